@@ -768,7 +768,12 @@ proc generate {os_handle} {
 		puts $config_file "#define portGET_RUN_TIME_COUNTER_VALUE()\n"
 	}
 
-	puts $config_file "#define configUSE_TICKLESS_IDLE	0"
+	set val [common::get_property CONFIG.use_tickless_idle $os_handle]
+	if {$val == "true" && ($proctype == "psu_cortexr5" || $proctype == "psv_cortexr5" || $proctype == "psu_cortexa53")} {
+		puts $config_file "#define configUSE_TICKLESS_IDLE	1"
+	} else {
+		puts $config_file "#define configUSE_TICKLESS_IDLE	0"
+	}
 	puts $config_file "#define configTASK_RETURN_ADDRESS    NULL"
 	puts $config_file "#define INCLUDE_vTaskPrioritySet             1"
 	puts $config_file "#define INCLUDE_uxTaskPriorityGet            1"
@@ -64,6 +64,20 @@ extern "C" {
 struct StreamBufferDef_t;
 typedef struct StreamBufferDef_t * StreamBufferHandle_t;
 
+/**
+ * Region of the buffer storage area returned by xStreamBufferSendAcquire() and
+ * xStreamBufferReceivePeek().  When the region wraps around the end of the
+ * storage area it is made of two spans, the second one starting at the start
+ * of the storage area.  Otherwise pucSecond is NULL and xSecondLength is 0.
+ */
+typedef struct xSTREAM_BUFFER_SPANS
+{
+	uint8_t *pucFirst;		/* Start of the first span. */
+	size_t xFirstLength;	/* Number of bytes in the first span. */
+	uint8_t *pucSecond;		/* Start of the second span, or NULL. */
+	size_t xSecondLength;	/* Number of bytes in the second span. */
+} StreamBufferSpans_t;
+
 
 /**
  * message_buffer.h
@@ -829,6 +843,109 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendAcquire( StreamBufferHandle_t xStreamBuffer,
+								 size_t xMaxBytes,
+								 StreamBufferSpans_t * const pxSpans );
+
+void vStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer, size_t xCommitBytes );
+
+void vStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									 size_t xCommitBytes,
+									 BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Zero copy send.  xStreamBufferSendAcquire() returns in pxSpans the free part
+ * of the buffer storage area, up to xMaxBytes, so the writer can fill it in
+ * place, for example as the destination of a DMA transfer.  Nothing is added
+ * to the stream buffer until vStreamBufferSendCommit(), or
+ * vStreamBufferSendCommitFromISR() from an interrupt, adds the first
+ * xCommitBytes of the acquired region to it and unblocks a reader waiting for
+ * the trigger level.
+ *
+ * The acquired region stays valid until it is committed as only the writer
+ * adds data.  xCommitBytes must not exceed the number of bytes acquired.
+ * xStreamBufferSendAcquire() never blocks and can be called from an interrupt.
+ * It cannot be used with message buffers.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param xMaxBytes The maximum number of bytes to acquire.
+ *
+ * @param pxSpans Filled with the acquired region.
+ *
+ * @return The number of bytes acquired, which is 0 when the buffer is full.
+ *
+ * \defgroup xStreamBufferSendAcquire xStreamBufferSendAcquire
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendAcquire( StreamBufferHandle_t xStreamBuffer,
+								 size_t xMaxBytes,
+								 StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+void vStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+							  size_t xCommitBytes ) PRIVILEGED_FUNCTION;
+
+void vStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									 size_t xCommitBytes,
+									 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceivePeek( StreamBufferHandle_t xStreamBuffer,
+								 size_t xMaxBytes,
+								 StreamBufferSpans_t * const pxSpans,
+								 TickType_t xTicksToWait );
+
+void vStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer, size_t xReleaseBytes );
+
+void vStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+										 size_t xReleaseBytes,
+										 BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Zero copy receive.  xStreamBufferReceivePeek() returns in pxSpans up to
+ * xMaxBytes of the data in the buffer, without removing it, so the reader can
+ * consume it in place.  vStreamBufferReceiveRelease(), or
+ * vStreamBufferReceiveReleaseFromISR() from an interrupt, then removes the
+ * first xReleaseBytes of that data and unblocks a writer waiting for space.
+ *
+ * The peeked data stays valid until it is released as only the reader removes
+ * data.  xTicksToWait must be 0 when xStreamBufferReceivePeek() is called from
+ * an interrupt.  These functions cannot be used with message buffers.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param xMaxBytes The maximum number of bytes to peek.
+ *
+ * @param pxSpans Filled with the data in the buffer.
+ *
+ * @param xTicksToWait The maximum time to wait for data when the buffer is
+ * empty.
+ *
+ * @return The number of bytes peeked, which is 0 when the buffer is still
+ * empty after xTicksToWait.
+ *
+ * \defgroup xStreamBufferReceivePeek xStreamBufferReceivePeek
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceivePeek( StreamBufferHandle_t xStreamBuffer,
+								 size_t xMaxBytes,
+								 StreamBufferSpans_t * const pxSpans,
+								 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+void vStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+								  size_t xReleaseBytes ) PRIVILEGED_FUNCTION;
+
+void vStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+										 size_t xReleaseBytes,
+										 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
@@ -431,6 +431,55 @@ int32_t lReturn;
 }
 /*-----------------------------------------------------------*/
 
+static void prvYieldCoreHandler( void *pvUnused )
+{
+	( void ) pvUnused;
+
+	/* Another core made a task ready that should preempt the task running
+	here.  Switch on the way out of the interrupt. */
+	ullPortYieldRequired = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldCore( BaseType_t xCoreID )
+{
+	configASSERT( ( xCoreID >= 0 ) && ( xCoreID < 4 ) );
+
+	if( xCoreID == portGET_CORE_ID() )
+	{
+		portYIELD();
+	}
+	else
+	{
+		/* Make the caller's writes visible before the other core runs. */
+		__asm volatile ( "DSB SY" ::: "memory" );
+		XScuGic_SoftwareIntr( &xInterruptController, configYIELD_CORE_SGI_ID, ( 1UL << xCoreID ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSpinlockTake( PortSpinlock_t *pxLock )
+{
+uint32_t ulTicket;
+
+	ulTicket = __atomic_fetch_add( &( pxLock->ulNextTicket ), 1U, __ATOMIC_RELAXED );
+	while( __atomic_load_n( &( pxLock->ulOwner ), __ATOMIC_ACQUIRE ) != ulTicket )
+	{
+		/* vPortSpinlockGive() sends an event, and an event sent since the
+		owner was read makes WFE return at once. */
+		__asm volatile ( "WFE" ::: "memory" );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSpinlockGive( PortSpinlock_t *pxLock )
+{
+	__atomic_store_n( &( pxLock->ulOwner ), pxLock->ulOwner + 1U, __ATOMIC_RELEASE );
+	__asm volatile ( "DSB SY	\n"
+					 "SEV		\n" ::: "memory" );
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xPortStartScheduler( void )
 {
 uint32_t ulAPSR;
@@ -513,6 +562,10 @@ uint32_t ulBpr;
 			executing. */
 			portDISABLE_INTERRUPTS();
 
+			/* Let the other cores request a context switch on this one. */
+			xPortInstallInterruptHandler( configYIELD_CORE_SGI_ID, prvYieldCoreHandler, NULL );
+			vPortEnableInterrupt( configYIELD_CORE_SGI_ID );
+
 			/* Start the timer that generates the tick ISR. */
 			configSETUP_TICK_INTERRUPT();
 
@@ -149,6 +149,13 @@ macros is used. */
 handler for whichever peripheral is used to generate the RTOS tick. */
 void FreeRTOS_Tick_Handler( void );
 
+/* Tickless idle, the tick timer is reprogrammed to wake up at the end of the
+expected idle time. */
+#if( configUSE_TICKLESS_IDLE == 1 )
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
 /*
  * Installs pxHandler as the interrupt handler for the peripheral specified by
  * the ucInterruptID parameter.
@@ -200,6 +207,43 @@ void vPortEnableInterrupt( uint8_t ucInterruptID );
  */
 void vPortDisableInterrupt( uint8_t ucInterruptID );
 
+/*-----------------------------------------------------------
+ * Multi-core support
+ *----------------------------------------------------------*/
+
+/* Index of the executing core within the A53 cluster. */
+#define portGET_CORE_ID()	( ( BaseType_t ) ( mfcp( MPIDR_EL1 ) & 0xFFUL ) )
+
+/* SGI used to request a context switch on another core. */
+#ifndef configYIELD_CORE_SGI_ID
+	#define configYIELD_CORE_SGI_ID		7
+#endif
+
+/*
+ * Ticket spinlock shared between the cores of the cluster.  The lock must be
+ * in normal, inner shareable cacheable memory for the exclusive accesses to
+ * work.  Taking the lock does not mask interrupts, so a lock that is also
+ * taken from an ISR must be taken inside a critical section.
+ */
+typedef struct xPORT_SPINLOCK
+{
+	volatile uint32_t ulNextTicket;	/* Next ticket to hand out. */
+	volatile uint32_t ulOwner;		/* Ticket of the current owner. */
+} PortSpinlock_t;
+
+#define portSPINLOCK_INIT	{ 0U, 0U }
+
+void vPortSpinlockTake( PortSpinlock_t *pxLock );
+void vPortSpinlockGive( PortSpinlock_t *pxLock );
+
+/*
+ * Requests a context switch on the core xCoreID by raising
+ * configYIELD_CORE_SGI_ID on it.  The switch happens when the SGI handler
+ * returns, as for any ISR that sets portYIELD_FROM_ISR().
+ */
+void vPortYieldCore( BaseType_t xCoreID );
+#define portYIELD_CORE( xCoreID )	vPortYieldCore( xCoreID )
+
 /* Any task that uses the floating point unit MUST call vPortTaskUsesFPU()
 before any floating point instructions are executed. */
 #if( configUSE_TASK_FPU_SUPPORT != 2 )
@@ -55,6 +55,31 @@ void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName ) __att
 /* Timer used to generate the tick interrupt. */
 static XTtcPs xTimerInstance;
 XScuGic xInterruptController;
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	#error configUSE_TICKLESS_IDLE cannot be used with configGENERATE_RUN_TIME_STATS, both reprogram the tick timer.
+#endif
+
+/* Timer counts in one tick, and the longest sleep the timer interval can
+hold.  Both are set when the tick timer is configured. */
+static uint32_t ulTimerCountsForOneTick = 0;
+static TickType_t xMaximumPossibleSuppressedTicks = 0;
+
+/* Set when the timer interval was shortened to realign the tick after a
+sleep, the next tick interrupt restores the one tick interval. */
+static volatile BaseType_t xTickIntervalRestore = pdFALSE;
+
+/* Masking interrupts in the CPU rather than with the GIC priority mask keeps
+WFI waking up on a pending interrupt. */
+#define portTICKLESS_IRQ_DISABLE()	__asm volatile ( "CPSID i" ::: "memory" ); \
+									__asm volatile ( "DSB" ); \
+									__asm volatile ( "ISB" )
+#define portTICKLESS_IRQ_ENABLE()	__asm volatile ( "CPSIE i" ::: "memory" ); \
+									__asm volatile ( "DSB" ); \
+									__asm volatile ( "ISB" )
+#endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
 void FreeRTOS_SetupTickInterrupt( void )
@@ -110,6 +135,10 @@ XScuGic_Config *pxInterruptControllerConfig;
 	XTtcPs_CalcIntervalFromFreq( &xTimerInstance, configTICK_RATE_HZ*10, &usInterval, &ucPrescaler );
 #else
 	XTtcPs_CalcIntervalFromFreq( &xTimerInstance, configTICK_RATE_HZ, &usInterval, &ucPrescaler );
+#endif
+#if( configUSE_TICKLESS_IDLE == 1 )
+	ulTimerCountsForOneTick = usInterval;
+	xMaximumPossibleSuppressedTicks = XTTCPS_MAX_INTERVAL_COUNT / ulTimerCountsForOneTick;
 #endif
 	XTtcPs_SetInterval( &xTimerInstance, usInterval );
 	XTtcPs_SetPrescaler( &xTimerInstance, ucPrescaler );
@@ -125,7 +154,116 @@ void FreeRTOS_ClearTickInterrupt( void )
 {
 
 	XTtcPs_ClearInterruptStatus( &xTimerInstance, XTtcPs_GetInterruptStatus( &xTimerInstance ) );
+#if( configUSE_TICKLESS_IDLE == 1 )
+	if( xTickIntervalRestore != pdFALSE )
+	{
+		XTtcPs_SetInterval( &xTimerInstance, ulTimerCountsForOneTick );
+		xTickIntervalRestore = pdFALSE;
+	}
+#endif
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+static void prvClearPendingTick( void )
+{
+	/* The TTC interrupt status is cleared on read.  Drop the tick interrupt
+	the GIC may already have latched so it is not counted twice. */
+	XScuGic_DistWriteReg( &xInterruptController,
+						  XSCUGIC_PENDING_CLR_OFFSET + ( ( configTIMER_INTERRUPT_ID / 32U ) * 4U ),
+						  ( 1UL << ( configTIMER_INTERRUPT_ID % 32U ) ) );
+}
+/*-----------------------------------------------------------*/
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+uint32_t ulCount, ulSleepCounts, ulCompleteTicks;
+TickType_t xModifiableIdleTime;
+
+	if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+	{
+		xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+	}
+
+	portTICKLESS_IRQ_DISABLE();
+
+	/* A task may have been made ready while the scheduler was being
+	suspended for the idle period. */
+	if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+	{
+		portTICKLESS_IRQ_ENABLE();
+		return;
+	}
+
+	/* Stop the tick timer, the counts already spent in the current tick are
+	part of the sleep. */
+	XTtcPs_Stop( &xTimerInstance );
+	ulCount = XTtcPs_GetCounterValue( &xTimerInstance );
+	if( ( XTtcPs_GetInterruptStatus( &xTimerInstance ) & XTTCPS_IXR_INTERVAL_MASK ) != 0U )
+	{
+		/* A tick expired but was not handled yet, account for it here and
+		do not sleep. */
+		prvClearPendingTick();
+		vTaskStepTick( 1 );
+		XTtcPs_SetInterval( &xTimerInstance, ulTimerCountsForOneTick );
+		XTtcPs_ResetCounterValue( &xTimerInstance );
+		XTtcPs_Start( &xTimerInstance );
+		portTICKLESS_IRQ_ENABLE();
+		return;
+	}
+
+	ulSleepCounts = ( ulTimerCountsForOneTick * ( uint32_t ) xExpectedIdleTime ) - ulCount;
+	XTtcPs_SetInterval( &xTimerInstance, ulSleepCounts );
+	XTtcPs_ResetCounterValue( &xTimerInstance );
+	XTtcPs_Start( &xTimerInstance );
+
+	/* configPRE_SLEEP_PROCESSING() can set xModifiableIdleTime to 0 when it
+	did the sleep itself. */
+	xModifiableIdleTime = xExpectedIdleTime;
+	configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+	if( xModifiableIdleTime > 0 )
+	{
+		__asm volatile( "DSB" ::: "memory" );
+		__asm volatile( "wfi" );
+		__asm volatile( "ISB" );
+	}
+	configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+	XTtcPs_Stop( &xTimerInstance );
+	ulCount = XTtcPs_GetCounterValue( &xTimerInstance );
+	if( ( XTtcPs_GetInterruptStatus( &xTimerInstance ) & XTTCPS_IXR_INTERVAL_MASK ) != 0U )
+	{
+		/* The whole sleep elapsed.  The counts run since the wakeup are
+		taken off the next tick so the tick keeps its phase. */
+		prvClearPendingTick();
+		ulCompleteTicks = xExpectedIdleTime;
+	}
+	else
+	{
+		/* Woken by another interrupt, count the whole ticks spent asleep and
+		time the next tick from where the current one started. */
+		ulCount += ( ulTimerCountsForOneTick * ( uint32_t ) xExpectedIdleTime ) - ulSleepCounts;
+		ulCompleteTicks = ulCount / ulTimerCountsForOneTick;
+		ulCount %= ulTimerCountsForOneTick;
+	}
+
+	if( ulCount != 0U )
+	{
+		XTtcPs_SetInterval( &xTimerInstance, ulTimerCountsForOneTick - ulCount );
+		xTickIntervalRestore = pdTRUE;
+	}
+	else
+	{
+		XTtcPs_SetInterval( &xTimerInstance, ulTimerCountsForOneTick );
+	}
+	XTtcPs_ResetCounterValue( &xTimerInstance );
+	XTtcPs_Start( &xTimerInstance );
+
+	vTaskStepTick( ( TickType_t ) ulCompleteTicks );
+	portTICKLESS_IRQ_ENABLE();
 }
+#endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
 void vApplicationIRQHandler( uint32_t ulICCIAR )
@@ -202,6 +202,28 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
 									  size_t xMaxCount,
 									  size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
 
+/*
+ * Add xCount bytes, already written in place by the writer, to the data in the
+ * buffer.  Returns the number of bytes in the buffer.
+ */
+static size_t prvCommitBytes( StreamBuffer_t * const pxStreamBuffer, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove xCount bytes, already consumed in place by the reader, from the data
+ * in the buffer.
+ */
+static void prvReleaseBytes( StreamBuffer_t * const pxStreamBuffer, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Describe the xCount bytes of the buffer storage area that start at index
+ * xStart in pxSpans, as two spans when the bytes wrap to the start of the
+ * storage area.
+ */
+static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+						 size_t xStart,
+						 size_t xCount,
+						 StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -1085,6 +1107,256 @@ UBaseType_t uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferSendAcquire( StreamBufferHandle_t xStreamBuffer,
+								 size_t xMaxBytes,
+								 StreamBufferSpans_t * const pxSpans )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xCount;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxSpans );
+
+	/* Message buffers need the length written ahead of the message, which
+	the zero copy API does not do. */
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+	/* Only the writer moves xHead, so the free space can only grow until the
+	bytes are committed. */
+	xCount = configMIN( xStreamBufferSpacesAvailable( pxStreamBuffer ), xMaxBytes );
+	prvGetSpans( pxStreamBuffer, pxStreamBuffer->xHead, xCount, pxSpans );
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommitBytes( StreamBuffer_t * const pxStreamBuffer, size_t xCount )
+{
+size_t xNextHead;
+
+	configASSERT( xCount <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+	xNextHead = pxStreamBuffer->xHead + xCount;
+	if( xNextHead >= pxStreamBuffer->xLength )
+	{
+		xNextHead -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxStreamBuffer->xHead = xNextHead;
+
+	return prvBytesInBuffer( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer, size_t xCommitBytes )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xCommitBytes > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xCommitBytes );
+
+		if( prvCommitBytes( pxStreamBuffer, xCommitBytes ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									 size_t xCommitBytes,
+									 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xCommitBytes > ( size_t ) 0 )
+	{
+		if( prvCommitBytes( pxStreamBuffer, xCommitBytes ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xCommitBytes );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceivePeek( StreamBufferHandle_t xStreamBuffer,
+								 size_t xMaxBytes,
+								 StreamBufferSpans_t * const pxSpans,
+								 TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xBytesAvailable;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxSpans );
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		/* Checking if there is data and clearing the notification state must be
+		performed atomically. */
+		taskENTER_CRITICAL();
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+			if( xBytesAvailable == ( size_t ) 0 )
+			{
+				/* Clear notification state as going to wait for data. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one reader. */
+				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBytesAvailable == ( size_t ) 0 )
+		{
+			/* Wait for data to be available. */
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+			/* Recheck the data available after blocking. */
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	}
+
+	/* Only the reader moves xTail, so the bytes stay in place until they are
+	released. */
+	xBytesAvailable = configMIN( xBytesAvailable, xMaxBytes );
+	prvGetSpans( pxStreamBuffer, pxStreamBuffer->xTail, xBytesAvailable, pxSpans );
+
+	return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseBytes( StreamBuffer_t * const pxStreamBuffer, size_t xCount )
+{
+size_t xNextTail;
+
+	configASSERT( xCount <= prvBytesInBuffer( pxStreamBuffer ) );
+
+	xNextTail = pxStreamBuffer->xTail + xCount;
+	if( xNextTail >= pxStreamBuffer->xLength )
+	{
+		xNextTail -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxStreamBuffer->xTail = xNextTail;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer, size_t xReleaseBytes )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xReleaseBytes > ( size_t ) 0 )
+	{
+		prvReleaseBytes( pxStreamBuffer, xReleaseBytes );
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReleaseBytes );
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+										 size_t xReleaseBytes,
+										 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	if( xReleaseBytes > ( size_t ) 0 )
+	{
+		prvReleaseBytes( pxStreamBuffer, xReleaseBytes );
+		sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReleaseBytes );
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+						 size_t xStart,
+						 size_t xCount,
+						 StreamBufferSpans_t * const pxSpans )
+{
+size_t xFirstLength;
+
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xStart, xCount );
+
+	pxSpans->pucFirst = &( pxStreamBuffer->pucBuffer[ xStart ] );
+	pxSpans->xFirstLength = xFirstLength;
+
+	if( xCount > xFirstLength )
+	{
+		pxSpans->pucSecond = pxStreamBuffer->pucBuffer;
+		pxSpans->xSecondLength = xCount - xFirstLength;
+	}
+	else
+	{
+		pxSpans->pucSecond = NULL;
+		pxSpans->xSecondLength = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
 {
 size_t xNextHead, xFirstLength;
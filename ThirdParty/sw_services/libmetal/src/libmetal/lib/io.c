@@ -6,9 +6,16 @@
 
 #include <errno.h>
 #include <limits.h>
+#include <metal/cpu.h>
 #include <metal/io.h>
 #include <metal/sys.h>
 
+#ifndef METAL_CPU_IO_WORD
+#define METAL_CPU_IO_WORD	unsigned int
+#endif
+
+typedef METAL_CPU_IO_WORD metal_io_word_t;
+
 void metal_io_init(struct metal_io_region *io, void *virt,
 	      const metal_phys_addr_t *physmap, size_t size,
 	      unsigned page_shift, unsigned int mem_flags,
@@ -32,6 +39,52 @@ void metal_io_init(struct metal_io_region *io, void *virt,
 	metal_sys_io_mem_map(io);
 }
 
+/*
+ * Copy with the widest aligned accesses the two buffers allow. Both sides
+ * are brought to a common alignment with byte copies, the bulk is copied
+ * four words at a time, and the tail byte by byte again, so that no
+ * unaligned access is ever made to device memory.
+ */
+static void metal_io_copy(unsigned char *restrict dst,
+			  const unsigned char *restrict src, int len)
+{
+	uintptr_t misalign = (uintptr_t)dst ^ (uintptr_t)src;
+	unsigned int align;
+
+	if (!(misalign % sizeof(metal_io_word_t)))
+		align = sizeof(metal_io_word_t);
+	else if (!(misalign % sizeof(unsigned int)))
+		align = sizeof(unsigned int);
+	else
+		align = 1;
+
+	for (; len && ((uintptr_t)dst % align); dst++, src++, len--)
+		*dst = *src;
+	if (align == sizeof(metal_io_word_t)) {
+		metal_io_word_t *d = (metal_io_word_t *)dst;
+		const metal_io_word_t *s = (const metal_io_word_t *)src;
+
+		for (; len >= (int)(4 * sizeof(*d)); d += 4, s += 4,
+						     len -= 4 * sizeof(*d)) {
+			d[0] = s[0];
+			d[1] = s[1];
+			d[2] = s[2];
+			d[3] = s[3];
+		}
+		for (; len >= (int)sizeof(*d); d++, s++, len -= sizeof(*d))
+			*d = *s;
+		dst = (unsigned char *)d;
+		src = (const unsigned char *)s;
+	} else if (align == sizeof(unsigned int)) {
+		for (; len >= (int)sizeof(unsigned int);
+		     dst += sizeof(unsigned int), src += sizeof(unsigned int),
+		     len -= sizeof(unsigned int))
+			*(unsigned int *)dst = *(const unsigned int *)src;
+	}
+	for (; len != 0; dst++, src++, len--)
+		*dst = *src;
+}
+
 int metal_io_block_read(struct metal_io_region *io, unsigned long offset,
 	       void *restrict dst, int len)
 {
@@ -49,22 +102,7 @@ int metal_io_block_read(struct metal_io_region *io, unsigned long offset,
 			io, offset, dst, memory_order_seq_cst, len);
 	} else {
 		atomic_thread_fence(memory_order_seq_cst);
-		while ( len && (
-			((uintptr_t)dest % sizeof(int)) ||
-			((uintptr_t)ptr % sizeof(int)))) {
-			*(unsigned char *)dest =
-				*(const unsigned char *)ptr;
-			dest++;
-			ptr++;
-			len--;
-		}
-		for (; len >= (int)sizeof(int); dest += sizeof(int),
-					ptr += sizeof(int),
-					len -= sizeof(int))
-			*(unsigned int *)dest = *(const unsigned int *)ptr;
-		for (; len != 0; dest++, ptr++, len--)
-			*(unsigned char *)dest =
-				*(const unsigned char *)ptr;
+		metal_io_copy(dest, ptr, len);
 	}
 	return retlen;
 }
@@ -85,22 +123,7 @@ int metal_io_block_write(struct metal_io_region *io, unsigned long offset,
 		retlen = (*io->ops.block_write)(
 			io, offset, src, memory_order_seq_cst, len);
 	} else {
-		while ( len && (
-			((uintptr_t)ptr % sizeof(int)) ||
-			((uintptr_t)source % sizeof(int)))) {
-			*(unsigned char *)ptr =
-				*(const unsigned char *)source;
-			ptr++;
-			source++;
-			len--;
-		}
-		for (; len >= (int)sizeof(int); ptr += sizeof(int),
-					source += sizeof(int),
-					len -= sizeof(int))
-			*(unsigned int *)ptr = *(const unsigned int *)source;
-		for (; len != 0; ptr++, source++, len--)
-			*(unsigned char *)ptr =
-				*(const unsigned char *)source;
+		metal_io_copy(ptr, source, len);
 		atomic_thread_fence(memory_order_seq_cst);
 	}
 	return retlen;
@@ -12,6 +12,11 @@
 #ifndef __METAL_AARCH64_CPU__H__
 #define __METAL_AARCH64_CPU__H__
 
+#include <stdint.h>
+
 #define metal_cpu_yield() asm volatile("yield")
 
+/** Widest access used by the generic I/O block copies */
+#define METAL_CPU_IO_WORD	uint64_t
+
 #endif /* __METAL_AARCH64_CPU__H__ */
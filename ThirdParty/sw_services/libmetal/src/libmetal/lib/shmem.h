@@ -30,6 +30,7 @@ extern "C" {
 #define METAL_SHM_DIR_DEV_RW 3U /**< shmem direction, device read/write */
 
 #define METAL_SHM_NOTCACHED  1U /**< shmem not cached */
+#define METAL_SHM_CONTIGUOUS 2U /**< shmem physically contiguous */
 
 struct metal_generic_shmem;
 struct metal_shm_ops {
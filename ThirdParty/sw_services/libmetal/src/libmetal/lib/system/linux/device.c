@@ -380,6 +380,11 @@ static int metal_uio_dev_shm_attach(struct linux_bus *lbus,
 
 	(void)lbus;
 
+	if (shm->id < 0) {
+		/* Not a dma-buf, the memory already has its DMA addresses */
+		memcpy(&ref->sg, &shm->sg, sizeof(ref->sg));
+		return 0;
+	}
 	va = mmap(NULL, shm->size, PROT_READ | PROT_WRITE, MAP_SHARED,
 		  shm->id, 0);
 	if (va == MAP_FAILED) {
@@ -434,6 +439,12 @@ static void metal_uio_dev_shm_detach(struct linux_bus *lbus,
 	void *va;
 
 	(void)lbus;
+	if (shm->id < 0) {
+		/* Borrowed the shmem scatter list on attach */
+		ref->dev = NULL;
+		ref->sg.nents = 0;
+		return;
+	}
 	args.dbuf_fd = shm->id;
 	ret = ioctl(ldev->fd, UIO_IOC_UNMAP_DMABUF, &args);
 	if (ret < 0) {
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2019, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file	linux/shmem-provider-hugepage.c
+ * @brief	Linux libmetal shared memory provider with hugepages.
+ *
+ * The memory is allocated from the largest hugepage size that holds the
+ * requested size, so that a buffer usually spans a single, physically
+ * contiguous page. The mapping is cached and locked, and the physical
+ * address of every hugepage is resolved at allocation time, so the
+ * resulting I/O region can be handed to a DMA device as it is. The memory
+ * is private to the process which opens it.
+ */
+
+#include <metal/atomic.h>
+#include <metal/cache.h>
+#include <metal/dma.h>
+#include <metal/log.h>
+#include <metal/shmem.h>
+#include <metal/sys.h>
+#include <metal/utilities.h>
+#include <string.h>
+#include "shmem.h"
+
+static struct metal_page_size *metal_linux_hugepage_find(size_t size)
+{
+	struct metal_page_size *ps, *found = NULL;
+
+	/* Smallest hugepage which holds the buffer, else the largest one */
+	metal_for_each_page_size_up(ps) {
+		if (!(ps->mmap_flags & MAP_HUGETLB))
+			continue;
+		found = ps;
+		if (ps->page_size >= size)
+			break;
+	}
+	return found;
+}
+
+static int metal_linux_hugepage_sync_for_device(struct metal_generic_shmem *shm,
+						struct metal_device *dev,
+						unsigned int direction)
+{
+	struct metal_io_region *io = shm->sg.ios;
+
+	(void)dev;
+	if (direction == METAL_DMA_DEV_R) {
+		/* Device reads, make the CPU writes visible first */
+		atomic_thread_fence(memory_order_release);
+		metal_cache_flush(io->virt, io->size);
+	} else if (direction == METAL_DMA_DEV_W ||
+		   direction == METAL_DMA_DEV_WR) {
+		atomic_thread_fence(memory_order_acq_rel);
+		metal_cache_flush(io->virt, io->size);
+	} else {
+		metal_log(METAL_LOG_ERROR,
+			  "%s: unrecognized direction: 0x%x\n",
+			  __func__, direction);
+		return -EINVAL;
+	}
+	return 0;
+}
+
+static int metal_linux_hugepage_sync_for_cpu(struct metal_generic_shmem *shm,
+					     unsigned int direction)
+{
+	struct metal_io_region *io = shm->sg.ios;
+
+	if (direction == METAL_DMA_DEV_R) {
+		atomic_thread_fence(memory_order_release);
+	} else if (direction == METAL_DMA_DEV_W ||
+		   direction == METAL_DMA_DEV_WR) {
+		/* Device wrote, drop stale lines before the CPU reads */
+		metal_cache_invalidate(io->virt, io->size);
+		atomic_thread_fence(memory_order_acq_rel);
+	} else {
+		metal_log(METAL_LOG_ERROR,
+			  "%s: unrecognized direction: 0x%x\n",
+			  __func__, direction);
+		return -EINVAL;
+	}
+	return 0;
+}
+
+static struct metal_shm_ops metal_linux_hugepage_ops = {
+	.sync_for_device = metal_linux_hugepage_sync_for_device,
+	.sync_for_cpu = metal_linux_hugepage_sync_for_cpu,
+	/* The scatter list built at allocation is used as it is */
+	.mmap = NULL,
+	.munmap = NULL,
+};
+
+static int metal_linux_hugepage_alloc(struct metal_shm_provider *provider,
+				      struct metal_generic_shmem *shm,
+				      size_t size)
+{
+	struct metal_page_size *ps;
+	struct metal_io_region *io;
+	metal_phys_addr_t *phys;
+	unsigned long page_phys;
+	size_t pages, page;
+	unsigned int shift;
+	int contiguous;
+	uint8_t *virt;
+	void *mem;
+	int error;
+
+	(void)provider;
+	if (shm == NULL || size == 0) {
+		return -EINVAL;
+	}
+	if (shm->flags & METAL_SHM_NOTCACHED) {
+		metal_log(METAL_LOG_ERROR,
+			  "%s: hugepage memory is always cached.\n",
+			  __func__);
+		return -EINVAL;
+	}
+	if (_metal.pagemap_fd < 0) {
+		metal_log(METAL_LOG_ERROR,
+			  "%s: no va2pa mapping, cannot get DMA addresses.\n",
+			  __func__);
+		return -ENOSYS;
+	}
+	ps = metal_linux_hugepage_find(size);
+	if (ps == NULL) {
+		metal_log(METAL_LOG_ERROR,
+			  "%s: no hugepage size is available.\n", __func__);
+		return -ENOMEM;
+	}
+
+	size = metal_align_up(size, ps->page_size);
+	pages = size / ps->page_size;
+	mem = mmap(NULL, size, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | ps->mmap_flags,
+		   -1, 0);
+	if (mem == MAP_FAILED) {
+		metal_log(METAL_LOG_ERROR,
+			  "%s: failed to mmap %ld bytes of 0x%lx pages - %s\n",
+			  __func__, size, ps->page_size, strerror(errno));
+		return -ENOMEM;
+	}
+	/* Hugepages are not swapped, but keep the mapping resident anyway */
+	error = metal_mlock(mem, size);
+	if (error) {
+		metal_log(METAL_LOG_WARNING, "%s: failed to mlock - %s\n",
+			  __func__, strerror(-error));
+	}
+
+	phys = malloc(sizeof(*phys) * pages);
+	io = malloc(sizeof(*io));
+	if (phys == NULL || io == NULL) {
+		error = -ENOMEM;
+		goto err;
+	}
+	contiguous = 1;
+	for (virt = mem, page = 0; page < pages; page++) {
+		error = metal_virt2phys(virt + page * ps->page_size,
+					&page_phys);
+		if (error < 0)
+			goto err;
+		phys[page] = page_phys;
+		if (phys[page] != phys[0] + page * ps->page_size)
+			contiguous = 0;
+	}
+	if (!contiguous && (shm->flags & METAL_SHM_CONTIGUOUS)) {
+		metal_log(METAL_LOG_ERROR,
+			  "%s: %ld hugepages are not physically contiguous.\n",
+			  __func__, pages);
+		error = -ENOMEM;
+		goto err;
+	}
+	/* A contiguous buffer is described by its base address only */
+	shift = contiguous ? (unsigned int)-1 : ps->page_shift;
+	metal_io_init(io, mem, phys, size, shift, 0, NULL);
+
+	shm->sg.ios = io;
+	shm->sg.nents = 1;
+	shm->ops = &metal_linux_hugepage_ops;
+	shm->size = size;
+	shm->id = -1;
+	metal_log(METAL_LOG_DEBUG,
+		  "%s: %s, %ld x 0x%lx pages, %scontiguous at 0x%lx.\n",
+		  __func__, shm->name, pages, ps->page_size,
+		  contiguous ? "" : "not ", phys[0]);
+	return 0;
+
+err:
+	free(io);
+	free(phys);
+	metal_unmap(mem, size);
+	return error;
+}
+
+static void metal_linux_hugepage_free(struct metal_shm_provider *provider,
+				      struct metal_generic_shmem *shm)
+{
+	struct metal_io_region *io;
+
+	(void)provider;
+	if (shm == NULL || shm->sg.ios == NULL) {
+		return;
+	}
+	io = shm->sg.ios;
+	metal_unmap(io->virt, io->size);
+	free((void *)io->physmap);
+	free(io);
+	shm->sg.ios = NULL;
+	shm->sg.nents = 0;
+}
+
+METAL_SHM_PROVIDER_DECLARE(linux_shm_provider_hugepage, "linux_hugepage", NULL,
+			   metal_linux_hugepage_alloc,
+			   metal_linux_hugepage_free)
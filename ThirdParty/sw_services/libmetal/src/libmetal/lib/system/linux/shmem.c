@@ -22,6 +22,7 @@ int metal_linux_init_shmem(void)
 	int ret = 0;
 
 	metal_shm_provider_register(&linux_shm_provider_shm);
+	metal_shm_provider_register(&linux_shm_provider_hugepage);
 #ifdef HAVE_DMA_BUF_H
 	ret = metal_ion_shm_provider_init();
 #endif
@@ -31,6 +32,7 @@ int metal_linux_init_shmem(void)
 void metal_linux_deinit_shmem(void)
 {
 	metal_shm_provider_unregister(&linux_shm_provider_shm);
+	metal_shm_provider_unregister(&linux_shm_provider_hugepage);
 #ifdef HAVE_DMA_BUF_H
 	metal_ion_shm_provider_deinit();
 #endif
@@ -23,6 +23,7 @@ extern "C" {
  *  @{ */
 
 extern struct metal_shm_provider linux_shm_provider_shm;
+extern struct metal_shm_provider linux_shm_provider_hugepage;
 
 int metal_linux_shmem_mmap(struct metal_generic_shmem *shm,
 			   size_t size,
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2019, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Check the I/O block copies for every source and destination alignment,
+ * then report their bandwidth on RPMsg sized buffers.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "metal-test.h"
+#include <metal/io.h>
+#include <metal/log.h>
+#include <metal/sys.h>
+#include <metal/time.h>
+
+#define IO_COPY_REGION_SIZE	4096
+#define IO_COPY_MAX_LEN		600
+#define IO_COPY_BENCH_LEN	512
+#define IO_COPY_BENCH_LOOPS	100000
+
+static unsigned long long io_copy_mbps(unsigned long long bytes,
+				       unsigned long long ns)
+{
+	return ns ? (bytes * 1000ULL) / ns : 0;
+}
+
+static int io_copy_check(struct metal_io_region *io, unsigned char *mem,
+			 unsigned char *buf, unsigned char *ref)
+{
+	int src, dst, len, i;
+
+	for (src = 0; src < 16; src++) {
+		for (dst = 0; dst < 16; dst++) {
+			for (len = 0; len < IO_COPY_MAX_LEN; len += 7) {
+				for (i = 0; i < len; i++)
+					ref[i] = (unsigned char)(i + src + dst);
+				memset(mem, 0, IO_COPY_REGION_SIZE);
+				metal_io_block_write(io, dst, ref, len);
+				if (memcmp(mem + dst, ref, len) ||
+				    (dst && mem[dst - 1]) || mem[dst + len]) {
+					metal_log(METAL_LOG_ERROR,
+						  "block_write %d,%d,%d failed\n",
+						  src, dst, len);
+					return -1;
+				}
+				memset(buf, 0, IO_COPY_MAX_LEN + 16);
+				metal_io_block_read(io, dst, buf + src, len);
+				if (memcmp(buf + src, ref, len)) {
+					metal_log(METAL_LOG_ERROR,
+						  "block_read %d,%d,%d failed\n",
+						  src, dst, len);
+					return -1;
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+static void io_copy_bench(struct metal_io_region *io, unsigned char *buf)
+{
+	unsigned long long start, rd, wr, cpy;
+	unsigned long long bytes;
+	int i;
+
+	bytes = (unsigned long long)IO_COPY_BENCH_LEN * IO_COPY_BENCH_LOOPS;
+
+	start = metal_get_timestamp();
+	for (i = 0; i < IO_COPY_BENCH_LOOPS; i++)
+		metal_io_block_write(io, 16, buf, IO_COPY_BENCH_LEN);
+	wr = metal_get_timestamp() - start;
+
+	start = metal_get_timestamp();
+	for (i = 0; i < IO_COPY_BENCH_LOOPS; i++)
+		metal_io_block_read(io, 16, buf, IO_COPY_BENCH_LEN);
+	rd = metal_get_timestamp() - start;
+
+	start = metal_get_timestamp();
+	for (i = 0; i < IO_COPY_BENCH_LOOPS; i++)
+		memcpy(metal_io_virt(io, 16), buf, IO_COPY_BENCH_LEN);
+	cpy = metal_get_timestamp() - start;
+
+	metal_log(METAL_LOG_INFO,
+		  "io copy %d bytes: write %llu MB/s, read %llu MB/s, "
+		  "memcpy %llu MB/s\n", IO_COPY_BENCH_LEN,
+		  io_copy_mbps(bytes, wr), io_copy_mbps(bytes, rd),
+		  io_copy_mbps(bytes, cpy));
+}
+
+static int io_copy(void)
+{
+	struct metal_io_region io;
+	unsigned char *mem, *buf, *ref;
+	metal_phys_addr_t phys = 0;
+	int error;
+
+	mem = malloc(IO_COPY_REGION_SIZE);
+	buf = malloc(IO_COPY_MAX_LEN + 16);
+	ref = malloc(IO_COPY_MAX_LEN);
+	if (!mem || !buf || !ref) {
+		metal_log(METAL_LOG_ERROR, "failed to allocate memory\n");
+		error = -ENOMEM;
+		goto out;
+	}
+	metal_io_init(&io, mem, &phys, IO_COPY_REGION_SIZE, -1, 0, NULL);
+
+	error = io_copy_check(&io, mem, buf, ref);
+	if (!error)
+		io_copy_bench(&io, buf);
+
+	metal_io_finish(&io);
+out:
+	free(ref);
+	free(buf);
+	free(mem);
+	return error;
+}
+METAL_ADD_TEST(io_copy);
@@ -285,7 +285,8 @@ proc get_emac_periphs {processor} {
 			|| $periphname == "axi_ethernetlite"
 			|| $periphname == "ps7_ethernet"
 			|| $periphname == "psu_ethernet"
-			|| $periphname == "psv_ethernet"} {
+			|| $periphname == "psv_ethernet"
+			|| $periphname == "xxv_ethernet"} {
 			lappend emac_periphs_list $periph
 		} elseif {$periphname == "xps_ll_temac"} {
 			set emac0_enabled "0"
@@ -394,7 +395,7 @@ proc lwip_drc {libhandle} {
 
 		set cpuname [common::get_property NAME $processor]
 		error "ERROR: No Ethernet MAC cores are addressable from processor $cpuname. \
-			lwIP requires atleast one EMAC (xps_ethernetlite | xps_ll_temac | axi_ethernet | axi_ethernet_buffer | axi_ethernetlite | ps7_ethernet | psu_ethernet | psv_ethernet ) core \
+			lwIP requires atleast one EMAC (xps_ethernetlite | xps_ll_temac | axi_ethernet | axi_ethernet_buffer | axi_ethernetlite | ps7_ethernet | psu_ethernet | psv_ethernet | xxv_ethernet ) core \
 			with its interrupt pin connected to the interrupt controller.\n" "" "MDT_ERROR"
 		return
 	} else {
@@ -694,7 +695,16 @@ proc generate_lwip_opts {libhandle} {
 	puts $lwipopts_fd "\#define IP_REASS_MAX_PBUFS $ip_reass_max_pbufs"
 	puts $lwipopts_fd "\#define IP_FRAG_MAX_MTU $ip_frag_max_mtu"
 	puts $lwipopts_fd "\#define IP_DEFAULT_TTL $ip_default_ttl"
-	puts $lwipopts_fd "\#define LWIP_CHKSUM_ALGORITHM 3"
+	# ARM processors use the checksum routines of the port
+	switch -regexp $proctype {
+		"ps7_cortexa9|psu_cortexr5|psv_cortexr5|psu_cortexa53|psv_cortexa72" {
+			puts $lwipopts_fd "\#define LWIP_CHKSUM xlwip_chksum"
+			puts $lwipopts_fd "\#define LWIP_CHKSUM_COPY(dst, src, len) xlwip_chksum_copy(dst, src, len)"
+		}
+		default {
+			puts $lwipopts_fd "\#define LWIP_CHKSUM_ALGORITHM 3"
+		}
+	}
 	puts $lwipopts_fd ""
 
 	# UDP options
@@ -841,6 +851,23 @@ proc generate_lwip_opts {libhandle} {
 
 	puts $lwipopts_fd ""
 
+	# zero-copy RX hands DMA buffers to the stack as custom pbufs and
+	# zero-copy TX wraps application buffers in them
+	set rx_zero_copy [common::get_property CONFIG.gem_rx_zero_copy $libhandle]
+	set tx_zero_copy [common::get_property CONFIG.tx_zero_copy $libhandle]
+	if {$rx_zero_copy || $tx_zero_copy} {
+		puts $lwipopts_fd "\#define LWIP_SUPPORT_CUSTOM_PBUF 1"
+		puts $lwipopts_fd ""
+	}
+
+	# Gem hardware timestamps travel in two extra pbuf fields
+	set hw_timestamp [common::get_property CONFIG.gem_hw_timestamp $libhandle]
+	if {$hw_timestamp > 0} {
+		puts $lwipopts_fd "\#define LWIP_PBUF_CUSTOM_DATA u32_t ts_sec; u32_t ts_nsec;"
+		puts $lwipopts_fd "\#define LWIP_PBUF_CUSTOM_DATA_INIT(p) ((p)->ts_nsec = 0xFFFFFFFFU)"
+		puts $lwipopts_fd ""
+	}
+
 	set jumbo_frames [common::get_property CONFIG.temac_use_jumbo_frames $libhandle]
 	if {$jumbo_frames} {
 		puts $lwipopts_fd "\#define USE_JUMBO_FRAMES 1"
@@ -1127,6 +1154,29 @@ proc update_ps_ethernet_topology {emac processor topologyvar} {
 	}
 }
 
+proc update_xxv_ethernet_topology {emac processor topologyvar} {
+	upvar $topologyvar topology
+	set proc_type [common::get_property IP_NAME $processor]
+	set topology(emac_baseaddr) [common::get_property CONFIG.C_BASEADDR $emac]
+	set topology(emac_type) "xemac_type_xxv_ethernet"
+	set topology(intc_baseaddr) "0x0"
+	set topology(emac_intr_id) "0x0"
+	set topology(scugic_emac_intr) "0x0"
+
+	# the MCDMA channel interrupts are taken from the driver config,
+	# only the GIC is needed here
+	if {$proc_type == "psu_cortexa53"} {
+		set topology(scugic_baseaddr) "0xF9020000"
+	} elseif {$proc_type == "psu_cortexr5" || $proc_type == "psv_cortexr5"} {
+		set topology(scugic_baseaddr) "0xF9001000"
+	} elseif {$proc_type == "ps7_cortexa9"} {
+		set topology(scugic_baseaddr) "0xF8F00100"
+	} else {
+		set emac_name [common::get_property NAME $emac]
+		error "ERROR: lwIP supports xxv_ethernet ($emac_name) only on Zynq and Zynq UltraScale+ processors" "" "mdt_error"
+	}
+}
+
 proc generate_topology_per_emac {fd topologyvar} {
 	upvar $topologyvar topology
 
@@ -1204,6 +1254,10 @@ proc generate_topology {libhandle} {
 			update_ps_ethernet_topology $emac $processor topology
 			generate_topology_per_emac $tfd topology
 			incr topology_size 1
+		} elseif {$iptype == "xxv_ethernet"} {
+			update_xxv_ethernet_topology $emac $processor topology
+			generate_topology_per_emac $tfd topology
+			incr topology_size 1
 		}
 	}
 
@@ -1231,6 +1285,7 @@ proc generate_adapterconfig_makefile {libhandle} {
 	set have_axi_ethernet_dma 0
 	set have_axi_ethernet_mcdma 0
 	set have_ps_ethernet 0
+	set have_xxv_ethernet 0
 	set force_axieth_on_zynq 0
 	set force_emaclite_on_zynq 0
 
@@ -1283,6 +1338,8 @@ proc generate_adapterconfig_makefile {libhandle} {
 			}
 		} elseif {$iptype == "ps7_ethernet" || $iptype == "psu_ethernet" || $iptype == "psv_ethernet" } {
 			set have_ps_ethernet 1
+		} elseif {$iptype == "xxv_ethernet"} {
+			set have_xxv_ethernet 1
 		}
 	}
 	if {$force_axieth_on_zynq == 1 && $have_axi_ethernet == 1} {
@@ -1372,6 +1429,11 @@ proc generate_adapterconfig_makefile {libhandle} {
 		puts $fd "CONFIG_PS_ETHERNET=y"
 	}
 
+	# xxv_ethernet works next to the other MACs, it has its own adapter
+	if {$have_xxv_ethernet == 1} {
+		puts $fd "CONFIG_XXV_ETHERNET=y"
+	}
+
 	set api_mode [common::get_property CONFIG.api_mode $libhandle]
 	if {$api_mode == "SOCKET_API"} {
 		puts $fd "CONFIG_SOCKETS=y"
@@ -1396,6 +1458,7 @@ proc generate_adapterconfig_include {libhandle} {
 	set have_1588_enabled 0
 	set have_axi_ethernet_mcdma 0
 	set have_ps_ethernet 0
+	set have_xxv_ethernet 0
 	set force_axieth_on_zynq 0
 	set force_emaclite_on_zynq 0
 
@@ -1453,6 +1516,8 @@ proc generate_adapterconfig_include {libhandle} {
 			set have_axi_ethernet 1
 		} elseif {$iptype == "ps7_ethernet" || $iptype == "psu_ethernet" || $iptype == "psv_ethernet"} {
 			set have_ps_ethernet 1
+		} elseif {$iptype == "xxv_ethernet"} {
+			set have_xxv_ethernet 1
 		}
 	}
 	if {$force_emaclite_on_zynq == 1 && $have_emaclite == 1} {
@@ -1504,6 +1569,9 @@ proc generate_adapterconfig_include {libhandle} {
 	} elseif {$have_ps_ethernet == 1} {
 			puts $fd "\#define XLWIP_CONFIG_INCLUDE_GEM 1"
 	}
+	if {$have_xxv_ethernet == 1} {
+		puts $fd "\#define XLWIP_CONFIG_INCLUDE_XXV_ETHERNET 1"
+	}
 
 	if {$have_axi_ethernet == 1} {
 		set ndesc [common::get_property CONFIG.n_tx_descriptors $libhandle]
@@ -1517,6 +1585,29 @@ proc generate_adapterconfig_include {libhandle} {
 		set ncoalesce [common::get_property CONFIG.n_rx_coalesce $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_COALESCE $ncoalesce"
 		puts $fd ""
+
+		set large_send_mtu [common::get_property CONFIG.axi_large_send_mtu $libhandle]
+		if {$large_send_mtu > 0 && $have_axi_ethernet_dma == 1} {
+			set tx_csum [common::get_property CONFIG.tcp_tx_checksum_offload $libhandle]
+			set tx_full_csum [common::get_property CONFIG.tcp_ip_tx_checksum_offload $libhandle]
+			if {!$tx_csum && !$tx_full_csum} {
+				error "ERROR: axi_large_send_mtu requires TCP Tx checksum offload (partial or full)" "" "MDT_ERROR"
+			}
+			if {$large_send_mtu > 65535} {
+				error "ERROR: axi_large_send_mtu ($large_send_mtu) must not exceed 65535" "" "MDT_ERROR"
+			}
+			puts $fd "\#define XLWIP_CONFIG_TX_LARGE_SEND_MTU $large_send_mtu"
+			puts $fd ""
+		}
+
+		set vlan_id [common::get_property CONFIG.axi_vlan_id $libhandle]
+		if {$vlan_id > 0} {
+			if {$vlan_id > 4094} {
+				error "ERROR: axi_vlan_id ($vlan_id) must not exceed 4094" "" "MDT_ERROR"
+			}
+			puts $fd "\#define XLWIP_CONFIG_AXI_VLAN_ID $vlan_id"
+			puts $fd ""
+		}
 	}
 	if {$have_ps_ethernet == 1} {
 		set emacnum [common::get_property CONFIG.emac_number $libhandle]
@@ -1526,6 +1617,94 @@ proc generate_adapterconfig_include {libhandle} {
 		set ndesc [common::get_property CONFIG.n_rx_descriptors $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_DESC $ndesc"
 		puts $fd ""
+
+		set rx_zero_copy [common::get_property CONFIG.gem_rx_zero_copy $libhandle]
+		if {$rx_zero_copy} {
+			puts $fd "\#define XLWIP_CONFIG_RX_ZERO_COPY 1"
+			set nbufs [common::get_property CONFIG.n_rx_zero_copy_buffers $libhandle]
+			if {$nbufs <= $ndesc} {
+				error "ERROR: n_rx_zero_copy_buffers ($nbufs) must be larger than n_rx_descriptors ($ndesc)" "" "MDT_ERROR"
+			}
+			puts $fd "\#define XLWIP_CONFIG_N_RX_ZC_BUFS $nbufs"
+			puts $fd ""
+		}
+
+		set rx_coalesce [common::get_property CONFIG.gem_rx_coalesce $libhandle]
+		if {$rx_coalesce > 0} {
+			puts $fd "\#define XLWIP_CONFIG_RX_COALESCE $rx_coalesce"
+			puts $fd ""
+		}
+
+		set hw_timestamp [common::get_property CONFIG.gem_hw_timestamp $libhandle]
+		if {$hw_timestamp < 0 || $hw_timestamp > 3} {
+			error "ERROR: gem_hw_timestamp must be between 0 and 3" "" "MDT_ERROR"
+		}
+		if {$hw_timestamp > 0} {
+			puts $fd "\#define XLWIP_CONFIG_HW_TIMESTAMP $hw_timestamp"
+			puts $fd ""
+		}
+
+		set rx_pbuf_cache [common::get_property CONFIG.gem_rx_pbuf_cache $libhandle]
+		if {$rx_pbuf_cache > 0} {
+			if {$rx_zero_copy} {
+				error "ERROR: gem_rx_pbuf_cache is not supported with gem_rx_zero_copy" "" "MDT_ERROR"
+			}
+			if {$rx_pbuf_cache > 256} {
+				error "ERROR: gem_rx_pbuf_cache ($rx_pbuf_cache) must not exceed 256" "" "MDT_ERROR"
+			}
+			puts $fd "\#define XLWIP_CONFIG_N_RX_PBUF_CACHE $rx_pbuf_cache"
+			puts $fd ""
+		}
+
+		set rx_buf_size [common::get_property CONFIG.gem_rx_buf_size $libhandle]
+		if {$rx_buf_size > 0} {
+			set pbuf_pool_bufsize [common::get_property CONFIG.pbuf_pool_bufsize $libhandle]
+			if {$rx_zero_copy} {
+				error "ERROR: gem_rx_buf_size is not supported with gem_rx_zero_copy" "" "MDT_ERROR"
+			}
+			if {[expr $rx_buf_size % 64] != 0 || $rx_buf_size > 16320} {
+				error "ERROR: gem_rx_buf_size ($rx_buf_size) must be a multiple of 64 not larger than 16320" "" "MDT_ERROR"
+			}
+			if {$rx_buf_size > $pbuf_pool_bufsize} {
+				error "ERROR: gem_rx_buf_size ($rx_buf_size) must not be larger than pbuf_pool_bufsize ($pbuf_pool_bufsize)" "" "MDT_ERROR"
+			}
+			puts $fd "\#define XLWIP_CONFIG_RX_BUF_SIZE $rx_buf_size"
+			puts $fd ""
+		}
+	}
+
+	# xxv_ethernet shares the descriptor and coalesce settings of axi_ethernet
+	if {$have_xxv_ethernet == 1 && $have_axi_ethernet == 0} {
+		if {$have_ps_ethernet == 0} {
+			set ndesc [common::get_property CONFIG.n_tx_descriptors $libhandle]
+			puts $fd "\#define XLWIP_CONFIG_N_TX_DESC $ndesc"
+			set ndesc [common::get_property CONFIG.n_rx_descriptors $libhandle]
+			puts $fd "\#define XLWIP_CONFIG_N_RX_DESC $ndesc"
+			puts $fd ""
+		}
+		set ncoalesce [common::get_property CONFIG.n_tx_coalesce $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_N_TX_COALESCE $ncoalesce"
+		set ncoalesce [common::get_property CONFIG.n_rx_coalesce $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_N_RX_COALESCE $ncoalesce"
+		puts $fd ""
+	}
+
+	if {$have_axi_ethernet == 1 || $have_ps_ethernet == 1 || $have_xxv_ethernet == 1} {
+		set poll_budget [common::get_property CONFIG.rx_poll_budget $libhandle]
+		if {$poll_budget > 0} {
+			puts $fd "\#define XLWIP_CONFIG_RX_POLL_BUDGET $poll_budget"
+			puts $fd ""
+		}
+		set netif_stats [common::get_property CONFIG.netif_stats $libhandle]
+		if {$netif_stats} {
+			puts $fd "\#define XLWIP_CONFIG_NETIF_STATS 1"
+			puts $fd ""
+		}
+		set tx_zero_copy [common::get_property CONFIG.tx_zero_copy $libhandle]
+		if {$tx_zero_copy} {
+			puts $fd "\#define XLWIP_CONFIG_TX_ZERO_COPY 1"
+			puts $fd ""
+		}
 	}
 
 	puts $fd "\#endif"
@@ -71,6 +71,14 @@ typedef signed     long long    s64_t;
 
 typedef unsigned long mem_ptr_t;
 
+/* Checksum routines of the port, in xchksum.c */
+#ifdef LWIP_CHKSUM
+u16_t xlwip_chksum(const void *dataptr, int len);
+#endif
+#ifdef LWIP_CHKSUM_COPY
+u16_t xlwip_chksum_copy(void *dst, const void *src, u16_t len);
+#endif
+
 #define PACK_STRUCT_FIELD(x) x
 #define PACK_STRUCT_STRUCT __attribute__((packed))
 #define PACK_STRUCT_BEGIN
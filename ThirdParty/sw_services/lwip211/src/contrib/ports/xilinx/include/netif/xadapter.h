@@ -36,6 +36,7 @@ extern "C" {
 #endif
 
 #include "lwipopts.h"
+#include "xlwipconfig.h"
 
 #if !NO_SYS
 #ifdef OS_IS_XILKERNEL
@@ -49,6 +50,127 @@ extern "C" {
 
 #include "netif/xtopology.h"
 
+/*
+ * RX polling mode: when non zero the receive interrupt only schedules the
+ * input path, which then drains up to this many BDs per pass with the
+ * interrupt masked. Zero keeps the interrupt driven receive path.
+ */
+#ifndef XLWIP_CONFIG_RX_POLL_BUDGET
+#define XLWIP_CONFIG_RX_POLL_BUDGET 0
+#endif
+
+/*
+ * Netif statistics: when non zero every Gem/Axi-Ethernet interface keeps a
+ * struct xemacif_stats, read with xemacif_get_stats(). Zero compiles the
+ * counters out of the data path.
+ */
+#ifndef XLWIP_CONFIG_NETIF_STATS
+#define XLWIP_CONFIG_NETIF_STATS 0
+#endif
+
+/*
+ * Zero-copy TX: when non zero xemacif_tx_ref_alloc() wraps application
+ * memory in a pbuf that the SG DMA reads in place. The application gets its
+ * buffer back through a callback once the frame has been sent.
+ */
+#ifndef XLWIP_CONFIG_TX_ZERO_COPY
+#define XLWIP_CONFIG_TX_ZERO_COPY 0
+#endif
+
+#if XLWIP_CONFIG_TX_ZERO_COPY
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "XLWIP_CONFIG_TX_ZERO_COPY requires LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+
+struct xemacif_tx_ref;
+typedef void (*xemacif_tx_done_fn)(struct xemacif_tx_ref *ref);
+
+/*
+ * Descriptor of one zero-copy TX buffer, owned by the application and left
+ * untouched by it from xemacif_tx_ref_alloc() until done() is called. The
+ * pbuf_custom must stay the first member.
+ */
+struct xemacif_tx_ref {
+	struct pbuf_custom pc;
+	xemacif_tx_done_fn done;	/* called when the stack drops the pbuf */
+	void *arg;			/* application cookie */
+};
+#endif
+
+#if XLWIP_CONFIG_NETIF_STATS
+#if (defined (__arm__) || defined (__aarch64__)) && \
+	(!defined (ARMR5) || defined (SLEEP_TIMER_BASEADDR))
+#include "xtime_l.h"
+/*
+ * RX latency is measured in XTime ticks (COUNTS_PER_SECOND), on Cortex-R5
+ * only when the BSP has a TTC sleep timer
+ */
+#define XEMACIF_STATS_HAVE_TIMER	1
+#endif
+
+/* rx_lat_hist[n] counts frames with a latency in [2^n, 2^(n+1)) ticks */
+#define XEMACIF_STATS_LAT_BUCKETS	24
+
+struct xemacif_stats {
+	u64_t rx_bytes;
+	u64_t tx_bytes;
+	u32_t rx_packets;
+	u32_t tx_packets;
+	u32_t rx_ring_hwm;	/* most RX BDs reclaimed in one pass */
+	u32_t tx_ring_hwm;	/* most TX BDs owned by the DMA at once */
+	u32_t rx_no_buf;	/* RX overrun/buffer not available events */
+	u32_t rx_resets;	/* RX data path resets */
+	u32_t pbuf_alloc_fail;	/* RX buffers that could not be replenished */
+	u32_t rx_csum_offload;	/* frames checksum verified by hardware */
+	u32_t tx_csum_offload;	/* frames checksum inserted by hardware */
+	u32_t rx_coalesced;	/* frames merged into a previous TCP segment */
+	u32_t rx_lat_hist[XEMACIF_STATS_LAT_BUCKETS];	/* RX IRQ to input */
+	u64_t rx_irq_time;	/* timer value at the last RX interrupt */
+	u64_t start_time;	/* timer value when the stats were cleared */
+};
+
+#define XEMACIF_STATS_INC(s, f)		((s)->f++)
+#define XEMACIF_STATS_ADD(s, f, n)	((s)->f += (n))
+#define XEMACIF_STATS_HWM(s, f, n)	do { \
+		if ((u32_t)(n) > (s)->f) \
+			(s)->f = (u32_t)(n); \
+	} while (0)
+#ifdef XEMACIF_STATS_HAVE_TIMER
+#define XEMACIF_STATS_STAMP(s)		do { \
+		XTime stamp_; \
+		XTime_GetTime(&stamp_); \
+		(s)->rx_irq_time = (u64_t)stamp_; \
+	} while (0)
+#define XEMACIF_STATS_RX_LATENCY(s)	xemacif_stats_rx_latency(s)
+#else
+#define XEMACIF_STATS_STAMP(s)
+#define XEMACIF_STATS_RX_LATENCY(s)
+#endif
+#else
+#define XEMACIF_STATS_INC(s, f)
+#define XEMACIF_STATS_ADD(s, f, n)
+#define XEMACIF_STATS_HWM(s, f, n)
+#define XEMACIF_STATS_STAMP(s)
+#define XEMACIF_STATS_RX_LATENCY(s)
+#endif
+
+/*
+ * Trace buffer hooks. With the BSP trace buffer enabled the data path
+ * emits these events with XIL_TRACE(), the argument is given in brackets.
+ */
+#if defined (__arm__) || defined (__aarch64__)
+#include "xil_trace.h"
+#endif
+#ifndef XIL_TRACE
+#define XIL_TRACE(Event, Arg)
+#endif
+
+#define XEMACIF_TRACE_RX_IRQ	0x1100U	/* RX interrupt (status) */
+#define XEMACIF_TRACE_TX_IRQ	0x1101U	/* TX interrupt (status) */
+#define XEMACIF_TRACE_RX_BDS	0x1102U	/* RX BDs reclaimed (count) */
+#define XEMACIF_TRACE_RX_INPUT	0x1103U	/* frame passed to lwIP (length) */
+#define XEMACIF_TRACE_TX_SEND	0x1104U	/* frame given to the DMA (length) */
+
 struct xemac_s {
 	enum xemac_types type;
 	int  topology_index;
@@ -79,6 +201,19 @@ struct netif *	xemac_add(struct netif *netif,
 #if defined (__arm__) || defined (__aarch64__)
 void xemacpsif_resetrx_on_no_rxdata(struct netif *netif);
 #endif
+#if XLWIP_CONFIG_TX_ZERO_COPY
+struct pbuf *	xemacif_tx_ref_alloc(struct xemacif_tx_ref *ref, void *payload,
+	u16_t len, xemacif_tx_done_fn done, void *arg);
+#endif
+#if XLWIP_CONFIG_NETIF_STATS
+s32_t	xemacif_get_stats(struct netif *netif, struct xemacif_stats *stats);
+void	xemacif_clear_stats(struct netif *netif);
+void	xemacif_print_stats(struct netif *netif);
+void	xemacif_stats_reset(struct xemacif_stats *stats);
+#ifdef XEMACIF_STATS_HAVE_TIMER
+void	xemacif_stats_rx_latency(struct xemacif_stats *stats);
+#endif
+#endif
 
 /* global lwip debug variable used for debugging */
 extern int lwip_runtime_debug;
@@ -56,6 +56,27 @@ extern "C" {
 #include "netif/xpqueue.h"
 #include "xlwipconfig.h"
 
+/*
+ * Large send: when non zero the netif reports this MTU to lwIP and cuts TCP
+ * segments longer than the link MTU into link sized frames itself. Only
+ * supported with AXI DMA and TX checksum offload.
+ */
+#ifndef XLWIP_CONFIG_TX_LARGE_SEND_MTU
+#define XLWIP_CONFIG_TX_LARGE_SEND_MTU 0
+#endif
+
+/*
+ * VLAN offload: when non zero the MAC inserts a tag with this VLAN ID in
+ * every transmitted frame and strips it from received frames. Requires a
+ * core built with the extended VLAN functions.
+ */
+#ifndef XLWIP_CONFIG_AXI_VLAN_ID
+#define XLWIP_CONFIG_AXI_VLAN_ID 0
+#endif
+
+/* IPv4 group MAC addresses tracked in the extended multicast table */
+#define XAXIEMACIF_EXT_MCAST_ENTRIES	32
+
 #if XLWIP_CONFIG_INCLUDE_AXIETH_ON_ZYNQ == 1
 #define AXIDMA_TX_INTR_PRIORITY_SET_IN_GIC      0xA0
 #define AXIDMA_RX_INTR_PRIORITY_SET_IN_GIC      0xA0
@@ -74,8 +95,30 @@ unsigned get_IEEE_phy_speed(XAxiEthernet *xaxiemacp);
 unsigned configure_IEEE_phy_speed(XAxiEthernet *xaxiemacp, unsigned speed);
 unsigned phy_setup_axiemac (XAxiEthernet *xaxiemacp);
 
+/* MAC statistics counters, read by xaxiemacif_get_hw_stats() */
+struct xaxiemacif_hw_stats {
+	u64_t rx_bytes;
+	u64_t tx_bytes;
+	u64_t rx_frames;
+	u64_t tx_frames;
+	u64_t rx_broadcast;
+	u64_t rx_multicast;
+	u64_t tx_broadcast;
+	u64_t tx_multicast;
+	u64_t rx_vlan;
+	u64_t rx_pause;
+	u64_t rx_fcs_errors;
+	u64_t rx_length_errors;
+	u64_t rx_undersize;
+	u64_t rx_fragments;
+	u64_t rx_oversize;
+	u64_t tx_underrun;
+};
+
 /* xaxiemacif_hw.c */
 void 	xaxiemac_error_handler(XAxiEthernet * Temac);
+s32_t	xaxiemacif_get_hw_stats(struct netif *netif,
+				struct xaxiemacif_hw_stats *stats);
 
 /* structure within each netif, encapsulating all information required for
  * using a particular temac instance
@@ -97,6 +140,20 @@ typedef struct {
 	/* pointers to memory holding buffer descriptors (used only with SDMA) */
 	void *rx_bdspace;
 	void *tx_bdspace;
+
+#if LWIP_IGMP
+	/* IPv4 groups are filtered in the extended multicast table when set.
+	 * Each table entry passes 256 group MACs, so an entry is only cleared
+	 * once none of the joined MACs maps to it.
+	 */
+	u8_t ext_mcast;
+	u32_t ext_mcast_addr[XAXIEMACIF_EXT_MCAST_ENTRIES];
+	u16_t ext_mcast_refs[XAXIEMACIF_EXT_MCAST_ENTRIES];
+#endif
+
+#if XLWIP_CONFIG_NETIF_STATS
+	struct xemacif_stats stats;
+#endif
 } xaxiemacif_s;
 
 extern xaxiemacif_s xaxiemacif;
@@ -118,6 +175,9 @@ XStatus axi_mcdma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p);
 #else
 XStatus init_axi_dma(struct xemac_s *xemac);
 XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p);
+#if XLWIP_CONFIG_RX_POLL_BUDGET
+s32_t axidma_rx_poll(struct xemac_s *xemac, s32_t budget);
+#endif
 #endif
 #endif
 
@@ -100,6 +100,85 @@ extern "C" {
 
 #define MAX_FRAME_SIZE_JUMBO (XEMACPS_MTU_JUMBO + XEMACPS_HDR_SIZE + XEMACPS_TRL_SIZE)
 
+/*
+ * Zero-copy RX: received frames are passed up in recycled DMA buffers. A
+ * receive callback may keep the pbuf as long as it needs the payload, the
+ * buffer goes back to the RX ring on pbuf_free().
+ */
+#ifndef XLWIP_CONFIG_RX_ZERO_COPY
+#define XLWIP_CONFIG_RX_ZERO_COPY 0
+#endif
+
+#if XLWIP_CONFIG_RX_ZERO_COPY
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "XLWIP_CONFIG_RX_ZERO_COPY requires LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+/* Number of RX buffers per interface, must be larger than the RxBD count */
+#ifndef XLWIP_CONFIG_N_RX_ZC_BUFS
+#define XLWIP_CONFIG_N_RX_ZC_BUFS (2 * XLWIP_CONFIG_N_RX_DESC)
+#endif
+#endif
+
+/*
+ * RX coalescing: when non zero up to this many back to back in-order frames
+ * of one TCP flow are merged into a single segment before entering lwIP.
+ * Relies on the Gem checksum offload, merged segments are not checksummed.
+ */
+#ifndef XLWIP_CONFIG_RX_COALESCE
+#define XLWIP_CONFIG_RX_COALESCE 0
+#endif
+
+#if XLWIP_CONFIG_RX_COALESCE && (CHECKSUM_CHECK_TCP || CHECKSUM_CHECK_IP)
+#error "XLWIP_CONFIG_RX_COALESCE requires Gem RX checksum offload"
+#endif
+
+/*
+ * Hardware timestamps: BD timestamp mode (XEMACPS_TS_MODE_*) of both
+ * directions, 0 disables. A received frame carries its timestamp in the
+ * ts_sec and ts_nsec fields of its pbuf, which the receive callbacks of the
+ * raw API get unchanged. A sent frame is passed, with the same fields set,
+ * to the function installed with xemacpsif_set_tx_timestamp_fn(). Frames
+ * without a timestamp have ts_nsec set to XEMACIF_TS_NONE. The 1588 timer
+ * is started and steered with the XEmacPs_Tsu*() driver functions.
+ */
+#ifndef XLWIP_CONFIG_HW_TIMESTAMP
+#define XLWIP_CONFIG_HW_TIMESTAMP 0
+#endif
+
+#if XLWIP_CONFIG_HW_TIMESTAMP
+#ifndef XPAR_XEMACPS_BD_TIMESTAMP
+#error "XLWIP_CONFIG_HW_TIMESTAMP requires the emacps bd_timestamp parameter"
+#endif
+#define XEMACIF_TS_NONE		0xFFFFFFFFU
+
+/*
+ * Called from the TX completion path, with interrupts disabled, with the
+ * first pbuf of a sent frame. The payload starts at the Ethernet header.
+ */
+typedef void (*xemacpsif_tx_ts_fn)(struct pbuf *p);
+#endif
+
+/*
+ * RX buffer size: when non zero each RxBD gets a PBUF_POOL buffer of this
+ * many bytes instead of one sized for the largest frame. Frames that do not
+ * fit, such as jumbo frames, are received into several BDs and passed up as
+ * a pbuf chain. Must be a multiple of 64 and not larger than
+ * PBUF_POOL_BUFSIZE.
+ */
+#ifndef XLWIP_CONFIG_RX_BUF_SIZE
+#define XLWIP_CONFIG_RX_BUF_SIZE 0
+#endif
+
+#if XLWIP_CONFIG_RX_BUF_SIZE
+#if XLWIP_CONFIG_RX_ZERO_COPY
+#error "XLWIP_CONFIG_RX_BUF_SIZE is not supported with XLWIP_CONFIG_RX_ZERO_COPY"
+#endif
+#if (XLWIP_CONFIG_RX_BUF_SIZE % XEMACPS_RX_BUF_UNIT) || \
+	(XLWIP_CONFIG_RX_BUF_SIZE > PBUF_POOL_BUFSIZE)
+#error "XLWIP_CONFIG_RX_BUF_SIZE must be a multiple of 64 not larger than PBUF_POOL_BUFSIZE"
+#endif
+#endif
+
 void 	xemacpsif_setmac(u32_t index, u8_t *addr);
 u8_t*	xemacpsif_getmac(u32_t index);
 err_t 	xemacpsif_init(struct netif *netif);
@@ -124,6 +203,25 @@ typedef struct {
 
 	unsigned int last_rx_frms_cntr;
 
+#if XLWIP_CONFIG_RX_BUF_SIZE
+	/* frame being received into several BDs */
+	struct pbuf *rx_head;
+	u32_t rx_len;
+#endif
+
+#if XLWIP_CONFIG_N_RX_PBUF_CACHE
+	/* RX pool pbufs taken from the global pool in batches */
+	struct pbuf *rx_pbuf_cache[XLWIP_CONFIG_N_RX_PBUF_CACHE];
+	u16_t rx_pbuf_cache_cnt;
+#endif
+
+#if XLWIP_CONFIG_NETIF_STATS
+	struct xemacif_stats stats;
+#endif
+
+#if XLWIP_CONFIG_HW_TIMESTAMP
+	xemacpsif_tx_ts_fn tx_ts_fn;
+#endif
 } xemacpsif_s;
 
 extern xemacpsif_s xemacpsif;
@@ -138,8 +236,15 @@ void detect_phy(XEmacPs *xemacpsp);
 void emacps_send_handler(void *arg);
 XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p);
 void emacps_recv_handler(void *arg);
+#if XLWIP_CONFIG_RX_POLL_BUDGET
+s32_t emacps_rx_poll(struct xemac_s *xemac, s32_t budget);
+#endif
 void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord);
 void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring);
+#if XLWIP_CONFIG_HW_TIMESTAMP
+XEmacPs *xemacpsif_get_emacps(struct netif *netif);
+void xemacpsif_set_tx_timestamp_fn(struct netif *netif, xemacpsif_tx_ts_fn fn);
+#endif
 void HandleTxErrors(struct xemac_s *xemac);
 void HandleEmacPsError(struct xemac_s *xemac);
 XEmacPs_Config *xemacps_lookup_config(unsigned mac_base);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2019 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#ifndef __NETIF_XXXVETHERNETIF_H__
+#define __NETIF_XXXVETHERNETIF_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "xlwipconfig.h"
+#include "lwip/netif.h"
+#include "netif/etharp.h"
+#include "netif/xadapter.h"
+
+#include "xparameters.h"
+#include "xstatus.h"
+
+#include "xxxvethernet.h"
+#include "xmcdma.h"
+
+/* MCDMA channels handled per interface, one RX queue each */
+#define XXXVETHIF_MAX_CHANS	16
+
+/*
+ * Depth of the queue between the RX interrupt and the input path of each
+ * channel, must be a power of two. Frames arriving on a full queue are
+ * dropped.
+ */
+#ifndef XLWIP_CONFIG_XXV_RXQ_SIZE
+#define XLWIP_CONFIG_XXV_RXQ_SIZE 512
+#endif
+
+#if (XLWIP_CONFIG_XXV_RXQ_SIZE & (XLWIP_CONFIG_XXV_RXQ_SIZE - 1)) != 0
+#error "XLWIP_CONFIG_XXV_RXQ_SIZE must be a power of two"
+#endif
+
+/* received frames of one MCDMA S2MM channel */
+struct xxxvethernetif_rxq {
+	struct pbuf *p[XLWIP_CONFIG_XXV_RXQ_SIZE];
+	u32_t head, tail;	/* free running, written by ISR/input path */
+};
+
+/* structure within each netif, encapsulating all information required for
+ * using a particular xxv ethernet instance
+ */
+typedef struct {
+	XMcdma       aximcdma;
+	XXxvEthernet xxv_ethernet;
+
+	/* one queue per RX channel, indexed by ChanId - 1 */
+	struct xxxvethernetif_rxq *recv_q;
+	u32_t n_chans;
+
+#if !NO_SYS
+	/* channels drained by their own thread, see
+	 * xxxvethernetif_input_chan_thread() */
+	u32_t rx_chan_threads;
+	sys_sem_t sem_rx_chan[XXXVETHIF_MAX_CHANS];
+#endif
+
+	/* pointers to memory holding buffer descriptors */
+	void *rx_bdspace;
+	void *tx_bdspace;
+
+#if XLWIP_CONFIG_NETIF_STATS
+	struct xemacif_stats stats;
+#endif
+} xxxvethernetif_s;
+
+err_t	xxxvethernetif_init(struct netif *netif);
+int	xxxvethernetif_input(struct netif *netif);
+int	xxxvethernetif_input_chan(struct netif *netif, u32_t chan);
+#if !NO_SYS
+void	xxxvethernetif_input_chan_thread(struct netif *netif, u32_t chan);
+#endif
+
+/* xxxvethernetif_mcdma.c */
+XStatus	init_xxv_mcdma(struct xemac_s *xemac);
+XStatus	xxv_mcdma_sgsend(xxxvethernetif_s *xxxvethernetif, struct pbuf *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NETIF_XXXVETHERNETIF_H__ */
@@ -28,6 +28,8 @@
  *
  */
 
+#include <string.h>
+
 #include "lwipopts.h"
 #include "xlwipconfig.h"
 #include "xemac_ieee_reg.h"
@@ -62,6 +64,11 @@
 #include "netif/xemacpsif.h"
 #endif
 
+#ifdef XLWIP_CONFIG_INCLUDE_XXV_ETHERNET
+#include "netif/xxxvethernetif.h"
+#include "xxxvethernet_hw.h"
+#endif
+
 #if !NO_SYS
 #include "lwip/tcpip.h"
 #endif
@@ -188,6 +195,18 @@ xemac_add(struct netif *netif,
 
 						);
 #endif
+#endif
+#ifdef XLWIP_CONFIG_INCLUDE_XXV_ETHERNET
+			case xemac_type_xxv_ethernet:
+				return netif_add(netif, ipaddr, netmask, gw,
+					(void*)(UINTPTR)mac_baseaddr,
+					xxxvethernetif_init,
+#if NO_SYS
+					ethernet_input
+#else
+					tcpip_input
+#endif
+					);
 #endif
 			default:
 				xil_printf("unable to determine type of EMAC with baseaddress 0x%08x\r\n",
@@ -255,6 +274,15 @@ xemacif_input(struct netif *netif)
 			while(1);
 			return 0;
 #endif
+#endif
+		case xemac_type_xxv_ethernet:
+#ifdef XLWIP_CONFIG_INCLUDE_XXV_ETHERNET
+			n_packets = xxxvethernetif_input(netif);
+			break;
+#else
+			print("incorrect configuration: xxv_ethernet drivers not present?");
+			while(1);
+			return 0;
 #endif
 		default:
 			print("incorrect configuration: unknown temac type");
@@ -265,6 +293,203 @@ xemacif_input(struct netif *netif)
 	return n_packets;
 }
 
+#if XLWIP_CONFIG_TX_ZERO_COPY
+static void xemacif_tx_ref_free(struct pbuf *p)
+{
+	struct xemacif_tx_ref *ref = (struct xemacif_tx_ref *)p;
+
+	if (ref->done != NULL)
+		ref->done(ref);
+}
+
+/*
+ * xemacif_tx_ref_alloc():
+ *
+ * Wraps len bytes of application memory at payload in a PBUF_REF pbuf for
+ * udp_send()/udp_sendto(). lwIP chains its own header pbuf in front, the
+ * Gem and AXI DMA SG paths point a BD at payload directly and only flush
+ * the data cache over it, so nothing is copied. done(ref) is called when
+ * the last reference is dropped, i.e. after the application has called
+ * pbuf_free() and the DMA has sent the frame. It runs in the TX completion
+ * path, usually interrupt context, and must only hand the buffer back.
+ *
+ * The buffer should be cache line aligned and a multiple of the cache
+ * line size, so that flushing it never writes back a neighbour. Frames for
+ * the Emaclite are copied by the driver and done() is called on return
+ * from udp_send().
+ *
+ * Returns the pbuf, or NULL if len is zero.
+ */
+struct pbuf *
+xemacif_tx_ref_alloc(struct xemacif_tx_ref *ref, void *payload, u16_t len,
+		xemacif_tx_done_fn done, void *arg)
+{
+	if (ref == NULL || payload == NULL || len == 0)
+		return NULL;
+
+	ref->pc.custom_free_function = xemacif_tx_ref_free;
+	ref->done = done;
+	ref->arg = arg;
+
+	return pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF, &ref->pc,
+			payload, len);
+}
+#endif
+
+#if XLWIP_CONFIG_NETIF_STATS
+static struct xemacif_stats *xemacif_stats_of(struct netif *netif)
+{
+	struct xemac_s *emac = (struct xemac_s *)netif->state;
+
+	switch (emac->type) {
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET
+		case xemac_type_axi_ethernet:
+			return &((xaxiemacif_s *)emac->state)->stats;
+#endif
+#ifdef XLWIP_CONFIG_INCLUDE_GEM
+		case xemac_type_emacps:
+			return &((xemacpsif_s *)emac->state)->stats;
+#endif
+#ifdef XLWIP_CONFIG_INCLUDE_XXV_ETHERNET
+		case xemac_type_xxv_ethernet:
+			return &((xxxvethernetif_s *)emac->state)->stats;
+#endif
+		default:
+			return NULL;
+	}
+}
+
+void xemacif_stats_reset(struct xemacif_stats *stats)
+{
+#ifdef XEMACIF_STATS_HAVE_TIMER
+	XTime now;
+#endif
+
+	memset(stats, 0, sizeof *stats);
+#ifdef XEMACIF_STATS_HAVE_TIMER
+	XTime_GetTime(&now);
+	stats->start_time = (u64_t)now;
+	stats->rx_irq_time = stats->start_time;
+#endif
+}
+
+#ifdef XEMACIF_STATS_HAVE_TIMER
+/*
+ * xemacif_stats_rx_latency():
+ *
+ * Called with the interface protected for every frame handed to lwIP.
+ * Adds the time elapsed since the last RX interrupt to the log2 histogram.
+ */
+void xemacif_stats_rx_latency(struct xemacif_stats *stats)
+{
+	XTime now;
+	u64_t delta;
+	u32_t bucket = 0;
+
+	XTime_GetTime(&now);
+	/* XTime is 32 bit on Cortex-R5, subtract in its width to wrap */
+	delta = (u64_t)(XTime)(now - (XTime)stats->rx_irq_time);
+	while (((delta >>= 1) != 0) && (bucket < XEMACIF_STATS_LAT_BUCKETS - 1))
+		bucket++;
+	stats->rx_lat_hist[bucket]++;
+}
+#endif
+
+/*
+ * xemacif_get_stats():
+ *
+ * Copies a consistent snapshot of the interface statistics to 'stats'.
+ * Returns 0 on success, -1 if the interface keeps no statistics.
+ */
+s32_t
+xemacif_get_stats(struct netif *netif, struct xemacif_stats *stats)
+{
+	struct xemacif_stats *s = xemacif_stats_of(netif);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (s == NULL)
+		return -1;
+
+	SYS_ARCH_PROTECT(lev);
+	*stats = *s;
+	SYS_ARCH_UNPROTECT(lev);
+
+	return 0;
+}
+
+void
+xemacif_clear_stats(struct netif *netif)
+{
+	struct xemacif_stats *s = xemacif_stats_of(netif);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (s == NULL)
+		return;
+
+	SYS_ARCH_PROTECT(lev);
+	xemacif_stats_reset(s);
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+/*
+ * xemacif_print_stats():
+ *
+ * Prints the interface statistics. Packet rates are averaged over the time
+ * since the statistics were last cleared.
+ */
+void
+xemacif_print_stats(struct netif *netif)
+{
+	struct xemacif_stats s;
+	u32_t i;
+#ifdef XEMACIF_STATS_HAVE_TIMER
+	XTime now;
+	u64_t ms;
+#endif
+
+	if (xemacif_get_stats(netif, &s) < 0) {
+		xil_printf("netif stats not available for this interface\r\n");
+		return;
+	}
+
+	xil_printf("netif %c%c%d statistics:\r\n", netif->name[0],
+			netif->name[1], netif->num);
+	xil_printf("  rx %d packets %d KBytes, tx %d packets %d KBytes\r\n",
+			s.rx_packets, (u32_t)(s.rx_bytes >> 10),
+			s.tx_packets, (u32_t)(s.tx_bytes >> 10));
+#ifdef XEMACIF_STATS_HAVE_TIMER
+	XTime_GetTime(&now);
+	ms = (u64_t)(XTime)(now - (XTime)s.start_time) /
+			(COUNTS_PER_SECOND / 1000);
+	if (ms) {
+		xil_printf("  rx %d pps, tx %d pps over %d ms\r\n",
+				(u32_t)((u64_t)s.rx_packets * 1000 / ms),
+				(u32_t)((u64_t)s.tx_packets * 1000 / ms), (u32_t)ms);
+	}
+#endif
+	xil_printf("  ring high-water rx %d tx %d BDs\r\n",
+			s.rx_ring_hwm, s.tx_ring_hwm);
+	xil_printf("  rx no buffer %d, rx resets %d, pbuf alloc failures %d\r\n",
+			s.rx_no_buf, s.rx_resets, s.pbuf_alloc_fail);
+	xil_printf("  checksum offload rx %d tx %d\r\n",
+			s.rx_csum_offload, s.tx_csum_offload);
+	if (s.rx_coalesced)
+		xil_printf("  rx frames coalesced into TCP segments %d\r\n",
+				s.rx_coalesced);
+#ifdef XEMACIF_STATS_HAVE_TIMER
+	xil_printf("  rx irq to input latency, %d ticks per us:\r\n",
+			(u32_t)(COUNTS_PER_SECOND / 1000000));
+	for (i = 0; i < XEMACIF_STATS_LAT_BUCKETS; i++) {
+		if (s.rx_lat_hist[i])
+			xil_printf("    < 2^%d ticks: %d\r\n", i + 1,
+					s.rx_lat_hist[i]);
+	}
+#else
+	LWIP_UNUSED_ARG(i);
+#endif
+}
+#endif
+
 #if defined(XLWIP_CONFIG_INCLUDE_GEM)
 static u32_t phy_link_detect(XEmacPs *xemacp, u32_t phy_addr)
 {
@@ -310,6 +535,20 @@ static u32_t phy_link_detect(XEmacLite *xemacp, u32_t phy_addr)
 		return 1;
 	return 0;
 }
+#elif defined(XLWIP_CONFIG_INCLUDE_XXV_ETHERNET)
+static u32_t phy_link_detect(XXxvEthernet *xemacp, u32_t phy_addr)
+{
+	LWIP_UNUSED_ARG(phy_addr);
+
+	/* The block lock bit is sticky low, read it twice to get the
+	 * current status.
+	 */
+	XXxvEthernet_ReadReg(xemacp->Config.BaseAddress, XXE_RXBLSR_OFFSET);
+	if (XXxvEthernet_ReadReg(xemacp->Config.BaseAddress,
+				 XXE_RXBLSR_OFFSET) & XXE_RXBLKLCK_MASK)
+		return 1;
+	return 0;
+}
 #endif
 
 #if defined(XLWIP_CONFIG_INCLUDE_GEM)
@@ -357,6 +596,15 @@ static u32_t phy_autoneg_status(XEmacLite *xemacp, u32_t phy_addr)
 		return 1;
 	return 0;
 }
+#elif defined(XLWIP_CONFIG_INCLUDE_XXV_ETHERNET)
+static u32_t phy_autoneg_status(XXxvEthernet *xemacp, u32_t phy_addr)
+{
+	LWIP_UNUSED_ARG(xemacp);
+	LWIP_UNUSED_ARG(phy_addr);
+
+	/* no PHY, the link is up once the receiver has block lock */
+	return 1;
+}
 #endif
 
 void eth_link_detect(struct netif *netif)
@@ -373,6 +621,9 @@ void eth_link_detect(struct netif *netif)
 #elif defined(XLWIP_CONFIG_INCLUDE_EMACLITE)
 	xemacliteif_s *xemacs = (xemacliteif_s *)(xemac->state);
 	XEmacLite *xemacp = xemacs->instance;
+#elif defined(XLWIP_CONFIG_INCLUDE_XXV_ETHERNET)
+	xxxvethernetif_s *xemacs = (xxxvethernetif_s *)(xemac->state);
+	XXxvEthernet *xemacp = &xemacs->xxv_ethernet;
 #endif
 
 	if ((xemacp->IsReady != (u32)XIL_COMPONENT_IS_READY) ||
@@ -109,6 +109,9 @@ static err_t _unbuffered_low_level_output(xaxiemacif_s *xaxiemacif,
 #if LINK_STATS
 		lwip_stats.link.drop++;
 #endif
+	} else {
+		XEMACIF_STATS_INC(&xaxiemacif->stats, tx_packets);
+		XEMACIF_STATS_ADD(&xaxiemacif->stats, tx_bytes, p->tot_len);
 	}
 
 #if ETH_PAD_SIZE
@@ -199,6 +202,10 @@ static struct pbuf *low_level_input(struct netif *netif)
 
 	/* return one packet from receive q */
 	p = (struct pbuf *)pq_dequeue(xaxiemacif->recv_q);
+	XEMACIF_STATS_INC(&xaxiemacif->stats, rx_packets);
+	XEMACIF_STATS_ADD(&xaxiemacif->stats, rx_bytes, p->tot_len);
+	XEMACIF_STATS_RX_LATENCY(&xaxiemacif->stats);
+	XIL_TRACE(XEMACIF_TRACE_RX_INPUT, p->tot_len);
 	return p;
 }
 
@@ -236,6 +243,17 @@ int xaxiemacif_input(struct netif *netif)
 	struct eth_hdr *ethhdr;
 	struct pbuf *p;
 	SYS_ARCH_DECL_PROTECT(lev);
+#if XLWIP_CONFIG_RX_POLL_BUDGET && defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA)
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	s32_t n_polled = 0;
+
+	/* pull the next batch off the ring once the previous one is consumed */
+	if (pq_qlength(xaxiemacif->recv_q) == 0) {
+		n_polled = axidma_rx_poll(xemac, XLWIP_CONFIG_RX_POLL_BUDGET);
+	}
+	LWIP_UNUSED_ARG(n_polled);
+#endif
 
 #if !NO_SYS
 	while (1)
@@ -247,8 +265,15 @@ int xaxiemacif_input(struct netif *netif)
 		SYS_ARCH_UNPROTECT(lev);
 
 		/* no packet could be read, silently ignore this */
-		if (p == NULL)
+		if (p == NULL) {
+#if XLWIP_CONFIG_RX_POLL_BUDGET && defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA) && !NO_SYS
+			/* budget exhausted, ring may not be empty: come back */
+			if (n_polled >= XLWIP_CONFIG_RX_POLL_BUDGET) {
+				sys_sem_signal(&xemac->sem_rx_data_available);
+			}
+#endif
 			return 0;
+		}
 
 		/* points to packet payload, which starts with an Ethernet header */
 		ethhdr = p->payload;
@@ -315,12 +340,21 @@ static err_t low_level_init(struct netif *netif)
 	if (!xaxiemacif->recv_q)
 		return ERR_MEM;
 
+#if XLWIP_CONFIG_NETIF_STATS
+	xemacif_stats_reset(&xaxiemacif->stats);
+#endif
+
 	/* maximum transfer unit */
 #ifdef USE_JUMBO_FRAMES
 	netif->mtu = XAE_JUMBO_MTU - XAE_HDR_SIZE;
 #else
 	netif->mtu = XAE_MTU - XAE_HDR_SIZE;
 #endif
+#if XLWIP_CONFIG_TX_LARGE_SEND_MTU && defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA)
+	/* TCP segments up to this size are cut to the link MTU in
+	 * axidma_sgsend() */
+	netif->mtu = XLWIP_CONFIG_TX_LARGE_SEND_MTU;
+#endif
 
 #if LWIP_IGMP
 	netif->igmp_mac_filter = xaxiemacif_mac_filter_update;
@@ -504,6 +538,78 @@ xaxiemacif_mld6_mac_filter_update (struct netif *netif, ip_addr_t *group,
 #endif
 
 #if LWIP_IGMP
+static err_t
+xaxiemacif_ext_mcast_update (xaxiemacif_s *xaxiemacif, u8_t *ip_addr_temp,
+								u8_t action)
+{
+	u8_t multicast_mac_addr[6];
+	u32_t addr;
+	int free_entry = -1;
+	int i;
+
+	if ((ip_addr_temp[0] < 224) || (ip_addr_temp[0] > 239))
+		return ERR_ARG;
+
+	multicast_mac_addr[0] = 0x01;
+	multicast_mac_addr[1] = 0x00;
+	multicast_mac_addr[2] = 0x5E;
+	multicast_mac_addr[3] = ip_addr_temp[1] & 0x7F;
+	multicast_mac_addr[4] = ip_addr_temp[2];
+	multicast_mac_addr[5] = ip_addr_temp[3];
+	addr = (multicast_mac_addr[3] << 16) | (multicast_mac_addr[4] << 8) |
+						multicast_mac_addr[5];
+
+	for (i = 0; i < XAXIEMACIF_EXT_MCAST_ENTRIES; i++) {
+		if (xaxiemacif->ext_mcast_refs[i] == 0) {
+			if (free_entry < 0)
+				free_entry = i;
+		} else if (xaxiemacif->ext_mcast_addr[i] == addr) {
+			break;
+		}
+	}
+
+	if (action == IGMP_ADD_MAC_FILTER) {
+		if (i < XAXIEMACIF_EXT_MCAST_ENTRIES) {
+			/* Several IPv4 groups share one MAC */
+			xaxiemacif->ext_mcast_refs[i]++;
+			return ERR_OK;
+		}
+		if (free_entry < 0) {
+			LWIP_DEBUGF(NETIF_DEBUG,
+			("xaxiemacif_ext_mcast_update: No multicast entries left.\r\n"));
+			return ERR_MEM;
+		}
+		xaxiemacif->ext_mcast_addr[free_entry] = addr;
+		xaxiemacif->ext_mcast_refs[free_entry] = 1;
+
+		XAxiEthernet_Stop(&xaxiemacif->axi_ethernet);
+		XAxiEthernet_AddExtMulticastGroup(&xaxiemacif->axi_ethernet,
+							multicast_mac_addr);
+		XAxiEthernet_Start(&xaxiemacif->axi_ethernet);
+		return ERR_OK;
+	}
+
+	if (i == XAXIEMACIF_EXT_MCAST_ENTRIES)
+		return ERR_MEM;
+	if (--xaxiemacif->ext_mcast_refs[i] != 0)
+		return ERR_OK;
+
+	/* The table entry is shared by the MACs which only differ in their
+	 * last byte, keep it while any of them is still joined.
+	 */
+	for (i = 0; i < XAXIEMACIF_EXT_MCAST_ENTRIES; i++) {
+		if ((xaxiemacif->ext_mcast_refs[i] != 0) &&
+			((xaxiemacif->ext_mcast_addr[i] >> 8) == (addr >> 8)))
+			return ERR_OK;
+	}
+
+	XAxiEthernet_Stop(&xaxiemacif->axi_ethernet);
+	XAxiEthernet_ClearExtMulticastGroup(&xaxiemacif->axi_ethernet,
+							multicast_mac_addr);
+	XAxiEthernet_Start(&xaxiemacif->axi_ethernet);
+	return ERR_OK;
+}
+
 static err_t
 xaxiemacif_mac_filter_update (struct netif *netif, ip_addr_t *group,
 								u8_t action)
@@ -518,6 +624,10 @@ xaxiemacif_mac_filter_update (struct netif *netif, ip_addr_t *group,
 	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
 	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
 
+	if (xaxiemacif->ext_mcast)
+		return xaxiemacif_ext_mcast_update(xaxiemacif, ip_addr_temp,
+								action);
+
 	if (action == IGMP_ADD_MAC_FILTER) {
 		if ((ip_addr_temp[0] >= 224) && (ip_addr_temp[0] <= 239)) {
 			if (xaxiemac_mcast_entry_mask >= 0x0F) {
@@ -45,6 +45,9 @@
 
 #include "lwip/stats.h"
 #include "lwip/inet_chksum.h"
+#if XLWIP_CONFIG_TX_LARGE_SEND_MTU
+#include "lwip/prot/tcp.h"
+#endif
 
 #include "netif/xadapter.h"
 #include "netif/xaxiemacif.h"
@@ -78,11 +81,41 @@
 		Xil_DCacheInvalidateRange((u32)data, length)
 #endif
 
+/* The TX fragments of a frame are flushed as one batch with a single dsb */
+#include "xil_cache_batch.h"
+#define XCACHE_FLUSH_BATCH_INIT(batch)	\
+		Xil_DCacheBatchInit(&(batch), XIL_DCACHE_BATCH_FLUSH)
+#define XCACHE_FLUSH_BATCH_ADD(batch, data, length)	\
+		Xil_DCacheBatchAdd(&(batch), (INTPTR)(data), length)
+#define XCACHE_FLUSH_BATCH_COMMIT(batch)	\
+		Xil_DCacheBatchCommit(&(batch))
+#else
+#define XCACHE_FLUSH_BATCH_INIT(batch)
+#define XCACHE_FLUSH_BATCH_ADD(batch, data, length)	\
+		XCACHE_FLUSH_DCACHE_RANGE(data, length)
+#define XCACHE_FLUSH_BATCH_COMMIT(batch)
 #endif
 
 /* Byte alignment of BDs */
 #define BD_ALIGNMENT (XAXIDMA_BD_MINIMUM_ALIGNMENT*2)
 
+#if XLWIP_CONFIG_TX_LARGE_SEND_MTU
+#if LWIP_FULL_CSUM_OFFLOAD_TX != 1 && LWIP_PARTIAL_CSUM_OFFLOAD_TX != 1
+#error "XLWIP_CONFIG_TX_LARGE_SEND_MTU requires TX checksum offload"
+#endif
+
+/* IP MTU of the link; large send frames are cut to this size */
+#ifdef USE_JUMBO_FRAMES
+#define AXIDMA_WIRE_MTU	(XAE_JUMBO_MTU - XAE_HDR_SIZE)
+#else
+#define AXIDMA_WIRE_MTU	(XAE_MTU - XAE_HDR_SIZE)
+#endif
+
+/* frames per large send, for the smallest MSS (60 byte IP and TCP headers) */
+#define LARGE_SEND_MAX_SEGS	\
+	(XLWIP_CONFIG_TX_LARGE_SEND_MTU / (AXIDMA_WIRE_MTU - 120) + 1)
+#endif
+
 #if XPAR_INTC_0_HAS_FAST == 1
 /*********** Function Prototypes *********************************************/
 /*
@@ -270,6 +303,7 @@ static void axidma_send_handler(void *arg)
 
 	/* Acknowledge pending interrupts */
 	XAxiDma_BdRingAckIrq(txringptr, irq_status);
+	XIL_TRACE(XEMACIF_TRACE_TX_IRQ, irq_status);
 
 	/* If error interrupt is asserted, raise error flag, reset the
 	 * hardware to recover from the error, and return with no further
@@ -296,7 +330,7 @@ static void axidma_send_handler(void *arg)
 #endif
 }
 
-static void setup_rx_bds(XAxiDma_BdRing *rxring)
+static void setup_rx_bds(xaxiemacif_s *xaxiemacif, XAxiDma_BdRing *rxring)
 {
 	XAxiDma_Bd *rxbd;
 	s32_t n_bds;
@@ -317,6 +351,7 @@ static void setup_rx_bds(XAxiDma_BdRing *rxring)
 			lwip_stats.link.memerr++;
 			lwip_stats.link.drop++;
 #endif
+			XEMACIF_STATS_INC(&xaxiemacif->stats, pbuf_alloc_fail);
 			printf("unable to alloc pbuf in recv_handler\r\n");
 			return;
 		}
@@ -364,11 +399,83 @@ static void setup_rx_bds(XAxiDma_BdRing *rxring)
 	}
 }
 
-static void axidma_recv_handler(void *arg)
+/*
+ * axidma_process_rx_bds():
+ *
+ * Reclaims up to 'budget' received BDs with a single XAxiDma_BdRingFromHw()
+ * call, queues the frames on recv_q, frees the BDs with one
+ * XAxiDma_BdRingFree() call and refills the ring.
+ * Returns the number of BDs processed.
+ */
+static u32 axidma_process_rx_bds(xaxiemacif_s *xaxiemacif, u32 budget)
 {
 	struct pbuf *p;
-	u32 irq_status, i, timeOut;
+	u32 i;
+	u32 bd_processed;
+	u32 rx_bytes;
 	XAxiDma_Bd *rxbd, *rxbdset;
+	XAxiDma_BdRing *rxring;
+
+	rxring = XAxiDma_GetRxRing(&xaxiemacif->axidma);
+
+	bd_processed = XAxiDma_BdRingFromHw(rxring, budget, &rxbdset);
+	if (bd_processed == 0) {
+		return 0;
+	}
+	XEMACIF_STATS_HWM(&xaxiemacif->stats, rx_ring_hwm, bd_processed);
+	XIL_TRACE(XEMACIF_TRACE_RX_BDS, bd_processed);
+
+	for (i = 0, rxbd = rxbdset; i < bd_processed; i++) {
+		p = (struct pbuf *)(UINTPTR)XAxiDma_BdGetId(rxbd);
+		/* Adjust the buffer size to the actual number of bytes received.*/
+		rx_bytes = extract_packet_len(rxbd);
+		pbuf_realloc(p, rx_bytes);
+
+#ifdef USE_JUMBO_FRAMES
+#ifndef __aarch64__
+		XCACHE_INVALIDATE_DCACHE_RANGE(p->payload,
+						XAE_MAX_JUMBO_FRAME_SIZE);
+#endif
+#else
+#ifndef __aarch64__
+		XCACHE_INVALIDATE_DCACHE_RANGE(p->payload, XAE_MAX_FRAME_SIZE);
+#endif
+#endif
+
+#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
+		/* Verify for partial checksum offload case */
+		if (!is_checksum_valid(rxbd, p)) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("Incorrect csum as calculated by the hw\r\n"));
+		} else {
+			XEMACIF_STATS_INC(&xaxiemacif->stats, rx_csum_offload);
+		}
+#elif LWIP_FULL_CSUM_OFFLOAD_RX==1
+		XEMACIF_STATS_INC(&xaxiemacif->stats, rx_csum_offload);
+#endif
+		/* store it in the receive queue,
+		 * where it'll be processed by a different handler
+		 */
+		if (pq_enqueue(xaxiemacif->recv_q, (void*)p) < 0) {
+#if LINK_STATS
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
+#endif
+			pbuf_free(p);
+		}
+		rxbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(rxring, rxbd);
+	}
+	/* free up the BD's */
+	XAxiDma_BdRingFree(rxring, bd_processed, rxbdset);
+	/* return all the processed bd's back to the stack */
+	/* setup_rx_bds -> use XAxiDma_BdRingGetFreeCnt */
+	setup_rx_bds(xaxiemacif, rxring);
+
+	return bd_processed;
+}
+
+static void axidma_recv_handler(void *arg)
+{
+	u32 irq_status, timeOut;
 	struct xemac_s *xemac;
 	xaxiemacif_s *xaxiemacif;
 	XAxiDma_BdRing *rxring;
@@ -380,6 +487,7 @@ static void axidma_recv_handler(void *arg)
 	xemac = (struct xemac_s *)(arg);
 	xaxiemacif = (xaxiemacif_s *)(xemac->state);
 	rxring = XAxiDma_GetRxRing(&xaxiemacif->axidma);
+	XEMACIF_STATS_STAMP(&xaxiemacif->stats);
 
 	XAxiDma_BdRingIntDisable(rxring, XAXIDMA_IRQ_ALL_MASK);
 
@@ -388,16 +496,18 @@ static void axidma_recv_handler(void *arg)
 
 	/* Acknowledge pending interrupts */
 	XAxiDma_BdRingAckIrq(rxring, irq_status);
+	XIL_TRACE(XEMACIF_TRACE_RX_IRQ, irq_status);
 
 	/* If error interrupt is asserted, raise error flag, reset the
 	 * hardware to recover from the error, and return with no further
 	 * processing.
 	 */
 	if ((irq_status & XAXIDMA_IRQ_ERROR_MASK)) {
-		setup_rx_bds(rxring);
+		setup_rx_bds(xaxiemacif, rxring);
 		xil_printf("%s: Error: axidma error interrupt is asserted\r\n",
 			__FUNCTION__);
 		XAxiDma_Reset(&xaxiemacif->axidma);
+		XEMACIF_STATS_INC(&xaxiemacif->stats, rx_resets);
 		timeOut = 10000;
 		while (timeOut) {
 			if (XAxiDma_ResetIsDone(&xaxiemacif->axidma)) {
@@ -416,53 +526,25 @@ static void axidma_recv_handler(void *arg)
 	 * to handle the processed BDs and then raise the according flag.
 	 */
 	if (irq_status & (XAXIDMA_IRQ_DELAY_MASK | XAXIDMA_IRQ_IOC_MASK)) {
-		u32 bd_processed;
-		u32 rx_bytes;
-
-		bd_processed = XAxiDma_BdRingFromHw(rxring, XAXIDMA_ALL_BDS, &rxbdset);
-
-		for (i = 0, rxbd = rxbdset; i < bd_processed; i++) {
-			p = (struct pbuf *)(UINTPTR)XAxiDma_BdGetId(rxbd);
-			/* Adjust the buffer size to the actual number of bytes received.*/
-			rx_bytes = extract_packet_len(rxbd);
-			pbuf_realloc(p, rx_bytes);
-
-#ifdef USE_JUMBO_FRAMES
-#ifndef __aarch64__
-			XCACHE_INVALIDATE_DCACHE_RANGE(p->payload,
-							XAE_MAX_JUMBO_FRAME_SIZE);
-#endif
-#else
-#ifndef __aarch64__
-			XCACHE_INVALIDATE_DCACHE_RANGE(p->payload, XAE_MAX_FRAME_SIZE);
-#endif
-#endif
-
-#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
-			/* Verify for partial checksum offload case */
-			if (!is_checksum_valid(rxbd, p)) {
-				LWIP_DEBUGF(NETIF_DEBUG, ("Incorrect csum as calculated by the hw\r\n"));
-			}
+#if XLWIP_CONFIG_RX_POLL_BUDGET
+		/*
+		 * Polling mode: leave the completion interrupts masked, only
+		 * the error interrupt stays armed. axidma_rx_poll() unmasks
+		 * them once it finds the ring empty.
+		 */
+		XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ERROR_MASK);
+#if !NO_SYS
+		sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
-			/* store it in the receive queue,
-			 * where it'll be processed by a different handler
-			 */
-			if (pq_enqueue(xaxiemacif->recv_q, (void*)p) < 0) {
-#if LINK_STATS
-				lwip_stats.link.memerr++;
-				lwip_stats.link.drop++;
+#ifdef OS_IS_FREERTOS
+		xInsideISR--;
 #endif
-				pbuf_free(p);
-			}
-			rxbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(rxring, rxbd);
-		}
-		/* free up the BD's */
-		XAxiDma_BdRingFree(rxring, bd_processed, rxbdset);
-		/* return all the processed bd's back to the stack */
-		/* setup_rx_bds -> use XAxiDma_BdRingGetFreeCnt */
-		setup_rx_bds(rxring);
+		return;
+#else
+		axidma_process_rx_bds(xaxiemacif, XAXIDMA_ALL_BDS);
 #if !NO_SYS
 		sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
 #endif
 	}
 	XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
@@ -472,6 +554,34 @@ static void axidma_recv_handler(void *arg)
 
 }
 
+#if XLWIP_CONFIG_RX_POLL_BUDGET
+/*
+ * axidma_rx_poll():
+ *
+ * Drains up to 'budget' received frames onto recv_q in one pass and unmasks
+ * the completion interrupts once the ring has been found empty. Completions
+ * in between are latched in the channel status register, so unmasking
+ * raises the interrupt immediately if more frames arrived.
+ * Returns the number of frames moved to recv_q.
+ */
+s32_t axidma_rx_poll(struct xemac_s *xemac, s32_t budget)
+{
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	XAxiDma_BdRing *rxring = XAxiDma_GetRxRing(&xaxiemacif->axidma);
+	s32_t n_frames;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	n_frames = (s32_t)axidma_process_rx_bds(xaxiemacif, (u32)budget);
+	if (n_frames < budget) {
+		XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	return n_frames;
+}
+#endif
+
 s32_t is_tx_space_available(xaxiemacif_s *emac)
 {
 	XAxiDma_BdRing *txring;
@@ -501,6 +611,218 @@ s32_t process_sent_bds(XAxiDma_BdRing *txring)
 	return (XAxiDma_BdRingFree(txring, n_bds, txbdset));
 }
 
+#if XLWIP_CONFIG_TX_LARGE_SEND_MTU
+/* pseudo header checksum of a TCP segment, in the form returned by
+ * inet_chksum_pseudo()
+ */
+static u16_t large_send_pseudo_csum(struct ip_hdr *iph, u16_t tcp_len)
+{
+	u32_t acc;
+
+	acc = (iph->src.addr & 0xffffUL) + (iph->src.addr >> 16) +
+		(iph->dest.addr & 0xffffUL) + (iph->dest.addr >> 16) +
+		(u32_t)lwip_htons(IP_PROTO_TCP) + (u32_t)lwip_htons(tcp_len);
+	while (acc >> 16) {
+		acc = (acc & 0xffffUL) + (acc >> 16);
+	}
+	return (u16_t)~acc;
+}
+
+/*
+ * Large send: lwIP sees an MTU of XLWIP_CONFIG_TX_LARGE_SEND_MTU, so TCP
+ * segments may be larger than the link MTU. Such a segment is cut here into
+ * frames of at most AXIDMA_WIRE_MTU bytes. Each frame is a header BD,
+ * pointing to a copy of a header template built once from the original
+ * headers, followed by BDs that point straight into the payload pbufs of the
+ * original segment. Payload pbufs are flushed from the cache only once, and
+ * all frames are queued to the hardware with a single BdRingToHw.
+ */
+static XStatus axidma_large_send(xaxiemacif_s *xaxiemacif, struct pbuf *p)
+{
+	XAxiDma_BdRing *txring = XAxiDma_GetTxRing(&xaxiemacif->axidma);
+	struct ethip_hdr *ehdr = p->payload;
+	struct ip_hdr *iph;
+	struct tcp_hdr *tcph;
+	struct pbuf *q, *hdrs[LARGE_SEND_MAX_SEGS];
+	XAxiDma_Bd *txbdset, *txbd, *last_txbd = NULL;
+	u16_t iphdr_len, hdr_len, mss, tcp_flags, ip_id, seg_len, left, take;
+	u16_t q_off, tcp_payload_offset;
+	u32_t seqno, payload_len, done;
+	s32_t n_segs, n_bds, i;
+	XStatus status;
+#if XLWIP_CONFIG_INCLUDE_AXIETH_ON_ZYNQ == 1
+	Xil_DCacheBatch flush_batch;
+#endif
+
+	if (p->len < sizeof(struct ethip_hdr) ||
+		htons(ehdr->eth.type) != ETHTYPE_IP ||
+		IPH_PROTO(&ehdr->ip) != IP_PROTO_TCP) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("large_send: non TCP frame exceeds MTU\r\n"));
+		return XST_FAILURE;
+	}
+	iph = &ehdr->ip;
+	iphdr_len = IPH_HL(iph) * 4;
+	tcp_payload_offset = XAE_HDR_SIZE + iphdr_len;
+	if (p->len < tcp_payload_offset + TCP_HLEN) {
+		return XST_FAILURE;
+	}
+	tcph = (struct tcp_hdr *)((u8_t *)p->payload + tcp_payload_offset);
+	hdr_len = tcp_payload_offset + TCPH_HDRLEN(tcph) * 4;
+	if (p->len < hdr_len) {
+		return XST_FAILURE;
+	}
+
+	mss = XAE_HDR_SIZE + AXIDMA_WIRE_MTU - hdr_len;
+	payload_len = p->tot_len - hdr_len;
+	n_segs = (payload_len + mss - 1) / mss;
+	if (n_segs > LARGE_SEND_MAX_SEGS) {
+		return XST_FAILURE;
+	}
+
+	/* count the BDs: one header BD per frame plus one per payload piece */
+	n_bds = n_segs;
+	q = p;
+	q_off = hdr_len;
+	for (i = 0, done = 0; i < n_segs; i++) {
+		seg_len = LWIP_MIN(mss, payload_len - done);
+		for (left = seg_len; left > 0; left -= take) {
+			while (q_off == q->len) {
+				q = q->next;
+				q_off = 0;
+			}
+			take = LWIP_MIN(left, q->len - q_off);
+			q_off += take;
+			n_bds++;
+		}
+		done += seg_len;
+	}
+
+	if (XAxiDma_BdRingGetFreeCnt(txring) < n_bds) {
+		process_sent_bds(txring);
+	}
+
+	/* header template: original headers, with the flags that belong only
+	 * to the last frame cleared and the checksums zeroed
+	 */
+	hdrs[0] = pbuf_alloc(PBUF_RAW, hdr_len, PBUF_RAM);
+	if (hdrs[0] == NULL) {
+		return XST_FAILURE;
+	}
+	MEMCPY(hdrs[0]->payload, p->payload, hdr_len);
+	tcp_flags = TCPH_FLAGS(tcph);
+	seqno = lwip_ntohl(tcph->seqno);
+	ip_id = lwip_ntohs(IPH_ID(iph));
+	iph = (struct ip_hdr *)((u8_t *)hdrs[0]->payload + XAE_HDR_SIZE);
+	tcph = (struct tcp_hdr *)((u8_t *)hdrs[0]->payload + tcp_payload_offset);
+	TCPH_FLAGS_SET(tcph, (u16_t)(tcp_flags & ~(TCP_FIN | TCP_PSH)));
+	tcph->chksum = 0;
+	IPH_CHKSUM_SET(iph, 0);
+
+	for (i = 1; i < n_segs; i++) {
+		hdrs[i] = pbuf_alloc(PBUF_RAW, hdr_len, PBUF_RAM);
+		if (hdrs[i] == NULL) {
+			while (i-- > 0) {
+				pbuf_free(hdrs[i]);
+			}
+			return XST_FAILURE;
+		}
+		MEMCPY(hdrs[i]->payload, hdrs[0]->payload, hdr_len);
+	}
+
+	status = XAxiDma_BdRingAlloc(txring, n_bds, &txbdset);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("large_send: Error allocating TxBD\r\n"));
+		for (i = 0; i < n_segs; i++) {
+			pbuf_free(hdrs[i]);
+		}
+		return XST_FAILURE;
+	}
+
+	XCACHE_FLUSH_BATCH_INIT(flush_batch);
+	for (q = p; q != NULL; q = q->next) {
+		XCACHE_FLUSH_BATCH_ADD(flush_batch, q->payload, q->len);
+	}
+
+	txbd = txbdset;
+	q = p;
+	q_off = hdr_len;
+	for (i = 0, done = 0; i < n_segs; i++) {
+		XAxiDma_Bd *hdrbd = txbd;
+
+		seg_len = LWIP_MIN(mss, payload_len - done);
+
+		/* per frame header fields */
+		iph = (struct ip_hdr *)((u8_t *)hdrs[i]->payload + XAE_HDR_SIZE);
+		tcph = (struct tcp_hdr *)((u8_t *)hdrs[i]->payload +
+							tcp_payload_offset);
+		IPH_LEN_SET(iph, lwip_htons(hdr_len - XAE_HDR_SIZE + seg_len));
+		IPH_ID_SET(iph, lwip_htons((u16_t)(ip_id + i)));
+		tcph->seqno = lwip_htonl(seqno + done);
+		if (i == n_segs - 1) {
+			TCPH_FLAGS_SET(tcph, tcp_flags);
+		}
+#if LWIP_PARTIAL_CSUM_OFFLOAD_TX==1
+		IPH_CHKSUM_SET(iph, inet_chksum(iph, iphdr_len));
+#endif
+		XCACHE_FLUSH_BATCH_ADD(flush_batch, hdrs[i]->payload, hdr_len);
+
+		XAxiDma_BdSetBufAddr(hdrbd, (UINTPTR)hdrs[i]->payload);
+		XAxiDma_BdSetLength(hdrbd, hdr_len, txring->MaxTransferLen);
+		XAxiDma_BdSetId(hdrbd, (void *)hdrs[i]);
+		XAxiDma_BdSetCtrl(hdrbd, XAXIDMA_BD_CTRL_TXSOF_MASK);
+#if LWIP_FULL_CSUM_OFFLOAD_TX==1
+		bd_fullcsum_enable(hdrbd);
+#endif
+#if LWIP_PARTIAL_CSUM_OFFLOAD_TX==1
+		bd_csum_disable(hdrbd);
+		bd_csum_set(hdrbd, tcp_payload_offset, tcp_payload_offset + 16,
+			htons(~large_send_pseudo_csum(iph,
+				hdr_len - tcp_payload_offset + seg_len)));
+#endif
+		txbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(txring, txbd);
+
+		/* payload pieces, shared with the original pbufs */
+		for (left = seg_len; left > 0; left -= take) {
+			while (q_off == q->len) {
+				q = q->next;
+				q_off = 0;
+			}
+			take = LWIP_MIN(left, q->len - q_off);
+
+			XAxiDma_BdSetBufAddr(txbd, (UINTPTR)q->payload + q_off);
+			XAxiDma_BdSetLength(txbd, take, txring->MaxTransferLen);
+			XAxiDma_BdSetId(txbd, (void *)q);
+			XAxiDma_BdSetCtrl(txbd, 0);
+			pbuf_ref(q);
+
+			q_off += take;
+			last_txbd = txbd;
+			txbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(txring, txbd);
+		}
+		XAxiDma_BdSetCtrl(last_txbd, XAXIDMA_BD_CTRL_TXEOF_MASK);
+		done += seg_len;
+	}
+
+	XCACHE_FLUSH_BATCH_COMMIT(flush_batch);
+
+	/* enq to h/w */
+	status = XAxiDma_BdRingToHw(txring, n_bds, txbdset);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("large_send: Error submitting TxBD\r\n"));
+		/* every BD holds a header pbuf or a ref on a payload pbuf */
+		for (i = 0, txbd = txbdset; i < n_bds; i++) {
+			pbuf_free((struct pbuf *)(UINTPTR)XAxiDma_BdGetId(txbd));
+			txbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(txring, txbd);
+		}
+		XAxiDma_BdRingUnAlloc(txring, n_bds, txbdset);
+		return status;
+	}
+	XEMACIF_STATS_HWM(&xaxiemacif->stats, tx_ring_hwm, txring->HwCnt);
+	XEMACIF_STATS_ADD(&xaxiemacif->stats, tx_csum_offload, n_segs);
+	return status;
+}
+#endif
+
 XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 {
 	struct pbuf *q;
@@ -509,6 +831,9 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 	XStatus status;
 	XAxiDma_BdRing *txring;
 	u32_t max_frame_size;
+#if XLWIP_CONFIG_INCLUDE_AXIETH_ON_ZYNQ == 1
+	Xil_DCacheBatch flush_batch;
+#endif
 
 #ifdef USE_JUMBO_FRAMES
 	max_frame_size = XAE_MAX_JUMBO_FRAME_SIZE - 18;
@@ -517,6 +842,12 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 #endif
 	txring = XAxiDma_GetTxRing(&xaxiemacif->axidma);
 
+#if XLWIP_CONFIG_TX_LARGE_SEND_MTU
+	if (p->tot_len > XAE_HDR_SIZE + AXIDMA_WIRE_MTU) {
+		return axidma_large_send(xaxiemacif, p);
+	}
+#endif
+
 	/* first count the number of pbufs */
 	for (q = p, n_pbufs = 0; q != NULL; q = q->next)
 		n_pbufs++;
@@ -528,6 +859,7 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 		return ERR_IF;
 	}
 
+	XCACHE_FLUSH_BATCH_INIT(flush_batch);
 	for(q = p, txbd = txbdset; q != NULL; q = q->next) {
 		/* Send the data from the pbuf to the interface, one pbuf at a
 		 * time. The size of the data in each pbuf is kept in the ->len
@@ -543,7 +875,7 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 		}
 		XAxiDma_BdSetId(txbd, (void *)q);
 		XAxiDma_BdSetCtrl(txbd, 0);
-		XCACHE_FLUSH_DCACHE_RANGE(q->payload, q->len);
+		XCACHE_FLUSH_BATCH_ADD(flush_batch, q->payload, q->len);
 
 		pbuf_ref(q);
 
@@ -565,6 +897,7 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 	bd_fullcsum_disable(txbdset);
 	if (p->len > sizeof(struct ethip_hdr)) {
 		bd_fullcsum_enable(txbdset);
+		XEMACIF_STATS_INC(&xaxiemacif->stats, tx_csum_offload);
 	}
 #endif
 #if LWIP_PARTIAL_CSUM_OFFLOAD_TX==1
@@ -601,11 +934,17 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 			/* init buffer descriptor */
 			bd_csum_set(txbdset, tcp_payload_offset,
 			csum_insert_offset, htons(~csum_init));
+			XEMACIF_STATS_INC(&xaxiemacif->stats, tx_csum_offload);
 		}
 	}
 #endif
+	XCACHE_FLUSH_BATCH_COMMIT(flush_batch);
+
 	/* enq to h/w */
-	return XAxiDma_BdRingToHw(txring, n_pbufs, txbdset);
+	status = XAxiDma_BdRingToHw(txring, n_pbufs, txbdset);
+	XEMACIF_STATS_HWM(&xaxiemacif->stats, tx_ring_hwm, txring->HwCnt);
+	XIL_TRACE(XEMACIF_TRACE_TX_SEND, p->tot_len);
+	return status;
 }
 
 XStatus init_axi_dma(struct xemac_s *xemac)
@@ -28,6 +28,8 @@
  *
  */
 
+#include <string.h>
+
 #include "netif/xaxiemacif.h"
 #include "lwipopts.h"
 
@@ -69,9 +71,49 @@ void init_axiemac(xaxiemacif_s *xaxiemac, struct netif *netif)
 	options |= XAE_RECEIVER_ENABLE_OPTION;
 	options |= XAE_FCS_STRIP_OPTION;
 	options |= XAE_MULTICAST_OPTION;
+#if LWIP_IGMP
+	xaxiemac->ext_mcast = 0;
+	memset(xaxiemac->ext_mcast_refs, 0, sizeof(xaxiemac->ext_mcast_refs));
+#if !(LWIP_IPV6 && LWIP_IPV6_MLD)
+	/* The extended table filters any number of IPv4 groups in hardware,
+	 * instead of the 4 multicast address registers. MLD still needs the
+	 * registers for the IPv6 groups.
+	 */
+	if (XAxiEthernet_IsExtFuncCap(xaxiemacp) &&
+			XAxiEthernet_IsExtMcast(xaxiemacp)) {
+		options &= ~XAE_MULTICAST_OPTION;
+		options |= XAE_EXT_MULTICAST_OPTION;
+		xaxiemac->ext_mcast = 1;
+	}
+#endif
+#endif
+#if XLWIP_CONFIG_AXI_VLAN_ID
+	if (XAxiEthernet_IsExtFuncCap(xaxiemacp) &&
+			XAxiEthernet_IsTxVlanTag(xaxiemacp) &&
+			XAxiEthernet_IsRxVlanStrp(xaxiemacp)) {
+		options |= XAE_EXT_TXVLAN_TAG_OPTION;
+		options |= XAE_EXT_RXVLAN_STRP_OPTION;
+	} else {
+		xil_printf("axi_ethernet: VLAN offload not built in hardware\r\n");
+	}
+#endif
 	XAxiEthernet_SetOptions(xaxiemacp, options);
 	XAxiEthernet_ClearOptions(xaxiemacp, ~options);
 
+#if XLWIP_CONFIG_AXI_VLAN_ID
+	/* Tag every transmitted frame and only strip the tag of our VLAN, so
+	 * that frames of other VLANs still reach lwIP tagged and are dropped.
+	 */
+	if (options & XAE_EXT_TXVLAN_TAG_OPTION) {
+		XAxiEthernet_SetVTagMode(xaxiemacp, XAE_VTAG_ALL, XAE_TX);
+		XAxiEthernet_SetVTagValue(xaxiemacp, (0x8100 << 16) |
+				XLWIP_CONFIG_AXI_VLAN_ID, XAE_TX);
+		XAxiEthernet_SetVStripMode(xaxiemacp, XAE_VSTRP_SELECT, XAE_RX);
+		XAxiEthernet_SetVidTable(xaxiemacp, XLWIP_CONFIG_AXI_VLAN_ID,
+				XLWIP_CONFIG_AXI_VLAN_ID, 1, 0, XAE_RX);
+	}
+#endif
+
 	/* set mac address */
 	XAxiEthernet_SetMacAddress(xaxiemacp, (unsigned char*)(netif->hwaddr));
 	link_speed = phy_setup_axiemac(xaxiemacp);
@@ -116,6 +158,72 @@ void init_axiemac(xaxiemacif_s *xaxiemac, struct netif *netif)
 	XAxiEthernet_IntEnable(xaxiemacp, XAE_INT_RECV_ERROR_MASK);
 }
 
+static u64_t xaxiemac_read_counter(XAxiEthernet *xaxiemacp, u32_t offset)
+{
+	u32_t hi, lo;
+
+	/* The halves are not latched together, retry if the MSW moved */
+	do {
+		hi = XAxiEthernet_ReadReg(xaxiemacp->Config.BaseAddress,
+								offset + 4);
+		lo = XAxiEthernet_ReadReg(xaxiemacp->Config.BaseAddress, offset);
+	} while (hi != XAxiEthernet_ReadReg(xaxiemacp->Config.BaseAddress,
+								offset + 4));
+
+	return ((u64_t)hi << 32) | lo;
+}
+
+/*
+ * xaxiemacif_get_hw_stats():
+ *
+ * Reads the statistics counters of the MAC. Frames dropped by the address
+ * filters are not counted anywhere else, as they never reach the netif.
+ * Returns ERR_ARG when the netif is not an axi_ethernet or the core is
+ * built without statistics.
+ */
+s32_t xaxiemacif_get_hw_stats(struct netif *netif,
+				struct xaxiemacif_hw_stats *stats)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	XAxiEthernet *xaxiemacp;
+
+	if (xemac->type != xemac_type_axi_ethernet)
+		return ERR_ARG;
+
+	xaxiemacp = &((xaxiemacif_s *)(xemac->state))->axi_ethernet;
+	if (!XAxiEthernet_IsStatsConfigured(xaxiemacp))
+		return ERR_ARG;
+
+	stats->rx_bytes = xaxiemac_read_counter(xaxiemacp, XAE_RXBL_OFFSET);
+	stats->tx_bytes = xaxiemac_read_counter(xaxiemacp, XAE_TXBL_OFFSET);
+	stats->rx_frames = xaxiemac_read_counter(xaxiemacp, XAE_RXFL_OFFSET);
+	stats->tx_frames = xaxiemac_read_counter(xaxiemacp, XAE_TXFL_OFFSET);
+	stats->rx_broadcast = xaxiemac_read_counter(xaxiemacp,
+						XAE_RXBCSTFL_OFFSET);
+	stats->rx_multicast = xaxiemac_read_counter(xaxiemacp,
+						XAE_RXMCSTFL_OFFSET);
+	stats->tx_broadcast = xaxiemac_read_counter(xaxiemacp,
+						XAE_TXBCSTFL_OFFSET);
+	stats->tx_multicast = xaxiemac_read_counter(xaxiemacp,
+						XAE_TXMCSTFL_OFFSET);
+	stats->rx_vlan = xaxiemac_read_counter(xaxiemacp, XAE_RXVLANFL_OFFSET);
+	stats->rx_pause = xaxiemac_read_counter(xaxiemacp, XAE_RXPFL_OFFSET);
+	stats->rx_fcs_errors = xaxiemac_read_counter(xaxiemacp,
+						XAE_RXFCSERL_OFFSET);
+	stats->rx_length_errors = xaxiemac_read_counter(xaxiemacp,
+						XAE_RXLTERL_OFFSET);
+	stats->rx_undersize = xaxiemac_read_counter(xaxiemacp,
+						XAE_RXUNDRL_OFFSET);
+	stats->rx_fragments = xaxiemac_read_counter(xaxiemacp,
+						XAE_RXFRAGL_OFFSET);
+	stats->rx_oversize = xaxiemac_read_counter(xaxiemacp,
+						XAE_RXOVRL_OFFSET);
+	stats->tx_underrun = xaxiemac_read_counter(xaxiemacp,
+						XAE_TXUNDRERL_OFFSET);
+
+	return ERR_OK;
+}
+
 void xaxiemac_error_handler(XAxiEthernet * Temac)
 {
 	unsigned Pending;
@@ -539,26 +539,20 @@ XStatus axi_mcdma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p)
 	XMcdma_Bd *txbdset, *txbd, *last_txbd = NULL;
 	XMcdma_ChanCtrl *Tx_Chan;
 	XStatus status;
-	static u8_t ChanId = 1;
-	u8_t next_ChanId = ChanId;
 
 	/* first count the number of pbufs */
 	for (q = p; q != NULL; q = q->next)
 		n_pbufs++;
 
-	/* Transfer packets to TX DMA Channels in round-robin manner */
-	do {
-		Tx_Chan = XMcdma_GetMcdmaTxChan(&xaxiemacif->aximcdma, ChanId);
-
-		if (++ChanId > xaxiemacif->axi_ethernet.Config.AxiMcDmaChan_Cnt)
-			ChanId = 1;
-
-		if ((next_ChanId == ChanId) && (n_pbufs > Tx_Chan->BdCnt)) {
-			LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: Error, not enough BD space in All Chans\r\n"));
-			return ERR_IF;
-		}
-
-	} while (n_pbufs > Tx_Chan->BdCnt);
+	/* Transfer packets to TX DMA Channels in weighted round-robin manner,
+	 * the weights default to 1 and can be set with XMcdma_SetChanSwWeight()
+	 */
+	Tx_Chan = XMcdma_WrrNextChan(&xaxiemacif->aximcdma, XMCDMA_MEM_TO_DEV,
+				     XMCDMA_ALL_CHAN_MASK, n_pbufs);
+	if (Tx_Chan == NULL) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: Error, not enough BD space in All Chans\r\n"));
+		return ERR_IF;
+	}
 
 	txbdset = (XMcdma_Bd *)XMcdma_GetChanCurBd(Tx_Chan);
 
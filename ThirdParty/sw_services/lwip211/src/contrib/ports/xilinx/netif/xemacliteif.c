@@ -159,6 +159,13 @@ XEmacLite *xemaclitep_fast;
 #endif
 #endif
 
+/* TRUE when the ping or the pong RX buffer holds a frame */
+#define xemacliteif_rx_pending(instance)					\
+	((XEmacLite_IsRxEmpty((instance)->EmacLiteConfig.BaseAddress) != TRUE) || \
+	 (((instance)->EmacLiteConfig.RxPingPong != 0) &&			\
+	  (XEmacLite_IsRxEmpty((instance)->EmacLiteConfig.BaseAddress +	\
+				XEL_BUFFER_OFFSET) != TRUE)))
+
 static void
 xemacif_recv_handler(void *arg) {
 	struct xemac_s *xemac = (struct xemac_s *)(arg);
@@ -166,6 +173,10 @@ xemacif_recv_handler(void *arg) {
 	XEmacLite *instance = xemacliteif->instance;
 	struct pbuf *p;
 	int len = 0;
+	int n;
+#if !NO_SYS
+	int received = 0;
+#endif
 	struct xtopology_t *xtopologyp = &xtopology[xemac->topology_index];
 
 #ifdef OS_IS_FREERTOS
@@ -176,53 +187,56 @@ xemacif_recv_handler(void *arg) {
 #else
 	XIntc_AckIntr(xtopologyp->intc_baseaddr, 1 << xtopologyp->intc_emac_intr);
 #endif
-	p = pbuf_alloc(PBUF_RAW, XEL_MAX_FRAME_SIZE, PBUF_POOL);
-	if (!p) {
+	/* Drain both buffers: a frame landing in the other buffer while this
+	 * one is copied out raises no interrupt of its own once acked.
+	 */
+	for (n = 0; n < 2 && xemacliteif_rx_pending(instance); n++) {
+		p = pbuf_alloc(PBUF_RAW, XEL_MAX_FRAME_SIZE, PBUF_POOL);
+		if (!p) {
 #if LINK_STATS
-		lwip_stats.link.memerr++;
-		lwip_stats.link.drop++;
-#endif
-		/* receive and just ignore the frame.
-		 * we need to receive the frame because otherwise emaclite will
-		 * not generate any other interrupts since it cannot receive,
-		 * and we do not actively poll the emaclite
-		 */
-		XEmacLite_Recv(instance, xemac_tx_frame);
-#ifdef OS_IS_FREERTOS
-		xInsideISR--;
-#endif
-		return;
-	}
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
+#endif
+			/* receive and just ignore the frame.
+			 * we need to receive the frame because otherwise emaclite will
+			 * not generate any other interrupts since it cannot receive,
+			 * and we do not actively poll the emaclite
+			 */
+			XEmacLite_Recv(instance, xemac_tx_frame);
+			continue;
+		}
 
-	/* receive the packet */
-	len = XEmacLite_Recv(instance, p->payload);
+		/* receive the packet, the pool payload is word aligned so the
+		 * driver copies it out of the dual port RAM a word at a time
+		 */
+		len = XEmacLite_Recv(instance, p->payload);
 
-	if (len == 0) {
+		if (len == 0) {
 #if LINK_STATS
-		lwip_stats.link.drop++;
-#endif
-		pbuf_free(p);
-#ifdef OS_IS_FREERTOS
-		xInsideISR--;
+			lwip_stats.link.drop++;
 #endif
-		return;
-	}
+			pbuf_free(p);
+			break;
+		}
+		pbuf_realloc(p, len);
 
-	/* store it in the receive queue, where it'll be processed by xemacif input thread */
-	if (pq_enqueue(xemacliteif->recv_q, (void*)p) < 0) {
+		/* store it in the receive queue, where it'll be processed by xemacif input thread */
+		if (pq_enqueue(xemacliteif->recv_q, (void*)p) < 0) {
 #if LINK_STATS
-		lwip_stats.link.memerr++;
-		lwip_stats.link.drop++;
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
 #endif
-		pbuf_free(p);
-#ifdef OS_IS_FREERTOS
-		xInsideISR--;
+			pbuf_free(p);
+			continue;
+		}
+#if !NO_SYS
+		received = 1;
 #endif
-		return;
 	}
 
 #if !NO_SYS
-	sys_sem_signal(&xemac->sem_rx_data_available);
+	if (received)
+		sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
@@ -243,6 +257,85 @@ int transmit_packet(XEmacLite *instancep, void *packet, unsigned len)
 	return 0;
 }
 
+/*
+ * Returns the address of a free TX buffer, 0 if both are busy. As in
+ * XEmacLite_Send(), the expected buffer only moves on when it is the one
+ * used, so that the driver stays in sync.
+ */
+static UINTPTR
+xemacliteif_tx_buffer(XEmacLite *instancep)
+{
+	UINTPTR base = XEmacLite_NextTransmitAddr(instancep);
+
+	if ((XEmacLite_GetTxStatus(base) &
+		(XEL_TSR_XMIT_BUSY_MASK | XEL_TSR_XMIT_ACTIVE_MASK)) == 0) {
+		if (instancep->EmacLiteConfig.TxPingPong != 0)
+			instancep->NextTxBufferToUse ^= XEL_BUFFER_OFFSET;
+		return base;
+	}
+
+	if (instancep->EmacLiteConfig.TxPingPong != 0) {
+		base ^= XEL_BUFFER_OFFSET;
+		if ((XEmacLite_GetTxStatus(base) &
+			(XEL_TSR_XMIT_BUSY_MASK | XEL_TSR_XMIT_ACTIVE_MASK)) == 0)
+			return base;
+	}
+
+	return 0;
+}
+
+/*
+ * Copies a pbuf chain straight into a TX buffer. The dual port RAM only
+ * takes word writes, bytes straddling two pbufs are gathered in a word first.
+ */
+static void
+xemacliteif_write_frame(UINTPTR base, struct pbuf *p)
+{
+	volatile u32 *dst = (volatile u32 *)base;
+	union {
+		u32 w;
+		u8_t b[4];
+	} acc;
+	unsigned fill = 0;
+	struct pbuf *q;
+
+	acc.w = 0;
+	for (q = p; q != NULL; q = q->next) {
+		const u8_t *src = q->payload;
+		u16_t len = q->len;
+
+		while (fill != 0 && len != 0) {
+			acc.b[fill++] = *src++;
+			len--;
+			if (fill == 4) {
+				*dst++ = acc.w;
+				fill = 0;
+			}
+		}
+
+		if (((UINTPTR)src & 3) == 0) {
+			const u32 *src32 = (const u32 *)src;
+
+			for (; len >= 4; len -= 4)
+				*dst++ = *src32++;
+			src = (const u8_t *)src32;
+		} else {
+			for (; len >= 4; len -= 4, src += 4) {
+				memcpy(&acc.w, src, 4);
+				*dst++ = acc.w;
+			}
+		}
+
+		while (len != 0) {
+			acc.b[fill++] = *src++;
+			len--;
+		}
+	}
+
+	if (fill != 0)
+		*dst = acc.w;
+}
+
 /*
  * this function is always called with interrupts off
  * this function also assumes that there is space to send in the Emaclite buffer
@@ -250,27 +343,35 @@ int transmit_packet(XEmacLite *instancep, void *packet, unsigned len)
 static err_t
 _unbuffered_low_level_output(XEmacLite *instancep, struct pbuf *p)
 {
-	struct pbuf *q;
-	int total_len = 0;
+	UINTPTR base;
+	u32 reg;
 
 #if ETH_PAD_SIZE
 	pbuf_header(p, -ETH_PAD_SIZE);			/* drop the padding word */
 #endif
 
-	for(q = p, total_len = 0; q != NULL; q = q->next) {
-		/* Send the data from the pbuf to the interface, one pbuf at a
-		   time. The size of the data in each pbuf is kept in the ->len
-		   variable. */
-		memcpy(xemac_tx_frame + total_len, q->payload, q->len);
-		total_len += q->len;
-	}
-
-	if (transmit_packet(instancep, xemac_tx_frame, total_len) < 0) {
+	base = xemacliteif_tx_buffer(instancep);
+	if (base == 0 || p->tot_len > XEL_MAX_TX_FRAME_SIZE) {
 #if LINK_STATS
 		lwip_stats.link.drop++;
 #endif
+#if ETH_PAD_SIZE
+		pbuf_header(p, ETH_PAD_SIZE);		/* reclaim the padding word */
+#endif
+		return ERR_MEM;
 	}
 
+	/* fill this buffer while the other one may still be transmitting */
+	xemacliteif_write_frame(base, p);
+
+	XEmacLite_WriteReg(base, XEL_TPLR_OFFSET, (p->tot_len &
+			(XEL_TPLR_LENGTH_MASK_HI | XEL_TPLR_LENGTH_MASK_LO)));
+	reg = XEmacLite_GetTxStatus(base) | XEL_TSR_XMIT_BUSY_MASK;
+	if ((XEmacLite_GetTxStatus(instancep->EmacLiteConfig.BaseAddress) &
+						XEL_TSR_XMIT_IE_MASK) != 0)
+		reg |= XEL_TSR_XMIT_ACTIVE_MASK;
+	XEmacLite_SetTxStatus(base, reg);
+
 #if ETH_PAD_SIZE
 	pbuf_header(p, ETH_PAD_SIZE);			/* reclaim the padding word */
 #endif
@@ -282,6 +383,24 @@ _unbuffered_low_level_output(XEmacLite *instancep, struct pbuf *p)
 	return ERR_OK;
 }
 
+/*
+ * Moves queued frames into the free TX buffers, oldest first.
+ * Must be called with interrupts off.
+ */
+static void
+xemacliteif_send_backlog(xemacliteif_s *xemacliteif)
+{
+	XEmacLite *instance = xemacliteif->instance;
+	struct pbuf *p;
+
+	while (pq_qlength(xemacliteif->send_q) &&
+		(XEmacLite_TxBufferAvailable(instance) == TRUE)) {
+		p = (struct pbuf *)pq_dequeue(xemacliteif->send_q);
+		_unbuffered_low_level_output(instance, p);
+		pbuf_free(p);
+	}
+}
+
 /*
  * low_level_output():
  *
@@ -301,15 +420,13 @@ low_level_output(struct netif *netif, struct pbuf *p)
 
 	SYS_ARCH_PROTECT(lev);
 
-	/* check if space is available to send */
-        if (XEmacLite_TxBufferAvailable(instance) == TRUE) {
-		if (pq_qlength(xemacliteif->send_q)) {  	/* send backlog */
-			_unbuffered_low_level_output(instance, (struct pbuf *)pq_dequeue(xemacliteif->send_q));
-		} else { 				/* send current */
-			_unbuffered_low_level_output(instance, p);
-			SYS_ARCH_UNPROTECT(lev);
-			return ERR_OK;
-		}
+	/* send backlog first, then current if a buffer is still free */
+	xemacliteif_send_backlog(xemacliteif);
+	if ((pq_qlength(xemacliteif->send_q) == 0) &&
+		(XEmacLite_TxBufferAvailable(instance) == TRUE)) {
+		_unbuffered_low_level_output(instance, p);
+		SYS_ARCH_UNPROTECT(lev);
+		return ERR_OK;
 	}
 
 	/* if we cannot send the packet immediately, then make a copy of the whole packet
@@ -333,6 +450,7 @@ low_level_output(struct netif *netif, struct pbuf *p)
 #if LINK_STATS
 		lwip_stats.link.drop++;
 #endif
+		pbuf_free(q);
 		SYS_ARCH_UNPROTECT(lev);
 		return ERR_MEM;
 	}
@@ -346,7 +464,6 @@ static void
 xemacif_send_handler(void *arg) {
 	struct xemac_s *xemac = (struct xemac_s *)(arg);
 	xemacliteif_s *xemacliteif = (xemacliteif_s *)(xemac->state);
-	XEmacLite *instance = xemacliteif->instance;
 	struct xtopology_t *xtopologyp = &xtopology[xemac->topology_index];
 
 #ifdef OS_IS_FREERTOS
@@ -357,11 +474,8 @@ xemacif_send_handler(void *arg) {
 	XIntc_AckIntr(xtopologyp->intc_baseaddr, 1 << xtopologyp->intc_emac_intr);
 #endif
 
-	if (pq_qlength(xemacliteif->send_q) && (XEmacLite_TxBufferAvailable(instance) == TRUE)) {
-		struct pbuf *p = pq_dequeue(xemacliteif->send_q);
-		_unbuffered_low_level_output(instance, p);
-		pbuf_free(p);
-	}
+	/* refill ping and pong from the backlog */
+	xemacliteif_send_backlog(xemacliteif);
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
 #endif
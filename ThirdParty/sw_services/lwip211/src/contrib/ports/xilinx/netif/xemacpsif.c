@@ -41,6 +41,8 @@
 #include "lwip/sys.h"
 #include "lwip/stats.h"
 #include "lwip/igmp.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/tcp.h"
 
 #include "netif/etharp.h"
 #include "netif/xemacpsif.h"
@@ -98,6 +100,9 @@ static err_t _unbuffered_low_level_output(xemacpsif_s *xemacpsif,
 #if LINK_STATS
 	lwip_stats.link.drop++;
 #endif
+	} else {
+		XEMACIF_STATS_INC(&xemacpsif->stats, tx_packets);
+		XEMACIF_STATS_ADD(&xemacpsif->stats, tx_bytes, p->tot_len);
 	}
 
 #if ETH_PAD_SIZE
@@ -155,6 +160,160 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 	return err;
 }
 
+#if XLWIP_CONFIG_RX_COALESCE
+/*
+ * rx_coalesce_tcp_hdr():
+ *
+ * Returns the TCP header of p if it is an unfragmented IPv4 TCP segment
+ * without IP options that only carries data (ACK, optionally PSH), with
+ * all its headers in the first pbuf. The TCP payload length is returned in
+ * data_len. Returns NULL for anything else.
+ */
+static struct tcp_hdr *rx_coalesce_tcp_hdr(struct pbuf *p, u16_t *data_len)
+{
+	struct eth_hdr *ethhdr = (struct eth_hdr *)p->payload;
+	struct ip_hdr *iphdr;
+	struct tcp_hdr *tcphdr;
+	u16_t iplen, tcphlen;
+
+	if (p->len < SIZEOF_ETH_HDR + IP_HLEN + TCP_HLEN ||
+			ethhdr->type != PP_HTONS(ETHTYPE_IP))
+		return NULL;
+
+	iphdr = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+	if (IPH_V(iphdr) != 4 || IPH_HL_BYTES(iphdr) != IP_HLEN ||
+			IPH_PROTO(iphdr) != IP_PROTO_TCP ||
+			(IPH_OFFSET(iphdr) & PP_HTONS(IP_OFFMASK | IP_MF)) != 0)
+		return NULL;
+
+	tcphdr = (struct tcp_hdr *)((u8_t *)iphdr + IP_HLEN);
+	tcphlen = TCPH_HDRLEN_BYTES(tcphdr);
+	iplen = lwip_ntohs(IPH_LEN(iphdr));
+	if (tcphlen < TCP_HLEN || p->len < SIZEOF_ETH_HDR + IP_HLEN + tcphlen ||
+			iplen <= IP_HLEN + tcphlen ||
+			p->tot_len < SIZEOF_ETH_HDR + iplen)
+		return NULL;
+
+	if ((TCPH_FLAGS(tcphdr) & ~TCP_PSH) != TCP_ACK)
+		return NULL;
+
+	*data_len = iplen - IP_HLEN - tcphlen;
+	return tcphdr;
+}
+
+/*
+ * rx_coalesce():
+ *
+ * Merges the in-order segments of the TCP flow of p that directly follow
+ * it in the receive queue into p, up to XLWIP_CONFIG_RX_COALESCE frames.
+ * The headers of the merged frames are stripped and their payloads
+ * chained behind p, whose header takes the ACK number, window and options
+ * of the last merged segment and the PSH flag of any of them. lwIP then
+ * runs its TCP input path and sends at most one ACK for the whole chain.
+ * Checksums are not updated, the Gem has verified every frame.
+ *
+ * Called with the receive queue protected.
+ */
+static struct pbuf *rx_coalesce(xemacpsif_s *xemacpsif, struct pbuf *p)
+{
+	struct tcp_hdr *tcphdr, *nexthdr;
+	struct ip_hdr *iphdr, *nextip;
+	struct pbuf *q;
+	u16_t hlen, len, next_hlen, next_len;
+	u32_t seqno;
+	u32_t n;
+
+	tcphdr = rx_coalesce_tcp_hdr(p, &len);
+	if (tcphdr == NULL)
+		return p;
+
+	iphdr = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+	hlen = SIZEOF_ETH_HDR + IP_HLEN + TCPH_HDRLEN_BYTES(tcphdr);
+	seqno = lwip_ntohl(tcphdr->seqno) + len;
+	/* a padded frame can only be extended once the padding is gone */
+	pbuf_realloc(p, hlen + len);
+
+	for (n = 1; n < XLWIP_CONFIG_RX_COALESCE; n++) {
+		q = (struct pbuf *)pq_peek(xemacpsif->recv_q);
+		if (q == NULL)
+			break;
+
+		nexthdr = rx_coalesce_tcp_hdr(q, &next_len);
+		if (nexthdr == NULL)
+			break;
+		nextip = (struct ip_hdr *)((u8_t *)q->payload + SIZEOF_ETH_HDR);
+		next_hlen = SIZEOF_ETH_HDR + IP_HLEN + TCPH_HDRLEN_BYTES(nexthdr);
+
+		/* same flow, next in sequence, same options, still fits */
+		if (!ip4_addr_cmp(&nextip->src, &iphdr->src) ||
+				!ip4_addr_cmp(&nextip->dest, &iphdr->dest) ||
+				nexthdr->src != tcphdr->src ||
+				nexthdr->dest != tcphdr->dest ||
+				lwip_ntohl(nexthdr->seqno) != seqno ||
+				next_hlen != hlen ||
+				(u32_t)hlen + len + next_len > 0xFFFFU)
+			break;
+
+		pq_dequeue(xemacpsif->recv_q);
+		XEMACIF_STATS_INC(&xemacpsif->stats, rx_packets);
+		XEMACIF_STATS_INC(&xemacpsif->stats, rx_coalesced);
+		XEMACIF_STATS_ADD(&xemacpsif->stats, rx_bytes, q->tot_len);
+
+		/* the newest ACK, window and timestamps win */
+		tcphdr->ackno = nexthdr->ackno;
+		tcphdr->wnd = nexthdr->wnd;
+		if (TCPH_FLAGS(nexthdr) & TCP_PSH)
+			TCPH_SET_FLAG(tcphdr, TCP_PSH);
+		MEMCPY(tcphdr + 1, nexthdr + 1, hlen - (SIZEOF_ETH_HDR +
+				IP_HLEN + TCP_HLEN));
+
+		/* drop the Ethernet padding and the headers */
+		pbuf_realloc(q, next_hlen + next_len);
+		pbuf_remove_header(q, next_hlen);
+		pbuf_cat(p, q);
+
+		len += next_len;
+		seqno += next_len;
+		IPH_LEN_SET(iphdr, lwip_htons(hlen - SIZEOF_ETH_HDR + len));
+	}
+
+	return p;
+}
+#endif
+
+#if XLWIP_CONFIG_HW_TIMESTAMP
+/*
+ * xemacpsif_get_emacps():
+ *
+ * Returns the driver instance of a Gem interface, for the XEmacPs_Tsu*()
+ * 1588 timer functions.
+ */
+XEmacPs *xemacpsif_get_emacps(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	return &xemacpsif->emacps;
+}
+
+/*
+ * xemacpsif_set_tx_timestamp_fn():
+ *
+ * Installs the function that gets the timestamped frames once sent, NULL
+ * removes it.
+ */
+void xemacpsif_set_tx_timestamp_fn(struct netif *netif, xemacpsif_tx_ts_fn fn)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	xemacpsif->tx_ts_fn = fn;
+	SYS_ARCH_UNPROTECT(lev);
+}
+#endif
+
 /*
  * low_level_input():
  *
@@ -174,6 +333,13 @@ static struct pbuf * low_level_input(struct netif *netif)
 
 	/* return one packet from receive q */
 	p = (struct pbuf *)pq_dequeue(xemacpsif->recv_q);
+	XEMACIF_STATS_INC(&xemacpsif->stats, rx_packets);
+	XEMACIF_STATS_ADD(&xemacpsif->stats, rx_bytes, p->tot_len);
+	XEMACIF_STATS_RX_LATENCY(&xemacpsif->stats);
+#if XLWIP_CONFIG_RX_COALESCE
+	p = rx_coalesce(xemacpsif, p);
+#endif
+	XIL_TRACE(XEMACIF_TRACE_RX_INPUT, p->tot_len);
 	return p;
 }
 
@@ -211,6 +377,17 @@ s32_t xemacpsif_input(struct netif *netif)
 	struct eth_hdr *ethhdr;
 	struct pbuf *p;
 	SYS_ARCH_DECL_PROTECT(lev);
+#if XLWIP_CONFIG_RX_POLL_BUDGET
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	s32_t n_polled = 0;
+
+	/* pull the next batch off the ring once the previous one is consumed */
+	if (pq_qlength(xemacpsif->recv_q) == 0) {
+		n_polled = emacps_rx_poll(xemac, XLWIP_CONFIG_RX_POLL_BUDGET);
+	}
+	LWIP_UNUSED_ARG(n_polled);
+#endif
 
 #ifdef OS_IS_FREERTOS
 	while (1)
@@ -223,6 +400,12 @@ s32_t xemacpsif_input(struct netif *netif)
 
 		/* no packet could be read, silently ignore this */
 		if (p == NULL) {
+#if XLWIP_CONFIG_RX_POLL_BUDGET && !NO_SYS
+			/* budget exhausted, ring may not be empty: come back */
+			if (n_polled >= XLWIP_CONFIG_RX_POLL_BUDGET) {
+				sys_sem_signal(&xemac->sem_rx_data_available);
+			}
+#endif
 			return 0;
 		}
 
@@ -312,6 +495,14 @@ static err_t low_level_init(struct netif *netif)
 	if (!xemacpsif->recv_q)
 		return ERR_MEM;
 
+#if XLWIP_CONFIG_N_RX_PBUF_CACHE
+	xemacpsif->rx_pbuf_cache_cnt = 0;
+#endif
+
+#if XLWIP_CONFIG_NETIF_STATS
+	xemacif_stats_reset(&xemacpsif->stats);
+#endif
+
 	/* maximum transfer unit */
 #ifdef ZYNQMP_USE_JUMBO
 	netif->mtu = XEMACPS_MTU_JUMBO - XEMACPS_HDR_SIZE;
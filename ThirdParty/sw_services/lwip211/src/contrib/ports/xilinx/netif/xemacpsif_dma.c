@@ -42,6 +42,7 @@
 #include "xparameters_ps.h"
 #include "xil_exception.h"
 #include "xil_mmu.h"
+#include "xil_cache_batch.h"
 #if defined (ARMR5)
 #include "xreg_cortexr5.h"
 #endif
@@ -61,12 +62,66 @@
 /* Byte alignment of BDs */
 #define BD_ALIGNMENT (XEMACPS_DMABD_MINIMUM_ALIGNMENT*2)
 
+/* With RX checksum offload, RxBD status bits 23:22 report the checksums the
+ * MAC verified; zero means none was checked.
+ */
+#define XEMACPS_RXBUF_CSUM_MASK	0x00C00000U
+
 /* A max of 4 different ethernet interfaces are supported */
 static UINTPTR tx_pbufs_storage[4*XLWIP_CONFIG_N_TX_DESC];
 static UINTPTR rx_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC];
 
 static s32_t emac_intr_num;
 
+/* Size of the PBUF_POOL buffer given to each RxBD */
+#if XLWIP_CONFIG_RX_BUF_SIZE
+#define RX_PBUF_SIZE	XLWIP_CONFIG_RX_BUF_SIZE
+#elif defined(ZYNQMP_USE_JUMBO)
+#define RX_PBUF_SIZE	MAX_FRAME_SIZE_JUMBO
+#else
+#define RX_PBUF_SIZE	XEMACPS_MAX_FRAME_SIZE
+#endif
+
+#if XLWIP_CONFIG_RX_ZERO_COPY
+/******************************************************************************
+ * Zero-copy receive buffers.
+ *
+ * Instead of allocating a PBUF_POOL pbuf for every refilled RxBD, each
+ * interface owns a fixed set of cache line aligned DMA buffers. A received
+ * frame is handed to lwIP as a custom pbuf whose payload is the DMA buffer
+ * itself. When lwIP releases the last reference to that pbuf, the custom free
+ * function puts the buffer back on the free list of its interface and the
+ * RxBD ring is refilled right away.
+ *
+ * Only the bytes the MAC wrote for the previous frame can have been touched
+ * by the CPU, so only that many bytes are invalidated when the buffer is
+ * given back to the hardware, and only the received length is invalidated
+ * on reception.
+ *********************************************************************************/
+#ifdef ZYNQMP_USE_JUMBO
+#define RX_ZC_FRAME_SIZE	MAX_FRAME_SIZE_JUMBO
+#else
+#define RX_ZC_FRAME_SIZE	XEMACPS_MAX_FRAME_SIZE
+#endif
+#define RX_ZC_BUF_ALIGNMENT	64
+#define RX_ZC_BUF_SIZE		((RX_ZC_FRAME_SIZE + RX_ZC_BUF_ALIGNMENT - 1) & \
+						~(RX_ZC_BUF_ALIGNMENT - 1))
+
+struct xemacps_rx_buf {
+	struct pbuf_custom pc;
+	struct xemacps_rx_buf *next;
+	xemacpsif_s *xemacpsif;
+	u8_t *payload;
+	u32_t used_len;
+};
+
+static struct xemacps_rx_buf rx_zc_bufs[4*XLWIP_CONFIG_N_RX_ZC_BUFS];
+static u8_t rx_zc_buf_space[4*XLWIP_CONFIG_N_RX_ZC_BUFS][RX_ZC_BUF_SIZE]
+				__attribute__ ((aligned (RX_ZC_BUF_ALIGNMENT)));
+static struct xemacps_rx_buf *rx_zc_free_list[4];
+static u8_t rx_zc_bufs_ready[4];
+#endif
+
 /******************************************************************************
  * Each BD is of 8 bytes of size and the BDs (BD chain) need to be  put
  * at uncached memory location. If they are not put at uncached
@@ -191,6 +246,158 @@ u32_t get_base_index_rxpbufsstorage (xemacpsif_s *xemacpsif)
 	return index;
 }
 
+#if XLWIP_CONFIG_RX_ZERO_COPY
+static inline
+u32_t get_rx_zc_instance (xemacpsif_s *xemacpsif)
+{
+	return get_base_index_rxpbufsstorage(xemacpsif) / XLWIP_CONFIG_N_RX_DESC;
+}
+
+static struct xemacps_rx_buf *rx_zc_buf_get(xemacpsif_s *xemacpsif)
+{
+	struct xemacps_rx_buf *rxbuf;
+	u32_t inst = get_rx_zc_instance(xemacpsif);
+
+	rxbuf = rx_zc_free_list[inst];
+	if (rxbuf != NULL) {
+		rx_zc_free_list[inst] = rxbuf->next;
+		rxbuf->next = NULL;
+	}
+	return rxbuf;
+}
+
+static void rx_zc_buf_put(struct xemacps_rx_buf *rxbuf)
+{
+	u32_t inst = get_rx_zc_instance(rxbuf->xemacpsif);
+
+	rxbuf->next = rx_zc_free_list[inst];
+	rx_zc_free_list[inst] = rxbuf;
+}
+
+/*
+ * Called by lwIP when the last reference to a received custom pbuf is
+ * dropped. This can happen from thread context as well as from within the
+ * receive handler, hence the ring update is done with interrupts masked.
+ */
+static void rx_zc_pbuf_free(struct pbuf *p)
+{
+	struct xemacps_rx_buf *rxbuf = (struct xemacps_rx_buf *)p;
+	xemacpsif_s *xemacpsif = rxbuf->xemacpsif;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	rx_zc_buf_put(rxbuf);
+	setup_rx_bds(xemacpsif, &XEmacPs_GetRxRing(&xemacpsif->emacps));
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+static void init_rx_zc_bufs(xemacpsif_s *xemacpsif)
+{
+	struct xemacps_rx_buf *rxbuf;
+	u32_t inst = get_rx_zc_instance(xemacpsif);
+	u32_t base = inst * XLWIP_CONFIG_N_RX_ZC_BUFS;
+	u32_t i;
+
+	/*
+	 * init_dma() is invoked again on error recovery while the stack may
+	 * still hold some of the buffers, so the pool is only populated once.
+	 */
+	if (rx_zc_bufs_ready[inst] != 0) {
+		return;
+	}
+	rx_zc_free_list[inst] = NULL;
+	for (i = 0; i < XLWIP_CONFIG_N_RX_ZC_BUFS; i++) {
+		rxbuf = &rx_zc_bufs[base + i];
+		rxbuf->pc.custom_free_function = rx_zc_pbuf_free;
+		rxbuf->xemacpsif = xemacpsif;
+		rxbuf->payload = rx_zc_buf_space[base + i];
+		/* Nothing is known about the cache state of a fresh buffer */
+		rxbuf->used_len = RX_ZC_BUF_SIZE;
+		rx_zc_buf_put(rxbuf);
+	}
+	rx_zc_bufs_ready[inst] = 1;
+}
+#endif
+
+#if XLWIP_CONFIG_N_RX_PBUF_CACHE
+/*
+ * Per interface cache of RX pool pbufs.
+ *
+ * Every refilled RxBD takes a PBUF_POOL pbuf, and each pbuf_alloc() goes
+ * through the critical region of the global pool. The RX path rather takes
+ * its pbufs from a small cache of its interface, refilled from the global
+ * pool XLWIP_CONFIG_N_RX_PBUF_CACHE pbufs at a time in a single critical
+ * region. The RX path is the only user of the cache and it runs from the RX
+ * interrupt, or from emacps_rx_poll() with interrupts masked, so the cache
+ * itself needs no protection.
+ */
+static struct pbuf *rx_pbuf_get(xemacpsif_s *xemacpsif)
+{
+	if (xemacpsif->rx_pbuf_cache_cnt == 0) {
+		xemacpsif->rx_pbuf_cache_cnt = pbuf_alloc_pool_batch(
+				xemacpsif->rx_pbuf_cache,
+				XLWIP_CONFIG_N_RX_PBUF_CACHE, RX_PBUF_SIZE);
+		if (xemacpsif->rx_pbuf_cache_cnt == 0) {
+			return NULL;
+		}
+	}
+	return xemacpsif->rx_pbuf_cache[--xemacpsif->rx_pbuf_cache_cnt];
+}
+
+static void rx_pbuf_cache_flush(xemacpsif_s *xemacpsif)
+{
+	while (xemacpsif->rx_pbuf_cache_cnt > 0) {
+		pbuf_free(xemacpsif->rx_pbuf_cache[--xemacpsif->rx_pbuf_cache_cnt]);
+	}
+}
+#else
+#define rx_pbuf_get(xemacpsif)	pbuf_alloc(PBUF_RAW, RX_PBUF_SIZE, PBUF_POOL)
+#endif
+
+#if XLWIP_CONFIG_HW_TIMESTAMP
+/*
+ * emacps_rx_timestamp():
+ *
+ * Copies the timestamp of the last BD of a received frame into its pbuf.
+ */
+static void emacps_rx_timestamp(xemacpsif_s *xemacpsif, XEmacPs_Bd *bd,
+		struct pbuf *p)
+{
+	XEmacPs_Timestamp ts;
+
+	if (XEmacPs_BdGetTimestamp(&xemacpsif->emacps, bd, XEMACPS_RECV,
+			&ts) == XST_SUCCESS) {
+		p->ts_sec = (u32_t)ts.Seconds;
+		p->ts_nsec = ts.NanoSeconds;
+	} else {
+		p->ts_nsec = XEMACIF_TS_NONE;
+	}
+}
+
+/*
+ * emacps_tx_timestamp():
+ *
+ * Hands a sent frame to the TX timestamp function, with the timestamp of
+ * its last BD. The BD words must not have been cleared yet.
+ */
+static void emacps_tx_timestamp(xemacpsif_s *xemacpsif, XEmacPs_Bd *bd,
+		struct pbuf *head)
+{
+	XEmacPs_Timestamp ts;
+
+	if (xemacpsif->tx_ts_fn == NULL || head == NULL) {
+		return;
+	}
+	if (XEmacPs_BdGetTimestamp(&xemacpsif->emacps, bd, XEMACPS_SEND,
+			&ts) != XST_SUCCESS) {
+		return;
+	}
+	head->ts_sec = (u32_t)ts.Seconds;
+	head->ts_nsec = ts.NanoSeconds;
+	xemacpsif->tx_ts_fn(head);
+}
+#endif
+
 void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 {
 	XEmacPs_Bd *txbdset;
@@ -202,6 +409,11 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 	struct pbuf *p;
 	u32 *temp;
 	u32_t index;
+#if XLWIP_CONFIG_HW_TIMESTAMP
+	/* first pbuf of the frame, kept until its last BD is reclaimed */
+	struct pbuf *head = NULL;
+	u32_t ctrl;
+#endif
 
 	index = get_base_index_txpbufsstorage (xemacpsif);
 
@@ -217,6 +429,23 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 		curbdpntr = txbdset;
 		while (n_pbufs_freed > 0) {
 			bdindex = XEMACPS_BD_TO_INDEX(txring, curbdpntr);
+#if XLWIP_CONFIG_HW_TIMESTAMP
+			ctrl = XEmacPs_BdRead(curbdpntr, XEMACPS_BD_STAT_OFFSET);
+			p = (struct pbuf *)tx_pbufs_storage[index + bdindex];
+			if (head == NULL) {
+				head = p;
+			} else if (p != NULL) {
+				pbuf_free(p);
+			}
+			tx_pbufs_storage[index + bdindex] = 0;
+			if (ctrl & XEMACPS_TXBUF_LAST_MASK) {
+				emacps_tx_timestamp(xemacpsif, curbdpntr, head);
+				if (head != NULL) {
+					pbuf_free(head);
+				}
+				head = NULL;
+			}
+#endif
 			temp = (u32 *)curbdpntr;
 			*temp = 0;
 			temp++;
@@ -226,11 +455,13 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 				*temp = 0x80000000;
 			}
 			dsb();
+#if !XLWIP_CONFIG_HW_TIMESTAMP
 			p = (struct pbuf *)tx_pbufs_storage[index + bdindex];
 			if (p != NULL) {
 				pbuf_free(p);
 			}
 			tx_pbufs_storage[index + bdindex] = 0;
+#endif
 			curbdpntr = XEmacPs_BdRingNext(txring, curbdpntr);
 			n_pbufs_freed--;
 			dsb();
@@ -258,6 +489,7 @@ void emacps_send_handler(void *arg)
 	txringptr = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
 	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_TXSR_OFFSET);
 	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,XEMACPS_TXSR_OFFSET, regval);
+	XIL_TRACE(XEMACIF_TRACE_TX_IRQ, regval);
 
 	/* If Transmit done interrupt is asserted, process completed BD's */
 	process_sent_bds(xemacpsif, txringptr);
@@ -270,14 +502,17 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 {
 	struct pbuf *q;
 	s32_t n_pbufs;
-	XEmacPs_Bd *txbdset, *txbd, *last_txbd = NULL;
-	XEmacPs_Bd *temp_txbd;
+	XEmacPs_Bd *txbdset, *txbd;
 	XStatus status;
 	XEmacPs_BdRing *txring;
 	u32_t bdindex;
 	u32_t lev;
 	u32_t index;
 	u32_t max_fr_size;
+	u32_t len;
+	u32_t ctrl;
+	u32_t first_ctrl = 0;
+	Xil_DCacheBatch flush_batch;
 
 	lev = mfcpsr();
 	mtcpsr(lev | 0x000000C0);
@@ -286,6 +521,12 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 
 	index = get_base_index_txpbufsstorage (xemacpsif);
 
+#ifdef ZYNQMP_USE_JUMBO
+	max_fr_size = MAX_FRAME_SIZE_JUMBO - 18;
+#else
+	max_fr_size = XEMACPS_MAX_FRAME_SIZE - 18;
+#endif
+
 	/* first count the number of pbufs */
 	for (q = p, n_pbufs = 0; q != NULL; q = q->next)
 		n_pbufs++;
@@ -298,6 +539,14 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 		return XST_FAILURE;
 	}
 
+	/* The payloads of all the fragments are flushed as one batch, so that
+	   pbufs sharing cache lines are merged and a single dsb covers them. */
+	Xil_DCacheBatchInit(&flush_batch, XIL_DCACHE_BATCH_FLUSH);
+
+	/* Each BD is written with two plain stores, its control word is built
+	   from the ring template. The 1st BD of the frame is written with its
+	   used bit still set and released only after all other fragments are
+	   in place, so the hardware never picks up a partial frame. */
 	for(q = p, txbd = txbdset; q != NULL; q = q->next) {
 		bdindex = XEMACPS_BD_TO_INDEX(txring, txbd);
 		if (tx_pbufs_storage[index + bdindex] != 0) {
@@ -310,43 +559,30 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 		   time. The size of the data in each pbuf is kept in the ->len
 		   variable. */
 		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheFlushRange((UINTPTR)q->payload, (UINTPTR)q->len);
+			Xil_DCacheBatchAdd(&flush_batch, (INTPTR)q->payload, q->len);
 		}
 
-		XEmacPs_BdSetAddressTx(txbd, (UINTPTR)q->payload);
-
-#ifdef ZYNQMP_USE_JUMBO
-		max_fr_size = MAX_FRAME_SIZE_JUMBO - 18;
-#else
-		max_fr_size = XEMACPS_MAX_FRAME_SIZE - 18;
-#endif
-		if (q->len > max_fr_size)
-			XEmacPs_BdSetLength(txbd, max_fr_size & 0x3FFF);
-		else
-			XEmacPs_BdSetLength(txbd, q->len & 0x3FFF);
+		len = (q->len > max_fr_size) ? max_fr_size : q->len;
+		ctrl = XEmacPs_BdRingTxCtrl(txring, txbd, len,
+				(q->next == NULL) ? XEMACPS_TXBUF_LAST_MASK : 0U);
+		if (txbd == txbdset) {
+			first_ctrl = ctrl;
+			ctrl |= XEMACPS_TXBUF_USED_MASK;
+		}
+		XEmacPs_BdRingTxFill(txbd, (UINTPTR)q->payload, ctrl);
 
 		tx_pbufs_storage[index + bdindex] = (UINTPTR)q;
 
 		pbuf_ref(q);
-		last_txbd = txbd;
-		XEmacPs_BdClearLast(txbd);
 		txbd = XEmacPs_BdRingNext(txring, txbd);
 	}
-	XEmacPs_BdSetLast(last_txbd);
-	/* For fragmented packets, remember the 1st BD allocated for the 1st
-	   packet fragment. The used bit for this BD should be cleared at the end
-	   after clearing out used bits for other fragments. For packets without
-	   just remember the allocated BD. */
-	temp_txbd = txbdset;
-	txbd = txbdset;
-	txbd = XEmacPs_BdRingNext(txring, txbd);
-	q = p->next;
-	for(; q != NULL; q = q->next) {
-		XEmacPs_BdClearTxUsed(txbd);
+	/* The commit ends with the dsb that also orders the BD writes */
+	if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+		Xil_DCacheBatchCommit(&flush_batch);
+	} else {
 		dsb();
-		txbd = XEmacPs_BdRingNext(txring, txbd);
 	}
-	XEmacPs_BdClearTxUsed(temp_txbd);
+	XEmacPs_BdWrite(txbdset, XEMACPS_BD_STAT_OFFSET, first_ctrl);
 	dsb();
 
 	status = XEmacPs_BdRingToHw(txring, n_pbufs, txbdset);
@@ -355,6 +591,13 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 		LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: Error submitting TxBD\r\n"));
 		return XST_FAILURE;
 	}
+	XEMACIF_STATS_HWM(&xemacpsif->stats, tx_ring_hwm, txring->HwCnt);
+	XIL_TRACE(XEMACIF_TRACE_TX_SEND, p->tot_len);
+#if XLWIP_CONFIG_NETIF_STATS
+	if (xemacpsif->emacps.Options & XEMACPS_TX_CHKSUM_ENABLE_OPTION) {
+		xemacpsif->stats.tx_csum_offload++;
+	}
+#endif
 	/* Start transmit */
 	XEmacPs_WriteReg((xemacpsif->emacps).Config.BaseAddress,
 	XEMACPS_NWCTRL_OFFSET,
@@ -369,7 +612,11 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 {
 	XEmacPs_Bd *rxbd;
 	XStatus status;
+#if XLWIP_CONFIG_RX_ZERO_COPY
+	struct xemacps_rx_buf *rxbuf;
+#else
 	struct pbuf *p;
+#endif
 	u32_t freebds;
 	u32_t bdindex;
 	u32 *temp;
@@ -380,23 +627,36 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 	freebds = XEmacPs_BdRingGetFreeCnt (rxring);
 	while (freebds > 0) {
 		freebds--;
-#ifdef ZYNQMP_USE_JUMBO
-		p = pbuf_alloc(PBUF_RAW, MAX_FRAME_SIZE_JUMBO, PBUF_POOL);
+#if XLWIP_CONFIG_RX_ZERO_COPY
+		rxbuf = rx_zc_buf_get(xemacpsif);
+		if (!rxbuf) {
+			/*
+			 * All buffers are held by the stack. The ring gets
+			 * refilled as soon as lwIP frees one of them.
+			 */
+			XEMACIF_STATS_INC(&xemacpsif->stats, pbuf_alloc_fail);
+			return;
+		}
 #else
-		p = pbuf_alloc(PBUF_RAW, XEMACPS_MAX_FRAME_SIZE, PBUF_POOL);
-#endif
+		p = rx_pbuf_get(xemacpsif);
 		if (!p) {
 #if LINK_STATS
 			lwip_stats.link.memerr++;
 			lwip_stats.link.drop++;
 #endif
+			XEMACIF_STATS_INC(&xemacpsif->stats, pbuf_alloc_fail);
 			printf("unable to alloc pbuf in recv_handler\r\n");
 			return;
 		}
+#endif
 		status = XEmacPs_BdRingAlloc(rxring, 1, &rxbd);
 		if (status != XST_SUCCESS) {
 			LWIP_DEBUGF(NETIF_DEBUG, ("setup_rx_bds: Error allocating RxBD\r\n"));
+#if XLWIP_CONFIG_RX_ZERO_COPY
+			rx_zc_buf_put(rxbuf);
+#else
 			pbuf_free(p);
+#endif
 			return;
 		}
 		status = XEmacPs_BdRingToHw(rxring, 1, rxbd);
@@ -409,17 +669,21 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 				LWIP_DEBUGF(NETIF_DEBUG, ("set of BDs was rejected because the first BD did not have its start-of-packet bit set, or the last BD did not have its end-of-packet bit set, or any one of the BD set has 0 as length value\r\n"));
 			}
 
+#if XLWIP_CONFIG_RX_ZERO_COPY
+			rx_zc_buf_put(rxbuf);
+#else
 			pbuf_free(p);
+#endif
 			XEmacPs_BdRingUnAlloc(rxring, 1, rxbd);
 			return;
 		}
-#ifdef ZYNQMP_USE_JUMBO
+#if XLWIP_CONFIG_RX_ZERO_COPY
 		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
+			Xil_DCacheInvalidateRange((UINTPTR)rxbuf->payload, (UINTPTR)rxbuf->used_len);
 		}
 #else
 		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
+			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)RX_PBUF_SIZE);
 		}
 #endif
 		bdindex = XEMACPS_BD_TO_INDEX(rxring, rxbd);
@@ -433,91 +697,236 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 		*temp = 0;
 		dsb();
 
+#if XLWIP_CONFIG_RX_ZERO_COPY
+		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)rxbuf->payload);
+		rx_pbufs_storage[index + bdindex] = (UINTPTR)rxbuf;
+#else
 		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
 		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
+#endif
 	}
 }
 
-void emacps_recv_handler(void *arg)
+#if XLWIP_CONFIG_RX_BUF_SIZE
+/*
+ * emacps_rx_chain():
+ *
+ * Adds the buffer of one received BD to the frame being reassembled. A
+ * frame larger than XLWIP_CONFIG_RX_BUF_SIZE spans several BDs: every
+ * buffer but the last one is full and the last BD holds the length of the
+ * whole frame. Returns the frame as a pbuf chain once its last BD is seen,
+ * NULL otherwise.
+ */
+static struct pbuf *emacps_rx_chain(xemacpsif_s *xemacpsif, XEmacPs_Bd *bd,
+		struct pbuf *p)
+{
+	u32_t status = XEmacPs_BdRead(bd, XEMACPS_BD_STAT_OFFSET);
+	u32_t frame_len;
+	struct pbuf *head;
+
+	if (status & XEMACPS_RXBUF_SOF_MASK) {
+		if (xemacpsif->rx_head != NULL) {
+			/* the previous frame never got its last BD */
+			pbuf_free(xemacpsif->rx_head);
+			xemacpsif->rx_head = NULL;
+#if LINK_STATS
+			lwip_stats.link.drop++;
+#endif
+		}
+		xemacpsif->rx_len = 0;
+	} else if (xemacpsif->rx_head == NULL) {
+		/* rest of a frame whose first BD was dropped */
+		pbuf_free(p);
+		return NULL;
+	}
+
+	if (!(status & XEMACPS_RXBUF_EOF_MASK)) {
+		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+			Xil_DCacheInvalidateRange((UINTPTR)p->payload, RX_PBUF_SIZE);
+		}
+		xemacpsif->rx_len += RX_PBUF_SIZE;
+		if (xemacpsif->rx_head == NULL) {
+			xemacpsif->rx_head = p;
+		} else {
+			pbuf_cat(xemacpsif->rx_head, p);
+		}
+		return NULL;
+	}
+
+	head = xemacpsif->rx_head;
+	xemacpsif->rx_head = NULL;
+	frame_len = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, bd);
+	if (frame_len <= xemacpsif->rx_len) {
+		pbuf_free(p);
+		if (head != NULL) {
+			pbuf_free(head);
+		}
+#if LINK_STATS
+		lwip_stats.link.drop++;
+#endif
+		return NULL;
+	}
+
+	/* Adjust the last buffer to the bytes left in the frame */
+	pbuf_realloc(p, frame_len - xemacpsif->rx_len);
+	if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+		Xil_DCacheInvalidateRange((UINTPTR)p->payload, p->len);
+	}
+	if (head == NULL) {
+		return p;
+	}
+	pbuf_cat(head, p);
+	return head;
+}
+#endif
+
+/*
+ * emacps_process_rx_bds():
+ *
+ * Reclaims up to 'budget' received BDs from the hardware with a single
+ * XEmacPs_BdRingFromHwRx() call, queues the frames on recv_q, returns the
+ * BDs with one XEmacPs_BdRingFree() call and refills the ring.
+ * Returns the number of BDs processed.
+ */
+static s32_t emacps_process_rx_bds(xemacpsif_s *xemacpsif, s32_t budget)
 {
 	struct pbuf *p;
+#if XLWIP_CONFIG_RX_ZERO_COPY
+	struct xemacps_rx_buf *rxbuf;
+#endif
 	XEmacPs_Bd *rxbdset, *curbdptr;
-	struct xemac_s *xemac;
-	xemacpsif_s *xemacpsif;
 	XEmacPs_BdRing *rxring;
 	volatile s32_t bd_processed;
 	s32_t rx_bytes, k;
 	u32_t bdindex;
-	u32_t regval;
 	u32_t index;
+
+	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
+	index = get_base_index_rxpbufsstorage (xemacpsif);
+
+	bd_processed = XEmacPs_BdRingFromHwRx(rxring, budget, &rxbdset);
+	if (bd_processed <= 0) {
+		return 0;
+	}
+	XEMACIF_STATS_HWM(&xemacpsif->stats, rx_ring_hwm, bd_processed);
+	XIL_TRACE(XEMACIF_TRACE_RX_BDS, bd_processed);
+
+	for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
+
+		bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
+#ifdef ZYNQMP_USE_JUMBO
+		rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
+#else
+		rx_bytes = XEmacPs_BdGetLength(curbdptr);
+#endif
+#if XLWIP_CONFIG_NETIF_STATS
+		if (XEmacPs_BdRead(curbdptr, XEMACPS_BD_STAT_OFFSET) &
+				XEMACPS_RXBUF_CSUM_MASK) {
+			xemacpsif->stats.rx_csum_offload++;
+		}
+#endif
+#if XLWIP_CONFIG_RX_ZERO_COPY
+		rxbuf = (struct xemacps_rx_buf *)rx_pbufs_storage[index + bdindex];
+		rx_pbufs_storage[index + bdindex] = 0;
+
+		/* Invalidate only what the MAC wrote, see the note on
+		 * zero-copy receive buffers at the top of this file.
+		 */
+		Xil_DCacheInvalidateRange((UINTPTR)rxbuf->payload, rx_bytes);
+		rxbuf->used_len = rx_bytes;
+
+		p = pbuf_alloced_custom(PBUF_RAW, rx_bytes, PBUF_REF,
+				&rxbuf->pc, rxbuf->payload, RX_ZC_BUF_SIZE);
+#else
+		p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
+#if XLWIP_CONFIG_RX_BUF_SIZE
+		p = emacps_rx_chain(xemacpsif, curbdptr, p);
+		if (p == NULL) {
+			curbdptr = XEmacPs_BdRingNext(rxring, curbdptr);
+			continue;
+		}
+		LWIP_UNUSED_ARG(rx_bytes);
+#else
+
+		/*
+		 * Adjust the buffer size to the actual number of bytes received.
+		 */
+		pbuf_realloc(p, rx_bytes);
+
+		/* Invalidate RX frame before queuing to handle
+		 * L1 cache prefetch conditions on any architecture.
+		 */
+		Xil_DCacheInvalidateRange((UINTPTR)p->payload, rx_bytes);
+#endif
+#endif
+
+#if XLWIP_CONFIG_HW_TIMESTAMP
+		emacps_rx_timestamp(xemacpsif, curbdptr, p);
+#endif
+
+		/* store it in the receive queue,
+		 * where it'll be processed by a different handler
+		 */
+		if (pq_enqueue(xemacpsif->recv_q, (void*)p) < 0) {
+#if LINK_STATS
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
+#endif
+			pbuf_free(p);
+		}
+		curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
+	}
+	/* free up the BD's */
+	XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
+	setup_rx_bds(xemacpsif, rxring);
+
+	return bd_processed;
+}
+
+void emacps_recv_handler(void *arg)
+{
+	struct xemac_s *xemac;
+	xemacpsif_s *xemacpsif;
+	u32_t regval;
 	u32_t gigeversion;
 
 	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
+	XEMACIF_STATS_STAMP(&xemacpsif->stats);
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR++;
 #endif
 
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
-	index = get_base_index_rxpbufsstorage (xemacpsif);
 	/*
 	 * If Reception done interrupt is asserted, call RX call back function
 	 * to handle the processed BDs and then raise the according flag.
 	 */
 	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET);
 	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET, regval);
+	XIL_TRACE(XEMACIF_TRACE_RX_IRQ, regval);
 	if (gigeversion <= 2) {
 			resetrx_on_no_rxdata(xemacpsif);
 	}
 
-	while(1) {
-
-		bd_processed = XEmacPs_BdRingFromHwRx(rxring, XLWIP_CONFIG_N_RX_DESC, &rxbdset);
-		if (bd_processed <= 0) {
-			break;
-		}
-
-		for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
-
-			bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
-			p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
-
-			/*
-			 * Adjust the buffer size to the actual number of bytes received.
-			 */
-#ifdef ZYNQMP_USE_JUMBO
-			rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
-#else
-			rx_bytes = XEmacPs_BdGetLength(curbdptr);
-#endif
-			pbuf_realloc(p, rx_bytes);
-
-			/* Invalidate RX frame before queuing to handle
-			 * L1 cache prefetch conditions on any architecture.
-			 */
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, rx_bytes);
-
-			/* store it in the receive queue,
-			 * where it'll be processed by a different handler
-			 */
-			if (pq_enqueue(xemacpsif->recv_q, (void*)p) < 0) {
-#if LINK_STATS
-				lwip_stats.link.memerr++;
-				lwip_stats.link.drop++;
+#if XLWIP_CONFIG_RX_POLL_BUDGET
+	/*
+	 * Polling mode: keep the frame received interrupt masked and let
+	 * emacps_rx_poll() drain the ring from thread context. It is unmasked
+	 * again once a poll pass finds the ring empty.
+	 */
+	XEmacPs_IntDisable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+#if !NO_SYS
+	sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
-				pbuf_free(p);
-			}
-			curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
-		}
-		/* free up the BD's */
-		XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
-		setup_rx_bds(xemacpsif, rxring);
+#else
+	while (emacps_process_rx_bds(xemacpsif, XLWIP_CONFIG_N_RX_DESC) > 0) {
 #if !NO_SYS
 		sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
 	}
+#endif
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
@@ -525,6 +934,34 @@ void emacps_recv_handler(void *arg)
 	return;
 }
 
+#if XLWIP_CONFIG_RX_POLL_BUDGET
+/*
+ * emacps_rx_poll():
+ *
+ * Drains up to 'budget' received frames onto recv_q in one pass. When less
+ * than 'budget' frames were pending the ring is empty and the frame
+ * received interrupt is unmasked again; frames that complete in the
+ * meantime are latched in the interrupt status register and raise an
+ * interrupt as soon as it is unmasked.
+ * Returns the number of frames moved to recv_q.
+ */
+s32_t emacps_rx_poll(struct xemac_s *xemac, s32_t budget)
+{
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	s32_t n_frames;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	n_frames = emacps_process_rx_bds(xemacpsif, budget);
+	if (n_frames < budget) {
+		XEmacPs_IntEnable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	return n_frames;
+}
+#endif
+
 void clean_dma_txdescs(struct xemac_s *xemac)
 {
 	XEmacPs_Bd bdtemplate;
@@ -550,7 +987,11 @@ XStatus init_dma(struct xemac_s *xemac)
 	XEmacPs_Bd bdtemplate;
 	XEmacPs_BdRing *rxringptr, *txringptr;
 	XEmacPs_Bd *rxbd;
+#if XLWIP_CONFIG_RX_ZERO_COPY
+	struct xemacps_rx_buf *rxbuf;
+#else
 	struct pbuf *p;
+#endif
 	XStatus status;
 	s32_t i;
 	u32_t bdindex;
@@ -566,6 +1007,20 @@ XStatus init_dma(struct xemac_s *xemac)
 
 	index = get_base_index_rxpbufsstorage (xemacpsif);
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
+
+#if XLWIP_CONFIG_RX_BUF_SIZE
+	/*
+	 * Let the MAC spread frames over RxBD buffers of RX_PBUF_SIZE
+	 * bytes, the DMACR field is in units of 64 bytes.
+	 */
+	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_DMACR_OFFSET,
+		(XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress,
+			XEMACPS_DMACR_OFFSET) & ~XEMACPS_DMACR_RXBUF_MASK) |
+		(((u32)RX_PBUF_SIZE / XEMACPS_RX_BUF_UNIT) <<
+			XEMACPS_DMACR_RXBUF_SHIFT));
+	xemacpsif->rx_head = NULL;
+	xemacpsif->rx_len = 0;
+#endif
 	/*
 	 * The BDs need to be allocated in uncached memory. Hence the 1 MB
 	 * address range allocated for Bd_Space is made uncached
@@ -665,12 +1120,18 @@ XStatus init_dma(struct xemac_s *xemac)
 	/*
 	 * Allocate RX descriptors, 1 RxBD at a time.
 	 */
+#if XLWIP_CONFIG_RX_ZERO_COPY
+	init_rx_zc_bufs(xemacpsif);
+#endif
 	for (i = 0; i < XLWIP_CONFIG_N_RX_DESC; i++) {
-#ifdef ZYNQMP_USE_JUMBO
-		p = pbuf_alloc(PBUF_RAW, MAX_FRAME_SIZE_JUMBO, PBUF_POOL);
+#if XLWIP_CONFIG_RX_ZERO_COPY
+		rxbuf = rx_zc_buf_get(xemacpsif);
+		if (!rxbuf) {
+			printf("unable to get rx buffer in init_dma\r\n");
+			return ERR_IF;
+		}
 #else
-		p = pbuf_alloc(PBUF_RAW, XEMACPS_MAX_FRAME_SIZE, PBUF_POOL);
-#endif
+		p = rx_pbuf_get(xemacpsif);
 		if (!p) {
 #if LINK_STATS
 			lwip_stats.link.memerr++;
@@ -679,17 +1140,26 @@ XStatus init_dma(struct xemac_s *xemac)
 			printf("unable to alloc pbuf in init_dma\r\n");
 			return ERR_IF;
 		}
+#endif
 		status = XEmacPs_BdRingAlloc(rxringptr, 1, &rxbd);
 		if (status != XST_SUCCESS) {
 			LWIP_DEBUGF(NETIF_DEBUG, ("init_dma: Error allocating RxBD\r\n"));
+#if XLWIP_CONFIG_RX_ZERO_COPY
+			rx_zc_buf_put(rxbuf);
+#else
 			pbuf_free(p);
+#endif
 			return ERR_IF;
 		}
 		/* Enqueue to HW */
 		status = XEmacPs_BdRingToHw(rxringptr, 1, rxbd);
 		if (status != XST_SUCCESS) {
 			LWIP_DEBUGF(NETIF_DEBUG, ("Error: committing RxBD to HW\r\n"));
+#if XLWIP_CONFIG_RX_ZERO_COPY
+			rx_zc_buf_put(rxbuf);
+#else
 			pbuf_free(p);
+#endif
 			XEmacPs_BdRingUnAlloc(rxringptr, 1, rxbd);
 			return ERR_IF;
 		}
@@ -703,18 +1173,21 @@ XStatus init_dma(struct xemac_s *xemac)
 		temp++;
 		*temp = 0;
 		dsb();
-#ifdef ZYNQMP_USE_JUMBO
+#if XLWIP_CONFIG_RX_ZERO_COPY
 		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
+			Xil_DCacheInvalidateRange((UINTPTR)rxbuf->payload, (UINTPTR)rxbuf->used_len);
 		}
+		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)rxbuf->payload);
+
+		rx_pbufs_storage[index + bdindex] = (UINTPTR)rxbuf;
 #else
 		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
+			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)RX_PBUF_SIZE);
 		}
-#endif
 		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
 
 		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
+#endif
 	}
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
 	if (gigeversion > 2) {
@@ -793,6 +1266,7 @@ void resetrx_on_no_rxdata(xemacpsif_s *xemacpsif)
 			regctrl = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_NWCTRL_OFFSET);
 			regctrl |= (XEMACPS_NWCTRL_RXEN_MASK);
 			XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_NWCTRL_OFFSET, regctrl);
+			XEMACIF_STATS_INC(&xemacpsif->stats, rx_resets);
 		}
 		xemacpsif->last_rx_frms_cntr = tempcntr;
 	}
@@ -814,11 +1288,31 @@ void free_txrx_pbufs(xemacpsif_s *xemacpsif)
 		}
 	}
 
+#if XLWIP_CONFIG_RX_ZERO_COPY
+	/* Buffers parked on the RxBD ring go back to the free list */
+	index1 = get_base_index_rxpbufsstorage (xemacpsif);
+	for (index = index1; index < (index1 + XLWIP_CONFIG_N_RX_DESC); index++) {
+		if (rx_pbufs_storage[index] != 0) {
+			rx_zc_buf_put((struct xemacps_rx_buf *)rx_pbufs_storage[index]);
+			rx_pbufs_storage[index] = 0;
+		}
+	}
+#else
 	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
 		p = (struct pbuf *)rx_pbufs_storage[index];
 		pbuf_free(p);
 
 	}
+#if XLWIP_CONFIG_RX_BUF_SIZE
+	if (xemacpsif->rx_head != NULL) {
+		pbuf_free(xemacpsif->rx_head);
+		xemacpsif->rx_head = NULL;
+	}
+#endif
+#if XLWIP_CONFIG_N_RX_PBUF_CACHE
+	rx_pbuf_cache_flush(xemacpsif);
+#endif
+#endif
 }
 
 void free_onlytx_pbufs(xemacpsif_s *xemacpsif)
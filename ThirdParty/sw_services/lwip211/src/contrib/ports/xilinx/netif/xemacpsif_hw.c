@@ -194,6 +194,14 @@ void setup_isr (struct xemac_s *xemac)
 
 void start_emacps (xemacpsif_s *xemacps)
 {
+#if XLWIP_CONFIG_HW_TIMESTAMP
+	/* reset leaves extended BD mode, enable it again on every start */
+	if (XEmacPs_SetBdTimestampMode(&xemacps->emacps,
+			XLWIP_CONFIG_HW_TIMESTAMP,
+			XLWIP_CONFIG_HW_TIMESTAMP) != XST_SUCCESS) {
+		xil_printf("In %s:BD timestamps not supported\r\n", __func__);
+	}
+#endif
 	/* start the temac */
 	XEmacPs_Start(&xemacps->emacps);
 }
@@ -233,15 +241,18 @@ void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord)
 			case XEMACPS_RECV:
 			if (ErrorWord & XEMACPS_RXSR_HRESPNOK_MASK) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("Receive DMA error\r\n"));
+				XEMACIF_STATS_INC(&xemacpsif->stats, rx_resets);
 				HandleEmacPsError(xemac);
 			}
 			if (ErrorWord & XEMACPS_RXSR_RXOVR_MASK) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("Receive over run\r\n"));
+				XEMACIF_STATS_INC(&xemacpsif->stats, rx_no_buf);
 				emacps_recv_handler(arg);
 				setup_rx_bds(xemacpsif, rxring);
 			}
 			if (ErrorWord & XEMACPS_RXSR_BUFFNA_MASK) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("Receive buffer not available\r\n"));
+				XEMACIF_STATS_INC(&xemacpsif->stats, rx_no_buf);
 				emacps_recv_handler(arg);
 				setup_rx_bds(xemacpsif, rxring);
 			}
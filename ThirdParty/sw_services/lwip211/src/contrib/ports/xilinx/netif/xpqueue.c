@@ -86,6 +86,15 @@ pq_dequeue(pq_queue_t *q)
 	return q->data[ptail];
 }
 
+void*
+pq_peek(pq_queue_t *q)
+{
+	if (q->len == 0)
+		return NULL;
+
+	return q->data[q->tail];
+}
+
 int
 pq_qlength(pq_queue_t *q)
 {
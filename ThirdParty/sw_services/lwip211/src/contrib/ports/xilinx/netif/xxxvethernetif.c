@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2019 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <xparameters.h>
+
+#include "xlwipconfig.h"
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/mem.h"
+#include "lwip/pbuf.h"
+#include "lwip/sys.h"
+#include "lwip/stats.h"
+
+#include "netif/etharp.h"
+#include "netif/xxxvethernetif.h"
+#include "netif/xadapter.h"
+
+#include "xxxvethernet_hw.h"
+
+#if LWIP_IPV6
+#include "lwip/ethip6.h"
+#endif
+
+/* Define those to better describe your network interface. */
+#define IFNAME0 'x'
+#define IFNAME1 'e'
+
+extern enum ethernet_link_status eth_link_status;
+
+/*
+ * low_level_output():
+ *
+ * Should do the actual transmission of the packet. The packet is
+ * contained in the pbuf that is passed to the function. This pbuf
+ * might be chained.
+ *
+ */
+static err_t low_level_output(struct netif *netif, struct pbuf *p)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+	XStatus status;
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xxxvethernetif_s *xxxvethernetif = (xxxvethernetif_s *)(xemac->state);
+
+#if ETH_PAD_SIZE
+	pbuf_header(p, -ETH_PAD_SIZE);			/* drop the padding word */
+#endif
+
+	SYS_ARCH_PROTECT(lev);
+	status = xxv_mcdma_sgsend(xxxvethernetif, p);
+	SYS_ARCH_UNPROTECT(lev);
+
+	if (status != XST_SUCCESS) {
+#if LINK_STATS
+		lwip_stats.link.drop++;
+#endif
+	} else {
+		XEMACIF_STATS_INC(&xxxvethernetif->stats, tx_packets);
+		XEMACIF_STATS_ADD(&xxxvethernetif->stats, tx_bytes, p->tot_len);
+#if LINK_STATS
+		lwip_stats.link.xmit++;
+#endif
+	}
+
+#if ETH_PAD_SIZE
+	pbuf_header(p, ETH_PAD_SIZE);	/* reclaim the padding word */
+#endif
+
+	return (status == XST_SUCCESS) ? ERR_OK : ERR_MEM;
+}
+
+/*
+ * low_level_input():
+ *
+ * Returns the oldest frame received on RX channel chan, or NULL.
+ *
+ */
+static struct pbuf *low_level_input(struct netif *netif, u32_t chan)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xxxvethernetif_s *xxxvethernetif = (xxxvethernetif_s *)(xemac->state);
+	struct xxxvethernetif_rxq *q = &xxxvethernetif->recv_q[chan - 1];
+	struct pbuf *p;
+
+	/* see if there is data to process */
+	if (q->head == q->tail)
+		return NULL;
+
+	/* return one packet from receive q */
+	p = q->p[q->tail & (XLWIP_CONFIG_XXV_RXQ_SIZE - 1)];
+	q->tail++;
+	XEMACIF_STATS_INC(&xxxvethernetif->stats, rx_packets);
+	XEMACIF_STATS_ADD(&xxxvethernetif->stats, rx_bytes, p->tot_len);
+	XEMACIF_STATS_RX_LATENCY(&xxxvethernetif->stats);
+	XIL_TRACE(XEMACIF_TRACE_RX_INPUT, p->tot_len);
+	return p;
+}
+
+/*
+ * xxxvethernetif_output():
+ *
+ * This function is called by the TCP/IP stack when an IP packet
+ * should be sent. It calls the function called low_level_output() to
+ * do the actual transmission of the packet.
+ *
+ */
+static err_t xxxvethernetif_output(struct netif *netif, struct pbuf *p,
+		const ip4_addr_t *ipaddr)
+{
+	/* resolve hardware address, then send (or queue) packet */
+	return etharp_output(netif, p, ipaddr);
+}
+
+/*
+ * xxxvethernetif_input_chan():
+ *
+ * Passes the frames received on MCDMA RX channel chan (1 based) to lwIP.
+ * The channels are independent, so with an OS every channel may be drained
+ * from its own thread, see xxxvethernetif_input_chan_thread().
+ *
+ * Returns the number of packets read (max 1 packet on success,
+ * 0 if there are no packets)
+ *
+ */
+int xxxvethernetif_input_chan(struct netif *netif, u32_t chan)
+{
+	struct eth_hdr *ethhdr;
+	struct pbuf *p;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+#if !NO_SYS
+	while (1)
+#endif
+	{
+		/* move received packet into a new pbuf */
+		SYS_ARCH_PROTECT(lev);
+		p = low_level_input(netif, chan);
+		SYS_ARCH_UNPROTECT(lev);
+
+		/* no packet could be read, silently ignore this */
+		if (p == NULL)
+			return 0;
+
+		/* points to packet payload, which starts with an Ethernet header */
+		ethhdr = p->payload;
+
+#if LINK_STATS
+		lwip_stats.link.recv++;
+#endif /* LINK_STATS */
+
+		switch (htons(ethhdr->type)) {
+			/* IP or ARP packet? */
+			case ETHTYPE_IP:
+			case ETHTYPE_ARP:
+#if LWIP_IPV6
+			/*IPv6 Packet?*/
+			case ETHTYPE_IPV6:
+#endif
+#if PPPOE_SUPPORT
+				/* PPPoE packet? */
+			case ETHTYPE_PPPOEDISC:
+			case ETHTYPE_PPPOE:
+#endif /* PPPOE_SUPPORT */
+				/* full packet send to tcpip_thread to process */
+				if (netif->input(p, netif) != ERR_OK) {
+					LWIP_DEBUGF(NETIF_DEBUG, ("xxxvethernetif_input: IP input error\r\n"));
+					pbuf_free(p);
+					p = NULL;
+				}
+				break;
+
+			default:
+				pbuf_free(p);
+				p = NULL;
+				break;
+		}
+	}
+	return 1;
+}
+
+/*
+ * xxxvethernetif_input():
+ *
+ * Drains the RX channels which are not handled by a thread of their own.
+ *
+ */
+int xxxvethernetif_input(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xxxvethernetif_s *xxxvethernetif = (xxxvethernetif_s *)(xemac->state);
+	u32_t chan;
+	int n_packets = 0;
+
+	for (chan = 1; chan <= xxxvethernetif->n_chans; chan++) {
+#if !NO_SYS
+		if (xxxvethernetif->rx_chan_threads & (1U << (chan - 1)))
+			continue;
+#endif
+		n_packets += xxxvethernetif_input_chan(netif, chan);
+	}
+
+	return n_packets;
+}
+
+#if !NO_SYS
+/*
+ * xxxvethernetif_input_chan_thread():
+ *
+ * Body of a thread which passes the frames of RX channel chan to lwIP. Once
+ * it runs, the receive interrupt of the channel wakes this thread instead
+ * of xemacif_input_thread(). Start one per channel to spread the RX
+ * processing of the flows steered by the PL over several tasks or cores.
+ *
+ */
+void xxxvethernetif_input_chan_thread(struct netif *netif, u32_t chan)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xxxvethernetif_s *xxxvethernetif = (xxxvethernetif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (chan == 0 || chan > xxxvethernetif->n_chans) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("xxxvethernetif_input_chan_thread: no channel %d\r\n", chan));
+		return;
+	}
+
+	SYS_ARCH_PROTECT(lev);
+	xxxvethernetif->rx_chan_threads |= 1U << (chan - 1);
+	SYS_ARCH_UNPROTECT(lev);
+
+	while (1) {
+		/* move the frames queued before the switch over too */
+		xxxvethernetif_input_chan(netif, chan);
+
+		sys_sem_wait(&xxxvethernetif->sem_rx_chan[chan - 1]);
+	}
+}
+#endif
+
+static XStatus init_xxvemac(xxxvethernetif_s *xxxvethernetif)
+{
+	XXxvEthernet *xxvemacp = &xxxvethernetif->xxv_ethernet;
+#ifdef USE_JUMBO_FRAMES
+	u32 reg;
+
+	/* let frames up to the jumbo size through the receiver */
+	reg = XXxvEthernet_ReadReg(xxvemacp->Config.BaseAddress,
+				   XXE_RXMTU_OFFSET);
+	reg &= ~XXE_RXMTU_MAX_JUM_MASK;
+	reg |= ((u32)XXE_MAX_JUMBO_FRAME_SIZE << 16) & XXE_RXMTU_MAX_JUM_MASK;
+	XXxvEthernet_WriteReg(xxvemacp->Config.BaseAddress,
+			      XXE_RXMTU_OFFSET, reg);
+#endif
+
+	XXxvEthernet_SetOptions(xxvemacp, XXE_DEFAULT_OPTIONS);
+
+	/* waits for the RX block lock */
+	if (XXxvEthernet_Start(xxvemacp) != XST_SUCCESS) {
+		xil_printf("xxxvethernetif: no RX block lock, link is down\r\n");
+		eth_link_status = ETH_LINK_DOWN;
+		return XST_FAILURE;
+	}
+
+	eth_link_status = ETH_LINK_UP;
+	return XST_SUCCESS;
+}
+
+static err_t low_level_init(struct netif *netif)
+{
+	unsigned mac_address = (unsigned)(UINTPTR)(netif->state);
+	struct xemac_s *xemac;
+	xxxvethernetif_s *xxxvethernetif;
+	XXxvEthernet_Config *mac_config;
+	u32_t i;
+
+	/* obtain config of this emac */
+	mac_config = XXxvEthernet_LookupConfigBaseAddr(mac_address);
+	if (mac_config == NULL) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("xxxvethernetif_init: no config for 0x%08x\r\n", mac_address));
+		return ERR_IF;
+	}
+
+	xxxvethernetif = mem_malloc(sizeof *xxxvethernetif);
+	if (xxxvethernetif == NULL) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("xxxvethernetif_init: out of memory\r\n"));
+		return ERR_MEM;
+	}
+	memset(xxxvethernetif, 0, sizeof *xxxvethernetif);
+
+	xemac = mem_malloc(sizeof *xemac);
+	if (xemac == NULL) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("xxxvethernetif_init: out of memory\r\n"));
+		return ERR_MEM;
+	}
+
+	xemac->state = (void *)xxxvethernetif;
+	xemac->topology_index = xtopology_find_index(mac_address);
+	xemac->type = xemac_type_xxv_ethernet;
+
+	XXxvEthernet_CfgInitialize(&xxxvethernetif->xxv_ethernet, mac_config,
+				   mac_config->BaseAddress);
+
+	if (!XXxvEthernet_IsMcDma(&xxxvethernetif->xxv_ethernet)) {
+		/* should not occur */
+		LWIP_DEBUGF(NETIF_DEBUG, ("xxxvethernetif_init: mac is not configured with MCDMA\r\n"));
+		return ERR_IF;
+	}
+
+	xxxvethernetif->n_chans = mac_config->AxiMcDmaChan_Cnt;
+	if (xxxvethernetif->n_chans > XXXVETHIF_MAX_CHANS)
+		xxxvethernetif->n_chans = XXXVETHIF_MAX_CHANS;
+	if (xxxvethernetif->n_chans == 0)
+		return ERR_IF;
+
+	xxxvethernetif->recv_q = mem_malloc(xxxvethernetif->n_chans *
+					    sizeof *xxxvethernetif->recv_q);
+	if (xxxvethernetif->recv_q == NULL) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("xxxvethernetif_init: out of memory\r\n"));
+		return ERR_MEM;
+	}
+	for (i = 0; i < xxxvethernetif->n_chans; i++)
+		xxxvethernetif->recv_q[i].head = xxxvethernetif->recv_q[i].tail = 0;
+
+#if XLWIP_CONFIG_NETIF_STATS
+	xemacif_stats_reset(&xxxvethernetif->stats);
+#endif
+
+	/* maximum transfer unit */
+#ifdef USE_JUMBO_FRAMES
+	netif->mtu = XXE_JUMBO_MTU;
+#else
+	netif->mtu = XXE_MTU;
+#endif
+
+	/* there is no address filter, the MAC takes every frame */
+	netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP |
+				   NETIF_FLAG_LINK_UP;
+
+#if LWIP_IPV6 && LWIP_IPV6_MLD
+	netif->flags |= NETIF_FLAG_MLD6;
+#endif
+
+#if LWIP_IGMP
+	netif->flags |= NETIF_FLAG_IGMP;
+#endif
+
+#if !NO_SYS
+	sys_sem_new(&xemac->sem_rx_data_available, 0);
+	for (i = 0; i < xxxvethernetif->n_chans; i++)
+		sys_sem_new(&xxxvethernetif->sem_rx_chan[i], 0);
+#endif
+
+	/* replace the state in netif (currently the emac baseaddress)
+	 * with the mac instance pointer. The RX interrupts may fire as soon
+	 * as the MCDMA is set up.
+	 */
+	netif->state = (void *)xemac;
+
+	if (init_xxv_mcdma(xemac) != XST_SUCCESS)
+		return ERR_IF;
+
+	/* initialize the mac */
+	init_xxvemac(xxxvethernetif);
+
+	return ERR_OK;
+}
+
+/*
+ * xxxvethernetif_init():
+ *
+ * Should be called at the beginning of the program to set up the
+ * network interface. It calls the function low_level_init() to do the
+ * actual setup of the hardware.
+ *
+ */
+err_t
+xxxvethernetif_init(struct netif *netif)
+{
+	err_t err;
+
+	netif->name[0] = IFNAME0;
+	netif->name[1] = IFNAME1;
+	netif->output = xxxvethernetif_output;
+	netif->linkoutput = low_level_output;
+#if LWIP_IPV6
+	netif->output_ip6 = ethip6_output;
+#endif
+
+	err = low_level_init(netif);
+	if (err != ERR_OK)
+		xil_printf("xxxvethernetif_init: interface setup failed\r\n");
+
+	return err;
+}
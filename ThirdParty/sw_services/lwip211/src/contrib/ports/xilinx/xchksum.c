@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2019 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+/*
+ * Internet checksum for the ARM processors, used by lwIP through the
+ * LWIP_CHKSUM and LWIP_CHKSUM_COPY hooks that lwipopts.h selects for
+ * these processors.
+ *
+ * Both return the same value as lwip_standard_chksum(): the non-inverted
+ * one's complement sum of the buffer, in host order.
+ *
+ * - AArch64 (A53, A72) sums 32 bytes per iteration with NEON pairwise
+ *   add-accumulate. NEON loads need no alignment, so the buffer is summed
+ *   from its first byte whatever its address.
+ * - AArch32 (R5, A9, A53 in 32 bit mode) sums 16 bytes per iteration with
+ *   an ADCS chain, which adds the carries back as it goes.
+ *
+ * xlwip_chksum_copy() sums the data while copying it, so the payload
+ * only goes through the caches once.
+ */
+
+#include <string.h>
+
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/inet_chksum.h"
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#if defined(__aarch64__) || defined(__arm__)
+
+/* Fold a 64 bit one's complement sum to 16 bits */
+static inline u16_t xlwip_fold(u64_t sum)
+{
+	sum = (sum & 0xFFFFFFFFULL) + (sum >> 32);
+	sum = (sum & 0xFFFFFFFFULL) + (sum >> 32);
+	sum = (sum & 0xFFFFU) + (sum >> 16);
+	sum = (sum & 0xFFFFU) + (sum >> 16);
+	sum = (sum & 0xFFFFU) + (sum >> 16);
+
+	return (u16_t)sum;
+}
+
+/* Sum of the trailing 16 bit words and byte of a buffer, copied to dst
+ * when dst is not NULL. The buffer starts at an even offset of the data */
+static inline u64_t xlwip_sum_tail(const u8_t *pb, u8_t *dst, u32_t len)
+{
+	u64_t sum = 0;
+	u16_t w;
+
+	while (len > 1) {
+		memcpy(&w, pb, 2);
+		if (dst != NULL) {
+			memcpy(dst, &w, 2);
+			dst += 2;
+		}
+		sum += w;
+		pb += 2;
+		len -= 2;
+	}
+
+	if (len > 0) {
+		w = 0;
+		((u8_t *)&w)[0] = *pb;
+		if (dst != NULL) {
+			*dst = *pb;
+		}
+		sum += w;
+	}
+
+	return sum;
+}
+
+#if defined(__aarch64__)
+
+/* 32 byte blocks summed before the 32 bit lanes are widened. Each block
+ * adds at most 2 * 0xFFFF to a lane */
+#define XLWIP_CHKSUM_BLOCKS	16384U
+
+static inline u64_t xlwip_sum(const u8_t *pb, u8_t *dst, u32_t len)
+{
+	uint64x2_t acc = vdupq_n_u64(0);
+	uint32x4_t acc0;
+	uint32x4_t acc1;
+	uint8x16_t b0;
+	uint8x16_t b1;
+	u32_t n;
+
+	while (len >= 32U) {
+		n = len >> 5;
+		if (n > XLWIP_CHKSUM_BLOCKS) {
+			n = XLWIP_CHKSUM_BLOCKS;
+		}
+		len -= n << 5;
+
+		acc0 = vdupq_n_u32(0);
+		acc1 = vdupq_n_u32(0);
+		do {
+			b0 = vld1q_u8(pb);
+			b1 = vld1q_u8(pb + 16);
+			if (dst != NULL) {
+				vst1q_u8(dst, b0);
+				vst1q_u8(dst + 16, b1);
+				dst += 32;
+			}
+			acc0 = vpadalq_u16(acc0, vreinterpretq_u16_u8(b0));
+			acc1 = vpadalq_u16(acc1, vreinterpretq_u16_u8(b1));
+			pb += 32;
+		} while (--n != 0U);
+
+		acc = vpadalq_u32(acc, acc0);
+		acc = vpadalq_u32(acc, acc1);
+	}
+
+	return xlwip_fold(vgetq_lane_u64(acc, 0)) +
+		(u64_t)xlwip_fold(vgetq_lane_u64(acc, 1)) +
+		xlwip_sum_tail(pb, dst, len);
+}
+
+u16_t xlwip_chksum(const void *dataptr, int len)
+{
+	if (len <= 0) {
+		return 0;
+	}
+
+	return xlwip_fold(xlwip_sum((const u8_t *)dataptr, NULL, (u32_t)len));
+}
+
+u16_t xlwip_chksum_copy(void *dst, const void *src, u16_t len)
+{
+	return xlwip_fold(xlwip_sum((const u8_t *)src, (u8_t *)dst, len));
+}
+
+#else /* __arm__ */
+
+/* Adds nblocks blocks of 16 bytes to sum, with end around carry */
+static inline u32_t xlwip_sum_blocks(const u32_t *pl, u32_t nblocks,
+		u32_t sum)
+{
+	u32_t w0, w1, w2, w3;
+
+	__asm__ volatile (
+		"	adds	%[sum], %[sum], #0\n"	/* clear the carry */
+		"1:	ldr	%[w0], [%[pl]], #4\n"
+		"	ldr	%[w1], [%[pl]], #4\n"
+		"	ldr	%[w2], [%[pl]], #4\n"
+		"	ldr	%[w3], [%[pl]], #4\n"
+		"	adcs	%[sum], %[sum], %[w0]\n"
+		"	adcs	%[sum], %[sum], %[w1]\n"
+		"	adcs	%[sum], %[sum], %[w2]\n"
+		"	adcs	%[sum], %[sum], %[w3]\n"
+		"	sub	%[n], %[n], #1\n"	/* keeps the carry */
+		"	teq	%[n], #0\n"
+		"	bne	1b\n"
+		"	adc	%[sum], %[sum], #0\n"
+		: [sum] "+r" (sum), [pl] "+r" (pl), [n] "+r" (nblocks),
+		  [w0] "=&r" (w0), [w1] "=&r" (w1), [w2] "=&r" (w2),
+		  [w3] "=&r" (w3)
+		:
+		: "cc", "memory");
+
+	return sum;
+}
+
+/* Sum of a word aligned buffer */
+static inline u64_t xlwip_sum_aligned(const u8_t *pb, u32_t len)
+{
+	u64_t sum = 0;
+
+	if (len >= 16U) {
+		sum = xlwip_sum_blocks((const u32_t *)(const void *)pb,
+				len >> 4, 0);
+		pb += len & ~15U;
+		len &= 15U;
+	}
+
+	while (len > 3U) {
+		sum += *(const u32_t *)(const void *)pb;
+		pb += 4;
+		len -= 4;
+	}
+
+	return sum + xlwip_sum_tail(pb, NULL, len);
+}
+
+u16_t xlwip_chksum(const void *dataptr, int len)
+{
+	const u8_t *pb = (const u8_t *)dataptr;
+	u64_t sum = 0;
+	u16_t t = 0;
+	int odd = ((mem_ptr_t)pb & 1);
+	u16_t res;
+
+	/* Sum the leading byte in the upper half of a word, the words from
+	 * there on then swap back to the right order with the result */
+	if (odd && len > 0) {
+		((u8_t *)&t)[1] = *pb++;
+		len--;
+	}
+
+	if (((mem_ptr_t)pb & 2) && len > 1) {
+		sum += *(const u16_t *)(const void *)pb;
+		pb += 2;
+		len -= 2;
+	}
+
+	if (len > 0) {
+		sum += xlwip_sum_aligned(pb, (u32_t)len);
+	}
+
+	res = xlwip_fold(sum + t);
+	if (odd) {
+		res = SWAP_BYTES_IN_WORD(res);
+	}
+
+	return res;
+}
+
+u16_t xlwip_chksum_copy(void *dst, const void *src, u16_t len)
+{
+	const u32_t *ps = (const u32_t *)src;
+	u32_t *pd = (u32_t *)dst;
+	u64_t sum = 0;
+	u32_t w;
+	u32_t n;
+
+	if ((((mem_ptr_t)dst | (mem_ptr_t)src) & 3) != 0) {
+		MEMCPY(dst, src, len);
+		return xlwip_chksum(dst, len);
+	}
+
+	for (n = len >> 2; n != 0U; n--) {
+		w = *ps++;
+		*pd++ = w;
+		sum += w;
+	}
+
+	return xlwip_fold(sum + xlwip_sum_tail((const u8_t *)ps, (u8_t *)pd,
+			len & 3U));
+}
+
+#endif /* __aarch64__ */
+
+#endif /* __aarch64__ || __arm__ */
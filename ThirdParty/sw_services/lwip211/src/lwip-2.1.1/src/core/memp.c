@@ -355,6 +355,58 @@ memp_malloc_fn(memp_t type, const char *file, const int line)
   return memp;
 }
 
+/**
+ * Get up to 'count' elements from a pool in a single critical region, for
+ * callers that keep a private cache of elements and refill it in batches.
+ *
+ * @param type the pool to get the elements from
+ * @param elems array receiving the elements
+ * @param count number of elements wanted
+ *
+ * @return the number of elements stored in elems, less than count when the
+ *         pool runs out
+ */
+u16_t
+memp_malloc_batch(memp_t type, void **elems, u16_t count)
+{
+  u16_t n = 0;
+#if MEMP_MEM_MALLOC || MEMP_OVERFLOW_CHECK
+  LWIP_ERROR("memp_malloc_batch: type < MEMP_MAX", (type < MEMP_MAX), return 0;);
+
+  while ((n < count) && ((elems[n] = memp_malloc(type)) != NULL)) {
+    n++;
+  }
+#else /* MEMP_MEM_MALLOC || MEMP_OVERFLOW_CHECK */
+  const struct memp_desc *desc;
+  struct memp *memp;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  LWIP_ERROR("memp_malloc_batch: type < MEMP_MAX", (type < MEMP_MAX), return 0;);
+  desc = memp_pools[type];
+
+  SYS_ARCH_PROTECT(old_level);
+  while ((n < count) && ((memp = *desc->tab) != NULL)) {
+    *desc->tab = memp->next;
+    LWIP_ASSERT("memp_malloc_batch: memp properly aligned",
+                ((mem_ptr_t)memp % MEM_ALIGNMENT) == 0);
+    /* cast through u8_t* to get rid of alignment warnings */
+    elems[n++] = ((u8_t *)memp + MEMP_SIZE);
+  }
+#if MEMP_STATS
+  desc->stats->used = (u16_t)(desc->stats->used + n);
+  if (desc->stats->used > desc->stats->max) {
+    desc->stats->max = desc->stats->used;
+  }
+  if (n < count) {
+    desc->stats->err++;
+  }
+#endif
+  SYS_ARCH_UNPROTECT(old_level);
+#endif /* MEMP_MEM_MALLOC || MEMP_OVERFLOW_CHECK */
+
+  return n;
+}
+
 static void
 do_memp_free_pool(const struct memp_desc *desc, void *mem)
 {
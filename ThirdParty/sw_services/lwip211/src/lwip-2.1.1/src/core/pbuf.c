@@ -186,6 +186,8 @@ pbuf_init_alloced_pbuf(struct pbuf *p, void *payload, u16_t tot_len, u16_t len,
   p->flags = flags;
   p->ref = 1;
   p->if_idx = NETIF_NO_INDEX;
+
+  LWIP_PBUF_CUSTOM_DATA_INIT(p);
 }
 
 /**
@@ -299,6 +301,39 @@ pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
   return p;
 }
 
+/**
+ * @ingroup pbuf
+ * Allocates up to 'count' single PBUF_POOL pbufs of 'length' bytes at the
+ * PBUF_RAW layer, taking them from the pool in one critical region. This is
+ * meant for drivers that keep a cache of receive pbufs per interface.
+ *
+ * @param pbufs array receiving the allocated pbufs
+ * @param count number of pbufs wanted
+ * @param length size of each pbuf's payload, must fit in one pool buffer
+ *
+ * @return the number of pbufs stored in pbufs, less than count when the
+ *         pool runs out
+ */
+u16_t
+pbuf_alloc_pool_batch(struct pbuf **pbufs, u16_t count, u16_t length)
+{
+  u16_t n;
+  u16_t i;
+
+  LWIP_ERROR("pbuf_alloc_pool_batch: length fits a pool buffer",
+             (length <= PBUF_POOL_BUFSIZE_ALIGNED), return 0;);
+
+  n = memp_malloc_batch(MEMP_PBUF_POOL, (void **)pbufs, count);
+  for (i = 0; i < n; i++) {
+    pbuf_init_alloced_pbuf(pbufs[i], LWIP_MEM_ALIGN((void *)((u8_t *)pbufs[i] + SIZEOF_STRUCT_PBUF)),
+                           length, length, PBUF_POOL, 0);
+  }
+  if (n < count) {
+    PBUF_POOL_IS_EMPTY();
+  }
+  return n;
+}
+
 /**
  * @ingroup pbuf
  * Allocates a pbuf for referenced data.
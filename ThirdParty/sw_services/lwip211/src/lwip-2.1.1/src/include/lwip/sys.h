@@ -487,8 +487,12 @@ u32_t sys_now(void);
 			      mtmsr(lev & ~0x2)
 #endif
 
+/* Inlined on ARM as well, the function call was most of the cost of the
+ * critical regions on every memp and pbuf allocation and free. */
 #if defined (__arm__) || defined (__aarch64__)
-#define SYS_ARCH_PROTECT(lev) lev = sys_arch_protect()
+#include "xpseudo_asm.h"
+#define SYS_ARCH_PROTECT(lev) lev = mfcpsr(); \
+			      mtcpsr(lev | 0xC0)
 #endif
 /**
  * @ingroup sys_prot
@@ -505,7 +509,7 @@ u32_t sys_now(void);
 #endif
 
 #if defined (__arm__) || defined (__aarch64__)
-#define SYS_ARCH_UNPROTECT(lev) sys_arch_unprotect(lev)
+#define SYS_ARCH_UNPROTECT(lev)	mtcpsr(lev)
 #endif
 sys_prot_t sys_arch_protect(void);
 void sys_arch_unprotect(sys_prot_t pval);
@@ -41,6 +41,7 @@ extern "C" {
 #define RPMSG_ERR_BUFF_SIZE	(RPMSG_ERROR_BASE - 5)
 #define RPMSG_ERR_INIT		(RPMSG_ERROR_BASE - 6)
 #define RPMSG_ERR_ADDR		(RPMSG_ERROR_BASE - 7)
+#define RPMSG_ERR_PERM		(RPMSG_ERROR_BASE - 8)
 
 struct rpmsg_endpoint;
 struct rpmsg_device;
@@ -81,11 +82,26 @@ struct rpmsg_endpoint {
 /**
  * struct rpmsg_device_ops - RPMsg device operations
  * @send_offchannel_raw: send RPMsg data
+ * @hold_rx_buffer: hold RPMsg RX buffer
+ * @release_rx_buffer: release RPMsg RX buffer
+ * @get_tx_payload_buffer: get RPMsg TX buffer
+ * @send_offchannel_nocopy: send RPMsg data without copy
+ * @start_tx_batch: start deferring the notifications of sent messages
+ * @end_tx_batch: end a TX batch and notify the sent messages
  */
 struct rpmsg_device_ops {
 	int (*send_offchannel_raw)(struct rpmsg_device *rdev,
 				   uint32_t src, uint32_t dst,
 				   const void *data, int size, int wait);
+	void (*hold_rx_buffer)(struct rpmsg_device *rdev, void *rxbuf);
+	void (*release_rx_buffer)(struct rpmsg_device *rdev, void *rxbuf);
+	void *(*get_tx_payload_buffer)(struct rpmsg_device *rdev,
+				       uint32_t *len, int wait);
+	int (*send_offchannel_nocopy)(struct rpmsg_device *rdev,
+				      uint32_t src, uint32_t dst,
+				      const void *data, int len);
+	void (*start_tx_batch)(struct rpmsg_device *rdev);
+	void (*end_tx_batch)(struct rpmsg_device *rdev);
 };
 
 /**
@@ -267,6 +283,118 @@ static inline int rpmsg_trysend_offchannel(struct rpmsg_endpoint *ept,
 	return rpmsg_send_offchannel_raw(ept, src, dst, data, len, false);
 }
 
+/**
+ * rpmsg_hold_rx_buffer() - hold a received buffer past the endpoint callback
+ * @ept: the rpmsg endpoint
+ * @rxbuf: RX buffer, the data pointer passed to the endpoint callback
+ *
+ * This function is called from the endpoint callback to keep the buffer
+ * after the callback returns, so the received data can be processed in
+ * place. The buffer is not given back to the remote processor until
+ * rpmsg_release_rx_buffer() is called, so a held buffer reduces the number
+ * of buffers the remote processor can send with.
+ */
+void rpmsg_hold_rx_buffer(struct rpmsg_endpoint *ept, void *rxbuf);
+
+/**
+ * rpmsg_release_rx_buffer() - release a held buffer
+ * @ept: the rpmsg endpoint
+ * @rxbuf: RX buffer held with rpmsg_hold_rx_buffer()
+ *
+ * This function gives a held buffer back to the remote processor. It can be
+ * called from any context except an endpoint callback of the same device
+ * running on another thread.
+ */
+void rpmsg_release_rx_buffer(struct rpmsg_endpoint *ept, void *rxbuf);
+
+/**
+ * rpmsg_get_tx_payload_buffer() - get a TX buffer to fill in place
+ * @ept: the rpmsg endpoint
+ * @len: pointer to the size of the payload buffer, set on return
+ * @wait: boolean, wait or not for a buffer to become available
+ *
+ * The returned payload buffer is in the shared memory. It is filled in place
+ * and sent with rpmsg_send_nocopy(), rpmsg_sendto_nocopy() or
+ * rpmsg_send_offchannel_nocopy(), which take ownership of it. A buffer that
+ * is obtained must be sent, there is no way to give it back.
+ *
+ * Returns a pointer to the payload buffer, or NULL on failure.
+ */
+void *rpmsg_get_tx_payload_buffer(struct rpmsg_endpoint *ept,
+				  uint32_t *len, int wait);
+
+/**
+ * rpmsg_send_offchannel_nocopy() - send a message in a TX buffer, using
+ * explicit src/dst addresses
+ * @ept: the rpmsg endpoint
+ * @src: source address
+ * @dst: destination address
+ * @data: payload buffer returned by rpmsg_get_tx_payload_buffer()
+ * @len: length of payload
+ *
+ * This function sends the payload buffer without copying it. The buffer
+ * belongs to the rpmsg device after the call, whatever the result.
+ *
+ * Returns number of bytes it has sent or negative error value on failure.
+ */
+int rpmsg_send_offchannel_nocopy(struct rpmsg_endpoint *ept, uint32_t src,
+				 uint32_t dst, const void *data, int len);
+
+/**
+ * rpmsg_sendto_nocopy() - send a message in a TX buffer, specify dst
+ * @ept: the rpmsg endpoint
+ * @data: payload buffer returned by rpmsg_get_tx_payload_buffer()
+ * @len: length of payload
+ * @dst: destination address
+ *
+ * Returns number of bytes it has sent or negative error value on failure.
+ */
+static inline int rpmsg_sendto_nocopy(struct rpmsg_endpoint *ept,
+				      const void *data, int len, uint32_t dst)
+{
+	return rpmsg_send_offchannel_nocopy(ept, ept->addr, dst, data, len);
+}
+
+/**
+ * rpmsg_send_nocopy() - send a message in a TX buffer
+ * @ept: the rpmsg endpoint
+ * @data: payload buffer returned by rpmsg_get_tx_payload_buffer()
+ * @len: length of payload
+ *
+ * Returns number of bytes it has sent or negative error value on failure.
+ */
+static inline int rpmsg_send_nocopy(struct rpmsg_endpoint *ept,
+				    const void *data, int len)
+{
+	if (ept->dest_addr == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_ADDR;
+	return rpmsg_send_offchannel_nocopy(ept, ept->addr, ept->dest_addr,
+					    data, len);
+}
+
+/**
+ * rpmsg_start_tx_batch() - start a batch of messages
+ * @ept: the rpmsg endpoint
+ *
+ * Messages sent on the RPMsg device of @ept after this call, from any
+ * endpoint, are placed in the shared memory but the remote processor is not
+ * notified until rpmsg_end_tx_batch() is called. Batches can be nested, the
+ * notification is sent by the outermost rpmsg_end_tx_batch().
+ *
+ * If a send has to wait for a buffer, the messages already in the batch are
+ * notified first, so the remote processor can free buffers.
+ */
+void rpmsg_start_tx_batch(struct rpmsg_endpoint *ept);
+
+/**
+ * rpmsg_end_tx_batch() - end a batch of messages
+ * @ept: the rpmsg endpoint
+ *
+ * This function notifies the remote processor once for all the messages
+ * sent since the matching rpmsg_start_tx_batch().
+ */
+void rpmsg_end_tx_batch(struct rpmsg_endpoint *ept);
+
 /**
  * rpmsg_init_ept - initialize rpmsg endpoint
  *
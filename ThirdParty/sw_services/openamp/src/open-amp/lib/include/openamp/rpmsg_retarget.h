@@ -20,6 +20,16 @@ extern "C" {
 
 #define DEFAULT_PROXY_ENDPOINT  0xFFUL
 
+/* Maximum number of requests waiting for their response */
+#ifndef RPMSG_RPC_MAX_PENDING
+#define RPMSG_RPC_MAX_PENDING   8
+#endif
+
+/* Maximum number of opened files with write buffering or read-ahead */
+#ifndef RPMSG_RPC_MAX_FILES
+#define RPMSG_RPC_MAX_FILES     4
+#endif
+
 struct rpmsg_rpc_data;
 
 typedef int (*rpmsg_rpc_poll)(void *arg);
@@ -36,12 +46,20 @@ struct rpmsg_rpc_syscall {
 	struct rpmsg_rpc_syscall_header args;
 };
 
+struct rpmsg_rpc_resp {
+	void *buf;
+	size_t len;
+};
+
 struct rpmsg_rpc_data {
 	struct rpmsg_endpoint ept;
 	int ept_destroyed;
-	atomic_int nacked;
-	void *respbuf;
-	size_t respbuf_len;
+	/* responses expected, in request order */
+	struct rpmsg_rpc_resp resp_q[RPMSG_RPC_MAX_PENDING];
+	atomic_uint resp_head;
+	unsigned int resp_tail;
+	/* first error returned to a request posted without response buffer */
+	int post_err;
 	rpmsg_rpc_poll poll;
 	void *poll_arg;
 	rpmsg_rpc_shutdown_cb shutdown_cb;
@@ -102,6 +120,41 @@ int rpmsg_rpc_send(struct rpmsg_rpc_data *rpc,
 		   void *req, size_t len,
 		   void *resp, size_t resp_len);
 
+/**
+ * rpmsg_rpc_post - Post RPMsg RPC call
+ *
+ * This function sends RPC request without waiting for the response. The
+ * response is copied to the response buffer when it is received, during
+ * the poll of a later rpmsg_rpc_wait() or rpmsg_rpc_send() call. Without a
+ * response buffer only the status of the response is checked, the first
+ * error is returned by rpmsg_rpc_wait().
+ *
+ * @rpc: pointer to remoteproc procedure call data struct
+ * @req: pointer to request buffer
+ * @len: length of the request data
+ * @resp: pointer to where store the response, or NULL
+ * @resp_len: length of the response buffer
+ *
+ * return length of the sent request, negative value for failure.
+ */
+int rpmsg_rpc_post(struct rpmsg_rpc_data *rpc,
+		   void *req, size_t len,
+		   void *resp, size_t resp_len);
+
+/**
+ * rpmsg_rpc_wait - Wait for RPMsg RPC responses
+ *
+ * This function polls until at most @pending posted requests are waiting
+ * for their response.
+ *
+ * @rpc: pointer to remoteproc procedure call data struct
+ * @pending: number of requests that can stay waiting
+ *
+ * return 0, or the first error returned to a request posted without
+ * response buffer since the previous call.
+ */
+int rpmsg_rpc_wait(struct rpmsg_rpc_data *rpc, unsigned int pending);
+
 /**
  * rpmsg_set_default_rpc - set default RPMsg RPC data
  *
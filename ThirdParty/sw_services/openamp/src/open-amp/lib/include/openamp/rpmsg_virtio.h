@@ -26,8 +26,45 @@ extern "C" {
 #define RPMSG_BUFFER_SIZE	(512)
 #endif
 
+/* Alignment of the shared memory pool buffers, a power of two cache line */
+#ifndef RPMSG_BUFFER_ALIGN
+#define RPMSG_BUFFER_ALIGN	(64)
+#endif
+
 /* The feature bitmap for virtio rpmsg */
 #define VIRTIO_RPMSG_F_NS	0 /* RP supports name service notifications */
+#define VIRTIO_RPMSG_F_FRAG	1 /* RP supports fragmented messages */
+
+/**
+ * struct rpmsg_virtio_config - configuration of the master buffers
+ * @h2r_buf_size: size of the buffers sent by the master to the remote
+ * @r2h_buf_size: size of the buffers sent by the remote to the master
+ *
+ * The buffer sizes include the 16 bytes rpmsg header, and are at most
+ * 65551 bytes. The remote side uses the sizes chosen by the master.
+ */
+struct rpmsg_virtio_config {
+	uint32_t h2r_buf_size;
+	uint32_t r2h_buf_size;
+};
+
+/**
+ * struct rpmsg_virtio_rx_frag - reassembly of a fragmented message
+ * @buf: reassembly buffer, the payload follows an rpmsg header
+ * @size: payload size of the reassembly buffer
+ * @len: payload length received so far
+ * @total: payload length of the message, 0 if none is reassembled
+ * @src: source address of the message
+ * @dst: destination address of the message
+ */
+struct rpmsg_virtio_rx_frag {
+	void *buf;
+	uint32_t size;
+	uint32_t len;
+	uint32_t total;
+	uint32_t src;
+	uint32_t dst;
+};
 
 /**
  * struct rpmsg_virtio_shm_pool - shared memory pool used for rpmsg buffers
@@ -49,6 +86,13 @@ struct rpmsg_virtio_shm_pool {
  * @svq: pointer to send virtqueue
  * @shbuf_io: pointer to the shared buffer I/O region
  * @shpool: pointer to the shared buffers pool
+ * @tx_batch: nesting depth of TX batches, the send virtqueue is not kicked
+ *            while it is not zero
+ * @config: buffer sizes of the master
+ * @rx_frag: reassembly of the received fragmented message
+ * @tx_lock: lock keeping the fragments of a sent message together
+ * @rx_poll: whether received messages are polled, with the receive
+ *           notifications disabled
  */
 struct rpmsg_virtio_device {
 	struct rpmsg_device rdev;
@@ -57,6 +101,11 @@ struct rpmsg_virtio_device {
 	struct virtqueue *svq;
 	struct metal_io_region *shbuf_io;
 	struct rpmsg_virtio_shm_pool *shpool;
+	unsigned int tx_batch;
+	struct rpmsg_virtio_config config;
+	struct rpmsg_virtio_rx_frag rx_frag;
+	metal_mutex_t tx_lock;
+	bool rx_poll;
 };
 
 #define RPMSG_REMOTE	VIRTIO_DEV_SLAVE
@@ -131,6 +180,36 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 		    struct metal_io_region *shm_io,
 		    struct rpmsg_virtio_shm_pool *shpool);
 
+/**
+ * rpmsg_init_vdev_with_config - initialize rpmsg virtio device with
+ * configurable buffer sizes
+ *
+ * Same as rpmsg_init_vdev, with the sizes of the buffers allocated by the
+ * master for each direction. The configuration is ignored on the slave side.
+ *
+ * If both sides support the VIRTIO_RPMSG_F_FRAG feature, a message larger
+ * than a buffer is sent as several fragments, and given to the endpoint
+ * callback in one contiguous buffer by the receiving side. Such a message
+ * cannot be held with rpmsg_hold_rx_buffer().
+ *
+ * @param rvdev  - pointer to the rpmsg virtio device
+ * @param vdev   - pointer to the virtio device
+ * @param ns_bind_cb  - callback handler for name service announcement without
+ *                      local endpoints waiting to bind.
+ * @param shm_io - pointer to the share memory I/O region.
+ * @param shpool - pointer to shared memory pool. rpmsg_virtio_init_shm_pool has
+ *                 to be called first to fill this structure.
+ * @param config - pointer to the buffer sizes, NULL for RPMSG_BUFFER_SIZE
+ *
+ * @return - status of function execution
+ */
+int rpmsg_init_vdev_with_config(struct rpmsg_virtio_device *rvdev,
+				struct virtio_device *vdev,
+				rpmsg_ns_bind_cb ns_bind_cb,
+				struct metal_io_region *shm_io,
+				struct rpmsg_virtio_shm_pool *shpool,
+				const struct rpmsg_virtio_config *config);
+
 /**
  * rpmsg_deinit_vdev - deinitialize rpmsg virtio device
  *
@@ -153,6 +232,32 @@ void rpmsg_deinit_vdev(struct rpmsg_virtio_device *rvdev);
 void rpmsg_virtio_init_shm_pool(struct rpmsg_virtio_shm_pool *shpool,
 				void *shbuf, size_t size);
 
+/**
+ * rpmsg_virtio_set_rx_poll - select the polling receive mode
+ *
+ * In polling mode, the other side is asked not to notify the buffers it
+ * sends, and received messages are processed by rpmsg_virtio_poll() only.
+ * This removes the interrupt from the receive path, for endpoints that
+ * cannot afford its latency.
+ *
+ * @param rvdev - pointer to the rpmsg virtio device
+ * @param enable - true for polling mode, false for notification mode
+ */
+void rpmsg_virtio_set_rx_poll(struct rpmsg_virtio_device *rvdev, bool enable);
+
+/**
+ * rpmsg_virtio_poll - process the received messages
+ *
+ * Checks the receive vring index directly, and calls the endpoint callbacks
+ * of the messages received. It can be called in a busy loop, it costs a
+ * few shared memory reads when no message is received.
+ *
+ * @param rvdev - pointer to the rpmsg virtio device
+ *
+ * @return - number of messages pending when called, 0 if none
+ */
+int rpmsg_virtio_poll(struct rpmsg_virtio_device *rvdev);
+
 /**
  * rpmsg_virtio_get_rpmsg_device - get RPMsg device from RPMsg virtio device
  *
@@ -221,6 +221,8 @@ uint32_t virtqueue_get_desc_size(struct virtqueue *vq);
 
 uint32_t virtqueue_get_buffer_length(struct virtqueue *vq, uint16_t idx);
 
+int virtqueue_get_pending_count(struct virtqueue *vq);
+
 #if defined __cplusplus
 }
 #endif
@@ -15,6 +15,11 @@
  *************************************************************************/
 static struct rpmsg_rpc_data *rpmsg_default_rpc;
 
+static unsigned int rpmsg_rpc_pending(struct rpmsg_rpc_data *rpc)
+{
+	return rpc->resp_tail - atomic_load(&rpc->resp_head);
+}
+
 static int rpmsg_rpc_ept_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
 			    uint32_t src, void *priv)
 {
@@ -29,17 +34,28 @@ static int rpmsg_rpc_ept_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
 			rpmsg_destroy_ept(ept);
 		} else {
 			struct rpmsg_rpc_data *rpc;
+			struct rpmsg_rpc_resp *resp;
+			unsigned int head;
 
 			rpc = metal_container_of(ept,
 						 struct rpmsg_rpc_data,
 						 ept);
 			metal_spinlock_acquire(&rpc->buflock);
-			if (rpc->respbuf != NULL && rpc->respbuf_len != 0) {
-				if (len > rpc->respbuf_len)
-					len = rpc->respbuf_len;
-				memcpy(rpc->respbuf, data, len);
+			head = atomic_load(&rpc->resp_head);
+			if (head != rpc->resp_tail) {
+				/* responses come in the order of the requests */
+				resp = &rpc->resp_q[head % RPMSG_RPC_MAX_PENDING];
+				if (resp->buf != NULL && resp->len != 0) {
+					if (len > resp->len)
+						len = resp->len;
+					memcpy(resp->buf, data, len);
+				} else if (len >= sizeof(*syscall) &&
+					   syscall->args.int_field1 < 0 &&
+					   rpc->post_err == 0) {
+					rpc->post_err = syscall->args.int_field1;
+				}
+				atomic_store(&rpc->resp_head, head + 1);
 			}
-			atomic_flag_clear(&rpc->nacked);
 			metal_spinlock_release(&rpc->buflock);
 		}
 	}
@@ -54,7 +70,6 @@ static void rpmsg_service_unbind(struct rpmsg_endpoint *ept)
 	rpc = metal_container_of(ept, struct rpmsg_rpc_data, ept);
 	rpc->ept_destroyed = 1;
 	rpmsg_destroy_ept(ept);
-	atomic_flag_clear(&rpc->nacked);
 	if (rpc->shutdown_cb)
 		rpc->shutdown_cb(rpc);
 }
@@ -77,9 +92,9 @@ int rpmsg_rpc_init(struct rpmsg_rpc_data *rpc,
 	rpc->poll_arg = poll_arg;
 	rpc->poll = poll;
 	rpc->ept_destroyed = 0;
-	rpc->respbuf = NULL;
-	rpc->respbuf_len = 0;
-	atomic_init(&rpc->nacked, 1);
+	atomic_init(&rpc->resp_head, 0);
+	rpc->resp_tail = 0;
+	rpc->post_err = 0;
 	ret = rpmsg_create_ept(&rpc->ept, rdev,
 			       ept_name, ept_addr, ept_raddr,
 			       rpmsg_rpc_ept_cb, rpmsg_service_unbind);
@@ -102,8 +117,8 @@ void rpmsg_rpc_release(struct rpmsg_rpc_data *rpc)
 		rpmsg_destroy_ept(&rpc->ept);
 	metal_mutex_acquire(&rpc->lock);
 	metal_spinlock_acquire(&rpc->buflock);
-	rpc->respbuf = NULL;
-	rpc->respbuf_len = 0;
+	/* drop the responses still expected */
+	atomic_store(&rpc->resp_head, rpc->resp_tail);
 	metal_spinlock_release(&rpc->buflock);
 	metal_mutex_release(&rpc->lock);
 	metal_mutex_deinit(&rpc->lock);
@@ -111,31 +126,83 @@ void rpmsg_rpc_release(struct rpmsg_rpc_data *rpc)
 	return;
 }
 
-int rpmsg_rpc_send(struct rpmsg_rpc_data *rpc,
+static void rpmsg_rpc_wait_pending(struct rpmsg_rpc_data *rpc,
+				   unsigned int pending)
+{
+	while (rpmsg_rpc_pending(rpc) > pending && !rpc->ept_destroyed) {
+		if (rpc->poll)
+			rpc->poll(rpc->poll_arg);
+	}
+}
+
+int rpmsg_rpc_post(struct rpmsg_rpc_data *rpc,
 		   void *req, size_t len,
 		   void *resp, size_t resp_len)
 {
+	struct rpmsg_rpc_resp *slot;
 	int ret;
 
-	if (rpc == NULL)
+	if (rpc == NULL || rpc->ept_destroyed)
 		return -EINVAL;
+
+	/* make room for the response */
+	rpmsg_rpc_wait_pending(rpc, RPMSG_RPC_MAX_PENDING - 1);
+
 	metal_spinlock_acquire(&rpc->buflock);
-	rpc->respbuf = resp;
-	rpc->respbuf_len = resp_len;
+	slot = &rpc->resp_q[rpc->resp_tail % RPMSG_RPC_MAX_PENDING];
+	slot->buf = resp;
+	slot->len = resp_len;
+	rpc->resp_tail++;
 	metal_spinlock_release(&rpc->buflock);
-	(void)atomic_flag_test_and_set(&rpc->nacked);
+
 	ret = rpmsg_send(&rpc->ept, req, len);
-	if (ret < 0)
+	if (ret < 0) {
+		/* no response will come */
+		metal_spinlock_acquire(&rpc->buflock);
+		rpc->resp_tail--;
+		metal_spinlock_release(&rpc->buflock);
 		return -EINVAL;
-	if (!resp)
-		return ret;
-	while((atomic_flag_test_and_set(&rpc->nacked))) {
-		if (rpc->poll)
-			rpc->poll(rpc->poll_arg);
 	}
 	return ret;
 }
 
+int rpmsg_rpc_wait(struct rpmsg_rpc_data *rpc, unsigned int pending)
+{
+	int ret;
+
+	if (rpc == NULL)
+		return -EINVAL;
+	rpmsg_rpc_wait_pending(rpc, pending);
+	metal_spinlock_acquire(&rpc->buflock);
+	ret = rpc->post_err;
+	rpc->post_err = 0;
+	metal_spinlock_release(&rpc->buflock);
+	if (ret == 0 && rpmsg_rpc_pending(rpc) > pending)
+		ret = -EINVAL;
+	return ret;
+}
+
+int rpmsg_rpc_send(struct rpmsg_rpc_data *rpc,
+		   void *req, size_t len,
+		   void *resp, size_t resp_len)
+{
+	int ret;
+
+	if (rpc == NULL)
+		return -EINVAL;
+	if (!resp) {
+		ret = rpmsg_send(&rpc->ept, req, len);
+		return ret < 0 ? -EINVAL : ret;
+	}
+	ret = rpmsg_rpc_post(rpc, req, len, resp, resp_len);
+	if (ret < 0)
+		return ret;
+	rpmsg_rpc_wait_pending(rpc, 0);
+	if (rpmsg_rpc_pending(rpc) != 0)
+		return -EINVAL;
+	return ret;
+}
+
 void rpmsg_set_default_rpc(struct rpmsg_rpc_data *rpc)
 {
 	if (rpc == NULL)
@@ -143,6 +210,106 @@ void rpmsg_set_default_rpc(struct rpmsg_rpc_data *rpc)
 	rpmsg_default_rpc = rpc;
 }
 
+#define MAX_BUF_LEN 496UL
+#define MAX_PAYLOAD_LEN (MAX_BUF_LEN - sizeof(struct rpmsg_rpc_syscall))
+
+/*
+ * Files opened with _open() get a buffer when one is free:
+ * - files opened write only are written back in MAX_PAYLOAD_LEN blocks,
+ *   posted without waiting for the remote to write them. An error returned
+ *   for one of them is reported by the next _write() or by _close().
+ * - files opened read only are read ahead: the next block is requested
+ *   as soon as the previous one arrived, and read from the remote while
+ *   the application consumes the current one.
+ * Other files and the standard streams are not buffered.
+ */
+struct rpmsg_rpc_file {
+	int fd;
+	int flags;
+	/* request header followed by the data to write, or read data */
+	unsigned char buf[MAX_BUF_LEN];
+	size_t len;
+	size_t off;
+	int eof;
+	int ra_posted;
+	/* response of the read-ahead request */
+	unsigned char rabuf[MAX_BUF_LEN];
+};
+
+static struct rpmsg_rpc_file rpmsg_rpc_files[RPMSG_RPC_MAX_FILES];
+static int rpmsg_rpc_files_init;
+
+static struct rpmsg_rpc_file *rpmsg_rpc_file_get(int fd)
+{
+	int i;
+
+	if (fd < 0)
+		return NULL;
+	for (i = 0; i < RPMSG_RPC_MAX_FILES; i++) {
+		if (rpmsg_rpc_files_init && rpmsg_rpc_files[i].fd == fd)
+			return &rpmsg_rpc_files[i];
+	}
+	return NULL;
+}
+
+static void rpmsg_rpc_file_alloc(int fd, int flags)
+{
+	struct rpmsg_rpc_file *file;
+	int accmode = flags & O_ACCMODE;
+	int i;
+
+	if (!rpmsg_rpc_files_init) {
+		for (i = 0; i < RPMSG_RPC_MAX_FILES; i++)
+			rpmsg_rpc_files[i].fd = -1;
+		rpmsg_rpc_files_init = 1;
+	}
+	if (accmode != O_RDONLY && accmode != O_WRONLY)
+		return;
+	file = NULL;
+	for (i = 0; file == NULL && i < RPMSG_RPC_MAX_FILES; i++) {
+		if (rpmsg_rpc_files[i].fd < 0)
+			file = &rpmsg_rpc_files[i];
+	}
+	if (file == NULL)
+		return;
+	file->fd = fd;
+	file->flags = accmode;
+	file->len = 0;
+	file->off = 0;
+	file->eof = 0;
+	file->ra_posted = 0;
+}
+
+/* Post a WRITE request of len bytes found after the header in buf */
+static int rpmsg_rpc_post_write(struct rpmsg_rpc_data *rpc, int fd,
+				unsigned char *buf, size_t len, int null_term)
+{
+	struct rpmsg_rpc_syscall *syscall = (struct rpmsg_rpc_syscall *)buf;
+
+	syscall->id = WRITE_SYSCALL_ID;
+	syscall->args.int_field1 = fd;
+	syscall->args.int_field2 = len;
+	syscall->args.data_len = len + null_term;
+	if (null_term)
+		buf[sizeof(*syscall) + len] = 0;
+
+	return rpmsg_rpc_post(rpc, buf, sizeof(*syscall) + len + null_term,
+			      NULL, 0);
+}
+
+static int rpmsg_rpc_file_flush(struct rpmsg_rpc_data *rpc,
+				struct rpmsg_rpc_file *file)
+{
+	int ret = 0;
+
+	if (file->flags == O_WRONLY && file->len != 0) {
+		ret = rpmsg_rpc_post_write(rpc, file->fd, file->buf,
+					   file->len, 0);
+		file->len = 0;
+	}
+	return ret < 0 ? ret : 0;
+}
+
 /*************************************************************************
  *
  *   FUNCTION
@@ -154,21 +321,23 @@ void rpmsg_set_default_rpc(struct rpmsg_rpc_data *rpc)
  *       Open a file.  Minimal implementation
  *
  *************************************************************************/
-#define MAX_BUF_LEN 496UL
-
 int _open(const char *filename, int flags, int mode)
 {
 	struct rpmsg_rpc_data *rpc = rpmsg_default_rpc;
 	struct rpmsg_rpc_syscall *syscall;
 	struct rpmsg_rpc_syscall resp;
-	int filename_len = strlen(filename) + 1;
-	int payload_size = sizeof(*syscall) + filename_len;
+	int filename_len;
+	int payload_size;
 	unsigned char tmpbuf[MAX_BUF_LEN];
 	int ret;
 
-	if (filename == NULL || payload_size > (int)MAX_BUF_LEN) {
+	if (filename == NULL)
+		return -EINVAL;
+
+	filename_len = strlen(filename) + 1;
+	payload_size = sizeof(*syscall) + filename_len;
+	if (payload_size > (int)MAX_BUF_LEN)
 		return -EINVAL;
-	}
 
 	if (rpc == NULL)
 		return -EINVAL;
@@ -192,32 +361,22 @@ int _open(const char *filename, int flags, int mode)
 			ret = -EINVAL;
 	}
 
+	if (ret >= 0)
+		rpmsg_rpc_file_alloc(ret, flags);
+
 	return ret;
 }
 
-/*************************************************************************
- *
- *   FUNCTION
- *
- *       _read
- *
- *   DESCRIPTION
- *
- *       Low level function to redirect IO to serial.
- *
- *************************************************************************/
-int _read(int fd, char *buffer, int buflen)
+/* Read one block of at most MAX_PAYLOAD_LEN bytes to buffer */
+static int rpmsg_rpc_read_block(struct rpmsg_rpc_data *rpc, int fd,
+				char *buffer, int buflen)
 {
 	struct rpmsg_rpc_syscall syscall;
 	struct rpmsg_rpc_syscall *resp;
-	struct rpmsg_rpc_data *rpc = rpmsg_default_rpc;
 	int payload_size = sizeof(syscall);
 	unsigned char tmpbuf[MAX_BUF_LEN];
 	int ret;
 
-	if (rpc == NULL || buffer == NULL || buflen == 0)
-		return -EINVAL;
-
 	/* Construct rpc payload */
 	syscall.id = READ_SYSCALL_ID;
 	syscall.args.int_field1 = fd;
@@ -250,6 +409,121 @@ int _read(int fd, char *buffer, int buflen)
 	return ret;
 }
 
+static int rpmsg_rpc_post_read_ahead(struct rpmsg_rpc_data *rpc,
+				     struct rpmsg_rpc_file *file)
+{
+	struct rpmsg_rpc_syscall syscall;
+	struct rpmsg_rpc_syscall *resp;
+	int ret;
+
+	syscall.id = READ_SYSCALL_ID;
+	syscall.args.int_field1 = file->fd;
+	syscall.args.int_field2 = MAX_PAYLOAD_LEN;
+	syscall.args.data_len = 0;	/*not used */
+
+	resp = (struct rpmsg_rpc_syscall *)file->rabuf;
+	resp->id = 0;
+	ret = rpmsg_rpc_post(rpc, (void *)&syscall, sizeof(syscall),
+			     file->rabuf, sizeof(file->rabuf));
+	file->ra_posted = ret >= 0;
+	return ret;
+}
+
+/* Move the read-ahead block to the file buffer, and request the next one */
+static int rpmsg_rpc_file_fill(struct rpmsg_rpc_data *rpc,
+			       struct rpmsg_rpc_file *file)
+{
+	struct rpmsg_rpc_syscall *resp;
+	int ret;
+
+	if (!file->ra_posted) {
+		ret = rpmsg_rpc_post_read_ahead(rpc, file);
+		if (ret < 0)
+			return ret;
+	}
+	rpmsg_rpc_wait_pending(rpc, 0);
+	file->ra_posted = 0;
+
+	resp = (struct rpmsg_rpc_syscall *)file->rabuf;
+	if (resp->id != READ_SYSCALL_ID)
+		return -EINVAL;
+	ret = resp->args.int_field1;
+	if (ret <= 0) {
+		file->eof = 1;
+		return ret;
+	}
+	if (ret > (int)resp->args.data_len)
+		ret = resp->args.data_len;
+	if (ret > (int)MAX_PAYLOAD_LEN)
+		ret = MAX_PAYLOAD_LEN;
+	memcpy(file->buf, file->rabuf + sizeof(*resp), ret);
+	file->len = ret;
+	file->off = 0;
+
+	/* the remote reads the next block while this one is consumed */
+	(void)rpmsg_rpc_post_read_ahead(rpc, file);
+
+	return ret;
+}
+
+/*************************************************************************
+ *
+ *   FUNCTION
+ *
+ *       _read
+ *
+ *   DESCRIPTION
+ *
+ *       Low level function to redirect IO to serial.
+ *
+ *************************************************************************/
+int _read(int fd, char *buffer, int buflen)
+{
+	struct rpmsg_rpc_data *rpc = rpmsg_default_rpc;
+	struct rpmsg_rpc_file *file;
+	int done = 0;
+	int ret = 0;
+	int len;
+
+	if (rpc == NULL || buffer == NULL || buflen == 0)
+		return -EINVAL;
+
+	file = rpmsg_rpc_file_get(fd);
+	if (file != NULL && file->flags == O_RDONLY) {
+		while (done < buflen) {
+			if (file->off == file->len) {
+				if (file->eof)
+					break;
+				ret = rpmsg_rpc_file_fill(rpc, file);
+				if (ret <= 0)
+					break;
+			}
+			len = file->len - file->off;
+			if (len > buflen - done)
+				len = buflen - done;
+			memcpy(buffer + done, file->buf + file->off, len);
+			file->off += len;
+			done += len;
+		}
+		return done != 0 ? done : ret;
+	}
+
+	/* large reads are split in blocks, a short block ends the read */
+	while (done < buflen) {
+		len = buflen - done;
+		if (len > (int)MAX_PAYLOAD_LEN)
+			len = MAX_PAYLOAD_LEN;
+		ret = rpmsg_rpc_read_block(rpc, fd, buffer + done, len);
+		if (ret <= 0)
+			break;
+		done += ret;
+		if (ret < len)
+			break;
+	}
+
+	return done != 0 ? done : ret;
+}
+
 /*************************************************************************
  *
  *   FUNCTION
@@ -263,44 +537,59 @@ int _read(int fd, char *buffer, int buflen)
  *************************************************************************/
 int _write(int fd, const char *ptr, int len)
 {
-	int ret;
-	struct rpmsg_rpc_syscall *syscall;
-	struct rpmsg_rpc_syscall resp;
-	int payload_size = sizeof(*syscall) + len;
 	struct rpmsg_rpc_data *rpc = rpmsg_default_rpc;
+	struct rpmsg_rpc_file *file;
 	unsigned char tmpbuf[MAX_BUF_LEN];
-	unsigned char *tmpptr;
 	int null_term = 0;
+	int done = 0;
+	int chunk;
+	int ret;
 
-	if (rpc == NULL)
+	if (rpc == NULL || (ptr == NULL && len != 0))
 		return -EINVAL;
-	if (fd == 1)
-		null_term = 1;
 
-	syscall = (struct rpmsg_rpc_syscall *)tmpbuf;
-	syscall->id = WRITE_SYSCALL_ID;
-	syscall->args.int_field1 = fd;
-	syscall->args.int_field2 = len;
-	syscall->args.data_len = len + null_term;
-	tmpptr = tmpbuf + sizeof(*syscall);
-	memcpy(tmpptr, ptr, len);
-	if (null_term == 1) {
-		*(char *)(tmpptr + len + null_term) = 0;
-		payload_size += 1;
+	file = rpmsg_rpc_file_get(fd);
+	if (file != NULL && file->flags == O_WRONLY) {
+		/* report an error of the blocks written back so far */
+		ret = rpmsg_rpc_wait(rpc, RPMSG_RPC_MAX_PENDING);
+		if (ret < 0)
+			return ret;
+		while (done < len) {
+			chunk = MAX_PAYLOAD_LEN - file->len;
+			if (chunk > len - done)
+				chunk = len - done;
+			memcpy(file->buf + sizeof(struct rpmsg_rpc_syscall) +
+			       file->len, ptr + done, chunk);
+			file->len += chunk;
+			done += chunk;
+			if (file->len == MAX_PAYLOAD_LEN) {
+				ret = rpmsg_rpc_file_flush(rpc, file);
+				if (ret < 0)
+					return ret;
+			}
+		}
+		return len;
 	}
-	resp.id = 0;
-	ret = rpmsg_rpc_send(rpc, tmpbuf, payload_size,
-			     (void *)&resp, sizeof(resp));
 
-	if (ret >= 0) {
-		if (resp.id == WRITE_SYSCALL_ID)
-			ret = resp.args.int_field1;
-		else
-			ret = -EINVAL;
+	if (fd == 1)
+		null_term = 1;
+
+	/* large writes are split in blocks, sent without waiting */
+	while (done < len) {
+		chunk = MAX_PAYLOAD_LEN - null_term;
+		if (chunk > len - done)
+			chunk = len - done;
+		memcpy(tmpbuf + sizeof(struct rpmsg_rpc_syscall), ptr + done,
+		       chunk);
+		ret = rpmsg_rpc_post_write(rpc, fd, tmpbuf, chunk, null_term);
+		if (ret < 0)
+			return ret;
+		done += chunk;
 	}
 
-	return ret;
+	ret = rpmsg_rpc_wait(rpc, 0);
 
+	return ret < 0 ? ret : len;
 }
 
 /*************************************************************************
@@ -317,13 +606,26 @@ int _write(int fd, const char *ptr, int len)
 int _close(int fd)
 {
 	int ret;
+	int err = 0;
 	struct rpmsg_rpc_syscall syscall;
 	struct rpmsg_rpc_syscall resp;
 	int payload_size = sizeof(syscall);
 	struct rpmsg_rpc_data *rpc = rpmsg_default_rpc;
+	struct rpmsg_rpc_file *file;
 
 	if (rpc == NULL)
 		return -EINVAL;
+
+	file = rpmsg_rpc_file_get(fd);
+	if (file != NULL) {
+		/* write back buffered data, drop read-ahead data */
+		err = rpmsg_rpc_file_flush(rpc, file);
+		ret = rpmsg_rpc_wait(rpc, 0);
+		if (err == 0)
+			err = ret;
+		file->fd = -1;
+	}
+
 	syscall.id = CLOSE_SYSCALL_ID;
 	syscall.args.int_field1 = fd;
 	syscall.args.int_field2 = 0;	/*not used */
@@ -340,5 +642,5 @@ int _close(int fd)
 			ret = -EINVAL;
 	}
 
-	return ret;
+	return err < 0 ? err : ret;
 }
@@ -36,6 +36,28 @@ extern "C" {
 #endif
 
 #define RPMSG_LOCATE_DATA(p) ((unsigned char *)(p) + sizeof(struct rpmsg_hdr))
+#define RPMSG_LOCATE_HDR(p) \
+	((struct rpmsg_hdr *)((unsigned char *)(p) - sizeof(struct rpmsg_hdr)))
+
+/*
+ * The reserved field of the header of a buffer owned by the local side
+ * keeps the index of the buffer in the virtqueue, and the held flag for
+ * a received buffer. It is cleared before a buffer is sent.
+ */
+#define RPMSG_BUF_HELD		(1U << 31)
+#define RPMSG_BUF_IDX_MASK	0xFFFFU
+
+/*
+ * Flags of the header of a fragment of a message. The reserved field of
+ * every fragment holds the payload length of the whole message.
+ */
+#define RPMSG_HDR_F_FRAG	(1U << 0)
+#define RPMSG_HDR_F_FIRST	(1U << 1)
+#define RPMSG_HDR_F_LAST	(1U << 2)
+
+/* Largest buffer, the payload length of the header is 16 bits */
+#define RPMSG_MAX_BUFFER_SIZE	(0xFFFFU + sizeof(struct rpmsg_hdr))
+
 /**
  * enum rpmsg_ns_flags - dynamic name service announcement flags
  *
@@ -8,6 +8,7 @@
  */
 
 #include <metal/alloc.h>
+#include <metal/log.h>
 #include <metal/sleep.h>
 #include <metal/utilities.h>
 #include <openamp/rpmsg_virtio.h>
@@ -30,6 +31,9 @@ rpmsg_virtio_shm_pool_get_buffer(struct rpmsg_virtio_shm_pool *shpool,
 {
 	void *buffer;
 
+	/* Keep the next buffer cache line aligned */
+	size = (size + RPMSG_BUFFER_ALIGN - 1) &
+	       ~((size_t)RPMSG_BUFFER_ALIGN - 1);
 	if (shpool->avail < size)
 		return NULL;
 	buffer = (char *)shpool->base + shpool->size - shpool->avail;
@@ -42,8 +46,17 @@ rpmsg_virtio_shm_pool_get_buffer(struct rpmsg_virtio_shm_pool *shpool,
 void rpmsg_virtio_init_shm_pool(struct rpmsg_virtio_shm_pool *shpool,
 				void *shb, size_t size)
 {
+	size_t skip;
+
 	if (!shpool)
 		return;
+	/* Start the pool on a cache line, buffers do not share lines */
+	skip = (RPMSG_BUFFER_ALIGN - ((uintptr_t)shb % RPMSG_BUFFER_ALIGN)) %
+	       RPMSG_BUFFER_ALIGN;
+	if (skip > size)
+		skip = size;
+	shb = (char *)shb + skip;
+	size -= skip;
 	shpool->base = shb;
 	shpool->size = size;
 	shpool->avail = size;
@@ -145,8 +158,8 @@ static void *rpmsg_virtio_get_tx_buffer(struct rpmsg_virtio_device *rvdev,
 		data = virtqueue_get_buffer(rvdev->svq, len, idx);
 		if (data == NULL) {
 			data = rpmsg_virtio_shm_pool_get_buffer(rvdev->shpool,
-							RPMSG_BUFFER_SIZE);
-			*len = RPMSG_BUFFER_SIZE;
+						rvdev->config.h2r_buf_size);
+			*len = rvdev->config.h2r_buf_size;
 		}
 	}
 #endif /*!VIRTIO_SLAVE_ONLY*/
@@ -194,6 +207,88 @@ static void *rpmsg_virtio_get_rx_buffer(struct rpmsg_virtio_device *rvdev,
 	return data;
 }
 
+/**
+ * rpmsg_virtio_get_buffer_len
+ *
+ * Returns the full length of a buffer owned by the local side.
+ *
+ * @param rvdev - pointer to rpmsg device
+ * @param vq    - virtqueue the buffer was taken from
+ * @param idx   - buffer index
+ *
+ * @return - buffer length
+ */
+static uint32_t rpmsg_virtio_get_buffer_len(struct rpmsg_virtio_device *rvdev,
+					    struct virtqueue *vq, uint16_t idx)
+{
+	unsigned int role = rpmsg_virtio_get_role(rvdev);
+	uint32_t len = 0;
+
+#ifndef VIRTIO_SLAVE_ONLY
+	if (role == RPMSG_MASTER) {
+		/* All the buffers of a virtqueue have the configured size */
+		(void)idx;
+		if (vq == rvdev->svq)
+			len = rvdev->config.h2r_buf_size;
+		else
+			len = rvdev->config.r2h_buf_size;
+	}
+#endif /*!VIRTIO_SLAVE_ONLY*/
+
+#ifndef VIRTIO_MASTER_ONLY
+	if (role == RPMSG_REMOTE) {
+		len = virtqueue_get_buffer_length(vq, idx);
+	}
+#endif /*!VIRTIO_MASTER_ONLY*/
+
+	return len;
+}
+
+/**
+ * rpmsg_virtio_next_rx_buffer
+ *
+ * Retrieves the next received buffer while the receive notifications are
+ * disabled. When the virtqueue is empty, the notifications are enabled
+ * again, and a buffer received since the last check is still returned.
+ * Called with the device lock held.
+ *
+ * @param rvdev - pointer to rpmsg device
+ * @param len  - size of received buffer
+ * @param idx  - index of buffer
+ *
+ * @return - pointer to received buffer, NULL if the virtqueue is empty
+ */
+static void *rpmsg_virtio_next_rx_buffer(struct rpmsg_virtio_device *rvdev,
+					 uint32_t *len, uint16_t *idx)
+{
+	void *data;
+
+	data = rpmsg_virtio_get_rx_buffer(rvdev, len, idx);
+	if (!data && !rvdev->rx_poll && virtqueue_enable_cb(rvdev->rvq)) {
+		virtqueue_disable_cb(rvdev->rvq);
+		data = rpmsg_virtio_get_rx_buffer(rvdev, len, idx);
+	}
+
+	return data;
+}
+
+/**
+ * rpmsg_virtio_kick_tx
+ *
+ * Notifies the other side of the buffers placed on the send virtqueue, unless
+ * a TX batch is open. Called with the device lock held.
+ *
+ * @param rvdev - pointer to rpmsg device
+ * @param force - kick even if a TX batch is open
+ */
+static void rpmsg_virtio_kick_tx(struct rpmsg_virtio_device *rvdev, int force)
+{
+	if (rvdev->tx_batch && !force)
+		return;
+	if (rvdev->svq->vq_queued_cnt)
+		virtqueue_kick(rvdev->svq);
+}
+
 #ifndef VIRTIO_MASTER_ONLY
 /**
  * check if the remote is ready to start RPMsg communication
@@ -240,7 +335,7 @@ static int _rpmsg_virtio_get_buffer_size(struct rpmsg_virtio_device *rvdev)
 		 * If device role is Master then buffers are provided by us,
 		 * so just provide the macro.
 		 */
-		length = RPMSG_BUFFER_SIZE - sizeof(struct rpmsg_hdr);
+		length = rvdev->config.h2r_buf_size - sizeof(struct rpmsg_hdr);
 	}
 #endif /*!VIRTIO_SLAVE_ONLY*/
 
@@ -262,6 +357,15 @@ static int _rpmsg_virtio_get_buffer_size(struct rpmsg_virtio_device *rvdev)
 	return length;
 }
 
+static void rpmsg_virtio_send_buffer(struct rpmsg_virtio_device *rvdev,
+				     void *buffer, uint32_t src, uint32_t dst,
+				     int size, uint16_t flags, uint32_t total,
+				     uint32_t buff_len, uint16_t idx);
+static int rpmsg_virtio_send_chunk(struct rpmsg_virtio_device *rvdev,
+				   uint32_t src, uint32_t dst,
+				   const void *data, int size,
+				   int offset, int total, int wait);
+
 /**
  * This function sends rpmsg "message" to remote device.
  *
@@ -282,13 +386,8 @@ static int rpmsg_virtio_send_offchannel_raw(struct rpmsg_device *rdev,
 					    int size, int wait)
 {
 	struct rpmsg_virtio_device *rvdev;
-	struct rpmsg_hdr rp_hdr;
-	void *buffer = NULL;
-	uint16_t idx;
-	int tick_count;
-	uint32_t buff_len;
+	int offset = 0;
 	int status;
-	struct metal_io_region *io;
 
 	/* Get the associated remote device for channel. */
 	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
@@ -299,6 +398,58 @@ static int rpmsg_virtio_send_offchannel_raw(struct rpmsg_device *rdev,
 		return RPMSG_ERR_DEV_STATE;
 	}
 
+	if (!(rvdev->vdev->features & (1 << VIRTIO_RPMSG_F_FRAG)))
+		return rpmsg_virtio_send_chunk(rvdev, src, dst, data, size,
+					       0, 0, wait);
+
+	/* Keep the fragments of the message together on the virtqueue */
+	metal_mutex_acquire(&rvdev->tx_lock);
+	do {
+		status = rpmsg_virtio_send_chunk(rvdev, src, dst,
+						 (const char *)data + offset,
+						 size - offset, offset, size,
+						 wait);
+		if (status < 0)
+			break;
+		offset += status;
+	} while (offset < size);
+	metal_mutex_release(&rvdev->tx_lock);
+
+	return status < 0 ? status : size;
+}
+
+/**
+ * rpmsg_virtio_send_chunk
+ *
+ * Sends a message, or the next fragment of a message, in one buffer.
+ *
+ * @param rvdev  - pointer to rpmsg virtio device
+ * @param src    - source address of channel
+ * @param dst    - destination address of channel
+ * @param data   - data to transmit
+ * @param size   - size of data
+ * @param offset - offset of data in the message
+ * @param total  - size of the message, 0 if it cannot be fragmented
+ * @param wait   - boolean, wait or not for buffer to become
+ *                 available
+ *
+ * @return - size of data sent or negative value for failure.
+ */
+static int rpmsg_virtio_send_chunk(struct rpmsg_virtio_device *rvdev,
+				   uint32_t src, uint32_t dst,
+				   const void *data, int size,
+				   int offset, int total, int wait)
+{
+	struct rpmsg_device *rdev = &rvdev->rdev;
+	void *buffer = NULL;
+	uint16_t idx;
+	uint16_t flags = 0;
+	int tick_count;
+	uint32_t buff_len;
+	int status;
+	int len = size;
+	struct metal_io_region *io;
+
 	if (wait)
 		tick_count = RPMSG_TICK_COUNT / RPMSG_TICKS_PER_INTERVAL;
 	else
@@ -310,9 +461,14 @@ static int rpmsg_virtio_send_offchannel_raw(struct rpmsg_device *rdev,
 		/* Lock the device to enable exclusive access to virtqueues */
 		metal_mutex_acquire(&rdev->lock);
 		avail_size = _rpmsg_virtio_get_buffer_size(rvdev);
-		if (size <= avail_size)
+		if (total && avail_size > 0 && size > avail_size)
+			len = avail_size;
+		if (len <= avail_size)
 			buffer = rpmsg_virtio_get_tx_buffer(rvdev, &buff_len,
 							    &idx);
+		if (!buffer && tick_count)
+			/* Let the other side free the batched buffers */
+			rpmsg_virtio_kick_tx(rvdev, true);
 		metal_mutex_release(&rdev->lock);
 		if (buffer || !tick_count)
 			break;
@@ -324,34 +480,209 @@ static int rpmsg_virtio_send_offchannel_raw(struct rpmsg_device *rdev,
 	if (!buffer)
 		return RPMSG_ERR_NO_BUFF;
 
+	if (total && (offset || len < size)) {
+		flags = RPMSG_HDR_F_FRAG;
+		if (!offset)
+			flags |= RPMSG_HDR_F_FIRST;
+		if (len == size)
+			flags |= RPMSG_HDR_F_LAST;
+	}
+
+	/* Copy data to rpmsg buffer. */
+	io = rvdev->shbuf_io;
+	status = metal_io_block_write(io,
+				      metal_io_virt_to_offset(io,
+				      RPMSG_LOCATE_DATA(buffer)),
+				      data, len);
+	RPMSG_ASSERT(status == len, "failed to write buffer\r\n");
+
+	rpmsg_virtio_send_buffer(rvdev, buffer, src, dst, len, flags,
+				 flags ? total : 0, buff_len, idx);
+
+	return len;
+}
+
+/**
+ * rpmsg_virtio_send_buffer
+ *
+ * Writes the RPMsg header of a filled TX buffer and places the buffer on
+ * the virtqueue for the other side.
+ *
+ * @param rvdev    - pointer to rpmsg virtio device
+ * @param buffer   - buffer pointer
+ * @param src      - source address of channel
+ * @param dst      - destination address of channel
+ * @param size     - size of payload
+ * @param flags    - fragment flags
+ * @param total    - size of the message of a fragment
+ * @param buff_len - buffer length
+ * @param idx      - buffer index
+ */
+static void rpmsg_virtio_send_buffer(struct rpmsg_virtio_device *rvdev,
+				     void *buffer, uint32_t src, uint32_t dst,
+				     int size, uint16_t flags, uint32_t total,
+				     uint32_t buff_len, uint16_t idx)
+{
+	struct rpmsg_device *rdev = &rvdev->rdev;
+	struct rpmsg_hdr rp_hdr;
+	struct metal_io_region *io;
+	int status;
+
 	/* Initialize RPMSG header. */
 	rp_hdr.dst = dst;
 	rp_hdr.src = src;
 	rp_hdr.len = size;
-	rp_hdr.reserved = 0;
+	rp_hdr.reserved = total;
+	rp_hdr.flags = flags;
 
-	/* Copy data to rpmsg buffer. */
 	io = rvdev->shbuf_io;
 	status = metal_io_block_write(io, metal_io_virt_to_offset(io, buffer),
 				      &rp_hdr, sizeof(rp_hdr));
 	RPMSG_ASSERT(status == sizeof(rp_hdr), "failed to write header\r\n");
 
-	status = metal_io_block_write(io,
-				      metal_io_virt_to_offset(io,
-				      RPMSG_LOCATE_DATA(buffer)),
-				      data, size);
-	RPMSG_ASSERT(status == size, "failed to write buffer\r\n");
 	metal_mutex_acquire(&rdev->lock);
 
 	/* Enqueue buffer on virtqueue. */
 	status = rpmsg_virtio_enqueue_buffer(rvdev, buffer, buff_len, idx);
 	RPMSG_ASSERT(status == VQUEUE_SUCCESS, "failed to enqueue buffer\r\n");
 	/* Let the other side know that there is a job to process. */
-	virtqueue_kick(rvdev->svq);
+	rpmsg_virtio_kick_tx(rvdev, false);
 
 	metal_mutex_release(&rdev->lock);
+}
 
-	return size;
+/**
+ * rpmsg_virtio_start_tx_batch
+ *
+ * Opens a TX batch, sent buffers are not notified until it is closed.
+ *
+ * @param rdev - pointer to rpmsg device
+ */
+static void rpmsg_virtio_start_tx_batch(struct rpmsg_device *rdev)
+{
+	struct rpmsg_virtio_device *rvdev;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+
+	metal_mutex_acquire(&rdev->lock);
+	rvdev->tx_batch++;
+	metal_mutex_release(&rdev->lock);
+}
+
+/**
+ * rpmsg_virtio_end_tx_batch
+ *
+ * Closes a TX batch, and notifies the other side of all the buffers sent in
+ * the batch when the outermost batch is closed.
+ *
+ * @param rdev - pointer to rpmsg device
+ */
+static void rpmsg_virtio_end_tx_batch(struct rpmsg_device *rdev)
+{
+	struct rpmsg_virtio_device *rvdev;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+
+	metal_mutex_acquire(&rdev->lock);
+	if (rvdev->tx_batch)
+		rvdev->tx_batch--;
+	rpmsg_virtio_kick_tx(rvdev, false);
+	metal_mutex_release(&rdev->lock);
+}
+
+/**
+ * rpmsg_virtio_get_tx_payload_buffer
+ *
+ * Provides a TX buffer to fill in place. The index of the buffer is kept in
+ * the reserved field of its header until it is sent.
+ *
+ * @param rdev - pointer to rpmsg device
+ * @param len  - size of the payload buffer, set on return
+ * @param wait - boolean, wait or not for buffer to become available
+ *
+ * @return - pointer to the payload buffer, NULL on failure.
+ */
+static void *rpmsg_virtio_get_tx_payload_buffer(struct rpmsg_device *rdev,
+						uint32_t *len, int wait)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdr = NULL;
+	uint16_t idx;
+	int tick_count;
+	uint32_t buff_len;
+	int status;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+
+	status = rpmsg_virtio_get_status(rvdev);
+	/* Validate device state */
+	if (!(status & VIRTIO_CONFIG_STATUS_DRIVER_OK))
+		return NULL;
+
+	if (wait)
+		tick_count = RPMSG_TICK_COUNT / RPMSG_TICKS_PER_INTERVAL;
+	else
+		tick_count = 0;
+
+	while (1) {
+		/* Lock the device to enable exclusive access to virtqueues */
+		metal_mutex_acquire(&rdev->lock);
+		rp_hdr = rpmsg_virtio_get_tx_buffer(rvdev, &buff_len, &idx);
+		if (!rp_hdr && tick_count)
+			/* Let the other side free the batched buffers */
+			rpmsg_virtio_kick_tx(rvdev, true);
+		metal_mutex_release(&rdev->lock);
+		if (rp_hdr || !tick_count)
+			break;
+		metal_sleep_usec(RPMSG_TICKS_PER_INTERVAL);
+		tick_count--;
+	}
+	if (!rp_hdr)
+		return NULL;
+
+	rp_hdr->reserved = idx;
+	*len = rpmsg_virtio_get_buffer_len(rvdev, rvdev->svq, idx) -
+	       sizeof(struct rpmsg_hdr);
+
+	return RPMSG_LOCATE_DATA(rp_hdr);
+}
+
+/**
+ * rpmsg_virtio_send_offchannel_nocopy
+ *
+ * Sends a TX buffer obtained with rpmsg_virtio_get_tx_payload_buffer.
+ *
+ * @param rdev - pointer to rpmsg device
+ * @param src  - source address of channel
+ * @param dst  - destination address of channel
+ * @param data - payload buffer
+ * @param len  - size of payload
+ *
+ * @return - size of data sent or negative value for failure.
+ */
+static int rpmsg_virtio_send_offchannel_nocopy(struct rpmsg_device *rdev,
+					       uint32_t src, uint32_t dst,
+					       const void *data, int len)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdr;
+	uint32_t buff_len;
+	uint16_t idx;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+
+	rp_hdr = RPMSG_LOCATE_HDR(data);
+	idx = rp_hdr->reserved & RPMSG_BUF_IDX_MASK;
+	buff_len = rpmsg_virtio_get_buffer_len(rvdev, rvdev->svq, idx);
+
+	/* Send the buffer anyway, it cannot be given back */
+	if (len < 0 || (uint32_t)len > buff_len - sizeof(*rp_hdr))
+		len = buff_len - sizeof(*rp_hdr);
+
+	rpmsg_virtio_send_buffer(rvdev, rp_hdr, src, dst, len, 0, 0, buff_len,
+				 idx);
+
+	return len;
 }
 
 /**
@@ -368,6 +699,87 @@ static void rpmsg_virtio_tx_callback(struct virtqueue *vq)
 	(void)vq;
 }
 
+/**
+ * rpmsg_virtio_rx_fragment
+ *
+ * Copies a received fragment in the reassembly buffer. A fragment that does
+ * not continue the message being reassembled drops the message.
+ *
+ * @param rvdev  - pointer to rpmsg virtio device
+ * @param rp_hdr - header of the received fragment
+ *
+ * @return - header of the reassembled message when the fragment completes
+ *           it, NULL otherwise
+ */
+static struct rpmsg_hdr *
+rpmsg_virtio_rx_fragment(struct rpmsg_virtio_device *rvdev,
+			 struct rpmsg_hdr *rp_hdr)
+{
+	struct rpmsg_virtio_rx_frag *frag = &rvdev->rx_frag;
+	struct metal_io_region *io = rvdev->shbuf_io;
+	struct rpmsg_hdr *msg_hdr;
+	uint32_t total = rp_hdr->reserved;
+
+	if (rp_hdr->flags & RPMSG_HDR_F_FIRST) {
+		if (frag->total)
+			metal_log(METAL_LOG_WARNING,
+				  "rpmsg: dropped incomplete message\r\n");
+		frag->total = 0;
+		if (total > frag->size) {
+			/* Grow the reassembly buffer to the largest message */
+			metal_free_memory(frag->buf);
+			frag->size = 0;
+			frag->buf = metal_allocate_memory(sizeof(*msg_hdr) +
+							  total);
+			if (!frag->buf) {
+				metal_log(METAL_LOG_ERROR,
+					  "rpmsg: no memory for %u bytes\r\n",
+					  (unsigned int)total);
+				return NULL;
+			}
+			frag->size = total;
+		}
+		frag->total = total;
+		frag->len = 0;
+		frag->src = rp_hdr->src;
+		frag->dst = rp_hdr->dst;
+	} else if (!frag->total || frag->total != total ||
+		   frag->src != rp_hdr->src || frag->dst != rp_hdr->dst) {
+		/* Not the next fragment of the current message */
+		frag->total = 0;
+		return NULL;
+	}
+
+	if (rp_hdr->len > frag->total - frag->len) {
+		frag->total = 0;
+		return NULL;
+	}
+
+	msg_hdr = frag->buf;
+	metal_io_block_read(io,
+			    metal_io_virt_to_offset(io,
+			    RPMSG_LOCATE_DATA(rp_hdr)),
+			    (char *)RPMSG_LOCATE_DATA(msg_hdr) + frag->len,
+			    rp_hdr->len);
+	frag->len += rp_hdr->len;
+
+	if (!(rp_hdr->flags & RPMSG_HDR_F_LAST))
+		return NULL;
+	if (frag->len != frag->total) {
+		frag->total = 0;
+		return NULL;
+	}
+
+	/* The message cannot be held, its buffer is reused */
+	msg_hdr->src = frag->src;
+	msg_hdr->dst = frag->dst;
+	msg_hdr->len = 0;
+	msg_hdr->reserved = 0;
+	msg_hdr->flags = RPMSG_HDR_F_FRAG;
+
+	return msg_hdr;
+}
+
 /**
  * rpmsg_virtio_rx_callback
  *
@@ -389,8 +801,14 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 
 	metal_mutex_acquire(&rdev->lock);
 
+	/*
+	 * No notification is needed while the buffers are processed, all
+	 * the available buffers are taken in this callback.
+	 */
+	virtqueue_disable_cb(rvdev->rvq);
+
 	/* Process the received data from remote node */
-	rp_hdr = rpmsg_virtio_get_rx_buffer(rvdev, &len, &idx);
+	rp_hdr = rpmsg_virtio_next_rx_buffer(rvdev, &len, &idx);
 
 	metal_mutex_release(&rdev->lock);
 
@@ -408,8 +826,26 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 				 */
 				ept->dest_addr = rp_hdr->src;
 			}
-			status = ept->cb(ept, RPMSG_LOCATE_DATA(rp_hdr),
-					 rp_hdr->len, rp_hdr->src, ept->priv);
+			if (rp_hdr->flags & RPMSG_HDR_F_FRAG) {
+				struct rpmsg_hdr *msg_hdr;
+
+				status = RPMSG_SUCCESS;
+				msg_hdr = rpmsg_virtio_rx_fragment(rvdev,
+								   rp_hdr);
+				if (msg_hdr) {
+					status = ept->cb(ept,
+						RPMSG_LOCATE_DATA(msg_hdr),
+						rvdev->rx_frag.total,
+						msg_hdr->src, ept->priv);
+					rvdev->rx_frag.total = 0;
+				}
+			} else {
+				/* Keep the index in case the buffer is held */
+				rp_hdr->reserved = idx;
+				status = ept->cb(ept, RPMSG_LOCATE_DATA(rp_hdr),
+						 rp_hdr->len, rp_hdr->src,
+						 ept->priv);
+			}
 
 			RPMSG_ASSERT(status == RPMSG_SUCCESS,
 				     "unexpected callback status\r\n");
@@ -417,10 +853,12 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 
 		metal_mutex_acquire(&rdev->lock);
 
-		/* Return used buffers. */
-		rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
+		/* Return used buffers, unless held by the endpoint. */
+		if (!ept || (rp_hdr->flags & RPMSG_HDR_F_FRAG) ||
+		    !(rp_hdr->reserved & RPMSG_BUF_HELD))
+			rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
 
-		rp_hdr = rpmsg_virtio_get_rx_buffer(rvdev, &len, &idx);
+		rp_hdr = rpmsg_virtio_next_rx_buffer(rvdev, &len, &idx);
 		if (rp_hdr == NULL) {
 			/* tell peer we return some rx buffer */
 			virtqueue_kick(rvdev->rvq);
@@ -429,6 +867,64 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 	}
 }
 
+/**
+ * rpmsg_virtio_hold_rx_buffer
+ *
+ * Marks a received buffer as held, so it is not returned when the endpoint
+ * callback returns.
+ *
+ * @param rdev  - pointer to rpmsg device
+ * @param rxbuf - payload of the received buffer
+ */
+static void rpmsg_virtio_hold_rx_buffer(struct rpmsg_device *rdev,
+					void *rxbuf)
+{
+	struct rpmsg_hdr *rp_hdr;
+
+	(void)rdev;
+
+	rp_hdr = RPMSG_LOCATE_HDR(rxbuf);
+	/* A reassembled message is not in a virtqueue buffer */
+	if (rp_hdr->flags & RPMSG_HDR_F_FRAG)
+		return;
+	/* The buffer is owned by the callback, no lock is needed */
+	rp_hdr->reserved |= RPMSG_BUF_HELD;
+}
+
+/**
+ * rpmsg_virtio_release_rx_buffer
+ *
+ * Returns a held buffer to the other side.
+ *
+ * @param rdev  - pointer to rpmsg device
+ * @param rxbuf - payload of the held buffer
+ */
+static void rpmsg_virtio_release_rx_buffer(struct rpmsg_device *rdev,
+					   void *rxbuf)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdr;
+	uint16_t idx;
+	uint32_t len;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	rp_hdr = RPMSG_LOCATE_HDR(rxbuf);
+
+	if ((rp_hdr->flags & RPMSG_HDR_F_FRAG) ||
+	    !(rp_hdr->reserved & RPMSG_BUF_HELD))
+		return;
+
+	idx = rp_hdr->reserved & RPMSG_BUF_IDX_MASK;
+	rp_hdr->reserved = 0;
+
+	metal_mutex_acquire(&rdev->lock);
+	len = rpmsg_virtio_get_buffer_len(rvdev, rvdev->rvq, idx);
+	rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
+	/* Tell peer we return some rx buffer */
+	virtqueue_kick(rvdev->rvq);
+	metal_mutex_release(&rdev->lock);
+}
+
 /**
  * rpmsg_virtio_ns_callback
  *
@@ -496,6 +992,37 @@ static int rpmsg_virtio_ns_callback(struct rpmsg_endpoint *ept, void *data,
 	return RPMSG_SUCCESS;
 }
 
+void rpmsg_virtio_set_rx_poll(struct rpmsg_virtio_device *rvdev, bool enable)
+{
+	struct rpmsg_device *rdev;
+
+	if (!rvdev || !rvdev->rvq)
+		return;
+	rdev = &rvdev->rdev;
+	metal_mutex_acquire(&rdev->lock);
+	rvdev->rx_poll = enable;
+	if (enable)
+		virtqueue_disable_cb(rvdev->rvq);
+	else
+		virtqueue_enable_cb(rvdev->rvq);
+	metal_mutex_release(&rdev->lock);
+
+	/* Process the messages received while switching to notifications */
+	if (!enable)
+		rpmsg_virtio_poll(rvdev);
+}
+
+int rpmsg_virtio_poll(struct rpmsg_virtio_device *rvdev)
+{
+	int pending;
+
+	pending = virtqueue_get_pending_count(rvdev->rvq);
+	if (pending)
+		rpmsg_virtio_rx_callback(rvdev->rvq);
+
+	return pending;
+}
+
 int rpmsg_virtio_get_buffer_size(struct rpmsg_device *rdev)
 {
 	int size;
@@ -515,6 +1042,17 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 		    rpmsg_ns_bind_cb ns_bind_cb,
 		    struct metal_io_region *shm_io,
 		    struct rpmsg_virtio_shm_pool *shpool)
+{
+	return rpmsg_init_vdev_with_config(rvdev, vdev, ns_bind_cb, shm_io,
+					   shpool, NULL);
+}
+
+int rpmsg_init_vdev_with_config(struct rpmsg_virtio_device *rvdev,
+				struct virtio_device *vdev,
+				rpmsg_ns_bind_cb ns_bind_cb,
+				struct metal_io_region *shm_io,
+				struct rpmsg_virtio_shm_pool *shpool,
+				const struct rpmsg_virtio_config *config)
 {
 	struct rpmsg_device *rdev;
 	const char *vq_names[RPMSG_NUM_VRINGS];
@@ -529,6 +1067,27 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 	rdev->ns_bind_cb = ns_bind_cb;
 	vdev->priv = rvdev;
 	rdev->ops.send_offchannel_raw = rpmsg_virtio_send_offchannel_raw;
+	rdev->ops.hold_rx_buffer = rpmsg_virtio_hold_rx_buffer;
+	rdev->ops.release_rx_buffer = rpmsg_virtio_release_rx_buffer;
+	rdev->ops.get_tx_payload_buffer = rpmsg_virtio_get_tx_payload_buffer;
+	rdev->ops.send_offchannel_nocopy = rpmsg_virtio_send_offchannel_nocopy;
+	rdev->ops.start_tx_batch = rpmsg_virtio_start_tx_batch;
+	rdev->ops.end_tx_batch = rpmsg_virtio_end_tx_batch;
+	rvdev->tx_batch = 0;
+	rvdev->rx_poll = false;
+	memset(&rvdev->rx_frag, 0, sizeof(rvdev->rx_frag));
+	metal_mutex_init(&rvdev->tx_lock);
+	if (config) {
+		if (config->h2r_buf_size <= sizeof(struct rpmsg_hdr) ||
+		    config->h2r_buf_size > RPMSG_MAX_BUFFER_SIZE ||
+		    config->r2h_buf_size <= sizeof(struct rpmsg_hdr) ||
+		    config->r2h_buf_size > RPMSG_MAX_BUFFER_SIZE)
+			return RPMSG_ERR_PARAM;
+		rvdev->config = *config;
+	} else {
+		rvdev->config.h2r_buf_size = RPMSG_BUFFER_SIZE;
+		rvdev->config.r2h_buf_size = RPMSG_BUFFER_SIZE;
+	}
 	role = rpmsg_virtio_get_role(rvdev);
 
 #ifndef VIRTIO_MASTER_ONLY
@@ -600,11 +1159,11 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 		unsigned int idx;
 		void *buffer;
 
-		vqbuf.len = RPMSG_BUFFER_SIZE;
+		vqbuf.len = rvdev->config.r2h_buf_size;
 		for (idx = 0; idx < rvdev->rvq->vq_nentries; idx++) {
 			/* Initialize TX virtqueue buffers for remote device */
 			buffer = rpmsg_virtio_shm_pool_get_buffer(shpool,
-							RPMSG_BUFFER_SIZE);
+						rvdev->config.r2h_buf_size);
 
 			if (!buffer) {
 				return RPMSG_ERR_NO_BUFF;
@@ -615,7 +1174,7 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 			metal_io_block_set(shm_io,
 					   metal_io_virt_to_offset(shm_io,
 								   buffer),
-					   0x00, RPMSG_BUFFER_SIZE);
+					   0x00, rvdev->config.r2h_buf_size);
 			status =
 				virtqueue_add_buffer(rvdev->rvq, &vqbuf, 0, 1,
 						     buffer);
@@ -665,5 +1224,11 @@ void rpmsg_deinit_vdev(struct rpmsg_virtio_device *rvdev)
 	rvdev->rvq = 0;
 	rvdev->svq = 0;
 
+	metal_free_memory(rvdev->rx_frag.buf);
+	rvdev->rx_frag.buf = NULL;
+	rvdev->rx_frag.size = 0;
+	rvdev->rx_frag.total = 0;
+
+	metal_mutex_deinit(&rvdev->tx_lock);
 	metal_mutex_deinit(&rdev->lock);
 }
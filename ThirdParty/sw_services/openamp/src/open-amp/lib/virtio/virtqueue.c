@@ -410,6 +410,34 @@ uint32_t virtqueue_get_desc_size(struct virtqueue *vq)
 	return len;
 }
 
+/**
+ * virtqueue_get_pending_count - Returns the number of buffers placed in the
+ *                               virtqueue by the other side and not yet
+ *                               retrieved
+ *
+ * The indexes are read from the vring directly, so this function can be
+ * used to poll the virtqueue without notification.
+ *
+ * @param vq            - Pointer to VirtIO queue control block
+ *
+ * @return              - Number of pending buffers
+ */
+int virtqueue_get_pending_count(struct virtqueue *vq)
+{
+	atomic_thread_fence(memory_order_seq_cst);
+
+#ifndef VIRTIO_SLAVE_ONLY
+	if (vq->vq_dev->role == VIRTIO_DEV_MASTER)
+		return virtqueue_nused(vq);
+#endif /*VIRTIO_SLAVE_ONLY*/
+#ifndef VIRTIO_MASTER_ONLY
+	if (vq->vq_dev->role == VIRTIO_DEV_SLAVE)
+		return virtqueue_navail(vq);
+#endif /*VIRTIO_MASTER_ONLY*/
+
+	return 0;
+}
+
 /**************************************************************************
  *                            Helper Functions                            *
  **************************************************************************/
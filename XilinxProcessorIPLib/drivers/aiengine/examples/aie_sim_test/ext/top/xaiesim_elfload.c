@@ -46,6 +46,7 @@
 * 1.6  Nishad  12/05/2018  Renamed ME attributes to AIE
 * 1.7  Hyun    09/13/2019  Used global IO accessors and added more __AIESIM__
 * 1.8  Hyun    09/13/2019  Added XAieSim_LoadElfMem()
+* 1.9  Hyun    10/14/2019  Parse the ELF once to load it to multiple tiles
 * </pre>
 *
 ******************************************************************************/
@@ -69,108 +70,88 @@ extern XAieGbl_Config XAieGbl_ConfigTable[];
 /*****************************************************************************/
 /**
 *
-* This routine is used to write to the specified section by reading the
-* corresponding data from the ELF buffer.
+* This routine adds a segment to the parsed ELF image. Data memory segments
+* are split at the 32 KB bank boundaries, as each bank can belong to a
+* different tile.
 *
-* @param	TileInstPtr: Pointer to the Tile instance structure.
-* @param        SectName: Name of the section.
-* @param        SectPtr: Poiner to the section entry in the ELF buffer.
-* @param	ElfPtr: Pointer to the ELF buffer.
+* @param	ImgPtr: Pointer to the parsed ELF image.
+* @param	Type: XAIESIM_ELF_SEG_PRGMEM, _DATMEM or _BSS.
+* @param	Addr: Section's loadable address.
+* @param	Size: Section size in bytes.
+* @param	Data: Section data in the ELF buffer, NULL for bss.
 *
-* @return	None.
+* @return	XAIESIM_SUCCESS on success, else XAIESIM_FAILURE.
 *
 * @note		None.
 *
 *******************************************************************************/
-static void XAieSim_WriteSectionMem(XAieSim_Tile *TileInstPtr, uint8 *SectName,
-		Elf32_Shdr *SectPtr, uint8 *ElfPtr)
+static uint32 XAieSim_ElfAddSeg(XAieSim_ElfImage *ImgPtr, uint32 Type,
+		uint32 Addr, uint32 Size, uint8 *Data)
 {
-	uint32 Idx;
-	uint32 DmbOff;
-	uint32 SectAddr;
-	uint32 RemSize;
-	uint32 DoneSize;
-	uint64_t DmbAddr;
-	uint64_t TgtTileAddr;
+	XAieSim_ElfSeg *SegPtr;
+	uint32 SegSize;
 
-	if(strstr(SectName, "data.DMb") != NULL) {
-		TgtTileAddr = XAieSim_GetTargetTileAddr(TileInstPtr,
-				SectPtr->sh_addr);
-
-		SectAddr = SectPtr->sh_addr;
-		RemSize = SectPtr->sh_size;
-		DoneSize = 0U;
-
-		/* Use 32 bit loads to match sim output */
-		for(Idx = 0U; Idx < RemSize; Idx += 4U){
-			/* Mask address as per the Data memory offset*/
-			DmbOff = (SectAddr &
-					XAIESIM_ELF_TILEADDR_DMB_MASK) + Idx;
-
-			if(DmbOff & 0x8000U) {
-				/*
-				 * 32 KB boundary cross. Data section
-				 * moving to the memory bank of next
-				 * cardinal direction. Change the target
-				 * tile address
-				 */
-				SectPtr->sh_addr += 0x8000U;
-				TgtTileAddr =
-					XAieSim_GetTargetTileAddr(TileInstPtr,
-							(SectPtr->sh_addr &
-							 0x1FFFFU));
-				SectAddr = 0x0U;
-				Idx = 0U;
-				DmbOff = 0U;
-				RemSize -= DoneSize;
-			}
+	while(Size > 0U) {
+		if(ImgPtr->NumSegs == XAIESIM_ELF_SEG_NUMMAX) {
+			XAieSim_print("ERROR: Too many ELF segments\n");
+			return XAIESIM_FAILURE;
+		}
 
-			DmbAddr = TgtTileAddr +
-				XAIESIM_ELF_TILECORE_DATMEM + DmbOff;
-			XAieGbl_Write32(DmbAddr, *ElfPtr++);
-			DoneSize += 4U;
+		SegSize = Size;
+		if((Type != XAIESIM_ELF_SEG_PRGMEM) &&
+				((Addr & XAIESIM_ELF_TILEADDR_DMB_MASK) +
+				 Size > 0x8000U)) {
+			SegSize = 0x8000U -
+				(Addr & XAIESIM_ELF_TILEADDR_DMB_MASK);
 		}
-	} else {
-		TgtTileAddr = TileInstPtr->TileAddr+XAIESIM_ELF_TILECORE_PRGMEM +
-			SectPtr->sh_addr;
 
-		for(Idx = 0U; Idx < SectPtr->sh_size; Idx += 4U) {
-			XAieGbl_Write32((TgtTileAddr + Idx), *ElfPtr++);
+		SegPtr = &ImgPtr->Segs[ImgPtr->NumSegs];
+		SegPtr->Type = Type;
+		SegPtr->Addr = Addr;
+		SegPtr->Size = SegSize;
+		SegPtr->Data = Data;
+		ImgPtr->NumSegs++;
+
+		Addr += SegSize;
+		Size -= SegSize;
+		if(Data != XAIE_NULL) {
+			Data += SegSize;
 		}
 	}
+
+	return XAIESIM_SUCCESS;
 }
 
 /*****************************************************************************/
 /**
 *
-* This is the API to load the specified ELF to the target AIE Tile program
-* memory followed by clearing of the BSS sections.
+* This is the API to parse an ELF in memory into the list of segments to load
+* to a tile. The image only refers to the ELF buffer, which should be kept
+* until the image is loaded, and can be loaded to any number of tiles.
 *
-* @param	TileInstPtr - Pointer to the Tile instance structure.
-* @param	ElfPtr: Path to the ELF memory
+* @param	ElfPtr: Pointer to the ELF in memory.
+* @param	ImgPtr: Pointer to the parsed ELF image to fill.
 *
 * @return	XAIESIM_SUCCESS on success, else XAIESIM_FAILURE.
 *
 * @note		None.
 *
 *******************************************************************************/
-uint32 XAieSim_LoadElfMem(XAieSim_Tile *TileInstPtr, uint8 *ElfPtr,
-		uint8 LoadSym)
+uint32 XAieSim_ElfParseMem(uint8 *ElfPtr, XAieSim_ElfImage *ImgPtr)
 {
-	Elf32_Ehdr *ElfHdr = ElfPtr;
+	Elf32_Ehdr *ElfHdr = (Elf32_Ehdr *)ElfPtr;
 	Elf32_Shdr *SectHdr;
+	uint8 *DataPtr;
+	uint32 Count = 0U;
+	uint32 ShNameIdx = 0U;
+	uint32 Status = XAIESIM_SUCCESS;
 
-	uint8 Count = 0U;
-	uint8 ShNameIdx = 0U;
+	ImgPtr->NumSegs = 0U;
 
-	uint32 Idx;
-	uint8 *DataPtr;
-	uint32 DmbOff;
-	uint32 SectAddr;
-	uint32 RemSize;
-	uint32 DoneSize;
-	uint64_t DmbAddr;
-	uint64_t TgtTileAddr;
+	if(memcmp(ElfHdr->e_ident, ELFMAG, SELFMAG) != 0) {
+		XAieSim_print("ERROR: Invalid ELF\n");
+		return XAIESIM_FAILURE;
+	}
 
 	XAieSim_print("**** ELF HEADER ****\n");
 	XAieSim_print("e_type\t\t : %08x\ne_machine\t : %08x\ne_version\t : "
@@ -184,7 +165,7 @@ uint32 XAieSim_LoadElfMem(XAieSim_Tile *TileInstPtr, uint8 *ElfPtr,
 			ElfHdr->e_ehsize, ElfHdr->e_phentsize, ElfHdr->e_phnum,
 			ElfHdr->e_shentsize, ElfHdr->e_shnum, ElfHdr->e_shstrndx);
 
-	SectHdr = ElfPtr + ElfHdr->e_shoff;
+	SectHdr = (Elf32_Shdr *)(ElfPtr + ElfHdr->e_shoff);
 
 	/*
 	 * Get the section names from the .shstrtab section. First find the
@@ -217,73 +198,156 @@ uint32 XAieSim_LoadElfMem(XAieSim_Tile *TileInstPtr, uint8 *ElfPtr,
 	}
 
 	Count = 0U;
-	while(Count < ElfHdr->e_shnum) {
-		/* Copy the program data sections to memory */
+	while((Count < ElfHdr->e_shnum) && (Status == XAIESIM_SUCCESS)) {
+		/* Program data sections */
 		if((SectHdr[Count].sh_type == SHT_PROGBITS) &&
 				((SectHdr[Count].sh_flags &
 				  (SHF_ALLOC | SHF_EXECINSTR)) ||
 				 (SectHdr[Count].sh_flags &
 				  (SHF_ALLOC | SHF_WRITE)))) {
-
-			XAieSim_WriteSectionMem(TileInstPtr,
-					DataPtr + SectHdr[Count].sh_name,
-					&SectHdr[Count],
+			Status = XAieSim_ElfAddSeg(ImgPtr,
+					(strstr(DataPtr + SectHdr[Count].sh_name,
+						"data.DMb") != NULL) ?
+					XAIESIM_ELF_SEG_DATMEM :
+					XAIESIM_ELF_SEG_PRGMEM,
+					SectHdr[Count].sh_addr,
+					SectHdr[Count].sh_size,
 					ElfPtr + SectHdr[Count].sh_offset);
 		}
 
-		/* Zero out the bss sections */
+		/*
+		 * The bss sections are zeroed. Use the section header size,
+		 * the AIE compiler uses the section header for load size.
+		 */
 		if((SectHdr[Count].sh_type == SHT_NOBITS) &&
 				(strstr(DataPtr + SectHdr[Count].sh_name,
 					"bss.DMb") != NULL)) {
-			XAieSim_print("Zeroing out the bss sections\n");
+			Status = XAieSim_ElfAddSeg(ImgPtr,
+					XAIESIM_ELF_SEG_BSS,
+					SectHdr[Count].sh_addr,
+					SectHdr[Count].sh_size, XAIE_NULL);
+		}
+		Count++;
+	}
 
-			TgtTileAddr = XAieSim_GetTargetTileAddr(TileInstPtr,
-					SectHdr[Count].sh_addr);
-			SectAddr = SectHdr[Count].sh_addr;
-			/*
-			 * Use the section header size. The AIE compiler uses
-			 * the section header for load size.
-			 */
-			RemSize = SectHdr[Count].sh_size;
-			DoneSize = 0U;
+	return Status;
+}
 
-			/* Use 32 bit loads to match sim output */
-			for(Idx = 0U; Idx < RemSize; Idx += 4U){
-				/* Mask address as per the Data memory offset*/
-				DmbOff = (SectAddr &
-						XAIESIM_ELF_TILEADDR_DMB_MASK) + Idx;
-
-				if(DmbOff & 0x8000U) {
-					/*
-					 * 32 KB boundary cross. Data section
-					 * moving to the memory bank of next
-					 * cardinal direction. Change the target
-					 * tile address
-					 */
-					SectHdr[Count].sh_addr += 0x8000U;
-					TgtTileAddr =
-						XAieSim_GetTargetTileAddr(TileInstPtr,
-								(SectHdr[Count].sh_addr &
-								 0x1FFFFU));
-					SectAddr = 0x0U;
-					Idx = 0U;
-					DmbOff = 0U;
-					RemSize -= DoneSize;
-					DoneSize = 0U;
-				}
-
-				DmbAddr = TgtTileAddr +
-					XAIESIM_ELF_TILECORE_DATMEM + DmbOff;
-				XAieGbl_Write32(DmbAddr, 0U);
-				DoneSize += 4U;
+/*****************************************************************************/
+/**
+*
+* This is the API to load a parsed ELF image to a tile. The program memory is
+* written with 128 bit writes where the section is aligned.
+*
+* @param	TileInstPtr - Pointer to the Tile instance structure.
+* @param	ImgPtr: Pointer to the parsed ELF image.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieSim_LoadElfImage(XAieSim_Tile *TileInstPtr, XAieSim_ElfImage *ImgPtr)
+{
+	XAieSim_ElfSeg *SegPtr;
+	uint32 Data[4U];
+	uint32 SegIdx;
+	uint32 Idx;
+	uint64_t TgtAddr;
+
+	for(SegIdx = 0U; SegIdx < ImgPtr->NumSegs; SegIdx++) {
+		SegPtr = &ImgPtr->Segs[SegIdx];
+
+		if(SegPtr->Type == XAIESIM_ELF_SEG_PRGMEM) {
+			TgtAddr = TileInstPtr->TileAddr +
+				XAIESIM_ELF_TILECORE_PRGMEM + SegPtr->Addr;
+		} else {
+			TgtAddr = XAieSim_GetTargetTileAddr(TileInstPtr,
+					SegPtr->Addr) +
+				XAIESIM_ELF_TILECORE_DATMEM +
+				(SegPtr->Addr & XAIESIM_ELF_TILEADDR_DMB_MASK);
+		}
+
+		if(SegPtr->Type == XAIESIM_ELF_SEG_BSS) {
+			for(Idx = 0U; Idx < SegPtr->Size; Idx += 4U) {
+				XAieGbl_Write32(TgtAddr + Idx, 0U);
 			}
+			continue;
+		}
+
+		Idx = 0U;
+		if((SegPtr->Type == XAIESIM_ELF_SEG_PRGMEM) &&
+				((TgtAddr & 0xFU) == 0U)) {
+			/* The ELF buffer may not be word aligned */
+			for(; Idx + 16U <= SegPtr->Size; Idx += 16U) {
+				memcpy(Data, SegPtr->Data + Idx, 16U);
+				XAieGbl_Write128(TgtAddr + Idx, Data);
+			}
+		}
+
+		for(; Idx < SegPtr->Size; Idx += 4U) {
+			Data[0U] = 0U;
+			memcpy(Data, SegPtr->Data + Idx,
+				(SegPtr->Size - Idx < 4U) ?
+				(SegPtr->Size - Idx) : 4U);
+			XAieGbl_Write32(TgtAddr + Idx, Data[0U]);
 		}
-		Count++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the API to load the specified ELF to a set of AIE tiles. The ELF is
+* parsed once and the same image is loaded to all the tiles.
+*
+* @param	TileInstPtrs - Array of pointers to the tile instances.
+* @param	NumTiles: Number of tiles in TileInstPtrs.
+* @param	ElfPtr: Path to the ELF memory
+* @param	LoadSym: Not used, the ELF is not a file.
+*
+* @return	XAIESIM_SUCCESS on success, else XAIESIM_FAILURE.
+*
+* @note		None.
+*
+*******************************************************************************/
+uint32 XAieSim_LoadElfMemMulti(XAieSim_Tile **TileInstPtrs, uint32 NumTiles,
+		uint8 *ElfPtr, uint8 LoadSym)
+{
+	XAieSim_ElfImage Img;
+	uint32 Idx;
+
+	if(XAieSim_ElfParseMem(ElfPtr, &Img) != XAIESIM_SUCCESS) {
+		return XAIESIM_FAILURE;
+	}
+
+	for(Idx = 0U; Idx < NumTiles; Idx++) {
+		XAieSim_LoadElfImage(TileInstPtrs[Idx], &Img);
 	}
 
 	return XAIESIM_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the API to load the specified ELF to the target AIE Tile program
+* memory followed by clearing of the BSS sections.
+*
+* @param	TileInstPtr - Pointer to the Tile instance structure.
+* @param	ElfPtr: Path to the ELF memory
+*
+* @return	XAIESIM_SUCCESS on success, else XAIESIM_FAILURE.
+*
+* @note		None.
+*
+*******************************************************************************/
+uint32 XAieSim_LoadElfMem(XAieSim_Tile *TileInstPtr, uint8 *ElfPtr,
+		uint8 LoadSym)
+{
+	return XAieSim_LoadElfMemMulti(&TileInstPtr, 1U, ElfPtr, LoadSym);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -43,6 +43,7 @@
 * 1.3  Naresh  07/11/2018  Updated copyright info
 * 1.4  Nishad  12/05/2018  Renamed ME attributes to AIE
 * 1.8  Hyun    09/13/2019  Added XAieSim_LoadElfMem()
+* 1.9  Hyun    10/14/2019  Added the parsed ELF image for multiple tiles
 * </pre>
 *
 ******************************************************************************/
@@ -57,6 +58,11 @@
 /************************** Constant Definitions *****************************/
 #define XAIESIM_ELF_SECTION_NUMMAX		100
 #define XAIESIM_ELF_SECTION_NAMEMAXLEN		100
+#define XAIESIM_ELF_SEG_NUMMAX			128
+
+#define XAIESIM_ELF_SEG_PRGMEM			0U
+#define XAIESIM_ELF_SEG_DATMEM			1U
+#define XAIESIM_ELF_SEG_BSS			2U
 
 #define XAIESIM_ELF_TILEADDR_DMB_MASK            0x7FFFU	/* 32 KB */
 #define XAIESIM_ELF_TILEADDR_DMB_CARD_OFF        0x18000U
@@ -80,11 +86,34 @@ typedef struct {
 	uint32 end;	/**< Stack end address */
 } XAieSim_StackSz;
 
+/**
+ * This typedef contains a section to load, data sections are split at the
+ * 32 KB data memory bank boundaries.
+ */
+typedef struct {
+	uint32 Type;	/**< XAIESIM_ELF_SEG_PRGMEM, _DATMEM or _BSS */
+	uint32 Addr;	/**< Section's loadable address */
+	uint32 Size;	/**< Size in bytes */
+	uint8 *Data;	/**< Data in the ELF buffer, NULL for bss */
+} XAieSim_ElfSeg;
+
+/**
+ * This typedef contains an ELF parsed once to be loaded to many tiles.
+ */
+typedef struct {
+	uint32 NumSegs;					/**< Valid segments */
+	XAieSim_ElfSeg Segs[XAIESIM_ELF_SEG_NUMMAX];	/**< Segments */
+} XAieSim_ElfImage;
+
 /***************************** Macro Definitions *****************************/
 
 /************************** Function Prototypes  *****************************/
 uint32 XAieSim_LoadElfMem(XAieGbl_Tile *TileInstPtr, uint8 *ElfPtr, uint8 LoadSym);
 uint32 XAieSim_LoadElf(XAieGbl_Tile *TileInstPtr, uint8 *ElfPtr, uint8 LoadSym);
+uint32 XAieSim_LoadElfMemMulti(XAieGbl_Tile **TileInstPtrs, uint32 NumTiles,
+		uint8 *ElfPtr, uint8 LoadSym);
+uint32 XAieSim_ElfParseMem(uint8 *ElfPtr, XAieSim_ElfImage *ImgPtr);
+void XAieSim_LoadElfImage(XAieGbl_Tile *TileInstPtr, XAieSim_ElfImage *ImgPtr);
 uint32 XAieSim_GetStackRange(uint8 *MapPtr, XAieSim_StackSz *StackSzPtr);
 void XAieSim_LoadSymbols(XAieGbl_Tile *TileInstPtr, uint8 *ElfPtr);
 void XAieSim_WriteSection(XAieGbl_Tile *TileInstPtr, uint8 *SectName, Elf32_Shdr *SectPtr, FILE *Fd);
@@ -42,19 +42,37 @@
 * 1.3  Hyun    01/08/2019  Use the poll function
 * 1.4  Hyun    06/20/2019  Added APIs for individual BD / Channel reset
 * 1.5  Hyun    06/20/2019  Add XAieDma_ShimSoftInitialize()
+* 1.6  Hyun    10/14/2019  Add the Shim DMA queue
 * </pre>
 *
 ******************************************************************************/
 #include "xaiegbl_defs.h"
 #include "xaiegbl.h"
+#include "xaiegbl_params.h"
 #include "xaiedma_shim.h"
+#include "xaietile_event.h"
+#include "xaietile_pl.h"
 
 /***************************** Include Files *********************************/
 
 /***************************** Macro Definitions *****************************/
 #define XAIEDMA_SHIM_DONE_DEF_WAIT_USECS		1000000U
 
+/* IRQ events of the 1st level interrupt controller */
+#define XAIEDMA_SHIM_QUEUE_IRQEVT_NUM		4U
+#define XAIEDMA_SHIM_QUEUE_IRQEVT_WIDTH		8U
+#define XAIEDMA_SHIM_QUEUE_IRQEVT_MASK		0x7FU
+/* 1st level interrupt input of the IRQ event 0 */
+#define XAIEDMA_SHIM_QUEUE_IRQEVT_L1_BIT	16U
+
 /************************** Variable Definitions *****************************/
+/* Event generated by each channel when it finishes a BD */
+static const u8 XAieDma_ShimQueueEvent[XAIEDMA_SHIM_MAX_NUM_CHANNELS] = {
+	XAIETILE_EVENT_SHIM_DMA_S2MM_0_FINISHED_BD_NOC,
+	XAIETILE_EVENT_SHIM_DMA_S2MM_1_FINISHED_BD_NOC,
+	XAIETILE_EVENT_SHIM_DMA_MM2S_0_FINISHED_BD_NOC,
+	XAIETILE_EVENT_SHIM_DMA_MM2S_1_FINISHED_BD_NOC
+};
 
 /************************** Function Definitions *****************************/
 /*****************************************************************************/
@@ -613,6 +631,355 @@ u8 XAieDma_ShimPendingBdCount(XAieDma_Shim *DmaInstPtr, u32 ChNum)
 	return StartQSize;
 }
 
+/*****************************************************************************/
+/**
+*
+* This API initializes a Shim DMA queue for the selected channel. The queue
+* owns the BDs BdBase to BdBase + NumBds - 1 and takes the lock, AXI and
+* packet attributes of all of them from the BD entry BdBase of the Shim DMA
+* instance, so these attributes are set with XAieDma_ShimBdSet*() on BdBase
+* before this API is called. The channel is enabled by the caller.
+*
+* @param	QueuePtr - Pointer to the Shim DMA queue instance.
+* @param	DmaInstPtr - Pointer to the Shim DMA instance.
+* @param	ChNum - Channel number (0-S2MM0,1-S2MM1,2-MM2S0,3-MM2S1).
+* @param	BdBase - First BD owned by the queue.
+* @param	NumBds - Number of BDs owned by the queue.
+*
+* @return	XAIE_SUCCESS if successful, else XAIE_FAILURE.
+*
+* @note		Up to XAIEGBL_NOC_DMASTA_STARTQ_MAX transfers are in flight,
+*		so the channel doesn't idle between transfers once the queue
+*		owns that many BDs. The other BDs of the Shim DMA must not be
+*		used for this channel while the queue is in use.
+*
+*******************************************************************************/
+u32 XAieDma_ShimQueueInitialize(XAieDma_ShimQueue *QueuePtr,
+		XAieDma_Shim *DmaInstPtr, u8 ChNum, u8 BdBase, u8 NumBds)
+{
+	u8 BdIdx;
+
+	XAie_AssertNonvoid(QueuePtr != XAIE_NULL);
+	XAie_AssertNonvoid(DmaInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid(ChNum < XAIEDMA_SHIM_MAX_NUM_CHANNELS);
+
+	if((NumBds == 0U) || ((u32)BdBase + NumBds >
+				XAIEDMA_SHIM_MAX_NUM_DESCRS)) {
+		return XAIE_FAILURE;
+	}
+
+	QueuePtr->DmaInstPtr = DmaInstPtr;
+	QueuePtr->TileInstPtr = XAIE_NULL;
+	QueuePtr->ChNum = ChNum;
+	QueuePtr->BdBase = BdBase;
+	QueuePtr->NumBds = NumBds;
+	QueuePtr->NextBd = 0U;
+	QueuePtr->MaxHw = NumBds;
+	if(QueuePtr->MaxHw > XAIEGBL_NOC_DMASTA_STARTQ_MAX) {
+		QueuePtr->MaxHw = XAIEGBL_NOC_DMASTA_STARTQ_MAX;
+	}
+	QueuePtr->IntrEn = 0U;
+	QueuePtr->Head = 0U;
+	QueuePtr->NumHw = 0U;
+	QueuePtr->NumPending = 0U;
+	QueuePtr->Callback = XAIE_NULL;
+	QueuePtr->CallBackRef = XAIE_NULL;
+
+	/* Each transfer is a BD of its own, completed one by one */
+	XAieDma_ShimBdSetNext(DmaInstPtr, BdBase,
+			XAIEDMA_SHIM_BD_NEXTBD_INVALID);
+	for(BdIdx = 1U; BdIdx < NumBds; BdIdx++) {
+		DmaInstPtr->Descrs[BdBase + BdIdx] = DmaInstPtr->Descrs[BdBase];
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API sets the completion callback of the Shim DMA queue.
+*
+* @param	QueuePtr - Pointer to the Shim DMA queue instance.
+* @param	Callback - Function called for each completed transfer.
+* @param	CallBackRef - First argument of the callback.
+*
+* @return	None.
+*
+* @note		The callback is called from XAieDma_ShimQueueProcess(). It can
+*		enqueue new transfers.
+*
+*******************************************************************************/
+void XAieDma_ShimQueueSetCallback(XAieDma_ShimQueue *QueuePtr,
+		XAieDma_ShimQueueCallback Callback, void *CallBackRef)
+{
+	XAie_AssertVoid(QueuePtr != XAIE_NULL);
+
+	QueuePtr->Callback = Callback;
+	QueuePtr->CallBackRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API gives the pending transfers of the queue to the channel, as long
+* as the channel start queue has room for them.
+*
+* @param	QueuePtr - Pointer to the Shim DMA queue instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void XAieDma_ShimQueueIssue(XAieDma_ShimQueue *QueuePtr)
+{
+	XAieDma_Shim *DmaInstPtr = QueuePtr->DmaInstPtr;
+	XAieDma_ShimQueueEntry *EntryPtr;
+	u8 BdNum;
+
+	while((QueuePtr->NumPending > 0U) &&
+			(QueuePtr->NumHw < QueuePtr->MaxHw)) {
+		EntryPtr = &QueuePtr->Entries[(QueuePtr->Head +
+				QueuePtr->NumHw) % XAIEDMA_SHIM_QUEUE_DEPTH];
+
+		/*
+		 * Transfers complete in order, so the BD used MaxHw transfers
+		 * ago, or earlier, is done with.
+		 */
+		BdNum = QueuePtr->BdBase + QueuePtr->NextBd;
+		QueuePtr->NextBd++;
+		if(QueuePtr->NextBd == QueuePtr->NumBds) {
+			QueuePtr->NextBd = 0U;
+		}
+
+		XAieDma_ShimBdSetAddr(DmaInstPtr, BdNum, EntryPtr->AddrH,
+				EntryPtr->AddrL, EntryPtr->Length);
+		XAieDma_ShimBdWrite(DmaInstPtr, BdNum);
+		XAieDma_ShimSetStartBd(DmaInstPtr, QueuePtr->ChNum, BdNum);
+
+		QueuePtr->NumPending--;
+		QueuePtr->NumHw++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API adds a transfer to the Shim DMA queue. The transfer is given to
+* the channel right away if the channel start queue has room for it, or
+* later by XAieDma_ShimQueueProcess() when an earlier transfer completes.
+*
+* @param	QueuePtr - Pointer to the Shim DMA queue instance.
+* @param	AddrHigh - Upper 16-bits base address bits.
+* @param	AddrLow - Lower 32-bits base address bits (128-bit aligned).
+* @param	Length - Transfer length in bytes (multiple of 4 bytes).
+* @param	UserData - Value passed to the completion callback.
+*
+* @return	XAIE_SUCCESS if successful, or XAIE_FAILURE if the queue is
+*		full.
+*
+* @note		The queue isn't locked. When XAieDma_ShimQueueProcess() runs
+*		from an interrupt handler, the caller is required to mask the
+*		interrupt around this API.
+*
+*******************************************************************************/
+u32 XAieDma_ShimQueueEnqueue(XAieDma_ShimQueue *QueuePtr, u16 AddrHigh,
+		u32 AddrLow, u32 Length, u64 UserData)
+{
+	XAieDma_ShimQueueEntry *EntryPtr;
+
+	XAie_AssertNonvoid(QueuePtr != XAIE_NULL);
+	XAie_AssertNonvoid((AddrLow & XAIEDMA_SHIM_ADDRLOW_ALIGN_MASK) == 0U);
+	XAie_AssertNonvoid((Length & XAIEDMA_SHIM_TXFER_LEN32_MASK) == 0U);
+
+	if(QueuePtr->NumHw + QueuePtr->NumPending ==
+			XAIEDMA_SHIM_QUEUE_DEPTH) {
+		return XAIE_FAILURE;
+	}
+
+	EntryPtr = &QueuePtr->Entries[(QueuePtr->Head + QueuePtr->NumHw +
+			QueuePtr->NumPending) % XAIEDMA_SHIM_QUEUE_DEPTH];
+	EntryPtr->AddrH = AddrHigh;
+	EntryPtr->AddrL = AddrLow;
+	EntryPtr->Length = Length;
+	EntryPtr->UserData = UserData;
+	QueuePtr->NumPending++;
+
+	XAieDma_ShimQueueIssue(QueuePtr);
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API retires the completed transfers of the Shim DMA queue, calling
+* the completion callback for each of them, and gives the pending transfers
+* to the channel. It is called from the handler of the queue interrupt, or
+* periodically when the interrupt isn't used.
+*
+* @param	QueuePtr - Pointer to the Shim DMA queue instance.
+*
+* @return	Number of transfers completed.
+*
+* @note		The completed transfers are counted from the channel status,
+*		so a single call retires all the transfers that completed
+*		since the previous one, whatever the number of interrupts.
+*
+*******************************************************************************/
+u32 XAieDma_ShimQueueProcess(XAieDma_ShimQueue *QueuePtr)
+{
+	XAieDma_ShimQueueEntry *EntryPtr;
+	u32 InFlight;
+	u32 Done;
+	u32 Idx;
+
+	XAie_AssertNonvoid(QueuePtr != XAIE_NULL);
+
+	/* Clear the interrupt first, so a completion after the read raises it */
+	if(QueuePtr->IntrEn != 0U) {
+		XAieTile_PlIntcL1StatusClr(QueuePtr->TileInstPtr,
+				1U << (XAIEDMA_SHIM_QUEUE_IRQEVT_L1_BIT +
+					QueuePtr->IntrSlot),
+				QueuePtr->SwitchAB);
+	}
+
+	InFlight = XAieDma_ShimPendingBdCount(QueuePtr->DmaInstPtr,
+			QueuePtr->ChNum);
+	if(InFlight > QueuePtr->NumHw) {
+		InFlight = QueuePtr->NumHw;
+	}
+	Done = QueuePtr->NumHw - InFlight;
+
+	for(Idx = 0U; Idx < Done; Idx++) {
+		EntryPtr = &QueuePtr->Entries[QueuePtr->Head];
+		QueuePtr->Head = (QueuePtr->Head + 1U) %
+			XAIEDMA_SHIM_QUEUE_DEPTH;
+		QueuePtr->NumHw--;
+
+		/* Refill before the callback to keep the channel busy */
+		XAieDma_ShimQueueIssue(QueuePtr);
+
+		if(QueuePtr->Callback != XAIE_NULL) {
+			QueuePtr->Callback(QueuePtr->CallBackRef,
+					EntryPtr->UserData);
+		}
+	}
+
+	XAieDma_ShimQueueIssue(QueuePtr);
+
+	return Done;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API routes the BD finished event of the queue channel to an IRQ event
+* of the 1st level interrupt controller of the Shim tile, and enables it.
+*
+* @param	QueuePtr - Pointer to the Shim DMA queue instance.
+* @param	TileInstPtr - Pointer to the Shim tile instance of the channel.
+* @param	Slot - IRQ event to use (0-3).
+* @param	SwitchAB - Flag to indicate if it's the A or B block.
+*
+* @return	XAIE_SUCCESS if successful, else XAIE_FAILURE.
+*
+* @note		The 1st level interrupt number, the 2nd level interrupt
+*		controller and the host interrupt handler are set up by the
+*		caller. The handler calls XAieDma_ShimQueueProcess().
+*
+*******************************************************************************/
+u32 XAieDma_ShimQueueIntrEnable(XAieDma_ShimQueue *QueuePtr,
+		XAieGbl_Tile *TileInstPtr, u8 Slot, u8 SwitchAB)
+{
+	u64 RegAddr;
+	u32 RegVal;
+	u32 Lsb;
+
+	XAie_AssertNonvoid(QueuePtr != XAIE_NULL);
+	XAie_AssertNonvoid(TileInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid(TileInstPtr->TileType == XAIEGBL_TILE_TYPE_SHIMNOC);
+	XAie_AssertNonvoid(SwitchAB == XAIETILE_PL_BLOCK_SWITCHA ||
+			   SwitchAB == XAIETILE_PL_BLOCK_SWITCHB);
+
+	if(Slot >= XAIEDMA_SHIM_QUEUE_IRQEVT_NUM) {
+		return XAIE_FAILURE;
+	}
+
+	if(SwitchAB == XAIETILE_PL_BLOCK_SWITCHA) {
+		RegAddr = TileInstPtr->TileAddr + XAIEGBL_PL_INTCON1STLEVIRQEVTA;
+	} else {
+		RegAddr = TileInstPtr->TileAddr + XAIEGBL_PL_INTCON1STLEVIRQEVTB;
+	}
+
+	Lsb = Slot * XAIEDMA_SHIM_QUEUE_IRQEVT_WIDTH;
+	RegVal = XAieGbl_Read32(RegAddr);
+	RegVal &= ~(XAIEDMA_SHIM_QUEUE_IRQEVT_MASK << Lsb);
+	RegVal |= XAie_SetField(XAieDma_ShimQueueEvent[QueuePtr->ChNum], Lsb,
+			XAIEDMA_SHIM_QUEUE_IRQEVT_MASK << Lsb);
+	XAieGbl_Write32(RegAddr, RegVal);
+
+	QueuePtr->TileInstPtr = TileInstPtr;
+	QueuePtr->IntrSlot = Slot;
+	QueuePtr->SwitchAB = SwitchAB;
+	QueuePtr->IntrEn = 1U;
+
+	XAieTile_PlIntcL1StatusClr(TileInstPtr,
+			1U << (XAIEDMA_SHIM_QUEUE_IRQEVT_L1_BIT + Slot), SwitchAB);
+	XAieTile_PlIntcL1Enable(TileInstPtr,
+			1U << (XAIEDMA_SHIM_QUEUE_IRQEVT_L1_BIT + Slot), SwitchAB);
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API disables the completion interrupt of the Shim DMA queue. The
+* queue is then processed by calling XAieDma_ShimQueueProcess() periodically.
+*
+* @param	QueuePtr - Pointer to the Shim DMA queue instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieDma_ShimQueueIntrDisable(XAieDma_ShimQueue *QueuePtr)
+{
+	XAie_AssertVoid(QueuePtr != XAIE_NULL);
+
+	if(QueuePtr->IntrEn == 0U) {
+		return;
+	}
+
+	XAieTile_PlIntcL1Disable(QueuePtr->TileInstPtr,
+			1U << (XAIEDMA_SHIM_QUEUE_IRQEVT_L1_BIT +
+				QueuePtr->IntrSlot), QueuePtr->SwitchAB);
+	QueuePtr->IntrEn = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the number of transfers of the Shim DMA queue that are not
+* completed yet, in flight or waiting for the channel.
+*
+* @param	QueuePtr - Pointer to the Shim DMA queue instance.
+*
+* @return	Number of transfers not completed.
+*
+* @note		The count is updated by XAieDma_ShimQueueProcess().
+*
+*******************************************************************************/
+u32 XAieDma_ShimQueueGetNumPending(XAieDma_ShimQueue *QueuePtr)
+{
+	XAie_AssertNonvoid(QueuePtr != XAIE_NULL);
+
+	return QueuePtr->NumHw + QueuePtr->NumPending;
+}
+
 /** @} */
 
 
@@ -41,6 +41,7 @@
 * 1.2  Nishad  12/05/2018  Renamed ME attributes to AIE
 * 1.3  Hyun    06/20/2019  Added APIs for individual BD / Channel reset
 * 1.4  Hyun    06/20/2019  Add XAieDma_ShimSoftInitialize()
+* 1.5  Hyun    10/14/2019  Add the Shim DMA queue
 * </pre>
 *
 ******************************************************************************/
@@ -80,6 +81,11 @@ extern XAieGbl_RegShimDmaSts ShimDmaSts[];
 #define XAIEDMA_SHIM_TXFER_LEN32_OFFSET		2U
 #define XAIEDMA_SHIM_TXFER_LEN32_MASK		3U
 
+/* Number of transfers a Shim DMA queue can hold, including the ones in flight */
+#ifndef XAIEDMA_SHIM_QUEUE_DEPTH
+#define XAIEDMA_SHIM_QUEUE_DEPTH		32U
+#endif
+
 /**************************** Type Definitions *******************************/
 /**
  * This typedef contains the lock attributes for the BD.
@@ -136,6 +142,49 @@ typedef struct
 	XAieDma_ShimBd Descrs[XAIEDMA_SHIM_MAX_NUM_DESCRS];	/**< Data structure to hold the 16 descriptors of the Shim DMA */
 }XAieDma_Shim;
 
+/**
+ * Completion callback of a Shim DMA queue. It is called once per transfer, in
+ * the order the transfers were enqueued, with the UserData of the transfer.
+ */
+typedef void (*XAieDma_ShimQueueCallback)(void *CallBackRef, u64 UserData);
+
+/**
+ * This typedef is a transfer held by the Shim DMA queue.
+ */
+typedef struct
+{
+	u16 AddrH;		/**< Upper 16-bits base address bits */
+	u32 AddrL;		/**< Lower 32-bits base address bits */
+	u32 Length;		/**< Transfer length in bytes */
+	u64 UserData;		/**< Value passed to the completion callback */
+} XAieDma_ShimQueueEntry;
+
+/**
+ * This typedef is the Shim DMA queue of one channel. The queue owns a range
+ * of BDs of the Shim DMA instance and feeds the channel start queue from a
+ * ring of transfers, recycling the BDs as the transfers complete. User is
+ * required to allocate memory for the queue instance.
+ */
+typedef struct
+{
+	XAieDma_Shim *DmaInstPtr;	/**< Shim DMA instance of the channel */
+	XAieGbl_Tile *TileInstPtr;	/**< Shim tile, for the interrupt */
+	u8 ChNum;			/**< Channel number */
+	u8 BdBase;			/**< First BD owned by the queue */
+	u8 NumBds;			/**< Number of BDs owned by the queue */
+	u8 NextBd;			/**< Index of the next BD to use, from BdBase */
+	u8 MaxHw;			/**< Transfers that can be in flight */
+	u8 IntrEn;			/**< Completion interrupt is enabled */
+	u8 IntrSlot;			/**< IRQ event slot of the interrupt */
+	u8 SwitchAB;			/**< 1st level interrupt controller block */
+	u32 Head;			/**< Oldest transfer of the ring */
+	u32 NumHw;			/**< Transfers in flight */
+	u32 NumPending;			/**< Transfers not given to the channel yet */
+	XAieDma_ShimQueueCallback Callback;	/**< Completion callback */
+	void *CallBackRef;		/**< Argument of the completion callback */
+	XAieDma_ShimQueueEntry Entries[XAIEDMA_SHIM_QUEUE_DEPTH]; /**< Ring */
+} XAieDma_ShimQueue;
+
 /***************************** Macro Definitions *****************************/
 #define XAIEGBL_NOC_DMASTA_STA_IDLE		0x0U
 #define XAIEGBL_NOC_DMASTA_STARTQ_MAX		0x4U
@@ -202,5 +251,12 @@ void XAieDma_ShimBdClear(XAieDma_Shim *DmaInstPtr, u8 BdNum);
 void XAieDma_ShimBdClearAll(XAieDma_Shim *DmaInstPtr);
 u8 XAieDma_ShimWaitDone(XAieDma_Shim *DmaInstPtr, u32 ChNum, u32 TimeOut);
 u8 XAieDma_ShimPendingBdCount(XAieDma_Shim *DmaInstPtr, u32 ChNum);
+u32 XAieDma_ShimQueueInitialize(XAieDma_ShimQueue *QueuePtr, XAieDma_Shim *DmaInstPtr, u8 ChNum, u8 BdBase, u8 NumBds);
+void XAieDma_ShimQueueSetCallback(XAieDma_ShimQueue *QueuePtr, XAieDma_ShimQueueCallback Callback, void *CallBackRef);
+u32 XAieDma_ShimQueueEnqueue(XAieDma_ShimQueue *QueuePtr, u16 AddrHigh, u32 AddrLow, u32 Length, u64 UserData);
+u32 XAieDma_ShimQueueProcess(XAieDma_ShimQueue *QueuePtr);
+u32 XAieDma_ShimQueueIntrEnable(XAieDma_ShimQueue *QueuePtr, XAieGbl_Tile *TileInstPtr, u8 Slot, u8 SwitchAB);
+void XAieDma_ShimQueueIntrDisable(XAieDma_ShimQueue *QueuePtr);
+u32 XAieDma_ShimQueueGetNumPending(XAieDma_ShimQueue *QueuePtr);
 
 #endif
@@ -44,6 +44,7 @@
 * 1.4  Nishad  12/05/2018  Renamed ME attributes to AIE
 * 1.5  Jubaer  05/24/2019  Add PL type on TileType attribute
 * 1.6  Nishad  07/31/2019  Add support for RPU baremetal
+* 1.7  Hyun    10/14/2019  Use XAIEGBL_TILE_ADDR()
 * </pre>
 *
 ******************************************************************************/
@@ -134,18 +135,8 @@ ConfigPtr->ArrOffset = XAIE_BASE_ARRAY_ADDR_OFFSET;
 				TilePtr->RowId = RowIdx; /* Row index */
 				TilePtr->ColId = ColIdx; /* Column index */
 
-				/*
-				 * Tile address format:
-				 * --------------------------------------------
-				 * |                7 bits  5 bits   18 bits  |
-				 * --------------------------------------------
-				 * | Array offset | Column | Row | Tile addr  |
-				 * --------------------------------------------
-				 */
-				TileAddr = (u64)(((u64)ConfigPtr->ArrOffset <<
-						XAIEGBL_TILE_ADDR_ARR_SHIFT) |
-					(ColIdx << XAIEGBL_TILE_ADDR_COL_SHIFT) |
-					(RowIdx << XAIEGBL_TILE_ADDR_ROW_SHIFT));
+				TileAddr = XAIEGBL_TILE_ADDR(ConfigPtr->ArrOffset,
+						ColIdx, RowIdx);
 
 				TilePtr->TileAddr = TileAddr;
 
@@ -192,9 +183,8 @@ ConfigPtr->ArrOffset = XAIE_BASE_ARRAY_ADDR_OFFSET;
 			TilePtr->RowId = 0U; /* Row index */
 			TilePtr->ColId = ColIdx; /* Column index */
 
-			TileAddr = (u64)(((u64)ConfigPtr->ArrOffset <<
-					XAIEGBL_TILE_ADDR_ARR_SHIFT) |
-					(ColIdx << XAIEGBL_TILE_ADDR_COL_SHIFT));
+			TileAddr = XAIEGBL_TILE_ADDR(ConfigPtr->ArrOffset,
+					ColIdx, 0U);
 
 			TilePtr->TileAddr = TileAddr;
 			TilePtr->MemModAddr = 0U;
@@ -106,6 +106,7 @@
 * 1.3  Naresh  06/18/2018  Updated code as per standalone driver framework
 * 1.4  Naresh  07/11/2018  Updated copyright info
 * 1.5  Nishad  12/05/2018  Renamed ME attributes to AIE
+* 1.6  Hyun    10/14/2019  Add the tile address macros
 * </pre>
 *
 ******************************************************************************/
@@ -203,6 +204,48 @@ typedef struct {
 } XAieGbl_HwCfg;
 
 /**************************** Macro Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* Macro to compute the base address of a tile.
+*
+* @param	ArrOff - AIE array offset, as in XAieGbl_Config.
+* @param	ColIdx - Column index of the tile.
+* @param	RowIdx - Row index of the tile, 0 for the Shim tile.
+*
+* @return	48-bit tile base address.
+*
+* @note		Tile address format:
+*		--------------------------------------------
+*		|                7 bits  5 bits   18 bits  |
+*		--------------------------------------------
+*		| Array offset | Column | Row | Tile addr  |
+*		--------------------------------------------
+*
+*******************************************************************************/
+#define XAIEGBL_TILE_ADDR(ArrOff, ColIdx, RowIdx)				\
+			((u64)(((u64)(ArrOff) << XAIEGBL_TILE_ADDR_ARR_SHIFT) |	\
+			((u64)(ColIdx) << XAIEGBL_TILE_ADDR_COL_SHIFT) |	\
+			((u64)(RowIdx) << XAIEGBL_TILE_ADDR_ROW_SHIFT)))
+
+/*****************************************************************************/
+/**
+*
+* Macro to compute the base address of a tile of the AIE array described in
+* xparameters_aie.h. With constant indexes, the address is resolved at
+* compile time and the register accesses built on it, such as
+* XAieTile_LockAcquireNb(), need no tile instance.
+*
+* @param	ColIdx - Column index of the tile.
+* @param	RowIdx - Row index of the tile, 0 for the Shim tile.
+*
+* @return	48-bit tile base address.
+*
+* @note		None.
+*
+*******************************************************************************/
+#define XAieGbl_TileAddr(ColIdx, RowIdx)					\
+			XAIEGBL_TILE_ADDR(XPAR_AIE_ARRAY_OFFSET, ColIdx, RowIdx)
 
 /**************************** Function prototypes ***************************/
 void XAieGbl_HwInit(XAieGbl_HwCfg *CfgPtr);
@@ -42,6 +42,7 @@
 * 1.3  Nishad  12/05/2018  Renamed ME attributes to AIE
 * 1.4  Hyun    01/08/2019  Add the mask poll function
 * 1.5  Tejus   10/14/2019  Enable assertion for linux and simulation
+* 1.6  Hyun    10/14/2019  Compile out the assertions with NDEBUG
 * </pre>
 *
 ******************************************************************************/
@@ -68,8 +69,17 @@
 
 #define XAie_print			XAieLib_print
 #define XAie_usleep			XAieLib_usleep
+/*
+ * As Xil_Assert*(), the assertions cost nothing in NDEBUG builds. The
+ * condition is only used in sizeof, so it isn't evaluated.
+ */
+#ifndef NDEBUG
 #define XAie_AssertNonvoid(Cond)	XAieLib_AssertNonvoid(Cond, __func__, __LINE__)
 #define XAie_AssertVoid(Cond)		XAieLib_AssertVoid(Cond, __func__, __LINE__)
+#else
+#define XAie_AssertNonvoid(Cond)	((void)sizeof(Cond))
+#define XAie_AssertVoid(Cond)		((void)sizeof(Cond))
+#endif
 
 #define XAie_SetField(Val, Lsb, Mask)	(((u32)Val << Lsb) & Mask)
 #define XAie_GetField(Val, Lsb, Mask)	(((u32)Val & Mask) >> Lsb)
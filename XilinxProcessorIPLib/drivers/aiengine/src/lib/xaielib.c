@@ -56,6 +56,8 @@
 * 2.4  Hyun    09/13/2019  Use the simulation elf loader function
 * 2.5  Hyun    09/13/2019  Use XAieSim_LoadElfMem()
 * 2.6  Tejus   10/14/2019  Enable assertion for linux and simulation
+* 2.7  Hyun    10/14/2019  Add the register write transaction
+* 2.8  Hyun    10/14/2019  Add XAieLib_LoadElfMemMulti()
 * </pre>
 *
 ******************************************************************************/
@@ -116,6 +118,23 @@ typedef struct XAieLib_MemInst
 	void *Platform;	/**< Platform specific data */
 } XAieLib_MemInst;
 
+/* Register write transaction, see XAieLib_TxnStart() */
+typedef struct XAieLib_Txn
+{
+	XAieLib_TxnCmd *Cmds;	/**< Buffer of the recorded writes */
+	u32 Size;		/**< Number of commands in the buffer */
+	u32 NumCmds;		/**< Number of recorded writes */
+	u8 Active;		/**< Writes are recorded if set */
+} XAieLib_Txn;
+
+static XAieLib_Txn XAieLib_TxnInst;
+
+/************************** Function Prototypes  *****************************/
+static void XAieLib_IOWrite32(u64 Addr, u32 Data);
+static void XAieLib_IOMaskWrite32(u64 Addr, u32 Mask, u32 Data);
+static void XAieLib_IOWrite128(u64 Addr, u32 *Data);
+static void XAieLib_TxnRecord(u64 Addr, u32 Mask, u32 Data);
+
 /************************** Function Definitions *****************************/
 
 /*****************************************************************************/
@@ -209,6 +228,10 @@ int XAieLib_usleep(u64 Usec)
 *******************************************************************************/
 u32 XAieLib_LoadElf(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym)
 {
+	if (XAieLib_TxnInst.NumCmds != 0U) {
+		XAieLib_TxnFlush();
+	}
+
 #ifdef __AIESIM__
 	return XAieSim_LoadElf(TileInstPtr, ElfPtr, LoadSym);
 #elif defined __AIEBAREMTL__
@@ -234,6 +257,10 @@ u32 XAieLib_LoadElf(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym)
 *******************************************************************************/
 u32 XAieLib_LoadElfMem(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym)
 {
+	if (XAieLib_TxnInst.NumCmds != 0U) {
+		XAieLib_TxnFlush();
+	}
+
 #ifdef __AIESIM__
 	return XAIELIB_FAILURE;
 #elif defined __AIEBAREMTL__
@@ -243,6 +270,38 @@ u32 XAieLib_LoadElfMem(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym)
 #endif
 }
 
+/*****************************************************************************/
+/**
+*
+* This API loads the elf to a set of tiles which run the same kernel. The elf
+* is parsed once, and the same sections are written to every tile.
+*
+* @param	TileInstPtrs: Array of tile instances for the elf to be loaded
+* @param	NumTiles: Number of tiles in TileInstPtrs
+* @param	ElfPtr: pointer to the elf in memory
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieLib_LoadElfMemMulti(XAieGbl_Tile **TileInstPtrs, u32 NumTiles,
+		u8 *ElfPtr, u8 LoadSym)
+{
+	if (XAieLib_TxnInst.NumCmds != 0U) {
+		XAieLib_TxnFlush();
+	}
+
+#ifdef __AIESIM__
+	return XAIELIB_FAILURE;
+#elif defined __AIEBAREMTL__
+	return XAIELIB_FAILURE;
+#else
+	return XAieSim_LoadElfMemMulti(TileInstPtrs, NumTiles, ElfPtr,
+			LoadSym);
+#endif
+}
+
 /*****************************************************************************/
 /**
 *
@@ -727,6 +786,157 @@ u32 XAieLib_MemRead32(XAieLib_MemInst *XAieLib_MemInstPtr, u64 Addr)
 #endif
 }
 
+/*****************************************************************************/
+/**
+*
+* This API starts a register write transaction. Until XAieLib_TxnSubmit(),
+* XAieLib_Write32(), XAieLib_MaskWrite32() and XAieLib_Write128() record the
+* writes in the given buffer instead of accessing the device.
+*
+* @param	CmdBuf: Buffer for the recorded writes.
+* @param	NumCmds: Number of commands that fit in CmdBuf.
+*
+* @return	XAIELIB_SUCCESS on success, XAIELIB_FAILURE if a transaction
+* is already started or the buffer is empty.
+*
+* @note		When the buffer is full, or before any read or NPI access,
+* the recorded writes are applied and the recording continues, so the device
+* sees the accesses in the program order. The transaction is global and not
+* thread safe, same as the rest of the IO layer.
+*
+*******************************************************************************/
+u32 XAieLib_TxnStart(XAieLib_TxnCmd *CmdBuf, u32 NumCmds)
+{
+	if (XAieLib_TxnInst.Active || (CmdBuf == NULL) || (NumCmds == 0U)) {
+		return XAIELIB_FAILURE;
+	}
+
+	XAieLib_TxnInst.Cmds = CmdBuf;
+	XAieLib_TxnInst.Size = NumCmds;
+	XAieLib_TxnInst.NumCmds = 0U;
+	XAieLib_TxnInst.Active = 1U;
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API applies the writes recorded in the transaction buffer. Runs of
+* plain writes to 4 consecutive words aligned at 16 bytes are issued as
+* 128bit writes. The transaction stays started.
+*
+* @param	None.
+*
+* @return	XAIELIB_SUCCESS on success, XAIELIB_FAILURE if no transaction
+* is started.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieLib_TxnFlush(void)
+{
+	XAieLib_TxnCmd *Cmds = XAieLib_TxnInst.Cmds;
+	u32 NumCmds = XAieLib_TxnInst.NumCmds;
+	u32 Data[4U];
+	u32 Idx, Run;
+
+	if (!XAieLib_TxnInst.Active) {
+		return XAIELIB_FAILURE;
+	}
+
+	/* Reads below must not flush again */
+	XAieLib_TxnInst.NumCmds = 0U;
+
+	Idx = 0U;
+	while (Idx < NumCmds) {
+		if (Cmds[Idx].Mask != XAIELIB_TXN_MASK_ALL) {
+			XAieLib_IOMaskWrite32(Cmds[Idx].Addr, Cmds[Idx].Mask,
+					Cmds[Idx].Data);
+			Idx++;
+			continue;
+		}
+
+		for (Run = 1U; (Run < 4U) && (Idx + Run < NumCmds); Run++) {
+			if ((Cmds[Idx + Run].Mask != XAIELIB_TXN_MASK_ALL) ||
+				(Cmds[Idx + Run].Addr !=
+				 Cmds[Idx].Addr + Run * 4U)) {
+				break;
+			}
+		}
+
+		if ((Run == 4U) && ((Cmds[Idx].Addr & 0xFU) == 0U)) {
+			for (Run = 0U; Run < 4U; Run++) {
+				Data[Run] = Cmds[Idx + Run].Data;
+			}
+			XAieLib_IOWrite128(Cmds[Idx].Addr, Data);
+			Idx += 4U;
+		} else {
+			XAieLib_IOWrite32(Cmds[Idx].Addr, Cmds[Idx].Data);
+			Idx++;
+		}
+	}
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API applies the writes recorded in the transaction buffer and ends
+* the transaction. The writes are done directly again after this.
+*
+* @param	None.
+*
+* @return	XAIELIB_SUCCESS on success, XAIELIB_FAILURE if no transaction
+* is started.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieLib_TxnSubmit(void)
+{
+	u32 Ret;
+
+	Ret = XAieLib_TxnFlush();
+	XAieLib_TxnInst.Active = 0U;
+	XAieLib_TxnInst.Cmds = NULL;
+	XAieLib_TxnInst.Size = 0U;
+
+	return Ret;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function records a write in the transaction buffer. Every write gets
+* its own entry, writes to the same register are not combined since FIFO,
+* strobe and lock registers act on each write.
+*
+* @param	Addr: Register address.
+* @param	Mask: Bits to write, XAIELIB_TXN_MASK_ALL for a plain write.
+* @param	Data: Register value.
+*
+* @return	None.
+*
+* @note		The buffer is flushed when it is full.
+*
+*******************************************************************************/
+static void XAieLib_TxnRecord(u64 Addr, u32 Mask, u32 Data)
+{
+	XAieLib_TxnCmd *Cmd;
+
+	if (XAieLib_TxnInst.NumCmds == XAieLib_TxnInst.Size) {
+		XAieLib_TxnFlush();
+	}
+
+	Cmd = &XAieLib_TxnInst.Cmds[XAieLib_TxnInst.NumCmds];
+	Cmd->Addr = Addr;
+	Cmd->Mask = Mask;
+	Cmd->Data = Data;
+	XAieLib_TxnInst.NumCmds++;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -741,6 +951,10 @@ u32 XAieLib_MemRead32(XAieLib_MemInst *XAieLib_MemInstPtr, u64 Addr)
 *******************************************************************************/
 u32 XAieLib_Read32(u64 Addr)
 {
+	if (XAieLib_TxnInst.NumCmds != 0U) {
+		XAieLib_TxnFlush();
+	}
+
 #ifdef __AIESIM__
 	return(XAieSim_Read32(Addr));
 #elif defined __AIEBAREMTL__
@@ -767,6 +981,10 @@ void XAieLib_Read128(u64 Addr, u32 *Data)
 {
 	u8 Idx;
 
+	if (XAieLib_TxnInst.NumCmds != 0U) {
+		XAieLib_TxnFlush();
+	}
+
 	for(Idx = 0U; Idx < 4U; Idx++) {
 #ifdef __AIESIM__
 		Data[Idx] = XAieSim_Read32(Addr + Idx*4U);
@@ -788,10 +1006,34 @@ void XAieLib_Read128(u64 Addr, u32 *Data)
 *
 * @return	None.
 *
-* @note		None.
+* @note		The write is recorded if a transaction is started.
 *
 *******************************************************************************/
 void XAieLib_Write32(u64 Addr, u32 Data)
+{
+	if (XAieLib_TxnInst.Active) {
+		XAieLib_TxnRecord(Addr, XAIELIB_TXN_MASK_ALL, Data);
+		return;
+	}
+
+	XAieLib_IOWrite32(Addr, Data);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the platform IO function to write 32bit data to the specified
+* address.
+*
+* @param	Addr: Address to write to.
+* @param	Data: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+static void XAieLib_IOWrite32(u64 Addr, u32 Data)
 {
 #ifdef __AIESIM__
 	XAieSim_Write32(Addr, Data);
@@ -814,10 +1056,35 @@ void XAieLib_Write32(u64 Addr, u32 Data)
 *
 * @return	None.
 *
-* @note		None.
+* @note		The write is recorded if a transaction is started.
 *
 *******************************************************************************/
 void XAieLib_MaskWrite32(u64 Addr, u32 Mask, u32 Data)
+{
+	if (XAieLib_TxnInst.Active) {
+		XAieLib_TxnRecord(Addr, Mask, Data);
+		return;
+	}
+
+	XAieLib_IOMaskWrite32(Addr, Mask, Data);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the platform IO function to write a masked 32bit data to
+* the specified address.
+*
+* @param	Addr: Address to write to.
+* @param	Mask: Mask to be applied to Data.
+* @param	Data: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+static void XAieLib_IOMaskWrite32(u64 Addr, u32 Mask, u32 Data)
 {
 	u32 RegVal;
 
@@ -846,10 +1113,39 @@ void XAieLib_MaskWrite32(u64 Addr, u32 Mask, u32 Data)
 *
 * @return	None.
 *
-* @note		None.
+* @note		The write is recorded if a transaction is started.
 *
 *******************************************************************************/
 void XAieLib_Write128(u64 Addr, u32 *Data)
+{
+	u8 Idx;
+
+	if (XAieLib_TxnInst.Active) {
+		for(Idx = 0U; Idx < 4U; Idx++) {
+			XAieLib_TxnRecord(Addr + Idx * 4U,
+					XAIELIB_TXN_MASK_ALL, Data[Idx]);
+		}
+		return;
+	}
+
+	XAieLib_IOWrite128(Addr, Data);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the platform IO function to write 128bit data to the specified
+* address.
+*
+* @param	Addr: Address to write to.
+* @param	Data: Pointer to the 128-bit data buffer.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+static void XAieLib_IOWrite128(u64 Addr, u32 *Data)
 {
 #ifdef __AIESIM__
 	XAieSim_Write128(Addr, Data);
@@ -880,6 +1176,10 @@ void XAieLib_Write128(u64 Addr, u32 *Data)
 void XAieLib_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0,
 						u32 CmdWd1, u8 *CmdStr)
 {
+	if (XAieLib_TxnInst.NumCmds != 0U) {
+		XAieLib_TxnFlush();
+	}
+
 #ifdef __AIESIM__
 	XAieSim_WriteCmd(Command, ColId, RowId, CmdWd0, CmdWd1, CmdStr);
 #elif defined __AIEBAREMTL__
@@ -952,6 +1252,10 @@ u32 XAieLib_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs)
 *******************************************************************************/
 u32 XAieLib_NPIRead32(u64 Addr)
 {
+	if (XAieLib_TxnInst.NumCmds != 0U) {
+		XAieLib_TxnFlush();
+	}
+
 #ifdef __AIESIM__
 	return XAieSim_NPIRead32(Addr);
 #elif defined __AIEBAREMTL__
@@ -976,6 +1280,10 @@ u32 XAieLib_NPIRead32(u64 Addr)
 *******************************************************************************/
 void XAieLib_NPIWrite32(u64 Addr, u32 Data)
 {
+	if (XAieLib_TxnInst.NumCmds != 0U) {
+		XAieLib_TxnFlush();
+	}
+
 #ifdef __AIESIM__
 	XAieSim_NPIWrite32(Addr, Data);
 #elif defined __AIEBAREMTL__
@@ -1004,6 +1312,10 @@ void XAieLib_NPIMaskWrite32(u64 Addr, u32 Mask, u32 Data)
 {
 	u32 RegVal;
 
+	if (XAieLib_TxnInst.NumCmds != 0U) {
+		XAieLib_TxnFlush();
+	}
+
 #ifdef __AIESIM__
 	XAieSim_NPIMaskWrite32(Addr, Mask, Data);
 #elif defined __AIEBAREMTL__
@@ -45,6 +45,8 @@
 * 1.6  Nishad  12/05/2018  Renamed ME attributes to AIE
 * 1.7  Hyun    01/08/2019  Add XAieLib_MaskPoll()
 * 1.8  Tejus   10/14/2019  Enable assertion for linux and simulation
+* 1.9  Hyun    10/14/2019  Add the register write transaction APIs
+* 2.0  Hyun    10/14/2019  Add XAieLib_LoadElfMemMulti()
 * </pre>
 *
 ******************************************************************************/
@@ -73,6 +75,20 @@ typedef uint64_t		u64;
 /* Enable cache for memory mapping */
 #define XAIELIB_MEM_ATTR_CACHE		0x1U
 
+/* Mask of a recorded write that replaces the whole register */
+#define XAIELIB_TXN_MASK_ALL		0xFFFFFFFFU
+
+/*
+ * Register write recorded in a transaction buffer. Mask is
+ * XAIELIB_TXN_MASK_ALL for a plain write, or the mask of a masked write.
+ */
+typedef struct XAieLib_TxnCmd
+{
+	u64 Addr;	/**< Register address */
+	u32 Mask;	/**< Bits to write */
+	u32 Data;	/**< Register value */
+} XAieLib_TxnCmd;
+
 /************************** Variable Definitions *****************************/
 
 /************************** Function Prototypes  *****************************/
@@ -84,6 +100,10 @@ void XAieLib_Write128(u64 Addr, u32 *Data);
 void XAieLib_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0, u32 CmdWd1, u8 *CmdStr);
 u32 XAieLib_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs);
 
+u32 XAieLib_TxnStart(XAieLib_TxnCmd *CmdBuf, u32 NumCmds);
+u32 XAieLib_TxnFlush(void);
+u32 XAieLib_TxnSubmit(void);
+
 u32 XAieLib_NPIRead32(u64 Addr);
 void XAieLib_NPIWrite32(u64 Addr, u32 Data);
 u32 XAieLib_NPIMaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs);
@@ -97,6 +117,8 @@ typedef struct XAieGbl_Tile XAieGbl_Tile;
 
 u32 XAieLib_LoadElf(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym);
 u32 XAieLib_LoadElfMem(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym);
+u32 XAieLib_LoadElfMemMulti(XAieGbl_Tile **TileInstPtrs, u32 NumTiles,
+		u8 *ElfPtr, u8 LoadSym);
 
 void XAieLib_InitDev(void);
 u32 XAieLib_InitTile(XAieGbl_Tile *TileInstPtr);
@@ -0,0 +1,245 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xaietile_clean.c
+* @{
+*
+* This file contains the routines to reset a partition of the AIE array and
+* zeroize its memories between applications. The columns of the partition
+* are reset together through the shim column reset, which returns the core,
+* memory and stream switch modules of all their tiles, locks and DMAs
+* included, to the reset state. The memories are then zeroized with 128-bit
+* writes, which are interleaved across the tiles so the writes to different
+* columns are in flight at the same time.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0  Hyun    10/15/2019  Initial creation
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xaiegbl.h"
+#include "xaiegbl_defs.h"
+#include "xaiegbl_reginit.h"
+#include "xaietile_shim.h"
+#include "xaietile_clean.h"
+
+/***************************** Macro Definitions *****************************/
+#define XAIETILE_CLEAN_WORD_SIZE		16U
+
+/************************** Variable Definitions *****************************/
+extern XAieGbl_RegShimColumnReset ShimColumnReset;
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API returns a tile of the partition.
+*
+* @param	CleanPtr - Pointer to the partition.
+* @param	ColIdx - Column index in the array.
+* @param	RowIdx - Row index in the array, 0 for the shim tile.
+*
+* @return	Pointer to the tile instance.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static XAieGbl_Tile *XAieTile_CleanGetTile(XAieTile_Clean *CleanPtr,
+		u16 ColIdx, u16 RowIdx)
+{
+	return CleanPtr->TileInstPtr +
+		(ColIdx * (CleanPtr->ConfigPtr->NumRows + 1U)) + RowIdx;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the current time of the clean, or 0 if no time source is
+* given.
+*
+* @param	CleanPtr - Pointer to the partition.
+*
+* @return	Time stamp.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static u64 XAieTile_CleanTime(XAieTile_Clean *CleanPtr)
+{
+	u64 Time = 0U;
+
+	if (CleanPtr->TimeStamp != XAIE_NULL) {
+		Time = CleanPtr->TimeStamp();
+	}
+
+	return Time;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API zeroizes a memory in all AIE tiles of the partition. The loop
+* writes the same offset in every tile before moving to the next offset, so
+* consecutive writes go to different tiles and columns.
+*
+* @param	CleanPtr - Pointer to the partition.
+* @param	MemBase - Offset of the memory in the tile.
+* @param	MemSize - Size of the memory in bytes.
+*
+* @return	None.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static void XAieTile_CleanMem(XAieTile_Clean *CleanPtr, u32 MemBase,
+		u32 MemSize)
+{
+	u32 Zero[4U] = {0U, 0U, 0U, 0U};
+	XAieGbl_Tile *TileInstPtr;
+	u32 Offset;
+	u16 RowIdx;
+	u16 ColIdx;
+
+	for (Offset = 0U; Offset < MemSize;
+			Offset += XAIETILE_CLEAN_WORD_SIZE) {
+		for (RowIdx = 1U; RowIdx <= CleanPtr->ConfigPtr->NumRows;
+				RowIdx++) {
+			for (ColIdx = CleanPtr->StartCol;
+					ColIdx < CleanPtr->StartCol +
+					CleanPtr->NumCols; ColIdx++) {
+				TileInstPtr = XAieTile_CleanGetTile(CleanPtr,
+						ColIdx, RowIdx);
+				XAieGbl_Write128(TileInstPtr->TileAddr +
+						MemBase + Offset, Zero);
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API resets a partition of the AIE array and zeroizes the memories of
+* its AIE tiles, and reports the time spent in each phase.
+*
+* The column reset is asserted in all columns of the partition, then
+* released in all of them. It replaces the core control, lock and DMA
+* channel resets of each tile. The data and program memories selected by
+* the flags are zeroized afterwards, as they keep their content across the
+* reset.
+*
+* @param	CleanPtr - Pointer to the partition.
+* @param	ReportPtr - Pointer to the report, can be NULL.
+*
+* @return	XAIE_SUCCESS if successful, else XAIE_FAILURE.
+*
+* @note		The cores and DMAs of the partition are stopped by the column
+*		reset, so nothing else writes the memories while they are
+*		zeroized. The shim tiles of the partition are reset with their
+*		columns. The configuration of the partition is lost, the
+*		application has to be loaded again.
+*
+*******************************************************************************/
+u32 XAieTile_CleanPartition(XAieTile_Clean *CleanPtr,
+		XAieTile_CleanReport *ReportPtr)
+{
+	XAieTile_CleanReport Report = {0U};
+	XAieGbl_Tile *ShimInstPtr = XAIE_NULL;
+	u64 Start;
+	u64 PhaseStart;
+	u16 ColIdx;
+
+	XAie_AssertNonvoid(CleanPtr != XAIE_NULL);
+	XAie_AssertNonvoid(CleanPtr->TileInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid(CleanPtr->ConfigPtr != XAIE_NULL);
+
+	if ((CleanPtr->NumCols == 0U) || (CleanPtr->StartCol +
+			CleanPtr->NumCols > CleanPtr->ConfigPtr->NumCols)) {
+		return XAIE_FAILURE;
+	}
+
+	Start = XAieTile_CleanTime(CleanPtr);
+
+	/* Reset all columns at once */
+	PhaseStart = Start;
+	for (ColIdx = CleanPtr->StartCol;
+			ColIdx < CleanPtr->StartCol + CleanPtr->NumCols;
+			ColIdx++) {
+		ShimInstPtr = XAieTile_CleanGetTile(CleanPtr, ColIdx, 0U);
+		XAieTile_ShimColumnReset(ShimInstPtr, XAIE_RESETENABLE);
+	}
+
+	/* Read back to make sure the resets are asserted before release */
+	(void)XAieGbl_Read32(ShimInstPtr->TileAddr + ShimColumnReset.RegOff);
+
+	for (ColIdx = CleanPtr->StartCol;
+			ColIdx < CleanPtr->StartCol + CleanPtr->NumCols;
+			ColIdx++) {
+		ShimInstPtr = XAieTile_CleanGetTile(CleanPtr, ColIdx, 0U);
+		XAieTile_ShimColumnReset(ShimInstPtr, XAIE_RESETDISABLE);
+	}
+	(void)XAieGbl_Read32(ShimInstPtr->TileAddr + ShimColumnReset.RegOff);
+	Report.ResetTime = XAieTile_CleanTime(CleanPtr) - PhaseStart;
+
+	Report.NumTiles = (u32)CleanPtr->NumCols *
+		CleanPtr->ConfigPtr->NumRows;
+
+	if (CleanPtr->Flags & XAIETILE_CLEAN_DATAMEM) {
+		PhaseStart = XAieTile_CleanTime(CleanPtr);
+		XAieTile_CleanMem(CleanPtr, XAIEGBL_TILE_DATAMEM_BASE,
+				XAIETILE_CLEAN_DATAMEM_SIZE);
+		Report.DataMemTime = XAieTile_CleanTime(CleanPtr) - PhaseStart;
+		Report.BytesZeroized += Report.NumTiles *
+			XAIETILE_CLEAN_DATAMEM_SIZE;
+	}
+
+	if (CleanPtr->Flags & XAIETILE_CLEAN_PROGMEM) {
+		PhaseStart = XAieTile_CleanTime(CleanPtr);
+		XAieTile_CleanMem(CleanPtr, XAIEGBL_TILE_PROGMEM_BASE,
+				XAIETILE_CLEAN_PROGMEM_SIZE);
+		Report.ProgMemTime = XAieTile_CleanTime(CleanPtr) - PhaseStart;
+		Report.BytesZeroized += Report.NumTiles *
+			XAIETILE_CLEAN_PROGMEM_SIZE;
+	}
+
+	Report.TotalTime = XAieTile_CleanTime(CleanPtr) - Start;
+
+	if (ReportPtr != XAIE_NULL) {
+		*ReportPtr = Report;
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/** @} */
@@ -0,0 +1,92 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xaietile_clean.h
+* @{
+*
+*  Header file for the partition level reset and memory zeroization
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0  Hyun    10/15/2019  Initial creation
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIETILE_CLEAN_H
+#define XAIETILE_CLEAN_H
+
+/***************************** Include Files *********************************/
+
+/***************************** Constant Definitions **************************/
+/* Memories zeroized by XAieTile_CleanPartition() */
+#define XAIETILE_CLEAN_DATAMEM			(1U << 0)
+#define XAIETILE_CLEAN_PROGMEM			(1U << 1)
+
+#define XAIETILE_CLEAN_DATAMEM_SIZE		0x8000U
+#define XAIETILE_CLEAN_PROGMEM_SIZE		0x4000U
+
+/***************************** Type Definitions ******************************/
+/**
+ * This typedef contains the partition to clean. The columns of the
+ * partition are reset as a whole, so a partition is a range of columns.
+ */
+typedef struct
+{
+	XAieGbl_Tile *TileInstPtr;	/**< Tile array given to XAieGbl_CfgInitialize() */
+	XAieGbl_Config *ConfigPtr;	/**< Configuration of the AIE array */
+	u16 StartCol;			/**< First column of the partition */
+	u16 NumCols;			/**< Number of columns of the partition */
+	u32 Flags;			/**< XAIETILE_CLEAN_* memories to zeroize */
+	u64 (*TimeStamp)(void);		/**< Time source of the report, can be NULL */
+} XAieTile_Clean;
+
+/**
+ * This typedef contains the time spent in each phase of the clean, in the
+ * unit of the TimeStamp function.
+ */
+typedef struct
+{
+	u64 ResetTime;		/**< Column reset */
+	u64 DataMemTime;	/**< Data memory zeroization */
+	u64 ProgMemTime;	/**< Program memory zeroization */
+	u64 TotalTime;		/**< Whole clean */
+	u32 NumTiles;		/**< AIE tiles cleaned */
+	u32 BytesZeroized;	/**< Bytes written with zero */
+} XAieTile_CleanReport;
+
+/***************************** Macro Definitions *****************************/
+
+/************************** Function Prototypes  *****************************/
+u32 XAieTile_CleanPartition(XAieTile_Clean *CleanPtr, XAieTile_CleanReport *ReportPtr);
+
+#endif		/* end of protection macro */
+
+/** @} */
@@ -39,6 +39,7 @@
 * 1.0  Naresh  03/14/2018  Initial creation
 * 1.1  Naresh  07/11/2018  Updated copyright info
 * 1.2  Nishad  12/05/2018  Renamed ME attributes to AIE
+* 1.3  Hyun    10/14/2019  Add the non-blocking lock macros
 * </pre>
 *
 ******************************************************************************/
@@ -46,6 +47,9 @@
 #define XAIETILE_LOCK_H
 
 /***************************** Include Files *********************************/
+#if defined __AIEBAREMTL__ && !defined __AIESIM__
+#include "xil_io.h"
+#endif
 
 /***************************** Constant Definitions **************************/
 #define XAIETILE_LOCK_ACQ_SUCCESS		1U
@@ -60,9 +64,102 @@
 #define XAIETILE_LOCK_REL_VAL0			0U
 #define XAIETILE_LOCK_REL_VAL1			1U
 
+/* Lock register layout, from the lock base of the tile */
+#define XAIETILE_LOCK_REG_SHIFT			7U
+#define XAIETILE_LOCK_RELNV_OFF			0x00U
+#define XAIETILE_LOCK_RELV0_OFF			0x20U
+#define XAIETILE_LOCK_RELV1_OFF			0x30U
+#define XAIETILE_LOCK_ACQNV_OFF			0x40U
+#define XAIETILE_LOCK_ACQV0_OFF			0x60U
+#define XAIETILE_LOCK_ACQV1_OFF			0x70U
+#define XAIETILE_LOCK_DONE_MASK			0x1U
+
 /**************************** Type Definitions *******************************/
 
 /***************************** Macro Definitions *****************************/
+/*
+ * Lock operations are triggered by reads. The read goes through the IO layer
+ * on all targets, so that the writes of a pending XAieLib transaction are
+ * applied before the lock is acquired or released.
+ */
+#define XAieTile_LockRead32(Addr)		XAieGbl_Read32(Addr)
+
+/*****************************************************************************/
+/**
+*
+* Macro to compute the address of a lock register.
+*
+* @param	TileAddr - Tile base address, TileAddr of the tile instance or
+*		XAieGbl_TileAddr().
+* @param	LockOff - XAIEGBL_TILE_ADDR_MEMLOCKOFF for an AIE tile or
+*		XAIEGBL_TILE_ADDR_NOCLOCKOFF for a Shim tile.
+* @param	LockId - Lock index, ranging from 0-15.
+* @param	RegOff - One of the XAIETILE_LOCK_*_OFF register offsets.
+*
+* @return	Lock register address.
+*
+* @note		None.
+*
+*******************************************************************************/
+#define XAieTile_LockRegAddr(TileAddr, LockOff, LockId, RegOff)		\
+			((u64)(TileAddr) + (LockOff) +				\
+			((u64)(LockId) << XAIETILE_LOCK_REG_SHIFT) + (RegOff))
+
+/*****************************************************************************/
+/**
+*
+* Macro to try to acquire a lock once, with or without value. When the
+* arguments are constants, as with XAieGbl_TileAddr(), this is a single
+* register read with no table lookup and no assertion.
+*
+* @param	TileAddr - Tile base address.
+* @param	LockOff - XAIEGBL_TILE_ADDR_MEMLOCKOFF or
+*		XAIEGBL_TILE_ADDR_NOCLOCKOFF.
+* @param	LockId - Lock index, ranging from 0-15.
+* @param	LockVal - Lock value used for acquire (0, 1, or 0xFF for no
+*		value).
+*
+* @return	1 if acquire successful, else 0.
+*
+* @note		Same as XAieTile_LockAcquire() with a TimeOut of 0.
+*
+*******************************************************************************/
+#define XAieTile_LockAcquireNb(TileAddr, LockOff, LockId, LockVal)		\
+			((u8)(XAieTile_LockRead32(XAieTile_LockRegAddr(	\
+			TileAddr, LockOff, LockId,				\
+			((LockVal) == XAIETILE_LOCK_ACQ_VAL0) ?			\
+			XAIETILE_LOCK_ACQV0_OFF :				\
+			((LockVal) == XAIETILE_LOCK_ACQ_VAL1) ?			\
+			XAIETILE_LOCK_ACQV1_OFF : XAIETILE_LOCK_ACQNV_OFF)) &	\
+			XAIETILE_LOCK_DONE_MASK))
+
+/*****************************************************************************/
+/**
+*
+* Macro to try to release a lock once, with or without value. When the
+* arguments are constants, this is a single register read with no table
+* lookup and no assertion.
+*
+* @param	TileAddr - Tile base address.
+* @param	LockOff - XAIEGBL_TILE_ADDR_MEMLOCKOFF or
+*		XAIEGBL_TILE_ADDR_NOCLOCKOFF.
+* @param	LockId - Lock index, ranging from 0-15.
+* @param	LockVal - Lock value used for release (0, 1, or 0xFF for no
+*		value).
+*
+* @return	1 if release successful, else 0.
+*
+* @note		Same as XAieTile_LockRelease() with a TimeOut of 0.
+*
+*******************************************************************************/
+#define XAieTile_LockReleaseNb(TileAddr, LockOff, LockId, LockVal)		\
+			((u8)(XAieTile_LockRead32(XAieTile_LockRegAddr(	\
+			TileAddr, LockOff, LockId,				\
+			((LockVal) == XAIETILE_LOCK_REL_VAL0) ?			\
+			XAIETILE_LOCK_RELV0_OFF :				\
+			((LockVal) == XAIETILE_LOCK_REL_VAL1) ?			\
+			XAIETILE_LOCK_RELV1_OFF : XAIETILE_LOCK_RELNV_OFF)) &	\
+			XAIETILE_LOCK_DONE_MASK))
 
 /************************** Function Prototypes  *****************************/
 u8 XAieTile_LockAcquire(XAieGbl_Tile *TileInstPtr, u8 LockId, u8 LockVal, u32 TimeOut);
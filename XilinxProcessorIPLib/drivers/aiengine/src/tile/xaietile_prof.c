@@ -0,0 +1,432 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xaietile_prof.c
+* @{
+*
+* This file contains the routines to profile a group of AIE tiles, typically
+* the tiles of a graph. The core module performance counters of every tile
+* are set up in one call to count the enabled, lock stall, stream stall and
+* port stalled cycles. The counters are then sampled into a user buffer, and
+* reported per kernel or exported as a timeline in the trace event format.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0  Hyun    10/14/2019  Initial creation
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+
+#include "xaiegbl.h"
+#include "xaiegbl_defs.h"
+#include "xaietile_core.h"
+#include "xaietile_event.h"
+#include "xaietile_perfcnt.h"
+#include "xaietile_prof.h"
+
+/***************************** Macro Definitions *****************************/
+/* Room for the closing of the trace event array */
+#define XAIETILE_PROF_EXPORT_TAIL		3U
+
+/************************** Variable Definitions *****************************/
+/* Names of the counters in the exported timeline */
+static const char *XAieTile_ProfCntName[XAIETILE_PROF_NUM_COUNTERS] = {
+	"active",
+	"lock_stall",
+	"stream_stall",
+	"backpressure"
+};
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API sets up the core module performance counters of a tile of the
+* profile and clears them.
+*
+* @param	ProfTilePtr - Pointer to the profiled tile.
+*
+* @return	None.
+*
+* @note		Used only within this file. A counter whose start and stop
+*		events are the same counts the cycles the event is asserted.
+*
+*******************************************************************************/
+static void XAieTile_ProfTileSetup(XAieTile_ProfTile *ProfTilePtr)
+{
+	XAieGbl_Tile *TileInstPtr = ProfTilePtr->TileInstPtr;
+	u16 PortEvent = XAIETILE_EVENT_CORE_NONE;
+	u8 Counter;
+
+	XAieTileCore_PerfCounterControl(TileInstPtr, XAIETILE_PROF_CNT_ACTIVE,
+			XAIETILE_EVENT_CORE_ACTIVE, XAIETILE_EVENT_CORE_DISABLED,
+			XAIETILE_EVENT_CORE_NONE);
+	XAieTileCore_PerfCounterControl(TileInstPtr,
+			XAIETILE_PROF_CNT_LOCK_STALL,
+			XAIETILE_EVENT_CORE_LOCK_STALL,
+			XAIETILE_EVENT_CORE_LOCK_STALL,
+			XAIETILE_EVENT_CORE_NONE);
+	XAieTileCore_PerfCounterControl(TileInstPtr,
+			XAIETILE_PROF_CNT_STREAM_STALL,
+			XAIETILE_EVENT_CORE_STREAM_STALL,
+			XAIETILE_EVENT_CORE_STREAM_STALL,
+			XAIETILE_EVENT_CORE_NONE);
+
+	if (ProfTilePtr->PortId != XAIETILE_PROF_PORT_NONE) {
+		XAieTile_CoreStrmSwEventPortSelectSet(TileInstPtr,
+				XAIETILE_STRSW_EVENT_PORT_0,
+				ProfTilePtr->PortType, ProfTilePtr->PortId);
+		PortEvent = XAIETILE_EVENT_CORE_PORT_STALLED_0;
+	}
+	XAieTileCore_PerfCounterControl(TileInstPtr,
+			XAIETILE_PROF_CNT_BACKPRESSURE, PortEvent, PortEvent,
+			XAIETILE_EVENT_CORE_NONE);
+
+	for (Counter = 0U; Counter < XAIETILE_PROF_NUM_COUNTERS; Counter++) {
+		XAieTileCore_PerfCounterSet(TileInstPtr, Counter, 0U);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API initializes the profiling of a group of tiles, and sets up the
+* core module performance counters of all the tiles. The performance
+* counters 0 to 3 of the tiles are owned by the profiling afterwards.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	Tiles - Array of the profiled tiles.
+* @param	NumTiles - Number of tiles in the array.
+* @param	Samples - Buffer of samples.
+* @param	MaxSamples - Number of samples the buffer can hold.
+*
+* @return	XAIE_SUCCESS if successful, else XAIE_FAILURE.
+*
+* @note		This API should be called before the cores are enabled, so
+*		the counters cover the whole run.
+*
+*******************************************************************************/
+u32 XAieTile_ProfInitialize(XAieTile_Prof *ProfPtr, XAieTile_ProfTile *Tiles,
+		u32 NumTiles, XAieTile_ProfSample *Samples, u32 MaxSamples)
+{
+	u32 Idx;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+	XAie_AssertNonvoid(Tiles != XAIE_NULL);
+	XAie_AssertNonvoid(Samples != XAIE_NULL);
+
+	if (NumTiles == 0U || MaxSamples < NumTiles) {
+		return XAIE_FAILURE;
+	}
+
+	for (Idx = 0U; Idx < NumTiles; Idx++) {
+		if (Tiles[Idx].TileInstPtr == XAIE_NULL ||
+				Tiles[Idx].TileInstPtr->TileType !=
+				XAIEGBL_TILE_TYPE_AIETILE) {
+			return XAIE_FAILURE;
+		}
+	}
+
+	ProfPtr->Tiles = Tiles;
+	ProfPtr->NumTiles = NumTiles;
+	ProfPtr->Samples = Samples;
+	ProfPtr->MaxSamples = MaxSamples;
+
+	for (Idx = 0U; Idx < NumTiles; Idx++) {
+		XAieTile_ProfTileSetup(&Tiles[Idx]);
+	}
+
+	XAieTile_ProfReset(ProfPtr);
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API clears the performance counters of all the profiled tiles and
+* empties the sample buffer.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieTile_ProfReset(XAieTile_Prof *ProfPtr)
+{
+	u32 Idx;
+	u8 Counter;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+
+	for (Idx = 0U; Idx < ProfPtr->NumTiles; Idx++) {
+		for (Counter = 0U; Counter < XAIETILE_PROF_NUM_COUNTERS;
+				Counter++) {
+			XAieTileCore_PerfCounterSet(
+					ProfPtr->Tiles[Idx].TileInstPtr,
+					Counter, 0U);
+		}
+	}
+
+	ProfPtr->NumSamples = 0U;
+	ProfPtr->DroppedPasses = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API samples the timer and the performance counters of all the
+* profiled tiles into the sample buffer. It is called periodically while the
+* graph runs, for example from a timer handler of the host.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+*
+* @return	XAIE_SUCCESS if successful, or XAIE_FAILURE if the buffer has
+*		no room for a sample of every tile.
+*
+* @note		A pass samples either all the tiles or none of them, so the
+*		sample n is of the tile n % NumTiles. The 32-bit counters
+*		wrap, the API must be called at least once every 2^32 cycles.
+*
+*******************************************************************************/
+u32 XAieTile_ProfSampleAll(XAieTile_Prof *ProfPtr)
+{
+	XAieTile_ProfSample *SamplePtr;
+	XAieGbl_Tile *TileInstPtr;
+	u32 Idx;
+	u8 Counter;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+
+	if (ProfPtr->MaxSamples - ProfPtr->NumSamples < ProfPtr->NumTiles) {
+		ProfPtr->DroppedPasses++;
+		return XAIE_FAILURE;
+	}
+
+	for (Idx = 0U; Idx < ProfPtr->NumTiles; Idx++) {
+		TileInstPtr = ProfPtr->Tiles[Idx].TileInstPtr;
+		SamplePtr = &ProfPtr->Samples[ProfPtr->NumSamples];
+
+		SamplePtr->Timestamp = XAieTile_CoreReadTimer(TileInstPtr);
+		SamplePtr->TileIdx = Idx;
+		for (Counter = 0U; Counter < XAIETILE_PROF_NUM_COUNTERS;
+				Counter++) {
+			SamplePtr->Count[Counter] =
+				XAieTileCore_PerfCounterGet(TileInstPtr,
+						Counter);
+		}
+
+		ProfPtr->NumSamples++;
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API reports the counts of a kernel between the first and the last
+* samples in the buffer, summed over all the tiles running the kernel.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	KernelId - Kernel to report.
+* @param	ReportPtr - Pointer to the report to fill.
+*
+* @return	XAIE_SUCCESS if successful, or XAIE_FAILURE if no tile runs
+*		the kernel or fewer than 2 passes are sampled.
+*
+* @note		The counts are accumulated pass by pass, so counters that
+*		wrapped between the first and the last samples are handled.
+*
+*******************************************************************************/
+u32 XAieTile_ProfGetReport(XAieTile_Prof *ProfPtr, u32 KernelId,
+		XAieTile_ProfReport *ReportPtr)
+{
+	XAieTile_ProfSample *PrevPtr;
+	XAieTile_ProfSample *CurPtr;
+	u32 NumTiles;
+	u32 Idx;
+	u32 Sample;
+	u8 Counter;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+	XAie_AssertNonvoid(ReportPtr != XAIE_NULL);
+
+	NumTiles = ProfPtr->NumTiles;
+
+	ReportPtr->KernelId = KernelId;
+	ReportPtr->NumTiles = 0U;
+	ReportPtr->Cycles = 0U;
+	for (Counter = 0U; Counter < XAIETILE_PROF_NUM_COUNTERS; Counter++) {
+		ReportPtr->Count[Counter] = 0U;
+	}
+
+	if (ProfPtr->NumSamples < 2U * NumTiles) {
+		return XAIE_FAILURE;
+	}
+
+	for (Idx = 0U; Idx < NumTiles; Idx++) {
+		if (ProfPtr->Tiles[Idx].KernelId != KernelId) {
+			continue;
+		}
+
+		ReportPtr->NumTiles++;
+		for (Sample = Idx + NumTiles; Sample < ProfPtr->NumSamples;
+				Sample += NumTiles) {
+			PrevPtr = &ProfPtr->Samples[Sample - NumTiles];
+			CurPtr = &ProfPtr->Samples[Sample];
+
+			ReportPtr->Cycles += CurPtr->Timestamp -
+				PrevPtr->Timestamp;
+			for (Counter = 0U; Counter < XAIETILE_PROF_NUM_COUNTERS;
+					Counter++) {
+				ReportPtr->Count[Counter] +=
+					(u32)(CurPtr->Count[Counter] -
+					      PrevPtr->Count[Counter]);
+			}
+		}
+	}
+
+	if (ReportPtr->NumTiles == 0U) {
+		return XAIE_FAILURE;
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API exports the samples as a timeline in the trace event format, a
+* JSON array of counter events that trace viewers such as chrome://tracing
+* display. Each kernel is a process and each tile a counter track, with the
+* cycles counted since the previous sample of the tile.
+*
+* @param	ProfPtr - Pointer to the profiling instance.
+* @param	CyclesPerUs - AIE clock frequency in MHz, to convert the timer
+*		to the microseconds of the format.
+* @param	Buf - Buffer receiving the timeline.
+* @param	Size - Size of the buffer in bytes.
+* @param	LenPtr - Pointer to the length of the timeline, without the
+*		terminating null.
+*
+* @return	XAIE_SUCCESS if successful, or XAIE_FAILURE if the buffer is
+*		too small. The timeline is then truncated at the last sample
+*		that fits, and still a valid JSON array.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieTile_ProfExport(XAieTile_Prof *ProfPtr, u32 CyclesPerUs, char *Buf,
+		u32 Size, u32 *LenPtr)
+{
+	XAieTile_ProfSample *PrevPtr;
+	XAieTile_ProfSample *CurPtr;
+	XAieTile_ProfTile *ProfTilePtr;
+	u32 NumTiles;
+	u32 Sample;
+	u32 Len = 0U;
+	u32 Ret = XAIE_SUCCESS;
+	int Cnt;
+	u8 Counter;
+
+	XAie_AssertNonvoid(ProfPtr != XAIE_NULL);
+	XAie_AssertNonvoid(Buf != XAIE_NULL);
+	XAie_AssertNonvoid(LenPtr != XAIE_NULL);
+	XAie_AssertNonvoid(CyclesPerUs != 0U);
+
+	NumTiles = ProfPtr->NumTiles;
+
+	if (Size < 2U + XAIETILE_PROF_EXPORT_TAIL) {
+		*LenPtr = 0U;
+		return XAIE_FAILURE;
+	}
+
+	Buf[Len++] = '[';
+	for (Sample = NumTiles; Sample < ProfPtr->NumSamples; Sample++) {
+		PrevPtr = &ProfPtr->Samples[Sample - NumTiles];
+		CurPtr = &ProfPtr->Samples[Sample];
+		ProfTilePtr = &ProfPtr->Tiles[CurPtr->TileIdx];
+
+		Cnt = snprintf(&Buf[Len], Size - Len - XAIETILE_PROF_EXPORT_TAIL,
+				"%s\n{\"name\":\"tile_%d_%d\",\"ph\":\"C\","
+				"\"ts\":%llu,\"pid\":%u,\"args\":{",
+				(Sample == NumTiles) ? "" : ",",
+				ProfTilePtr->TileInstPtr->ColId,
+				ProfTilePtr->TileInstPtr->RowId,
+				(unsigned long long)(CurPtr->Timestamp /
+					CyclesPerUs),
+				(unsigned int)ProfTilePtr->KernelId);
+		if (Cnt < 0 || (u32)Cnt >=
+				Size - Len - XAIETILE_PROF_EXPORT_TAIL) {
+			Ret = XAIE_FAILURE;
+			break;
+		}
+
+		for (Counter = 0U; Counter < XAIETILE_PROF_NUM_COUNTERS;
+				Counter++) {
+			Cnt += snprintf(&Buf[Len + Cnt],
+					Size - Len - Cnt -
+					XAIETILE_PROF_EXPORT_TAIL,
+					"%s\"%s\":%u", Counter ? "," : "",
+					XAieTile_ProfCntName[Counter],
+					(unsigned int)(CurPtr->Count[Counter] -
+						PrevPtr->Count[Counter]));
+			if ((u32)Cnt + 2U >=
+					Size - Len - XAIETILE_PROF_EXPORT_TAIL) {
+				break;
+			}
+		}
+		if (Counter < XAIETILE_PROF_NUM_COUNTERS) {
+			Ret = XAIE_FAILURE;
+			break;
+		}
+
+		/* Only commit the event once it fits as a whole */
+		Len += Cnt;
+		Buf[Len++] = '}';
+		Buf[Len++] = '}';
+	}
+
+	Buf[Len++] = '\n';
+	Buf[Len++] = ']';
+	Buf[Len] = '\0';
+	*LenPtr = Len;
+
+	return Ret;
+}
+
+/** @} */
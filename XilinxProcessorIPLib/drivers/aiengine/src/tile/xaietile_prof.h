@@ -0,0 +1,119 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xaietile_prof.h
+* @{
+*
+*  Header file for the profiling of a group of AIE tiles
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0  Hyun    10/14/2019  Initial creation
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIETILE_PROF_H
+#define XAIETILE_PROF_H
+
+/***************************** Include Files *********************************/
+
+/***************************** Constant Definitions **************************/
+#define XAIETILE_PROF_NUM_COUNTERS		4U
+
+/* Core module performance counters used by the profiling */
+#define XAIETILE_PROF_CNT_ACTIVE		0U	/* Core enabled cycles */
+#define XAIETILE_PROF_CNT_LOCK_STALL		1U	/* Lock stall cycles */
+#define XAIETILE_PROF_CNT_STREAM_STALL		2U	/* Stream stall cycles */
+#define XAIETILE_PROF_CNT_BACKPRESSURE		3U	/* Port stalled cycles */
+
+/* No stream switch port is monitored for backpressure */
+#define XAIETILE_PROF_PORT_NONE			0xFFU
+
+/***************************** Type Definitions ******************************/
+/**
+ * This typedef contains a tile of the profiled graph.
+ */
+typedef struct
+{
+	XAieGbl_Tile *TileInstPtr;	/**< AIE tile */
+	u32 KernelId;			/**< Kernel running on the tile */
+	u8 PortType;			/**< Monitored port type (master = 1, slave = 0) */
+	u8 PortId;			/**< Monitored port ID, or XAIETILE_PROF_PORT_NONE */
+} XAieTile_ProfTile;
+
+/**
+ * This typedef is a sample of the counters of a tile.
+ */
+typedef struct
+{
+	u64 Timestamp;				/**< Core module timer */
+	u32 TileIdx;				/**< Index of the tile in the profile */
+	u32 Count[XAIETILE_PROF_NUM_COUNTERS];	/**< Counter values */
+} XAieTile_ProfSample;
+
+/**
+ * This typedef contains the counts of a kernel between the first and the
+ * last samples, summed over the tiles of the kernel.
+ */
+typedef struct
+{
+	u32 KernelId;				/**< Kernel */
+	u32 NumTiles;				/**< Tiles running the kernel */
+	u64 Cycles;				/**< Timer cycles */
+	u64 Count[XAIETILE_PROF_NUM_COUNTERS];	/**< Counted cycles */
+} XAieTile_ProfReport;
+
+/**
+ * This typedef is the profiling instance. User is required to allocate memory
+ * for the instance, the tile array and the sample buffer.
+ */
+typedef struct
+{
+	XAieTile_ProfTile *Tiles;	/**< Profiled tiles */
+	u32 NumTiles;			/**< Number of profiled tiles */
+	XAieTile_ProfSample *Samples;	/**< Sample buffer */
+	u32 MaxSamples;			/**< Number of samples in the buffer */
+	u32 NumSamples;			/**< Valid samples in the buffer */
+	u32 DroppedPasses;		/**< Passes lost because the buffer was full */
+} XAieTile_Prof;
+
+/***************************** Macro Definitions *****************************/
+
+/************************** Function Prototypes  *****************************/
+u32 XAieTile_ProfInitialize(XAieTile_Prof *ProfPtr, XAieTile_ProfTile *Tiles, u32 NumTiles, XAieTile_ProfSample *Samples, u32 MaxSamples);
+void XAieTile_ProfReset(XAieTile_Prof *ProfPtr);
+u32 XAieTile_ProfSampleAll(XAieTile_Prof *ProfPtr);
+u32 XAieTile_ProfGetReport(XAieTile_Prof *ProfPtr, u32 KernelId, XAieTile_ProfReport *ReportPtr);
+u32 XAieTile_ProfExport(XAieTile_Prof *ProfPtr, u32 CyclesPerUs, char *Buf, u32 Size, u32 *LenPtr);
+
+#endif		/* end of protection macro */
+
+/** @} */
@@ -7,6 +7,7 @@
 #include <xaiengine/xaiegbl_reginit.h>
 #include <xaiengine/xaielib.h>
 #include <xaiengine/xaielib_npi.h>
+#include <xaiengine/xaietile_clean.h>
 #include <xaiengine/xaietile_core.h>
 #include <xaiengine/xaietile_event.h>
 #include <xaiengine/xaietile_lock.h>
@@ -15,6 +16,7 @@
 #include <xaiengine/xaietile_perfcnt.h>
 #include <xaiengine/xaietile_pl.h>
 #include <xaiengine/xaietile_plif.h>
+#include <xaiengine/xaietile_prof.h>
 #include <xaiengine/xaietile_shim.h>
 #include <xaiengine/xaietile_strm.h>
 #include <xaiengine/xparameters_aie.h>
@@ -40,6 +40,20 @@
 * The driver does the interrupt handling, and dispatch to the user application
 * through callback functions that user has registered.
 *
+* <b> Ring Buffer </b>
+*
+* The core loops over the periods of its buffer on its own. The ring layer in
+* xaudioformatter_ring.c keeps it running and tracks the periods in software:
+* XAudioFormatterRingInit() binds a channel to a buffer, the application
+* fills (MM2S) or drains (S2MM) it one period at a time with
+* XAudioFormatterRingGetPeriod() and XAudioFormatterRingAdvance(), and the IOC
+* interrupt of each period advances the hardware position and time stamps
+* it. When the application falls behind, the ring resynchronizes its position
+* instead of stopping the DMA; an MM2S underrun plays silence rather than
+* replaying stale periods. XAudioFormatterRingSetLowLatency() selects 1 ms
+* periods. The interrupt latency must stay below one period, as the core
+* reports a single IOC event for periods completed back to back.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -177,6 +191,37 @@ typedef struct {
 	u32 bytes_per_period;
 } XAudioFormatterHwParams;
 
+typedef u64 (*XAudioFormatter_TimeFunc)(void);
+typedef void (*XAudioFormatter_PeriodCallback)(void *CallbackRef, u32 Period,
+	u64 Timestamp);
+typedef void (*XAudioFormatter_XrunCallback)(void *CallbackRef, u32 Xruns);
+
+/**
+* This typedef contains the state of a channel run as a ring buffer. Positions
+* are free running period counts.
+*/
+typedef struct {
+	XAudioFormatter *InstancePtr;	/**< Audio formatter instance */
+	XAudioFormatter_ChannelId ChannelId;	/**< Channel of the ring */
+	XAudioFormatterHwParams HwParams;	/**< Buffer and period layout */
+	u8 *Buf;			/**< Buffer, periods * bytes_per_period
+					  *  bytes */
+	volatile u32 HwPos;		/**< Periods completed by the core */
+	volatile u64 Timestamp;		/**< Time of the last completion */
+	volatile u32 Xruns;		/**< Periods underrun or overrun */
+	u32 AppPos;			/**< Periods written or read by the
+					  *  application */
+	u8 Running;			/**< DMA is started */
+	XAudioFormatter_TimeFunc TimeFunc;	/**< Time stamp source */
+	XAudioFormatter_PeriodCallback PeriodCallback;
+	void *PeriodCallbackRef;
+	XAudioFormatter_XrunCallback XrunCallback;
+	void *XrunCallbackRef;
+} XAudioFormatter_Ring;
+
+#define XAUD_RING_LL_PERIOD_US	1000	/**< Low latency period length */
+#define XAUD_RING_LL_PERIODS	XAUD_PERIODS_MIN /**< Low latency periods */
+
 /*****************************************************************************/
 
 
@@ -208,6 +253,28 @@ void XAudioFormatterSetFsMultiplier(XAudioFormatter *InstancePtr, u32 Mclk,
 u32 XAudioFormatterGetDMATransferCount(XAudioFormatter *InstancePtr);
 void XSdiAud_GetChStat(XAudioFormatter *InstancePtr, u8 *ChStatBuf);
 void XAudioFormatterSetS2MMTimeOut(XAudioFormatter *InstancePtr, u32 TimeOut);
+
+/* Ring buffer functions in xaudioformatter_ring.c */
+u32 XAudioFormatterRingPeriodBytes(u32 Fs, u32 active_ch, u32 bits_per_sample,
+	u32 PeriodUs);
+u32 XAudioFormatterRingSetLowLatency(XAudioFormatterHwParams *hw_params,
+	u32 Fs);
+u32 XAudioFormatterRingInit(XAudioFormatter_Ring *RingPtr,
+	XAudioFormatter *InstancePtr, XAudioFormatter_ChannelId ChannelId,
+	XAudioFormatterHwParams *hw_params);
+void XAudioFormatterRingSetTimeFunc(XAudioFormatter_Ring *RingPtr,
+	XAudioFormatter_TimeFunc TimeFunc);
+void XAudioFormatterRingSetPeriodCallback(XAudioFormatter_Ring *RingPtr,
+	XAudioFormatter_PeriodCallback CallbackFunc, void *CallbackRef);
+void XAudioFormatterRingSetXrunCallback(XAudioFormatter_Ring *RingPtr,
+	XAudioFormatter_XrunCallback CallbackFunc, void *CallbackRef);
+void XAudioFormatterRingStart(XAudioFormatter_Ring *RingPtr);
+void XAudioFormatterRingStop(XAudioFormatter_Ring *RingPtr);
+u32 XAudioFormatterRingAvail(XAudioFormatter_Ring *RingPtr);
+u8 *XAudioFormatterRingGetPeriod(XAudioFormatter_Ring *RingPtr);
+void XAudioFormatterRingAdvance(XAudioFormatter_Ring *RingPtr);
+u32 XAudioFormatterRingGetPosition(XAudioFormatter_Ring *RingPtr,
+	u64 *TimestampPtr);
 /******************************************************************************/
 
 #ifdef __cplusplus
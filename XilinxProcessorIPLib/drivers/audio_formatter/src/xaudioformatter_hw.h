@@ -186,6 +186,8 @@ extern "C" {
 
 #define XAUD_CTRL_DATA_WIDTH_SHIFT       16
 #define XAUD_CTRL_ACTIVE_CH_SHIFT        19
+#define XAUD_CTRL_DATA_WIDTH_MASK        (0x7 << XAUD_CTRL_DATA_WIDTH_SHIFT)
+#define XAUD_CTRL_ACTIVE_CH_MASK         (0xF << XAUD_CTRL_ACTIVE_CH_SHIFT)
 #define XAUD_PERIOD_CFG_PERIODS_SHIFT    16
 
 #define XAUD_CHANNELS_MIN            2
@@ -193,6 +195,7 @@ extern "C" {
 #define XAUD_PERIODS_MAX             8
 #define XAUD_PERIOD_BYTES_MIN        64
 #define XAUD_PERIOD_BYTES_MAX        (50 * 1024)
+#define XAUD_PERIOD_BYTES_ALIGN      64
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -0,0 +1,575 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaudioformatter_ring.c
+* @addtogroup audio_formatter_v1_0
+* @{
+*
+* This file contains the ring buffer layer of the Audio Formatter driver.
+*
+* The core runs continuously over the periods of its buffer. The IOC
+* interrupt of each period advances the hardware position (HwPos) and the
+* application advances its own position (AppPos) as it fills or drains
+* periods. The two positions are written from one context each, so the ring
+* needs no locking between the interrupt handler and the application.
+*
+* MM2S: the periods in [HwPos, AppPos) are queued, HwPos being played. When
+* the core completes a period the application had not queued in time, the
+* next period is silenced and the application resumes after the period being
+* played.
+*
+* S2MM: the periods in [AppPos, HwPos) hold captured data. When the core
+* wraps onto a period the application had not read, the application resumes
+* at the oldest period which is still intact.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xaudioformatter.h"
+
+/************************** Function Prototypes ******************************/
+
+static void XAudioFormatterRingIOCHandler(void *CallbackRef);
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function returns the size in memory of a sample of the given bit depth.
+*
+******************************************************************************/
+static u32 XAudioFormatterRingSampleBytes(u32 bits_per_sample)
+{
+	if (bits_per_sample == BIT_DEPTH_8)
+		return 1;
+	if (bits_per_sample == BIT_DEPTH_16)
+		return 2;
+	return 4;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the period size alignment for a frame size, the
+* smallest multiple of both the frame size and XAUD_PERIOD_BYTES_ALIGN.
+*
+******************************************************************************/
+static u32 XAudioFormatterRingPeriodAlign(u32 FrameBytes)
+{
+	u32 a = FrameBytes;
+	u32 b = XAUD_PERIOD_BYTES_ALIGN;
+	u32 t;
+
+	while (b != 0) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+	return (FrameBytes / a) * XAUD_PERIOD_BYTES_ALIGN;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function computes the period size for a period length.
+*
+* @param	Fs is the sampling frequency in Hz.
+* @param	active_ch is the number of channels.
+* @param	bits_per_sample is the bit depth, enum XAudioFormatter_BitDepth.
+* @param	PeriodUs is the period length in microseconds.
+*
+* @return	Period size in bytes, rounded up to whole frames and to the
+*		64 byte period granularity of the core.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XAudioFormatterRingPeriodBytes(u32 Fs, u32 active_ch, u32 bits_per_sample,
+	u32 PeriodUs)
+{
+	u32 FrameBytes;
+	u32 Align;
+	u32 Frames;
+	u32 Bytes;
+
+	Xil_AssertNonvoid(Fs > 0);
+	Xil_AssertNonvoid(active_ch > 0);
+	Xil_AssertNonvoid(bits_per_sample <= BIT_DEPTH_32);
+
+	FrameBytes = active_ch * XAudioFormatterRingSampleBytes(bits_per_sample);
+	Align = XAudioFormatterRingPeriodAlign(FrameBytes);
+	Frames = (u32)(((u64)Fs * PeriodUs + 999999U) / 1000000U);
+	Bytes = Frames * FrameBytes;
+
+	return ((Bytes + Align - 1) / Align) * Align;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function selects the low latency mode: XAUD_RING_LL_PERIODS periods of
+* XAUD_RING_LL_PERIOD_US each.
+*
+* @param	hw_params is a pointer to the hw params, with active_ch and
+*		bits_per_sample set. Its periods and bytes_per_period are
+*		updated.
+* @param	Fs is the sampling frequency in Hz.
+*
+* @return
+*		- XST_SUCCESS if the period fits the core.
+*		- XST_INVALID_PARAM otherwise.
+*
+* @note		The period is rounded up, to 1.33 ms for 44.1 kHz stereo
+*		16 bit audio for instance.
+*
+******************************************************************************/
+u32 XAudioFormatterRingSetLowLatency(XAudioFormatterHwParams *hw_params,
+	u32 Fs)
+{
+	u32 Bytes;
+
+	Xil_AssertNonvoid(hw_params != NULL);
+
+	Bytes = XAudioFormatterRingPeriodBytes(Fs, hw_params->active_ch,
+		hw_params->bits_per_sample, XAUD_RING_LL_PERIOD_US);
+	if (Bytes < XAUD_PERIOD_BYTES_MIN)
+		Bytes = XAUD_PERIOD_BYTES_MIN;
+	if (Bytes > XAUD_PERIOD_BYTES_MAX)
+		return XST_INVALID_PARAM;
+
+	hw_params->periods = XAUD_RING_LL_PERIODS;
+	hw_params->bytes_per_period = Bytes;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a ring buffer on a channel of the core. The DMA
+* is not started; MM2S periods can be queued before XAudioFormatterRingStart()
+* and the buffer is cleared so that unqueued periods play silence.
+*
+* @param	RingPtr is a pointer to the ring.
+* @param	InstancePtr is a pointer to the XAudioFormatter instance.
+* @param	ChannelId is the channel run as a ring buffer.
+* @param	hw_params is a pointer to the buffer and period layout.
+*		bytes_per_period must be a multiple of the frame size and
+*		of XAUD_PERIOD_BYTES_ALIGN.
+*
+* @return
+*		- XST_SUCCESS if the ring is initialized.
+*		- XST_INVALID_PARAM if the channel is absent or the layout
+*		  is not supported.
+*
+* @note		The IOC callback of the channel is taken by the ring. The
+*		period and xrun callbacks replace it.
+*
+******************************************************************************/
+u32 XAudioFormatterRingInit(XAudioFormatter_Ring *RingPtr,
+	XAudioFormatter *InstancePtr, XAudioFormatter_ChannelId ChannelId,
+	XAudioFormatterHwParams *hw_params)
+{
+	u32 MaxChannels;
+	u32 FrameBytes;
+
+	Xil_AssertNonvoid(RingPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(hw_params != NULL);
+
+	if (ChannelId == XAudioFormatter_S2MM) {
+		if (!InstancePtr->s2mm_presence)
+			return XST_INVALID_PARAM;
+		MaxChannels = InstancePtr->Config.MaxChannelsS2MM;
+	} else {
+		if (!InstancePtr->mm2s_presence)
+			return XST_INVALID_PARAM;
+		MaxChannels = InstancePtr->Config.MaxChannelsMM2S;
+	}
+	if (hw_params->bits_per_sample > BIT_DEPTH_32 ||
+		hw_params->active_ch < XAUD_CHANNELS_MIN ||
+		hw_params->active_ch > MaxChannels ||
+		hw_params->periods < XAUD_PERIODS_MIN ||
+		hw_params->periods > XAUD_PERIODS_MAX ||
+		hw_params->bytes_per_period < XAUD_PERIOD_BYTES_MIN ||
+		hw_params->bytes_per_period > XAUD_PERIOD_BYTES_MAX)
+		return XST_INVALID_PARAM;
+
+	FrameBytes = hw_params->active_ch *
+		XAudioFormatterRingSampleBytes(hw_params->bits_per_sample);
+	if (hw_params->bytes_per_period %
+		XAudioFormatterRingPeriodAlign(FrameBytes) != 0)
+		return XST_INVALID_PARAM;
+
+	memset(RingPtr, 0, sizeof(XAudioFormatter_Ring));
+	RingPtr->InstancePtr = InstancePtr;
+	RingPtr->ChannelId = ChannelId;
+	RingPtr->HwParams = *hw_params;
+	RingPtr->Buf = (u8 *)(UINTPTR)hw_params->buf_addr;
+
+	if (ChannelId == XAudioFormatter_MM2S) {
+		memset(RingPtr->Buf, 0,
+			hw_params->periods * hw_params->bytes_per_period);
+		Xil_DCacheFlushRange((INTPTR)RingPtr->Buf,
+			hw_params->periods * hw_params->bytes_per_period);
+		XAudioFormatter_SetMM2SCallback(InstancePtr,
+			XAudioFormatter_IOC_Handler,
+			(void *)XAudioFormatterRingIOCHandler, RingPtr);
+	} else {
+		XAudioFormatter_SetS2MMCallback(InstancePtr,
+			XAudioFormatter_IOC_Handler,
+			(void *)XAudioFormatterRingIOCHandler, RingPtr);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the time stamp source of the period completions, e.g. a
+* wrapper around XTime_GetTime(). Without it, the time stamps are 0.
+*
+* @param	RingPtr is a pointer to the ring.
+* @param	TimeFunc is the time stamp source.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XAudioFormatterRingSetTimeFunc(XAudioFormatter_Ring *RingPtr,
+	XAudioFormatter_TimeFunc TimeFunc)
+{
+	Xil_AssertVoid(RingPtr != NULL);
+
+	RingPtr->TimeFunc = TimeFunc;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the callback called from the interrupt handler on every
+* period completion, with the hardware position and its time stamp.
+*
+* @param	RingPtr is a pointer to the ring.
+* @param	CallbackFunc is the callback, NULL to remove it.
+* @param	CallbackRef is passed to the callback.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XAudioFormatterRingSetPeriodCallback(XAudioFormatter_Ring *RingPtr,
+	XAudioFormatter_PeriodCallback CallbackFunc, void *CallbackRef)
+{
+	Xil_AssertVoid(RingPtr != NULL);
+
+	RingPtr->PeriodCallback = CallbackFunc;
+	RingPtr->PeriodCallbackRef = CallbackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the callback called from the interrupt handler when a
+* period underruns (MM2S) or overruns (S2MM), with the xrun count.
+*
+* @param	RingPtr is a pointer to the ring.
+* @param	CallbackFunc is the callback, NULL to remove it.
+* @param	CallbackRef is passed to the callback.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XAudioFormatterRingSetXrunCallback(XAudioFormatter_Ring *RingPtr,
+	XAudioFormatter_XrunCallback CallbackFunc, void *CallbackRef)
+{
+	Xil_AssertVoid(RingPtr != NULL);
+
+	RingPtr->XrunCallback = CallbackFunc;
+	RingPtr->XrunCallbackRef = CallbackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function starts the ring from its first period. The channel is reset
+* and programmed, and the IOC and error interrupts are enabled. The DMA then
+* runs until XAudioFormatterRingStop(), whatever the application does.
+*
+* @param	RingPtr is a pointer to the ring.
+*
+* @return	None.
+*
+* @note		The interrupt enables of the channel are reset too.
+*
+******************************************************************************/
+void XAudioFormatterRingStart(XAudioFormatter_Ring *RingPtr)
+{
+	XAudioFormatter *InstancePtr;
+
+	Xil_AssertVoid(RingPtr != NULL);
+	Xil_AssertVoid(RingPtr->InstancePtr != NULL);
+
+	InstancePtr = RingPtr->InstancePtr;
+	InstancePtr->ChannelId = RingPtr->ChannelId;
+	XAudioFormatterDMAReset(InstancePtr);
+	XAudioFormatterSetHwParams(InstancePtr, &RingPtr->HwParams);
+
+	RingPtr->HwPos = 0;
+	RingPtr->Timestamp = 0;
+	RingPtr->Xruns = 0;
+	if (RingPtr->ChannelId == XAudioFormatter_S2MM)
+		RingPtr->AppPos = 0;
+	RingPtr->Running = TRUE;
+
+	XAudioFormatter_InterruptEnable(InstancePtr,
+		XAUD_CTRL_IOC_IRQ_MASK | XAUD_CTRL_ERR_IRQ_MASK);
+	XAudioFormatterDMAStart(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stops the ring. Queued MM2S periods are dropped.
+*
+* @param	RingPtr is a pointer to the ring.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XAudioFormatterRingStop(XAudioFormatter_Ring *RingPtr)
+{
+	XAudioFormatter *InstancePtr;
+
+	Xil_AssertVoid(RingPtr != NULL);
+	Xil_AssertVoid(RingPtr->InstancePtr != NULL);
+
+	InstancePtr = RingPtr->InstancePtr;
+	InstancePtr->ChannelId = RingPtr->ChannelId;
+	XAudioFormatterDMAStop(InstancePtr);
+	XAudioFormatter_InterruptDisable(InstancePtr,
+		XAUD_CTRL_IOC_IRQ_MASK | XAUD_CTRL_ERR_IRQ_MASK);
+
+	RingPtr->Running = FALSE;
+	RingPtr->AppPos = 0;
+	RingPtr->HwPos = 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the number of periods the application can write
+* (MM2S) or read (S2MM). The application position is resynchronized first if
+* the core has overtaken it.
+*
+* @param	RingPtr is a pointer to the ring.
+*
+* @return	Number of periods available to the application.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XAudioFormatterRingAvail(XAudioFormatter_Ring *RingPtr)
+{
+	u32 HwPos;
+	u32 Periods;
+
+	Xil_AssertNonvoid(RingPtr != NULL);
+
+	HwPos = RingPtr->HwPos;
+	Periods = RingPtr->HwParams.periods;
+
+	if (RingPtr->ChannelId == XAudioFormatter_MM2S) {
+		if (RingPtr->Running && (s32)(RingPtr->AppPos - HwPos) <= 0)
+			RingPtr->AppPos = HwPos + 1;
+		return Periods - (RingPtr->AppPos - HwPos);
+	}
+
+	if (HwPos - RingPtr->AppPos >= Periods)
+		RingPtr->AppPos = HwPos - Periods + 1;
+	return HwPos - RingPtr->AppPos;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the next period for the application to fill (MM2S)
+* or read (S2MM). S2MM periods are invalidated from the data cache.
+*
+* @param	RingPtr is a pointer to the ring.
+*
+* @return	Pointer to the period, or NULL if none is available.
+*
+* @note		None.
+*
+******************************************************************************/
+u8 *XAudioFormatterRingGetPeriod(XAudioFormatter_Ring *RingPtr)
+{
+	u8 *Period;
+	u32 Bytes;
+
+	Xil_AssertNonvoid(RingPtr != NULL);
+
+	if (XAudioFormatterRingAvail(RingPtr) == 0)
+		return NULL;
+
+	Bytes = RingPtr->HwParams.bytes_per_period;
+	Period = RingPtr->Buf +
+		(RingPtr->AppPos % RingPtr->HwParams.periods) * Bytes;
+	if (RingPtr->ChannelId == XAudioFormatter_S2MM)
+		Xil_DCacheInvalidateRange((INTPTR)Period, Bytes);
+
+	return Period;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function hands the period returned by XAudioFormatterRingGetPeriod()
+* back: queued to the core (MM2S, flushed from the data cache) or released
+* for capture (S2MM).
+*
+* @param	RingPtr is a pointer to the ring.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XAudioFormatterRingAdvance(XAudioFormatter_Ring *RingPtr)
+{
+	u32 Bytes;
+
+	Xil_AssertVoid(RingPtr != NULL);
+
+	if (RingPtr->ChannelId == XAudioFormatter_MM2S) {
+		Bytes = RingPtr->HwParams.bytes_per_period;
+		Xil_DCacheFlushRange((INTPTR)(RingPtr->Buf +
+			(RingPtr->AppPos % RingPtr->HwParams.periods) * Bytes),
+			Bytes);
+	}
+	RingPtr->AppPos++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the hardware position and the time stamp of its last
+* period completion, read consistently with the interrupt handler.
+*
+* @param	RingPtr is a pointer to the ring.
+* @param	TimestampPtr is where the time stamp is stored, may be NULL.
+*
+* @return	Number of periods completed by the core since the start.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XAudioFormatterRingGetPosition(XAudioFormatter_Ring *RingPtr,
+	u64 *TimestampPtr)
+{
+	u32 HwPos;
+	u64 Timestamp;
+
+	Xil_AssertNonvoid(RingPtr != NULL);
+
+	do {
+		HwPos = RingPtr->HwPos;
+		Timestamp = RingPtr->Timestamp;
+	} while (HwPos != RingPtr->HwPos);
+
+	if (TimestampPtr != NULL)
+		*TimestampPtr = Timestamp;
+
+	return HwPos;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the IOC callback of a ring channel. It advances the
+* hardware position, silences the next MM2S period on underrun and counts
+* the xruns.
+*
+* @param	CallbackRef is a pointer to the ring.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XAudioFormatterRingIOCHandler(void *CallbackRef)
+{
+	XAudioFormatter_Ring *RingPtr = (XAudioFormatter_Ring *)CallbackRef;
+	u32 Periods = RingPtr->HwParams.periods;
+	u32 Bytes = RingPtr->HwParams.bytes_per_period;
+	u32 AppPos = RingPtr->AppPos;
+	u32 HwPos;
+	u64 Timestamp = 0;
+	u8 *Period;
+	u8 Xrun;
+
+	if (RingPtr->TimeFunc != NULL)
+		Timestamp = RingPtr->TimeFunc();
+	RingPtr->Timestamp = Timestamp;
+	HwPos = RingPtr->HwPos + 1;
+	RingPtr->HwPos = HwPos;
+
+	if (RingPtr->ChannelId == XAudioFormatter_MM2S) {
+		Xrun = (s32)(AppPos - HwPos) <= 0;
+		if (Xrun) {
+			Period = RingPtr->Buf + ((HwPos + 1) % Periods) * Bytes;
+			memset(Period, 0, Bytes);
+			Xil_DCacheFlushRange((INTPTR)Period, Bytes);
+		}
+	} else {
+		Xrun = HwPos - AppPos >= Periods;
+	}
+
+	if (RingPtr->PeriodCallback != NULL)
+		RingPtr->PeriodCallback(RingPtr->PeriodCallbackRef, HwPos,
+			Timestamp);
+	if (Xrun) {
+		RingPtr->Xruns++;
+		if (RingPtr->XrunCallback != NULL)
+			RingPtr->XrunCallback(RingPtr->XrunCallbackRef,
+				RingPtr->Xruns);
+	}
+}
+/** @} */
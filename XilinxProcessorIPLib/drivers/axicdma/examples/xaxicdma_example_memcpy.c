@@ -0,0 +1,248 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+ *
+ * @file xaxicdma_example_memcpy.c
+ *
+ * This file demonstrates how to use the memcpy job queue of the xaxicdma
+ * driver on the Xilinx AXI CDMA core (AXICDMA).
+ *
+ * NUMBER_OF_JOBS copies of different sizes are submitted at once, the queue
+ * packs them into BD chains and completes each chain with one interrupt. The
+ * example polls XAxiCdma_MemcpyIntrHandler() until the fence of the last job
+ * is reached, then checks that every job handler reported success and the
+ * data.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 4.7   adk  10/15/19 First release
+ * </pre>
+ *
+ ****************************************************************************/
+#include "xaxicdma.h"
+#include "xdebug.h"
+#include "xil_cache.h"
+#include "xparameters.h"
+
+#if (!defined(DEBUG))
+extern void xil_printf(const char *format, ...);
+#endif
+
+/******************** Constant Definitions **********************************/
+
+/*
+ * The following constants map to the XPAR parameters created in the
+ * xparameters.h file. They are defined here such that a user can easily
+ * change all the needed parameters in one place.
+ */
+
+#ifndef TESTAPP_GEN
+#define DMA_CTRL_DEVICE_ID	XPAR_AXICDMA_0_DEVICE_ID
+#endif
+
+#define NUMBER_OF_JOBS		24	/* Number of copies to submit */
+
+#define JOB_BYTESIZE		256	/* Size step of the copies */
+
+#define BUFFER_BYTESIZE		(NUMBER_OF_JOBS * NUMBER_OF_JOBS * \
+				 JOB_BYTESIZE)
+
+/************************** Function Prototypes ******************************/
+
+static void JobDone(void *CallBackRef, int Status);
+
+int XAxiCdma_MemcpyExample(u16 DeviceId);
+
+/************************** Variable Definitions *****************************/
+
+static XAxiCdma AxiCdmaInstance;	/* Instance of the XAxiCdma */
+
+static XAxiCdma_Memcpy Memcpy;		/* Memcpy job queue */
+
+/* Source and Destination buffer for DMA transfer.
+ */
+static u8 SrcBuffer[BUFFER_BYTESIZE] __attribute__ ((aligned (64)));
+static u8 DestBuffer[BUFFER_BYTESIZE] __attribute__ ((aligned (64)));
+
+/* Status reported by the job handlers.
+ */
+volatile static int JobStatus[NUMBER_OF_JOBS];
+
+
+/*****************************************************************************/
+/**
+* The entry point for this example. It invokes the example function,
+* and reports the execution status.
+*
+* @param	None.
+*
+* @return
+*		- XST_SUCCESS if example finishes successfully
+*		- XST_FAILURE if example fails.
+*
+* @note		None.
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main()
+{
+	int Status;
+
+	xil_printf("\r\n--- Entering main() --- \r\n");
+
+	Status = XAxiCdma_MemcpyExample(DMA_CTRL_DEVICE_ID);
+
+	if (Status != XST_SUCCESS) {
+		xil_printf("AxiCdma_Memcpy Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran AxiCdma_Memcpy Example\r\n");
+	xil_printf("--- Exiting main() --- \r\n");
+
+	return XST_SUCCESS;
+
+}
+#endif
+
+
+/*****************************************************************************/
+/**
+* The example to copy buffers through the memcpy job queue in polled mode.
+*
+* @param	DeviceId is the Device Id of the XAxiCdma instance
+*
+* @return
+*		- XST_SUCCESS if example finishes successfully
+*		- XST_FAILURE if error occurs
+*
+* @note		If the hardware build has problems, this function hangs.
+*
+******************************************************************************/
+int XAxiCdma_MemcpyExample(u16 DeviceId)
+{
+	XAxiCdma_Config *CfgPtr;
+	XAxiCdma_MemcpyJob Job;
+	u32 Fence;
+	u32 Offset;
+	int Status;
+	int Index;
+
+	/* Initialize the XAxiCdma device.
+	 */
+	CfgPtr = XAxiCdma_LookupConfig(DeviceId);
+	if (!CfgPtr) {
+		return XST_FAILURE;
+	}
+
+	Status = XAxiCdma_CfgInitialize(&AxiCdmaInstance, CfgPtr,
+		CfgPtr->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XAxiCdma_MemcpyInitialize(&Memcpy, &AxiCdmaInstance);
+	if (Status != XST_SUCCESS) {
+		xdbg_printf(XDBG_DEBUG_ERROR,
+			    "Memcpy initialize failed with %d\r\n", Status);
+		return XST_FAILURE;
+	}
+
+	for (Index = 0; Index < BUFFER_BYTESIZE; Index++) {
+		SrcBuffer[Index] = Index & 0xFF;
+		DestBuffer[Index] = 0;
+	}
+
+	/* Submit copies of 1 to NUMBER_OF_JOBS times JOB_BYTESIZE bytes,
+	 * the buffers are flushed by the queue
+	 */
+	Offset = 0;
+	for (Index = 0; Index < NUMBER_OF_JOBS; Index++) {
+		JobStatus[Index] = XST_DEVICE_BUSY;
+
+		Job.SrcAddr = (UINTPTR)&SrcBuffer[Offset];
+		Job.DstAddr = (UINTPTR)&DestBuffer[Offset];
+		Job.Size = (Index + 1) * JOB_BYTESIZE;
+		Job.Handler = JobDone;
+		Job.CallBackRef = (void *)&JobStatus[Index];
+
+		Status = XAxiCdma_MemcpySubmit(&Memcpy, &Job);
+		if (Status != XST_SUCCESS) {
+			xdbg_printf(XDBG_DEBUG_ERROR,
+				    "Submit job %d failed with %d\r\n",
+				    Index, Status);
+			return XST_FAILURE;
+		}
+
+		Offset += Job.Size;
+	}
+
+	/* Wait until the last job is done
+	 */
+	Fence = XAxiCdma_MemcpyGetFence(&Memcpy);
+	while (!XAxiCdma_MemcpyFenceDone(&Memcpy, Fence)) {
+		XAxiCdma_MemcpyIntrHandler(&Memcpy);
+	}
+
+	for (Index = 0; Index < NUMBER_OF_JOBS; Index++) {
+		if (JobStatus[Index] != XST_SUCCESS) {
+			xil_printf("Job %d failed\r\n", Index);
+			return XST_FAILURE;
+		}
+	}
+
+	for (Index = 0; Index < (int)Offset; Index++) {
+		if (DestBuffer[Index] != SrcBuffer[Index]) {
+			xil_printf("Data error %d: %x/%x\r\n", Index,
+				   DestBuffer[Index], SrcBuffer[Index]);
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/*
+* Completion handler of a job, records the job status.
+*
+* @param	CallBackRef is the status entry of the job
+* @param	Status is the job status
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void JobDone(void *CallBackRef, int Status)
+{
+	*(volatile int *)CallBackRef = Status;
+}
@@ -220,6 +220,23 @@
  *
  * </pre>
  *
+ * <b>Memcpy Job Queue</b>
+ *
+ * Applications which only copy buffers can use the memcpy job queue instead
+ * of managing BDs. XAxiCdma_MemcpyInitialize() creates a BD ring inside the
+ * XAxiCdma_Memcpy instance, jobs are queued with XAxiCdma_MemcpySubmit() and
+ * packed into BD chains of up to XAXICDMA_MEMCPY_CHAIN_LEN jobs. The
+ * coalescing counter is set to the BD count of each chain, so a chain
+ * completes with a single interrupt. Completion is reported per job through
+ * a handler, or with fences: XAxiCdma_MemcpyGetFence() after a submission
+ * and XAxiCdma_MemcpyFenceDone() later. The application connects
+ * XAxiCdma_MemcpyIntrHandler() instead of XAxiCdma_IntrHandler(), or calls
+ * it in a loop when interrupts are not used. The queue has exclusive use of
+ * the engine.
+ *
+ * Alternatively XAxiCdma_MemcpySetOffload() registers an engine with
+ * Xil_MemCpy(), which then copies large buffers with polled simple transfers.
+ *
  * <b>Physical/Virtual Addresses</b>
  *
  * Addresses for the transfer buffers are physical addresses.
@@ -336,6 +353,11 @@
  *       ms   04/05/17 Modified Comment lines in functions of axicdma
  *                     examples to recognize it as documentation block
  *                     for doxygen generation of examples.
+ * 4.7   adk  10/15/19 Added the memcpy job queue, XAxiCdma_Memcpy*() APIs in
+ *		       xaxicdma_memcpy.c, which packs copies into BDs and
+ *		       completes them with one interrupt per BD chain.
+ *		       Added XAxiCdma_MemcpySetOffload() which lets
+ *		       Xil_MemCpy() hand large copies to the engine.
  * </pre>
  *****************************************************************************/
 
@@ -378,6 +400,21 @@ extern "C" {
 #define XAXICDMA_KEYHOLE_READ	0
 #define XAXICDMA_KEYHOLE_WRITE	1
 
+/* Memcpy job queue sizes
+ *
+ * A chain of BDs completes with one interrupt, so the number of BDs must not
+ * exceed XAXICDMA_COALESCE_MAX.
+ */
+#ifndef XAXICDMA_MEMCPY_QUEUE_DEPTH
+#define XAXICDMA_MEMCPY_QUEUE_DEPTH	64 /* Queued jobs, power of two */
+#endif
+#ifndef XAXICDMA_MEMCPY_CHAIN_LEN
+#define XAXICDMA_MEMCPY_CHAIN_LEN	16 /* Jobs in one BD chain */
+#endif
+#ifndef XAXICDMA_MEMCPY_NUM_BDS
+#define XAXICDMA_MEMCPY_NUM_BDS		32 /* BDs of the queue */
+#endif
+
 /**************************** Type Definitions *******************************/
 
 /**
@@ -482,6 +519,58 @@ typedef struct {
 }XAxiCdma;
 /* @} */
 
+/**
+ * @name XAxiCdma_MemcpyHandler
+ *
+ * Completion handler of a memcpy job. Status is XST_SUCCESS, or XST_FAILURE
+ * when the engine reported an error for the job or for an earlier job of its
+ * chain.
+ */
+typedef void (*XAxiCdma_MemcpyHandler)(void *CallBackRef, int Status);
+
+/**
+ * @name XAxiCdma_MemcpyJob
+ *
+ * A job of the memcpy queue
+ *
+ * @{
+ */
+typedef struct {
+	UINTPTR DstAddr;                /**< Destination address */
+	UINTPTR SrcAddr;                /**< Source address */
+	u32 Size;                       /**< Bytes to copy */
+	XAxiCdma_MemcpyHandler Handler; /**< Called when the copy is done,
+	                                     can be NULL */
+	void *CallBackRef;              /**< Passed to the handler */
+}XAxiCdma_MemcpyJob;
+
+/**
+ * @name XAxiCdma_Memcpy
+ *
+ * The memcpy job queue. It owns the BD ring of the engine.
+ *
+ * @{
+ */
+typedef struct {
+	XAxiCdma_Bd Bds[XAXICDMA_MEMCPY_NUM_BDS]
+	    __attribute__ ((aligned (XAXICDMA_BD_MINIMUM_ALIGNMENT)));
+	                                /**< BD ring */
+	XAxiCdma *Dma;                  /**< Engine instance */
+	u32 PieceLen;                   /**< Bytes copied by one BD */
+	XAxiCdma_MemcpyJob Queue[XAXICDMA_MEMCPY_QUEUE_DEPTH];
+	                                /**< Jobs not started yet */
+	u32 Head;                       /**< Jobs queued so far */
+	u32 Tail;                       /**< Jobs started so far */
+	XAxiCdma_MemcpyJob Jobs[XAXICDMA_MEMCPY_CHAIN_LEN];
+	                                /**< Jobs of the running chain */
+	u32 NumJobs;                    /**< Jobs in the running chain */
+	u32 DoneJobs;                   /**< Jobs of the chain completed */
+	u32 BdsLeft;                    /**< BDs of the oldest running job
+	                                     not completed yet */
+	u32 Completed;                  /**< Jobs completed so far */
+	u32 Locked;                     /**< Nesting count of the queue lock */
+}XAxiCdma_Memcpy;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -571,6 +660,18 @@ void XAxiCdma_BdSetTailBdPtr(XAxiCdma *InstancePtr, UINTPTR TailBdPtr);
  */
 void XAxiCdma_DumpRegisters(XAxiCdma *InstancePtr);
 
+/* Memcpy job queue functions in xaxicdma_memcpy.c
+ */
+int XAxiCdma_MemcpyInitialize(XAxiCdma_Memcpy *MemcpyPtr,
+	XAxiCdma *InstancePtr);
+int XAxiCdma_MemcpySubmit(XAxiCdma_Memcpy *MemcpyPtr,
+	XAxiCdma_MemcpyJob *JobPtr);
+u32 XAxiCdma_MemcpyPending(XAxiCdma_Memcpy *MemcpyPtr);
+u32 XAxiCdma_MemcpyGetFence(XAxiCdma_Memcpy *MemcpyPtr);
+int XAxiCdma_MemcpyFenceDone(XAxiCdma_Memcpy *MemcpyPtr, u32 Fence);
+void XAxiCdma_MemcpyIntrHandler(void *HandlerRef);
+void XAxiCdma_MemcpySetOffload(XAxiCdma *InstancePtr, u32 Threshold);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,690 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *  @file xaxicdma_memcpy.c
+* @addtogroup axicdma_v4_6
+* @{
+ *
+ * The implementation of the memcpy job queue.
+ *
+ * Jobs are queued with XAxiCdma_MemcpySubmit(). When the engine is idle the
+ * queued jobs are packed into one BD chain of up to XAXICDMA_MEMCPY_CHAIN_LEN
+ * jobs, a job longer than the maximum transfer length of the engine takes
+ * several BDs. The coalescing threshold is set to the BD count of the chain,
+ * so the chain completes with one interrupt. The handler of every job is
+ * then called, the completed count used by the fences is updated and the BDs
+ * are reused for the next chain.
+ *
+ * The queue replaces XAxiCdma_IntrHandler(), which keeps one handler entry
+ * per BD set and resets the engine after calling it. On an error the queue
+ * resets the engine itself, creates the BD ring again and fails the jobs
+ * left in the chain. Job handlers run in the context of
+ * XAxiCdma_MemcpyIntrHandler() and may submit new jobs.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 4.7   adk  10/15/19 First release
+ *                     Added XAxiCdma_MemcpySetOffload().
+ * </pre>
+ *
+ *****************************************************************************/
+#include "xaxicdma.h"
+#include "xaxicdma_i.h"
+#include "xil_cache.h"
+#include "xil_mem.h"
+
+#if (XAXICDMA_MEMCPY_NUM_BDS > XAXICDMA_COALESCE_MAX)
+#error "XAXICDMA_MEMCPY_NUM_BDS exceeds the coalescing threshold range"
+#endif
+
+#if ((XAXICDMA_MEMCPY_QUEUE_DEPTH & (XAXICDMA_MEMCPY_QUEUE_DEPTH - 1)) != 0)
+#error "XAXICDMA_MEMCPY_QUEUE_DEPTH must be a power of two"
+#endif
+
+/************************** Function Prototypes ******************************/
+
+static u32 XAxiCdma_MemcpyBdCount(XAxiCdma_Memcpy *MemcpyPtr, u32 Size);
+static void XAxiCdma_MemcpyLock(XAxiCdma_Memcpy *MemcpyPtr);
+static void XAxiCdma_MemcpyUnlock(XAxiCdma_Memcpy *MemcpyPtr);
+static void XAxiCdma_MemcpyDispatch(XAxiCdma_Memcpy *MemcpyPtr);
+static int XAxiCdma_MemcpyStartChain(XAxiCdma_Memcpy *MemcpyPtr, u32 NumBds);
+static void XAxiCdma_MemcpyComplete(XAxiCdma_Memcpy *MemcpyPtr, int Status);
+static void XAxiCdma_MemcpyRecover(XAxiCdma_Memcpy *MemcpyPtr);
+static s32 XAxiCdma_MemcpyOffload(void *Dst, const void *Src, u32 Cnt);
+
+/************************** Variable Definitions *****************************/
+
+static XAxiCdma *OffloadInstPtr;
+
+/*****************************************************************************/
+/**
+ * This function initializes a memcpy job queue on an engine. It creates the
+ * BD ring of the engine over the BDs of the queue, so the engine must be idle
+ * and must not be used through the other transfer APIs afterwards.
+ *
+ * @param	MemcpyPtr is the memcpy job queue to initialize
+ * @param	InstancePtr is the initialized driver instance of the engine
+ *
+ * @return
+ *		- XST_SUCCESS for success
+ *		- XST_FAILURE if the hardware is simple mode only, or the
+ *		driver instance is not in working state
+ *		- XST_INVALID_PARAM or XST_DMA_SG_LIST_ERROR if the BD ring
+ *		cannot be created
+ *
+ * @note	None.
+ *
+ *****************************************************************************/
+int XAxiCdma_MemcpyInitialize(XAxiCdma_Memcpy *MemcpyPtr,
+	XAxiCdma *InstancePtr)
+{
+	int Status;
+
+	Xil_AssertNonvoid(MemcpyPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	if ((!InstancePtr->Initialized) || (InstancePtr->SimpleOnlyBuild)) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "MemcpyInitialize: driver "
+			"instance not in valid state or simple only build\r\n");
+		return XST_FAILURE;
+	}
+
+	MemcpyPtr->Dma = InstancePtr;
+	MemcpyPtr->PieceLen = InstancePtr->MaxTransLen &
+		~((u32)InstancePtr->WordLength - 1);
+	MemcpyPtr->Head = 0;
+	MemcpyPtr->Tail = 0;
+	MemcpyPtr->NumJobs = 0;
+	MemcpyPtr->DoneJobs = 0;
+	MemcpyPtr->BdsLeft = 0;
+	MemcpyPtr->Completed = 0;
+	MemcpyPtr->Locked = 0;
+
+	Status = XAxiCdma_BdRingCreate(InstancePtr, (UINTPTR)MemcpyPtr->Bds,
+		(UINTPTR)MemcpyPtr->Bds, XAXICDMA_BD_MINIMUM_ALIGNMENT,
+		XAXICDMA_MEMCPY_NUM_BDS);
+	if (Status != XST_SUCCESS) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "MemcpyInitialize: BD ring "
+			"create failed %d\r\n", Status);
+		return Status;
+	}
+
+	XAxiCdma_IntrDisable(InstancePtr, XAXICDMA_XR_IRQ_ALL_MASK);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * This function queues a memcpy job. The job is copied, so the caller may
+ * reuse it on return. The source and destination buffers are flushed from the
+ * data cache here, the destination is invalidated again before the handler
+ * of the job is called.
+ *
+ * @param	MemcpyPtr is the memcpy job queue
+ * @param	JobPtr is the job to queue
+ *
+ * @return
+ *		- XST_SUCCESS for success
+ *		- XST_INVALID_PARAM if the size is 0, the job needs more than
+ *		XAXICDMA_MEMCPY_NUM_BDS BDs, or the addresses are not aligned
+ *		to the data width and the hardware has no DRE
+ *		- XST_DEVICE_BUSY if the queue is full
+ *		- XST_FAILURE if the driver instance is not in working state
+ *
+ * @note	The fence of the job is returned by XAxiCdma_MemcpyGetFence()
+ *		right after this call.
+ *
+ *****************************************************************************/
+int XAxiCdma_MemcpySubmit(XAxiCdma_Memcpy *MemcpyPtr,
+	XAxiCdma_MemcpyJob *JobPtr)
+{
+	XAxiCdma *InstancePtr;
+	int Status;
+
+	Xil_AssertNonvoid(MemcpyPtr != NULL);
+	Xil_AssertNonvoid(JobPtr != NULL);
+
+	InstancePtr = MemcpyPtr->Dma;
+
+	if ((JobPtr->Size == 0) ||
+	    (XAxiCdma_MemcpyBdCount(MemcpyPtr, JobPtr->Size) >
+	     XAXICDMA_MEMCPY_NUM_BDS)) {
+		return XST_INVALID_PARAM;
+	}
+
+	if ((!InstancePtr->HasDRE) &&
+	    ((JobPtr->SrcAddr | JobPtr->DstAddr) &
+	     (UINTPTR)(InstancePtr->WordLength - 1))) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "MemcpySubmit: unaligned "
+			"transfer without DRE\r\n");
+		return XST_INVALID_PARAM;
+	}
+
+	if (!InstancePtr->Initialized) {
+		return XST_FAILURE;
+	}
+
+	Xil_DCacheFlushRange(JobPtr->SrcAddr, JobPtr->Size);
+	Xil_DCacheFlushRange(JobPtr->DstAddr, JobPtr->Size);
+
+	XAxiCdma_MemcpyLock(MemcpyPtr);
+
+	if ((MemcpyPtr->Head - MemcpyPtr->Tail) ==
+	    XAXICDMA_MEMCPY_QUEUE_DEPTH) {
+		Status = XST_DEVICE_BUSY;
+	}
+	else {
+		MemcpyPtr->Queue[MemcpyPtr->Head &
+			(XAXICDMA_MEMCPY_QUEUE_DEPTH - 1)] = *JobPtr;
+		MemcpyPtr->Head++;
+		Status = XST_SUCCESS;
+	}
+
+	XAxiCdma_MemcpyUnlock(MemcpyPtr);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function returns the number of jobs queued or running.
+ *
+ * @param	MemcpyPtr is the memcpy job queue
+ *
+ * @return	The number of jobs not completed yet
+ *
+ * @note	None.
+ *
+ *****************************************************************************/
+u32 XAxiCdma_MemcpyPending(XAxiCdma_Memcpy *MemcpyPtr)
+{
+	u32 Pending;
+
+	Xil_AssertNonvoid(MemcpyPtr != NULL);
+
+	XAxiCdma_MemcpyLock(MemcpyPtr);
+	Pending = (MemcpyPtr->Head - MemcpyPtr->Tail) +
+		(MemcpyPtr->NumJobs - MemcpyPtr->DoneJobs);
+	XAxiCdma_MemcpyUnlock(MemcpyPtr);
+
+	return Pending;
+}
+
+/*****************************************************************************/
+/**
+ * This function returns the fence of the last job submitted. Jobs complete in
+ * submission order, so the fence is reached once that job and all the jobs
+ * submitted before it are done.
+ *
+ * @param	MemcpyPtr is the memcpy job queue
+ *
+ * @return	The fence value, to pass to XAxiCdma_MemcpyFenceDone()
+ *
+ * @note	None.
+ *
+ *****************************************************************************/
+u32 XAxiCdma_MemcpyGetFence(XAxiCdma_Memcpy *MemcpyPtr)
+{
+	Xil_AssertNonvoid(MemcpyPtr != NULL);
+
+	return MemcpyPtr->Head;
+}
+
+/*****************************************************************************/
+/**
+ * This function checks whether a fence has been reached.
+ *
+ * @param	MemcpyPtr is the memcpy job queue
+ * @param	Fence is a value returned by XAxiCdma_MemcpyGetFence()
+ *
+ * @return
+ *		- 1 if all the jobs up to the fence are done or failed
+ *		- 0 otherwise
+ *
+ * @note	The check wraps around, fences older than 2^31 jobs are not
+ *		valid.
+ *
+ *****************************************************************************/
+int XAxiCdma_MemcpyFenceDone(XAxiCdma_Memcpy *MemcpyPtr, u32 Fence)
+{
+	Xil_AssertNonvoid(MemcpyPtr != NULL);
+
+	return ((s32)(MemcpyPtr->Completed - Fence) >= 0) ? 1 : 0;
+}
+
+/*****************************************************************************/
+/**
+ * This function is the interrupt handler of the memcpy job queue. The
+ * application connects it to the interrupt controller with the memcpy job
+ * queue as the reference, instead of XAxiCdma_IntrHandler(). The interrupt
+ * status bits are set even when the interrupts are disabled, so without an
+ * interrupt controller the application polls by calling it in a loop.
+ *
+ * The jobs whose BDs are done are completed, then the next chain is started.
+ *
+ * @param	HandlerRef is the memcpy job queue
+ *
+ * @return	None
+ *
+ * @note	None.
+ *
+ *****************************************************************************/
+void XAxiCdma_MemcpyIntrHandler(void *HandlerRef)
+{
+	XAxiCdma_Memcpy *MemcpyPtr;
+	XAxiCdma *InstancePtr;
+	XAxiCdma_Bd *BdPtr;
+	XAxiCdma_Bd *CurBdPtr;
+	u32 Status;
+	u32 Irq;
+	u32 NumBds;
+	u32 DoneBds;
+	u32 Count;
+	int Error;
+
+	MemcpyPtr = (XAxiCdma_Memcpy *)HandlerRef;
+	InstancePtr = MemcpyPtr->Dma;
+
+	Status = XAxiCdma_ReadReg(InstancePtr->BaseAddr, XAXICDMA_SR_OFFSET);
+	Irq = Status & XAXICDMA_XR_IRQ_ALL_MASK;
+
+	if (Irq == 0x0) {
+		return;
+	}
+
+	/* Acknowledge the interrupt
+	 */
+	XAxiCdma_WriteReg(InstancePtr->BaseAddr, XAXICDMA_SR_OFFSET, Irq);
+
+	XAxiCdma_MemcpyLock(MemcpyPtr);
+
+	Error = ((Irq & XAXICDMA_XR_IRQ_ERROR_MASK) &&
+		(Status & XAXICDMA_SR_ERR_ALL_MASK)) ? 1 : 0;
+
+	/* Count the BDs done without error, up to the first failed one
+	 */
+	NumBds = XAxiCdma_BdRingFromHw(InstancePtr, XAXICDMA_ALL_BDS, &BdPtr);
+	DoneBds = 0;
+	CurBdPtr = BdPtr;
+
+	while (DoneBds < NumBds) {
+		if (XAxiCdma_BdGetSts(CurBdPtr) &
+		    XAXICDMA_BD_STS_ALL_ERR_MASK) {
+			Error = 1;
+			break;
+		}
+
+		DoneBds++;
+		CurBdPtr = XAxiCdma_BdRingNext(InstancePtr, CurBdPtr);
+	}
+
+	if (NumBds > 0) {
+		XAxiCdma_BdRingFree(InstancePtr, NumBds, BdPtr);
+	}
+
+	/* Complete the jobs all of whose BDs are done
+	 */
+	while ((DoneBds > 0) && (MemcpyPtr->DoneJobs < MemcpyPtr->NumJobs)) {
+		if (MemcpyPtr->BdsLeft == 0) {
+			MemcpyPtr->BdsLeft = XAxiCdma_MemcpyBdCount(MemcpyPtr,
+				MemcpyPtr->Jobs[MemcpyPtr->DoneJobs].Size);
+		}
+
+		Count = (DoneBds < MemcpyPtr->BdsLeft) ?
+			DoneBds : MemcpyPtr->BdsLeft;
+		MemcpyPtr->BdsLeft -= Count;
+		DoneBds -= Count;
+
+		if (MemcpyPtr->BdsLeft == 0) {
+			XAxiCdma_MemcpyComplete(MemcpyPtr, XST_SUCCESS);
+		}
+	}
+
+	if (Error) {
+		XAxiCdma_MemcpyRecover(MemcpyPtr);
+	}
+
+	if (MemcpyPtr->DoneJobs == MemcpyPtr->NumJobs) {
+		MemcpyPtr->NumJobs = 0;
+		MemcpyPtr->DoneJobs = 0;
+	}
+
+	XAxiCdma_MemcpyUnlock(MemcpyPtr);
+}
+
+/*****************************************************************************/
+/**
+ * This function makes Xil_MemCpy() hand copies of at least Threshold bytes
+ * to the engine as polled simple transfers. Copies the engine cannot take,
+ * for example unaligned buffers without DRE or a busy engine, and copies
+ * which fail are done by the CPU. The data cache is flushed and invalidated
+ * over both buffers around every transfer.
+ *
+ * On soft processors a threshold of a few hundred bytes usually pays off,
+ * smaller copies are faster through the cache.
+ *
+ * @param	InstancePtr is the initialized driver instance of the engine,
+ *		NULL disables the offload
+ * @param	Threshold is the smallest copy in bytes given to the engine
+ *
+ * @return	None.
+ *
+ * @note	The engine must be used in polled mode, and must not be used
+ *		by the memcpy job queue. Xil_MemCpy() calls from interrupt
+ *		context must not race with the same engine.
+ *
+ *****************************************************************************/
+void XAxiCdma_MemcpySetOffload(XAxiCdma *InstancePtr, u32 Threshold)
+{
+	if (InstancePtr == NULL) {
+		Xil_MemCpySetOffload(NULL, 0U);
+		OffloadInstPtr = NULL;
+		return;
+	}
+
+	Xil_AssertVoid(InstancePtr->Initialized);
+
+	OffloadInstPtr = InstancePtr;
+	Xil_MemCpySetOffload(XAxiCdma_MemcpyOffload, Threshold);
+}
+
+/*****************************************************************************/
+/*
+ * Return the number of BDs a copy of Size bytes takes.
+ *
+ *****************************************************************************/
+static u32 XAxiCdma_MemcpyBdCount(XAxiCdma_Memcpy *MemcpyPtr, u32 Size)
+{
+	return (Size + MemcpyPtr->PieceLen - 1) / MemcpyPtr->PieceLen;
+}
+
+/*****************************************************************************/
+/*
+ * Take the queue lock by disabling the engine interrupts. The lock nests, the
+ * handler of a job may submit jobs.
+ *
+ *****************************************************************************/
+static void XAxiCdma_MemcpyLock(XAxiCdma_Memcpy *MemcpyPtr)
+{
+	MemcpyPtr->Locked++;
+
+	XAxiCdma_IntrDisable(MemcpyPtr->Dma, XAXICDMA_XR_IRQ_ALL_MASK);
+}
+
+/*****************************************************************************/
+/*
+ * Release the queue lock. The outermost release starts the next chain when
+ * the engine is idle, and enables the interrupts while a chain is running.
+ *
+ *****************************************************************************/
+static void XAxiCdma_MemcpyUnlock(XAxiCdma_Memcpy *MemcpyPtr)
+{
+	if (MemcpyPtr->Locked > 1) {
+		MemcpyPtr->Locked--;
+		return;
+	}
+
+	XAxiCdma_MemcpyDispatch(MemcpyPtr);
+	MemcpyPtr->Locked = 0;
+
+	if (MemcpyPtr->NumJobs != 0) {
+		XAxiCdma_IntrEnable(MemcpyPtr->Dma,
+			XAXICDMA_XR_IRQ_IOC_MASK | XAXICDMA_XR_IRQ_ERROR_MASK);
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Move queued jobs to a new chain and start it, when no chain is running.
+ *
+ *****************************************************************************/
+static void XAxiCdma_MemcpyDispatch(XAxiCdma_Memcpy *MemcpyPtr)
+{
+	XAxiCdma_MemcpyJob *JobPtr;
+	u32 NumBds;
+	u32 JobBds;
+
+	while ((MemcpyPtr->NumJobs == 0) &&
+	       (MemcpyPtr->Head != MemcpyPtr->Tail)) {
+		NumBds = 0;
+
+		while ((MemcpyPtr->Head != MemcpyPtr->Tail) &&
+		       (MemcpyPtr->NumJobs < XAXICDMA_MEMCPY_CHAIN_LEN)) {
+			JobPtr = &MemcpyPtr->Queue[MemcpyPtr->Tail &
+				(XAXICDMA_MEMCPY_QUEUE_DEPTH - 1)];
+			JobBds = XAxiCdma_MemcpyBdCount(MemcpyPtr,
+				JobPtr->Size);
+
+			if ((NumBds + JobBds) > XAXICDMA_MEMCPY_NUM_BDS) {
+				break;
+			}
+
+			MemcpyPtr->Jobs[MemcpyPtr->NumJobs] = *JobPtr;
+			MemcpyPtr->NumJobs++;
+			MemcpyPtr->Tail++;
+			NumBds += JobBds;
+		}
+
+		MemcpyPtr->DoneJobs = 0;
+		MemcpyPtr->BdsLeft = 0;
+
+		/* A chain which cannot be started fails all its jobs, then
+		 * the next jobs are tried
+		 */
+		if (XAxiCdma_MemcpyStartChain(MemcpyPtr, NumBds) !=
+		    XST_SUCCESS) {
+			while (MemcpyPtr->DoneJobs < MemcpyPtr->NumJobs) {
+				XAxiCdma_MemcpyComplete(MemcpyPtr,
+					XST_FAILURE);
+			}
+
+			MemcpyPtr->NumJobs = 0;
+		}
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Fill NumBds BDs with the jobs of the chain and pass them to the hardware.
+ *
+ *****************************************************************************/
+static int XAxiCdma_MemcpyStartChain(XAxiCdma_Memcpy *MemcpyPtr, u32 NumBds)
+{
+	XAxiCdma *InstancePtr;
+	XAxiCdma_MemcpyJob *JobPtr;
+	XAxiCdma_Bd *BdSetPtr;
+	XAxiCdma_Bd *BdPtr;
+	UINTPTR Offset;
+	u32 Len;
+	u32 Index;
+	int Status;
+
+	InstancePtr = MemcpyPtr->Dma;
+
+	/* One interrupt for the whole chain
+	 */
+	Status = XAxiCdma_SetCoalesce(InstancePtr, NumBds,
+		XAXICDMA_COALESCE_NO_CHANGE);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Status = XAxiCdma_BdRingAlloc(InstancePtr, NumBds, &BdSetPtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	BdPtr = BdSetPtr;
+
+	for (Index = 0; Index < MemcpyPtr->NumJobs; Index++) {
+		JobPtr = &MemcpyPtr->Jobs[Index];
+
+		for (Offset = 0; Offset < JobPtr->Size; Offset += Len) {
+			Len = JobPtr->Size - Offset;
+			if (Len > MemcpyPtr->PieceLen) {
+				Len = MemcpyPtr->PieceLen;
+			}
+
+			XAxiCdma_BdSetSrcBufAddr(BdPtr,
+				JobPtr->SrcAddr + Offset);
+			XAxiCdma_BdSetDstBufAddr(BdPtr,
+				JobPtr->DstAddr + Offset);
+			XAxiCdma_BdSetLength(BdPtr, Len);
+
+			BdPtr = XAxiCdma_BdRingNext(InstancePtr, BdPtr);
+		}
+	}
+
+	Status = XAxiCdma_BdRingToHw(InstancePtr, NumBds, BdSetPtr, NULL,
+		NULL);
+	if (Status != XST_SUCCESS) {
+		XAxiCdma_BdRingUnAlloc(InstancePtr, NumBds, BdSetPtr);
+		return Status;
+	}
+
+	/* The queue tracks the chain itself, drop the handler entry
+	 */
+	InstancePtr->SgHandlerHead = InstancePtr->SgHandlerTail;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/*
+ * Complete the oldest job of the running chain.
+ *
+ *****************************************************************************/
+static void XAxiCdma_MemcpyComplete(XAxiCdma_Memcpy *MemcpyPtr, int Status)
+{
+	XAxiCdma_MemcpyJob *JobPtr;
+
+	JobPtr = &MemcpyPtr->Jobs[MemcpyPtr->DoneJobs];
+	MemcpyPtr->DoneJobs++;
+	MemcpyPtr->Completed++;
+
+	if (Status == XST_SUCCESS) {
+		Xil_DCacheInvalidateRange(JobPtr->DstAddr, JobPtr->Size);
+	}
+
+	if (JobPtr->Handler != NULL) {
+		JobPtr->Handler(JobPtr->CallBackRef, Status);
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Reset the engine after an error, create the BD ring again and fail the
+ * jobs left in the chain.
+ *
+ *****************************************************************************/
+static void XAxiCdma_MemcpyRecover(XAxiCdma_Memcpy *MemcpyPtr)
+{
+	XAxiCdma *InstancePtr;
+	int TimeOut;
+
+	InstancePtr = MemcpyPtr->Dma;
+	TimeOut = XAXICDMA_RESET_LOOP_LIMIT;
+
+	XAxiCdma_Reset(InstancePtr);
+
+	while (TimeOut) {
+		if (XAxiCdma_ResetIsDone(InstancePtr)) {
+			break;
+		}
+
+		TimeOut -= 1;
+	}
+
+	if (!TimeOut) {
+		/* Mark the driver/engine is not in working state
+		 */
+		InstancePtr->Initialized = 0;
+	}
+	else {
+		XAxiCdma_BdRingCreate(InstancePtr, (UINTPTR)MemcpyPtr->Bds,
+			(UINTPTR)MemcpyPtr->Bds, XAXICDMA_BD_MINIMUM_ALIGNMENT,
+			XAXICDMA_MEMCPY_NUM_BDS);
+	}
+
+	MemcpyPtr->BdsLeft = 0;
+
+	while (MemcpyPtr->DoneJobs < MemcpyPtr->NumJobs) {
+		XAxiCdma_MemcpyComplete(MemcpyPtr, XST_FAILURE);
+	}
+}
+/*****************************************************************************/
+/*
+ * Copy Cnt bytes with a polled simple transfer, the offload function given to
+ * Xil_MemCpySetOffload(). The engine is reset when the transfer fails.
+ *
+ *****************************************************************************/
+static s32 XAxiCdma_MemcpyOffload(void *Dst, const void *Src, u32 Cnt)
+{
+	XAxiCdma *InstancePtr = OffloadInstPtr;
+	int TimeOut;
+
+	if ((InstancePtr == NULL) || (Cnt > XAXICDMA_MAX_TRANSFER_LEN)) {
+		return XST_FAILURE;
+	}
+
+	Xil_DCacheFlushRange((UINTPTR)Src, Cnt);
+	Xil_DCacheFlushRange((UINTPTR)Dst, Cnt);
+
+	if (XAxiCdma_SimpleTransfer(InstancePtr, (UINTPTR)Src, (UINTPTR)Dst,
+				    (int)Cnt, NULL, NULL) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	while (XAxiCdma_IsBusy(InstancePtr)) {
+		/* Wait */
+	}
+
+	Xil_DCacheInvalidateRange((UINTPTR)Dst, Cnt);
+
+	if (XAxiCdma_GetError(InstancePtr) != 0x0) {
+		TimeOut = XAXICDMA_RESET_LOOP_LIMIT;
+
+		XAxiCdma_Reset(InstancePtr);
+
+		while (TimeOut) {
+			if (XAxiCdma_ResetIsDone(InstancePtr)) {
+				break;
+			}
+
+			TimeOut -= 1;
+		}
+
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+/** @} */
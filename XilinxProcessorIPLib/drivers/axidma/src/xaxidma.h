@@ -182,6 +182,18 @@
 *   -----   XAxiDma_Pause() or XAxiDma_Reset()                 ------
 * </pre>
 *
+* <b>Single Producer/Single Consumer Rings</b>
+*
+* The regular BD ring functions share counters between the submission and
+* the completion side, so all of them must run under one lock (usually with
+* interrupts disabled). A ring can instead be driven through
+* XAxiDma_BdRingSpscAlloc()/XAxiDma_BdRingSpscToHw() on a producer context and
+* XAxiDma_BdRingSpscFromHw()/XAxiDma_BdRingSpscFree() on a consumer context,
+* for example submission on one A53 core and completion on another. Each side
+* only writes its own counters and publishes them to the other side with
+* release/acquire ordering, so no lock is needed between the two. See
+* XAxiDma_BdRingSpscAlloc() for the rules.
+*
 * <b>Interrupt Coalescing</b>
 *
 * SGDMA provides control over the frequency of interrupts through interrupt
@@ -196,6 +208,15 @@
 *   and no new packets to process. Note that the interrupt will only fire if
 *   at least one packet has been processed.
 *
+* Instead of a fixed setting the driver can retune both values at run time.
+* XAxiDma_BdRingSetAdaptCoalesce() takes lower and upper bounds for the
+* counter and the timer, and XAxiDma_BdRingAdaptCoalesceSample(), called by
+* the application once per fixed period (for example from a timer tick),
+* measures how many BDs completed in the period and reprograms the channel:
+* at light load the lower bounds are used so that each packet is signalled
+* quickly, under bursts the counter grows so that about TargetIrqs interrupts
+* fire per period and the timer grows with it.
+*
 * <b> Interrupt </b>
 *
 * Interrupts are handled by the user application. Each DMA channel has its own
@@ -471,6 +492,8 @@
 * 9.6  rsp   01/11/18 Fixed CR#976392 In XAxiDma struct use UINTPTR for RegBase.
 *                     In XAxiDma_LookupConfigBaseAddr() use UINTPTR for Baseaddr.
 * 9.7  rsp   04/25/18 Add SgLengthWidth member in dma config structure. CR #1000474
+* 9.10 rsp   06/14/19 Add single producer/single consumer BD ring APIs.
+*      rsp   06/20/19 Add adaptive interrupt coalescing controller.
 * </pre>
 *
 ******************************************************************************/
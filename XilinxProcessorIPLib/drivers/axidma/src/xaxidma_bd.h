@@ -96,6 +96,8 @@
  * 8.0   srt  01/29/14 Added support for Micro DMA Mode.
  * 9.2   vak  15/04/16 Fixed compilation warnings in axidma driver
  * 9.8   rsp  07/11/18 Fix cppcheck portability warnings. CR #1006164
+ * 9.10  rsp  10/14/19 Add XAXIDMA_CACHE_BATCH_* macros to flush a set of BDs
+ *                     as one data cache batch on 32-bit ARM.
  *
  * </pre>
  *****************************************************************************/
@@ -113,6 +115,9 @@ extern "C" {
 #include "xstatus.h"
 #include "xdebug.h"
 #include "xil_cache.h"
+#if defined (__arm__) && !defined (__aarch64__)
+#include "xil_cache_batch.h"
+#endif
 
 #ifdef __MICROBLAZE__
 #include "xenv.h"
@@ -148,6 +153,25 @@ typedef u32 XAxiDma_Bd[XAXIDMA_BD_NUM_WORDS];
 	Xil_DCacheInvalidateRange((UINTPTR)(BdPtr), XAXIDMA_BD_HW_NUM_BYTES)
 #endif
 
+/******************************************************************************
+ * On 32-bit ARM a set of BDs is flushed as one data cache batch: the BDs of a
+ * set are contiguous, so their lines merge into one range that completes
+ * with a single dsb.
+ *****************************************************************************/
+#if defined (__arm__) && !defined (__aarch64__)
+#define XAXIDMA_CACHE_BATCH
+#define XAXIDMA_CACHE_BATCH_INIT(Batch) \
+	Xil_DCacheBatchInit(&(Batch), XIL_DCACHE_BATCH_FLUSH)
+#define XAXIDMA_CACHE_BATCH_FLUSH(Batch, BdPtr) \
+	Xil_DCacheBatchAdd(&(Batch), (INTPTR)(BdPtr), XAXIDMA_BD_HW_NUM_BYTES)
+#define XAXIDMA_CACHE_BATCH_COMMIT(Batch) \
+	Xil_DCacheBatchCommit(&(Batch))
+#else
+#define XAXIDMA_CACHE_BATCH_INIT(Batch)
+#define XAXIDMA_CACHE_BATCH_FLUSH(Batch, BdPtr) XAXIDMA_CACHE_FLUSH(BdPtr)
+#define XAXIDMA_CACHE_BATCH_COMMIT(Batch)
+#endif
+
 /*****************************************************************************/
 /**
 *
@@ -64,6 +64,15 @@
 *       rsp  01/17/18  Use virtual address for register read/write.
 *                      In _BdRingCreate() assign VA to BdaRestart CR#976392
 * 9.9   rsp  02/05/19  Fix XAxiDma_BdRingFromHw implementation for cyclic mode.
+* 9.10  rsp  06/14/19  Add single producer/single consumer ring APIs
+*                      XAxiDma_BdRingSpscAlloc(), XAxiDma_BdRingSpscToHw(),
+*                      XAxiDma_BdRingSpscFromHw(), XAxiDma_BdRingSpscFree()
+*                      and XAxiDma_BdRingSpscGetFreeCnt().
+*       rsp  06/20/19  Add adaptive interrupt coalescing controller
+*                      XAxiDma_BdRingSetAdaptCoalesce() and
+*                      XAxiDma_BdRingAdaptCoalesceSample().
+*       rsp  10/14/19  Flush the BDs of a set as one data cache batch in
+*                      XAxiDma_BdRingPrepareBds() on 32-bit ARM.
 *
 * </pre>
 ******************************************************************************/
@@ -100,6 +109,34 @@
 #define XAXIDMA_VIRT_TO_PHYS(BdPtr) \
 	((UINTPTR)(BdPtr) + (RingPtr->FirstBdPhysAddr - RingPtr->FirstBdAddr))
 
+/******************************************************************************
+ * Load/store a single producer/single consumer ring counter with acquire/
+ * release ordering. The store orders all earlier memory accesses (BD updates
+ * and cache maintenance) before the counter update; the load orders all later
+ * accesses after it.
+ *
+ * @param	Ptr is the address of the counter
+ * @param	Val is the value to store
+ *
+ *****************************************************************************/
+#if defined (__GNUC__)
+#define XAXIDMA_SPSC_LOAD_ACQUIRE(Ptr) \
+	__atomic_load_n((Ptr), __ATOMIC_ACQUIRE)
+#define XAXIDMA_SPSC_STORE_RELEASE(Ptr, Val) \
+	__atomic_store_n((Ptr), (Val), __ATOMIC_RELEASE)
+#else
+static inline u32 XAxiDma_SpscLoadAcquire(volatile u32 *Ptr)
+{
+	u32 Val = *Ptr;
+
+	DATA_SYNC;
+	return Val;
+}
+#define XAXIDMA_SPSC_LOAD_ACQUIRE(Ptr)	XAxiDma_SpscLoadAcquire(Ptr)
+#define XAXIDMA_SPSC_STORE_RELEASE(Ptr, Val) \
+	{ DATA_SYNC; *(Ptr) = (Val); }
+#endif
+
 /******************************************************************************
  * Move the BdPtr argument ahead an arbitrary number of BDs wrapping around
  * to the beginning of the ring if needed.
@@ -468,6 +505,12 @@ u32 XAxiDma_BdRingCreate(XAxiDma_BdRing *RingPtr, UINTPTR PhysAddr,
 	RingPtr->HwTail = (XAxiDma_Bd *) VirtAddr;
 	RingPtr->PostHead = (XAxiDma_Bd *) VirtAddr;
 	RingPtr->BdaRestart = (XAxiDma_Bd *) VirtAddr;
+	RingPtr->SpscAllocTotal = 0;
+	RingPtr->SpscHwTotal = 0;
+	RingPtr->SpscPostTotal = 0;
+	RingPtr->SpscFreeTotal = 0;
+	RingPtr->DoneTotal = 0;
+	memset(&RingPtr->Adapt, 0, sizeof(XAxiDma_AdaptCoalesce));
 	RingPtr->CyclicBd = (XAxiDma_Bd *) malloc(sizeof(XAxiDma_Bd));
 
 	return XST_SUCCESS;
@@ -590,9 +633,10 @@ int XAxiDma_StartBdRingHw(XAxiDma_BdRing * RingPtr)
 		RingPtr->RunState = AXIDMA_CHANNEL_NOT_HALTED;
 
 		/* If there are unprocessed BDs then we want the channel to begin
-		 * processing right away
+		 * processing right away. Rings used through the Spsc APIs do
+		 * not maintain HwCnt, kick them once anything was submitted.
 		 */
-		if (RingPtr->HwCnt > 0) {
+		if ((RingPtr->HwCnt > 0) || (RingPtr->SpscHwTotal != 0)) {
 
 			XAXIDMA_CACHE_INVALIDATE(RingPtr->HwTail);
 			if (RingPtr->Cyclic) {
@@ -743,6 +787,141 @@ int XAxiDma_BdRingSetCoalesce(XAxiDma_BdRing *RingPtr, u32 Counter, u32 Timer)
 
 	return XST_SUCCESS;
 }
+/*****************************************************************************/
+/**
+ * Enable or disable adaptive interrupt coalescing on a descriptor ring.
+ *
+ * In adaptive mode the packet threshold counter and the delay timer are
+ * retuned by XAxiDma_BdRingAdaptCoalesceSample(), which the application calls
+ * once per sample period of its choosing. Each sample the number of BDs
+ * retrieved with XAxiDma_BdRingFromHw() (or XAxiDma_BdRingSpscFromHw()) in the
+ * period is averaged and the counter is set to that rate divided by
+ * CfgPtr->TargetIrqs, clamped to [MinCounter, MaxCounter]. The timer is
+ * scaled linearly between MinTimer and MaxTimer along with the counter, so
+ * the tail of a burst is still signalled within a bounded delay.
+ *
+ * The lower bounds are programmed immediately. Disabling leaves the last
+ * programmed values in place; they can be overridden with
+ * XAxiDma_BdRingSetCoalesce().
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	CfgPtr points to the bounds to use, or NULL to disable
+ *		adaptive mode. The bounds are copied.
+ *
+ * @return
+ *		- XST_SUCCESS if adaptive mode was enabled or disabled
+ *		- XST_INVALID_PARAM if a bound is out of range or
+ *		TargetIrqs is 0
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingSetAdaptCoalesce(XAxiDma_BdRing * RingPtr,
+	XAxiDma_AdaptCoalesceCfg *CfgPtr)
+{
+	XAxiDma_AdaptCoalesce *AdaptPtr = &RingPtr->Adapt;
+
+	if (CfgPtr == NULL) {
+		AdaptPtr->IsEnabled = 0;
+
+		return XST_SUCCESS;
+	}
+
+	if ((CfgPtr->MinCounter == 0) ||
+	    (CfgPtr->MinCounter > CfgPtr->MaxCounter) ||
+	    (CfgPtr->MaxCounter > 0xFF) ||
+	    (CfgPtr->MinTimer > CfgPtr->MaxTimer) ||
+	    (CfgPtr->MaxTimer > 0xFF) || (CfgPtr->TargetIrqs == 0)) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingSetAdaptCoalesce: "
+			"invalid bounds\r\n");
+
+		return XST_INVALID_PARAM;
+	}
+
+	AdaptPtr->Cfg = *CfgPtr;
+	AdaptPtr->LastDoneTotal = RingPtr->DoneTotal;
+	AdaptPtr->AvgRate = 0;
+	AdaptPtr->Counter = CfgPtr->MinCounter;
+	AdaptPtr->Timer = CfgPtr->MinTimer;
+
+	(void)XAxiDma_BdRingSetCoalesce(RingPtr, AdaptPtr->Counter,
+					AdaptPtr->Timer);
+
+	AdaptPtr->IsEnabled = 1;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Take one sample for the adaptive interrupt coalescing controller and
+ * reprogram the channel if the computed setting changed. Call this once per
+ * sample period from the same context that calls XAxiDma_BdRingFromHw(), or
+ * with that context locked out.
+ *
+ * The rate is smoothed over about four periods, so a single idle or busy
+ * period does not make the setting oscillate.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ *
+ * @return
+ *		- XST_SUCCESS if the sample was taken
+ *		- XST_FAILURE if adaptive mode is not enabled on the ring
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingAdaptCoalesceSample(XAxiDma_BdRing * RingPtr)
+{
+	XAxiDma_AdaptCoalesce *AdaptPtr = &RingPtr->Adapt;
+	XAxiDma_AdaptCoalesceCfg *CfgPtr = &AdaptPtr->Cfg;
+	u32 Done;
+	u32 Counter;
+	u32 Timer;
+
+	if (!AdaptPtr->IsEnabled) {
+		return XST_FAILURE;
+	}
+
+	Done = RingPtr->DoneTotal - AdaptPtr->LastDoneTotal;
+	AdaptPtr->LastDoneTotal = RingPtr->DoneTotal;
+
+	/* Saturate so the fixed point average cannot overflow */
+	if (Done > 0x00FFFFFF) {
+		Done = 0x00FFFFFF;
+	}
+
+	/* Exponential average with weight 1/4, 3 fraction bits */
+	AdaptPtr->AvgRate = AdaptPtr->AvgRate - (AdaptPtr->AvgRate >> 2) +
+				((Done << 3) >> 2);
+
+	Counter = (AdaptPtr->AvgRate >> 3) / CfgPtr->TargetIrqs;
+	if (Counter < CfgPtr->MinCounter) {
+		Counter = CfgPtr->MinCounter;
+	}
+	else if (Counter > CfgPtr->MaxCounter) {
+		Counter = CfgPtr->MaxCounter;
+	}
+
+	Timer = CfgPtr->MinTimer;
+	if (CfgPtr->MaxCounter != CfgPtr->MinCounter) {
+		Timer += ((CfgPtr->MaxTimer - CfgPtr->MinTimer) *
+			  (Counter - CfgPtr->MinCounter)) /
+			 (CfgPtr->MaxCounter - CfgPtr->MinCounter);
+	}
+
+	if ((Counter != AdaptPtr->Counter) || (Timer != AdaptPtr->Timer)) {
+		AdaptPtr->Counter = Counter;
+		AdaptPtr->Timer = Timer;
+		(void)XAxiDma_BdRingSetCoalesce(RingPtr, Counter, Timer);
+	}
+
+	return XST_SUCCESS;
+}
+
 /*****************************************************************************/
 /**
  * Retrieve current interrupt coalescing parameters from the given descriptor
@@ -982,71 +1161,42 @@ int XAxiDma_BdRingUnAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
 
 	return XST_SUCCESS;
 }
-/*****************************************************************************/
-/**
- * Enqueue a set of BDs to hardware that were previously allocated by
- * XAxiDma_BdRingAlloc(). Once this function returns, the argument BD set goes
- * under hardware control. Changes to these BDs should be held until they are
- * finished by hardware to avoid data corruption and system instability.
- *
- * For transmit, the set will be rejected if the last BD of the set does not
- * mark the end of a packet or the first BD does not mark the start of a packet.
+/******************************************************************************
+ * Check a set of BDs allocated with XAxiDma_BdRingAlloc() before it is given
+ * to hardware, clear the completed bit of each BD and flush the BDs from the
+ * data cache.
  *
  * @param	RingPtr is a pointer to the descriptor ring instance to be
  *		worked on.
- * @param	NumBd is the number of BDs in the set.
- * @param	BdSetPtr is the first BD of the set to commit to hardware.
+ * @param	NumBd is the number of BDs in the set, must be positive.
+ * @param	BdSetPtr is the first BD of the set.
+ * @param	LastBdPtr is an output parameter, it points to the last BD of
+ *		the set.
  *
  * @return
- *		- XST_SUCCESS if the set of BDs was accepted and enqueued to
- *		hardware
- *		- XST_INVALID_PARAM if passed in NumBd is negative
- *		- XST_FAILURE if the set of BDs was rejected because the first
- *		BD does not have its start-of-packet bit set, or the last BD
- *		does not have its end-of-packet bit set, or any one of the BDs
- *		has 0 length.
- *		- XST_DMA_SG_LIST_ERROR if this function was called out of
- *		sequence with XAxiDma_BdRingAlloc()
- *
- * @note	This function should not be preempted by another XAxiDma ring
- *		function call that modifies the BD space. It is the caller's
- *		responsibility to provide a mutual exclusion mechanism.
+ *		- XST_SUCCESS if the set can be given to hardware
+ *		- XST_FAILURE if the first BD does not have its start-of-packet
+ *		bit set, the last BD does not have its end-of-packet bit set,
+ *		or any one of the BDs has 0 length.
  *
- *		This function can be used only when DMA is in SG mode
+ * @note	This function can be used only when DMA is in SG mode
  *
  *****************************************************************************/
-int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
-	XAxiDma_Bd * BdSetPtr)
+static int XAxiDma_BdRingPrepareBds(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd * BdSetPtr, XAxiDma_Bd ** LastBdPtr)
 {
 	XAxiDma_Bd *CurBdPtr;
 	int i;
 	u32 BdCr;
 	u32 BdSts;
-	int RingIndex = RingPtr->RingIndex;
-
-	if (NumBd < 0) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingToHw: negative BD number "
-			"%d\r\n", NumBd);
-
-		return XST_INVALID_PARAM;
-	}
-
-	/* If the commit set is empty, do nothing */
-	if (NumBd == 0) {
-		return XST_SUCCESS;
-	}
-
-	/* Make sure we are in sync with XAxiDma_BdRingAlloc() */
-	if ((RingPtr->PreCnt < NumBd) || (RingPtr->PreHead != BdSetPtr)) {
-
-		xdbg_printf(XDBG_DEBUG_ERROR, "Bd ring has problems\r\n");
-		return XST_DMA_SG_LIST_ERROR;
-	}
+#ifdef XAXIDMA_CACHE_BATCH
+	Xil_DCacheBatch Batch;
+#endif
 
 	CurBdPtr = BdSetPtr;
 	BdCr = XAxiDma_BdGetCtrl(CurBdPtr);
 	BdSts = XAxiDma_BdGetSts(CurBdPtr);
+	XAXIDMA_CACHE_BATCH_INIT(Batch);
 
 	/* In case of Tx channel, the first BD should have been marked
 	 * as start-of-frame
@@ -1076,7 +1226,7 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 		XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET, BdSts);
 
 		/* Flush the current BD so DMA core could see the updates */
-		XAXIDMA_CACHE_FLUSH(CurBdPtr);
+		XAXIDMA_CACHE_BATCH_FLUSH(Batch, CurBdPtr);
 
 		CurBdPtr = (XAxiDma_Bd *)((void *)XAxiDma_BdRingNext(RingPtr, CurBdPtr));
 		BdCr = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_CTRL_LEN_OFFSET);
@@ -1106,19 +1256,34 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 	BdSts &= ~XAXIDMA_BD_STS_COMPLETE_MASK;
 	XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET, BdSts);
 
-	/* Flush the last BD so DMA core could see the updates */
-	XAXIDMA_CACHE_FLUSH(CurBdPtr);
+	/* Flush the last BD so DMA core could see the updates, the commit
+	 * completes the flush of the whole set
+	 */
+	XAXIDMA_CACHE_BATCH_FLUSH(Batch, CurBdPtr);
+	XAXIDMA_CACHE_BATCH_COMMIT(Batch);
 	DATA_SYNC;
 
-	/* This set has completed pre-processing, adjust ring pointers and
-	 * counters
-	 */
-	XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->PreHead, NumBd);
-	RingPtr->PreCnt -= NumBd;
-	RingPtr->HwTail = CurBdPtr;
-	RingPtr->HwCnt += NumBd;
+	*LastBdPtr = CurBdPtr;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************
+ * Signal a running channel that BDs up to RingPtr->HwTail are ready to be
+ * processed by writing the tail descriptor register.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ *
+ * @returns	None
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+static void XAxiDma_BdRingWriteTail(XAxiDma_BdRing * RingPtr)
+{
+	int RingIndex = RingPtr->RingIndex;
 
-	/* If it is running, signal the engine to begin processing */
 	if (RingPtr->RunState == AXIDMA_CHANNEL_NOT_HALTED) {
 			if (RingPtr->Cyclic) {
 				XAxiDma_WriteReg(RingPtr->ChanBase,
@@ -1128,7 +1293,7 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 					XAxiDma_WriteReg(RingPtr->ChanBase,
 							 XAXIDMA_TDESC_MSB_OFFSET,
 							 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->CyclicBd)));
-				return XST_SUCCESS;
+				return;
 			}
 
 			if (RingPtr->IsRxChannel) {
@@ -1159,115 +1324,123 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 								UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
 			}
 	}
-
-	return XST_SUCCESS;
 }
 
 /*****************************************************************************/
 /**
- * Returns a set of BD(s) that have been processed by hardware. The returned
- * BDs may be examined by the application to determine the outcome of the DMA
- * transactions. Once the BDs have been examined, the application must call
- * XAxiDma_BdRingFree() in the same order which they were retrieved here.
- *
- * Example:
- *
- * <pre>
- *        NumBd = XAxiDma_BdRingFromHw(MyRingPtr, XAXIDMA_ALL_BDS, &MyBdSet);
- *
- *        if (NumBd == 0)
- *        {
- *           // hardware has nothing ready for us yet
- *        }
- *
- *        CurBd = MyBdSet;
- *        for (i=0; i<NumBd; i++)
- *        {
- *           // Examine CurBd for post processing.....
- *
- *           // Onto next BD
- *           CurBd = XAxiDma_BdRingNext(MyRingPtr, CurBd);
- *        }
- *
- *        XAxiDma_BdRingFree(MyRingPtr, NumBd, MyBdSet); // Return the list
- * </pre>
- *
- * A more advanced use of this function may allocate multiple sets of BDs.
- * They must be retrieved from hardware and freed in the correct sequence:
- * <pre>
- *        // Legal
- *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd1, &MySet1);
- *        XAxiDma_BdRingFree(MyRingPtr, NumBd1, MySet1);
- *
- *        // Legal
- *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd1, &MySet1);
- *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd2, &MySet2);
- *        XAxiDma_BdRingFree(MyRingPtr, NumBd1, MySet1);
- *        XAxiDma_BdRingFree(MyRingPtr, NumBd2, MySet2);
- *
- *        // Not legal
- *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd1, &MySet1);
- *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd2, &MySet2);
- *        XAxiDma_BdRingFree(MyRingPtr, NumBd2, MySet2);
- *        XAxiDma_BdRingFree(MyRingPtr, NumBd1, MySet1);
- * </pre>
+ * Enqueue a set of BDs to hardware that were previously allocated by
+ * XAxiDma_BdRingAlloc(). Once this function returns, the argument BD set goes
+ * under hardware control. Changes to these BDs should be held until they are
+ * finished by hardware to avoid data corruption and system instability.
  *
- * If hardware has partially completed a packet spanning multiple BDs, then
- * none of the BDs for that packet will be included in the results.
+ * For transmit, the set will be rejected if the last BD of the set does not
+ * mark the end of a packet or the first BD does not mark the start of a packet.
  *
  * @param	RingPtr is a pointer to the descriptor ring instance to be
  *		worked on.
- * @param	BdLimit is the maximum number of BDs to return in the set. Use
- *		XAXIDMA_ALL_BDS to return all BDs that have been processed.
- * @param	BdSetPtr is an output parameter, it points to the first BD
- *		available for examination.
- *
- * @return	The number of BDs processed by hardware. A value of 0 indicates
- *		that no data is available. No more than BdLimit BDs will be
- *		returned.
+ * @param	NumBd is the number of BDs in the set.
+ * @param	BdSetPtr is the first BD of the set to commit to hardware.
  *
- * @note	Treat BDs returned by this function as read-only.
+ * @return
+ *		- XST_SUCCESS if the set of BDs was accepted and enqueued to
+ *		hardware
+ *		- XST_INVALID_PARAM if passed in NumBd is negative
+ *		- XST_FAILURE if the set of BDs was rejected because the first
+ *		BD does not have its start-of-packet bit set, or the last BD
+ *		does not have its end-of-packet bit set, or any one of the BDs
+ *		has 0 length.
+ *		- XST_DMA_SG_LIST_ERROR if this function was called out of
+ *		sequence with XAxiDma_BdRingAlloc()
  *
- * 		This function should not be preempted by another XAxiDma ring
+ * @note	This function should not be preempted by another XAxiDma ring
  *		function call that modifies the BD space. It is the caller's
  *		responsibility to provide a mutual exclusion mechanism.
  *
  *		This function can be used only when DMA is in SG mode
  *
  *****************************************************************************/
-int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
-			     XAxiDma_Bd ** BdSetPtr)
+int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd * BdSetPtr)
 {
 	XAxiDma_Bd *CurBdPtr;
-	int BdCount;
-	int BdPartialCount;
-	u32 BdSts;
-	u32 BdCr;
+	int Status;
 
-	CurBdPtr = RingPtr->HwHead;
-	BdCount = 0;
-	BdPartialCount = 0;
-	BdSts = 0;
-	BdCr = 0;
+	if (NumBd < 0) {
 
-	/* If no BDs in work group, then there's nothing to search */
-	if (RingPtr->HwCnt == 0) {
-		*BdSetPtr = (XAxiDma_Bd *)NULL;
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingToHw: negative BD number "
+			"%d\r\n", NumBd);
 
-		return 0;
+		return XST_INVALID_PARAM;
 	}
 
-	if (BdLimit > RingPtr->HwCnt) {
-		BdLimit = RingPtr->HwCnt;
+	/* If the commit set is empty, do nothing */
+	if (NumBd == 0) {
+		return XST_SUCCESS;
 	}
 
-	/* Starting at HwHead, keep moving forward in the list until:
-	 *  - A BD is encountered with its completed bit clear in the status
-	 *    word which means hardware has not completed processing of that
-	 *    BD.
-	 *  - RingPtr->HwTail is reached
-	 *  - The number of requested BDs has been processed
-	 */
+	/* Make sure we are in sync with XAxiDma_BdRingAlloc() */
+	if ((RingPtr->PreCnt < NumBd) || (RingPtr->PreHead != BdSetPtr)) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "Bd ring has problems\r\n");
+		return XST_DMA_SG_LIST_ERROR;
+	}
+
+	Status = XAxiDma_BdRingPrepareBds(RingPtr, NumBd, BdSetPtr, &CurBdPtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	/* This set has completed pre-processing, adjust ring pointers and
+	 * counters
+	 */
+	XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->PreHead, NumBd);
+	RingPtr->PreCnt -= NumBd;
+	RingPtr->HwTail = CurBdPtr;
+	RingPtr->HwCnt += NumBd;
+
+	/* If it is running, signal the engine to begin processing */
+	XAxiDma_BdRingWriteTail(RingPtr);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************
+ * Count the BDs, starting at RingPtr->HwHead, that hardware has completed.
+ * BDs of a packet that hardware has only partially completed are not
+ * counted.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	BdLimit is the maximum number of BDs to examine, it must not be
+ *		larger than the number of BDs in the work group.
+ * @param	StopBdPtr is the last BD to examine, NULL to examine BdLimit
+ *		BDs.
+ *
+ * @returns	The number of completed BDs.
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+static int XAxiDma_BdRingCountDone(XAxiDma_BdRing * RingPtr, int BdLimit,
+	XAxiDma_Bd * StopBdPtr)
+{
+	XAxiDma_Bd *CurBdPtr;
+	int BdCount;
+	int BdPartialCount;
+	u32 BdSts;
+	u32 BdCr;
+
+	CurBdPtr = RingPtr->HwHead;
+	BdCount = 0;
+	BdPartialCount = 0;
+
+	/* Starting at HwHead, keep moving forward in the list until:
+	 *  - A BD is encountered with its completed bit clear in the status
+	 *    word which means hardware has not completed processing of that
+	 *    BD.
+	 *  - StopBdPtr is reached
+	 *  - The number of requested BDs has been processed
+	 */
 
 	while (BdCount < BdLimit) {
 		/* Read the status */
@@ -1309,7 +1482,7 @@ int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 		}
 
 		/* Reached the end of the work group */
-		if (CurBdPtr == RingPtr->HwTail) {
+		if (CurBdPtr == StopBdPtr) {
 			break;
 		}
 
@@ -1320,6 +1493,99 @@ int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 	/* Subtract off any partial packet BDs found */
 	BdCount -= BdPartialCount;
 
+	return BdCount;
+}
+
+/*****************************************************************************/
+/**
+ * Returns a set of BD(s) that have been processed by hardware. The returned
+ * BDs may be examined by the application to determine the outcome of the DMA
+ * transactions. Once the BDs have been examined, the application must call
+ * XAxiDma_BdRingFree() in the same order which they were retrieved here.
+ *
+ * Example:
+ *
+ * <pre>
+ *        NumBd = XAxiDma_BdRingFromHw(MyRingPtr, XAXIDMA_ALL_BDS, &MyBdSet);
+ *
+ *        if (NumBd == 0)
+ *        {
+ *           // hardware has nothing ready for us yet
+ *        }
+ *
+ *        CurBd = MyBdSet;
+ *        for (i=0; i<NumBd; i++)
+ *        {
+ *           // Examine CurBd for post processing.....
+ *
+ *           // Onto next BD
+ *           CurBd = XAxiDma_BdRingNext(MyRingPtr, CurBd);
+ *        }
+ *
+ *        XAxiDma_BdRingFree(MyRingPtr, NumBd, MyBdSet); // Return the list
+ * </pre>
+ *
+ * A more advanced use of this function may allocate multiple sets of BDs.
+ * They must be retrieved from hardware and freed in the correct sequence:
+ * <pre>
+ *        // Legal
+ *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd1, &MySet1);
+ *        XAxiDma_BdRingFree(MyRingPtr, NumBd1, MySet1);
+ *
+ *        // Legal
+ *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd1, &MySet1);
+ *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd2, &MySet2);
+ *        XAxiDma_BdRingFree(MyRingPtr, NumBd1, MySet1);
+ *        XAxiDma_BdRingFree(MyRingPtr, NumBd2, MySet2);
+ *
+ *        // Not legal
+ *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd1, &MySet1);
+ *        XAxiDma_BdRingFromHw(MyRingPtr, NumBd2, &MySet2);
+ *        XAxiDma_BdRingFree(MyRingPtr, NumBd2, MySet2);
+ *        XAxiDma_BdRingFree(MyRingPtr, NumBd1, MySet1);
+ * </pre>
+ *
+ * If hardware has partially completed a packet spanning multiple BDs, then
+ * none of the BDs for that packet will be included in the results.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	BdLimit is the maximum number of BDs to return in the set. Use
+ *		XAXIDMA_ALL_BDS to return all BDs that have been processed.
+ * @param	BdSetPtr is an output parameter, it points to the first BD
+ *		available for examination.
+ *
+ * @return	The number of BDs processed by hardware. A value of 0 indicates
+ *		that no data is available. No more than BdLimit BDs will be
+ *		returned.
+ *
+ * @note	Treat BDs returned by this function as read-only.
+ *
+ * 		This function should not be preempted by another XAxiDma ring
+ *		function call that modifies the BD space. It is the caller's
+ *		responsibility to provide a mutual exclusion mechanism.
+ *
+ *		This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
+			     XAxiDma_Bd ** BdSetPtr)
+{
+	int BdCount;
+
+	/* If no BDs in work group, then there's nothing to search */
+	if (RingPtr->HwCnt == 0) {
+		*BdSetPtr = (XAxiDma_Bd *)NULL;
+
+		return 0;
+	}
+
+	if (BdLimit > RingPtr->HwCnt) {
+		BdLimit = RingPtr->HwCnt;
+	}
+
+	BdCount = XAxiDma_BdRingCountDone(RingPtr, BdLimit, RingPtr->HwTail);
+
 	/* If BdCount is non-zero then BDs were found to return. Set return
 	 * parameters, update pointers and counters, return success
 	 */
@@ -1329,6 +1595,7 @@ int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 			RingPtr->HwCnt -= BdCount;
 			RingPtr->PostCnt += BdCount;
 		}
+		RingPtr->DoneTotal += (u32)BdCount;
 		XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->HwHead, BdCount);
 
 		return BdCount;
@@ -1400,6 +1667,279 @@ int XAxiDma_BdRingFree(XAxiDma_BdRing * RingPtr, int NumBd,
 	return XST_SUCCESS;
 }
 /*****************************************************************************/
+/**
+ * Single producer/single consumer variant of XAxiDma_BdRingAlloc().
+ *
+ * The XAxiDma_BdRingSpsc functions let one context (the producer) own the
+ * submission side of a ring, XAxiDma_BdRingSpscAlloc() and
+ * XAxiDma_BdRingSpscToHw(), while another context
+ * (the consumer), possibly running on another core, owns the completion side,
+ * XAxiDma_BdRingSpscFromHw() and XAxiDma_BdRingSpscFree(). The two sides share
+ * no counter that both of them write: the producer publishes the number of BDs
+ * given to hardware and the consumer publishes the number of BDs freed, each
+ * with release ordering, and each side reads the other's counter with acquire
+ * ordering. No lock and no interrupt masking is needed between the two
+ * contexts; calls on the same side must still be serialized by the caller.
+ *
+ * A ring must be driven either entirely through the Spsc functions or
+ * entirely through the regular ones. XAxiDma_BdRingGetFreeCnt() and the
+ * HwCnt/FreeCnt members are not maintained in Spsc mode, use
+ * XAxiDma_BdRingSpscGetFreeCnt() instead. Cyclic mode is not supported.
+ *
+ * When the two contexts run on different cores their caches must be
+ * coherent (inner shareable memory on A53/A72) for the counters themselves;
+ * BD cache maintenance is done by the functions as in regular mode.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	NumBd is the number of BDs to allocate
+ * @param	BdSetPtr is an output parameter, it points to the first BD
+ *		available for modification.
+ *
+ * @return
+ *		- XST_SUCCESS if the requested number of BDs were returned in
+ *		the BdSetPtr parameter.
+ *		- XST_INVALID_PARAM if passed in NumBd is not positive
+ *		- XST_FAILURE if there were not enough free BDs to satisfy
+ *		the request.
+ *
+ * @note	Producer side. This function can be used only when DMA is in SG
+ *		mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingSpscAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd ** BdSetPtr)
+{
+	if (NumBd <= 0) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingSpscAlloc: negative BD "
+				"number %d\r\n", NumBd);
+
+		return XST_INVALID_PARAM;
+	}
+
+	/* Enough free BDs available for the request? */
+	if (XAxiDma_BdRingSpscGetFreeCnt(RingPtr) < NumBd) {
+		xdbg_printf(XDBG_DEBUG_ERROR,
+		"Not enough BDs to alloc %d\r\n", NumBd);
+
+		return XST_FAILURE;
+	}
+
+	/* Set the return argument and move FreeHead forward */
+	*BdSetPtr = RingPtr->FreeHead;
+	XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->FreeHead, NumBd);
+	RingPtr->SpscAllocTotal += (u32)NumBd;
+	RingPtr->PreCnt += NumBd;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Single producer/single consumer variant of XAxiDma_BdRingToHw(). See
+ * XAxiDma_BdRingSpscAlloc() for the usage model.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	NumBd is the number of BDs in the set.
+ * @param	BdSetPtr is the first BD of the set to commit to hardware.
+ *
+ * @return
+ *		- XST_SUCCESS if the set of BDs was accepted and enqueued to
+ *		hardware
+ *		- XST_INVALID_PARAM if passed in NumBd is negative
+ *		- XST_FAILURE if the set of BDs was rejected because the first
+ *		BD does not have its start-of-packet bit set, or the last BD
+ *		does not have its end-of-packet bit set, or any one of the BDs
+ *		has 0 length.
+ *		- XST_DMA_SG_LIST_ERROR if this function was called out of
+ *		sequence with XAxiDma_BdRingSpscAlloc()
+ *
+ * @note	Producer side. This function can be used only when DMA is in SG
+ *		mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingSpscToHw(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd * BdSetPtr)
+{
+	XAxiDma_Bd *CurBdPtr;
+	int Status;
+
+	if (NumBd < 0) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingSpscToHw: negative BD "
+			"number %d\r\n", NumBd);
+
+		return XST_INVALID_PARAM;
+	}
+
+	/* If the commit set is empty, do nothing */
+	if (NumBd == 0) {
+		return XST_SUCCESS;
+	}
+
+	/* Make sure we are in sync with XAxiDma_BdRingSpscAlloc() */
+	if ((RingPtr->PreCnt < NumBd) || (RingPtr->PreHead != BdSetPtr) ||
+	    (RingPtr->Cyclic)) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "Bd ring has problems\r\n");
+		return XST_DMA_SG_LIST_ERROR;
+	}
+
+	Status = XAxiDma_BdRingPrepareBds(RingPtr, NumBd, BdSetPtr, &CurBdPtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->PreHead, NumBd);
+	RingPtr->PreCnt -= NumBd;
+	RingPtr->HwTail = CurBdPtr;
+
+	/* Publish the BDs to the consumer side */
+	XAXIDMA_SPSC_STORE_RELEASE(&RingPtr->SpscHwTotal,
+				   RingPtr->SpscHwTotal + (u32)NumBd);
+
+	/* If it is running, signal the engine to begin processing */
+	XAxiDma_BdRingWriteTail(RingPtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Single producer/single consumer variant of XAxiDma_BdRingFromHw(). See
+ * XAxiDma_BdRingSpscAlloc() for the usage model.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	BdLimit is the maximum number of BDs to return in the set. Use
+ *		XAXIDMA_ALL_BDS to return all BDs that have been processed.
+ * @param	BdSetPtr is an output parameter, it points to the first BD
+ *		available for examination.
+ *
+ * @return	The number of BDs processed by hardware. A value of 0 indicates
+ *		that no data is available. No more than BdLimit BDs will be
+ *		returned.
+ *
+ * @note	Consumer side. Treat BDs returned by this function as read-only.
+ *
+ *		This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingSpscFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
+	XAxiDma_Bd ** BdSetPtr)
+{
+	int HwCnt;
+	int BdCount;
+
+	/* BDs given to hardware and not yet retrieved */
+	HwCnt = (int)(XAXIDMA_SPSC_LOAD_ACQUIRE(&RingPtr->SpscHwTotal) -
+		      RingPtr->SpscPostTotal);
+	if (BdLimit > HwCnt) {
+		BdLimit = HwCnt;
+	}
+
+	BdCount = 0;
+	if (BdLimit > 0) {
+		BdCount = XAxiDma_BdRingCountDone(RingPtr, BdLimit, NULL);
+	}
+
+	if (BdCount) {
+		*BdSetPtr = RingPtr->HwHead;
+		RingPtr->SpscPostTotal += (u32)BdCount;
+		RingPtr->PostCnt += BdCount;
+		RingPtr->DoneTotal += (u32)BdCount;
+		XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->HwHead, BdCount);
+	}
+	else {
+		*BdSetPtr = (XAxiDma_Bd *)NULL;
+	}
+
+	return BdCount;
+}
+
+/*****************************************************************************/
+/**
+ * Single producer/single consumer variant of XAxiDma_BdRingFree(). Once this
+ * function returns the BDs may be allocated again by the producer side; the
+ * caller must not access them any more. See XAxiDma_BdRingSpscAlloc() for
+ * the usage model.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	NumBd is the number of BDs to free.
+ * @param	BdSetPtr is the head of a list of BDs returned by
+ *		XAxiDma_BdRingSpscFromHw().
+ *
+ * @return
+ *		- XST_SUCCESS if the set of BDs was freed.
+ *		- XST_INVALID_PARAM if NumBd is negative
+ *		- XST_DMA_SG_LIST_ERROR if this function was called out of
+ *		sequence with XAxiDma_BdRingSpscFromHw().
+ *
+ * @note	Consumer side. This function can be used only when DMA is in SG
+ *		mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingSpscFree(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd * BdSetPtr)
+{
+	if (NumBd < 0) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR,
+		    "BdRingSpscFree: negative BDs %d\r\n", NumBd);
+
+		return XST_INVALID_PARAM;
+	}
+
+	/* If the BD Set to free is empty, do nothing
+	 */
+	if (NumBd == 0) {
+		return XST_SUCCESS;
+	}
+
+	/* Make sure we are in sync with XAxiDma_BdRingSpscFromHw() */
+	if ((RingPtr->PostCnt < NumBd) || (RingPtr->PostHead != BdSetPtr)) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingSpscFree: Error free BDs: "
+		"post count %d to free %d\r\n", RingPtr->PostCnt, NumBd);
+
+		return XST_DMA_SG_LIST_ERROR;
+	}
+
+	RingPtr->PostCnt -= NumBd;
+	XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->PostHead, NumBd);
+
+	/* Hand the BDs back to the producer side */
+	XAXIDMA_SPSC_STORE_RELEASE(&RingPtr->SpscFreeTotal,
+				   RingPtr->SpscFreeTotal + (u32)NumBd);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Return the number of BDs allocatable with XAxiDma_BdRingSpscAlloc().
+ *
+ * @param	RingPtr is the BD ring to operate on.
+ *
+ * @return	The number of BDs currently allocatable.
+ *
+ * @note	Producer side. The consumer may free more BDs at any time, so
+ *		the returned value is a lower bound.
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingSpscGetFreeCnt(XAxiDma_BdRing * RingPtr)
+{
+	u32 InUse;
+
+	InUse = RingPtr->SpscAllocTotal -
+		XAXIDMA_SPSC_LOAD_ACQUIRE(&RingPtr->SpscFreeTotal);
+
+	return RingPtr->AllCnt - (int)InUse;
+}
+/*****************************************************************************/
 /**
  * Check the internal data structures of the BD ring for the provided channel.
  * The following checks are made:
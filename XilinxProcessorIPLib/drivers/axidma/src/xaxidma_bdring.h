@@ -63,6 +63,9 @@
 *		       backward compatibility.
 * 9.2   vak  15/04/16  Fixed the compilation warnings in axidma driver
 * 9.7   rsp  01/11/18  Use UINTPTR instead of u32 for ChanBase CR#976392
+* 9.10  rsp  06/14/19  Add single producer/single consumer ring counters and
+*                      XAxiDma_BdRingSpsc APIs.
+*       rsp  06/20/19  Add adaptive interrupt coalescing controller.
 *
 * </pre>
 *
@@ -94,6 +97,32 @@ extern "C" {
 
 /**************************** Type Definitions *******************************/
 
+/** Bounds for the adaptive interrupt coalescing controller, see
+ * XAxiDma_BdRingSetAdaptCoalesce().
+ */
+typedef struct {
+	u32 MinCounter;		/**< Packet threshold at light load, 1 to 255 */
+	u32 MaxCounter;		/**< Largest packet threshold, MinCounter to
+				  255 */
+	u32 MinTimer;		/**< Delay timer at light load, 0 to 255 */
+	u32 MaxTimer;		/**< Delay timer at MaxCounter, MinTimer to
+				  255 */
+	u32 TargetIrqs;		/**< Interrupts per sample period aimed for
+				  once the load exceeds MinCounter packets
+				  per interrupt */
+} XAxiDma_AdaptCoalesceCfg;
+
+/** Run time state of the adaptive interrupt coalescing controller
+ */
+typedef struct {
+	XAxiDma_AdaptCoalesceCfg Cfg;	/**< User bounds */
+	int IsEnabled;		/**< Adaptive mode is active */
+	u32 LastDoneTotal;	/**< DoneTotal at the previous sample */
+	u32 AvgRate;		/**< Smoothed BDs per period, 3 fraction bits */
+	u32 Counter;		/**< Packet threshold currently programmed */
+	u32 Timer;		/**< Delay timer currently programmed */
+} XAxiDma_AdaptCoalesce;
+
 /** Container structure for descriptor storage control. If address translation
  * is enabled, then all addresses and pointers excluding FirstBdPhysAddr are
  * expressed in terms of the virtual address.
@@ -129,6 +158,16 @@ typedef struct {
 	int AllCnt;		/**< Total Number of BDs for channel */
 	int RingIndex;		/**< Ring Index */
 	int Cyclic;		/**< Check for cyclic DMA Mode */
+	u32 SpscAllocTotal;	/**< Spsc mode: BDs allocated, producer only */
+	volatile u32 SpscHwTotal;	/**< Spsc mode: BDs given to hardware,
+					  written by the producer */
+	u32 SpscPostTotal;	/**< Spsc mode: BDs retrieved from hardware,
+				  consumer only */
+	volatile u32 SpscFreeTotal;	/**< Spsc mode: BDs freed, written by
+					  the consumer */
+	u32 DoneTotal;		/**< BDs retrieved from hardware since the
+				  ring was created, wraps */
+	XAxiDma_AdaptCoalesce Adapt;	/**< Adaptive coalescing state */
 } XAxiDma_BdRing;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -523,8 +562,20 @@ int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 		XAxiDma_Bd ** BdSetPtr);
 int XAxiDma_BdRingFree(XAxiDma_BdRing * RingPtr, int NumBd,
 		XAxiDma_Bd * BdSetPtr);
+int XAxiDma_BdRingSpscAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd ** BdSetPtr);
+int XAxiDma_BdRingSpscToHw(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd * BdSetPtr);
+int XAxiDma_BdRingSpscFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
+	XAxiDma_Bd ** BdSetPtr);
+int XAxiDma_BdRingSpscFree(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd * BdSetPtr);
+int XAxiDma_BdRingSpscGetFreeCnt(XAxiDma_BdRing * RingPtr);
 int XAxiDma_BdRingStart(XAxiDma_BdRing * RingPtr);
 int XAxiDma_BdRingSetCoalesce(XAxiDma_BdRing * RingPtr, u32 Counter, u32 Timer);
+int XAxiDma_BdRingSetAdaptCoalesce(XAxiDma_BdRing * RingPtr,
+	XAxiDma_AdaptCoalesceCfg *CfgPtr);
+int XAxiDma_BdRingAdaptCoalesceSample(XAxiDma_BdRing * RingPtr);
 void XAxiDma_BdRingGetCoalesce(XAxiDma_BdRing * RingPtr,
 		u32 *CounterPtr, u32 *TimerPtr);
 
@@ -0,0 +1,423 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xaxipmon_sampler_example.c
+*
+* This file contains a design example showing how to use the sampling
+* service of the AXI Performance Monitor driver to monitor a slot
+* continuously, and how to drain the event log with an AXI DMA.
+*
+* @note
+*
+* The APM must be in Advanced mode. The event log part needs an APM with
+* the event log enabled and its streaming interface connected to the S2MM
+* channel of an AXI DMA in simple mode; it is skipped when the design has
+* no AXI DMA.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 6.8   adk    10/15/19 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xaxipmon_sampler.h"
+#include "xparameters.h"
+#include "xstatus.h"
+#include "xil_exception.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+
+#ifdef XPAR_INTC_0_DEVICE_ID
+#include "xintc.h"
+#else
+#include "xscugic.h"
+#endif
+
+#ifdef XPAR_AXIDMA_0_DEVICE_ID
+#include "xaxidma.h"
+#endif
+/************************** Constant Definitions ****************************/
+
+/*
+ * The following constants map to the XPAR parameters created in the
+ * xparameters.h file. They are defined here such that a user can easily
+ * change all the needed parameters in one place.
+ */
+#ifdef XPAR_INTC_0_DEVICE_ID
+#define INTC				XIntc
+#define INTC_HANDLER			XIntc_InterruptHandler
+#define AXIPMON_DEVICE_ID		XPAR_AXIPMON_0_DEVICE_ID
+#define INTC_DEVICE_ID			XPAR_INTC_0_DEVICE_ID
+#define INTC_AXIPMON_INTERRUPT_ID	XPAR_INTC_0_AXIPMON_0_VEC_ID
+#else
+#define INTC				XScuGic
+#define INTC_HANDLER			XScuGic_InterruptHandler
+#define AXIPMON_DEVICE_ID		XPAR_AXIPMON_0_DEVICE_ID
+#define INTC_DEVICE_ID			XPAR_SCUGIC_0_DEVICE_ID
+#define INTC_AXIPMON_INTERRUPT_ID	XPAR_XAPMPS_0_INTR
+#endif
+
+#ifdef XPAR_AXIDMA_0_DEVICE_ID
+#define DMA_DEVICE_ID		XPAR_AXIDMA_0_DEVICE_ID
+#endif
+
+#define APM_CLOCK_HZ		100000000U	/* APM core clock */
+#define SAMPLE_INTERVAL		(APM_CLOCK_HZ / 1000U)	/* 1 ms */
+#define NUM_SAMPLES		256U	/* Sample ring, power of 2 */
+#define MONITOR_SLOT		0U
+
+#define LOG_BUF_SIZE		0x4000U	/* Event log buffer size */
+#define NUM_LOG_BUFS		16U	/* Event log buffers to capture */
+
+/**************************** Type Definitions ******************************/
+
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Function Prototypes *****************************/
+
+int AxiPmonSamplerExample(u16 AxiPmonDeviceId);
+
+static int AxiPmonSetupIntrSystem(INTC *IntcInstancePtr,
+				XAxiPmon_Sampler *SamplerPtr, u16 IntrId);
+
+#ifdef XPAR_AXIDMA_0_DEVICE_ID
+static int AxiPmonEventLogCapture(XAxiPmon_Sampler *SamplerPtr);
+#endif
+
+/************************** Variable Definitions ****************************/
+
+static XAxiPmon AxiPmonInst;	/* AXI Performance Monitor driver instance */
+static XAxiPmon_Sampler Sampler;	/* Sampling service instance */
+static XAxiPmon_Sample Samples[NUM_SAMPLES];	/* Sample ring */
+static u32 Scratch[NUM_SAMPLES];	/* Percentile work area */
+INTC Intc;	/* The Instance of the Interrupt Controller Driver */
+
+#ifdef XPAR_AXIDMA_0_DEVICE_ID
+static XAxiDma AxiDma;		/* AXI DMA draining the event log */
+static u8 LogBuf[2][LOG_BUF_SIZE] __attribute__ ((aligned(64)));
+#endif
+
+/****************************************************************************/
+/**
+*
+* Main function that invokes the example in this file.
+*
+* @param	None.
+*
+* @return
+*		- XST_SUCCESS if the example has completed successfully.
+*		- XST_FAILURE if the example has failed.
+*
+* @note		None.
+*
+*****************************************************************************/
+int main(void)
+{
+	int Status;
+
+	Status = AxiPmonSamplerExample(AXIPMON_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf("AXI Performance Monitor Sampler Example Failed\r\n");
+		return XST_FAILURE;
+	}
+	xil_printf("Successfully ran AXI Performance Monitor Sampler "
+						"Example\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function samples the bandwidth and latency of a slot every
+* SAMPLE_INTERVAL clocks until the ring is full, then prints the summary.
+* This function does the following tasks:
+*	- Initiate the AXI Performance Monitor device driver instance
+*	- Initiate the sampling service and select the slot metrics
+*	- Setup Interrupt System
+*	- Start sampling and capture the event log, if present
+*	- Wait for the ring to fill and stop sampling
+*	- Print the slot summary
+*
+* @param	AxiPmonDeviceId is the XPAR_<AXIPMON_instance>_DEVICE_ID value
+*		from xparameters.h.
+*
+* @return
+*		- XST_SUCCESS if the example has completed successfully.
+*		- XST_FAILURE if the example has failed.
+*
+* @note		None
+*
+******************************************************************************/
+int AxiPmonSamplerExample(u16 AxiPmonDeviceId)
+{
+	int Status;
+	XAxiPmon_Config *ConfigPtr;
+	XAxiPmon_SlotSummary Summary;
+
+	ConfigPtr = XAxiPmon_LookupConfig(AxiPmonDeviceId);
+	if (ConfigPtr == NULL) {
+		return XST_FAILURE;
+	}
+	XAxiPmon_CfgInitialize(&AxiPmonInst, ConfigPtr,
+				ConfigPtr->BaseAddress);
+	if (AxiPmonInst.Mode != XAPM_MODE_ADVANCED) {
+		return XST_FAILURE;
+	}
+
+	Status = XAxiPmon_SamplerInit(&Sampler, &AxiPmonInst, Samples,
+				Scratch, NUM_SAMPLES, APM_CLOCK_HZ);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XAxiPmon_SamplerSetSlot(&Sampler, MONITOR_SLOT,
+			XAPM_SAMPLER_BANDWIDTH | XAPM_SAMPLER_LATENCY);
+	if (Status != XST_SUCCESS) {
+		/* Not enough counters for latency, sample bandwidth only */
+		Status = XAxiPmon_SamplerSetSlot(&Sampler, MONITOR_SLOT,
+					XAPM_SAMPLER_BANDWIDTH);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	Status = AxiPmonSetupIntrSystem(&Intc, &Sampler,
+					INTC_AXIPMON_INTERRUPT_ID);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	(void)XAxiPmon_SamplerStart(&Sampler, SAMPLE_INTERVAL);
+
+	/*
+	 * Application for which Metrics has to be computed should be
+	 * started here
+	 */
+
+#ifdef XPAR_AXIDMA_0_DEVICE_ID
+	if (AxiPmonInst.Config.IsEventLog == 1U) {
+		Status = AxiPmonEventLogCapture(&Sampler);
+		if (Status != XST_SUCCESS) {
+			(void)XAxiPmon_SamplerStop(&Sampler);
+			return XST_FAILURE;
+		}
+	}
+#endif
+
+	/* Wait until the ring is full */
+	while (Sampler.Dropped == 0U) {
+		;
+	}
+	(void)XAxiPmon_SamplerStop(&Sampler);
+
+	Status = XAxiPmon_SamplerGetSummary(&Sampler, MONITOR_SLOT, &Summary);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	xil_printf("Slot %d: %d samples\r\n", MONITOR_SLOT,
+				Summary.NumSamples);
+	xil_printf("Write bandwidth avg %d peak %d bytes/s\r\n",
+				(u32)Summary.WrBandwidth,
+				(u32)Summary.WrBandwidthPeak);
+	xil_printf("Read bandwidth avg %d peak %d bytes/s\r\n",
+				(u32)Summary.RdBandwidth,
+				(u32)Summary.RdBandwidthPeak);
+	xil_printf("Write latency avg %d p50 %d p90 %d p99 %d clocks\r\n",
+			Summary.WrLatency,
+			Summary.WrLatencyPct[XAPM_SAMPLER_P50],
+			Summary.WrLatencyPct[XAPM_SAMPLER_P90],
+			Summary.WrLatencyPct[XAPM_SAMPLER_P99]);
+	xil_printf("Read latency avg %d p50 %d p90 %d p99 %d clocks\r\n",
+			Summary.RdLatency,
+			Summary.RdLatencyPct[XAPM_SAMPLER_P50],
+			Summary.RdLatencyPct[XAPM_SAMPLER_P90],
+			Summary.RdLatencyPct[XAPM_SAMPLER_P99]);
+	xil_printf("Outstanding x100 write %d read %d\r\n",
+			Summary.WrOutstanding, Summary.RdOutstanding);
+
+	return XST_SUCCESS;
+}
+
+#ifdef XPAR_AXIDMA_0_DEVICE_ID
+/*****************************************************************************/
+/**
+*
+* This function starts the event log and captures NUM_LOG_BUFS buffers of it
+* with the S2MM channel of the AXI DMA. Two buffers are used in turn so that
+* the previous buffer can be processed while the next one is filled.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+*
+* @return
+*		- XST_SUCCESS if the log was captured.
+*		- XST_FAILURE if the AXI DMA could not be set up.
+*
+* @note		The log records are not decoded by this example.
+*
+******************************************************************************/
+static int AxiPmonEventLogCapture(XAxiPmon_Sampler *SamplerPtr)
+{
+	XAxiDma_Config *CfgPtr;
+	int Status;
+	u32 Index;
+	u32 Buf = 0U;
+
+	CfgPtr = XAxiDma_LookupConfig(DMA_DEVICE_ID);
+	if (CfgPtr == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XAxiDma_CfgInitialize(&AxiDma, CfgPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	if (XAxiDma_HasSg(&AxiDma)) {
+		return XST_FAILURE;
+	}
+	XAxiDma_IntrDisable(&AxiDma, XAXIDMA_IRQ_ALL_MASK,
+				XAXIDMA_DEVICE_TO_DMA);
+
+	Xil_DCacheInvalidateRange((UINTPTR)LogBuf, sizeof(LogBuf));
+	Status = XAxiDma_SimpleTransfer(&AxiDma, (UINTPTR)LogBuf[Buf],
+				LOG_BUF_SIZE, XAXIDMA_DEVICE_TO_DMA);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	(void)XAxiPmon_SamplerStartEventLog(SamplerPtr,
+			XAPM_FLAG_WRADDR | XAPM_FLAG_FIRSTWR |
+			XAPM_FLAG_LASTWR | XAPM_FLAG_RESPONSE |
+			XAPM_FLAG_RDADDR | XAPM_FLAG_FIRSTRD |
+			XAPM_FLAG_LASTRD);
+
+	for (Index = 1U; Index < NUM_LOG_BUFS; Index++) {
+		while (XAxiDma_Busy(&AxiDma, XAXIDMA_DEVICE_TO_DMA)) {
+			;
+		}
+
+		/* Refill the other buffer before looking at this one */
+		Buf ^= 1U;
+		Status = XAxiDma_SimpleTransfer(&AxiDma, (UINTPTR)LogBuf[Buf],
+				LOG_BUF_SIZE, XAXIDMA_DEVICE_TO_DMA);
+		if (Status != XST_SUCCESS) {
+			break;
+		}
+
+		/*
+		 * LogBuf[Buf ^ 1] holds a buffer of event log records and
+		 * can be processed or forwarded here
+		 */
+		Xil_DCacheInvalidateRange((UINTPTR)LogBuf[Buf ^ 1U],
+					LOG_BUF_SIZE);
+	}
+
+	while (XAxiDma_Busy(&AxiDma, XAXIDMA_DEVICE_TO_DMA)) {
+		;
+	}
+	(void)XAxiPmon_StopEventLog(SamplerPtr->InstancePtr);
+
+	xil_printf("Event log: %d buffers, %d FIFO full events\r\n",
+				Index, SamplerPtr->FifoFull);
+
+	return (Status == XST_SUCCESS) ? XST_SUCCESS : XST_FAILURE;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* This function connects the sampler interrupt handler to the AXI
+* Performance Monitor interrupt.
+*
+* @param	IntcInstancePtr is a reference to the Interrupt Controller
+*			driver Instance
+* @param	SamplerPtr is a reference to the sampler instance
+* @param	IntrId is XPAR_<INTC_instance>_<AXIPMON_instance>_INTERRUPT_INTR
+*			value from xparameters.h
+*
+* @return
+*		- XST_SUCCESS if the interrupt setup is successful.
+*		- XST_FAILURE if interrupt setup is not successful.
+*
+* @note		None.
+*
+******************************************************************************/
+static int AxiPmonSetupIntrSystem(INTC *IntcInstancePtr,
+				XAxiPmon_Sampler *SamplerPtr, u16 IntrId)
+{
+	int Status;
+#ifdef XPAR_INTC_0_DEVICE_ID
+	Status = XIntc_Initialize(IntcInstancePtr, INTC_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Status = XIntc_Connect(IntcInstancePtr, IntrId,
+		(XInterruptHandler)XAxiPmon_SamplerIntrHandler, SamplerPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Status = XIntc_Start(IntcInstancePtr, XIN_REAL_MODE);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XIntc_Enable(IntcInstancePtr, IntrId);
+#else
+	XScuGic_Config *IntcConfig;
+
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (NULL == IntcConfig) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(IntcInstancePtr, IntcConfig,
+					IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_Connect(IntcInstancePtr, IntrId,
+		(Xil_InterruptHandler)XAxiPmon_SamplerIntrHandler, SamplerPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XScuGic_Enable(IntcInstancePtr, IntrId);
+#endif
+	Xil_ExceptionInit();
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+				(Xil_ExceptionHandler)INTC_HANDLER,
+				IntcInstancePtr);
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
@@ -255,6 +255,9 @@
 *                     generation.
 * 6.6   ms   04/18/17 Modified tcl file to add suffix U for all macro
 *                     definitions of axipmon in xparameters.h
+* 6.8   adk  10/15/19 Added the interrupt driven sampling service in
+*                     xaxipmon_sampler.c/.h, with per slot bandwidth and
+*                     latency summaries, and its example.
 * </pre>
 *
 *****************************************************************************/
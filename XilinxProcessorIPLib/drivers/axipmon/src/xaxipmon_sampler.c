@@ -0,0 +1,653 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaxipmon_sampler.c
+* @addtogroup axipmon_v6_6
+* @{
+*
+* This file contains the continuous sampling service of the XAxiPmon driver.
+* See xaxipmon_sampler.h for more information.
+*
+* @note	None.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 6.8   adk    10/15/19 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xaxipmon_sampler.h"
+
+/************************** Constant Definitions ****************************/
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Variable Definitions ****************************/
+
+static const u8 XAxiPmon_SamplerPct[XAPM_SAMPLER_NUM_PCT] = {
+	50U, 90U, 99U
+};
+
+/************************** Function Prototypes *****************************/
+
+static u64 XAxiPmon_SamplerRate(u64 Count, u64 Clocks, u32 ClockHz);
+static void XAxiPmon_SamplerLatencyPct(XAxiPmon_Sampler *SamplerPtr,
+			u32 Head, u8 LatCounter, u8 CntCounter, u32 *Pct);
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a sampling service on an APM. No slot is
+* sampled until XAxiPmon_SamplerSetSlot is called.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	InstancePtr is a pointer to the initialized XAxiPmon instance,
+*		which must be in Advanced mode.
+* @param	Samples is the sample ring of NumSamples entries.
+* @param	Scratch is an array of NumSamples words used to compute the
+*		percentiles.
+* @param	NumSamples is the number of samples in the ring, a power of 2.
+* @param	ClockHz is the frequency of the APM core clock.
+*
+* @return	XST_SUCCESS
+*
+* @note		None
+*
+******************************************************************************/
+s32 XAxiPmon_SamplerInit(XAxiPmon_Sampler *SamplerPtr, XAxiPmon *InstancePtr,
+			XAxiPmon_Sample *Samples, u32 *Scratch,
+			u32 NumSamples, u32 ClockHz)
+{
+	u32 Index;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(InstancePtr->Mode == XAPM_MODE_ADVANCED);
+	Xil_AssertNonvoid(Samples != NULL);
+	Xil_AssertNonvoid(Scratch != NULL);
+	Xil_AssertNonvoid((NumSamples != 0U) &&
+			((NumSamples & (NumSamples - 1U)) == 0U));
+	Xil_AssertNonvoid(ClockHz != 0U);
+
+	SamplerPtr->InstancePtr = InstancePtr;
+	SamplerPtr->Samples = Samples;
+	SamplerPtr->Scratch = Scratch;
+	SamplerPtr->NumSamples = NumSamples;
+	SamplerPtr->Head = 0U;
+	SamplerPtr->Tail = 0U;
+	SamplerPtr->Dropped = 0U;
+	SamplerPtr->FifoFull = 0U;
+	SamplerPtr->SampleInterval = 0U;
+	SamplerPtr->ClockHz = ClockHz;
+	SamplerPtr->NumCounters = 0U;
+	for (Index = 0U; Index < XAPM_MAX_AGENTS; Index++) {
+		SamplerPtr->SlotSets[Index] = 0U;
+		SamplerPtr->Slots[Index].WrBytes = XAPM_SAMPLER_NO_COUNTER;
+		SamplerPtr->Slots[Index].RdBytes = XAPM_SAMPLER_NO_COUNTER;
+		SamplerPtr->Slots[Index].WrLatency = XAPM_SAMPLER_NO_COUNTER;
+		SamplerPtr->Slots[Index].WrCount = XAPM_SAMPLER_NO_COUNTER;
+		SamplerPtr->Slots[Index].RdLatency = XAPM_SAMPLER_NO_COUNTER;
+		SamplerPtr->Slots[Index].RdCount = XAPM_SAMPLER_NO_COUNTER;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function selects the metric sets sampled on a slot and reassigns the
+* metric counters of all the slots, in slot order.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	Slot is the monitor slot, 0 to XAPM_MAX_AGENTS - 1.
+* @param	MetricSets is an OR of XAPM_SAMPLER_* metric sets, 0 to stop
+*		sampling the slot.
+*
+* @return	XST_SUCCESS if the counters are assigned, XST_FAILURE if the
+*		APM does not have enough metric counters.
+*
+* @note		The sampler must be stopped.
+*
+******************************************************************************/
+s32 XAxiPmon_SamplerSetSlot(XAxiPmon_Sampler *SamplerPtr, u8 Slot,
+			u8 MetricSets)
+{
+	XAxiPmon *InstancePtr;
+	XAxiPmon_SlotCounters *SlotPtr;
+	u8 Sets[XAPM_MAX_AGENTS];
+	u8 Index;
+	u8 Counter = 0U;
+	u8 NumCounters;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(Slot < XAPM_MAX_AGENTS);
+
+	InstancePtr = SamplerPtr->InstancePtr;
+	NumCounters = InstancePtr->Config.NumberofCounters;
+	if (NumCounters > XAPM_MAX_COUNTERS) {
+		NumCounters = (u8)XAPM_MAX_COUNTERS;
+	}
+
+	for (Index = 0U; Index < XAPM_MAX_AGENTS; Index++) {
+		Sets[Index] = SamplerPtr->SlotSets[Index];
+	}
+	Sets[Slot] = MetricSets;
+
+	/* Check that the counters suffice before changing anything */
+	for (Index = 0U; Index < XAPM_MAX_AGENTS; Index++) {
+		if ((Sets[Index] & XAPM_SAMPLER_BANDWIDTH) != 0U) {
+			Counter += 2U;
+		}
+		if ((Sets[Index] & XAPM_SAMPLER_LATENCY) != 0U) {
+			Counter += 4U;
+		}
+	}
+	if (Counter > NumCounters) {
+		return XST_FAILURE;
+	}
+
+	Counter = 0U;
+	for (Index = 0U; Index < XAPM_MAX_AGENTS; Index++) {
+		SamplerPtr->SlotSets[Index] = Sets[Index];
+		SlotPtr = &SamplerPtr->Slots[Index];
+		SlotPtr->WrBytes = XAPM_SAMPLER_NO_COUNTER;
+		SlotPtr->RdBytes = XAPM_SAMPLER_NO_COUNTER;
+		SlotPtr->WrLatency = XAPM_SAMPLER_NO_COUNTER;
+		SlotPtr->WrCount = XAPM_SAMPLER_NO_COUNTER;
+		SlotPtr->RdLatency = XAPM_SAMPLER_NO_COUNTER;
+		SlotPtr->RdCount = XAPM_SAMPLER_NO_COUNTER;
+
+		if ((Sets[Index] & XAPM_SAMPLER_BANDWIDTH) != 0U) {
+			SlotPtr->WrBytes = Counter;
+			(void)XAxiPmon_SetMetrics(InstancePtr, Index,
+					XAPM_METRIC_SET_2, Counter);
+			Counter++;
+			SlotPtr->RdBytes = Counter;
+			(void)XAxiPmon_SetMetrics(InstancePtr, Index,
+					XAPM_METRIC_SET_3, Counter);
+			Counter++;
+		}
+		if ((Sets[Index] & XAPM_SAMPLER_LATENCY) != 0U) {
+			SlotPtr->WrLatency = Counter;
+			(void)XAxiPmon_SetMetrics(InstancePtr, Index,
+					XAPM_METRIC_SET_6, Counter);
+			Counter++;
+			SlotPtr->WrCount = Counter;
+			(void)XAxiPmon_SetMetrics(InstancePtr, Index,
+					XAPM_METRIC_SET_0, Counter);
+			Counter++;
+			SlotPtr->RdLatency = Counter;
+			(void)XAxiPmon_SetMetrics(InstancePtr, Index,
+					XAPM_METRIC_SET_5, Counter);
+			Counter++;
+			SlotPtr->RdCount = Counter;
+			(void)XAxiPmon_SetMetrics(InstancePtr, Index,
+					XAPM_METRIC_SET_1, Counter);
+			Counter++;
+		}
+	}
+	SamplerPtr->NumCounters = Counter;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function starts sampling. The metric counters are reset at the end of
+* every interval and copied into the ring by XAxiPmon_SamplerIntrHandler,
+* which must be connected to the APM interrupt.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	SampleInterval is the length of an interval in APM clocks.
+*
+* @return	XST_SUCCESS
+*
+* @note		The ring is emptied.
+*
+******************************************************************************/
+s32 XAxiPmon_SamplerStart(XAxiPmon_Sampler *SamplerPtr, u32 SampleInterval)
+{
+	XAxiPmon *InstancePtr;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(SampleInterval != 0U);
+
+	InstancePtr = SamplerPtr->InstancePtr;
+
+	SamplerPtr->Head = 0U;
+	SamplerPtr->Tail = 0U;
+	SamplerPtr->Dropped = 0U;
+	SamplerPtr->SampleInterval = SampleInterval;
+
+	(void)XAxiPmon_ResetMetricCounter(InstancePtr);
+	XAxiPmon_IntrClear(InstancePtr, XAPM_IXR_SIC_OVERFLOW_MASK);
+	XAxiPmon_IntrEnable(InstancePtr, XAPM_IXR_SIC_OVERFLOW_MASK);
+	XAxiPmon_IntrGlobalEnable(InstancePtr);
+
+	(void)XAxiPmon_StartCounters(InstancePtr, SampleInterval);
+
+	/*
+	 * Reset the counters at each lapse. XAxiPmon_EnableMetricCounterReset
+	 * would also clear the enable bit set by XAxiPmon_StartCounters.
+	 */
+	XAxiPmon_WriteReg(InstancePtr->Config.BaseAddress, XAPM_SICR_OFFSET,
+			XAxiPmon_ReadReg(InstancePtr->Config.BaseAddress,
+			XAPM_SICR_OFFSET) | XAPM_SICR_MCNTR_RST_MASK);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stops sampling and the event log. The samples in the ring
+* are kept.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+*
+* @return	XST_SUCCESS
+*
+* @note		None
+*
+******************************************************************************/
+s32 XAxiPmon_SamplerStop(XAxiPmon_Sampler *SamplerPtr)
+{
+	XAxiPmon *InstancePtr;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+
+	InstancePtr = SamplerPtr->InstancePtr;
+
+	XAxiPmon_DisableSampleIntervalCounter(InstancePtr);
+	(void)XAxiPmon_StopCounters(InstancePtr);
+	if (InstancePtr->Config.IsEventLog == 1U) {
+		(void)XAxiPmon_StopEventLog(InstancePtr);
+	}
+
+	XAxiPmon_WriteReg(InstancePtr->Config.BaseAddress, XAPM_IE_OFFSET,
+			XAxiPmon_ReadReg(InstancePtr->Config.BaseAddress,
+			XAPM_IE_OFFSET) & ~(XAPM_IXR_SIC_OVERFLOW_MASK |
+			XAPM_IXR_FIFO_FULL_MASK));
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function starts the event log and counts its FIFO full events. The
+* event log stream must be drained by an AXI DMA S2MM channel set up by the
+* application.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	FlagEnables is an OR of the XAPM_FLAG_* flags to log.
+*
+* @return	XST_SUCCESS
+*
+* @note		None
+*
+******************************************************************************/
+s32 XAxiPmon_SamplerStartEventLog(XAxiPmon_Sampler *SamplerPtr,
+			u32 FlagEnables)
+{
+	XAxiPmon *InstancePtr;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(SamplerPtr->InstancePtr->Config.IsEventLog == 1U);
+
+	InstancePtr = SamplerPtr->InstancePtr;
+
+	SamplerPtr->FifoFull = 0U;
+	(void)XAxiPmon_ResetFifo(InstancePtr);
+	XAxiPmon_IntrClear(InstancePtr, XAPM_IXR_FIFO_FULL_MASK);
+	XAxiPmon_IntrEnable(InstancePtr, XAPM_IXR_FIFO_FULL_MASK);
+	XAxiPmon_IntrGlobalEnable(InstancePtr);
+
+	return XAxiPmon_StartEventLog(InstancePtr, FlagEnables);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the interrupt handler of the sampler. At the end of each
+* sample interval it copies the sampled metric counters into the ring; when
+* the ring is full the sample is dropped and counted.
+*
+* @param	CallBackRef is a pointer to the sampler instance.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+void XAxiPmon_SamplerIntrHandler(void *CallBackRef)
+{
+	XAxiPmon_Sampler *SamplerPtr = (XAxiPmon_Sampler *)CallBackRef;
+	XAxiPmon *InstancePtr;
+	XAxiPmon_Sample *SamplePtr;
+	u32 Status;
+	u8 Counter;
+
+	Xil_AssertVoid(SamplerPtr != NULL);
+
+	InstancePtr = SamplerPtr->InstancePtr;
+	Status = XAxiPmon_IntrGetStatus(InstancePtr);
+	XAxiPmon_IntrClear(InstancePtr, Status);
+
+	if ((Status & XAPM_IXR_FIFO_FULL_MASK) != 0U) {
+		SamplerPtr->FifoFull++;
+	}
+
+	if ((Status & XAPM_IXR_SIC_OVERFLOW_MASK) == 0U) {
+		return;
+	}
+
+	if ((SamplerPtr->Head - SamplerPtr->Tail) >= SamplerPtr->NumSamples) {
+		SamplerPtr->Dropped++;
+		return;
+	}
+
+	SamplePtr = &SamplerPtr->Samples[SamplerPtr->Head &
+					(SamplerPtr->NumSamples - 1U)];
+	SamplePtr->Interval = SamplerPtr->SampleInterval;
+	for (Counter = 0U; Counter < SamplerPtr->NumCounters; Counter++) {
+		/*
+		 * The sampled counters hold the values at the lapse, the
+		 * live counters have already been reset
+		 */
+		if (InstancePtr->Config.HaveSampledCounters == 1U) {
+			SamplePtr->Counter[Counter] =
+				XAxiPmon_GetSampledMetricCounter(InstancePtr,
+								Counter);
+		} else {
+			SamplePtr->Counter[Counter] =
+				XAxiPmon_GetMetricCounter(InstancePtr, Counter);
+		}
+	}
+	SamplerPtr->Head++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function removes the oldest sample from the ring.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	SamplePtr is where the sample is copied.
+*
+* @return	1 if a sample was copied, 0 if the ring is empty.
+*
+* @note		None
+*
+******************************************************************************/
+u32 XAxiPmon_SamplerRead(XAxiPmon_Sampler *SamplerPtr,
+			XAxiPmon_Sample *SamplePtr)
+{
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(SamplePtr != NULL);
+
+	if (SamplerPtr->Tail == SamplerPtr->Head) {
+		return 0U;
+	}
+
+	*SamplePtr = SamplerPtr->Samples[SamplerPtr->Tail &
+					(SamplerPtr->NumSamples - 1U)];
+	SamplerPtr->Tail++;
+
+	return 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function summarizes the samples of a slot held in the ring, without
+* removing them.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	Slot is the monitor slot.
+* @param	SummaryPtr is where the summary is written. The fields of the
+*		metric sets not sampled on the slot are 0.
+*
+* @return	XST_SUCCESS, or XST_NO_DATA if the ring is empty.
+*
+* @note		Bandwidths are computed with the ClockHz given to
+*		XAxiPmon_SamplerInit.
+*
+******************************************************************************/
+s32 XAxiPmon_SamplerGetSummary(XAxiPmon_Sampler *SamplerPtr, u8 Slot,
+			XAxiPmon_SlotSummary *SummaryPtr)
+{
+	XAxiPmon_SlotCounters *SlotPtr;
+	XAxiPmon_Sample *SamplePtr;
+	u64 Clocks = 0U;
+	u64 WrLatency = 0U;
+	u64 RdLatency = 0U;
+	u64 WrCount = 0U;
+	u64 RdCount = 0U;
+	u64 Rate;
+	u32 Head;
+	u32 Index;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(Slot < XAPM_MAX_AGENTS);
+	Xil_AssertNonvoid(SummaryPtr != NULL);
+
+	(void)memset(SummaryPtr, 0, sizeof(XAxiPmon_SlotSummary));
+
+	/* The handler only adds samples past Head */
+	Head = SamplerPtr->Head;
+	if (Head == SamplerPtr->Tail) {
+		return XST_NO_DATA;
+	}
+
+	SlotPtr = &SamplerPtr->Slots[Slot];
+	for (Index = SamplerPtr->Tail; Index != Head; Index++) {
+		SamplePtr = &SamplerPtr->Samples[Index &
+					(SamplerPtr->NumSamples - 1U)];
+		Clocks += SamplePtr->Interval;
+		SummaryPtr->NumSamples++;
+
+		if (SlotPtr->WrBytes != XAPM_SAMPLER_NO_COUNTER) {
+			SummaryPtr->WrBytes +=
+				SamplePtr->Counter[SlotPtr->WrBytes];
+			SummaryPtr->RdBytes +=
+				SamplePtr->Counter[SlotPtr->RdBytes];
+
+			Rate = XAxiPmon_SamplerRate(
+				SamplePtr->Counter[SlotPtr->WrBytes],
+				SamplePtr->Interval, SamplerPtr->ClockHz);
+			if (Rate > SummaryPtr->WrBandwidthPeak) {
+				SummaryPtr->WrBandwidthPeak = Rate;
+			}
+			Rate = XAxiPmon_SamplerRate(
+				SamplePtr->Counter[SlotPtr->RdBytes],
+				SamplePtr->Interval, SamplerPtr->ClockHz);
+			if (Rate > SummaryPtr->RdBandwidthPeak) {
+				SummaryPtr->RdBandwidthPeak = Rate;
+			}
+		}
+		if (SlotPtr->WrLatency != XAPM_SAMPLER_NO_COUNTER) {
+			WrLatency += SamplePtr->Counter[SlotPtr->WrLatency];
+			WrCount += SamplePtr->Counter[SlotPtr->WrCount];
+			RdLatency += SamplePtr->Counter[SlotPtr->RdLatency];
+			RdCount += SamplePtr->Counter[SlotPtr->RdCount];
+		}
+	}
+
+	if (SlotPtr->WrBytes != XAPM_SAMPLER_NO_COUNTER) {
+		SummaryPtr->WrBandwidth = XAxiPmon_SamplerRate(
+				SummaryPtr->WrBytes, Clocks,
+				SamplerPtr->ClockHz);
+		SummaryPtr->RdBandwidth = XAxiPmon_SamplerRate(
+				SummaryPtr->RdBytes, Clocks,
+				SamplerPtr->ClockHz);
+	}
+
+	if (SlotPtr->WrLatency != XAPM_SAMPLER_NO_COUNTER) {
+		if (WrCount != 0U) {
+			SummaryPtr->WrLatency = (u32)(WrLatency / WrCount);
+		}
+		if (RdCount != 0U) {
+			SummaryPtr->RdLatency = (u32)(RdLatency / RdCount);
+		}
+
+		/* Little's law: latency cycles per cycle */
+		SummaryPtr->WrOutstanding = (u32)((WrLatency * 100U) / Clocks);
+		SummaryPtr->RdOutstanding = (u32)((RdLatency * 100U) / Clocks);
+
+		XAxiPmon_SamplerLatencyPct(SamplerPtr, Head,
+				SlotPtr->WrLatency, SlotPtr->WrCount,
+				SummaryPtr->WrLatencyPct);
+		XAxiPmon_SamplerLatencyPct(SamplerPtr, Head,
+				SlotPtr->RdLatency, SlotPtr->RdCount,
+				SummaryPtr->RdLatencyPct);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function converts a count over a number of clocks to a count per
+* second, without overflowing 64 bits.
+*
+* @param	Count is the count.
+* @param	Clocks is the number of clocks.
+* @param	ClockHz is the clock frequency.
+*
+* @return	Count per second.
+*
+* @note		None
+*
+******************************************************************************/
+static u64 XAxiPmon_SamplerRate(u64 Count, u64 Clocks, u32 ClockHz)
+{
+	while ((Count > 0xFFFFFFFFU) || (Clocks > 0xFFFFFFFFU)) {
+		Count >>= 1U;
+		Clocks >>= 1U;
+	}
+	if (Clocks == 0U) {
+		return 0U;
+	}
+
+	return (Count * ClockHz) / Clocks;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function computes the percentiles of the per interval average
+* latency of a direction of a slot.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	Head is the end of the samples to use.
+* @param	LatCounter is the total latency counter.
+* @param	CntCounter is the transaction count counter.
+* @param	Pct is where the XAPM_SAMPLER_NUM_PCT percentiles are written.
+*
+* @return	None
+*
+* @note		Intervals without transactions are skipped.
+*
+******************************************************************************/
+static void XAxiPmon_SamplerLatencyPct(XAxiPmon_Sampler *SamplerPtr,
+			u32 Head, u8 LatCounter, u8 CntCounter, u32 *Pct)
+{
+	XAxiPmon_Sample *SamplePtr;
+	u32 *Values = SamplerPtr->Scratch;
+	u32 Num = 0U;
+	u32 Index;
+	u32 Gap;
+	u32 Pos;
+	u32 Value;
+
+	for (Index = SamplerPtr->Tail; Index != Head; Index++) {
+		SamplePtr = &SamplerPtr->Samples[Index &
+					(SamplerPtr->NumSamples - 1U)];
+		if (SamplePtr->Counter[CntCounter] != 0U) {
+			Values[Num] = SamplePtr->Counter[LatCounter] /
+					SamplePtr->Counter[CntCounter];
+			Num++;
+		}
+	}
+	if (Num == 0U) {
+		return;
+	}
+
+	/* Shell sort, the ring is small and this runs outside the handler */
+	for (Gap = Num / 2U; Gap > 0U; Gap /= 2U) {
+		for (Index = Gap; Index < Num; Index++) {
+			Value = Values[Index];
+			for (Pos = Index; (Pos >= Gap) &&
+					(Values[Pos - Gap] > Value); Pos -= Gap) {
+				Values[Pos] = Values[Pos - Gap];
+			}
+			Values[Pos] = Value;
+		}
+	}
+
+	for (Index = 0U; Index < XAPM_SAMPLER_NUM_PCT; Index++) {
+		Pct[Index] = Values[((Num - 1U) * XAxiPmon_SamplerPct[Index]) /
+					100U];
+	}
+}
+/** @} */
@@ -0,0 +1,198 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaxipmon_sampler.h
+* @addtogroup axipmon_v6_6
+* @{
+*
+* This file contains the continuous sampling service of the XAxiPmon driver.
+*
+* The service assigns the metric counters of an APM in Advanced mode to
+* metric sets of the monitor slots, lets the sample interval counter lapse
+* at a fixed interval and, from the sample interval interrupt, copies the
+* counters of every interval into a ring buffer provided by the user, so
+* that no interval is lost between two reads of the application.
+*
+* Metric sets of a slot:
+*	- XAPM_SAMPLER_BANDWIDTH: write and read byte counts (2 counters)
+*	- XAPM_SAMPLER_LATENCY: total write and read latencies and write and
+*	  read transaction counts (4 counters). The average number of
+*	  outstanding transactions is derived from them, as the total latency
+*	  of an interval divided by the length of the interval.
+*
+* XAxiPmon_SamplerGetSummary() reports the bandwidth, the average latency,
+* the average outstanding transactions and the 50th, 90th and 99th
+* percentiles of the per interval average latency of a slot, computed over
+* the samples held in the ring.
+*
+* The event log of the APM is a stream; XAxiPmon_SamplerStartEventLog()
+* starts it and counts the FIFO full events, the stream itself is moved to
+* memory by an AXI DMA S2MM channel set up by the application, see
+* xaxipmon_sampler_example.c.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 6.8   adk    10/15/19 First release
+* </pre>
+*
+*****************************************************************************/
+#ifndef XAXIPMON_SAMPLER_H /* Prevent circular inclusions */
+#define XAXIPMON_SAMPLER_H /* by using protection macros  */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files ********************************/
+
+#include "xaxipmon.h"
+
+/************************** Constant Definitions ****************************/
+
+/**
+ * @name Metric sets of a slot
+ * @{
+ */
+#define XAPM_SAMPLER_BANDWIDTH	0x01U /**< Write and read byte counts */
+#define XAPM_SAMPLER_LATENCY	0x02U /**< Latencies and transaction
+					*  counts */
+/*@}*/
+
+/**
+ * @name Percentiles reported by XAxiPmon_SamplerGetSummary
+ * @{
+ */
+#define XAPM_SAMPLER_P50	0U /**< Median */
+#define XAPM_SAMPLER_P90	1U /**< 90th percentile */
+#define XAPM_SAMPLER_P99	2U /**< 99th percentile */
+#define XAPM_SAMPLER_NUM_PCT	3U /**< Number of percentiles */
+/*@}*/
+
+#define XAPM_SAMPLER_NO_COUNTER	0xFFU /**< Metric not sampled */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Counters of one sample interval.
+ */
+typedef struct {
+	u32 Interval;			/**< Length in APM clocks */
+	u32 Counter[XAPM_MAX_COUNTERS];	/**< Metric counters */
+} XAxiPmon_Sample;
+
+/**
+ * Counters assigned to the metrics of a slot, XAPM_SAMPLER_NO_COUNTER for
+ * the metrics not sampled.
+ */
+typedef struct {
+	u8 WrBytes;		/**< Write byte count */
+	u8 RdBytes;		/**< Read byte count */
+	u8 WrLatency;		/**< Total write latency */
+	u8 WrCount;		/**< Write transaction count */
+	u8 RdLatency;		/**< Total read latency */
+	u8 RdCount;		/**< Read transaction count */
+} XAxiPmon_SlotCounters;
+
+/**
+ * Summary of a slot over the samples in the ring.
+ */
+typedef struct {
+	u32 NumSamples;			/**< Samples summarized */
+	u64 WrBytes;			/**< Bytes written */
+	u64 RdBytes;			/**< Bytes read */
+	u64 WrBandwidth;		/**< Average write bytes/s */
+	u64 RdBandwidth;		/**< Average read bytes/s */
+	u64 WrBandwidthPeak;		/**< Highest interval write bytes/s */
+	u64 RdBandwidthPeak;		/**< Highest interval read bytes/s */
+	u32 WrLatency;			/**< Average write latency, clocks */
+	u32 RdLatency;			/**< Average read latency, clocks */
+	u32 WrLatencyPct[XAPM_SAMPLER_NUM_PCT];	/**< Interval average write
+						  *  latency percentiles */
+	u32 RdLatencyPct[XAPM_SAMPLER_NUM_PCT];	/**< Interval average read
+						  *  latency percentiles */
+	u32 WrOutstanding;		/**< Average outstanding writes x 100 */
+	u32 RdOutstanding;		/**< Average outstanding reads x 100 */
+} XAxiPmon_SlotSummary;
+
+/**
+ * The sampling service instance.
+ */
+typedef struct {
+	XAxiPmon *InstancePtr;		/**< APM instance */
+	XAxiPmon_Sample *Samples;	/**< Sample ring */
+	u32 *Scratch;			/**< NumSamples words for the summary */
+	u32 NumSamples;			/**< Ring size, a power of 2 */
+	volatile u32 Head;		/**< Samples produced */
+	volatile u32 Tail;		/**< Samples consumed */
+	volatile u32 Dropped;		/**< Samples lost to a full ring */
+	volatile u32 FifoFull;		/**< Event log FIFO full events */
+	u32 SampleInterval;		/**< Interval in APM clocks */
+	u32 ClockHz;			/**< APM clock frequency */
+	u8 NumCounters;			/**< Counters assigned */
+	u8 SlotSets[XAPM_MAX_AGENTS];	/**< Metric sets per slot */
+	XAxiPmon_SlotCounters Slots[XAPM_MAX_AGENTS]; /**< Counters per
+							 *  slot */
+} XAxiPmon_Sampler;
+
+/************************** Function Prototypes *****************************/
+
+/**
+ * Functions in xaxipmon_sampler.c
+ */
+s32 XAxiPmon_SamplerInit(XAxiPmon_Sampler *SamplerPtr, XAxiPmon *InstancePtr,
+			XAxiPmon_Sample *Samples, u32 *Scratch,
+			u32 NumSamples, u32 ClockHz);
+
+s32 XAxiPmon_SamplerSetSlot(XAxiPmon_Sampler *SamplerPtr, u8 Slot,
+			u8 MetricSets);
+
+s32 XAxiPmon_SamplerStart(XAxiPmon_Sampler *SamplerPtr, u32 SampleInterval);
+
+s32 XAxiPmon_SamplerStop(XAxiPmon_Sampler *SamplerPtr);
+
+s32 XAxiPmon_SamplerStartEventLog(XAxiPmon_Sampler *SamplerPtr,
+			u32 FlagEnables);
+
+void XAxiPmon_SamplerIntrHandler(void *CallBackRef);
+
+u32 XAxiPmon_SamplerRead(XAxiPmon_Sampler *SamplerPtr,
+			XAxiPmon_Sample *SamplePtr);
+
+s32 XAxiPmon_SamplerGetSummary(XAxiPmon_Sampler *SamplerPtr, u8 Slot,
+			XAxiPmon_SlotSummary *SummaryPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* End of protection macro. */
+/** @} */
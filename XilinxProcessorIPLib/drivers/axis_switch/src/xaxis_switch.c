@@ -42,6 +42,8 @@
 * 1.1   sk  08/16/16 Used UINTPTR instead of u32 for Baseaddress as part of
 *                    adding 64 bit support. CR# 867425.
 *                    Changed the prototype of XAxisScr_CfgInitialize API.
+* 1.3   adk 10/15/19 Track the MI MUX register values in the instance.
+*                    Added the route table functions.
 * </pre>
 *
 ******************************************************************************/
@@ -146,6 +148,7 @@ void XAxisScr_MiPortEnable(XAxis_Switch *InstancePtr, u8 MiIndex, u8 SiIndex)
 	/* MUX[MiIndex] is sourced from SI[SiIndex] */
 	XAxisScr_WriteReg(InstancePtr->Config.BaseAddress, MiPortAddr,
 				SiIndex);
+	InstancePtr->MiMux[MiIndex] = SiIndex;
 }
 
 /*****************************************************************************/
@@ -178,6 +181,7 @@ void XAxisScr_MiPortDisable(XAxis_Switch *InstancePtr, u8 MiIndex)
 
 	XAxisScr_WriteReg(InstancePtr->Config.BaseAddress, MiPortAddr,
 				XAXIS_SCR_MI_X_DISABLE_MASK);
+	InstancePtr->MiMux[MiIndex] = XAXIS_SCR_MI_X_DISABLE_MASK;
 }
 
 /*****************************************************************************/
@@ -305,6 +309,186 @@ void XAxisScr_MiPortDisableAll(XAxis_Switch *InstancePtr)
 
 		XAxisScr_WriteReg(InstancePtr->Config.BaseAddress, MiPortAddr,
 				XAXIS_SCR_MI_X_DISABLE_MASK);
+		InstancePtr->MiMux[Index] = XAXIS_SCR_MI_X_DISABLE_MASK;
 	}
 }
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a route table with all the MUX ports disabled.
+*
+* @param	TablePtr is a pointer to the route table.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XAxisScr_RouteTableInit(XAxis_Switch_RouteTable *TablePtr)
+{
+	u8 Index;
+
+	/* Verify argument. */
+	Xil_AssertVoid(TablePtr != NULL);
+
+	for (Index = 0; Index < XAXIS_SCR_MAX_MI; Index++) {
+		TablePtr->MiMux[Index] = XAXIS_SCR_MI_X_DISABLE_MASK;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the route of a MUX port in a route table.
+*
+* @param	TablePtr is a pointer to the route table.
+* @param	MiIndex specifies the MUX which is within the range [0 to 15].
+* @param	SiIndex specifies the SI sourcing the MUX. The range is
+*		[0 to 15].
+*
+* @return	None.
+*
+* @note		Several MUX ports may be sourced from the same SI.
+*
+******************************************************************************/
+void XAxisScr_RouteTableSet(XAxis_Switch_RouteTable *TablePtr, u8 MiIndex,
+				u8 SiIndex)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(TablePtr != NULL);
+	Xil_AssertVoid(MiIndex < XAXIS_SCR_MAX_MI);
+	Xil_AssertVoid(SiIndex <= XAXIS_SCR_MI_X_MUX_MASK);
+
+	TablePtr->MiMux[MiIndex] = SiIndex;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function disables a MUX port in a route table.
+*
+* @param	TablePtr is a pointer to the route table.
+* @param	MiIndex specifies the MUX which is within the range [0 to 15].
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XAxisScr_RouteTableClear(XAxis_Switch_RouteTable *TablePtr, u8 MiIndex)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(TablePtr != NULL);
+	Xil_AssertVoid(MiIndex < XAXIS_SCR_MAX_MI);
+
+	TablePtr->MiMux[MiIndex] = XAXIS_SCR_MI_X_DISABLE_MASK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the routing programmed by the driver, as a starting
+* point for the next route table.
+*
+* @param	InstancePtr is a pointer to the XAxis_Switch core instance.
+* @param	TablePtr is a pointer to the route table to fill.
+*
+* @return	None.
+*
+* @note		The MUX ports which do not exist in the core are disabled.
+*
+******************************************************************************/
+void XAxisScr_GetRouteTable(XAxis_Switch *InstancePtr,
+				XAxis_Switch_RouteTable *TablePtr)
+{
+	u8 Index;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(TablePtr != NULL);
+
+	for (Index = 0; Index < XAXIS_SCR_MAX_MI; Index++) {
+		TablePtr->MiMux[Index] =
+			(Index < InstancePtr->Config.MaxNumMI) ?
+			InstancePtr->MiMux[Index] :
+			XAXIS_SCR_MI_X_DISABLE_MASK;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function programs a route table. Only the MI MUX registers whose value
+* changes are written, then a single register update applies all of them at
+* once and the function waits until the core has taken the update.
+*
+* @param	InstancePtr is a pointer to the XAxis_Switch core instance.
+* @param	TablePtr is a pointer to the route table.
+*
+* @return
+*		- XST_SUCCESS if the routing is applied, or already was.
+*		- XST_INVALID_PARAM if a MUX port is sourced from a SI which
+*		  does not exist in the core.
+*		- XST_FAILURE if the register update bit did not clear within
+*		  XAXIS_SCR_UPDATE_TIMEOUT polls. The registers are written and
+*		  the update is left pending.
+*
+* @note		Entries beyond the number of MI ports of the core are ignored.
+*
+******************************************************************************/
+s32 XAxisScr_RouteTableCommit(XAxis_Switch *InstancePtr,
+				const XAxis_Switch_RouteTable *TablePtr)
+{
+	u32 MiPortAddr;
+	u32 Timeout = XAXIS_SCR_UPDATE_TIMEOUT;
+	u32 Changed = 0;
+	u8 Index;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(TablePtr != NULL);
+
+	for (Index = 0; Index < InstancePtr->Config.MaxNumMI; Index++) {
+		if ((TablePtr->MiMux[Index] != XAXIS_SCR_MI_X_DISABLE_MASK) &&
+		    (TablePtr->MiMux[Index] >= InstancePtr->Config.MaxNumSI)) {
+			return XST_INVALID_PARAM;
+		}
+	}
+
+	for (Index = 0; Index < InstancePtr->Config.MaxNumMI; Index++) {
+		if (TablePtr->MiMux[Index] == InstancePtr->MiMux[Index]) {
+			continue;
+		}
+
+		/* Calculate MI port address of which to be changed */
+		MiPortAddr = XAXIS_SCR_MI_MUX_START_OFFSET + 4 * Index;
+
+		XAxisScr_WriteReg(InstancePtr->Config.BaseAddress, MiPortAddr,
+				TablePtr->MiMux[Index]);
+		InstancePtr->MiMux[Index] = TablePtr->MiMux[Index];
+		Changed++;
+	}
+
+	if (Changed == 0) {
+		return XST_SUCCESS;
+	}
+
+	/* Commit all the MI MUX registers with a single update */
+	XAxisScr_WriteReg(InstancePtr->Config.BaseAddress,
+			XAXIS_SCR_CTRL_OFFSET, XAXIS_SCR_CTRL_REG_UPDATE_MASK);
+
+	while ((XAxisScr_ReadReg(InstancePtr->Config.BaseAddress,
+			XAXIS_SCR_CTRL_OFFSET) &
+			XAXIS_SCR_CTRL_REG_UPDATE_MASK) != 0) {
+		if (Timeout == 0) {
+			return XST_FAILURE;
+		}
+		Timeout--;
+	}
+
+	return XST_SUCCESS;
+}
 /** @} */
@@ -50,6 +50,16 @@
 * - Call XAxisScr_CfgInitialize to initialize the device and the driver
 *   instance associated with it.
 *
+* <b>Route Tables</b>
+*
+* A route table holds the source of every MI MUX. The application builds the
+* complete routing with XAxisScr_RouteTableInit, XAxisScr_RouteTableSet and
+* XAxisScr_RouteTableClear, or starts from the active routing returned by
+* XAxisScr_GetRouteTable, and applies it with XAxisScr_RouteTableCommit.
+* The driver tracks the value of every MI MUX register, so the commit only
+* writes the registers which change and then issues a single register update
+* for all of them. The switch applies the new routing atomically.
+*
 * <b>Interrupts </b>
 *
 * This driver does not have interrupt mechanism.
@@ -90,6 +100,9 @@
 *                    fix for CR-969126.
 *       ms  03/17/17 Added readme.txt file in examples folder for doxygen
 *                    generation.
+* 1.3   adk 10/15/19 Added route tables, XAxisScr_RouteTableCommit() writes
+*                    the changed MI MUX registers and commits them with a
+*                    single register update.
 * </pre>
 *
 ******************************************************************************/
@@ -109,6 +122,9 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+#define XAXIS_SCR_MAX_MI		16	/**< Maximum number of MI ports */
+#define XAXIS_SCR_UPDATE_TIMEOUT	1000000	/**< Polls of the register
+						  *  update bit */
 
 /**************************** Type Definitions *******************************/
 
@@ -134,8 +150,17 @@ typedef struct {
 	XAxis_Switch_Config Config;	/**< Hardware Configuration */
 	u32 IsReady;			/**< Core and the driver instance are
 					  *  initialized */
+	u32 MiMux[XAXIS_SCR_MAX_MI];	/**< Value of the MI MUX registers */
 } XAxis_Switch;
 
+/**
+* Route table. Each entry is the value of a MI MUX register: the SI index
+* sourcing the MI, or XAXIS_SCR_MI_X_DISABLE_MASK when the MI is disabled.
+*/
+typedef struct {
+	u32 MiMux[XAXIS_SCR_MAX_MI];	/**< MI MUX register values */
+} XAxis_Switch_RouteTable;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -195,6 +220,16 @@ s32 XAxisScr_IsMiPortEnabled(XAxis_Switch *InstancePtr, u8 MiIndex,
 s32 XAxisScr_IsMiPortDisabled(XAxis_Switch *InstancePtr, u8 MiIndex);
 void XAxisScr_MiPortDisableAll(XAxis_Switch *InstancePtr);
 
+void XAxisScr_RouteTableInit(XAxis_Switch_RouteTable *TablePtr);
+void XAxisScr_RouteTableSet(XAxis_Switch_RouteTable *TablePtr, u8 MiIndex,
+				u8 SiIndex);
+void XAxisScr_RouteTableClear(XAxis_Switch_RouteTable *TablePtr,
+				u8 MiIndex);
+void XAxisScr_GetRouteTable(XAxis_Switch *InstancePtr,
+				XAxis_Switch_RouteTable *TablePtr);
+s32 XAxisScr_RouteTableCommit(XAxis_Switch *InstancePtr,
+				const XAxis_Switch_RouteTable *TablePtr);
+
 /* Self test function in xaxis_switch_selftest.c */
 s32 XAxisScr_SelfTest(XAxis_Switch *InstancePtr);
 
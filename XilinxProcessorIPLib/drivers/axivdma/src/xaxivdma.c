@@ -155,6 +155,10 @@ int XAxiVdma_CfgInitialize(XAxiVdma *InstancePtr, XAxiVdma_Config *CfgPtr,
 	InstancePtr->WriteCallBack.CompletionCallBack = 0x0;
 	InstancePtr->WriteCallBack.ErrCallBack = 0x0;
 
+	/* The frame store ring is not running
+	 */
+	InstancePtr->WriteRing.IsActive = 0;
+
 	InstancePtr->BaseAddr = EffectiveAddr;
 	InstancePtr->MaxNumFrames = CfgPtr->MaxFrameStoreNum;
 	InstancePtr->HasMm2S = CfgPtr->HasMm2S;
@@ -119,6 +119,28 @@
 * Each channel has two interrupt callback functions. One for IOC and delay
 * interrupt, or general interrupt; one for error interrupt.
 *
+* <b>Frame Store Ring</b>
+*
+* For software that processes captured frames, the write channel can be run
+* as a frame store ring instead of tracking XAxiVdma_CurrFrameStore() by
+* hand:
+*
+* - XAxiVdma_RingStart() configures and starts the write channel in park
+*   mode over at least three frame stores, with the frame count interrupt
+*   enabled.
+* - On each completed frame XAxiVdma_WriteIntrHandler() records the frame
+*   store as the latest frame and parks the channel on a frame store that is
+*   neither the latest frame nor the frame held by the consumer. When the
+*   read channel is running it also avoids the frame store being read, so a
+*   genlocked display is not overwritten.
+* - XAxiVdma_RingAcquire() hands the latest completed frame to the consumer
+*   and XAxiVdma_RingRelease() returns it. Frames are never copied.
+* - A frame that is superseded before the consumer acquires it is counted as
+*   skipped, so a slow consumer always gets the freshest frame.
+*
+* The write interrupt handler must be connected. The frame count threshold
+* must stay at one so the handler runs for every frame.
+*
 * <b>Reset</b>
 *
 * Reset a DMA channel causes the channel enter the following state:
@@ -510,6 +532,34 @@ typedef struct {
     void *ErrRef;                         /**< Call back ref */
 } XAxiVdma_ChannelCallBack;
 
+/**
+ * The XAxiVdma_RingFrame structure describes a frame handed to the consumer
+ * of the frame store ring.
+ */
+typedef struct {
+    int FrameIndex;        /**< Frame store index */
+    UINTPTR Addr;          /**< Start address of the frame store */
+    u32 Sequence;          /**< Sequence number of the completed frame */
+} XAxiVdma_RingFrame;
+
+/**
+ * The XAxiVdma_FrameRing structure contains the state of the write channel
+ * frame store ring.
+ */
+typedef struct {
+    int IsActive;          /**< Whether the ring drives the write channel */
+    int NumFrames;         /**< Number of frame stores in the ring */
+    UINTPTR FrameAddr[XAXIVDMA_MAX_FRAMESTORE];
+                           /**< Start addresses of the frame stores */
+    int WriteFrame;        /**< Frame store the channel is parked on */
+    int LatestFrame;       /**< Latest completed frame store, -1 if none */
+    int HeldFrame;         /**< Frame store held by consumer, -1 if none */
+    u32 LatestSequence;    /**< Sequence number of the latest frame */
+    u32 Completed;         /**< Number of completed frames */
+    u32 Acquired;          /**< Number of frames handed to the consumer */
+    u32 Skipped;           /**< Number of frames superseded unacquired */
+} XAxiVdma_FrameRing;
+
 /**
  * The XAxiVdma driver instance data.
  */
@@ -534,6 +584,7 @@ typedef struct {
     XAxiVdma_Channel ReadChannel;  /**< Channel to read from memory */
     XAxiVdma_Channel WriteChannel; /**< Channel to write to memory */
 	int AddrWidth;		  /**< Address Width */
+    XAxiVdma_FrameRing WriteRing;  /**< Frame store ring of write channel */
 } XAxiVdma;
 
 
@@ -608,6 +659,16 @@ int XAxiVdma_SetCallBack(XAxiVdma * InstancePtr, u32 HandlerType,
         void *CallBackFunc, void *CallBackRef, u16 Direction);
 int XAxiVdma_Selftest(XAxiVdma * InstancePtr);
 
+/*
+ * Frame store ring functions in xaxivdma_ring.c
+ */
+int XAxiVdma_RingStart(XAxiVdma *InstancePtr,
+        XAxiVdma_DmaSetup *DmaConfigPtr);
+void XAxiVdma_RingStop(XAxiVdma *InstancePtr);
+int XAxiVdma_RingAcquire(XAxiVdma *InstancePtr, XAxiVdma_RingFrame *FramePtr);
+int XAxiVdma_RingRelease(XAxiVdma *InstancePtr, int FrameIndex);
+void XAxiVdma_RingFrameDone(XAxiVdma *InstancePtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -319,6 +319,15 @@ void XAxiVdma_WriteIntrHandler(void * InstancePtr)
 
 	XAxiVdma_ChannelIntrClear(Channel, PendingIntr);
 
+	/* Advance the frame store ring, if the channel runs one
+	 */
+	if (DmaPtr->WriteRing.IsActive &&
+	    (PendingIntr & XAXIVDMA_IXR_FRMCNT_MASK) &&
+	    !(PendingIntr & XAXIVDMA_IXR_ERROR_MASK)) {
+
+		XAxiVdma_RingFrameDone(DmaPtr);
+	}
+
 	CallBack = &(DmaPtr->WriteCallBack);
 
 	if (!CallBack->CompletionCallBack) {
@@ -0,0 +1,419 @@
+/******************************************************************************
+*
+* Copyright (C) 2012 - 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaxivdma_ring.c
+* @addtogroup axivdma_v6_6
+* @{
+*
+* Implementation of the write channel frame store ring.
+*
+* The hardware cannot skip a frame store in circular mode, so the ring runs
+* the write channel in park mode and moves the park pointer from the write
+* interrupt handler once per frame. With one frame store being written, one
+* holding the latest frame and one held by the consumer, the ring needs at
+* least three frame stores.
+*
+* The handler must run before the next frame sync, otherwise the channel
+* writes the same frame store again.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   ms   10/15/18 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xaxivdma.h"
+#include "xaxivdma_i.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XAXIVDMA_RING_MIN_FRAMES	3	/**< Write, latest and held */
+#define XAXIVDMA_RING_NO_FRAME		(-1)	/**< No frame store */
+
+/************************** Function Prototypes ******************************/
+
+static u32 XAxiVdma_RingLock(XAxiVdma_Channel *Channel);
+static void XAxiVdma_RingUnlock(XAxiVdma_Channel *Channel, u32 IntrMask);
+static int XAxiVdma_RingReadFrame(XAxiVdma *InstancePtr);
+
+/*****************************************************************************/
+/**
+ * Start the write channel as a frame store ring
+ *
+ * The channel is configured with the frame store addresses in the setup
+ * structure, started, and parked on the first frame store. The frame count
+ * interrupt is enabled with a threshold of one frame. Other enabled
+ * interrupts are not affected.
+ *
+ * @param InstancePtr is the pointer to the DMA engine to work on
+ * @param DmaConfigPtr is the pointer to the setup structure. The number of
+ *        frame stores is the number of frame stores of the channel.
+ *
+ * @return
+ * - XST_SUCCESS if the ring is running
+ * - XST_DEVICE_NOT_FOUND if the write channel is invalid
+ * - XST_INVALID_PARAM if the channel has less than three frame stores
+ * - XST_DEVICE_BUSY if the ring is already running
+ * - Other error code from starting the transfer
+ *
+ *****************************************************************************/
+int XAxiVdma_RingStart(XAxiVdma *InstancePtr,
+        XAxiVdma_DmaSetup *DmaConfigPtr)
+{
+	XAxiVdma_Channel *Channel;
+	XAxiVdma_FrameRing *Ring;
+	int Status;
+	int Index;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(DmaConfigPtr != NULL);
+
+	Channel = XAxiVdma_GetChannel(InstancePtr, XAXIVDMA_WRITE);
+	Ring = &InstancePtr->WriteRing;
+
+	if (!Channel->IsValid) {
+		return XST_DEVICE_NOT_FOUND;
+	}
+
+	if (Ring->IsActive) {
+		return XST_DEVICE_BUSY;
+	}
+
+	if (Channel->NumFrames < XAXIVDMA_RING_MIN_FRAMES) {
+		xdbg_printf(XDBG_DEBUG_ERROR,
+		    "Frame store ring needs %d frames, channel has %d\r\n",
+		    XAXIVDMA_RING_MIN_FRAMES, Channel->NumFrames);
+
+		return XST_INVALID_PARAM;
+	}
+
+	Ring->NumFrames = Channel->NumFrames;
+	for (Index = 0; Index < Ring->NumFrames; Index++) {
+		Ring->FrameAddr[Index] = DmaConfigPtr->FrameStoreStartAddr[Index];
+	}
+	Ring->WriteFrame = 0;
+	Ring->LatestFrame = XAXIVDMA_RING_NO_FRAME;
+	Ring->HeldFrame = XAXIVDMA_RING_NO_FRAME;
+	Ring->LatestSequence = 0;
+	Ring->Completed = 0;
+	Ring->Acquired = 0;
+	Ring->Skipped = 0;
+
+	Status = XAxiVdma_StartWriteFrame(InstancePtr, DmaConfigPtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Status = XAxiVdma_StartParking(InstancePtr, Ring->WriteFrame,
+	    XAXIVDMA_WRITE);
+	if (Status != XST_SUCCESS) {
+		XAxiVdma_DmaStop(InstancePtr, XAXIVDMA_WRITE);
+		return Status;
+	}
+
+	/* Without the debug frame counter the threshold stays at its reset
+	 * value of one
+	 */
+	Status = XAxiVdma_ChannelSetFrmCnt(Channel, 1, 0);
+	if ((Status != XST_SUCCESS) && (Status != XST_NO_FEATURE)) {
+		XAxiVdma_DmaStop(InstancePtr, XAXIVDMA_WRITE);
+		return Status;
+	}
+
+	Ring->IsActive = 1;
+
+	XAxiVdma_ChannelEnableIntr(Channel,
+	    XAxiVdma_ChannelGetEnabledIntr(Channel) |
+	    XAXIVDMA_IXR_FRMCNT_MASK);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Stop the write channel frame store ring
+ *
+ * The frame count interrupt is disabled and the write channel is stopped.
+ * A frame held by the consumer stays valid until it is overwritten by a
+ * new transfer.
+ *
+ * @param InstancePtr is the pointer to the DMA engine to work on
+ *
+ * @return
+ *  None
+ *
+ *****************************************************************************/
+void XAxiVdma_RingStop(XAxiVdma *InstancePtr)
+{
+	XAxiVdma_Channel *Channel;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if (!InstancePtr->WriteRing.IsActive) {
+		return;
+	}
+
+	Channel = XAxiVdma_GetChannel(InstancePtr, XAXIVDMA_WRITE);
+
+	XAxiVdma_ChannelDisableIntr(Channel, XAXIVDMA_IXR_FRMCNT_MASK);
+	InstancePtr->WriteRing.IsActive = 0;
+
+	XAxiVdma_DmaStop(InstancePtr, XAXIVDMA_WRITE);
+}
+
+/*****************************************************************************/
+/**
+ * Acquire the latest completed frame of the write channel
+ *
+ * The frame store is not written by the hardware until it is released with
+ * XAxiVdma_RingRelease(). Only one frame can be held at a time.
+ *
+ * @param InstancePtr is the pointer to the DMA engine to work on
+ * @param FramePtr is the pointer to the frame description to fill in
+ *
+ * @return
+ * - XST_SUCCESS if a frame was acquired
+ * - XST_NO_DATA if no frame completed since the last acquire
+ * - XST_DEVICE_BUSY if a frame is already held
+ * - XST_FAILURE if the ring is not running
+ *
+ *****************************************************************************/
+int XAxiVdma_RingAcquire(XAxiVdma *InstancePtr, XAxiVdma_RingFrame *FramePtr)
+{
+	XAxiVdma_Channel *Channel;
+	XAxiVdma_FrameRing *Ring;
+	u32 IntrMask;
+	int Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(FramePtr != NULL);
+
+	Ring = &InstancePtr->WriteRing;
+
+	if (!Ring->IsActive) {
+		return XST_FAILURE;
+	}
+
+	Channel = XAxiVdma_GetChannel(InstancePtr, XAXIVDMA_WRITE);
+	IntrMask = XAxiVdma_RingLock(Channel);
+
+	if (Ring->HeldFrame != XAXIVDMA_RING_NO_FRAME) {
+		Status = XST_DEVICE_BUSY;
+	}
+	else if (Ring->LatestFrame == XAXIVDMA_RING_NO_FRAME) {
+		Status = XST_NO_DATA;
+	}
+	else {
+		Ring->HeldFrame = Ring->LatestFrame;
+		Ring->LatestFrame = XAXIVDMA_RING_NO_FRAME;
+		Ring->Acquired++;
+
+		FramePtr->FrameIndex = Ring->HeldFrame;
+		FramePtr->Addr = Ring->FrameAddr[Ring->HeldFrame];
+		FramePtr->Sequence = Ring->LatestSequence;
+
+		Status = XST_SUCCESS;
+	}
+
+	XAxiVdma_RingUnlock(Channel, IntrMask);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Release a frame acquired with XAxiVdma_RingAcquire()
+ *
+ * @param InstancePtr is the pointer to the DMA engine to work on
+ * @param FrameIndex is the frame store index of the acquired frame
+ *
+ * @return
+ * - XST_SUCCESS if the frame was released
+ * - XST_INVALID_PARAM if the frame is not held
+ *
+ *****************************************************************************/
+int XAxiVdma_RingRelease(XAxiVdma *InstancePtr, int FrameIndex)
+{
+	XAxiVdma_Channel *Channel;
+	XAxiVdma_FrameRing *Ring;
+	u32 IntrMask;
+	int Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	Ring = &InstancePtr->WriteRing;
+	Channel = XAxiVdma_GetChannel(InstancePtr, XAXIVDMA_WRITE);
+	IntrMask = XAxiVdma_RingLock(Channel);
+
+	if ((FrameIndex == XAXIVDMA_RING_NO_FRAME) ||
+	    (FrameIndex != Ring->HeldFrame)) {
+		Status = XST_INVALID_PARAM;
+	}
+	else {
+		Ring->HeldFrame = XAXIVDMA_RING_NO_FRAME;
+		Status = XST_SUCCESS;
+	}
+
+	XAxiVdma_RingUnlock(Channel, IntrMask);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Advance the write channel frame store ring after a completed frame
+ *
+ * This function is called by XAxiVdma_WriteIntrHandler() on a frame count
+ * interrupt. The frame store just written becomes the latest frame, and the
+ * channel is parked on the next frame store that is neither the latest
+ * frame nor the held frame. When the read channel is running, the frame
+ * store it reads is avoided as well.
+ *
+ * @param InstancePtr is the pointer to the DMA engine to work on
+ *
+ * @return
+ *  None
+ *
+ *****************************************************************************/
+void XAxiVdma_RingFrameDone(XAxiVdma *InstancePtr)
+{
+	XAxiVdma_FrameRing *Ring;
+	int ReadFrame;
+	int Fallback;
+	int Next;
+	int Index;
+
+	Ring = &InstancePtr->WriteRing;
+
+	if (Ring->LatestFrame != XAXIVDMA_RING_NO_FRAME) {
+		Ring->Skipped++;
+	}
+
+	Ring->LatestFrame = Ring->WriteFrame;
+	Ring->LatestSequence = ++Ring->Completed;
+
+	ReadFrame = XAxiVdma_RingReadFrame(InstancePtr);
+	Fallback = XAXIVDMA_RING_NO_FRAME;
+	Next = XAXIVDMA_RING_NO_FRAME;
+
+	for (Index = 1; Index <= Ring->NumFrames; Index++) {
+		int Frame = (Ring->LatestFrame + Index) % Ring->NumFrames;
+
+		if ((Frame == Ring->LatestFrame) || (Frame == Ring->HeldFrame)) {
+			continue;
+		}
+
+		if (Fallback == XAXIVDMA_RING_NO_FRAME) {
+			Fallback = Frame;
+		}
+
+		if (Frame != ReadFrame) {
+			Next = Frame;
+			break;
+		}
+	}
+
+	if (Next == XAXIVDMA_RING_NO_FRAME) {
+		Next = Fallback;
+	}
+
+	Ring->WriteFrame = Next;
+
+	XAxiVdma_StartParking(InstancePtr, Next, XAXIVDMA_WRITE);
+}
+
+/*****************************************************************************/
+/*
+ * Block the frame count interrupt of the write channel
+ *
+ * @param Channel is the pointer to the write channel
+ *
+ * @return
+ *  The enabled interrupts before the call
+ *
+ *****************************************************************************/
+static u32 XAxiVdma_RingLock(XAxiVdma_Channel *Channel)
+{
+	u32 IntrMask;
+
+	IntrMask = XAxiVdma_ChannelGetEnabledIntr(Channel);
+
+	if (IntrMask & XAXIVDMA_IXR_FRMCNT_MASK) {
+		XAxiVdma_ChannelDisableIntr(Channel, XAXIVDMA_IXR_FRMCNT_MASK);
+	}
+
+	return IntrMask;
+}
+
+/*****************************************************************************/
+/*
+ * Restore the write channel interrupts saved by XAxiVdma_RingLock()
+ *
+ * @param Channel is the pointer to the write channel
+ * @param IntrMask is the value returned by XAxiVdma_RingLock()
+ *
+ * @return
+ *  None
+ *
+ *****************************************************************************/
+static void XAxiVdma_RingUnlock(XAxiVdma_Channel *Channel, u32 IntrMask)
+{
+	if (IntrMask & XAXIVDMA_IXR_FRMCNT_MASK) {
+		XAxiVdma_ChannelEnableIntr(Channel, IntrMask);
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Get the frame store the read channel is reading
+ *
+ * @param InstancePtr is the pointer to the DMA engine to work on
+ *
+ * @return
+ *  The frame store index, or -1 if the read channel is not running
+ *
+ *****************************************************************************/
+static int XAxiVdma_RingReadFrame(XAxiVdma *InstancePtr)
+{
+	XAxiVdma_Channel *Channel;
+
+	Channel = XAxiVdma_GetChannel(InstancePtr, XAXIVDMA_READ);
+
+	if (!Channel->IsValid || !XAxiVdma_ChannelIsRunning(Channel)) {
+		return XAXIVDMA_RING_NO_FRAME;
+	}
+
+	return (int)XAxiVdma_CurrFrameStore(InstancePtr, XAXIVDMA_READ);
+}
+/** @} */
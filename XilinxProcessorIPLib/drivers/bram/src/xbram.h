@@ -118,6 +118,9 @@
 *       ms  08/07/17 Fixed compilation warnings in xbram_sinit.c
 * 4.3   aru 03/23/19 Used UINTPTR instead of u32 for MemBaseAddress and
 *                    MemHighAddress.
+*       adk 10/15/19 Added the ECC scrub service in xbram_scrub.c, which
+*                    corrects the BRAM in background slices and logs the
+*                    errors found.
 * </pre>
 *****************************************************************************/
 #ifndef XBRAM_H		/* prevent circular inclusions */
@@ -136,6 +139,14 @@ extern "C" {
 
 /************************** Constant Definitions ****************************/
 
+/** @name Scrub service
+ * @{
+ */
+#define XBRAM_SCRUB_BLOCK_WORDS	8  /**< Words read between ECC status
+					 *  checks */
+#define XBRAM_SCRUB_LOG_SIZE	16 /**< Entries in the scrub error log */
+/*@}*/
+
 
 /**************************** Type Definitions ******************************/
 
@@ -183,6 +194,35 @@ typedef struct {
 	u32 IsReady;			/* Device is initialized and ready */
 } XBram;
 
+/**
+ * Scrub error log entry.
+ */
+typedef struct {
+	UINTPTR Address;	/**< Address of the failing word */
+	u32 Pass;		/**< Scrub pass in which it was found */
+	u32 Type;		/**< XBRAM_IR_CE_MASK or XBRAM_IR_UE_MASK */
+} XBram_ScrubLogEntry;
+
+/**
+ * The XBram scrub service instance data, see xbram_scrub.c. The user is
+ * required to allocate a variable of this type for each scrubbed BRAM.
+ */
+typedef struct {
+	XBram *Bram;			/**< BRAM instance scrubbed */
+	u32 WordsPerSlice;		/**< Words read by each slice */
+	UINTPTR BaseAddress;		/**< First byte of the region */
+	UINTPTR HighAddress;		/**< Last byte of the region */
+	UINTPTR NextAddress;		/**< Start of the next slice */
+	u32 Passes;			/**< Complete passes over the region */
+	u32 CeCount;			/**< Correctable errors found */
+	u32 UeCount;			/**< Uncorrectable errors found */
+	u32 Corrected;			/**< Words written back */
+	XBram_ScrubLogEntry Log[XBRAM_SCRUB_LOG_SIZE]; /**< Error log */
+	u32 LogHead;			/**< Next log entry written */
+	u32 LogCount;			/**< Log entries not read yet */
+	u32 LogLost;			/**< Log entries overwritten */
+} XBram_Scrub;
+
 /***************** Macros (Inline Functions) Definitions ********************/
 
 
@@ -213,6 +253,17 @@ void XBram_InterruptClear(XBram *InstancePtr, u32 Mask);
 u32 XBram_InterruptGetEnabled(XBram *InstancePtr);
 u32 XBram_InterruptGetStatus(XBram *InstancePtr);
 
+/*
+ * Functions implemented in xbram_scrub.c
+ */
+int XBram_ScrubInitialize(XBram_Scrub *ScrubPtr, XBram *InstancePtr,
+			  u32 WordsPerSlice);
+int XBram_ScrubSetRegion(XBram_Scrub *ScrubPtr, UINTPTR BaseAddress,
+			 UINTPTR HighAddress);
+u32 XBram_ScrubSlice(XBram_Scrub *ScrubPtr);
+u32 XBram_ScrubGetLog(XBram_Scrub *ScrubPtr, XBram_ScrubLogEntry *Entries,
+		      u32 MaxEntries);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,348 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xbram_scrub.c
+* @addtogroup bram_v4_2
+* @{
+*
+* Implements the ECC scrub service of the XBram driver. See xbram.h for more
+* information about the driver.
+*
+* The BRAM controller corrects single bit errors on the data it returns but
+* does not write the corrected data back, so errors stay in the memory until
+* the location is written, and a second upset in the same word makes the
+* error uncorrectable. The scrub service reads a region of the BRAM a slice
+* at a time, writes back the words with a correctable error and logs the
+* address of each error found. XBram_ScrubSlice() is meant to be called
+* periodically, from a timer task or an idle hook, the number of words read
+* by each call bounds its execution time.
+*
+* The functions in this file require the hardware device to be built with
+* ECC and with the ECC status register.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 4.3   adk  10/15/19 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+#include <string.h>
+#include "xbram.h"
+#include "xil_cache.h"
+
+/************************** Constant Definitions ****************************/
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+#define RD(reg)		XBram_ReadReg(InstancePtr->Config.CtrlBaseAddress, \
+					XBRAM_ ## reg)
+#define WR(reg, data)	XBram_WriteReg(InstancePtr->Config.CtrlBaseAddress, \
+						XBRAM_ ## reg, data)
+
+/************************** Variable Definitions ****************************/
+
+/************************** Function Prototypes *****************************/
+static void ScrubLog(XBram_Scrub *ScrubPtr, UINTPTR Addr, u32 Type);
+static void ScrubBlock(XBram_Scrub *ScrubPtr, UINTPTR Addr, u32 Words);
+
+
+/****************************************************************************/
+/**
+* Initialize the scrub service of a BRAM. The scrubbed region is the whole
+* memory of the BRAM, see XBram_ScrubSetRegion() to restrict it.
+*
+* @param	ScrubPtr is the scrub instance to initialize, allocated by the
+*		user.
+* @param	InstancePtr is the BRAM instance to scrub.
+* @param	WordsPerSlice is the number of 32 bit words read by each call
+*		of XBram_ScrubSlice().
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_NO_FEATURE if the BRAM has no ECC or no ECC status
+*		register.
+*
+* @note		Without write access to the BRAM, the errors are detected
+*		and logged but not corrected.
+*
+*****************************************************************************/
+int XBram_ScrubInitialize(XBram_Scrub *ScrubPtr, XBram *InstancePtr,
+			  u32 WordsPerSlice)
+{
+	Xil_AssertNonvoid(ScrubPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(WordsPerSlice != 0);
+
+	if (!InstancePtr->Config.EccPresent ||
+	    !InstancePtr->Config.EccStatusInterruptPresent ||
+	    InstancePtr->Config.CtrlBaseAddress == 0) {
+		return XST_NO_FEATURE;
+	}
+
+	memset(ScrubPtr, 0, sizeof(*ScrubPtr));
+	ScrubPtr->Bram = InstancePtr;
+	ScrubPtr->WordsPerSlice = WordsPerSlice;
+	ScrubPtr->BaseAddress = InstancePtr->Config.MemBaseAddress;
+	ScrubPtr->HighAddress = InstancePtr->Config.MemHighAddress;
+	ScrubPtr->NextAddress = ScrubPtr->BaseAddress;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* Restrict the scrub to a region of the BRAM, the next slice starts at the
+* beginning of the region.
+*
+* @param	ScrubPtr is the scrub instance.
+* @param	BaseAddress is the first byte of the region.
+* @param	HighAddress is the last byte of the region.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the region is not a word aligned part of
+*		the BRAM memory.
+*
+* @note		None.
+*
+*****************************************************************************/
+int XBram_ScrubSetRegion(XBram_Scrub *ScrubPtr, UINTPTR BaseAddress,
+			 UINTPTR HighAddress)
+{
+	XBram_Config *ConfigPtr;
+
+	Xil_AssertNonvoid(ScrubPtr != NULL);
+	Xil_AssertNonvoid(ScrubPtr->Bram != NULL);
+
+	ConfigPtr = &ScrubPtr->Bram->Config;
+	if (BaseAddress < ConfigPtr->MemBaseAddress ||
+	    HighAddress > ConfigPtr->MemHighAddress ||
+	    BaseAddress > HighAddress ||
+	    (BaseAddress & 3) != 0 || (HighAddress & 3) != 3) {
+		return XST_INVALID_PARAM;
+	}
+
+	ScrubPtr->BaseAddress = BaseAddress;
+	ScrubPtr->HighAddress = HighAddress;
+	ScrubPtr->NextAddress = BaseAddress;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* Scrub the next slice of the region, WordsPerSlice words or up to the end of
+* the region. The scrub starts again at the beginning of the region after
+* its end, Passes counts the complete passes over the region.
+*
+* The words are read by blocks of XBRAM_SCRUB_BLOCK_WORDS, and the ECC status
+* is checked after each block. A block with an error is read again a word at
+* a time to find the failing words. A word with a correctable error is
+* written back with the corrected data read, a word with an uncorrectable
+* error is only logged, writing it back would store wrong data with a valid
+* ECC.
+*
+* @param	ScrubPtr is the scrub instance.
+*
+* @return	The number of errors found in the slice.
+*
+* @note		The function clears the ECC status register, an interrupt
+*		handler for the ECC interrupts should use the scrub log rather
+*		than the status register. The write back of a word is not
+*		atomic, the region must not be written by another bus master
+*		while it is scrubbed.
+*
+*****************************************************************************/
+u32 XBram_ScrubSlice(XBram_Scrub *ScrubPtr)
+{
+	XBram *InstancePtr;
+	UINTPTR Addr;
+	u32 Words;
+	u32 Left;
+	u32 Errors;
+
+	Xil_AssertNonvoid(ScrubPtr != NULL);
+	Xil_AssertNonvoid(ScrubPtr->Bram != NULL);
+
+	InstancePtr = ScrubPtr->Bram;
+	Errors = ScrubPtr->CeCount + ScrubPtr->UeCount;
+	Addr = ScrubPtr->NextAddress;
+	Left = (u32)((ScrubPtr->HighAddress - Addr) >> 2) + 1;
+	if (Left > ScrubPtr->WordsPerSlice) {
+		Left = ScrubPtr->WordsPerSlice;
+	}
+
+	/* Read the BRAM rather than cached data */
+	Xil_DCacheFlushRange(Addr, Left * 4);
+
+	/* Do not account errors found before the slice to the slice */
+	WR(ECC_STATUS_OFFSET, XBRAM_IR_ALL_MASK);
+
+	while (Left != 0) {
+		Words = (Left < XBRAM_SCRUB_BLOCK_WORDS) ?
+				Left : XBRAM_SCRUB_BLOCK_WORDS;
+		ScrubBlock(ScrubPtr, Addr, Words);
+		Addr += (UINTPTR)Words * 4;
+		Left -= Words;
+	}
+
+	if (Addr > ScrubPtr->HighAddress || Addr == 0) {
+		Addr = ScrubPtr->BaseAddress;
+		ScrubPtr->Passes++;
+	}
+	ScrubPtr->NextAddress = Addr;
+
+	return ScrubPtr->CeCount + ScrubPtr->UeCount - Errors;
+}
+
+/****************************************************************************/
+/**
+* Get the entries of the scrub log, oldest first, and empty the log.
+*
+* @param	ScrubPtr is the scrub instance.
+* @param	Entries is filled in with the log entries.
+* @param	MaxEntries is the number of entries Entries can hold.
+*
+* @return	The number of entries copied to Entries. The entries which do
+*		not fit are dropped.
+*
+* @note		The log keeps the XBRAM_SCRUB_LOG_SIZE most recent errors,
+*		LogLost counts the entries overwritten before they were read.
+*
+*****************************************************************************/
+u32 XBram_ScrubGetLog(XBram_Scrub *ScrubPtr, XBram_ScrubLogEntry *Entries,
+		      u32 MaxEntries)
+{
+	u32 Count;
+	u32 Index;
+	u32 First;
+
+	Xil_AssertNonvoid(ScrubPtr != NULL);
+	Xil_AssertNonvoid(Entries != NULL || MaxEntries == 0);
+
+	Count = (ScrubPtr->LogCount < MaxEntries) ?
+			ScrubPtr->LogCount : MaxEntries;
+	First = (ScrubPtr->LogHead + XBRAM_SCRUB_LOG_SIZE -
+			ScrubPtr->LogCount) % XBRAM_SCRUB_LOG_SIZE;
+	for (Index = 0; Index < Count; Index++) {
+		Entries[Index] = ScrubPtr->Log[(First + Index) %
+						XBRAM_SCRUB_LOG_SIZE];
+	}
+	ScrubPtr->LogCount = 0;
+
+	return Count;
+}
+
+/****************************************************************************/
+/**
+* Scrub a block of words of the BRAM.
+*
+* @param	ScrubPtr is the scrub instance.
+* @param	Addr is the address of the first word of the block.
+* @param	Words is the number of words in the block.
+*
+* @return	None.
+*
+* @note		The ECC status must be clear on entry, it is clear on exit.
+*
+*****************************************************************************/
+static void ScrubBlock(XBram_Scrub *ScrubPtr, UINTPTR Addr, u32 Words)
+{
+	XBram *InstancePtr = ScrubPtr->Bram;
+	u32 Status;
+	u32 Data;
+	u32 Index;
+
+	for (Index = 0; Index < Words; Index++) {
+		(void)XBram_In32(Addr + Index * 4);
+	}
+	if ((RD(ECC_STATUS_OFFSET) & XBRAM_IR_ALL_MASK) == 0) {
+		return;
+	}
+	WR(ECC_STATUS_OFFSET, XBRAM_IR_ALL_MASK);
+
+	for (Index = 0; Index < Words; Index++, Addr += 4) {
+		Data = XBram_In32(Addr);
+		Status = RD(ECC_STATUS_OFFSET) & XBRAM_IR_ALL_MASK;
+		if (Status == 0) {
+			continue;
+		}
+		WR(ECC_STATUS_OFFSET, XBRAM_IR_ALL_MASK);
+
+		if (Status & XBRAM_IR_UE_MASK) {
+			ScrubPtr->UeCount++;
+			ScrubLog(ScrubPtr, Addr, XBRAM_IR_UE_MASK);
+		} else {
+			ScrubPtr->CeCount++;
+			ScrubLog(ScrubPtr, Addr, XBRAM_IR_CE_MASK);
+			if (ScrubPtr->Bram->Config.WriteAccess) {
+				XBram_Out32(Addr, Data);
+				Xil_DCacheFlushRange(Addr, 4);
+				ScrubPtr->Corrected++;
+			}
+		}
+	}
+}
+
+/****************************************************************************/
+/**
+* Add an entry to the scrub log, overwriting the oldest entry if the log is
+* full.
+*
+* @param	ScrubPtr is the scrub instance.
+* @param	Addr is the address of the failing word.
+* @param	Type is XBRAM_IR_CE_MASK or XBRAM_IR_UE_MASK.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void ScrubLog(XBram_Scrub *ScrubPtr, UINTPTR Addr, u32 Type)
+{
+	XBram_ScrubLogEntry *EntryPtr = &ScrubPtr->Log[ScrubPtr->LogHead];
+
+	EntryPtr->Address = Addr;
+	EntryPtr->Pass = ScrubPtr->Passes;
+	EntryPtr->Type = Type;
+
+	ScrubPtr->LogHead = (ScrubPtr->LogHead + 1) % XBRAM_SCRUB_LOG_SIZE;
+	if (ScrubPtr->LogCount < XBRAM_SCRUB_LOG_SIZE) {
+		ScrubPtr->LogCount++;
+	} else {
+		ScrubPtr->LogLost++;
+	}
+}
+/** @} */
@@ -73,6 +73,8 @@
 		      XCanFd_Addto_Queue(), to send more than 32 buffers.
 		      CR# 1022093
 * 2.2   sn   06/11/19 Inactivating Mailbox RX buffers based on requirement.
+* 2.2   sn   10/15/19 Added XCanFd_Recv_Sequential_Bulk() and
+*		      XCanFd_Send_Bulk().
 *
 * </pre>
 ******************************************************************************/
@@ -100,6 +102,12 @@ extern XCanFd_Config XCanFd_ConfigTable[];
 
 static void StubHandler(void);
 static int XCanfd_TrrVal_Get_SetBit_Position(u32 u);
+static void XCanFd_SeqRecv_ReadFrame(XCanFd *InstancePtr, u32 ReadIndex,
+		u32 *FramePtr, u8 fifo_no);
+static u32 XCanFd_SeqRecv_Bulk_Fifo(XCanFd *InstancePtr, u32 *FramePtr,
+		u32 MaxFrames, u8 fifo_no);
+static void XCanFd_WriteTxBuffer(XCanFd *InstancePtr, u32 BufferNumber,
+		u32 *FramePtr);
 static u32 XCanFd_SeqRecv_logic(XCanFd *InstancePtr, u32 ReadIndex,
 	   u32 FsrVal, u32 *FramePtr, u8 fifo_no);
 
@@ -723,6 +731,111 @@ u32 XCanFd_Recv_Sequential(XCanFd *InstancePtr, u32 *FramePtr)
 
 }
 
+/*****************************************************************************/
+/**
+*
+* This function drains the RX FIFOs in sequential mode. It reads up to
+* MaxFrames CAN/CAN FD frames, first from Fifo 0 then from Fifo 1, into
+* consecutive XCANFD_FRAME_WORDS word slots of the user buffer.
+*
+* The fill level and Read Index are read once per call instead of once per
+* frame, the following Read Indexes are derived locally. The Read Index is
+* advanced with one write of the IRI bit per frame, the core increments it by
+* one per write.
+*
+* @param	InstancePtr is a pointer to the XCanFd instance to be worked on.
+* @param	FramePtr is a pointer to a 32-bit aligned buffer of MaxFrames
+*		times XCANFD_FRAME_WORDS words.
+* @param	MaxFrames is the maximum number of frames to read.
+*
+* @return	The number of frames read, 0 if the FIFOs are empty.
+*
+* @note		Frames arriving while the FIFOs are drained are left for the
+*		next call. Fifo 1 is only present with CanFD 2.0 spec support.
+*
+******************************************************************************/
+u32 XCanFd_Recv_Sequential_Bulk(XCanFd *InstancePtr, u32 *FramePtr,
+		u32 MaxFrames)
+{
+	u32 NumFrames;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(FramePtr != NULL);
+
+	NumFrames = XCanFd_SeqRecv_Bulk_Fifo(InstancePtr, FramePtr, MaxFrames,
+			XCANFD_RX_FIFO_0);
+#if !defined (CANFD_v1_0)
+	NumFrames += XCanFd_SeqRecv_Bulk_Fifo(InstancePtr,
+			FramePtr + (NumFrames * XCANFD_FRAME_WORDS),
+			MaxFrames - NumFrames, XCANFD_RX_FIFO_1);
+#endif
+
+	return NumFrames;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function fills the free TX Buffers with frames and requests the
+* transmission of all of them with a single TRR write, so that the core
+* always has every TX Buffer queued when the bus is busy. The frames are
+* read from consecutive XCANFD_FRAME_WORDS word slots of the user buffer.
+*
+* @param	InstancePtr is a pointer to the XCanFd instance to be worked on.
+* @param	FramePtr is a pointer to a 32-bit aligned buffer of NumFrames
+*		times XCANFD_FRAME_WORDS words.
+* @param	NumFrames is the number of frames to send.
+*
+* @return	The number of frames queued, less than NumFrames when all the
+*		TX Buffers are pending. The caller retries the rest, e.g. from
+*		the TXOK or TXRRS interrupt.
+*
+* @note		Must not be mixed with XCanFd_Addto_Queue() and
+*		XCanFd_Send_Queue(). The core sends the queued frames in the
+*		order of their ID priority.
+*
+******************************************************************************/
+u32 XCanFd_Send_Bulk(XCanFd *InstancePtr, u32 *FramePtr, u32 NumFrames)
+{
+	u32 TrrVal;
+	u32 FreeMask;
+	u32 ReqMask = 0;
+	u32 BufferNumber;
+	u32 Sent = 0;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(FramePtr != NULL);
+
+	TrrVal = XCanFd_ReadReg(InstancePtr->CanFdConfig.BaseAddress,
+			XCANFD_TRR_OFFSET);
+	if (InstancePtr->CanFdConfig.NumofTxBuf >= MAX_BUFFER_INDEX) {
+		FreeMask = ~TrrVal;
+	} else {
+		FreeMask = ~TrrVal &
+			((1U << InstancePtr->CanFdConfig.NumofTxBuf) - 1U);
+	}
+
+	while ((Sent < NumFrames) && (FreeMask != 0)) {
+		BufferNumber = XCanfd_TrrVal_Get_SetBit_Position(
+				XCanFD_Check_TrrVal_Set_Bit(FreeMask));
+		XCanFd_WriteTxBuffer(InstancePtr, BufferNumber,
+				FramePtr + (Sent * XCANFD_FRAME_WORDS));
+		FreeMask &= ~((u32)TRR_POS_MASK << BufferNumber);
+		ReqMask |= (u32)TRR_POS_MASK << BufferNumber;
+		Sent++;
+	}
+
+	if (ReqMask != 0) {
+		/* Writing 1 requests a buffer, 0 leaves it unchanged */
+		XCanFd_WriteReg(InstancePtr->CanFdConfig.BaseAddress,
+				XCANFD_TRR_OFFSET, ReqMask);
+	}
+
+	return Sent;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -1779,6 +1892,45 @@ static int XCanfd_TrrVal_Get_SetBit_Position(u32 u) {
 *
 ******************************************************************************/
 static u32 XCanFd_SeqRecv_logic(XCanFd *InstancePtr, u32 ReadIndex, u32 FsrVal, u32 *FramePtr, u8 fifo_no)
+{
+	XCanFd_SeqRecv_ReadFrame(InstancePtr, ReadIndex, FramePtr, fifo_no);
+
+		/* Set the IRI bit causes core to increment RI in FSR Register */
+		if (fifo_no == XCANFD_RX_FIFO_0) {
+			FsrVal = XCanFd_ReadReg(InstancePtr->CanFdConfig.BaseAddress,
+					XCANFD_FSR_OFFSET);
+			FsrVal |= XCANFD_FSR_IRI_MASK;
+			XCanFd_WriteReg(InstancePtr->CanFdConfig.BaseAddress,
+					XCANFD_FSR_OFFSET, FsrVal);
+		} else {
+			FsrVal = XCanFd_ReadReg(InstancePtr->CanFdConfig.BaseAddress,
+					XCANFD_FSR_OFFSET);
+			FsrVal |= XCANFD_FSR_IRI_1_MASK;
+			XCanFd_WriteReg(InstancePtr->CanFdConfig.BaseAddress,
+					XCANFD_FSR_OFFSET, FsrVal);
+		}
+
+		return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function copies the CAN/CAN FD Frame at the given Read Index of a RX
+* FIFO to the user buffer. The Read Index of the core is not changed.
+*
+* @param	InstancePtr is a pointer to the XCanFd instance to be worked on.
+* @param	ReadIndex is the buffer to read in the FIFO.
+* @param	FramePtr is a pointer to a 32-bit aligned buffer where the
+*		    CAN/CAN FD frame is to be written.
+* @param    fifo_no is the target fifo number
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XCanFd_SeqRecv_ReadFrame(XCanFd *InstancePtr, u32 ReadIndex,
+		u32 *FramePtr, u8 fifo_no)
 {
 	u32 DwIndex=0;
 	u32 CanEDL;
@@ -1846,22 +1998,118 @@ static u32 XCanFd_SeqRecv_logic(XCanFd *InstancePtr, u32 ReadIndex, u32 FsrVal,
 				DwIndex++;
 			}
 		}
+}
 
-		/* Set the IRI bit causes core to increment RI in FSR Register */
-		if (fifo_no == XCANFD_RX_FIFO_0) {
-			FsrVal = XCanFd_ReadReg(InstancePtr->CanFdConfig.BaseAddress,
-					XCANFD_FSR_OFFSET);
-			FsrVal |= XCANFD_FSR_IRI_MASK;
-			XCanFd_WriteReg(InstancePtr->CanFdConfig.BaseAddress,
-					XCANFD_FSR_OFFSET, FsrVal);
-		} else {
-			FsrVal = XCanFd_ReadReg(InstancePtr->CanFdConfig.BaseAddress,
+/*****************************************************************************/
+/**
+* This function reads up to MaxFrames frames from one RX FIFO. The Read Index
+* is read once and then followed locally. Since the FIFO depth is a build
+* option of the core, the Read Index is read again each time the local one
+* reaches a multiple of XCANFD_RX_FIFO_MIN_DEPTH, where the FIFO may wrap.
+*
+* @param	InstancePtr is a pointer to the XCanFd instance to be worked on.
+* @param	FramePtr is a pointer to the user buffer.
+* @param	MaxFrames is the maximum number of frames to read.
+* @param    fifo_no is the target fifo number
+*
+* @return	The number of frames read.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XCanFd_SeqRecv_Bulk_Fifo(XCanFd *InstancePtr, u32 *FramePtr,
+		u32 MaxFrames, u8 fifo_no)
+{
+	u32 FsrVal;
+	u32 FillLevel;
+	u32 ReadIndex;
+	u32 IriMask;
+	u32 Index;
+
+	FsrVal = XCanFd_ReadReg(InstancePtr->CanFdConfig.BaseAddress,
+			XCANFD_FSR_OFFSET);
+	if (fifo_no == XCANFD_RX_FIFO_0) {
+		FillLevel = (FsrVal & XCANFD_FSR_FL_MASK) >>
+				XCANFD_FSR_FL_0_SHIFT;
+		ReadIndex = FsrVal & XCANFD_FSR_RI_MASK;
+		IriMask = XCANFD_FSR_IRI_MASK;
+	} else {
+#if defined (CANFD_v1_0)
+		return 0;
+#else
+		FillLevel = (FsrVal & XCANFD_FSR_FL_1_MASK) >>
+				XCANFD_FSR_FL_1_SHIFT;
+		ReadIndex = (FsrVal & XCANFD_FSR_RI_1_MASK) >>
+				XCANFD_FSR_RI_1_SHIFT;
+		IriMask = XCANFD_FSR_IRI_1_MASK;
+#endif
+	}
+	if (FillLevel > MaxFrames) {
+		FillLevel = MaxFrames;
+	}
+
+	for (Index = 0; Index < FillLevel; Index++) {
+		XCanFd_SeqRecv_ReadFrame(InstancePtr, ReadIndex,
+				FramePtr + (Index * XCANFD_FRAME_WORDS), fifo_no);
+		XCanFd_WriteReg(InstancePtr->CanFdConfig.BaseAddress,
+				XCANFD_FSR_OFFSET, IriMask);
+		ReadIndex++;
+		if ((ReadIndex % XCANFD_RX_FIFO_MIN_DEPTH) == 0) {
+			FsrVal = XCanFd_ReadReg(
+					InstancePtr->CanFdConfig.BaseAddress,
 					XCANFD_FSR_OFFSET);
-			FsrVal |= XCANFD_FSR_IRI_1_MASK;
-			XCanFd_WriteReg(InstancePtr->CanFdConfig.BaseAddress,
-					XCANFD_FSR_OFFSET, FsrVal);
+			if (fifo_no == XCANFD_RX_FIFO_0) {
+				ReadIndex = FsrVal & XCANFD_FSR_RI_MASK;
+			} else {
+#if !defined (CANFD_v1_0)
+				ReadIndex = (FsrVal & XCANFD_FSR_RI_1_MASK) >>
+						XCANFD_FSR_RI_1_SHIFT;
+#endif
+			}
 		}
+	}
 
-		return XST_SUCCESS;
+	return FillLevel;
+}
+
+/*****************************************************************************/
+/**
+* This function writes a CAN/CAN FD frame into a TX Buffer without requesting
+* its transmission.
+*
+* @param	InstancePtr is a pointer to the XCanFd instance to be worked on.
+* @param	BufferNumber is the TX Buffer to write.
+* @param	FramePtr is a pointer to a 32-bit aligned buffer containing the
+*		CAN frame to be sent.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XCanFd_WriteTxBuffer(XCanFd *InstancePtr, u32 BufferNumber,
+		u32 *FramePtr)
+{
+	u32 DwIndex;
+	u32 Dlc;
+	u32 Len;
+
+	XCanFd_WriteReg(InstancePtr->CanFdConfig.BaseAddress,
+			XCANFD_TXID_OFFSET(BufferNumber), FramePtr[0]);
+	XCanFd_WriteReg(InstancePtr->CanFdConfig.BaseAddress,
+			XCANFD_TXDLC_OFFSET(BufferNumber), FramePtr[1]);
+
+	/*
+	 * The data words are consecutive for both frame types, take the
+	 * length from the DLC written instead of reading it back
+	 */
+	Dlc = XCanFd_GetDlc2len(FramePtr[1] & XCANFD_DLCR_DLC_MASK,
+			(FramePtr[1] & XCANFD_DLCR_EDL_MASK));
+	for (Len = 0, DwIndex = 0; Len < Dlc; Len += 4, DwIndex++) {
+		XCanFd_WriteReg(InstancePtr->CanFdConfig.BaseAddress,
+				(XCANFD_TXDW_OFFSET(BufferNumber) +
+				(DwIndex * XCANFD_DW_BYTES)),
+				Xil_EndianSwap32(FramePtr[2 + DwIndex]));
+	}
 }
 /** @} */
@@ -264,6 +264,9 @@ exclusion
 * 2.2   sn   06/11/19 Corrected below incorrect Mask values for CANFD2.0 in xcanfd_hw.h
 *		      XCANFD_MAILBOX_RB_MASK_BASE_OFFSET,XCANFD_WMR_RXFP_MASK
 *		      and CONTROL_STATUS_3.
+* 2.2   sn   10/15/19 Added XCanFd_Recv_Sequential_Bulk(), XCanFd_Send_Bulk()
+*		      and XCanFd_SetRxBulkIntr() for high frame rates.
+*		      Fixed XCANFD_TX*_OFFSET() to use their argument.
 *
 * </pre>
 *
@@ -322,6 +325,8 @@ extern "C" {
 #define XCANFD_MODE_BR		0x0000000B /**< Bus-Off Recovery Mode */
 #define XCANFD_RX_FIFO_0	         0 /**< Selection for RX Fifo 0 */
 #define XCANFD_RX_FIFO_1	         1 /**< Selection for RX Fifo 1 */
+#define XCANFD_FRAME_WORDS	(XCANFD_MAX_FRAME_SIZE / XCANFD_DW_BYTES)
+				/**< Words per frame in the bulk API buffers */
 /* @} */
 
 /** @name Callback identifiers used as parameters to XCanFd_SetHandler()
@@ -579,7 +584,7 @@ typedef struct {
 *
 *****************************************************************************/
 #define XCANFD_TXID_OFFSET(FreeBuffer) \
-	(XCANFD_TXFIFO_0_BASE_ID_OFFSET+(FreeTxBuffer*XCANFD_MAX_FRAME_SIZE))
+	(XCANFD_TXFIFO_0_BASE_ID_OFFSET+((FreeBuffer)*XCANFD_MAX_FRAME_SIZE))
 
 /*****************************************************************************/
 /**
@@ -591,7 +596,7 @@ typedef struct {
 *
  *****************************************************************************/
 #define XCANFD_TXDLC_OFFSET(FreeBuffer) \
-	(XCANFD_TXFIFO_0_BASE_DLC_OFFSET+(FreeTxBuffer*XCANFD_MAX_FRAME_SIZE))
+	(XCANFD_TXFIFO_0_BASE_DLC_OFFSET+((FreeBuffer)*XCANFD_MAX_FRAME_SIZE))
 
 /*****************************************************************************/
 /**
@@ -603,7 +608,7 @@ typedef struct {
 *
 *****************************************************************************/
 #define XCANFD_TXDW_OFFSET(FreeBuffer) \
-	(XCANFD_TXFIFO_0_BASE_DW0_OFFSET+(FreeTxBuffer*XCANFD_MAX_FRAME_SIZE))
+	(XCANFD_TXFIFO_0_BASE_DW0_OFFSET+((FreeBuffer)*XCANFD_MAX_FRAME_SIZE))
 
 /*****************************************************************************/
 /**
@@ -1065,6 +1070,9 @@ u32 XCanFd_Set_MailBox_IdMask(XCanFd *InstancePtr, u32 RxBuffer,
 						u32 MaskValue, u32 IdValue);
 u32 XCanFd_Recv_Sequential(XCanFd *InstancePtr, u32 *FramePtr);
 u32 XCanFd_Recv_Mailbox(XCanFd *InstancePtr, u32 *FramePtr);
+u32 XCanFd_Recv_Sequential_Bulk(XCanFd *InstancePtr, u32 *FramePtr,
+						u32 MaxFrames);
+u32 XCanFd_Send_Bulk(XCanFd *InstancePtr, u32 *FramePtr, u32 NumFrames);
 u32 XCanFd_Recv_TXEvents_Sequential(XCanFd *InstancePtr, u32 *FramePtr);
 void XCanFd_PollQueue_Buffer(XCanFd *InstancePtr);
 int XCanFd_GetNofMessages_Stored_Rx_Fifo(XCanFd *InstancePtr, u8 fifo_no);
@@ -1112,6 +1120,7 @@ void XCanFd_InterruptEnable_RxBuffFull(XCanFd *InstancePtr, u32 Mask,
 						u32 RxBuffNumber);
 void XCanFd_InterruptDisable_RxBuffFull(XCanFd *InstancePtr, u32 Mask,
 						u32 RxBuffNumber);
+int XCanFd_SetRxBulkIntr(XCanFd *InstancePtr, u8 Threshold);
 
 /* Functions in xcanfd_sinit.c */
 XCanFd_Config *XCanFd_LookupConfig(u16 Deviceid);
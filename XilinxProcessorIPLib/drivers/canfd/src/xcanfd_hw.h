@@ -873,6 +873,8 @@ Mask/Acceptance Filter ID)
 					 */
 #define XCANFD_TXE_MESSAGE_SIZE 8
 #define XCANFD_DW_BYTES	4		/**< Data Word Bytes */
+#define XCANFD_RX_FIFO_MIN_DEPTH	16	/**< Smallest RX FIFO depth, the
+						FIFO may wrap at any multiple */
 #define XST_NOBUFFER	33L	/**< All Buffers (32) are filled */
 #define XST_BUFFER_ALREADY_FILLED	34L	/**< Given Buffer is Already
 						filled */
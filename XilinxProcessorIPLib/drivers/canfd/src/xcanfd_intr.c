@@ -47,6 +47,7 @@
 *					   XCanFd_SetRxIntrWatermark : This function has been
 *					   moved to xcanfd_intr.c
 *       ask  07/03/18 Fix for Sequential recv CR# 992606,CR# 1004222.
+* 2.2   sn   10/15/19 Added XCanFd_SetRxBulkIntr().
 * </pre>
 *
 ******************************************************************************/
@@ -554,4 +555,49 @@ int XCanFd_SetHandler(XCanFd *InstancePtr, u32 HandlerType,
 	}
 	return (XST_SUCCESS);
 }
+/****************************************************************************/
+/**
+*
+* This routine sets up the RX interrupts for XCanFd_Recv_Sequential_Bulk().
+* The per frame RXOK interrupt is disabled and the RX FIFO watermark full
+* interrupt(s) are enabled, so that the handler runs once per Threshold
+* frames and drains them in one call.
+*
+* @param	InstancePtr is a pointer to the XCanFd instance.
+* @param	Threshold is the RX FIFO watermark, in frames. The valid values
+*		are from 1 to XCANFD_WM_FIFO0_THRESHOLD.
+*
+* @return	- XST_FAILURE - If the CAN device is not in Configuration Mode.
+*		- XST_SUCCESS - If the watermark and interrupts are set.
+*
+* @note		Frames below the watermark stay in the FIFO until the next
+*		watermark interrupt or until the application polls with
+*		XCanFd_Recv_Sequential_Bulk(), e.g. from a timer, to bound
+*		their latency. The watermark of Fifo 1 is set as well on IP
+*		with CanFD 2.0 spec support.
+*
+*****************************************************************************/
+int XCanFd_SetRxBulkIntr(XCanFd *InstancePtr, u8 Threshold)
+{
+	u32 Mask = XCANFD_IXR_RXFWMFLL_MASK;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid((Threshold > 0) &&
+			(Threshold <= XCANFD_WM_FIFO0_THRESHOLD));
+
+	if (XCanFd_SetRxIntrWatermark(InstancePtr, (s8)Threshold) !=
+			(u32)XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+#if !defined (CANFD_v1_0)
+	(void)XCanFd_SetRxIntrWatermarkFifo1(InstancePtr, (s8)Threshold);
+	Mask |= XCANFD_IXR_RXFWMFLL_1_MASK;
+#endif
+
+	XCanFd_InterruptDisable(InstancePtr, XCANFD_IXR_RXOK_MASK);
+	XCanFd_InterruptEnable(InstancePtr, Mask);
+
+	return XST_SUCCESS;
+}
 /** @} */
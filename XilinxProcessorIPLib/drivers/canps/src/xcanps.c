@@ -46,6 +46,8 @@
 * 			XCanPs_GetTxIntrWatermark.
 * 3.00  kvn    02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.3	sne    08/06/19	Fixed coverity warnings.
+*	adk    10/15/19	Added batched TX/RX FIFO access and acceptance filter
+*			tables.
 *
 * </pre>
 *
@@ -57,6 +59,8 @@
 
 /************************** Constant Definitions *****************************/
 
+#define XCANPS_FILTER_BUSY_TIMEOUT	1000U /**< Polls of the ACFBSY bit */
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -159,6 +163,13 @@ void XCanPs_Reset(XCanPs *InstancePtr)
 
 	XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr, XCANPS_SRR_OFFSET, \
 			   XCANPS_SRR_SRST_MASK);
+
+	/*
+	 * Both FIFOs are empty after reset, nothing is known about them
+	 * until the watermark status is seen again.
+	 */
+	InstancePtr->TxFifoRoom = 0U;
+	InstancePtr->RxFifoLevel = 0U;
 }
 
 /****************************************************************************/
@@ -487,6 +498,10 @@ s32 XCanPs_Send(XCanPs *InstancePtr, u32 *FramePtr)
 		XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr,
 				XCANPS_TXFIFO_DW2_OFFSET, Xil_EndianSwap32(FramePtr[3]));
 
+		if (InstancePtr->TxFifoRoom != 0U) {
+			InstancePtr->TxFifoRoom--;
+		}
+
 		Status = XST_SUCCESS;
 	}
 	return Status;
@@ -541,6 +556,218 @@ s32 XCanPs_Recv(XCanPs *InstancePtr, u32 *FramePtr)
 		 */
 		XCanPs_IntrClear(InstancePtr, XCANPS_IXR_RXNEMP_MASK);
 
+		if (InstancePtr->RxFifoLevel != 0U) {
+			InstancePtr->RxFifoLevel--;
+		}
+
+		Status = XST_SUCCESS;
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends a batch of CAN frames through the TX FIFO. Frames are
+* written back to back as long as the TX FIFO is known to have room for them,
+* the status register is only polled once that room is used up.
+*
+* The room in the TX FIFO is taken from the TX FIFO Empty and TX FIFO
+* Watermark Empty interrupt status bits, which this function consumes, and
+* from the same events seen by XCanPs_IntrHandler() when they are enabled.
+*
+* @param	InstancePtr is a pointer to the XCanPs instance.
+* @param	FramePtr is a pointer to a 32-bit aligned buffer containing
+*		NumFrames CAN frames of XCANPS_FRAME_WORDS words each, in the
+*		format used by XCanPs_Send().
+* @param	NumFrames is the number of frames to send.
+* @param	SentPtr is a pointer to the number of frames written to the
+*		TX FIFO, returned by this function.
+*
+* @return
+*		- XST_SUCCESS if at least one frame was written into the FIFO,
+*		or NumFrames is 0.
+*		- XST_FIFO_NO_ROOM if there is no room in the TX FIFO for the
+*		first frame.
+*
+* @note		The empty status bits are only meaningful while all frames
+*		are queued by this function. If XCanPs_Send() is used while
+*		polling these bits, clear XCANPS_IXR_TXFEMP_MASK and
+*		XCANPS_IXR_TXFWMEMP_MASK with XCanPs_IntrClear() before calling
+*		this function again.
+*
+******************************************************************************/
+s32 XCanPs_SendBatch(XCanPs *InstancePtr, u32 *FramePtr, u32 NumFrames,
+			u32 *SentPtr)
+{
+	u32 IntrValue;
+	u32 Room;
+	u32 Index;
+	u32 *Frame;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(FramePtr != NULL);
+	Xil_AssertNonvoid(SentPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Room = InstancePtr->TxFifoRoom;
+	IntrValue = XCanPs_IntrGetStatus(InstancePtr) &
+			((u32)XCANPS_IXR_TXFEMP_MASK |
+			 (u32)XCANPS_IXR_TXFWMEMP_MASK);
+	if (IntrValue != (u32)0) {
+		/*
+		 * Clear the bits before any frame is written so that they
+		 * only report the FIFO draining after this call.
+		 */
+		XCanPs_IntrClear(InstancePtr, IntrValue);
+		if ((IntrValue & XCANPS_IXR_TXFEMP_MASK) != (u32)0) {
+			Room = XCANPS_FIFO_DEPTH;
+		} else if ((XCANPS_FIFO_DEPTH -
+			(u32)XCanPs_GetTxIntrWatermark(InstancePtr)) > Room) {
+			Room = XCANPS_FIFO_DEPTH -
+				(u32)XCanPs_GetTxIntrWatermark(InstancePtr);
+		} else {
+			/*This else was made for misra-c compliance*/
+			;
+		}
+	}
+
+	for (Index = 0U; Index < NumFrames; Index++) {
+		if (Room != (u32)0) {
+			Room--;
+		} else if (XCanPs_IsTxFifoFull(InstancePtr) == TRUE) {
+			break;
+		} else {
+			/*This else was made for misra-c compliance*/
+			;
+		}
+
+		/*
+		 * Write IDR, DLC, Data Word 1 and Data Word 2 to the CAN device.
+		 */
+		Frame = &FramePtr[Index * XCANPS_FRAME_WORDS];
+		XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr,
+				XCANPS_TXFIFO_ID_OFFSET, Frame[0]);
+		XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr,
+				XCANPS_TXFIFO_DLC_OFFSET, Frame[1]);
+		XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr,
+				XCANPS_TXFIFO_DW1_OFFSET, Xil_EndianSwap32(Frame[2]));
+		XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr,
+				XCANPS_TXFIFO_DW2_OFFSET, Xil_EndianSwap32(Frame[3]));
+	}
+
+	InstancePtr->TxFifoRoom = Room;
+	*SentPtr = Index;
+
+	if ((Index == (u32)0) && (NumFrames != (u32)0)) {
+		Status = XST_FIFO_NO_ROOM;
+	} else {
+		Status = XST_SUCCESS;
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function receives a batch of CAN frames from the RX FIFO. When the RX
+* FIFO Watermark Full status shows that the FIFO holds at least the watermark
+* threshold, that many frames are read back to back, the remaining frames are
+* read one by one while the RX FIFO is not empty.
+*
+* Enabling XCANPS_IXR_RXFWMFLL_MASK instead of XCANPS_IXR_RXNEMP_MASK and
+* calling this function from the receive callback takes one interrupt per
+* watermark threshold frames instead of one per frame.
+*
+* @param	InstancePtr is a pointer to the XCanPs instance.
+* @param	FramePtr is a pointer to a 32-bit aligned buffer for MaxFrames
+*		CAN frames of XCANPS_FRAME_WORDS words each, in the format
+*		used by XCanPs_Recv().
+* @param	MaxFrames is the number of frames the buffer can hold.
+* @param	RecvdPtr is a pointer to the number of frames read from the
+*		RX FIFO, returned by this function.
+*
+* @return
+*		- XST_SUCCESS if at least one frame was read from the FIFO, or
+*		MaxFrames is 0.
+*		- XST_NO_DATA if there is no frame to be received from the FIFO.
+*
+* @note		The watermark status bit is only meaningful while all frames
+*		are read by this function. If XCanPs_Recv() is used while
+*		polling this bit, clear XCANPS_IXR_RXFWMFLL_MASK with
+*		XCanPs_IntrClear() before calling this function again.
+*
+******************************************************************************/
+s32 XCanPs_RecvBatch(XCanPs *InstancePtr, u32 *FramePtr, u32 MaxFrames,
+			u32 *RecvdPtr)
+{
+	u32 IntrValue;
+	u32 Level;
+	u32 Index;
+	u32 *Frame;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(FramePtr != NULL);
+	Xil_AssertNonvoid(RecvdPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Level = InstancePtr->RxFifoLevel;
+	IntrValue = XCanPs_IntrGetStatus(InstancePtr);
+	if ((IntrValue & XCANPS_IXR_RXFWMFLL_MASK) != (u32)0) {
+		XCanPs_IntrClear(InstancePtr, XCANPS_IXR_RXFWMFLL_MASK);
+		if ((u32)XCanPs_GetRxIntrWatermark(InstancePtr) > Level) {
+			Level = (u32)XCanPs_GetRxIntrWatermark(InstancePtr);
+		}
+	}
+
+	for (Index = 0U; Index < MaxFrames; Index++) {
+		if (Level != (u32)0) {
+			Level--;
+		} else if (Index == (u32)0) {
+			if ((IntrValue & XCANPS_IXR_RXNEMP_MASK) == (u32)0) {
+				break;
+			}
+		} else {
+			/*
+			 * Clear RXNEMP bit in ISR, it is set again by the
+			 * device while frames remain in the RX FIFO.
+			 */
+			XCanPs_IntrClear(InstancePtr, XCANPS_IXR_RXNEMP_MASK);
+			if (XCanPs_IsRxEmpty(InstancePtr) == TRUE) {
+				break;
+			}
+		}
+
+		/*
+		 * Read IDR, DLC, Data Word 1 and Data Word 2 from the CAN device.
+		 */
+		Frame = &FramePtr[Index * XCANPS_FRAME_WORDS];
+		Frame[0] = XCanPs_ReadReg(InstancePtr->CanConfig.BaseAddr,
+						XCANPS_RXFIFO_ID_OFFSET);
+		Frame[1] = XCanPs_ReadReg(InstancePtr->CanConfig.BaseAddr,
+						XCANPS_RXFIFO_DLC_OFFSET);
+		Frame[2] = Xil_EndianSwap32(XCanPs_ReadReg(InstancePtr->CanConfig.BaseAddr,
+						XCANPS_RXFIFO_DW1_OFFSET));
+		Frame[3] = Xil_EndianSwap32(XCanPs_ReadReg(InstancePtr->CanConfig.BaseAddr,
+						XCANPS_RXFIFO_DW2_OFFSET));
+	}
+
+	/*
+	 * Leave RXNEMP reporting the FIFO occupancy after the last read, as
+	 * XCanPs_Recv() does.
+	 */
+	if (Index != (u32)0) {
+		XCanPs_IntrClear(InstancePtr, XCANPS_IXR_RXNEMP_MASK);
+	}
+
+	InstancePtr->RxFifoLevel = Level;
+	*RecvdPtr = Index;
+
+	if ((Index == (u32)0) && (MaxFrames != (u32)0)) {
+		Status = XST_NO_DATA;
+	} else {
 		Status = XST_SUCCESS;
 	}
 	return Status;
@@ -870,6 +1097,145 @@ void XCanPs_AcceptFilterGet(XCanPs *InstancePtr, u32 FilterIndex,
 	}
 }
 
+/*****************************************************************************/
+/**
+*
+* This function applies a complete acceptance filter table in one call. All
+* filters are disabled, the Mask and ID Registers of the used filters are
+* written once the device stops being busy, and the used filters are enabled
+* together with a single write of the Acceptance Filter Register.
+*
+* While the filters are disabled the device accepts every frame, the caller
+* may discard frames received during the update.
+*
+* @param	InstancePtr is a pointer to the XCanPs instance.
+* @param	TablePtr is a pointer to the filter table. Its first NumFilters
+*		entries are written to Acceptance Filter No. 1 onwards, use
+*		XCANPS_IDR_* defined in xcanps_hw.h or
+*		XCanPs_AcceptFilterBuildTable() to create the values.
+*
+* @return
+*		- XST_SUCCESS if the table was applied successfully.
+*		- XST_FAILURE if the CAN device did not become ready to accept
+*		writes to AFMR and AFIR. The previously enabled filters are
+*		enabled again.
+*
+* @note		None.
+*
+******************************************************************************/
+s32 XCanPs_AcceptFilterSetTable(XCanPs *InstancePtr,
+			const XCanPs_FilterTable *TablePtr)
+{
+	u32 EnabledFilters;
+	u32 Timeout = XCANPS_FILTER_BUSY_TIMEOUT;
+	u32 Index;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(TablePtr != NULL);
+	Xil_AssertNonvoid(TablePtr->NumFilters <= XCANPS_NUM_FILTERS);
+
+	EnabledFilters = XCanPs_AcceptFilterGetEnabled(InstancePtr);
+	XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr, XCANPS_AFR_OFFSET,
+			(u32)0);
+
+	while ((XCanPs_IsAcceptFilterBusy(InstancePtr) == TRUE) &&
+		(Timeout != (u32)0)) {
+		Timeout--;
+	}
+
+	if (Timeout == (u32)0) {
+		XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr,
+				XCANPS_AFR_OFFSET, EnabledFilters);
+		Status = XST_FAILURE;
+	} else {
+
+		/*
+		 * The AFMR/AFIR pairs are 8 bytes apart, starting with filter 1.
+		 */
+		for (Index = 0U; Index < TablePtr->NumFilters; Index++) {
+			XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr,
+					XCANPS_AFMR1_OFFSET + (Index * 8U),
+					TablePtr->MaskValue[Index]);
+			XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr,
+					XCANPS_AFIR1_OFFSET + (Index * 8U),
+					TablePtr->IdValue[Index]);
+		}
+
+		XCanPs_WriteReg(InstancePtr->CanConfig.BaseAddr,
+				XCANPS_AFR_OFFSET,
+				((u32)1 << TablePtr->NumFilters) - (u32)1);
+		Status = XST_SUCCESS;
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function computes an acceptance filter table for a list of standard
+* identifiers. Up to XCANPS_NUM_FILTERS identifiers get a filter each and are
+* matched exactly. Longer lists are split into XCANPS_NUM_FILTERS runs of
+* consecutive entries, each run gets a filter that matches the identifier bits
+* common to the run.
+*
+* Only standard frames pass the filters. With more identifiers than filters,
+* frames with other identifiers sharing the common bits pass as well, and the
+* caller has to check the identifier of the received frames.
+*
+* @param	StandardIds is a pointer to the list of 11-bit standard
+*		identifiers. Sorting the list in ascending order keeps the
+*		runs close together and the filters tight.
+* @param	NumIds is the number of identifiers in the list.
+* @param	TablePtr is a pointer to the filter table filled by this
+*		function, to be applied with XCanPs_AcceptFilterSetTable().
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XCanPs_AcceptFilterBuildTable(const u32 *StandardIds, u32 NumIds,
+			XCanPs_FilterTable *TablePtr)
+{
+	u32 NumFilters;
+	u32 Filter;
+	u32 First;
+	u32 Last;
+	u32 Index;
+	u32 DiffBits;
+
+	Xil_AssertVoid(StandardIds != NULL);
+	Xil_AssertVoid(TablePtr != NULL);
+
+	if (NumIds < XCANPS_NUM_FILTERS) {
+		NumFilters = NumIds;
+	} else {
+		NumFilters = XCANPS_NUM_FILTERS;
+	}
+
+	for (Filter = 0U; Filter < NumFilters; Filter++) {
+		First = (Filter * NumIds) / NumFilters;
+		Last = ((Filter + 1U) * NumIds) / NumFilters;
+
+		DiffBits = 0U;
+		for (Index = First + 1U; Index < Last; Index++) {
+			DiffBits |= StandardIds[Index] ^ StandardIds[First];
+		}
+
+		TablePtr->MaskValue[Filter] = ((~DiffBits <<
+					XCANPS_IDR_ID1_SHIFT) &
+					XCANPS_IDR_ID1_MASK) |
+					XCANPS_IDR_IDE_MASK;
+		TablePtr->IdValue[Filter] = (StandardIds[First] <<
+					XCANPS_IDR_ID1_SHIFT) &
+					XCANPS_IDR_ID1_MASK;
+	}
+
+	TablePtr->NumFilters = NumFilters;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -201,6 +201,9 @@
 *     ms      03/17/17  Added readme.txt file in examples folder for doxygen
 *                       generation.
 * 3.3 sne     08/06/19	Fixed coverity warnings.
+*     adk     10/15/19	Added XCanPs_SendBatch(), XCanPs_RecvBatch(),
+*			XCanPs_AcceptFilterSetTable() and
+*			XCanPs_AcceptFilterBuildTable().
 *
 * </pre>
 *
@@ -239,6 +242,14 @@ extern "C" {
 #define XCANPS_HANDLER_EVENT  4U /**< Handler type for all other interrupts */
 /* @} */
 
+/** @name FIFO and acceptance filter sizes
+ *  @{
+ */
+#define XCANPS_FIFO_DEPTH	64U /**< Frames in the TX FIFO and RX FIFO */
+#define XCANPS_FRAME_WORDS	4U  /**< Words of a frame in a batch buffer */
+#define XCANPS_NUM_FILTERS	4U  /**< Number of acceptance filters */
+/* @} */
+
 /**************************** Type Definitions *******************************/
 
 /**
@@ -259,6 +270,16 @@ typedef struct {
 *******************************************************************************/
 typedef void (*XCanPs_SendRecvHandler) (void *CallBackRef);
 
+/**
+ * This typedef contains the values of all acceptance filters, applied at once
+ * by XCanPs_AcceptFilterSetTable(). Entry n is written to AFMRn+1/AFIRn+1.
+ */
+typedef struct {
+	u32 NumFilters;		/**< Number of filters used, 0 to 4 */
+	u32 MaskValue[XCANPS_NUM_FILTERS]; /**< Acceptance Filter Mask values */
+	u32 IdValue[XCANPS_NUM_FILTERS];   /**< Acceptance Filter ID values */
+} XCanPs_FilterTable;
+
 /******************************************************************************/
 /**
  * Callback type for error interrupt.
@@ -319,6 +340,9 @@ typedef struct {
 	XCanPs_EventHandler EventHandler;
 	void *EventRef;
 
+	u32 TxFifoRoom;		/**< Frames known to fit in the TX FIFO */
+	u32 RxFifoLevel;	/**< Frames known to sit in the RX FIFO */
+
 } XCanPs;
 
 
@@ -522,12 +546,20 @@ u32 XCanPs_GetBusErrorStatus(XCanPs *InstancePtr);
 void XCanPs_ClearBusErrorStatus(XCanPs *InstancePtr, u32 Mask);
 s32 XCanPs_Send(XCanPs *InstancePtr, u32 *FramePtr);
 s32 XCanPs_Recv(XCanPs *InstancePtr, u32 *FramePtr);
+s32 XCanPs_SendBatch(XCanPs *InstancePtr, u32 *FramePtr, u32 NumFrames,
+			u32 *SentPtr);
+s32 XCanPs_RecvBatch(XCanPs *InstancePtr, u32 *FramePtr, u32 MaxFrames,
+			u32 *RecvdPtr);
 s32 XCanPs_SendHighPriority(XCanPs *InstancePtr, u32 *FramePtr);
 void XCanPs_AcceptFilterEnable(XCanPs *InstancePtr, u32 FilterIndexes);
 void XCanPs_AcceptFilterDisable(XCanPs *InstancePtr, u32 FilterIndexes);
 u32 XCanPs_AcceptFilterGetEnabled(XCanPs *InstancePtr);
 s32 XCanPs_AcceptFilterSet(XCanPs *InstancePtr, u32 FilterIndex,
 			 u32 MaskValue, u32 IdValue);
+s32 XCanPs_AcceptFilterSetTable(XCanPs *InstancePtr,
+			const XCanPs_FilterTable *TablePtr);
+void XCanPs_AcceptFilterBuildTable(const u32 *StandardIds, u32 NumIds,
+			XCanPs_FilterTable *TablePtr);
 void XCanPs_AcceptFilterGet(XCanPs *InstancePtr, u32 FilterIndex,
 			  u32 *MaskValue, u32 *IdValue);
 
@@ -41,6 +41,9 @@
 * 3.00  kvn    02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.1   nsk    12/21/15 Updated XCanPs_IntrHandler to handle error
 *			interrupts correctly. CR#925615
+* 3.3   adk    10/15/19 Track the FIFO levels of the watermark interrupts for
+*			the batched send and receive, TX FIFO empty invokes
+*			the send callback.
 * </pre>
 *
 ******************************************************************************/
@@ -296,6 +299,25 @@ void XCanPs_IntrHandler(void *InstancePtr)
 	}
 
 
+	/*
+	 * Remember the FIFO levels reported by the watermark interrupts, they
+	 * have just been cleared and XCanPs_SendBatch()/XCanPs_RecvBatch()
+	 * called from the callbacks use them to skip status reads.
+	 */
+	if (((PendingIntr & XCANPS_IXR_RXFWMFLL_MASK) != (u32)0) &&
+		((u32)XCanPs_GetRxIntrWatermark(CanPtr) > CanPtr->RxFifoLevel)) {
+		CanPtr->RxFifoLevel = (u32)XCanPs_GetRxIntrWatermark(CanPtr);
+	}
+	if ((PendingIntr & XCANPS_IXR_TXFEMP_MASK) != (u32)0) {
+		CanPtr->TxFifoRoom = XCANPS_FIFO_DEPTH;
+	} else if ((PendingIntr & XCANPS_IXR_TXFWMEMP_MASK) != (u32)0) {
+		CanPtr->TxFifoRoom = XCANPS_FIFO_DEPTH -
+				(u32)XCanPs_GetTxIntrWatermark(CanPtr);
+	} else {
+		/*This else was made for misra-c compliance*/
+		;
+	}
+
 	if (((PendingIntr & (XCANPS_IXR_RXFWMFLL_MASK |
 			XCANPS_IXR_RXNEMP_MASK)) != (u32)0) &&
 		(CanPtr->RecvHandler != NULL)) {
@@ -320,7 +342,8 @@ void XCanPs_IntrHandler(void *InstancePtr)
 	/*
 	 * A frame was transmitted successfully.
 	 */
-	if (((PendingIntr & (XCANPS_IXR_TXOK_MASK | XCANPS_IXR_TXFWMEMP_MASK)) != (u32)0) &&
+	if (((PendingIntr & (XCANPS_IXR_TXOK_MASK | XCANPS_IXR_TXFWMEMP_MASK |
+			XCANPS_IXR_TXFEMP_MASK)) != (u32)0) &&
 		(CanPtr->SendHandler != NULL)) {
 		CanPtr->SendHandler(CanPtr->SendRef);
 	}
@@ -30,8 +30,8 @@
 * @addtogroup clk_wiz_v1_2
 * @{
 *
-* This file implements the functions to get the CLK_WIZ GUI information and
-* Clock Monitor Interrupt status
+* This file implements the functions to get the CLK_WIZ GUI information,
+* Clock Monitor Interrupt status and the dynamic reconfiguration functions
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -42,6 +42,7 @@
 * 1.1 siv 8/17/16 Used UINTPTR instead of u32 for Baseaddress
 * 	Changed the prototype of XClk_Wiz_CfgInitialize
 * 1.2 ms  3/02/17 Fixed compilation warnings. Fix for CR-970507.
+* 1.3 adk 10/15/19 Added XClk_Wiz_ComputeSetting and XClk_Wiz_ApplySetting.
 * </pre>
 ******************************************************************************/
 
@@ -166,4 +167,163 @@ static void StubErrCallBack(void *CallBackRef, u32 ErrorMask)
 	(void) ErrorMask;
 	Xil_AssertVoidAlways();
 }
+
+/*****************************************************************************/
+/**
+* XClk_Wiz_ComputeSetting searches the DIVCLK_DIVIDE, CLKFBOUT_MULT and
+* CLKOUT_DIVIDE values which give the output frequencies closest to the
+* requested ones, and stores them as register images. Integer dividers are
+* used and the search only uses integer math, so that it can run on
+* processors without an FPU.
+*
+* @param	SettingPtr is the setting to fill.
+* @param	RefClkKhz is the input clock frequency in kHz.
+* @param	OutClkKhz is the array of requested CLKOUT0.. frequencies in
+*		kHz.
+* @param	NumOutputs is the number of entries in OutClkKhz.
+*
+* @return
+*		- XST_SUCCESS if a setting was found. SettingPtr->ErrorKhz
+*		  holds the sum of the frequency errors.
+*		- XST_FAILURE if no divider gives a valid VCO frequency.
+*
+* @note		The VCO and PFD limits are XCLK_WIZ_VCO_MIN_KHZ,
+*		XCLK_WIZ_VCO_MAX_KHZ and XCLK_WIZ_PFD_MIN_KHZ.
+*
+****************************************************************************/
+u32 XClk_Wiz_ComputeSetting(XClk_Wiz_Setting *SettingPtr, u32 RefClkKhz,
+			const u32 *OutClkKhz, u32 NumOutputs)
+{
+	u32 Div;
+	u32 Mult;
+	u32 Vco;
+	u32 OutDiv[XCLK_WIZ_MAX_OUTPUTS];
+	u32 Err;
+	u32 Freq;
+	u32 Index;
+	u32 BestErr = 0xFFFFFFFFU;
+
+	Xil_AssertNonvoid(SettingPtr != NULL);
+	Xil_AssertNonvoid(OutClkKhz != NULL);
+	Xil_AssertNonvoid((NumOutputs > 0U) &&
+			(NumOutputs <= (u32)XCLK_WIZ_MAX_OUTPUTS));
+	Xil_AssertNonvoid(RefClkKhz > 0U);
+
+	for (Div = 1U; Div <= XCLK_WIZ_DIVCLK_MAX; Div++) {
+		if ((RefClkKhz / Div) < XCLK_WIZ_PFD_MIN_KHZ) {
+			break;
+		}
+		for (Mult = XCLK_WIZ_MULT_MIN; Mult <= XCLK_WIZ_MULT_MAX;
+								Mult++) {
+			Vco = (u32)(((u64)RefClkKhz * Mult) / Div);
+			if (Vco < XCLK_WIZ_VCO_MIN_KHZ) {
+				continue;
+			}
+			if (Vco > XCLK_WIZ_VCO_MAX_KHZ) {
+				break;
+			}
+
+			Err = 0U;
+			for (Index = 0U; (Index < NumOutputs) &&
+					(Err < BestErr); Index++) {
+				Xil_AssertNonvoid(OutClkKhz[Index] > 0U);
+				OutDiv[Index] = (Vco + (OutClkKhz[Index] / 2U)) /
+						OutClkKhz[Index];
+				if (OutDiv[Index] == 0U) {
+					OutDiv[Index] = 1U;
+				} else if (OutDiv[Index] >
+						XCLK_WIZ_CLKOUT_DIV_MAX) {
+					OutDiv[Index] = XCLK_WIZ_CLKOUT_DIV_MAX;
+				}
+				Freq = Vco / OutDiv[Index];
+				Err += (Freq > OutClkKhz[Index]) ?
+					(Freq - OutClkKhz[Index]) :
+					(OutClkKhz[Index] - Freq);
+			}
+			if (Err >= BestErr) {
+				continue;
+			}
+
+			BestErr = Err;
+			SettingPtr->Reg0 = (Mult << XCLK_WIZ_REG0_MULT_SHIFT) |
+						Div;
+			for (Index = 0U; Index < NumOutputs; Index++) {
+				SettingPtr->ClkOutDiv[Index] = OutDiv[Index];
+			}
+			if (BestErr == 0U) {
+				goto END;
+			}
+		}
+	}
+
+END:
+	if (BestErr == 0xFFFFFFFFU) {
+		return XST_FAILURE;
+	}
+	SettingPtr->NumOutputs = NumOutputs;
+	SettingPtr->ErrorKhz = BestErr;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* XClk_Wiz_ApplySetting writes a setting computed by XClk_Wiz_ComputeSetting
+* to the Clock Configuration Registers, loads it and waits for the MMCM/PLL to
+* lock again.
+*
+* @param	InstancePtr is the XClk_Wiz instance to operate on.
+* @param	SettingPtr is the setting to apply.
+*
+* @return
+*		- XST_SUCCESS if the clock locked with the new setting.
+*		- XST_FAILURE if it did not lock within XCLK_WIZ_LOCK_TIMEOUT
+*		  polls.
+*
+* @note		The core must be configured with dynamic reconfiguration
+*		through the AXI4-Lite interface.
+*
+****************************************************************************/
+u32 XClk_Wiz_ApplySetting(XClk_Wiz *InstancePtr,
+			const XClk_Wiz_Setting *SettingPtr)
+{
+	UINTPTR BaseAddr;
+	u32 Index;
+	u32 Count;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(SettingPtr != NULL);
+	Xil_AssertNonvoid(SettingPtr->NumOutputs <=
+			(u32)XCLK_WIZ_MAX_OUTPUTS);
+
+	BaseAddr = InstancePtr->Config.BaseAddr;
+
+	XClk_Wiz_WriteReg(BaseAddr, XCLK_WIZ_REG0_OFFSET, SettingPtr->Reg0);
+	for (Index = 0U; Index < SettingPtr->NumOutputs; Index++) {
+		XClk_Wiz_WriteReg(BaseAddr, XCLK_WIZ_CLKOUT0_DIV_OFFSET +
+				(Index * XCLK_WIZ_CLKOUT_STRIDE),
+				SettingPtr->ClkOutDiv[Index]);
+	}
+	XClk_Wiz_WriteReg(BaseAddr, XCLK_WIZ_RECONFIG_OFFSET,
+			XCLK_WIZ_RECONFIG_LOAD_MASK |
+			XCLK_WIZ_RECONFIG_SADDR_MASK);
+
+	/* The lock drops once the new setting is loaded */
+	for (Count = 0U; Count < XCLK_WIZ_LOCK_TIMEOUT; Count++) {
+		if ((XClk_Wiz_ReadReg(BaseAddr, XCLK_WIZ_STATUS_OFFSET) &
+				XCLK_WIZ_STATUS_LOCKED_MASK) == 0U) {
+			break;
+		}
+	}
+
+	for (Count = 0U; Count < XCLK_WIZ_LOCK_TIMEOUT; Count++) {
+		if ((XClk_Wiz_ReadReg(BaseAddr, XCLK_WIZ_STATUS_OFFSET) &
+				XCLK_WIZ_STATUS_LOCKED_MASK) != 0U) {
+			return XST_SUCCESS;
+		}
+	}
+
+	return XST_FAILURE;
+}
 /** @} */
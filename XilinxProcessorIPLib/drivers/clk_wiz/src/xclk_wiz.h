@@ -54,6 +54,14 @@
 *  -  Select reference clock frequency
 *  -  Select 4 user clock frequencies
 *
+* <b>Dynamic Reconfiguration</b>
+*  -  XClk_Wiz_ComputeSetting() searches the integer DIVCLK, CLKFBOUT and
+*     CLKOUT dividers for a set of output frequencies and stores the register
+*     images in a XClk_Wiz_Setting. It is meant to be called once per video
+*     mode or rate at init time, or the settings can be built offline.
+*  -  XClk_Wiz_ApplySetting() writes a setting with one pass over the Clock
+*     Configuration Registers, loads it and waits for lock.
+*
 * <b>Pre-Requisite's</b>
 *
 *
@@ -98,6 +106,9 @@
 *                  and warnings in xclk_wiz.c files. Fix for CR-970507.
 *     ms  03/17/17 Added readme.txt file in examples folder for doxygen
 *                  generation.
+* 1.3 adk 10/15/19 Added XClk_Wiz_ComputeSetting and XClk_Wiz_ApplySetting
+*                  to switch between precomputed dynamic reconfiguration
+*                  settings.
 * </pre>
 *
 ******************************************************************************/
@@ -131,6 +142,27 @@ extern "C" {
 
 /*@}*/
 
+/** @name Dynamic reconfiguration limits
+ * The defaults are the 7 series MMCME2 limits, in kHz.
+ * @{
+ */
+#define XCLK_WIZ_MAX_OUTPUTS		7	/**< CLKOUT0..6 */
+#ifndef XCLK_WIZ_VCO_MIN_KHZ
+#define XCLK_WIZ_VCO_MIN_KHZ		600000U	/**< Minimum VCO frequency */
+#endif
+#ifndef XCLK_WIZ_VCO_MAX_KHZ
+#define XCLK_WIZ_VCO_MAX_KHZ		1200000U /**< Maximum VCO frequency */
+#endif
+#ifndef XCLK_WIZ_PFD_MIN_KHZ
+#define XCLK_WIZ_PFD_MIN_KHZ		10000U	/**< Minimum PFD frequency */
+#endif
+#define XCLK_WIZ_DIVCLK_MAX		106U	/**< DIVCLK_DIVIDE range */
+#define XCLK_WIZ_MULT_MIN		2U	/**< CLKFBOUT_MULT range */
+#define XCLK_WIZ_MULT_MAX		64U
+#define XCLK_WIZ_CLKOUT_DIV_MAX		128U	/**< CLKOUT_DIVIDE range */
+#define XCLK_WIZ_LOCK_TIMEOUT		100000U	/**< Lock status polls */
+/*@}*/
+
 /*****************************************************************************/
 /**
 * The configuration structure for CLK_WIZ Controller
@@ -157,6 +189,18 @@ typedef struct {
 				going as input to the PLL/MMCM */
 } XClk_Wiz_Config;
 
+/**
+* Precomputed dynamic reconfiguration setting. The members hold the values of
+* the Clock Configuration Registers, they are written as is by
+* XClk_Wiz_ApplySetting().
+*/
+typedef struct {
+	u32 Reg0;		/**< DIVCLK_DIVIDE and CLKFBOUT_MULT */
+	u32 ClkOutDiv[XCLK_WIZ_MAX_OUTPUTS]; /**< CLKOUT divide registers */
+	u32 NumOutputs;		/**< CLKOUTs programmed */
+	u32 ErrorKhz;		/**< Sum of the output frequency errors */
+} XClk_Wiz_Setting;
+
 /*****************************************************************************/
 /**
 *
@@ -419,6 +463,10 @@ void XClk_Wiz_GetInterruptSettings(XClk_Wiz  *InstancePtr);
 
 int XClk_Wiz_SetCallBack(XClk_Wiz *InstancePtr, u32 HandleType,
 			void *CallBackFunc, void *CallBackRef);
+u32 XClk_Wiz_ComputeSetting(XClk_Wiz_Setting *SettingPtr, u32 RefClkKhz,
+			const u32 *OutClkKhz, u32 NumOutputs);
+u32 XClk_Wiz_ApplySetting(XClk_Wiz *InstancePtr,
+			const XClk_Wiz_Setting *SettingPtr);
 
 #ifdef __cplusplus
 }
@@ -37,6 +37,7 @@
  * Ver Who Date     Changes
  * ----- ---- -------- -------------------------------------------------------
  * 1.0 ram 02/12/16 Initial version for Clock Wizard
+ * 1.3 adk 10/15/19 Added the dynamic reconfiguration registers
  * </pre>
  *
  *****************************************************************************/
@@ -61,11 +62,36 @@ extern "C" {
  *  @{
  */
 
+#define XCLK_WIZ_SRR_OFFSET	0x00000000  /**< Software Reset Register */
+#define XCLK_WIZ_STATUS_OFFSET	0x00000004  /**< Status Register */
 #define XCLK_WIZ_ISR_OFFSET	0x0000000C  /**< Interrupt Status Register */
 #define XCLK_WIZ_IER_OFFSET	0x00000010  /**< Interrupt Enable Register */
+#define XCLK_WIZ_REG0_OFFSET	0x00000200  /**< Clock Configuration
+						Register 0 */
+#define XCLK_WIZ_CLKOUT0_DIV_OFFSET	0x00000208  /**< CLKOUT0 divide
+							register */
+#define XCLK_WIZ_CLKOUT_STRIDE	0x0000000C  /**< Registers of one CLKOUT */
+#define XCLK_WIZ_RECONFIG_OFFSET	0x0000025C  /**< Clock Configuration
+							Register 23 */
 
 /*@}*/
 
+/** @name Bitmasks of the dynamic reconfiguration registers
+ * @{
+ */
+
+#define XCLK_WIZ_STATUS_LOCKED_MASK	0x00000001 /**< MMCM/PLL locked */
+#define XCLK_WIZ_REG0_DIVCLK_MASK	0x000000FF /**< DIVCLK_DIVIDE */
+#define XCLK_WIZ_REG0_MULT_SHIFT	         8 /**< CLKFBOUT_MULT shift */
+#define XCLK_WIZ_REG0_MULT_MASK		0x0000FF00 /**< CLKFBOUT_MULT */
+#define XCLK_WIZ_CLKOUT_DIV_MASK	0x000000FF /**< CLKOUT_DIVIDE */
+#define XCLK_WIZ_RECONFIG_LOAD_MASK	0x00000001 /**< Load the Clock
+							Configuration Registers */
+#define XCLK_WIZ_RECONFIG_SADDR_MASK	0x00000002 /**< Use the written
+							values, not the
+							defaults */
+/*@}*/
+
 /** @name Bitmasks and offsets of XCLK_WIZ_ISR_OFFSET register
  * This register is used to display interrupt status register
  * @{
@@ -40,6 +40,8 @@
 * --- --- -------- ------------------------------------------------------------
 * 1.0 vsa 06/17/15 Initial release
 * 1.1 sss 08/17/16 Added 64 bit support
+* 1.3 adk 10/15/19 XCsi_GetShortPacket returns the packets read by the
+*                  interrupt handler while the frame timing is enabled.
 * </pre>
 ******************************************************************************/
 
@@ -115,6 +117,10 @@ u32 XCsi_CfgInitialize(XCsi *InstancePtr, XCsi_Config *CfgPtr,
 	InstancePtr->VCXErrCallBack = StubErrCallBack;
 	InstancePtr->ErrorCallBack = StubErrCallBack;
 
+	/* Frame timing is disabled until a time stamp handler is set */
+	InstancePtr->TimeStampHandler = NULL;
+	InstancePtr->SpktCount = 0;
+
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
 
 	return XST_SUCCESS;
@@ -303,6 +309,10 @@ u32 XCsi_Configure(XCsi *InstancePtr)
 *
 * @return 	None
 *
+* @note		While the frame timing is enabled the FIFO is drained by the
+*		interrupt handler and the oldest packet it kept is returned
+*		instead. ShortPacketStruct is left untouched when there is none.
+*
 ****************************************************************************/
 void XCsi_GetShortPacket(XCsi *InstancePtr, XCsi_SPktData *ShortPacketStruct)
 {
@@ -312,6 +322,11 @@ void XCsi_GetShortPacket(XCsi *InstancePtr, XCsi_SPktData *ShortPacketStruct)
 	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(ShortPacketStruct != NULL);
 
+	if (InstancePtr->TimeStampHandler != NULL) {
+		(void)XCsi_TimingGetShortPacket(InstancePtr, ShortPacketStruct);
+		return;
+	}
+
 	/* Read Generic Packet from register */
 	Value = XCsi_ReadReg(InstancePtr->Config.BaseAddr, XCSI_SPKTR_OFFSET);
 
@@ -80,6 +80,23 @@
 *	- Invalid Data ID
 *	- Frame Sync and Level Errors for Virtual Channels
 *
+* <b> Frame Timing </b>
+*
+* When a time stamp handler is installed with XCsi_SetTimeStampHandler(), the
+* interrupt handler drains the Short Packet FIFO itself and time stamps the
+* Frame Start and Frame End packets of virtual channels 0 to 3, the channels
+* the Generic Short Packet register reports. The frame numbers carried by the
+* Frame Start packets reveal the frames lost upstream. The other short packets
+* are kept in a small ring and returned by XCsi_GetShortPacket(). The Short
+* Packet FIFO Not Empty interrupt must be enabled for the timing to work.
+*
+* When each virtual channel is routed to its own frame buffer write instance,
+* XCsi_VcFrameWrittenHandler() is installed as the done callback of that
+* instance, with the reference returned by XCsi_GetVcTimingRef(). The latency
+* from Frame End to the frame being in memory is then measured as well.
+* XCsi_GetVcStartSkew() returns the spread of the last Frame Start of a set of
+* channels, for instance cameras which are expected to run in sync.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -114,6 +131,7 @@
 *     ms  04/05/17 Modified Comment lines in functions of csi
 *                  examples to recognize it as documentation block
 *                  for doxygen generation of examples.
+* 1.3 adk 10/15/19 Added per virtual channel frame timing and statistics.
 * </pre>
 *
 ******************************************************************************/
@@ -156,6 +174,19 @@ extern "C" {
 #define XCSI_V20_MAX_VC	16	/**< Max Virtual Channels supported for v2.0 */
 #define XCSI_MAX_VC	16	/**< Max Virtual Channels supported for CSI */
 
+#define XCSI_TIMING_MAX_VC	XCSI_V10_MAX_VC	/**< Virtual Channels reported
+						  *  by the Short Packet
+						  *  register */
+#define XCSI_SPKT_RING_SIZE	16	/**< Short packets kept while the
+					  *  frame timing is enabled */
+
+/** @name Short Packet Data Types
+ * @{
+*/
+#define XCSI_SPKT_DT_FS		0x00	/**< Frame Start */
+#define XCSI_SPKT_DT_FE		0x01	/**< Frame End */
+/*@}*/
+
 /**************************** Type Definitions *******************************/
 
 /**
@@ -200,6 +231,54 @@ typedef struct {
 	u8 SkewCalHs;	/**< Data Lane Skew Reception status */
 } XCsi_DataLaneInfo;
 
+/**
+* This typedef contains the frame timing statistics of a Virtual Channel.
+* Times are in the units of the time stamp handler.
+*/
+typedef struct {
+	u32 FramesStarted;	/**< Frame Start packets received */
+	u32 FramesEnded;	/**< Frame End packets received */
+	u32 FramesWritten;	/**< Frames written by the frame buffer */
+	u32 FramesDropped;	/**< Frames missing from the frame numbers */
+	u32 FramesIncomplete;	/**< Frame Start without Frame End */
+	u64 LastStart;		/**< Time of the last Frame Start */
+	u64 LastEnd;		/**< Time of the last Frame End */
+	u64 PeriodMin;		/**< Min time between Frame Starts */
+	u64 PeriodMax;		/**< Max time between Frame Starts */
+	u64 DurationMin;	/**< Min time from Frame Start to Frame End */
+	u64 DurationMax;	/**< Max time from Frame Start to Frame End */
+	u64 LatencyMin;		/**< Min time from Frame End to written */
+	u64 LatencyMax;		/**< Max time from Frame End to written */
+	u64 LatencyLast;	/**< Last time from Frame End to written */
+} XCsi_VcStats;
+
+/**
+* This typedef contains the frame timing state of a Virtual Channel.
+*/
+typedef struct {
+	void *CsiPtr;		/**< XCsi instance the channel belongs to */
+	u8 Vc;			/**< Virtual Channel number */
+	u8 InFrame;		/**< Frame Start received, Frame End pending */
+	u8 EndPending;		/**< Frame End not yet matched by a write */
+	u16 FrameNum;		/**< Frame number of the last Frame Start */
+	u64 StartTime;		/**< Time of the current Frame Start */
+	u64 EndTime;		/**< Time of the last Frame End */
+	XCsi_VcStats Stats;	/**< Statistics */
+} XCsi_VcTiming;
+
+/**
+*
+* Callback type returning a free running time stamp, used for the frame
+* timing.
+*
+* @param	TimeStampRef is the reference passed to
+*		XCsi_SetTimeStampHandler().
+*
+* @return	Current time.
+*
+ *****************************************************************************/
+typedef u64 (*XCsi_TimeStampHandler) (void *TimeStampRef);
+
 /**
 * The configuration structure for CSI Controller
 *
@@ -272,6 +351,17 @@ typedef struct {
 					  *  like Stream Line Buffer Full,
 					  *  Stop State errors */
 	void *VCXErrRef; /**< To be passed to the Error Call back */
+	XCsi_TimeStampHandler TimeStampHandler;	/**< Time stamps for the
+						  *  frame timing, NULL when
+						  *  disabled */
+	void *TimeStampRef;	/**< To be passed to the time stamp handler */
+	XCsi_VcTiming VcTiming[XCSI_TIMING_MAX_VC];	/**< Frame timing */
+	XCsi_SPktData SpktRing[XCSI_SPKT_RING_SIZE];	/**< Short packets
+							  *  read by the
+							  *  interrupt handler */
+	u8 SpktHead;		/**< Oldest entry of SpktRing */
+	u8 SpktCount;		/**< Entries in SpktRing */
+	u32 SpktOverflow;	/**< Short packets lost as SpktRing was full */
 	u32 IsReady; /**< Driver is ready */
 } XCsi;
 
@@ -710,6 +800,19 @@ void XCsi_IntrDisable(XCsi *InstancePtr, u32 Mask);
 u32 XCsi_GetIntrStatus(XCsi *InstancePtr);
 void XCsi_InterruptClear(XCsi *InstancePtr, u32 Mask);
 
+/* Frame timing functions in xcsi_timing.c */
+void XCsi_SetTimeStampHandler(XCsi *InstancePtr,
+				XCsi_TimeStampHandler TimeStampHandler,
+				void *TimeStampRef);
+void XCsi_TimingReadShortPackets(XCsi *InstancePtr);
+u8 XCsi_TimingGetShortPacket(XCsi *InstancePtr,
+				XCsi_SPktData *ShortPacketStruct);
+void *XCsi_GetVcTimingRef(XCsi *InstancePtr, u8 Vc);
+void XCsi_VcFrameWrittenHandler(void *CallbackRef);
+void XCsi_GetVcStats(XCsi *InstancePtr, u8 Vc, XCsi_VcStats *StatsPtr);
+void XCsi_ResetVcStats(XCsi *InstancePtr);
+u64 XCsi_GetVcStartSkew(XCsi *InstancePtr, u32 VcMask);
+
 #ifdef __cplusplus
 }
 #endif
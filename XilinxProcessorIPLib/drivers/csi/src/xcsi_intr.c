@@ -41,6 +41,7 @@
 * Ver Who Date     Changes
 * --- --- -------- ------------------------------------------------------------
 * 1.0 vsa 07/28/15 Initial release
+* 1.3 adk 10/15/19 Drain the Short Packet FIFO for the frame timing.
 * </pre>
 ******************************************************************************/
 
@@ -303,6 +304,7 @@ void XCsi_IntrHandler(void *InstancePtr)
 {
 	u32 ActiveIntr;
 	u32 Mask;
+	u32 SpktMask;
 
 	XCsi *XCsiPtr = (XCsi *)InstancePtr;
 
@@ -313,6 +315,16 @@ void XCsi_IntrHandler(void *InstancePtr)
 	/* Get Active interrupts */
 	ActiveIntr = XCsi_GetIntrStatus(XCsiPtr);
 
+	SpktMask = ActiveIntr & XCSI_INTR_SPKT_MASK;
+	if ((SpktMask != 0) && (XCsiPtr->TimeStampHandler != NULL)) {
+		/* Time stamp the Frame Start/End packets before anything
+		 * else, keep the other packets for the callback */
+		XCsi_TimingReadShortPackets(XCsiPtr);
+		if (XCsiPtr->SpktCount == 0) {
+			SpktMask &= ~XCSI_ISR_SPFIFONE_MASK;
+		}
+	}
+
 	Mask = ActiveIntr & XCSI_INTR_FRAMERCVD_MASK;
 	if (Mask) {
 		/* If Frame received then call corresponding callback function */
@@ -326,11 +338,10 @@ void XCsi_IntrHandler(void *InstancePtr)
 		XCsiPtr->ErrorCallBack(XCsiPtr->ErrRef,	Mask);
 	}
 
-	Mask = ActiveIntr & XCSI_INTR_SPKT_MASK;
-	if (Mask) {
+	if (SpktMask) {
 		/* If ShortPacket Interrupts then call corresponding
 		 * callback function */
-		XCsiPtr->ShortPacketCallBack(XCsiPtr->ShortPacketRef, Mask);
+		XCsiPtr->ShortPacketCallBack(XCsiPtr->ShortPacketRef, SpktMask);
 	}
 
 	Mask = ActiveIntr & XCSI_INTR_DPHY_MASK;
@@ -0,0 +1,465 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xcsi_timing.c
+* @addtogroup csi_v1_1
+* @{
+*
+* This file implements the per virtual channel frame timing of the CSI2 Rx
+* Controller. The Frame Start and Frame End short packets are time stamped
+* when the interrupt handler drains the Short Packet FIFO, the frames written
+* to memory are time stamped by the done callback of the frame buffer write
+* instance the virtual channel is routed to.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver Who Date     Changes
+* --- --- -------- ------------------------------------------------------------
+* 1.3 adk 10/15/19 Initial release
+* </pre>
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xparameters.h"
+#include "xcsi.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XCSI_SPKT_DRAIN_MAX	64	/**< Max short packets read per
+					  *  interrupt */
+
+/**************************** Type Definitions *******************************/
+
+
+/************************** Macros Definitions *******************************/
+
+
+/************************** Function Prototypes ******************************/
+
+static void XCsi_TimingMinMax(u64 Value, u64 *MinPtr, u64 *MaxPtr);
+static void XCsi_TimingFrameStart(XCsi_VcTiming *VcPtr, u16 FrameNum,
+					u64 Now);
+static void XCsi_TimingFrameEnd(XCsi_VcTiming *VcPtr, u64 Now);
+
+/************************** Variable Definitions *****************************/
+
+
+/************************** Function Definitions ******************************/
+
+/*****************************************************************************/
+/**
+* This function installs the time stamp handler used for the frame timing
+* and resets the timing state of all the virtual channels.
+*
+* @param	InstancePtr is the XCsi instance to operate on
+* @param	TimeStampHandler returns a free running time stamp, NULL to
+*		disable the frame timing.
+* @param	TimeStampRef is passed to TimeStampHandler.
+*
+* @return	None
+*
+* @note		To be called while the CSI interrupts are disabled.
+*
+****************************************************************************/
+void XCsi_SetTimeStampHandler(XCsi *InstancePtr,
+				XCsi_TimeStampHandler TimeStampHandler,
+				void *TimeStampRef)
+{
+	u32 Vc;
+
+	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	for (Vc = 0; Vc < XCSI_TIMING_MAX_VC; Vc++) {
+		(void)memset(&InstancePtr->VcTiming[Vc], 0,
+				sizeof(XCsi_VcTiming));
+		InstancePtr->VcTiming[Vc].CsiPtr = InstancePtr;
+		InstancePtr->VcTiming[Vc].Vc = (u8)Vc;
+	}
+
+	InstancePtr->SpktHead = 0;
+	InstancePtr->SpktCount = 0;
+	InstancePtr->SpktOverflow = 0;
+
+	InstancePtr->TimeStampRef = TimeStampRef;
+	InstancePtr->TimeStampHandler = TimeStampHandler;
+}
+
+/*****************************************************************************/
+/**
+* This function drains the Short Packet FIFO. The Frame Start and Frame End
+* packets are accounted to their virtual channel, the other packets are kept
+* for XCsi_GetShortPacket().
+*
+* All the packets read are stamped with the same time, taken when the
+* function is entered, which is the closest to their arrival.
+*
+* @param	InstancePtr is the XCsi instance to operate on
+*
+* @return	None
+*
+* @note		Called by the interrupt handler while the frame timing is
+*		enabled.
+*
+****************************************************************************/
+void XCsi_TimingReadShortPackets(XCsi *InstancePtr)
+{
+	XCsi_SPktData *PktPtr;
+	XCsi_VcTiming *VcPtr;
+	u32 Count;
+	u32 Value;
+	u16 Data;
+	u8 DataType;
+	u8 Vc;
+	u64 Now;
+
+	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->TimeStampHandler != NULL);
+
+	Now = InstancePtr->TimeStampHandler(InstancePtr->TimeStampRef);
+
+	for (Count = 0; Count < XCSI_SPKT_DRAIN_MAX; Count++) {
+		if (XCsi_GetBitField(InstancePtr->Config.BaseAddr,
+				XCSI_CSR_OFFSET, XCSI_CSR_SPFIFONE_MASK,
+				XCSI_CSR_SPFIFONE_SHIFT) == 0) {
+			break;
+		}
+
+		Value = XCsi_ReadReg(InstancePtr->Config.BaseAddr,
+					XCSI_SPKTR_OFFSET);
+		Data = (Value & XCSI_SPKTR_DATA_MASK) >> XCSI_SPKTR_DATA_SHIFT;
+		Vc = (Value & XCSI_SPKTR_VC_MASK) >> XCSI_SPKTR_VC_SHIFT;
+		DataType = (Value & XCSI_SPKTR_DT_MASK) >> XCSI_SPKTR_DT_SHIFT;
+
+		VcPtr = &InstancePtr->VcTiming[Vc];
+		if (DataType == XCSI_SPKT_DT_FS) {
+			XCsi_TimingFrameStart(VcPtr, Data, Now);
+			continue;
+		}
+		if (DataType == XCSI_SPKT_DT_FE) {
+			XCsi_TimingFrameEnd(VcPtr, Now);
+			continue;
+		}
+
+		if (InstancePtr->SpktCount == XCSI_SPKT_RING_SIZE) {
+			InstancePtr->SpktOverflow++;
+			continue;
+		}
+
+		PktPtr = &InstancePtr->SpktRing[(InstancePtr->SpktHead +
+				InstancePtr->SpktCount) % XCSI_SPKT_RING_SIZE];
+		PktPtr->Data = Data;
+		PktPtr->DataType = DataType;
+		PktPtr->VirtualChannel = Vc;
+		InstancePtr->SpktCount++;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function takes the oldest short packet kept by the interrupt handler
+* while the frame timing is enabled.
+*
+* @param	InstancePtr is the XCsi instance to operate on
+* @param	ShortPacketStruct is filled up by this function.
+*
+* @return
+*		- 1 if a packet was returned.
+*		- 0 if no packet is pending.
+*
+* @note		To be called from the short packet callback or with the CSI
+*		interrupts disabled.
+*
+****************************************************************************/
+u8 XCsi_TimingGetShortPacket(XCsi *InstancePtr,
+				XCsi_SPktData *ShortPacketStruct)
+{
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(ShortPacketStruct != NULL);
+
+	if (InstancePtr->SpktCount == 0) {
+		return 0;
+	}
+
+	*ShortPacketStruct = InstancePtr->SpktRing[InstancePtr->SpktHead];
+	InstancePtr->SpktHead = (InstancePtr->SpktHead + 1) %
+					XCSI_SPKT_RING_SIZE;
+	InstancePtr->SpktCount--;
+
+	return 1;
+}
+
+/*****************************************************************************/
+/**
+* This function returns the reference to install, together with
+* XCsi_VcFrameWrittenHandler(), as the done callback of the frame buffer
+* write instance a virtual channel is routed to.
+*
+* @param	InstancePtr is the XCsi instance to operate on
+* @param	Vc is the virtual channel number, 0 to XCSI_TIMING_MAX_VC - 1.
+*
+* @return	Callback reference of the virtual channel.
+*
+****************************************************************************/
+void *XCsi_GetVcTimingRef(XCsi *InstancePtr, u8 Vc)
+{
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Vc < XCSI_TIMING_MAX_VC);
+
+	return &InstancePtr->VcTiming[Vc];
+}
+
+/*****************************************************************************/
+/**
+* This function is the done callback of the frame buffer write instance a
+* virtual channel is routed to. It counts the frame written and measures the
+* latency from the Frame End packet.
+*
+* @param	CallbackRef is the reference returned by XCsi_GetVcTimingRef().
+*
+* @return	None
+*
+* @note		The frame buffer interrupt must not preempt the CSI interrupt
+*		handler, or the other way around.
+*
+****************************************************************************/
+void XCsi_VcFrameWrittenHandler(void *CallbackRef)
+{
+	XCsi_VcTiming *VcPtr = (XCsi_VcTiming *)CallbackRef;
+	XCsi *CsiPtr;
+	u64 Latency;
+
+	/* Verify arguments */
+	Xil_AssertVoid(VcPtr != NULL);
+	Xil_AssertVoid(VcPtr->CsiPtr != NULL);
+
+	CsiPtr = (XCsi *)VcPtr->CsiPtr;
+	if (CsiPtr->TimeStampHandler == NULL) {
+		return;
+	}
+
+	VcPtr->Stats.FramesWritten++;
+
+	if (VcPtr->EndPending != 0) {
+		Latency = CsiPtr->TimeStampHandler(CsiPtr->TimeStampRef) -
+				VcPtr->EndTime;
+		VcPtr->Stats.LatencyLast = Latency;
+		XCsi_TimingMinMax(Latency, &VcPtr->Stats.LatencyMin,
+					&VcPtr->Stats.LatencyMax);
+		VcPtr->EndPending = 0;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function gets the frame timing statistics of a virtual channel.
+*
+* @param	InstancePtr is the XCsi instance to operate on
+* @param	Vc is the virtual channel number, 0 to XCSI_TIMING_MAX_VC - 1.
+* @param	StatsPtr is filled up by this function.
+*
+* @return	None
+*
+* @note		Minimum values are 0 until measured.
+*
+****************************************************************************/
+void XCsi_GetVcStats(XCsi *InstancePtr, u8 Vc, XCsi_VcStats *StatsPtr)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Vc < XCSI_TIMING_MAX_VC);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = InstancePtr->VcTiming[Vc].Stats;
+}
+
+/*****************************************************************************/
+/**
+* This function clears the frame timing statistics of all the virtual
+* channels.
+*
+* @param	InstancePtr is the XCsi instance to operate on
+*
+* @return	None
+*
+****************************************************************************/
+void XCsi_ResetVcStats(XCsi *InstancePtr)
+{
+	u32 Vc;
+
+	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	for (Vc = 0; Vc < XCSI_TIMING_MAX_VC; Vc++) {
+		(void)memset(&InstancePtr->VcTiming[Vc].Stats, 0,
+				sizeof(XCsi_VcStats));
+	}
+	InstancePtr->SpktOverflow = 0;
+}
+
+/*****************************************************************************/
+/**
+* This function returns the spread between the earliest and the latest of
+* the last Frame Start of a set of virtual channels.
+*
+* @param	InstancePtr is the XCsi instance to operate on
+* @param	VcMask has bit n set for virtual channel n to be included.
+*
+* @return	The skew in time stamp units, 0 if less than two of the
+*		channels have started a frame.
+*
+****************************************************************************/
+u64 XCsi_GetVcStartSkew(XCsi *InstancePtr, u32 VcMask)
+{
+	XCsi_VcStats *StatsPtr;
+	u64 Min = 0;
+	u64 Max = 0;
+	u32 Found = 0;
+	u32 Vc;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	for (Vc = 0; Vc < XCSI_TIMING_MAX_VC; Vc++) {
+		StatsPtr = &InstancePtr->VcTiming[Vc].Stats;
+		if (((VcMask & (1U << Vc)) == 0) ||
+		    (StatsPtr->FramesStarted == 0)) {
+			continue;
+		}
+		if ((Found == 0) || (StatsPtr->LastStart < Min)) {
+			Min = StatsPtr->LastStart;
+		}
+		if ((Found == 0) || (StatsPtr->LastStart > Max)) {
+			Max = StatsPtr->LastStart;
+		}
+		Found++;
+	}
+
+	return (Found < 2) ? 0 : (Max - Min);
+}
+
+/*****************************************************************************/
+/**
+* This function updates a minimum and a maximum, a minimum of 0 is unset.
+*
+* @param	Value is the new sample.
+* @param	MinPtr is the minimum to update.
+* @param	MaxPtr is the maximum to update.
+*
+* @return	None
+*
+****************************************************************************/
+static void XCsi_TimingMinMax(u64 Value, u64 *MinPtr, u64 *MaxPtr)
+{
+	if ((*MinPtr == 0) || (Value < *MinPtr)) {
+		*MinPtr = Value;
+	}
+	if (Value > *MaxPtr) {
+		*MaxPtr = Value;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function accounts a Frame Start packet. A frame number of 0 means the
+* sensor does not number its frames. Otherwise the numbers count up from 1
+* and restart at 1 after wrapping, so a gap is the number of frames lost.
+*
+* @param	VcPtr is the virtual channel the packet was received on.
+* @param	FrameNum is the frame number of the packet.
+* @param	Now is the time stamp of the packet.
+*
+* @return	None
+*
+****************************************************************************/
+static void XCsi_TimingFrameStart(XCsi_VcTiming *VcPtr, u16 FrameNum,
+					u64 Now)
+{
+	XCsi_VcStats *StatsPtr = &VcPtr->Stats;
+
+	if (VcPtr->InFrame != 0) {
+		/* Frame End of the previous frame was lost */
+		StatsPtr->FramesIncomplete++;
+	}
+
+	if ((FrameNum != 0) && (VcPtr->FrameNum != 0)) {
+		if (FrameNum > VcPtr->FrameNum) {
+			StatsPtr->FramesDropped += FrameNum -
+							VcPtr->FrameNum - 1;
+		} else if (FrameNum < VcPtr->FrameNum) {
+			StatsPtr->FramesDropped += FrameNum - 1;
+		}
+	}
+
+	if (StatsPtr->FramesStarted != 0) {
+		XCsi_TimingMinMax(Now - StatsPtr->LastStart,
+				&StatsPtr->PeriodMin, &StatsPtr->PeriodMax);
+	}
+
+	StatsPtr->FramesStarted++;
+	StatsPtr->LastStart = Now;
+	VcPtr->FrameNum = FrameNum;
+	VcPtr->StartTime = Now;
+	VcPtr->InFrame = 1;
+}
+
+/*****************************************************************************/
+/**
+* This function accounts a Frame End packet.
+*
+* @param	VcPtr is the virtual channel the packet was received on.
+* @param	Now is the time stamp of the packet.
+*
+* @return	None
+*
+****************************************************************************/
+static void XCsi_TimingFrameEnd(XCsi_VcTiming *VcPtr, u64 Now)
+{
+	XCsi_VcStats *StatsPtr = &VcPtr->Stats;
+
+	if (VcPtr->InFrame != 0) {
+		XCsi_TimingMinMax(Now - VcPtr->StartTime,
+				&StatsPtr->DurationMin, &StatsPtr->DurationMax);
+		VcPtr->InFrame = 0;
+	} else {
+		/* Frame Start of this frame was lost */
+		StatsPtr->FramesIncomplete++;
+	}
+
+	StatsPtr->FramesEnded++;
+	StatsPtr->LastEnd = Now;
+	VcPtr->EndTime = Now;
+	VcPtr->EndPending = 1;
+}
+/** @} */
@@ -57,7 +57,14 @@
 *
 * <b> Interrupts </b>
 * This driver will not support handling of interrupts user should write handler
-* to handle the interrupts.
+* to handle the interrupts. The transfer queue is the exception, its
+* XCsuDma_QueueIntrHandler() can be connected to the interrupt system.
+*
+* <b> Transfer queue </b>
+* XCsuDma_Queue keeps a ring of transfers for one channel. The next transfer
+* is started as soon as the done of the current one is seen, either by
+* XCsuDma_QueueIntrHandler() or by XCsuDma_QueuePoll(), so the channel stays
+* busy while software refills the queue.
 *
 * <b> Virtual Memory </b>
 *
@@ -115,6 +122,8 @@
 *       Rama	02/26/19 Fixed IAR issue by changing
 *						 "XCsuDma_WaitForDoneTimeout" to function
 *       arc     03/26/19 Fixed MISRA-C violations.
+* 1.5   adk     10/15/19 Added the transfer queue, XCsuDma_Queue*() APIs in
+*                        xcsudma_queue.c.
 * </pre>
 *
 ******************************************************************************/
@@ -408,6 +417,43 @@ typedef struct {
 				  *  commands */
 }XCsuDma_Configure;
 
+/******************************************************************************/
+/**
+* This typedef contains a transfer of the transfer queue.
+*/
+typedef struct {
+	UINTPTR Addr;		/**< Address of the buffer */
+	u32 Size;		/**< Size in 4 byte words */
+	u8 EnDataLast;		/**< Asserts data_inp_last at the end, source
+				  *  channel only */
+}XCsuDma_QueueEntry;
+
+/******************************************************************************/
+/**
+* Callback of the transfer queue, called when a transfer is done.
+*/
+typedef void (*XCsuDma_QueueHandler)(void *CallBackRef,
+					XCsuDma_QueueEntry *EntryPtr);
+
+/******************************************************************************/
+/**
+* This typedef contains the transfer queue of a channel. Head counts the
+* transfers submitted and Tail the transfers done, the transfer n is stored
+* in Entry[n & (NumEntries - 1)] and the one at Tail is on the channel while
+* Busy is set.
+*/
+typedef struct {
+	XCsuDma *CsuDmaPtr;		/**< CSU_DMA instance */
+	XCsuDma_Channel Channel;	/**< Channel of the queue */
+	XCsuDma_QueueEntry *Entry;	/**< Ring of transfers */
+	u32 NumEntries;			/**< Entries, a power of two */
+	u32 Head;			/**< Transfers submitted */
+	u32 Tail;			/**< Transfers done */
+	u32 Busy;			/**< A transfer is on the channel */
+	XCsuDma_QueueHandler Handler;	/**< Done callback, can be NULL */
+	void *CallBackRef;		/**< Passed to the callback */
+}XCsuDma_Queue;
+
 /*****************************************************************************/
 
 
@@ -458,6 +504,18 @@ u32 XCsuDma_GetIntrMask(XCsuDma *InstancePtr, XCsuDma_Channel Channel);
 
 s32 XCsuDma_SelfTest(XCsuDma *InstancePtr);
 
+/* Transfer queue APIs */
+s32 XCsuDma_QueueInitialize(XCsuDma_Queue *QueuePtr, XCsuDma *InstancePtr,
+		XCsuDma_Channel Channel, XCsuDma_QueueEntry *EntryPtr,
+		u32 NumEntries);
+void XCsuDma_QueueSetHandler(XCsuDma_Queue *QueuePtr,
+		XCsuDma_QueueHandler Handler, void *CallBackRef);
+s32 XCsuDma_QueueSubmit(XCsuDma_Queue *QueuePtr, UINTPTR Addr, u32 Size,
+		u8 EnDataLast);
+u32 XCsuDma_QueuePoll(XCsuDma_Queue *QueuePtr);
+void XCsuDma_QueueWait(XCsuDma_Queue *QueuePtr);
+void XCsuDma_QueueIntrHandler(void *CallBackRef);
+
 /******************************************************************************/
 
 #ifdef __cplusplus
@@ -0,0 +1,394 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xcsudma_queue.c
+* @addtogroup csudma_v1_5
+* @{
+*
+* This file contains the transfer queue of the CSU_DMA driver. Transfers are
+* submitted to a ring and started one after the other on the channel. The
+* done of a transfer is seen by XCsuDma_QueueIntrHandler() or by
+* XCsuDma_QueuePoll(), which start the next transfer before the callback of
+* the finished one runs.
+* Please see xcsudma.h for more details of the driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- ---------------------------------------------------
+* 1.5   adk    10/15/19  First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xcsudma.h"
+
+/************************** Function Prototypes ******************************/
+
+static void XCsuDma_QueueStart(XCsuDma_Queue *QueuePtr);
+static void XCsuDma_QueueDone(XCsuDma_Queue *QueuePtr);
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a transfer queue of a channel.
+*
+* @param	QueuePtr is a pointer to the XCsuDma_Queue instance.
+* @param	InstancePtr is a pointer to the initialized XCsuDma instance.
+* @param	Channel represents the type of channel either it is Source or
+*		Destination.
+*		Source channel      - XCSUDMA_SRC_CHANNEL
+*		Destination Channel - XCSUDMA_DST_CHANNEL
+* @param	EntryPtr is a pointer to an array of NumEntries transfers which
+*		holds the ring.
+* @param	NumEntries is the size of the ring, a power of two.
+*
+* @return
+*		- XST_SUCCESS if the queue is initialized.
+*		- XST_INVALID_PARAM if NumEntries is not a power of two.
+*
+* @note		The channel must be idle. Only the queue should start
+*		transfers on the channel from then on.
+*
+******************************************************************************/
+s32 XCsuDma_QueueInitialize(XCsuDma_Queue *QueuePtr, XCsuDma *InstancePtr,
+		XCsuDma_Channel Channel, XCsuDma_QueueEntry *EntryPtr,
+		u32 NumEntries)
+{
+	s32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(EntryPtr != NULL);
+	Xil_AssertNonvoid((Channel == (XCSUDMA_SRC_CHANNEL)) ||
+					(Channel == (XCSUDMA_DST_CHANNEL)));
+	Xil_AssertNonvoid(InstancePtr->IsReady ==
+				(u32)(XIL_COMPONENT_IS_READY));
+
+	if ((NumEntries == 0U) ||
+			((NumEntries & (NumEntries - 1U)) != 0U)) {
+		Status = (s32)XST_INVALID_PARAM;
+		goto END;
+	}
+
+	QueuePtr->CsuDmaPtr = InstancePtr;
+	QueuePtr->Channel = Channel;
+	QueuePtr->Entry = EntryPtr;
+	QueuePtr->NumEntries = NumEntries;
+	QueuePtr->Head = 0U;
+	QueuePtr->Tail = 0U;
+	QueuePtr->Busy = 0U;
+	QueuePtr->Handler = NULL;
+	QueuePtr->CallBackRef = NULL;
+
+	Status = (s32)XST_SUCCESS;
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function installs the callback which is called for every done
+* transfer of the queue.
+*
+* @param	QueuePtr is a pointer to the XCsuDma_Queue instance.
+* @param	Handler is the callback, NULL removes it.
+* @param	CallBackRef is passed to the callback.
+*
+* @return	None.
+*
+* @note		The callback runs in the context of XCsuDma_QueueIntrHandler()
+*		or XCsuDma_QueuePoll(), after the next transfer is started. It
+*		may submit new transfers.
+*
+******************************************************************************/
+void XCsuDma_QueueSetHandler(XCsuDma_Queue *QueuePtr,
+		XCsuDma_QueueHandler Handler, void *CallBackRef)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(QueuePtr != NULL);
+
+	QueuePtr->Handler = Handler;
+	QueuePtr->CallBackRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds a transfer to the queue. It is started right away when
+* the channel is idle, else when the transfers before it are done.
+*
+* @param	QueuePtr is a pointer to the XCsuDma_Queue instance.
+* @param	Addr is the address of the buffer, 4 byte aligned.
+* @param	Size is the number of 4 byte words to transfer.
+* @param	EnDataLast asserts the data_inp_last signal at the end of the
+*		transfer, it is applicable only to the source channel.
+*
+* @return
+*		- XST_SUCCESS if the transfer is queued.
+*		- XST_INVALID_PARAM if Size is 0.
+*		- XST_DEVICE_BUSY if the queue is full.
+*
+* @note		The cache maintenance of the buffer is done here, as
+*		XCsuDma_Transfer() does, so that the done callback does not pay
+*		for it. When the done interrupt is used it is masked while the
+*		queue is updated.
+*
+******************************************************************************/
+s32 XCsuDma_QueueSubmit(XCsuDma_Queue *QueuePtr, UINTPTR Addr, u32 Size,
+		u8 EnDataLast)
+{
+	XCsuDma_QueueEntry *EntryPtr;
+	u32 IntrMasked;
+	s32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(((Addr) & (u64)(XCSUDMA_ADDR_LSB_MASK)) == (u64)0x00);
+	Xil_AssertNonvoid(Size <= (u32)(XCSUDMA_SIZE_MAX));
+
+	if (Size == 0U) {
+		Status = (s32)XST_INVALID_PARAM;
+		goto END;
+	}
+
+	if ((QueuePtr->Head - QueuePtr->Tail) >= QueuePtr->NumEntries) {
+		Status = (s32)XST_DEVICE_BUSY;
+		goto END;
+	}
+
+#if !defined(PSU_PMU)
+	/* Flushing cache memory */
+	if (QueuePtr->Channel == (XCSUDMA_SRC_CHANNEL)) {
+		Xil_DCacheFlushRange(Addr, Size << (u32)(XCSUDMA_SIZE_SHIFT));
+	}
+	/* Invalidating cache memory */
+	else {
+#if defined(__aarch64__)
+		Xil_DCacheInvalidateRange(Addr, Size <<
+					(u32)(XCSUDMA_SIZE_SHIFT));
+#else
+		Xil_DCacheFlushRange(Addr, Size << (u32)(XCSUDMA_SIZE_SHIFT));
+#endif
+	}
+#endif
+
+	/* Keep the done interrupt out while the ring is updated */
+	IntrMasked = XCsuDma_GetIntrMask(QueuePtr->CsuDmaPtr,
+			QueuePtr->Channel) & (u32)XCSUDMA_IXR_DONE_MASK;
+	if (IntrMasked == 0U) {
+		XCsuDma_DisableIntr(QueuePtr->CsuDmaPtr, QueuePtr->Channel,
+				(u32)XCSUDMA_IXR_DONE_MASK);
+	}
+
+	EntryPtr = &QueuePtr->Entry[QueuePtr->Head &
+					(QueuePtr->NumEntries - 1U)];
+	EntryPtr->Addr = Addr;
+	EntryPtr->Size = Size;
+	EntryPtr->EnDataLast = EnDataLast;
+	QueuePtr->Head++;
+
+	if (QueuePtr->Busy == 0U) {
+		XCsuDma_QueueStart(QueuePtr);
+	}
+
+	if (IntrMasked == 0U) {
+		XCsuDma_EnableIntr(QueuePtr->CsuDmaPtr, QueuePtr->Channel,
+				(u32)XCSUDMA_IXR_DONE_MASK);
+	}
+
+	Status = (s32)XST_SUCCESS;
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks the channel once for the done of the current transfer.
+* When it is done the next transfer is started and the callback of the done
+* one is called.
+*
+* @param	QueuePtr is a pointer to the XCsuDma_Queue instance.
+*
+* @return	Number of transfers submitted and not done.
+*
+* @note		Used when the done interrupt is not enabled.
+*
+******************************************************************************/
+u32 XCsuDma_QueuePoll(XCsuDma_Queue *QueuePtr)
+{
+	u32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+
+	if (QueuePtr->Busy != 0U) {
+		Status = XCsuDma_IntrGetStatus(QueuePtr->CsuDmaPtr,
+						QueuePtr->Channel);
+		if ((Status & (u32)XCSUDMA_IXR_DONE_MASK) != 0U) {
+			XCsuDma_QueueDone(QueuePtr);
+		}
+	}
+
+	return QueuePtr->Head - QueuePtr->Tail;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function polls the channel until all the transfers of the queue are
+* done.
+*
+* @param	QueuePtr is a pointer to the XCsuDma_Queue instance.
+*
+* @return	None.
+*
+* @note		Like XCsuDma_WaitForDone(), this function has no timeout.
+*
+******************************************************************************/
+void XCsuDma_QueueWait(XCsuDma_Queue *QueuePtr)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(QueuePtr != NULL);
+
+	while (XCsuDma_QueuePoll(QueuePtr) != 0U) {
+		;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the interrupt handler of a transfer queue. The application
+* connects it, with the queue as reference, to the interrupt of the CSU_DMA
+* and enables the done interrupt of the channel with XCsuDma_EnableIntr().
+*
+* @param	CallBackRef is a pointer to the XCsuDma_Queue instance.
+*
+* @return	None.
+*
+* @note		The other interrupts of the channel are cleared and ignored.
+*
+******************************************************************************/
+void XCsuDma_QueueIntrHandler(void *CallBackRef)
+{
+	XCsuDma_Queue *QueuePtr = (XCsuDma_Queue *)CallBackRef;
+	u32 Status;
+
+	/* Verify arguments */
+	Xil_AssertVoid(QueuePtr != NULL);
+
+	Status = XCsuDma_IntrGetStatus(QueuePtr->CsuDmaPtr, QueuePtr->Channel);
+	Status &= ~XCsuDma_GetIntrMask(QueuePtr->CsuDmaPtr, QueuePtr->Channel);
+
+	if (((Status & (u32)XCSUDMA_IXR_DONE_MASK) != 0U) &&
+			(QueuePtr->Busy != 0U)) {
+		XCsuDma_QueueDone(QueuePtr);
+		Status &= ~(u32)XCSUDMA_IXR_DONE_MASK;
+	}
+
+	if (Status != 0U) {
+		XCsuDma_IntrClear(QueuePtr->CsuDmaPtr, QueuePtr->Channel,
+					Status);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function starts the transfer at the tail of the queue, if any.
+*
+* @param	QueuePtr is a pointer to the XCsuDma_Queue instance.
+*
+* @return	None.
+*
+* @note		The cache maintenance is done at submit time, so the
+*		transfer is written with XCsuDma_64BitTransfer().
+*
+******************************************************************************/
+static void XCsuDma_QueueStart(XCsuDma_Queue *QueuePtr)
+{
+	XCsuDma_QueueEntry *EntryPtr;
+	u64 Addr;
+
+	if (QueuePtr->Tail == QueuePtr->Head) {
+		QueuePtr->Busy = 0U;
+		goto END;
+	}
+
+	EntryPtr = &QueuePtr->Entry[QueuePtr->Tail &
+					(QueuePtr->NumEntries - 1U)];
+	Addr = (u64)EntryPtr->Addr;
+	QueuePtr->Busy = 1U;
+	XCsuDma_64BitTransfer(QueuePtr->CsuDmaPtr, QueuePtr->Channel,
+			(u32)(Addr & XCSUDMA_ADDR_MASK),
+			(u32)((Addr & ULONG64_HI_MASK) >> XCSUDMA_MSB_ADDR_SHIFT),
+			EntryPtr->Size, EntryPtr->EnDataLast);
+END:
+	return;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function completes the transfer on the channel, starts the next one
+* and calls the callback.
+*
+* @param	QueuePtr is a pointer to the XCsuDma_Queue instance.
+*
+* @return	None.
+*
+* @note		The entry is copied before the next transfer is started, its
+*		slot can be reused by a transfer submitted from the callback.
+*
+******************************************************************************/
+static void XCsuDma_QueueDone(XCsuDma_Queue *QueuePtr)
+{
+	XCsuDma_QueueEntry Entry;
+
+	/* Acknowledge the transfer before the next one can complete */
+	XCsuDma_IntrClear(QueuePtr->CsuDmaPtr, QueuePtr->Channel,
+				(u32)XCSUDMA_IXR_DONE_MASK);
+
+	Entry = QueuePtr->Entry[QueuePtr->Tail & (QueuePtr->NumEntries - 1U)];
+	QueuePtr->Tail++;
+	XCsuDma_QueueStart(QueuePtr);
+
+	if (QueuePtr->Handler != NULL) {
+		QueuePtr->Handler(QueuePtr->CallBackRef, &Entry);
+	}
+}
+/** @} */
@@ -75,6 +75,9 @@
 *			XDCFG_INT_STS_OFFSET) &
 *			XDCFG_IXR_D_P_DONE_MASK) !=
 *			XDCFG_IXR_D_P_DONE_MASK);
+* 3.6   adk 10/15/19 Moved the PCAP mode setup of XDcfg_Transfer to
+*		     XDcfg_SetTransferMode and added the DMA command queue
+*		     and XDcfg_QueueReadback.
 *
 *
 * </pre>
@@ -84,17 +87,39 @@
 /***************************** Include Files *********************************/
 
 #include "xdevcfg.h"
+#include "xil_cache.h"
 
 /************************** Constant Definitions *****************************/
 
+#define XDCFG_NOOP_WORD		0x20000000U	/* Type 1 NOOP */
+#define XDCFG_DMA_DONE_CNT_SHIFT	28U
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 
+static void XDcfg_SetTransferMode(XDcfg *InstancePtr, u32 TransferType);
+static void XDcfg_FeedDmaQueue(XDcfg *InstancePtr);
+static u32 XDcfg_QueueDma(XDcfg *InstancePtr, u32 SourcePtr, u32 DestPtr,
+				u32 SrcWordLength, u32 DestWordLength,
+				u32 Flags);
+
 /************************** Variable Definitions *****************************/
 
+/*
+ * Sent after a frame readback to desynchronize the configuration logic.
+ */
+static const u32 XDcfg_DesyncCmd[6] = {
+	0x30008001U,		/* Type 1 write to CMD */
+	0x0000000DU,		/* DESYNC */
+	XDCFG_NOOP_WORD,
+	XDCFG_NOOP_WORD,
+	XDCFG_NOOP_WORD,
+	XDCFG_NOOP_WORD
+};
+
 /****************************************************************************/
 /**
 *
@@ -152,6 +177,11 @@ int XDcfg_CfgInitialize(XDcfg *InstancePtr,
 	 */
 	InstancePtr->Config.BaseAddr = EffectiveAddress;
 	InstancePtr->IsStarted = 0;
+	InstancePtr->DmaHead = 0;
+	InstancePtr->DmaCount = 0;
+	InstancePtr->DmaInFlight = 0;
+	InstancePtr->DmaPcapDone = 0;
+	InstancePtr->ReadbackBusy = 0;
 
 
 	/* Unlock the Device Configuration Interface */
@@ -787,8 +817,6 @@ u32 XDcfg_Transfer(XDcfg *InstancePtr,
 			u32 TransferType)
 {
 
-	u32 CtrlReg;
-
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
@@ -819,37 +847,7 @@ u32 XDcfg_Transfer(XDcfg *InstancePtr,
 			return XST_INVALID_PARAM;
 		}
 
-		/* Clear internal PCAP loopback */
-		CtrlReg = XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
-					XDCFG_MCTRL_OFFSET);
-		XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
-				XDCFG_MCTRL_OFFSET, (CtrlReg &
-				~(XDCFG_MCTRL_PCAP_LPBK_MASK)));
-
-		if (TransferType == XDCFG_NON_SECURE_PCAP_WRITE) {
-			/*
-			 * Clear QUARTER_PCAP_RATE_EN bit
-			 * so that the PCAP data is transmitted every clock
-			 */
-			CtrlReg = XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
-						XDCFG_CTRL_OFFSET);
-
-			XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
-					XDCFG_CTRL_OFFSET, (CtrlReg &
-					  ~XDCFG_CTRL_PCAP_RATE_EN_MASK));
-
-		}
-		if (TransferType == XDCFG_SECURE_PCAP_WRITE) {
-			/*
-			 * AES engine handles only 8 bit data every clock cycle.
-			 * Hence, Encrypted PCAP data which is 32 bit data can
-			 * only be sent in every 4 clock cycles. Set the control
-			 * register QUARTER_PCAP_RATE_EN bit to achieve this
-			 * operation.
-			 */
-			XDcfg_SetControlRegister(InstancePtr,
-						XDCFG_CTRL_PCAP_RATE_EN_MASK);
-		}
+		XDcfg_SetTransferMode(InstancePtr, TransferType);
 
 		XDcfg_InitiateDma(InstancePtr, (u32)SourcePtr,
 				(u32)DestPtr, SrcWordLength, DestWordLength);
@@ -863,12 +861,7 @@ u32 XDcfg_Transfer(XDcfg *InstancePtr,
 			return XST_INVALID_PARAM;
 		}
 
-		/* Clear internal PCAP loopback */
-		CtrlReg = XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
-					XDCFG_MCTRL_OFFSET);
-		XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
-				XDCFG_MCTRL_OFFSET, (CtrlReg &
-				~(XDCFG_MCTRL_PCAP_LPBK_MASK)));
+		XDcfg_SetTransferMode(InstancePtr, TransferType);
 
 		/*
 		 * For PCAP readback of FPGA configuration register or memory,
@@ -893,47 +886,440 @@ u32 XDcfg_Transfer(XDcfg *InstancePtr,
 			return XST_INVALID_PARAM;
 		}
 
-		if (TransferType == XDCFG_CONCURRENT_NONSEC_READ_WRITE) {
-			/* Enable internal PCAP loopback */
-			CtrlReg = XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
-					XDCFG_MCTRL_OFFSET);
-			XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
-					XDCFG_MCTRL_OFFSET, (CtrlReg |
-					XDCFG_MCTRL_PCAP_LPBK_MASK));
+		XDcfg_SetTransferMode(InstancePtr, TransferType);
+
+		XDcfg_InitiateDma(InstancePtr, (u32)SourcePtr,
+				(u32)DestPtr, SrcWordLength, DestWordLength);
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function sets up the PCAP loopback and data rate for a type of
+* transfer.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	TransferType contains the type of PCAP transfer.
+*
+* @return	None.
+*
+* @note		AES engine handles only 8 bit data every clock cycle. Hence,
+*		encrypted PCAP data which is 32 bit data can only be sent in
+*		every 4 clock cycles, which is done by the control register
+*		QUARTER_PCAP_RATE_EN bit. Only non-secure loopback transfers
+*		use the internal PCAP loopback.
+*
+*****************************************************************************/
+static void XDcfg_SetTransferMode(XDcfg *InstancePtr, u32 TransferType)
+{
+	u32 CtrlReg;
+
+	CtrlReg = XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
+				XDCFG_MCTRL_OFFSET);
+	if (TransferType == XDCFG_CONCURRENT_NONSEC_READ_WRITE) {
+		CtrlReg |= XDCFG_MCTRL_PCAP_LPBK_MASK;
+	} else {
+		CtrlReg &= ~XDCFG_MCTRL_PCAP_LPBK_MASK;
+	}
+	XDcfg_WriteReg(InstancePtr->Config.BaseAddr, XDCFG_MCTRL_OFFSET,
+			CtrlReg);
+
+	if ((TransferType == XDCFG_NON_SECURE_PCAP_WRITE) ||
+		(TransferType == XDCFG_CONCURRENT_NONSEC_READ_WRITE)) {
+		XDcfg_ClearControlRegister(InstancePtr,
+					XDCFG_CTRL_PCAP_RATE_EN_MASK);
+	} else if ((TransferType == XDCFG_SECURE_PCAP_WRITE) ||
+		(TransferType == XDCFG_CONCURRENT_SECURE_READ_WRITE)) {
+		XDcfg_SetControlRegister(InstancePtr,
+					XDCFG_CTRL_PCAP_RATE_EN_MASK);
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function gives queued commands to the DMA while its command queue has
+* room. A command flagged XDCFG_DMA_CMD_SYNC waits until all the commands
+* given before it are done and PCAP has signalled D_P_DONE.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+*
+* @return	None.
+*
+* @note		The caller must keep XDcfg_ServiceDmaQueue from running.
+*
+*****************************************************************************/
+static void XDcfg_FeedDmaQueue(XDcfg *InstancePtr)
+{
+	XDcfg_DmaCmd *CmdPtr;
 
+	while (InstancePtr->DmaCount != 0U) {
+		CmdPtr = &InstancePtr->DmaQueue[InstancePtr->DmaHead];
+
+		if ((CmdPtr->Flags & XDCFG_DMA_CMD_SYNC) != 0U) {
+			if ((InstancePtr->DmaInFlight != 0U) ||
+				(InstancePtr->DmaPcapDone == 0U)) {
+				break;
+			}
 			/*
-			 * Clear QUARTER_PCAP_RATE_EN bit
-			 * so that the PCAP data is transmitted every clock
+			 * Everything given before this command is done,
+			 * including the readback command.
 			 */
-			CtrlReg = XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
-						XDCFG_CTRL_OFFSET);
+			InstancePtr->ReadbackBusy = 0;
+		}
+
+		if ((XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
+				XDCFG_STATUS_OFFSET) &
+				XDCFG_STATUS_DMA_CMD_Q_F_MASK) != 0U) {
+			break;
+		}
+
+		/*
+		 * A stale D_P_DONE must not release the next sync command.
+		 */
+		XDcfg_IntrClear(InstancePtr, XDCFG_IXR_D_P_DONE_MASK);
+		InstancePtr->DmaPcapDone = 0;
+		InstancePtr->DmaInFlight++;
+
+		XDcfg_InitiateDma(InstancePtr, CmdPtr->SrcAddr,
+				CmdPtr->DestAddr, CmdPtr->SrcWordLength,
+				CmdPtr->DestWordLength);
+
+		InstancePtr->DmaHead = (InstancePtr->DmaHead + 1U) %
+					XDCFG_DMA_QUEUE_DEPTH;
+		InstancePtr->DmaCount--;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function appends a command to the DMA queue and feeds the DMA. The
+* DMA done interrupts are masked meanwhile.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	SourcePtr is the source address or XDCFG_DMA_INVALID_ADDRESS.
+* @param	DestPtr is the destination address or
+*		XDCFG_DMA_INVALID_ADDRESS.
+* @param	SrcWordLength is the number of words to be read.
+* @param	DestWordLength is the number of words to be written.
+* @param	Flags is 0 or XDCFG_DMA_CMD_SYNC.
+*
+* @return
+*		- XST_SUCCESS if the command is queued
+*		- XST_DEVICE_BUSY if the queue is full
+*
+* @note		None.
+*
+*****************************************************************************/
+static u32 XDcfg_QueueDma(XDcfg *InstancePtr, u32 SourcePtr, u32 DestPtr,
+				u32 SrcWordLength, u32 DestWordLength,
+				u32 Flags)
+{
+	XDcfg_DmaCmd *CmdPtr;
+	u32 IntrReg;
 
-			XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
-					XDCFG_CTRL_OFFSET, (CtrlReg &
-					  ~XDCFG_CTRL_PCAP_RATE_EN_MASK));
+	IntrReg = XDcfg_IntrGetEnabled(InstancePtr) &
+			(XDCFG_IXR_DMA_DONE_MASK | XDCFG_IXR_D_P_DONE_MASK);
+	XDcfg_IntrDisable(InstancePtr, IntrReg);
+
+	if (InstancePtr->DmaCount == XDCFG_DMA_QUEUE_DEPTH) {
+		XDcfg_IntrEnable(InstancePtr, IntrReg);
+		return XST_DEVICE_BUSY;
+	}
 
+	CmdPtr = &InstancePtr->DmaQueue[(InstancePtr->DmaHead +
+			InstancePtr->DmaCount) % XDCFG_DMA_QUEUE_DEPTH];
+	CmdPtr->SrcAddr = SourcePtr;
+	CmdPtr->DestAddr = DestPtr;
+	CmdPtr->SrcWordLength = SrcWordLength;
+	CmdPtr->DestWordLength = DestWordLength;
+	CmdPtr->Flags = Flags;
+	InstancePtr->DmaCount++;
+
+	XDcfg_FeedDmaQueue(InstancePtr);
+
+	XDcfg_IntrEnable(InstancePtr, IntrReg);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function queues a DMA transfer. The command is given to the DMA right
+* away when its command queue has room, otherwise by XDcfg_InterruptHandler
+* or XDcfg_PollDmaQueue once an earlier command completes, so that several
+* buffers, e.g. the pieces of a partial bitstream, are sent back to back.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	SourcePtr contains a pointer to the source memory where the data
+*		is to be transferred from.
+* @param	SrcWordLength is the number of words (32 bit) to be transferred
+*		for the source transfer.
+* @param	DestPtr contains a pointer to the destination memory
+*		where the data is to be transferred to.
+* @param	DestWordLength is the number of words (32 bit) to be transferred
+*		for the Destination transfer.
+* @param	TransferType contains the type of PCAP transfer being requested,
+*		XDCFG_PCAP_READBACK is not supported, see XDcfg_QueueReadback.
+*
+* @return
+*		- XST_SUCCESS if the transfer is queued
+*		- XST_DEVICE_BUSY if the queue is full or holds transfers of
+*		  another type
+*		- XST_INVALID_PARAM if invalid Source / Destination address
+*			or length is sent
+*		- XST_FAILURE if the fabric is not initialized
+*
+* @note		The cache and address requirements of XDcfg_Transfer apply.
+*		The buffers must not be reused before XDcfg_DmaQueuePending
+*		returns 0.
+*
+*****************************************************************************/
+u32 XDcfg_QueueTransfer(XDcfg *InstancePtr,
+			void *SourcePtr, u32 SrcWordLength,
+			void *DestPtr, u32 DestWordLength,
+			u32 TransferType)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if ((TransferType == XDCFG_SECURE_PCAP_WRITE) ||
+		(TransferType == XDCFG_NON_SECURE_PCAP_WRITE)) {
+		if ((!SourcePtr) || (SrcWordLength == 0)) {
+			return XST_INVALID_PARAM;
 		}
-		if (TransferType == XDCFG_CONCURRENT_SECURE_READ_WRITE) {
-			/* Clear internal PCAP loopback */
-			CtrlReg = XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
-						XDCFG_MCTRL_OFFSET);
-			XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
-					XDCFG_MCTRL_OFFSET, (CtrlReg &
-					~(XDCFG_MCTRL_PCAP_LPBK_MASK)));
+	} else if ((TransferType == XDCFG_CONCURRENT_SECURE_READ_WRITE) ||
+		(TransferType == XDCFG_CONCURRENT_NONSEC_READ_WRITE)) {
+		if ((!SourcePtr) || (SrcWordLength == 0) ||
+			(!DestPtr) || (DestWordLength == 0)) {
+			return XST_INVALID_PARAM;
+		}
+	} else {
+		return XST_INVALID_PARAM;
+	}
 
-			/*
-			 * Set the QUARTER_PCAP_RATE_EN bit
-			 * so that the PCAP data is transmitted every 4 clock
-			 * cycles, this is required for encrypted data.
-			 */
-			XDcfg_SetControlRegister(InstancePtr,
-					XDCFG_CTRL_PCAP_RATE_EN_MASK);
+	if ((XDcfg_ReadReg(InstancePtr->Config.BaseAddr, XDCFG_STATUS_OFFSET)
+			& XDCFG_STATUS_PCFG_INIT_MASK) == 0) {
+		if (TransferType != XDCFG_CONCURRENT_NONSEC_READ_WRITE) {
+			return XST_FAILURE;
 		}
+	}
 
-		XDcfg_InitiateDma(InstancePtr, (u32)SourcePtr,
-				(u32)DestPtr, SrcWordLength, DestWordLength);
+	if (XDcfg_DmaQueuePending(InstancePtr) == 0U) {
+		XDcfg_SetTransferMode(InstancePtr, TransferType);
+		InstancePtr->DmaType = TransferType;
+	} else if (InstancePtr->DmaType != TransferType) {
+		return XST_DEVICE_BUSY;
 	}
 
+	return XDcfg_QueueDma(InstancePtr, (u32)SourcePtr,
+			(DestPtr != NULL) ? (u32)DestPtr :
+				XDCFG_DMA_INVALID_ADDRESS,
+			SrcWordLength, DestWordLength, 0U);
+}
+
+/****************************************************************************/
+/**
+*
+* This function queues the readback of consecutive PL frames. The frame read
+* command, the data transfer and the desynchronization sequence are queued as
+* three DMA commands; the whole range is read by a single DMA into DestPtr.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	FrameAddr is the frame address (FAR) of the first frame.
+* @param	FrameCount is the number of frames to read.
+* @param	DestPtr is the destination buffer, it must hold
+*		(FrameCount + 1) * XDCFG_FRAME_WORDS words. The first frame
+*		read is the pad frame of the configuration logic.
+*
+* @return
+*		- XST_SUCCESS if the readback is queued
+*		- XST_DEVICE_BUSY if the queue is short of three entries, holds
+*		  transfers of another type or a readback command is pending
+*		- XST_INVALID_PARAM if DestPtr or FrameCount is invalid
+*		- XST_FAILURE if the fabric is not initialized
+*
+* @note		DestPtr must be invalidated from the cache once
+*		XDcfg_DmaQueuePending returns 0.
+*
+*****************************************************************************/
+u32 XDcfg_QueueReadback(XDcfg *InstancePtr, u32 FrameAddr,
+				u32 FrameCount, void *DestPtr)
+{
+	u32 WordCount;
+	u32 CmdIndex;
+	u32 *CmdBuf;
+	u32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if ((!DestPtr) || (FrameCount == 0U) || (FrameCount >
+			(XDCFG_READBACK_MAX_WORDS / XDCFG_FRAME_WORDS) - 1U)) {
+		return XST_INVALID_PARAM;
+	}
+
+	if ((XDcfg_ReadReg(InstancePtr->Config.BaseAddr, XDCFG_STATUS_OFFSET)
+			& XDCFG_STATUS_PCFG_INIT_MASK) == 0) {
+		return XST_FAILURE;
+	}
+
+	if (XDcfg_DmaQueuePending(InstancePtr) == 0U) {
+		XDcfg_SetTransferMode(InstancePtr, XDCFG_PCAP_READBACK);
+		InstancePtr->DmaType = XDCFG_PCAP_READBACK;
+		InstancePtr->ReadbackBusy = 0;
+	} else if ((InstancePtr->DmaType != XDCFG_PCAP_READBACK) ||
+		(InstancePtr->ReadbackBusy != 0U) ||
+		(InstancePtr->DmaCount > (XDCFG_DMA_QUEUE_DEPTH - 3U))) {
+		return XST_DEVICE_BUSY;
+	}
+
+	WordCount = (FrameCount + 1U) * XDCFG_FRAME_WORDS;
+
+	CmdBuf = InstancePtr->ReadbackCmd;
+	CmdIndex = 0;
+	CmdBuf[CmdIndex++] = 0xFFFFFFFFU;	/* Dummy Word */
+	CmdBuf[CmdIndex++] = 0x000000BBU;	/* Bus Width Sync Word */
+	CmdBuf[CmdIndex++] = 0x11220044U;	/* Bus Width Detect */
+	CmdBuf[CmdIndex++] = 0xFFFFFFFFU;	/* Dummy Word */
+	CmdBuf[CmdIndex++] = 0xAA995566U;	/* Sync Word */
+	CmdBuf[CmdIndex++] = XDCFG_NOOP_WORD;
+	CmdBuf[CmdIndex++] = 0x30008001U;	/* Type 1 write to CMD */
+	CmdBuf[CmdIndex++] = 0x00000007U;	/* RCRC */
+	CmdBuf[CmdIndex++] = XDCFG_NOOP_WORD;
+	CmdBuf[CmdIndex++] = XDCFG_NOOP_WORD;
+	CmdBuf[CmdIndex++] = 0x30008001U;	/* Type 1 write to CMD */
+	CmdBuf[CmdIndex++] = 0x00000004U;	/* RCFG */
+	CmdBuf[CmdIndex++] = XDCFG_NOOP_WORD;
+	CmdBuf[CmdIndex++] = 0x30002001U;	/* Type 1 write to FAR */
+	CmdBuf[CmdIndex++] = FrameAddr;
+	CmdBuf[CmdIndex++] = 0x28006000U;	/* Type 1 read from FDRO */
+	CmdBuf[CmdIndex++] = 0x48000000U | WordCount; /* Type 2 count */
+	while (CmdIndex < XDCFG_READBACK_CMD_WORDS) {
+		CmdBuf[CmdIndex++] = XDCFG_NOOP_WORD;
+	}
+	Xil_DCacheFlushRange((INTPTR)CmdBuf, sizeof(InstancePtr->ReadbackCmd));
+
+	/*
+	 * The queue has room for the three commands and nothing else adds to
+	 * it meanwhile, so only the first one can fail.
+	 */
+	Status = XDcfg_QueueDma(InstancePtr, (u32)CmdBuf,
+			XDCFG_DMA_INVALID_ADDRESS, CmdIndex, 0U, 0U);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+	InstancePtr->ReadbackBusy = 1;
+
+	(void)XDcfg_QueueDma(InstancePtr, XDCFG_DMA_INVALID_ADDRESS,
+			(u32)DestPtr, 0U, WordCount, XDCFG_DMA_CMD_SYNC);
+	(void)XDcfg_QueueDma(InstancePtr, (u32)XDcfg_DesyncCmd,
+			XDCFG_DMA_INVALID_ADDRESS,
+			sizeof(XDcfg_DesyncCmd) / sizeof(u32), 0U,
+			XDCFG_DMA_CMD_SYNC);
+
 	return XST_SUCCESS;
 }
+
+/****************************************************************************/
+/**
+*
+* This function accounts for the completed DMA commands and gives the next
+* queued commands to the DMA. It is called by XDcfg_InterruptHandler.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	IntrStatus is the interrupt status read and cleared by the
+*		caller.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void XDcfg_ServiceDmaQueue(XDcfg *InstancePtr, u32 IntrStatus)
+{
+	u32 StatusReg;
+	u32 DoneCount;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if ((IntrStatus & XDCFG_IXR_D_P_DONE_MASK) != 0U) {
+		InstancePtr->DmaPcapDone = 1;
+	}
+
+	/*
+	 * Completed commands are counted by the DMA_DONE_CNT field, which
+	 * is cleared by writing ones to it.
+	 */
+	StatusReg = XDcfg_ReadReg(InstancePtr->Config.BaseAddr,
+				XDCFG_STATUS_OFFSET);
+	DoneCount = (StatusReg & XDCFG_STATUS_DMA_DONE_CNT_MASK) >>
+			XDCFG_DMA_DONE_CNT_SHIFT;
+	if (DoneCount != 0U) {
+		XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
+				XDCFG_STATUS_OFFSET,
+				XDCFG_STATUS_DMA_DONE_CNT_MASK);
+		if (DoneCount > InstancePtr->DmaInFlight) {
+			DoneCount = InstancePtr->DmaInFlight;
+		}
+		InstancePtr->DmaInFlight -= DoneCount;
+	}
+
+	XDcfg_FeedDmaQueue(InstancePtr);
+}
+
+/****************************************************************************/
+/**
+*
+* This function services the DMA queue in polled mode. It is to be called
+* until XDcfg_DmaQueuePending returns 0.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+*
+* @return	Number of commands queued or given to the DMA.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XDcfg_PollDmaQueue(XDcfg *InstancePtr)
+{
+	u32 IntrStatus;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	IntrStatus = XDcfg_IntrGetStatus(InstancePtr) &
+			(XDCFG_IXR_DMA_DONE_MASK | XDCFG_IXR_D_P_DONE_MASK);
+	if (IntrStatus != 0U) {
+		XDcfg_IntrClear(InstancePtr, IntrStatus);
+	}
+	XDcfg_ServiceDmaQueue(InstancePtr, IntrStatus);
+
+	return XDcfg_DmaQueuePending(InstancePtr);
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the number of DMA commands queued or given to the DMA
+* and not completed yet.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+*
+* @return	Number of pending commands.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XDcfg_DmaQueuePending(XDcfg *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return InstancePtr->DmaCount + InstancePtr->DmaInFlight;
+}
 /** @} */
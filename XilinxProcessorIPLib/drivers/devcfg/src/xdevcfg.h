@@ -54,6 +54,18 @@
 * This driver also does not support the reading of the internal registers of the
 * PCAP. The driver has no knowledge of the PCAP internals.
 *
+* <b> DMA command queue </b>
+*
+* XDcfg_QueueTransfer() and XDcfg_QueueReadback() append DMA commands to a
+* software queue of XDCFG_DMA_QUEUE_DEPTH entries. The two entry hardware
+* command queue is refilled from the DMA done interrupt by
+* XDcfg_InterruptHandler(), or by XDcfg_PollDmaQueue() in polled mode, so a
+* partial bitstream split into several buffers streams without gaps.
+* XDcfg_QueueReadback() reads a range of PL frames into memory, e.g. for SEU
+* scrubbing, with a single DMA. The XDCFG_IXR_DMA_DONE_MASK and
+* XDCFG_IXR_D_P_DONE_MASK interrupts must be enabled when the queue is used
+* in interrupt mode.
+*
 * <b> Initialization and Configuration </b>
 *
 * The device driver enables higher layer software (e.g., an application) to
@@ -153,6 +165,9 @@
 * 3.5   ms  04/18/17 Modified tcl file to add suffix U for all macros
 *                    definitions of devcfg in xparameters.h
 *       ms  08/07/17 Fixed compilation warnings in xdevcfg_sinit.c
+* 3.6   adk 10/15/19 Added a software DMA command queue, fed from the DMA
+*		     done interrupt, and the XDcfg_QueueReadback frame
+*		     readback API.
 * </pre>
 *
 ******************************************************************************/
@@ -179,6 +194,19 @@ extern "C" {
 #define XDCFG_CONCURRENT_SECURE_READ_WRITE	4
 #define XDCFG_CONCURRENT_NONSEC_READ_WRITE	5
 
+/* DMA command queue */
+
+#define XDCFG_DMA_QUEUE_DEPTH		16U	/**< Commands queued in
+						  *  software */
+#define XDCFG_DMA_CMD_SYNC		0x1U	/**< Issue the command only
+						  *  once the previous ones
+						  *  went through PCAP */
+
+/* PL frame readback */
+
+#define XDCFG_FRAME_WORDS		101U	/**< Words in a PL frame */
+#define XDCFG_READBACK_CMD_WORDS	24U	/**< Readback command words */
+#define XDCFG_READBACK_MAX_WORDS	0x07FFFFFFU /**< Type 2 packet limit */
 
 /**************************** Type Definitions *******************************/
 /**
@@ -202,6 +230,17 @@ typedef struct {
 	u32 BaseAddr;		/**< Base address of the device */
 } XDcfg_Config;
 
+/**
+ * A DMA command held in the software queue.
+ */
+typedef struct {
+	u32 SrcAddr;		/**< Source address */
+	u32 DestAddr;		/**< Destination address */
+	u32 SrcWordLength;	/**< Source length in words */
+	u32 DestWordLength;	/**< Destination length in words */
+	u32 Flags;		/**< XDCFG_DMA_CMD_* */
+} XDcfg_DmaCmd;
+
 /**
  * The XDcfg driver instance data.
  */
@@ -213,6 +252,16 @@ typedef struct {
 				  */
 	XDcfg_IntrHandler StatusHandler;  /* Event handler function */
 	void *CallBackRef;	/* Callback reference for event handler */
+	XDcfg_DmaCmd DmaQueue[XDCFG_DMA_QUEUE_DEPTH]; /**< Commands not yet
+						       *  given to the DMA */
+	u32 DmaHead;		/**< Oldest queued command */
+	u32 DmaCount;		/**< Queued commands */
+	u32 DmaInFlight;	/**< Commands given to the DMA */
+	u32 DmaPcapDone;	/**< D_P_DONE seen since the last command */
+	u32 DmaType;		/**< Transfer type of the queued commands */
+	u32 ReadbackBusy;	/**< ReadbackCmd is in use */
+	u32 ReadbackCmd[XDCFG_READBACK_CMD_WORDS]; /**< Frame readback
+						    *  command */
 } XDcfg;
 
 /****************************************************************************/
@@ -371,6 +420,20 @@ u32 XDcfg_Transfer(XDcfg *InstancePtr,
 				void *DestPtr, u32 DestWordLength,
 				u32 TransferType);
 
+u32 XDcfg_QueueTransfer(XDcfg *InstancePtr,
+				void *SourcePtr, u32 SrcWordLength,
+				void *DestPtr, u32 DestWordLength,
+				u32 TransferType);
+
+u32 XDcfg_QueueReadback(XDcfg *InstancePtr, u32 FrameAddr,
+				u32 FrameCount, void *DestPtr);
+
+void XDcfg_ServiceDmaQueue(XDcfg *InstancePtr, u32 IntrStatus);
+
+u32 XDcfg_PollDmaQueue(XDcfg *InstancePtr);
+
+u32 XDcfg_DmaQueuePending(XDcfg *InstancePtr);
+
 /*
  * Interrupt related function prototypes implemented in xdevcfg_intr.c
  */
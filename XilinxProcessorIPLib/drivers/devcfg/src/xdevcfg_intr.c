@@ -42,6 +42,7 @@
 * 2.01a nm  07/07/12 Updated the XDcfg_IntrClear function to directly
 *		     set the mask instead of oring it with the
 *		     value read from the interrupt status register
+* 3.6   adk 10/15/19 Feed the DMA command queue from the interrupt handler
 * </pre>
 *
 ******************************************************************************/
@@ -262,6 +263,14 @@ void XDcfg_InterruptHandler(XDcfg *InstancePtr)
 	XDcfg_WriteReg(InstancePtr->Config.BaseAddr,
 				XDCFG_INT_STS_OFFSET, IntrStatusReg);
 
+	/*
+	 * Give the queued DMA commands to the DMA as earlier ones complete.
+	 */
+	if ((IntrStatusReg & (XDCFG_IXR_DMA_DONE_MASK |
+			XDCFG_IXR_D_P_DONE_MASK)) != 0U) {
+		XDcfg_ServiceDmaQueue(InstancePtr, IntrStatusReg);
+	}
+
 	/*
 	 * Signal application that there are events to handle.
 	 */
@@ -54,6 +54,9 @@
  * 6.0   jb   02/19/19 Added HDCP22 functions.
  *            02/21/19 Added returning AUX defers for HDCP22 DPCD offsets
  * 6.0	 jb   08/22/19 Removed returning AUX defers for HDCP22 DPCD offsets
+ * 7.2   adk  10/15/19 Reuse the results of the last training of a sink.
+ *                     Added link training and AUX statistics.
+ *                     Poll the AUX status without sleeping once it is ready.
  * </pre>
  *
 *******************************************************************************/
@@ -143,6 +146,11 @@ static u32 XDp_TxAdjVswingPreemp(XDp *InstancePtr);
 static u32 XDp_TxSetTrainingPattern(XDp *InstancePtr, u32 Pattern);
 static u32 XDp_TxGetTrainingDelay(XDp *InstancePtr,
 					XDp_TxTrainingState TrainingState);
+static XDp_TxTrainCacheEntry *XDp_TxTrainCacheFind(XDp *InstancePtr);
+static void XDp_TxTrainCacheSeed(XDp *InstancePtr);
+static void XDp_TxTrainCacheStore(XDp *InstancePtr, u8 ReqLinkRate,
+							u8 ReqLaneCount);
+static u64 XDp_TxTimeStamp(XDp *InstancePtr);
 /* AUX transaction functions. */
 static u32 XDp_TxAuxCommon(XDp *InstancePtr, u32 CmdType, u32 Address,
 							u32 NumBytes, u8 *Data);
@@ -485,7 +493,11 @@ u32 XDp_TxEstablishLink(XDp *InstancePtr)
 	u32 Status;
 	u32 Status2;
 	u32 ReenableMainLink;
+	u8 ReqLinkRate;
+	u8 ReqLaneCount;
+	u64 StartTime;
 	XDp_TxLinkConfig *LinkConfig = &InstancePtr->TxInstance.LinkConfig;
+	XDp_TxTrainStats *Stats = &InstancePtr->TxInstance.TrainStats;
 
 	/* Verify arguments. */
 	Xil_AssertNonvoid(InstancePtr != NULL);
@@ -496,6 +508,18 @@ u32 XDp_TxEstablishLink(XDp *InstancePtr)
 	Xil_AssertNonvoid(XDp_IsLaneCountValid(InstancePtr,
 				LinkConfig->LaneCount));
 
+	StartTime = XDp_TxTimeStamp(InstancePtr);
+	Stats->Trainings++;
+	Stats->CrIterations = 0;
+	Stats->EqIterations = 0;
+	Stats->CrTime = 0;
+	Stats->EqTime = 0;
+
+	/* Start from the results of the last training of this sink. */
+	ReqLinkRate = LinkConfig->LinkRate;
+	ReqLaneCount = LinkConfig->LaneCount;
+	XDp_TxTrainCacheSeed(InstancePtr);
+
 	XDp_TxResetPhy(InstancePtr, XDP_TX_PHY_CONFIG_PHY_RESET_MASK);
 
 	/* Disable main link during training. */
@@ -510,19 +534,27 @@ u32 XDp_TxEstablishLink(XDp *InstancePtr)
 			XDP_TX_PHY_STATUS_LANES_READY_MASK(
 			InstancePtr->Config.MaxLaneCount));
 	if (Status != XST_SUCCESS) {
+		Stats->Failures++;
 		return XST_FAILURE;
 	}
 
 	/* Train main link. */
 	Status = XDp_TxRunTraining(InstancePtr);
+	InstancePtr->TxInstance.TrainSeeded = 0;
 
 	/* Turn off the training pattern and enable scrambler. */
 	Status2 = XDp_TxSetTrainingPattern(InstancePtr,
 					XDP_TX_TRAINING_PATTERN_SET_OFF);
+	Stats->TotalTime = XDp_TxTimeStamp(InstancePtr) - StartTime;
 	if ((Status != XST_SUCCESS) || (Status2 != XST_SUCCESS)) {
+		/* Retrain from scratch next time. */
+		XDp_TxTrainCacheStore(InstancePtr, 0, 0);
+		Stats->Failures++;
 		return XST_FAILURE;
 	}
 
+	XDp_TxTrainCacheStore(InstancePtr, ReqLinkRate, ReqLaneCount);
+
 	/* Re-enable main link after training if required. */
 	if (ReenableMainLink) {
 		XDp_TxEnableMainLink(InstancePtr);
@@ -720,6 +752,139 @@ void XDp_TxCfgTxPeLevel(XDp *InstancePtr, u8 Level, u8 TxLevel)
 	InstancePtr->TxInstance.BoardChar.TxPeLevels[Level] = TxLevel;
 }
 
+/******************************************************************************/
+/**
+ * This function identifies the connected sink for the link training cache.
+ * Subsequent link trainings start from the link rate, lane count, voltage
+ * swing and pre-emphasis levels of the last successful training of the same
+ * sink, and store their own results for it.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ * @param	Edid is a pointer to the base EDID block of the sink, or NULL
+ *		if the sink is unknown, which disables the cache.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XDp_TxTrainCacheSetSink(XDp *InstancePtr, u8 *Edid)
+{
+	u32 Hash = 2166136261U;
+	u8 Index;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(XDp_GetCoreType(InstancePtr) == XDP_TX);
+
+	if (Edid == NULL) {
+		InstancePtr->TxInstance.SinkId = 0;
+		return;
+	}
+
+	/* FNV-1a hash of the base block. */
+	for (Index = 0; Index < XDP_EDID_BLOCK_SIZE; Index++) {
+		Hash = (Hash ^ Edid[Index]) * 16777619U;
+	}
+	if (Hash == 0) {
+		Hash = 1;
+	}
+
+	InstancePtr->TxInstance.SinkId = Hash;
+}
+
+/******************************************************************************/
+/**
+ * This function discards all the cached link training results.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XDp_TxTrainCacheClear(XDp *InstancePtr)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(XDp_GetCoreType(InstancePtr) == XDP_TX);
+
+	memset(InstancePtr->TxInstance.TrainCache, 0,
+			sizeof(InstancePtr->TxInstance.TrainCache));
+	InstancePtr->TxInstance.TrainCacheNext = 0;
+}
+
+/******************************************************************************/
+/**
+ * This function installs the time stamp source used to measure the link
+ * training phases.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ * @param	CallbackFunc is the function returning a free running time
+ *		stamp, or NULL to stop measuring.
+ * @param	CallbackRef is the user data passed to the callback.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XDp_TxSetTimeStampHandler(XDp *InstancePtr,
+			XDp_TimeStampHandler CallbackFunc, void *CallbackRef)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(XDp_GetCoreType(InstancePtr) == XDP_TX);
+
+	InstancePtr->TxInstance.TimeStampHandler = CallbackFunc;
+	InstancePtr->TxInstance.TimeStampRef = CallbackRef;
+}
+
+/******************************************************************************/
+/**
+ * This function retrieves the link training and AUX channel statistics.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ * @param	StatsPtr is a pointer to the structure the statistics are
+ *		copied to.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XDp_TxGetTrainStats(XDp *InstancePtr, XDp_TxTrainStats *StatsPtr)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(XDp_GetCoreType(InstancePtr) == XDP_TX);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = InstancePtr->TxInstance.TrainStats;
+}
+
+/******************************************************************************/
+/**
+ * This function clears the link training and AUX channel statistics.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XDp_TxClearTrainStats(XDp *InstancePtr)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(XDp_GetCoreType(InstancePtr) == XDP_TX);
+
+	memset(&InstancePtr->TxInstance.TrainStats, 0,
+				sizeof(XDp_TxTrainStats));
+}
+
 /******************************************************************************/
 /**
  * This function checks if there is a connected RX device.
@@ -2326,17 +2491,25 @@ static u32 XDp_RxInitialize(XDp *InstancePtr)
 static u32 XDp_TxRunTraining(XDp *InstancePtr)
 {
 	u32 Status;
+	u64 StartTime;
 	XDp_TxTrainingState TrainingState = XDP_TX_TS_CLOCK_RECOVERY;
+	XDp_TxTrainStats *Stats = &InstancePtr->TxInstance.TrainStats;
 
 	while (1) {
 		switch (TrainingState) {
 		case XDP_TX_TS_CLOCK_RECOVERY:
+			StartTime = XDp_TxTimeStamp(InstancePtr);
 			TrainingState = XDp_TxTrainingStateClockRecovery(
 								InstancePtr);
+			Stats->CrTime += XDp_TxTimeStamp(InstancePtr) -
+								StartTime;
 			break;
 		case XDP_TX_TS_CHANNEL_EQUALIZATION:
+			StartTime = XDp_TxTimeStamp(InstancePtr);
 			TrainingState = XDp_TxTrainingStateChannelEqualization(
 								InstancePtr);
+			Stats->EqTime += XDp_TxTimeStamp(InstancePtr) -
+								StartTime;
 			break;
 		case XDP_TX_TS_ADJUST_LINK_RATE:
 			TrainingState = XDp_TxTrainingStateAdjustLinkRate(
@@ -2451,9 +2624,19 @@ static XDp_TxTrainingState XDp_TxTrainingStateClockRecovery(XDp *InstancePtr)
 
 	/* Transmit training pattern 1. */
 	/* Disable the scrambler. */
-	/* Start from minimal voltage swing and pre-emphasis levels. */
-	InstancePtr->TxInstance.LinkConfig.VsLevel = 0;
-	InstancePtr->TxInstance.LinkConfig.PeLevel = 0;
+	/* Start from minimal voltage swing and pre-emphasis levels, or from
+	 * the levels the last training of this sink ended with. The cached
+	 * levels are only tried once. */
+	if (InstancePtr->TxInstance.TrainSeeded) {
+		LinkConfig->VsLevel = InstancePtr->TxInstance.TrainSeedVsLevel;
+		LinkConfig->PeLevel = InstancePtr->TxInstance.TrainSeedPeLevel;
+		PrevVsLevel = LinkConfig->VsLevel;
+		InstancePtr->TxInstance.TrainSeeded = 0;
+	}
+	else {
+		LinkConfig->VsLevel = 0;
+		LinkConfig->PeLevel = 0;
+	}
 	Status = XDp_TxSetTrainingPattern(InstancePtr,
 					XDP_TX_TRAINING_PATTERN_SET_TP1);
 	if (Status != XST_SUCCESS) {
@@ -2461,6 +2644,8 @@ static XDp_TxTrainingState XDp_TxTrainingStateClockRecovery(XDp *InstancePtr)
 	}
 
 	while (1) {
+		InstancePtr->TxInstance.TrainStats.CrIterations++;
+
 		/* Wait delay specified in TRAINING_AUX_RD_INTERVAL. */
 		XDp_WaitUs(InstancePtr, DelayUs);
 
@@ -2603,6 +2788,8 @@ static XDp_TxTrainingState XDp_TxTrainingStateChannelEqualization(
 	}
 
 	while (IterationCount < 5) {
+		InstancePtr->TxInstance.TrainStats.EqIterations++;
+
 		/* Wait delay specified in TRAINING_AUX_RD_INTERVAL. */
 		XDp_WaitUs(InstancePtr, DelayUs);
 
@@ -3335,6 +3522,164 @@ static u32 XDp_TxGetTrainingDelay(XDp *InstancePtr,
 	return Delay;
 }
 
+/******************************************************************************/
+/**
+ * This function looks up the link training cache entry of the connected sink.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ *
+ * @return	A pointer to the entry, or NULL if the sink is unknown or has
+ *		no entry.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static XDp_TxTrainCacheEntry *XDp_TxTrainCacheFind(XDp *InstancePtr)
+{
+	u8 Index;
+	XDp_TxTrainCacheEntry *Entry;
+
+	if (InstancePtr->TxInstance.SinkId == 0) {
+		return NULL;
+	}
+
+	for (Index = 0; Index < XDP_TX_TRAIN_CACHE_SIZE; Index++) {
+		Entry = &InstancePtr->TxInstance.TrainCache[Index];
+		if (Entry->SinkId == InstancePtr->TxInstance.SinkId) {
+			return Entry;
+		}
+	}
+
+	return NULL;
+}
+
+/******************************************************************************/
+/**
+ * This function prepares a link training from the cached results of the
+ * connected sink. If the last training requested the same link rate and lane
+ * count, the link is set to the link rate and lane count it was trained at,
+ * and clock recovery starts from the voltage swing and pre-emphasis levels
+ * training ended with. The regular downshift sequence takes over if the
+ * cached settings do not train.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static void XDp_TxTrainCacheSeed(XDp *InstancePtr)
+{
+	u32 Status;
+	XDp_TxTrainCacheEntry *Entry;
+	XDp_TxLinkConfig *LinkConfig = &InstancePtr->TxInstance.LinkConfig;
+
+	InstancePtr->TxInstance.TrainSeeded = 0;
+
+	Entry = XDp_TxTrainCacheFind(InstancePtr);
+	if ((Entry == NULL) || (Entry->ReqLinkRate != LinkConfig->LinkRate) ||
+			(Entry->ReqLaneCount != LinkConfig->LaneCount)) {
+		return;
+	}
+
+	if ((Entry->LinkRate != LinkConfig->LinkRate) &&
+			(InstancePtr->TxInstance.TrainAdaptive != 0)) {
+		Status = XDp_TxSetLinkRate(InstancePtr, Entry->LinkRate);
+		if (Status != XST_SUCCESS) {
+			return;
+		}
+	}
+	if ((Entry->LaneCount != LinkConfig->LaneCount) &&
+			(InstancePtr->TxInstance.TrainAdaptive != 0)) {
+		Status = XDp_TxSetLaneCount(InstancePtr, Entry->LaneCount);
+		if (Status != XST_SUCCESS) {
+			return;
+		}
+	}
+
+	/* Clock recovery gives up when it reaches the maximum voltage swing,
+	 * so only start below it. */
+	if (Entry->VsLevel < XDP_TX_MAXIMUM_VS_LEVEL) {
+		InstancePtr->TxInstance.TrainSeedVsLevel = Entry->VsLevel;
+		InstancePtr->TxInstance.TrainSeedPeLevel = Entry->PeLevel;
+		InstancePtr->TxInstance.TrainSeeded = 1;
+	}
+
+	InstancePtr->TxInstance.TrainStats.CacheHits++;
+}
+
+/******************************************************************************/
+/**
+ * This function stores the result of a link training of the connected sink
+ * in the link training cache.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ * @param	ReqLinkRate is the link rate training was started with.
+ * @param	ReqLaneCount is the lane count training was started with, 0 to
+ *		drop the entry of the sink after a failed training.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static void XDp_TxTrainCacheStore(XDp *InstancePtr, u8 ReqLinkRate,
+							u8 ReqLaneCount)
+{
+	XDp_TxTrainCacheEntry *Entry;
+	XDp_TxLinkConfig *LinkConfig = &InstancePtr->TxInstance.LinkConfig;
+
+	if (InstancePtr->TxInstance.SinkId == 0) {
+		return;
+	}
+
+	Entry = XDp_TxTrainCacheFind(InstancePtr);
+	if (ReqLaneCount == 0) {
+		if (Entry != NULL) {
+			Entry->SinkId = 0;
+		}
+		return;
+	}
+
+	if (Entry == NULL) {
+		Entry = &InstancePtr->TxInstance.TrainCache[
+				InstancePtr->TxInstance.TrainCacheNext];
+		InstancePtr->TxInstance.TrainCacheNext =
+			(InstancePtr->TxInstance.TrainCacheNext + 1) %
+						XDP_TX_TRAIN_CACHE_SIZE;
+	}
+
+	Entry->SinkId = InstancePtr->TxInstance.SinkId;
+	Entry->ReqLinkRate = ReqLinkRate;
+	Entry->ReqLaneCount = ReqLaneCount;
+	Entry->LinkRate = LinkConfig->LinkRate;
+	Entry->LaneCount = LinkConfig->LaneCount;
+	Entry->VsLevel = LinkConfig->VsLevel;
+	Entry->PeLevel = LinkConfig->PeLevel;
+}
+
+/******************************************************************************/
+/**
+ * This function reads the time stamp source of the training statistics.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ *
+ * @return	The time stamp, or 0 if no time stamp handler is installed.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static u64 XDp_TxTimeStamp(XDp *InstancePtr)
+{
+	if (InstancePtr->TxInstance.TimeStampHandler == NULL) {
+		return 0;
+	}
+
+	return InstancePtr->TxInstance.TimeStampHandler(
+				InstancePtr->TxInstance.TimeStampRef);
+}
+
 /******************************************************************************/
 /**
  * This function contains the common sequence of submitting an AUX command for
@@ -3369,6 +3714,11 @@ static u32 XDp_TxAuxCommon(XDp *InstancePtr, u32 CmdType, u32 Address,
 	XDp_AuxTransaction Request;
 	u32 BytesLeft;
 
+	/* The AUX channel is owned by the request queue until it drains. */
+	if (InstancePtr->TxInstance.AuxQueueCount != 0) {
+		return XST_DEVICE_BUSY;
+	}
+
 	/* Set the start address for AUX transactions. For I2C transactions,
 	 * this is the address of the I2C bus. */
 	Request.Address = Address;
@@ -3456,13 +3806,16 @@ static u32 XDp_TxAuxRequest(XDp *InstancePtr, XDp_AuxTransaction *Request)
 		}
 
 		/* Send the request. */
+		InstancePtr->TxInstance.TrainStats.AuxRequests++;
 		Status = XDp_TxAuxRequestSend(InstancePtr, Request);
 		if (Status == XST_SEND_ERROR) {
 			/* The request was deferred. */
+			InstancePtr->TxInstance.TrainStats.AuxDefers++;
 			DeferCount++;
 		}
 		else if (Status == XST_ERROR_COUNT_MAX) {
 			/* Waiting for a reply timed out. */
+			InstancePtr->TxInstance.TrainStats.AuxTimeouts++;
 			TimeoutCount++;
 		}
 		else {
@@ -3506,17 +3859,20 @@ static u32 XDp_TxAuxRequestSend(XDp *InstancePtr, XDp_AuxTransaction *Request)
 
 	/* Ensure that any pending AUX transactions have completed. */
 	TimeoutCount = 0;
-	do {
+	while (1) {
 		Status = XDp_ReadReg(InstancePtr->Config.BaseAddr,
 							XDP_TX_REPLY_STATUS);
+		if (!(Status & XDP_TX_REPLY_STATUS_REQUEST_IN_PROGRESS_MASK) &&
+			!(Status & XDP_TX_REPLY_STATUS_REPLY_IN_PROGRESS_MASK)) {
+			break;
+		}
 
-		XDp_WaitUs(InstancePtr, 20);
 		TimeoutCount++;
 		if (TimeoutCount >= XDP_AUX_MAX_TIMEOUT_COUNT) {
 			return XST_ERROR_COUNT_MAX;
 		}
-	} while ((Status & XDP_TX_REPLY_STATUS_REQUEST_IN_PROGRESS_MASK) ||
-			(Status & XDP_TX_REPLY_STATUS_REPLY_IN_PROGRESS_MASK));
+		XDp_WaitUs(InstancePtr, 20);
+	}
 
 	/* Set the address for the request. */
 	XDp_WriteReg(InstancePtr->Config.BaseAddr, XDP_TX_AUX_ADDRESS,
@@ -3567,16 +3923,19 @@ static u32 XDp_TxAuxRequestSend(XDp *InstancePtr, XDp_AuxTransaction *Request)
 
 		/* Wait until all data has been received. */
 		TimeoutCount = 0;
-		do {
+		while (1) {
 			Status = XDp_ReadReg(InstancePtr->Config.BaseAddr,
 						XDP_TX_REPLY_DATA_COUNT);
+			if (Status == Request->NumBytes) {
+				break;
+			}
 
-			XDp_WaitUs(InstancePtr, 100);
 			TimeoutCount++;
 			if (TimeoutCount >= XDP_AUX_MAX_TIMEOUT_COUNT) {
 				return XST_ERROR_COUNT_MAX;
 			}
-		} while (Status != Request->NumBytes);
+			XDp_WaitUs(InstancePtr, 100);
+		}
 
 		/* Obtain the read data from the reply FIFO. */
 		for (Index = 0; Index < Request->NumBytes; Index++) {
@@ -3652,9 +4011,12 @@ static u32 XDp_TxAuxWaitReady(XDp *InstancePtr)
 	u32 Timeout = 100;
 
 	/* Wait until the DisplayPort TX core is ready. */
-	do {
+	while (1) {
 		Status = XDp_ReadReg(InstancePtr->Config.BaseAddr,
 						XDP_TX_INTERRUPT_SIG_STATE);
+		if (!(Status & XDP_TX_REPLY_STATUS_REPLY_IN_PROGRESS_MASK)) {
+			break;
+		}
 
 		/* Protect against an infinite loop. */
 		if (!Timeout--) {
@@ -3662,7 +4024,6 @@ static u32 XDp_TxAuxWaitReady(XDp *InstancePtr)
 		}
 		XDp_WaitUs(InstancePtr, 20);
 	}
-	while (Status & XDP_TX_REPLY_STATUS_REPLY_IN_PROGRESS_MASK);
 
 	return XST_SUCCESS;
 }
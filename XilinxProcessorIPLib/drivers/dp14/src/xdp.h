@@ -114,6 +114,10 @@
  *	  locked for all lanes.
  *	- Channel equalization: All lanes need to achieve channel equalization
  *	  and and symbol lock, as well as for interlane alignment to take place.
+ *   When the sink is identified by XDp_TxTrainCacheSetSink(), the result of
+ *   its last successful training is reused: the link rate and lane count it
+ *   settled on, and the voltage swing and pre-emphasis levels clock recovery
+ *   starts from.
  * - The SPM manages transportation of an isochronous stream. That is, it will
  *   initialize and maintain a video stream, establish a virtual channel to a
  *   sink monitor, and transmit the stream.
@@ -379,6 +383,8 @@
  *                     	Added new HDCP22 functions:
  *                     		XDp_GenerateCpIrq,
  *                     		XDp_EnableDisableHdcp22AuxDeffers
+ * 7.2   adk  10/15/19 Added the link training cache, training statistics and
+ *                     the interrupt driven AUX request queue.
  *
  * </pre>
  *
@@ -396,6 +402,13 @@
 #include "xstatus.h"
 #include "xvidc.h"
 
+/**************************** Constant Definitions ****************************/
+
+#define XDP_TX_TRAIN_CACHE_SIZE	4	/**< Number of sinks the training
+						results are kept for. */
+#define XDP_TX_AUX_QUEUE_DEPTH	8	/**< Number of queued AUX
+						requests. */
+
 /****************************** Type Definitions ******************************/
 
 /**
@@ -661,6 +674,73 @@ typedef struct {
 					pre-emphasis is used. */
 } XDp_TxBoardChar;
 
+/**
+ * This typedef contains the result of a successful link training for a sink.
+ */
+typedef struct {
+	u32 SinkId;		/**< Hash of the sink's base EDID block, 0 if
+					the entry is unused. */
+	u8 ReqLinkRate;		/**< Link rate training was started with. */
+	u8 ReqLaneCount;	/**< Lane count training was started with. */
+	u8 LinkRate;		/**< Link rate the link was trained at. */
+	u8 LaneCount;		/**< Lane count the link was trained at. */
+	u8 VsLevel;		/**< Voltage swing level at the end of
+					training. */
+	u8 PeLevel;		/**< Pre-emphasis level at the end of
+					training. */
+} XDp_TxTrainCacheEntry;
+
+/**
+ * This typedef contains the link training and AUX channel statistics. The
+ * times are only measured when a time stamp handler is set using
+ * XDp_TxSetTimeStampHandler() and are expressed in its units.
+ */
+typedef struct {
+	u32 Trainings;		/**< Number of link trainings. */
+	u32 Failures;		/**< Number of failed link trainings. */
+	u32 CacheHits;		/**< Trainings started from cached results. */
+	u32 CrIterations;	/**< Clock recovery loops of the last
+					training. */
+	u32 EqIterations;	/**< Channel equalization loops of the last
+					training. */
+	u64 CrTime;		/**< Time spent in clock recovery during the
+					last training. */
+	u64 EqTime;		/**< Time spent in channel equalization during
+					the last training. */
+	u64 TotalTime;		/**< Duration of the last training. */
+	u32 AuxRequests;	/**< AUX requests sent. */
+	u32 AuxDefers;		/**< AUX requests deferred by the sink. */
+	u32 AuxTimeouts;	/**< AUX requests which timed out. */
+} XDp_TxTrainStats;
+
+/******************************************************************************/
+/**
+ * Callback type which represents the completion handler of a queued AUX
+ * request.
+ *
+ * @param	CallbackRef is the user data passed to XDp_TxAuxQueueSubmit().
+ * @param	Status is XST_SUCCESS if the request was acknowledged,
+ *		XST_FAILURE if it was NACK'ed or XST_ERROR_COUNT_MAX if it was
+ *		deferred or timed out too many times.
+ *
+ * @note	The handler is called from the interrupt handler.
+ *
+*******************************************************************************/
+typedef void (*XDp_TxAuxDoneHandler)(void *CallbackRef, u32 Status);
+
+/**
+ * This typedef describes a queued AUX request.
+ */
+typedef struct {
+	u32 CmdType;		/**< AUX or I2C-over-AUX command. */
+	u32 Address;		/**< AUX or I2C start address. */
+	u8 *Data;		/**< Buffer read into or written from. */
+	u8 NumBytes;		/**< Number of bytes, up to 16. */
+	u8 Retries;		/**< Defers and timeouts seen so far. */
+	XDp_TxAuxDoneHandler Handler; /**< Completion handler, may be NULL. */
+	void *CallbackRef;	/**< User data passed to the handler. */
+} XDp_TxAuxQueueEntry;
+
 /**
  * This typedef describes a downstream DisplayPort device when the driver is
  * running in multi-stream transport (MST) mode.
@@ -876,6 +956,19 @@ typedef struct {
 *******************************************************************************/
 typedef void (*XDp_TimerHandler)(void *InstancePtr, u32 MicroSeconds);
 
+/******************************************************************************/
+/**
+ * Callback type which returns a free running time stamp, used to measure the
+ * link training phases.
+ *
+ * @param	CallbackRef is the user data passed to
+ *		XDp_TxSetTimeStampHandler().
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+typedef u64 (*XDp_TimeStampHandler)(void *CallbackRef);
+
 /******************************************************************************/
 /**
  * Callback type which represents the handler for interrupts.
@@ -991,6 +1084,32 @@ typedef struct {
 							swing and pre-emphasis
 							adjust request callback
 							function. */
+	u32 SinkId;				/**< Hash of the EDID of the
+							connected sink, 0 if
+							unknown. */
+	XDp_TxTrainCacheEntry TrainCache[XDP_TX_TRAIN_CACHE_SIZE];
+						/**< Results of the last
+							successful trainings. */
+	u8 TrainCacheNext;			/**< Next cache entry to
+							replace. */
+	u8 TrainSeeded;				/**< Clock recovery starts from
+							the cached levels. */
+	u8 TrainSeedVsLevel;			/**< Cached voltage swing
+							level. */
+	u8 TrainSeedPeLevel;			/**< Cached pre-emphasis
+							level. */
+	XDp_TxTrainStats TrainStats;		/**< Link training and AUX
+							statistics. */
+	XDp_TimeStampHandler TimeStampHandler;	/**< Time stamp source of the
+							training statistics. */
+	void *TimeStampRef;			/**< A pointer to the user data
+							passed to the time stamp
+							handler. */
+	XDp_TxAuxQueueEntry AuxQueue[XDP_TX_AUX_QUEUE_DEPTH];
+						/**< Queued AUX requests. */
+	u8 AuxQueueHead;			/**< Request in progress. */
+	volatile u8 AuxQueueCount;		/**< Number of queued
+							requests. */
 } XDp_Tx;
 
 /**
@@ -1353,6 +1472,12 @@ void XDp_TxSetHasRedriverInPath(XDp *InstancePtr, u8 Set);
 void XDp_TxCfgTxVsOffset(XDp *InstancePtr, u8 Offset);
 void XDp_TxCfgTxVsLevel(XDp *InstancePtr, u8 Level, u8 TxLevel);
 void XDp_TxCfgTxPeLevel(XDp *InstancePtr, u8 Level, u8 TxLevel);
+void XDp_TxTrainCacheSetSink(XDp *InstancePtr, u8 *Edid);
+void XDp_TxTrainCacheClear(XDp *InstancePtr);
+void XDp_TxSetTimeStampHandler(XDp *InstancePtr,
+			XDp_TimeStampHandler CallbackFunc, void *CallbackRef);
+void XDp_TxGetTrainStats(XDp *InstancePtr, XDp_TxTrainStats *StatsPtr);
+void XDp_TxClearTrainStats(XDp *InstancePtr);
 
 /* xdp.c: TX AUX transaction functions. */
 u32 XDp_TxAuxRead(XDp *InstancePtr, u32 DpcdAddress, u32 BytesToRead,
@@ -1428,6 +1553,10 @@ void XDp_InterruptHandler(XDp *InstancePtr);
 #if XPAR_XDPTXSS_NUM_INSTANCES
 int XDp_TxSetCallback(XDp *InstancePtr,	XDp_Tx_HandlerType HandlerType,
 			XDp_IntrHandler CallbackFunc, void *CallbackRef);
+u32 XDp_TxAuxQueueSubmit(XDp *InstancePtr, u32 CmdType, u32 Address,
+			u8 NumBytes, u8 *Data, XDp_TxAuxDoneHandler Handler,
+			void *CallbackRef);
+u32 XDp_TxAuxQueuePending(XDp *InstancePtr);
 #endif /* XPAR_XDPTXSS_NUM_INSTANCES */
 
 #if XPAR_XDPRXSS_NUM_INSTANCES
@@ -53,6 +53,7 @@
  * 6.0   tu   09/08/17 Added three interrupt handler that addresses callback
  *                     function of application
  * 6.0   jb   02/19/19 Added HDCP22 interrupts.
+ * 7.2   adk  10/15/19 Added the interrupt driven AUX request queue.
  * </pre>
  *
 *******************************************************************************/
@@ -61,10 +62,24 @@
 
 #include "xdp.h"
 
+/**************************** Constant Definitions ****************************/
+
+#if XPAR_XDPTXSS_NUM_INSTANCES
+/* Give up on a queued AUX request after 50 defers or timeouts. */
+#define XDP_TX_AUX_QUEUE_MAX_RETRIES 50
+
+/* AUX reply interrupts used by the request queue. */
+#define XDP_TX_AUX_QUEUE_INTR_MASK \
+	(XDP_TX_INTERRUPT_MASK_REPLY_RECEIVED_MASK | \
+	XDP_TX_INTERRUPT_MASK_REPLY_TIMEOUT_MASK)
+#endif /* XPAR_XDPTXSS_NUM_INSTANCES */
+
 /**************************** Function Prototypes *****************************/
 
 #if XPAR_XDPTXSS_NUM_INSTANCES
 static void XDp_TxInterruptHandler(XDp *InstancePtr);
+static void XDp_TxAuxQueueStart(XDp *InstancePtr);
+static void XDp_TxAuxQueueService(XDp *InstancePtr, u32 IntrStatus);
 #endif
 #if XPAR_XDPRXSS_NUM_INSTANCES
 static void XDp_RxInterruptHandler(XDp *InstancePtr);
@@ -723,6 +738,12 @@ static void XDp_TxInterruptHandler(XDp *InstancePtr)
 	HpdPulseDetected = IntrStatus &
 				XDP_TX_INTERRUPT_STATUS_HPD_PULSE_DETECTED_MASK;
 
+	/* Complete the AUX request in progress and start the next one. */
+	if (IntrStatus & (XDP_TX_INTERRUPT_STATUS_REPLY_RECEIVED_MASK |
+				XDP_TX_INTERRUPT_STATUS_REPLY_TIMEOUT_MASK)) {
+		XDp_TxAuxQueueService(InstancePtr, IntrStatus);
+	}
+
 	if (HpdEventDetected) {
 		if (InstancePtr->TxInstance.DrvHpdEventHandler)
 			InstancePtr->TxInstance.DrvHpdEventHandler(
@@ -747,6 +768,250 @@ static void XDp_TxInterruptHandler(XDp *InstancePtr)
 		}
 	}
 }
+
+/******************************************************************************/
+/**
+ * This function queues an AUX or I2C-over-AUX request. The requests are sent
+ * one after the other from the interrupt handler, which calls the completion
+ * handler of each request once its reply is received. This lets the caller
+ * go on while the sink replies instead of polling the AUX channel.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ * @param	CmdType is the AUX command (one of: XDP_TX_AUX_CMD_READ,
+ *		XDP_TX_AUX_CMD_WRITE, XDP_TX_AUX_CMD_I2C_READ,
+ *		XDP_TX_AUX_CMD_I2C_READ_MOT, XDP_TX_AUX_CMD_I2C_WRITE or
+ *		XDP_TX_AUX_CMD_I2C_WRITE_MOT).
+ * @param	Address is the DPCD address, or the I2C address for
+ *		I2C-over-AUX commands.
+ * @param	NumBytes is the number of bytes to transfer, from 1 to 16.
+ * @param	Data is a pointer to the buffer read into or written from. It
+ *		must remain valid until the completion handler is called.
+ * @param	Handler is the completion handler, may be NULL.
+ * @param	CallbackRef is the user data passed to the handler.
+ *
+ * @return
+ *		- XST_SUCCESS if the request was queued.
+ *		- XST_DEVICE_BUSY if the queue is full.
+ *
+ * @note	The DisplayPort interrupt must be connected. The blocking AUX
+ *		functions, and thus link training, return XST_DEVICE_BUSY
+ *		while requests are queued.
+ *
+*******************************************************************************/
+u32 XDp_TxAuxQueueSubmit(XDp *InstancePtr, u32 CmdType, u32 Address,
+			u8 NumBytes, u8 *Data, XDp_TxAuxDoneHandler Handler,
+			void *CallbackRef)
+{
+	u32 IntrMask;
+	u8 Tail;
+	XDp_TxAuxQueueEntry *Entry;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(XDp_GetCoreType(InstancePtr) == XDP_TX);
+	Xil_AssertNonvoid((NumBytes > 0) && (NumBytes <= 16));
+	Xil_AssertNonvoid(Data != NULL);
+
+	/* Keep the interrupt handler off the queue while it is updated. */
+	IntrMask = XDp_ReadReg(InstancePtr->Config.BaseAddr,
+						XDP_TX_INTERRUPT_MASK);
+	XDp_WriteReg(InstancePtr->Config.BaseAddr, XDP_TX_INTERRUPT_MASK,
+				IntrMask | XDP_TX_AUX_QUEUE_INTR_MASK);
+
+	if (InstancePtr->TxInstance.AuxQueueCount == XDP_TX_AUX_QUEUE_DEPTH) {
+		XDp_WriteReg(InstancePtr->Config.BaseAddr,
+				XDP_TX_INTERRUPT_MASK, IntrMask);
+		return XST_DEVICE_BUSY;
+	}
+
+	Tail = (InstancePtr->TxInstance.AuxQueueHead +
+			InstancePtr->TxInstance.AuxQueueCount) %
+						XDP_TX_AUX_QUEUE_DEPTH;
+	Entry = &InstancePtr->TxInstance.AuxQueue[Tail];
+	Entry->CmdType = CmdType;
+	Entry->Address = Address;
+	Entry->Data = Data;
+	Entry->NumBytes = NumBytes;
+	Entry->Retries = 0;
+	Entry->Handler = Handler;
+	Entry->CallbackRef = CallbackRef;
+
+	InstancePtr->TxInstance.AuxQueueCount++;
+	if (InstancePtr->TxInstance.AuxQueueCount == 1) {
+		XDp_TxAuxQueueStart(InstancePtr);
+	}
+
+	/* Enable the AUX reply interrupts. */
+	XDp_WriteReg(InstancePtr->Config.BaseAddr, XDP_TX_INTERRUPT_MASK,
+				IntrMask & ~XDP_TX_AUX_QUEUE_INTR_MASK);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the number of queued AUX requests, including the one
+ * in progress.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ *
+ * @return	The number of requests not completed yet.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+u32 XDp_TxAuxQueuePending(XDp *InstancePtr)
+{
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(XDp_GetCoreType(InstancePtr) == XDP_TX);
+
+	return InstancePtr->TxInstance.AuxQueueCount;
+}
+
+/******************************************************************************/
+/**
+ * This function sends the AUX request at the head of the queue.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static void XDp_TxAuxQueueStart(XDp *InstancePtr)
+{
+	u8 Index;
+	XDp_TxAuxQueueEntry *Entry =
+		&InstancePtr->TxInstance.AuxQueue[
+				InstancePtr->TxInstance.AuxQueueHead];
+
+	XDp_WriteReg(InstancePtr->Config.BaseAddr, XDP_TX_AUX_ADDRESS,
+							Entry->Address);
+
+	if ((Entry->CmdType == XDP_TX_AUX_CMD_WRITE) ||
+			(Entry->CmdType == XDP_TX_AUX_CMD_I2C_WRITE) ||
+			(Entry->CmdType == XDP_TX_AUX_CMD_I2C_WRITE_MOT)) {
+		/* Feed write data into the DisplayPort TX core's write FIFO. */
+		for (Index = 0; Index < Entry->NumBytes; Index++) {
+			XDp_WriteReg(InstancePtr->Config.BaseAddr,
+				XDP_TX_AUX_WRITE_FIFO, Entry->Data[Index]);
+		}
+	}
+
+	/* Submit the command and the data size. */
+	XDp_WriteReg(InstancePtr->Config.BaseAddr, XDP_TX_AUX_CMD,
+				((Entry->CmdType << XDP_TX_AUX_CMD_SHIFT) |
+				((Entry->NumBytes - 1) &
+				XDP_TX_AUX_CMD_NBYTES_TRANSFER_MASK)));
+
+	InstancePtr->TxInstance.TrainStats.AuxRequests++;
+}
+
+/******************************************************************************/
+/**
+ * This function handles the reply to the AUX request at the head of the
+ * queue. Deferred and timed out requests are sent again, up to
+ * XDP_TX_AUX_QUEUE_MAX_RETRIES times. Otherwise the request is completed and
+ * the next one is started.
+ *
+ * @param	InstancePtr is a pointer to the XDp instance.
+ * @param	IntrStatus is the interrupt status read by the interrupt
+ *		handler.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static void XDp_TxAuxQueueService(XDp *InstancePtr, u32 IntrStatus)
+{
+	u32 ReplyCode;
+	u32 Status;
+	u32 IntrMask;
+	u8 Index;
+	XDp_TxAuxQueueEntry *Entry;
+	XDp_TxAuxDoneHandler Handler;
+	void *CallbackRef;
+
+	if (InstancePtr->TxInstance.AuxQueueCount == 0) {
+		return;
+	}
+	Entry = &InstancePtr->TxInstance.AuxQueue[
+				InstancePtr->TxInstance.AuxQueueHead];
+
+	if (IntrStatus & XDP_TX_INTERRUPT_STATUS_REPLY_TIMEOUT_MASK) {
+		InstancePtr->TxInstance.TrainStats.AuxTimeouts++;
+		ReplyCode = XDP_TX_AUX_REPLY_CODE_DEFER;
+	}
+	else {
+		ReplyCode = XDp_ReadReg(InstancePtr->Config.BaseAddr,
+						XDP_TX_AUX_REPLY_CODE);
+		if ((ReplyCode == XDP_TX_AUX_REPLY_CODE_DEFER) ||
+			(ReplyCode == XDP_TX_AUX_REPLY_CODE_I2C_DEFER)) {
+			InstancePtr->TxInstance.TrainStats.AuxDefers++;
+		}
+	}
+
+	if ((ReplyCode == XDP_TX_AUX_REPLY_CODE_DEFER) ||
+			(ReplyCode == XDP_TX_AUX_REPLY_CODE_I2C_DEFER)) {
+		Entry->Retries++;
+		if (Entry->Retries < XDP_TX_AUX_QUEUE_MAX_RETRIES) {
+			XDp_TxAuxQueueStart(InstancePtr);
+			return;
+		}
+		Status = XST_ERROR_COUNT_MAX;
+	}
+	else if ((ReplyCode == XDP_TX_AUX_REPLY_CODE_NACK) ||
+			(ReplyCode == XDP_TX_AUX_REPLY_CODE_I2C_NACK)) {
+		Status = XST_FAILURE;
+	}
+	else if ((Entry->CmdType == XDP_TX_AUX_CMD_READ) ||
+			(Entry->CmdType == XDP_TX_AUX_CMD_I2C_READ) ||
+			(Entry->CmdType == XDP_TX_AUX_CMD_I2C_READ_MOT)) {
+		/* The reply is complete when the interrupt is raised. */
+		if (XDp_ReadReg(InstancePtr->Config.BaseAddr,
+				XDP_TX_REPLY_DATA_COUNT) != Entry->NumBytes) {
+			Status = XST_FAILURE;
+		}
+		else {
+			for (Index = 0; Index < Entry->NumBytes; Index++) {
+				Entry->Data[Index] = XDp_ReadReg(
+					InstancePtr->Config.BaseAddr,
+					XDP_TX_AUX_REPLY_DATA);
+			}
+			Status = XST_SUCCESS;
+		}
+	}
+	else {
+		Status = XST_SUCCESS;
+	}
+
+	Handler = Entry->Handler;
+	CallbackRef = Entry->CallbackRef;
+
+	InstancePtr->TxInstance.AuxQueueHead =
+		(InstancePtr->TxInstance.AuxQueueHead + 1) %
+						XDP_TX_AUX_QUEUE_DEPTH;
+	InstancePtr->TxInstance.AuxQueueCount--;
+	if (InstancePtr->TxInstance.AuxQueueCount != 0) {
+		XDp_TxAuxQueueStart(InstancePtr);
+	}
+	else {
+		/* The queue drained, disable the AUX reply interrupts. */
+		IntrMask = XDp_ReadReg(InstancePtr->Config.BaseAddr,
+						XDP_TX_INTERRUPT_MASK);
+		XDp_WriteReg(InstancePtr->Config.BaseAddr,
+				XDP_TX_INTERRUPT_MASK,
+				IntrMask | XDP_TX_AUX_QUEUE_INTR_MASK);
+	}
+
+	if (Handler != NULL) {
+		Handler(CallbackRef, Status);
+	}
+}
 #endif /* XPAR_XDPTXSS_NUM_INSTANCES */
 
 #if XPAR_XDPRXSS_NUM_INSTANCES
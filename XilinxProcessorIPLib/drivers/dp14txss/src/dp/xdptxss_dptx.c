@@ -45,6 +45,8 @@
 * 4.0  aad 05/13/16 Use asynchronous clock mode by default.
 * 5.0  tu  08/03/17 Enabled video packing for bpc > 10
 * 5.0  aad 09/08/17 Case to handle HTotal > 4095, PPC = 1 in AXIStream Mode.
+* 6.2  adk 10/15/19 Read the SST sink EDID before training so that the link
+*                   training results cached for the sink are reused.
 * </pre>
 *
 ******************************************************************************/
@@ -128,6 +130,9 @@ u32 XDpTxSs_DpTxStart(XDp *InstancePtr, u8 TransportMode, u8 Bpc,
 	if (TransportMode) {
 		xdbg_printf(XDBG_DEBUG_GENERAL,"\n\rSS INFO:Starting "
 			"MST config.\n\r");
+
+		/* The link training cache is keyed by the SST sink EDID. */
+		XDp_TxTrainCacheSetSink(InstancePtr, NULL);
 		/* Enable MST mode in both the RX and TX. */
 		Status = XDp_TxMstEnable(InstancePtr);
 		if (Status != XST_SUCCESS) {
@@ -472,6 +477,16 @@ u32 XDpTxSs_DpTxStart(XDp *InstancePtr, u8 TransportMode, u8 Bpc,
 		/* Disable main stream to force sending of IDLE patterns. */
 		XDp_TxDisableMainLink(InstancePtr);
 
+		xdbg_printf(XDBG_DEBUG_GENERAL,"Reading (SST) Sink EDID..."
+			"\n\r");
+
+		/* Get EDID, it identifies the sink for the link training
+		 * cache.
+		 */
+		Status = XDp_TxGetEdid(InstancePtr, Edid);
+		XDp_TxTrainCacheSetSink(InstancePtr,
+				(Status == XST_SUCCESS) ? Edid : NULL);
+
 		/* Start link training with user set link rate and lane
 		 * count.
 		 */
@@ -490,12 +505,6 @@ u32 XDpTxSs_DpTxStart(XDp *InstancePtr, u8 TransportMode, u8 Bpc,
 			}
 		}
 
-		xdbg_printf(XDBG_DEBUG_GENERAL,"Reading (SST) Sink EDID..."
-			"\n\r");
-
-		/* Get EDID */
-		XDp_TxGetEdid(InstancePtr, Edid);
-
 		if (VidMode == XVIDC_VM_USE_EDID_PREFERRED) {
 			xdbg_printf(XDBG_DEBUG_GENERAL,"SS INFO:SST:Using "
 				"preferred EDID resolution.\n\r");
@@ -41,6 +41,7 @@
  * ---- ----- -------- ----------------------------------------------------
  * 1.0  aad   04/12/16 Initial release.
  * 1.1  aad   04/26/18 Fixed Warnings
+ * 1.2  adk   10/15/19 Clear the flip queues in XDpDma_CfgInitialize.
  * </pre>
  *
  *****************************************************************************/
@@ -354,6 +355,9 @@ void XDpDma_CfgInitialize(XDpDma *InstancePtr, XDpDma_Config *CfgPtr)
 	InstancePtr->Gfx.TriggerStatus = XDPDMA_TRIGGER_DONE;
 	InstancePtr->Gfx.VideoInfo = NULL;
 	InstancePtr->Gfx.FrameBuffer = NULL;
+
+	InstancePtr->VideoFlip = NULL;
+	InstancePtr->GfxFlip = NULL;
 }
 
 /*************************************************************************/
@@ -40,6 +40,8 @@
  * Ver	Who   Date     Changes
  * ---- ----- -------- ----------------------------------------------------
  * 1.0  aad   04/12/16 Initial release.
+ * 1.2  adk   10/15/19 Added pre-linked flip queues for the video and
+ *		       graphics channels and circular audio rings.
  * </pre>
  *
  *****************************************************************************/
@@ -67,6 +69,12 @@ extern "C" {
 #define XDPDMA_DESCRIPTOR_ALIGN 256
 /* DPDMA preamble field */
 #define XDPDMA_DESCRIPTOR_PREAMBLE 0xA5
+/* Frame buffers of a flip queue */
+#define XDPDMA_FLIP_MAX_BUFFERS 3
+/* No buffer in a flip queue state */
+#define XDPDMA_FLIP_NONE 0xFF
+/* Descriptors of an audio ring */
+#define XDPDMA_AUDIO_RING_MAX 8
 /**************************** Type Definitions ********************************/
 
 /**
@@ -207,6 +215,57 @@ typedef struct {
 	XDpDma_AudioBuffer *Buffer;
 	u8 Used;
 } XDpDma_AudioChannel;
+
+/**
+ * This typedef holds the descriptors of one frame buffer of a flip queue,
+ * one per plane.
+ */
+typedef struct {
+	XDpDma_Descriptor Plane0;
+	XDpDma_Descriptor Plane1;
+	XDpDma_Descriptor Plane2;
+} XDpDma_FlipBuffer;
+
+/**
+ * This typedef holds the descriptor of one fragment of an audio ring.
+ */
+typedef struct {
+	XDpDma_Descriptor Desc;
+} XDpDma_AudioFragment;
+
+/**
+ * This typedef defines a flip queue of a Video or Graphics channel. Each
+ * frame buffer gets its own self linked descriptors, built once by
+ * XDpDma_FlipSetBuffer(), so a flip only programs the descriptor start
+ * address on VSync. A buffer moves from Pending to Committed when it is
+ * retriggered and to Displayed once the channel reports its descriptor ID.
+ */
+typedef struct {
+	XDpDma_FlipBuffer Buffer[XDPDMA_FLIP_MAX_BUFFERS];
+	XDpDma_ChannelType Channel;
+	u8 NumPlanes;
+	u8 NumBuffers;
+	u8 Started;
+	volatile u8 Pending;		/**< Submitted, not yet committed */
+	volatile u8 Committed;		/**< Retriggered, not yet fetched */
+	volatile u8 Displayed;		/**< Being scanned out */
+	u32 Flips;			/**< Buffers displayed */
+	u32 Replaced;			/**< Pending buffers replaced before
+					     being committed */
+} XDpDma_FlipQueue;
+
+/**
+ * This typedef defines an audio ring. The descriptors are linked in a
+ * circle over one audio buffer split in fragments, so the channel plays
+ * until it is disabled while the user refills played fragments.
+ */
+typedef struct {
+	XDpDma_AudioFragment Frag[XDPDMA_AUDIO_RING_MAX];
+	u64 Address;
+	u32 FragSize;
+	u8 NumFrags;
+	u8 Next;			/**< Next fragment to complete */
+} XDpDma_AudioRing;
 /*************************************************************************/
 /**
  * This callback type represents the handler for a DPDMA VSync interrupt.
@@ -237,6 +296,8 @@ typedef struct {
 	XDpDma_VideoChannel Video;
 	XDpDma_GfxChannel Gfx;
 	XDpDma_AudioChannel Audio[2];
+	XDpDma_FlipQueue *VideoFlip;
+	XDpDma_FlipQueue *GfxFlip;
 	XVidC_VideoTiming *Timing;
 	u8 QOS;
 
@@ -275,6 +336,22 @@ void XDpDma_InitAudioDescriptor(XDpDma_AudioChannel *Channel,
 			       XDpDma_AudioBuffer *AudioBuffer);
 int XDpDma_PlayAudio(XDpDma *InstancePtr, XDpDma_AudioBuffer *Buffer,
 		      u8 ChannelNum);
+
+/* Flip queue and audio ring functions in xdpdma_flip.c */
+int XDpDma_FlipInit(XDpDma *InstancePtr, XDpDma_FlipQueue *Flip,
+		    XDpDma_ChannelType Channel, u8 NumBuffers);
+int XDpDma_FlipSetBuffer(XDpDma_FlipQueue *Flip, u8 Index,
+			 XDpDma_FrameBuffer *Plane0,
+			 XDpDma_FrameBuffer *Plane1,
+			 XDpDma_FrameBuffer *Plane2);
+int XDpDma_FlipSubmit(XDpDma_FlipQueue *Flip, u8 Index);
+int XDpDma_FlipGetFreeBuffer(XDpDma_FlipQueue *Flip, u8 *IndexPtr);
+void XDpDma_FlipVSync(XDpDma *InstancePtr, XDpDma_FlipQueue *Flip);
+int XDpDma_AudioRingInit(XDpDma_AudioRing *Ring, XDpDma_AudioBuffer *Buffer,
+			 u8 NumFrags);
+int XDpDma_AudioRingStart(XDpDma *InstancePtr, XDpDma_AudioRing *Ring,
+			  u8 ChannelNum);
+u8 XDpDma_AudioRingReclaim(XDpDma_AudioRing *Ring, u8 *FirstPtr);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,559 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2019 Xilinx, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+ ******************************************************************************/
+
+/*****************************************************************************/
+/**
+ *
+ * @file xdpdma_flip.c
+ *
+ * This file implements the flip queues of the Video and Graphics channels
+ * and the audio rings.
+ *
+ * The descriptors of every frame buffer and audio fragment are built once
+ * and linked in advance. On VSync a flip only programs the descriptor start
+ * address and retriggers the channel, which fetches the new descriptor at
+ * the next frame boundary, so no descriptor is written in the blanking
+ * window and a flip never lands mid-frame.
+ *
+ * With three buffers, one is displayed, one may wait for the next VSync and
+ * the user renders into the third. Submitting a buffer while another one is
+ * still pending replaces the pending one, so that the newest frame is shown.
+ *
+ * @note	XDpDma_FlipSubmit() and XDpDma_FlipGetFreeBuffer() may be
+ *		called while the VSync interrupt is enabled.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver	Who   Date     Changes
+ * ---- ----- -------- ----------------------------------------------------
+ * 1.2  adk   10/15/19 Initial release.
+ * </pre>
+ *
+ *****************************************************************************/
+
+/***************************** Include Files **********************************/
+#include "xdpdma.h"
+#include "xil_cache.h"
+
+/************************** Constant Definitions ******************************/
+#define XDPDMA_CH_OFFSET		0x100
+#define XDPDMA_GRAPHICS_CHANNEL		3
+#define XDPDMA_AUDIO_CHANNEL0		4
+
+#define XDPDMA_DESC_PREAMBLE		0xA5
+#define XDPDMA_DESC_IGNR_DONE		0x400
+#define XDPDMA_DESC_UPDATE		0x200
+#define XDPDMA_DESC_DONE_SHIFT		31
+#define XDPDMA_DSCR_ID_MASK		0xFFFF
+#define XDPDMA_AUDIO_ALIGNMENT		128
+
+/* Descriptor IDs start at 1, as the other descriptors of the driver use 0 */
+#define XDPDMA_FLIP_DSCR_ID(Index)	((u32)(Index) + 1U)
+
+/*************************************************************************/
+/**
+ *
+ * This function programs the start address of a descriptor on a channel.
+ *
+ * @param    InstancePtr is a pointer to the driver instance.
+ * @param    ChannelNum is the physical channel number of the DPDMA.
+ * @param    Descriptor is the descriptor to be fetched on the next trigger.
+ *
+ * @return   None.
+ *
+ * @note     None.
+ *
+ * **************************************************************************/
+static void XDpDma_FlipSetStart(XDpDma *InstancePtr, u8 ChannelNum,
+				XDpDma_Descriptor *Descriptor)
+{
+	u64 DescAddr = (INTPTR) Descriptor;
+
+	XDpDma_WriteReg(InstancePtr->Config.BaseAddr,
+			XDPDMA_CH0_DSCR_STRT_ADDRE +
+			(XDPDMA_CH_OFFSET * ChannelNum),
+			UPPER_32_BITS(DescAddr));
+	XDpDma_WriteReg(InstancePtr->Config.BaseAddr,
+			XDPDMA_CH0_DSCR_STRT_ADDR +
+			(XDPDMA_CH_OFFSET * ChannelNum),
+			LOWER_32_BITS(DescAddr));
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function returns the descriptor of a plane of a frame buffer.
+ *
+ * @param    Flip is a pointer to the flip queue.
+ * @param    Index is the frame buffer index.
+ * @param    Plane is the plane number.
+ *
+ * @return   Pointer to the descriptor.
+ *
+ * @note     None.
+ *
+ * **************************************************************************/
+static XDpDma_Descriptor *XDpDma_FlipDesc(XDpDma_FlipQueue *Flip, u8 Index,
+					  u8 Plane)
+{
+	XDpDma_FlipBuffer *Buffer = &Flip->Buffer[Index];
+
+	if(Plane == 2) {
+		return &Buffer->Plane2;
+	}
+	else if(Plane == 1) {
+		return &Buffer->Plane1;
+	}
+	return &Buffer->Plane0;
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function returns the first physical channel of a flip queue.
+ *
+ * @param    Flip is a pointer to the flip queue.
+ *
+ * @return   Physical channel number.
+ *
+ * @note     None.
+ *
+ * **************************************************************************/
+static u8 XDpDma_FlipFirstChannel(XDpDma_FlipQueue *Flip)
+{
+	return (Flip->Channel == GraphicsChan) ? XDPDMA_GRAPHICS_CHANNEL : 0;
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function initializes a flip queue and attaches it to the VSync
+ * handler. The format of the channel has to be set beforehand.
+ *
+ * @param    InstancePtr is a pointer to the driver instance.
+ * @param    Flip is a pointer to the flip queue.
+ * @param    Channel is VideoChan or GraphicsChan.
+ * @param    NumBuffers is the number of frame buffers, 2 or 3.
+ *
+ * @return   XST_SUCCESS when the flip queue is attached.
+ *	     XST_FAILURE when the format of the channel is not set.
+ *
+ * @note     The frame buffers have to be set with XDpDma_FlipSetBuffer()
+ *	     before they are submitted.
+ *
+ * **************************************************************************/
+int XDpDma_FlipInit(XDpDma *InstancePtr, XDpDma_FlipQueue *Flip,
+		    XDpDma_ChannelType Channel, u8 NumBuffers)
+{
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Flip != NULL);
+	Xil_AssertNonvoid((Channel == VideoChan) ||
+			  (Channel == GraphicsChan));
+	Xil_AssertNonvoid((NumBuffers >= 2) &&
+			  (NumBuffers <= XDPDMA_FLIP_MAX_BUFFERS));
+
+	if(Channel == VideoChan) {
+		if(InstancePtr->Video.VideoInfo == NULL) {
+			return XST_FAILURE;
+		}
+		Flip->NumPlanes = InstancePtr->Video.VideoInfo->Mode + 1;
+	}
+	else {
+		if(InstancePtr->Gfx.VideoInfo == NULL) {
+			return XST_FAILURE;
+		}
+		Flip->NumPlanes = 1;
+	}
+
+	Flip->Channel = Channel;
+	Flip->NumBuffers = NumBuffers;
+	Flip->Started = 0;
+	Flip->Pending = XDPDMA_FLIP_NONE;
+	Flip->Committed = XDPDMA_FLIP_NONE;
+	Flip->Displayed = XDPDMA_FLIP_NONE;
+	Flip->Flips = 0;
+	Flip->Replaced = 0;
+
+	if(Channel == VideoChan) {
+		InstancePtr->VideoFlip = Flip;
+	}
+	else {
+		InstancePtr->GfxFlip = Flip;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function builds the descriptors of a frame buffer of a flip queue.
+ *
+ * @param    Flip is a pointer to the flip queue.
+ * @param    Index is the frame buffer index.
+ * @param    Plane0 is a pointer to the Frame Buffer structure.
+ * @param    Plane1 is a pointer to the Frame Buffer structure.
+ * @param    Plane2 is a pointer to the Frame Buffer structure.
+ *
+ * @return   XST_SUCCESS when the descriptors are built.
+ *	     XST_DEVICE_BUSY when the frame buffer is pending, committed or
+ *	     displayed.
+ *
+ * @note     For interleaved mode use Plane0.
+ *	     For semi-planar mode use Plane0 and Plane1.
+ *	     For planar mode use Plane0, Plane1 and Plane2.
+ *
+ * **************************************************************************/
+int XDpDma_FlipSetBuffer(XDpDma_FlipQueue *Flip, u8 Index,
+			 XDpDma_FrameBuffer *Plane0,
+			 XDpDma_FrameBuffer *Plane1,
+			 XDpDma_FrameBuffer *Plane2)
+{
+	XDpDma_FrameBuffer *Planes[3] = { Plane0, Plane1, Plane2 };
+	XDpDma_Descriptor *Desc;
+	u8 Plane;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Flip != NULL);
+	Xil_AssertNonvoid(Index < Flip->NumBuffers);
+
+	if((Index == Flip->Pending) || (Index == Flip->Committed) ||
+	   (Index == Flip->Displayed)) {
+		return XST_DEVICE_BUSY;
+	}
+
+	for(Plane = 0; Plane < Flip->NumPlanes; Plane++) {
+		Xil_AssertNonvoid(Planes[Plane] != NULL);
+		Desc = XDpDma_FlipDesc(Flip, Index, Plane);
+		XDpDma_InitVideoDescriptor(Desc, Planes[Plane]);
+		Desc->DSCR_ID = XDPDMA_FLIP_DSCR_ID(Index);
+		Xil_DCacheFlushRange((INTPTR)Desc, sizeof(XDpDma_Descriptor));
+	}
+
+	return XST_SUCCESS;
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function queues a frame buffer for display on the next VSync.
+ *
+ * @param    Flip is a pointer to the flip queue.
+ * @param    Index is the frame buffer index.
+ *
+ * @return   XST_SUCCESS when the frame buffer is queued.
+ *	     XST_DEVICE_BUSY when the frame buffer is committed or
+ *	     displayed.
+ *
+ * @note     A frame buffer still pending is replaced and becomes free.
+ *
+ * **************************************************************************/
+int XDpDma_FlipSubmit(XDpDma_FlipQueue *Flip, u8 Index)
+{
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Flip != NULL);
+	Xil_AssertNonvoid(Index < Flip->NumBuffers);
+
+	if((Index == Flip->Committed) || (Index == Flip->Displayed)) {
+		return XST_DEVICE_BUSY;
+	}
+
+	if((Flip->Pending != XDPDMA_FLIP_NONE) && (Flip->Pending != Index)) {
+		Flip->Replaced++;
+	}
+	/* Single store, the VSync handler sees either buffer */
+	Flip->Pending = Index;
+
+	return XST_SUCCESS;
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function returns a frame buffer the user may render into.
+ *
+ * @param    Flip is a pointer to the flip queue.
+ * @param    IndexPtr is filled with the frame buffer index.
+ *
+ * @return   XST_SUCCESS when a frame buffer is free.
+ *	     XST_FAILURE when all the frame buffers are in use.
+ *
+ * @note     The states are read in the order the VSync handler moves the
+ *	     buffers, so a buffer is never seen free while it moves.
+ *
+ * **************************************************************************/
+int XDpDma_FlipGetFreeBuffer(XDpDma_FlipQueue *Flip, u8 *IndexPtr)
+{
+	u8 Pending, Committed, Displayed;
+	u8 Index;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Flip != NULL);
+	Xil_AssertNonvoid(IndexPtr != NULL);
+
+	Pending = Flip->Pending;
+	Committed = Flip->Committed;
+	Displayed = Flip->Displayed;
+
+	for(Index = 0; Index < Flip->NumBuffers; Index++) {
+		if((Index != Pending) && (Index != Committed) &&
+		   (Index != Displayed)) {
+			*IndexPtr = Index;
+			return XST_SUCCESS;
+		}
+	}
+
+	return XST_FAILURE;
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function advances a flip queue on VSync. It is called by
+ * XDpDma_VSyncHandler for the attached flip queues.
+ *
+ * @param    InstancePtr is a pointer to the driver instance.
+ * @param    Flip is a pointer to the flip queue.
+ *
+ * @return   None.
+ *
+ * @note     A committed buffer has to be fetched by the channel before the
+ *	     next one is committed, otherwise the retrigger could be lost.
+ *
+ * **************************************************************************/
+void XDpDma_FlipVSync(XDpDma *InstancePtr, XDpDma_FlipQueue *Flip)
+{
+	XDpDma_Descriptor *Desc;
+	u8 FirstChannel;
+	u8 Plane;
+	u8 Index;
+	u32 DscrId;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Flip != NULL);
+
+	FirstChannel = XDpDma_FlipFirstChannel(Flip);
+
+	if(Flip->Committed != XDPDMA_FLIP_NONE) {
+		DscrId = XDpDma_ReadReg(InstancePtr->Config.BaseAddr,
+					XDPDMA_CH0_DSCR_ID +
+					(XDPDMA_CH_OFFSET * FirstChannel));
+		if((DscrId & XDPDMA_DSCR_ID_MASK) !=
+		   XDPDMA_FLIP_DSCR_ID(Flip->Committed)) {
+			return;
+		}
+		Flip->Displayed = Flip->Committed;
+		Flip->Committed = XDPDMA_FLIP_NONE;
+		Flip->Flips++;
+	}
+
+	Index = Flip->Pending;
+	if(Index == XDPDMA_FLIP_NONE) {
+		return;
+	}
+	/* Committed is set before Pending is cleared, see GetFreeBuffer */
+	if(Index != Flip->Displayed) {
+		for(Plane = 0; Plane < Flip->NumPlanes; Plane++) {
+			Desc = XDpDma_FlipDesc(Flip, Index, Plane);
+			XDpDma_FlipSetStart(InstancePtr, FirstChannel + Plane,
+					    Desc);
+			if(Flip->Channel == VideoChan) {
+				InstancePtr->Video.Channel[Plane].Current =
+					Desc;
+			}
+			else {
+				InstancePtr->Gfx.Channel.Current = Desc;
+			}
+		}
+		Flip->Committed = Index;
+	}
+	Flip->Pending = XDPDMA_FLIP_NONE;
+
+	if(Flip->Committed == XDPDMA_FLIP_NONE) {
+		return;
+	}
+	if(Flip->Started == 0) {
+		XDpDma_SetChannelState(InstancePtr, Flip->Channel,
+				       XDPDMA_ENABLE);
+		XDpDma_Trigger(InstancePtr, Flip->Channel);
+		Flip->Started = 1;
+	}
+	else {
+		XDpDma_ReTrigger(InstancePtr, Flip->Channel);
+	}
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function builds an audio ring over an audio buffer.
+ *
+ * @param    Ring is a pointer to the audio ring.
+ * @param    Buffer is the audio buffer, split in NumFrags fragments.
+ * @param    NumFrags is the number of fragments, 2 to
+ *	     XDPDMA_AUDIO_RING_MAX.
+ *
+ * @return   XST_SUCCESS when the ring is built.
+ *	     XST_INVALID_PARAM when the fragments are not multiples of
+ *	     128 bytes.
+ *
+ * @note     None.
+ *
+ * **************************************************************************/
+int XDpDma_AudioRingInit(XDpDma_AudioRing *Ring, XDpDma_AudioBuffer *Buffer,
+			 u8 NumFrags)
+{
+	XDpDma_Descriptor *Desc;
+	u64 DescAddr;
+	u64 FragAddr;
+	u8 Index;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Ring != NULL);
+	Xil_AssertNonvoid(Buffer != NULL);
+	Xil_AssertNonvoid((NumFrags >= 2) &&
+			  (NumFrags <= XDPDMA_AUDIO_RING_MAX));
+
+	if((Buffer->Address % XDPDMA_AUDIO_ALIGNMENT != 0) ||
+	   (Buffer->Size % (NumFrags * XDPDMA_AUDIO_ALIGNMENT) != 0)) {
+		return XST_INVALID_PARAM;
+	}
+
+	Ring->Address = Buffer->Address;
+	Ring->FragSize = Buffer->Size / NumFrags;
+	Ring->NumFrags = NumFrags;
+	Ring->Next = 0;
+
+	for(Index = 0; Index < NumFrags; Index++) {
+		Desc = &Ring->Frag[Index].Desc;
+		DescAddr = (INTPTR) &Ring->Frag[(Index + 1) % NumFrags].Desc;
+		FragAddr = Ring->Address + ((u64)Ring->FragSize * Index);
+
+		Desc->Control = XDPDMA_DESC_PREAMBLE | XDPDMA_DESC_UPDATE |
+				XDPDMA_DESC_IGNR_DONE;
+		Desc->DSCR_ID = 0;
+		Desc->XFER_SIZE = Ring->FragSize;
+		Desc->LINE_SIZE_STRIDE = 0;
+		Desc->LSB_Timestamp = 0;
+		Desc->MSB_Timestamp = 0;
+		Desc->ADDR_EXT = ((FragAddr >> XDPDMA_DESCRIPTOR_SRC_ADDR_WIDTH) <<
+				  XDPDMA_DESCRIPTOR_ADDR_EXT_SRC_ADDR_EXT_SHIFT) |
+				 (UPPER_32_BITS(DescAddr));
+		Desc->NEXT_DESR = LOWER_32_BITS(DescAddr);
+		Desc->SRC_ADDR = LOWER_32_BITS(FragAddr);
+		Xil_DCacheFlushRange((INTPTR)Desc, sizeof(XDpDma_Descriptor));
+	}
+
+	return XST_SUCCESS;
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function starts playing an audio ring on an audio channel.
+ *
+ * @param    InstancePtr is a pointer to the driver instance.
+ * @param    Ring is a pointer to the audio ring.
+ * @param    ChannelNum selects between Audio Channel 0 and Audio Channel 1.
+ *
+ * @return   XST_SUCCESS when the channel is started.
+ *	     XST_FAILURE when the channel fails to be enabled.
+ *
+ * @note     The ring plays until the channel is disabled with
+ *	     XDpDma_SetChannelState().
+ *
+ * **************************************************************************/
+int XDpDma_AudioRingStart(XDpDma *InstancePtr, XDpDma_AudioRing *Ring,
+			  u8 ChannelNum)
+{
+	XDpDma_ChannelType Channel;
+	int Status;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Ring != NULL);
+	Xil_AssertNonvoid(ChannelNum <= 1);
+
+	Channel = (ChannelNum == 0) ? AudioChan0 : AudioChan1;
+	InstancePtr->Audio[ChannelNum].Current = &Ring->Frag[0].Desc;
+	InstancePtr->Audio[ChannelNum].Buffer = NULL;
+	Ring->Next = 0;
+
+	XDpDma_FlipSetStart(InstancePtr, XDPDMA_AUDIO_CHANNEL0 + ChannelNum,
+			    &Ring->Frag[0].Desc);
+	Status = XDpDma_SetChannelState(InstancePtr, Channel, XDPDMA_ENABLE);
+	if(Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return XDpDma_Trigger(InstancePtr, Channel);
+}
+
+/*************************************************************************/
+/**
+ *
+ * This function returns the fragments played since the last call, which
+ * the user may refill.
+ *
+ * @param    Ring is a pointer to the audio ring.
+ * @param    FirstPtr is filled with the index of the first played
+ *	     fragment. The others follow it, wrapping around the ring.
+ *
+ * @return   Number of fragments played.
+ *
+ * @note     The fragments have to be refilled before the ring wraps back
+ *	     to them, so this should be called at least every
+ *	     NumFrags - 1 fragments.
+ *
+ * **************************************************************************/
+u8 XDpDma_AudioRingReclaim(XDpDma_AudioRing *Ring, u8 *FirstPtr)
+{
+	XDpDma_Descriptor *Desc;
+	u8 Count = 0;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Ring != NULL);
+	Xil_AssertNonvoid(FirstPtr != NULL);
+
+	*FirstPtr = Ring->Next;
+	while(Count < Ring->NumFrags) {
+		Desc = &Ring->Frag[Ring->Next].Desc;
+		Xil_DCacheInvalidateRange((INTPTR)Desc,
+					  sizeof(XDpDma_Descriptor));
+		if((Desc->MSB_Timestamp >> XDPDMA_DESC_DONE_SHIFT) == 0) {
+			break;
+		}
+		/* Rearm the done bit for the next lap */
+		Desc->MSB_Timestamp = 0;
+		Xil_DCacheFlushRange((INTPTR)Desc, sizeof(XDpDma_Descriptor));
+		Ring->Next = (Ring->Next + 1) % Ring->NumFrags;
+		Count++;
+	}
+
+	return Count;
+}
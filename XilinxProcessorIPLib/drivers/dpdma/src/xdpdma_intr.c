@@ -38,6 +38,7 @@
  * Ver   Who  Date     Changes
  * ----- ---- -------- -----------------------------------------------
  * 1.0   aad  01/17/17 Initial release.
+ * 1.2   adk  10/15/19 Service the flip queues on VSync.
  * </pre>
  *
 *******************************************************************************/
@@ -117,6 +118,14 @@ void XDpDma_VSyncHandler(XDpDma *InstancePtr)
 {
 	Xil_AssertVoid(InstancePtr != NULL);
 
+	/* Flip queues only program descriptor addresses */
+	if(InstancePtr->VideoFlip != NULL) {
+		XDpDma_FlipVSync(InstancePtr, InstancePtr->VideoFlip);
+	}
+	if(InstancePtr->GfxFlip != NULL) {
+		XDpDma_FlipVSync(InstancePtr, InstancePtr->GfxFlip);
+	}
+
 	/* Video Channel Trigger/Retrigger Handler */
 	if(InstancePtr->Video.TriggerStatus == XDPDMA_TRIGGER_EN) {
 		XDpDma_SetupChannel(InstancePtr, VideoChan);
@@ -46,6 +46,7 @@
 # 3.6   hk   09/14/17 Export PL PCS PMA information for ETH1/2/3 as well.
 # 3.7   hk   12/01/17 Export TSU clock frequency to xparameters.h
 # 3.8   hk   07/19/18 Added canonical property is cache coherency.
+# 3.10  hk   07/08/19 Export the bd_timestamp parameter to xparameters.h
 #
 ##############################################################################
 
@@ -63,6 +64,19 @@ proc generate {drv_handle} {
 
     generate_sgmii_params $drv_handle "xparameters.h"
 
+    generate_bd_timestamp $drv_handle "xparameters.h"
+
+}
+
+proc generate_bd_timestamp {drv_handle file_name} {
+	set bd_timestamp [common::get_property CONFIG.bd_timestamp $drv_handle]
+	if {$bd_timestamp == "true" || $bd_timestamp == 1} {
+		set file_handle [::hsi::utils::open_include_file $file_name]
+		puts $file_handle "/* Buffer descriptors include timestamp words */"
+		puts $file_handle "\#define XPAR_XEMACPS_BD_TIMESTAMP 1"
+		puts $file_handle ""
+		close $file_handle
+	}
 }
 
 proc generate_gmii2rgmii_params {drv_handle file_name} {
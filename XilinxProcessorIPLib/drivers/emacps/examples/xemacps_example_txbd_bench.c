@@ -0,0 +1,351 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xemacps_example_txbd_bench.c
+*
+* Micro-benchmark of the Tx BD preparation cost of the EmacPs driver. It
+* compares, in CPU cycles per packet:
+*
+* - The per field accessors (XEmacPs_BdSetAddressTx(), XEmacPs_BdSetLength(),
+*   XEmacPs_BdClearLast()/XEmacPs_BdSetLast() and XEmacPs_BdClearTxUsed()),
+*   each of which reads the BD back before writing it.
+*
+* - The template fast path, XEmacPs_BdRingTxCtrl() and XEmacPs_BdRingTxFill(),
+*   which writes every BD with plain stores using the static control bits
+*   kept in the ring by XEmacPs_BdRingClone().
+*
+* Each packet allocates BENCH_FRAGS BDs, fills them the same way
+* emacps_sgsend() in the lwIP adapter does and returns them with
+* XEmacPs_BdRingUnAlloc(). The BDs are never given to the hardware, so no
+* link or PHY is needed and the GEM itself is not touched. The BD memory is
+* given the same attributes as in xemacps_example_intr_dma.c, so the numbers
+* include the cost of uncached BD accesses seen by a real driver.
+*
+* The cycle counts are derived from the global timer read by XTime_GetTime()
+* and the CPU clock frequency in xparameters.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 3.10  hk   06/26/19 First release
+*
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+#include "xparameters.h"
+#include "xil_types.h"
+#include "xil_printf.h"
+#include "xil_cache.h"
+#include "xil_mmu.h"
+#include "xtime_l.h"
+#include "xemacps.h"
+
+/************************** Constant Definitions ****************************/
+
+#define BENCH_NUM_BDS		64U	/* BDs in the Tx ring */
+#define BENCH_FRAGS		3U	/* BDs (pbufs) per packet */
+#define BENCH_PACKETS		100000U	/* Packets per measurement */
+#define BENCH_FRAG_LEN		512U	/* Bytes per fragment */
+
+#if defined (versal) && defined (__aarch64__)
+#define BENCH_CPU_FREQ_HZ	XPAR_CPU_CORTEXA72_CORE_CLOCK_FREQ_HZ
+#elif defined (__aarch64__)
+#define BENCH_CPU_FREQ_HZ	XPAR_CPU_CORTEXA53_CORE_CLOCK_FREQ_HZ
+#elif defined (ARMR5)
+#define BENCH_CPU_FREQ_HZ	XPAR_CPU_CORTEXR5_CORE_CLOCK_FREQ_HZ
+#else
+#define BENCH_CPU_FREQ_HZ	XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ
+#endif
+
+/**************************** Type Definitions ******************************/
+
+typedef void (*BenchFillFunc) (XEmacPs_BdRing *RingPtr, XEmacPs_Bd *BdSetPtr);
+
+/************************** Function Prototypes *****************************/
+
+int EmacPsTxBdBench(void);
+static void BenchFillAccessors(XEmacPs_BdRing *RingPtr, XEmacPs_Bd *BdSetPtr);
+static void BenchFillTemplate(XEmacPs_BdRing *RingPtr, XEmacPs_Bd *BdSetPtr);
+static LONG BenchRun(XEmacPs_BdRing *RingPtr, BenchFillFunc Fill,
+		     u64 *CyclesPtr);
+
+/************************** Variable Definitions ****************************/
+
+/*
+ * BD memory, aligned to the MMU section size so that its attributes can be
+ * changed without affecting adjacent data.
+ */
+#ifdef __ICCARM__
+#if defined __aarch64__
+#pragma data_alignment = 0x200000
+u8 bd_space[0x200000];
+#else
+#pragma data_alignment = 0x100000
+u8 bd_space[0x100000];
+#endif
+#else
+#if defined __aarch64__
+u8 bd_space[0x200000] __attribute__ ((aligned (0x200000)));
+#else
+u8 bd_space[0x100000] __attribute__ ((aligned (0x100000)));
+#endif
+#endif
+
+/* Frame data, only its address is put into the BDs */
+u8 BenchFrame[BENCH_FRAGS * BENCH_FRAG_LEN] __attribute__ ((aligned (64)));
+
+XEmacPs_BdRing BenchRing;
+
+/****************************************************************************/
+/**
+*
+* This is the main function for the Tx BD micro-benchmark.
+*
+* @param	None.
+*
+* @return	- XST_SUCCESS to indicate success.
+*		- XST_FAILURE to indicate failure.
+*
+* @note		None.
+*
+****************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	LONG Status;
+
+	xil_printf("Entering into main() \r\n");
+
+	Status = EmacPsTxBdBench();
+	if (Status != XST_SUCCESS) {
+		xil_printf("Emacps Tx BD benchmark Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran Emacps Tx BD benchmark\r\n");
+	return XST_SUCCESS;
+}
+#endif
+
+/****************************************************************************/
+/**
+*
+* Set up a Tx ring the way the lwIP adapter does and measure both ways of
+* filling BDs.
+*
+* @param	None.
+*
+* @return	- XST_SUCCESS to indicate success.
+*		- XST_FAILURE to indicate failure.
+*
+* @note		None.
+*
+****************************************************************************/
+int EmacPsTxBdBench(void)
+{
+	XEmacPs_Bd BdTemplate;
+	u64 AccessorCycles;
+	u64 TemplateCycles;
+	LONG Status;
+
+	/* Same attributes as used for the BDs in xemacps_example_intr_dma.c */
+#if defined (__aarch64__)
+	Xil_SetTlbAttributes((UINTPTR)bd_space, NORM_NONCACHE |
+			     INNER_SHAREABLE);
+#elif defined (ARMR5)
+	Xil_SetTlbAttributes((INTPTR)bd_space, STRONG_ORDERD_SHARED |
+			     PRIV_RW_USER_RW);
+#else
+	Xil_SetTlbAttributes((INTPTR)bd_space, DEVICE_MEMORY);
+#endif
+
+	Status = XEmacPs_BdRingCreate(&BenchRing, (UINTPTR)bd_space,
+				      (UINTPTR)bd_space,
+				      XEMACPS_DMABD_MINIMUM_ALIGNMENT,
+				      BENCH_NUM_BDS);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Error setting up TxBD space\r\n");
+		return XST_FAILURE;
+	}
+
+	XEmacPs_BdClear(&BdTemplate);
+	XEmacPs_BdSetStatus(&BdTemplate, XEMACPS_TXBUF_USED_MASK);
+	Status = XEmacPs_BdRingClone(&BenchRing, &BdTemplate, XEMACPS_SEND);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Error cloning TxBD template\r\n");
+		return XST_FAILURE;
+	}
+
+	Status = BenchRun(&BenchRing, BenchFillAccessors, &AccessorCycles);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = BenchRun(&BenchRing, BenchFillTemplate, &TemplateCycles);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	xil_printf("Tx BD fill, %d BDs per packet, %d packets\r\n",
+		   BENCH_FRAGS, BENCH_PACKETS);
+	xil_printf("  per field accessors: %d cycles/packet\r\n",
+		   (u32)(AccessorCycles / BENCH_PACKETS));
+	xil_printf("  BD template:         %d cycles/packet\r\n",
+		   (u32)(TemplateCycles / BENCH_PACKETS));
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Allocate, fill and release BENCH_PACKETS packets of BENCH_FRAGS BDs and
+* return the CPU cycles it took.
+*
+* @param	RingPtr is the Tx ring.
+* @param	Fill fills the BDs of one packet.
+* @param	CyclesPtr returns the elapsed CPU cycles.
+*
+* @return	- XST_SUCCESS to indicate success.
+*		- XST_FAILURE to indicate failure.
+*
+* @note		None.
+*
+****************************************************************************/
+static LONG BenchRun(XEmacPs_BdRing *RingPtr, BenchFillFunc Fill,
+		     u64 *CyclesPtr)
+{
+	XEmacPs_Bd *BdSetPtr;
+	XTime Start;
+	XTime End;
+	LONG Status;
+	u32 i;
+
+	XTime_GetTime(&Start);
+
+	for (i = 0U; i < BENCH_PACKETS; i++) {
+		Status = XEmacPs_BdRingAlloc(RingPtr, BENCH_FRAGS, &BdSetPtr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Error allocating TxBD\r\n");
+			return XST_FAILURE;
+		}
+
+		Fill(RingPtr, BdSetPtr);
+
+		Status = XEmacPs_BdRingUnAlloc(RingPtr, BENCH_FRAGS, BdSetPtr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Error releasing TxBD\r\n");
+			return XST_FAILURE;
+		}
+	}
+
+	XTime_GetTime(&End);
+
+	*CyclesPtr = ((u64)(End - Start) * (u64)BENCH_CPU_FREQ_HZ) /
+		     (u64)COUNTS_PER_SECOND;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Fill the BDs of one packet with the per field accessors, as emacps_sgsend()
+* did before the template fast path.
+*
+* @param	RingPtr is the Tx ring.
+* @param	BdSetPtr is the first BD of the packet.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void BenchFillAccessors(XEmacPs_BdRing *RingPtr, XEmacPs_Bd *BdSetPtr)
+{
+	XEmacPs_Bd *BdPtr = BdSetPtr;
+	XEmacPs_Bd *LastBdPtr = BdSetPtr;
+	u32 i;
+
+	for (i = 0U; i < BENCH_FRAGS; i++) {
+		XEmacPs_BdSetAddressTx(BdPtr,
+				(UINTPTR)&BenchFrame[i * BENCH_FRAG_LEN]);
+		XEmacPs_BdSetLength(BdPtr, BENCH_FRAG_LEN);
+		XEmacPs_BdClearLast(BdPtr);
+		LastBdPtr = BdPtr;
+		BdPtr = XEmacPs_BdRingNext(RingPtr, BdPtr);
+	}
+	XEmacPs_BdSetLast(LastBdPtr);
+
+	BdPtr = XEmacPs_BdRingNext(RingPtr, BdSetPtr);
+	for (i = 1U; i < BENCH_FRAGS; i++) {
+		XEmacPs_BdClearTxUsed(BdPtr);
+		BdPtr = XEmacPs_BdRingNext(RingPtr, BdPtr);
+	}
+	XEmacPs_BdClearTxUsed(BdSetPtr);
+}
+
+/****************************************************************************/
+/**
+*
+* Fill the BDs of one packet with the template fast path, as emacps_sgsend()
+* does now.
+*
+* @param	RingPtr is the Tx ring.
+* @param	BdSetPtr is the first BD of the packet.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void BenchFillTemplate(XEmacPs_BdRing *RingPtr, XEmacPs_Bd *BdSetPtr)
+{
+	XEmacPs_Bd *BdPtr = BdSetPtr;
+	u32 FirstCtrl = 0U;
+	u32 Ctrl;
+	u32 i;
+
+	for (i = 0U; i < BENCH_FRAGS; i++) {
+		Ctrl = XEmacPs_BdRingTxCtrl(RingPtr, BdPtr, BENCH_FRAG_LEN,
+				(i == (BENCH_FRAGS - 1U)) ?
+				XEMACPS_TXBUF_LAST_MASK : 0U);
+		if (i == 0U) {
+			FirstCtrl = Ctrl;
+			Ctrl |= XEMACPS_TXBUF_USED_MASK;
+		}
+		XEmacPs_BdRingTxFill(BdPtr,
+				(UINTPTR)&BenchFrame[i * BENCH_FRAG_LEN], Ctrl);
+		BdPtr = XEmacPs_BdRingNext(RingPtr, BdPtr);
+	}
+	XEmacPs_BdWrite(BdSetPtr, XEMACPS_BD_STAT_OFFSET, FirstCtrl);
+}
@@ -51,6 +51,8 @@
 * 3.8  hk   09/17/18 Cleanup stale comments.
 * 3.8  mus  11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
 * 3.10 hk   05/16/19 Clear status registers properly in reset
+*      hk   06/12/19 Program RX Q1 base address and buffer size, enable
+*                    RX Q1 interrupts when a queue 1 ring is in use.
 *
 * </pre>
 ******************************************************************************/
@@ -111,8 +113,12 @@ LONG XEmacPs_CfgInitialize(XEmacPs *InstancePtr, XEmacPs_Config * CfgPtr,
 	/* Set callbacks to an initial stub routine */
 	InstancePtr->SendHandler = ((XEmacPs_Handler)((void*)XEmacPs_StubHandler));
 	InstancePtr->RecvHandler = ((XEmacPs_Handler)(void*)XEmacPs_StubHandler);
+	InstancePtr->RecvQ1Handler = ((XEmacPs_Handler)(void*)XEmacPs_StubHandler);
 	InstancePtr->ErrorHandler = ((XEmacPs_ErrHandler)(void*)XEmacPs_StubHandler);
 
+	/* No queue 1 RX ring until the user creates one */
+	InstancePtr->RxBdRingQ1.BaseBdAddr = 0U;
+
 	/* Reset the hardware and set default options */
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
 	XEmacPs_Reset(InstancePtr);
@@ -205,7 +211,12 @@ void XEmacPs_Start(XEmacPs *InstancePtr)
 
 	/* Enable TX Q1 Interrupts */
 	if (InstancePtr->Version > 2)
-		XEmacPs_IntQ1Enable(InstancePtr, XEMACPS_INTQ1_IXR_ALL_MASK);
+		XEmacPs_IntQ1Enable(InstancePtr, XEMACPS_INTQ1_IXR_TX_MASK);
+
+	/* Enable RX Q1 Interrupts only if a queue 1 ring has been set up */
+	if ((InstancePtr->Version > 2) &&
+			(InstancePtr->RxBdRingQ1.BaseBdAddr != 0U))
+		XEmacPs_IntQ1Enable(InstancePtr, XEMACPS_INTQ1_IXR_RX_MASK);
 
 	/* Mark as started */
 	InstancePtr->IsStarted = XIL_COMPONENT_IS_STARTED;
@@ -369,10 +380,22 @@ void XEmacPs_Reset(XEmacPs *InstancePtr)
 	if (InstancePtr->Version > 2)
 		XEmacPs_SetQueuePtr(InstancePtr, 0, 0x01U, (u16)XEMACPS_SEND);
 	XEmacPs_SetQueuePtr(InstancePtr, 0, 0x00U, (u16)XEMACPS_RECV);
+	if (InstancePtr->Version > 2) {
+		XEmacPs_SetQueuePtr(InstancePtr, 0, 0x01U, (u16)XEMACPS_RECV);
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_RXQ1BUFSIZE_OFFSET,
+			(((u32)XEMACPS_RX_BUF_SIZE / (u32)XEMACPS_RX_BUF_UNIT) +
+			((((u32)XEMACPS_RX_BUF_SIZE %
+			(u32)XEMACPS_RX_BUF_UNIT) != (u32)0) ? 1U : 0U)));
+	}
 
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
 			   XEMACPS_RXSR_OFFSET, XEMACPS_SR_ALL_MASK);
 
+	/* Steer all frames to queue 0 until screeners are programmed */
+	if (InstancePtr->Version > 2)
+		XEmacPs_ClearScreens(InstancePtr);
+
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress, XEMACPS_IDR_OFFSET,
 			   XEMACPS_IXR_ALL_MASK);
 
@@ -466,9 +489,15 @@ void XEmacPs_SetQueuePtr(XEmacPs *InstancePtr, UINTPTR QPtr, u8 QueueNum,
 		}
 	}
 	 else {
-		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
-			XEMACPS_TXQ1BASE_OFFSET,
-			(QPtr & ULONG64_LO_MASK));
+		if (Direction == XEMACPS_SEND) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_TXQ1BASE_OFFSET,
+				(QPtr & ULONG64_LO_MASK));
+		} else {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_RXQ1BASE_OFFSET,
+				(QPtr & ULONG64_LO_MASK));
+		}
 	}
 #ifdef __aarch64__
 	if (Direction == XEMACPS_SEND) {
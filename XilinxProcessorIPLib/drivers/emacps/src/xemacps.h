@@ -327,6 +327,10 @@
  * 3.8   hk   07/19/18 Fixed CPP, GCC and doxygen warnings - CR-1006327
  *	 hk   09/17/18 Fix PTP interrupt masks and cleanup comments.
  * 3.9   hk   01/23/19 Add RX watermark support
+ * 3.10  hk   06/12/19 Add RX priority queue 1 BD ring and receive handler,
+ *                     and screener APIs to steer frames to RX queues.
+ *       hk   07/08/19 Add BD timestamps, 1588 timer (TSU) access and a PI
+ *                     clock servo in xemacps_tsu.c.
  *
  * </pre>
  *
@@ -453,6 +457,17 @@ extern "C" {
 #define XEMACPS_HANDLER_DMASEND 1U
 #define XEMACPS_HANDLER_DMARECV 2U
 #define XEMACPS_HANDLER_ERROR   3U
+#define XEMACPS_HANDLER_DMARECVQ1 4U
+/*@}*/
+
+/** @name Receive queues
+ *
+ * Number of RX priority queues handled by the driver. Queue 0 is the default
+ * queue; frames are steered to other queues by the type 1 and type 2
+ * screeners.
+ * @{
+ */
+#define XEMACPS_MAX_RXQUEUES    2U
 /*@}*/
 
 /* Constants to determine the configuration of the hardware device. They are
@@ -519,6 +534,36 @@ typedef void (*XEmacPs_ErrHandler) (void *CallBackRef, u8 Direction,
 
 /*@}*/
 
+/**
+ * Time of the 1588 timer (TSU), also used for BD timestamps.
+ */
+typedef struct {
+	u64 Seconds;		/**< Seconds, 48 bits on GEM version > 2 */
+	u32 NanoSeconds;	/**< Nanoseconds, 0 to 999999999 */
+} XEmacPs_Timestamp;
+
+/**
+ * State of the PI servo that steers the 1588 timer towards a master clock,
+ * see XEmacPs_TsuServoInit() and XEmacPs_TsuServoSample().
+ */
+typedef struct {
+	s32 Kp;			/**< Proportional gain, 16.16 fixed point */
+	s32 Ki;			/**< Integral gain, 16.16 fixed point */
+	u32 IntervalMs;		/**< Time between two samples */
+	u32 StepThresholdNs;	/**< Offsets above this step the timer */
+	s32 MaxPpb;		/**< Frequency adjustment limit */
+	s64 Integral;		/**< Accumulated frequency error, ppb */
+	s32 Ppb;		/**< Last frequency adjustment */
+	u32 Locked;		/**< Set once an offset was below threshold */
+} XEmacPs_TsuServo;
+
+/** @name XEmacPs_TsuServoSample() return values
+ * @{
+ */
+#define XEMACPS_SERVO_STEPPED	0U	/**< The timer was stepped */
+#define XEMACPS_SERVO_LOCKED	1U	/**< The frequency was adjusted */
+/*@}*/
+
 /**
  * This typedef contains configuration information for a device.
  */
@@ -543,11 +588,14 @@ typedef struct XEmacPs_Instance {
 
 	XEmacPs_BdRing TxBdRing;	/* Transmit BD ring */
 	XEmacPs_BdRing RxBdRing;	/* Receive BD ring */
+	XEmacPs_BdRing RxBdRingQ1;	/* Receive BD ring, priority queue 1 */
 
 	XEmacPs_Handler SendHandler;
 	XEmacPs_Handler RecvHandler;
+	XEmacPs_Handler RecvQ1Handler;
 	void *SendRef;
 	void *RecvRef;
+	void *RecvQ1Ref;
 
 	XEmacPs_ErrHandler ErrorHandler;
 	void *ErrorRef;
@@ -556,6 +604,8 @@ typedef struct XEmacPs_Instance {
 	u32 MaxMtuSize;
 	u32 MaxFrameSize;
 	u32 MaxVlanFrameSize;
+	u32 TsuIncrement;	/* Nominal 1588 timer increment per TSU clock,
+				   ns in 8.24 fixed point */
 
 } XEmacPs;
 
@@ -594,6 +644,24 @@ typedef struct XEmacPs_Instance {
 *****************************************************************************/
 #define XEmacPs_GetRxRing(InstancePtr) ((InstancePtr)->RxBdRing)
 
+/****************************************************************************/
+/**
+* Retrieve the Rx ring object of priority queue 1. This object can be used in
+* the various Ring API functions. The ring must be created and its base
+* address programmed with XEmacPs_SetQueuePtr() before XEmacPs_Start() for
+* queue 1 receive interrupts to be enabled.
+*
+* @param  InstancePtr is the DMA channel to operate on.
+*
+* @return RxBdRingQ1 attribute
+*
+* @note
+* C-style signature:
+*    XEmacPs_BdRing XEmacPs_GetRxQ1Ring(XEmacPs *InstancePtr)
+*
+*****************************************************************************/
+#define XEmacPs_GetRxQ1Ring(InstancePtr) ((InstancePtr)->RxBdRingQ1)
+
 /****************************************************************************/
 /**
 *
@@ -841,6 +909,37 @@ LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index);
 LONG XEmacPs_SendPausePacket(XEmacPs *InstancePtr);
 void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength);
 
+/*
+ * RX queue screening functions in xemacps_screen.c
+ */
+void XEmacPs_GetScreenerCount(XEmacPs *InstancePtr, u8 *Type1Count,
+			      u8 *Type2Count, u8 *EthTypeCount,
+			      u8 *CompareCount);
+LONG XEmacPs_SetType1Screen(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+			    u32 Enable, u8 DsTc, u16 UdpPort);
+LONG XEmacPs_SetType2Screen(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+			    u32 Enable, u8 VlanPriority, u8 EthTypeIndex,
+			    u8 CompareA, u8 CompareB, u8 CompareC);
+LONG XEmacPs_SetScreenEthType(XEmacPs *InstancePtr, u8 Index, u16 EthType);
+LONG XEmacPs_SetScreenCompare(XEmacPs *InstancePtr, u8 Index, u16 Value,
+			      u16 Mask, u8 OffsetType, u8 Offset);
+void XEmacPs_ClearScreens(XEmacPs *InstancePtr);
+
+/*
+ * Timestamp and 1588 timer functions in xemacps_tsu.c
+ */
+LONG XEmacPs_SetBdTimestampMode(XEmacPs *InstancePtr, u32 TxMode, u32 RxMode);
+LONG XEmacPs_BdGetTimestamp(XEmacPs *InstancePtr, XEmacPs_Bd *BdPtr,
+			    u32 Direction, XEmacPs_Timestamp *TsPtr);
+LONG XEmacPs_TsuInit(XEmacPs *InstancePtr, u32 TsuClkFreqHz);
+void XEmacPs_TsuGetTime(XEmacPs *InstancePtr, XEmacPs_Timestamp *TsPtr);
+void XEmacPs_TsuSetTime(XEmacPs *InstancePtr, XEmacPs_Timestamp *TsPtr);
+void XEmacPs_TsuAdjustTime(XEmacPs *InstancePtr, s64 OffsetNs);
+LONG XEmacPs_TsuAdjustFreq(XEmacPs *InstancePtr, s32 Ppb);
+void XEmacPs_TsuServoInit(XEmacPs_TsuServo *ServoPtr, u32 IntervalMs);
+u32 XEmacPs_TsuServoSample(XEmacPs *InstancePtr, XEmacPs_TsuServo *ServoPtr,
+			   s64 OffsetNs);
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,6 +65,8 @@
  * 3.2   hk   11/18/15 Change BD typedef and number of words.
  * 3.8   hk   08/18/18 Remove duplicate definition of XEmacPs_BdSetLength
  * 3.8   mus  11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
+ * 3.10  hk   07/08/19 Add the two timestamp words of extended BDs when
+ *                     XPAR_XEMACPS_BD_TIMESTAMP is defined.
  *
  * </pre>
  *
@@ -83,20 +85,37 @@ extern "C" {
 #include <string.h>
 #include "xil_types.h"
 #include "xil_assert.h"
+#include "xparameters.h"
 
 /************************** Constant Definitions *****************************/
 
 /**************************** Type Definitions *******************************/
+/*
+ * With XPAR_XEMACPS_BD_TIMESTAMP (bd_timestamp driver parameter) every BD
+ * ends with two timestamp words, which the controller fills when extended
+ * BD mode is enabled with XEmacPs_SetBdTimestampMode(). Only GEM versions
+ * later than 2 (Zynq Ultrascale+ MPSoC, Versal) support extended BDs.
+ */
+#ifdef XPAR_XEMACPS_BD_TIMESTAMP
+#define XEMACPS_BD_TS_WORDS 2U
+#else
+#define XEMACPS_BD_TS_WORDS 0U
+#endif
+
 #ifdef __aarch64__
 /* Minimum BD alignment */
 #define XEMACPS_DMABD_MINIMUM_ALIGNMENT  64U
-#define XEMACPS_BD_NUM_WORDS 4U
+#define XEMACPS_BD_NUM_WORDS (4U + XEMACPS_BD_TS_WORDS)
 #else
 /* Minimum BD alignment */
 #define XEMACPS_DMABD_MINIMUM_ALIGNMENT  4U
-#define XEMACPS_BD_NUM_WORDS 2U
+#define XEMACPS_BD_NUM_WORDS (2U + XEMACPS_BD_TS_WORDS)
 #endif
 
+/* Offset of the first timestamp word */
+#define XEMACPS_BD_TS_OFFSET \
+	((XEMACPS_BD_NUM_WORDS - XEMACPS_BD_TS_WORDS) * 4U)
+
 /**
  * The XEmacPs_Bd is the type for buffer descriptors (BDs).
  */
@@ -772,6 +791,76 @@ typedef u32 XEmacPs_Bd[XEMACPS_BD_NUM_WORDS];
     XEMACPS_RXBUF_SOF_MASK)!=0U ? TRUE : FALSE)
 
 
+/*****************************************************************************/
+/**
+ * Determine whether the controller stored a timestamp in a receive BD. Only
+ * meaningful for the last BD of a frame and with extended BDs enabled.
+ *
+ * @param  BdPtr is the BD pointer to operate on
+ *
+ * @note
+ * C-style signature:
+ *    u32 XEmacPs_BdIsRxTsValid(XEmacPs_Bd* BdPtr)
+ *
+ *****************************************************************************/
+#define XEmacPs_BdIsRxTsValid(BdPtr)                               \
+    ((XEmacPs_BdRead((BdPtr), XEMACPS_BD_ADDR_OFFSET) &           \
+    XEMACPS_RXBUF_TS_VALID_MASK)!=0U ? TRUE : FALSE)
+
+
+/*****************************************************************************/
+/**
+ * Determine whether the controller stored a timestamp in a transmit BD. Only
+ * meaningful for the last BD of a frame and with extended BDs enabled.
+ *
+ * @param  BdPtr is the BD pointer to operate on
+ *
+ * @note
+ * C-style signature:
+ *    u32 XEmacPs_BdIsTxTsValid(XEmacPs_Bd* BdPtr)
+ *
+ *****************************************************************************/
+#define XEmacPs_BdIsTxTsValid(BdPtr)                               \
+    ((XEmacPs_BdRead((BdPtr), XEMACPS_BD_STAT_OFFSET) &           \
+    XEMACPS_TXBUF_TS_VALID_MASK)!=0U ? TRUE : FALSE)
+
+
+/*****************************************************************************/
+/**
+ * Get the nanoseconds of the timestamp stored in a BD.
+ *
+ * @param  BdPtr is the BD pointer to operate on
+ *
+ * @note
+ * C-style signature:
+ *    u32 XEmacPs_BdGetTsNanoSec(XEmacPs_Bd* BdPtr)
+ *
+ *****************************************************************************/
+#define XEmacPs_BdGetTsNanoSec(BdPtr)                              \
+    (XEmacPs_BdRead((BdPtr), XEMACPS_BD_TS_OFFSET) &              \
+    XEMACPS_BD_TS_NSEC_MASK)
+
+
+/*****************************************************************************/
+/**
+ * Get the 6 least significant bits of the seconds of the timestamp stored in
+ * a BD. XEmacPs_BdGetTimestamp() completes them from the 1588 timer.
+ *
+ * @param  BdPtr is the BD pointer to operate on
+ *
+ * @note
+ * C-style signature:
+ *    u32 XEmacPs_BdGetTsSec(XEmacPs_Bd* BdPtr)
+ *
+ *****************************************************************************/
+#define XEmacPs_BdGetTsSec(BdPtr)                                  \
+    ((XEmacPs_BdRead((BdPtr), XEMACPS_BD_TS_OFFSET) >>            \
+    XEMACPS_BD_TS_SECL_SHIFT) |                                    \
+    ((XEmacPs_BdRead((BdPtr), XEMACPS_BD_TS_OFFSET + 4U) &        \
+    XEMACPS_BD_TS_SECH_MASK) << 2U))
+
+
+
 /************************** Function Prototypes ******************************/
 
 #ifdef __cplusplus
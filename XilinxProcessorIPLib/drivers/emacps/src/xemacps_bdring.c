@@ -53,6 +53,8 @@
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.6   rb   09/08/17 Add XEmacPs_BdRingPtrReset() API to reset BD ring
 * 		      pointers
+* 3.10  hk   06/26/19 XEmacPs_BdRingClone() keeps the static control bits of
+*		      a Tx template in the ring for XEmacPs_BdRingTxCtrl().
 *
 * </pre>
 ******************************************************************************/
@@ -263,6 +265,7 @@ LONG XEmacPs_BdRingCreate(XEmacPs_BdRing * RingPtr, UINTPTR PhysAddr,
 		((RingPtr->HighBdAddr - RingPtr->BaseBdAddr) + RingPtr->Separation);
 	RingPtr->AllCnt = (u32)BdCount;
 	RingPtr->FreeCnt = (u32)BdCount;
+	RingPtr->TxTemplate = 0x00000000U;
 	RingPtr->FreeHead = (XEmacPs_Bd *)(void *)VirtAddrLoc;
 	RingPtr->PreHead = (XEmacPs_Bd *)VirtAddrLoc;
 	RingPtr->HwHead = (XEmacPs_Bd *)VirtAddrLoc;
@@ -279,6 +282,10 @@ LONG XEmacPs_BdRingCreate(XEmacPs_BdRing * RingPtr, UINTPTR PhysAddr,
  * Clone the given BD into every BD in the list.
  * every field of the source BD is replicated in every BD of the list.
  *
+ * For a Tx ring the static control bits of the template (currently the no
+ * CRC bit) are also kept in the ring, XEmacPs_BdRingTxCtrl() uses them to
+ * build complete control words in the transmit path.
+ *
  * This function can be called only when all BDs are in the free group such as
  * they are immediately after initialization with XEmacPs_BdRingCreate().
  * This prevents modification of BDs while they are in use by hardware or the
@@ -339,6 +346,8 @@ LONG XEmacPs_BdRingClone(XEmacPs_BdRing * RingPtr, XEmacPs_Bd * SrcBdPtr,
 	}
 	else {
 		XEmacPs_BdSetTxWrap(CurBd);
+		RingPtr->TxTemplate = XEmacPs_BdRead(SrcBdPtr,
+				XEMACPS_BD_STAT_OFFSET) & XEMACPS_TXBUF_NOCRC_MASK;
 	}
 
 	return (LONG)(XST_SUCCESS);
@@ -43,6 +43,9 @@
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.6   rb   09/08/17 HwCnt variable (in XEmacPs_BdRing structure) is
 *		      changed to volatile.
+* 3.10  hk   06/26/19 Add TxTemplate to XEmacPs_BdRing and the
+*		      XEmacPs_BdRingTxCtrl()/XEmacPs_BdRingTxFill() fast path
+*		      for filling Tx BDs without read-modify-write.
 *
 * </pre>
 *
@@ -82,6 +85,8 @@ typedef struct {
 	u32 FreeCnt;    /**< Number of allocatable BDs in the free group */
 	u32 PostCnt;    /**< Number of BDs in post-work group */
 	u32 AllCnt;     /**< Total Number of BDs for channel */
+	u32 TxTemplate; /**< Static Tx control bits of the template BD given
+			     to XEmacPs_BdRingClone() */
 } XEmacPs_BdRing;
 
 
@@ -201,6 +206,55 @@ typedef struct {
     (XEmacPs_Bd*)(RingPtr)->HighBdAddr :                              \
     (XEmacPs_Bd*)((UINTPTR)(BdPtr) - (RingPtr)->Separation))
 
+/*****************************************************************************/
+/**
+* Compute the complete control/status word of a Tx BD from the ring's
+* template, so that it can be written with a single store. The static
+* control bits come from the template BD given to XEmacPs_BdRingClone() and
+* the wrap bit is set if BdPtr is the last BD of the ring. The used bit is
+* clear unless passed in Flags.
+*
+* @param  RingPtr is the Tx ring the BD belongs to.
+* @param  BdPtr is the BD the word is meant for.
+* @param  LenBytes is the number of bytes to transfer.
+* @param  Flags are per packet bits to add, XEMACPS_TXBUF_LAST_MASK for the
+*         last BD of a frame and/or XEMACPS_TXBUF_USED_MASK.
+*
+* @return The control/status word.
+*
+* @note
+* C-style signature:
+*    u32 XEmacPs_BdRingTxCtrl(XEmacPs_BdRing* RingPtr, XEmacPs_Bd *BdPtr,
+*                             u32 LenBytes, u32 Flags)
+*
+*****************************************************************************/
+#define XEmacPs_BdRingTxCtrl(RingPtr, BdPtr, LenBytes, Flags)          \
+    ((RingPtr)->TxTemplate | ((u32)(LenBytes) & XEMACPS_TXBUF_LEN_MASK) | \
+    (u32)(Flags) | (((UINTPTR)(BdPtr) == (RingPtr)->HighBdAddr) ?       \
+    XEMACPS_TXBUF_WRAP_MASK : 0U))
+
+/*****************************************************************************/
+/**
+* Fill a Tx BD with plain stores, the buffer address first and then the
+* control/status word computed with XEmacPs_BdRingTxCtrl(). Unlike the
+* individual XEmacPs_BdSet* accessors nothing is read back from the BD, so the
+* status bits left by the previous transmission are cleared as well.
+*
+* @param  BdPtr is the BD to fill.
+* @param  Addr is the buffer address.
+* @param  Ctrl is the control/status word.
+*
+* @note
+* C-style signature:
+*    void XEmacPs_BdRingTxFill(XEmacPs_Bd *BdPtr, UINTPTR Addr, u32 Ctrl)
+*
+*****************************************************************************/
+#define XEmacPs_BdRingTxFill(BdPtr, Addr, Ctrl)                      \
+    {                                                                 \
+        XEmacPs_BdSetAddressTx((BdPtr), (Addr));                      \
+        XEmacPs_BdWrite((BdPtr), XEMACPS_BD_STAT_OFFSET, (Ctrl));     \
+    }
+
 /************************** Function Prototypes ******************************/
 
 /*
@@ -58,6 +58,10 @@
 * 3.8  hk   09/17/18 Fix PTP interrupt masks.
 * 3.9  hk   01/23/19 Add RX watermark support
 * 3.10 hk   05/16/19 Clear status registers properly in reset
+*      hk   06/12/19 Add RX Q1 interrupt masks, RX Q1 buffer size register
+*                    and type 1/type 2 screener register definitions.
+*      hk   07/08/19 Add 1588 sub-ns increment, seconds MSB and BD timestamp
+*                    control registers and BD timestamp bits.
 * </pre>
 *
 ******************************************************************************/
@@ -272,6 +276,12 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_LAST_OFFSET          0x000001B4U /**< Last statistic counter
 						      offset, for clearing */
 
+#define XEMACPS_1588_SUBNS_INC_OFFSET 0x000001BCU /**< 1588 sub-nanosecond
+						      increment, GEM version
+						      later than 2 */
+#define XEMACPS_1588_SEC_MSB_OFFSET  0x000001C0U /**< 1588 second counter
+						      bits 47:32, GEM version
+						      later than 2 */
 #define XEMACPS_1588_SEC_OFFSET      0x000001D0U /**< 1588 second counter */
 #define XEMACPS_1588_NANOSEC_OFFSET  0x000001D4U /**< 1588 nanosecond counter */
 #define XEMACPS_1588_ADJ_OFFSET      0x000001D8U /**< 1588 nanosecond
@@ -301,8 +311,14 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 							reg */
 #define XEMACPS_RXQ1BASE_OFFSET	     0x00000480U /**< RX Q1 Base address
 							reg */
+#define XEMACPS_RXQ1BUFSIZE_OFFSET   0x000004A0U /**< RX Q1 DMA buffer size
+							reg */
 #define XEMACPS_MSBBUF_TXQBASE_OFFSET  0x000004C8U /**< MSB Buffer TX Q Base
 							reg */
+#define XEMACPS_TXBDCTRL_OFFSET      0x000004CCU /**< TX BD timestamp
+							control reg */
+#define XEMACPS_RXBDCTRL_OFFSET      0x000004D0U /**< RX BD timestamp
+							control reg */
 #define XEMACPS_MSBBUF_RXQBASE_OFFSET  0x000004D4U /**< MSB Buffer RX Q Base
 							reg */
 #define XEMACPS_INTQ1_IER_OFFSET     0x00000600U /**< Interrupt Q1 Enable
@@ -312,6 +328,19 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_INTQ1_IMR_OFFSET     0x00000640U /**< Interrupt Q1 Mask
 							reg */
 
+#define XEMACPS_DCFG8_OFFSET         0x0000029CU /**< Design config 8 reg,
+							screener counts */
+#define XEMACPS_SCRT1_OFFSET         0x00000500U /**< Type 1 screener 0 reg,
+							4 bytes apart */
+#define XEMACPS_SCRT2_OFFSET         0x00000540U /**< Type 2 screener 0 reg,
+							4 bytes apart */
+#define XEMACPS_SCRETHT_OFFSET       0x000006E0U /**< Screener ethertype 0
+							reg, 4 bytes apart */
+#define XEMACPS_SCRCMPW0_OFFSET      0x00000700U /**< Screener compare 0
+							word 0, 8 bytes apart */
+#define XEMACPS_SCRCMPW1_OFFSET      0x00000704U /**< Screener compare 0
+							word 1, 8 bytes apart */
+
 /* Define some bit positions for registers. */
 
 /** @name network control register bit definitions
@@ -465,10 +494,90 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
  */
 #define XEMACPS_INTQ1SR_TXCOMPL_MASK	0x00000080U /**< Transmit completed OK */
 #define XEMACPS_INTQ1SR_TXERR_MASK	0x00000040U /**< Transmit AMBA Error */
+#define XEMACPS_INTQ1SR_RXUSED_MASK	0x00000004U /**< Rx buffer used bit read */
+#define XEMACPS_INTQ1SR_RXCOMPL_MASK	0x00000002U /**< Frame received OK */
 
-#define XEMACPS_INTQ1_IXR_ALL_MASK	((u32)XEMACPS_INTQ1SR_TXCOMPL_MASK | \
+#define XEMACPS_INTQ1_IXR_TX_MASK	((u32)XEMACPS_INTQ1SR_TXCOMPL_MASK | \
 					 (u32)XEMACPS_INTQ1SR_TXERR_MASK)
 
+#define XEMACPS_INTQ1_IXR_RX_MASK	((u32)XEMACPS_INTQ1SR_RXCOMPL_MASK | \
+					 (u32)XEMACPS_INTQ1SR_RXUSED_MASK)
+
+#define XEMACPS_INTQ1_IXR_ALL_MASK	((u32)XEMACPS_INTQ1_IXR_TX_MASK | \
+					 (u32)XEMACPS_INTQ1_IXR_RX_MASK)
+
+/*@}*/
+
+/**
+ * @name Design config 8 register bit definitions
+ * @{
+ */
+#define XEMACPS_DCFG8_T1SCR_MASK	0xFF000000U /**< Number of type 1
+							screeners */
+#define XEMACPS_DCFG8_T1SCR_SHIFT	24U
+#define XEMACPS_DCFG8_T2SCR_MASK	0x00FF0000U /**< Number of type 2
+							screeners */
+#define XEMACPS_DCFG8_T2SCR_SHIFT	16U
+#define XEMACPS_DCFG8_SCRETH_MASK	0x0000FF00U /**< Number of ethertype
+							registers */
+#define XEMACPS_DCFG8_SCRETH_SHIFT	8U
+#define XEMACPS_DCFG8_SCRCMP_MASK	0x000000FFU /**< Number of compare
+							registers */
+/*@}*/
+
+/**
+ * @name Type 1 screener register bit definitions
+ * @{
+ */
+#define XEMACPS_SCRT1_QUEUE_MASK	0x0000000FU /**< Target RX queue */
+#define XEMACPS_SCRT1_DSTC_MASK		0x00000FF0U /**< DS/TC field to match */
+#define XEMACPS_SCRT1_DSTC_SHIFT	4U
+#define XEMACPS_SCRT1_UDP_MASK		0x0FFFF000U /**< UDP dest port to match */
+#define XEMACPS_SCRT1_UDP_SHIFT		12U
+#define XEMACPS_SCRT1_DSTCEN_MASK	0x10000000U /**< Enable DS/TC match */
+#define XEMACPS_SCRT1_UDPEN_MASK	0x20000000U /**< Enable UDP port match */
+/*@}*/
+
+/**
+ * @name Type 2 screener register bit definitions
+ * @{
+ */
+#define XEMACPS_SCRT2_QUEUE_MASK	0x0000000FU /**< Target RX queue */
+#define XEMACPS_SCRT2_VLANPR_MASK	0x00000070U /**< VLAN priority to match */
+#define XEMACPS_SCRT2_VLANPR_SHIFT	4U
+#define XEMACPS_SCRT2_VLANEN_MASK	0x00000100U /**< Enable VLAN match */
+#define XEMACPS_SCRT2_ETHT_MASK		0x00000E00U /**< Ethertype reg index */
+#define XEMACPS_SCRT2_ETHT_SHIFT	9U
+#define XEMACPS_SCRT2_ETHTEN_MASK	0x00001000U /**< Enable ethertype match */
+#define XEMACPS_SCRT2_CMPA_MASK		0x0003E000U /**< Compare A reg index */
+#define XEMACPS_SCRT2_CMPA_SHIFT	13U
+#define XEMACPS_SCRT2_CMPAEN_MASK	0x00040000U /**< Enable compare A */
+#define XEMACPS_SCRT2_CMPB_MASK		0x00F80000U /**< Compare B reg index */
+#define XEMACPS_SCRT2_CMPB_SHIFT	19U
+#define XEMACPS_SCRT2_CMPBEN_MASK	0x01000000U /**< Enable compare B */
+#define XEMACPS_SCRT2_CMPC_MASK		0x3E000000U /**< Compare C reg index */
+#define XEMACPS_SCRT2_CMPC_SHIFT	25U
+#define XEMACPS_SCRT2_CMPCEN_MASK	0x40000000U /**< Enable compare C */
+/*@}*/
+
+/**
+ * @name Screener compare register bit definitions
+ * @{
+ */
+#define XEMACPS_SCRCMPW0_MASK_MASK	0x0000FFFFU /**< Compare mask */
+#define XEMACPS_SCRCMPW0_VAL_MASK	0xFFFF0000U /**< Compare value */
+#define XEMACPS_SCRCMPW0_VAL_SHIFT	16U
+#define XEMACPS_SCRCMPW1_OFST_MASK	0x0000007FU /**< Byte offset of the
+							compared half word */
+#define XEMACPS_SCRCMPW1_OFSTTYPE_MASK	0x00000180U /**< Offset reference */
+#define XEMACPS_SCRCMPW1_OFSTTYPE_SHIFT	7U
+
+#define XEMACPS_SCRCMP_OFST_FRAME	0U /**< Offset from start of frame */
+#define XEMACPS_SCRCMP_OFST_ETYPE	1U /**< Offset from after ethertype */
+#define XEMACPS_SCRCMP_OFST_IPHDR	2U /**< Offset from after IP header */
+#define XEMACPS_SCRCMP_OFST_L4HDR	3U /**< Offset from after TCP/UDP
+							header */
+
 /*@}*/
 
 /**
@@ -536,6 +645,27 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_RXWM_LOW_SHFT_MSK	16U	/**< Shift for RXWM low */
 /*@}*/
 
+/** @name 1588 timer adjust, increment and BD timestamp control registers
+ * @{
+ */
+#define XEMACPS_1588_ADJ_SUB_MASK	0x80000000U /**< Subtract the value */
+#define XEMACPS_1588_ADJ_NS_MASK	0x3FFFFFFFU /**< Nanoseconds to add or
+							subtract */
+#define XEMACPS_1588_INC_NS_MASK	0x000000FFU /**< Nanoseconds per TSU
+							clock */
+#define XEMACPS_1588_SUBNS_MSB_MASK	0x0000FFFFU /**< Sub-ns bits 23:8 */
+#define XEMACPS_1588_SUBNS_LSB_SHIFT	24U	    /**< Sub-ns bits 7:0 */
+#define XEMACPS_1588_SEC_MSB_MASK	0x0000FFFFU /**< Seconds 47:32 */
+
+#define XEMACPS_BDCTRL_TSMODE_MASK	0x00000030U /**< Frames timestamped
+							in their BD */
+#define XEMACPS_BDCTRL_TSMODE_SHIFT	4U
+#define XEMACPS_TS_MODE_NONE		0U /**< No BD timestamps */
+#define XEMACPS_TS_MODE_PTP_EVENT	1U /**< PTP event frames only */
+#define XEMACPS_TS_MODE_PTP_ALL		2U /**< All PTP frames */
+#define XEMACPS_TS_MODE_ALL		3U /**< All frames */
+/*@}*/
+
 /* Transmit buffer descriptor status words offset
  * @{
  */
@@ -543,6 +673,14 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_BD_STAT_OFFSET  0x00000004U /**< word 1/status of BDs */
 #define XEMACPS_BD_ADDR_HI_OFFSET  0x00000008U /**< word 2/addr of BDs */
 
+/* Timestamp words of extended BDs: nanoseconds and seconds 1:0 in the first
+ * word, seconds 5:2 in the second one.
+ */
+#define XEMACPS_BD_TS_NSEC_MASK	0x3FFFFFFFU /**< Nanoseconds */
+#define XEMACPS_BD_TS_SECL_SHIFT	30U	    /**< Seconds 1:0 */
+#define XEMACPS_BD_TS_SECH_MASK	0x0000000FU /**< Seconds 5:2 */
+#define XEMACPS_BD_TS_SEC_MASK	0x0000003FU /**< Seconds kept in a BD */
+
 /*
  * @}
  */
@@ -563,6 +701,8 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_TXBUF_EXH_MASK   0x08000000U /**< Buffers exhausted */
 #define XEMACPS_TXBUF_TCP_MASK   0x04000000U /**< Late collision. */
 #define XEMACPS_TXBUF_NOCRC_MASK 0x00010000U /**< No CRC */
+#define XEMACPS_TXBUF_TS_VALID_MASK 0x00800000U /**< Timestamp captured,
+						      extended BDs only */
 #define XEMACPS_TXBUF_LAST_MASK  0x00008000U /**< Last buffer */
 #define XEMACPS_TXBUF_LEN_MASK   0x00003FFFU /**< Mask for length field */
 /*
@@ -597,6 +737,8 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_RXBUF_LEN_MASK       0x00001FFFU /**< Mask for length field */
 #define XEMACPS_RXBUF_LEN_JUMBO_MASK 0x00003FFFU /**< Mask for jumbo length */
 
+#define XEMACPS_RXBUF_TS_VALID_MASK  0x00000004U /**< Timestamp captured,
+						      extended BDs only */
 #define XEMACPS_RXBUF_WRAP_MASK      0x00000002U /**< Wrap bit, last BD */
 #define XEMACPS_RXBUF_NEW_MASK       0x00000001U /**< Used bit.. */
 #define XEMACPS_RXBUF_ADD_MASK       0xFFFFFFFCU /**< Mask for address */
@@ -53,6 +53,8 @@
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.1   hk   07/27/15 Do not call error handler with '0' error code when
 *                     there is no error. CR# 869403
+* 3.10  hk   06/12/19 Add receive handler and RX used bit handling for
+*                     priority queue 1.
 * </pre>
 ******************************************************************************/
 
@@ -81,8 +83,8 @@
  *
  * @param InstancePtr is a pointer to the instance to be worked on.
  * @param HandlerType indicates what interrupt handler type is.
- *        XEMACPS_HANDLER_DMASEND, XEMACPS_HANDLER_DMARECV and
- *        XEMACPS_HANDLER_ERROR.
+ *        XEMACPS_HANDLER_DMASEND, XEMACPS_HANDLER_DMARECV,
+ *        XEMACPS_HANDLER_DMARECVQ1 and XEMACPS_HANDLER_ERROR.
  * @param FuncPointer is the pointer to the callback function
  * @param CallBackRef is the upper layer callback reference passed back when
  *        when the callback function is invoked.
@@ -115,6 +117,11 @@ LONG XEmacPs_SetHandler(XEmacPs *InstancePtr, u32 HandlerType,
 		InstancePtr->RecvHandler = ((XEmacPs_Handler)(void *)FuncPointer);
 		InstancePtr->RecvRef = CallBackRef;
 		break;
+	case XEMACPS_HANDLER_DMARECVQ1:
+		Status = (LONG)(XST_SUCCESS);
+		InstancePtr->RecvQ1Handler = ((XEmacPs_Handler)(void *)FuncPointer);
+		InstancePtr->RecvQ1Ref = CallBackRef;
+		break;
 	case XEMACPS_HANDLER_ERROR:
 		Status = (LONG)(XST_SUCCESS);
 		InstancePtr->ErrorHandler = ((XEmacPs_ErrHandler)(void *)FuncPointer);
@@ -179,6 +186,22 @@ void XEmacPs_IntrHandler(void *XEmacPsPtr)
 		InstancePtr->RecvHandler(InstancePtr->RecvRef);
 	}
 
+	/* Receive Q1 complete interrupt */
+	if ((InstancePtr->Version > 2) &&
+			(InstancePtr->RxBdRingQ1.BaseBdAddr != 0U) &&
+			((RegQ1ISR & XEMACPS_INTQ1SR_RXCOMPL_MASK) != 0x00000000U)) {
+		/* Clear RX status register RX complete indication but preserve
+		 * error bits if there is any */
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				   XEMACPS_INTQ1_STS_OFFSET,
+				   XEMACPS_INTQ1SR_RXCOMPL_MASK);
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				   XEMACPS_RXSR_OFFSET,
+				   ((u32)XEMACPS_RXSR_FRAMERX_MASK |
+				   (u32)XEMACPS_RXSR_BUFFNA_MASK));
+		InstancePtr->RecvQ1Handler(InstancePtr->RecvQ1Ref);
+	}
+
 	/* Transmit Q1 complete interrupt */
 	if ((InstancePtr->Version > 2) &&
 			((RegQ1ISR & XEMACPS_INTQ1SR_TXCOMPL_MASK) != 0x00000000U)) {
@@ -246,6 +269,22 @@ void XEmacPs_IntrHandler(void *XEmacPsPtr)
 					  RegQ1ISR);
 	   }
 
+	/* Receive Q1 buffer not available. The frame is dropped by the
+	 * controller; report it so that the ring can be replenished.
+	 */
+	if ((InstancePtr->Version > 2) &&
+			(InstancePtr->RxBdRingQ1.BaseBdAddr != 0U) &&
+			((RegQ1ISR & XEMACPS_INTQ1SR_RXUSED_MASK) != 0x00000000U)) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				   XEMACPS_INTQ1_STS_OFFSET,
+				   XEMACPS_INTQ1SR_RXUSED_MASK);
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				   XEMACPS_RXSR_OFFSET,
+				   (u32)XEMACPS_RXSR_BUFFNA_MASK);
+		InstancePtr->ErrorHandler(InstancePtr->ErrorRef, XEMACPS_RECV,
+					  XEMACPS_RXSR_BUFFNA_MASK);
+	}
+
 	/* Transmit error conditions interrupt */
         if (((RegISR & XEMACPS_IXR_TX_ERR_MASK) != 0x00000000U) &&
             (!(RegISR & XEMACPS_IXR_TXCOMPL_MASK) != 0x00000000U)) {
@@ -0,0 +1,381 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xemacps_screen.c
+* @addtogroup emacps_v3_10
+* @{
+ *
+ * Functions in this file program the GEM RX queue screeners. Type 1
+ * screeners match the IP DS/TC field and/or the UDP destination port; type 2
+ * screeners match the VLAN priority, an ethertype register and up to three
+ * compare registers. A frame that matches an enabled screener is written to
+ * the RX priority queue named in that screener, all other frames go to queue
+ * 0. Screeners are only present on GEM versions later than 2 (Zynq
+ * Ultrascale+ MPSoC); the number of each kind is read from the design
+ * configuration registers. See xemacps.h for a detailed description of the
+ * driver.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 3.10  hk   06/12/19 First release
+ * </pre>
+ *****************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xemacps.h"
+
+/************************** Constant Definitions *****************************/
+
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+
+/************************** Function Prototypes ******************************/
+
+
+/************************** Variable Definitions *****************************/
+
+
+/*****************************************************************************/
+/**
+ * Get the number of screening resources implemented in the controller.
+ * All counts are returned as 0 on controllers without screeners.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Type1Count is the returned number of type 1 screeners.
+ * @param Type2Count is the returned number of type 2 screeners.
+ * @param EthTypeCount is the returned number of ethertype registers.
+ * @param CompareCount is the returned number of compare registers.
+ *
+ *****************************************************************************/
+void XEmacPs_GetScreenerCount(XEmacPs *InstancePtr, u8 *Type1Count,
+			      u8 *Type2Count, u8 *EthTypeCount,
+			      u8 *CompareCount)
+{
+	u32 Reg = 0U;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Type1Count != NULL);
+	Xil_AssertVoid(Type2Count != NULL);
+	Xil_AssertVoid(EthTypeCount != NULL);
+	Xil_AssertVoid(CompareCount != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->Version > 2) {
+		Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+				      XEMACPS_DCFG8_OFFSET);
+	}
+
+	*Type1Count = (u8)((Reg & XEMACPS_DCFG8_T1SCR_MASK) >>
+			   XEMACPS_DCFG8_T1SCR_SHIFT);
+	*Type2Count = (u8)((Reg & XEMACPS_DCFG8_T2SCR_MASK) >>
+			   XEMACPS_DCFG8_T2SCR_SHIFT);
+	*EthTypeCount = (u8)((Reg & XEMACPS_DCFG8_SCRETH_MASK) >>
+			     XEMACPS_DCFG8_SCRETH_SHIFT);
+	*CompareCount = (u8)(Reg & XEMACPS_DCFG8_SCRCMP_MASK);
+}
+
+/*****************************************************************************/
+/**
+ * Program a type 1 screener. A frame matches when all enabled fields match;
+ * a screener with no field enabled is disabled.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the type 1 screener to program.
+ * @param QueueNum is the RX queue matching frames are written to.
+ * @param Enable is a bit mask of XEMACPS_SCRT1_DSTCEN_MASK and
+ *        XEMACPS_SCRT1_UDPEN_MASK selecting the fields to match.
+ * @param DsTc is the IPv4 DS or IPv6 traffic class field to match.
+ * @param UdpPort is the UDP destination port to match.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was programmed
+ * - XST_NO_FEATURE if the controller has no screeners
+ * - XST_INVALID_PARAM if Index or QueueNum is out of range
+ *
+ * @note
+ * Screeners may be reprogrammed while the device is started. Frames already
+ * in the RX packet buffer are steered with the old setting.
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetType1Screen(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+			    u32 Enable, u8 DsTc, u16 UdpPort)
+{
+	u8 T1Count, T2Count, EthCount, CmpCount;
+	u32 Reg;
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid((Enable & ~((u32)XEMACPS_SCRT1_DSTCEN_MASK |
+			  (u32)XEMACPS_SCRT1_UDPEN_MASK)) == 0x00000000U);
+
+	XEmacPs_GetScreenerCount(InstancePtr, &T1Count, &T2Count, &EthCount,
+				 &CmpCount);
+
+	if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else if ((Index >= T1Count) || (QueueNum >= XEMACPS_MAX_RXQUEUES)) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		Reg = ((u32)QueueNum & XEMACPS_SCRT1_QUEUE_MASK) |
+		      (((u32)DsTc << XEMACPS_SCRT1_DSTC_SHIFT) &
+		       XEMACPS_SCRT1_DSTC_MASK) |
+		      (((u32)UdpPort << XEMACPS_SCRT1_UDP_SHIFT) &
+		       XEMACPS_SCRT1_UDP_MASK) |
+		      Enable;
+
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT1_OFFSET + ((u32)Index * (u32)4)),
+			Reg);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Program a type 2 screener. A frame matches when all enabled fields match;
+ * a screener with no field enabled is disabled. The ethertype and compare
+ * registers referenced here are programmed with XEmacPs_SetScreenEthType()
+ * and XEmacPs_SetScreenCompare().
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the type 2 screener to program.
+ * @param QueueNum is the RX queue matching frames are written to.
+ * @param Enable is a bit mask of XEMACPS_SCRT2_VLANEN_MASK,
+ *        XEMACPS_SCRT2_ETHTEN_MASK, XEMACPS_SCRT2_CMPAEN_MASK,
+ *        XEMACPS_SCRT2_CMPBEN_MASK and XEMACPS_SCRT2_CMPCEN_MASK selecting
+ *        the fields to match.
+ * @param VlanPriority is the VLAN priority to match.
+ * @param EthTypeIndex is the ethertype register to match against.
+ * @param CompareA is the first compare register to match against.
+ * @param CompareB is the second compare register to match against.
+ * @param CompareC is the third compare register to match against.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was programmed
+ * - XST_NO_FEATURE if the controller has no screeners
+ * - XST_INVALID_PARAM if an index or QueueNum is out of range
+ *
+ * @note
+ * Screeners may be reprogrammed while the device is started. Frames already
+ * in the RX packet buffer are steered with the old setting.
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetType2Screen(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+			    u32 Enable, u8 VlanPriority, u8 EthTypeIndex,
+			    u8 CompareA, u8 CompareB, u8 CompareC)
+{
+	u8 T1Count, T2Count, EthCount, CmpCount;
+	u32 Reg;
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid((Enable & ~((u32)XEMACPS_SCRT2_VLANEN_MASK |
+			  (u32)XEMACPS_SCRT2_ETHTEN_MASK |
+			  (u32)XEMACPS_SCRT2_CMPAEN_MASK |
+			  (u32)XEMACPS_SCRT2_CMPBEN_MASK |
+			  (u32)XEMACPS_SCRT2_CMPCEN_MASK)) == 0x00000000U);
+
+	XEmacPs_GetScreenerCount(InstancePtr, &T1Count, &T2Count, &EthCount,
+				 &CmpCount);
+
+	if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else if ((Index >= T2Count) || (QueueNum >= XEMACPS_MAX_RXQUEUES) ||
+		   (VlanPriority > 7U) ||
+		   (((Enable & XEMACPS_SCRT2_ETHTEN_MASK) != 0x00000000U) &&
+		    (EthTypeIndex >= EthCount)) ||
+		   (((Enable & XEMACPS_SCRT2_CMPAEN_MASK) != 0x00000000U) &&
+		    (CompareA >= CmpCount)) ||
+		   (((Enable & XEMACPS_SCRT2_CMPBEN_MASK) != 0x00000000U) &&
+		    (CompareB >= CmpCount)) ||
+		   (((Enable & XEMACPS_SCRT2_CMPCEN_MASK) != 0x00000000U) &&
+		    (CompareC >= CmpCount))) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		Reg = ((u32)QueueNum & XEMACPS_SCRT2_QUEUE_MASK) |
+		      (((u32)VlanPriority << XEMACPS_SCRT2_VLANPR_SHIFT) &
+		       XEMACPS_SCRT2_VLANPR_MASK) |
+		      (((u32)EthTypeIndex << XEMACPS_SCRT2_ETHT_SHIFT) &
+		       XEMACPS_SCRT2_ETHT_MASK) |
+		      (((u32)CompareA << XEMACPS_SCRT2_CMPA_SHIFT) &
+		       XEMACPS_SCRT2_CMPA_MASK) |
+		      (((u32)CompareB << XEMACPS_SCRT2_CMPB_SHIFT) &
+		       XEMACPS_SCRT2_CMPB_MASK) |
+		      (((u32)CompareC << XEMACPS_SCRT2_CMPC_SHIFT) &
+		       XEMACPS_SCRT2_CMPC_MASK) |
+		      Enable;
+
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT2_OFFSET + ((u32)Index * (u32)4)),
+			Reg);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Program a screener ethertype register used by type 2 screeners.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the ethertype register to program.
+ * @param EthType is the ethertype to match, e.g. 0x88F7 for PTP.
+ *
+ * @return
+ * - XST_SUCCESS if the register was programmed
+ * - XST_NO_FEATURE if the controller has no screeners
+ * - XST_INVALID_PARAM if Index is out of range
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenEthType(XEmacPs *InstancePtr, u8 Index, u16 EthType)
+{
+	u8 T1Count, T2Count, EthCount, CmpCount;
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	XEmacPs_GetScreenerCount(InstancePtr, &T1Count, &T2Count, &EthCount,
+				 &CmpCount);
+
+	if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else if (Index >= EthCount) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRETHT_OFFSET + ((u32)Index * (u32)4)),
+			(u32)EthType);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Program a screener compare register used by type 2 screeners. The
+ * compare matches when the 16 bit big endian half word at the given offset,
+ * ANDed with Mask, equals Value ANDed with Mask.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the compare register to program.
+ * @param Value is the half word value to compare against.
+ * @param Mask selects the bits of the half word that are compared.
+ * @param OffsetType is the header the offset is relative to, one of
+ *        XEMACPS_SCRCMP_OFST_FRAME, XEMACPS_SCRCMP_OFST_ETYPE,
+ *        XEMACPS_SCRCMP_OFST_IPHDR or XEMACPS_SCRCMP_OFST_L4HDR.
+ * @param Offset is the byte offset of the half word (0-127).
+ *
+ * @return
+ * - XST_SUCCESS if the register was programmed
+ * - XST_NO_FEATURE if the controller has no screeners
+ * - XST_INVALID_PARAM if Index is out of range
+ *
+ * @note
+ * For example, to steer TCP traffic to destination port 5001 use
+ * OffsetType XEMACPS_SCRCMP_OFST_IPHDR, Offset 2, Value 5001, Mask 0xFFFF.
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenCompare(XEmacPs *InstancePtr, u8 Index, u16 Value,
+			      u16 Mask, u8 OffsetType, u8 Offset)
+{
+	u8 T1Count, T2Count, EthCount, CmpCount;
+	u32 RegOffset;
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(OffsetType <= XEMACPS_SCRCMP_OFST_L4HDR);
+	Xil_AssertNonvoid(Offset <= XEMACPS_SCRCMPW1_OFST_MASK);
+
+	XEmacPs_GetScreenerCount(InstancePtr, &T1Count, &T2Count, &EthCount,
+				 &CmpCount);
+
+	if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else if (Index >= CmpCount) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		RegOffset = (u32)Index * (u32)8;
+
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRCMPW0_OFFSET + RegOffset),
+			(((u32)Value << XEMACPS_SCRCMPW0_VAL_SHIFT) |
+			 (u32)Mask));
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRCMPW1_OFFSET + RegOffset),
+			((((u32)OffsetType << XEMACPS_SCRCMPW1_OFSTTYPE_SHIFT) &
+			  XEMACPS_SCRCMPW1_OFSTTYPE_MASK) |
+			 ((u32)Offset & XEMACPS_SCRCMPW1_OFST_MASK)));
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Disable all type 1 and type 2 screeners so that every received frame is
+ * written to queue 0. This is done by XEmacPs_Reset().
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ *
+ *****************************************************************************/
+void XEmacPs_ClearScreens(XEmacPs *InstancePtr)
+{
+	u8 T1Count, T2Count, EthCount, CmpCount;
+	u8 Index;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	XEmacPs_GetScreenerCount(InstancePtr, &T1Count, &T2Count, &EthCount,
+				 &CmpCount);
+
+	for (Index = 0U; Index < T1Count; Index++) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT1_OFFSET + ((u32)Index * (u32)4)),
+			0x00000000U);
+	}
+	for (Index = 0U; Index < T2Count; Index++) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT2_OFFSET + ((u32)Index * (u32)4)),
+			0x00000000U);
+	}
+}
+/** @} */
@@ -0,0 +1,500 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xemacps_tsu.c
+* @addtogroup emacps_v3_10
+* @{
+ *
+ * Functions in this file give access to the GEM timestamp unit (TSU): the
+ * 1588 timer, the timestamps the controller stores in extended BDs and a PI
+ * servo that steers the timer towards a master clock.
+ *
+ * BD timestamps are taken by the MAC when the frame crosses the MII, so they
+ * carry none of the interrupt and software latency of reading the PTP event
+ * registers. They require the driver to be built with the bd_timestamp
+ * parameter, which adds two timestamp words to every BD (see xemacps_bd.h),
+ * and a GEM version later than 2 (Zynq Ultrascale+ MPSoC, Versal). The
+ * timer functions work on all versions; Zynq-7000 has no sub-nanosecond
+ * increment, so its frequency can only be adjusted by whole nanoseconds per
+ * TSU clock. See xemacps.h for a detailed description of the driver.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 3.10  hk   07/08/19 First release
+ * </pre>
+ *****************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xemacps.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XEMACPS_NSEC_PER_SEC	1000000000LL
+
+/* Default PI servo settings */
+#define XEMACPS_SERVO_KP	45875	/* 0.7 in 16.16 */
+#define XEMACPS_SERVO_KI	19661	/* 0.3 in 16.16 */
+#define XEMACPS_SERVO_STEP_NS	20000U
+#define XEMACPS_SERVO_MAX_PPB	500000
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+
+/************************** Function Prototypes ******************************/
+
+static void XEmacPs_TsuSetIncrement(XEmacPs *InstancePtr, u64 Increment);
+
+/************************** Variable Definitions *****************************/
+
+
+/*****************************************************************************/
+/**
+ * Select the frames the controller timestamps in their BDs. A non zero mode
+ * switches the direction to extended BD mode, in which the controller writes
+ * the timestamp words of the BDs.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param TxMode is the transmit mode, one of XEMACPS_TS_MODE_NONE,
+ *        XEMACPS_TS_MODE_PTP_EVENT, XEMACPS_TS_MODE_PTP_ALL or
+ *        XEMACPS_TS_MODE_ALL.
+ * @param RxMode is the receive mode, one of the same values.
+ *
+ * @return
+ * - XST_SUCCESS if the modes were set
+ * - XST_DEVICE_IS_STARTED if the device has not yet been stopped
+ * - XST_NO_FEATURE if a mode other than XEMACPS_TS_MODE_NONE is requested
+ *   and the BDs have no timestamp words or the controller has no extended
+ *   BD mode
+ *
+ * @note
+ * XEmacPs_Reset() leaves extended BD mode, call this function after it and
+ * before the BD rings are handed to the hardware. Receive buffers must then
+ * be 8 byte aligned, as bit 2 of the BD address word holds the timestamp
+ * valid flag.
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetBdTimestampMode(XEmacPs *InstancePtr, u32 TxMode, u32 RxMode)
+{
+	u32 Reg;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(TxMode <= XEMACPS_TS_MODE_ALL);
+	Xil_AssertNonvoid(RxMode <= XEMACPS_TS_MODE_ALL);
+
+	if (InstancePtr->IsStarted == (u32)XIL_COMPONENT_IS_STARTED) {
+		return (LONG)(XST_DEVICE_IS_STARTED);
+	}
+	if (((TxMode | RxMode) != XEMACPS_TS_MODE_NONE) &&
+	    ((XEMACPS_BD_TS_WORDS == 0U) || (InstancePtr->Version <= 2))) {
+		return (LONG)(XST_NO_FEATURE);
+	}
+	if (InstancePtr->Version <= 2) {
+		return (LONG)(XST_SUCCESS);
+	}
+
+	Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+			      XEMACPS_DMACR_OFFSET);
+	Reg &= ~((u32)XEMACPS_DMACR_TXEXTEND_MASK |
+		 (u32)XEMACPS_DMACR_RXEXTEND_MASK);
+	if (TxMode != XEMACPS_TS_MODE_NONE) {
+		Reg |= (u32)XEMACPS_DMACR_TXEXTEND_MASK;
+	}
+	if (RxMode != XEMACPS_TS_MODE_NONE) {
+		Reg |= (u32)XEMACPS_DMACR_RXEXTEND_MASK;
+	}
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			 XEMACPS_DMACR_OFFSET, Reg);
+
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			 XEMACPS_TXBDCTRL_OFFSET,
+			 (TxMode << XEMACPS_BDCTRL_TSMODE_SHIFT) &
+			 XEMACPS_BDCTRL_TSMODE_MASK);
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			 XEMACPS_RXBDCTRL_OFFSET,
+			 (RxMode << XEMACPS_BDCTRL_TSMODE_SHIFT) &
+			 XEMACPS_BDCTRL_TSMODE_MASK);
+
+	return (LONG)(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+ * Get the timestamp the controller stored in the last BD of a frame. A BD
+ * holds the nanoseconds and the 6 least significant bits of the seconds, the
+ * other bits are taken from the 1588 timer, so the BD must be processed
+ * within 64 seconds of the frame.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param BdPtr is the last BD of a sent or received frame.
+ * @param Direction is XEMACPS_SEND or XEMACPS_RECV.
+ * @param TsPtr is the returned timestamp.
+ *
+ * @return
+ * - XST_SUCCESS if the BD holds a timestamp
+ * - XST_NO_DATA if it does not
+ *
+ *****************************************************************************/
+LONG XEmacPs_BdGetTimestamp(XEmacPs *InstancePtr, XEmacPs_Bd *BdPtr,
+			    u32 Direction, XEmacPs_Timestamp *TsPtr)
+{
+#if XEMACPS_BD_TS_WORDS
+	XEmacPs_Timestamp Now;
+	u32 Valid;
+	u32 Sec;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(BdPtr != NULL);
+	Xil_AssertNonvoid(TsPtr != NULL);
+	Xil_AssertNonvoid((Direction == XEMACPS_SEND) ||
+			  (Direction == XEMACPS_RECV));
+
+	if (Direction == XEMACPS_SEND) {
+		Valid = XEmacPs_BdIsTxTsValid(BdPtr);
+	} else {
+		Valid = XEmacPs_BdIsRxTsValid(BdPtr);
+	}
+	if (Valid == FALSE) {
+		return (LONG)(XST_NO_DATA);
+	}
+
+	Sec = XEmacPs_BdGetTsSec(BdPtr);
+	TsPtr->NanoSeconds = XEmacPs_BdGetTsNanoSec(BdPtr);
+
+	XEmacPs_TsuGetTime(InstancePtr, &Now);
+	TsPtr->Seconds = (Now.Seconds & ~(u64)XEMACPS_BD_TS_SEC_MASK) | Sec;
+	if (TsPtr->Seconds > Now.Seconds) {
+		/* the 6 bit seconds wrapped since the frame */
+		TsPtr->Seconds -= (u64)XEMACPS_BD_TS_SEC_MASK + 1U;
+	}
+
+	return (LONG)(XST_SUCCESS);
+#else
+	(void)InstancePtr;
+	(void)BdPtr;
+	(void)Direction;
+	(void)TsPtr;
+	return (LONG)(XST_NO_DATA);
+#endif
+}
+
+/*****************************************************************************/
+/**
+ * Start the 1588 timer at the rate of the TSU clock. The nominal increment
+ * is kept in the instance as the reference for XEmacPs_TsuAdjustFreq().
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param TsuClkFreqHz is the TSU clock frequency, usually
+ *        XPAR_XEMACPS_<n>_ENET_TSU_CLK_FREQ_HZ.
+ *
+ * @return
+ * - XST_SUCCESS if the timer was started
+ * - XST_INVALID_PARAM if the clock is too slow for the 8 bit nanosecond
+ *   increment
+ *
+ *****************************************************************************/
+LONG XEmacPs_TsuInit(XEmacPs *InstancePtr, u32 TsuClkFreqHz)
+{
+	u64 Increment;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(TsuClkFreqHz != 0U);
+
+	Increment = ((u64)XEMACPS_NSEC_PER_SEC << 24) / TsuClkFreqHz;
+	if ((Increment >> 24) > XEMACPS_1588_INC_NS_MASK) {
+		return (LONG)(XST_INVALID_PARAM);
+	}
+
+	InstancePtr->TsuIncrement = (u32)Increment;
+	XEmacPs_TsuSetIncrement(InstancePtr, Increment);
+
+	return (LONG)(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+ * Read the 1588 timer.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param TsPtr is the returned time.
+ *
+ *****************************************************************************/
+void XEmacPs_TsuGetTime(XEmacPs *InstancePtr, XEmacPs_Timestamp *TsPtr)
+{
+	u32 SecHi = 0U;
+	u32 SecLo;
+	u32 NanoSec;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(TsPtr != NULL);
+
+	/* read again if the seconds rolled over between the two reads */
+	do {
+		SecLo = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XEMACPS_1588_SEC_OFFSET);
+		NanoSec = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+					  XEMACPS_1588_NANOSEC_OFFSET);
+		if (InstancePtr->Version > 2) {
+			SecHi = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+						XEMACPS_1588_SEC_MSB_OFFSET) &
+				XEMACPS_1588_SEC_MSB_MASK;
+		}
+	} while (SecLo != XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+					  XEMACPS_1588_SEC_OFFSET));
+
+	TsPtr->Seconds = ((u64)SecHi << 32) | SecLo;
+	TsPtr->NanoSeconds = NanoSec;
+}
+
+/*****************************************************************************/
+/**
+ * Set the 1588 timer.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param TsPtr is the new time.
+ *
+ *****************************************************************************/
+void XEmacPs_TsuSetTime(XEmacPs *InstancePtr, XEmacPs_Timestamp *TsPtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(TsPtr != NULL);
+	Xil_AssertVoid(TsPtr->NanoSeconds < (u32)XEMACPS_NSEC_PER_SEC);
+
+	if (InstancePtr->Version > 2) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				 XEMACPS_1588_SEC_MSB_OFFSET,
+				 (u32)(TsPtr->Seconds >> 32) &
+				 XEMACPS_1588_SEC_MSB_MASK);
+	}
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			 XEMACPS_1588_SEC_OFFSET, (u32)TsPtr->Seconds);
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			 XEMACPS_1588_NANOSEC_OFFSET, TsPtr->NanoSeconds);
+}
+
+/*****************************************************************************/
+/**
+ * Shift the 1588 timer by an offset. Offsets of less than a second are
+ * applied atomically by the adjust register, larger ones read, modify and
+ * write the timer.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param OffsetNs is the number of nanoseconds to add, negative to
+ *        subtract.
+ *
+ *****************************************************************************/
+void XEmacPs_TsuAdjustTime(XEmacPs *InstancePtr, s64 OffsetNs)
+{
+	XEmacPs_Timestamp Ts;
+	s64 Sec;
+	s64 NanoSec;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if ((OffsetNs > -XEMACPS_NSEC_PER_SEC) &&
+	    (OffsetNs < XEMACPS_NSEC_PER_SEC)) {
+		if (OffsetNs < 0) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+					 XEMACPS_1588_ADJ_OFFSET,
+					 XEMACPS_1588_ADJ_SUB_MASK |
+					 ((u32)(-OffsetNs) &
+					  XEMACPS_1588_ADJ_NS_MASK));
+		} else {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+					 XEMACPS_1588_ADJ_OFFSET,
+					 (u32)OffsetNs &
+					 XEMACPS_1588_ADJ_NS_MASK);
+		}
+		return;
+	}
+
+	XEmacPs_TsuGetTime(InstancePtr, &Ts);
+	Sec = (s64)Ts.Seconds + (OffsetNs / XEMACPS_NSEC_PER_SEC);
+	NanoSec = (s64)Ts.NanoSeconds + (OffsetNs % XEMACPS_NSEC_PER_SEC);
+	if (NanoSec < 0) {
+		NanoSec += XEMACPS_NSEC_PER_SEC;
+		Sec--;
+	} else if (NanoSec >= XEMACPS_NSEC_PER_SEC) {
+		NanoSec -= XEMACPS_NSEC_PER_SEC;
+		Sec++;
+	}
+	Ts.Seconds = (Sec < 0) ? 0U : (u64)Sec;
+	Ts.NanoSeconds = (u32)NanoSec;
+	XEmacPs_TsuSetTime(InstancePtr, &Ts);
+}
+
+/*****************************************************************************/
+/**
+ * Run the 1588 timer faster or slower than the TSU clock by changing its
+ * increment.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Ppb is the frequency offset in parts per billion, positive to run
+ *        faster.
+ *
+ * @return
+ * - XST_SUCCESS if the increment was changed
+ * - XST_FAILURE if XEmacPs_TsuInit() was not called
+ *
+ *****************************************************************************/
+LONG XEmacPs_TsuAdjustFreq(XEmacPs *InstancePtr, s32 Ppb)
+{
+	s64 Increment;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((Ppb > -XEMACPS_NSEC_PER_SEC) &&
+			  (Ppb < XEMACPS_NSEC_PER_SEC));
+
+	if (InstancePtr->TsuIncrement == 0U) {
+		return (LONG)(XST_FAILURE);
+	}
+
+	Increment = (s64)InstancePtr->TsuIncrement;
+	Increment += (Increment * Ppb) / XEMACPS_NSEC_PER_SEC;
+	XEmacPs_TsuSetIncrement(InstancePtr, (u64)Increment);
+
+	return (LONG)(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+ * Initialize a PI servo with gains of 0.7 and 0.3, a 20 us step threshold
+ * and a 500 ppm frequency limit. The fields may be changed afterwards.
+ *
+ * @param ServoPtr is the servo to initialize.
+ * @param IntervalMs is the time between two offset samples, usually the
+ *        PTP sync interval.
+ *
+ *****************************************************************************/
+void XEmacPs_TsuServoInit(XEmacPs_TsuServo *ServoPtr, u32 IntervalMs)
+{
+	Xil_AssertVoid(ServoPtr != NULL);
+	Xil_AssertVoid(IntervalMs != 0U);
+
+	ServoPtr->Kp = XEMACPS_SERVO_KP;
+	ServoPtr->Ki = XEMACPS_SERVO_KI;
+	ServoPtr->IntervalMs = IntervalMs;
+	ServoPtr->StepThresholdNs = XEMACPS_SERVO_STEP_NS;
+	ServoPtr->MaxPpb = XEMACPS_SERVO_MAX_PPB;
+	ServoPtr->Integral = 0;
+	ServoPtr->Ppb = 0;
+	ServoPtr->Locked = 0U;
+}
+
+/*****************************************************************************/
+/**
+ * Feed one offset from the master clock to the servo. Until the servo is
+ * locked an offset above the step threshold steps the timer, after that
+ * every offset only adjusts the timer frequency.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param ServoPtr is the servo.
+ * @param OffsetNs is the local time minus the master time.
+ *
+ * @return
+ * - XEMACPS_SERVO_STEPPED if the timer was stepped
+ * - XEMACPS_SERVO_LOCKED if its frequency was adjusted
+ *
+ *****************************************************************************/
+u32 XEmacPs_TsuServoSample(XEmacPs *InstancePtr, XEmacPs_TsuServo *ServoPtr,
+			   s64 OffsetNs)
+{
+	s64 AbsOffset;
+	s64 Error;
+	s64 Ppb;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(ServoPtr != NULL);
+
+	AbsOffset = (OffsetNs < 0) ? -OffsetNs : OffsetNs;
+	if ((ServoPtr->Locked == 0U) &&
+	    (AbsOffset > (s64)ServoPtr->StepThresholdNs)) {
+		XEmacPs_TsuAdjustTime(InstancePtr, -OffsetNs);
+		ServoPtr->Locked = 1U;
+		return XEMACPS_SERVO_STEPPED;
+	}
+	ServoPtr->Locked = 1U;
+
+	/* offset over one interval as a frequency error in ppb */
+	Error = (OffsetNs * 1000) / (s64)ServoPtr->IntervalMs;
+
+	ServoPtr->Integral += (Error * ServoPtr->Ki) / 65536;
+	if (ServoPtr->Integral > ServoPtr->MaxPpb) {
+		ServoPtr->Integral = ServoPtr->MaxPpb;
+	} else if (ServoPtr->Integral < -ServoPtr->MaxPpb) {
+		ServoPtr->Integral = -ServoPtr->MaxPpb;
+	}
+
+	Ppb = -(((Error * ServoPtr->Kp) / 65536) + ServoPtr->Integral);
+	if (Ppb > ServoPtr->MaxPpb) {
+		Ppb = ServoPtr->MaxPpb;
+	} else if (Ppb < -ServoPtr->MaxPpb) {
+		Ppb = -ServoPtr->MaxPpb;
+	}
+
+	ServoPtr->Ppb = (s32)Ppb;
+	(void)XEmacPs_TsuAdjustFreq(InstancePtr, ServoPtr->Ppb);
+
+	return XEMACPS_SERVO_LOCKED;
+}
+
+/*****************************************************************************/
+/**
+ * Write the 1588 timer increment, in nanoseconds per TSU clock in 8.24
+ * fixed point. The sub-nanosecond part is only kept on GEM versions later
+ * than 2.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Increment is the new increment.
+ *
+ *****************************************************************************/
+static void XEmacPs_TsuSetIncrement(XEmacPs *InstancePtr, u64 Increment)
+{
+	u32 SubNs = (u32)Increment & 0x00FFFFFFU;
+
+	/* the sub-ns part is applied with the next write of the ns part */
+	if (InstancePtr->Version > 2) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				 XEMACPS_1588_SUBNS_INC_OFFSET,
+				 ((SubNs >> 8) & XEMACPS_1588_SUBNS_MSB_MASK) |
+				 ((SubNs & 0xFFU) <<
+				  XEMACPS_1588_SUBNS_LSB_SHIFT));
+	}
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			 XEMACPS_1588_INC_OFFSET,
+			 (u32)(Increment >> 24) & XEMACPS_1588_INC_NS_MASK);
+}
+/** @} */
@@ -54,6 +54,7 @@
 *                     as Pointer to const,Casting operation to a pointer,
 *                     Literal value requires a U suffix.
 * 3.5   sne  03/13/19 Added Versal support.
+* 3.6   adk  10/15/19 Added XGpioPs_WriteMasked and XGpioPs_WriteBanks.
 * </pre>
 *
 ******************************************************************************/
@@ -110,6 +111,7 @@ s32 XGpioPs_CfgInitialize(XGpioPs *InstancePtr, const XGpioPs_Config *ConfigPtr,
 	InstancePtr->GpioConfig.BaseAddr = EffectiveAddr;
 	InstancePtr->GpioConfig.DeviceId = ConfigPtr->DeviceId;
 	InstancePtr->Handler = (XGpioPs_Handler)StubHandler;
+	InstancePtr->EventFilter = NULL;
 	InstancePtr->Platform = XGetPlatform_Info();
 
 	/* Initialize the Bank data based on platform */
@@ -307,6 +309,99 @@ void XGpioPs_Write(const XGpioPs *InstancePtr, u8 Bank, u32 Data)
 			  XGPIOPS_DATA_OFFSET, Data);
 }
 
+/****************************************************************************/
+/**
+*
+* Write the pins selected by Mask in the specified GPIO bank, through the
+* MASK_DATA registers. The other pins of the bank keep their state, there is
+* no read-modify-write of the Data register, so the update does not race
+* with other writers of the bank.
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+* @param	Bank is the bank number of the GPIO to operate on.
+*		Valid values are 0-3 in Zynq and 0-5 in Zynq Ultrascale+ MP.
+* @param	Mask selects the pins of the bank to write, bit 0 is the first
+*		pin of the bank.
+* @param	Data is the value of the pins selected by Mask.
+*
+* @return	None.
+*
+* @note		Each half of the bank is written at once by one register
+*		write. A half without pins in Mask is not written, so a Mask
+*		within pins 0-15 or within pins 16-31 is a single write.
+*
+*****************************************************************************/
+void XGpioPs_WriteMasked(const XGpioPs *InstancePtr, u8 Bank, u32 Mask,
+			 u32 Data)
+{
+	u32 RegAddr;
+	u32 HalfMask;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(Bank < InstancePtr->MaxBanks);
+#ifdef versal
+	if(InstancePtr->PmcGpio == TRUE) {
+		Xil_AssertVoid(Bank != XGPIOPS_TWO);
+	} else {
+		Xil_AssertVoid((Bank !=XGPIOPS_ONE) && (Bank !=XGPIOPS_TWO));
+	}
+#endif
+
+	RegAddr = InstancePtr->GpioConfig.BaseAddr +
+			((u32)(Bank) * XGPIOPS_DATA_MASK_OFFSET);
+
+	/*
+	 * The upper 16 bits of the Mask/Data registers are the mask, a pin is
+	 * written when its mask bit is 0.
+	 */
+	HalfMask = Mask & 0xFFFFU;
+	if (HalfMask != (u32)0) {
+		XGpioPs_WriteReg(RegAddr, XGPIOPS_DATA_LSW_OFFSET,
+				 ((~HalfMask & 0xFFFFU) << 16U) |
+				 (Data & HalfMask));
+	}
+
+	HalfMask = Mask >> 16U;
+	if (HalfMask != (u32)0) {
+		XGpioPs_WriteReg(RegAddr, XGPIOPS_DATA_MSW_OFFSET,
+				 ((~HalfMask & 0xFFFFU) << 16U) |
+				 ((Data >> 16U) & HalfMask));
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* Do a list of masked bank writes, see XGpioPs_WriteMasked(). The writes are
+* issued back to back in the order of the list, which is the fastest way to
+* update pins spread over several banks.
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+* @param	Writes is the list of bank writes.
+* @param	Count is the number of entries in Writes.
+*
+* @return	None.
+*
+* @note		The hardware has no register spanning several banks, the
+*		pins of different banks, or of different halves of a bank,
+*		change in separate bus writes.
+*
+*****************************************************************************/
+void XGpioPs_WriteBanks(const XGpioPs *InstancePtr,
+			const XGpioPs_BankWrite *Writes, u32 Count)
+{
+	u32 Index;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid((Writes != NULL) || (Count == (u32)0));
+
+	for (Index = 0U; Index < Count; Index++) {
+		XGpioPs_WriteMasked(InstancePtr, Writes[Index].Bank,
+				    Writes[Index].Mask, Writes[Index].Data);
+	}
+}
+
 /****************************************************************************/
 /**
 *
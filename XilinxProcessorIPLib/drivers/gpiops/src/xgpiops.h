@@ -111,6 +111,10 @@
 *                     sync with standalone BSP
 * 3.6	sne  06/12/19 Fixed IAR compiler warning.
 * 3.6   sne  08/14/19 Added interrupt handler support on versal.
+* 3.6   adk  10/15/19 Added XGpioPs_WriteMasked and XGpioPs_WriteBanks for
+*                     masked bank writes without read-modify-write, and the
+*                     optional interrupt event filter for software debounce
+*                     and event timestamps.
 *
 * </pre>
 *
@@ -195,6 +199,36 @@ extern "C" {
  *****************************************************************************/
 typedef void (*XGpioPs_Handler) (void *CallBackRef, u32 Bank, u32 Status);
 
+/**
+ * Time source of the interrupt event filter. It returns a free running
+ * count, in any unit, which is used for event timestamps and debounce.
+ */
+typedef u64 (*XGpioPs_TimeFunc) (void);
+
+/**
+ * One masked bank write of XGpioPs_WriteBanks().
+ */
+typedef struct {
+	u8 Bank;		/**< Bank to write */
+	u32 Mask;		/**< Pins of the bank to change */
+	u32 Data;		/**< Value of the pins in Mask */
+} XGpioPs_BankWrite;
+
+/**
+ * Interrupt event filter, allocated by the user and attached with
+ * XGpioPs_SetEventFilter(). The interrupt handler timestamps the events
+ * with GetTime, and drops the events of the pins in PinMask which come less
+ * than Interval after the previous event accepted on the same pin.
+ */
+typedef struct {
+	XGpioPs_TimeFunc GetTime;	/**< Time source */
+	u64 Interval;			/**< Debounce interval, GetTime units */
+	u32 PinMask[XGPIOPS_MAX_BANKS_ZYNQMP]; /**< Debounced pins per bank */
+	u32 Valid[XGPIOPS_MAX_BANKS_ZYNQMP];   /**< Pins with an EventTime */
+	u64 EventTime[XGPIOPS_MAX_BANKS_ZYNQMP][32]; /**< Last accepted event */
+	u32 Dropped;			/**< Events dropped by the debounce */
+} XGpioPs_EventFilter;
+
 /**
  * This typedef contains configuration information for a device.
  */
@@ -217,6 +251,7 @@ typedef struct {
 	u32 MaxPinNum;			/**< Max pins in the GPIO device */
 	u8 MaxBanks;			/**< Max banks in a GPIO device */
         u32 PmcGpio;                    /**< Flag for accessing PS GPIO for versal*/
+	XGpioPs_EventFilter *EventFilter; /**< Optional interrupt event filter */
 } XGpioPs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -234,6 +269,10 @@ void XGpioPs_SetDirection(const XGpioPs *InstancePtr, u8 Bank, u32 Direction);
 u32 XGpioPs_GetDirection(const XGpioPs *InstancePtr, u8 Bank);
 void XGpioPs_SetOutputEnable(const XGpioPs *InstancePtr, u8 Bank, u32 OpEnable);
 u32 XGpioPs_GetOutputEnable(const XGpioPs *InstancePtr, u8 Bank);
+void XGpioPs_WriteMasked(const XGpioPs *InstancePtr, u8 Bank, u32 Mask,
+			 u32 Data);
+void XGpioPs_WriteBanks(const XGpioPs *InstancePtr,
+			const XGpioPs_BankWrite *Writes, u32 Count);
 #ifdef versal
 void XGpioPs_GetBankPin(const XGpioPs *InstancePtr,u8 PinNumber,u8 *BankNumber, u8 *PinNumberInBank);
 #else
@@ -265,6 +304,9 @@ void XGpioPs_GetIntrType(const XGpioPs *InstancePtr, u8 Bank, u32 *IntrType,
 void XGpioPs_SetCallbackHandler(XGpioPs *InstancePtr, void *CallBackRef,
 			     XGpioPs_Handler FuncPointer);
 void XGpioPs_IntrHandler(const XGpioPs *InstancePtr);
+void XGpioPs_SetEventFilter(XGpioPs *InstancePtr,
+			    XGpioPs_EventFilter *FilterPtr,
+			    XGpioPs_TimeFunc GetTime, u64 Interval);
 
 /* Pin APIs in xgpiops_intr.c */
 void XGpioPs_SetIntrTypePin(const XGpioPs *InstancePtr, u32 Pin, u8 IrqType);
@@ -275,6 +317,8 @@ void XGpioPs_IntrDisablePin(const XGpioPs *InstancePtr, u32 Pin);
 u32 XGpioPs_IntrGetEnabledPin(const XGpioPs *InstancePtr, u32 Pin);
 u32 XGpioPs_IntrGetStatusPin(const XGpioPs *InstancePtr, u32 Pin);
 void XGpioPs_IntrClearPin(const XGpioPs *InstancePtr, u32 Pin);
+void XGpioPs_SetDebouncePin(const XGpioPs *InstancePtr, u32 Pin, u32 Enable);
+u64 XGpioPs_GetEventTime(const XGpioPs *InstancePtr, u32 Pin);
 
 /* Functions in xgpiops_sinit.c */
 XGpioPs_Config *XGpioPs_LookupConfig(u16 DeviceId);
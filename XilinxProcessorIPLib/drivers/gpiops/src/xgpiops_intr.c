@@ -54,6 +54,9 @@
 * 3.5   sne  03/20/19 Fixed multiple interrupts problem CR#1024556.
 * 3.6	sne  06/12/19 Fixed IAR compiler warning.
 * 3.6   sne  08/14/19 Added interrupt handler support on versal.
+* 3.6   adk  10/15/19 Added the interrupt event filter for software debounce
+*                     and event timestamps, XGpioPs_SetEventFilter,
+*                     XGpioPs_SetDebouncePin and XGpioPs_GetEventTime.
 *
 * </pre>
 *
@@ -61,6 +64,7 @@
 
 /***************************** Include Files *********************************/
 
+#include <string.h>
 #include "xgpiops.h"
 
 /************************** Constant Definitions *****************************/
@@ -74,6 +78,8 @@
 /************************** Function Prototypes ******************************/
 
 void StubHandler(const void *CallBackRef, u32 Bank, u32 Status);
+static u32 XGpioPs_FilterEvents(XGpioPs_EventFilter *FilterPtr, u8 Bank,
+				u32 Status);
 
 /****************************************************************************/
 /**
@@ -792,13 +798,181 @@ void XGpioPs_IntrHandler(const XGpioPs *InstancePtr)
 		if ((IntrStatus & IntrEnabled) != (u32)0) {
 			XGpioPs_IntrClear(InstancePtr, Bank,
 					(IntrStatus & IntrEnabled));
-			InstancePtr->Handler(InstancePtr->
-					CallBackRef, Bank,
-					(IntrStatus & IntrEnabled));
+			IntrStatus &= IntrEnabled;
+			if (InstancePtr->EventFilter != NULL) {
+				IntrStatus = XGpioPs_FilterEvents(
+						InstancePtr->EventFilter,
+						Bank, IntrStatus);
+			}
+			if (IntrStatus != (u32)0) {
+				InstancePtr->Handler(InstancePtr->
+						CallBackRef, Bank,
+						IntrStatus);
+			}
 		}
 	}
 }
 
+/*****************************************************************************/
+/**
+*
+* Timestamp the events of a bank and drop the ones of debounced pins which
+* come within the debounce interval of the previous accepted event.
+*
+* @param	FilterPtr is a pointer to the event filter.
+* @param	Bank is the GPIO bank of the events.
+* @param	Status is the interrupt status of the bank.
+*
+* @return	The interrupt status without the dropped events.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XGpioPs_FilterEvents(XGpioPs_EventFilter *FilterPtr, u8 Bank,
+				u32 Status)
+{
+	u64 Now = FilterPtr->GetTime();
+	u32 Pending = Status;
+	u32 Result = Status;
+	u32 PinBit;
+	u8 Pin;
+
+	for (Pin = 0U; Pending != (u32)0; Pin++) {
+		PinBit = (u32)1 << Pin;
+		if ((Pending & PinBit) == (u32)0) {
+			continue;
+		}
+		Pending &= ~PinBit;
+
+		if (((FilterPtr->PinMask[Bank] & PinBit) != (u32)0) &&
+		    ((FilterPtr->Valid[Bank] & PinBit) != (u32)0) &&
+		    ((Now - FilterPtr->EventTime[Bank][Pin]) <
+		     FilterPtr->Interval)) {
+			Result &= ~PinBit;
+			FilterPtr->Dropped++;
+		} else {
+			FilterPtr->EventTime[Bank][Pin] = Now;
+			FilterPtr->Valid[Bank] |= PinBit;
+		}
+	}
+
+	return Result;
+}
+
+/*****************************************************************************/
+/**
+*
+* Attach an event filter to the interrupt handler. The handler then
+* timestamps the events with GetTime and drops the events of the pins
+* selected by XGpioPs_SetDebouncePin() which come less than Interval after
+* the previous accepted event on the same pin, so that a bouncing input
+* calls the callback once.
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+* @param	FilterPtr is a pointer to the filter, allocated by the user,
+*		or NULL to detach the filter.
+* @param	GetTime is the time source of the filter.
+* @param	Interval is the debounce interval, in GetTime units.
+*
+* @return	None.
+*
+* @note		The filter is reset, no pin is debounced until
+*		XGpioPs_SetDebouncePin() is called. Call this function with
+*		the GPIO interrupt disabled.
+*
+******************************************************************************/
+void XGpioPs_SetEventFilter(XGpioPs *InstancePtr,
+			    XGpioPs_EventFilter *FilterPtr,
+			    XGpioPs_TimeFunc GetTime, u64 Interval)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid((FilterPtr == NULL) || (GetTime != NULL));
+
+	if (FilterPtr != NULL) {
+		(void)memset(FilterPtr, 0, sizeof(*FilterPtr));
+		FilterPtr->GetTime = GetTime;
+		FilterPtr->Interval = Interval;
+	}
+	InstancePtr->EventFilter = FilterPtr;
+}
+
+/*****************************************************************************/
+/**
+*
+* Enable or disable the debounce of the events of the specified pin by the
+* event filter.
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+* @param	Pin is the pin number. Valid values are 0-117 in Zynq and
+*		0-173 in Zynq Ultrascale+ MP.
+* @param	Enable is TRUE to debounce the pin, FALSE otherwise.
+*
+* @return	None.
+*
+* @note		An event filter must be attached with XGpioPs_SetEventFilter().
+*
+******************************************************************************/
+void XGpioPs_SetDebouncePin(const XGpioPs *InstancePtr, u32 Pin, u32 Enable)
+{
+	u8 Bank;
+	u8 PinNumber;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(InstancePtr->EventFilter != NULL);
+	Xil_AssertVoid(Pin < InstancePtr->MaxPinNum);
+
+	/* Get the Bank number and Pin number within the bank. */
+#ifdef versal
+	XGpioPs_GetBankPin(InstancePtr,(u8)Pin, &Bank, &PinNumber);
+#else
+	XGpioPs_GetBankPin((u8)Pin, &Bank, &PinNumber);
+#endif
+
+	if (Enable != (u32)FALSE) {
+		InstancePtr->EventFilter->PinMask[Bank] |= ((u32)1 << PinNumber);
+	} else {
+		InstancePtr->EventFilter->PinMask[Bank] &= ~((u32)1 << PinNumber);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Get the timestamp of the last event accepted by the event filter on the
+* specified pin.
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+* @param	Pin is the pin number. Valid values are 0-117 in Zynq and
+*		0-173 in Zynq Ultrascale+ MP.
+*
+* @return	The GetTime value of the last event, 0 if the pin had no
+*		event since the filter was attached.
+*
+* @note		An event filter must be attached with XGpioPs_SetEventFilter().
+*
+******************************************************************************/
+u64 XGpioPs_GetEventTime(const XGpioPs *InstancePtr, u32 Pin)
+{
+	u8 Bank;
+	u8 PinNumber;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(InstancePtr->EventFilter != NULL);
+	Xil_AssertNonvoid(Pin < InstancePtr->MaxPinNum);
+
+	/* Get the Bank number and Pin number within the bank. */
+#ifdef versal
+	XGpioPs_GetBankPin(InstancePtr,(u8)Pin, &Bank, &PinNumber);
+#else
+	XGpioPs_GetBankPin((u8)Pin, &Bank, &PinNumber);
+#endif
+
+	return InstancePtr->EventFilter->EventTime[Bank][PinNumber];
+}
+
 /*****************************************************************************/
 /**
 *
@@ -62,6 +62,8 @@
 * 4.1   yas    11/10/16 Added function XHdcp1x_SetHdmiMode.
 * 4.1   yas    08/03/17 Updated the initialization to memset the XHdcp1x
 *                       structure to 0.
+* 4.3   adk    10/15/19 Updated XHdcp1x_SetKeySelect to drop the Km record
+*                       of the transmitter.
 * </pre>
 *
 ******************************************************************************/
@@ -1071,6 +1073,12 @@ int XHdcp1x_SetKeySelect(XHdcp1x *InstancePtr, u8 KeySelect)
 
 	Status = XHdcp1x_CipherSetKeySelect(InstancePtr, KeySelect);
 
+	/* A new key set invalidates any Km held by the cipher */
+	if (InstancePtr->Config.IsRx == FALSE) {
+		InstancePtr->Tx.KmLocalKsv = 0;
+		InstancePtr->Tx.KmRemoteKsv = 0;
+	}
+
 	return (Status);
 }
 
@@ -719,6 +719,9 @@
 *                       topology failures and ready the topology for the
 *                       repeater application to read.
 * 4.3   yas    08/16/19 Added support for HDMI 2.1 Rx and Tx.
+*       adk    10/15/19 Added KmLocalKsv and KmRemoteKsv to XHdcp1x_Tx and
+*                       the KmReused statistic to skip the Km calculation
+*                       when re-authenticating with the same receiver.
 * </pre>
 *
 ******************************************************************************/
@@ -978,6 +981,8 @@ typedef struct {
 	u32 ReadFailures;	/**< Num of remote read failures */
 	u32 LinkCheckPassed;	/**< Num of link verifications that passed */
 	u32 LinkCheckFailed;	/**< Num of link verifications that failed */
+	u32 KmReused;		/**< Num of authentications that reused the
+				  *  Km already held by the cipher */
 } XHdcp1x_TxStats;
 
 /**
@@ -1041,6 +1046,10 @@ typedef struct {
 	u32 IsUnauthenticatedCallbackSet;	/**< Unauthenticated config
 						  *  flag */
 	u16 DownstreamReady;/**< The downstream interface's status flag */
+	u64 KmLocalKsv;		/**< Local KSV the cipher's Km was computed
+				  *  with, 0 if none */
+	u64 KmRemoteKsv;	/**< Remote KSV the cipher's Km was computed
+				  *  with, 0 if none */
 } XHdcp1x_Tx;
 
 /**
@@ -41,6 +41,7 @@
 * 1.00  fidus  07/16/15 Initial release.
 * 3.1   yas    06/14/16 Added new functions XHdcp1x_CipherEnableBlank
 *                       and XHdcp1x_CipherDisableBlank
+* 4.3   adk    10/15/19 Added function XHdcp1x_CipherIsKmLoaded.
 * </pre>
 *
 ******************************************************************************/
@@ -872,6 +873,46 @@ int XHdcp1x_CipherSetRemoteKsv(XHdcp1x *InstancePtr, u64 Ksv)
 	return (Status);
 }
 
+/*****************************************************************************/
+/**
+* This function checks if the cipher still holds a valid Km computed for
+* a specific remote KSV.
+*
+* @param	InstancePtr is the device to query.
+* @param	Ksv is the remote KSV value to check against.
+*
+* @return	Truth value indicating the Km is ready for Ksv (TRUE) or
+*		not (FALSE).
+*
+* @note		The key management block only clears Km ready when a new
+*		calculation is started or the cipher is disabled, so a
+*		match means XHdcp1x_CipherSetRemoteKsv can be skipped.
+*
+******************************************************************************/
+int XHdcp1x_CipherIsKmLoaded(const XHdcp1x *InstancePtr, u64 Ksv)
+{
+	u64 RemoteKsv = 0;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	/* Check that it is not disabled */
+	if (!XHdcp1x_CipherIsEnabled(InstancePtr)) {
+		return (FALSE);
+	}
+
+	/* Check that Km is available */
+	if (!XHdcp1x_CipherKmReady(InstancePtr)) {
+		return (FALSE);
+	}
+
+	/* Determine the remote ksv the Km was computed with */
+	RemoteKsv = XHdcp1x_CipherGetRemoteKsv(InstancePtr);
+	RemoteKsv &= 0xFFFFFFFFFFull;
+
+	return (RemoteKsv == Ksv);
+}
+
 /*****************************************************************************/
 /**
 * This function reads the contents of the B register in BM0.
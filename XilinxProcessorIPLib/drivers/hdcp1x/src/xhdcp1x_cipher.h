@@ -42,6 +42,7 @@
 *                       Added macro HDCP1X_CIPHER_BIT_REPEATER_ENABLE
 * 3.1   yas    06/15/16 Added new functions XHdcp1x_CipherEnableBlank
 *                       and XHdcp1x_CipherDisableBlank.
+* 4.3   adk    10/15/19 Added function XHdcp1x_CipherIsKmLoaded.
 * </pre>
 *
 ******************************************************************************/
@@ -131,6 +132,7 @@ int XHdcp1x_CipherDisableEncryption(XHdcp1x *InstancePtr, u64 StreamMap);
 u64 XHdcp1x_CipherGetLocalKsv(const XHdcp1x *InstancePtr);
 u64 XHdcp1x_CipherGetRemoteKsv(const XHdcp1x *InstancePtr);
 int XHdcp1x_CipherSetRemoteKsv(XHdcp1x *InstancePtr, u64 Ksv);
+int XHdcp1x_CipherIsKmLoaded(const XHdcp1x *InstancePtr, u64 Ksv);
 
 int XHdcp1x_CipherGetB(const XHdcp1x *InstancePtr, u32 *X, u32 *Y, u32 *Z);
 int XHdcp1x_CipherSetB(XHdcp1x *InstancePtr, u32 X, u32 Y, u32 Z);
@@ -72,6 +72,9 @@
 *                       it available in XHdcp1x_TxGetTopology().
 *                       Updating the XHdcp1x_TxReset() to clear the
 *                       Authentication Request flag.
+* 4.3   adk    10/15/19 Updated XHdcp1x_TxExchangeKsvs to reuse the Km held
+*                       by the cipher when re-authenticating with the same
+*                       receiver.
 * </pre>
 *
 *****************************************************************************/
@@ -942,6 +945,8 @@ int XHdcp1x_TxInfo(const XHdcp1x *InstancePtr)
 			InstancePtr->Tx.Stats.LinkCheckFailed);
 	XHDCP1X_DEBUG_PRINTF("Read Failures:   %d\r\n",
 			InstancePtr->Tx.Stats.ReadFailures);
+	XHDCP1X_DEBUG_PRINTF("Km Reused:       %d\r\n",
+			InstancePtr->Tx.Stats.KmReused);
 
 	XHDCP1X_DEBUG_PRINTF("\r\n");
 	XHDCP1X_DEBUG_PRINTF("Cipher Stats\r\n");
@@ -1301,6 +1306,8 @@ static void XHdcp1x_TxDisableState(XHdcp1x *InstancePtr)
 
 	/* Disable the cryto engine */
 	XHdcp1x_CipherDisable(InstancePtr);
+	InstancePtr->Tx.KmLocalKsv = 0;
+	InstancePtr->Tx.KmRemoteKsv = 0;
 
 	/* Disable the timer */
 	XHdcp1x_TxStopTimer(InstancePtr);
@@ -1473,8 +1480,22 @@ static void XHdcp1x_TxExchangeKsvs(XHdcp1x *InstancePtr,
 			/* Determine theLocalKsv */
 			LocalKsv = XHdcp1x_CipherGetLocalKsv(InstancePtr);
 
-			/* Load the cipher with the remote ksv */
-			XHdcp1x_CipherSetRemoteKsv(InstancePtr, RemoteKsv);
+			/* Reuse the Km if already computed for this pair */
+			if ((InstancePtr->Tx.KmLocalKsv == LocalKsv) &&
+			    (InstancePtr->Tx.KmRemoteKsv == RemoteKsv) &&
+			    XHdcp1x_CipherIsKmLoaded(InstancePtr, RemoteKsv)) {
+				InstancePtr->Tx.Stats.KmReused++;
+			}
+			/* Otherwise load the cipher with the remote ksv */
+			else if (XHdcp1x_CipherSetRemoteKsv(InstancePtr,
+					RemoteKsv) == XST_SUCCESS) {
+				InstancePtr->Tx.KmLocalKsv = LocalKsv;
+				InstancePtr->Tx.KmRemoteKsv = RemoteKsv;
+			}
+			else {
+				InstancePtr->Tx.KmLocalKsv = 0;
+				InstancePtr->Tx.KmRemoteKsv = 0;
+			}
 
 			/* Clear AINFO */
 			memset(Buf_AInfo, 0, XHDCP1X_PORT_SIZE_AINFO);
@@ -3384,6 +3405,8 @@ static void XHdcp1x_TxEnterState(XHdcp1x *InstancePtr, XHdcp1x_StateType State,
 			InstancePtr->Tx.Flags &= ~XVPHY_FLAG_PHY_UP;
 			XHdcp1x_TxDisableEncryptionState(InstancePtr);
 			XHdcp1x_CipherDisable(InstancePtr);
+			InstancePtr->Tx.KmLocalKsv = 0;
+			InstancePtr->Tx.KmRemoteKsv = 0;
 			break;
 
 		/* Otherwise */
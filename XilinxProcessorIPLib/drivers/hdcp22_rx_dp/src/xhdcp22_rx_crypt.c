@@ -40,6 +40,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00  JB   02/19/19 First Release.
+*       JB   10/14/19 Use sliding window exponentiation in the Montgomery
+*                     domain and a CIOS software Montgomery multiplication.
 *</pre>
 *
 *****************************************************************************/
@@ -60,6 +62,11 @@
 /***************** Macros (Inline Functions) Definitions ********************/
 #define XHdcp22Rx_MpSizeof(A) (sizeof(A)/sizeof(u32))
 
+/* Sliding window size of the modular exponentiation, and number of
+ * precomputed odd powers of the base: A^1, A^3, ..., A^(2^W - 1) */
+#define XHDCP22_RX_MONTEXP_WINDOW         4
+#define XHDCP22_RX_MONTEXP_TABLE_SIZE     (1 << (XHDCP22_RX_MONTEXP_WINDOW - 1))
+
 /************************** Variable Definitions ****************************/
 
 /************************** Function Prototypes *****************************/
@@ -80,8 +87,9 @@ static void XHdcp22Rx_Pkcs1MontMultFios(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
 #else
 static void XHdcp22Rx_Pkcs1MontMultFiosStub(u32 *U, u32 *A, u32 *B, u32 *N,
 	            const u32 *NPrime, int NDigits);
-static void XHdcp22Rx_Pkcs1MontMultAdd(u32 *A, u32 C, int SDigit, int NDigits);
 #endif
+static void XHdcp22Rx_Pkcs1MontMult(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
+	            u32 *B, u32 *N, const u32 *NPrime, int NDigits);
 static int  XHdcp22Rx_Pkcs1MontExp(XHdcp22_Rx *InstancePtr, u32 *C, u32 *A, u32 *E,
 	            u32 *N, const u32 *NPrime, int NDigits);
 
@@ -660,57 +668,15 @@ static int XHdcp22Rx_Pkcs1EmeOaepDecode(u8 *EncodedMessage, u8 *Message, int *Me
 	return XST_SUCCESS;
 }
 
-#ifdef _XHDCP22_RX_SW_MMULT_
-/****************************************************************************/
-/**
-* This function performs a carry propagation adding C to the input
-* array A of size NDigits, given by the first argument starting from
-* the first element SDigit, and propagates it until no further carry
-* is generated.
-*
-* ADD(A[i],C)
-*
-* Reference:
-* Analyzing and Comparing Montgomery Multiplication Algorithms
-* IEEE Micro, 16(3):26-33,June 1996
-* By: Cetin Koc, Tolga Acar, and Burton Kaliski
-*
-* @param	A is an input array of size NDigits
-* @param	C is the value being added to the input A
-* @param	SDigit is the start digit
-* @param	NDigits is the integer precision of the arguments (A)
-*
-* @return	None.
-*
-* @note		None.
-*****************************************************************************/
-static void XHdcp22Rx_Pkcs1MontMultAdd(u32 *A, u32 C, int SDigit, int NDigits)
-{
-	/* Verify arguments */
-	Xil_AssertVoid(A != NULL);
-	Xil_AssertVoid(SDigit <= NDigits);
-
-	int i;
-
-	for(i=SDigit; i<NDigits; i++)
-	{
-		C = mpAdd(A+i, A+i, &C, 1);
-
-		if(C == 0)
-		{
-			return;
-		}
-	}
-}
-#endif
-
 #ifdef _XHDCP22_RX_SW_MMULT_
 /****************************************************************************/
 /**
 * This function implements the Montgomery Modular Multiplication (MMM)
-* Finely Integrated Operand Scanning (FIOS) algorithm. The FIOS method
-* interleaves multiplication and reduction operations. Requires NDigits+3
-* words of temporary storage.
+* Coarsely Integrated Operand Scanning (CIOS) algorithm. The CIOS method
+* alternates a multiplication pass and a reduction pass for each digit of B.
+* Products and carries are accumulated in 64 bit words, so that each inner
+* step is one multiply-accumulate. Requires NDigits+2 words of temporary
+* storage.
 *
 * U = MontMult(A,B,N)
 *
@@ -728,7 +694,7 @@ static void XHdcp22Rx_Pkcs1MontMultAdd(u32 *A, u32 C, int SDigit, int NDigits)
 *
 * @return	None.
 *
-* @note		None.
+* @note		U can be the same array as A or B.
 *****************************************************************************/
 static void XHdcp22Rx_Pkcs1MontMultFiosStub(u32 *U, u32 *A, u32 *B,
 	u32 *N, const u32 *NPrime, int NDigits)
@@ -742,65 +708,52 @@ static void XHdcp22Rx_Pkcs1MontMultFiosStub(u32 *U, u32 *A, u32 *B,
 	Xil_AssertVoid(NDigits == 16);
 
 	int i, j;
-	u32 S, C, C1, C2, M[2], X[2];
-	u32 T[XHDCP22_RX_N_SIZE];
+	u64 Acc;
+	u32 C, M;
+	u32 T[XHDCP22_RX_N_SIZE/4];
 
-	memset(T, 0, 4*(NDigits+3));
+	memset(T, 0, 4*(NDigits+2));
 
 	for(i=0; i<NDigits; i++)
 	{
-		// (C,S) = t[0] + a[0]*b[i], worst case 2 words
-		spMultiply(X, A[0], B[i]);	// X[Upper,Lower] = a[0]*b[i]
-		C = mpAdd(&S, T+0, X+0, 1);	// [C,S] = t[0] + X[Lower]
-		mpAdd(&C, &C, X+1, 1);		// [~,C] = C + X[Upper], No carry
-
-		// ADD(t[1],C)
-		XHdcp22Rx_Pkcs1MontMultAdd(T, C, 1, NDigits+3);
+		// (C,t[j]) = t[j] + a[j]*b[i] + C
+		C = 0;
+		for(j=0; j<NDigits; j++)
+		{
+			Acc = (u64)T[j] + ((u64)A[j] * B[i]) + C;
+			T[j] = (u32)Acc;
+			C = (u32)(Acc >> 32);
+		}
+		// (t[s+1],t[s]) = t[s] + C
+		Acc = (u64)T[NDigits] + C;
+		T[NDigits] = (u32)Acc;
+		T[NDigits+1] = (u32)(Acc >> 32);
 
-		// m = S*n'[0] mod W, where W=2^32
-		// Note: X[Upper,Lower] = S*n'[0], m=X[Lower]
-		spMultiply(M, S, NPrime[0]);
+		// m = t[0]*n'[0] mod W, where W=2^32
+		M = T[0] * NPrime[0];
 
-		// (C,S) = S + m*n[0], worst case 2 words
-		spMultiply(X, M[0], N[0]);	// X[Upper,Lower] = m*n[0]
-		C = mpAdd(&S, &S, X+0, 1);	// [C,S] = S + X[Lower]
-		mpAdd(&C, &C, X+1, 1);		// [~,C] = C + X[Upper]
+		// (C,~) = t[0] + m*n[0]
+		Acc = (u64)T[0] + ((u64)M * N[0]);
+		C = (u32)(Acc >> 32);
 
+		// (C,t[j-1]) = t[j] + m*n[j] + C
 		for(j=1; j<NDigits; j++)
 		{
-			// (C,S) = t[j] + a[j]*b[i] + C, worst case 2 words
-			spMultiply(X, A[j], B[i]);	 	// X[Upper,Lower] = a[j]*b[i], double precision
-			C1 = mpAdd(&S, T+j, &C, 1);		// (C1,S) = t[j] + C
-			C2 = mpAdd(&S, &S, X+0, 1); 	// (C2,S) = S + X[Lower]
-			mpAdd(&C, &C1, X+1, 1);			// (~,C)  = C1 + X[Upper], doesn't produce carry
-			mpAdd(&C, &C, &C2, 1); 			// (~,C)  = C + C2, doesn't produce carry
-
-			// ADD(t[j+1],C)
-			XHdcp22Rx_Pkcs1MontMultAdd(T, C, j+1, NDigits+3);
-
-			// (C,S) = S + m*n[j]
-			spMultiply(X, M[0], N[j]);	// X[Upper,Lower] = m*n[j]
-			C = mpAdd(&S, &S, X+0, 1);	// [C,S] = S + X[Lower]
-			mpAdd(&C, &C, X+1, 1);		// [~,C] = C + X[Upper]
-
-			// t[j-1] = S
-			T[j-1] = S;
+			Acc = (u64)T[j] + ((u64)M * N[j]) + C;
+			T[j-1] = (u32)Acc;
+			C = (u32)(Acc >> 32);
 		}
 
-		// (C,S) = t[s] + C
-		C = mpAdd(&S, T+NDigits, &C, 1);
-		// t[s-1] = S
-		T[NDigits-1] = S;
-		// t[s] = t[s+1] + C
-		mpAdd(T+NDigits, T+NDigits+1, &C, 1);
-		// t[s+1] = 0
-		T[NDigits+1] = 0;
+		// (C,t[s-1]) = t[s] + C, t[s] = t[s+1] + C
+		Acc = (u64)T[NDigits] + C;
+		T[NDigits-1] = (u32)Acc;
+		T[NDigits] = T[NDigits+1] + (u32)(Acc >> 32);
 	}
 
 	/* Step 3: if(u>=n) return u-n else return u */
-	if(mpCompare(T, N, NDigits+3) >= 0)
+	if((T[NDigits] != 0) || (mpCompare(T, N, NDigits) >= 0))
 	{
-		mpSubtract(T, T, N, NDigits+3);
+		mpSubtract(T, T, N, NDigits);
 	}
 
 	memcpy(U, T, 4*NDigits);
@@ -895,13 +848,56 @@ static void XHdcp22Rx_Pkcs1MontMultFios(XHdcp22_Rx *InstancePtr, u32 *U,
 }
 #endif
 
+/****************************************************************************/
+/**
+* This function performs one Montgomery multiplication, with the MMULT
+* hardware or, when _XHDCP22_RX_SW_MMULT_ is defined, in software.
+*
+* U = MontMult(A,B,N)
+*
+* @param	InstancePtr is a pointer to the MMULT instance.
+* @param	U is the MMM result
+* @param	A is the n-residue input, A' = A*R mod N
+* @param	B is the n-residue input, B' = B*R mod N
+* @param	N is the modulus
+* @param	NPrime is a pre-computed constant, NPrime = (1-R*Rbar)/N
+* @param	NDigits is the integer precision of the arguments (C,A,B,N,NPrime)
+*
+* @return	None.
+*
+* @note		The hardware takes N and NPrime from
+* 			XHdcp22Rx_Pkcs1MontMultFiosInit.
+*****************************************************************************/
+static void XHdcp22Rx_Pkcs1MontMult(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
+	u32 *B, u32 *N, const u32 *NPrime, int NDigits)
+{
+#ifndef _XHDCP22_RX_SW_MMULT_
+	XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, U, A, B, NDigits);
+#else
+	XHdcp22Rx_Pkcs1MontMultFiosStub(U, A, B, N, NPrime, NDigits);
+#endif
+}
+
 /****************************************************************************/
 /**
 * This function performs the modular exponentation operation using the
-* binary square and multiply method.
+* sliding window method in the Montgomery domain.
 *
 * C = ModExp(A, E, N) = A^E*mod(N)
 *
+* The odd powers A^1, A^3, ..., A^(2^W - 1) of the base are precomputed in
+* Montgomery form, W being XHDCP22_RX_MONTEXP_WINDOW. The exponent is then
+* scanned from its most significant set bit. Each run of zero bits costs one
+* squaring per bit, and each window of up to W bits that starts and ends with
+* a one costs one squaring per bit and a single multiplication by the
+* precomputed power. For a 512 bit exponent this takes about 100
+* multiplications instead of 256 with the binary method.
+*
+* Reference:
+* Handbook of Applied Cryptography, Algorithm 14.85
+* By: Alfred Menezes, Paul van Oorschot, and Scott Vanstone
+*
+* @param	InstancePtr is a pointer to the MMULT instance.
 * @param	C is result of the modular exponentiation
 * @param	A is the base
 * @param	E is the exponent
@@ -910,7 +906,7 @@ static void XHdcp22Rx_Pkcs1MontMultFios(XHdcp22_Rx *InstancePtr, u32 *U,
 * @param	NDigits is the integer precision of the arguments (C,A,B,N,NPrime).
 * 			Maximum integer precision is 16.
 *
-* @return	None.
+* @return	XST_SUCCESS.
 *
 * @note		None.
 *****************************************************************************/
@@ -918,9 +914,14 @@ static int XHdcp22Rx_Pkcs1MontExp(XHdcp22_Rx *InstancePtr, u32 *C, u32 *A,
 	u32 *E, u32 *N, const u32 *NPrime, int NDigits)
 {
 	int Offset;
+	int Low;
+	int Bit;
+	int IsOne = TRUE;
+	u32 Window;
 	u32 R[XHDCP22_RX_N_SIZE/4];
 	u32 Abar[XHDCP22_RX_N_SIZE/4];
 	u32 Xbar[XHDCP22_RX_N_SIZE/4];
+	u32 Table[XHDCP22_RX_MONTEXP_TABLE_SIZE][XHDCP22_RX_N_SIZE/8];
 
 	memset(R, 0, sizeof(R));
 	memset(Abar, 0, sizeof(Abar));
@@ -940,34 +941,74 @@ static int XHdcp22Rx_Pkcs1MontExp(XHdcp22_Rx *InstancePtr, u32 *C, u32 *A,
 	/* Step 2: Abar = A*R*mod(N) */
 	mpModMult(Abar, A, Xbar, N, 2*NDigits);
 
-	/* Step 3: Binary square and multiply */
-	for(Offset=32*NDigits-1; Offset>=0; Offset--)
+	/* Step 3: Table[i] = Abar^(2i+1), using R as Abar^2 */
+	memcpy(Table[0], Abar, 4*NDigits);
+	XHdcp22Rx_Pkcs1MontMult(InstancePtr, R, Abar, Abar, N, NPrime, NDigits);
+	for(Window=1; Window<XHDCP22_RX_MONTEXP_TABLE_SIZE; Window++)
 	{
-#ifndef _XHDCP22_RX_SW_MMULT_
-		XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, Xbar, Xbar, Xbar, NDigits);
-#else
-		XHdcp22Rx_Pkcs1MontMultFiosStub(Xbar, Xbar, Xbar, N, NPrime, NDigits);
-#endif
+		XHdcp22Rx_Pkcs1MontMult(InstancePtr, Table[Window], Table[Window-1],
+			R, N, NPrime, NDigits);
+	}
 
-		if(mpGetBit(E, NDigits, Offset) == TRUE)
+	/* Step 4: Sliding window square and multiply */
+	Offset = (int)mpBitLength(E, NDigits) - 1;
+	while(Offset >= 0)
+	{
+		if(mpGetBit(E, NDigits, Offset) != TRUE)
 		{
-#ifndef _XHDCP22_RX_SW_MMULT_
-			XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, Xbar, Xbar, Abar, NDigits);
-#else
-			XHdcp22Rx_Pkcs1MontMultFiosStub(Xbar, Xbar, Abar, N, NPrime, NDigits);
-#endif
+			if(IsOne != TRUE)
+			{
+				XHdcp22Rx_Pkcs1MontMult(InstancePtr, Xbar, Xbar, Xbar, N,
+					NPrime, NDigits);
+			}
+			Offset--;
+			continue;
 		}
+
+		/* Longest window E[Offset..Low] of at most W bits ending with a one */
+		Low = Offset - XHDCP22_RX_MONTEXP_WINDOW + 1;
+		if(Low < 0)
+		{
+			Low = 0;
+		}
+		while(mpGetBit(E, NDigits, Low) != TRUE)
+		{
+			Low++;
+		}
+
+		Window = 0;
+		for(Bit=Offset; Bit>=Low; Bit--)
+		{
+			Window = (Window << 1) | (u32)mpGetBit(E, NDigits, Bit);
+			if(IsOne != TRUE)
+			{
+				XHdcp22Rx_Pkcs1MontMult(InstancePtr, Xbar, Xbar, Xbar, N,
+					NPrime, NDigits);
+			}
+		}
+
+		/* Xbar = Xbar * Abar^Window, Window is odd */
+		if(IsOne == TRUE)
+		{
+			memcpy(Xbar, Table[Window >> 1], 4*NDigits);
+			IsOne = FALSE;
+		}
+		else
+		{
+			XHdcp22Rx_Pkcs1MontMult(InstancePtr, Xbar, Xbar, Table[Window >> 1],
+				N, NPrime, NDigits);
+		}
+
+		Offset = Low - 1;
 	}
 
-	/* Step 4: C=MonPro(Xbar,1) */
+	/* Step 5: C=MonPro(Xbar,1) */
 	memset(R, 0, sizeof(R));
 	R[0] = 1;
+	XHdcp22Rx_Pkcs1MontMult(InstancePtr, C, Xbar, R, N, NPrime, NDigits);
 
-#ifndef _XHDCP22_RX_SW_MMULT_
-	XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, C, Xbar, R, NDigits);
-#else
-	XHdcp22Rx_Pkcs1MontMultFiosStub(C, Xbar, R, N, NPrime, NDigits);
-#endif
+	/* Clear the powers of the base */
+	memset(Table, 0, sizeof(Table));
 
 	return XST_SUCCESS;
 }
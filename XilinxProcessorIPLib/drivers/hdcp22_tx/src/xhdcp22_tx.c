@@ -71,6 +71,11 @@
 *                          RxStatus register.
 * 2.31  YB     03/28/19 Moved the reading of the DDC status from
 *                          XHdcp22Tx_TimerHandler to XHdcp22Tx_Poll.
+* 2.40  MH     10/14/19 Replaced the least recently used pairing info entry
+*                       when the table is full. Added functions
+*                       XHdcp22Tx_GetPairingInfoTable and
+*                       XHdcp22Tx_SetPairingInfoTable and the pairing info
+*                       updated callback to keep the table over power cycles.
 * </pre>
 *
 ******************************************************************************/
@@ -194,6 +199,10 @@ static void XHdcp22Tx_InvalidatePairingInfo(XHdcp22_Tx *InstancePtr,
                                              const u8* ReceiverId);
 static XHdcp22_Tx_PairingInfo *XHdcp22Tx_UpdatePairingInfo(XHdcp22_Tx *InstancePtr,
                               const XHdcp22_Tx_PairingInfo *PairingInfo, u8 Ready);
+static XHdcp22_Tx_PairingInfo *XHdcp22Tx_GetPairingInfoSlot(XHdcp22_Tx *InstancePtr,
+                                                            const u8 *ReceiverId);
+static void XHdcp22Tx_UsePairingInfo(XHdcp22_Tx *InstancePtr,
+                                     XHdcp22_Tx_PairingInfo *PairingInfoPtr);
 
 /* Timer functions */
 static void XHdcp22Tx_TimerHandler(void *CallbackRef, u8 TmrCntNumber);
@@ -333,6 +342,8 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
 	InstancePtr->IsUnauthenticatedCallbackSet = (FALSE);
 	InstancePtr->DownstreamTopologyAvailableCallback = XHdcp22Tx_StubCallback;
 	InstancePtr->IsDownstreamTopologyAvailableCallbackSet = (FALSE);
+	InstancePtr->PairingInfoUpdatedCallback = XHdcp22Tx_StubCallback;
+	InstancePtr->IsPairingInfoUpdatedCallbackSet = (FALSE);
 
 	InstancePtr->Info.Protocol = XHDCP22_TX_HDMI;
 
@@ -1405,6 +1416,7 @@ u8 XHdcp22Tx_IsDwnstrmCapable (XHdcp22_Tx *InstancePtr)
 * (XHDCP22_TX_HANDLER_AUTHENTICATED)                 AuthenticatedCallback
 * (XHDCP22_TX_HANDLER_UNAUTHENTICATED)               UnauthenticatedCallback
 * (XHDCP22_TX_HANDLER_DOWNSTREAM_TOPOLOGY_AVAILABLE) DownstreamTopologyAvailableCallback
+* (XHDCP22_TX_HANDLER_PAIRINGINFO_UPDATED)           PairingInfoUpdatedCallback
 * </pre>
 *
 * @param	InstancePtr is a pointer to the HDMI RX core instance.
@@ -1475,6 +1487,14 @@ int XHdcp22Tx_SetCallback(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_HandlerType Handle
 			Status = (XST_SUCCESS);
 			break;
 
+		// Pairing info table is updated
+		case (XHDCP22_TX_HANDLER_PAIRINGINFO_UPDATED) :
+			InstancePtr->PairingInfoUpdatedCallback = (XHdcp22_Tx_Callback)CallbackFunc;
+			InstancePtr->PairingInfoUpdatedCallbackRef = CallbackRef;
+			InstancePtr->IsPairingInfoUpdatedCallbackSet = (TRUE);
+			Status = (XST_SUCCESS);
+			break;
+
 		default:
 			Status = (XST_INVALID_PARAM);
 			break;
@@ -1786,6 +1806,7 @@ XHdcp22_Tx_StateType Xhdcp22Tx_StateA1_1(XHdcp22_Tx *InstancePtr)
 			/* Update RxCaps in pairing info */
 			memcpy(PairingInfoPtr->RxCaps, MsgPtr->Message.AKESendCert.RxCaps,
 				sizeof(PairingInfoPtr->RxCaps));
+			XHdcp22Tx_UsePairingInfo(InstancePtr, PairingInfoPtr);
 
 			/* Write encrypted Km */
 			Result = XHdcp22Tx_WriteAKEStoredKm(InstancePtr, PairingInfoPtr);
@@ -3850,9 +3871,111 @@ int XHdcp22Tx_ClearPairingInfo(XHdcp22_Tx *InstancePtr)
 
 	memset(InstancePtr->Info.PairingInfo, 0x00,
 	       sizeof(InstancePtr->Info.PairingInfo));
+	InstancePtr->Info.PairingInfoAge = 0;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function copies the valid entries of the pairing info table to a
+* buffer, so the application can keep them over a power cycle, for example
+* in flash. The entries are loaded back with #XHdcp22Tx_SetPairingInfoTable.
+* A good moment to copy the table is the PairingInfoUpdatedCallback.
+*
+* @param   InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param   TablePtr is a pointer to the buffer receiving the entries.
+* @param   MaxEntries is the number of entries that fit in the buffer.
+*
+* @return  The number of entries copied.
+*
+* @note    The entries hold the master key Km in the clear. The application
+*          must keep the stored copy confidential, for example by
+*          encrypting it before it is written to non-volatile memory.
+*
+******************************************************************************/
+u32 XHdcp22Tx_GetPairingInfoTable(XHdcp22_Tx *InstancePtr,
+                                  XHdcp22_Tx_PairingInfo *TablePtr,
+                                  u32 MaxEntries)
+{
+	u32 i;
+	u32 NumEntries = 0;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(TablePtr != NULL);
+
+	for (i = 0; (i < XHDCP22_TX_MAX_STORED_PAIRINGINFO) &&
+	            (NumEntries < MaxEntries); i++) {
+		if (InstancePtr->Info.PairingInfo[i].Ready == TRUE) {
+			memcpy(&TablePtr[NumEntries], &InstancePtr->Info.PairingInfo[i],
+			       sizeof(XHdcp22_Tx_PairingInfo));
+			NumEntries++;
+		}
+	}
+
+	return NumEntries;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function loads pairing info entries saved with
+* #XHdcp22Tx_GetPairingInfoTable, so receivers that were paired before take
+* the 'stored km' sequence and skip the RSA encryption of Km. The current
+* table is cleared first. When there are more entries than
+* XHDCP22_TX_MAX_STORED_PAIRINGINFO the most recently used ones are kept.
+*
+* @param   InstancePtr is a pointer to the XHdcp22Tx core instance.
+* @param   TablePtr is a pointer to the saved entries.
+* @param   NumEntries is the number of saved entries.
+*
+* @return  XST_SUCCESS
+*
+* @note    Entries that are not ready or have an illegal receiver ID are
+*          skipped. A receiver that lost its pairing fails the 'stored km'
+*          sequence once and is then paired again.
+*
+******************************************************************************/
+int XHdcp22Tx_SetPairingInfoTable(XHdcp22_Tx *InstancePtr,
+                                  const XHdcp22_Tx_PairingInfo *TablePtr,
+                                  u32 NumEntries)
+{
+	u32 i;
+	u8 IllegalRecvID[] = {0x0, 0x0, 0x0, 0x0, 0x0};
+	const XHdcp22_Tx_PairingInfo *EntryPtr = NULL;
+	XHdcp22_Tx_PairingInfo *PairingInfoPtr = NULL;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((TablePtr != NULL) || (NumEntries == 0));
+
+	XHdcp22Tx_ClearPairingInfo(InstancePtr);
+
+	for (i = 0; i < NumEntries; i++) {
+		EntryPtr = &TablePtr[i];
+		if ((EntryPtr->Ready != TRUE) ||
+		    (memcmp(EntryPtr->ReceiverId, IllegalRecvID,
+		            XHDCP22_TX_CERT_RCVID_SIZE) == 0)) {
+			continue;
+		}
+
+		/* Keep the newer entry when the table is full */
+		PairingInfoPtr = XHdcp22Tx_GetPairingInfoSlot(InstancePtr,
+		                                              EntryPtr->ReceiverId);
+		if ((PairingInfoPtr->Ready == TRUE) &&
+		    (PairingInfoPtr->LastUsed > EntryPtr->LastUsed)) {
+			continue;
+		}
+
+		memcpy(PairingInfoPtr, EntryPtr, sizeof(XHdcp22_Tx_PairingInfo));
+		if (EntryPtr->LastUsed > InstancePtr->Info.PairingInfoAge) {
+			InstancePtr->Info.PairingInfoAge = EntryPtr->LastUsed;
+		}
+	}
 
 	return XST_SUCCESS;
 }
+
 /*****************************************************************************/
 /**
 *
@@ -3891,53 +4014,104 @@ static XHdcp22_Tx_PairingInfo *XHdcp22Tx_GetPairingInfo(XHdcp22_Tx *InstancePtr,
 /*****************************************************************************/
 /**
 *
-* This function updates a pairing info entry in the storage.
+* This function selects the pairing info slot for a receiver. This is the
+* entry of the receiver if it is stored, else the first slot that is not
+* ready, else the least recently used entry.
 *
-* @param  PairingInfo is a pointer to a pairing info structure.
+* @param  ReceiverId is a pointer to a 5-byte receiver Id.
 *
-* @return
-*         - XST_SUCCESS if there was enough room
-*         - XST_FAILURE if there was no room for this receiver
+* @return A pointer to the selected slot.
 *
 * @note   None.
 *
 ******************************************************************************/
-static XHdcp22_Tx_PairingInfo *XHdcp22Tx_UpdatePairingInfo(
-	                          XHdcp22_Tx *InstancePtr,
-                              const XHdcp22_Tx_PairingInfo *PairingInfo,
-                              u8 Ready)
+static XHdcp22_Tx_PairingInfo *XHdcp22Tx_GetPairingInfoSlot(XHdcp22_Tx *InstancePtr,
+                                                            const u8 *ReceiverId)
 {
 	int i = 0;
-	int i_match = 0;
-	u8 Match = (FALSE);
-	XHdcp22_Tx_PairingInfo * PairingInfoPtr = NULL;
+	XHdcp22_Tx_PairingInfo *SlotPtr = NULL;
+	XHdcp22_Tx_PairingInfo *PairingInfoPtr = NULL;
 
-	/* Find slot */
 	for (i=0; i<XHDCP22_TX_MAX_STORED_PAIRINGINFO; i++) {
 
 		PairingInfoPtr = &InstancePtr->Info.PairingInfo[i];
 
-		/* Look for empty slot */
-		if ((PairingInfoPtr->Ready == FALSE) && (Match == FALSE)) {
-			i_match = i;
-			Match = (TRUE);
+		/* Look for match, match overrides empty and LRU slot */
+		if (memcmp(ReceiverId, PairingInfoPtr->ReceiverId,
+		           XHDCP22_TX_CERT_RCVID_SIZE) == 0) {
+			return PairingInfoPtr;
 		}
 
-		/* Look for match, match overrides empty slot */
-		if (memcmp(PairingInfo->ReceiverId, PairingInfoPtr->ReceiverId,
-		           XHDCP22_TX_CERT_RCVID_SIZE) == 0) {
-			i_match = i;
-			break;
+		/* Look for empty slot, else for the least recently used one */
+		if ((SlotPtr == NULL) ||
+		    ((SlotPtr->Ready == TRUE) &&
+		     ((PairingInfoPtr->Ready == FALSE) ||
+		      (PairingInfoPtr->LastUsed < SlotPtr->LastUsed)))) {
+			SlotPtr = PairingInfoPtr;
 		}
 	}
 
-	PairingInfoPtr = &InstancePtr->Info.PairingInfo[i_match];
+	return SlotPtr;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function marks a pairing info entry as the most recently used.
+*
+* @param  PairingInfoPtr is a pointer to an entry of the storage.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Tx_UsePairingInfo(XHdcp22_Tx *InstancePtr,
+                                     XHdcp22_Tx_PairingInfo *PairingInfoPtr)
+{
+	InstancePtr->Info.PairingInfoAge++;
+	PairingInfoPtr->LastUsed = InstancePtr->Info.PairingInfoAge;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function updates a pairing info entry in the storage. When the storage
+* is full the least recently used entry is replaced.
+*
+* @param  PairingInfo is a pointer to a pairing info structure.
+* @param  Ready is TRUE when the pairing completed, this calls the
+*         PairingInfoUpdatedCallback.
+*
+* @return A pointer to the updated entry.
+*
+* @note   None.
+*
+******************************************************************************/
+static XHdcp22_Tx_PairingInfo *XHdcp22Tx_UpdatePairingInfo(
+	                          XHdcp22_Tx *InstancePtr,
+                              const XHdcp22_Tx_PairingInfo *PairingInfo,
+                              u8 Ready)
+{
+	XHdcp22_Tx_PairingInfo * PairingInfoPtr = NULL;
+
+	/* Find slot */
+	PairingInfoPtr = XHdcp22Tx_GetPairingInfoSlot(InstancePtr,
+	                                              PairingInfo->ReceiverId);
 
 	/* Copy pairing info*/
-	memcpy(PairingInfoPtr, PairingInfo, sizeof(XHdcp22_Tx_PairingInfo));
+	if (PairingInfoPtr != PairingInfo) {
+		memcpy(PairingInfoPtr, PairingInfo, sizeof(XHdcp22_Tx_PairingInfo));
+	}
 
 	/* Set table ready */
 	PairingInfoPtr->Ready = Ready;
+	XHdcp22Tx_UsePairingInfo(InstancePtr, PairingInfoPtr);
+
+	if ((Ready == TRUE) && (InstancePtr->IsPairingInfoUpdatedCallbackSet)) {
+		InstancePtr->PairingInfoUpdatedCallback(
+		                    InstancePtr->PairingInfoUpdatedCallbackRef);
+	}
 
 	return PairingInfoPtr;
 }
@@ -3957,6 +4131,7 @@ static XHdcp22_Tx_PairingInfo *XHdcp22Tx_UpdatePairingInfo(
 static void XHdcp22Tx_InvalidatePairingInfo(XHdcp22_Tx *InstancePtr,
 	                                        const u8* ReceiverId)
 {
+	u8 Ready;
 	XHdcp22_Tx_PairingInfo *InfoPtr = XHdcp22Tx_GetPairingInfo(InstancePtr,
 		                                                       ReceiverId);
 
@@ -3965,7 +4140,14 @@ static void XHdcp22Tx_InvalidatePairingInfo(XHdcp22_Tx *InstancePtr,
 		return;
 	}
 	/* clear the found structure */
+	Ready = InfoPtr->Ready;
 	memset(InfoPtr, 0x00, sizeof(XHdcp22_Tx_PairingInfo));
+
+	/* a stored entry is gone, the saved table is outdated */
+	if ((Ready == TRUE) && (InstancePtr->IsPairingInfoUpdatedCallbackSet)) {
+		InstancePtr->PairingInfoUpdatedCallback(
+		                    InstancePtr->PairingInfoUpdatedCallbackRef);
+	}
 }
 
 /*****************************************************************************/
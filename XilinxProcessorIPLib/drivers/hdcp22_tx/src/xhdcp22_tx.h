@@ -80,6 +80,7 @@
 * 2.01  MH     02/28/17 Fixed compiler warnings.
 * 2.20  MH     04/12/17 Added function XHdcp22Tx_IsDwnstrmCapable.
 * 2.30  MH     07/06/17 Changed default polling value to 10 ms.
+* 2.40  MH     10/14/19 Added LRU pairing info table and its save and restore.
 * </pre>
 *
 ******************************************************************************/
@@ -124,9 +125,12 @@ extern "C" {
 #define XHDCP22_TX_REVOCATION_LIST_MAX_DEVICES 944
 
 /**
-* The list of maximum pairing info items to store.
+* The list of maximum pairing info items to store. When the list is full the
+* least recently used item is replaced.
 */
-#define XHDCP22_TX_MAX_STORED_PAIRINGINFO  2
+#ifndef XHDCP22_TX_MAX_STORED_PAIRINGINFO
+#define XHDCP22_TX_MAX_STORED_PAIRINGINFO  8
+#endif
 
 /**
 * The size of the log buffer.
@@ -146,6 +150,7 @@ typedef enum
 	XHDCP22_TX_HANDLER_AUTHENTICATED,
 	XHDCP22_TX_HANDLER_UNAUTHENTICATED,
 	XHDCP22_TX_HANDLER_DOWNSTREAM_TOPOLOGY_AVAILABLE,
+	XHDCP22_TX_HANDLER_PAIRINGINFO_UPDATED,
 	XHDCP22_TX_HANDLER_INVALID
 } XHdcp22_Tx_HandlerType;
 
@@ -312,6 +317,7 @@ typedef struct {
 	u8 Rrx[8];           /**< Random nonce for Rx (m: Rtx || Rrx). */
 	u8 Km[16];           /**< Km. */
 	u8 Ekh_Km[16];       /**< Ekh(Km). */
+	u32 LastUsed;        /**< Age of the last use, for LRU replacement. */
      u8 Ready;            /**< Indicates a valid entry */
 } XHdcp22_Tx_PairingInfo;
 /**
@@ -332,6 +338,8 @@ typedef struct
 	u8 MsgAvailable;                    /**< Message is available for reading. */
 
 	XHdcp22_Tx_PairingInfo PairingInfo[XHDCP22_TX_MAX_STORED_PAIRINGINFO];
+	/** Age of the most recently used pairing info item. */
+	u32 PairingInfoAge;
 	/** The result after a call to #XHdcp22Tx_Poll. */
 	XHdcp22_Tx_AuthenticationType AuthenticationStatus;
 
@@ -538,6 +546,12 @@ typedef struct
 	u8 IsDownstreamTopologyAvailableCallbackSet;
 	void *DownstreamTopologyAvailableCallbackRef;
 
+	/** Function pointer called after the pairing info table is updated */
+	XHdcp22_Tx_Callback PairingInfoUpdatedCallback;
+	/** Set if PairingInfoUpdatedCallback handler is defined. */
+	u8 IsPairingInfoUpdatedCallbackSet;
+	void *PairingInfoUpdatedCallbackRef;
+
 	/** Internal used timer. */
 	XHdcp22_Tx_Timer Timer;
 
@@ -582,6 +596,12 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
                             UINTPTR EffectiveAddr);
 int XHdcp22Tx_Reset(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_ClearPairingInfo(XHdcp22_Tx *InstancePtr);
+u32 XHdcp22Tx_GetPairingInfoTable(XHdcp22_Tx *InstancePtr,
+                                  XHdcp22_Tx_PairingInfo *TablePtr,
+                                  u32 MaxEntries);
+int XHdcp22Tx_SetPairingInfoTable(XHdcp22_Tx *InstancePtr,
+                                  const XHdcp22_Tx_PairingInfo *TablePtr,
+                                  u32 NumEntries);
 int XHdcp22Tx_Authenticate (XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Poll(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Enable (XHdcp22_Tx *InstancePtr);
@@ -75,6 +75,7 @@
 * Ver   Who    Date     Changes
 * ----- ------ -------- --------------------------------------------------
 * 1.00  jb     02/21/19 Initial release
+* 1.01  jb     10/14/19 Added LRU pairing info table and its save and restore.
 * </pre>
 *
 ******************************************************************************/
@@ -119,9 +120,12 @@ extern "C" {
 #define XHDCP22_TX_REVOCATION_LIST_MAX_DEVICES 944
 
 /**
-* The list of maximum pairing info items to store.
+* The list of maximum pairing info items to store. When the list is full the
+* least recently used item is replaced.
 */
-#define XHDCP22_TX_MAX_STORED_PAIRINGINFO  2
+#ifndef XHDCP22_TX_MAX_STORED_PAIRINGINFO
+#define XHDCP22_TX_MAX_STORED_PAIRINGINFO  8
+#endif
 
 /**
 * The size of the log buffer.
@@ -174,6 +178,7 @@ typedef enum
 	XHDCP22_TX_HANDLER_DOWNSTREAM_TOPOLOGY_AVAILABLE,
 	XHDCP22_TX_HANDLER_DP_AUX_READ,		/**< Get the DP AUX register data*/
 	XHDCP22_TX_HANDLER_DP_AUX_WRITE,	/**< Set the DP AUX register data*/
+	XHDCP22_TX_HANDLER_PAIRINGINFO_UPDATED,
 	XHDCP22_TX_HANDLER_INVALID
 } XHdcp22_Tx_HandlerType;
 
@@ -348,6 +353,7 @@ typedef struct {
 	u8 Rrx[8];           /**< Random nonce for Rx (m: Rtx || Rrx). */
 	u8 Km[16];           /**< Km. */
 	u8 Ekh_Km[16];       /**< Ekh(Km). */
+	u32 LastUsed;        /**< Age of the last use, for LRU replacement. */
      u8 Ready;            /**< Indicates a valid entry */
 } XHdcp22_Tx_PairingInfo;
 /**
@@ -368,6 +374,8 @@ typedef struct
 	u8 MsgAvailable;                    /**< Message is available for reading. */
 
 	XHdcp22_Tx_PairingInfo PairingInfo[XHDCP22_TX_MAX_STORED_PAIRINGINFO];
+	/** Age of the most recently used pairing info item. */
+	u32 PairingInfoAge;
 	/** The result after a call to #XHdcp22Tx_Poll. */
 	XHdcp22_Tx_AuthenticationType AuthenticationStatus;
 
@@ -580,6 +588,12 @@ typedef struct
 	u8 IsDownstreamTopologyAvailableCallbackSet;
 	void *DownstreamTopologyAvailableCallbackRef;
 
+	/** Function pointer called after the pairing info table is updated */
+	XHdcp22_Tx_Callback PairingInfoUpdatedCallback;
+	/** Set if PairingInfoUpdatedCallback handler is defined. */
+	u8 IsPairingInfoUpdatedCallbackSet;
+	void *PairingInfoUpdatedCallbackRef;
+
 	/** Function pointer Used to Read DP AUX channel registers (Remote DPCD) */
 	Xhdcp22_Tx_RdWrHandler TxDpAuxReadCallback;
 	/** To be passed to callback function */
@@ -634,6 +648,12 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
                             UINTPTR EffectiveAddr);
 int XHdcp22Tx_Reset(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_ClearPairingInfo(XHdcp22_Tx *InstancePtr);
+u32 XHdcp22Tx_GetPairingInfoTable(XHdcp22_Tx *InstancePtr,
+                                  XHdcp22_Tx_PairingInfo *TablePtr,
+                                  u32 MaxEntries);
+int XHdcp22Tx_SetPairingInfoTable(XHdcp22_Tx *InstancePtr,
+                                  const XHdcp22_Tx_PairingInfo *TablePtr,
+                                  u32 NumEntries);
 int XHdcp22Tx_Authenticate (XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Poll(XHdcp22_Tx *InstancePtr);
 int XHdcp22Tx_Enable (XHdcp22_Tx *InstancePtr);
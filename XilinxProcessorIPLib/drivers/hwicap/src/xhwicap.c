@@ -81,6 +81,11 @@
 *			delay as per IP specifications
 * 11.2	Nava  02/01/19 Updated the Number of words per frame as mention in the
 *		       ug570
+* 11.2  Nava  10/14/19 In polled mode XHwIcap_DeviceWrite refills the Write
+*		       FIFO while the ICAP drains it instead of waiting for
+*		       the FIFO to be empty. Added XHwIcap_FillWrFifo.
+*		       XHwIcap_DeviceRead drains the Read FIFO in bursts and
+*		       returns XST_FAILURE when the Read FIFO stays empty.
 * </pre>
 *
 *****************************************************************************/
@@ -318,6 +323,7 @@ int XHwIcap_DeviceWrite(XHwIcap *InstancePtr, u32 *FrameBuffer, u32 NumWords)
 
 #if (XPAR_HWICAP_0_MODE == 0)
 	u32 WrFifoVacancy;
+	u32 RefillLevel;
 	u32 IntrStatus;
 #endif
 
@@ -419,97 +425,122 @@ int XHwIcap_DeviceWrite(XHwIcap *InstancePtr, u32 *FrameBuffer, u32 NumWords)
 #else
 	/* If FIFOs are enabled, fill the FIFO and initiate transfer */
 
+	/*
+	 * The Write FIFO is empty at this point, half of its vacancy is used
+	 * as the refill level in polled mode.
+	 */
 	WrFifoVacancy = XHwIcap_GetWrFifoVacancy(InstancePtr);
-	while ((WrFifoVacancy != 0) &&
-			(InstancePtr->RemainingWords > 0)) {
-
-		XHwIcap_FifoWrite(InstancePtr, *InstancePtr->SendBufferPtr);
-		InstancePtr->RemainingWords--;
-		WrFifoVacancy--;
-		InstancePtr->SendBufferPtr++;
+	RefillLevel = WrFifoVacancy >> 1;
+	if (RefillLevel == 0U) {
+		RefillLevel = 1U;
 	}
 
+	XHwIcap_FillWrFifo(InstancePtr, WrFifoVacancy);
+
 	/*
 	 * Start the transfer of the data from the FIFO to the ICAP device.
 	 */
 	XHwIcap_StartConfig(InstancePtr);
 
-	while ((XHwIcap_ReadReg(InstancePtr->HwIcapConfig.BaseAddress,
-				XHI_CR_OFFSET)) & XHI_CR_WRITE_MASK);
-	/*
-	 * Check if there is more data to be written to the ICAP
-	 */
-	if (InstancePtr->RemainingWords != 0U){
+	if ((InstancePtr->RemainingWords != 0U) &&
+			(InstancePtr->IsPolled == FALSE)) { /* Interrupt Mode */
+
+		while ((XHwIcap_ReadReg(InstancePtr->HwIcapConfig.BaseAddress,
+					XHI_CR_OFFSET)) & XHI_CR_WRITE_MASK);
 
 		/*
-		 * Check whether it is polled or interrupt mode of operation.
+		 * If it is interrupt mode of operation then the
+		 * transfer of the remaining data will be done in the
+		 * interrupt handler.
 		 */
-		if (InstancePtr->IsPolled == FALSE) { /* Interrupt Mode */
-
-			/*
-			 * If it is interrupt mode of operation then the
-			 * transfer of the remaining data will be done in the
-			 * interrupt handler.
-			 */
-
-			/*
-			 * Clear the interrupt status of the earlier interrupts
-			 */
-			IntrStatus  = XHwIcap_IntrGetStatus(InstancePtr);
-			XHwIcap_IntrClear(InstancePtr, IntrStatus);
-
-
-			/*
-			 * Enable the interrupts by enabling the
-			 * Global Interrupt.
-			 */
-			XHwIcap_IntrGlobalEnable(InstancePtr);
 
-		}
-
-		else { /* Polled Mode */
-
-			while (InstancePtr->RemainingWords > 0) {
+		/*
+		 * Clear the interrupt status of the earlier interrupts
+		 */
+		IntrStatus  = XHwIcap_IntrGetStatus(InstancePtr);
+		XHwIcap_IntrClear(InstancePtr, IntrStatus);
 
-				WrFifoVacancy =
-					XHwIcap_GetWrFifoVacancy(InstancePtr);
-				while ((WrFifoVacancy != 0) &&
-			       		(InstancePtr->RemainingWords > 0)) {
-					XHwIcap_FifoWrite(InstancePtr,
-						*InstancePtr->SendBufferPtr);
-					InstancePtr->RemainingWords--;
-					WrFifoVacancy--;
-					InstancePtr->SendBufferPtr++;
-				}
+		/*
+		 * Enable the interrupts by enabling the
+		 * Global Interrupt.
+		 */
+		XHwIcap_IntrGlobalEnable(InstancePtr);
+	}
+	else { /* Polled Mode */
 
+		/*
+		 * Top up the FIFO each time half of it has been sent, so
+		 * that the ICAP does not wait for the FIFO to be refilled.
+		 */
+		while (InstancePtr->RemainingWords > 0) {
+			WrFifoVacancy = XHwIcap_GetWrFifoVacancy(InstancePtr);
+			if (WrFifoVacancy >= RefillLevel) {
+				XHwIcap_FillWrFifo(InstancePtr, WrFifoVacancy);
 				XHwIcap_StartConfig(InstancePtr);
-				while ((XHwIcap_ReadReg(InstancePtr->
-					HwIcapConfig.BaseAddress,
-					XHI_CR_OFFSET)) & XHI_CR_WRITE_MASK);
-				}
-
-				/*
-		 		 * Clear the flag to indicate the write has
-		 		 * been done
-		 		 */
-				InstancePtr->IsTransferInProgress = FALSE;
-				InstancePtr->RequestedWords = 0x0;
 			}
 		}
 
-	else {
+		while ((XHwIcap_ReadReg(InstancePtr->HwIcapConfig.BaseAddress,
+					XHI_CR_OFFSET)) & XHI_CR_WRITE_MASK);
+
 		/*
 		 * Clear the flag to indicate the write has been done
 		 */
 		InstancePtr->IsTransferInProgress = FALSE;
 		InstancePtr->RequestedWords = 0x0;
-
 	}
 
 #endif
 	return XST_SUCCESS;
 }
 
+/****************************************************************************/
+/**
+*
+* This function writes the words remaining to be sent by XHwIcap_DeviceWrite
+* to the Write FIFO, up to the given vacancy of the FIFO. It does not start
+* the transfer to the ICAP device.
+*
+* @param	InstancePtr is a pointer to the XHwIcap instance.
+* @param	WrFifoVacancy is the number of words the Write FIFO can take.
+*
+* @return	None.
+*
+* @note		This function is used by XHwIcap_DeviceWrite and by the
+*		interrupt handler.
+*
+*****************************************************************************/
+void XHwIcap_FillWrFifo(XHwIcap *InstancePtr, u32 WrFifoVacancy)
+{
+	UINTPTR FifoAddr = InstancePtr->HwIcapConfig.BaseAddress +
+				XHI_WF_OFFSET;
+#if XPAR_HWICAP_0_ICAP_DWIDTH == 8
+	u8 *BufferPtr = InstancePtr->SendBufferPtr;
+#elif XPAR_HWICAP_0_ICAP_DWIDTH == 16
+	u16 *BufferPtr = InstancePtr->SendBufferPtr;
+#else
+	u32 *BufferPtr = InstancePtr->SendBufferPtr;
+#endif
+	u32 NumWords = InstancePtr->RemainingWords;
+
+	if (NumWords > WrFifoVacancy) {
+		NumWords = WrFifoVacancy;
+	}
+
+	/*
+	 * Update the instance first, the FIFO is written from local copies
+	 * which the compiler can keep in registers.
+	 */
+	InstancePtr->RemainingWords -= NumWords;
+	InstancePtr->SendBufferPtr += NumWords;
+
+	while (NumWords > 0U) {
+		XHwIcap_Out32(FifoAddr, *BufferPtr);
+		BufferPtr++;
+		NumWords--;
+	}
+}
+
 /****************************************************************************/
 /**
 *
@@ -545,6 +576,7 @@ int XHwIcap_DeviceRead(XHwIcap *InstancePtr, u32 *FrameBuffer, u32 NumWords)
 	u32 *Data = FrameBuffer;
 #endif
 	u32 RdFifoOccupancy = 0;
+	UINTPTR FifoAddr;
 
 	/*
 	 * Assert validates the input arguments
@@ -598,6 +630,8 @@ int XHwIcap_DeviceRead(XHwIcap *InstancePtr, u32 *FrameBuffer, u32 NumWords)
 
 	XHwIcap_StartReadBack(InstancePtr);
 
+	FifoAddr = InstancePtr->HwIcapConfig.BaseAddress + XHI_RF_OFFSET;
+
 	/*
 	 * Read the data from the Read FIFO into the buffer provided by
 	 * the user.
@@ -606,33 +640,41 @@ int XHwIcap_DeviceRead(XHwIcap *InstancePtr, u32 *FrameBuffer, u32 NumWords)
 	/* As long as there is still data to read... */
 	while (InstancePtr->RemainingWords > 0) {
 		/* Wait until we have some data in the fifo. */
-		while(RdFifoOccupancy == 0) {
-			RdFifoOccupancy =
-			XHwIcap_GetRdFifoOccupancy(InstancePtr);
+		RdFifoOccupancy = XHwIcap_GetRdFifoOccupancy(InstancePtr);
+		while (RdFifoOccupancy == 0) {
 			Retries++;
 			if (Retries > XHI_MAX_RETRIES) {
 				break;
 			}
+			RdFifoOccupancy =
+			XHwIcap_GetRdFifoOccupancy(InstancePtr);
+		}
+		if (RdFifoOccupancy == 0) {
+			break;
 		}
+		Retries = 0;
 
-		/* Read the data from the Read FIFO. */
-#if (XPAR_HWICAP_0_ICAP_DWIDTH == 8) || (XPAR_HWICAP_0_ICAP_DWIDTH == 16)
-		while((RdFifoOccupancy != 0) &&
-				(InstancePtr->RemainingWords > 0)) {
-			Data[Index] = XHwIcap_FifoRead(InstancePtr);
-			InstancePtr->RemainingWords--;
-			RdFifoOccupancy--;
-			Index++;
+		if (RdFifoOccupancy > InstancePtr->RemainingWords) {
+			RdFifoOccupancy = InstancePtr->RemainingWords;
 		}
-#else
-		while((RdFifoOccupancy != 0) &&
-				(InstancePtr->RemainingWords > 0)) {
-			*Data++ = XHwIcap_FifoRead(InstancePtr);
-			InstancePtr->RemainingWords--;
+		InstancePtr->RemainingWords -= RdFifoOccupancy;
+
+		/* Read the data from the Read FIFO in a burst. */
+		while (RdFifoOccupancy != 0) {
+			Data[Index] = XHwIcap_In32(FifoAddr);
 			RdFifoOccupancy--;
+			Index++;
 		}
-#endif
 	}
+
+	/*
+	 * If the requested number of words have not been read from
+	 * the device then indicate failure.
+	 */
+	if (InstancePtr->RemainingWords != 0){
+		return XST_FAILURE;
+	}
+
 	while ((XHwIcap_ReadReg(InstancePtr->HwIcapConfig.BaseAddress,
 			XHI_CR_OFFSET)) &
 			XHI_CR_READ_MASK);
@@ -658,14 +700,6 @@ int XHwIcap_DeviceRead(XHwIcap *InstancePtr, u32 *FrameBuffer, u32 NumWords)
 		}
 	}
 
-	/*
-	 * If the requested number of words have not been read from
-	 * the device then indicate failure.
-	 */
-	if (InstancePtr->RemainingWords != 0){
-		return XST_FAILURE;
-	}
-
 	InstancePtr->IsTransferInProgress = FALSE;
 	InstancePtr->RequestedWords = 0x0;
 
@@ -181,6 +181,8 @@
 * 11.2 Nava   02/08/19 The current version of the driver is not supported for
 *                      families older than 7 series.So removed .o referenced
 *                      function prototypes from the header file.
+* 11.2 Nava   10/14/19 Added XHwIcap_FillWrFifo, XHwIcap_DeviceReadFrames and
+*                      XHwIcap_DeviceWriteFrames.
 *
 * </pre>
 *
@@ -640,6 +642,7 @@ int XHwIcap_CfgInitialize(XHwIcap *InstancePtr, XHwIcap_Config *ConfigPtr,
 				UINTPTR EffectiveAddr);
 int XHwIcap_DeviceWrite(XHwIcap *InstancePtr, u32 *FrameBuffer, u32 NumWords);
 int XHwIcap_DeviceRead(XHwIcap *InstancePtr, u32 *FrameBuffer, u32 NumWords);
+void XHwIcap_FillWrFifo(XHwIcap *InstancePtr, u32 WrFifoVacancy);
 void XHwIcap_Reset(XHwIcap *InstancePtr);
 void XHwIcap_FlushFifo(XHwIcap *InstancePtr);
 void XHwIcap_Abort(XHwIcap *InstancePtr);
@@ -675,6 +678,10 @@ int XHwIcap_DeviceReadFrame(XHwIcap *InstancePtr, long Top,
 				long Block, long HClkRow,
 				long MajorFrame, long MinorFrame,
 				u32 *FrameBuffer);
+int XHwIcap_DeviceReadFrames(XHwIcap *InstancePtr, long Top,
+				long Block, long HClkRow,
+				long MajorFrame, long MinorFrame,
+				u32 NumFrames, u32 *FrameBuffer);
 
 /*
  * Functions in the xhwicap_device_write_frame.c
@@ -683,6 +690,10 @@ int XHwIcap_DeviceWriteFrame(XHwIcap *InstancePtr, long Top,
 				long Block, long HClkRow,
 				long MajorFrame, long MinorFrame,
 				u32 *FrameData);
+int XHwIcap_DeviceWriteFrames(XHwIcap *InstancePtr, long Top,
+				long Block, long HClkRow,
+				long MajorFrame, long MinorFrame,
+				u32 NumFrames, u32 *FrameData);
 
 /************************** Variable Declarations ***************************/
 
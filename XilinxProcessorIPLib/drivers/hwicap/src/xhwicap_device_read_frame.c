@@ -49,6 +49,8 @@
 * 6.00a hvm  08/01/11 Added support for K7
 * 10.0  bss  6/24/14  Removed support for families older than 7 series
 * 11.0  MNK  6/12/14  Added support for 8-series family devices.
+* 11.2  Nava 10/14/19 Added XHwIcap_DeviceReadFrames to read consecutive
+*		      frames with one FDRO packet.
 *
 * </pre>
 *
@@ -99,6 +101,40 @@ int XHwIcap_DeviceReadFrame(XHwIcap *InstancePtr, long Top, long Block,
 				long HClkRow, long MajorFrame, long MinorFrame,
 				u32 *FrameBuffer)
 {
+	return XHwIcap_DeviceReadFrames(InstancePtr, Top, Block, HClkRow,
+					MajorFrame, MinorFrame, 1U, FrameBuffer);
+}
+
+/****************************************************************************/
+/**
+*
+* Reads consecutive frames from the device and puts them in memory specified
+* by the user. The frames are read back with a single FDRO packet, so the
+* synchronization, the FAR setup and the DESYNC are done once for all the
+* frames.
+*
+* @param	InstancePtr - a pointer to the XHwIcap instance to be worked on.
+* @param	Top - top (0) or bottom (1) half of device
+* @param	Block - Block Address (XHI_FAR_CLB_BLOCK,
+*		XHI_FAR_BRAM_BLOCK, XHI_FAR_BRAM_INT_BLOCK)
+* @param	HClkRow - selects the HClk Row
+* @param	MajorFrame - selects the column
+* @param	MinorFrame - selects the first frame inside column
+* @param	NumFrames is the number of frames to read.
+* @param	FrameBuffer is a pointer to the memory where the frames read
+*		from the device are stored. It must hold NumFrames + 1 frames,
+*		the frames are preceded by a pad frame, and 10 more words for
+*		Ultrascale or 25 more words for Ultrascale plus devices.
+*
+* @return	XST_SUCCESS else XST_FAILURE.
+*
+* @note		This is a blocking call.
+*
+*****************************************************************************/
+int XHwIcap_DeviceReadFrames(XHwIcap *InstancePtr, long Top, long Block,
+				long HClkRow, long MajorFrame, long MinorFrame,
+				u32 NumFrames, u32 *FrameBuffer)
+{
 
 	u32 Packet;
 	u32 Data;
@@ -111,6 +147,7 @@ int XHwIcap_DeviceReadFrame(XHwIcap *InstancePtr, long Top, long Block,
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 	Xil_AssertNonvoid(FrameBuffer != NULL);
+	Xil_AssertNonvoid(NumFrames > 0U);
 
 	/*
 	 * DUMMY and SYNC
@@ -158,15 +195,17 @@ int XHwIcap_DeviceReadFrame(XHwIcap *InstancePtr, long Top, long Block,
 	 */
 	switch (InstancePtr->DeviceFamily) {
 		case DEVICE_TYPE_7SERIES :
-				TotalWords = InstancePtr->WordsPerFrame << 1;
+				TotalWords = InstancePtr->WordsPerFrame * (NumFrames + 1U);
 				NumNoops = 32;
 				break;
 		case DEVICE_TYPE_ULTRA :
-			TotalWords = (InstancePtr->WordsPerFrame << 1) + 10;
+			TotalWords = (InstancePtr->WordsPerFrame *
+				      (NumFrames + 1U)) + 10;
 			NumNoops = 64;
 				break;
 		case DEVICE_TYPE_ULTRA_PLUS :
-			TotalWords = (InstancePtr->WordsPerFrame << 1) + 25;
+			TotalWords = (InstancePtr->WordsPerFrame *
+				      (NumFrames + 1U)) + 25;
 			NumNoops = 64;
 				break;
 		default:
@@ -50,6 +50,8 @@
 *		      (CR560534)
 * 6.00a hvm  08/01/11 Added support for K7
 * 10.0  bss  6/24/14  Removed support for families older than 7 series
+* 11.2  Nava 10/14/19 Added XHwIcap_DeviceWriteFrames to write consecutive
+*		      frames with one FDRI packet.
 *
 *
 * </pre>
@@ -105,6 +107,41 @@ int XHwIcap_DeviceWriteFrame(XHwIcap *InstancePtr, long Top, long Block,
 				long HClkRow, long MajorFrame, long MinorFrame,
 				u32 *FrameData)
 {
+	return XHwIcap_DeviceWriteFrames(InstancePtr, Top, Block, HClkRow,
+					MajorFrame, MinorFrame, 1U, FrameData);
+}
+
+/****************************************************************************/
+/**
+*
+* Writes consecutive frames from the specified buffer and puts them in the
+* device (ICAP). The frames are sent with a single FDRI packet, so the
+* synchronization, the FAR setup and the DESYNC are done once for all the
+* frames.
+*
+* @param	InstancePtr is a pointer to the XHwIcap instance.
+* @param	Top - top (0) or bottom (1) half of device
+* @param	Block - Block Address (XHI_FAR_CLB_BLOCK,
+* 		XHI_FAR_BRAM_BLOCK, XHI_FAR_BRAM_INT_BLOCK)
+* @param	HClkRow - selects the HClk Row
+* @param	MajorFrame - selects the column
+* @param	MinorFrame - selects the first frame inside column
+* @param	NumFrames is the number of frames to write.
+* @param	FrameData is a pointer to the frames that are to be written
+*		to the device. As for XHwIcap_DeviceWriteFrame, the pad frame
+*		comes first and is followed by the NumFrames data frames.
+*
+* @return	XST_SUCCESS else XST_FAILURE.
+*
+* @note		This is a blocking function.
+*		This function is used to write back the frames of data read
+*		using the XHwIcap_DeviceReadFrames.
+*
+*****************************************************************************/
+int XHwIcap_DeviceWriteFrames(XHwIcap *InstancePtr, long Top, long Block,
+				long HClkRow, long MajorFrame, long MinorFrame,
+				u32 NumFrames, u32 *FrameData)
+{
 
 	u32 Packet;
 	u32 Data;
@@ -116,6 +153,7 @@ int XHwIcap_DeviceWriteFrame(XHwIcap *InstancePtr, long Top, long Block,
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 	Xil_AssertNonvoid(FrameData != NULL);
+	Xil_AssertNonvoid(NumFrames > 0U);
 
 
 	/*
@@ -170,7 +208,7 @@ int XHwIcap_DeviceWriteFrame(XHwIcap *InstancePtr, long Top, long Block,
 	/*
 	 * Setup Packet header.
 	 */
-	TotalWords = InstancePtr->WordsPerFrame << 1;
+	TotalWords = InstancePtr->WordsPerFrame * (NumFrames + 1U);
 	if (TotalWords < XHI_TYPE_1_PACKET_MAX_WORDS)  {
 		/*
 		 * Create Type 1 Packet.
@@ -204,7 +242,7 @@ int XHwIcap_DeviceWriteFrame(XHwIcap *InstancePtr, long Top, long Block,
 	 */
 	Status = XHwIcap_DeviceWrite(InstancePtr,
 				(u32 *) &FrameData[InstancePtr->WordsPerFrame],
-				InstancePtr->WordsPerFrame);
+				InstancePtr->WordsPerFrame * NumFrames);
 	if (Status != XST_SUCCESS) {
 		return XST_FAILURE;
 	}
@@ -48,6 +48,7 @@
 * ----- -----  -------- -----------------------------------------------------
 * 2.00a  sv    09/22/07 First release
 * 4.00a  hvm   12/1/09  Updated with HAL phase 1 changes
+* 11.2   Nava  10/14/19 Use XHwIcap_FillWrFifo to refill the Write FIFO.
 *
 * </pre>
 *
@@ -124,7 +125,6 @@ void XHwIcap_IntrHandler(void *InstancePtr)
 {
 	XHwIcap *HwIcapPtr = (XHwIcap *) InstancePtr;
 	u32 IntrStatus;
-	u32 WrFifoVacancy;
 
 
 	Xil_AssertVoid(InstancePtr != NULL);
@@ -148,16 +148,8 @@ void XHwIcap_IntrHandler(void *InstancePtr)
 			 * as many as we have to write). We can use the Write
 			 * FIFO vacancy to know if the device can take more data.
 			 */
-			WrFifoVacancy = XHwIcap_GetWrFifoVacancy(HwIcapPtr);
-			while ((WrFifoVacancy != 0) &&
-			       (HwIcapPtr->RemainingWords > 0)) {
-				XHwIcap_FifoWrite(HwIcapPtr,
-						*HwIcapPtr->SendBufferPtr);
-
-				HwIcapPtr->RemainingWords--;
-				WrFifoVacancy--;
-				HwIcapPtr->SendBufferPtr++;
-			}
+			XHwIcap_FillWrFifo(HwIcapPtr,
+					XHwIcap_GetWrFifoVacancy(HwIcapPtr));
 
 			XHwIcap_StartConfig(HwIcapPtr);
 		}
@@ -49,6 +49,7 @@
 *				12/06/14 Implemented Repeated start feature.
 *				01/31/15 Modified the code according to MISRAC 2012 Compliant.
 * 3.3   kvn		05/05/16 Modified latest code for MISRA-C:2012 Compliance.
+* 3.10  adk		10/15/19 Initialize the transaction list pointer.
 *
 * </pre>
 *
@@ -116,6 +117,7 @@ s32 XIicPs_CfgInitialize(XIicPs *InstancePtr, XIicPs_Config *ConfigPtr,
 	InstancePtr->Config.InputClockHz = ConfigPtr->InputClockHz;
 	InstancePtr->StatusHandler = StubHandler;
 	InstancePtr->CallBackRef = NULL;
+	InstancePtr->XferPtr = NULL;
 
 	InstancePtr->IsReady = (u32)XIL_COMPONENT_IS_READY;
 
@@ -137,6 +137,17 @@
 * bit is set. Due to this errata, repeated start cannot be used if a receive
 * transfer is followed by any other transfer.
 *
+*<b>Transaction Lists</b>
+*
+* XIicPs_MasterXferPolled() and XIicPs_MasterXfer() execute a list of
+* XIicPs_Xfer transactions, each one a write, a read or a write followed by
+* a read from the same slave with a repeated start in between, as used to
+* read sensor and PMBus registers. Each transaction ends with a stop and
+* records its own status, so that a slave which does not respond does not
+* prevent the rest of the list from being executed. In interrupt mode the
+* transactions are chained by the interrupt handler and the status handler
+* is called once, with XIICPS_EVENT_COMPLETE_XFER, when the list is done.
+*
 * <pre> MODIFICATION HISTORY:
 *
 * Ver   Who     Date     Changes
@@ -185,6 +196,8 @@
 * 3.8   ask  08/01/18   Fix for Cppcheck and Doxygen warnings
 * 3.8   sd 09/06/18  Enable the Timeout interrupt
 * 3.9   sg 03/09/19  Added arbitration lost support in polled transfer
+* 3.10  adk 10/15/19 Added transaction list transfers with repeated start
+*                    between the write and read of a transaction.
 *
 * </pre>
 *
@@ -239,6 +252,7 @@ extern "C" {
 #define XIICPS_EVENT_RX_OVR			0x0080U  /**< RX overflow */
 #define XIICPS_EVENT_TX_OVR			0x0100U  /**< TX overflow */
 #define XIICPS_EVENT_RX_UNF			0x0200U  /**< RX underflow */
+#define XIICPS_EVENT_COMPLETE_XFER	0x0400U  /**< Transaction list done */
 /*@}*/
 
 /** @name Role constants
@@ -276,6 +290,21 @@ typedef struct {
 	u32 InputClockHz; /**< Input clock frequency */
 } XIicPs_Config;
 
+/**
+ * A transaction of a transaction list. WrCount bytes are written to the
+ * slave, then RdCount bytes are read from it after a repeated start. Either
+ * count may be zero.
+ */
+typedef struct {
+	u16 SlaveAddr;	/**< Address of the slave */
+	u8 *WrBufPtr;	/**< Bytes to write, e.g. a register or command */
+	s32 WrCount;	/**< Number of bytes to write */
+	u8 *RdBufPtr;	/**< Buffer for the bytes read */
+	s32 RdCount;	/**< Number of bytes to read */
+	s32 Status;	/**< XST_SUCCESS, XST_FAILURE or XST_IIC_ARB_LOST once
+			  *  the transaction is executed */
+} XIicPs_Xfer;
+
 /**
  * The XIicPs driver instance data. The user is required to allocate a
  * variable of this type for each IIC device in the system. A pointer
@@ -298,6 +327,12 @@ typedef struct {
 
 	XIicPs_IntrHandler StatusHandler;  /* Event handler function */
 	void *CallBackRef;	/* Callback reference for event handler */
+
+	XIicPs_Xfer *XferPtr;	/* Transaction list being executed */
+	u32 XferCount;		/* Number of transactions in the list */
+	u32 XferIndex;		/* Transaction being executed */
+	s32 XferIsRead;		/* Read of the transaction in progress */
+	s32 XferRepStart;	/* Repeated start option of the user */
 } XIicPs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -389,6 +424,15 @@ void XIicPs_EnableSlaveMonitor(XIicPs *InstancePtr, u16 SlaveAddr);
 void XIicPs_DisableSlaveMonitor(XIicPs *InstancePtr);
 void XIicPs_MasterInterruptHandler(XIicPs *InstancePtr);
 
+/*
+ * Functions for transaction lists, in xiicps_xfer.c
+ */
+s32 XIicPs_MasterXferPolled(XIicPs *InstancePtr, XIicPs_Xfer *XferPtr,
+		u32 XferCount);
+s32 XIicPs_MasterXfer(XIicPs *InstancePtr, XIicPs_Xfer *XferPtr,
+		u32 XferCount);
+u32 XIicPs_XferHandler(XIicPs *InstancePtr, u32 StatusEvent);
+
 /*
  * Functions for device as slave, in xiicps_slave.c
  */
@@ -61,6 +61,8 @@
 * 		     before slave address. Fix for CR996440.
 * 3.8   sd 09/06/18  Enable the Timeout interrupt
 * 3.9   sg 03/09/19  Added arbitration lost support in polled transfer
+* 3.10  adk 10/15/19 Pass the events of a transaction list to
+*                    XIicPs_XferHandler.
 * </pre>
 *
 ******************************************************************************/
@@ -918,6 +920,14 @@ void XIicPs_MasterInterruptHandler(XIicPs *InstancePtr)
 		StatusEvent |= XIICPS_EVENT_ERROR;
 	}
 
+	/*
+	 * Events of a transaction list are handled by the list, which only
+	 * reports when the list is done.
+	 */
+	if ((InstancePtr->XferPtr != NULL) && (StatusEvent != 0U)) {
+		StatusEvent = XIicPs_XferHandler(InstancePtr, StatusEvent);
+	}
+
 	/*
 	 * Signal application if there are any events.
 	 */
@@ -0,0 +1,351 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xiicps_xfer.c
+* @addtogroup iicps_v3_10
+* @{
+*
+* Contains functions of the XIicPs driver to execute transaction lists in
+* master mode. See xiicps.h for a detailed description of the device and
+* driver.
+*
+* <pre> MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------
+* 3.10  adk     10/15/19 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xiicps.h"
+
+/************************** Constant Definitions *****************************/
+
+/*
+ * Number of bus busy checks made after a transaction, for the stop condition
+ * to complete.
+ */
+#define XIICPS_XFER_IDLE_POLLS		100000U
+
+/*
+ * Events which terminate a transaction with an error.
+ */
+#define XIICPS_XFER_ERROR_EVENTS	(XIICPS_EVENT_ERROR | \
+					 XIICPS_EVENT_NACK | \
+					 XIICPS_EVENT_ARB_LOST | \
+					 XIICPS_EVENT_TIME_OUT)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static void XIicPs_XferRelease(XIicPs *InstancePtr);
+static void XIicPs_XferStart(XIicPs *InstancePtr);
+
+/************************* Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+* This function executes a list of transactions in polled mode.
+*
+* The write and the read of a transaction are separated by a repeated start,
+* and each transaction ends with a stop. A failed transaction does not stop
+* the execution of the list.
+*
+* @param	InstancePtr is a pointer to the XIicPs instance.
+* @param	XferPtr is a pointer to the first transaction of the list. The
+*		Status of each transaction is updated.
+* @param	XferCount is the number of transactions in the list.
+*
+* @return
+*		- XST_SUCCESS if all the transactions succeeded.
+*		- XST_FAILURE if at least one transaction failed.
+*
+* @note		This routine is for polled mode transfer only.
+*
+****************************************************************************/
+s32 XIicPs_MasterXferPolled(XIicPs *InstancePtr, XIicPs_Xfer *XferPtr,
+		u32 XferCount)
+{
+	XIicPs_Xfer *CurrPtr;
+	u32 Index;
+	s32 RepStart;
+	s32 Status;
+	s32 Result = (s32)XST_SUCCESS;
+
+	/*
+	 * Assert validates the input arguments.
+	 */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(XferPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(InstancePtr->XferPtr == NULL);
+
+	RepStart = InstancePtr->IsRepeatedStart;
+
+	for (Index = 0U; Index < XferCount; Index++) {
+		CurrPtr = &XferPtr[Index];
+		Status = (s32)XST_SUCCESS;
+
+		/*
+		 * Hold the bus after the write when a read follows.
+		 */
+		if (CurrPtr->WrCount > 0) {
+			InstancePtr->IsRepeatedStart =
+				(CurrPtr->RdCount > 0) ? 1 : 0;
+			Status = XIicPs_MasterSendPolled(InstancePtr,
+					CurrPtr->WrBufPtr, CurrPtr->WrCount,
+					CurrPtr->SlaveAddr);
+		}
+
+		if ((Status == (s32)XST_SUCCESS) && (CurrPtr->RdCount > 0)) {
+			InstancePtr->IsRepeatedStart = 0;
+			Status = XIicPs_MasterRecvPolled(InstancePtr,
+					CurrPtr->RdBufPtr, CurrPtr->RdCount,
+					CurrPtr->SlaveAddr);
+		}
+
+		if (Status != (s32)XST_SUCCESS) {
+			Result = (s32)XST_FAILURE;
+		}
+		CurrPtr->Status = Status;
+
+		XIicPs_XferRelease(InstancePtr);
+	}
+
+	InstancePtr->IsRepeatedStart = RepStart;
+
+	return Result;
+}
+
+/*****************************************************************************/
+/**
+* This function starts the execution of a list of transactions in interrupt
+* mode.
+*
+* The transactions are chained by the interrupt handler, which calls the
+* status handler once all of them are done with XIICPS_EVENT_COMPLETE_XFER,
+* and with XIICPS_EVENT_ERROR as well if any transaction failed. The events
+* of the individual transfers are not reported.
+*
+* @param	InstancePtr is a pointer to the XIicPs instance.
+* @param	XferPtr is a pointer to the first transaction of the list. It
+*		must remain valid until the list is done.
+* @param	XferCount is the number of transactions in the list.
+*
+* @return
+*		- XST_SUCCESS if the list is started.
+*		- XST_DEVICE_BUSY if a list is already being executed.
+*
+* @note		On Zynq the hold bit is released at the end of a write shorter
+*		than the FIFO, so the read of the transaction is preceded by a
+*		stop instead of a repeated start.
+*
+****************************************************************************/
+s32 XIicPs_MasterXfer(XIicPs *InstancePtr, XIicPs_Xfer *XferPtr,
+		u32 XferCount)
+{
+	/*
+	 * Assert validates the input arguments.
+	 */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(XferPtr != NULL);
+	Xil_AssertNonvoid(XferCount > 0U);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->XferPtr != NULL) {
+		return (s32)XST_DEVICE_BUSY;
+	}
+
+	InstancePtr->XferRepStart = InstancePtr->IsRepeatedStart;
+	InstancePtr->XferCount = XferCount;
+	InstancePtr->XferIndex = 0U;
+	InstancePtr->XferIsRead = 0;
+	InstancePtr->XferPtr = XferPtr;
+
+	XIicPs_XferStart(InstancePtr);
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function handles the events of a transaction list. It is invoked by
+* the master interrupt handler while a list is being executed.
+*
+* @param	InstancePtr is a pointer to the XIicPs instance.
+* @param	StatusEvent is the events of the current transfer.
+*
+* @return	The events to report to the status handler, 0 until the list
+*		is done.
+*
+* @note		None.
+*
+****************************************************************************/
+u32 XIicPs_XferHandler(XIicPs *InstancePtr, u32 StatusEvent)
+{
+	XIicPs_Xfer *CurrPtr;
+	u32 Index;
+	u32 Event;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	CurrPtr = &InstancePtr->XferPtr[InstancePtr->XferIndex];
+
+	if ((StatusEvent & XIICPS_XFER_ERROR_EVENTS) != 0U) {
+		if ((StatusEvent & XIICPS_EVENT_ARB_LOST) != 0U) {
+			CurrPtr->Status = (s32)XST_IIC_ARB_LOST;
+		} else {
+			CurrPtr->Status = (s32)XST_FAILURE;
+		}
+	} else if (((StatusEvent & XIICPS_EVENT_COMPLETE_SEND) != 0U) &&
+			(InstancePtr->XferIsRead == 0) && (CurrPtr->RdCount > 0)) {
+		/*
+		 * Write done, read from the held bus.
+		 */
+		InstancePtr->XferIsRead = 1;
+		XIicPs_XferStart(InstancePtr);
+		return 0U;
+	} else if ((StatusEvent & (XIICPS_EVENT_COMPLETE_SEND |
+			XIICPS_EVENT_COMPLETE_RECV)) != 0U) {
+		CurrPtr->Status = (s32)XST_SUCCESS;
+	} else {
+		/*
+		 * Nothing to do for the other events.
+		 */
+		return 0U;
+	}
+
+	XIicPs_XferRelease(InstancePtr);
+
+	InstancePtr->XferIndex++;
+	InstancePtr->XferIsRead = 0;
+	if (InstancePtr->XferIndex < InstancePtr->XferCount) {
+		XIicPs_XferStart(InstancePtr);
+		return 0U;
+	}
+
+	/*
+	 * The list is done.
+	 */
+	Event = XIICPS_EVENT_COMPLETE_XFER;
+	for (Index = 0U; Index < InstancePtr->XferCount; Index++) {
+		if (InstancePtr->XferPtr[Index].Status != (s32)XST_SUCCESS) {
+			Event |= XIICPS_EVENT_ERROR;
+		}
+	}
+	InstancePtr->IsRepeatedStart = InstancePtr->XferRepStart;
+	InstancePtr->XferPtr = NULL;
+
+	return Event;
+}
+
+/*****************************************************************************/
+/*
+* This function starts the next transfer of the current transaction, the
+* write or the read.
+*
+* @param	InstancePtr is a pointer to the XIicPs instance.
+*
+* @return	None.
+*
+* @note		Transactions with nothing to transfer complete immediately.
+*
+****************************************************************************/
+static void XIicPs_XferStart(XIicPs *InstancePtr)
+{
+	XIicPs_Xfer *CurrPtr;
+
+	while (InstancePtr->XferIndex < InstancePtr->XferCount) {
+		CurrPtr = &InstancePtr->XferPtr[InstancePtr->XferIndex];
+
+		if ((InstancePtr->XferIsRead == 0) && (CurrPtr->WrCount > 0)) {
+			InstancePtr->IsRepeatedStart =
+				(CurrPtr->RdCount > 0) ? 1 : 0;
+			XIicPs_MasterSend(InstancePtr, CurrPtr->WrBufPtr,
+					CurrPtr->WrCount, CurrPtr->SlaveAddr);
+			return;
+		}
+
+		if (CurrPtr->RdCount > 0) {
+			InstancePtr->XferIsRead = 1;
+			InstancePtr->IsRepeatedStart = 0;
+			XIicPs_MasterRecv(InstancePtr, CurrPtr->RdBufPtr,
+					CurrPtr->RdCount, CurrPtr->SlaveAddr);
+			return;
+		}
+
+		CurrPtr->Status = (s32)XST_SUCCESS;
+		InstancePtr->XferIndex++;
+		InstancePtr->XferIsRead = 0;
+	}
+
+	/*
+	 * Only empty transactions were left, the handler will not be called
+	 * for them.
+	 */
+	InstancePtr->IsRepeatedStart = InstancePtr->XferRepStart;
+	InstancePtr->XferPtr = NULL;
+	InstancePtr->StatusHandler(InstancePtr->CallBackRef,
+			XIICPS_EVENT_COMPLETE_XFER);
+}
+
+/*****************************************************************************/
+/*
+* This function ends a transaction. The hold bit is released so that a stop
+* is sent if the transaction failed with the bus held, then the bus is given
+* a bounded time to become idle before the next transaction.
+*
+* @param	InstancePtr is a pointer to the XIicPs instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void XIicPs_XferRelease(XIicPs *InstancePtr)
+{
+	u32 BaseAddr = InstancePtr->Config.BaseAddress;
+	u32 Polls = XIICPS_XFER_IDLE_POLLS;
+
+	XIicPs_WriteReg(BaseAddr, XIICPS_CR_OFFSET,
+			XIicPs_ReadReg(BaseAddr, XIICPS_CR_OFFSET) &
+					(~XIICPS_CR_HOLD_MASK));
+
+	while ((XIicPs_BusIsBusy(InstancePtr) == (s32)1) && (Polls > 0U)) {
+		Polls--;
+	}
+}
+/** @} */
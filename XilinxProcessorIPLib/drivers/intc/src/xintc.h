@@ -198,6 +198,9 @@
 * 		           driver tcl.
 * 3.1     adk    8/4/14    Fixed the CR:783248 Changes are made in
 *			   the test-app tcl
+* 3.10    adk    10/15/19  Added XIntc_ConnectVectored in xintc_fast.c to
+*			   dispatch normal handlers through per source fast
+*			   interrupt vectors, optionally nested.
 * 3.2     bss    4/8/14    Fixed driver tcl to handle external interrupt pins
 *			   correctly (CR#799609).
 * 3.3     adk    11/3/14   added generation of C_HAS_ILR parameter to
@@ -354,6 +357,15 @@ int XIntc_ConnectFastHandler(XIntc *InstancePtr, u8 Id,
 				XFastInterruptHandler Handler);
 void XIntc_SetNormalIntrMode(XIntc *InstancePtr, u8 Id);
 
+/*
+ * Vectored fast interrupt functions in xintc_fast.c
+ */
+#ifdef __MICROBLAZE__
+int XIntc_ConnectVectored(XIntc *InstancePtr, u8 Id,
+			  XInterruptHandler Handler, void *CallBackRef,
+			  u8 Nested);
+#endif
+
 /*
  * Interrupt functions in xintr_intr.c
  */
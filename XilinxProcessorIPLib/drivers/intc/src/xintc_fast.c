@@ -0,0 +1,265 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xintc_fast.c
+* @addtogroup intc_v3_9
+* @{
+*
+* This file contains the vectored fast interrupt dispatch of the XIntc driver.
+*
+* XIntc_ConnectFastHandler() requires a handler declared with the
+* fast_interrupt attribute for every source. XIntc_ConnectVectored() instead
+* connects a normal XInterruptHandler and its callback reference, like
+* XIntc_Connect(), and points the vector of the source to a fast interrupt
+* stub of this file. The processor then branches to the stub of the source
+* and the stub calls the handler directly, without reading the interrupt
+* status and looping over the pending sources. The interrupt is acknowledged
+* by the processor on entry, as for any fast interrupt.
+*
+* When the controller has the Interrupt Level Register, a source can be
+* connected as nested: its stub raises the interrupt level to the source and
+* enables the processor interrupts while the handler runs, so that higher
+* priority (lower numbered) sources preempt it.
+*
+* Vectored dispatch is supported for the 32 sources of a single controller,
+* not cascaded controllers, and requires fast interrupts to be enabled in the
+* hardware.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------------
+* 3.10  adk  10/15/19 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+#include "xil_assert.h"
+#include "xil_exception.h"
+#include "xparameters.h"
+#include "xintc.h"
+#include "xintc_i.h"
+
+#ifdef __MICROBLAZE__
+#include "mb_interface.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Declares and defines the fast interrupt stub of a source
+ */
+#define XINTC_FAST_STUB(Id) \
+	static void XIntc_FastStub##Id(void) __attribute__ ((fast_interrupt)); \
+	static void XIntc_FastStub##Id(void) \
+	{ \
+		XIntc_FastDispatch(Id); \
+	}
+
+/************************** Function Prototypes ******************************/
+
+static inline void XIntc_FastDispatch(u32 Id);
+
+/************************** Variable Definitions *****************************/
+
+static XIntc_Config *XIntc_FastCfgPtr; /* Controller using the stubs */
+static u32 XIntc_FastNestMask; /* Sources dispatched as nested */
+
+/*****************************************************************************/
+/**
+*
+* Calls the handler connected to a source from its fast interrupt stub.
+*
+* @param	Id is the ID of the interrupt source.
+*
+* @return	None.
+*
+* @note		For nested sources, r14 and the Interrupt Level Register are
+*		saved on entry and restored on exit, as in
+*		XIntc_DeviceInterruptHandler().
+*
+******************************************************************************/
+static inline void XIntc_FastDispatch(u32 Id)
+{
+	XIntc_VectorTableEntry *TablePtr =
+			&(XIntc_FastCfgPtr->HandlerTable[Id]);
+
+#if XPAR_XINTC_HAS_ILR == TRUE
+	if ((XIntc_FastNestMask & XIntc_BitPosMask[Id]) != 0U) {
+		volatile u32 R14_register;
+		volatile u32 ILR_reg;
+		UINTPTR BaseAddress = XIntc_FastCfgPtr->BaseAddress;
+
+		/* Save r14 register and ILR */
+		R14_register = mfgpr(r14);
+		ILR_reg = Xil_In32(BaseAddress + XIN_ILR_OFFSET);
+
+		/* Block this source and the lower priority ones */
+		Xil_Out32(BaseAddress + XIN_ILR_OFFSET, Id);
+		(void)Xil_In32(BaseAddress + XIN_ILR_OFFSET);
+		Xil_ExceptionEnable();
+
+		TablePtr->Handler(TablePtr->CallBackRef);
+
+		Xil_ExceptionDisable();
+		Xil_Out32(BaseAddress + XIN_ILR_OFFSET, ILR_reg);
+		mtgpr(r14, R14_register);
+		return;
+	}
+#endif
+
+	TablePtr->Handler(TablePtr->CallBackRef);
+}
+
+XINTC_FAST_STUB(0)
+XINTC_FAST_STUB(1)
+XINTC_FAST_STUB(2)
+XINTC_FAST_STUB(3)
+XINTC_FAST_STUB(4)
+XINTC_FAST_STUB(5)
+XINTC_FAST_STUB(6)
+XINTC_FAST_STUB(7)
+XINTC_FAST_STUB(8)
+XINTC_FAST_STUB(9)
+XINTC_FAST_STUB(10)
+XINTC_FAST_STUB(11)
+XINTC_FAST_STUB(12)
+XINTC_FAST_STUB(13)
+XINTC_FAST_STUB(14)
+XINTC_FAST_STUB(15)
+XINTC_FAST_STUB(16)
+XINTC_FAST_STUB(17)
+XINTC_FAST_STUB(18)
+XINTC_FAST_STUB(19)
+XINTC_FAST_STUB(20)
+XINTC_FAST_STUB(21)
+XINTC_FAST_STUB(22)
+XINTC_FAST_STUB(23)
+XINTC_FAST_STUB(24)
+XINTC_FAST_STUB(25)
+XINTC_FAST_STUB(26)
+XINTC_FAST_STUB(27)
+XINTC_FAST_STUB(28)
+XINTC_FAST_STUB(29)
+XINTC_FAST_STUB(30)
+XINTC_FAST_STUB(31)
+
+static const XFastInterruptHandler XIntc_FastStubTable[XIN_CONTROLLER_MAX_INTRS] = {
+	XIntc_FastStub0, XIntc_FastStub1, XIntc_FastStub2, XIntc_FastStub3,
+	XIntc_FastStub4, XIntc_FastStub5, XIntc_FastStub6, XIntc_FastStub7,
+	XIntc_FastStub8, XIntc_FastStub9, XIntc_FastStub10, XIntc_FastStub11,
+	XIntc_FastStub12, XIntc_FastStub13, XIntc_FastStub14, XIntc_FastStub15,
+	XIntc_FastStub16, XIntc_FastStub17, XIntc_FastStub18, XIntc_FastStub19,
+	XIntc_FastStub20, XIntc_FastStub21, XIntc_FastStub22, XIntc_FastStub23,
+	XIntc_FastStub24, XIntc_FastStub25, XIntc_FastStub26, XIntc_FastStub27,
+	XIntc_FastStub28, XIntc_FastStub29, XIntc_FastStub30, XIntc_FastStub31
+};
+
+/*****************************************************************************/
+/**
+*
+* Connects a normal interrupt handler to a source and dispatches the source
+* through its own fast interrupt vector. The handler is stored in the vector
+* table as by XIntc_Connect() and the source is switched to fast interrupt
+* mode with XIntc_ConnectFastHandler(). Use XIntc_SetNormalIntrMode() to go
+* back to the dispatch by XIntc_DeviceInterruptHandler().
+*
+* @param	InstancePtr is a pointer to the XIntc instance to be worked on.
+* @param	Id contains the ID of the interrupt source and should be in the
+*		range of 0 to 31 with 0 being the highest priority interrupt.
+* @param	Handler to the handler for that interrupt.
+* @param	CallBackRef is the callback reference, usually the instance
+*		pointer of the connecting driver.
+* @param	Nested is TRUE to let higher priority sources preempt the
+*		handler. It requires the Interrupt Level Register.
+*
+* @return
+*		- XST_SUCCESS if the source is connected.
+*		- XST_INVALID_PARAM if the source is beyond the first
+*		controller, nesting is requested without Interrupt Level
+*		Register, or another controller already uses vectored
+*		dispatch.
+*		- XST_FAILURE if fast interrupts are not enabled.
+*
+* @note
+*		The stubs are shared by all the sources with the same ID, so
+*		vectored dispatch is available to one controller.
+*
+* WARNING: The handler provided as an argument will overwrite any handler
+* that was previously connected.
+*
+****************************************************************************/
+int XIntc_ConnectVectored(XIntc *InstancePtr, u8 Id,
+			  XInterruptHandler Handler, void *CallBackRef,
+			  u8 Nested)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Handler != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->CfgPtr->FastIntr != TRUE) {
+		return XST_FAILURE;
+	}
+	if ((Id >= XIN_CONTROLLER_MAX_INTRS) ||
+	    (Id >= InstancePtr->CfgPtr->NumberofIntrs) ||
+	    (InstancePtr->CfgPtr->IntcType != XIN_INTC_NOCASCADE)) {
+		return XST_INVALID_PARAM;
+	}
+#if XPAR_XINTC_HAS_ILR != TRUE
+	if (Nested != FALSE) {
+		return XST_INVALID_PARAM;
+	}
+#endif
+	if ((XIntc_FastCfgPtr != NULL) &&
+	    (XIntc_FastCfgPtr != InstancePtr->CfgPtr)) {
+		return XST_INVALID_PARAM;
+	}
+	XIntc_FastCfgPtr = InstancePtr->CfgPtr;
+
+	InstancePtr->CfgPtr->HandlerTable[Id].Handler = Handler;
+	InstancePtr->CfgPtr->HandlerTable[Id].CallBackRef = CallBackRef;
+
+	if (Nested != FALSE) {
+		XIntc_FastNestMask |= XIntc_BitPosMask[Id];
+	} else {
+		XIntc_FastNestMask &= ~XIntc_BitPosMask[Id];
+	}
+
+	return XIntc_ConnectFastHandler(InstancePtr, Id,
+					XIntc_FastStubTable[Id]);
+}
+#endif /* __MICROBLAZE__ */
+/** @} */
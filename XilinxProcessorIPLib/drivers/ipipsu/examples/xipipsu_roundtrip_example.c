@@ -0,0 +1,290 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+* @file xipipsu_roundtrip_example.c
+*
+* This file consists of a round trip benchmark which uses the fast path APIs
+* of the XIpiPsu driver to send IPI messages to self and measure the time
+* taken until each one is acknowledged.
+* Example control flow:
+* - Init the IPI and GIC drivers
+* - Setup Interrupt System with IPI handler which copies the received message
+*   to the response buffer and acknowledges it
+* - Send TEST_ITERATIONS messages to self with XIpiPsu_SendMessage(), waiting
+*   for each one with XIpiPsu_PollForAckSpin() and checking the response
+* - Print the round trip statistics of the channel
+*
+* On A53 the round trips are measured in ticks of the generic timer. On other
+* processors they are measured in Observation register reads.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver  Who Date     Changes
+* ---- --- -------- --------------------------------------------------
+* 2.5  adk 10/15/19 First release
+* </pre>
+*
+******************************************************************************/
+/*****************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_exception.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+#include "xscugic.h"
+#include "xipipsu.h"
+#include "xipipsu_hw.h"
+#ifdef __aarch64__
+#include "xtime_l.h"
+#endif
+
+/************************* Test Configuration ********************************/
+/* IPI device ID to use for this test */
+#define TEST_CHANNEL_ID	XPAR_XIPIPSU_0_DEVICE_ID
+/* Test message length in words. Max is 8 words (32 bytes) */
+#define TEST_MSG_LEN	8
+/* Number of round trips measured */
+#define TEST_ITERATIONS	1000
+/* Interrupt Controller device ID */
+#define INTC_DEVICE_ID	XPAR_SCUGIC_0_DEVICE_ID
+/* Observation register reads after which a round trip times out */
+#define SPIN_COUNT	100000
+
+/*****************************************************************************/
+
+/* Global Instances of GIC and IPI devices */
+XScuGic GicInst;
+XIpiPsu IpiInst;
+
+/* Buffers to store Test Data, aligned for 64-bit accesses */
+static u32 MsgBuffer[TEST_MSG_LEN] __attribute__ ((aligned(8)));
+static u32 RespBuffer[TEST_MSG_LEN] __attribute__ ((aligned(8)));
+
+#ifdef __aarch64__
+/**
+ * Time source of the round trip statistics
+ */
+static u64 GetTicks(void)
+{
+	XTime Ticks;
+
+	XTime_GetTime(&Ticks);
+	return (u64)Ticks;
+}
+#endif
+
+/**
+ * Interrupt Handler :
+ * -Reads the pending sources
+ * -Sends back each message unchanged as response
+ * -Acknowledges the sources with a single write
+ *
+ */
+void IpiIntrHandler(void *XIpiPsuPtr)
+{
+	u32 IpiSrcMask;
+	u32 SrcMask;
+	u32 TmpBuffer[TEST_MSG_LEN] __attribute__ ((aligned(8)));
+	XIpiPsu *InstancePtr = (XIpiPsu *) XIpiPsuPtr;
+
+	IpiSrcMask = XIpiPsu_GetInterruptStatus(InstancePtr);
+
+	for (SrcMask = IpiSrcMask; SrcMask != 0U; SrcMask &= (SrcMask - 1U)) {
+		/* Echo the message of the lowest pending source */
+		if (XIpiPsu_ReadMessageFast(InstancePtr, SrcMask & (~SrcMask + 1U),
+				TmpBuffer, TEST_MSG_LEN, XIPIPSU_BUF_TYPE_MSG) ==
+				XST_SUCCESS) {
+			(void)XIpiPsu_WriteMessageFast(InstancePtr,
+					SrcMask & (~SrcMask + 1U), TmpBuffer,
+					TEST_MSG_LEN, XIPIPSU_BUF_TYPE_RESP);
+		}
+	}
+
+	/* Clear the Interrupt Status - This clears the OBS bits on the SRC CPUs */
+	XIpiPsu_ClearInterruptStatus(InstancePtr, IpiSrcMask);
+}
+
+
+static XStatus SetupInterruptSystem(XScuGic *IntcInstancePtr,
+		XIpiPsu *IpiInstancePtr, u32 IpiIntrId)
+{
+	u32 Status = 0;
+	XScuGic_Config *IntcConfig; /* Config for interrupt controller */
+
+	/* Initialize the interrupt controller driver */
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (NULL == IntcConfig) {
+		return XST_FAILURE;
+	}
+
+	Status = XScuGic_CfgInitialize(IntcInstancePtr, IntcConfig,
+			IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Connect the interrupt controller interrupt handler to the
+	 * hardware interrupt handling logic in the processor.
+	 */
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler) XScuGic_InterruptHandler, IntcInstancePtr);
+
+	/*
+	 * Connect a device driver handler that will be called when an
+	 * interrupt for the device occurs
+	 */
+	Status = XScuGic_Connect(IntcInstancePtr, IpiIntrId,
+			(Xil_InterruptHandler) IpiIntrHandler, (void *) IpiInstancePtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/* Enable the interrupt for the device */
+	XScuGic_Enable(IntcInstancePtr, IpiIntrId);
+
+	/* Enable interrupts */
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
+
+
+/**
+ * @brief	Measures TEST_ITERATIONS round trips to self and prints the
+ *		statistics
+ */
+static XStatus DoRoundTripTest(XIpiPsu *InstancePtr)
+{
+	u32 Iter;
+	u32 Index;
+	u32 DestMask = InstancePtr->Config.BitMask;
+	XStatus Status = XST_SUCCESS;
+	XIpiPsu_Stats Stats;
+
+#ifdef __aarch64__
+	XIpiPsu_SetTimeHandler(InstancePtr, GetTicks);
+#endif
+	XIpiPsu_ResetStats(InstancePtr);
+
+	for (Iter = 0; Iter < TEST_ITERATIONS; Iter++) {
+		for (Index = 0; Index < TEST_MSG_LEN; Index++) {
+			MsgBuffer[Index] = (Iter << 8) | Index;
+		}
+
+		if (XIpiPsu_SendMessage(InstancePtr, DestMask, MsgBuffer,
+				TEST_MSG_LEN) != XST_SUCCESS) {
+			xil_printf("Error: Invalid destination mask 0x%08x\r\n",
+					DestMask);
+			return XST_FAILURE;
+		}
+
+		if (XIpiPsu_PollForAckSpin(InstancePtr, DestMask, SPIN_COUNT) !=
+				XST_SUCCESS) {
+			xil_printf("Error: Timed Out on round trip %d\r\n", Iter);
+			Status = XST_FAILURE;
+			break;
+		}
+
+		XIpiPsu_ReadMessageFast(InstancePtr, DestMask, RespBuffer,
+				TEST_MSG_LEN, XIPIPSU_BUF_TYPE_RESP);
+		for (Index = 0; Index < TEST_MSG_LEN; Index++) {
+			if (RespBuffer[Index] != MsgBuffer[Index]) {
+				xil_printf("Error: Response mismatch on round trip %d\r\n",
+						Iter);
+				return XST_FAILURE;
+			}
+		}
+	}
+
+	XIpiPsu_GetStats(InstancePtr, DestMask, &Stats);
+	if (Stats.RoundTrips == 0U) {
+		return XST_FAILURE;
+	}
+
+#ifdef __aarch64__
+	xil_printf("Round trip time in timer ticks (%d ticks per us):\r\n",
+			(u32)(COUNTS_PER_SECOND / 1000000U));
+#else
+	xil_printf("Round trip time in Observation register reads:\r\n");
+#endif
+	xil_printf("Round trips %d, timeouts %d\r\n", Stats.RoundTrips,
+			Stats.Timeouts);
+	xil_printf("Min %d, Max %d, Avg %d\r\n", (u32)Stats.MinTime,
+			(u32)Stats.MaxTime,
+			(u32)(Stats.TotalTime / Stats.RoundTrips));
+
+	return Status;
+}
+
+int main()
+{
+	XIpiPsu_Config *CfgPtr;
+	int Status = XST_FAILURE;
+
+	xil_printf("IPI round trip benchmark [Build: %s %s]\r\n", __DATE__,
+			__TIME__);
+
+	Xil_DCacheDisable();
+
+	/* Look Up the config data */
+	CfgPtr = XIpiPsu_LookupConfig(TEST_CHANNEL_ID);
+	if (NULL == CfgPtr) {
+		goto END;
+	}
+
+	/* Init with the Cfg Data */
+	XIpiPsu_CfgInitialize(&IpiInst, CfgPtr, CfgPtr->BaseAddress);
+
+	/* Setup the GIC */
+	if (SetupInterruptSystem(&GicInst, &IpiInst, IpiInst.Config.IntId) !=
+			XST_SUCCESS) {
+		goto END;
+	}
+
+	/* Enable reception of IPIs from self */
+	XIpiPsu_InterruptEnable(&IpiInst, IpiInst.Config.BitMask);
+
+	/* Clear Any existing Interrupts */
+	XIpiPsu_ClearInterruptStatus(&IpiInst, XIPIPSU_ALL_MASK);
+
+	/* Call the test routine */
+	Status = DoRoundTripTest(&IpiInst);
+
+END:
+	/* Print the test result */
+	if (XST_SUCCESS == Status) {
+		xil_printf("Successfully ran Ipipsu roundtrip Example\r\n");
+	} else {
+		xil_printf("Ipipsu roundtrip Example Failed\r\n");
+	}
+
+	return Status;
+}
@@ -44,6 +44,9 @@
 * 2.1	kvn	05/05/16	Modified code for MISRA-C:2012 Compliance
 * 2.2	kvn	02/17/17	Add support for updating ConfigTable at run time
 * 2.4	sd	07/11/18	Fix a doxygen reported warning
+* 2.5	adk	10/15/19	Add fast path APIs for multi destination
+*				messages, bounded spin ACK polling and round
+*				trip statistics.
 * </pre>
 *
 *****************************************************************************/
@@ -74,6 +77,7 @@ XStatus XIpiPsu_CfgInitialize(XIpiPsu *InstancePtr, XIpiPsu_Config * CfgPtr,
 		UINTPTR EffectiveAddress)
 {
 	u32 Index;
+	u32 Bit;
 	/* Verify arguments */
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(CfgPtr != NULL);
@@ -92,6 +96,21 @@ XStatus XIpiPsu_CfgInitialize(XIpiPsu *InstancePtr, XIpiPsu_Config * CfgPtr,
 				CfgPtr->TargetList[Index].BufferIndex;
 	}
 
+	/* Build the IPI bit to Target List index table used by the fast path */
+	for (Bit = 0U; Bit < XIPIPSU_NUM_CPU_BITS; Bit++) {
+		InstancePtr->TargetIdx[Bit] = (u8)XIPIPSU_INVALID_TARGET;
+		for (Index = 0U; Index < CfgPtr->TargetCount; Index++) {
+			if (CfgPtr->TargetList[Index].Mask == ((u32)1U << Bit)) {
+				InstancePtr->TargetIdx[Bit] = (u8)Index;
+				break;
+			}
+		}
+	}
+
+	InstancePtr->TimeHandler = NULL;
+	InstancePtr->TrigTime = 0U;
+	XIpiPsu_ResetStats(InstancePtr);
+
 	/* Mark the component as Ready */
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
 	return (XST_SUCCESS);
@@ -386,4 +405,419 @@ void XIpiPsu_SetConfigTable(u32 DeviceId, XIpiPsu_Config *ConfigTblPtr)
 		}
 	}
 }
+/**
+ * @brief	Get the Target List index of a single CPU Mask
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ * @param	CpuMask is the Mask of the CPU, with a single bit set
+ *
+ * @return	Target List index if CPU Mask is valid
+ * 			XIPIPSU_INVALID_TARGET if not valid
+ *
+ * @note	Static function used by the fast path
+ *
+ */
+static u32 XIpiPsu_GetTargetIndex(XIpiPsu *InstancePtr, u32 CpuMask)
+{
+	u32 TargetIndex = XIPIPSU_INVALID_TARGET;
+
+	if ((CpuMask != 0U) && ((CpuMask & (CpuMask - 1U)) == 0U)) {
+		TargetIndex = InstancePtr->TargetIdx[__builtin_ctz(CpuMask)];
+	}
+
+	return TargetIndex;
+}
+
+/**
+ * @brief	Get the Buffer Address between this CPU and a Target
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ * @param	SelfIndex is the Buffer Index of this CPU
+ * @param	TargetIndex is the Target List index of the remote CPU
+ * @param	BufferType is either XIPIPSU_BUF_TYPE_MSG or XIPIPSU_BUF_TYPE_RESP
+ * @param	Outgoing is 1 for a buffer written by this CPU, 0 for a buffer
+ * 			written by the remote CPU
+ *
+ * @return	Buffer Address
+ *
+ * @note	Static function used by the fast path. Same layout as
+ * 			XIpiPsu_GetBufferAddress.
+ *
+ */
+static UINTPTR XIpiPsu_GetFastBufferAddress(XIpiPsu *InstancePtr,
+		u32 SelfIndex, u32 TargetIndex, u8 BufferType, u32 Outgoing)
+{
+	u32 InitIndex;
+	u32 RespIndex;
+	UINTPTR BufferAddr;
+
+	/*
+	 * A message and its response share the slot of the CPU which initiated
+	 * the exchange. This CPU is the initiator for an outgoing message or an
+	 * incoming response.
+	 */
+	if ((Outgoing != 0U) == (XIPIPSU_BUF_TYPE_MSG == BufferType)) {
+		InitIndex = SelfIndex;
+		RespIndex = InstancePtr->Config.TargetList[TargetIndex].BufferIndex;
+	} else {
+		InitIndex = InstancePtr->Config.TargetList[TargetIndex].BufferIndex;
+		RespIndex = SelfIndex;
+	}
+
+	BufferAddr = (UINTPTR)XIPIPSU_MSG_RAM_BASE
+			+ (InitIndex * XIPIPSU_BUFFER_OFFSET_GROUP)
+			+ (RespIndex * XIPIPSU_BUFFER_OFFSET_TARGET);
+	if (XIPIPSU_BUF_TYPE_RESP == BufferType) {
+		BufferAddr += XIPIPSU_BUFFER_OFFSET_RESPONSE;
+	}
+
+	return BufferAddr;
+}
+
+/**
+ * @brief	Get the Buffer Index of this CPU
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ *
+ * @return	Buffer Index value if this CPU is in the Target List
+ * 			XIPIPSU_MAX_BUFF_INDEX+1 if not
+ *
+ */
+static u32 XIpiPsu_GetSelfBufferIndex(XIpiPsu *InstancePtr)
+{
+	u32 TargetIndex;
+	u32 BufferIndex = XIPIPSU_MAX_BUFF_INDEX + 1U;
+
+	TargetIndex = XIpiPsu_GetTargetIndex(InstancePtr,
+			InstancePtr->Config.BitMask);
+	if (TargetIndex != XIPIPSU_INVALID_TARGET) {
+		BufferIndex = InstancePtr->Config.TargetList[TargetIndex].BufferIndex;
+	}
+
+	return BufferIndex;
+}
+
+/**
+ * @brief	Copy a Message between a user buffer and an IPI buffer
+ *
+ * @param	DstAddr is the destination address
+ * @param	SrcAddr is the source address
+ * @param	MsgLength is the length of the message in words
+ *
+ * @note	The IPI buffers are 32 byte aligned. On A53 the copy is done
+ * 			with 64-bit accesses when the user buffer is 8 byte aligned.
+ *
+ */
+static void XIpiPsu_CopyMessage(UINTPTR DstAddr, UINTPTR SrcAddr,
+		u32 MsgLength)
+{
+	u32 Index = 0U;
+
+#ifdef __aarch64__
+	if (((DstAddr | SrcAddr) & 0x7U) == 0U) {
+		for (; (Index + 1U) < MsgLength; Index += 2U) {
+			*(volatile u64 *)(DstAddr + ((UINTPTR)Index * 4U)) =
+				*(volatile const u64 *)(SrcAddr + ((UINTPTR)Index * 4U));
+		}
+	}
+#endif
+	for (; Index < MsgLength; Index++) {
+		*(volatile u32 *)(DstAddr + ((UINTPTR)Index * 4U)) =
+			*(volatile const u32 *)(SrcAddr + ((UINTPTR)Index * 4U));
+	}
+}
+
+/**
+ * @brief	Write a Message to one or more Destinations
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ * @param	DestCpuMask is the Device Mask of the destination CPUs. The
+ * 			message is written to the buffer of each CPU in the mask.
+ * @param	MsgPtr is the pointer to Buffer which contains the message to be sent
+ * @param	MsgLength is the length of the buffer/message in words
+ * @param	BufferType is the type of buffer (XIPIPSU_BUF_TYPE_MSG or XIPIPSU_BUF_TYPE_RESP)
+ *
+ * @return	XST_SUCCESS if successful
+ * 			XST_FAILURE if a CPU in the mask is not a valid target, in which
+ * 			case no buffer is written
+ */
+
+XStatus XIpiPsu_WriteMessageFast(XIpiPsu *InstancePtr, u32 DestCpuMask,
+		const u32 *MsgPtr, u32 MsgLength, u8 BufferType)
+{
+	u32 Mask;
+	u32 Bit;
+	u32 SelfIndex;
+	XStatus Status = XST_FAILURE;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(MsgPtr != NULL);
+	Xil_AssertNonvoid(MsgLength <= XIPIPSU_MAX_MSG_LEN);
+	Xil_AssertNonvoid((BufferType == XIPIPSU_BUF_TYPE_MSG) ||
+			(BufferType == XIPIPSU_BUF_TYPE_RESP));
+
+	SelfIndex = XIpiPsu_GetSelfBufferIndex(InstancePtr);
+	if ((SelfIndex > XIPIPSU_MAX_BUFF_INDEX) || (DestCpuMask == 0U)) {
+		goto END;
+	}
+
+	/* Validate all the destinations before writing any buffer */
+	for (Mask = DestCpuMask; Mask != 0U; Mask &= (Mask - 1U)) {
+		Bit = (u32)__builtin_ctz(Mask);
+		if (InstancePtr->TargetIdx[Bit] == XIPIPSU_INVALID_TARGET) {
+			goto END;
+		}
+	}
+
+	for (Mask = DestCpuMask; Mask != 0U; Mask &= (Mask - 1U)) {
+		Bit = (u32)__builtin_ctz(Mask);
+		XIpiPsu_CopyMessage(XIpiPsu_GetFastBufferAddress(InstancePtr,
+				SelfIndex, InstancePtr->TargetIdx[Bit], BufferType, 1U),
+				(UINTPTR)MsgPtr, MsgLength);
+	}
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+
+/**
+ * @brief	Read an Incoming Message or Response from a Source
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ * @param	SrcCpuMask is the Device Mask for the CPU which has sent the
+ * 			message or response, with a single bit set
+ * @param	MsgPtr is the pointer to Buffer to which the read message needs to be stored
+ * @param	MsgLength is the length of the buffer/message in words
+ * @param	BufferType is the type of buffer (XIPIPSU_BUF_TYPE_MSG or XIPIPSU_BUF_TYPE_RESP)
+ *
+ * @return	XST_SUCCESS if successful
+ * 			XST_FAILURE if the source is not a valid target
+ */
+
+XStatus XIpiPsu_ReadMessageFast(XIpiPsu *InstancePtr, u32 SrcCpuMask,
+		u32 *MsgPtr, u32 MsgLength, u8 BufferType)
+{
+	u32 TargetIndex;
+	u32 SelfIndex;
+	XStatus Status = XST_FAILURE;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(MsgPtr != NULL);
+	Xil_AssertNonvoid(MsgLength <= XIPIPSU_MAX_MSG_LEN);
+	Xil_AssertNonvoid((BufferType == XIPIPSU_BUF_TYPE_MSG) ||
+			(BufferType == XIPIPSU_BUF_TYPE_RESP));
+
+	SelfIndex = XIpiPsu_GetSelfBufferIndex(InstancePtr);
+	TargetIndex = XIpiPsu_GetTargetIndex(InstancePtr, SrcCpuMask);
+	if ((SelfIndex <= XIPIPSU_MAX_BUFF_INDEX) &&
+			(TargetIndex != XIPIPSU_INVALID_TARGET)) {
+		XIpiPsu_CopyMessage((UINTPTR)MsgPtr,
+				XIpiPsu_GetFastBufferAddress(InstancePtr, SelfIndex,
+				TargetIndex, BufferType, 0U), MsgLength);
+		Status = XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+/**
+ * @brief	Send a Message to one or more Destinations
+ *
+ * The message is written to the buffer of each destination and all of them
+ * are triggered with a single write of the Trigger register. The time stamp
+ * of the trigger is the start of the round trips measured by
+ * XIpiPsu_PollForAckSpin().
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ * @param	DestCpuMask is the Device Mask of the destination CPUs
+ * @param	MsgPtr is the pointer to Buffer which contains the message to be
+ * 			sent, may be NULL when MsgLength is 0
+ * @param	MsgLength is the length of the buffer/message in words
+ *
+ * @return	XST_SUCCESS if successful
+ * 			XST_FAILURE if a CPU in the mask is not a valid target
+ */
+
+XStatus XIpiPsu_SendMessage(XIpiPsu *InstancePtr, u32 DestCpuMask,
+		const u32 *MsgPtr, u32 MsgLength)
+{
+	XStatus Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (MsgLength != 0U) {
+		Status = XIpiPsu_WriteMessageFast(InstancePtr, DestCpuMask, MsgPtr,
+				MsgLength, XIPIPSU_BUF_TYPE_MSG);
+	}
+
+	if (Status == XST_SUCCESS) {
+		if (InstancePtr->TimeHandler != NULL) {
+			InstancePtr->TrigTime = InstancePtr->TimeHandler();
+		}
+		XIpiPsu_WriteReg(InstancePtr->Config.BaseAddress,
+				XIPIPSU_TRIG_OFFSET, DestCpuMask);
+	}
+
+	return Status;
+}
+
+/**
+ * @brief	Update the round trip statistics of a Target
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ * @param	Mask is the Mask of the targets acknowledged or timed out
+ * @param	Time is the round trip time
+ * @param	TimedOut is 1 if the targets timed out
+ *
+ */
+static void XIpiPsu_UpdateStats(XIpiPsu *InstancePtr, u32 Mask, u64 Time,
+		u32 TimedOut)
+{
+	u32 TargetIndex;
+	XIpiPsu_Stats *StatsPtr;
+
+	for (; Mask != 0U; Mask &= (Mask - 1U)) {
+		TargetIndex = InstancePtr->TargetIdx[__builtin_ctz(Mask)];
+		if (TargetIndex == XIPIPSU_INVALID_TARGET) {
+			continue;
+		}
+		StatsPtr = &InstancePtr->Stats[TargetIndex];
+		if (TimedOut != 0U) {
+			StatsPtr->Timeouts++;
+			continue;
+		}
+		if ((StatsPtr->RoundTrips == 0U) || (Time < StatsPtr->MinTime)) {
+			StatsPtr->MinTime = Time;
+		}
+		if (Time > StatsPtr->MaxTime) {
+			StatsPtr->MaxTime = Time;
+		}
+		StatsPtr->TotalTime += Time;
+		StatsPtr->RoundTrips++;
+	}
+}
+
+/**
+ * @brief	Spin on the Observation Register until all the Destinations
+ * 			have acknowledged
+ *
+ * Unlike XIpiPsu_PollForAck(), each destination is accounted for as soon as
+ * its bit clears, so that the round trip statistics of a fast target are not
+ * affected by a slower one of the same batch.
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ * @param	DestCpuMask is the Mask of the destination CPUs from which ACK
+ * 			is expected
+ * @param	SpinCount is the number of Observation Register reads after
+ * 			which the routine returns failure
+ *
+ * @return	XST_SUCCESS if all the destinations acknowledged
+ * 			XST_FAILURE if a timeout occurred
+ */
+
+XStatus XIpiPsu_PollForAckSpin(XIpiPsu *InstancePtr, u32 DestCpuMask,
+		u32 SpinCount)
+{
+	u32 Pending;
+	u32 Flag;
+	u32 PollCount = 0U;
+	u64 Time;
+	XStatus Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Pending = DestCpuMask;
+	while (Pending != 0U) {
+		if (PollCount >= SpinCount) {
+			XIpiPsu_UpdateStats(InstancePtr, Pending, 0U, 1U);
+			Status = XST_FAILURE;
+			break;
+		}
+		Flag = XIpiPsu_ReadReg(InstancePtr->Config.BaseAddress,
+				XIPIPSU_OBS_OFFSET);
+		PollCount++;
+		/* Account for the destinations which acknowledged on this read */
+		if ((Pending & ~Flag) != 0U) {
+			if (InstancePtr->TimeHandler != NULL) {
+				Time = InstancePtr->TimeHandler() - InstancePtr->TrigTime;
+			} else {
+				Time = PollCount;
+			}
+			XIpiPsu_UpdateStats(InstancePtr, Pending & ~Flag, Time, 0U);
+			Pending &= Flag;
+		}
+	}
+
+	return Status;
+}
+
+/**
+ * @brief	Set the time source of the round trip statistics
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ * @param	TimeHandler returns a free running time stamp, NULL to measure
+ * 			round trips in poll iterations
+ *
+ * @note	The statistics should be reset when the time source changes
+ */
+void XIpiPsu_SetTimeHandler(XIpiPsu *InstancePtr,
+		XIpiPsu_TimeHandler TimeHandler)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->TimeHandler = TimeHandler;
+}
+
+/**
+ * @brief	Read the round trip statistics of a Target
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ * @param	CpuMask is the Mask of the target CPU, with a single bit set
+ * @param	StatsPtr is the pointer to the statistics to fill
+ *
+ * @return	XST_SUCCESS if successful
+ * 			XST_FAILURE if the CPU is not a valid target
+ */
+XStatus XIpiPsu_GetStats(XIpiPsu *InstancePtr, u32 CpuMask,
+		XIpiPsu_Stats *StatsPtr)
+{
+	u32 TargetIndex;
+	XStatus Status = XST_FAILURE;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(StatsPtr != NULL);
+
+	TargetIndex = XIpiPsu_GetTargetIndex(InstancePtr, CpuMask);
+	if (TargetIndex != XIPIPSU_INVALID_TARGET) {
+		*StatsPtr = InstancePtr->Stats[TargetIndex];
+		Status = XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+/**
+ * @brief	Clear the round trip statistics of all the Targets
+ *
+ * @param	InstancePtr is the pointer to current IPI instance
+ */
+void XIpiPsu_ResetStats(XIpiPsu *InstancePtr)
+{
+	u32 Index;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	for (Index = 0U; Index < XIPIPSU_MAX_TARGETS; Index++) {
+		InstancePtr->Stats[Index].RoundTrips = 0U;
+		InstancePtr->Stats[Index].Timeouts = 0U;
+		InstancePtr->Stats[Index].MinTime = 0U;
+		InstancePtr->Stats[Index].MaxTime = 0U;
+		InstancePtr->Stats[Index].TotalTime = 0U;
+	}
+}
 /** @} */
@@ -67,6 +67,19 @@
  * - Write the response using XIpiPsu_WriteMessage()
  * - Ack the IPI using XIpiPsu_ClearInterruptStatus()
  *
+ * <b>Fast path</b>
+ * For latency sensitive exchanges, the following sequence can be used instead:
+ * - Write the Message and Trigger all the destinations with a single register
+ *   write using XIpiPsu_SendMessage()
+ * - Wait for the Acks using XIpiPsu_PollForAckSpin()
+ * - Read the responses using XIpiPsu_ReadMessageFast()
+ * The buffer addresses are looked up from a table built by
+ * XIpiPsu_CfgInitialize() and the buffers are accessed with 64-bit loads and
+ * stores on A53 when the user buffer is 8 byte aligned. Each acknowledged
+ * message updates the round trip statistics of its destination, which are
+ * read with XIpiPsu_GetStats(). Round trips are measured in poll iterations,
+ * or in ticks of the time source set with XIpiPsu_SetTimeHandler().
+ *
  * @note	XIpiPsu_Reset can be used at startup to clear the status and
  * disable all sources
  *
@@ -87,6 +100,9 @@
  *      ms  03/28/17  Add index.html to provide support for importing
  *                    examples in SDK.
  * 2.5  sdd 12/17/18  Add the cpp extern macro.
+ *      adk 10/15/19  Add a fast path for message passing: multi destination
+ *                    writes with 64-bit accesses, batched trigger, bounded
+ *                    spin ACK polling and per channel round trip statistics.
  * </pre>
  *
  *****************************************************************************/
@@ -107,6 +123,8 @@ extern "C" {
 #define XIPIPSU_BUF_TYPE_MSG	(0x00000001U)
 #define XIPIPSU_BUF_TYPE_RESP	(0x00000002U)
 #define XIPIPSU_MAX_MSG_LEN		XIPIPSU_MSG_BUF_SIZE
+#define XIPIPSU_NUM_CPU_BITS	32U	/* Bits in the IPI registers */
+#define XIPIPSU_INVALID_TARGET	0xFFU	/* Bit is not an IPI target */
 /**************************** Type Definitions *******************************/
 /**
  * Data structure used to refer IPI Targets
@@ -129,6 +147,23 @@ typedef struct {
 	XIpiPsu_Target TargetList[XIPIPSU_MAX_TARGETS] ; /** < List of IPI Targets */
 } XIpiPsu_Config;
 
+/**
+ * Returns a free running time stamp used for the round trip statistics
+ */
+typedef u64 (*XIpiPsu_TimeHandler)(void);
+
+/**
+ * Round trip statistics of an IPI target. Times are in ticks of the time
+ * handler, or in poll iterations when no time handler is set.
+ */
+typedef struct {
+	u32 RoundTrips; /**< Messages acknowledged by the target */
+	u32 Timeouts; /**< Polls which timed out waiting for the target */
+	u64 MinTime; /**< Shortest round trip */
+	u64 MaxTime; /**< Longest round trip */
+	u64 TotalTime; /**< Sum of all the round trips */
+} XIpiPsu_Stats;
+
 /**
  * The XIpiPsu driver instance data. The user is required to allocate a
  * variable of this type for each IPI device in the system. A pointer
@@ -138,6 +173,11 @@ typedef struct {
 	XIpiPsu_Config Config; /**< Configuration structure */
 	u32 IsReady; /**< Device is initialized and ready */
 	u32 Options; /**< Options set in the device */
+	u8 TargetIdx[XIPIPSU_NUM_CPU_BITS]; /**< Target List index of each
+						  *  IPI bit */
+	XIpiPsu_TimeHandler TimeHandler; /**< Time source, may be NULL */
+	u64 TrigTime; /**< Time stamp of the last XIpiPsu_SendMessage() */
+	XIpiPsu_Stats Stats[XIPIPSU_MAX_TARGETS]; /**< Per target statistics */
 } XIpiPsu;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -294,6 +334,28 @@ XStatus XIpiPsu_WriteMessage(XIpiPsu *InstancePtr, u32 DestCpuMask, u32 *MsgPtr,
 		u32 MsgLength, u8 BufferType);
 void XIpiPsu_SetConfigTable(u32 DeviceId, XIpiPsu_Config *ConfigTblPtr);
 
+/* Fast path Functions implemented in xipipsu.c */
+
+XStatus XIpiPsu_WriteMessageFast(XIpiPsu *InstancePtr, u32 DestCpuMask,
+		const u32 *MsgPtr, u32 MsgLength, u8 BufferType);
+
+XStatus XIpiPsu_ReadMessageFast(XIpiPsu *InstancePtr, u32 SrcCpuMask,
+		u32 *MsgPtr, u32 MsgLength, u8 BufferType);
+
+XStatus XIpiPsu_SendMessage(XIpiPsu *InstancePtr, u32 DestCpuMask,
+		const u32 *MsgPtr, u32 MsgLength);
+
+XStatus XIpiPsu_PollForAckSpin(XIpiPsu *InstancePtr, u32 DestCpuMask,
+		u32 SpinCount);
+
+void XIpiPsu_SetTimeHandler(XIpiPsu *InstancePtr,
+		XIpiPsu_TimeHandler TimeHandler);
+
+XStatus XIpiPsu_GetStats(XIpiPsu *InstancePtr, u32 CpuMask,
+		XIpiPsu_Stats *StatsPtr);
+
+void XIpiPsu_ResetStats(XIpiPsu *InstancePtr);
+
 #ifdef __cplusplus
 }
 #endif
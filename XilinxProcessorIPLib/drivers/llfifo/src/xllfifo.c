@@ -51,6 +51,11 @@
  * 5.1   sk   11/10/15 Used UINTPTR instead of u32 for Baseaddress CR# 867425.
  *                     Changed the prototypes of XLlFifo_CfgInitialize,
  *                     XLlFifo_Initialize APIs.
+ * 5.4   adk  10/15/19 Transfer blocks of words without per word checks, with
+ *		       incrementing addresses over the AXI4 data interface
+ *		       and 64-bit accesses on 64-bit processors. Added
+ *		       XLlFifo_RxBatch to receive several packets for a
+ *		       single occupancy read.
  * </pre>
  ******************************************************************************/
 
@@ -99,6 +104,112 @@ xdbg_stmnt(u32 _xllfifo_rr_value;)
 xdbg_stmnt(u32 _xllfifo_ipie_value;)
 xdbg_stmnt(u32 _xllfifo_ipis_value;)
 
+/*****************************************************************************/
+/**
+*
+* XLlFifo_iReadWords reads <i>WordCount</i> words from the receive channel of
+* the FIFO referenced by <i>InstancePtr</i>.
+*
+* With the AXI4 data interface, the words are read at incrementing addresses
+* of the receive data window so that the interconnect can burst them, and
+* two words at a time on 64-bit processors when <i>BufPtr</i> allows it. The
+* AXI4-Lite data register is a single address and is read word by word.
+*
+* @param    InstancePtr references the FIFO on which to operate.
+*
+* @param    BufPtr specifies the 32 bit aligned memory address to place the
+*           data read.
+*
+* @param    WordCount specifies the number of 32 bit words to read.
+*
+* @return   N/A
+*
+******************************************************************************/
+static void XLlFifo_iReadWords(XLlFifo *InstancePtr, u32 *BufPtr,
+				unsigned WordCount)
+{
+	UINTPTR DataAddr;
+	UINTPTR Offset = 0;
+
+	if (!InstancePtr->Datainterface) {
+		while (WordCount--) {
+			*BufPtr++ = XLlFifo_ReadReg(InstancePtr->BaseAddress,
+					XLLF_RDFD_OFFSET);
+		}
+		return;
+	}
+
+	DataAddr = (UINTPTR)InstancePtr->Axi4BaseAddress +
+			XLLF_AXI4_RDFD_OFFSET;
+#if defined (__aarch64__)
+	if (((UINTPTR)BufPtr & 0x7) == 0) {
+		u64 *Buf64 = (u64 *)BufPtr;
+
+		while (WordCount >= 2) {
+			*Buf64++ = Xil_In64(DataAddr + Offset);
+			Offset = (Offset + 8) & (XLLF_AXI4_DATA_WINDOW - 1);
+			WordCount -= 2;
+		}
+		BufPtr = (u32 *)Buf64;
+	}
+#endif
+	while (WordCount--) {
+		*BufPtr++ = Xil_In32(DataAddr + Offset);
+		Offset = (Offset + 4) & (XLLF_AXI4_DATA_WINDOW - 1);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* XLlFifo_iWriteWords writes <i>WordCount</i> words to the transmit channel of
+* the FIFO referenced by <i>InstancePtr</i>. See XLlFifo_iReadWords for the
+* access pattern used.
+*
+* @param    InstancePtr references the FIFO on which to operate.
+*
+* @param    BufPtr specifies the 32 bit aligned memory address of the data to
+*           write.
+*
+* @param    WordCount specifies the number of 32 bit words to write.
+*
+* @return   N/A
+*
+******************************************************************************/
+static void XLlFifo_iWriteWords(XLlFifo *InstancePtr, const u32 *BufPtr,
+				unsigned WordCount)
+{
+	UINTPTR DataAddr;
+	UINTPTR Offset = 0;
+
+	if (!InstancePtr->Datainterface) {
+		while (WordCount--) {
+			XLlFifo_WriteReg(InstancePtr->BaseAddress,
+					XLLF_TDFD_OFFSET, *BufPtr++);
+		}
+		return;
+	}
+
+	DataAddr = (UINTPTR)InstancePtr->Axi4BaseAddress +
+			XLLF_AXI4_TDFD_OFFSET;
+#if defined (__aarch64__)
+	if (((UINTPTR)BufPtr & 0x7) == 0) {
+		const u64 *Buf64 = (const u64 *)BufPtr;
+
+		while (WordCount >= 2) {
+			Xil_Out64(DataAddr + Offset, *Buf64++);
+			Offset = (Offset + 8) & (XLLF_AXI4_DATA_WINDOW - 1);
+			WordCount -= 2;
+		}
+		BufPtr = (const u32 *)Buf64;
+	}
+#endif
+	while (WordCount--) {
+		Xil_Out32(DataAddr + Offset, *BufPtr++);
+		Offset = (Offset + 4) & (XLLF_AXI4_DATA_WINDOW - 1);
+	}
+}
+
 /*****************************************************************************/
 /**
 *
@@ -174,25 +285,14 @@ u32 XLlFifo_iRxGetLen(XLlFifo *InstancePtr)
 int XLlFifo_iRead_Aligned(XLlFifo *InstancePtr, void *BufPtr,
 			     unsigned WordCount)
 {
-	unsigned WordsRemaining = WordCount;
-	u32 *BufPtrIdx = (u32 *)BufPtr;
-
 	xdbg_printf(XDBG_DEBUG_FIFO_RX, "XLlFifo_iRead_Aligned: start\n");
 	Xil_AssertNonvoid(InstancePtr);
 	Xil_AssertNonvoid(BufPtr);
 	/* assert buffer is 32 bit aligned */
-	Xil_AssertNonvoid(((unsigned)BufPtr & 0x3) == 0x0);
+	Xil_AssertNonvoid(((UINTPTR)BufPtr & 0x3) == 0x0);
 	xdbg_printf(XDBG_DEBUG_FIFO_RX, "XLlFifo_iRead_Aligned: after asserts\n");
 
-	while (WordsRemaining) {
-/*		xdbg_printf(XDBG_DEBUG_FIFO_RX,
-			    "XLlFifo_iRead_Aligned: WordsRemaining: %d\n",
-			    WordsRemaining);
-*/
-		*BufPtrIdx = XLlFifo_RxGetWord(InstancePtr);
-		BufPtrIdx++;
-		WordsRemaining--;
-	}
+	XLlFifo_iReadWords(InstancePtr, (u32 *)BufPtr, WordCount);
 	xdbg_printf(XDBG_DEBUG_FIFO_RX,
 		    "XLlFifo_iRead_Aligned: returning SUCCESS\n");
 	return XST_SUCCESS;
@@ -280,25 +380,15 @@ void XLlFifo_iTxSetLen(XLlFifo *InstancePtr, u32 Bytes)
 int XLlFifo_iWrite_Aligned(XLlFifo *InstancePtr, void *BufPtr,
 			      unsigned WordCount)
 {
-	unsigned WordsRemaining = WordCount;
-	u32 *BufPtrIdx = (u32 *)BufPtr;
-
 	xdbg_printf(XDBG_DEBUG_FIFO_TX,
 		    "XLlFifo_iWrite_Aligned: Inst: %p; Buff: %p; Count: %d\n",
 		    InstancePtr, BufPtr, WordCount);
 	Xil_AssertNonvoid(InstancePtr);
 	Xil_AssertNonvoid(BufPtr);
 	/* assert buffer is 32 bit aligned */
-	Xil_AssertNonvoid(((unsigned)BufPtr & 0x3) == 0x0);
+	Xil_AssertNonvoid(((UINTPTR)BufPtr & 0x3) == 0x0);
 
-	xdbg_printf(XDBG_DEBUG_FIFO_TX,
-		    "XLlFifo_iWrite_Aligned: WordsRemaining: %d\n",
-		    WordsRemaining);
-	while (WordsRemaining) {
-		XLlFifo_TxPutWord(InstancePtr, *BufPtrIdx);
-		BufPtrIdx++;
-		WordsRemaining--;
-	}
+	XLlFifo_iWriteWords(InstancePtr, (const u32 *)BufPtr, WordCount);
 
 	xdbg_printf(XDBG_DEBUG_FIFO_TX,
 		    "XLlFifo_iWrite_Aligned: returning SUCCESS\n");
@@ -434,6 +524,75 @@ void XLlFifo_TxPutWord(XLlFifo *InstancePtr, u32 Word)
 
 }
 
+/*****************************************************************************/
+/**
+*
+* XLlFifo_RxBatch receives up to <i>MaxPkts</i> packets from the receive
+* channel of the FIFO specified by <i>InstancePtr</i>, reading the receive
+* occupancy once. Packet <i>i</i> is copied to <i>BufPtrs[i]</i> and its
+* length is stored in <i>LenPtrs[i]</i>.
+*
+* A packet longer than <i>MaxLen</i> is drained from the FIFO, only its first
+* <i>MaxLen</i> bytes are copied and its full length is reported, so the
+* caller detects truncation with LenPtrs[i] > MaxLen.
+*
+* The occupancy only accounts for complete packets when the core is in store
+* and forward mode, which this function requires. It bypasses the receive
+* byte streamer and must not be called in the middle of a packet read with
+* XLlFifo_Read().
+*
+* @param    InstancePtr references the FIFO on which to operate.
+*
+* @param    BufPtrs specifies the 32 bit aligned buffers, of at least
+*           <i>MaxLen</i> bytes each.
+*
+* @param    LenPtrs specifies where the packet lengths are stored.
+*
+* @param    MaxLen specifies the size of each buffer, a multiple of 4 bytes.
+*
+* @param    MaxPkts specifies the number of buffers.
+*
+* @return   XLlFifo_RxBatch returns the number of packets received.
+*
+******************************************************************************/
+u32 XLlFifo_RxBatch(XLlFifo *InstancePtr, void **BufPtrs, u32 *LenPtrs,
+			u32 MaxLen, u32 MaxPkts)
+{
+	u32 Occupancy;
+	u32 NumPkts = 0;
+	u32 Len;
+	u32 Words;
+	u32 Copied;
+	u32 Discard;
+
+	Xil_AssertNonvoid(InstancePtr);
+	Xil_AssertNonvoid(BufPtrs);
+	Xil_AssertNonvoid(LenPtrs);
+	Xil_AssertNonvoid((MaxLen & 0x3) == 0x0);
+
+	Occupancy = XLlFifo_iRxOccupancy(InstancePtr);
+
+	while ((Occupancy > 0) && (NumPkts < MaxPkts)) {
+		Xil_AssertNonvoid(((UINTPTR)BufPtrs[NumPkts] & 0x3) == 0x0);
+
+		Len = XLlFifo_iRxGetLen(InstancePtr);
+		Words = (Len + 3) >> 2;
+		Copied = (Words > (MaxLen >> 2)) ? (MaxLen >> 2) : Words;
+
+		XLlFifo_iReadWords(InstancePtr, (u32 *)BufPtrs[NumPkts],
+					Copied);
+		for (; Copied < Words; Copied++) {
+			XLlFifo_iReadWords(InstancePtr, &Discard, 1);
+		}
+
+		LenPtrs[NumPkts] = Len;
+		NumPkts++;
+		Occupancy = (Occupancy > Words) ? (Occupancy - Words) : 0;
+	}
+
+	return NumPkts;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -92,6 +92,9 @@
  * for two frames. Each frame must be read in by calling iRxGetLen() just
  * prior to reading the data.
  *
+ * XLlFifo_RxBatch() follows this sequence for each of the frames accounted
+ * for by a single occupancy read, and copies them to a set of buffers.
+ *
  * <h3>Transmit</h3>
  * A frame is transmittted by using the following sequence:<br>
  * 1) XLlFifo_iTxVacancy() one or more times to know the availability of
@@ -117,6 +120,13 @@
  * twice in a row. Each frame must be written by writing the data for one
  * frame and then calling iTxSetLen().
  *
+ * <h3>Block transfers</h3>
+ * XLlFifo_Read() and XLlFifo_Write() move aligned blocks of words without
+ * per word checks. With the AXI4 data interface, the words are accessed at
+ * incrementing addresses of the 4 KB data window so that the interconnect
+ * can burst them, and on 64-bit processors two words are moved per access.
+ * The AXI4-Lite data registers are always accessed 32 bits at a time.
+ *
  * <h2>Interrupts</h2>
  * This driver does not handle interrupts from the FIFO hardware. The
  * software layer above may make use of the interrupts by setting up its
@@ -181,6 +191,9 @@
  * 5.2 adk    03/07/17 CR#978769 Fix doxygen issues in the driver.
  *		       Updated comments in the usage section as per example code.
  *		       Fix doxygen warnings in the driver.
+ * 5.4  adk   10/15/19 Transfers use incrementing addresses over the AXI4
+ *		       data interface and 64-bit accesses on 64-bit
+ *		       processors. Added XLlFifo_RxBatch.
  * </pre>
  *
  *****************************************************************************/
@@ -720,6 +733,8 @@ u32 XLlFifo_iTxVacancy(XLlFifo *InstancePtr);
 void XLlFifo_iTxSetLen(XLlFifo *InstancePtr, u32 Bytes);
 u32 XLlFifo_RxGetWord(XLlFifo *InstancePtr);
 void XLlFifo_TxPutWord(XLlFifo *InstancePtr, u32 Word);
+u32 XLlFifo_RxBatch(XLlFifo *InstancePtr, void **BufPtrs, u32 *LenPtrs,
+			u32 MaxLen, u32 MaxPkts);
 
 #ifdef __cplusplus
 }
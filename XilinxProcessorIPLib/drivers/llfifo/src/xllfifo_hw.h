@@ -47,6 +47,7 @@
 *		       XLLF_INT_TFPE_MASK, XLLF_INT_RFPF_MASK and
 *		       XLLF_INT_RFPE_MASK for the new version of the
 *		       AXI4-Stream FIFO core (v2.01a and later)
+* 5.4   adk  10/15/19  Added XLLF_AXI4_DATA_WINDOW.
 * </pre>
 *
 ******************************************************************************/
@@ -86,6 +87,8 @@ extern "C" {
 #define XLLF_RDFO_OFFSET 0x0000001c  /**< Receive Occupancy */
 #define XLLF_RDFD_OFFSET 0x00000020  /**< Receive Data */
 #define XLLF_AXI4_RDFD_OFFSET 	0x00001000  /**< Axi4 Receive Data */
+#define XLLF_AXI4_DATA_WINDOW	0x00001000  /**< Axi4 Transmit/Receive Data
+					      *  address range */
 #define XLLF_RLF_OFFSET  0x00000024  /**< Receive Length */
 #define XLLF_LLR_OFFSET  0x00000028  /**< Local Link Reset */
 #define XLLF_TDR_OFFSET  0x0000002C  /**< Transmit Destination  */
@@ -42,6 +42,8 @@
 * 2.00a hbm  01/20/10  Hal phase 1 support, bump up major release
 * 2.02a asa  12/28/11  The function XStrm_Read is changed to reset HeadIndex
 *		       to zero when all the bytes are read.
+* 5.4   adk  10/15/19  Use UINTPTR for the buffer alignment checks, pointers
+*		       are 64-bit wide on A53.
 * </pre>
 ******************************************************************************/
 
@@ -331,7 +333,7 @@ void XStrm_Read(XStrm_RxFifoStreamer *InstancePtr, void *BufPtr,
 		 *      of the fifo into the target buffer.
 		 *   2) Loop back around to transfer the last few bytes.
 		 */
-		else if ((((unsigned)DestPtr & 3) == 0) &&
+		else if ((((UINTPTR)DestPtr & 3) == 0) &&
 			 (BytesRemaining >= InstancePtr->FifoWidth)) {
 			xdbg_printf(XDBG_DEBUG_FIFO_RX, "XStrm_Read: Case 2: DestPtr: %p, BytesRemaining: %d, InstancePtr->FifoWidth: %d\n",
 				    DestPtr, BytesRemaining, InstancePtr->FifoWidth);
@@ -463,7 +465,7 @@ void XStrm_Write(XStrm_TxFifoStreamer *InstancePtr, void *BufPtr,
 		 */
 		if ((InstancePtr->TailIndex == 0) &&
 		    (BytesRemaining >= InstancePtr->FifoWidth) &&
-		    (((unsigned)SrcPtr & 3) == 0)) {
+		    (((UINTPTR)SrcPtr & 3) == 0)) {
 			FifoWordsToXfer =
 				BytesRemaining / InstancePtr->FifoWidth;
 
@@ -41,6 +41,7 @@
 * 1.1    rsp    20/02/18 Fix unused variable warning.
 *                        Remove TimeOut variable.CR-979061
 * 1.3    rsp    14/02/19 Populate HasRxLength value from config.
+* 1.3    rsp    24/06/19 Add software weighted round-robin channel selection.
 *
 ******************************************************************************/
 
@@ -170,6 +171,8 @@ s32 XMcDma_Initialize(XMcdma *InstancePtr, XMcdma_Config *CfgPtr)
 			InstancePtr->Tx_Chan[i].MaxTransferLen =
 					MAX_TRANSFER_LEN(CfgPtr->MaxTransferlen - 1);
 			InstancePtr->Tx_Chan[i].IsRxChan = 0;
+			InstancePtr->Tx_Chan[i].SwWeight = 1;
+			InstancePtr->Tx_Chan[i].SwCredit = 1;
 			if (InstancePtr->Config.AddrWidth > 32)
 				InstancePtr->Tx_Chan[i].ext_addr = 1;
 		}
@@ -192,11 +195,16 @@ s32 XMcDma_Initialize(XMcdma *InstancePtr, XMcdma_Config *CfgPtr)
 				   MAX_TRANSFER_LEN(CfgPtr->MaxTransferlen - 1);
 
 			InstancePtr->Rx_Chan[i].IsRxChan = 1;
+			InstancePtr->Rx_Chan[i].SwWeight = 1;
+			InstancePtr->Rx_Chan[i].SwCredit = 1;
 			if (InstancePtr->Config.AddrWidth > 32)
 				InstancePtr->Rx_Chan[i].ext_addr = 1;
 		}
 	}
 
+	InstancePtr->WrrChanId[XMCDMA_DEV_TO_MEM] = 1;
+	InstancePtr->WrrChanId[XMCDMA_MEM_TO_DEV] = 1;
+
 	return (XST_SUCCESS);
 }
 
@@ -585,6 +593,107 @@ u32 XMCdma_SetChan_Weight(XMcdma_ChanCtrl *Chan, u8 Weight)
 	return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+*
+* Set the software weighted round-robin weight of a channel, i.e. how many
+* times in a row XMcdma_WrrNextChan() may pick the channel before moving on
+* to the next eligible one. All channels start with weight 1, which gives
+* plain round-robin.
+*
+* @param	Chan is the MCDMA Channel to be worked on.
+* @param	Weight is the weight, 1 to XMCDMA_SW_WEIGHT_MAX.
+*
+* @return
+*		- XST_SUCCESS if the weight was set.
+*		- XST_INVALID_PARAM if Weight is out of range.
+*
+* @note		The new weight takes effect at the channel's next turn.
+*
+******************************************************************************/
+u32 XMcdma_SetChanSwWeight(XMcdma_ChanCtrl *Chan, u32 Weight)
+{
+	if (Weight == 0 || Weight > XMCDMA_SW_WEIGHT_MAX) {
+		xil_printf("Invalid Weight to Configure\n\r");
+		return XST_INVALID_PARAM;
+	}
+
+	Chan->SwWeight = Weight;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Pick the channel to submit the next transfer to, using software weighted
+* round-robin among the eligible channels of one direction.
+*
+* A channel is eligible when its bit (1 << (ChanId - 1)) is set in ChanMask,
+* typically because the caller has data queued for it, and it has at least
+* NumBd free BDs. The channel holding the turn is returned until it has been
+* picked SwWeight times or is no longer eligible; then the turn moves to the
+* next eligible channel. Every call is one pick, so call it once per packet.
+*
+* @param	InstancePtr is a pointer to the XMcdma instance.
+* @param	Direction is XMCDMA_MEM_TO_DEV for MM2S or XMCDMA_DEV_TO_MEM for
+*		S2MM channels.
+* @param	ChanMask selects the channels that may be picked, use
+*		XMCDMA_ALL_CHAN_MASK for all of them.
+* @param	NumBd is the number of free BDs the transfer needs.
+*
+* @return
+*		- Pointer to the channel to use.
+*		- NULL if no selected channel has NumBd free BDs.
+*
+* @note		None.
+*
+******************************************************************************/
+XMcdma_ChanCtrl *XMcdma_WrrNextChan(XMcdma *InstancePtr, u32 Direction,
+				    u32 ChanMask, u32 NumBd)
+{
+	XMcdma_ChanCtrl *Chan;
+	u32 NumChans;
+	u32 ChanId;
+	u32 i;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Direction <= XMCDMA_MEM_TO_DEV);
+
+	if (Direction == XMCDMA_MEM_TO_DEV)
+		NumChans = InstancePtr->Config.TxNumChannels;
+	else
+		NumChans = InstancePtr->Config.RxNumChannels;
+
+	ChanId = InstancePtr->WrrChanId[Direction];
+
+	/*
+	 * Check the channel holding the turn first, then all the others once.
+	 * A channel getting the turn starts with its full weight as credit.
+	 */
+	for (i = 0; i <= NumChans; i++) {
+		if (Direction == XMCDMA_MEM_TO_DEV)
+			Chan = XMcdma_GetMcdmaTxChan(InstancePtr, ChanId);
+		else
+			Chan = XMcdma_GetMcdmaRxChan(InstancePtr, ChanId);
+
+		if (i > 0)
+			Chan->SwCredit = Chan->SwWeight;
+
+		if (Chan->SwCredit && (ChanMask & (1U << (ChanId - 1))) &&
+		    Chan->BdCnt >= NumBd) {
+			Chan->SwCredit--;
+			InstancePtr->WrrChanId[Direction] = ChanId;
+			return Chan;
+		}
+
+		if (++ChanId > NumChans)
+			ChanId = 1;
+	}
+
+	return NULL;
+}
+
 u32 XMCdma_GetChan_PktDoneCnt(XMcdma_ChanCtrl *Chan)
 {
 	u32 Offset;
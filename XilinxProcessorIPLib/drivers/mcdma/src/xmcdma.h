@@ -71,6 +71,9 @@
 * - Submit a DMA transfer for the required length.
 *      - XMcDma_ChanSubmit(...)
 *
+* - Drop the last submitted BDs, if a transfer cannot be completed:
+*      - XMcDma_ChanUnSubmit(...)
+*
 * - Submit all prepared BDs to the hardware:
 *      - XMcDma_ChantoHw(...)
 *
@@ -85,6 +88,30 @@
 * The driver also provides API functions to get the status of a completed
 * BD, along with get functions for other fields in the BD.
 *
+* <b> Batch Submission and Software Scheduling </b>
+*
+* BDs prepared with XMcDma_ChanSubmit() on several channels can be handed to
+* the hardware with a single XMcDma_ChanToHwBatch() call, which writes the
+* tail descriptor of each selected channel once and enables all of them with
+* one channel enable register update.
+*
+* XMcdma_WrrNextChan() picks the channel to submit to next using a software
+* weighted round-robin: a channel is picked up to its XMcdma_SetChanSwWeight()
+* weight times in a row before the next eligible channel gets its turn, so a
+* bulk channel with a deep backlog cannot starve latency sensitive ones.
+* This complements the MM2S hardware scheduler (XMCdma_SetChan_Weight()),
+* which only arbitrates among BDs already given to the hardware.
+*
+* <b> Interrupt Coalescing </b>
+*
+* XMcdma_SetChanCoalesceDelay() programs a fixed packet threshold and delay
+* timer per channel. Alternatively XMcdma_SetChanAdaptCoalesce() sets lower
+* and upper bounds for both, and XMcdma_ChanAdaptCoalesceSample(), called by
+* the application once per fixed period, retunes them from the number of BDs
+* completed in the period: the lower bounds at light load for low latency, a
+* larger threshold under bursts so that about TargetIrqs interrupts fire per
+* period.
+*
 * The following diagram shows the correct flow of BDs:
 *
 * The diagram shows a complete cycle for BDs, starting from
@@ -139,6 +166,14 @@
 * 1.3   rsp     02/12/19 Add HasRxLength field in config and channel structure.
 * 1.3   rsp     02/11/19 Add top level submit XMcDma_Chan_Sideband_Submit() API
 *                        to program BD control and sideband information.
+* 1.3   rsp     06/20/19 Add adaptive interrupt coalescing controller
+*                        XMcdma_SetChanAdaptCoalesce() and
+*                        XMcdma_ChanAdaptCoalesceSample().
+* 1.3   rsp     06/24/19 Add software weighted round-robin channel selection
+*                        XMcdma_WrrNextChan() and multi channel submission
+*                        XMcDma_ChanToHwBatch().
+* 1.3   rsp     06/26/19 Add XMcDma_ChanUnSubmit() to give back BDs that are
+*                        not handed to the hardware.
 ******************************************************************************/
 #ifndef XMCDMA_H_
 #define XMCDMA_H_
@@ -165,6 +200,8 @@ extern "C" {
 #define XMCDMA_CHAN_BUSY		2
 #define XMCDMA_BD_MINIMUM_ALIGNMENT	0x40
 #define XMCDMA_AXCACHE			0xB
+#define XMCDMA_SW_WEIGHT_MAX		0xFF
+#define XMCDMA_ALL_CHAN_MASK		0xFFFFFFFF
 
 /* Direction flags */
 #define XMCDMA_DEV_TO_MEM		0
@@ -203,6 +240,28 @@ typedef enum {
 	XMCDMA_WRR_PRIORITY,
 } XMcdma_QScheduler;
 
+/**
+ * Bounds for the adaptive interrupt coalescing controller, see
+ * XMcdma_SetChanAdaptCoalesce().
+ */
+typedef struct {
+	u32 MinCoalesce;	/**< Irq threshold at light load, 1 to 255 */
+	u32 MaxCoalesce;	/**< Largest Irq threshold, MinCoalesce to 255 */
+	u32 MinDelay;		/**< Irq delay at light load, 1 to 255 */
+	u32 MaxDelay;		/**< Irq delay at MaxCoalesce, MinDelay to 255 */
+	u32 TargetIrqs;		/**< Interrupts per sample period aimed for
+				  under load */
+} XMcdma_AdaptCoalesceCfg;
+
+typedef struct {
+	XMcdma_AdaptCoalesceCfg Cfg;	/**< User bounds */
+	u32 IsEnabled;		/**< Adaptive mode is active */
+	u32 LastDoneTotal;	/**< BdDoneTotal at the previous sample */
+	u32 AvgRate;		/**< Smoothed BDs per period, 3 fraction bits */
+	u32 Coalesce;		/**< Irq threshold currently programmed */
+	u32 Delay;		/**< Irq delay currently programmed */
+} XMcdma_AdaptCoalesce;
+
 typedef struct {
 	UINTPTR ChanBase;
 	u32 Chan_id;		/* Channel Number */
@@ -230,8 +289,14 @@ typedef struct {
 	u32 BdPendingCnt;
 	u32 BdSubmitCnt;
 	u32 BdDoneCnt;
+	u32 BdDoneTotal;	/* BDs retrieved from hardware, wraps */
 	u32 Length;
 
+	XMcdma_AdaptCoalesce Adapt;	/* Adaptive coalescing state */
+
+	u32 SwWeight;		/* Software WRR weight, 1 to 255 */
+	u32 SwCredit;		/* Picks left in the current WRR turn */
+
 	XMcdma_QScheduler Schedulertype;
 
 	XMcdma_ChanDoneHandler DoneHandler;  /**< Call back for transfer
@@ -294,6 +359,8 @@ typedef struct {
 	                                          *  interrupt */
 	void *PktDropRef;                 /**< To be passed to the error
 	                                     * interrupt callback */
+	u32 WrrChanId[2];	/**< Channel holding the software WRR turn,
+				  indexed by XMCDMA_DEV_TO_MEM/MEM_TO_DEV */
 
 } XMcdma;
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -611,9 +678,15 @@ u16 XMcdma_GetChanServiced(XMcdma *InstancePtr);
 u16 XMcdma_GetTxChanServiced(XMcdma *InstancePtr);
 u32 XMcdma_SetChanCoalesceDelay(XMcdma_ChanCtrl *Chan, u32 IrqCoalesce,
 				u32 IrqDelay);
+u32 XMcdma_SetChanAdaptCoalesce(XMcdma_ChanCtrl *Chan,
+				XMcdma_AdaptCoalesceCfg *CfgPtr);
+u32 XMcdma_ChanAdaptCoalesceSample(XMcdma_ChanCtrl *Chan);
 u32 XMCdma_SetChan_Weight(XMcdma_ChanCtrl *Chan, u8 Weight);
 u32 XMCdma_GetChan_Weight(XMcdma_ChanCtrl *Chan);
 u32 XMCdma_GetChan_PktDoneCnt(XMcdma_ChanCtrl *Chan);
+u32 XMcdma_SetChanSwWeight(XMcdma_ChanCtrl *Chan, u32 Weight);
+XMcdma_ChanCtrl *XMcdma_WrrNextChan(XMcdma *InstancePtr, u32 Direction,
+				    u32 ChanMask, u32 NumBd);
 void XMcdma_SetSGAWCache(XMcdma *InstancePtr, u8 Value);
 void XMcdma_SetSGARCache(XMcdma *InstancePtr, u8 Value);
 
@@ -623,7 +696,9 @@ u32 XMcDma_ChanBdCreate(XMcdma_ChanCtrl *Chan, UINTPTR Addr, u32 Count);
 u32 XMcDma_ChanSubmit(XMcdma_ChanCtrl *Chan, UINTPTR BufAddr, u32 len);
 u32 XMcDma_Chan_Sideband_Submit(XMcdma_ChanCtrl *ChanPtr, UINTPTR BufAddr,
 				u32 Len, u32 *AppPtr, u16 Tuser, u16 Tid);
+u32 XMcDma_ChanUnSubmit(XMcdma_ChanCtrl *Chan, u32 BdCount);
 u32 XMcDma_ChanToHw(XMcdma_ChanCtrl *Chan);
+u32 XMcDma_ChanToHwBatch(XMcdma *InstancePtr, u32 Direction, u32 ChanMask);
 int XMcdma_BdChainFromHW(XMcdma_ChanCtrl *Chan, u32 BdLimit,
 			 XMcdma_Bd **BdSetPtr);
 int XMcdma_BdChainFree(XMcdma_ChanCtrl *Chan, int BdCount, XMcdma_Bd *BdSetPtr);
@@ -41,6 +41,9 @@
 *  1.2  mus  11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
 *  1.3  rsp  02/11/19 Add top level submit XMcDma_Chan_Sideband_Submit() API
 *                     to program BD control and sideband information.
+*  1.3  rsp  06/20/19 Add adaptive interrupt coalescing controller.
+*  1.3  rsp  06/24/19 Add XMcDma_ChanToHwBatch() multi channel submission.
+*  1.3  rsp  06/26/19 Add XMcDma_ChanUnSubmit() to drop submitted BDs.
 ******************************************************************************/
 
 #include "xmcdma.h"
@@ -205,6 +208,8 @@ u32 XMcDma_ChanBdCreate(XMcdma_ChanCtrl *Chan, UINTPTR Addr, u32 Count)
 	Chan->BdSubmitCnt = 0;
 	Chan->BdCnt = 0;
 	Chan->BdDoneCnt = 0;
+	Chan->BdDoneTotal = 0;
+	memset(&Chan->Adapt, 0, sizeof(XMcdma_AdaptCoalesce));
 	Chan->Separation = sizeof(XMcdma_Bd);
 
 	memset((void *)Addr, 0, sizeof(XMcdma_Bd) * Count);
@@ -416,6 +421,41 @@ u32 XMcDma_Chan_Sideband_Submit(XMcdma_ChanCtrl *ChanPtr, UINTPTR BufAddr,
 	return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+* This function gives back the last BDs submitted with XMcDma_ChanSubmit()
+* that are not handed to the hardware yet, so that a transfer can be dropped
+* when submitting one of its buffers fails.
+*
+* @param	Chan is the MCDMA Channel to be worked on.
+* @param	BdCount is the number of BDs to give back.
+*
+* @return
+*		- XST_SUCCESS if the BDs are given back
+*		- XST_INVALID_PARAM if fewer BDs are pending
+*
+*****************************************************************************/
+u32 XMcDma_ChanUnSubmit(XMcdma_ChanCtrl *Chan, u32 BdCount)
+{
+	XMcdma_Bd *BdCurPtr = Chan->BdRestart;
+	u32 i;
+
+	if (BdCount > Chan->BdPendingCnt) {
+		return XST_INVALID_PARAM;
+	}
+
+	for (i = 0; i < BdCount; i++) {
+		BdCurPtr = XMcdma_BdChainPrevBd(Chan, BdCurPtr);
+	}
+
+	Chan->BdRestart = BdCurPtr;
+	Chan->BdTail = XMcdma_BdChainPrevBd(Chan, BdCurPtr);
+	Chan->BdPendingCnt -= BdCount;
+	Chan->BdCnt += BdCount;
+
+	return XST_SUCCESS;
+}
+
 /*****************************************************************************/
 /**
 * This function triggers/Starts the h/w by programming the Current and Tail
@@ -452,6 +492,74 @@ u32 XMcDma_ChanToHw(XMcdma_ChanCtrl *Chan)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* This function hands the BDs prepared with XMcDma_ChanSubmit() on several
+* channels of one direction to the hardware. Each selected channel with
+* pending BDs gets its current descriptor programmed if idle and its tail
+* descriptor written once; all of them are then enabled with a single write
+* of the channel enable register. Channels with nothing pending are skipped.
+*
+* @param	InstancePtr is a pointer to the XMcdma instance.
+* @param	Direction is XMCDMA_MEM_TO_DEV for MM2S or XMCDMA_DEV_TO_MEM for
+*		S2MM channels.
+* @param	ChanMask selects the channels, bit (ChanId - 1) for each
+*		channel. Use XMCDMA_ALL_CHAN_MASK for all of them.
+*
+* @return
+*		- XST_SUCCESS if all channels with pending BDs were started
+*		- XST_DMA_ERROR if the engine could not be started
+*
+*****************************************************************************/
+u32 XMcDma_ChanToHwBatch(XMcdma *InstancePtr, u32 Direction, u32 ChanMask)
+{
+	XMcdma_ChanCtrl *Chan = NULL;
+	u32 NumChans;
+	u32 EnMask = 0;
+	u32 ChanId;
+	int Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Direction <= XMCDMA_MEM_TO_DEV);
+
+	if (Direction == XMCDMA_MEM_TO_DEV)
+		NumChans = InstancePtr->Config.TxNumChannels;
+	else
+		NumChans = InstancePtr->Config.RxNumChannels;
+
+	for (ChanId = 1; ChanId <= NumChans; ChanId++) {
+		if (!(ChanMask & (1U << (ChanId - 1))))
+			continue;
+
+		if (Direction == XMCDMA_MEM_TO_DEV)
+			Chan = XMcdma_GetMcdmaTxChan(InstancePtr, ChanId);
+		else
+			Chan = XMcdma_GetMcdmaRxChan(InstancePtr, ChanId);
+
+		if (Chan->BdPendingCnt == 0)
+			continue;
+
+		(void)XMcdma_UpdateChanCDesc(Chan);
+
+		Status = XMcdma_UpdateChanTDesc(Chan);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Update TAIL DESC failed %x", Status);
+			return Status;
+		}
+
+		EnMask |= (1U << (ChanId - 1));
+	}
+
+	/* Enable all the started channels at once */
+	if (EnMask) {
+		XMcdma_WriteReg(Chan->ChanBase, XMCDMA_CHEN_OFFSET,
+				XMcdma_ReadReg(Chan->ChanBase,
+					       XMCDMA_CHEN_OFFSET) | EnMask);
+	}
+
+	return XST_SUCCESS;
+}
+
 /*****************************************************************************/
 /**
 * Returns a set of BD(s) that have been processed by hardware. The returned
@@ -535,6 +643,7 @@ int XMcdma_BdChainFromHW(XMcdma_ChanCtrl *Chan, u32 BdLimit, XMcdma_Bd **BdSetPt
 		Chan->BdSubmitCnt -= BdCount;
 		Chan->BdCnt += BdCount;
 		Chan->BdDoneCnt += BdCount;
+		Chan->BdDoneTotal += BdCount;
 		XMCDMA_CHAN_SEEKAHEAD(Chan, Chan->BdHead, BdCount);
 
 		return BdCount;
@@ -771,6 +880,121 @@ u32 XMcdma_SetChanCoalesceDelay(XMcdma_ChanCtrl *Chan, u32 IrqCoalesce, u32 IrqD
 	return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+* Enable or disable adaptive interrupt coalescing for a particular channel.
+*
+* In adaptive mode XMcdma_ChanAdaptCoalesceSample(), called by the application
+* once per sample period, averages the number of BDs retrieved with
+* XMcdma_BdChainFromHW() per period and sets the Irq threshold to that rate
+* divided by TargetIrqs, clamped to [MinCoalesce, MaxCoalesce]. The Irq delay
+* is scaled linearly between MinDelay and MaxDelay along with the threshold.
+*
+* The lower bounds are programmed immediately. Disabling keeps the last
+* programmed values.
+*
+* @param	Chan is the MCDMA Channel to be worked on.
+* @param	CfgPtr points to the bounds to use, or NULL to disable adaptive
+*		mode. The bounds are copied.
+*
+* @return
+*		- XST_SUCCESS if adaptive mode was enabled or disabled
+*		- XST_INVALID_PARAM if a bound is out of range or TargetIrqs
+*		is 0
+*
+*****************************************************************************/
+u32 XMcdma_SetChanAdaptCoalesce(XMcdma_ChanCtrl *Chan,
+				XMcdma_AdaptCoalesceCfg *CfgPtr)
+{
+	XMcdma_AdaptCoalesce *Adapt = &Chan->Adapt;
+
+	if (CfgPtr == NULL) {
+		Adapt->IsEnabled = 0;
+		return XST_SUCCESS;
+	}
+
+	if (CfgPtr->MinCoalesce == 0 ||
+	    CfgPtr->MinCoalesce > CfgPtr->MaxCoalesce ||
+	    CfgPtr->MaxCoalesce > 0xFF || CfgPtr->MinDelay == 0 ||
+	    CfgPtr->MinDelay > CfgPtr->MaxDelay || CfgPtr->MaxDelay > 0xFF ||
+	    CfgPtr->TargetIrqs == 0) {
+		xil_printf("Invalid adaptive coalescing bounds\n\r");
+		return XST_INVALID_PARAM;
+	}
+
+	Adapt->Cfg = *CfgPtr;
+	Adapt->LastDoneTotal = Chan->BdDoneTotal;
+	Adapt->AvgRate = 0;
+	Adapt->Coalesce = CfgPtr->MinCoalesce;
+	Adapt->Delay = CfgPtr->MinDelay;
+
+	(void)XMcdma_SetChanCoalesceDelay(Chan, Adapt->Coalesce, Adapt->Delay);
+
+	Adapt->IsEnabled = 1;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Take one sample for the adaptive interrupt coalescing controller of a
+* channel and reprogram the channel if the computed setting changed. Call
+* this once per sample period from the context that calls
+* XMcdma_BdChainFromHW(), or with that context locked out.
+*
+* @param	Chan is the MCDMA Channel to be worked on.
+*
+* @return
+*		- XST_SUCCESS if the sample was taken
+*		- XST_FAILURE if adaptive mode is not enabled on the channel
+*
+* @note		The rate is smoothed over about four periods so that a single
+*		idle or busy period does not make the setting oscillate.
+*
+*****************************************************************************/
+u32 XMcdma_ChanAdaptCoalesceSample(XMcdma_ChanCtrl *Chan)
+{
+	XMcdma_AdaptCoalesce *Adapt = &Chan->Adapt;
+	XMcdma_AdaptCoalesceCfg *Cfg = &Adapt->Cfg;
+	u32 Done;
+	u32 Coalesce;
+	u32 Delay;
+
+	if (!Adapt->IsEnabled)
+		return XST_FAILURE;
+
+	Done = Chan->BdDoneTotal - Adapt->LastDoneTotal;
+	Adapt->LastDoneTotal = Chan->BdDoneTotal;
+
+	/* Saturate so the fixed point average cannot overflow */
+	if (Done > 0x00FFFFFF)
+		Done = 0x00FFFFFF;
+
+	/* Exponential average with weight 1/4, 3 fraction bits */
+	Adapt->AvgRate = Adapt->AvgRate - (Adapt->AvgRate >> 2) +
+			 ((Done << 3) >> 2);
+
+	Coalesce = (Adapt->AvgRate >> 3) / Cfg->TargetIrqs;
+	if (Coalesce < Cfg->MinCoalesce)
+		Coalesce = Cfg->MinCoalesce;
+	else if (Coalesce > Cfg->MaxCoalesce)
+		Coalesce = Cfg->MaxCoalesce;
+
+	Delay = Cfg->MinDelay;
+	if (Cfg->MaxCoalesce != Cfg->MinCoalesce)
+		Delay += ((Cfg->MaxDelay - Cfg->MinDelay) *
+			  (Coalesce - Cfg->MinCoalesce)) /
+			 (Cfg->MaxCoalesce - Cfg->MinCoalesce);
+
+	if (Coalesce != Adapt->Coalesce || Delay != Adapt->Delay) {
+		Adapt->Coalesce = Coalesce;
+		Adapt->Delay = Delay;
+		(void)XMcdma_SetChanCoalesceDelay(Chan, Coalesce, Delay);
+	}
+
+	return XST_SUCCESS;
+}
+
 
 /*****************************************************************************/
 /**
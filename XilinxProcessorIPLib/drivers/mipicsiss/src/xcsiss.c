@@ -41,6 +41,7 @@
 * 1.0 vsa 07/21/15 Initial release
 * 1.1 sss 08/17/16 Added 64 bit support
 *     sss 08/29/16 Added check for Dphy register interface
+* 1.2 adk 10/15/19 Added the frame timing functions
 * </pre>
 *
 ******************************************************************************/
@@ -673,4 +674,120 @@ static u32 CsiSs_ComputeSubCoreAbsAddr(UINTPTR SsBaseAddr, UINTPTR SsHighAddr,
 
 	return Status;
 }
+
+/*****************************************************************************/
+/**
+* This function enables the per virtual channel frame timing of the CSI2 Rx
+* Controller. See XCsi_SetTimeStampHandler().
+*
+* @param	InstancePtr is a pointer to the Subsystem instance to be
+*		worked on.
+* @param	TimeStampHandler returns a free running time stamp, NULL to
+*		disable the frame timing.
+* @param	TimeStampRef is passed to TimeStampHandler.
+*
+* @return	None
+*
+* @note		To be called while the subsystem interrupts are disabled.
+*
+******************************************************************************/
+void XCsiSs_SetTimeStampHandler(XCsiSs *InstancePtr,
+				XCsi_TimeStampHandler TimeStampHandler,
+				void *TimeStampRef)
+{
+	/* Verify argument. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	XCsi_SetTimeStampHandler(InstancePtr->CsiPtr, TimeStampHandler,
+					TimeStampRef);
+}
+
+/*****************************************************************************/
+/**
+* This function returns the reference to install with
+* XCsiSs_VcFrameWrittenHandler() as the done callback of the frame buffer
+* write instance a virtual channel is routed to.
+*
+* @param	InstancePtr is a pointer to the Subsystem instance to be
+*		worked on.
+* @param	Vc is the virtual channel number, 0 to XCSI_TIMING_MAX_VC - 1.
+*
+* @return	Callback reference of the virtual channel.
+*
+* @note		None
+*
+******************************************************************************/
+void *XCsiSs_GetVcTimingRef(XCsiSs *InstancePtr, u8 Vc)
+{
+	/* Verify argument. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return XCsi_GetVcTimingRef(InstancePtr->CsiPtr, Vc);
+}
+
+/*****************************************************************************/
+/**
+* This function gets the frame timing statistics of a virtual channel.
+*
+* @param	InstancePtr is a pointer to the Subsystem instance to be
+*		worked on.
+* @param	Vc is the virtual channel number, 0 to XCSI_TIMING_MAX_VC - 1.
+* @param	StatsPtr is filled up by this function.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+void XCsiSs_GetVcStats(XCsiSs *InstancePtr, u8 Vc, XCsi_VcStats *StatsPtr)
+{
+	/* Verify argument. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	XCsi_GetVcStats(InstancePtr->CsiPtr, Vc, StatsPtr);
+}
+
+/*****************************************************************************/
+/**
+* This function clears the frame timing statistics of all the virtual
+* channels.
+*
+* @param	InstancePtr is a pointer to the Subsystem instance to be
+*		worked on.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+void XCsiSs_ResetVcStats(XCsiSs *InstancePtr)
+{
+	/* Verify argument. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	XCsi_ResetVcStats(InstancePtr->CsiPtr);
+}
+
+/*****************************************************************************/
+/**
+* This function returns the spread of the last Frame Start of a set of
+* virtual channels.
+*
+* @param	InstancePtr is a pointer to the Subsystem instance to be
+*		worked on.
+* @param	VcMask has bit n set for virtual channel n to be included.
+*
+* @return	The skew in time stamp units, 0 if less than two of the
+*		channels have started a frame.
+*
+* @note		None
+*
+******************************************************************************/
+u64 XCsiSs_GetVcStartSkew(XCsiSs *InstancePtr, u32 VcMask)
+{
+	/* Verify argument. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return XCsi_GetVcStartSkew(InstancePtr->CsiPtr, VcMask);
+}
 /** @} */
@@ -104,6 +104,21 @@
 * The XCsiSs_SetCallBack() is used to register the call back functions
 * for MIPI CSI2 Rx Subsystem driver with the corresponding handles
 *
+* <b>Frame Timing</b>
+*
+* XCsiSs_SetTimeStampHandler() enables the per virtual channel frame timing of
+* the CSI2 Rx Controller driver, for virtual channels 0 to 3. The Frame Start
+* and Frame End short packets are then time stamped by the interrupt handler
+* and XCsiSs_GetVcStats() returns the frame period, duration and drop counts.
+*
+* When the video stream is split by virtual channel (TDEST) into one frame
+* buffer write instance per channel, each instance queues its own frames and
+* recycles its buffers from its own interrupt. Installing
+* XCsiSs_VcFrameWrittenHandler() as its done callback, with the reference
+* returned by XCsiSs_GetVcTimingRef(), adds the latency from Frame End to the
+* frame being in memory. XCsiSs_GetVcStartSkew() gives the spread of the last
+* Frame Start of the channels of cameras which are expected to run in sync.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -144,6 +159,7 @@
 *                  for CR-965028.
 *     ms  03/17/17 Added readme.txt file in examples folder for doxygen
 *                  generation.
+* 1.2 adk 10/15/19 Added per virtual channel frame timing.
 * </pre>
 *
 ******************************************************************************/
@@ -292,6 +308,17 @@ void XCsiSs_ReportCoreInfo(XCsiSs *InstancePtr);
 void XCsiSs_GetLaneInfo(XCsiSs *InstancePtr);
 void XCsiSs_GetShortPacket(XCsiSs *InstancePtr);
 void XCsiSs_GetVCInfo(XCsiSs *InstancePtr);
+void XCsiSs_SetTimeStampHandler(XCsiSs *InstancePtr,
+				XCsi_TimeStampHandler TimeStampHandler,
+				void *TimeStampRef);
+void *XCsiSs_GetVcTimingRef(XCsiSs *InstancePtr, u8 Vc);
+void XCsiSs_GetVcStats(XCsiSs *InstancePtr, u8 Vc, XCsi_VcStats *StatsPtr);
+void XCsiSs_ResetVcStats(XCsiSs *InstancePtr);
+u64 XCsiSs_GetVcStartSkew(XCsiSs *InstancePtr, u32 VcMask);
+
+#define XCsiSs_VcFrameWrittenHandler	XCsi_VcFrameWrittenHandler
+				/**< Done callback of the frame buffer write
+				  *  instance of a virtual channel */
 
 /* Self test function in xcsiss_selftest.c */
 u32 XCsiSs_SelfTest(XCsiSs *InstancePtr);
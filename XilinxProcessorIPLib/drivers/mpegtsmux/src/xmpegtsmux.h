@@ -66,8 +66,73 @@ typedef struct {
     u32 IsReady;
     XMpegTsMux_Callback Callback;
     void *CallbackRef;
+    void *JobQueue;    /* XMpegtsmux_JobQueue driven by the done interrupt */
 } XMpegtsmux;
 
+/*
+ * Job queue, see xmpegtsmux_jobq.c.
+ *
+ * The contexts and tables of a program stay in memory and are described
+ * once by an XMpegtsmux_Program. A job runs one pass of the core over
+ * NumDesc descriptors of a program. Jobs are started back to back from the
+ * done interrupt, and only the registers which differ from the previous job
+ * are written, so programs which share tables cost a start and a few
+ * writes per pass.
+ */
+#define XMPEGTSMUX_MAX_PROGRAMS		32	/* Program contexts */
+#define XMPEGTSMUX_JOBQ_DEPTH		64	/* Jobs queued */
+
+/* Registers written per job, in the order of XMpegtsmux_JobQueue.Shadow */
+#define XMPEGTSMUX_JOB_NUM_REGS		11
+
+typedef struct {
+    u64 MuxContext;       /* Address of the mux context */
+    u64 StreamContext;    /* Address of the stream contexts */
+    u64 StreamIdTable;    /* Address of the stream id table */
+    u64 NumStreamsTable;  /* Address of the number of streams table */
+    u32 Jobs;             /* Jobs completed */
+    u64 Bytes;            /* Bytes of the jobs completed */
+} XMpegtsmux_Program;
+
+typedef struct {
+    u32 Program;          /* Index of the program context */
+    u32 NumDesc;          /* Descriptors of the pass, up to 255 */
+    u32 DataIn;           /* HwStructIn_data_in */
+    u32 DataOutByteInf;   /* HwStructIn_data_out_byte_inf */
+    u32 Bytes;            /* Bytes muxed, for the statistics */
+    u64 Status;           /* HwStructIn_status on completion */
+    void *Ref;            /* Application reference */
+} XMpegtsmux_Job;
+
+typedef void (*XMpegtsmux_JobHandler)(void *CallbackRef, XMpegtsmux_Job *JobPtr);
+typedef u64 (*XMpegtsmux_TimeHandler)(void *TimeRef);
+
+typedef struct {
+    u32 Jobs;             /* Jobs completed */
+    u32 Descriptors;      /* Descriptors of the jobs completed */
+    u64 Bytes;            /* Bytes of the jobs completed */
+    u32 RegWrites;        /* Register writes to start the jobs */
+    u32 MaxQueued;        /* Highest number of jobs waiting */
+    u64 BusyTime;         /* Time with a job running */
+} XMpegtsmux_JobStats;
+
+typedef struct {
+    XMpegtsmux *InstancePtr;
+    XMpegtsmux_Program Programs[XMPEGTSMUX_MAX_PROGRAMS];
+    XMpegtsmux_Job *Queue[XMPEGTSMUX_JOBQ_DEPTH];
+    u32 Head;
+    u32 Count;            /* Jobs queued, the running job included */
+    u32 Running;
+    u32 Shadow[XMPEGTSMUX_JOB_NUM_REGS]; /* Register values last written */
+    u32 ShadowValid;
+    XMpegtsmux_JobHandler DoneHandler;
+    void *DoneRef;
+    XMpegtsmux_TimeHandler TimeHandler;
+    void *TimeRef;
+    u64 StartTime;
+    XMpegtsmux_JobStats Stats;
+} XMpegtsmux_JobQueue;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 #ifndef __linux__
 #define XMpegtsmux_WriteReg(BaseAddress, RegOffset, Data) \
@@ -133,6 +198,23 @@ void *XMpegTsMuxIntrHandler(void *InstancePtr);
 void XMpegTsMux_SetCallback(XMpegtsmux *InstancePtr, void *CallbackFunc,
 	void *CallbackRef);
 
+int XMpegtsmux_JobQueueInitialize(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux *InstancePtr, XMpegtsmux_JobHandler DoneHandler,
+	void *DoneRef);
+void XMpegtsmux_JobQueueSetTime(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_TimeHandler TimeHandler, void *TimeRef);
+int XMpegtsmux_JobQueueSetProgram(XMpegtsmux_JobQueue *QueuePtr, u32 Program,
+	const XMpegtsmux_Program *ProgramPtr);
+int XMpegtsmux_JobQueueSubmit(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_Job *JobPtr);
+int XMpegtsmux_JobQueueSubmitBatch(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_Job **Jobs, u32 NumJobs);
+void XMpegtsmux_JobQueueDone(XMpegtsmux_JobQueue *QueuePtr);
+u32 XMpegtsmux_JobQueuePending(XMpegtsmux_JobQueue *QueuePtr);
+void XMpegtsmux_JobQueueGetStats(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_JobStats *StatsPtr);
+void XMpegtsmux_JobQueueResetStats(XMpegtsmux_JobQueue *QueuePtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -98,6 +98,10 @@ void *XMpegTsMuxIntrHandler(void *InstancePtr)
 	if (XMpegtsmux_InterruptGetStatus(Ptr)) {
 		XMpegtsmux_InterruptClear(Ptr,
 			XMPEG_TS_MUX_ISR_DONE_BIT_MASK);
+		/* Complete the job and start the next one first */
+		if (Ptr->JobQueue)
+			XMpegtsmux_JobQueueDone(
+				(XMpegtsmux_JobQueue *)Ptr->JobQueue);
 		if (Ptr->Callback)
 			Ptr->Callback(Ptr);
 	}
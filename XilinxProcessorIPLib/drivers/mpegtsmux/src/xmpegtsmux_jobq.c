@@ -0,0 +1,411 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xmpegtsmux_jobq.c
+ * @addtogroup mpegtsmux_v1_0
+ * @{
+ *
+ * The functions in this file queue mux jobs and start them back to back from
+ * the done interrupt.
+ *
+ * The application describes the contexts and tables of each program once
+ * with XMpegtsmux_JobQueueSetProgram(). A job then only carries the program
+ * index and the per pass values. Starting a job writes the registers which
+ * differ from the previous job only, so running several jobs of the same
+ * program, or of programs sharing their tables, takes a few writes each.
+ * XMpegtsmux_JobQueueSubmitBatch() queues the jobs of several programs at
+ * once and the core runs them without waiting for the application.
+ *
+ * The done handler is called from the interrupt for each job, in order.
+ * The queue must be initialized with the interrupts of the core disabled.
+ *
+ ******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "xmpegtsmux_hw.h"
+#include "xmpegtsmux.h"
+
+/************************** Constant Definitions *****************************/
+#define XMPEGTSMUX_MAX_NUM_DESC		255
+
+/************************** Variable Definitions *****************************/
+/* Job registers, in the order of XMpegtsmux_JobQueue.Shadow */
+static const u32 XMpegtsmux_JobRegs[XMPEGTSMUX_JOB_NUM_REGS] = {
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_MUX_CONTEXT_DATA,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_MUX_CONTEXT_DATA + 4,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_STREAM_CONTEXT_DATA,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_STREAM_CONTEXT_DATA + 4,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_STREAM_ID_TABLE_DATA,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_STREAM_ID_TABLE_DATA + 4,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_NUM_STREAMS_TABLE_DATA,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_NUM_STREAMS_TABLE_DATA + 4,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_DATA_IN_DATA,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_DATA_OUT_BYTE_INF_DATA,
+	XMPEGTSMUX_CTRL_ADDR_HWSTRUCTIN_NUM_DESC_DATA,
+};
+
+/************************** Function Prototypes ******************************/
+static void XMpegtsmux_JobStart(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_Job *JobPtr);
+
+/*****************************************************************************/
+/**
+ *
+ * This function initializes a job queue and attaches it to the done
+ * interrupt of a core.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ * @param	InstancePtr is a pointer to the MPEG TS MUX IP instance.
+ * @param	DoneHandler is called for each job completed, may be NULL.
+ * @param	DoneRef is passed to DoneHandler.
+ *
+ * @return	XST_SUCCESS, or XST_FAILURE when the core is busy.
+ *
+ * @note	The done interrupt of the core must be enabled and
+ *		XMpegTsMuxIntrHandler() connected to the interrupt system.
+ *
+ ******************************************************************************/
+int XMpegtsmux_JobQueueInitialize(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux *InstancePtr, XMpegtsmux_JobHandler DoneHandler,
+	void *DoneRef)
+{
+	/* Verify arguments. */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (!XMpegtsmux_IsIdle(InstancePtr))
+		return XST_FAILURE;
+
+	memset(QueuePtr, 0, sizeof(XMpegtsmux_JobQueue));
+	QueuePtr->InstancePtr = InstancePtr;
+	QueuePtr->DoneHandler = DoneHandler;
+	QueuePtr->DoneRef = DoneRef;
+
+	InstancePtr->JobQueue = QueuePtr;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function installs a free running time stamp for the busy time
+ * statistics.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ * @param	TimeHandler returns the time, NULL to stop measuring.
+ * @param	TimeRef is passed to TimeHandler.
+ *
+ * @return	None.
+ *
+ ******************************************************************************/
+void XMpegtsmux_JobQueueSetTime(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_TimeHandler TimeHandler, void *TimeRef)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(QueuePtr != NULL);
+
+	QueuePtr->TimeHandler = TimeHandler;
+	QueuePtr->TimeRef = TimeRef;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function describes the contexts and tables of a program. They stay
+ * in memory and are used by every job of the program.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ * @param	Program is the program index, below XMPEGTSMUX_MAX_PROGRAMS.
+ * @param	ProgramPtr holds the addresses, its statistics are ignored.
+ *
+ * @return	XST_SUCCESS, or XST_DEVICE_BUSY when jobs of the program are
+ *		queued.
+ *
+ ******************************************************************************/
+int XMpegtsmux_JobQueueSetProgram(XMpegtsmux_JobQueue *QueuePtr, u32 Program,
+	const XMpegtsmux_Program *ProgramPtr)
+{
+	XMpegtsmux_Program *Prog;
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(Program < XMPEGTSMUX_MAX_PROGRAMS);
+	Xil_AssertNonvoid(ProgramPtr != NULL);
+
+	for (Index = 0; Index < QueuePtr->Count; Index++) {
+		if (QueuePtr->Queue[(QueuePtr->Head + Index) %
+				XMPEGTSMUX_JOBQ_DEPTH]->Program == Program)
+			return XST_DEVICE_BUSY;
+	}
+
+	Prog = &QueuePtr->Programs[Program];
+	Prog->MuxContext = ProgramPtr->MuxContext;
+	Prog->StreamContext = ProgramPtr->StreamContext;
+	Prog->StreamIdTable = ProgramPtr->StreamIdTable;
+	Prog->NumStreamsTable = ProgramPtr->NumStreamsTable;
+	Prog->Jobs = 0;
+	Prog->Bytes = 0;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function queues a job and starts it when the core is idle.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ * @param	JobPtr is the job, owned by the queue until its done handler
+ *		is called.
+ *
+ * @return	XST_SUCCESS, or XST_DEVICE_BUSY when the queue is full.
+ *
+ ******************************************************************************/
+int XMpegtsmux_JobQueueSubmit(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_Job *JobPtr)
+{
+	return XMpegtsmux_JobQueueSubmitBatch(QueuePtr, &JobPtr, 1);
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function queues several jobs, typically one per program, and starts
+ * the first one when the core is idle. The jobs run in the order given.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ * @param	Jobs is an array of NumJobs jobs.
+ * @param	NumJobs is the number of jobs.
+ *
+ * @return	XST_SUCCESS, or XST_DEVICE_BUSY when the queue cannot take
+ *		all the jobs, in which case none is queued.
+ *
+ * @note	Must not be preempted by XMpegTsMuxIntrHandler(): call it
+ *		with the interrupt of the core masked.
+ *
+ ******************************************************************************/
+int XMpegtsmux_JobQueueSubmitBatch(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_Job **Jobs, u32 NumJobs)
+{
+	u32 Index;
+	u32 Waiting;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(Jobs != NULL);
+
+	if (NumJobs > XMPEGTSMUX_JOBQ_DEPTH - QueuePtr->Count)
+		return XST_DEVICE_BUSY;
+
+	for (Index = 0; Index < NumJobs; Index++) {
+		Xil_AssertNonvoid(Jobs[Index] != NULL);
+		Xil_AssertNonvoid(Jobs[Index]->Program <
+				XMPEGTSMUX_MAX_PROGRAMS);
+		Xil_AssertNonvoid(Jobs[Index]->NumDesc <=
+				XMPEGTSMUX_MAX_NUM_DESC);
+
+		QueuePtr->Queue[(QueuePtr->Head + QueuePtr->Count) %
+				XMPEGTSMUX_JOBQ_DEPTH] = Jobs[Index];
+		QueuePtr->Count++;
+	}
+
+	Waiting = QueuePtr->Count - QueuePtr->Running;
+	if (Waiting > QueuePtr->Stats.MaxQueued)
+		QueuePtr->Stats.MaxQueued = Waiting;
+
+	if (!QueuePtr->Running && QueuePtr->Count)
+		XMpegtsmux_JobStart(QueuePtr, QueuePtr->Queue[QueuePtr->Head]);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function completes the running job and starts the next one. It is
+ * called by XMpegTsMuxIntrHandler() on the done interrupt.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ *
+ * @return	None.
+ *
+ ******************************************************************************/
+void XMpegtsmux_JobQueueDone(XMpegtsmux_JobQueue *QueuePtr)
+{
+	XMpegtsmux_Program *Prog;
+	XMpegtsmux_Job *JobPtr;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(QueuePtr != NULL);
+
+	if (!QueuePtr->Running)
+		return;
+
+	JobPtr = QueuePtr->Queue[QueuePtr->Head];
+	JobPtr->Status = XMpegtsmux_Get_status(QueuePtr->InstancePtr);
+
+	QueuePtr->Head = (QueuePtr->Head + 1) % XMPEGTSMUX_JOBQ_DEPTH;
+	QueuePtr->Count--;
+	QueuePtr->Running = 0;
+
+	if (QueuePtr->TimeHandler)
+		QueuePtr->Stats.BusyTime +=
+			QueuePtr->TimeHandler(QueuePtr->TimeRef) -
+			QueuePtr->StartTime;
+
+	/* Keep the core busy before handing the job back */
+	if (QueuePtr->Count)
+		XMpegtsmux_JobStart(QueuePtr, QueuePtr->Queue[QueuePtr->Head]);
+
+	Prog = &QueuePtr->Programs[JobPtr->Program];
+	Prog->Jobs++;
+	Prog->Bytes += JobPtr->Bytes;
+	QueuePtr->Stats.Jobs++;
+	QueuePtr->Stats.Descriptors += JobPtr->NumDesc;
+	QueuePtr->Stats.Bytes += JobPtr->Bytes;
+
+	if (QueuePtr->DoneHandler)
+		QueuePtr->DoneHandler(QueuePtr->DoneRef, JobPtr);
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function returns the number of jobs queued or running.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ *
+ * @return	Number of jobs.
+ *
+ ******************************************************************************/
+u32 XMpegtsmux_JobQueuePending(XMpegtsmux_JobQueue *QueuePtr)
+{
+	/* Verify arguments. */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+
+	return QueuePtr->Count;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function reads the statistics of the queue. The throughput is
+ * Stats.Bytes over Stats.BusyTime.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ * @param	StatsPtr is filled with the statistics.
+ *
+ * @return	None.
+ *
+ ******************************************************************************/
+void XMpegtsmux_JobQueueGetStats(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_JobStats *StatsPtr)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(QueuePtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = QueuePtr->Stats;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function clears the statistics of the queue and of its programs.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ *
+ * @return	None.
+ *
+ ******************************************************************************/
+void XMpegtsmux_JobQueueResetStats(XMpegtsmux_JobQueue *QueuePtr)
+{
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(QueuePtr != NULL);
+
+	memset(&QueuePtr->Stats, 0, sizeof(XMpegtsmux_JobStats));
+	for (Index = 0; Index < XMPEGTSMUX_MAX_PROGRAMS; Index++) {
+		QueuePtr->Programs[Index].Jobs = 0;
+		QueuePtr->Programs[Index].Bytes = 0;
+	}
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function programs a job, writing the registers which differ from
+ * the previous job only, and starts the core.
+ *
+ * @param	QueuePtr is a pointer to the job queue.
+ * @param	JobPtr is the job.
+ *
+ * @return	None.
+ *
+ ******************************************************************************/
+static void XMpegtsmux_JobStart(XMpegtsmux_JobQueue *QueuePtr,
+	XMpegtsmux_Job *JobPtr)
+{
+	XMpegtsmux_Program *Prog = &QueuePtr->Programs[JobPtr->Program];
+	u64 Base = QueuePtr->InstancePtr->Ctrl_BaseAddress;
+	u32 Regs[XMPEGTSMUX_JOB_NUM_REGS];
+	u32 Index;
+
+	Regs[0] = (u32)Prog->MuxContext;
+	Regs[1] = (u32)(Prog->MuxContext >> 32);
+	Regs[2] = (u32)Prog->StreamContext;
+	Regs[3] = (u32)(Prog->StreamContext >> 32);
+	Regs[4] = (u32)Prog->StreamIdTable;
+	Regs[5] = (u32)(Prog->StreamIdTable >> 32);
+	Regs[6] = (u32)Prog->NumStreamsTable;
+	Regs[7] = (u32)(Prog->NumStreamsTable >> 32);
+	Regs[8] = JobPtr->DataIn;
+	Regs[9] = JobPtr->DataOutByteInf;
+	Regs[10] = JobPtr->NumDesc;
+
+	for (Index = 0; Index < XMPEGTSMUX_JOB_NUM_REGS; Index++) {
+		if (QueuePtr->ShadowValid &&
+				QueuePtr->Shadow[Index] == Regs[Index])
+			continue;
+		XMpegtsmux_WriteReg(Base, XMpegtsmux_JobRegs[Index],
+			Regs[Index]);
+		QueuePtr->Shadow[Index] = Regs[Index];
+		QueuePtr->Stats.RegWrites++;
+	}
+	QueuePtr->ShadowValid = 1;
+
+	if (QueuePtr->TimeHandler)
+		QueuePtr->StartTime = QueuePtr->TimeHandler(QueuePtr->TimeRef);
+
+	QueuePtr->Running = 1;
+	XMpegtsmux_Start(QueuePtr->InstancePtr);
+}
+/** @} */
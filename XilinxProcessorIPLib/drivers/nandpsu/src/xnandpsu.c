@@ -101,6 +101,10 @@
 * 1.5   mus    11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
 * 1.5   mus    11/05/18 Updated XNandPsu_ChangeClockFreq to fix compilation
 *                       warnings.
+* 1.6   adk    10/15/19 Read runs of full pages in a block with the read cache
+*                       sequential commands in XNandPsu_Read.
+*                       Added XNandPsu_WriteMultiPlane, XNandPsu_ReadMultiPlane
+*                       and XNandPsu_CfgInitializeBbtCache.
 *
 * </pre>
 *
@@ -179,10 +183,18 @@ static s32 XNandPsu_OnfiReadParamPage(XNandPsu *InstancePtr, u32 Target,
 						u8 *Buf);
 
 static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
-							u32 Col, u8 *Buf);
+						u32 Col, u8 *Buf, u8 Cmd2);
 
 static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
-							u32 Col, u8 *Buf);
+						u32 Col, u8 *Buf, u32 ReadOp);
+
+static s32 XNandPsu_ReadCachePages(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u32 NumPages, u8 *Buf);
+
+static s32 XNandPsu_ReadPlane(XNandPsu *InstancePtr, u32 Target, u32 Page,
+							u8 Cmd2);
+
+static s32 XNandPsu_CheckPlanes(XNandPsu *InstancePtr, u32 Page);
 
 static s32 XNandPsu_CheckOnDie(XNandPsu *InstancePtr, OnfiParamPage *Param);
 
@@ -231,6 +243,37 @@ static void XNandPsu_Update_DmaAddr(XNandPsu *InstancePtr, u8* Buf);
 ******************************************************************************/
 s32 XNandPsu_CfgInitialize(XNandPsu *InstancePtr, XNandPsu_Config *ConfigPtr,
 				u32 EffectiveAddr)
+{
+	return XNandPsu_CfgInitializeBbtCache(InstancePtr, ConfigPtr,
+						EffectiveAddr, NULL);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a specific XNandPsu instance like
+* XNandPsu_CfgInitialize(), keeping a copy of the RAM based bad block table
+* in the user buffer. If the buffer already holds a valid table for the same
+* flash geometry, like after a warm boot, the table is taken from it instead
+* of being searched in flash.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	ConfigPtr points to XNandPsu device configuration structure.
+* @param	EffectiveAddr is the base address of NAND flash controller.
+* @param	BbtCachePtr is the bad block table copy in memory retained
+*		across warm boots. It can be NULL.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if fail.
+*
+* @note		The copy is validated with a checksum, so the buffer may hold
+*		random data on a cold boot.
+*
+******************************************************************************/
+s32 XNandPsu_CfgInitializeBbtCache(XNandPsu *InstancePtr,
+				XNandPsu_Config *ConfigPtr, u32 EffectiveAddr,
+				XNandPsu_BbtCache *BbtCachePtr)
 {
 	s32 Status = XST_FAILURE;
 
@@ -238,6 +281,7 @@ s32 XNandPsu_CfgInitialize(XNandPsu *InstancePtr, XNandPsu_Config *ConfigPtr,
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(ConfigPtr != NULL);
 
+	InstancePtr->BbtCache = BbtCachePtr;
 	/* Initialize InstancePtr Config structure */
 	InstancePtr->Config.DeviceId = ConfigPtr->DeviceId;
 	InstancePtr->Config.BaseAddress = EffectiveAddr;
@@ -474,6 +518,7 @@ static void XNandPsu_InitGeometry(XNandPsu *InstancePtr, OnfiParamPage *Param)
 	InstancePtr->Geometry.ColAddrCycles = (Param->AddrCycles >> 4U) & 0xFU;
 	InstancePtr->Geometry.NumBitsPerCell = Param->BitsPerCell;
 	InstancePtr->Geometry.NumBitsECC = Param->EccBits;
+	InstancePtr->Geometry.NumPlanes = (u8)(1U << (Param->PlaneAddrBits & 0x7U));
 	InstancePtr->Geometry.BlockSize = (Param->PagesPerBlock *
 						Param->BytesPerPage);
 	InstancePtr->Geometry.NumTargetBlocks = (Param->BlocksPerLun *
@@ -535,6 +580,14 @@ static void XNandPsu_InitFeatures(XNandPsu *InstancePtr, OnfiParamPage *Param)
 								1U : 0U;
 	InstancePtr->Features.ExtPrmPage = ((Param->Features & (1U << 7)) != 0U) ?
 								1U : 0U;
+	InstancePtr->Features.ReadCache = ((Param->OptionalCmds & (1U << 1)) != 0U) ?
+								1U : 0U;
+	InstancePtr->Features.MultiPlaneProg = ((Param->Features & (1U << 3)) != 0U) ?
+								1U : 0U;
+	/* Plane data is output with change read column enhanced */
+	InstancePtr->Features.MultiPlaneRead = (((Param->Features & (1U << 6)) != 0U) &&
+				((Param->OptionalCmds & (1U << 6)) != 0U)) ?
+								1U : 0U;
 }
 
 /*****************************************************************************/
@@ -1412,7 +1465,7 @@ s32 XNandPsu_Write(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *SrcBuf)
 		}
 		/* Program page */
 		Status = XNandPsu_ProgramPage(InstancePtr, Target, Page, 0U,
-								BufPtr);
+						BufPtr, ONFI_CMD_PG_PROG2);
 		if (Status != XST_SUCCESS)
 			goto Out;
 
@@ -1456,6 +1509,7 @@ s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *DestBuf)
 	u32 PartialBytes = 0U;
 	u32 RemLen;
 	u32 NumBytes;
+	u32 NumPages;
 	u8 *BufPtr;
 	u8 *DestBufPtr = (u8 *)DestBuf;
 	u64 OffsetVar = Offset;
@@ -1519,9 +1573,30 @@ s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *DestBuf)
 					InstancePtr->Geometry.BytesPerPage :
 					(u32)LengthVar;
 		}
-		/* Read page */
-		Status = XNandPsu_ReadPage(InstancePtr, Target, Page, 0U,
-								BufPtr);
+		/*
+		 * Full pages up to the end of the block are read with the
+		 * read cache commands, the bad block check is per block.
+		 */
+		NumPages = 1U;
+		if ((PartialBytes == 0U) &&
+			(InstancePtr->Features.ReadCache != 0U)) {
+			NumPages = InstancePtr->Geometry.PagesPerBlock -
+				(Page % InstancePtr->Geometry.PagesPerBlock);
+			if ((u64)NumPages * InstancePtr->Geometry.BytesPerPage >
+								LengthVar) {
+				NumPages = (u32)(LengthVar /
+					InstancePtr->Geometry.BytesPerPage);
+			}
+		}
+		if (NumPages > 1U) {
+			Status = XNandPsu_ReadCachePages(InstancePtr, Target,
+						Page, NumPages, BufPtr);
+			NumBytes = NumPages * InstancePtr->Geometry.BytesPerPage;
+		} else {
+			/* Read page */
+			Status = XNandPsu_ReadPage(InstancePtr, Target, Page,
+					0U, BufPtr, XNANDPSU_PROG_RD_MASK);
+		}
 		if (Status != XST_SUCCESS) {
 			goto Out;
 		}
@@ -1645,6 +1720,9 @@ Out:
 * @param	Page is the page address value to program.
 * @param	Col is the column address value to program.
 * @param	Buf is the data buffer to program.
+* @param	Cmd2 is the 2nd cycle command, ONFI_CMD_PG_PROG2 or
+*		ONFI_CMD_MUL_PG_PROG2 to queue the page of a multi-plane
+*		program.
 *
 * @return
 *		- XST_SUCCESS if successful.
@@ -1654,7 +1732,7 @@ Out:
 *
 ******************************************************************************/
 static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
-							u32 Col, u8 *Buf)
+						u32 Col, u8 *Buf, u8 Cmd2)
 {
 	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
 				InstancePtr->Geometry.ColAddrCycles;
@@ -1674,7 +1752,7 @@ static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	}
 	PktCount = InstancePtr->Geometry.BytesPerPage/PktSize;
 
-	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_PG_PROG1, ONFI_CMD_PG_PROG2,
+	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_PG_PROG1, Cmd2,
 					1U, 1U, (u8)AddrCycles);
 
 	if (InstancePtr->DmaMode == XNANDPSU_MDMA) {
@@ -1864,6 +1942,17 @@ Out:
 * @param	Page is the page address value to read.
 * @param	Col is the column address value to read.
 * @param	Buf is the data buffer to fill in.
+* @param	ReadOp is the operation in Program Register which reads the
+*		page data:
+*		- XNANDPSU_PROG_RD_MASK for Read Page (00h-30h).
+*		- XNANDPSU_PROG_RD_CACHE_START_MASK to read the page and
+*		start the array read of the next one (00h-30h, 31h).
+*		- XNANDPSU_PROG_RD_CACHE_SEQ_MASK for Read Cache Sequential
+*		(31h), Page is ignored.
+*		- XNANDPSU_PROG_RD_CACHE_END_MASK for Read Cache End (3Fh),
+*		Page is ignored.
+*		- XNANDPSU_PROG_CHNG_RD_COL_ENH_MASK to output the page of a
+*		plane after a multi-plane read (06h-E0h).
 *
 * @return
 *		- XST_SUCCESS if successful.
@@ -1873,7 +1962,7 @@ Out:
 *
 ******************************************************************************/
 static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
-							u32 Col, u8 *Buf)
+						u32 Col, u8 *Buf, u32 ReadOp)
 {
 	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
 				InstancePtr->Geometry.ColAddrCycles;
@@ -1881,6 +1970,8 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	u32 PktCount;
 	s32 Status = XST_FAILURE;
 	u32 RegVal;
+	u8 Cmd1 = ONFI_CMD_RD1;
+	u8 Cmd2 = ONFI_CMD_RD2;
 
 	/* Assert the input arguments. */
 	Xil_AssertNonvoid(Page < InstancePtr->Geometry.NumPages);
@@ -1893,8 +1984,22 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	}
 	PktCount = InstancePtr->Geometry.BytesPerPage/PktSize;
 
-	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_RD1, ONFI_CMD_RD2,
-					1U, 1U, (u8)AddrCycles);
+	if (ReadOp == XNANDPSU_PROG_RD_CACHE_SEQ_MASK) {
+		Cmd1 = ONFI_CMD_RD_CACHE_SEQ;
+		Cmd2 = 0U;
+		AddrCycles = 0U;
+	} else if (ReadOp == XNANDPSU_PROG_RD_CACHE_END_MASK) {
+		Cmd1 = ONFI_CMD_RD_CACHE_END;
+		Cmd2 = 0U;
+		AddrCycles = 0U;
+	} else if (ReadOp == XNANDPSU_PROG_CHNG_RD_COL_ENH_MASK) {
+		Cmd1 = ONFI_CMD_CHNG_RD_COL_ENHCD1;
+		Cmd2 = ONFI_CMD_CHNG_RD_COL_ENHCD2;
+	} else {
+		/* Read page and read cache start use 00h-30h */
+	}
+
+	XNandPsu_Prepare_Cmd(InstancePtr, Cmd1, Cmd2, 1U, 1U, (u8)AddrCycles);
 
 	if (InstancePtr->DmaMode == XNANDPSU_MDMA) {
 		RegVal = XNANDPSU_INTR_STS_EN_TRANS_COMP_STS_EN_MASK |
@@ -1931,7 +2036,7 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 
 	/* Set Read command in Program Register */
 	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
-				XNANDPSU_PROG_OFFSET,XNANDPSU_PROG_RD_MASK);
+				XNANDPSU_PROG_OFFSET, ReadOp);
 
 	Status = XNandPsu_Data_ReadWrite(InstancePtr, Buf, PktCount, PktSize, 0, 1);
 
@@ -1984,6 +2089,311 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function reads consecutive pages of a block with the ONFI read cache
+* commands, the array read of a page overlaps the data transfer of the
+* previous one.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the first page address value to read.
+* @param	NumPages is the number of pages to read, at least 2.
+* @param	Buf is the data buffer to fill in.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_ReadCachePages(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u32 NumPages, u8 *Buf)
+{
+	u32 Index;
+	u32 ReadOp;
+	s32 Status = XST_FAILURE;
+	u8 *BufPtr = Buf;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(NumPages > 1U);
+
+	for (Index = 0U; Index < NumPages; Index++) {
+		if (Index == 0U) {
+			ReadOp = XNANDPSU_PROG_RD_CACHE_START_MASK;
+		} else if (Index == (NumPages - 1U)) {
+			ReadOp = XNANDPSU_PROG_RD_CACHE_END_MASK;
+		} else {
+			ReadOp = XNANDPSU_PROG_RD_CACHE_SEQ_MASK;
+		}
+		Status = XNandPsu_ReadPage(InstancePtr, Target, Page + Index,
+						0U, BufPtr, ReadOp);
+		if (Status != XST_SUCCESS) {
+			/*
+			 * End the cache read, the data register still holds
+			 * the next page.
+			 */
+			if (ReadOp != XNANDPSU_PROG_RD_CACHE_END_MASK) {
+				(void)XNandPsu_ReadPage(InstancePtr, Target,
+					Page + Index + 1U, 0U,
+					&InstancePtr->PartialDataBuf[0],
+					XNANDPSU_PROG_RD_CACHE_END_MASK);
+			}
+			goto Out;
+		}
+		BufPtr += InstancePtr->Geometry.BytesPerPage;
+	}
+
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends the array read of one plane of a multi-plane read
+* (00h-32h) or of the last plane (00h-30h), without data transfer.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the page address value to read.
+* @param	Cmd2 is ONFI_CMD_MUL_RD2 or ONFI_CMD_RD2.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_ReadPlane(XNandPsu *InstancePtr, u32 Target, u32 Page,
+							u8 Cmd2)
+{
+	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
+				InstancePtr->Geometry.ColAddrCycles;
+	s32 Status = XST_FAILURE;
+
+	/*
+	 * Enable Transfer Complete Interrupt in Interrupt Status Enable
+	 * Register
+	 */
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+			XNANDPSU_INTR_STS_EN_OFFSET,
+			XNANDPSU_INTR_STS_EN_TRANS_COMP_STS_EN_MASK);
+	/* Program Command */
+	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_RD1, Cmd2, 0U, 0U,
+							(u8)AddrCycles);
+	/* Program Column, Page, Block address */
+	XNandPsu_SetPageColAddr(InstancePtr, Page, 0U);
+	/* Program Memory Address Register2 for chip select */
+	XNandPsu_SelectChip(InstancePtr, Target);
+	/* Set Read Interleaved in Program Register */
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+			XNANDPSU_PROG_OFFSET, XNANDPSU_PROG_RD_INTRLVD_MASK);
+	/* Poll for Transfer Complete event */
+	Status = XNandPsu_WaitFor_Transfer_Complete(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+	Status = XNandPsu_Device_Ready(InstancePtr, Target);
+
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks that a multi-plane operation can start at the page,
+* the block is aligned to the number of planes and no block of the planes is
+* bad.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Page is the page address value of the first plane.
+*
+* @return
+*		- XST_SUCCESS if the planes can be used.
+*		- XST_FAILURE otherwise.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_CheckPlanes(XNandPsu *InstancePtr, u32 Page)
+{
+	u32 Block = Page / InstancePtr->Geometry.PagesPerBlock;
+	u32 NumPlanes = InstancePtr->Geometry.NumPlanes;
+	u32 Plane;
+	s32 Status = XST_FAILURE;
+
+	if ((NumPlanes < 2U) || ((Block % NumPlanes) != 0U) ||
+		((Block + NumPlanes) > InstancePtr->Geometry.NumBlocks)) {
+		goto Out;
+	}
+	for (Plane = 0U; Plane < NumPlanes; Plane++) {
+		if (XNandPsu_IsBlockBad(InstancePtr, Block + Plane) ==
+							XST_SUCCESS) {
+			goto Out;
+		}
+	}
+	Status = XST_SUCCESS;
+
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function programs the same page of the blocks of all the planes with
+* one multi-plane program operation.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Page is the page address value in the block of the first
+*		plane. The block must be aligned to the number of planes.
+* @param	SrcBuf is the source data buffer, it holds one page for each
+*		plane.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed, the flash does not support multi-plane
+*		program or one of the blocks is bad.
+*
+* @note		The page is programmed with the page program command when the
+*		flash has a single plane.
+*
+******************************************************************************/
+s32 XNandPsu_WriteMultiPlane(XNandPsu *InstancePtr, u32 Page, u8 *SrcBuf)
+{
+	s32 Status = XST_FAILURE;
+	u32 Target;
+	u32 PageVar;
+	u32 Plane;
+	u32 NumPlanes;
+	u8 Cmd2;
+	u8 *BufPtr = SrcBuf;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Page < InstancePtr->Geometry.NumPages);
+	Xil_AssertNonvoid(SrcBuf != NULL);
+
+	Target = Page / InstancePtr->Geometry.NumTargetPages;
+	PageVar = Page % InstancePtr->Geometry.NumTargetPages;
+
+	if (InstancePtr->Geometry.NumPlanes < 2U) {
+		NumPlanes = 1U;
+	} else if (InstancePtr->Features.MultiPlaneProg == 0U) {
+		goto Out;
+	} else {
+		NumPlanes = InstancePtr->Geometry.NumPlanes;
+		Status = XNandPsu_CheckPlanes(InstancePtr, Page);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+	}
+
+	for (Plane = 0U; Plane < NumPlanes; Plane++) {
+		/* Page data of the last plane starts the array program */
+		Cmd2 = (Plane == (NumPlanes - 1U)) ? ONFI_CMD_PG_PROG2 :
+						ONFI_CMD_MUL_PG_PROG2;
+		Status = XNandPsu_ProgramPage(InstancePtr, Target,
+			PageVar + (Plane * InstancePtr->Geometry.PagesPerBlock),
+			0U, BufPtr, Cmd2);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		Status = XNandPsu_Device_Ready(InstancePtr, Target);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		BufPtr += InstancePtr->Geometry.BytesPerPage;
+	}
+
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads the same page of the blocks of all the planes with one
+* multi-plane read operation.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Page is the page address value in the block of the first
+*		plane. The block must be aligned to the number of planes.
+* @param	DestBuf is the destination data buffer, it is filled with one
+*		page for each plane.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed, the flash does not support multi-plane
+*		read or one of the blocks is bad.
+*
+* @note		The page is read with the read page command when the flash
+*		has a single plane.
+*
+******************************************************************************/
+s32 XNandPsu_ReadMultiPlane(XNandPsu *InstancePtr, u32 Page, u8 *DestBuf)
+{
+	s32 Status = XST_FAILURE;
+	u32 Target;
+	u32 PageVar;
+	u32 Plane;
+	u32 NumPlanes;
+	u8 *BufPtr = DestBuf;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Page < InstancePtr->Geometry.NumPages);
+	Xil_AssertNonvoid(DestBuf != NULL);
+
+	Target = Page / InstancePtr->Geometry.NumTargetPages;
+	PageVar = Page % InstancePtr->Geometry.NumTargetPages;
+
+	if (InstancePtr->Geometry.NumPlanes < 2U) {
+		Status = XNandPsu_ReadPage(InstancePtr, Target, PageVar, 0U,
+					DestBuf, XNANDPSU_PROG_RD_MASK);
+		goto Out;
+	}
+	if (InstancePtr->Features.MultiPlaneRead == 0U) {
+		goto Out;
+	}
+	NumPlanes = InstancePtr->Geometry.NumPlanes;
+	Status = XNandPsu_CheckPlanes(InstancePtr, Page);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+
+	/* Array read of all the planes, the last one starts it */
+	for (Plane = 0U; Plane < NumPlanes; Plane++) {
+		Status = XNandPsu_ReadPlane(InstancePtr, Target,
+			PageVar + (Plane * InstancePtr->Geometry.PagesPerBlock),
+			(Plane == (NumPlanes - 1U)) ? ONFI_CMD_RD2 :
+							ONFI_CMD_MUL_RD2);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+	}
+	/* Output the page of each plane */
+	for (Plane = 0U; Plane < NumPlanes; Plane++) {
+		Status = XNandPsu_ReadPage(InstancePtr, Target,
+			PageVar + (Plane * InstancePtr->Geometry.PagesPerBlock),
+			0U, BufPtr, XNANDPSU_PROG_CHNG_RD_COL_ENH_MASK);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		BufPtr += InstancePtr->Geometry.BytesPerPage;
+	}
+
+Out:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 *
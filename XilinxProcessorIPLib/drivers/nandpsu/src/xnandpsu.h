@@ -83,6 +83,17 @@
 * the control is returned back to user only after the read operation is
 * completed successfully or an error is reported.
 *
+* Runs of full pages within a block are read with the ONFI read cache
+* sequential commands when the flash supports them, so that the array read of
+* the next page overlaps the transfer of the current one. In MDMA mode the
+* page data is transferred directly to the user buffer.
+*
+* <b>Multi-plane Operations</b>
+*
+* XNandPsu_WriteMultiPlane() and XNandPsu_ReadMultiPlane() program and read the
+* same page of one block in every plane of a LUN with one array operation. The
+* blocks are consecutive and the first one is aligned to the number of planes.
+*
 * <b>Erase Operation</b>
 *
 * The erase operations are provided to erase a Block in the Flash memory. The
@@ -165,6 +176,9 @@
 * 1.5   mus    11/08/18    Updated BBT signature array size  in
 *                          XNandPsu_BbtDesc structure to fix the compilation
 *                          warnings.
+* 1.6   adk    10/15/19    Added read cache, multi-plane program/read and
+*                          warm boot reuse of the RAM bad block table through
+*                          XNandPsu_CfgInitializeBbtCache().
 *
 * </pre>
 *
@@ -210,6 +224,8 @@ extern "C" {
 
 #define XNANDPSU_INTR_POLL_TIMEOUT	0xF000000U
 
+#define XNANDPSU_BBT_CACHE_MAGIC	0x4E424243U	/**< "NBBC" */
+
 #define XNANDPSU_SDR_CLK		((u16)100U * (u16)1000U * (u16)1000U)
 #define XNANDPSU_NVDDR_CLK_0		((u16)20U * (u16)1000U * (u16)1000U)
 #define XNANDPSU_NVDDR_CLK_1		((u16)33U * (u16)1000U * (u16)1000U)
@@ -322,6 +338,7 @@ typedef struct {
 	u8 NumBitsPerCell;	/**< Number of bits per cell (Hamming/BCH) */
 	u8 NumBitsECC;		/**< Number of bits ECC correctability */
 	u32 EccCodeWordSize;	/**< ECC codeword size */
+	u8 NumPlanes;		/**< Number of planes per LUN */
 	/* Driver specific information */
 	u32 BlockSize;		/**< Block size */
 	u32 NumTargetPages;	/**< Total number of pages in a Target */
@@ -341,6 +358,9 @@ typedef struct {
 	u32 EzNand;
 	u32 OnDie;
 	u32 ExtPrmPage;
+	u32 ReadCache;		/**< Read cache commands supported */
+	u32 MultiPlaneProg;	/**< Multi-plane program supported */
+	u32 MultiPlaneRead;	/**< Multi-plane read supported */
 } XNandPsu_Features;
 
 /**
@@ -366,6 +386,23 @@ typedef struct {
 	u8 IsBCH;
 } XNandPsu_EccCfg;
 
+/**
+ * The XNandPsu_BbtCache structure holds a copy of the RAM based bad block
+ * table and of its descriptors. It is placed by the user in memory which is
+ * retained across warm boots, so that the bad block table search in flash is
+ * skipped when a valid copy of the same flash geometry is found.
+ */
+typedef struct {
+	u32 Magic;		/**< XNANDPSU_BBT_CACHE_MAGIC when valid */
+	u32 NumBlocks;		/**< Number of blocks of the flash */
+	u32 PagesPerBlock;	/**< Number of pages per block */
+	u32 BytesPerPage;	/**< Number of bytes per page */
+	XNandPsu_BbtDesc BbtDesc;	/**< Bad block table descriptor */
+	XNandPsu_BbtDesc BbtMirrorDesc;	/**< Mirror BBT descriptor */
+	u8 Bbt[XNANDPSU_MAX_BLOCKS >> 2];	/**< Bad block table array */
+	u32 Checksum;		/**< Sum of all the bytes above */
+} XNandPsu_BbtCache;
+
 /**
  * The XNandPsu structure contains the driver instance data. The user is
  * required to allocate a variable of this type for the NAND controller.
@@ -400,6 +437,7 @@ typedef struct {
 	XNandPsu_BadBlockPattern BbPattern;	/**< Bad block pattern to
 						  search */
 	u8 Bbt[XNANDPSU_MAX_BLOCKS >> 2];	/**< Bad block table array */
+	XNandPsu_BbtCache *BbtCache;	/**< Warm boot copy of the BBT */
 } XNandPsu;
 
 /******************* Macro Definitions (Inline Functions) *******************/
@@ -534,6 +572,10 @@ typedef struct {
 s32 XNandPsu_CfgInitialize(XNandPsu *InstancePtr, XNandPsu_Config *ConfigPtr,
 				u32 EffectiveAddr);
 
+s32 XNandPsu_CfgInitializeBbtCache(XNandPsu *InstancePtr,
+				XNandPsu_Config *ConfigPtr, u32 EffectiveAddr,
+				XNandPsu_BbtCache *BbtCachePtr);
+
 s32 XNandPsu_Erase(XNandPsu *InstancePtr, u64 Offset, u64 Length);
 
 s32 XNandPsu_Write(XNandPsu *InstancePtr, u64 Offset, u64 Length,
@@ -542,6 +584,10 @@ s32 XNandPsu_Write(XNandPsu *InstancePtr, u64 Offset, u64 Length,
 s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length,
 							u8 *DestBuf);
 
+s32 XNandPsu_WriteMultiPlane(XNandPsu *InstancePtr, u32 Page, u8 *SrcBuf);
+
+s32 XNandPsu_ReadMultiPlane(XNandPsu *InstancePtr, u32 Page, u8 *DestBuf);
+
 s32 XNandPsu_EraseBlock(XNandPsu *InstancePtr, u32 Target, u32 Block);
 
 s32 XNandPsu_WriteSpareBytes(XNandPsu *InstancePtr, u32 Page, u8 *Buf);
@@ -48,6 +48,9 @@
 * 1.1	nsk    11/07/16    Change memcpy to Xil_MemCpy to handle word aligned
 *	                   data access.
 * 1.4	nsk    04/10/18    Added ICCARM compiler support.
+* 1.6	adk    10/15/19    Take the BBT from the warm boot copy in
+*			   XNandPsu_ScanBbt when it is valid and keep the
+*			   copy up to date in XNandPsu_MarkBlockBad.
 * </pre>
 *
 ******************************************************************************/
@@ -83,6 +86,12 @@ static s32 XNandPsu_MarkBbt(XNandPsu* InstancePtr, XNandPsu_BbtDesc *Desc,
 
 static s32 XNandPsu_UpdateBbt(XNandPsu *InstancePtr, u32 Target);
 
+static u32 XNandPsu_BbtCacheChecksum(XNandPsu_BbtCache *CachePtr);
+
+static s32 XNandPsu_LoadBbtCache(XNandPsu *InstancePtr);
+
+static void XNandPsu_SaveBbtCache(XNandPsu *InstancePtr);
+
 /************************** Variable Definitions *****************************/
 
 /*****************************************************************************/
@@ -281,6 +290,12 @@ s32 XNandPsu_ScanBbt(XNandPsu *InstancePtr)
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
+	/* Reuse the Bad Block Table(BBT) kept across a warm boot */
+	if (XNandPsu_LoadBbtCache(InstancePtr) == XST_SUCCESS) {
+		Status = XST_SUCCESS;
+		goto Out;
+	}
+
 	/* Zero the RAM based Bad Block Table(BBT) entries */
 	BbtLen = InstancePtr->Geometry.NumBlocks >>
 					XNANDPSU_BBT_BLOCK_SHIFT;
@@ -324,11 +339,113 @@ s32 XNandPsu_ScanBbt(XNandPsu *InstancePtr)
 		}
 	}
 
+	XNandPsu_SaveBbtCache(InstancePtr);
+	Status = XST_SUCCESS;
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function computes the checksum of the warm boot copy of the Bad Block
+* Table(BBT), the sum of its bytes up to the checksum.
+*
+* @param	CachePtr is the pointer to the BBT copy.
+*
+* @return	Checksum of the copy.
+*
+******************************************************************************/
+static u32 XNandPsu_BbtCacheChecksum(XNandPsu_BbtCache *CachePtr)
+{
+	u8 *BufPtr = (u8 *)(void *)CachePtr;
+	u32 Len = (u32)((u8 *)(void *)&CachePtr->Checksum - BufPtr);
+	u32 Index;
+	u32 Sum = 0U;
+
+	for (Index = 0U; Index < Len; Index++) {
+		Sum += BufPtr[Index];
+	}
+
+	return Sum;
+}
+
+/*****************************************************************************/
+/**
+* This function loads the RAM based Bad Block Table(BBT) and its descriptors
+* from the warm boot copy, if the copy is valid for the flash geometry.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+*
+* @return
+*		- XST_SUCCESS if the BBT was loaded.
+*		- XST_FAILURE if there is no valid copy.
+*
+******************************************************************************/
+static s32 XNandPsu_LoadBbtCache(XNandPsu *InstancePtr)
+{
+	XNandPsu_BbtCache *CachePtr = InstancePtr->BbtCache;
+	s32 Status = XST_FAILURE;
+
+	if (CachePtr == NULL) {
+		goto Out;
+	}
+	if ((CachePtr->Magic != XNANDPSU_BBT_CACHE_MAGIC) ||
+		(CachePtr->NumBlocks != InstancePtr->Geometry.NumBlocks) ||
+		(CachePtr->PagesPerBlock !=
+				InstancePtr->Geometry.PagesPerBlock) ||
+		(CachePtr->BytesPerPage !=
+				InstancePtr->Geometry.BytesPerPage) ||
+		(CachePtr->Checksum != XNandPsu_BbtCacheChecksum(CachePtr))) {
+		goto Out;
+	}
+
+	(void)Xil_MemCpy(&InstancePtr->BbtDesc, &CachePtr->BbtDesc,
+						sizeof(XNandPsu_BbtDesc));
+	(void)Xil_MemCpy(&InstancePtr->BbtMirrorDesc, &CachePtr->BbtMirrorDesc,
+						sizeof(XNandPsu_BbtDesc));
+	(void)Xil_MemCpy(&InstancePtr->Bbt[0], &CachePtr->Bbt[0],
+						sizeof(InstancePtr->Bbt));
+#ifdef XNANDPSU_DEBUG
+	xil_printf("%s: Bad block table taken from warm boot copy\r\n",
+								__func__);
+#endif
 	Status = XST_SUCCESS;
 Out:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* This function saves the RAM based Bad Block Table(BBT) and its descriptors
+* in the warm boot copy, if one was given at initialization.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+*
+* @return
+*		- NONE
+*
+******************************************************************************/
+static void XNandPsu_SaveBbtCache(XNandPsu *InstancePtr)
+{
+	XNandPsu_BbtCache *CachePtr = InstancePtr->BbtCache;
+
+	if (CachePtr == NULL) {
+		return;
+	}
+
+	CachePtr->Magic = XNANDPSU_BBT_CACHE_MAGIC;
+	CachePtr->NumBlocks = InstancePtr->Geometry.NumBlocks;
+	CachePtr->PagesPerBlock = InstancePtr->Geometry.PagesPerBlock;
+	CachePtr->BytesPerPage = InstancePtr->Geometry.BytesPerPage;
+	(void)Xil_MemCpy(&CachePtr->BbtDesc, &InstancePtr->BbtDesc,
+						sizeof(XNandPsu_BbtDesc));
+	(void)Xil_MemCpy(&CachePtr->BbtMirrorDesc, &InstancePtr->BbtMirrorDesc,
+						sizeof(XNandPsu_BbtDesc));
+	(void)Xil_MemCpy(&CachePtr->Bbt[0], &InstancePtr->Bbt[0],
+						sizeof(InstancePtr->Bbt));
+	CachePtr->Checksum = XNandPsu_BbtCacheChecksum(CachePtr);
+}
+
 /*****************************************************************************/
 /**
 * This function converts the Bad Block Table(BBT) read from the flash to the
@@ -925,6 +1042,7 @@ s32 XNandPsu_MarkBlockBad(XNandPsu *InstancePtr, u32 Block)
 		if (Status != XST_SUCCESS) {
 			goto Out;
 		}
+		XNandPsu_SaveBbtCache(InstancePtr);
 	}
 
 	Status = XST_SUCCESS;
@@ -68,6 +68,11 @@
 * 0'b10 -> Block is bad due to wear
 * 0'b11 -> Good Block
 *
+* The RAM based BBT and its descriptors can also be kept in a user buffer in
+* memory retained across warm boots, see XNandPsu_CfgInitializeBbtCache. The
+* BBT is then taken from the buffer, without searching it in flash, as long as
+* the buffer checksum and the flash geometry match.
+*
 * The user can check for the validity of the block using the API
 * XNandPsu_IsBlockBad and take the action based on the return value. Also user
 * can update the bad block table using XNandPsu_MarkBlockBad API.
@@ -36,6 +36,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- ---------------------------------------------------
 * 1.0	bs	08/21/2018	First release
+* 1.1	adk	10/15/19	Made the bus number counter of the enumeration
+*			per instance.
 * </pre>
 *
 *******************************************************************************/
@@ -624,7 +626,6 @@ static void XPciePsu_IncreamentPMem(XPciePsu *InstancePtr)
 static void XPciePsu_FetchDevicesInBus(XPciePsu *InstancePtr, u32 BusNum)
 {
 	u32 ConfigData = 0;
-	static u32 LastBusNum;
 
 	u16 PCIeVendorID;
 	u16 PCIeDeviceID;
@@ -754,7 +755,7 @@ static void XPciePsu_FetchDevicesInBus(XPciePsu *InstancePtr, u32 BusNum)
 					Adr06 |= 0xFF; /* sub ordinate bus no 0xF
 						     */
 					Adr06 <<= TWO_HEX_NIBBLES;
-					Adr06 |= (++LastBusNum); /* secondary
+					Adr06 |= (++InstancePtr->LastBusNum); /* secondary
 							      bus no */
 					Adr06 <<= TWO_HEX_NIBBLES;
 					Adr06 |= BusNum; /* Primary bus no */
@@ -791,7 +792,7 @@ static void XPciePsu_FetchDevicesInBus(XPciePsu *InstancePtr, u32 BusNum)
 
 					/* Searches secondary bus devices. */
 					XPciePsu_FetchDevicesInBus(InstancePtr,
-							  LastBusNum);
+						InstancePtr->LastBusNum);
 
 					/*
 					 * update subordinate bus no
@@ -799,7 +800,7 @@ static void XPciePsu_FetchDevicesInBus(XPciePsu *InstancePtr, u32 BusNum)
 					 */
 					Adr06 &= (~(0xFF << FOUR_HEX_NIBBLES));
 					/* setting subordinate bus no */
-					Adr06 |= (LastBusNum
+					Adr06 |= (InstancePtr->LastBusNum
 						  << FOUR_HEX_NIBBLES);
 					XPciePsu_WriteConfigSpace(
 						InstancePtr, BusNum,
@@ -896,6 +897,7 @@ static void XPciePsu_FetchDevicesInBus(XPciePsu *InstancePtr, u32 BusNum)
 u8 XPciePsu_EnumerateBus(XPciePsu *InstancePtr)
 {
 	Xil_AssertNonvoid(InstancePtr != NULL);
+	InstancePtr->LastBusNum = 0;
 	XPciePsu_FetchDevicesInBus(InstancePtr, 0);
 	return XST_SUCCESS;
 }
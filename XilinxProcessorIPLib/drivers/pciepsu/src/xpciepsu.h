@@ -61,6 +61,7 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- ---------------------------------------------------
 * 1.0	bs	08/21/2018	First release
+* 1.1	adk	10/15/19	Added LastBusNum to the instance.
 * </pre>
 *
 *******************************************************************************/
@@ -106,6 +107,7 @@ typedef struct {
 	XPciePsu_Config Config; /**< Configuration data */
 	u32 IsReady;		/**< Is IP been initialized and ready */
 	u32 MaxSupportedBusNo;		/**< If this is RC IP, Max Number of  Buses */
+	u32 LastBusNum;		/**< Last bus number assigned by the enumeration */
 } XPciePsu;
 
 /***************************** Function Prototypes ****************************/
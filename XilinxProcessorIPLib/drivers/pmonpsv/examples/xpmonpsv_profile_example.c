@@ -0,0 +1,168 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xpmonpsv_profile_example.c
+* @addtogroup xpmonpsv_v1_0
+* @{
+*
+* This file contains an example of the profiling layer of the XpsvPmon
+* driver. All the LPD ports are measured over a number of one second
+* windows and the bandwidth and back pressure of each port is printed.
+*
+* @note	None.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 1.1   adk    10/15/19 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+#include "xil_printf.h"
+#include "xpmonpsv_profile.h"
+
+/************************** Constant Definitions ****************************/
+#define PMON_DEVICE_ID	XPAR_PSU_CORESIGHT_LPD_ATM_DEVICE_ID
+#define WINDOW_US	1000000U
+#define NUM_WINDOWS	4U
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Variable Definitions ****************************/
+static XpsvPmon PsvPmonInstance; /* The driver instance for Psvpmon Device */
+static XPmonpsv_Profile Profile;
+static XPmonpsv_ProfReport Reports[XPMONPSV_PROF_MAX_PORTS];
+
+/************************** Function Prototypes *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function profiles the LPD ports over NUM_WINDOWS windows.
+*
+* @param	DeviceId is the XPAR_<PMONPSV_instance>_DEVICE_ID value from
+*		xparameters.h.
+*
+* @return	XST_SUCCESS if successful, XST_FAILURE if unsuccessful.
+*
+* @note		None.
+*
+****************************************************************************/
+static u32 XpmonpsvProfileExample(u16 DeviceId)
+{
+	const XPmonpsv_PortInfo *Ports;
+	XPmonpsv_Config *ConfigPtr;
+	u32 NumPorts;
+	u32 Window;
+	u32 Index;
+	u32 Info;
+	s32 Status;
+
+	ConfigPtr = XpsvPmon_LookupConfig(DeviceId);
+	if (ConfigPtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	Status = XpsvPmon_CfgInitialize(&PsvPmonInstance, ConfigPtr,
+			ConfigPtr->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	(void)XpsvPmon_ProfileInit(&Profile, &PsvPmonInstance);
+	Status = XpsvPmon_ProfileAddAll(&Profile, XPMONPSV_PROF_BUSY);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	NumPorts = XpsvPmon_ProfileGetPorts(&Ports);
+
+	for (Window = 0U; Window < NUM_WINDOWS; Window++) {
+		Status = XpsvPmon_ProfileRun(&Profile, WINDOW_US, Reports);
+		if (Status != XST_SUCCESS) {
+			break;
+		}
+
+		xil_printf("\r\nWindow %d\r\n", Window);
+		for (Index = 0U; Index < Profile.NumPorts; Index++) {
+			for (Info = 0U; Info < NumPorts; Info++) {
+				if ((Ports[Info].Domain == Reports[Index].Domain) &&
+				    (Ports[Info].Port == Reports[Index].Port)) {
+					break;
+				}
+			}
+			xil_printf("%-18s wr %d B/s %d req %d busy,"
+				" rd %d B/s %d req %d busy\r\n",
+				(Info < NumPorts) ? Ports[Info].Name : "?",
+				(u32)Reports[Index].WrBandwidth,
+				Reports[Index].WrPackets,
+				Reports[Index].WrBusy,
+				(u32)Reports[Index].RdBandwidth,
+				Reports[Index].RdPackets,
+				Reports[Index].RdBusy);
+		}
+	}
+
+	XpsvPmon_Lock(&PsvPmonInstance);
+
+	return (Status == XST_SUCCESS) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the profile example.
+*
+* @param	None.
+*
+* @return	XST_SUCCESS if successful, XST_FAILURE if unsuccessful.
+*
+* @note		None.
+*
+******************************************************************************/
+int main(void)
+{
+	u32 Status;
+
+	Status = XpmonpsvProfileExample(PMON_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf("PMON Profile Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran PMON Profile Example\r\n");
+	return XST_SUCCESS;
+}
+/** @} */
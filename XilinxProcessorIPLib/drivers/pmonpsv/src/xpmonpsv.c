@@ -45,6 +45,9 @@
 * ----- -----  -------- -----------------------------------------------------
 * 1.0 sd   01/20/19  First release
 *     sd   03/05/19  Fix the counter check
+* 1.1 adk  10/15/19  Select the port of the given counter in
+*                    XpsvPmon_SetPort and grant counters 0 to 9 only in
+*                    XpsvPmon_RequestCounter.
 * </pre>
 *
 *****************************************************************************/
@@ -338,7 +341,7 @@ s32 XpsvPmon_RequestCounter(XpsvPmon *InstancePtr,u32 Domain, u32 *CounterNum)
 	if ( InstancePtr->RequestedCounters[Domain] == 0xFF )
 		InstancePtr->RequestedCounters[Domain] = 0U;
 
-	if (InstancePtr->RequestedCounters[Domain] > XPMONPSV_MAX_COUNTERS) {
+	if (InstancePtr->RequestedCounters[Domain] >= XPMONPSV_MAX_COUNTERS) {
 		return (s32)XST_FAILURE;
 	}
 
@@ -619,6 +622,7 @@ s32 XpsvPmon_SetPort(const XpsvPmon *InstancePtr, u32 PortSel, u32 Domain, u32 C
 	if (Domain == XPMONPSV_LPD_MAIN_DOMAIN) {
 		Offset = LPD_MAIN_OFFSET;
 	}
+	Offset = Offset +  (CounterNum* XPMONPSV_COUNTER_OFFSET);
 
 	XpsvPmon_WriteReg(InstancePtr, Offset + PMONPSV_WR_REQ_COUNTER0_PORTSEL, PortSel);
 	XpsvPmon_WriteReg(InstancePtr, Offset + PMONPSV_WR_RESP_COUNTER0_PORTSEL, PortSel);
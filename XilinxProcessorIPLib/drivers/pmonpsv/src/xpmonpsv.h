@@ -77,6 +77,8 @@
 * Ver   Who    Date     Changes
 * ----- -----  -------- -----------------------------------------------------
 * 1.0 sd   01/20/19 First release
+* 1.1 adk  10/15/19 Added the profiling layer in xpmonpsv_profile.c/.h,
+*                   which measures all the LPD ports over a common window.
 * </pre>
 *
 *****************************************************************************/
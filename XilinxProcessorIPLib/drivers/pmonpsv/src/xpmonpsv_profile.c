@@ -0,0 +1,405 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xpmonpsv_profile.c
+* @addtogroup pmonpsv_v1_0
+* @{
+*
+* This file contains the profiling layer of the XpsvPmon driver.
+* Refer to the xpmonpsv_profile.h header file for more information.
+*
+* @note 	None.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 1.1   adk    10/15/19 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xpmonpsv_profile.h"
+#include "sleep.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XPMONPSV_PROF_STATPERIOD	0x1FU	/* Longest statistics period */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static s32 XpsvPmon_ProfileSetCounter(XpsvPmon *InstancePtr, u32 Domain,
+		u32 Port, u32 Src, u8 *CounterPtr);
+
+/************************** Variable Definitions *****************************/
+
+static const XPmonpsv_PortInfo XpsvPmon_Ports[XPMONPSV_PROF_MAX_PORTS] = {
+	{ XPMONPSV_R5_DOMAIN, 0U, "lpd_afifs_axi" },
+	{ XPMONPSV_R5_DOMAIN, 1U, "lpd_ocm" },
+	{ XPMONPSV_R5_DOMAIN, 2U, "lpd_ocmext" },
+	{ XPMONPSV_R5_DOMAIN, 3U, "lpd_pmc_rpu_axi0" },
+	{ XPMONPSV_LPD_MAIN_DOMAIN, 0U, "lpd_fpd_axi" },
+	{ XPMONPSV_LPD_MAIN_DOMAIN, 1U, "prot_xppu" },
+};
+
+/*****************************************************************************/
+/**
+*
+* This function returns the table of the ports observed by the monitor.
+*
+* @param	PortsPtr is where a pointer to the table is returned.
+*
+* @return	Number of entries of the table.
+*
+******************************************************************************/
+u32 XpsvPmon_ProfileGetPorts(const XPmonpsv_PortInfo **PortsPtr)
+{
+	Xil_AssertNonvoid(PortsPtr != NULL);
+
+	*PortsPtr = XpsvPmon_Ports;
+
+	return XPMONPSV_PROF_MAX_PORTS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function initializes an empty profile. The profile takes all the
+* counters of the monitor, which must not be requested by other users.
+*
+* @param	ProfPtr is a pointer to the profile.
+* @param	InstancePtr is a pointer to the initialized XpsvPmon instance.
+*
+* @return	XST_SUCCESS
+*
+******************************************************************************/
+s32 XpsvPmon_ProfileInit(XPmonpsv_Profile *ProfPtr, XpsvPmon *InstancePtr)
+{
+	/* Assert the arguments */
+	Xil_AssertNonvoid(ProfPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	ProfPtr->InstancePtr = InstancePtr;
+	ProfPtr->NumPorts = 0U;
+
+	InstancePtr->RequestedCounters[XPMONPSV_R5_DOMAIN] = 0xFFU;
+	InstancePtr->RequestedCounters[XPMONPSV_LPD_MAIN_DOMAIN] = 0xFFU;
+
+	return XpsvPmon_Unlock(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds a port to a profile and programs its counters.
+*
+* @param	ProfPtr is a pointer to the profile.
+* @param	Domain is XPMONPSV_R5_DOMAIN or XPMONPSV_LPD_MAIN_DOMAIN.
+* @param	Port is the port select value, see XpsvPmon_ProfileGetPorts.
+* @param	Flags is 0 or XPMONPSV_PROF_BUSY.
+*
+* @return	XST_SUCCESS on success
+*		XST_FAILURE if the domain has no counter left
+*
+* @note		Each port takes two counters, three with XPMONPSV_PROF_BUSY,
+*		out of the XPMONPSV_MAX_COUNTERS of its domain.
+*
+******************************************************************************/
+s32 XpsvPmon_ProfileAddPort(XPmonpsv_Profile *ProfPtr, u32 Domain, u32 Port,
+		u32 Flags)
+{
+	XpsvPmon *InstancePtr;
+	XPmonpsv_ProfPort *PortPtr;
+	u32 Needed = 2U;
+	u32 Used;
+	s32 Status;
+
+	/* Assert the arguments */
+	Xil_AssertNonvoid(ProfPtr != NULL);
+	Xil_AssertNonvoid(Domain <= XPMONPSV_LPD_MAIN_DOMAIN);
+
+	InstancePtr = ProfPtr->InstancePtr;
+	if (ProfPtr->NumPorts >= XPMONPSV_PROF_MAX_PORTS) {
+		return (s32)XST_FAILURE;
+	}
+
+	/* Check the counters left so that a port is never half added */
+	if ((Flags & XPMONPSV_PROF_BUSY) != 0U) {
+		Needed++;
+	}
+	Used = InstancePtr->RequestedCounters[Domain];
+	if (Used == 0xFFU) {
+		Used = 0U;
+	}
+	if ((Used + Needed) > XPMONPSV_MAX_COUNTERS) {
+		return (s32)XST_FAILURE;
+	}
+
+	PortPtr = &ProfPtr->Ports[ProfPtr->NumPorts];
+	PortPtr->Domain = (u8)Domain;
+	PortPtr->Port = (u8)Port;
+	PortPtr->BusyCounter = XPMONPSV_PROF_NO_COUNTER;
+
+	Status = XpsvPmon_ProfileSetCounter(InstancePtr, Domain, Port,
+			XPMONPSV_SRC_BYTE, &PortPtr->ByteCounter);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+	Status = XpsvPmon_ProfileSetCounter(InstancePtr, Domain, Port,
+			XPMONPSV_SRC_PKT, &PortPtr->PktCounter);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+	if ((Flags & XPMONPSV_PROF_BUSY) != 0U) {
+		Status = XpsvPmon_ProfileSetCounter(InstancePtr, Domain, Port,
+				XPMONPSV_SRC_BUSY, &PortPtr->BusyCounter);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+	}
+
+	ProfPtr->NumPorts++;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds all the ports of the monitor to a profile. When a
+* domain does not have enough counters for the busy cycles of all its ports,
+* the last ports are added without them.
+*
+* @param	ProfPtr is a pointer to an empty profile.
+* @param	Flags is 0 or XPMONPSV_PROF_BUSY.
+*
+* @return	XST_SUCCESS on success
+*		XST_FAILURE if a port could not be added
+*
+******************************************************************************/
+s32 XpsvPmon_ProfileAddAll(XPmonpsv_Profile *ProfPtr, u32 Flags)
+{
+	const XPmonpsv_PortInfo *InfoPtr;
+	u32 Index;
+	u32 Left;
+	u32 Used;
+	u32 PortFlags;
+	s32 Status;
+
+	/* Assert the arguments */
+	Xil_AssertNonvoid(ProfPtr != NULL);
+
+	for (Index = 0U; Index < XPMONPSV_PROF_MAX_PORTS; Index++) {
+		InfoPtr = &XpsvPmon_Ports[Index];
+
+		/* Keep two counters for each of the next ports of the domain */
+		Left = 0U;
+		while (((Index + Left + 1U) < XPMONPSV_PROF_MAX_PORTS) &&
+			(XpsvPmon_Ports[Index + Left + 1U].Domain ==
+					InfoPtr->Domain)) {
+			Left++;
+		}
+		Used = ProfPtr->InstancePtr->RequestedCounters[InfoPtr->Domain];
+		if (Used == 0xFFU) {
+			Used = 0U;
+		}
+
+		PortFlags = Flags;
+		if ((Used + 3U + (2U * Left)) > XPMONPSV_MAX_COUNTERS) {
+			PortFlags &= ~XPMONPSV_PROF_BUSY;
+		}
+
+		Status = XpsvPmon_ProfileAddPort(ProfPtr, InfoPtr->Domain,
+				InfoPtr->Port, PortFlags);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function measures the ports of a profile over a window.
+*
+* @param	ProfPtr is a pointer to the profile.
+* @param	WindowUs is the window length in microseconds. The 32 bit
+*		counters must not wrap during the window.
+* @param	Reports is an array of ProfPtr->NumPorts reports, filled in the
+*		order the ports were added.
+*
+* @return	XST_SUCCESS on success
+*		XST_FAILURE if a counter could not be read
+*
+******************************************************************************/
+s32 XpsvPmon_ProfileRun(XPmonpsv_Profile *ProfPtr, u32 WindowUs,
+		XPmonpsv_ProfReport *Reports)
+{
+	XpsvPmon *InstancePtr;
+	XPmonpsv_ProfPort *PortPtr;
+	XPmonpsv_ProfReport *RepPtr;
+	u32 Unused;
+	u32 Index;
+	s32 Status;
+
+	/* Assert the arguments */
+	Xil_AssertNonvoid(ProfPtr != NULL);
+	Xil_AssertNonvoid(WindowUs != 0U);
+	Xil_AssertNonvoid(Reports != NULL);
+
+	InstancePtr = ProfPtr->InstancePtr;
+
+	/* Clear the counters first, then start them as close as possible */
+	for (Index = 0U; Index < ProfPtr->NumPorts; Index++) {
+		PortPtr = &ProfPtr->Ports[Index];
+		(void)XpsvPmon_ResetCounter(InstancePtr, PortPtr->Domain,
+				PortPtr->ByteCounter);
+		(void)XpsvPmon_ResetCounter(InstancePtr, PortPtr->Domain,
+				PortPtr->PktCounter);
+		if (PortPtr->BusyCounter != XPMONPSV_PROF_NO_COUNTER) {
+			(void)XpsvPmon_ResetCounter(InstancePtr,
+				PortPtr->Domain, PortPtr->BusyCounter);
+		}
+	}
+	for (Index = 0U; Index < ProfPtr->NumPorts; Index++) {
+		PortPtr = &ProfPtr->Ports[Index];
+		(void)XpsvPmon_EnableCounters(InstancePtr, PortPtr->Domain,
+				PortPtr->ByteCounter);
+		(void)XpsvPmon_EnableCounters(InstancePtr, PortPtr->Domain,
+				PortPtr->PktCounter);
+		if (PortPtr->BusyCounter != XPMONPSV_PROF_NO_COUNTER) {
+			(void)XpsvPmon_EnableCounters(InstancePtr,
+				PortPtr->Domain, PortPtr->BusyCounter);
+		}
+	}
+
+	usleep(WindowUs);
+
+	for (Index = 0U; Index < ProfPtr->NumPorts; Index++) {
+		PortPtr = &ProfPtr->Ports[Index];
+		(void)XpsvPmon_StopCounter(InstancePtr, PortPtr->Domain,
+				PortPtr->ByteCounter);
+		(void)XpsvPmon_StopCounter(InstancePtr, PortPtr->Domain,
+				PortPtr->PktCounter);
+		if (PortPtr->BusyCounter != XPMONPSV_PROF_NO_COUNTER) {
+			(void)XpsvPmon_StopCounter(InstancePtr,
+				PortPtr->Domain, PortPtr->BusyCounter);
+		}
+	}
+
+	for (Index = 0U; Index < ProfPtr->NumPorts; Index++) {
+		PortPtr = &ProfPtr->Ports[Index];
+		RepPtr = &Reports[Index];
+
+		RepPtr->Domain = PortPtr->Domain;
+		RepPtr->Port = PortPtr->Port;
+		RepPtr->WindowUs = WindowUs;
+		RepPtr->WrBusy = 0U;
+		RepPtr->RdBusy = 0U;
+		RepPtr->Reserved = 0U;
+
+		/* Write data travels with the request, read data with the response */
+		Status = XpsvPmon_GetWriteCounter(InstancePtr, &RepPtr->WrBytes,
+				&Unused, PortPtr->Domain, PortPtr->ByteCounter);
+		Status |= XpsvPmon_GetReadCounter(InstancePtr, &Unused,
+				&RepPtr->RdBytes, PortPtr->Domain,
+				PortPtr->ByteCounter);
+		Status |= XpsvPmon_GetWriteCounter(InstancePtr,
+				&RepPtr->WrPackets, &Unused, PortPtr->Domain,
+				PortPtr->PktCounter);
+		Status |= XpsvPmon_GetReadCounter(InstancePtr,
+				&RepPtr->RdPackets, &Unused, PortPtr->Domain,
+				PortPtr->PktCounter);
+		if (PortPtr->BusyCounter != XPMONPSV_PROF_NO_COUNTER) {
+			Status |= XpsvPmon_GetWriteCounter(InstancePtr,
+				&RepPtr->WrBusy, &Unused, PortPtr->Domain,
+				PortPtr->BusyCounter);
+			Status |= XpsvPmon_GetReadCounter(InstancePtr,
+				&RepPtr->RdBusy, &Unused, PortPtr->Domain,
+				PortPtr->BusyCounter);
+		}
+		if (Status != XST_SUCCESS) {
+			return (s32)XST_FAILURE;
+		}
+
+		RepPtr->WrBandwidth = ((u64)RepPtr->WrBytes * 1000000U) /
+				WindowUs;
+		RepPtr->RdBandwidth = ((u64)RepPtr->RdBytes * 1000000U) /
+				WindowUs;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function requests a counter and connects it to a port and a source.
+*
+* @param	InstancePtr is a pointer to the XpsvPmon instance.
+* @param	Domain is the domain of the port.
+* @param	Port is the port select value.
+* @param	Src is the counter source.
+* @param	CounterPtr is where the counter number is returned.
+*
+* @return	XST_SUCCESS on success
+*		XST_FAILURE if the domain has no counter left
+*
+******************************************************************************/
+static s32 XpsvPmon_ProfileSetCounter(XpsvPmon *InstancePtr, u32 Domain,
+		u32 Port, u32 Src, u8 *CounterPtr)
+{
+	u32 CounterNum;
+	s32 Status;
+
+	Status = XpsvPmon_RequestCounter(InstancePtr, Domain, &CounterNum);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	(void)XpsvPmon_ResetCounter(InstancePtr, Domain, CounterNum);
+	(void)XpsvPmon_SetSrc(InstancePtr, Src, Domain, CounterNum);
+	(void)XpsvPmon_SetPort(InstancePtr, Port, Domain, CounterNum);
+	(void)XpsvPmon_SetMetrics(InstancePtr, XPMONPSV_PROF_STATPERIOD,
+			Domain, CounterNum);
+	*CounterPtr = (u8)CounterNum;
+
+	return XST_SUCCESS;
+}
+/** @} */
@@ -0,0 +1,147 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xpmonpsv_profile.h
+* @addtogroup pmonpsv_v1_0
+* @{
+*
+* The profiling layer of the XpsvPmon driver measures the traffic of the
+* ports observed by the LPD performance monitor.
+*
+* Each port added to a profile gets one counter counting payload bytes and
+* one counting packets, and optionally one counting the busy cycles, during
+* which the port had data to send but the receiver was not ready. The busy
+* cycles per packet show the back pressure, and so the QoS, seen by the
+* masters behind the port.
+*
+* XpsvPmon_ProfileRun() clears and enables all the counters of the profile
+* back to back, waits for the window, stops them and returns one report per
+* port, so that all the ports are measured over the same window.
+*
+* The layer only uses the driver and usleep(), so it runs on the APU, the
+* RPU or the PLM.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 1.1   adk    10/15/19 First release
+* </pre>
+*
+*****************************************************************************/
+#ifndef XPMONPSV_PROFILE_H /* Prevent circular inclusions */
+#define XPMONPSV_PROFILE_H /* by using protection macros  */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files ********************************/
+
+#include "xpmonpsv.h"
+
+/************************** Constant Definitions ****************************/
+
+/* Counter sources, see XpsvPmon_SetSrc */
+#define XPMONPSV_SRC_BUSY		4U
+#define XPMONPSV_SRC_PKT		6U
+#define XPMONPSV_SRC_BYTE		8U
+
+/* Profile flags */
+#define XPMONPSV_PROF_BUSY		0x1U	/**< Count busy cycles */
+
+#define XPMONPSV_PROF_MAX_PORTS		6U	/**< Ports of both domains */
+#define XPMONPSV_PROF_NO_COUNTER	0xFFU
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * A port observed by the monitor.
+ */
+typedef struct {
+	u8 Domain;		/**< XPMONPSV_R5_DOMAIN or LPD_MAIN_DOMAIN */
+	u8 Port;		/**< Port select value */
+	const char *Name;	/**< Port name */
+} XPmonpsv_PortInfo;
+
+/**
+ * Counters of a port of a profile.
+ */
+typedef struct {
+	u8 Domain;		/**< Domain of the port */
+	u8 Port;		/**< Port select value */
+	u8 ByteCounter;		/**< Payload byte counter */
+	u8 PktCounter;		/**< Packet counter */
+	u8 BusyCounter;		/**< Busy cycle counter or NO_COUNTER */
+} XPmonpsv_ProfPort;
+
+/**
+ * Profile instance.
+ */
+typedef struct {
+	XpsvPmon *InstancePtr;	/**< Monitor instance */
+	u32 NumPorts;		/**< Ports in the profile */
+	XPmonpsv_ProfPort Ports[XPMONPSV_PROF_MAX_PORTS];	/**< Ports */
+} XPmonpsv_Profile;
+
+/**
+ * Traffic of a port over a window.
+ */
+typedef struct {
+	u32 Domain;		/**< Domain of the port */
+	u32 Port;		/**< Port select value */
+	u32 WindowUs;		/**< Window length in microseconds */
+	u32 WrBytes;		/**< Write payload bytes */
+	u32 RdBytes;		/**< Read payload bytes */
+	u32 WrPackets;		/**< Write requests */
+	u32 RdPackets;		/**< Read requests */
+	u32 WrBusy;		/**< Busy cycles of the write requests */
+	u32 RdBusy;		/**< Busy cycles of the read requests */
+	u32 Reserved;
+	u64 WrBandwidth;	/**< Write bytes per second */
+	u64 RdBandwidth;	/**< Read bytes per second */
+} XPmonpsv_ProfReport;
+
+/************************** Function Prototypes *****************************/
+
+u32 XpsvPmon_ProfileGetPorts(const XPmonpsv_PortInfo **PortsPtr);
+s32 XpsvPmon_ProfileInit(XPmonpsv_Profile *ProfPtr, XpsvPmon *InstancePtr);
+s32 XpsvPmon_ProfileAddPort(XPmonpsv_Profile *ProfPtr, u32 Domain, u32 Port,
+		u32 Flags);
+s32 XpsvPmon_ProfileAddAll(XPmonpsv_Profile *ProfPtr, u32 Flags);
+s32 XpsvPmon_ProfileRun(XPmonpsv_Profile *ProfPtr, u32 WindowUs,
+		XPmonpsv_ProfReport *Reports);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* End of protection macro. */
+/** @} */
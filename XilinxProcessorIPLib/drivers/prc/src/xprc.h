@@ -102,6 +102,18 @@
 *
 * <b> Debug prints </b>
 *
+* <b> Reconfiguration scheduler </b>
+*
+* The scheduler in xprc_sched.c queues (VSM, RM) reconfiguration requests
+* and sends them to the VSMs with software triggers, one request at a time
+* per VSM. XPrc_SchedHandler() checks the VSMs that are reconfiguring,
+* calls the completion callback, keeps the reconfiguration latency of each
+* RM and sends the next queued request of the VSM. It is called from the
+* handler of an interrupt driven by the VSM event/error outputs of the PRC,
+* or periodically.
+*
+* <b> Debug prints </b>
+*
 * XPrc driver is having debug prints.
 *	- To get the debug print statements of the driver, please define
 *	  XPRC_DEBUG as shown below.
@@ -132,6 +144,8 @@
 *                           flags. Added the Updated api.tcl to data folder.
 * 1.2  Nava   29/03/19      Updated the tcl logic to generated the
 *                           XPrc_ConfigTable properly.
+* 1.2  Nava   14/10/19      Added the reconfiguration scheduler in
+*                           xprc_sched.c.
 * </pre>
 *
 ******************************************************************************/
@@ -246,6 +260,18 @@ extern "C" {
 #define CP_FIFO_TYPE_BLOCKRAM		(1)	/**< Fifo Value for Blockram */
 /*@}*/
 
+/**
+ * @name Reconfiguration scheduler sizes
+ * @{
+ */
+#ifndef XPRC_SCHED_QUEUE_DEPTH
+#define XPRC_SCHED_QUEUE_DEPTH		(16)	/**< Queued requests */
+#endif
+#ifndef XPRC_SCHED_MAX_RM_STATS
+#define XPRC_SCHED_MAX_RM_STATS		(32)	/**< RMs with statistics */
+#endif
+/*@}*/
+
 /**************************** Type Definitions *******************************/
 
 /* This typedef contains configuration information for a device */
@@ -319,6 +345,72 @@ typedef struct {
 	XPrc_Config Config;	/**< Pointer to instance config entry */
 } XPrc;
 
+/**
+ * Completion callback of the reconfiguration scheduler. ErrorCode is
+ * XPRC_SR_NO_ERROR when the RM is loaded, or the XPRC_SR_*_ERROR code of
+ * the VSM status register.
+ */
+typedef void (*XPrc_SchedCallback)(void *CallBackRef, u16 VsmId, u16 RmId,
+				u32 ErrorCode);
+
+/**
+ * Time source of the scheduler statistics, in any monotonic unit. XTime
+ * or a timer counter can be used.
+ */
+typedef u64 (*XPrc_SchedGetTime)(void);
+
+/**
+ * A queued reconfiguration request. The trigger and the bitstream
+ * descriptor of the RM are read from the PRC when the request is submitted.
+ */
+typedef struct {
+	u16 VsmId;		/**< Virtual Socket Manager */
+	u16 RmId;		/**< Reconfigurable Module to load */
+	u16 TriggerId;		/**< Trigger mapped to the RM */
+	u32 BsSize;		/**< Size of the RM bitstream in bytes */
+	u64 SubmitTime;		/**< Time the request was submitted */
+} XPrc_SchedRequest;
+
+/**
+ * Reconfiguration statistics of one RM. Times are in the unit of the
+ * scheduler time source and are measured from the trigger to the
+ * completion.
+ */
+typedef struct {
+	u16 VsmId;		/**< Virtual Socket Manager */
+	u16 RmId;		/**< Reconfigurable Module */
+	u32 NumLoads;		/**< Successful reconfigurations */
+	u32 NumAlreadyLoaded;	/**< Requests for the RM already loaded */
+	u32 NumErrors;		/**< Failed reconfigurations */
+	u64 TotalTime;		/**< Sum of the reconfiguration times */
+	u64 MinTime;		/**< Shortest reconfiguration time */
+	u64 MaxTime;		/**< Longest reconfiguration time */
+	u64 TotalWaitTime;	/**< Sum of the times spent in the queue */
+	u64 TotalBytes;		/**< Bitstream bytes loaded */
+} XPrc_SchedRmStats;
+
+/**
+ * The reconfiguration scheduler. The user allocates a variable of this
+ * type for each PRC instance that is scheduled.
+ */
+typedef struct {
+	XPrc *PrcPtr;		/**< PRC instance */
+	XPrc_SchedRequest Queue[XPRC_SCHED_QUEUE_DEPTH];
+				/**< Queued requests, oldest first */
+	u32 NumQueued;		/**< Number of requests in Queue */
+	XPrc_SchedRequest Active[XPRC_MAX_NUMBER_OF_VSMS];
+				/**< Request being loaded by each VSM */
+	u32 ActiveMask;		/**< VSMs with a request being loaded */
+	u64 StartTime[XPRC_MAX_NUMBER_OF_VSMS];
+				/**< Trigger time of the active requests */
+	XPrc_SchedRmStats Stats[XPRC_SCHED_MAX_RM_STATS];
+				/**< Statistics of each RM */
+	u32 NumStats;		/**< Number of entries used in Stats */
+	XPrc_SchedCallback Callback;	/**< Completion callback */
+	void *CallBackRef;	/**< Callback reference */
+	XPrc_SchedGetTime GetTime;	/**< Time source, can be NULL */
+} XPrc_Sched;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -806,6 +898,18 @@ void XPrc_PrintVsmStatus(XPrc *InstancePtr, u32 VsmIdOrStatus, char * Prefix);
 /* Functions in xprc_selftest.c */
 s32 XPrc_SelfTest(XPrc *InstancePtr);
 
+/* Functions in xprc_sched.c */
+s32 XPrc_SchedInitialize(XPrc_Sched *SchedPtr, XPrc *InstancePtr,
+				XPrc_SchedGetTime GetTimeFunc);
+void XPrc_SchedSetCallback(XPrc_Sched *SchedPtr, XPrc_SchedCallback FuncPtr,
+				void *CallBackRef);
+s32 XPrc_SchedSubmit(XPrc_Sched *SchedPtr, u16 VsmId, u16 RmId);
+void XPrc_SchedHandler(void *SchedPtr);
+u32 XPrc_SchedGetNumPending(XPrc_Sched *SchedPtr);
+s32 XPrc_SchedGetRmStats(XPrc_Sched *SchedPtr, u16 VsmId, u16 RmId,
+				XPrc_SchedRmStats *StatsPtr);
+void XPrc_SchedResetStats(XPrc_Sched *SchedPtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,546 @@
+/******************************************************************************
+*
+* Copyright (C) 2016-2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xprc_sched.c
+* @addtogroup prc_v1_2
+* @{
+*
+* This file contains the reconfiguration scheduler of the XPrc driver.
+*
+* Requests to load a Reconfigurable Module (RM) in a Virtual Socket Manager
+* (VSM) are queued with XPrc_SchedSubmit(). The trigger mapped to the RM and
+* the size of its bitstream are read from the PRC when the request is
+* submitted, so that sending the request is a single register write. Each VSM
+* loads one request at a time, the requests of a VSM are sent in the order of
+* submission.
+*
+* XPrc_SchedHandler() reads the status of the VSMs that are loading an RM.
+* When a load is complete or has failed, it calls the completion callback,
+* updates the statistics of the RM and sends the next request of the VSM. The
+* PRC has no interrupt registers, so the handler is connected to an interrupt
+* driven by the vsm_<name>_event_error outputs of the PRC, or called
+* periodically from a timer interrupt or the main loop.
+*
+* The handler must not run while XPrc_SchedSubmit() or the other scheduler
+* functions are called. If it is called from an interrupt handler, disable
+* that interrupt around the calls to the scheduler.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date         Changes
+* ---- ----- -----------  ------------------------------------------------
+* 1.2   Nava 14/10/19      First release.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xprc.h"
+#include "xstatus.h"
+#include <string.h>
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Variable Definitions *****************************/
+
+/************************** Function Prototypes ******************************/
+static void XPrc_SchedDispatch(XPrc_Sched *SchedPtr, u16 VsmId);
+static void XPrc_SchedComplete(XPrc_Sched *SchedPtr, u16 VsmId,
+				u32 ErrorCode);
+static XPrc_SchedRmStats *XPrc_SchedFindStats(XPrc_Sched *SchedPtr,
+				u16 VsmId, u16 RmId, u8 Allocate);
+static void XPrc_SchedStubCallback(void *CallBackRef, u16 VsmId, u16 RmId,
+				u32 ErrorCode);
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a reconfiguration scheduler for a PRC instance.
+* The queue and the statistics are emptied.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+* @param	InstancePtr is a pointer to the PRC instance, already
+*		initialized with XPrc_CfgInitialize().
+* @param	GetTimeFunc is the time source of the statistics. It can be
+*		NULL, only the number of loads and errors are kept then.
+*
+* @return
+*		- XST_SUCCESS if the initialization is successful.
+*
+* @note		None.
+*
+******************************************************************************/
+s32 XPrc_SchedInitialize(XPrc_Sched *SchedPtr, XPrc *InstancePtr,
+				XPrc_SchedGetTime GetTimeFunc)
+{
+	/* Verify arguments */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	(void)memset((void *)SchedPtr, 0, sizeof(XPrc_Sched));
+	SchedPtr->PrcPtr = InstancePtr;
+	SchedPtr->GetTime = GetTimeFunc;
+	SchedPtr->Callback = XPrc_SchedStubCallback;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the completion callback of the scheduler.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+* @param	FuncPtr is the callback function.
+* @param	CallBackRef is the reference passed to the callback.
+*
+* @return	None.
+*
+* @note		The callback is called from XPrc_SchedHandler(), and from
+*		XPrc_SchedSubmit() when the RM is already loaded. It can
+*		submit new requests.
+*
+******************************************************************************/
+void XPrc_SchedSetCallback(XPrc_Sched *SchedPtr, XPrc_SchedCallback FuncPtr,
+				void *CallBackRef)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(SchedPtr != NULL);
+	Xil_AssertVoid(FuncPtr != NULL);
+
+	SchedPtr->Callback = FuncPtr;
+	SchedPtr->CallBackRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function queues a request to load an RM in a VSM. If the VSM is not
+* loading another RM, the request is sent to the PRC at once.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+* @param	VsmId is the identifier of the VSM.
+* @param	RmId is the identifier of the RM to load.
+*
+* @return
+*		- XST_SUCCESS if the request is queued or sent.
+*		- XST_INVALID_PARAM if no trigger of the VSM is mapped to the
+*		  RM.
+*		- XST_FAILURE if the queue is full.
+*
+* @note		The PRC ignores a trigger for the RM that is already loaded,
+*		such a request completes without error and is counted in
+*		NumAlreadyLoaded.
+*
+******************************************************************************/
+s32 XPrc_SchedSubmit(XPrc_Sched *SchedPtr, u16 VsmId, u16 RmId)
+{
+	XPrc *InstancePtr;
+	XPrc_SchedRequest *ReqPtr;
+	u32 NumTriggers;
+	u16 TriggerId;
+	s32 Status = XST_INVALID_PARAM;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+	Xil_AssertNonvoid(SchedPtr->PrcPtr != NULL);
+	InstancePtr = SchedPtr->PrcPtr;
+	Xil_AssertNonvoid(VsmId < XPrc_GetNumberOfVsms(InstancePtr));
+	Xil_AssertNonvoid(RmId < XPrc_GetNumRmsAllocated(InstancePtr, VsmId));
+
+	if (SchedPtr->NumQueued == (u32)XPRC_SCHED_QUEUE_DEPTH) {
+		Status = XST_FAILURE;
+		goto END;
+	}
+
+	/* Find the trigger that loads the RM */
+	NumTriggers = XPrc_GetNumTriggersAllocated(InstancePtr, VsmId);
+	for (TriggerId = 0U; TriggerId < NumTriggers; TriggerId++) {
+		if (XPrc_GetTriggerToRmMapping(InstancePtr, VsmId,
+				TriggerId) == (u32)RmId) {
+			break;
+		}
+	}
+	if (TriggerId == NumTriggers) {
+		goto END;
+	}
+
+	ReqPtr = &SchedPtr->Queue[SchedPtr->NumQueued];
+	ReqPtr->VsmId = VsmId;
+	ReqPtr->RmId = RmId;
+	ReqPtr->TriggerId = TriggerId;
+	ReqPtr->BsSize = XPrc_GetBsSize(InstancePtr, VsmId,
+			(u16)XPrc_GetRmBsIndex(InstancePtr, VsmId, RmId));
+	ReqPtr->SubmitTime = 0U;
+	if (SchedPtr->GetTime != NULL) {
+		ReqPtr->SubmitTime = SchedPtr->GetTime();
+	}
+	SchedPtr->NumQueued++;
+
+	if ((SchedPtr->ActiveMask & ((u32)1U << VsmId)) == 0U) {
+		XPrc_SchedDispatch(SchedPtr, VsmId);
+	}
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks the VSMs that are loading an RM. For each completed or
+* failed load, the completion callback is called, the statistics of the RM are
+* updated and the next request of the VSM is sent to the PRC.
+*
+* @param	SchedPtr is a pointer to the scheduler, passed as void * so
+*		that the function can be connected to an interrupt controller.
+*
+* @return	None.
+*
+* @note		A load is complete when the trigger has been taken by the VSM
+*		and the VSM is in the Active (full) state with the requested
+*		RM. It has failed when the VSM reports an error.
+*
+******************************************************************************/
+void XPrc_SchedHandler(void *SchedPtr)
+{
+	XPrc_Sched *Sched = (XPrc_Sched *)SchedPtr;
+	XPrc *InstancePtr;
+	u32 VsmStatus;
+	u32 ErrorCode;
+	u16 Trigger;
+	u16 VsmId;
+
+	/* Verify arguments */
+	Xil_AssertVoid(Sched != NULL);
+	Xil_AssertVoid(Sched->PrcPtr != NULL);
+	InstancePtr = Sched->PrcPtr;
+
+	for (VsmId = 0U; (Sched->ActiveMask != 0U) &&
+			(VsmId < XPrc_GetNumberOfVsms(InstancePtr)); VsmId++) {
+		if ((Sched->ActiveMask & ((u32)1U << VsmId)) == 0U) {
+			continue;
+		}
+		if (XPrc_IsSwTriggerPending(InstancePtr, VsmId, &Trigger) ==
+				XPRC_SW_TRIGGER_PENDING) {
+			continue;
+		}
+
+		VsmStatus = XPrc_ReadStatusReg(InstancePtr, VsmId);
+		ErrorCode = XPrc_GetVsmErrorStatus(NULL, VsmStatus);
+		if (ErrorCode == (u32)XPRC_SR_NO_ERROR) {
+			if ((XPrc_GetVsmState(NULL, VsmStatus) !=
+					(u32)XPRC_SR_STATE_FULL) ||
+			    (XPrc_GetRmIdFromStatus(NULL, VsmStatus) !=
+					(u32)Sched->Active[VsmId].RmId)) {
+				/* Still loading */
+				continue;
+			}
+		}
+
+		XPrc_SchedComplete(Sched, VsmId, ErrorCode);
+		XPrc_SchedDispatch(Sched, VsmId);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the number of requests that are queued or being
+* loaded.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+*
+* @return	Number of requests not completed yet.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XPrc_SchedGetNumPending(XPrc_Sched *SchedPtr)
+{
+	u32 ActiveMask;
+	u32 NumPending;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+
+	NumPending = SchedPtr->NumQueued;
+	for (ActiveMask = SchedPtr->ActiveMask; ActiveMask != 0U;
+			ActiveMask &= ActiveMask - 1U) {
+		NumPending++;
+	}
+
+	return NumPending;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function copies the reconfiguration statistics of an RM.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+* @param	VsmId is the identifier of the VSM.
+* @param	RmId is the identifier of the RM.
+* @param	StatsPtr is a pointer to the statistics to fill.
+*
+* @return
+*		- XST_SUCCESS if the statistics are copied.
+*		- XST_FAILURE if no request for the RM has completed.
+*
+* @note		Statistics are kept for the first XPRC_SCHED_MAX_RM_STATS
+*		(VSM, RM) pairs that complete a request.
+*
+******************************************************************************/
+s32 XPrc_SchedGetRmStats(XPrc_Sched *SchedPtr, u16 VsmId, u16 RmId,
+				XPrc_SchedRmStats *StatsPtr)
+{
+	XPrc_SchedRmStats *RmStatsPtr;
+	s32 Status = XST_FAILURE;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+	Xil_AssertNonvoid(StatsPtr != NULL);
+
+	RmStatsPtr = XPrc_SchedFindStats(SchedPtr, VsmId, RmId, FALSE);
+	if (RmStatsPtr != NULL) {
+		*StatsPtr = *RmStatsPtr;
+		Status = XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function clears the reconfiguration statistics of all the RMs.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XPrc_SchedResetStats(XPrc_Sched *SchedPtr)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(SchedPtr != NULL);
+
+	(void)memset((void *)SchedPtr->Stats, 0, sizeof(SchedPtr->Stats));
+	SchedPtr->NumStats = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends the oldest queued request of a VSM to the PRC. Requests
+* for the RM that is already loaded complete at once.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+* @param	VsmId is the identifier of the VSM, which is not loading any
+*		RM.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XPrc_SchedDispatch(XPrc_Sched *SchedPtr, u16 VsmId)
+{
+	XPrc *InstancePtr = SchedPtr->PrcPtr;
+	XPrc_SchedRequest *ReqPtr;
+	u32 VsmStatus;
+	u32 Index;
+
+	SchedPtr->ActiveMask &= ~((u32)1U << VsmId);
+
+	Index = 0U;
+	while (Index < SchedPtr->NumQueued) {
+		if (SchedPtr->Queue[Index].VsmId != VsmId) {
+			Index++;
+			continue;
+		}
+
+		ReqPtr = &SchedPtr->Active[VsmId];
+		*ReqPtr = SchedPtr->Queue[Index];
+		SchedPtr->NumQueued--;
+		for (; Index < SchedPtr->NumQueued; Index++) {
+			SchedPtr->Queue[Index] = SchedPtr->Queue[Index + 1U];
+		}
+		SchedPtr->ActiveMask |= (u32)1U << VsmId;
+		SchedPtr->StartTime[VsmId] = ReqPtr->SubmitTime;
+		if (SchedPtr->GetTime != NULL) {
+			SchedPtr->StartTime[VsmId] = SchedPtr->GetTime();
+		}
+
+		VsmStatus = XPrc_ReadStatusReg(InstancePtr, VsmId);
+		if ((XPrc_GetVsmState(NULL, VsmStatus) !=
+				(u32)XPRC_SR_STATE_FULL) ||
+		    (XPrc_GetRmIdFromStatus(NULL, VsmStatus) !=
+				(u32)ReqPtr->RmId)) {
+			XPrc_SendSwTrigger(InstancePtr, VsmId,
+					ReqPtr->TriggerId);
+			break;
+		}
+
+		/* The RM is loaded already, the PRC would ignore the trigger */
+		ReqPtr->BsSize = 0U;
+		XPrc_SchedComplete(SchedPtr, VsmId, (u32)XPRC_SR_NO_ERROR);
+		SchedPtr->ActiveMask &= ~((u32)1U << VsmId);
+		Index = 0U;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function completes the request being loaded by a VSM. The statistics
+* of the RM are updated before the callback is called.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+* @param	VsmId is the identifier of the VSM.
+* @param	ErrorCode is XPRC_SR_NO_ERROR or the error reported by the
+*		VSM.
+*
+* @return	None.
+*
+* @note		A request with a BsSize of 0 is for the RM already loaded.
+*
+******************************************************************************/
+static void XPrc_SchedComplete(XPrc_Sched *SchedPtr, u16 VsmId,
+				u32 ErrorCode)
+{
+	XPrc_SchedRequest Req = SchedPtr->Active[VsmId];
+	XPrc_SchedRmStats *RmStatsPtr;
+	u64 Time;
+
+	RmStatsPtr = XPrc_SchedFindStats(SchedPtr, VsmId, Req.RmId, TRUE);
+	if (RmStatsPtr != NULL) {
+		if (ErrorCode != (u32)XPRC_SR_NO_ERROR) {
+			RmStatsPtr->NumErrors++;
+		} else if (Req.BsSize == 0U) {
+			RmStatsPtr->NumAlreadyLoaded++;
+		} else {
+			RmStatsPtr->NumLoads++;
+			RmStatsPtr->TotalBytes += Req.BsSize;
+			if (SchedPtr->GetTime != NULL) {
+				Time = SchedPtr->GetTime();
+				RmStatsPtr->TotalWaitTime +=
+					SchedPtr->StartTime[VsmId] -
+					Req.SubmitTime;
+				Time -= SchedPtr->StartTime[VsmId];
+				RmStatsPtr->TotalTime += Time;
+				if ((RmStatsPtr->NumLoads == 1U) ||
+				    (Time < RmStatsPtr->MinTime)) {
+					RmStatsPtr->MinTime = Time;
+				}
+				if (Time > RmStatsPtr->MaxTime) {
+					RmStatsPtr->MaxTime = Time;
+				}
+			}
+		}
+	}
+
+	SchedPtr->Callback(SchedPtr->CallBackRef, VsmId, Req.RmId, ErrorCode);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function looks up the statistics of an RM.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+* @param	VsmId is the identifier of the VSM.
+* @param	RmId is the identifier of the RM.
+* @param	Allocate is TRUE to add an entry for the RM if it has none.
+*
+* @return	Pointer to the statistics, or NULL if the RM has none and no
+*		entry can be added.
+*
+* @note		None.
+*
+******************************************************************************/
+static XPrc_SchedRmStats *XPrc_SchedFindStats(XPrc_Sched *SchedPtr,
+				u16 VsmId, u16 RmId, u8 Allocate)
+{
+	XPrc_SchedRmStats *RmStatsPtr = NULL;
+	u32 Index;
+
+	for (Index = 0U; Index < SchedPtr->NumStats; Index++) {
+		if ((SchedPtr->Stats[Index].VsmId == VsmId) &&
+		    (SchedPtr->Stats[Index].RmId == RmId)) {
+			RmStatsPtr = &SchedPtr->Stats[Index];
+			break;
+		}
+	}
+
+	if ((RmStatsPtr == NULL) && (Allocate == (u8)TRUE) &&
+	    (SchedPtr->NumStats < (u32)XPRC_SCHED_MAX_RM_STATS)) {
+		RmStatsPtr = &SchedPtr->Stats[SchedPtr->NumStats];
+		RmStatsPtr->VsmId = VsmId;
+		RmStatsPtr->RmId = RmId;
+		SchedPtr->NumStats++;
+	}
+
+	return RmStatsPtr;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the default completion callback, it does nothing.
+*
+* @param	CallBackRef is the callback reference, unused.
+* @param	VsmId is the identifier of the VSM, unused.
+* @param	RmId is the identifier of the RM, unused.
+* @param	ErrorCode is the completion status, unused.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XPrc_SchedStubCallback(void *CallBackRef, u16 VsmId, u16 RmId,
+				u32 ErrorCode)
+{
+	(void)CallBackRef;
+	(void)VsmId;
+	(void)RmId;
+	(void)ErrorCode;
+}
+/** @} */
@@ -82,6 +82,8 @@
  *					  expression is not a boolean
  * 1.9  nsk 03/27/19 Update 64bit dma support
  * 1.10 sk  08/20/19 Fixed issues in poll timeout feature.
+ * 1.10 akm 10/14/19 Added XQspiPsu_StreamRead() to read large blocks in
+ *                   pipelined DMA chunks with a per chunk callback.
  * </pre>
  *
  ******************************************************************************/
@@ -109,6 +111,8 @@ static inline void XQspiPsu_SetupRxDma(const XQspiPsu *InstancePtr,
 static inline void XQspiPsu_GenFifoEntryCSAssert(const XQspiPsu *InstancePtr);
 static inline void XQspiPsu_GenFifoEntryData(XQspiPsu *InstancePtr,
 			XQspiPsu_Msg *Msg, s32 Index);
+static inline void XQspiPsu_GenFifoEntryLen(const XQspiPsu *InstancePtr,
+			u32 GenFifoEntry, u32 ByteCount);
 static inline void XQspiPsu_GenFifoEntryCSDeAssert(const XQspiPsu *InstancePtr);
 static inline void XQspiPsu_ReadRxFifo(XQspiPsu *InstancePtr,
 			XQspiPsu_Msg *Msg, s32 Size);
@@ -617,6 +621,258 @@ s32 XQspiPsu_PolledTransfer(XQspiPsu *InstancePtr, XQspiPsu_Msg *Msg,
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ *
+ * This function reads a large block of data from the flash in polled mode,
+ * in chunks received by the RX DMA one after the other. The messages passed
+ * are all transferred on the bus between one CS assert and de-assert, the
+ * flash command, address and dummy cycles are sent once.
+ *
+ * The GENFIFO entries of chunk N + 1 are queued while the DMA fills chunk N,
+ * and the DMA is set up for chunk N + 1 as soon as chunk N is done, so the
+ * bus stays busy for the whole read. The controller stalls the clock while
+ * the RX FIFO is full, no data is lost between two chunks. Handler is called
+ * for each chunk once it is in memory, while the next chunk is received, so
+ * the caller can process (copy, hash, decrypt) the data in parallel with the
+ * transfer.
+ *
+ * @param	InstancePtr is a pointer to the XQspiPsu instance.
+ * @param	Msg is a pointer to the structure containing transfer data.
+ *		The last message is the RX data of the read, the others are
+ *		the command, address and dummy messages, either TX messages
+ *		of at most XQSPIPSU_TXD_DEPTH bytes or dummy messages.
+ * @param	NumMsg is the number of messages to be transferred.
+ * @param	ChunkSize is the number of bytes of a chunk, a power of two
+ *		greater than or equal to 8.
+ * @param	Handler is called with each chunk, it may be NULL.
+ * @param	CallBackRef is passed back to Handler.
+ *
+ * @return
+ *		- XST_SUCCESS if successful.
+ *		- XST_INVALID_PARAM if the messages or ChunkSize can not be
+ *		streamed.
+ *		- XST_FAILURE if the driver is not in DMA read mode.
+ *		- XST_DEVICE_BUSY if a transfer is already in progress.
+ *
+ * @note	The RX buffer must be 4 byte aligned and the RX byte count a
+ *		multiple of 4. 64 bit addresses on 32 bit processors
+ *		(RxAddr64bit) are not supported, use XQspiPsu_PolledTransfer
+ *		for these transfers.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_StreamRead(XQspiPsu *InstancePtr, XQspiPsu_Msg *Msg,
+			u32 NumMsg, u32 ChunkSize,
+			XQspiPsu_ChunkHandler Handler, void *CallBackRef)
+{
+	XQspiPsu_Msg *DataMsg;
+	XQspiPsu_Msg ChunkMsg;
+	u32 QspiPsuStatusReg;
+	u32 BaseAddress;
+	u32 GenFifoEntry;
+	u32 Offset;
+	u32 Queued;
+	u32 Len;
+	u32 Index;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Msg != NULL);
+	Xil_AssertNonvoid(NumMsg > 0U);
+
+	DataMsg = &Msg[NumMsg - 1U];
+	if (((DataMsg->Flags & XQSPIPSU_MSG_FLAG_RX) == FALSE) ||
+		((DataMsg->Flags & XQSPIPSU_MSG_FLAG_TX) != FALSE) ||
+		(DataMsg->Xfer64bit != (u8)0U) ||
+		(DataMsg->ByteCount == 0U) ||
+		(DataMsg->ByteCount > XQSPIPSU_DMA_BYTES_MAX) ||
+		((DataMsg->ByteCount % 4U) != 0U) ||
+		(((UINTPTR)DataMsg->RxBfrPtr % 4U) != 0U) ||
+		(ChunkSize < 8U) || ((ChunkSize & (ChunkSize - 1U)) != 0U)) {
+		Status = (s32)XST_INVALID_PARAM;
+		goto END;
+	}
+	for (Index = 0U; Index < (NumMsg - 1U); Index++) {
+		if (((Msg[Index].Flags & XQSPIPSU_MSG_FLAG_RX) != FALSE) ||
+			(Msg[Index].ByteCount == 0U) ||
+			(((Msg[Index].Flags & XQSPIPSU_MSG_FLAG_TX) != FALSE) &&
+			(Msg[Index].ByteCount > (u32)XQSPIPSU_TXD_DEPTH))) {
+			Status = (s32)XST_INVALID_PARAM;
+			goto END;
+		}
+	}
+
+	if (InstancePtr->ReadMode != XQSPIPSU_READMODE_DMA) {
+		Status = (s32)XST_FAILURE;
+		goto END;
+	}
+
+	/*
+	 * Check whether there is another transfer in progress.
+	 * Not thread-safe
+	 */
+	if (InstancePtr->IsBusy == TRUE) {
+		Status = (s32)XST_DEVICE_BUSY;
+		goto END;
+	}
+
+	InstancePtr->IsBusy = TRUE;
+
+	BaseAddress = InstancePtr->Config.BaseAddress;
+
+	/* Enable */
+	XQspiPsu_Enable(InstancePtr);
+
+	/* Select slave */
+	XQspiPsu_GenFifoEntryCSAssert(InstancePtr);
+
+	/* Command, address and dummy, sent one after the other */
+	for (Index = 0U; Index < (NumMsg - 1U); Index++) {
+		XQspiPsu_GenFifoEntryData(InstancePtr, Msg, (s32)Index);
+
+		if (InstancePtr->IsManualstart == TRUE) {
+			XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_CFG_OFFSET,
+				XQspiPsu_ReadReg(BaseAddress,
+					XQSPIPSU_CFG_OFFSET) |
+					XQSPIPSU_CFG_START_GEN_FIFO_MASK);
+		}
+
+		do {
+			QspiPsuStatusReg = XQspiPsu_ReadReg(BaseAddress,
+						XQSPIPSU_ISR_OFFSET);
+		} while (((QspiPsuStatusReg &
+			XQSPIPSU_ISR_GENFIFOEMPTY_MASK) == FALSE) ||
+			((QspiPsuStatusReg &
+				XQSPIPSU_ISR_TXEMPTY_MASK) == FALSE));
+
+		/* Messages shorter than 8 bytes switch the driver to IO mode */
+		if (InstancePtr->IsUnaligned != 0) {
+			InstancePtr->IsUnaligned = 0;
+			XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_CFG_OFFSET,
+				(XQspiPsu_ReadReg(BaseAddress,
+					XQSPIPSU_CFG_OFFSET) |
+					XQSPIPSU_CFG_MODE_EN_DMA_MASK));
+			InstancePtr->ReadMode = XQSPIPSU_READMODE_DMA;
+		}
+	}
+
+	/* GENFIFO entry of the data chunks, the length is set per chunk */
+	GenFifoEntry = XQspiPsu_SelectSpiMode((u8)DataMsg->BusWidth);
+	GenFifoEntry |= InstancePtr->GenFifoCS;
+	GenFifoEntry |= InstancePtr->GenFifoBus;
+	if ((DataMsg->Flags & XQSPIPSU_MSG_FLAG_STRIPE) != FALSE) {
+		GenFifoEntry |= XQSPIPSU_GENFIFO_STRIPE;
+	}
+	GenFifoEntry |= XQSPIPSU_GENFIFO_DATA_XFER | XQSPIPSU_GENFIFO_RX;
+
+	ChunkMsg = *DataMsg;
+	InstancePtr->TxBytes = 0;
+	InstancePtr->SendBufferPtr = NULL;
+
+	/* DMA for the first chunk, GENFIFO entries for the first two */
+	Len = (DataMsg->ByteCount < ChunkSize) ? DataMsg->ByteCount : ChunkSize;
+	ChunkMsg.RxBfrPtr = DataMsg->RxBfrPtr;
+	ChunkMsg.ByteCount = Len;
+	InstancePtr->RxBytes = (s32)Len;
+	XQspiPsu_SetupRxDma(InstancePtr, &ChunkMsg);
+
+	Queued = 0U;
+	while ((Queued < DataMsg->ByteCount) && (Queued < (2U * ChunkSize))) {
+		Len = DataMsg->ByteCount - Queued;
+		if (Len > ChunkSize) {
+			Len = ChunkSize;
+		}
+		XQspiPsu_GenFifoEntryLen(InstancePtr, GenFifoEntry, Len);
+		Queued += Len;
+	}
+	if (InstancePtr->IsManualstart == TRUE) {
+		XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_CFG_OFFSET,
+			XQspiPsu_ReadReg(BaseAddress, XQSPIPSU_CFG_OFFSET) |
+				XQSPIPSU_CFG_START_GEN_FIFO_MASK);
+	}
+
+	Offset = 0U;
+	while (Offset < DataMsg->ByteCount) {
+		Len = DataMsg->ByteCount - Offset;
+		if (Len > ChunkSize) {
+			Len = ChunkSize;
+		}
+
+		/* Wait for the DMA to complete the current chunk */
+		while ((XQspiPsu_ReadReg(BaseAddress,
+			XQSPIPSU_QSPIDMA_DST_I_STS_OFFSET) &
+			XQSPIPSU_QSPIDMA_DST_I_STS_DONE_MASK) == FALSE) {
+		}
+		XQspiPsu_WriteReg(BaseAddress,
+			XQSPIPSU_QSPIDMA_DST_I_STS_OFFSET,
+			XQSPIPSU_QSPIDMA_DST_I_STS_DONE_MASK);
+
+		/* Restart the DMA for the next chunk, already on the bus */
+		if ((Offset + Len) < DataMsg->ByteCount) {
+			ChunkMsg.RxBfrPtr = DataMsg->RxBfrPtr + Offset + Len;
+			ChunkMsg.ByteCount = DataMsg->ByteCount - (Offset + Len);
+			if (ChunkMsg.ByteCount > ChunkSize) {
+				ChunkMsg.ByteCount = ChunkSize;
+			}
+			InstancePtr->RxBytes = (s32)ChunkMsg.ByteCount;
+			XQspiPsu_SetupRxDma(InstancePtr, &ChunkMsg);
+		}
+
+		/* Queue the chunk after the next one */
+		if (Queued < DataMsg->ByteCount) {
+			u32 QueueLen = DataMsg->ByteCount - Queued;
+
+			if (QueueLen > ChunkSize) {
+				QueueLen = ChunkSize;
+			}
+			XQspiPsu_GenFifoEntryLen(InstancePtr, GenFifoEntry,
+					QueueLen);
+			Queued += QueueLen;
+			if (InstancePtr->IsManualstart == TRUE) {
+				XQspiPsu_WriteReg(BaseAddress,
+					XQSPIPSU_CFG_OFFSET,
+					XQspiPsu_ReadReg(BaseAddress,
+						XQSPIPSU_CFG_OFFSET) |
+					XQSPIPSU_CFG_START_GEN_FIFO_MASK);
+			}
+		}
+
+		if (Handler != NULL) {
+			Handler(CallBackRef, DataMsg->RxBfrPtr + Offset, Len);
+		}
+
+		Offset += Len;
+	}
+	InstancePtr->RxBytes = 0;
+
+	/* De-select slave */
+	XQspiPsu_GenFifoEntryCSDeAssert(InstancePtr);
+
+	if (InstancePtr->IsManualstart == TRUE) {
+		XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_CFG_OFFSET,
+			XQspiPsu_ReadReg(BaseAddress, XQSPIPSU_CFG_OFFSET) |
+				XQSPIPSU_CFG_START_GEN_FIFO_MASK);
+	}
+
+	QspiPsuStatusReg = XQspiPsu_ReadReg(BaseAddress, XQSPIPSU_ISR_OFFSET);
+	while ((QspiPsuStatusReg & XQSPIPSU_ISR_GENFIFOEMPTY_MASK) == FALSE) {
+		QspiPsuStatusReg = XQspiPsu_ReadReg(BaseAddress,
+						XQSPIPSU_ISR_OFFSET);
+	}
+
+	/* Clear the busy flag. */
+	InstancePtr->IsBusy = FALSE;
+
+	/* Disable the device. */
+	XQspiPsu_Disable(InstancePtr);
+
+	Status = XST_SUCCESS;
+
+	END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  *
@@ -1420,8 +1676,6 @@ static inline void XQspiPsu_GenFifoEntryData(XQspiPsu *InstancePtr,
 {
 	u32 GenFifoEntry;
 	u32 BaseAddress;
-	u32 TempCount;
-	u32 ImmData;
 
 #ifdef DEBUG
 	xil_printf("\nXQspiPsu_GenFifoEntryData\r\n");
@@ -1458,62 +1712,94 @@ static inline void XQspiPsu_GenFifoEntryData(XQspiPsu *InstancePtr,
 
 	XQspiPsu_TXRXSetup(InstancePtr, &Msg[Index], &GenFifoEntry);
 
-	if (Msg[Index].ByteCount <= XQSPIPSU_GENFIFO_IMM_DATA_MASK) {
-		GenFifoEntry &= (u32)(~XQSPIPSU_GENFIFO_IMM_DATA_MASK);
-		GenFifoEntry |= Msg[Index].ByteCount;
+	XQspiPsu_GenFifoEntryLen(InstancePtr, GenFifoEntry,
+			Msg[Index].ByteCount);
+
+	/* One dummy GenFifo entry in case of IO mode */
+	if ((InstancePtr->ReadMode == XQSPIPSU_READMODE_IO) &&
+			((Msg[Index].Flags & XQSPIPSU_MSG_FLAG_RX) != FALSE)) {
+		GenFifoEntry = 0x0U;
 #ifdef DEBUG
-	xil_printf("\nFifoEntry=%08x\r\n", GenFifoEntry);
+		xil_printf("\nDummy FifoEntry=%08x\r\n", GenFifoEntry);
+#endif
+		XQspiPsu_WriteReg(BaseAddress,
+				XQSPIPSU_GEN_FIFO_OFFSET, GenFifoEntry);
+	}
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This function writes the GENFIFO entries for the length of a data transfer.
+ * Lengths up to 255 bytes take one immediate entry, longer ones take one
+ * exponent entry per bit set above bit 7 and an immediate entry for the low
+ * byte.
+ *
+ * @param	InstancePtr is a pointer to the XQspiPsu instance.
+ * @param	GenFifoEntry is the GENFIFO entry with all the fields but the
+ *		immediate data and exponent set up.
+ * @param	ByteCount is the number of bytes to be transferred.
+ *
+ * @return	None
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static inline void XQspiPsu_GenFifoEntryLen(const XQspiPsu *InstancePtr,
+						u32 GenFifoEntry, u32 ByteCount)
+{
+	u32 BaseAddress;
+	u32 TempCount;
+	u32 ImmData;
+	u32 Entry = GenFifoEntry;
+
+	BaseAddress = InstancePtr->Config.BaseAddress;
+
+	if (ByteCount <= XQSPIPSU_GENFIFO_IMM_DATA_MASK) {
+		Entry &= (u32)(~XQSPIPSU_GENFIFO_IMM_DATA_MASK);
+		Entry |= ByteCount;
+#ifdef DEBUG
+	xil_printf("\nFifoEntry=%08x\r\n", Entry);
 #endif
 		XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_GEN_FIFO_OFFSET,
-				GenFifoEntry);
+				Entry);
 	} else {
-		TempCount = Msg[Index].ByteCount;
+		TempCount = ByteCount;
 		u32 Exponent = 8;	/* 2^8 = 256 */
 
 		ImmData = TempCount & 0xFFU;
 		/* Exponent entries */
-		GenFifoEntry |= XQSPIPSU_GENFIFO_EXP;
+		Entry |= XQSPIPSU_GENFIFO_EXP;
 		while (TempCount != 0U) {
 			if ((TempCount &
 				XQSPIPSU_GENFIFO_EXP_START) != FALSE) {
-				GenFifoEntry &=
+				Entry &=
 					(u32)(~XQSPIPSU_GENFIFO_IMM_DATA_MASK);
-				GenFifoEntry |= Exponent;
+				Entry |= Exponent;
 #ifdef DEBUG
 				xil_printf("\nFifoEntry=%08x\r\n",
-					GenFifoEntry);
+					Entry);
 #endif
 				XQspiPsu_WriteReg(BaseAddress,
 					XQSPIPSU_GEN_FIFO_OFFSET,
-					GenFifoEntry);
+					Entry);
 			}
 			TempCount = TempCount >> 1;
 			Exponent++;
 		}
 
 		/* Immediate entry */
-		GenFifoEntry &= (u32)(~XQSPIPSU_GENFIFO_EXP);
+		Entry &= (u32)(~XQSPIPSU_GENFIFO_EXP);
 		if ((ImmData & 0xFFU) != FALSE) {
-			GenFifoEntry &= (u32)(~XQSPIPSU_GENFIFO_IMM_DATA_MASK);
-			GenFifoEntry |= ImmData & 0xFFU;
+			Entry &= (u32)(~XQSPIPSU_GENFIFO_IMM_DATA_MASK);
+			Entry |= ImmData & 0xFFU;
 #ifdef DEBUG
-			xil_printf("\nFifoEntry=%08x\r\n", GenFifoEntry);
+			xil_printf("\nFifoEntry=%08x\r\n", Entry);
 #endif
 			XQspiPsu_WriteReg(BaseAddress,
-				XQSPIPSU_GEN_FIFO_OFFSET, GenFifoEntry);
+				XQSPIPSU_GEN_FIFO_OFFSET, Entry);
 		}
 	}
-
-	/* One dummy GenFifo entry in case of IO mode */
-	if ((InstancePtr->ReadMode == XQSPIPSU_READMODE_IO) &&
-			((Msg[Index].Flags & XQSPIPSU_MSG_FLAG_RX) != FALSE)) {
-		GenFifoEntry = 0x0U;
-#ifdef DEBUG
-		xil_printf("\nDummy FifoEntry=%08x\r\n", GenFifoEntry);
-#endif
-		XQspiPsu_WriteReg(BaseAddress,
-				XQSPIPSU_GEN_FIFO_OFFSET, GenFifoEntry);
-	}
 }
 
 /*****************************************************************************/
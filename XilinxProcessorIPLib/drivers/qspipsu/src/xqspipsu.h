@@ -166,6 +166,7 @@
  * 1.10 akm 08/22/19 Set recommended tap delay values for 37.5MHZ, 100MHZ and
  *		     150MHZ frequencies in Versal.
  * 1.10 akm 09/05/19 Added Multi Die Erase and Muti Die Read support.
+ * 1.10 akm 10/14/19 Added XQspiPsu_StreamRead() and XQspiPsu_ChunkHandler.
  *
  * </pre>
  *
@@ -207,6 +208,18 @@ extern "C" {
 typedef void (*XQspiPsu_StatusHandler) (const void *CallBackRef, u32 StatusEvent,
 					u32 ByteCount);
 
+/**
+ * The handler data type passed to XQspiPsu_StreamRead(). It is called in the
+ * context of XQspiPsu_StreamRead() each time a chunk of the read data is in
+ * memory, while the next chunk is being received.
+ *
+ * @param	CallBackRef is the reference passed to XQspiPsu_StreamRead().
+ * @param	ChunkPtr is a pointer to the chunk in the RX buffer.
+ * @param	ByteCount is the number of bytes of the chunk.
+ */
+typedef void (*XQspiPsu_ChunkHandler) (void *CallBackRef, u8 *ChunkPtr,
+					u32 ByteCount);
+
 /**
  * This typedef contains configuration information for a flash message.
  */
@@ -386,6 +399,9 @@ void XQspiPsu_Abort(XQspiPsu *InstancePtr);
 /* Transfer functions and handlers */
 s32 XQspiPsu_PolledTransfer(XQspiPsu *InstancePtr, XQspiPsu_Msg *Msg,
 				u32 NumMsg);
+s32 XQspiPsu_StreamRead(XQspiPsu *InstancePtr, XQspiPsu_Msg *Msg,
+			u32 NumMsg, u32 ChunkSize,
+			XQspiPsu_ChunkHandler Handler, void *CallBackRef);
 s32 XQspiPsu_InterruptTransfer(XQspiPsu *InstancePtr, XQspiPsu_Msg *Msg,
 				u32 NumMsg);
 s32 XQspiPsu_InterruptHandler(XQspiPsu *InstancePtr);
@@ -253,6 +253,8 @@
 *       cog    10/02/19 Added macros for the clock divider.
 *       cog    10/02/19 Added macro for fabric rate of 16.
 *       cog    10/02/19 Added macros for new VCO ranges.
+*       cog    10/14/19 Added XRFdc_Bulk_Settings structure and the bulk settings APIs.
+*       cog    10/14/19 Added XRFdc_Hop_Table structure and the frequency hopping APIs.
 *
 * </pre>
 *
@@ -409,6 +411,52 @@ typedef struct {
 	u8 MixerType;
 } XRFdc_Mixer_Settings;
 
+/**
+ * Bulk settings, one entry per block. Flags selects the settings applied,
+ * the rest of the structure after Factor is filled by
+ * XRFdc_PrepareBulkSettings().
+ */
+typedef struct {
+	u32 Type; /* ADC or DAC */
+	u32 Tile_Id;
+	u32 Block_Id;
+	u32 Flags; /* XRFDC_BULK_* */
+	XRFdc_Mixer_Settings Mixer_Settings; /* Freq and PhaseOffset for XRFDC_BULK_NCO */
+	XRFdc_QMC_Settings QMC_Settings;
+	u32 Factor; /* Decimation or interpolation factor */
+	u16 NCORegs[5]; /* NCO frequency and phase register values */
+	u16 NCOUpdtReg; /* NCO update register value */
+	u32 EventSource;
+} XRFdc_Bulk_Settings;
+
+/**
+ * Frequency hopping table entry.
+ */
+typedef struct {
+	u16 NCORegs[5]; /* NCO frequency and phase register values */
+} XRFdc_Hop_Entry;
+
+/**
+ * Frequency hopping table, filled by XRFdc_PrepareHopTable().
+ */
+typedef struct {
+	u32 Type;
+	u32 Tile_Id;
+	u32 Block_Id;
+	u32 EventSource;
+	u32 NumHops;
+	double *FreqPtr; /* Frequencies of the hops in MHz */
+	double PhaseOffset;
+	XRFdc_Hop_Entry *HopsPtr;
+	u32 NumSlices; /* 2 for a block of a 4 GSPS ADC tile */
+	u32 SliceAddr[2];
+	u32 SliceIndex[2];
+	u32 NumUpdates; /* Update event writes */
+	u32 UpdtAddr[2];
+	u32 UpdtOffset[2];
+	u16 UpdtValue[2];
+} XRFdc_Hop_Table;
+
 /**
  * ADC block Threshold settings.
  */
@@ -759,6 +807,16 @@ typedef struct {
 #define XRFDC_EVENT_MIXER 0x00000001U
 #define XRFDC_EVENT_CRSE_DLY 0x00000002U
 #define XRFDC_EVENT_QMC 0x00000004U
+#define XRFDC_BULK_NCO 0x00000001U
+#define XRFDC_BULK_MIXER 0x00000002U
+#define XRFDC_BULK_QMC 0x00000004U
+#define XRFDC_BULK_FACTOR 0x00000008U
+#define XRFDC_NCO_NUM_REGS 5U
+#define XRFDC_NCO_REG_FQWD_LOW 0U
+#define XRFDC_NCO_REG_FQWD_MID 1U
+#define XRFDC_NCO_REG_FQWD_UPP 2U
+#define XRFDC_NCO_REG_PHASE_LOW 3U
+#define XRFDC_NCO_REG_PHASE_UPP 4U
 #define XRFDC_SELECT_ALL_TILES -1
 #define XRFDC_ADC_4GSPS 1U
 
@@ -2017,6 +2075,13 @@ u32 XRFdc_SetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_
 			   XRFdc_Mixer_Settings *MixerSettingsPtr);
 u32 XRFdc_GetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
 			   XRFdc_Mixer_Settings *MixerSettingsPtr);
+u32 XRFdc_PrepareBulkSettings(XRFdc *InstancePtr, XRFdc_Bulk_Settings *BulkSettingsPtr, u32 NumEntries,
+			      u32 EventSource);
+u32 XRFdc_ApplyBulkSettings(XRFdc *InstancePtr, XRFdc_Bulk_Settings *BulkSettingsPtr, u32 NumEntries);
+u32 XRFdc_PrepareHopTable(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, double *FreqPtr,
+			  double PhaseOffset, u32 NumHops, u32 EventSource, XRFdc_Hop_Entry *HopsPtr,
+			  XRFdc_Hop_Table *HopTablePtr);
+u32 XRFdc_Hop(XRFdc *InstancePtr, XRFdc_Hop_Table *HopTablePtr, u32 Hop);
 u32 XRFdc_SetQMCSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, XRFdc_QMC_Settings *QMCSettingsPtr);
 u32 XRFdc_GetQMCSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, XRFdc_QMC_Settings *QMCSettingsPtr);
 u32 XRFdc_GetCoarseDelaySettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
@@ -56,6 +56,9 @@
 *                       be incorrect.
 *       cog    09/19/19 Calibration mode 1 does not need the frequency shifting workaround
 *                       for Gen 3 devices.
+*       cog    10/14/19 Added XRFdc_PrepareBulkSettings() and XRFdc_ApplyBulkSettings()
+*                       APIs, the NCO register values are computed by a common function.
+*       cog    10/14/19 Added XRFdc_PrepareHopTable() and XRFdc_Hop() APIs.
 * </pre>
 *
 ******************************************************************************/
@@ -73,6 +76,9 @@ static void XRFdc_SetCoarseMixer(XRFdc *InstancePtr, u32 Type, u32 BaseAddr, u32
 				 u32 CoarseMixFreq, XRFdc_Mixer_Settings *MixerSettingsPtr);
 static u32 XRFdc_MixerRangeCheck(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, XRFdc_Mixer_Settings *MixerSettingsPtr);
 static void XRFdc_MixersOff(XRFdc *InstancePtr, u32 BaseAddr);
+static u32 XRFdc_GetNCORegs(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, double SamplingRate,
+			    double NCOFreq, double PhaseOffset, u16 *NCORegsPtr);
+static void XRFdc_WriteNCORegs(XRFdc *InstancePtr, u32 BaseAddr, u16 *NCORegsPtr);
 
 /************************** Function Prototypes ******************************/
 
@@ -109,15 +115,13 @@ u32 XRFdc_SetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_
 	u16 ReadReg;
 	u32 BaseAddr;
 	double SamplingRate;
-	s64 Freq;
-	s32 PhaseOffset;
 	u32 NoOfBlocks;
 	u32 Index;
 	XRFdc_Mixer_Settings *MixerConfigPtr;
 	u8 CalibrationMode = 0U;
 	u32 CoarseMixFreq;
 	double NCOFreq;
-	u32 NyquistZone = 0U;
+	u16 NCORegs[XRFDC_NCO_NUM_REGS];
 	u32 Offset;
 
 	Xil_AssertNonvoid(InstancePtr != NULL);
@@ -248,40 +252,13 @@ u32 XRFdc_SetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_
 			}
 		}
 
-		if ((NCOFreq < -(SamplingRate / 2.0)) || (NCOFreq > (SamplingRate / 2.0))) {
-			Status = XRFdc_GetNyquistZone(InstancePtr, Type, Tile_Id, Block_Id, &NyquistZone);
-			if (Status != XRFDC_SUCCESS) {
-				return XRFDC_FAILURE;
-			}
-			do {
-				if (NCOFreq < -(SamplingRate / 2.0)) {
-					NCOFreq += SamplingRate;
-				}
-				if (NCOFreq > (SamplingRate / 2.0)) {
-					NCOFreq -= SamplingRate;
-				}
-			} while ((NCOFreq < -(SamplingRate / 2.0)) || (NCOFreq > (SamplingRate / 2.0)));
-
-			if ((NyquistZone == XRFDC_EVEN_NYQUIST_ZONE) && (NCOFreq != 0)) {
-				NCOFreq *= -1;
-			}
+		/* NCO Frequency and Phase Offset */
+		Status = XRFdc_GetNCORegs(InstancePtr, Type, Tile_Id, Block_Id, SamplingRate, NCOFreq,
+					  MixerSettingsPtr->PhaseOffset, NCORegs);
+		if (Status != XRFDC_SUCCESS) {
+			return XRFDC_FAILURE;
 		}
-
-		/* NCO Frequency */
-		Freq = ((NCOFreq * XRFDC_NCO_FREQ_MULTIPLIER) / SamplingRate);
-		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_LOW_OFFSET, (u16)Freq);
-		ReadReg = (Freq >> XRFDC_NCO_FQWD_MID_SHIFT) & XRFDC_NCO_FQWD_MID_MASK;
-		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_MID_OFFSET, (u16)ReadReg);
-		ReadReg = (Freq >> XRFDC_NCO_FQWD_UPP_SHIFT) & XRFDC_NCO_FQWD_UPP_MASK;
-		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_UPP_OFFSET, (u16)ReadReg);
-
-		/* Phase Offset */
-		PhaseOffset = ((MixerSettingsPtr->PhaseOffset * XRFDC_NCO_PHASE_MULTIPLIER) /
-			       XRFDC_MIXER_PHASE_OFFSET_UP_LIMIT);
-		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_NCO_PHASE_LOW_OFFSET, (u16)PhaseOffset);
-
-		ReadReg = (PhaseOffset >> XRFDC_NCO_PHASE_UPP_SHIFT) & XRFDC_NCO_PHASE_UPP_MASK;
-		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_NCO_PHASE_UPP_OFFSET, ReadReg);
+		XRFdc_WriteNCORegs(InstancePtr, BaseAddr, NCORegs);
 
 		switch (MixerSettingsPtr->MixerType) {
 		case XRFDC_MIXER_TYPE_COARSE:
@@ -957,4 +934,607 @@ RETURN_PATH:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* Static API used to compute the NCO frequency and phase offset register
+* values of a block. The frequency is folded into the first Nyquist zone.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
+* @param    Tile_Id Valid values are 0-3.
+* @param    Block_Id is ADC/DAC block number inside the tile. Valid values
+*           are 0-3.
+* @param    SamplingRate is the sampling rate of the tile in MHz.
+* @param    NCOFreq is the NCO frequency in MHz, after the calibration mode
+*           adjustment.
+* @param    PhaseOffset is the NCO phase offset in degrees.
+* @param    NCORegsPtr is the array of XRFDC_NCO_NUM_REGS register values,
+*           indexed by XRFDC_NCO_REG_*.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if the Nyquist zone cannot be read.
+*
+* @note     None.
+*
+******************************************************************************/
+static u32 XRFdc_GetNCORegs(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, double SamplingRate,
+			    double NCOFreq, double PhaseOffset, u16 *NCORegsPtr)
+{
+	u32 Status;
+	u32 NyquistZone = 0U;
+	s64 Freq;
+	s32 Phase;
+
+	if ((NCOFreq < -(SamplingRate / 2.0)) || (NCOFreq > (SamplingRate / 2.0))) {
+		Status = XRFdc_GetNyquistZone(InstancePtr, Type, Tile_Id, Block_Id, &NyquistZone);
+		if (Status != XRFDC_SUCCESS) {
+			goto RETURN_PATH;
+		}
+		do {
+			if (NCOFreq < -(SamplingRate / 2.0)) {
+				NCOFreq += SamplingRate;
+			}
+			if (NCOFreq > (SamplingRate / 2.0)) {
+				NCOFreq -= SamplingRate;
+			}
+		} while ((NCOFreq < -(SamplingRate / 2.0)) || (NCOFreq > (SamplingRate / 2.0)));
+
+		if ((NyquistZone == XRFDC_EVEN_NYQUIST_ZONE) && (NCOFreq != 0)) {
+			NCOFreq *= -1;
+		}
+	}
+
+	Freq = ((NCOFreq * XRFDC_NCO_FREQ_MULTIPLIER) / SamplingRate);
+	NCORegsPtr[XRFDC_NCO_REG_FQWD_LOW] = (u16)Freq;
+	NCORegsPtr[XRFDC_NCO_REG_FQWD_MID] = (u16)((Freq >> XRFDC_NCO_FQWD_MID_SHIFT) & XRFDC_NCO_FQWD_MID_MASK);
+	NCORegsPtr[XRFDC_NCO_REG_FQWD_UPP] = (u16)((Freq >> XRFDC_NCO_FQWD_UPP_SHIFT) & XRFDC_NCO_FQWD_UPP_MASK);
+
+	Phase = ((PhaseOffset * XRFDC_NCO_PHASE_MULTIPLIER) / XRFDC_MIXER_PHASE_OFFSET_UP_LIMIT);
+	NCORegsPtr[XRFDC_NCO_REG_PHASE_LOW] = (u16)Phase;
+	NCORegsPtr[XRFDC_NCO_REG_PHASE_UPP] = (u16)((Phase >> XRFDC_NCO_PHASE_UPP_SHIFT) & XRFDC_NCO_PHASE_UPP_MASK);
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Static API used to write the NCO frequency and phase offset registers of a
+* block.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    BaseAddr is the block base address.
+* @param    NCORegsPtr is the array of register values computed by
+*           XRFdc_GetNCORegs().
+*
+* @return   None
+*
+* @note     Plain writes, no register is read.
+*
+******************************************************************************/
+static void XRFdc_WriteNCORegs(XRFdc *InstancePtr, u32 BaseAddr, u16 *NCORegsPtr)
+{
+	XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_LOW_OFFSET, NCORegsPtr[XRFDC_NCO_REG_FQWD_LOW]);
+	XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_MID_OFFSET, NCORegsPtr[XRFDC_NCO_REG_FQWD_MID]);
+	XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_UPP_OFFSET, NCORegsPtr[XRFDC_NCO_REG_FQWD_UPP]);
+	XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_NCO_PHASE_LOW_OFFSET, NCORegsPtr[XRFDC_NCO_REG_PHASE_LOW]);
+	XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_NCO_PHASE_UPP_OFFSET, NCORegsPtr[XRFDC_NCO_REG_PHASE_UPP]);
+}
+
+/*****************************************************************************/
+/**
+* Static API used to compute the NCO frequency and phase offset register
+* values of a block for a given mixer frequency, as XRFdc_SetMixerSettings()
+* would program them.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
+* @param    Tile_Id Valid values are 0-3.
+* @param    Block_Id is ADC/DAC block number inside the tile. Valid values
+*           are 0-3.
+* @param    Freq is the mixer frequency in MHz.
+* @param    PhaseOffset is the NCO phase offset in degrees.
+* @param    NCORegsPtr is the array of XRFDC_NCO_NUM_REGS register values.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     None.
+*
+******************************************************************************/
+static u32 XRFdc_GetBlockNCORegs(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, double Freq,
+				 double PhaseOffset, u16 *NCORegsPtr)
+{
+	u32 Status;
+	double SamplingRate;
+	u8 CalibrationMode = 0U;
+
+	if (Type == XRFDC_ADC_TILE) {
+		SamplingRate = InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.SampleRate;
+	} else {
+		SamplingRate = InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.SampleRate;
+	}
+	if (SamplingRate <= 0) {
+		metal_log(METAL_LOG_ERROR, "\n Incorrect Sampling rate in %s\r\n", __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+	SamplingRate *= XRFDC_MILLI;
+
+	/* Same calibration mode adjustment as XRFdc_SetMixerSettings() */
+	if ((Type == XRFDC_ADC_TILE) && (InstancePtr->RFdc_Config.IPType < XRFDC_GEN3)) {
+		Status = XRFdc_GetCalibrationMode(InstancePtr, Tile_Id, Block_Id, &CalibrationMode);
+		if (Status != XRFDC_SUCCESS) {
+			goto RETURN_PATH;
+		}
+		if (CalibrationMode == XRFDC_CALIB_MODE1) {
+			Freq -= SamplingRate / 2.0;
+		}
+	}
+
+	Status = XRFdc_GetNCORegs(InstancePtr, Type, Tile_Id, Block_Id, SamplingRate, Freq, PhaseOffset,
+				  NCORegsPtr);
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Static API used to get the range of internal blocks addressed by a block,
+* the two slices of a block of a 4 GSPS ADC tile.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
+* @param    Tile_Id Valid values are 0-3.
+* @param    Block_Id is ADC/DAC block number inside the tile.
+* @param    IndexPtr is the first internal block.
+* @param    NoOfBlocksPtr is the internal block after the last one.
+*
+* @return   None
+*
+* @note     None.
+*
+******************************************************************************/
+static void XRFdc_GetBlockRange(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 *IndexPtr,
+				u32 *NoOfBlocksPtr)
+{
+	*IndexPtr = Block_Id;
+	if ((XRFdc_IsHighSpeedADC(InstancePtr, Tile_Id) == 1) && (Type == XRFDC_ADC_TILE)) {
+		*NoOfBlocksPtr = XRFDC_NUM_OF_BLKS2;
+		if (Block_Id == XRFDC_BLK_ID1) {
+			*IndexPtr = XRFDC_BLK_ID2;
+			*NoOfBlocksPtr = XRFDC_NUM_OF_BLKS4;
+		}
+	} else {
+		*NoOfBlocksPtr = Block_Id + 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This API prepares a table of block settings for XRFdc_ApplyBulkSettings().
+* All the settings are checked and, for the XRFDC_BULK_NCO entries, the NCO
+* register values are computed, so that applying the table only writes to
+* the device. A table can be prepared once and applied many times, for
+* instance one table per hop of a frequency hopping sequence.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    BulkSettingsPtr is the table of block settings.
+* @param    NumEntries is the number of entries in the table.
+* @param    EventSource is the update event source of the table. For
+*           XRFDC_EVNT_SRC_TILE, XRFdc_ApplyBulkSettings() triggers the update
+*           event of every tile of the table. For XRFDC_EVNT_SRC_SYSREF,
+*           XRFDC_EVNT_SRC_PL or XRFDC_EVNT_SRC_MARKER the update is triggered
+*           externally, at the same time for all the tiles.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if an entry is not valid.
+*
+* @note     The table must be prepared again after a change of the sampling
+*           rate, the Nyquist zone or the calibration mode of its blocks.
+*
+******************************************************************************/
+u32 XRFdc_PrepareBulkSettings(XRFdc *InstancePtr, XRFdc_Bulk_Settings *BulkSettingsPtr, u32 NumEntries,
+			      u32 EventSource)
+{
+	u32 Status;
+	u32 Entry;
+	u32 BaseAddr;
+	XRFdc_Bulk_Settings *SettingsPtr;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(BulkSettingsPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	if ((EventSource != XRFDC_EVNT_SRC_TILE) && (EventSource != XRFDC_EVNT_SRC_SYSREF) &&
+	    (EventSource != XRFDC_EVNT_SRC_PL) && (EventSource != XRFDC_EVNT_SRC_MARKER)) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid event source selection in %s\r\n", __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	for (Entry = 0U; Entry < NumEntries; Entry++) {
+		SettingsPtr = &BulkSettingsPtr[Entry];
+		SettingsPtr->EventSource = EventSource;
+
+		if ((SettingsPtr->Type != XRFDC_ADC_TILE) && (SettingsPtr->Type != XRFDC_DAC_TILE)) {
+			metal_log(METAL_LOG_ERROR, "\n Invalid converter type in entry %u of %s\r\n", Entry,
+				  __func__);
+			Status = XRFDC_FAILURE;
+			goto RETURN_PATH;
+		}
+		if ((EventSource == XRFDC_EVNT_SRC_MARKER) && (SettingsPtr->Type == XRFDC_ADC_TILE)) {
+			metal_log(METAL_LOG_ERROR, "\n Invalid event source selection in %s\r\n", __func__);
+			Status = XRFDC_FAILURE;
+			goto RETURN_PATH;
+		}
+
+		Status = XRFdc_CheckDigitalPathEnabled(InstancePtr, SettingsPtr->Type, SettingsPtr->Tile_Id,
+						       SettingsPtr->Block_Id);
+		if (Status != XRFDC_SUCCESS) {
+			metal_log(METAL_LOG_ERROR, "\n Requested block not available in entry %u of %s\r\n", Entry,
+				  __func__);
+			goto RETURN_PATH;
+		}
+
+		if ((SettingsPtr->Flags & XRFDC_BULK_MIXER) != 0U) {
+			SettingsPtr->Mixer_Settings.EventSource = EventSource;
+			Status = XRFdc_MixerRangeCheck(InstancePtr, SettingsPtr->Type, SettingsPtr->Tile_Id,
+						       &SettingsPtr->Mixer_Settings);
+			if (Status != XRFDC_SUCCESS) {
+				goto RETURN_PATH;
+			}
+		} else if ((SettingsPtr->Flags & XRFDC_BULK_NCO) != 0U) {
+			if ((SettingsPtr->Mixer_Settings.PhaseOffset >= XRFDC_MIXER_PHASE_OFFSET_UP_LIMIT) ||
+			    (SettingsPtr->Mixer_Settings.PhaseOffset <= XRFDC_MIXER_PHASE_OFFSET_LOW_LIMIT)) {
+				metal_log(METAL_LOG_ERROR, "\n Invalid phase offset value in %s\r\n", __func__);
+				Status = XRFDC_FAILURE;
+				goto RETURN_PATH;
+			}
+
+			Status = XRFdc_GetBlockNCORegs(InstancePtr, SettingsPtr->Type, SettingsPtr->Tile_Id,
+						       SettingsPtr->Block_Id, SettingsPtr->Mixer_Settings.Freq,
+						       SettingsPtr->Mixer_Settings.PhaseOffset, SettingsPtr->NCORegs);
+			if (Status != XRFDC_SUCCESS) {
+				goto RETURN_PATH;
+			}
+
+			/* Update mode, the only field of the register */
+			BaseAddr = XRFDC_BLOCK_BASE(SettingsPtr->Type, SettingsPtr->Tile_Id, SettingsPtr->Block_Id);
+			SettingsPtr->NCOUpdtReg =
+				(XRFdc_ReadReg16(InstancePtr, BaseAddr, XRFDC_NCO_UPDT_OFFSET) &
+				 ~XRFDC_NCO_UPDT_MODE_MASK) |
+				(EventSource & XRFDC_NCO_UPDT_MODE_MASK);
+		}
+
+		if ((SettingsPtr->Flags & XRFDC_BULK_QMC) != 0U) {
+			SettingsPtr->QMC_Settings.EventSource = EventSource;
+		}
+	}
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This API applies a table of block settings prepared by
+* XRFdc_PrepareBulkSettings(). The settings are written tile by tile and,
+* when the event source of the table is XRFDC_EVNT_SRC_TILE, the mixer and
+* QMC settings of a tile take effect with a single update event of the tile,
+* triggered after all its blocks are written.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    BulkSettingsPtr is the table of block settings.
+* @param    NumEntries is the number of entries in the table.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     The XRFDC_BULK_NCO entries only write the NCO frequency, phase
+*           offset and update mode registers of their blocks. The
+*           XRFDC_BULK_MIXER, XRFDC_BULK_QMC and XRFDC_BULK_FACTOR entries use
+*           XRFdc_SetMixerSettings(), XRFdc_SetQMCSettings() and
+*           XRFdc_SetDecimationFactor() or XRFdc_SetInterpolationFactor(),
+*           they are meant for the setup rather than for hopping.
+*
+******************************************************************************/
+u32 XRFdc_ApplyBulkSettings(XRFdc *InstancePtr, XRFdc_Bulk_Settings *BulkSettingsPtr, u32 NumEntries)
+{
+	u32 Status = XRFDC_SUCCESS;
+	u32 Type;
+	u32 Tile_Id;
+	u32 Entry;
+	u32 Index;
+	u32 NoOfBlocks;
+	u32 BaseAddr;
+	u32 UpdateTile;
+	XRFdc_Bulk_Settings *SettingsPtr;
+	XRFdc_Mixer_Settings *MixerConfigPtr;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(BulkSettingsPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	for (Type = XRFDC_ADC_TILE; Type <= XRFDC_DAC_TILE; Type++) {
+		for (Tile_Id = XRFDC_TILE_ID0; Tile_Id <= XRFDC_TILE_ID_MAX; Tile_Id++) {
+			UpdateTile = 0U;
+			for (Entry = 0U; Entry < NumEntries; Entry++) {
+				SettingsPtr = &BulkSettingsPtr[Entry];
+				if ((SettingsPtr->Type != Type) || (SettingsPtr->Tile_Id != Tile_Id)) {
+					continue;
+				}
+
+				if ((SettingsPtr->Flags & XRFDC_BULK_FACTOR) != 0U) {
+					if (Type == XRFDC_ADC_TILE) {
+						Status = XRFdc_SetDecimationFactor(InstancePtr, Tile_Id,
+										   SettingsPtr->Block_Id,
+										   SettingsPtr->Factor);
+					} else {
+						Status = XRFdc_SetInterpolationFactor(InstancePtr, Tile_Id,
+										      SettingsPtr->Block_Id,
+										      SettingsPtr->Factor);
+					}
+					if (Status != XRFDC_SUCCESS) {
+						goto RETURN_PATH;
+					}
+				}
+
+				if ((SettingsPtr->Flags & XRFDC_BULK_MIXER) != 0U) {
+					Status = XRFdc_SetMixerSettings(InstancePtr, Type, Tile_Id, SettingsPtr->Block_Id,
+									&SettingsPtr->Mixer_Settings);
+					if (Status != XRFDC_SUCCESS) {
+						goto RETURN_PATH;
+					}
+					UpdateTile = 1U;
+				} else if ((SettingsPtr->Flags & XRFDC_BULK_NCO) != 0U) {
+					XRFdc_GetBlockRange(InstancePtr, Type, Tile_Id, SettingsPtr->Block_Id, &Index,
+							    &NoOfBlocks);
+					for (; Index < NoOfBlocks; Index++) {
+						BaseAddr = XRFDC_BLOCK_BASE(Type, Tile_Id, Index);
+						XRFdc_WriteNCORegs(InstancePtr, BaseAddr, SettingsPtr->NCORegs);
+						XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_NCO_UPDT_OFFSET,
+								 SettingsPtr->NCOUpdtReg);
+
+						if (Type == XRFDC_ADC_TILE) {
+							MixerConfigPtr = &InstancePtr->ADC_Tile[Tile_Id]
+										  .ADCBlock_Digital_Datapath[Index]
+										  .Mixer_Settings;
+						} else {
+							MixerConfigPtr = &InstancePtr->DAC_Tile[Tile_Id]
+										  .DACBlock_Digital_Datapath[Index]
+										  .Mixer_Settings;
+						}
+						MixerConfigPtr->Freq = SettingsPtr->Mixer_Settings.Freq;
+						MixerConfigPtr->PhaseOffset = SettingsPtr->Mixer_Settings.PhaseOffset;
+						MixerConfigPtr->EventSource = SettingsPtr->EventSource;
+					}
+					UpdateTile = 1U;
+				}
+
+				if ((SettingsPtr->Flags & XRFDC_BULK_QMC) != 0U) {
+					Status = XRFdc_SetQMCSettings(InstancePtr, Type, Tile_Id, SettingsPtr->Block_Id,
+								      &SettingsPtr->QMC_Settings);
+					if (Status != XRFDC_SUCCESS) {
+						goto RETURN_PATH;
+					}
+					UpdateTile = 1U;
+				}
+			}
+
+			/* One update event for all the blocks of the tile */
+			if ((UpdateTile != 0U) && (BulkSettingsPtr->EventSource == XRFDC_EVNT_SRC_TILE)) {
+				BaseAddr = XRFDC_DRP_BASE(Type, Tile_Id) + XRFDC_HSCOM_ADDR;
+				XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_HSCOM_UPDT_DYN_OFFSET, 0x1);
+			}
+		}
+	}
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This API prepares a frequency hopping table for a block. The NCO register
+* values of all the hops, the block addresses and the update event writes
+* are computed once, so that XRFdc_Hop() switches frequency with register
+* writes only. The NCO update event source of the block is set to
+* EventSource.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
+* @param    Tile_Id Valid values are 0-3.
+* @param    Block_Id is ADC/DAC block number inside the tile. Valid values
+*           are 0-3.
+* @param    FreqPtr is the array of NumHops mixer frequencies in MHz. It is
+*           used by XRFdc_Hop() and must be kept as long as the table.
+* @param    PhaseOffset is the NCO phase offset of all the hops in degrees.
+* @param    NumHops is the number of hops.
+* @param    EventSource is the NCO update event source. XRFdc_Hop()
+*           triggers the XRFDC_EVNT_SRC_IMMEDIATE, XRFDC_EVNT_SRC_SLICE and
+*           XRFDC_EVNT_SRC_TILE events. The XRFDC_EVNT_SRC_SYSREF,
+*           XRFDC_EVNT_SRC_PL and XRFDC_EVNT_SRC_MARKER events are issued
+*           external to the driver.
+* @param    HopsPtr is the caller storage for the NumHops hop entries.
+* @param    HopTablePtr is the hop table to prepare.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     The mixer must be set up in fine mode with
+*           XRFdc_SetMixerSettings() before the table is prepared, and the
+*           table must be prepared again after a call to
+*           XRFdc_SetMixerSettings() or a change of the sampling rate, the
+*           Nyquist zone or the calibration mode of the block.
+*
+******************************************************************************/
+u32 XRFdc_PrepareHopTable(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, double *FreqPtr,
+			  double PhaseOffset, u32 NumHops, u32 EventSource, XRFdc_Hop_Entry *HopsPtr,
+			  XRFdc_Hop_Table *HopTablePtr)
+{
+	u32 Status;
+	u32 Hop;
+	u32 Index;
+	u32 NoOfBlocks;
+	u32 Slice;
+	u32 BaseAddr;
+	u32 Offset;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(FreqPtr != NULL);
+	Xil_AssertNonvoid(HopsPtr != NULL);
+	Xil_AssertNonvoid(HopTablePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	Status = XRFdc_CheckDigitalPathEnabled(InstancePtr, Type, Tile_Id, Block_Id);
+	if (Status != XRFDC_SUCCESS) {
+		metal_log(METAL_LOG_ERROR, "\n Requested block not available in %s\r\n", __func__);
+		goto RETURN_PATH;
+	}
+
+	if ((EventSource > XRFDC_EVNT_SRC_PL) ||
+	    ((EventSource == XRFDC_EVNT_SRC_MARKER) && (Type == XRFDC_ADC_TILE))) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid event source selection in %s\r\n", __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	if ((PhaseOffset >= XRFDC_MIXER_PHASE_OFFSET_UP_LIMIT) || (PhaseOffset <= XRFDC_MIXER_PHASE_OFFSET_LOW_LIMIT)) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid phase offset value in %s\r\n", __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	for (Hop = 0U; Hop < NumHops; Hop++) {
+		Status = XRFdc_GetBlockNCORegs(InstancePtr, Type, Tile_Id, Block_Id, FreqPtr[Hop], PhaseOffset,
+					       HopsPtr[Hop].NCORegs);
+		if (Status != XRFDC_SUCCESS) {
+			goto RETURN_PATH;
+		}
+	}
+
+	HopTablePtr->Type = Type;
+	HopTablePtr->Tile_Id = Tile_Id;
+	HopTablePtr->Block_Id = Block_Id;
+	HopTablePtr->EventSource = EventSource;
+	HopTablePtr->NumHops = NumHops;
+	HopTablePtr->FreqPtr = FreqPtr;
+	HopTablePtr->PhaseOffset = PhaseOffset;
+	HopTablePtr->HopsPtr = HopsPtr;
+	HopTablePtr->NumSlices = 0U;
+	HopTablePtr->NumUpdates = 0U;
+
+	Offset = (Type == XRFDC_ADC_TILE) ? XRFDC_ADC_UPDATE_DYN_OFFSET : XRFDC_DAC_UPDATE_DYN_OFFSET;
+	XRFdc_GetBlockRange(InstancePtr, Type, Tile_Id, Block_Id, &Index, &NoOfBlocks);
+	for (; Index < NoOfBlocks; Index++) {
+		Slice = HopTablePtr->NumSlices;
+		BaseAddr = XRFDC_BLOCK_BASE(Type, Tile_Id, Index);
+		HopTablePtr->SliceAddr[Slice] = BaseAddr;
+		HopTablePtr->SliceIndex[Slice] = Index;
+		HopTablePtr->NumSlices++;
+
+		XRFdc_ClrSetReg(InstancePtr, BaseAddr, XRFDC_NCO_UPDT_OFFSET, XRFDC_NCO_UPDT_MODE_MASK, EventSource);
+
+		if (EventSource == XRFDC_EVNT_SRC_IMMEDIATE) {
+			HopTablePtr->UpdtAddr[Slice] = BaseAddr;
+			HopTablePtr->UpdtOffset[Slice] = Offset;
+			HopTablePtr->UpdtValue[Slice] =
+				(XRFdc_ReadReg16(InstancePtr, BaseAddr, Offset) & ~XRFDC_UPDT_EVNT_MASK) |
+				XRFDC_UPDT_EVNT_NCO_MASK;
+			HopTablePtr->NumUpdates++;
+		} else if (EventSource == XRFDC_EVNT_SRC_SLICE) {
+			HopTablePtr->UpdtAddr[Slice] = BaseAddr;
+			HopTablePtr->UpdtOffset[Slice] = Offset;
+			HopTablePtr->UpdtValue[Slice] = 0x1U;
+			HopTablePtr->NumUpdates++;
+		}
+	}
+
+	/* One update event for the tile */
+	if (EventSource == XRFDC_EVNT_SRC_TILE) {
+		HopTablePtr->UpdtAddr[0] = XRFDC_DRP_BASE(Type, Tile_Id) + XRFDC_HSCOM_ADDR;
+		HopTablePtr->UpdtOffset[0] = XRFDC_HSCOM_UPDT_DYN_OFFSET;
+		HopTablePtr->UpdtValue[0] = 0x1U;
+		HopTablePtr->NumUpdates = 1U;
+	}
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This API switches a block to a hop of a table prepared by
+* XRFdc_PrepareHopTable(). The NCO frequency and phase offset registers are
+* written and, unless the update event is issued external to the driver,
+* the update event is triggered. No register is read.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    HopTablePtr is the hop table.
+* @param    Hop is the index of the hop in the table.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if Hop is not in the table.
+*
+* @note     With the XRFDC_EVNT_SRC_SYSREF, XRFDC_EVNT_SRC_PL and
+*           XRFDC_EVNT_SRC_MARKER event sources the new frequency takes
+*           effect on the next external event.
+*
+******************************************************************************/
+u32 XRFdc_Hop(XRFdc *InstancePtr, XRFdc_Hop_Table *HopTablePtr, u32 Hop)
+{
+	u32 Status;
+	u32 Slice;
+	u16 *NCORegsPtr;
+	XRFdc_Mixer_Settings *MixerConfigPtr;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(HopTablePtr != NULL);
+
+	if (Hop >= HopTablePtr->NumHops) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid hop %u in %s\r\n", Hop, __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	NCORegsPtr = HopTablePtr->HopsPtr[Hop].NCORegs;
+	for (Slice = 0U; Slice < HopTablePtr->NumSlices; Slice++) {
+		XRFdc_WriteNCORegs(InstancePtr, HopTablePtr->SliceAddr[Slice], NCORegsPtr);
+	}
+	for (Slice = 0U; Slice < HopTablePtr->NumUpdates; Slice++) {
+		XRFdc_WriteReg16(InstancePtr, HopTablePtr->UpdtAddr[Slice], HopTablePtr->UpdtOffset[Slice],
+				 HopTablePtr->UpdtValue[Slice]);
+	}
+
+	/* Update the instance with new values */
+	for (Slice = 0U; Slice < HopTablePtr->NumSlices; Slice++) {
+		if (HopTablePtr->Type == XRFDC_ADC_TILE) {
+			MixerConfigPtr = &InstancePtr->ADC_Tile[HopTablePtr->Tile_Id]
+						  .ADCBlock_Digital_Datapath[HopTablePtr->SliceIndex[Slice]]
+						  .Mixer_Settings;
+		} else {
+			MixerConfigPtr = &InstancePtr->DAC_Tile[HopTablePtr->Tile_Id]
+						  .DACBlock_Digital_Datapath[HopTablePtr->SliceIndex[Slice]]
+						  .Mixer_Settings;
+		}
+		MixerConfigPtr->Freq = HopTablePtr->FreqPtr[Hop];
+		MixerConfigPtr->PhaseOffset = HopTablePtr->PhaseOffset;
+		MixerConfigPtr->EventSource = HopTablePtr->EventSource;
+	}
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
 /** @} */
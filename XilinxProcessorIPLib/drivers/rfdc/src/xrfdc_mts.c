@@ -53,6 +53,8 @@
 * 6.0   cog    02/17/19 Added XRFdc_GetMTSEnable API.
 * 7.0   cog    05/13/19 Formatting changes.
 *       cog    08/02/19 Formatting changes.
+*       cog    10/14/19 The tiles of a group are scanned together, added the
+*                       XRFDC_MTS_SCAN_VERIFY warm start scan mode.
 *
 * </pre>
 *
@@ -74,9 +76,9 @@ static void XRFdc_MTS_Sysref_Ctrl(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32
 				  u32 Enable_Div_Reset);
 static u32 XRFdc_MTS_Sysref_Dist(XRFdc *InstancePtr, int Num_DAC);
 static u32 XRFdc_MTS_Sysref_Count(XRFdc *InstancePtr, u32 Type, u32 Count_Val);
-static u32 XRFdc_MTS_Dtc_Scan(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, XRFdc_MTS_DTC_Settings *SettingsPtr);
-static u32 XRFdc_MTS_Dtc_Code(XRFdc *InstancePtr, u32 Type, u32 BaseAddr, u32 SRCtrlAddr, u32 DTCAddr, u16 SRctl,
-			      u16 SRclr_m, u32 Code);
+static u32 XRFdc_MTS_Dtc_Scan(XRFdc *InstancePtr, u32 Type, u32 Tiles, XRFdc_MTS_DTC_Settings *SettingsPtr);
+static void XRFdc_MTS_Dtc_Code(XRFdc *InstancePtr, u32 BaseAddr, u32 SRCtrlAddr, u32 DTCAddr, u16 SRctl, u16 SRclr_m,
+			       u32 Code);
 static u32 XRFdc_MTS_Dtc_Calc(u32 Type, u32 Tile_Id, XRFdc_MTS_DTC_Settings *SettingsPtr, u8 *FlagsPtr);
 static void XRFdc_MTS_Dtc_Flag_Debug(u8 *FlagsPtr, u32 Type, u32 Tile_Id, u32 Target, u32 Picked);
 static void XRFdc_MTS_FIFOCtrl(XRFdc *InstancePtr, u32 Type, u32 FIFO_Mode, u32 Tiles_To_Clear);
@@ -475,12 +477,12 @@ static u32 XRFdc_MTS_Dtc_Calc(u32 Type, u32 Tile_Id, XRFdc_MTS_DTC_Settings *Set
 /*****************************************************************************/
 /**
 *
-* This API Set a DTC code and wait for it to be updated. Return early/late
-* flags, if set
+* This API Set a DTC code and restart the sysref capture. The caller waits
+* for the code to be updated with XRFdc_MTS_Sysref_Count(), the wait is
+* shared by all the tiles of a scan.
 *
 *
 * @param    InstancePtr is a pointer to the XRfdc instance.
-* @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
 * @param    BaseAddr is for internal usage.
 * @param    SRCtrlAddr is for internal usage.
 * @param    DTCAddr is for internal usage.
@@ -488,18 +490,12 @@ static u32 XRFdc_MTS_Dtc_Calc(u32 Type, u32 Tile_Id, XRFdc_MTS_DTC_Settings *Set
 * @param    SRclr_m is for internal usage.
 * @param    Code is for internal usage.
 *
-* @return
-* 		- XRFDC_MTS_OK if successful.
-*           - XRFDC_MTS_TIMEOUT if timeout occurs.
-*
 * @note     None.
 *
 ******************************************************************************/
-static u32 XRFdc_MTS_Dtc_Code(XRFdc *InstancePtr, u32 Type, u32 BaseAddr, u32 SRCtrlAddr, u32 DTCAddr, u16 SRctl,
-			      u16 SRclr_m, u32 Code)
+static void XRFdc_MTS_Dtc_Code(XRFdc *InstancePtr, u32 BaseAddr, u32 SRCtrlAddr, u32 DTCAddr, u16 SRctl, u16 SRclr_m,
+			       u32 Code)
 {
-	u32 Status;
-
 	/* set the DTC code */
 	XRFdc_WriteReg16(InstancePtr, BaseAddr, DTCAddr, Code);
 
@@ -508,22 +504,24 @@ static u32 XRFdc_MTS_Dtc_Code(XRFdc *InstancePtr, u32 Type, u32 BaseAddr, u32 SR
 
 	/* unset sysref cap clear */
 	XRFdc_WriteReg16(InstancePtr, BaseAddr, SRCtrlAddr, SRctl);
-
-	Status = XRFdc_MTS_Sysref_Count(InstancePtr, Type, XRFDC_MTS_DTC_COUNT);
-
-	return Status;
 }
 
 /*****************************************************************************/
 /**
 *
 * This API Scan the DTC codes and determine the optimal capture code for
-* both PLL and T1 cases
+* both PLL and T1 cases. The tiles of the group are scanned together, each
+* DTC code is set on all the tiles before waiting for the sysref captures.
+*
+* In XRFDC_MTS_SCAN_VERIFY mode the codes of the previous sync are checked
+* first: the codes around each one are set and, if no early/late flag is
+* raised, the code is kept. Only the tiles that fail the check run the full
+* scan, as a reload scan targeting their previous codes.
 *
 *
 * @param    InstancePtr is a pointer to the XRfdc instance.
 * @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
-* @param    Tile_Id Valid values are 0-3.
+* @param    Tiles is the mask of the tiles to scan.
 * @param    SettingsPtr dtc settings structure.
 *
 * @return
@@ -533,59 +531,164 @@ static u32 XRFdc_MTS_Dtc_Code(XRFdc *InstancePtr, u32 Type, u32 BaseAddr, u32 SR
 * @note     None.
 *
 ******************************************************************************/
-static u32 XRFdc_MTS_Dtc_Scan(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, XRFdc_MTS_DTC_Settings *SettingsPtr)
+static u32 XRFdc_MTS_Dtc_Scan(XRFdc *InstancePtr, u32 Type, u32 Tiles, XRFdc_MTS_DTC_Settings *SettingsPtr)
 {
 	u32 Status;
-	u32 BaseAddr;
+	u32 BaseAddr[4];
 	u32 SRCtrlAddr;
 	u32 DTCAddr;
-	u8 Flags[XRFDC_MTS_NUM_DTC + 1];
-	u16 SRctl;
+	u8 Flags[4][XRFDC_MTS_NUM_DTC + 1];
+	u16 SRctl[4];
 	u16 SRclr_m;
 	u16 Flag_s;
 	u32 Index;
+	u32 Tile_Id;
+	u32 ScanTiles;
+	u32 Verify;
+	int Scan_Mode;
+	int Half_Gap;
+	int Offset;
+	int Code;
 
-	BaseAddr = XRFDC_DRP_BASE(Type, Tile_Id) + XRFDC_HSCOM_ADDR;
 	Status = XRFDC_MTS_OK;
+	Scan_Mode = SettingsPtr->Scan_Mode;
+	Verify = (Scan_Mode == XRFDC_MTS_SCAN_VERIFY) ? 1U : 0U;
 
-	/*  Enable SysRef Capture and Disable Divide Reset */
-	XRFdc_MTS_Sysref_Ctrl(InstancePtr, Type, Tile_Id, SettingsPtr->IsPLL, 1, 0);
 	SRCtrlAddr = (SettingsPtr->IsPLL != 0U) ? XRFDC_MTS_SRCAP_PLL : XRFDC_MTS_SRCAP_T1;
 	DTCAddr = (SettingsPtr->IsPLL != 0U) ? XRFDC_MTS_SRDTC_PLL : XRFDC_MTS_SRDTC_T1;
 	SRclr_m = (SettingsPtr->IsPLL != 0U) ? XRFDC_MTS_SRCLR_PLL_M : XRFDC_MTS_SRCLR_T1_M;
 	Flag_s = (SettingsPtr->IsPLL != 0U) ? XRFDC_MTS_SRFLAG_PLL : XRFDC_MTS_SRFLAG_T1;
 
-	SRctl = XRFdc_ReadReg16(InstancePtr, BaseAddr, SRCtrlAddr) & ~SRclr_m;
-
-	for (Index = 0U; Index < XRFDC_MTS_NUM_DTC; Index++) {
-		Flags[Index] = 0U;
+	for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+		if ((Tiles & (1U << Tile_Id)) != 0U) {
+			BaseAddr[Tile_Id] = XRFDC_DRP_BASE(Type, Tile_Id) + XRFDC_HSCOM_ADDR;
+			/*  Enable SysRef Capture and Disable Divide Reset */
+			XRFdc_MTS_Sysref_Ctrl(InstancePtr, Type, Tile_Id, SettingsPtr->IsPLL, 1, 0);
+			SRctl[Tile_Id] = XRFdc_ReadReg16(InstancePtr, BaseAddr[Tile_Id], SRCtrlAddr) & ~SRclr_m;
+			for (Index = 0U; Index < XRFDC_MTS_NUM_DTC; Index++) {
+				Flags[Tile_Id][Index] = 0U;
+			}
+			/* Verify needs the codes of a previous sync */
+			if (SettingsPtr->DTC_Code[Tile_Id] == -1) {
+				Verify = 0U;
+			}
+		}
 	}
-	for (Index = 0U; (Index < XRFDC_MTS_NUM_DTC) && (Status == XRFDC_MTS_OK); Index++) {
-		Status |= XRFdc_MTS_Dtc_Code(InstancePtr, Type, BaseAddr, SRCtrlAddr, DTCAddr, SRctl, SRclr_m, Index);
-		Flags[Index] = (XRFdc_ReadReg16(InstancePtr, BaseAddr, XRFDC_MTS_SRFLAG) >> Flag_s) & 0x3U;
+
+	ScanTiles = Tiles;
+	if (Verify != 0U) {
+		/* The codes were picked in the middle of a window of at least the minimum gap */
+		Half_Gap = (int)((SettingsPtr->IsPLL != 0U) ? XRFDC_MTS_MIN_GAP_PLL : XRFDC_MTS_MIN_GAP_T1) / 2;
+		ScanTiles = 0U;
+		for (Offset = -Half_Gap; (Offset <= Half_Gap) && (Status == XRFDC_MTS_OK); Offset++) {
+			for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+				if ((Tiles & (1U << Tile_Id)) != 0U) {
+					Code = SettingsPtr->DTC_Code[Tile_Id] + Offset;
+					Code = (Code < 0) ? 0 : Code;
+					Code = (Code >= (int)XRFDC_MTS_NUM_DTC) ? ((int)XRFDC_MTS_NUM_DTC - 1) : Code;
+					XRFdc_MTS_Dtc_Code(InstancePtr, BaseAddr[Tile_Id], SRCtrlAddr, DTCAddr,
+							   SRctl[Tile_Id], SRclr_m, Code);
+				}
+			}
+			Status |= XRFdc_MTS_Sysref_Count(InstancePtr, Type, XRFDC_MTS_DTC_COUNT);
+			for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+				if (((Tiles & (1U << Tile_Id)) != 0U) &&
+				    (((XRFdc_ReadReg16(InstancePtr, BaseAddr[Tile_Id], XRFDC_MTS_SRFLAG) >> Flag_s) &
+				      0x3U) != 0U)) {
+					ScanTiles |= (1U << Tile_Id);
+				}
+			}
+		}
+		if (Status != XRFDC_MTS_OK) {
+			ScanTiles = Tiles;
+		}
+		for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+			if ((Tiles & (1U << Tile_Id)) != 0U) {
+				metal_log(METAL_LOG_DEBUG, "Tile (%d): DTC Code %d %s\n", Tile_Id,
+					  SettingsPtr->DTC_Code[Tile_Id],
+					  ((ScanTiles & (1U << Tile_Id)) != 0U) ? "failed, rescan" : "verified");
+			}
+		}
+		/* Rescanned tiles keep their offset to the reference tile */
+		if (ScanTiles != 0U) {
+			for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+				if ((Tiles & (1U << Tile_Id)) != 0U) {
+					SettingsPtr->Target[Tile_Id] = SettingsPtr->DTC_Code[Tile_Id];
+				}
+			}
+		}
+		Status = XRFDC_MTS_OK;
+	} else if (Scan_Mode == XRFDC_MTS_SCAN_VERIFY) {
+		/* No previous codes, full initial scan */
+		for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+			SettingsPtr->DTC_Code[Tile_Id] = -1;
+		}
+		SettingsPtr->Scan_Mode = XRFDC_MTS_SCAN_INIT;
 	}
 
-	/* Calculate the best DTC code */
-	(void)XRFdc_MTS_Dtc_Calc(Type, Tile_Id, SettingsPtr, Flags);
+	if (ScanTiles != 0U) {
+		for (Index = 0U; (Index < XRFDC_MTS_NUM_DTC) && (Status == XRFDC_MTS_OK); Index++) {
+			for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+				if ((ScanTiles & (1U << Tile_Id)) != 0U) {
+					XRFdc_MTS_Dtc_Code(InstancePtr, BaseAddr[Tile_Id], SRCtrlAddr, DTCAddr,
+							   SRctl[Tile_Id], SRclr_m, Index);
+				}
+			}
+			Status |= XRFdc_MTS_Sysref_Count(InstancePtr, Type, XRFDC_MTS_DTC_COUNT);
+			for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+				if ((ScanTiles & (1U << Tile_Id)) != 0U) {
+					Flags[Tile_Id][Index] =
+						(XRFdc_ReadReg16(InstancePtr, BaseAddr[Tile_Id], XRFDC_MTS_SRFLAG) >>
+						 Flag_s) &
+						0x3U;
+				}
+			}
+		}
 
-	/* Program the calculated code */
-	if (SettingsPtr->DTC_Code[Tile_Id] == -1) {
-		metal_log(METAL_LOG_ERROR, "Unable to capture analog SysRef safely on %s tile %d\n",
-			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id);
-		Status |= XRFDC_MTS_DTC_INVALID;
-	} else {
-		(void)XRFdc_MTS_Dtc_Code(InstancePtr, Type, BaseAddr, SRCtrlAddr, DTCAddr, SRctl, SRclr_m,
-					 SettingsPtr->DTC_Code[Tile_Id]);
+		/* Calculate the best DTC codes, in tile order as for a sequential scan */
+		for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+			if ((ScanTiles & (1U << Tile_Id)) != 0U) {
+				(void)XRFdc_MTS_Dtc_Calc(Type, Tile_Id, SettingsPtr, Flags[Tile_Id]);
+			}
+		}
+	}
+	SettingsPtr->Scan_Mode = Scan_Mode;
+
+	/* Program the calculated codes */
+	for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+		if ((Tiles & (1U << Tile_Id)) != 0U) {
+			if (SettingsPtr->DTC_Code[Tile_Id] == -1) {
+				metal_log(METAL_LOG_ERROR, "Unable to capture analog SysRef safely on %s tile %d\n",
+					  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id);
+				Status |= XRFDC_MTS_DTC_INVALID;
+			} else {
+				XRFdc_MTS_Dtc_Code(InstancePtr, BaseAddr[Tile_Id], SRCtrlAddr, DTCAddr, SRctl[Tile_Id],
+						   SRclr_m, SettingsPtr->DTC_Code[Tile_Id]);
+			}
+		}
 	}
+	(void)XRFdc_MTS_Sysref_Count(InstancePtr, Type, XRFDC_MTS_DTC_COUNT);
 
 	if (SettingsPtr->IsPLL != 0U) {
 		/* PLL - Disable SysRef Capture */
-		XRFdc_MTS_Sysref_Ctrl(InstancePtr, Type, Tile_Id, 1, 0, 0);
+		for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+			if ((Tiles & (1U << Tile_Id)) != 0U) {
+				XRFdc_MTS_Sysref_Ctrl(InstancePtr, Type, Tile_Id, 1, 0, 0);
+			}
+		}
 	} else {
 		/* T1 - Reset Dividers */
-		XRFdc_MTS_Sysref_Ctrl(InstancePtr, Type, Tile_Id, 0, 1, 1);
+		for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+			if ((Tiles & (1U << Tile_Id)) != 0U) {
+				XRFdc_MTS_Sysref_Ctrl(InstancePtr, Type, Tile_Id, 0, 1, 1);
+			}
+		}
 		Status |= XRFdc_MTS_Sysref_Count(InstancePtr, Type, XRFDC_MTS_DTC_COUNT);
-		XRFdc_MTS_Sysref_Ctrl(InstancePtr, Type, Tile_Id, 0, 1, 0);
+		for (Tile_Id = XRFDC_TILE_ID0; Tile_Id < XRFDC_TILE_ID4; Tile_Id++) {
+			if ((Tiles & (1U << Tile_Id)) != 0U) {
+				XRFdc_MTS_Sysref_Ctrl(InstancePtr, Type, Tile_Id, 0, 1, 0);
+			}
+		}
 	}
 
 	return Status;
@@ -1067,7 +1170,11 @@ void XRFdc_MultiConverter_Init(XRFdc_MultiConverter_Sync_Config *ConfigPtr, int
 * 		- XRFDC_MTS_MARKER_MISM
 * 		- XRFDC_MTS_NOT_SUPPORTED if MTS is not supported.
 *
-* @note     None.
+* @note     After a first sync, DTC_Set_PLL.Scan_Mode and DTC_Set_T1.Scan_Mode
+*           can be set to XRFDC_MTS_SCAN_VERIFY so that the following syncs,
+*           e.g. after a retune, check the DTC codes kept in ConfigPtr
+*           instead of running the full scan. The marker latencies are
+*           always measured again.
 *
 ******************************************************************************/
 u32 XRFdc_MultiConverter_Sync(XRFdc *InstancePtr, u32 Type, XRFdc_MultiConverter_Sync_Config *ConfigPtr)
@@ -1080,6 +1187,7 @@ u32 XRFdc_MultiConverter_Sync(XRFdc *InstancePtr, u32 Type, XRFdc_MultiConverter
 	u32 BaseAddr;
 	u32 TileState;
 	u32 BlockStatus;
+	u32 PLL_Tiles;
 
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(ConfigPtr != NULL);
@@ -1128,32 +1236,30 @@ u32 XRFdc_MultiConverter_Sync(XRFdc *InstancePtr, u32 Type, XRFdc_MultiConverter
 	/* Update distribution */
 	Status |= XRFdc_MTS_Sysref_Dist(InstancePtr, -1);
 
-	/* Scan DTCs for each tile */
+	/* Find the tiles using the PLL */
+	PLL_Tiles = 0U;
 	for (Index = XRFDC_TILE_ID0; Index < XRFDC_TILE_ID4; Index++) {
 		if ((ConfigPtr->Tiles & (1U << Index)) != 0U) {
-			/* Run DTC Scan for T1/PLL */
 			BaseAddr = XRFDC_DRP_BASE(Type, Index) + XRFDC_HSCOM_ADDR;
 			RegData = XRFdc_ReadReg16(InstancePtr, BaseAddr, XRFDC_MTS_CLKSTAT);
 			if ((RegData & XRFDC_MTS_PLLEN_M) != 0U) {
-				/* DTC Scan PLL */
-				if (Index == 0U) {
-					metal_log(METAL_LOG_INFO, "\nDTC Scan PLL\n", 0);
-				}
-				ConfigPtr->DTC_Set_PLL.RefTile = ConfigPtr->RefTile;
-				Status |= XRFdc_MTS_Dtc_Scan(InstancePtr, Type, Index, &ConfigPtr->DTC_Set_PLL);
+				PLL_Tiles |= (1U << Index);
 			}
 		}
 	}
 
-	/* Scan DTCs for each tile T1 */
-	metal_log(METAL_LOG_INFO, "\nDTC Scan T1\n", 0);
-	for (Index = XRFDC_TILE_ID0; Index < XRFDC_TILE_ID4; Index++) {
-		if ((ConfigPtr->Tiles & (1U << Index)) != 0U) {
-			ConfigPtr->DTC_Set_T1.RefTile = ConfigPtr->RefTile;
-			Status |= XRFdc_MTS_Dtc_Scan(InstancePtr, Type, Index, &ConfigPtr->DTC_Set_T1);
-		}
+	/* Scan DTCs for the PLL tiles */
+	if (PLL_Tiles != 0U) {
+		metal_log(METAL_LOG_INFO, "\nDTC Scan PLL\n", 0);
+		ConfigPtr->DTC_Set_PLL.RefTile = ConfigPtr->RefTile;
+		Status |= XRFdc_MTS_Dtc_Scan(InstancePtr, Type, PLL_Tiles, &ConfigPtr->DTC_Set_PLL);
 	}
 
+	/* Scan DTCs for the tiles T1 */
+	metal_log(METAL_LOG_INFO, "\nDTC Scan T1\n", 0);
+	ConfigPtr->DTC_Set_T1.RefTile = ConfigPtr->RefTile;
+	Status |= XRFdc_MTS_Dtc_Scan(InstancePtr, Type, ConfigPtr->Tiles, &ConfigPtr->DTC_Set_T1);
+
 	/* Enable FIFOs */
 	XRFdc_MTS_FIFOCtrl(InstancePtr, Type, XRFDC_MTS_FIFO_ENABLE, ConfigPtr->Tiles);
 
@@ -50,6 +50,7 @@
 *                       optimization.
 * 6.0   cog    02/17/19 Added XRFdc_GetMTSEnable API.
 * 7.0   cog    05/13/19 Formatting changes.
+*       cog    10/14/19 Added XRFDC_MTS_SCAN_VERIFY scan mode.
 *
 * </pre>
 *
@@ -116,6 +117,7 @@ typedef struct {
 #define XRFDC_MTS_MARKER_COUNT 4U
 #define XRFDC_MTS_SCAN_INIT 0U
 #define XRFDC_MTS_SCAN_RELOAD 1U
+#define XRFDC_MTS_SCAN_VERIFY 2U
 #define XRFDC_MTS_SRCOUNT_TIMEOUT 1000U
 #define XRFDC_MTS_DELAY_MAX 31U
 #define XRFDC_MTS_CHECK_ALL_FIFOS 0U
@@ -241,6 +241,21 @@ typedef struct
 				 Vector table of interrupt handlers */
 } XScuGic_Config;
 
+#ifdef XSCUGIC_INTR_STATS
+/**
+ * Per interrupt statistics, updated by XScuGic_FastInterruptHandler() and
+ * XScuGic_NestedInterruptHandler() when XSCUGIC_INTR_STATS is defined. Times
+ * are in PMU cycle counter ticks, from the acknowledge of the interrupt to its
+ * end of interrupt, so they include the time spent in nested handlers.
+ */
+typedef struct
+{
+	u32 Count;		/**< Number of times the interrupt was serviced */
+	u32 MaxCycles;		/**< Longest service time */
+	u64 TotalCycles;	/**< Sum of the service times */
+} XScuGic_IntrStats;
+#endif
+
 /**
  * The XScuGic driver instance data. The user is required to allocate a
  * variable of this type for every intc device in the system. A pointer
@@ -251,6 +266,10 @@ typedef struct
 	XScuGic_Config *Config;  /**< Configuration table entry */
 	u32 IsReady;		 /**< Device is initialized and ready */
 	u32 UnhandledInterrupts; /**< Intc Statistics */
+#ifdef XSCUGIC_INTR_STATS
+	XScuGic_IntrStats IntrStats[XSCUGIC_MAX_NUM_INTR_INPUTS]; /**<
+				 Per interrupt statistics */
+#endif
 } XScuGic;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -590,6 +609,13 @@ XScuGic_Config *XScuGic_LookupConfig(u16 DeviceId);
  * Interrupt functions in xscugic_intr.c
  */
 void XScuGic_InterruptHandler(XScuGic *InstancePtr);
+void XScuGic_FastInterruptHandler(XScuGic *InstancePtr);
+void XScuGic_NestedInterruptHandler(XScuGic *InstancePtr);
+#ifdef XSCUGIC_INTR_STATS
+void XScuGic_GetIntrStats(XScuGic *InstancePtr, u32 Int_Id,
+			  XScuGic_IntrStats *StatsPtr);
+void XScuGic_ResetIntrStats(XScuGic *InstancePtr);
+#endif
 
 /*
  * Self-test functions in xscugic_selftest.c
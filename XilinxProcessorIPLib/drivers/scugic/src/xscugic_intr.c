@@ -79,15 +79,42 @@
 #include "xil_types.h"
 #include "xil_assert.h"
 #include "xscugic.h"
+#ifdef XSCUGIC_INTR_STATS
+#include "xpseudo_asm.h"
+#endif
 
 /************************** Constant Definitions *****************************/
 
+/*
+ * Nesting is supported where the vector code or the BSP lets a handler run
+ * with interrupts enabled without corrupting the interrupted context: on
+ * AArch64, whose IRQ vector saves ELR and SPSR on the stack, and on Cortex-A9
+ * and Cortex-R5, through Xil_EnableNestedInterrupts().
+ */
+#if defined (__aarch64__) || \
+	(defined (__GNUC__) && !defined (ARMA53_32))
+#define XSCUGIC_NESTING_SUPPORTED
+#endif
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
+#ifdef XSCUGIC_INTR_STATS
+#if defined (__aarch64__)
+#define XScuGic_CycleCount()	((u32)mfcp(PMCCNTR_EL0))
+#else
+#define XScuGic_CycleCount()	((u32)mfcp(XREG_CP15_PERF_CYCLE_COUNTER))
+#endif
+#endif
+
 /************************** Function Prototypes ******************************/
 
+#if defined (XSCUGIC_NESTING_SUPPORTED) && !defined (__aarch64__)
+static void XScuGic_CallNested(XScuGic_VectorTableEntry *TablePtr)
+	__attribute__((noinline));
+#endif
+
 /************************** Variable Definitions *****************************/
 
 /*****************************************************************************/
@@ -180,4 +207,230 @@ IntrExit:
 	     * could happen here.
 	     */
 }
+
+#if defined (XSCUGIC_NESTING_SUPPORTED) && !defined (__aarch64__)
+/*****************************************************************************/
+/**
+* Call an interrupt handler in system mode with interrupts enabled, so that
+* the IRQ mode link register and SPSR of the interrupted context are not
+* overwritten by a nested interrupt. Kept out of line so that the mode and
+* stack switch of Xil_EnableNestedInterrupts() only encloses the call.
+*
+* @param	TablePtr is the vector table entry of the interrupt.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XScuGic_CallNested(XScuGic_VectorTableEntry *TablePtr)
+{
+	Xil_EnableNestedInterrupts();
+	TablePtr->Handler(TablePtr->CallBackRef);
+	Xil_DisableNestedInterrupts();
+}
+#endif
+
+/*****************************************************************************/
+/**
+* Acknowledge the highest priority pending interrupt, call its handler from
+* the vector table and signal the end of interrupt.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	Nested is nonzero to run the handler with interrupts enabled.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static INLINE void XScuGic_Dispatch(XScuGic *InstancePtr, u32 Nested)
+{
+	XScuGic_VectorTableEntry *TablePtr;
+	u32 InterruptID;
+	u32 IntIDFull;
+#ifdef XSCUGIC_INTR_STATS
+	XScuGic_IntrStats *StatsPtr;
+	u32 Start;
+	u32 Cycles;
+
+	Start = XScuGic_CycleCount();
+#endif
+
+#if defined (GICv3)
+	InterruptID = XScuGic_get_IntID();
+	IntIDFull = InterruptID;
+#else
+	IntIDFull = XScuGic_CPUReadReg(InstancePtr, XSCUGIC_INT_ACK_OFFSET);
+	InterruptID = IntIDFull & XSCUGIC_ACK_INTID_MASK;
+#endif
+	if (XSCUGIC_MAX_NUM_INTR_INPUTS <= InterruptID) {
+		/*
+		 * Spurious interrupt, nothing was acknowledged so there is
+		 * no end of interrupt to signal.
+		 */
+		InstancePtr->UnhandledInterrupts++;
+		return;
+	}
+
+	TablePtr = &InstancePtr->Config->HandlerTable[InterruptID];
+#ifdef XSCUGIC_NESTING_SUPPORTED
+	if (Nested != 0U) {
+		/*
+		 * The CPU interface running priority is now the priority of
+		 * this interrupt, so only higher priority interrupts can
+		 * preempt the handler.
+		 */
+#if defined (__aarch64__)
+		Xil_ExceptionEnableMask(XIL_EXCEPTION_IRQ);
+		TablePtr->Handler(TablePtr->CallBackRef);
+		Xil_ExceptionDisableMask(XIL_EXCEPTION_IRQ);
+#else
+		XScuGic_CallNested(TablePtr);
+#endif
+	} else {
+		TablePtr->Handler(TablePtr->CallBackRef);
+	}
+#else
+	(void)Nested;
+	TablePtr->Handler(TablePtr->CallBackRef);
+#endif
+
+#if defined (GICv3)
+	XScuGic_ack_Int(IntIDFull);
+#else
+	XScuGic_CPUWriteReg(InstancePtr, XSCUGIC_EOI_OFFSET, IntIDFull);
+#endif
+
+#ifdef XSCUGIC_INTR_STATS
+	Cycles = XScuGic_CycleCount() - Start;
+	StatsPtr = &InstancePtr->IntrStats[InterruptID];
+	StatsPtr->Count++;
+	StatsPtr->TotalCycles += Cycles;
+	if (Cycles > StatsPtr->MaxCycles) {
+		StatsPtr->MaxCycles = Cycles;
+	}
+#endif
+}
+
+/*****************************************************************************/
+/**
+* This function is a shorter path interrupt handler for the driver. It is
+* connected in place of XScuGic_InterruptHandler() when the interrupt latency
+* matters: the vector table entry is indexed straight from the acknowledged
+* interrupt ID, the instance pointer is not checked and spurious interrupts
+* are dropped without writing the end of interrupt register.
+*
+* The handler runs with interrupts disabled. With XSCUGIC_INTR_STATS defined
+* the per interrupt statistics are updated, see XScuGic_GetIntrStats().
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+*
+* @return	None.
+*
+* @note		Every enabled interrupt must have a handler connected, the
+*		entries of the vector table are not checked.
+*
+******************************************************************************/
+void XScuGic_FastInterruptHandler(XScuGic *InstancePtr)
+{
+	XScuGic_Dispatch(InstancePtr, 0U);
+}
+
+/*****************************************************************************/
+/**
+* This function is the XScuGic_FastInterruptHandler() variant which lets
+* higher priority interrupts preempt the handler being executed. Once an
+* interrupt is acknowledged the GIC only signals interrupts of a higher
+* priority, in the sense of XScuGic_SetPriorityTriggerType(), so the
+* processor interrupts are re-enabled around the call to the handler and the
+* priorities alone decide which handlers nest.
+*
+* A latency critical interrupt is given a higher priority (a lower value)
+* than the others, for instance a control loop timer above the Ethernet and
+* DMA interrupts, and this handler is connected to the interrupt exception:
+*
+*	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+*		(Xil_ExceptionHandler)XScuGic_NestedInterruptHandler, &Gic);
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+*
+* @return	None.
+*
+* @note		The GIC does not signal an interrupt again while it is
+*		active, so the handlers need not clear their source before
+*		interrupts are re-enabled. Each nesting level uses the IRQ stack (and the
+*		system mode stack on Cortex-A9 and Cortex-R5), which must be
+*		sized for the number of priority levels in use. On AArch64 the
+*		floating point registers are saved lazily in a single area, so
+*		handlers which can be preempted must not use them. On Cortex-A53
+*		in 32 bit mode and with compilers other than GCC the handlers do
+*		not nest.
+*
+******************************************************************************/
+void XScuGic_NestedInterruptHandler(XScuGic *InstancePtr)
+{
+	XScuGic_Dispatch(InstancePtr, 1U);
+}
+
+#ifdef XSCUGIC_INTR_STATS
+/*****************************************************************************/
+/**
+* Get the statistics of an interrupt, gathered by
+* XScuGic_FastInterruptHandler() and XScuGic_NestedInterruptHandler().
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	Int_Id is the interrupt ID.
+* @param	StatsPtr is filled with the statistics.
+*
+* @return	None.
+*
+* @note		The times are PMU cycle counter ticks, the counter must be
+*		enabled by the application, e.g. with Xil_TraceInit().
+*
+******************************************************************************/
+void XScuGic_GetIntrStats(XScuGic *InstancePtr, u32 Int_Id,
+			  XScuGic_IntrStats *StatsPtr)
+{
+	u32 CurrMask;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	/* The 64 bit total is not updated atomically */
+	CurrMask = mfcpsr();
+	Xil_ExceptionDisable();
+	*StatsPtr = InstancePtr->IntrStats[Int_Id];
+	mtcpsr(CurrMask);
+}
+
+/*****************************************************************************/
+/**
+* Clear the statistics of all the interrupts.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XScuGic_ResetIntrStats(XScuGic *InstancePtr)
+{
+	u32 CurrMask;
+	u32 Int_Id;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	CurrMask = mfcpsr();
+	Xil_ExceptionDisable();
+	for (Int_Id = 0U; Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS; Int_Id++) {
+		InstancePtr->IntrStats[Int_Id].Count = 0U;
+		InstancePtr->IntrStats[Int_Id].MaxCycles = 0U;
+		InstancePtr->IntrStats[Int_Id].TotalCycles = 0U;
+	}
+	mtcpsr(CurrMask);
+}
+#endif
 /** @} */
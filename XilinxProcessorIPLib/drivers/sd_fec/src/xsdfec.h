@@ -55,6 +55,11 @@
  *
  * In addition, the driver provides set and get functions for all the individual registers defined for the SD-FEC.
  *
+ * \section sec_jobq Code Cache and Job Queue
+ * xsdfec_jobq.h precompiles LDPC codes once and keeps all of them resident on the devices, so that codes are switched
+ * block by block through the control packets. Its scheduler queues the control packets of the blocks and streams them
+ * to the least loaded of several SD-FEC devices, keeping per device throughput statistics.
+ *
  * \section sec_ex Example
  * The processor based example design output by the SD-FEC IP instance also includes an example application demonstrating a 
  * basic use case of the software driver.
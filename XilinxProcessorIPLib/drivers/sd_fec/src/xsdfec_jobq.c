@@ -0,0 +1,388 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "xsdfec_jobq.h"
+
+#define XSDFEC_TABLE_SC 0
+#define XSDFEC_TABLE_LA 1
+#define XSDFEC_TABLE_QC 2
+
+/************************** Local Functions *********************************/
+// Table of a code, its length in words and its size in allocation units
+static const u32* XSdFecCodeTable(const XSdFecLdpcParameters* ParamsPtr, u32 Table, u32* WordsPtr, u32* SizePtr) {
+  u32 Size[3];
+  XSdFecShareTableSize(ParamsPtr, &Size[XSDFEC_TABLE_SC], &Size[XSDFEC_TABLE_LA], &Size[XSDFEC_TABLE_QC]);
+  *SizePtr = Size[Table];
+  if (Table == XSDFEC_TABLE_SC) {
+    *WordsPtr = Size[XSDFEC_TABLE_SC];
+    return ParamsPtr->SCTable;
+  } else if (Table == XSDFEC_TABLE_LA) {
+    *WordsPtr = ParamsPtr->NLayers;
+    return ParamsPtr->LATable;
+  }
+  *WordsPtr = ParamsPtr->NQC;
+  return ParamsPtr->QCTable;
+}
+
+// Offset of a table, reusing the one of a cached code holding the same contents
+static int XSdFecCodeTableOffset(XSdFecCodeCache *CachePtr, const XSdFecLdpcParameters* ParamsPtr, u32 Table,
+                                 u32* OffsetPtr, u8* OwnsPtr) {
+  static const u32 Capacity[3] = { XSDFEC_SC_TABLE_SIZE, XSDFEC_LA_TABLE_SIZE, XSDFEC_QC_TABLE_SIZE };
+  static const u32 Lsb[3] = { XSDFEC_LDPC_CODE_REG3_SC_OFF_LSB, XSDFEC_LDPC_CODE_REG3_LA_OFF_LSB,
+                              XSDFEC_LDPC_CODE_REG3_QC_OFF_LSB };
+  static const u32 Mask[3] = { XSDFEC_LDPC_CODE_REG3_SC_OFF_MASK, XSDFEC_LDPC_CODE_REG3_LA_OFF_MASK,
+                               XSDFEC_LDPC_CODE_REG3_QC_OFF_MASK };
+  u32* NextPtr = (Table == XSDFEC_TABLE_SC) ? &CachePtr->SCNext :
+                 (Table == XSDFEC_TABLE_LA) ? &CachePtr->LANext : &CachePtr->QCNext;
+  u32 Words, Size;
+  const u32* Data = XSdFecCodeTable(ParamsPtr, Table, &Words, &Size);
+
+  for (u32 id = 0; id < XSDFEC_MAX_CODES; id++) {
+    const XSdFecCachedCode* Other = &CachePtr->Code[id];
+    u32 OtherWords, OtherSize;
+    if (Other->ParamsPtr == NULL || !Other->OwnsTable[Table]) {
+      continue;
+    }
+    const u32* OtherData = XSdFecCodeTable(Other->ParamsPtr, Table, &OtherWords, &OtherSize);
+    if (OtherWords == Words && (OtherData == Data || memcmp(OtherData, Data, Words * sizeof(u32)) == 0)) {
+      *OffsetPtr = (Other->Reg[3] & Mask[Table]) >> Lsb[Table];
+      *OwnsPtr   = 0;
+      return XST_SUCCESS;
+    }
+  }
+  if (*NextPtr + Size > Capacity[Table]) {
+    return XST_BUFFER_TOO_SMALL;
+  }
+  *OffsetPtr = *NextPtr;
+  *OwnsPtr   = 1;
+  return XST_SUCCESS;
+}
+
+static u32 XSdFecJobSize(XSdFecSched *SchedPtr, const XSdFecJob *JobPtr) {
+  if (JobPtr->Size != 0) {
+    return JobPtr->Size;
+  }
+  if (SchedPtr->CachePtr != NULL && JobPtr->CodeId < XSDFEC_MAX_CODES &&
+      SchedPtr->CachePtr->Code[JobPtr->CodeId].ParamsPtr != NULL) {
+    return SchedPtr->CachePtr->Code[JobPtr->CodeId].ParamsPtr->N;
+  }
+  return 0;
+}
+
+static u64 XSdFecSchedTime(XSdFecSched *SchedPtr) {
+  return (SchedPtr->TimeHandler != NULL) ? SchedPtr->TimeHandler() : 0;
+}
+
+/************************** Function Implementation *************************/
+void XSdFecCodeCacheInit(XSdFecCodeCache *CachePtr) {
+  Xil_AssertVoid(CachePtr != NULL);
+  memset(CachePtr, 0, sizeof(*CachePtr));
+}
+
+int XSdFecCodeCacheAdd(XSdFecCodeCache *CachePtr, u32 CodeId, const XSdFecLdpcParameters* ParamsPtr) {
+  Xil_AssertNonvoid(CachePtr  != NULL);
+  Xil_AssertNonvoid(ParamsPtr != NULL);
+  Xil_AssertNonvoid(CodeId < XSDFEC_MAX_CODES);
+
+  XSdFecCachedCode* Code = &CachePtr->Code[CodeId];
+  u32 Offset[3];
+  u8  Owns[3];
+  if (Code->ParamsPtr != NULL) {
+    return XST_DEVICE_BUSY;
+  }
+  for (u32 t = XSDFEC_TABLE_SC; t <= XSDFEC_TABLE_QC; t++) {
+    int Status = XSdFecCodeTableOffset(CachePtr, ParamsPtr, t, &Offset[t], &Owns[t]);
+    if (Status != XST_SUCCESS) {
+      return Status;
+    }
+  }
+
+  // Same packing as XSdFecAddLdpcParams()
+  Code->Reg[0]  = (XSDFEC_LDPC_CODE_REG0_N_MASK & (ParamsPtr->N << XSDFEC_LDPC_CODE_REG0_N_LSB));
+  Code->Reg[0] |= (XSDFEC_LDPC_CODE_REG0_K_MASK & (ParamsPtr->K << XSDFEC_LDPC_CODE_REG0_K_LSB));
+  Code->Reg[1]  = (XSDFEC_LDPC_CODE_REG1_PSIZE_MASK      & (ParamsPtr->PSize     << XSDFEC_LDPC_CODE_REG1_PSIZE_LSB));
+  Code->Reg[1] |= (XSDFEC_LDPC_CODE_REG1_NO_PACKING_MASK & (ParamsPtr->NoPacking << XSDFEC_LDPC_CODE_REG1_NO_PACKING_LSB));
+  Code->Reg[1] |= (XSDFEC_LDPC_CODE_REG1_NM_MASK         & (ParamsPtr->NM        << XSDFEC_LDPC_CODE_REG1_NM_LSB));
+  Code->Reg[2]  = (XSDFEC_LDPC_CODE_REG2_NLAYERS_MASK               & (ParamsPtr->NLayers       << XSDFEC_LDPC_CODE_REG2_NLAYERS_LSB));
+  Code->Reg[2] |= (XSDFEC_LDPC_CODE_REG2_NMQC_MASK                  & (ParamsPtr->NMQC          << XSDFEC_LDPC_CODE_REG2_NMQC_LSB));
+  Code->Reg[2] |= (XSDFEC_LDPC_CODE_REG2_NORM_TYPE_MASK             & (ParamsPtr->NormType      << XSDFEC_LDPC_CODE_REG2_NORM_TYPE_LSB));
+  Code->Reg[2] |= (XSDFEC_LDPC_CODE_REG2_SPECIAL_QC_MASK            & (ParamsPtr->SpecialQC     << XSDFEC_LDPC_CODE_REG2_SPECIAL_QC_LSB));
+  Code->Reg[2] |= (XSDFEC_LDPC_CODE_REG2_NO_FINAL_PARITY_CHECK_MASK & (ParamsPtr->NoFinalParity << XSDFEC_LDPC_CODE_REG2_NO_FINAL_PARITY_CHECK_LSB));
+  Code->Reg[2] |= (XSDFEC_LDPC_CODE_REG2_MAX_SCHEDULE_MASK          & (ParamsPtr->MaxSchedule   << XSDFEC_LDPC_CODE_REG2_MAX_SCHEDULE_LSB));
+  Code->Reg[3]  = (XSDFEC_LDPC_CODE_REG3_SC_OFF_MASK & (Offset[XSDFEC_TABLE_SC] << XSDFEC_LDPC_CODE_REG3_SC_OFF_LSB));
+  Code->Reg[3] |= (XSDFEC_LDPC_CODE_REG3_LA_OFF_MASK & (Offset[XSDFEC_TABLE_LA] << XSDFEC_LDPC_CODE_REG3_LA_OFF_LSB));
+  Code->Reg[3] |= (XSDFEC_LDPC_CODE_REG3_QC_OFF_MASK & (Offset[XSDFEC_TABLE_QC] << XSDFEC_LDPC_CODE_REG3_QC_OFF_LSB));
+
+  for (u32 t = XSDFEC_TABLE_SC; t <= XSDFEC_TABLE_QC; t++) {
+    Code->OwnsTable[t] = Owns[t];
+    if (Owns[t]) {
+      u32 Words, Size;
+      (void)XSdFecCodeTable(ParamsPtr, t, &Words, &Size);
+      if (t == XSDFEC_TABLE_SC) {
+        CachePtr->SCNext += Size;
+      } else if (t == XSDFEC_TABLE_LA) {
+        CachePtr->LANext += Size;
+      } else {
+        CachePtr->QCNext += Size;
+      }
+    }
+  }
+  Code->ParamsPtr = ParamsPtr;
+  return XST_SUCCESS;
+}
+
+void XSdFecCodeCacheSetTurbo(XSdFecCodeCache *CachePtr, const XSdFecTurboParameters* ParamsPtr) {
+  Xil_AssertVoid(CachePtr  != NULL);
+  Xil_AssertVoid(ParamsPtr != NULL);
+  CachePtr->TurboReg  = (XSDFEC_TURBO_ALG_MASK          & (ParamsPtr->Alg   << XSDFEC_TURBO_ALG_LSB));
+  CachePtr->TurboReg |= (XSDFEC_TURBO_SCALE_FACTOR_MASK & (ParamsPtr->Scale << XSDFEC_TURBO_SCALE_FACTOR_LSB));
+  CachePtr->TurboValid = 1;
+}
+
+int XSdFecCodeCacheLoadCode(XSdFecCodeCache *CachePtr, XSdFec *InstancePtr, u32 CodeId) {
+  Xil_AssertNonvoid(CachePtr    != NULL);
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->IsReady  == XIL_COMPONENT_IS_READY);
+  Xil_AssertNonvoid(InstancePtr->Standard == XSDFEC_STANDARD_OTHER);
+
+  if (CodeId >= XSDFEC_MAX_CODES || CachePtr->Code[CodeId].ParamsPtr == NULL) {
+    return XST_INVALID_PARAM;
+  }
+  const XSdFecCachedCode* Code = &CachePtr->Code[CodeId];
+  const XSdFecLdpcParameters* ParamsPtr = Code->ParamsPtr;
+  u32 SCOffset = (Code->Reg[3] & XSDFEC_LDPC_CODE_REG3_SC_OFF_MASK) >> XSDFEC_LDPC_CODE_REG3_SC_OFF_LSB;
+  u32 LAOffset = (Code->Reg[3] & XSDFEC_LDPC_CODE_REG3_LA_OFF_MASK) >> XSDFEC_LDPC_CODE_REG3_LA_OFF_LSB;
+  u32 QCOffset = (Code->Reg[3] & XSDFEC_LDPC_CODE_REG3_QC_OFF_MASK) >> XSDFEC_LDPC_CODE_REG3_QC_OFF_LSB;
+
+  XSdFecWrite_LDPC_CODE_REG0_Words(InstancePtr->BaseAddress, CodeId, &Code->Reg[0], 1);
+  XSdFecWrite_LDPC_CODE_REG1_Words(InstancePtr->BaseAddress, CodeId, &Code->Reg[1], 1);
+  XSdFecWrite_LDPC_CODE_REG2_Words(InstancePtr->BaseAddress, CodeId, &Code->Reg[2], 1);
+  XSdFecWrite_LDPC_CODE_REG3_Words(InstancePtr->BaseAddress, CodeId, &Code->Reg[3], 1);
+  // Shared tables are written by the code which allocated them only
+  if (Code->OwnsTable[XSDFEC_TABLE_SC]) {
+    XSdFecWrite_LDPC_SC_TABLE_Words(InstancePtr->BaseAddress, SCOffset, ParamsPtr->SCTable, (ParamsPtr->NLayers+3)>>2);
+  }
+  if (Code->OwnsTable[XSDFEC_TABLE_LA]) {
+    XSdFecWrite_LDPC_LA_TABLE_Words(InstancePtr->BaseAddress, LAOffset*4, ParamsPtr->LATable, ParamsPtr->NLayers);
+  }
+  if (Code->OwnsTable[XSDFEC_TABLE_QC]) {
+    XSdFecWrite_LDPC_QC_TABLE_Words(InstancePtr->BaseAddress, QCOffset*4, ParamsPtr->QCTable, ParamsPtr->NQC);
+  }
+  InstancePtr->SCOffset[CodeId] = SCOffset;
+  InstancePtr->LAOffset[CodeId] = LAOffset;
+  InstancePtr->QCOffset[CodeId] = QCOffset;
+  return XST_SUCCESS;
+}
+
+void XSdFecCodeCacheLoad(XSdFecCodeCache *CachePtr, XSdFec *InstancePtr) {
+  Xil_AssertVoid(CachePtr    != NULL);
+  Xil_AssertVoid(InstancePtr != NULL);
+  Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+  if (InstancePtr->Standard != XSDFEC_STANDARD_OTHER) {
+    return;
+  }
+  if (CachePtr->TurboValid) {
+    XSdFecSet_TURBO(InstancePtr->BaseAddress, CachePtr->TurboReg);
+  }
+  for (u32 id = 0; id < XSDFEC_MAX_CODES; id++) {
+    if (CachePtr->Code[id].ParamsPtr != NULL) {
+      (void)XSdFecCodeCacheLoadCode(CachePtr, InstancePtr, id);
+    }
+  }
+}
+
+int XSdFecSchedInit(XSdFecSched *SchedPtr, XSdFec *Instances, u32 NumInstances, XSdFecCodeCache *CachePtr, u32 Depth,
+                    XSdFecCtrlHandler CtrlHandler, XSdFecJobHandler DoneHandler, void *CallBackRef) {
+  Xil_AssertNonvoid(SchedPtr    != NULL);
+  Xil_AssertNonvoid(Instances   != NULL);
+  Xil_AssertNonvoid(CtrlHandler != NULL);
+
+  if (NumInstances == 0 || NumInstances > XSDFEC_SCHED_MAX_INSTANCES ||
+      Depth == 0 || Depth > XSDFEC_SCHED_MAX_INFLIGHT) {
+    return XST_INVALID_PARAM;
+  }
+  memset(SchedPtr, 0, sizeof(*SchedPtr));
+  SchedPtr->CachePtr    = CachePtr;
+  SchedPtr->NumDev      = NumInstances;
+  SchedPtr->Depth       = Depth;
+  SchedPtr->CtrlHandler = CtrlHandler;
+  SchedPtr->DoneHandler = DoneHandler;
+  SchedPtr->CallBackRef = CallBackRef;
+  for (u32 i = 0; i < NumInstances; i++) {
+    if (Instances[i].IsReady != XIL_COMPONENT_IS_READY) {
+      return XST_INVALID_PARAM;
+    }
+    SchedPtr->Dev[i].InstancePtr = &Instances[i];
+    SchedPtr->Dev[i].LastCode    = XSDFEC_MAX_CODES;
+    if (CachePtr != NULL) {
+      XSdFecCodeCacheLoad(CachePtr, &Instances[i]);
+    }
+  }
+  return XST_SUCCESS;
+}
+
+void XSdFecSchedSetTime(XSdFecSched *SchedPtr, XSdFecTimeHandler TimeHandler, u64 TimerFreq) {
+  Xil_AssertVoid(SchedPtr != NULL);
+  SchedPtr->TimeHandler = TimeHandler;
+  SchedPtr->TimerFreq   = TimerFreq;
+}
+
+int XSdFecSchedSubmit(XSdFecSched *SchedPtr, XSdFecJob *JobPtr) {
+  Xil_AssertNonvoid(SchedPtr != NULL);
+  Xil_AssertNonvoid(JobPtr   != NULL);
+  Xil_AssertNonvoid(JobPtr->NumCtrl > 0 && JobPtr->NumCtrl <= XSDFEC_CTRL_MAX_WORDS);
+
+  if (SchedPtr->QCount == XSDFEC_SCHED_QUEUE_DEPTH) {
+    return XST_DEVICE_BUSY;
+  }
+  SchedPtr->Queue[(SchedPtr->QHead + SchedPtr->QCount) % XSDFEC_SCHED_QUEUE_DEPTH] = JobPtr;
+  SchedPtr->QCount++;
+  if (SchedPtr->QCount > SchedPtr->QHigh) {
+    SchedPtr->QHigh = SchedPtr->QCount;
+  }
+  (void)XSdFecSchedDispatch(SchedPtr);
+  return XST_SUCCESS;
+}
+
+u32 XSdFecSchedDispatch(XSdFecSched *SchedPtr) {
+  Xil_AssertNonvoid(SchedPtr != NULL);
+  u32 Dispatched = 0;
+
+  while (SchedPtr->QCount > 0) {
+    XSdFecJob* JobPtr = SchedPtr->Queue[SchedPtr->QHead];
+    u32 Size = XSdFecJobSize(SchedPtr, JobPtr);
+    u32 Best = SchedPtr->NumDev;
+
+    // Least bits in flight, the device which already runs the code on a tie
+    for (u32 i = 0; i < SchedPtr->NumDev; i++) {
+      const XSdFecSchedDev* Dev = &SchedPtr->Dev[i];
+      if (Dev->Count == SchedPtr->Depth) {
+        continue;
+      }
+      if (Best == SchedPtr->NumDev || Dev->Load < SchedPtr->Dev[Best].Load ||
+          (Dev->Load == SchedPtr->Dev[Best].Load && Dev->LastCode == JobPtr->CodeId &&
+           SchedPtr->Dev[Best].LastCode != JobPtr->CodeId)) {
+        Best = i;
+      }
+    }
+    if (Best == SchedPtr->NumDev) {
+      break;
+    }
+    if (SchedPtr->CtrlHandler(SchedPtr->CallBackRef, Best, JobPtr->Ctrl, JobPtr->NumCtrl) != XST_SUCCESS) {
+      break;
+    }
+
+    XSdFecSchedDev* Dev = &SchedPtr->Dev[Best];
+    if (Dev->Count == 0) {
+      Dev->BusyStart = XSdFecSchedTime(SchedPtr);
+    }
+    if (Dev->LastCode != JobPtr->CodeId) {
+      if (Dev->LastCode != XSDFEC_MAX_CODES) {
+        Dev->Stats.CodeChanges++;
+      }
+      Dev->LastCode = JobPtr->CodeId;
+    }
+    Dev->InFlight[(Dev->Head + Dev->Count) % XSDFEC_SCHED_MAX_INFLIGHT] = JobPtr;
+    Dev->Count++;
+    Dev->Load += Size;
+    SchedPtr->QHead = (SchedPtr->QHead + 1) % XSDFEC_SCHED_QUEUE_DEPTH;
+    SchedPtr->QCount--;
+    Dispatched++;
+  }
+  return Dispatched;
+}
+
+int XSdFecSchedDone(XSdFecSched *SchedPtr, u32 InstIdx, u32 Status) {
+  Xil_AssertNonvoid(SchedPtr != NULL);
+  Xil_AssertNonvoid(InstIdx < SchedPtr->NumDev);
+
+  XSdFecSchedDev* Dev = &SchedPtr->Dev[InstIdx];
+  if (Dev->Count == 0) {
+    return XST_FAILURE;
+  }
+  XSdFecJob* JobPtr = Dev->InFlight[Dev->Head];
+  u32 Size = XSdFecJobSize(SchedPtr, JobPtr);
+  Dev->Head = (Dev->Head + 1) % XSDFEC_SCHED_MAX_INFLIGHT;
+  Dev->Count--;
+  Dev->Load -= Size;
+  Dev->Stats.Blocks++;
+  Dev->Stats.Bits += Size;
+  if (Status != 0) {
+    Dev->Stats.Errors++;
+  }
+  if (Dev->Count == 0) {
+    Dev->Stats.BusyTicks += XSdFecSchedTime(SchedPtr) - Dev->BusyStart;
+  }
+  if (SchedPtr->DoneHandler != NULL) {
+    SchedPtr->DoneHandler(SchedPtr->CallBackRef, InstIdx, JobPtr, Status);
+  }
+  (void)XSdFecSchedDispatch(SchedPtr);
+  return XST_SUCCESS;
+}
+
+u32 XSdFecSchedPending(XSdFecSched *SchedPtr) {
+  Xil_AssertNonvoid(SchedPtr != NULL);
+  u32 Pending = SchedPtr->QCount;
+  for (u32 i = 0; i < SchedPtr->NumDev; i++) {
+    Pending += SchedPtr->Dev[i].Count;
+  }
+  return Pending;
+}
+
+void XSdFecSchedGetStats(XSdFecSched *SchedPtr, u32 InstIdx, XSdFecSchedStats *StatsPtr) {
+  Xil_AssertVoid(SchedPtr != NULL);
+  Xil_AssertVoid(StatsPtr != NULL);
+  Xil_AssertVoid(InstIdx < SchedPtr->NumDev);
+
+  const XSdFecSchedDev* Dev = &SchedPtr->Dev[InstIdx];
+  *StatsPtr = Dev->Stats;
+  // Count the current busy period as well
+  if (Dev->Count != 0) {
+    StatsPtr->BusyTicks += XSdFecSchedTime(SchedPtr) - Dev->BusyStart;
+  }
+  StatsPtr->Mbps = 0;
+  if (SchedPtr->TimerFreq != 0 && StatsPtr->BusyTicks != 0) {
+    // Split in seconds and remainder so that long runs do not overflow
+    u64 Us = (StatsPtr->BusyTicks / SchedPtr->TimerFreq) * 1000000U +
+             ((StatsPtr->BusyTicks % SchedPtr->TimerFreq) * 1000000U) / SchedPtr->TimerFreq;
+    if (Us != 0) {
+      StatsPtr->Mbps = (u32)(StatsPtr->Bits / Us);
+    }
+  }
+}
+
+void XSdFecSchedResetStats(XSdFecSched *SchedPtr) {
+  Xil_AssertVoid(SchedPtr != NULL);
+  u64 Now = XSdFecSchedTime(SchedPtr);
+  for (u32 i = 0; i < SchedPtr->NumDev; i++) {
+    memset(&SchedPtr->Dev[i].Stats, 0, sizeof(XSdFecSchedStats));
+    SchedPtr->Dev[i].BusyStart = Now;
+  }
+  SchedPtr->QHigh = SchedPtr->QCount;
+}
@@ -0,0 +1,246 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/** \file xsdfec_jobq.h
+ *
+ * Code cache and job queue layer on top of the SD-FEC driver.
+ *
+ * \section sec_cache Code cache
+ * XSdFecCodeCacheAdd() precompiles the LDPC_CODE_REG0..3 words of a code and allocates its share table offsets,
+ * reusing the tables of a code added earlier when their contents are identical. The offsets are the same on every
+ * device, so XSdFecCodeCacheLoad() programs a device with plain register writes and all the cached codes stay
+ * resident. Changing the code from one block to the next then only takes the code ID of the control packet.
+ *
+ * \section sec_sched Job scheduling
+ * A job is the control packet of one block. XSdFecSchedSubmit() queues jobs and XSdFecSchedDispatch() streams their
+ * control packets, in order, to the device with the least outstanding work. The control packets are written by a
+ * handler of the application, as the CTRL interface is usually fed by a DMA or a stream FIFO. The application calls
+ * XSdFecSchedDone() once per block from its status or output handler; blocks complete in order on each device.
+ *
+ * XSdFecSchedSubmit(), XSdFecSchedDispatch() and XSdFecSchedDone() must not run concurrently.
+ */
+
+#ifndef XSDFEC_JOBQ_H
+#define XSDFEC_JOBQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Include Files
+#include "xsdfec.h"
+
+// Constant Definitions
+#define XSDFEC_MAX_CODES                128 // Number of LDPC code IDs
+#define XSDFEC_CTRL_MAX_WORDS             2 // Control packet words
+#define XSDFEC_SCHED_MAX_INSTANCES        8 // Devices handled by a scheduler
+#define XSDFEC_SCHED_QUEUE_DEPTH         64 // Jobs waiting for a device
+#define XSDFEC_SCHED_MAX_INFLIGHT        16 // Blocks in flight on a device
+
+// Share table capacities, in the units returned by XSdFecShareTableSize()
+#define XSDFEC_SC_TABLE_SIZE (XSDFEC_LDPC_SC_TABLE_DEPTH >> 2)
+#define XSDFEC_LA_TABLE_SIZE (XSDFEC_LDPC_LA_TABLE_DEPTH >> 4)
+#define XSDFEC_QC_TABLE_SIZE (XSDFEC_LDPC_QC_TABLE_DEPTH >> 4)
+
+// Type Definitions
+
+/** \brief Precompiled LDPC code
+ */
+typedef struct {
+  const XSdFecLdpcParameters* ParamsPtr; /**< Code parameters, NULL when the code ID is free */
+  u32 Reg[4];                            /**< LDPC_CODE_REG0..3 words */
+  u8  OwnsTable[3];                      /**< SC, LA and QC tables are written by this code */
+} XSdFecCachedCode;
+
+/** \brief Code cache
+ */
+typedef struct {
+  XSdFecCachedCode Code[XSDFEC_MAX_CODES];
+  u32 SCNext;     /**< First free scale table word */
+  u32 LANext;     /**< First free LA table unit */
+  u32 QCNext;     /**< First free QC table unit */
+  u32 TurboValid; /**< TurboReg holds Turbo parameters */
+  u32 TurboReg;   /**< Precompiled TURBO register */
+} XSdFecCodeCache;
+
+/** \brief Job
+ *
+ * One block, owned by the application until its done handler is called.
+ */
+typedef struct {
+  u32   CodeId;                       /**< LDPC code ID the control packet selects */
+  u32   Ctrl[XSDFEC_CTRL_MAX_WORDS];  /**< Control packet, as defined in PG256 */
+  u32   NumCtrl;                      /**< Words in Ctrl */
+  u32   Size;                         /**< Block size in bits, 0 to use N of the cached code */
+  void* Ref;                          /**< Application reference */
+} XSdFecJob;
+
+/** \brief Writes the control packet of a job to a device
+ *
+ * @returns XST_SUCCESS, or XST_FAILURE when the CTRL interface cannot take the packet now
+ */
+typedef int (*XSdFecCtrlHandler)(void *CallBackRef, u32 InstIdx, const u32 *CtrlPtr, u32 NumWords);
+
+/** \brief Called when a block completes
+ */
+typedef void (*XSdFecJobHandler)(void *CallBackRef, u32 InstIdx, XSdFecJob *JobPtr, u32 Status);
+
+/** \brief Returns a free running time stamp
+ */
+typedef u64 (*XSdFecTimeHandler)(void);
+
+/** \brief Per device statistics
+ */
+typedef struct {
+  u32 Blocks;      /**< Blocks completed */
+  u32 Errors;      /**< Blocks completed with a non zero status */
+  u64 Bits;        /**< Bits of the blocks completed */
+  u64 BusyTicks;   /**< Time with blocks in flight */
+  u32 Mbps;        /**< Bits / BusyTicks in Mbit/s, 0 without time stamps */
+  u32 CodeChanges; /**< Blocks using a different code than the previous block */
+} XSdFecSchedStats;
+
+/** \brief Per device scheduler state
+ */
+typedef struct {
+  XSdFec*    InstancePtr;
+  XSdFecJob* InFlight[XSDFEC_SCHED_MAX_INFLIGHT];
+  u32        Head;
+  u32        Count;
+  u32        Load;      /**< Bits in flight */
+  u32        LastCode;
+  u64        BusyStart;
+  XSdFecSchedStats Stats;
+} XSdFecSchedDev;
+
+/** \brief Scheduler
+ */
+typedef struct {
+  XSdFecCodeCache*  CachePtr;
+  XSdFecSchedDev    Dev[XSDFEC_SCHED_MAX_INSTANCES];
+  u32               NumDev;
+  u32               Depth;     /**< Blocks in flight per device */
+  XSdFecJob*        Queue[XSDFEC_SCHED_QUEUE_DEPTH];
+  u32               QHead;
+  u32               QCount;
+  u32               QHigh;     /**< Highest queue level seen */
+  XSdFecCtrlHandler CtrlHandler;
+  XSdFecJobHandler  DoneHandler;
+  void*             CallBackRef;
+  XSdFecTimeHandler TimeHandler;
+  u64               TimerFreq;
+} XSdFecSched;
+
+// API Function Prototypes
+/** \brief Empty a code cache
+ */
+void XSdFecCodeCacheInit(XSdFecCodeCache *CachePtr);
+
+/** \brief Precompile a LDPC code
+ *
+ * @param CachePtr  Pointer to the code cache
+ * @param CodeId    Code ID the code is programmed at
+ * @param ParamsPtr Pointer to the code parameters, kept by the cache
+ *
+ * @returns XST_SUCCESS, XST_DEVICE_BUSY when CodeId is in use or XST_BUFFER_TOO_SMALL when the share tables are full
+ */
+int XSdFecCodeCacheAdd(XSdFecCodeCache *CachePtr, u32 CodeId, const XSdFecLdpcParameters* ParamsPtr);
+
+/** \brief Precompile the Turbo parameters
+ */
+void XSdFecCodeCacheSetTurbo(XSdFecCodeCache *CachePtr, const XSdFecTurboParameters* ParamsPtr);
+
+/** \brief Program one cached code on a device
+ *
+ * @returns XST_SUCCESS or XST_INVALID_PARAM when CodeId is not cached
+ */
+int XSdFecCodeCacheLoadCode(XSdFecCodeCache *CachePtr, XSdFec *InstancePtr, u32 CodeId);
+
+/** \brief Program all the cached codes on a device
+ *
+ * LDPC codes are skipped on devices configured for the 5G NR standard, which has its codes built in.
+ */
+void XSdFecCodeCacheLoad(XSdFecCodeCache *CachePtr, XSdFec *InstancePtr);
+
+/** \brief Initialize a scheduler and load the code cache on its devices
+ *
+ * @param SchedPtr     Pointer to the scheduler
+ * @param Instances    Initialized devices
+ * @param NumInstances Number of devices, up to XSDFEC_SCHED_MAX_INSTANCES
+ * @param CachePtr     Code cache, may be NULL when the control packets select built in codes only
+ * @param Depth        Blocks in flight per device, up to XSDFEC_SCHED_MAX_INFLIGHT
+ * @param CtrlHandler  Writes control packets
+ * @param DoneHandler  Called on block completion, may be NULL
+ * @param CallBackRef  Passed to the handlers
+ *
+ * @returns XST_SUCCESS or XST_INVALID_PARAM
+ */
+int XSdFecSchedInit(XSdFecSched *SchedPtr, XSdFec *Instances, u32 NumInstances, XSdFecCodeCache *CachePtr, u32 Depth,
+                    XSdFecCtrlHandler CtrlHandler, XSdFecJobHandler DoneHandler, void *CallBackRef);
+
+/** \brief Provide time stamps for the throughput statistics
+ */
+void XSdFecSchedSetTime(XSdFecSched *SchedPtr, XSdFecTimeHandler TimeHandler, u64 TimerFreq);
+
+/** \brief Queue a job and dispatch what the devices can take
+ *
+ * @returns XST_SUCCESS or XST_DEVICE_BUSY when the queue is full
+ */
+int XSdFecSchedSubmit(XSdFecSched *SchedPtr, XSdFecJob *JobPtr);
+
+/** \brief Stream queued control packets to the devices
+ *
+ * @returns Number of jobs dispatched
+ */
+u32 XSdFecSchedDispatch(XSdFecSched *SchedPtr);
+
+/** \brief Complete the oldest block of a device and dispatch the next jobs
+ *
+ * @param SchedPtr Pointer to the scheduler
+ * @param InstIdx  Device index, in the order given to XSdFecSchedInit()
+ * @param Status   Block status, non zero counts as an error
+ *
+ * @returns XST_SUCCESS or XST_FAILURE when the device has no block in flight
+ */
+int XSdFecSchedDone(XSdFecSched *SchedPtr, u32 InstIdx, u32 Status);
+
+/** \brief Jobs queued or in flight
+ */
+u32 XSdFecSchedPending(XSdFecSched *SchedPtr);
+
+/** \brief Read the statistics of a device
+ */
+void XSdFecSchedGetStats(XSdFecSched *SchedPtr, u32 InstIdx, XSdFecSchedStats *StatsPtr);
+
+/** \brief Clear the statistics of all devices
+ */
+void XSdFecSchedResetStats(XSdFecSched *SchedPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
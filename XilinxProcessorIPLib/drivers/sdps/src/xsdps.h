@@ -78,8 +78,17 @@
 * descriptor table and hence care will have to be taken to call read/write
 * API's in a loop for large file sizes.
 *
-* Interrupt mode is not supported because it offers no improvement when used
-* with file system.
+* Request queue:
+* In addition to the polled read and write functions, read and write requests
+* can be queued with XSdPs_SubmitRequest() once XSdPs_EnableRequestQueue()
+* has been called and XSdPs_IntrHandler() is connected to the SD interrupt.
+* The ADMA2 descriptor table of a request is built when it is submitted and,
+* when a transfer completes, the interrupt handler issues the command of the
+* next queued request before it calls the completion handler of the finished
+* one. The bus then goes from one transfer to the next without waiting for
+* the application, and large sequential reads can be double buffered by
+* keeping two requests queued. The polled functions must not be used while
+* the request queue is enabled.
 *
 * eMMC support:
 * SD driver supports SD and eMMC based on the "enable MMC" parameter in SDK.
@@ -147,6 +156,7 @@
 * 3.7   mn     02/01/19 Add support for idling of SDIO
 * 3.8   mn     04/12/19 Modified TapDelay code for supporting ZynqMP and Versal
 *       mn     09/17/19 Modified ADMA handling API for 32bit and 64bit addresses
+*       mn     10/14/19 Added interrupt driven read/write request queue
 *
 * </pre>
 *
@@ -173,6 +183,15 @@ extern "C" {
 #define MAX_TUNING_COUNT	40U		/**< Maximum Tuning count */
 #define MAX_TIMEOUT		0x1FFFFFFFU		/**< Maximum Timeout */
 
+/* Number of requests that can be queued, a power of two */
+#ifndef XSDPS_REQ_QUEUE_DEPTH
+#define XSDPS_REQ_QUEUE_DEPTH	4U
+#endif
+#define XSDPS_REQ_DESC_LINES	32U	/**< ADMA2 descriptors per request */
+#define XSDPS_REQ_MAX_BLK_CNT	((XSDPS_REQ_DESC_LINES * \
+		XSDPS_DESC_MAX_LENGTH) / XSDPS_BLK_SIZE_512_MASK)
+					/**< Maximum blocks per request */
+
 /**************************** Type Definitions *******************************/
 
 typedef void (*XSdPs_ConfigTap) (u32 Bank, u32 DeviceId, u32 CardType);
@@ -216,6 +235,37 @@ typedef struct {
 }  __attribute__((__packed__))XSdPs_Adma2Descriptor64;
 #endif
 
+/* ADMA2 descriptor table of a queued request */
+typedef union {
+	XSdPs_Adma2Descriptor32 Desc32[XSDPS_REQ_DESC_LINES];
+	XSdPs_Adma2Descriptor64 Desc64[XSDPS_REQ_DESC_LINES];
+} XSdPs_Adma2DescTbl;
+
+typedef struct XSdPs_Request_s XSdPs_Request;
+
+/**
+ * Completion handler of a request, called from XSdPs_IntrHandler() with the
+ * Status of the request set.
+ */
+typedef void (*XSdPs_RequestHandler) (void *CallBackRef,
+		XSdPs_Request *RequestPtr);
+
+/**
+ * Read or write request, see XSdPs_SubmitRequest(). The request is owned by
+ * the driver from submission until its handler is called.
+ */
+struct XSdPs_Request_s {
+	u32 Arg;		/**< Block address, or byte address for
+				  *  standard capacity cards */
+	u32 BlkCnt;		/**< Number of 512 byte blocks */
+	u8 *Buff;		/**< Data buffer */
+	u32 IsWrite;		/**< 1 to write Buff to the card */
+	XSdPs_RequestHandler Handler;	/**< Completion handler, or NULL */
+	void *CallBackRef;	/**< First argument of Handler */
+	s32 Status;		/**< XST_SUCCESS, XST_FAILURE or
+				  *  XST_DEVICE_BUSY while pending */
+};
+
 /**
  * The XSdPs driver instance data. The user is required to allocate a
  * variable of this type for every SD device in the system. A pointer
@@ -242,6 +292,17 @@ typedef struct {
 	u32	OTapDelay;		/**< Output Tap Delay */
 	u32	ITapDelay;		/**< Input Tap Delay */
 	u64 Dma64BitAddr;	/**< 64 Bit DMA Address */
+	XSdPs_Request *ReqQueue[XSDPS_REQ_QUEUE_DEPTH];	/**< Queued requests */
+	volatile u32 ReqHead;	/**< Number of requests submitted */
+	volatile u32 ReqTail;	/**< Number of requests completed */
+	volatile u32 ReqBusy;	/**< Request at ReqTail is on the bus */
+#ifdef __ICCARM__
+	XSdPs_Adma2DescTbl ReqDescTbl[XSDPS_REQ_QUEUE_DEPTH];
+#else
+	XSdPs_Adma2DescTbl ReqDescTbl[XSDPS_REQ_QUEUE_DEPTH]
+		__attribute__ ((aligned(32)));
+#endif
+				/**< Descriptor tables of the queued requests */
 } XSdPs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -267,6 +328,11 @@ s32 XSdPs_CardInitialize(XSdPs *InstancePtr);
 s32 XSdPs_Get_Mmc_ExtCsd(XSdPs *InstancePtr, u8 *ReadBuff);
 s32 XSdPs_Set_Mmc_ExtCsd(XSdPs *InstancePtr, u32 Arg);
 void XSdPs_Idle(XSdPs *InstancePtr);
+s32 XSdPs_EnableRequestQueue(XSdPs *InstancePtr);
+s32 XSdPs_DisableRequestQueue(XSdPs *InstancePtr);
+s32 XSdPs_SubmitRequest(XSdPs *InstancePtr, XSdPs_Request *RequestPtr);
+u32 XSdPs_GetPendingRequests(XSdPs *InstancePtr);
+void XSdPs_IntrHandler(void *InstancePtr);
 #if defined (ARMR5) || defined (__aarch64__) || defined (ARMA53_32) || defined (__MICROBLAZE__)
 void XSdPs_Identify_UhsMode(XSdPs *InstancePtr, u8 *ReadBuff);
 void XSdPs_ddr50_tapdelay(u32 Bank, u32 DeviceId, u32 CardType);
@@ -0,0 +1,511 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsdps_intr.c
+* @addtogroup sdps_v3_8
+* @{
+*
+* Contains the interrupt driven read/write request queue of the XSdPs driver.
+* See xsdps.h for a description of the request queue.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---    -------- -----------------------------------------------
+* 3.8   mn     10/14/19 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsdps.h"
+
+/************************** Constant Definitions *****************************/
+#define XSDPS_REQ_QUEUE_MASK	(XSDPS_REQ_QUEUE_DEPTH - 1U)
+#define XSDPS_RST_TIMEOUT	0xFFFFFU
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd);
+static void XSdPs_ReqSetupDescTbl(XSdPs *InstancePtr, u32 Slot);
+static s32 XSdPs_ReqStart(XSdPs *InstancePtr, u32 Slot);
+static void XSdPs_ReqSchedule(XSdPs *InstancePtr, XSdPs_Request *DonePtr);
+
+/*****************************************************************************/
+/**
+*
+* This function enables the request queue. The block size is set to 512
+* bytes and the transfer complete and error interrupts are signaled.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return
+*		- XST_SUCCESS if the request queue is enabled.
+*		- XST_FAILURE if the block size could not be set.
+*
+* @note		XSdPs_IntrHandler() must be connected to the SD interrupt.
+*		The polled read/write functions must not be used until
+*		XSdPs_DisableRequestQueue() is called.
+*
+******************************************************************************/
+s32 XSdPs_EnableRequestQueue(XSdPs *InstancePtr)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_SIZE_OFFSET) != XSDPS_BLK_SIZE_512_MASK) {
+		Status = XSdPs_SetBlkSize(InstancePtr, XSDPS_BLK_SIZE_512_MASK);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+	}
+
+	InstancePtr->ReqHead = 0U;
+	InstancePtr->ReqTail = 0U;
+	InstancePtr->ReqBusy = 0U;
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_STS_OFFSET, XSDPS_NORM_INTR_ALL_MASK);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_STS_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, XSDPS_INTR_TC_MASK);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function disables the request queue and the SD interrupt signals.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return
+*		- XST_SUCCESS if the request queue is disabled.
+*		- XST_DEVICE_BUSY if requests are still pending.
+*
+******************************************************************************/
+s32 XSdPs_DisableRequestQueue(XSdPs *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->ReqHead != InstancePtr->ReqTail) {
+		return XST_DEVICE_BUSY;
+	}
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function queues a read or write request. The ADMA2 descriptor table of
+* the request is built and the data cache maintenance of the buffer is done
+* here, so that the transfer can be started from the interrupt handler as
+* soon as the bus is free. The request is started right away when the queue
+* is empty.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	RequestPtr is a pointer to the request. It must stay valid until
+*		its handler is called.
+*
+* @return
+*		- XST_SUCCESS if the request is queued. Its Status is
+*		XST_DEVICE_BUSY until it completes.
+*		- XST_INVALID_PARAM if the block count is 0 or above
+*		XSDPS_REQ_MAX_BLK_CNT.
+*		- XST_DEVICE_BUSY if XSDPS_REQ_QUEUE_DEPTH requests are pending.
+*		- XST_FAILURE if no card is inserted.
+*
+* @note		The buffer should be cache line aligned and a multiple of the
+*		cache line size, as for the polled functions. If the command of
+*		the request cannot be issued, the request completes with
+*		XST_FAILURE and its handler may run before this function
+*		returns. The handler may submit new requests.
+*
+******************************************************************************/
+s32 XSdPs_SubmitRequest(XSdPs *InstancePtr, XSdPs_Request *RequestPtr)
+{
+	u32 PresentStateReg;
+	u16 NormSigEn;
+	u16 ErrSigEn;
+	u32 Slot;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(RequestPtr != NULL);
+
+	if ((RequestPtr->BlkCnt == 0U) ||
+			(RequestPtr->BlkCnt > XSDPS_REQ_MAX_BLK_CNT)) {
+		Status = XST_INVALID_PARAM;
+		goto RETURN_PATH;
+	}
+
+	if ((InstancePtr->ReqHead - InstancePtr->ReqTail) >=
+			XSDPS_REQ_QUEUE_DEPTH) {
+		Status = XST_DEVICE_BUSY;
+		goto RETURN_PATH;
+	}
+
+	if ((InstancePtr->HC_Version != XSDPS_HC_SPEC_V3) ||
+				((InstancePtr->Host_Caps & XSDPS_CAPS_SLOT_TYPE_MASK)
+				!= XSDPS_CAPS_EMB_SLOT)) {
+		if(InstancePtr->Config.CardDetect != 0U) {
+			/* Check status to ensure card is initialized */
+			PresentStateReg = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XSDPS_PRES_STATE_OFFSET);
+			if ((PresentStateReg & XSDPS_PSR_CARD_INSRT_MASK) == 0x0U) {
+				Status = XST_FAILURE;
+				goto RETURN_PATH;
+			}
+		}
+	}
+
+	RequestPtr->Status = XST_DEVICE_BUSY;
+	Slot = InstancePtr->ReqHead & XSDPS_REQ_QUEUE_MASK;
+	InstancePtr->ReqQueue[Slot] = RequestPtr;
+	XSdPs_ReqSetupDescTbl(InstancePtr, Slot);
+
+	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		if (RequestPtr->IsWrite != 0U) {
+			Xil_DCacheFlushRange((INTPTR)RequestPtr->Buff,
+				RequestPtr->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+		} else {
+			Xil_DCacheInvalidateRange((INTPTR)RequestPtr->Buff,
+				RequestPtr->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+		}
+	}
+
+	/*
+	 * Keep the interrupt handler out while the queue is updated and the
+	 * request is started
+	 */
+	NormSigEn = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET);
+	ErrSigEn = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+
+	InstancePtr->ReqHead++;
+	if (InstancePtr->ReqBusy == 0U) {
+		XSdPs_ReqSchedule(InstancePtr, NULL);
+	}
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, NormSigEn);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET, ErrSigEn);
+
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the number of requests submitted and not completed,
+* the one on the bus included.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	Number of pending requests.
+*
+******************************************************************************/
+u32 XSdPs_GetPendingRequests(XSdPs *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return InstancePtr->ReqHead - InstancePtr->ReqTail;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the interrupt handler of the request queue. It completes
+* the request on the bus, starts the next queued request and then calls the
+* completion handler of the finished one.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	None.
+*
+* @note		On an error the CMD and DAT lines are reset and the request
+*		completes with XST_FAILURE.
+*
+******************************************************************************/
+void XSdPs_IntrHandler(void *InstancePtr)
+{
+	XSdPs *SdPtr = (XSdPs *)InstancePtr;
+	XSdPs_Request *DonePtr;
+	u32 StatusReg;
+	u32 Timeout;
+	s32 Status;
+
+	Xil_AssertVoid(SdPtr != NULL);
+
+	StatusReg = XSdPs_ReadReg16(SdPtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET);
+
+	if ((StatusReg & XSDPS_INTR_ERR_MASK) != 0U) {
+		/* Write to clear error bits */
+		XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_STS_OFFSET,
+				XSDPS_ERROR_INTR_ALL_MASK);
+		XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET,
+				XSDPS_NORM_INTR_ALL_MASK & ~XSDPS_INTR_CARD_MASK);
+		/* Abort the transfer so that the next command can be issued */
+		XSdPs_WriteReg8(SdPtr->Config.BaseAddress, XSDPS_SW_RST_OFFSET,
+				XSDPS_SWRST_CMD_LINE_MASK |
+				XSDPS_SWRST_DAT_LINE_MASK);
+		Timeout = XSDPS_RST_TIMEOUT;
+		while (((XSdPs_ReadReg8(SdPtr->Config.BaseAddress,
+				XSDPS_SW_RST_OFFSET) &
+				(XSDPS_SWRST_CMD_LINE_MASK |
+				 XSDPS_SWRST_DAT_LINE_MASK)) != 0U) &&
+				(Timeout != 0U)) {
+			Timeout--;
+		}
+		Status = XST_FAILURE;
+	} else if ((StatusReg & XSDPS_INTR_TC_MASK) != 0U) {
+		/* Write to clear the command and transfer complete bits */
+		XSdPs_WriteReg16(SdPtr->Config.BaseAddress,
+				XSDPS_NORM_INTR_STS_OFFSET,
+				XSDPS_INTR_CC_MASK | XSDPS_INTR_TC_MASK);
+		Status = XST_SUCCESS;
+	} else {
+		return;
+	}
+
+	if (SdPtr->ReqBusy == 0U) {
+		return;
+	}
+
+	DonePtr = SdPtr->ReqQueue[SdPtr->ReqTail & XSDPS_REQ_QUEUE_MASK];
+	if ((DonePtr->IsWrite == 0U) && (SdPtr->Config.IsCacheCoherent == 0U)) {
+		Xil_DCacheInvalidateRange((INTPTR)DonePtr->Buff,
+				DonePtr->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+	}
+	DonePtr->Status = Status;
+	SdPtr->ReqTail++;
+	SdPtr->ReqBusy = 0U;
+
+	XSdPs_ReqSchedule(SdPtr, DonePtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function starts the oldest queued request and then calls the handler
+* of the request that just completed. Requests whose command cannot be issued
+* are completed with XST_FAILURE, in order.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	DonePtr is the request that just completed, or NULL.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XSdPs_ReqSchedule(XSdPs *InstancePtr, XSdPs_Request *DonePtr)
+{
+	XSdPs_Request *ReqPtr;
+
+	while ((InstancePtr->ReqBusy == 0U) &&
+			(InstancePtr->ReqHead != InstancePtr->ReqTail)) {
+		if (XSdPs_ReqStart(InstancePtr, InstancePtr->ReqTail &
+				XSDPS_REQ_QUEUE_MASK) == XST_SUCCESS) {
+			InstancePtr->ReqBusy = 1U;
+		} else {
+			ReqPtr = InstancePtr->ReqQueue[InstancePtr->ReqTail &
+					XSDPS_REQ_QUEUE_MASK];
+			ReqPtr->Status = XST_FAILURE;
+			InstancePtr->ReqTail++;
+			if ((DonePtr != NULL) && (DonePtr->Handler != NULL)) {
+				DonePtr->Handler(DonePtr->CallBackRef, DonePtr);
+			}
+			DonePtr = ReqPtr;
+		}
+	}
+
+	if ((DonePtr != NULL) && (DonePtr->Handler != NULL)) {
+		DonePtr->Handler(DonePtr->CallBackRef, DonePtr);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function issues the command of a queued request. Unlike
+* XSdPs_CmdTransfer() it does not wait for the command to complete, the
+* transfer complete interrupt signals the end of the request.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	Slot is the queue slot of the request.
+*
+* @return
+*		- XST_SUCCESS if the command was issued.
+*		- XST_FAILURE if the command or data lines are busy.
+*
+******************************************************************************/
+static s32 XSdPs_ReqStart(XSdPs *InstancePtr, u32 Slot)
+{
+	XSdPs_Request *ReqPtr = InstancePtr->ReqQueue[Slot];
+	u32 PresentStateReg;
+	u32 CommandReg;
+	u32 Mode;
+	u32 Cmd;
+
+	PresentStateReg = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XSDPS_PRES_STATE_OFFSET);
+	if ((PresentStateReg & (XSDPS_PSR_INHIBIT_CMD_MASK |
+				XSDPS_PSR_INHIBIT_DAT_MASK)) != 0U) {
+		return XST_FAILURE;
+	}
+
+	Mode = XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK;
+	if (ReqPtr->BlkCnt != 1U) {
+		Mode |= XSDPS_TM_AUTO_CMD12_EN_MASK |
+			XSDPS_TM_MUL_SIN_BLK_SEL_MASK;
+	}
+	if (ReqPtr->IsWrite != 0U) {
+		Cmd = (ReqPtr->BlkCnt == 1U) ? CMD24 : CMD25;
+	} else {
+		Mode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+		Cmd = (ReqPtr->BlkCnt == 1U) ? CMD17 : CMD18;
+	}
+
+#if defined(__aarch64__) || defined(__arch64__)
+	if (InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) {
+		XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XSDPS_ADMA_SAR_EXT_OFFSET,
+			(u32)((UINTPTR)&InstancePtr->ReqDescTbl[Slot] >> 32U));
+	}
+#endif
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_ADMA_SAR_OFFSET,
+			(u32)(UINTPTR)&InstancePtr->ReqDescTbl[Slot]);
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_CNT_OFFSET, (u16)ReqPtr->BlkCnt);
+	XSdPs_WriteReg8(InstancePtr->Config.BaseAddress,
+			XSDPS_TIMEOUT_CTRL_OFFSET, 0xEU);
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XSDPS_ARGMT_OFFSET, ReqPtr->Arg);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_STS_OFFSET,
+			XSDPS_NORM_INTR_ALL_MASK & ~XSDPS_INTR_CARD_MASK);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_STS_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+
+	/* Mask the reserved bits 31-30, see XSdPs_CmdTransfer() */
+	CommandReg = XSdPs_FrameCmd(InstancePtr, Cmd) & 0x3FFFU;
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_XFER_MODE_OFFSET,
+			(CommandReg << 16) | Mode);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function builds the ADMA2 descriptor table of a queued request, in the
+* 64-bit descriptor format on version 3 host controllers and in the 32-bit
+* format otherwise, and flushes it from the data cache.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	Slot is the queue slot of the request.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XSdPs_ReqSetupDescTbl(XSdPs *InstancePtr, u32 Slot)
+{
+	XSdPs_Adma2DescTbl *TblPtr = &InstancePtr->ReqDescTbl[Slot];
+	XSdPs_Request *ReqPtr = InstancePtr->ReqQueue[Slot];
+	u32 Bytes = ReqPtr->BlkCnt * XSDPS_BLK_SIZE_512_MASK;
+	UINTPTR Addr = (UINTPTR)ReqPtr->Buff;
+	u32 TotalDescLines;
+	u32 DescNum;
+	u16 Attribute;
+	u16 Length;
+
+	TotalDescLines = (Bytes + XSDPS_DESC_MAX_LENGTH - 1U) /
+			XSDPS_DESC_MAX_LENGTH;
+
+	for (DescNum = 0U; DescNum < TotalDescLines; DescNum++) {
+		Attribute = XSDPS_DESC_TRAN | XSDPS_DESC_VALID;
+		/* A length of 0 stands for XSDPS_DESC_MAX_LENGTH bytes */
+		Length = 0U;
+		if (DescNum == (TotalDescLines - 1U)) {
+			Attribute |= XSDPS_DESC_END;
+			Length = (u16)(Bytes - (DescNum * XSDPS_DESC_MAX_LENGTH));
+		}
+
+		if (InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) {
+			TblPtr->Desc64[DescNum].Address = (u64)(Addr +
+					((UINTPTR)DescNum * XSDPS_DESC_MAX_LENGTH));
+			TblPtr->Desc64[DescNum].Attribute = Attribute;
+			TblPtr->Desc64[DescNum].Length = Length;
+		} else {
+			TblPtr->Desc32[DescNum].Address = (u32)(Addr +
+					((UINTPTR)DescNum * XSDPS_DESC_MAX_LENGTH));
+			TblPtr->Desc32[DescNum].Attribute = Attribute;
+			TblPtr->Desc32[DescNum].Length = Length;
+		}
+	}
+
+	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		Xil_DCacheFlushRange((INTPTR)TblPtr, sizeof(XSdPs_Adma2DescTbl));
+	}
+}
+/** @} */
@@ -71,6 +71,9 @@
 *                       Declared the pointer param as Pointer to const,
 *			added goto statements.
 * 3.3	akm    08/06/19 Initialized DeviceID in XSpiPs_CfgInitialize function.
+* 3.3	adk    10/15/19 Added XSpiPs_MsgTransfer and XSpiPs_PolledMsgTransfer
+*			which keep the TX FIFO above the watermark during
+*			long transfers.
 * </pre>
 *
 ******************************************************************************/
@@ -81,6 +84,11 @@
 
 /************************** Constant Definitions *****************************/
 
+/*
+ * TX FIFO watermark used by message transfers. The FIFO is refilled once it
+ * drains below this level, so the bus keeps running while the refill is done.
+ */
+#define XSPIPS_MSG_TXWR		(XSPIPS_FIFO_DEPTH / 2U)
 
 /**************************** Type Definitions *******************************/
 
@@ -125,6 +133,10 @@
 
 static void StubStatusHandler(const void *CallBackRef, u32 StatusEvent,
 				u32 ByteCount);
+static void XSpiPs_MsgStart(XSpiPs *InstancePtr);
+static void XSpiPs_MsgFill(XSpiPs *InstancePtr);
+static u32 XSpiPs_MsgService(XSpiPs *InstancePtr);
+static void XSpiPs_MsgFinish(XSpiPs *InstancePtr);
 
 /************************** Variable Definitions *****************************/
 
@@ -184,6 +196,7 @@ s32 XSpiPs_CfgInitialize(XSpiPs *InstancePtr, const XSpiPs_Config *ConfigPtr,
 		 * Set some default values.
 		 */
 		InstancePtr->IsBusy = FALSE;
+		InstancePtr->MsgPtr = NULL;
 
 		InstancePtr->Config.BaseAddress = EffectiveAddr;
 		InstancePtr->Config.InputClockHz = ConfigPtr->InputClockHz;
@@ -936,6 +949,23 @@ void XSpiPs_InterruptHandler(XSpiPs *InstancePtr)
 	}
 
 
+	/*
+	 * Message transfers refill the FIFO from the watermark interrupt.
+	 */
+	if ((SpiPtr->MsgPtr != NULL) &&
+		((IntrStatus & XSPIPS_IXR_TXOW_MASK) != 0U)) {
+		if (XSpiPs_MsgService(SpiPtr) == TRUE) {
+			XSpiPs_MsgFinish(SpiPtr);
+			SpiPtr->StatusHandler(SpiPtr->StatusRef,
+						XST_SPI_TRANSFER_DONE,
+						SpiPtr->MsgBytes);
+		} else {
+			XSpiPs_WriteReg(SpiPtr->Config.BaseAddress,
+				 XSPIPS_IER_OFFSET, XSPIPS_IXR_TXOW_MASK);
+		}
+		IntrStatus &= ~XSPIPS_IXR_TXOW_MASK;
+	}
+
 	if ((IntrStatus & XSPIPS_IXR_TXOW_MASK) != 0U) {
 		u8 TempData;
 		u32 TransCount;
@@ -1045,6 +1075,16 @@ void XSpiPs_InterruptHandler(XSpiPs *InstancePtr)
 		BytesDone = SpiPtr->RequestedBytes - SpiPtr->RemainingBytes;
 		SpiPtr->IsBusy = FALSE;
 
+		/*
+		 * Terminate a message transfer in progress.
+		 */
+		if (SpiPtr->MsgPtr != NULL) {
+			XSpiPs_WriteReg(SpiPtr->Config.BaseAddress,
+					XSPIPS_TXWR_OFFSET,
+					XSPIPS_TXWR_RESET_VALUE);
+			SpiPtr->MsgPtr = NULL;
+		}
+
 		/*
 		 * The Slave select lines are being manually controlled.
 		 * Disable them because the transfer is complete.
@@ -1146,9 +1186,358 @@ void XSpiPs_Abort(XSpiPs *InstancePtr)
 			XSPIPS_SR_OFFSET,
 			XSPIPS_IXR_MODF_MASK);
 
+	/*
+	 * Restore the TX watermark changed by a message transfer.
+	 */
+	XSpiPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XSPIPS_TXWR_OFFSET, XSPIPS_TXWR_RESET_VALUE);
+
 	InstancePtr->RemainingBytes = 0U;
 	InstancePtr->RequestedBytes = 0U;
 	InstancePtr->IsBusy = FALSE;
+	InstancePtr->MsgPtr = NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* Transfers a list of messages on the SPI bus in interrupt mode, as a master.
+*
+* Each message selects its own slave. The TX FIFO watermark is raised to half
+* the FIFO during a message, and the interrupt handler reads the bytes known
+* to be received and refills the TX FIFO before it empties, so a message is
+* sent without gaps between FIFO loads. The status callback is called with
+* XST_SPI_TRANSFER_DONE and the total byte count once all the messages are
+* done.
+*
+* @param	InstancePtr is a pointer to the XSpiPs instance.
+* @param	MsgPtr is a pointer to the first message of the list. The list
+*		must remain valid until the transfer is done.
+* @param	MsgCount is the number of messages in the list.
+*
+* @return
+*		- XST_SUCCESS if the transfer is started.
+*		- XST_DEVICE_BUSY indicates that a data transfer is already in
+*		progress.
+*
+* @note
+*
+* This function is not thread-safe.  The higher layer software must ensure that
+* no two threads are transferring data on the SPI bus at the same time.
+*
+******************************************************************************/
+s32 XSpiPs_MsgTransfer(XSpiPs *InstancePtr, XSpiPs_Msg *MsgPtr, u32 MsgCount)
+{
+	u32 Index;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(MsgPtr != NULL);
+	Xil_AssertNonvoid(MsgCount > 0U);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(XSpiPs_IsMaster(InstancePtr) == TRUE);
+	for (Index = 0U; Index < MsgCount; Index++) {
+		Xil_AssertNonvoid(MsgPtr[Index].SendBufPtr != NULL);
+		Xil_AssertNonvoid(MsgPtr[Index].ByteCount > 0U);
+		Xil_AssertNonvoid(MsgPtr[Index].SlaveSel <=
+					XSPIPS_CR_SSCTRL_MAXIMUM);
+	}
+
+	if (InstancePtr->IsBusy == TRUE) {
+		Status = (s32)XST_DEVICE_BUSY;
+	} else {
+		InstancePtr->IsBusy = TRUE;
+		InstancePtr->MsgPtr = MsgPtr;
+		InstancePtr->MsgCount = MsgCount;
+		InstancePtr->MsgIndex = 0U;
+		InstancePtr->MsgBytes = 0U;
+
+		XSpiPs_Enable(InstancePtr);
+
+		/*
+		 * Clear all the interrupts.
+		 */
+		XSpiPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XSPIPS_SR_OFFSET, XSPIPS_IXR_WR_TO_CLR_MASK);
+
+		XSpiPs_MsgStart(InstancePtr);
+
+		/*
+		 * Enable interrupts (connecting to the interrupt controller and
+		 * enabling interrupts should have been done by the caller).
+		 */
+		XSpiPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XSPIPS_IER_OFFSET, XSPIPS_IXR_DFLT_MASK);
+
+		Status = (s32)XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Transfers a list of messages on the SPI bus in polled mode, as a master.
+* The FIFO is managed as in XSpiPs_MsgTransfer(), by polling the TX FIFO
+* watermark status. This function blocks until all the messages are done.
+*
+* @param	InstancePtr is a pointer to the XSpiPs instance.
+* @param	MsgPtr is a pointer to the first message of the list.
+* @param	MsgCount is the number of messages in the list.
+*
+* @return
+*		- XST_SUCCESS if all the messages are transferred.
+*		- XST_DEVICE_BUSY indicates that a data transfer is already in
+*		progress.
+*		- XST_SEND_ERROR if a mode fault occurred.
+*
+* @note
+*
+* This function is not thread-safe.  The higher layer software must ensure that
+* no two threads are transferring data on the SPI bus at the same time.
+*
+******************************************************************************/
+s32 XSpiPs_PolledMsgTransfer(XSpiPs *InstancePtr, XSpiPs_Msg *MsgPtr,
+				u32 MsgCount)
+{
+	u32 Index;
+	u32 StatusReg;
+	u32 Done = FALSE;
+	s32 Status = (s32)XST_SUCCESS;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(MsgPtr != NULL);
+	Xil_AssertNonvoid(MsgCount > 0U);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(XSpiPs_IsMaster(InstancePtr) == TRUE);
+	for (Index = 0U; Index < MsgCount; Index++) {
+		Xil_AssertNonvoid(MsgPtr[Index].SendBufPtr != NULL);
+		Xil_AssertNonvoid(MsgPtr[Index].ByteCount > 0U);
+		Xil_AssertNonvoid(MsgPtr[Index].SlaveSel <=
+					XSPIPS_CR_SSCTRL_MAXIMUM);
+	}
+
+	if (InstancePtr->IsBusy == TRUE) {
+		Status = (s32)XST_DEVICE_BUSY;
+		goto END;
+	}
+
+	InstancePtr->IsBusy = TRUE;
+	InstancePtr->MsgPtr = MsgPtr;
+	InstancePtr->MsgCount = MsgCount;
+	InstancePtr->MsgIndex = 0U;
+	InstancePtr->MsgBytes = 0U;
+
+	XSpiPs_Enable(InstancePtr);
+	XSpiPs_MsgStart(InstancePtr);
+
+	while (Done == FALSE) {
+		StatusReg = XSpiPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XSPIPS_SR_OFFSET);
+		if ((StatusReg & XSPIPS_IXR_MODF_MASK) != 0U) {
+			/*
+			 * Clear the mode fail bit
+			 */
+			XSpiPs_WriteReg(InstancePtr->Config.BaseAddress,
+					XSPIPS_SR_OFFSET, XSPIPS_IXR_MODF_MASK);
+			Status = (s32)XST_SEND_ERROR;
+			break;
+		}
+		if ((StatusReg & XSPIPS_IXR_TXOW_MASK) != 0U) {
+			Done = XSpiPs_MsgService(InstancePtr);
+		}
+	}
+
+	XSpiPs_MsgFinish(InstancePtr);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/*
+*
+* Starts the current message of a message list: selects its slave and fills
+* the TX FIFO.
+*
+* @param	InstancePtr is a pointer to the XSpiPs instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XSpiPs_MsgStart(XSpiPs *InstancePtr)
+{
+	XSpiPs_Msg *MsgPtr = &InstancePtr->MsgPtr[InstancePtr->MsgIndex];
+	u32 ConfigReg;
+
+	InstancePtr->SendBufferPtr = MsgPtr->SendBufPtr;
+	InstancePtr->RecvBufferPtr = MsgPtr->RecvBufPtr;
+	InstancePtr->RequestedBytes = MsgPtr->ByteCount;
+	InstancePtr->RemainingBytes = MsgPtr->ByteCount;
+	InstancePtr->InFlight = 0U;
+
+	/*
+	 * Select the slave of the message, as XSpiPs_SetSlaveSelect does.
+	 */
+	if (XSpiPs_IsDecodeSSelect(InstancePtr) == TRUE) {
+		InstancePtr->SlaveSelect = ((u32)MsgPtr->SlaveSel) <<
+						XSPIPS_CR_SSCTRL_SHIFT;
+	} else {
+		InstancePtr->SlaveSelect = ((~(1U << MsgPtr->SlaveSel)) &
+			XSPIPS_CR_SSCTRL_MAXIMUM) << XSPIPS_CR_SSCTRL_SHIFT;
+	}
+	ConfigReg = XSpiPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XSPIPS_CR_OFFSET);
+	ConfigReg &= (u32)(~XSPIPS_CR_SSCTRL_MASK);
+	ConfigReg |= InstancePtr->SlaveSelect;
+	XSpiPs_WriteReg(InstancePtr->Config.BaseAddress, XSPIPS_CR_OFFSET,
+			ConfigReg);
+
+	XSpiPs_MsgFill(InstancePtr);
+}
+
+/*****************************************************************************/
+/*
+*
+* Fills the TX FIFO with the bytes of the current message, without letting
+* more bytes than the FIFO depth be in flight so that the RX FIFO cannot
+* overflow, and sets the watermark for the next refill.
+*
+* @param	InstancePtr is a pointer to the XSpiPs instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XSpiPs_MsgFill(XSpiPs *InstancePtr)
+{
+	u32 BaseAddr = InstancePtr->Config.BaseAddress;
+	u32 ConfigReg;
+
+	while ((InstancePtr->RemainingBytes > 0U) &&
+		(InstancePtr->InFlight < XSPIPS_FIFO_DEPTH)) {
+		XSpiPs_SendByte(BaseAddr, *InstancePtr->SendBufferPtr);
+		InstancePtr->SendBufferPtr += 1;
+		InstancePtr->RemainingBytes--;
+		InstancePtr->InFlight++;
+	}
+
+	/*
+	 * Refill at half FIFO while there is more to send, then wait for
+	 * the FIFO to empty to collect the last bytes.
+	 */
+	if (InstancePtr->RemainingBytes > 0U) {
+		XSpiPs_WriteReg(BaseAddr, XSPIPS_TXWR_OFFSET, XSPIPS_MSG_TXWR);
+	} else {
+		XSpiPs_WriteReg(BaseAddr, XSPIPS_TXWR_OFFSET,
+				XSPIPS_TXWR_RESET_VALUE);
+	}
+
+	if ((XSpiPs_IsManualStart(InstancePtr) == TRUE)
+		&& (XSpiPs_IsMaster(InstancePtr) == TRUE)) {
+		ConfigReg = XSpiPs_ReadReg(BaseAddr, XSPIPS_CR_OFFSET);
+		ConfigReg |= XSPIPS_CR_MANSTRT_MASK;
+		XSpiPs_WriteReg(BaseAddr, XSPIPS_CR_OFFSET, ConfigReg);
+	}
+}
+
+/*****************************************************************************/
+/*
+*
+* Services the TX FIFO watermark of a message transfer. With the TX FIFO
+* below the watermark, all but watermark bytes of the ones in flight have
+* been received, so they are read without checking the RX FIFO status.
+*
+* @param	InstancePtr is a pointer to the XSpiPs instance.
+*
+* @return	TRUE when all the messages are done, FALSE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XSpiPs_MsgService(XSpiPs *InstancePtr)
+{
+	u32 BaseAddr = InstancePtr->Config.BaseAddress;
+	u32 ConfigReg;
+	u32 Count;
+	u8 TempData;
+
+	if (InstancePtr->RemainingBytes > 0U) {
+		Count = InstancePtr->InFlight - XSPIPS_MSG_TXWR;
+	} else {
+		Count = InstancePtr->InFlight;
+	}
+
+	InstancePtr->InFlight -= Count;
+	InstancePtr->RequestedBytes -= Count;
+	while (Count != 0U) {
+		TempData = (u8)XSpiPs_RecvByte(BaseAddr);
+		if (InstancePtr->RecvBufferPtr != NULL) {
+			*InstancePtr->RecvBufferPtr = TempData;
+			InstancePtr->RecvBufferPtr += 1;
+		}
+		--Count;
+	}
+
+	if (InstancePtr->RequestedBytes != 0U) {
+		XSpiPs_MsgFill(InstancePtr);
+		return FALSE;
+	}
+
+	/*
+	 * The message is done, deselect the slave before the next one.
+	 */
+	InstancePtr->MsgBytes +=
+		InstancePtr->MsgPtr[InstancePtr->MsgIndex].ByteCount;
+	if (XSpiPs_IsManualChipSelect(InstancePtr) == TRUE) {
+		ConfigReg = XSpiPs_ReadReg(BaseAddr, XSPIPS_CR_OFFSET);
+		ConfigReg |= XSPIPS_CR_SSCTRL_MASK;
+		XSpiPs_WriteReg(BaseAddr, XSPIPS_CR_OFFSET, ConfigReg);
+	}
+
+	InstancePtr->MsgIndex++;
+	if (InstancePtr->MsgIndex < InstancePtr->MsgCount) {
+		XSpiPs_MsgStart(InstancePtr);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/*****************************************************************************/
+/*
+*
+* Terminates a message transfer and returns the device to the state expected
+* by the other transfer functions.
+*
+* @param	InstancePtr is a pointer to the XSpiPs instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XSpiPs_MsgFinish(XSpiPs *InstancePtr)
+{
+	u32 BaseAddr = InstancePtr->Config.BaseAddress;
+	u32 ConfigReg;
+
+	XSpiPs_WriteReg(BaseAddr, XSPIPS_IDR_OFFSET, XSPIPS_IXR_DFLT_MASK);
+	XSpiPs_WriteReg(BaseAddr, XSPIPS_TXWR_OFFSET, XSPIPS_TXWR_RESET_VALUE);
+
+	if (XSpiPs_IsManualChipSelect(InstancePtr) == TRUE) {
+		ConfigReg = XSpiPs_ReadReg(BaseAddr, XSPIPS_CR_OFFSET);
+		ConfigReg |= XSPIPS_CR_SSCTRL_MASK;
+		XSpiPs_WriteReg(BaseAddr, XSPIPS_CR_OFFSET, ConfigReg);
+	}
+
+	InstancePtr->MsgPtr = NULL;
+	InstancePtr->IsBusy = FALSE;
+	XSpiPs_Disable(InstancePtr);
 }
 
 /** @} */
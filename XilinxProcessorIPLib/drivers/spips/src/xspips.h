@@ -159,6 +159,17 @@
 * that another SPI device is acting as a master on the bus.
 *
 *
+* <b>Message Transfers</b>
+*
+* XSpiPs_MsgTransfer() and XSpiPs_PolledMsgTransfer() execute a list of
+* XSpiPs_Msg messages in master mode, each one to its own slave. Unlike
+* XSpiPs_Transfer(), which waits for the TX FIFO to empty before refilling
+* it, they keep the FIFO topped up from the TX FIFO watermark interrupt, so
+* that the bus does not idle between FIFO loads of a long message. The status
+* handler is called once with XST_SPI_TRANSFER_DONE when all the messages are
+* done. The controller data register is 8 bits wide, so the FIFO is accessed
+* one byte at a time.
+*
 * <b>Polled Operation</b>
 *
 * Transfer in polled mode is supported through a separate interface function
@@ -253,6 +264,8 @@
 * 3.3   mus    04/05/19 Replaced XPLAT_versal macro with XPLAT_VERSAL, to be in
 *                       sync with standalone BSP
 * 3.3   akm    08/06/19 Initialized DeviceID in XSpiPs_CfgInitialize function.
+* 3.3   adk    10/15/19 Added message list transfers which refill the FIFO
+*                       from the TX watermark interrupt.
 *
 * </pre>
 *
@@ -403,6 +416,17 @@ typedef struct {
 	u32 InputClockHz;	/**< Input clock frequency */
 } XSpiPs_Config;
 
+/**
+ * A message of a message list. The buffers follow the same rules as the ones
+ * of XSpiPs_Transfer().
+ */
+typedef struct {
+	u8 *SendBufPtr;		/**< Buffer to send, must not be NULL */
+	u8 *RecvBufPtr;		/**< Buffer to receive, may be NULL */
+	u32 ByteCount;		/**< Number of bytes to transfer */
+	u8 SlaveSel;		/**< Slave select, as for XSpiPs_SetSlaveSelect */
+} XSpiPs_Msg;
+
 /**
  * The XSpiPs driver instance data. The user is required to allocate a
  * variable of this type for every SPI device in the system. A pointer
@@ -423,6 +447,13 @@ typedef struct {
 	XSpiPs_StatusHandler StatusHandler;
 	void *StatusRef;  	 /**< Callback reference for status handler */
 
+	XSpiPs_Msg *MsgPtr;	 /**< Message list in progress (state) */
+	u32 MsgCount;		 /**< Number of messages in the list (state) */
+	u32 MsgIndex;		 /**< Message being transferred (state) */
+	u32 MsgBytes;		 /**< Bytes of the completed messages (state) */
+	u32 InFlight;		 /**< Bytes written to the TX FIFO and not yet
+				      read from the RX FIFO (state) */
+
 } XSpiPs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -676,6 +707,10 @@ void XSpiPs_InterruptHandler(XSpiPs *InstancePtr);
 
 void XSpiPs_Abort(XSpiPs *InstancePtr);
 
+s32 XSpiPs_MsgTransfer(XSpiPs *InstancePtr, XSpiPs_Msg *MsgPtr, u32 MsgCount);
+s32 XSpiPs_PolledMsgTransfer(XSpiPs *InstancePtr, XSpiPs_Msg *MsgPtr,
+				u32 MsgCount);
+
 s32 XSpiPs_SetSlaveSelect(XSpiPs *InstancePtr, u8 SlaveSel);
 u8 XSpiPs_GetSlaveSelect(const XSpiPs *InstancePtr);
 
@@ -0,0 +1,495 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xsrio_msg_throughput_example.c
+ *
+ * This file contains a throughput benchmark of the SRIO messaging layer
+ * between two nodes linked by SRIO. The same application runs on both
+ * nodes, NODE_IS_INITIATOR selects the role.
+ *
+ * H/W Requirements:
+ * On both nodes the SRIO Gen2 core is connected to two AXI DMA engines in
+ * simple mode: the first one to the initiator request (MM2S) and response
+ * (S2MM) streams, the second one to the target request (S2MM) and response
+ * (MM2S) streams. The device IDs of the streams are tied for the link
+ * partner.
+ *
+ * S/W Flow:
+ * 1) The target node exports WIN_SIZE bytes of memory at WIN_ADDR, posts
+ *    buffers to mailbox 0 and serves the requests forever. Every doorbell
+ *    received is counted and every message received is posted again.
+ * 2) The initiator node measures, with XTime_GetTime():
+ *    - NWRITE throughput, writing the window BENCH_ROUNDS times.
+ *    - NWRITE_R throughput.
+ *    - NREAD throughput, reading the window back and comparing it.
+ *    - Doorbells per second, one doorbell outstanding at a time.
+ *    - Message throughput, with XSRIO_MSG_MBOX_DEPTH messages of
+ *      MSG_SIZE bytes in flight.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 1.3   adk  10/15/19 First release
+ * </pre>
+ *
+ * ***************************************************************************
+ */
+
+/***************************** Include Files *********************************/
+#include "xparameters.h"
+#include "xil_printf.h"
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xtime_l.h"
+#include "xsrio.h"
+#include "xsrio_msg.h"
+#include "xaxidma.h"
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+#define SRIO_DEVICE_ID		XPAR_SRIO_0_DEVICE_ID
+#define INIT_DMA_DEV_ID		XPAR_AXIDMA_0_DEVICE_ID
+#define TARG_DMA_DEV_ID		XPAR_AXIDMA_1_DEVICE_ID
+
+#ifndef NODE_IS_INITIATOR
+#define NODE_IS_INITIATOR	1	/* 0 on the target node */
+#endif
+
+#define WIN_ADDR		0x10000000ULL	/* RapidIO address of the
+						 * target window */
+#define WIN_SIZE		0x10000U	/* Window size */
+#define BENCH_ROUNDS		64U		/* Window transfers per test */
+#define BENCH_DOORBELLS		10000U		/* Doorbells sent */
+#define MSG_SIZE		XSRIO_MSG_MAX_MSG_SIZE
+#define BENCH_MESSAGES		1000U		/* Messages sent */
+
+/******************** Variable Definitions **********************************/
+XSrio Srio;			/* Instance of the XSrio */
+XAxiDma InitDma;		/* Instance of the initiator XAxiDma */
+XAxiDma TargDma;		/* Instance of the target XAxiDma */
+XSrio_MsgEngine Engine;		/* Instance of the messaging engine */
+
+u8 WinBuf[WIN_SIZE] __attribute__ ((aligned(64)));
+u8 ReadBuf[WIN_SIZE] __attribute__ ((aligned(64)));
+u8 MsgBuf[XSRIO_MSG_MBOX_DEPTH][MSG_SIZE];
+XSrio_MboxDesc MboxDesc[XSRIO_MSG_MBOX_DEPTH];
+XSrio_Xfer Xfer[XSRIO_MSG_MBOX_DEPTH];
+
+/******************** Function Prototypes ************************************/
+int XSrioMsgThroughputExample(XSrio *InstancePtr, u16 DeviceId);
+static int DmaInit(XAxiDma *DmaPtr, u16 DeviceId);
+static void PrintRate(const char *Name, u64 Bytes, XTime Start, XTime End);
+static int RunTarget(void);
+static int RunInitiator(void);
+static int BenchWindow(u32 Op);
+static int BenchDoorbells(void);
+static int BenchMessages(void);
+
+/*****************************************************************************/
+/**
+*
+* Main function
+*
+* This function is the main entry of the SRIO messaging throughput test.
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if tests pass
+* 		- XST_FAILURE if fails.
+*
+* @note		The target node never returns.
+*
+******************************************************************************/
+int main()
+{
+	int Status;
+
+	xil_printf("Entering main\n\r");
+
+	Status = XSrioMsgThroughputExample(&Srio, SRIO_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf("SRIO Messaging Throughput Test Failed\n\r");
+		xil_printf("--- Exiting main() ---\n\r");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran SRIO Messaging Throughput Test\n\r");
+	xil_printf("--- Exiting main() ---\n\r");
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* XSrioMsgThroughputExample initializes the SRIO device, the DMA engines and
+* the messaging engine and runs the role of the node.
+*
+* @param	InstancePtr is a pointer to the instance of the
+*		XSrio driver.
+* @param	DeviceId is Device ID of the SRIO Gen2 Device.
+*
+* @return
+*		-XST_SUCCESS to indicate success
+*		-XST_FAILURE to indicate failure
+*
+******************************************************************************/
+int XSrioMsgThroughputExample(XSrio *InstancePtr, u16 DeviceId)
+{
+	XSrio_Config *SrioConfig;
+	int Status;
+
+	SrioConfig = XSrio_LookupConfig(DeviceId);
+	if (!SrioConfig) {
+		xil_printf("No SRIO config found for %d\r\n", DeviceId);
+		return XST_FAILURE;
+	}
+
+	Status = XSrio_CfgInitialize(InstancePtr, SrioConfig,
+				SrioConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Initialization failed for SRIO\n\r");
+		return Status;
+	}
+
+	if (XSrio_GetPortStatus(InstancePtr) != XSRIO_PORT_OK) {
+		xil_printf("SRIO link is not up\n\r");
+		return XST_FAILURE;
+	}
+
+	XSrio_SetWaterMark(InstancePtr, 0x5, 0x4, 0x3);
+	XSrio_SetPortRespTimeOutValue(InstancePtr, 0x010203);
+
+	if ((DmaInit(&InitDma, INIT_DMA_DEV_ID) != XST_SUCCESS) ||
+	    (DmaInit(&TargDma, TARG_DMA_DEV_ID) != XST_SUCCESS)) {
+		return XST_FAILURE;
+	}
+
+	Status = XSrio_MsgInitialize(&Engine, InstancePtr, &InitDma, &TargDma);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Messaging engine initialization failed\n\r");
+		return XST_FAILURE;
+	}
+
+	if (NODE_IS_INITIATOR) {
+		return RunInitiator();
+	}
+
+	return RunTarget();
+}
+
+/*****************************************************************************/
+/**
+* Initialize an AXI DMA engine in simple mode with its interrupts disabled.
+*
+* @param	DmaPtr is the DMA instance.
+* @param	DeviceId is the DMA device ID.
+*
+* @return	XST_SUCCESS or XST_FAILURE.
+*
+******************************************************************************/
+static int DmaInit(XAxiDma *DmaPtr, u16 DeviceId)
+{
+	XAxiDma_Config *DmaConfig;
+
+	DmaConfig = XAxiDma_LookupConfig(DeviceId);
+	if (!DmaConfig) {
+		xil_printf("No DMA config found for %d\r\n", DeviceId);
+		return XST_FAILURE;
+	}
+
+	if (XAxiDma_CfgInitialize(DmaPtr, DmaConfig) != XST_SUCCESS) {
+		xil_printf("DMA %d initialization failed\r\n", DeviceId);
+		return XST_FAILURE;
+	}
+
+	XAxiDma_IntrDisable(DmaPtr, XAXIDMA_IRQ_ALL_MASK,
+				XAXIDMA_DEVICE_TO_DMA);
+	XAxiDma_IntrDisable(DmaPtr, XAXIDMA_IRQ_ALL_MASK,
+				XAXIDMA_DMA_TO_DEVICE);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Print a throughput in MB/s.
+*
+* @param	Name is the name of the test.
+* @param	Bytes is the number of bytes moved.
+* @param	Start is the time stamp at the start of the test.
+* @param	End is the time stamp at the end of the test.
+*
+* @return	None.
+*
+******************************************************************************/
+static void PrintRate(const char *Name, u64 Bytes, XTime Start, XTime End)
+{
+	u64 Us = ((End - Start) * 1000000U) / (u64)COUNTS_PER_SECOND;
+
+	if (Us == 0U) {
+		Us = 1U;
+	}
+
+	xil_printf("%s: %d bytes in %d us, %d MB/s\r\n", Name, (u32)Bytes,
+			(u32)Us, (u32)(Bytes / Us));
+}
+
+/*****************************************************************************/
+/**
+* Serve the requests of the initiator node forever.
+*
+* @param	None.
+*
+* @return	XST_FAILURE if a mailbox descriptor cannot be posted.
+*
+******************************************************************************/
+static int RunTarget(void)
+{
+	u32 Doorbells = 0U;
+	u32 Messages = 0U;
+	u32 Index;
+	u16 Info;
+
+	XSrio_MsgSetWindow(&Engine, WIN_ADDR, WinBuf, WIN_SIZE);
+	for (Index = 0U; Index < XSRIO_MSG_MBOX_DEPTH; Index++) {
+		if (XSrio_MsgPostMbox(&Engine, 0U, &MboxDesc[Index],
+				MsgBuf[Index], MSG_SIZE) != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	xil_printf("Target node ready\r\n");
+
+	while (1) {
+		(void)XSrio_MsgService(&Engine);
+
+		while (XSrio_MsgRecvDoorbell(&Engine, &Info) == XST_SUCCESS) {
+			Doorbells++;
+			if ((Doorbells % BENCH_DOORBELLS) == 0U) {
+				xil_printf("%d doorbells received\r\n",
+						Doorbells);
+			}
+		}
+
+		for (Index = 0U; Index < XSRIO_MSG_MBOX_DEPTH; Index++) {
+			if (MboxDesc[Index].State < XSRIO_XFER_DONE) {
+				continue;
+			}
+			Messages++;
+			if ((Messages % BENCH_MESSAGES) == 0U) {
+				xil_printf("%d messages received\r\n",
+						Messages);
+			}
+			(void)XSrio_MsgPostMbox(&Engine, 0U, &MboxDesc[Index],
+						MsgBuf[Index], MSG_SIZE);
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Run the measurements of the initiator node.
+*
+* @param	None.
+*
+* @return	XST_SUCCESS or XST_FAILURE.
+*
+******************************************************************************/
+static int RunInitiator(void)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < WIN_SIZE; Index++) {
+		WinBuf[Index] = (u8)(Index * 7U);
+	}
+
+	if (BenchWindow(XSRIO_XFER_NWRITE) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	if (BenchWindow(XSRIO_XFER_NWRITE_R) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	if (BenchWindow(XSRIO_XFER_NREAD) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	for (Index = 0U; Index < WIN_SIZE; Index++) {
+		if (ReadBuf[Index] != WinBuf[Index]) {
+			xil_printf("Data mismatch at 0x%x\r\n", Index);
+			return XST_FAILURE;
+		}
+	}
+
+	if (BenchDoorbells() != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return BenchMessages();
+}
+
+/*****************************************************************************/
+/**
+* Move the window BENCH_ROUNDS times, one transfer of WIN_SIZE bytes at a
+* time.
+*
+* @param	Op is XSRIO_XFER_NWRITE, XSRIO_XFER_NWRITE_R or
+*		XSRIO_XFER_NREAD.
+*
+* @return	XST_SUCCESS or XST_FAILURE.
+*
+******************************************************************************/
+static int BenchWindow(u32 Op)
+{
+	XTime Start;
+	XTime End;
+	u32 Round;
+	int Status;
+
+	XTime_GetTime(&Start);
+	for (Round = 0U; Round < BENCH_ROUNDS; Round++) {
+		if (Op == XSRIO_XFER_NREAD) {
+			Status = XSrio_MsgNRead(&Engine, &Xfer[0], WIN_ADDR,
+						ReadBuf, WIN_SIZE);
+		} else {
+			Status = XSrio_MsgNWrite(&Engine, &Xfer[0], WIN_ADDR,
+					WinBuf, WIN_SIZE,
+					(Op == XSRIO_XFER_NWRITE_R) ? 1U : 0U);
+		}
+		if (Status == XST_SUCCESS) {
+			Status = XSrio_MsgWait(&Engine, &Xfer[0]);
+		}
+		if (Status != XST_SUCCESS) {
+			xil_printf("Transfer failed, status 0x%x\r\n",
+					Xfer[0].RespStatus);
+			return XST_FAILURE;
+		}
+	}
+	XTime_GetTime(&End);
+
+	PrintRate((Op == XSRIO_XFER_NREAD) ? "NREAD" :
+		  (Op == XSRIO_XFER_NWRITE_R) ? "NWRITE_R" : "NWRITE",
+		  (u64)WIN_SIZE * BENCH_ROUNDS, Start, End);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Send BENCH_DOORBELLS doorbells, sending again those answered with a RETRY.
+*
+* @param	None.
+*
+* @return	XST_SUCCESS or XST_FAILURE.
+*
+******************************************************************************/
+static int BenchDoorbells(void)
+{
+	XTime Start;
+	XTime End;
+	u32 Count = 0U;
+	u32 Us;
+
+	XTime_GetTime(&Start);
+	while (Count < BENCH_DOORBELLS) {
+		if (XSrio_MsgSendDoorbell(&Engine, &Xfer[0], (u16)Count) !=
+				XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		if (XSrio_MsgWait(&Engine, &Xfer[0]) == XST_SUCCESS) {
+			Count++;
+		} else if (Xfer[0].RespStatus != XSRIO_HELLO_STATUS_RETRY) {
+			xil_printf("Doorbell failed\r\n");
+			return XST_FAILURE;
+		}
+	}
+	XTime_GetTime(&End);
+
+	Us = (u32)(((End - Start) * 1000000U) / (u64)COUNTS_PER_SECOND);
+	xil_printf("DOORBELL: %d doorbells in %d us\r\n", BENCH_DOORBELLS, Us);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Send BENCH_MESSAGES messages to mailbox 0 with up to XSRIO_MSG_MBOX_DEPTH of
+* them in flight. Messages answered with a RETRY are sent again.
+*
+* @param	None.
+*
+* @return	XST_SUCCESS or XST_FAILURE.
+*
+******************************************************************************/
+static int BenchMessages(void)
+{
+	XTime Start;
+	XTime End;
+	u8 Busy[XSRIO_MSG_MBOX_DEPTH] = {0U};
+	u32 Sent = 0U;
+	u32 Done = 0U;
+	u32 Index;
+
+	XTime_GetTime(&Start);
+	while (Done < BENCH_MESSAGES) {
+		(void)XSrio_MsgService(&Engine);
+		for (Index = 0U; Index < XSRIO_MSG_MBOX_DEPTH; Index++) {
+			if (Busy[Index] != 0U) {
+				if (Xfer[Index].State < XSRIO_XFER_DONE) {
+					continue;
+				}
+				Busy[Index] = 0U;
+				if (Xfer[Index].State == XSRIO_XFER_DONE) {
+					Done++;
+				} else if (Xfer[Index].RespStatus ==
+						XSRIO_HELLO_STATUS_RETRY) {
+					Sent--;
+				} else {
+					xil_printf("Message failed\r\n");
+					return XST_FAILURE;
+				}
+			}
+			if ((Sent < BENCH_MESSAGES) &&
+			    (XSrio_MsgSendMessage(&Engine, &Xfer[Index], 0U,
+					0U, WinBuf, MSG_SIZE) == XST_SUCCESS)) {
+				Busy[Index] = 1U;
+				Sent++;
+			}
+		}
+	}
+	XTime_GetTime(&End);
+
+	PrintRate("MESSAGE", (u64)MSG_SIZE * BENCH_MESSAGES, Start, End);
+
+	return XST_SUCCESS;
+}
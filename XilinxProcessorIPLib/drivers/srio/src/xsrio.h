@@ -66,10 +66,16 @@
 * <b>Interrupts</b>
 * There are no interrupts available for the SRIO Gen2 Core.
 *
+* <b>Messaging</b>
+* xsrio_msg.h provides doorbells, mailbox messages and NREAD/NWRITE transfers
+* over the user interfaces of the core when they are connected to AXI DMA
+* engines in simple mode.
+*
 * <b> Examples </b>
 *
 * There is an example provided to show the usage of the APIs
 * - SRIO Dma loopback example (xsrio_dma_loopback_example.c)
+* - SRIO messaging throughput example (xsrio_msg_throughput_example.c)
 *
 * <b> Asserts </b>
 *
@@ -103,6 +109,8 @@
 *                     srio examples for proper documentation while
 *                     generating doxygen.
 * 1.2   adk  30/07/19 Fix portwidth handling in the XSrio_CfgInitialize() API.
+* 1.3   adk  10/15/19 Added the messaging layer (xsrio_msg.c) and the
+*                     messaging throughput example.
 * </pre>
 ******************************************************************************/
 
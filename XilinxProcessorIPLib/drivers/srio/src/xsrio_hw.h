@@ -41,6 +41,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- --------------------------------------------------------- 
 * 1.0   adk  16/04/14 Initial release.
+* 1.3   adk  10/15/19 Added the HELLO packet header definitions used by the
+*                     messaging layer.
 * 
 ******************************************************************************/
 
@@ -623,6 +625,58 @@ extern "C" {
 
 /*@}*/
 
+/** @name HELLO packet header definitions.
+ *  The 64 bit header leads every packet of the initiator and target request
+ *  and response streams. It is stored in memory as the lower word followed
+ *  by the upper word. Doorbell, message and response fields are carried in
+ *  the address field.
+ * @{
+ */
+#define XSRIO_HELLO_HDR_SIZE		8U	/**< Header size in bytes */
+#define XSRIO_HELLO_MAX_PAYLOAD		256U	/**< Maximum payload size */
+
+#define XSRIO_HELLO_TID_SHIFT		56U	/**< Transaction ID */
+#define XSRIO_HELLO_FTYPE_SHIFT		52U	/**< Format type */
+#define XSRIO_HELLO_TTYPE_SHIFT		48U	/**< Transaction type */
+#define XSRIO_HELLO_PRIO_SHIFT		45U	/**< Priority */
+#define XSRIO_HELLO_CRF_SHIFT		44U	/**< Critical request flow */
+#define XSRIO_HELLO_SIZE_SHIFT		36U	/**< Payload size - 1 */
+#define XSRIO_HELLO_TID_MASK		0xFFU
+#define XSRIO_HELLO_FTYPE_MASK		0xFU
+#define XSRIO_HELLO_TTYPE_MASK		0xFU
+#define XSRIO_HELLO_PRIO_MASK		0x3U
+#define XSRIO_HELLO_SIZE_MASK		0xFFU
+#define XSRIO_HELLO_ADDR_MASK		0x3FFFFFFFFULL	/**< 34 bit address */
+
+#define XSRIO_HELLO_FTYPE_NREAD		0x2U	/**< NREAD, TTYPE 4 */
+#define XSRIO_HELLO_FTYPE_WRITE		0x5U	/**< NWRITE, NWRITE_R */
+#define XSRIO_HELLO_FTYPE_SWRITE	0x6U	/**< SWRITE */
+#define XSRIO_HELLO_FTYPE_DOORBELL	0xAU	/**< DOORBELL */
+#define XSRIO_HELLO_FTYPE_MESSAGE	0xBU	/**< MESSAGE */
+#define XSRIO_HELLO_FTYPE_RESPONSE	0xDU	/**< RESPONSE */
+
+#define XSRIO_HELLO_TTYPE_NREAD		0x4U	/**< NREAD */
+#define XSRIO_HELLO_TTYPE_NWRITE	0x4U	/**< NWRITE */
+#define XSRIO_HELLO_TTYPE_NWRITE_R	0x5U	/**< NWRITE_R */
+#define XSRIO_HELLO_TTYPE_RESP_NODATA	0x0U	/**< Response without data */
+#define XSRIO_HELLO_TTYPE_RESP_MSG	0x1U	/**< Message response */
+#define XSRIO_HELLO_TTYPE_RESP_DATA	0x8U	/**< Response with data */
+
+#define XSRIO_HELLO_STATUS_MASK		0xFU	/**< Response status */
+#define XSRIO_HELLO_STATUS_DONE		0x0U	/**< Done */
+#define XSRIO_HELLO_STATUS_RETRY	0x3U	/**< Retry */
+#define XSRIO_HELLO_STATUS_ERROR	0x7U	/**< Error */
+
+#define XSRIO_HELLO_DB_INFO_MASK	0xFFFFU	/**< Doorbell information */
+#define XSRIO_HELLO_MSG_SEG_SHIFT	0U	/**< Message segment */
+#define XSRIO_HELLO_MSG_LEN_SHIFT	4U	/**< Message segments - 1 */
+#define XSRIO_HELLO_MSG_LETTER_SHIFT	8U	/**< Message letter */
+#define XSRIO_HELLO_MSG_MBOX_SHIFT	10U	/**< Mailbox */
+#define XSRIO_HELLO_MSG_SEG_MASK	0xFU
+#define XSRIO_HELLO_MSG_LETTER_MASK	0x3U
+#define XSRIO_HELLO_MSG_MBOX_MASK	0x3U
+/*@}*/
+
 /****************** Macros (Inline Functions) Definitions ********************/
 /*****************************************************************************/
 /**
@@ -0,0 +1,1188 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsrio_msg.c
+* @addtogroup srio_v1_2
+* @{
+* This file contains the messaging layer of the XSrio driver. See the
+* xsrio_msg.h header file for more details.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.3   adk  10/15/19 First release
+* </pre>
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xsrio_msg.h"
+
+#ifdef XPAR_XAXIDMA_NUM_INSTANCES
+#include "xil_cache.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XSRIO_MSG_WAIT_COUNT	10000000U	/**< XSrio_MsgWait() polls */
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static void XSrio_MsgPutHdr(u8 *BufPtr, u64 Hdr);
+static u64 XSrio_MsgGetHdr(const u8 *BufPtr);
+static u64 XSrio_MsgHdr(u32 Tid, u32 Ftype, u32 Ttype, u32 Prio, u32 Size,
+			u64 Addr);
+static u32 XSrio_MsgBitCount(u32 Value);
+static int XSrio_MsgQueue(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr);
+static void XSrio_MsgCheckDone(XSrio_MsgEngine *EnginePtr,
+				XSrio_Xfer *XferPtr);
+static void XSrio_MsgFrame(XSrio_MsgEngine *EnginePtr);
+static void XSrio_MsgResponse(XSrio_MsgEngine *EnginePtr, u32 Len);
+static void XSrio_MsgRespond(XSrio_MsgEngine *EnginePtr, u64 ReqHdr,
+			u32 Ttype, u32 Status, const u8 *DataPtr, u32 DataLen);
+static u8 *XSrio_MsgInWindow(XSrio_MsgEngine *EnginePtr, u64 Addr, u32 Len);
+static u32 XSrio_MsgSegment(XSrio_MsgEngine *EnginePtr, u64 Addr,
+			const u8 *DataPtr, u32 DataLen);
+static void XSrio_MsgRequest(XSrio_MsgEngine *EnginePtr, u32 Len);
+
+/****************************************************************************/
+/**
+* Initialize a messaging engine.
+*
+* @param	EnginePtr is the engine to initialize.
+* @param	SrioPtr is the initialized SRIO Gen2 instance.
+* @param	InitDmaPtr is the initialized DMA connected to the initiator
+*		request and response streams.
+* @param	TargDmaPtr is the initialized DMA connected to the target
+*		request and response streams, or NULL when the node does not
+*		serve inbound requests.
+*
+* @return
+*		- XST_SUCCESS if the engine is initialized.
+*		- XST_INVALID_PARAM if a DMA is in scatter gather mode.
+*
+* @note		The S2MM channels are armed before returning.
+*****************************************************************************/
+int XSrio_MsgInitialize(XSrio_MsgEngine *EnginePtr, XSrio *SrioPtr,
+			XAxiDma *InitDmaPtr, XAxiDma *TargDmaPtr)
+{
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(SrioPtr != NULL);
+	Xil_AssertNonvoid(InitDmaPtr != NULL);
+
+	if (XAxiDma_HasSg(InitDmaPtr) ||
+	    ((TargDmaPtr != NULL) && XAxiDma_HasSg(TargDmaPtr))) {
+		return XST_INVALID_PARAM;
+	}
+
+	memset(EnginePtr, 0, sizeof(XSrio_MsgEngine));
+	EnginePtr->SrioPtr = SrioPtr;
+	EnginePtr->InitDmaPtr = InitDmaPtr;
+	EnginePtr->TargDmaPtr = TargDmaPtr;
+	EnginePtr->TidFree = 0xFFFFFFFFU;
+	EnginePtr->TidNext = XSRIO_MSG_MAX_TIDS;
+	EnginePtr->IsReady = XIL_COMPONENT_IS_READY;
+
+	(void)XSrio_MsgService(EnginePtr);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* Set the handlers called on transfer completion and message reception.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	XferHandler is called when an outbound transfer completes,
+*		may be NULL.
+* @param	MboxHandler is called when a message has been received, may
+*		be NULL.
+* @param	CallBackRef is passed to the handlers.
+*
+* @return	None.
+*
+* @note		The handlers run from XSrio_MsgService() and may queue new
+*		transfers or post mailbox descriptors.
+*****************************************************************************/
+void XSrio_MsgSetHandlers(XSrio_MsgEngine *EnginePtr,
+			XSrio_XferHandler XferHandler,
+			XSrio_MboxHandler MboxHandler, void *CallBackRef)
+{
+	Xil_AssertVoid(EnginePtr != NULL);
+
+	EnginePtr->XferHandler = XferHandler;
+	EnginePtr->MboxHandler = MboxHandler;
+	EnginePtr->CallBackRef = CallBackRef;
+}
+
+/****************************************************************************/
+/**
+* Set the memory window which serves inbound NREAD, NWRITE and NWRITE_R
+* requests.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	Addr is the RapidIO address of the window.
+* @param	WinPtr is the local memory of the window, NULL to answer all
+*		the requests with an ERROR.
+* @param	Size is the size of the window in bytes.
+*
+* @return	None.
+*
+* @note		None.
+*****************************************************************************/
+void XSrio_MsgSetWindow(XSrio_MsgEngine *EnginePtr, u64 Addr, u8 *WinPtr,
+			u32 Size)
+{
+	Xil_AssertVoid(EnginePtr != NULL);
+
+	EnginePtr->WinAddr = Addr;
+	EnginePtr->WinPtr = WinPtr;
+	EnginePtr->WinSize = Size;
+}
+
+/****************************************************************************/
+/**
+* Queue a NREAD transfer.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	XferPtr is the transfer, owned by the engine until it
+*		completes.
+* @param	Addr is the RapidIO address to read from.
+* @param	BufPtr is the buffer the data is read to.
+* @param	Len is the number of bytes to read.
+*
+* @return
+*		- XST_SUCCESS if the transfer is queued.
+*		- XST_INVALID_PARAM if the range is outside the 34 bit
+*		  address space.
+*		- XST_DEVICE_BUSY if the transfer queue is full.
+*
+* @note		None.
+*****************************************************************************/
+int XSrio_MsgNRead(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr,
+			u64 Addr, u8 *BufPtr, u32 Len)
+{
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(EnginePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(XferPtr != NULL);
+	Xil_AssertNonvoid(BufPtr != NULL);
+
+	if ((Len == 0U) || ((Addr + Len - 1U) > XSRIO_HELLO_ADDR_MASK)) {
+		return XST_INVALID_PARAM;
+	}
+
+	XferPtr->Op = XSRIO_XFER_NREAD;
+	XferPtr->Addr = Addr;
+	XferPtr->BufPtr = BufPtr;
+	XferPtr->Len = Len;
+
+	return XSrio_MsgQueue(EnginePtr, XferPtr);
+}
+
+/****************************************************************************/
+/**
+* Queue a NWRITE or NWRITE_R transfer.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	XferPtr is the transfer, owned by the engine until it
+*		completes.
+* @param	Addr is the RapidIO address to write to.
+* @param	BufPtr is the data to write. It is copied as the packets are
+*		framed and must not change until the transfer completes.
+* @param	Len is the number of bytes to write.
+* @param	WithResp selects NWRITE_R when non zero. A NWRITE transfer
+*		completes once its packets are sent.
+*
+* @return
+*		- XST_SUCCESS if the transfer is queued.
+*		- XST_INVALID_PARAM if the range is outside the 34 bit
+*		  address space.
+*		- XST_DEVICE_BUSY if the transfer queue is full.
+*
+* @note		None.
+*****************************************************************************/
+int XSrio_MsgNWrite(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr,
+			u64 Addr, const u8 *BufPtr, u32 Len, u32 WithResp)
+{
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(EnginePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(XferPtr != NULL);
+	Xil_AssertNonvoid(BufPtr != NULL);
+
+	if ((Len == 0U) || ((Addr + Len - 1U) > XSRIO_HELLO_ADDR_MASK)) {
+		return XST_INVALID_PARAM;
+	}
+
+	XferPtr->Op = (WithResp != 0U) ? XSRIO_XFER_NWRITE_R :
+					XSRIO_XFER_NWRITE;
+	XferPtr->Addr = Addr;
+	XferPtr->BufPtr = (u8 *)BufPtr;
+	XferPtr->Len = Len;
+
+	return XSrio_MsgQueue(EnginePtr, XferPtr);
+}
+
+/****************************************************************************/
+/**
+* Queue a doorbell.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	XferPtr is the transfer, owned by the engine until it
+*		completes.
+* @param	Info is the doorbell information.
+*
+* @return
+*		- XST_SUCCESS if the doorbell is queued.
+*		- XST_DEVICE_BUSY if the transfer queue is full.
+*
+* @note		A RETRY response of a busy target completes the transfer
+*		with XSRIO_XFER_ERROR, it is up to the caller to send again.
+*****************************************************************************/
+int XSrio_MsgSendDoorbell(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr,
+			u16 Info)
+{
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(EnginePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(XferPtr != NULL);
+
+	XferPtr->Op = XSRIO_XFER_DOORBELL;
+	XferPtr->Info = Info;
+	XferPtr->BufPtr = NULL;
+	XferPtr->Len = 0U;
+
+	return XSrio_MsgQueue(EnginePtr, XferPtr);
+}
+
+/****************************************************************************/
+/**
+* Queue a message.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	XferPtr is the transfer, owned by the engine until it
+*		completes.
+* @param	Mbox is the destination mailbox.
+* @param	Letter is the message letter.
+* @param	BufPtr is the message. It is copied as the segments are framed
+*		and must not change until the transfer completes.
+* @param	Len is the message length, up to XSRIO_MSG_MAX_MSG_SIZE. The
+*		message is sent in segments of 256 bytes.
+*
+* @return
+*		- XST_SUCCESS if the message is queued.
+*		- XST_INVALID_PARAM if a parameter is out of range.
+*		- XST_DEVICE_BUSY if the transfer queue is full.
+*
+* @note		None.
+*****************************************************************************/
+int XSrio_MsgSendMessage(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr,
+			u8 Mbox, u8 Letter, const u8 *BufPtr, u32 Len)
+{
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(EnginePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(XferPtr != NULL);
+	Xil_AssertNonvoid(BufPtr != NULL);
+
+	if ((Len == 0U) || (Len > XSRIO_MSG_MAX_MSG_SIZE) ||
+	    (Mbox >= XSRIO_MSG_NUM_MBOX) ||
+	    (Letter > XSRIO_HELLO_MSG_LETTER_MASK)) {
+		return XST_INVALID_PARAM;
+	}
+
+	XferPtr->Op = XSRIO_XFER_MESSAGE;
+	XferPtr->Mbox = Mbox;
+	XferPtr->Letter = Letter;
+	XferPtr->BufPtr = (u8 *)BufPtr;
+	XferPtr->Len = Len;
+
+	return XSrio_MsgQueue(EnginePtr, XferPtr);
+}
+
+/****************************************************************************/
+/**
+* Read the oldest doorbell received.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	InfoPtr is where the doorbell information is returned.
+*
+* @return
+*		- XST_SUCCESS if a doorbell was read.
+*		- XST_NO_DATA if no doorbell is queued.
+*
+* @note		None.
+*****************************************************************************/
+int XSrio_MsgRecvDoorbell(XSrio_MsgEngine *EnginePtr, u16 *InfoPtr)
+{
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(InfoPtr != NULL);
+
+	if (EnginePtr->DbCount == 0U) {
+		(void)XSrio_MsgService(EnginePtr);
+		if (EnginePtr->DbCount == 0U) {
+			return XST_NO_DATA;
+		}
+	}
+
+	*InfoPtr = EnginePtr->DbQueue[EnginePtr->DbHead];
+	EnginePtr->DbHead = (EnginePtr->DbHead + 1U) % XSRIO_MSG_DB_DEPTH;
+	EnginePtr->DbCount--;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* Post a receive descriptor to a mailbox. Messages are received in the posted
+* descriptors in order.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	Mbox is the mailbox.
+* @param	DescPtr is the descriptor, owned by the engine until its State
+*		is XSRIO_XFER_DONE or XSRIO_XFER_ERROR.
+* @param	BufPtr is the message buffer.
+* @param	Size is the size of the buffer.
+*
+* @return
+*		- XST_SUCCESS if the descriptor is posted.
+*		- XST_INVALID_PARAM if Mbox is out of range.
+*		- XST_DEVICE_BUSY if the mailbox holds XSRIO_MSG_MBOX_DEPTH
+*		  descriptors.
+*
+* @note		None.
+*****************************************************************************/
+int XSrio_MsgPostMbox(XSrio_MsgEngine *EnginePtr, u8 Mbox,
+			XSrio_MboxDesc *DescPtr, u8 *BufPtr, u32 Size)
+{
+	u32 Idx;
+
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(DescPtr != NULL);
+	Xil_AssertNonvoid(BufPtr != NULL);
+
+	if (Mbox >= XSRIO_MSG_NUM_MBOX) {
+		return XST_INVALID_PARAM;
+	}
+	if (EnginePtr->MboxCount[Mbox] == XSRIO_MSG_MBOX_DEPTH) {
+		return XST_DEVICE_BUSY;
+	}
+
+	DescPtr->BufPtr = BufPtr;
+	DescPtr->Size = Size;
+	DescPtr->Len = 0U;
+	DescPtr->SegSize = 0U;
+	DescPtr->SegsSeen = 0U;
+	DescPtr->NumSegs = 0U;
+	DescPtr->Letter = 0U;
+	DescPtr->State = XSRIO_XFER_QUEUED;
+
+	Idx = (EnginePtr->MboxHead[Mbox] + EnginePtr->MboxCount[Mbox]) %
+		XSRIO_MSG_MBOX_DEPTH;
+	EnginePtr->Mbox[Mbox][Idx] = DescPtr;
+	EnginePtr->MboxCount[Mbox]++;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* Make progress on the four streams: complete the DMA transfers, process the
+* responses and requests received, frame and send the next packets and arm
+* the S2MM channels again.
+*
+* @param	EnginePtr is the engine to operate on.
+*
+* @return	Number of packets processed.
+*
+* @note		None.
+*****************************************************************************/
+u32 XSrio_MsgService(XSrio_MsgEngine *EnginePtr)
+{
+	XAxiDma *DmaPtr;
+	XSrio_Xfer *XferPtr;
+	u32 Events = 0U;
+	u32 Idx;
+
+	Xil_AssertNonvoid(EnginePtr != NULL);
+
+	DmaPtr = EnginePtr->InitDmaPtr;
+
+	/* Responses first, they free the transaction IDs */
+	if ((EnginePtr->IrespActive != 0U) &&
+	    (XAxiDma_Busy(DmaPtr, XAXIDMA_DEVICE_TO_DMA) == FALSE)) {
+		EnginePtr->IrespActive = 0U;
+		Xil_DCacheInvalidateRange((UINTPTR)EnginePtr->IrespBuf,
+					XSRIO_MSG_BUF_SIZE);
+		XSrio_MsgResponse(EnginePtr, XAxiDma_ReadReg(DmaPtr->RegBase,
+				XAXIDMA_RX_OFFSET + XAXIDMA_BUFFLEN_OFFSET));
+		Events++;
+	}
+	if (EnginePtr->IrespActive == 0U) {
+		Xil_DCacheInvalidateRange((UINTPTR)EnginePtr->IrespBuf,
+					XSRIO_MSG_BUF_SIZE);
+		if (XAxiDma_SimpleTransfer(DmaPtr, (UINTPTR)EnginePtr->IrespBuf,
+				XSRIO_MSG_BUF_SIZE, XAXIDMA_DEVICE_TO_DMA) ==
+				XST_SUCCESS) {
+			EnginePtr->IrespActive = 1U;
+		}
+	}
+
+	/* Requests, the next frame is built while the previous one is sent */
+	if ((EnginePtr->TxActive != 0U) &&
+	    (XAxiDma_Busy(DmaPtr, XAXIDMA_DMA_TO_DEVICE) == FALSE)) {
+		EnginePtr->TxActive = 0U;
+		EnginePtr->Stats.TxPackets++;
+		Idx = EnginePtr->TxIdx ^ 1U;
+		XferPtr = EnginePtr->TxUntracked[Idx];
+		if (XferPtr != NULL) {
+			EnginePtr->TxUntracked[Idx] = NULL;
+			XferPtr->Pending--;
+			XSrio_MsgCheckDone(EnginePtr, XferPtr);
+		}
+		Events++;
+	}
+	XSrio_MsgFrame(EnginePtr);
+	if ((EnginePtr->TxActive == 0U) && (EnginePtr->TxReady != 0U)) {
+		Idx = EnginePtr->TxIdx;
+		if (XAxiDma_SimpleTransfer(DmaPtr,
+				(UINTPTR)EnginePtr->TxBuf[Idx],
+				EnginePtr->TxLen[Idx],
+				XAXIDMA_DMA_TO_DEVICE) == XST_SUCCESS) {
+			EnginePtr->TxActive = 1U;
+			EnginePtr->TxReady = 0U;
+			EnginePtr->TxIdx = Idx ^ 1U;
+			XSrio_MsgFrame(EnginePtr);
+		}
+	}
+
+	DmaPtr = EnginePtr->TargDmaPtr;
+	if (DmaPtr == NULL) {
+		return Events;
+	}
+
+	if ((EnginePtr->TrespActive != 0U) &&
+	    (XAxiDma_Busy(DmaPtr, XAXIDMA_DMA_TO_DEVICE) == FALSE)) {
+		EnginePtr->TrespActive = 0U;
+		EnginePtr->TrespHead = (EnginePtr->TrespHead + 1U) %
+					XSRIO_MSG_RESP_DEPTH;
+		EnginePtr->TrespCount--;
+	}
+	if ((EnginePtr->TreqActive != 0U) &&
+	    (XAxiDma_Busy(DmaPtr, XAXIDMA_DEVICE_TO_DMA) == FALSE)) {
+		EnginePtr->TreqActive = 0U;
+		EnginePtr->TreqHeld = 1U;
+		EnginePtr->TreqLen = XAxiDma_ReadReg(DmaPtr->RegBase,
+				XAXIDMA_RX_OFFSET + XAXIDMA_BUFFLEN_OFFSET);
+		Xil_DCacheInvalidateRange((UINTPTR)EnginePtr->TreqBuf,
+					XSRIO_MSG_BUF_SIZE);
+	}
+
+	/* A request is processed once a response frame is free for it */
+	if ((EnginePtr->TreqHeld != 0U) &&
+	    (EnginePtr->TrespCount < XSRIO_MSG_RESP_DEPTH)) {
+		EnginePtr->TreqHeld = 0U;
+		XSrio_MsgRequest(EnginePtr, EnginePtr->TreqLen);
+		Events++;
+	}
+	if ((EnginePtr->TreqActive == 0U) && (EnginePtr->TreqHeld == 0U)) {
+		Xil_DCacheInvalidateRange((UINTPTR)EnginePtr->TreqBuf,
+					XSRIO_MSG_BUF_SIZE);
+		if (XAxiDma_SimpleTransfer(DmaPtr, (UINTPTR)EnginePtr->TreqBuf,
+				XSRIO_MSG_BUF_SIZE, XAXIDMA_DEVICE_TO_DMA) ==
+				XST_SUCCESS) {
+			EnginePtr->TreqActive = 1U;
+		}
+	}
+	if ((EnginePtr->TrespActive == 0U) && (EnginePtr->TrespCount != 0U)) {
+		Idx = EnginePtr->TrespHead;
+		if (XAxiDma_SimpleTransfer(DmaPtr,
+				(UINTPTR)EnginePtr->TrespBuf[Idx],
+				EnginePtr->TrespLen[Idx],
+				XAXIDMA_DMA_TO_DEVICE) == XST_SUCCESS) {
+			EnginePtr->TrespActive = 1U;
+		}
+	}
+
+	return Events;
+}
+
+/****************************************************************************/
+/**
+* Service the engine until a transfer completes.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	XferPtr is the transfer to wait for.
+*
+* @return
+*		- XST_SUCCESS if the transfer completed with XSRIO_XFER_DONE.
+*		- XST_FAILURE if it completed with XSRIO_XFER_ERROR or did
+*		  not complete in XSRIO_MSG_WAIT_COUNT polls, in which case
+*		  it is still owned by the engine.
+*
+* @note		None.
+*****************************************************************************/
+int XSrio_MsgWait(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr)
+{
+	u32 Count = XSRIO_MSG_WAIT_COUNT;
+
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(XferPtr != NULL);
+
+	while ((XferPtr->State < XSRIO_XFER_DONE) && (Count > 0U)) {
+		(void)XSrio_MsgService(EnginePtr);
+		Count--;
+	}
+
+	return (XferPtr->State == XSRIO_XFER_DONE) ? XST_SUCCESS :
+			XST_FAILURE;
+}
+
+/****************************************************************************/
+/**
+* Return the number of outbound transfers queued plus the number of packets
+* being sent or awaiting a response.
+*
+* @param	EnginePtr is the engine to operate on.
+*
+* @return	Work pending, 0 when the engine is idle.
+*
+* @note		None.
+*****************************************************************************/
+u32 XSrio_MsgPending(XSrio_MsgEngine *EnginePtr)
+{
+	Xil_AssertNonvoid(EnginePtr != NULL);
+
+	return EnginePtr->TxCount + EnginePtr->TxReady + EnginePtr->TxActive +
+		(XSRIO_MSG_MAX_TIDS - XSrio_MsgBitCount(EnginePtr->TidFree));
+}
+
+/*****************************************************************************/
+/**
+* Store a HELLO header, lower word first.
+*
+* @param	BufPtr is the packet buffer.
+* @param	Hdr is the header.
+*
+* @return	None.
+*
+* @note		None.
+******************************************************************************/
+static void XSrio_MsgPutHdr(u8 *BufPtr, u64 Hdr)
+{
+	u32 *WordPtr = (u32 *)BufPtr;
+
+	WordPtr[0] = (u32)Hdr;
+	WordPtr[1] = (u32)(Hdr >> 32);
+}
+
+/*****************************************************************************/
+/**
+* Load a HELLO header.
+*
+* @param	BufPtr is the packet buffer.
+*
+* @return	The header.
+*
+* @note		None.
+******************************************************************************/
+static u64 XSrio_MsgGetHdr(const u8 *BufPtr)
+{
+	const u32 *WordPtr = (const u32 *)BufPtr;
+
+	return ((u64)WordPtr[1] << 32) | WordPtr[0];
+}
+
+/*****************************************************************************/
+/**
+* Build a HELLO header.
+*
+* @param	Tid is the transaction ID.
+* @param	Ftype is the format type.
+* @param	Ttype is the transaction type.
+* @param	Prio is the priority.
+* @param	Size is the payload size in bytes, 0 for a packet without
+*		payload.
+* @param	Addr is the address field.
+*
+* @return	The header.
+*
+* @note		None.
+******************************************************************************/
+static u64 XSrio_MsgHdr(u32 Tid, u32 Ftype, u32 Ttype, u32 Prio, u32 Size,
+			u64 Addr)
+{
+	u32 SizeField = (Size != 0U) ? (Size - 1U) : 0U;
+
+	return ((u64)(Tid & XSRIO_HELLO_TID_MASK) << XSRIO_HELLO_TID_SHIFT) |
+		((u64)(Ftype & XSRIO_HELLO_FTYPE_MASK) <<
+			XSRIO_HELLO_FTYPE_SHIFT) |
+		((u64)(Ttype & XSRIO_HELLO_TTYPE_MASK) <<
+			XSRIO_HELLO_TTYPE_SHIFT) |
+		((u64)(Prio & XSRIO_HELLO_PRIO_MASK) <<
+			XSRIO_HELLO_PRIO_SHIFT) |
+		((u64)(SizeField & XSRIO_HELLO_SIZE_MASK) <<
+			XSRIO_HELLO_SIZE_SHIFT) |
+		(Addr & XSRIO_HELLO_ADDR_MASK);
+}
+
+/*****************************************************************************/
+/**
+* Count the bits set in a word.
+*
+* @param	Value is the word.
+*
+* @return	Number of bits set.
+*
+* @note		None.
+******************************************************************************/
+static u32 XSrio_MsgBitCount(u32 Value)
+{
+	u32 Count = 0U;
+	u32 Bits = Value;
+
+	while (Bits != 0U) {
+		Bits &= Bits - 1U;
+		Count++;
+	}
+
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+* Append a transfer to the transfer queue.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	XferPtr is the transfer.
+*
+* @return
+*		- XST_SUCCESS if the transfer is queued.
+*		- XST_DEVICE_BUSY if the queue is full.
+*
+* @note		None.
+******************************************************************************/
+static int XSrio_MsgQueue(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr)
+{
+	u32 Idx;
+
+	if (EnginePtr->TxCount == XSRIO_MSG_TX_DEPTH) {
+		return XST_DEVICE_BUSY;
+	}
+
+	XferPtr->Offset = 0U;
+	XferPtr->Pending = 0U;
+	XferPtr->Framed = 0U;
+	XferPtr->RespStatus = XSRIO_HELLO_STATUS_DONE;
+	XferPtr->State = XSRIO_XFER_QUEUED;
+
+	Idx = (EnginePtr->TxHead + EnginePtr->TxCount) % XSRIO_MSG_TX_DEPTH;
+	EnginePtr->TxQueue[Idx] = XferPtr;
+	EnginePtr->TxCount++;
+
+	(void)XSrio_MsgService(EnginePtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Complete a transfer once its last packet has been framed and every packet
+* has been sent or answered.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	XferPtr is the transfer.
+*
+* @return	None.
+*
+* @note		None.
+******************************************************************************/
+static void XSrio_MsgCheckDone(XSrio_MsgEngine *EnginePtr,
+				XSrio_Xfer *XferPtr)
+{
+	if ((XferPtr->Framed == 0U) || (XferPtr->Pending != 0U)) {
+		return;
+	}
+
+	XferPtr->State = (XferPtr->RespStatus == XSRIO_HELLO_STATUS_DONE) ?
+			XSRIO_XFER_DONE : XSRIO_XFER_ERROR;
+	if (EnginePtr->XferHandler != NULL) {
+		EnginePtr->XferHandler(EnginePtr->CallBackRef, XferPtr);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Frame the next packet of the oldest queued transfer in the free ping pong
+* buffer. Nothing is framed while the buffer holds a frame not yet sent, or
+* when the packet needs a transaction ID and all of them are outstanding.
+*
+* @param	EnginePtr is the engine to operate on.
+*
+* @return	None.
+*
+* @note		NREAD and NWRITE packets do not cross a 256 byte address
+*		boundary.
+******************************************************************************/
+static void XSrio_MsgFrame(XSrio_MsgEngine *EnginePtr)
+{
+	XSrio_Xfer *XferPtr;
+	u8 *BufPtr;
+	u64 Addr;
+	u32 Chunk;
+	u32 FrameLen;
+	u32 Ftype;
+	u32 Ttype;
+	u32 Tid;
+	u32 NumSegs;
+	u32 Idx = EnginePtr->TxIdx;
+	u32 Tracked;
+
+	if ((EnginePtr->TxReady != 0U) || (EnginePtr->TxCount == 0U)) {
+		return;
+	}
+
+	XferPtr = EnginePtr->TxQueue[EnginePtr->TxHead];
+	Tracked = (XferPtr->Op != XSRIO_XFER_NWRITE) ? 1U : 0U;
+	if ((Tracked != 0U) && (EnginePtr->TidFree == 0U)) {
+		return;
+	}
+
+	BufPtr = EnginePtr->TxBuf[Idx];
+	Chunk = XferPtr->Len - XferPtr->Offset;
+	if (Chunk > XSRIO_HELLO_MAX_PAYLOAD) {
+		Chunk = XSRIO_HELLO_MAX_PAYLOAD;
+	}
+
+	switch (XferPtr->Op) {
+	case XSRIO_XFER_NREAD:
+		Ftype = XSRIO_HELLO_FTYPE_NREAD;
+		Ttype = XSRIO_HELLO_TTYPE_NREAD;
+		break;
+	case XSRIO_XFER_NWRITE:
+		Ftype = XSRIO_HELLO_FTYPE_WRITE;
+		Ttype = XSRIO_HELLO_TTYPE_NWRITE;
+		break;
+	case XSRIO_XFER_NWRITE_R:
+		Ftype = XSRIO_HELLO_FTYPE_WRITE;
+		Ttype = XSRIO_HELLO_TTYPE_NWRITE_R;
+		break;
+	case XSRIO_XFER_DOORBELL:
+		Ftype = XSRIO_HELLO_FTYPE_DOORBELL;
+		Ttype = 0U;
+		break;
+	default:
+		Ftype = XSRIO_HELLO_FTYPE_MESSAGE;
+		Ttype = 0U;
+		break;
+	}
+
+	if (Ftype == XSRIO_HELLO_FTYPE_DOORBELL) {
+		Addr = XferPtr->Info & XSRIO_HELLO_DB_INFO_MASK;
+	} else if (Ftype == XSRIO_HELLO_FTYPE_MESSAGE) {
+		NumSegs = (XferPtr->Len + XSRIO_HELLO_MAX_PAYLOAD - 1U) /
+				XSRIO_HELLO_MAX_PAYLOAD;
+		Addr = ((u64)(XferPtr->Offset / XSRIO_HELLO_MAX_PAYLOAD) <<
+				XSRIO_HELLO_MSG_SEG_SHIFT) |
+			((u64)(NumSegs - 1U) << XSRIO_HELLO_MSG_LEN_SHIFT) |
+			((u64)XferPtr->Letter <<
+				XSRIO_HELLO_MSG_LETTER_SHIFT) |
+			((u64)XferPtr->Mbox << XSRIO_HELLO_MSG_MBOX_SHIFT);
+	} else {
+		Addr = XferPtr->Addr + XferPtr->Offset;
+		if (Chunk > (XSRIO_HELLO_MAX_PAYLOAD -
+				((u32)Addr & (XSRIO_HELLO_MAX_PAYLOAD - 1U)))) {
+			Chunk = XSRIO_HELLO_MAX_PAYLOAD -
+				((u32)Addr & (XSRIO_HELLO_MAX_PAYLOAD - 1U));
+		}
+	}
+
+	if (Tracked != 0U) {
+		Tid = 0U;
+		while ((EnginePtr->TidFree & ((u32)1U << Tid)) == 0U) {
+			Tid++;
+		}
+		EnginePtr->TidFree &= ~((u32)1U << Tid);
+		EnginePtr->TidXfer[Tid] = XferPtr;
+		EnginePtr->TidOffset[Tid] = XferPtr->Offset;
+		EnginePtr->TidLen[Tid] = Chunk;
+		EnginePtr->TxUntracked[Idx] = NULL;
+	} else {
+		if (EnginePtr->TidNext < XSRIO_MSG_MAX_TIDS) {
+			EnginePtr->TidNext = XSRIO_MSG_MAX_TIDS;
+		}
+		Tid = EnginePtr->TidNext;
+		EnginePtr->TidNext++;
+		EnginePtr->TxUntracked[Idx] = XferPtr;
+	}
+
+	XSrio_MsgPutHdr(BufPtr, XSrio_MsgHdr(Tid, Ftype, Ttype,
+			XSRIO_MSG_REQ_PRIO, Chunk, Addr));
+	FrameLen = XSRIO_HELLO_HDR_SIZE;
+	if ((XferPtr->Op != XSRIO_XFER_NREAD) && (Chunk != 0U)) {
+		memcpy(BufPtr + XSRIO_HELLO_HDR_SIZE,
+			XferPtr->BufPtr + XferPtr->Offset, Chunk);
+		FrameLen += Chunk;
+	}
+	Xil_DCacheFlushRange((UINTPTR)BufPtr, FrameLen);
+
+	XferPtr->Pending++;
+	XferPtr->Offset += Chunk;
+	XferPtr->State = XSRIO_XFER_ACTIVE;
+	if (XferPtr->Offset >= XferPtr->Len) {
+		XferPtr->Framed = 1U;
+		EnginePtr->TxHead = (EnginePtr->TxHead + 1U) %
+					XSRIO_MSG_TX_DEPTH;
+		EnginePtr->TxCount--;
+	}
+
+	EnginePtr->TxLen[Idx] = FrameLen;
+	EnginePtr->TxReady = 1U;
+}
+
+/*****************************************************************************/
+/**
+* Process the packet received on the initiator response stream.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	Len is the length of the packet.
+*
+* @return	None.
+*
+* @note		None.
+******************************************************************************/
+static void XSrio_MsgResponse(XSrio_MsgEngine *EnginePtr, u32 Len)
+{
+	XSrio_Xfer *XferPtr;
+	u64 Hdr;
+	u32 Tid;
+	u32 Status;
+	u32 DataLen;
+
+	if (Len < XSRIO_HELLO_HDR_SIZE) {
+		EnginePtr->Stats.Stray++;
+		return;
+	}
+
+	Hdr = XSrio_MsgGetHdr(EnginePtr->IrespBuf);
+	Tid = (u32)(Hdr >> XSRIO_HELLO_TID_SHIFT) & XSRIO_HELLO_TID_MASK;
+	if ((((u32)(Hdr >> XSRIO_HELLO_FTYPE_SHIFT) & XSRIO_HELLO_FTYPE_MASK) !=
+			XSRIO_HELLO_FTYPE_RESPONSE) ||
+	    (Tid >= XSRIO_MSG_MAX_TIDS) || (EnginePtr->TidXfer[Tid] == NULL)) {
+		EnginePtr->Stats.Stray++;
+		return;
+	}
+
+	EnginePtr->Stats.RespPackets++;
+	XferPtr = EnginePtr->TidXfer[Tid];
+	Status = (u32)Hdr & XSRIO_HELLO_STATUS_MASK;
+	if (Status == XSRIO_HELLO_STATUS_DONE) {
+		if (XferPtr->Op == XSRIO_XFER_NREAD) {
+			DataLen = Len - XSRIO_HELLO_HDR_SIZE;
+			if (DataLen > EnginePtr->TidLen[Tid]) {
+				DataLen = EnginePtr->TidLen[Tid];
+			}
+			memcpy(XferPtr->BufPtr + EnginePtr->TidOffset[Tid],
+				EnginePtr->IrespBuf + XSRIO_HELLO_HDR_SIZE,
+				DataLen);
+		}
+	} else if (XferPtr->RespStatus == XSRIO_HELLO_STATUS_DONE) {
+		XferPtr->RespStatus = (u8)Status;
+	}
+
+	EnginePtr->TidXfer[Tid] = NULL;
+	EnginePtr->TidFree |= (u32)1U << Tid;
+	XferPtr->Pending--;
+	XSrio_MsgCheckDone(EnginePtr, XferPtr);
+}
+
+/*****************************************************************************/
+/**
+* Frame a response in the next free target response buffer.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	ReqHdr is the header of the request.
+* @param	Ttype is the transaction type of the response.
+* @param	Status is the response status.
+* @param	DataPtr is the response data.
+* @param	DataLen is the length of the response data, 0 for a response
+*		without data.
+*
+* @return	None.
+*
+* @note		The caller makes sure a buffer is free.
+******************************************************************************/
+static void XSrio_MsgRespond(XSrio_MsgEngine *EnginePtr, u64 ReqHdr,
+			u32 Ttype, u32 Status, const u8 *DataPtr, u32 DataLen)
+{
+	u32 Idx;
+	u32 Prio;
+	u8 *BufPtr;
+
+	Idx = (EnginePtr->TrespHead + EnginePtr->TrespCount) %
+		XSRIO_MSG_RESP_DEPTH;
+	BufPtr = EnginePtr->TrespBuf[Idx];
+
+	/* Responses go one priority above their request */
+	Prio = (u32)(ReqHdr >> XSRIO_HELLO_PRIO_SHIFT) & XSRIO_HELLO_PRIO_MASK;
+	if (Prio < XSRIO_HELLO_PRIO_MASK) {
+		Prio++;
+	}
+
+	XSrio_MsgPutHdr(BufPtr, XSrio_MsgHdr(
+		(u32)(ReqHdr >> XSRIO_HELLO_TID_SHIFT),
+		XSRIO_HELLO_FTYPE_RESPONSE, Ttype, Prio, DataLen, Status));
+	if (DataLen != 0U) {
+		memcpy(BufPtr + XSRIO_HELLO_HDR_SIZE, DataPtr, DataLen);
+	}
+	Xil_DCacheFlushRange((UINTPTR)BufPtr, XSRIO_HELLO_HDR_SIZE + DataLen);
+
+	EnginePtr->TrespLen[Idx] = XSRIO_HELLO_HDR_SIZE + DataLen;
+	EnginePtr->TrespCount++;
+
+	if (Status == XSRIO_HELLO_STATUS_RETRY) {
+		EnginePtr->Stats.Retries++;
+	} else if (Status != XSRIO_HELLO_STATUS_DONE) {
+		EnginePtr->Stats.Errors++;
+	}
+}
+
+/*****************************************************************************/
+/**
+* Map a range of RapidIO addresses to the target window.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	Addr is the first address.
+* @param	Len is the length of the range.
+*
+* @return	Local address of the range, NULL if it is not inside the
+*		window.
+*
+* @note		None.
+******************************************************************************/
+static u8 *XSrio_MsgInWindow(XSrio_MsgEngine *EnginePtr, u64 Addr, u32 Len)
+{
+	u32 Offset;
+
+	if ((EnginePtr->WinPtr == NULL) || (Addr < EnginePtr->WinAddr) ||
+	    ((Addr - EnginePtr->WinAddr) > EnginePtr->WinSize)) {
+		return NULL;
+	}
+
+	Offset = (u32)(Addr - EnginePtr->WinAddr);
+	if (Len > (EnginePtr->WinSize - Offset)) {
+		return NULL;
+	}
+
+	return EnginePtr->WinPtr + Offset;
+}
+
+/*****************************************************************************/
+/**
+* Place a message segment in the mailbox descriptor receiving its message.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	Addr is the address field of the segment.
+* @param	DataPtr is the segment data.
+* @param	DataLen is the segment length.
+*
+* @return	Status of the message response.
+*
+* @note		All segments but the last are of the same size. The last
+*		segment is answered with a RETRY when it arrives before the
+*		segment size is known.
+******************************************************************************/
+static u32 XSrio_MsgSegment(XSrio_MsgEngine *EnginePtr, u64 Addr,
+			const u8 *DataPtr, u32 DataLen)
+{
+	XSrio_MboxDesc *DescPtr;
+	u32 Mbox;
+	u32 Letter;
+	u32 Seg;
+	u32 NumSegs;
+	u32 Offset;
+
+	Mbox = (u32)(Addr >> XSRIO_HELLO_MSG_MBOX_SHIFT) &
+		XSRIO_HELLO_MSG_MBOX_MASK;
+	Letter = (u32)(Addr >> XSRIO_HELLO_MSG_LETTER_SHIFT) &
+		XSRIO_HELLO_MSG_LETTER_MASK;
+	Seg = (u32)(Addr >> XSRIO_HELLO_MSG_SEG_SHIFT) &
+		XSRIO_HELLO_MSG_SEG_MASK;
+	NumSegs = ((u32)(Addr >> XSRIO_HELLO_MSG_LEN_SHIFT) &
+		XSRIO_HELLO_MSG_SEG_MASK) + 1U;
+
+	if (EnginePtr->MboxCount[Mbox] == 0U) {
+		return XSRIO_HELLO_STATUS_RETRY;
+	}
+	DescPtr = EnginePtr->Mbox[Mbox][EnginePtr->MboxHead[Mbox]];
+
+	if (DescPtr->SegsSeen == 0U) {
+		DescPtr->Letter = (u8)Letter;
+		DescPtr->NumSegs = (u8)NumSegs;
+	} else if ((Letter != DescPtr->Letter) ||
+			(NumSegs != DescPtr->NumSegs)) {
+		return XSRIO_HELLO_STATUS_RETRY;
+	}
+	if (Seg >= NumSegs) {
+		return XSRIO_HELLO_STATUS_ERROR;
+	}
+	if (Seg != (NumSegs - 1U)) {
+		DescPtr->SegSize = DataLen;
+	} else if ((NumSegs > 1U) && (DescPtr->SegSize == 0U)) {
+		return XSRIO_HELLO_STATUS_RETRY;
+	}
+
+	Offset = Seg * DescPtr->SegSize;
+	if ((Offset + DataLen) > DescPtr->Size) {
+		DescPtr->State = XSRIO_XFER_ERROR;
+	} else {
+		memcpy(DescPtr->BufPtr + Offset, DataPtr, DataLen);
+		DescPtr->SegsSeen |= (u16)(1U << Seg);
+		if ((Offset + DataLen) > DescPtr->Len) {
+			DescPtr->Len = Offset + DataLen;
+		}
+		DescPtr->State = XSRIO_XFER_ACTIVE;
+		if (XSrio_MsgBitCount(DescPtr->SegsSeen) == NumSegs) {
+			DescPtr->State = XSRIO_XFER_DONE;
+		}
+	}
+
+	if (DescPtr->State >= XSRIO_XFER_DONE) {
+		EnginePtr->MboxHead[Mbox] = (EnginePtr->MboxHead[Mbox] + 1U) %
+						XSRIO_MSG_MBOX_DEPTH;
+		EnginePtr->MboxCount[Mbox]--;
+		if (EnginePtr->MboxHandler != NULL) {
+			EnginePtr->MboxHandler(EnginePtr->CallBackRef, (u8)Mbox,
+						DescPtr);
+		}
+	}
+
+	return (DescPtr->State == XSRIO_XFER_ERROR) ?
+		XSRIO_HELLO_STATUS_ERROR : XSRIO_HELLO_STATUS_DONE;
+}
+
+/*****************************************************************************/
+/**
+* Process the packet received on the target request stream.
+*
+* @param	EnginePtr is the engine to operate on.
+* @param	Len is the length of the packet.
+*
+* @return	None.
+*
+* @note		None.
+******************************************************************************/
+static void XSrio_MsgRequest(XSrio_MsgEngine *EnginePtr, u32 Len)
+{
+	const u8 *DataPtr = EnginePtr->TreqBuf + XSRIO_HELLO_HDR_SIZE;
+	u8 *WinPtr;
+	u64 Hdr;
+	u64 Addr;
+	u32 Ftype;
+	u32 Ttype;
+	u32 Size;
+	u32 DataLen;
+	u32 Status;
+
+	if (Len < XSRIO_HELLO_HDR_SIZE) {
+		EnginePtr->Stats.Stray++;
+		return;
+	}
+
+	EnginePtr->Stats.ReqPackets++;
+	Hdr = XSrio_MsgGetHdr(EnginePtr->TreqBuf);
+	Ftype = (u32)(Hdr >> XSRIO_HELLO_FTYPE_SHIFT) & XSRIO_HELLO_FTYPE_MASK;
+	Ttype = (u32)(Hdr >> XSRIO_HELLO_TTYPE_SHIFT) & XSRIO_HELLO_TTYPE_MASK;
+	Size = ((u32)(Hdr >> XSRIO_HELLO_SIZE_SHIFT) &
+		XSRIO_HELLO_SIZE_MASK) + 1U;
+	Addr = Hdr & XSRIO_HELLO_ADDR_MASK;
+	DataLen = Len - XSRIO_HELLO_HDR_SIZE;
+	if (DataLen > Size) {
+		DataLen = Size;
+	}
+
+	switch (Ftype) {
+	case XSRIO_HELLO_FTYPE_NREAD:
+		WinPtr = XSrio_MsgInWindow(EnginePtr, Addr, Size);
+		if (WinPtr != NULL) {
+			XSrio_MsgRespond(EnginePtr, Hdr,
+				XSRIO_HELLO_TTYPE_RESP_DATA,
+				XSRIO_HELLO_STATUS_DONE, WinPtr, Size);
+		} else {
+			XSrio_MsgRespond(EnginePtr, Hdr,
+				XSRIO_HELLO_TTYPE_RESP_NODATA,
+				XSRIO_HELLO_STATUS_ERROR, NULL, 0U);
+		}
+		break;
+
+	case XSRIO_HELLO_FTYPE_WRITE:
+	case XSRIO_HELLO_FTYPE_SWRITE:
+		Status = XSRIO_HELLO_STATUS_DONE;
+		WinPtr = XSrio_MsgInWindow(EnginePtr, Addr, DataLen);
+		if (WinPtr != NULL) {
+			memcpy(WinPtr, DataPtr, DataLen);
+		} else {
+			Status = XSRIO_HELLO_STATUS_ERROR;
+		}
+		if ((Ftype == XSRIO_HELLO_FTYPE_WRITE) &&
+		    (Ttype == XSRIO_HELLO_TTYPE_NWRITE_R)) {
+			XSrio_MsgRespond(EnginePtr, Hdr,
+				XSRIO_HELLO_TTYPE_RESP_NODATA, Status,
+				NULL, 0U);
+		} else if (Status != XSRIO_HELLO_STATUS_DONE) {
+			EnginePtr->Stats.Errors++;
+		}
+		break;
+
+	case XSRIO_HELLO_FTYPE_DOORBELL:
+		Status = XSRIO_HELLO_STATUS_RETRY;
+		if (EnginePtr->DbCount < XSRIO_MSG_DB_DEPTH) {
+			EnginePtr->DbQueue[(EnginePtr->DbHead +
+				EnginePtr->DbCount) % XSRIO_MSG_DB_DEPTH] =
+				(u16)(Addr & XSRIO_HELLO_DB_INFO_MASK);
+			EnginePtr->DbCount++;
+			Status = XSRIO_HELLO_STATUS_DONE;
+		}
+		XSrio_MsgRespond(EnginePtr, Hdr, XSRIO_HELLO_TTYPE_RESP_NODATA,
+				Status, NULL, 0U);
+		break;
+
+	case XSRIO_HELLO_FTYPE_MESSAGE:
+		Status = XSrio_MsgSegment(EnginePtr, Addr, DataPtr, DataLen);
+		XSrio_MsgRespond(EnginePtr, Hdr, XSRIO_HELLO_TTYPE_RESP_MSG,
+				Status, NULL, 0U);
+		break;
+
+	default:
+		EnginePtr->Stats.Stray++;
+		break;
+	}
+}
+
+#endif /* XPAR_XAXIDMA_NUM_INSTANCES */
+/** @} */
@@ -0,0 +1,278 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsrio_msg.h
+* @addtogroup srio_v1_2
+* @{
+*
+* This file contains the messaging layer of the SRIO Gen2 driver. It moves
+* HELLO format packets between memory and the user interfaces of the core
+* through AXI DMA engines in simple mode:
+*
+* - The initiator DMA feeds the initiator request (IREQ) stream from its MM2S
+*   channel and drains the initiator response (IRESP) stream to its S2MM
+*   channel.
+* - The optional target DMA drains the target request (TREQ) stream to its
+*   S2MM channel and feeds the target response (TRESP) stream from its MM2S
+*   channel.
+*
+* <b>Outbound transfers</b>
+*
+* XSrio_MsgNRead(), XSrio_MsgNWrite(), XSrio_MsgSendDoorbell() and
+* XSrio_MsgSendMessage() queue a transfer. The transfer is split in packets
+* of up to 256 bytes which are framed in a ping pong buffer while the previous
+* packet is sent. Packets which expect a response get a transaction ID, up to
+* XSRIO_MSG_MAX_TIDS of them are outstanding, and the response is matched to
+* the transfer through it. A transfer completes when every packet has been
+* sent and answered; its State is then XSRIO_XFER_DONE, or XSRIO_XFER_ERROR
+* with the first non DONE response status in RespStatus.
+*
+* <b>Inbound requests</b>
+*
+* - Doorbells are queued and read with XSrio_MsgRecvDoorbell(). A doorbell
+*   which does not fit in the queue is answered with a RETRY.
+* - Message segments are reassembled in the buffer of the oldest descriptor
+*   posted to the mailbox with XSrio_MsgPostMbox(). One message is in progress
+*   per mailbox; segments of other letters are answered with a RETRY.
+* - NREAD, NWRITE and NWRITE_R requests are served from the memory window
+*   given to XSrio_MsgSetWindow().
+*
+* All data is copied through the engine buffers, the user buffers need no
+* cache maintenance. XSrio_MsgService() makes progress on all the streams and
+* is called from a polling loop or from the DMA interrupt handlers. The engine
+* functions must not run concurrently.
+*
+* The source and destination device IDs are carried on the sideband of the
+* streams, which the AXI DMA does not drive: the design ties them for the
+* link partner.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.3   adk  10/15/19 First release
+* </pre>
+******************************************************************************/
+
+#ifndef XSRIO_MSG_H		/* prevent circular inclusions */
+#define XSRIO_MSG_H		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xsrio.h"
+
+#ifdef XPAR_XAXIDMA_NUM_INSTANCES
+#include "xaxidma.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XSRIO_MSG_TX_DEPTH	16U	/**< Transfers queued */
+#define XSRIO_MSG_MAX_TIDS	32U	/**< Requests awaiting a response */
+#define XSRIO_MSG_DB_DEPTH	16U	/**< Doorbells received */
+#define XSRIO_MSG_NUM_MBOX	4U	/**< Mailboxes */
+#define XSRIO_MSG_MBOX_DEPTH	4U	/**< Descriptors posted per mailbox */
+#define XSRIO_MSG_MAX_SEGS	16U	/**< Segments of a message */
+#define XSRIO_MSG_RESP_DEPTH	4U	/**< Target responses queued */
+#define XSRIO_MSG_BUF_SIZE	320U	/**< Packet buffer, cache line
+					  *  multiple */
+#define XSRIO_MSG_MAX_MSG_SIZE	(XSRIO_MSG_MAX_SEGS * XSRIO_HELLO_MAX_PAYLOAD)
+
+#define XSRIO_MSG_REQ_PRIO	0U	/**< Priority of the requests */
+
+/* Transfer operations */
+#define XSRIO_XFER_NREAD	0U	/**< NREAD */
+#define XSRIO_XFER_NWRITE	1U	/**< NWRITE */
+#define XSRIO_XFER_NWRITE_R	2U	/**< NWRITE_R */
+#define XSRIO_XFER_DOORBELL	3U	/**< DOORBELL */
+#define XSRIO_XFER_MESSAGE	4U	/**< MESSAGE */
+
+/* Transfer and mailbox descriptor states */
+#define XSRIO_XFER_QUEUED	0U	/**< Queued */
+#define XSRIO_XFER_ACTIVE	1U	/**< Packets sent or received */
+#define XSRIO_XFER_DONE		2U	/**< Completed */
+#define XSRIO_XFER_ERROR	3U	/**< Completed with an error */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Outbound transfer, owned by the engine from the call which queues it until
+ * it completes.
+ */
+typedef struct {
+	u8 *BufPtr;		/**< Data buffer */
+	u64 Addr;		/**< Target address */
+	u32 Len;		/**< Length in bytes */
+	u32 Offset;		/**< Bytes framed */
+	u32 Pending;		/**< Packets not sent or not answered */
+	u16 Info;		/**< Doorbell information */
+	u8 Op;			/**< XSRIO_XFER_* operation */
+	u8 Mbox;		/**< Message mailbox */
+	u8 Letter;		/**< Message letter */
+	u8 Framed;		/**< Last packet framed */
+	u8 RespStatus;		/**< First non DONE response status */
+	volatile u8 State;	/**< XSRIO_XFER_* state */
+	void *Ref;		/**< Application reference */
+} XSrio_Xfer;
+
+/**
+ * Mailbox receive descriptor.
+ */
+typedef struct {
+	u8 *BufPtr;		/**< Message buffer */
+	u32 Size;		/**< Size of the buffer */
+	u32 Len;		/**< Message length */
+	u32 SegSize;		/**< Segment size of the message */
+	u16 SegsSeen;		/**< Segments received */
+	u8 NumSegs;		/**< Segments of the message */
+	u8 Letter;		/**< Message letter */
+	volatile u8 State;	/**< XSRIO_XFER_* state */
+} XSrio_MboxDesc;
+
+/**
+ * Called when an outbound transfer completes.
+ */
+typedef void (*XSrio_XferHandler)(void *CallBackRef, XSrio_Xfer *XferPtr);
+
+/**
+ * Called when a message has been received in a mailbox.
+ */
+typedef void (*XSrio_MboxHandler)(void *CallBackRef, u8 Mbox,
+					XSrio_MboxDesc *DescPtr);
+
+/**
+ * Engine statistics.
+ */
+typedef struct {
+	u32 TxPackets;		/**< Request packets sent */
+	u32 RespPackets;	/**< Responses received */
+	u32 ReqPackets;		/**< Target requests received */
+	u32 Retries;		/**< Requests answered with a RETRY */
+	u32 Errors;		/**< Requests answered with an ERROR */
+	u32 Stray;		/**< Packets dropped */
+} XSrio_MsgStats;
+
+/**
+ * The messaging engine instance.
+ */
+typedef struct {
+	u8 TxBuf[2][XSRIO_MSG_BUF_SIZE]
+		__attribute__ ((aligned(64)));	/**< IREQ ping pong frames */
+	u8 IrespBuf[XSRIO_MSG_BUF_SIZE]
+		__attribute__ ((aligned(64)));	/**< IRESP packet */
+	u8 TreqBuf[XSRIO_MSG_BUF_SIZE]
+		__attribute__ ((aligned(64)));	/**< TREQ packet */
+	u8 TrespBuf[XSRIO_MSG_RESP_DEPTH][XSRIO_MSG_BUF_SIZE]
+		__attribute__ ((aligned(64)));	/**< TRESP frames */
+	XSrio *SrioPtr;			/**< SRIO Gen2 instance */
+	XAxiDma *InitDmaPtr;		/**< IREQ/IRESP DMA */
+	XAxiDma *TargDmaPtr;		/**< TREQ/TRESP DMA, may be NULL */
+
+	XSrio_Xfer *TxQueue[XSRIO_MSG_TX_DEPTH];	/**< Transfers queued */
+	u32 TxHead;			/**< Oldest queued transfer */
+	u32 TxCount;			/**< Transfers queued */
+	u32 TxLen[2];			/**< Length of the TxBuf frames */
+	XSrio_Xfer *TxUntracked[2];	/**< Transfer of a TxBuf frame
+					  *  without response */
+	u8 TxReady;			/**< TxBuf[TxIdx] holds a frame */
+	u8 TxIdx;			/**< Frame to send next */
+	u8 TxActive;			/**< MM2S transfer started */
+	u8 IrespActive;			/**< IRESP S2MM transfer started */
+	u8 TreqActive;			/**< TREQ S2MM transfer started */
+	u8 TreqHeld;			/**< TREQ packet waits for a
+					  *  response frame */
+	u32 TreqLen;			/**< Length of the TREQ packet */
+	u8 TrespActive;			/**< TRESP MM2S transfer started */
+	u8 TidNext;			/**< Next TID of untracked packets */
+
+	u32 TidFree;			/**< Free TID bitmap */
+	XSrio_Xfer *TidXfer[XSRIO_MSG_MAX_TIDS];	/**< Transfer of a TID */
+	u32 TidOffset[XSRIO_MSG_MAX_TIDS];	/**< Transfer offset */
+	u32 TidLen[XSRIO_MSG_MAX_TIDS];		/**< Packet length */
+
+	u32 TrespHead;			/**< Oldest response frame */
+	u32 TrespCount;			/**< Response frames queued */
+	u32 TrespLen[XSRIO_MSG_RESP_DEPTH];	/**< Response frame lengths */
+
+	u16 DbQueue[XSRIO_MSG_DB_DEPTH];	/**< Doorbells received */
+	u32 DbHead;			/**< Oldest doorbell */
+	u32 DbCount;			/**< Doorbells queued */
+
+	XSrio_MboxDesc *Mbox[XSRIO_MSG_NUM_MBOX][XSRIO_MSG_MBOX_DEPTH];
+					/**< Descriptors posted */
+	u32 MboxHead[XSRIO_MSG_NUM_MBOX];	/**< Oldest descriptor */
+	u32 MboxCount[XSRIO_MSG_NUM_MBOX];	/**< Descriptors posted */
+
+	u64 WinAddr;			/**< Address of the target window */
+	u8 *WinPtr;			/**< Local memory of the window */
+	u32 WinSize;			/**< Size of the window */
+
+	XSrio_XferHandler XferHandler;	/**< Transfer completion handler */
+	XSrio_MboxHandler MboxHandler;	/**< Message handler */
+	void *CallBackRef;		/**< Handler argument */
+	XSrio_MsgStats Stats;		/**< Statistics */
+	u32 IsReady;			/**< Engine is initialized */
+} XSrio_MsgEngine;
+
+/************************** Function Prototypes ******************************/
+
+int XSrio_MsgInitialize(XSrio_MsgEngine *EnginePtr, XSrio *SrioPtr,
+			XAxiDma *InitDmaPtr, XAxiDma *TargDmaPtr);
+void XSrio_MsgSetHandlers(XSrio_MsgEngine *EnginePtr,
+			XSrio_XferHandler XferHandler,
+			XSrio_MboxHandler MboxHandler, void *CallBackRef);
+void XSrio_MsgSetWindow(XSrio_MsgEngine *EnginePtr, u64 Addr, u8 *WinPtr,
+			u32 Size);
+int XSrio_MsgNRead(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr,
+			u64 Addr, u8 *BufPtr, u32 Len);
+int XSrio_MsgNWrite(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr,
+			u64 Addr, const u8 *BufPtr, u32 Len, u32 WithResp);
+int XSrio_MsgSendDoorbell(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr,
+			u16 Info);
+int XSrio_MsgSendMessage(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr,
+			u8 Mbox, u8 Letter, const u8 *BufPtr, u32 Len);
+int XSrio_MsgRecvDoorbell(XSrio_MsgEngine *EnginePtr, u16 *InfoPtr);
+int XSrio_MsgPostMbox(XSrio_MsgEngine *EnginePtr, u8 Mbox,
+			XSrio_MboxDesc *DescPtr, u8 *BufPtr, u32 Size);
+u32 XSrio_MsgService(XSrio_MsgEngine *EnginePtr);
+int XSrio_MsgWait(XSrio_MsgEngine *EnginePtr, XSrio_Xfer *XferPtr);
+u32 XSrio_MsgPending(XSrio_MsgEngine *EnginePtr);
+
+#endif /* XPAR_XAXIDMA_NUM_INSTANCES */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif		/* end of protection macro */
+/** @} */
@@ -75,6 +75,23 @@
 *		driven sampling mode in the single channel mode.
 *
 *
+* <b> Fast Acquisition </b>
+*
+* XSysMonPsu_CaptureInit() resolves the register address of every channel
+* enabled in the sequencer once, so that XSysMonPsu_CaptureGetData() reads the
+* results of a whole sequence in a single pass of register reads. The device
+* has no DMA interface, this pass is the cheapest way to collect a sequence.
+*
+* XSysMonPsu_CaptureSample() is meant to be called on the End of Sequence
+* event, from the interrupt handler or a polling loop. It optionally averages
+* 2^n sequences in software, in addition to the hardware averaging set with
+* XSysMonPsu_SetAvg(), and stores the results with a time stamp in a ring
+* provided by the user. XSysMonPsu_CaptureRead() empties the ring; the two may
+* run in different contexts. The minimum, maximum, mean and standard deviation
+* of each channel are tracked and XSysMonPsu_CaptureSetThreshold() programs
+* alarm thresholds derived from them.
+*
+*
 * <b> Initialization and Configuration </b>
 *
 * The device driver enables higher layer software (e.g., an application) to
@@ -174,6 +191,8 @@
 *                       in sysmonpsu_header.h
 *       mn     03/08/18 Update Clock Divisor to the proper value
 * 2.4   mn     04/20/18 Remove looping check for PL accessible bit
+* 2.5   adk    10/15/19 Added fast acquisition of the sequencer channels,
+*                       see xsysmonpsu_capture.c
 *
 * </pre>
 *
@@ -422,6 +441,61 @@ typedef struct {
 #define XSM_AMS_CH_OFFSET 0x00000060U
 #define XSM_MIN_MAX_CH_OFFSET 0x00000080U
 
+/**
+ * @name Fast acquisition
+ * @{
+ */
+#define XSM_CAPTURE_MAX_CH	32U	/**< Channels in a capture */
+#define XSM_CAPTURE_MAX_AVG	6U	/**< Max software average shift */
+/*@}*/
+
+/**
+ * Returns a free running time stamp, used to time stamp captured sequences.
+ */
+typedef u64 (*XSysMonPsu_TimeHandler)(void);
+
+/**
+ * One captured sequence. Data[] holds the ADC codes of the channels in the
+ * order of XSysMonPsu_Capture.Channel[].
+ */
+typedef struct {
+	u64 TimeStamp;			/**< Time of the last sequence */
+	u16 Data[XSM_CAPTURE_MAX_CH];	/**< ADC codes */
+} XSysMonPsu_Sample;
+
+/**
+ * Statistics of a captured channel, over the sequences stored in the ring.
+ */
+typedef struct {
+	u32 Count;	/**< Samples accounted */
+	u16 Min;	/**< Lowest code */
+	u16 Max;	/**< Highest code */
+	u64 Sum;	/**< Sum of the codes */
+	u64 SumSq;	/**< Sum of the squared codes */
+} XSysMonPsu_ChStats;
+
+/**
+ * Fast acquisition state of a System Monitor block.
+ */
+typedef struct {
+	XSysMonPsu *InstancePtr;		/**< Device */
+	u32 SysmonBlk;				/**< XSYSMON_PS or XSYSMON_PL */
+	u32 NumCh;				/**< Channels captured */
+	u8 Channel[XSM_CAPTURE_MAX_CH];		/**< Channel numbers */
+	u32 Addr[XSM_CAPTURE_MAX_CH];		/**< Result registers */
+	XSysMonPsu_Sample *Ring;		/**< User provided ring */
+	u32 RingSize;				/**< Entries in Ring */
+	volatile u32 Head;			/**< Entries written */
+	volatile u32 Tail;			/**< Entries read */
+	u32 Overruns;				/**< Sequences lost, ring full */
+	u32 AvgShift;				/**< 2^AvgShift sequences
+						  *  averaged per entry */
+	u32 AvgCount;				/**< Sequences accumulated */
+	u32 AvgSum[XSM_CAPTURE_MAX_CH];		/**< Accumulated codes */
+	XSysMonPsu_TimeHandler TimeHandler;	/**< Time stamp source */
+	XSysMonPsu_ChStats Stats[XSM_CAPTURE_MAX_CH];	/**< Statistics */
+} XSysMonPsu_Capture;
+
 /************************* Variable Definitions ******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -673,6 +747,24 @@ u64 XSysMonPsu_IntrGetEnabled(XSysMonPsu *InstancePtr);
 u64 XSysMonPsu_IntrGetStatus(XSysMonPsu *InstancePtr);
 void XSysMonPsu_IntrClear(XSysMonPsu *InstancePtr, u64 Mask);
 
+/* Fast acquisition functions in xsysmonpsu_capture.c */
+s32 XSysMonPsu_CaptureInit(XSysMonPsu_Capture *CapturePtr,
+		XSysMonPsu *InstancePtr, u32 SysmonBlk,
+		XSysMonPsu_Sample *Ring, u32 RingSize);
+void XSysMonPsu_CaptureSetAverage(XSysMonPsu_Capture *CapturePtr,
+		u32 AvgShift);
+void XSysMonPsu_CaptureSetTime(XSysMonPsu_Capture *CapturePtr,
+		XSysMonPsu_TimeHandler TimeHandler);
+u32 XSysMonPsu_CaptureGetData(XSysMonPsu_Capture *CapturePtr, u16 *DataPtr);
+u32 XSysMonPsu_CaptureSample(XSysMonPsu_Capture *CapturePtr);
+u32 XSysMonPsu_CaptureRead(XSysMonPsu_Capture *CapturePtr,
+		XSysMonPsu_Sample *SamplePtr, u32 MaxSamples);
+s32 XSysMonPsu_CaptureGetStats(XSysMonPsu_Capture *CapturePtr, u8 Channel,
+		XSysMonPsu_ChStats *StatsPtr);
+void XSysMonPsu_CaptureResetStats(XSysMonPsu_Capture *CapturePtr);
+s32 XSysMonPsu_CaptureSetThreshold(XSysMonPsu_Capture *CapturePtr,
+		u8 Channel, u8 UpperReg, u8 LowerReg, u32 Sigmas, u16 Margin);
+
 /* Functions in xsysmonpsu_selftest.c */
 s32 XSysMonPsu_SelfTest(XSysMonPsu *InstancePtr);
 
@@ -0,0 +1,527 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsysmonpsu_capture.c
+* @addtogroup sysmonpsu_v2_5
+*
+* This file contains the fast acquisition functions of the SYSMONPSU driver:
+* single pass read of the sequencer results, capture of the sequences into a
+* ring with software averaging and time stamps, and alarm thresholds derived
+* from the captured statistics. Refer to xsysmonpsu.h for an overview.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date	Changes
+* ----- -----  -------- -----------------------------------------------
+* 2.5   adk    10/15/19 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xsysmonpsu.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XSM_SEQ_CH_NONE		0xFFU	/**< Sequencer bit without a result */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static u32 XSysMonPsu_SqRoot(u64 Value);
+
+/************************** Variable Definitions *****************************/
+
+/*
+ * Channel measured by each bit of the SEQ_CH0 register. The calibration and
+ * test bits do not have a result register of their own.
+ */
+static const u8 XSysMonPsu_SeqCh0Map[XSM_SEQ_CH_SHIFT] = {
+	XSM_SEQ_CH_NONE, XSM_SEQ_CH_NONE, XSM_SEQ_CH_NONE, XSM_SEQ_CH_NONE,
+	XSM_SEQ_CH_NONE, XSM_CH_SUPPLY4, XSM_CH_SUPPLY5, XSM_CH_SUPPLY6,
+	XSM_CH_TEMP, XSM_CH_SUPPLY1, XSM_CH_SUPPLY2, XSM_CH_VPVN,
+	XSM_CH_VREFP, XSM_CH_VREFN, XSM_CH_SUPPLY3, XSM_SEQ_CH_NONE
+};
+
+/****************************************************************************/
+/**
+*
+* This function initializes a capture of the channels enabled in the
+* sequencer of a System Monitor block. The register address of every channel
+* is resolved here, the sequencer must therefore be configured before and not
+* be changed while capturing.
+*
+* @param	CapturePtr is a pointer to the capture state.
+* @param	InstancePtr is a pointer to the XSysMonPsu instance.
+* @param	SysmonBlk is the value that tells whether it is for PS Sysmon
+*		block or PL Sysmon block.
+* @param	Ring is a pointer to RingSize entries receiving the sequences,
+*		can be NULL when only XSysMonPsu_CaptureGetData() is used.
+* @param	RingSize is the number of entries in Ring.
+*
+* @return	- XST_SUCCESS if successful.
+*		- XST_FAILURE if no channel, or more than XSM_CAPTURE_MAX_CH
+*		channels, are enabled in the sequencer.
+*
+* @note		None.
+*
+*****************************************************************************/
+s32 XSysMonPsu_CaptureInit(XSysMonPsu_Capture *CapturePtr,
+		XSysMonPsu *InstancePtr, u32 SysmonBlk,
+		XSysMonPsu_Sample *Ring, u32 RingSize)
+{
+	u64 ChMask;
+	u32 EffectiveBaseAddress;
+	u32 Bit;
+	u8 Channel;
+
+	/* Assert the arguments. */
+	Xil_AssertNonvoid(CapturePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid((SysmonBlk == XSYSMON_PS) ||
+			  (SysmonBlk == XSYSMON_PL));
+	Xil_AssertNonvoid((Ring != NULL) || (RingSize == 0U));
+
+	(void)memset(CapturePtr, 0, sizeof(XSysMonPsu_Capture));
+	CapturePtr->InstancePtr = InstancePtr;
+	CapturePtr->SysmonBlk = SysmonBlk;
+	CapturePtr->Ring = Ring;
+	CapturePtr->RingSize = RingSize;
+
+	EffectiveBaseAddress =
+			XSysMonPsu_GetEffBaseAddress(InstancePtr->Config.BaseAddress,
+					SysmonBlk);
+	ChMask = XSysMonPsu_GetSeqChEnables(InstancePtr, SysmonBlk);
+
+	/*
+	 * Walk the sequencer bits in channel order: the on chip sensors of
+	 * SEQ_CH0, then the auxiliary channels of SEQ_CH1 and the supplies
+	 * of SEQ_CH2, whose bit positions match the channel numbers.
+	 */
+	for (Channel = XSM_CH_TEMP; Channel <= XSM_CH_TEMP_REMTE; Channel++) {
+		if (Channel < XSM_CH_AUX_MIN) {
+			for (Bit = 0U; Bit < XSM_SEQ_CH_SHIFT; Bit++) {
+				if (XSysMonPsu_SeqCh0Map[Bit] == Channel) {
+					break;
+				}
+			}
+			if (Bit == XSM_SEQ_CH_SHIFT) {
+				continue;
+			}
+		} else {
+			Bit = Channel;
+		}
+
+		if ((ChMask & ((u64)1U << Bit)) == (u64)0U) {
+			continue;
+		}
+		if (CapturePtr->NumCh == XSM_CAPTURE_MAX_CH) {
+			return XST_FAILURE;
+		}
+
+		CapturePtr->Channel[CapturePtr->NumCh] = Channel;
+		if (Channel <= XSM_CH_AUX_MAX) {
+			CapturePtr->Addr[CapturePtr->NumCh] =
+				EffectiveBaseAddress + ((u32)Channel << 2U);
+		} else {
+			CapturePtr->Addr[CapturePtr->NumCh] =
+				EffectiveBaseAddress + XSM_ADC_CH_OFFSET +
+				(((u32)Channel - XSM_CH_SUPPLY7) << 2U);
+		}
+		CapturePtr->NumCh++;
+	}
+
+	if (CapturePtr->NumCh == 0U) {
+		return XST_FAILURE;
+	}
+
+	XSysMonPsu_CaptureResetStats(CapturePtr);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function sets the number of sequences averaged into a ring entry.
+* Pending accumulated sequences are dropped.
+*
+* @param	CapturePtr is a pointer to the capture state.
+* @param	AvgShift is the log2 of the number of sequences averaged,
+*		0 to XSM_CAPTURE_MAX_AVG. 0 stores every sequence.
+*
+* @return	None.
+*
+* @note		This averaging adds to the one of the device, enabled with
+*		XSysMonPsu_SetAvg() and XSysMonPsu_SetSeqAvgEnables().
+*
+*****************************************************************************/
+void XSysMonPsu_CaptureSetAverage(XSysMonPsu_Capture *CapturePtr,
+		u32 AvgShift)
+{
+	/* Assert the arguments. */
+	Xil_AssertVoid(CapturePtr != NULL);
+	Xil_AssertVoid(AvgShift <= XSM_CAPTURE_MAX_AVG);
+
+	CapturePtr->AvgShift = AvgShift;
+	CapturePtr->AvgCount = 0U;
+	(void)memset(CapturePtr->AvgSum, 0, sizeof(CapturePtr->AvgSum));
+}
+
+/****************************************************************************/
+/**
+*
+* This function sets the time stamp source of the captured sequences.
+*
+* @param	CapturePtr is a pointer to the capture state.
+* @param	TimeHandler returns a free running time stamp, NULL to store
+*		a zero time stamp.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void XSysMonPsu_CaptureSetTime(XSysMonPsu_Capture *CapturePtr,
+		XSysMonPsu_TimeHandler TimeHandler)
+{
+	/* Assert the arguments. */
+	Xil_AssertVoid(CapturePtr != NULL);
+
+	CapturePtr->TimeHandler = TimeHandler;
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads the results of all the captured channels in a single
+* pass.
+*
+* @param	CapturePtr is a pointer to the capture state.
+* @param	DataPtr is a pointer to NumCh entries receiving the ADC codes,
+*		in the order of CapturePtr->Channel[].
+*
+* @return	The number of channels read.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XSysMonPsu_CaptureGetData(XSysMonPsu_Capture *CapturePtr, u16 *DataPtr)
+{
+	u32 Index;
+
+	/* Assert the arguments. */
+	Xil_AssertNonvoid(CapturePtr != NULL);
+	Xil_AssertNonvoid(DataPtr != NULL);
+
+	for (Index = 0U; Index < CapturePtr->NumCh; Index++) {
+		DataPtr[Index] = (u16)XSysmonPsu_ReadReg(CapturePtr->Addr[Index]);
+	}
+
+	return CapturePtr->NumCh;
+}
+
+/****************************************************************************/
+/**
+*
+* This function captures one sequence. It is to be called once per End of
+* Sequence event. Every 2^AvgShift calls the averaged sequence is time
+* stamped, accounted in the statistics and stored in the ring.
+*
+* @param	CapturePtr is a pointer to the capture state.
+*
+* @return	1 if an entry was completed, 0 otherwise.
+*
+* @note		An entry completed while the ring is full is accounted in the
+*		statistics and counted in Overruns, but not stored.
+*
+*****************************************************************************/
+u32 XSysMonPsu_CaptureSample(XSysMonPsu_Capture *CapturePtr)
+{
+	XSysMonPsu_Sample *SamplePtr = NULL;
+	XSysMonPsu_ChStats *StatsPtr;
+	u32 Index;
+	u32 Head;
+	u16 Data;
+
+	/* Assert the arguments. */
+	Xil_AssertNonvoid(CapturePtr != NULL);
+
+	for (Index = 0U; Index < CapturePtr->NumCh; Index++) {
+		CapturePtr->AvgSum[Index] +=
+			(u16)XSysmonPsu_ReadReg(CapturePtr->Addr[Index]);
+	}
+
+	CapturePtr->AvgCount++;
+	if (CapturePtr->AvgCount < ((u32)1U << CapturePtr->AvgShift)) {
+		return 0U;
+	}
+	CapturePtr->AvgCount = 0U;
+
+	Head = CapturePtr->Head;
+	if ((Head - CapturePtr->Tail) < CapturePtr->RingSize) {
+		SamplePtr = &CapturePtr->Ring[Head % CapturePtr->RingSize];
+		SamplePtr->TimeStamp = (CapturePtr->TimeHandler != NULL) ?
+				CapturePtr->TimeHandler() : 0U;
+	} else {
+		CapturePtr->Overruns++;
+	}
+
+	for (Index = 0U; Index < CapturePtr->NumCh; Index++) {
+		Data = (u16)(CapturePtr->AvgSum[Index] >> CapturePtr->AvgShift);
+		CapturePtr->AvgSum[Index] = 0U;
+
+		StatsPtr = &CapturePtr->Stats[Index];
+		StatsPtr->Count++;
+		StatsPtr->Sum += Data;
+		StatsPtr->SumSq += (u64)Data * Data;
+		if (Data < StatsPtr->Min) {
+			StatsPtr->Min = Data;
+		}
+		if (Data > StatsPtr->Max) {
+			StatsPtr->Max = Data;
+		}
+
+		if (SamplePtr != NULL) {
+			SamplePtr->Data[Index] = Data;
+		}
+	}
+
+	if (SamplePtr != NULL) {
+		CapturePtr->Head = Head + 1U;
+	}
+
+	return 1U;
+}
+
+/****************************************************************************/
+/**
+*
+* This function takes the oldest entries out of the ring.
+*
+* @param	CapturePtr is a pointer to the capture state.
+* @param	SamplePtr is a pointer to MaxSamples entries.
+* @param	MaxSamples is the number of entries to read at most.
+*
+* @return	The number of entries read.
+*
+* @note		This function may run concurrently with
+*		XSysMonPsu_CaptureSample(), e.g. from the interrupt handler.
+*
+*****************************************************************************/
+u32 XSysMonPsu_CaptureRead(XSysMonPsu_Capture *CapturePtr,
+		XSysMonPsu_Sample *SamplePtr, u32 MaxSamples)
+{
+	u32 Tail;
+	u32 Count = 0U;
+
+	/* Assert the arguments. */
+	Xil_AssertNonvoid(CapturePtr != NULL);
+	Xil_AssertNonvoid((SamplePtr != NULL) || (MaxSamples == 0U));
+
+	Tail = CapturePtr->Tail;
+	while ((Count < MaxSamples) && (Tail != CapturePtr->Head)) {
+		SamplePtr[Count] = CapturePtr->Ring[Tail % CapturePtr->RingSize];
+		Tail++;
+		Count++;
+	}
+	CapturePtr->Tail = Tail;
+
+	return Count;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the statistics of a captured channel.
+*
+* @param	CapturePtr is a pointer to the capture state.
+* @param	Channel is the channel number.
+* @param	StatsPtr is a pointer to the statistics returned.
+*
+* @return	- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the channel is not captured.
+*
+* @note		None.
+*
+*****************************************************************************/
+s32 XSysMonPsu_CaptureGetStats(XSysMonPsu_Capture *CapturePtr, u8 Channel,
+		XSysMonPsu_ChStats *StatsPtr)
+{
+	u32 Index;
+
+	/* Assert the arguments. */
+	Xil_AssertNonvoid(CapturePtr != NULL);
+	Xil_AssertNonvoid(StatsPtr != NULL);
+
+	for (Index = 0U; Index < CapturePtr->NumCh; Index++) {
+		if (CapturePtr->Channel[Index] == Channel) {
+			*StatsPtr = CapturePtr->Stats[Index];
+			return XST_SUCCESS;
+		}
+	}
+
+	return XST_INVALID_PARAM;
+}
+
+/****************************************************************************/
+/**
+*
+* This function clears the statistics of all the captured channels.
+*
+* @param	CapturePtr is a pointer to the capture state.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void XSysMonPsu_CaptureResetStats(XSysMonPsu_Capture *CapturePtr)
+{
+	u32 Index;
+
+	/* Assert the arguments. */
+	Xil_AssertVoid(CapturePtr != NULL);
+
+	for (Index = 0U; Index < XSM_CAPTURE_MAX_CH; Index++) {
+		CapturePtr->Stats[Index].Count = 0U;
+		CapturePtr->Stats[Index].Min = 0xFFFFU;
+		CapturePtr->Stats[Index].Max = 0U;
+		CapturePtr->Stats[Index].Sum = 0U;
+		CapturePtr->Stats[Index].SumSq = 0U;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function programs the alarm thresholds of a channel around the
+* captured statistics: Mean +/- (Sigmas * Standard deviation + Margin),
+* clamped to the ADC code range.
+*
+* @param	CapturePtr is a pointer to the capture state.
+* @param	Channel is the channel number.
+* @param	UpperReg is the XSM_ATR_* index of the upper threshold.
+* @param	LowerReg is the XSM_ATR_* index of the lower threshold.
+* @param	Sigmas is the number of standard deviations allowed.
+* @param	Margin is the ADC code margin added to the deviation.
+*
+* @return	- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the channel is not captured.
+*		- XST_FAILURE if the channel has no statistics yet.
+*
+* @note		The thresholds are compared to the ADC codes, so that the
+*		ones derived from the codes need no conversion.
+*
+*****************************************************************************/
+s32 XSysMonPsu_CaptureSetThreshold(XSysMonPsu_Capture *CapturePtr,
+		u8 Channel, u8 UpperReg, u8 LowerReg, u32 Sigmas, u16 Margin)
+{
+	XSysMonPsu_ChStats Stats;
+	u64 Mean;
+	u64 Variance;
+	u64 Window;
+	u64 Upper;
+	u64 Lower;
+	s32 Status;
+
+	/* Assert the arguments. */
+	Xil_AssertNonvoid(CapturePtr != NULL);
+	Xil_AssertNonvoid(UpperReg <= XSM_ATR_TEMP_RMTE_LOWER);
+	Xil_AssertNonvoid(LowerReg <= XSM_ATR_TEMP_RMTE_LOWER);
+
+	Status = XSysMonPsu_CaptureGetStats(CapturePtr, Channel, &Stats);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+	if (Stats.Count == 0U) {
+		return XST_FAILURE;
+	}
+
+	Mean = Stats.Sum / Stats.Count;
+	Variance = (Stats.SumSq / Stats.Count) - (Mean * Mean);
+	if (Variance > (Stats.SumSq / Stats.Count)) {
+		/* Rounding of the integer mean */
+		Variance = 0U;
+	}
+	Window = ((u64)Sigmas * XSysMonPsu_SqRoot(Variance)) + Margin;
+
+	Upper = Mean + Window;
+	if (Upper > 0xFFFFU) {
+		Upper = 0xFFFFU;
+	}
+	Lower = (Window < Mean) ? (Mean - Window) : 0U;
+
+	XSysMonPsu_SetAlarmThreshold(CapturePtr->InstancePtr, UpperReg,
+			(u16)Upper, CapturePtr->SysmonBlk);
+	XSysMonPsu_SetAlarmThreshold(CapturePtr->InstancePtr, LowerReg,
+			(u16)Lower, CapturePtr->SysmonBlk);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the integer square root of a value.
+*
+* @param	Value is the value.
+*
+* @return	floor(sqrt(Value)).
+*
+* @note		None.
+*
+*****************************************************************************/
+static u32 XSysMonPsu_SqRoot(u64 Value)
+{
+	u64 Root = 0U;
+	u64 Bit = (u64)1U << 62U;
+
+	while (Bit > Value) {
+		Bit >>= 2U;
+	}
+
+	while (Bit != 0U) {
+		if (Value >= (Root + Bit)) {
+			Value -= Root + Bit;
+			Root = (Root >> 1U) + Bit;
+		} else {
+			Root >>= 1U;
+		}
+		Bit >>= 2U;
+	}
+
+	return (u32)Root;
+}
@@ -41,6 +41,8 @@
 * Ver   Who    Date	    Changes
 * ----- -----  -------- -----------------------------------------------
 * 1.0   aad    20/11/18 First release.
+* 1.1   adk    15/10/19 Added XSysMonPsv_ReadSupplyValues() to read a list of
+*                       supplies in a single pass.
 *
 * </pre>
 *
@@ -516,6 +518,64 @@ u32 XSysMonPsv_ReadSupplyValue(XSysMonPsv *InstancePtr,
 	return XSysMonPsv_ReadReg(InstancePtr->Config.BaseAddress + Offset);
 }
 
+/*****************************************************************************/
+/**
+*
+* This function reads the raw values of a list of supplies in a single pass.
+* The register offset of the value type is resolved once for the whole list.
+*
+* @param	InstancePtr is a pointer to the driver instance.
+* @param	Supplies is an array of the supplies to be read
+* @param	NumSupplies is the number of entries in Supplies and Values
+* @param	Values is an array receiving the raw values, Invalid for the
+*		supplies which haven't been configured
+* @param	Value is the type of reading for the Supplies
+*
+* @return	The number of configured supplies read.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XSysMonPsv_ReadSupplyValues(XSysMonPsv *InstancePtr,
+				const XSysMonPsv_Supply *Supplies,
+				u32 NumSupplies, u32 *Values,
+				XSysMonPsv_Val Value)
+{
+	UINTPTR Addr;
+	u32 Index;
+	u32 Count = 0U;
+	u8 SupplyReg;
+
+	/* Assert the arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Supplies != NULL);
+	Xil_AssertNonvoid(Values != NULL);
+
+	if(Value == XSYSMONPSV_VAL)
+		Addr = XSYSMONPSV_SUPPLY;
+
+	else if(Value == XSYSMONPSV_VAL_MIN)
+		Addr = XSYSMONPSV_SUPPLY_MIN;
+
+	else
+		Addr = XSYSMONPSV_SUPPLY_MAX;
+
+	Addr += InstancePtr->Config.BaseAddress;
+
+	for (Index = 0U; Index < NumSupplies; Index++) {
+		SupplyReg = InstancePtr->Config.Supply_List[Supplies[Index]];
+		if(SupplyReg == XSYSMONPSV_INVALID_SUPPLY) {
+			Values[Index] = XSYSMONPSV_INVALID;
+			continue;
+		}
+
+		Values[Index] = XSysMonPsv_ReadReg(Addr + SupplyReg * 4);
+		Count++;
+	}
+
+	return Count;
+}
+
 /*****************************************************************************/
 /**
 *
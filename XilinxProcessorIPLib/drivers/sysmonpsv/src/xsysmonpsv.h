@@ -110,6 +110,7 @@
 * Ver   Who    Date	Changes
 * ----- -----  -------- -----------------------------------------------
 * 1.00  aad    08/02/18 First release
+* 1.1   adk    10/15/19 Added XSysMonPsv_ReadSupplyValues()
 *
 * </pre>
 *
@@ -314,6 +315,10 @@ u32 XSysMonPsv_ReadSupplyThreshold(XSysMonPsv *InstancePtr,
 				   XSysMonPsv_Threshold ThresholdType);
 u32 XSysMonPsv_ReadSupplyValue(XSysMonPsv *InstancePtr,
 			       XSysMonPsv_Supply Supply, XSysMonPsv_Val Value);
+u32 XSysMonPsv_ReadSupplyValues(XSysMonPsv *InstancePtr,
+				const XSysMonPsv_Supply *Supplies,
+				u32 NumSupplies, u32 *Values,
+				XSysMonPsv_Val Value);
 u32 XSysMonPsv_IsNewData(XSysMonPsv *InstancePtr, XSysMonPsv_Supply Supply);
 u32 XSysMonPsv_IsAlarmCondition(XSysMonPsv *InstancePtr,
 			       XSysMonPsv_Supply Supply);
@@ -39,6 +39,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.0   sa   04/05/17 First release
+*       adk  10/15/19 Keep Magic1 in the instance, reset time source and
+*                     checkpoint.
 * </pre>
 *
 *****************************************************************************/
@@ -137,6 +139,11 @@ int XTMR_Manager_CfgInitialize(XTMR_Manager *InstancePtr, XTMR_Manager_Config *C
 	InstancePtr->RecoveryHandler = NULL;
 	InstancePtr->PostResetHandler = NULL;
 
+	InstancePtr->Magic1 = Config->Magic1;
+	InstancePtr->GetTime = NULL;
+	InstancePtr->BreakTime = 0;
+	InstancePtr->Checkpoint = NULL;
+
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
 
 	InstancePtr->RegBaseAddress = EffectiveAddr;
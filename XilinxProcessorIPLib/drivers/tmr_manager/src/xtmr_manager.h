@@ -79,6 +79,8 @@
 * 1.0   sa   04/05/17 First release
 *       ms   03/17/17 Added readme.txt file in examples folder for doxygen
 *                     generation.
+*       adk  10/15/19 Added checkpoints, recovery time statistics, and
+*                     support for several instances.
 * </pre>
 *
 *****************************************************************************/
@@ -98,6 +100,19 @@ extern "C" {
 
 /************************** Constant Definitions ****************************/
 
+/** @name Checkpoints
+ * @{
+ */
+#define XTM_CHECKPOINT_BLOCK_SIZE	256U	/**< Bytes per block */
+#define XTM_CHECKPOINT_MAGIC		0x54434B50U /**< Complete checkpoint */
+
+/**
+ * Number of block checksums needed for a region of Size bytes
+ */
+#define XTM_CHECKPOINT_BLOCKS(Size)	\
+	(((Size) + XTM_CHECKPOINT_BLOCK_SIZE - 1U) / XTM_CHECKPOINT_BLOCK_SIZE)
+/*@}*/
+
 /**************************** Type Definitions ******************************/
 
 /**
@@ -108,13 +123,54 @@ extern "C" {
 typedef void (*XTMR_Manager_Handler)(void *CallBackRef);
 
 /**
- * Statistics for the XTMR_Manager driver
+ * Time source for the statistics, returning a free running counter. The
+ * unit is the one of the counter.
+ */
+typedef u32 (*XTMR_Manager_TimeFunc)(void);
+
+/**
+ * Statistics for the XTMR_Manager driver. Times are in units of the time
+ * source, and 0 without one.
  */
 typedef struct {
 	u32 InterruptCount;		/**< Number of SEM interrupts */
 	u32 RecoveryCount;		/**< Number of recoveries performed */
+	u32 LastRecoveryTime;		/**< Break to resume, last recovery */
+	u32 MaxRecoveryTime;		/**< Break to resume, longest */
+	u32 CheckpointCount;		/**< Number of checkpoints saved */
+	u32 LastCheckpointTime;		/**< Time of the last checkpoint */
+	u32 RestoreCount;		/**< Number of checkpoints restored */
+	u32 LastRestoreTime;		/**< Time of the last restore */
+	u32 MaxRestoreTime;		/**< Time of the longest restore */
 } XTMR_Manager_Stats;
 
+/**
+ * Critical memory region saved in checkpoints
+ */
+typedef struct {
+	UINTPTR Addr;			/**< Start address, word aligned */
+	u32 Size;			/**< Size in bytes, multiple of 4 */
+} XTMR_Manager_Region;
+
+/**
+ * Checkpoint of critical memory regions. Regions, NumRegions, Store and
+ * BlockSums are set by the user, the rest by the driver. The structure and
+ * the buffers must survive a reset, see xtmr_manager_checkpoint.c.
+ */
+typedef struct {
+	XTMR_Manager_Region *Regions;	/**< Critical memory regions */
+	u32 NumRegions;			/**< Number of regions */
+	u32 *Store;			/**< Checkpoint storage, as large as
+					     all the regions together */
+	u32 *BlockSums;			/**< Checksum of each block of the
+					     store, XTM_CHECKPOINT_BLOCKS
+					     per region, or NULL */
+	u32 Magic;			/**< XTM_CHECKPOINT_MAGIC when the
+					     checkpoint is complete */
+	u32 Sequence;			/**< Number of the last checkpoint */
+	u32 BlocksSaved;		/**< Blocks written by the last one */
+} XTMR_Manager_Checkpoint;
+
 /**
  * This typedef contains configuration information for the device.
  */
@@ -170,6 +226,11 @@ typedef struct {
 
 	XTMR_Manager_Handler Handler;
 	void *CallBackRef;		/* Callback ref for handler */
+
+	u8 Magic1;			/* Magic byte 1 of this device */
+	XTMR_Manager_TimeFunc GetTime;	/* Time source for statistics */
+	u32 BreakTime;			/* Time of the last break */
+	XTMR_Manager_Checkpoint *Checkpoint; /* Attached checkpoint */
 } XTMR_Manager;
 
 
@@ -206,6 +267,19 @@ void XTMR_Manager_SetPostResetHandler(XTMR_Manager *InstancePtr,
 				      XTMR_Manager_Handler FuncPtr,
 				      void *CallBackRef);
 
+void XTMR_Manager_SetTimeSource(XTMR_Manager *InstancePtr,
+				XTMR_Manager_TimeFunc FuncPtr);
+
+/*
+ * Functions for checkpoints, in file xtmr_manager_checkpoint.c
+ */
+int XTMR_Manager_CheckpointInitialize(XTMR_Manager *InstancePtr,
+				      XTMR_Manager_Checkpoint *CheckpointPtr);
+u32 XTMR_Manager_CheckpointSave(XTMR_Manager *InstancePtr);
+int XTMR_Manager_CheckpointRestore(XTMR_Manager *InstancePtr);
+u32 XTMR_Manager_CheckpointSequence(XTMR_Manager *InstancePtr);
+void XTMR_Manager_CheckpointInvalidate(XTMR_Manager *InstancePtr);
+
 /*
  * Functions for internal watchdog, in file xtmr_manager_wdog.c
  */
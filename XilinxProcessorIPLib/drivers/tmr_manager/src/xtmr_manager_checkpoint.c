@@ -0,0 +1,420 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xtmr_manager_checkpoint.c
+* @addtogroup tmr_manager_v1_0
+* @{
+*
+* This file contains the checkpoint functions for the TMR Manager component
+* (XTMR_Manager).
+*
+* A recovery reset resumes execution where the break occurred, but when it
+* cannot be done the TMR sub-system goes through a cold reset and the
+* application starts over. Checkpoints make that restart fast: the
+* application registers its critical memory regions, saves them periodically
+* with XTMR_Manager_CheckpointSave, and after a cold reset calls
+* XTMR_Manager_CheckpointRestore to continue from the last checkpoint rather
+* than initializing and resynchronizing everything again.
+*
+* The regions are handled in blocks of XTM_CHECKPOINT_BLOCK_SIZE bytes. A
+* checkpoint only writes the blocks that changed since the previous one, and
+* a restore only writes back the blocks that differ from the checkpoint. An
+* optional checksum per block detects a corrupted checkpoint store.
+*
+* The XTMR_Manager_Checkpoint structure, the block checksums and the store
+* must be in memory that is neither cleared nor initialized at startup, for
+* instance a section marked NOLOAD in the linker script, in block RAM or in
+* external memory.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 1.0   adk  10/15/19 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+#include "xil_assert.h"
+#include "xstatus.h"
+#include "xtmr_manager.h"
+#include "xtmr_manager_i.h"
+
+/************************** Constant Definitions ****************************/
+
+#define XTM_CHECKPOINT_BLOCK_WORDS	(XTM_CHECKPOINT_BLOCK_SIZE / 4U)
+
+/**************************** Type Definitions ******************************/
+
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+
+/************************** Variable Definitions ****************************/
+
+
+/************************** Function Prototypes *****************************/
+
+static u32 XTMR_Manager_BlockSum(const u32 *Data, u32 Words);
+static int XTMR_Manager_BlockDiffers(const u32 *Src, const u32 *Dst,
+				     u32 Words);
+static void XTMR_Manager_BlockCopy(u32 *Dst, const u32 *Src, u32 Words);
+static u32 XTMR_Manager_ElapsedTime(XTMR_Manager *InstancePtr, u32 Start);
+
+
+/****************************************************************************/
+/**
+*
+* Attach a checkpoint to the instance. The regions, store and block
+* checksums of the checkpoint must be set by the caller. A checkpoint
+* saved before a cold reset is kept, and can be restored.
+*
+* @param	InstancePtr is a pointer to the XTMR_Manager instance.
+* @param	CheckpointPtr is a pointer to the checkpoint.
+*
+* @return
+*		- XST_SUCCESS if the checkpoint is attached.
+*		- XST_INVALID_PARAM if a region is not word aligned.
+*
+* @note		None.
+*
+****************************************************************************/
+int XTMR_Manager_CheckpointInitialize(XTMR_Manager *InstancePtr,
+				      XTMR_Manager_Checkpoint *CheckpointPtr)
+{
+	u32 Index;
+
+	/*
+	 * Assert validates the input arguments
+	 */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(CheckpointPtr != NULL);
+	Xil_AssertNonvoid(CheckpointPtr->Regions != NULL);
+	Xil_AssertNonvoid(CheckpointPtr->Store != NULL);
+
+	for (Index = 0; Index < CheckpointPtr->NumRegions; Index++) {
+		if (((CheckpointPtr->Regions[Index].Addr & 3U) != 0U) ||
+		    ((CheckpointPtr->Regions[Index].Size & 3U) != 0U))
+			return XST_INVALID_PARAM;
+	}
+
+	/* Anything else than a completed checkpoint is discarded */
+	if (CheckpointPtr->Magic != XTM_CHECKPOINT_MAGIC) {
+		CheckpointPtr->Magic = 0U;
+		CheckpointPtr->Sequence = 0U;
+	}
+
+	InstancePtr->Checkpoint = CheckpointPtr;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Save the critical memory regions in the checkpoint store. Only the blocks
+* that changed since the previous checkpoint are written.
+*
+* @param	InstancePtr is a pointer to the XTMR_Manager instance.
+*
+* @return	Number of blocks written.
+*
+* @note		A fault during the save leaves no valid checkpoint, until the
+*		next save completes.
+*
+****************************************************************************/
+u32 XTMR_Manager_CheckpointSave(XTMR_Manager *InstancePtr)
+{
+	XTMR_Manager_Checkpoint *CheckpointPtr;
+	u32 *Store;
+	u32 *Sum;
+	u32 *Live;
+	u32 Index, Offset, Words;
+	u32 Blocks = 0U;
+	u32 Start = 0U;
+	int Full;
+
+	/*
+	 * Assert validates the input arguments
+	 */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(InstancePtr->Checkpoint != NULL);
+
+	CheckpointPtr = InstancePtr->Checkpoint;
+	if (InstancePtr->GetTime != NULL)
+		Start = InstancePtr->GetTime();
+
+	/* The first checkpoint writes everything */
+	Full = (CheckpointPtr->Sequence == 0U);
+	CheckpointPtr->Magic = 0U;
+
+	Store = CheckpointPtr->Store;
+	Sum = CheckpointPtr->BlockSums;
+	for (Index = 0; Index < CheckpointPtr->NumRegions; Index++) {
+		Live = (u32 *)CheckpointPtr->Regions[Index].Addr;
+		for (Offset = 0; Offset < CheckpointPtr->Regions[Index].Size;
+		     Offset += XTM_CHECKPOINT_BLOCK_SIZE) {
+			Words = (CheckpointPtr->Regions[Index].Size - Offset)
+				/ 4U;
+			if (Words > XTM_CHECKPOINT_BLOCK_WORDS)
+				Words = XTM_CHECKPOINT_BLOCK_WORDS;
+
+			if (Full ||
+			    XTMR_Manager_BlockDiffers(Live, Store, Words)) {
+				XTMR_Manager_BlockCopy(Store, Live, Words);
+				if (Sum != NULL)
+					*Sum = XTMR_Manager_BlockSum(Store,
+								     Words);
+				Blocks++;
+			}
+
+			Live += Words;
+			Store += Words;
+			if (Sum != NULL)
+				Sum++;
+		}
+	}
+
+	CheckpointPtr->Sequence++;
+	CheckpointPtr->BlocksSaved = Blocks;
+	CheckpointPtr->Magic = XTM_CHECKPOINT_MAGIC;
+
+	InstancePtr->Stats.CheckpointCount++;
+	InstancePtr->Stats.LastCheckpointTime =
+		XTMR_Manager_ElapsedTime(InstancePtr, Start);
+
+	return Blocks;
+}
+
+/****************************************************************************/
+/**
+*
+* Restore the critical memory regions from the last checkpoint, typically
+* after a cold reset. Only the blocks that differ from the checkpoint are
+* written.
+*
+* @param	InstancePtr is a pointer to the XTMR_Manager instance.
+*
+* @return
+*		- XST_SUCCESS if the regions are restored.
+*		- XST_FAILURE if there is no complete checkpoint, or if a block
+*		of the store does not match its checksum. Nothing is
+*		restored then.
+*
+* @note		None.
+*
+****************************************************************************/
+int XTMR_Manager_CheckpointRestore(XTMR_Manager *InstancePtr)
+{
+	XTMR_Manager_Checkpoint *CheckpointPtr;
+	u32 *Store;
+	u32 *Sum;
+	u32 *Live;
+	u32 Index, Offset, Words, Time;
+	u32 Start = 0U;
+
+	/*
+	 * Assert validates the input arguments
+	 */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(InstancePtr->Checkpoint != NULL);
+
+	CheckpointPtr = InstancePtr->Checkpoint;
+	if (CheckpointPtr->Magic != XTM_CHECKPOINT_MAGIC)
+		return XST_FAILURE;
+
+	if (InstancePtr->GetTime != NULL)
+		Start = InstancePtr->GetTime();
+
+	/* Check the whole store before touching the regions */
+	if (CheckpointPtr->BlockSums != NULL) {
+		Store = CheckpointPtr->Store;
+		Sum = CheckpointPtr->BlockSums;
+		for (Index = 0; Index < CheckpointPtr->NumRegions; Index++) {
+			for (Offset = 0;
+			     Offset < CheckpointPtr->Regions[Index].Size;
+			     Offset += XTM_CHECKPOINT_BLOCK_SIZE) {
+				Words = (CheckpointPtr->Regions[Index].Size -
+					 Offset) / 4U;
+				if (Words > XTM_CHECKPOINT_BLOCK_WORDS)
+					Words = XTM_CHECKPOINT_BLOCK_WORDS;
+				if (*Sum != XTMR_Manager_BlockSum(Store, Words))
+					return XST_FAILURE;
+				Store += Words;
+				Sum++;
+			}
+		}
+	}
+
+	Store = CheckpointPtr->Store;
+	for (Index = 0; Index < CheckpointPtr->NumRegions; Index++) {
+		Live = (u32 *)CheckpointPtr->Regions[Index].Addr;
+		for (Offset = 0; Offset < CheckpointPtr->Regions[Index].Size;
+		     Offset += XTM_CHECKPOINT_BLOCK_SIZE) {
+			Words = (CheckpointPtr->Regions[Index].Size - Offset)
+				/ 4U;
+			if (Words > XTM_CHECKPOINT_BLOCK_WORDS)
+				Words = XTM_CHECKPOINT_BLOCK_WORDS;
+			if (XTMR_Manager_BlockDiffers(Store, Live, Words))
+				XTMR_Manager_BlockCopy(Live, Store, Words);
+			Live += Words;
+			Store += Words;
+		}
+	}
+
+	Time = XTMR_Manager_ElapsedTime(InstancePtr, Start);
+	InstancePtr->Stats.RestoreCount++;
+	InstancePtr->Stats.LastRestoreTime = Time;
+	if (Time > InstancePtr->Stats.MaxRestoreTime)
+		InstancePtr->Stats.MaxRestoreTime = Time;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Tell if a complete checkpoint is available for restore.
+*
+* @param	InstancePtr is a pointer to the XTMR_Manager instance.
+*
+* @return	Number of the last checkpoint, 0 if there is none.
+*
+* @note		None.
+*
+****************************************************************************/
+u32 XTMR_Manager_CheckpointSequence(XTMR_Manager *InstancePtr)
+{
+	/*
+	 * Assert validates the input arguments
+	 */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if ((InstancePtr->Checkpoint == NULL) ||
+	    (InstancePtr->Checkpoint->Magic != XTM_CHECKPOINT_MAGIC))
+		return 0U;
+
+	return InstancePtr->Checkpoint->Sequence;
+}
+
+/****************************************************************************/
+/**
+*
+* Discard the checkpoint, for instance when the application state it holds
+* is known to be wrong.
+*
+* @param	InstancePtr is a pointer to the XTMR_Manager instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+void XTMR_Manager_CheckpointInvalidate(XTMR_Manager *InstancePtr)
+{
+	/*
+	 * Assert validates the input arguments
+	 */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->Checkpoint != NULL) {
+		InstancePtr->Checkpoint->Magic = 0U;
+		InstancePtr->Checkpoint->Sequence = 0U;
+	}
+}
+
+/****************************************************************************
+*
+* Checksum of a block, rotate and xor so that swapped words are detected.
+*
+*****************************************************************************/
+static u32 XTMR_Manager_BlockSum(const u32 *Data, u32 Words)
+{
+	u32 Sum = XTM_CHECKPOINT_MAGIC;
+	u32 Index;
+
+	for (Index = 0; Index < Words; Index++)
+		Sum = ((Sum << 5) | (Sum >> 27)) ^ Data[Index];
+
+	return Sum;
+}
+
+/****************************************************************************
+*
+* Compare two blocks, returns 1 if they differ.
+*
+*****************************************************************************/
+static int XTMR_Manager_BlockDiffers(const u32 *Src, const u32 *Dst,
+				     u32 Words)
+{
+	u32 Index;
+
+	for (Index = 0; Index < Words; Index++) {
+		if (Src[Index] != Dst[Index])
+			return 1;
+	}
+
+	return 0;
+}
+
+/****************************************************************************
+*
+* Copy a block word by word.
+*
+*****************************************************************************/
+static void XTMR_Manager_BlockCopy(u32 *Dst, const u32 *Src, u32 Words)
+{
+	u32 Index;
+
+	for (Index = 0; Index < Words; Index++)
+		Dst[Index] = Src[Index];
+}
+
+/****************************************************************************
+*
+* Time since Start with the time source of the instance, 0 without one.
+*
+*****************************************************************************/
+static u32 XTMR_Manager_ElapsedTime(XTMR_Manager *InstancePtr, u32 Start)
+{
+	if (InstancePtr->GetTime == NULL)
+		return 0U;
+
+	return InstancePtr->GetTime() - Start;
+}
+
+/** @} */
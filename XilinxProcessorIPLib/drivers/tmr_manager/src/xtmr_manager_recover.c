@@ -39,6 +39,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.0   sa   04/05/17 First release
+*       adk  10/15/19 Check Magic1 of the instance rather than the one of
+*                     device 0, record recovery time.
 * </pre>
 *
 *****************************************************************************/
@@ -94,7 +96,11 @@ void XTMR_Manager_BreakHandler (XTMR_Manager *InstancePtr)
 	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 	Xil_AssertVoid((InstancePtr->Cr & XTM_CR_RIR) != 0);
 	Xil_AssertVoid((InstancePtr->Cr & XTM_CR_MAGIC1_MASK) ==
-		       XPAR_TMR_MANAGER_0_MAGIC1);
+		       InstancePtr->Magic1);
+
+	/* Recovery time is counted from here */
+	if (InstancePtr->GetTime != NULL)
+		InstancePtr->BreakTime = InstancePtr->GetTime();
 
 	/* Call user defined pre-recovery handler, if any */
 	if (InstancePtr->PreResetHandler != NULL)
@@ -118,6 +124,7 @@ void XTMR_Manager_BreakHandler (XTMR_Manager *InstancePtr)
 int XTMR_Manager_ResetHandler (XTMR_Manager *InstancePtr)
 {
         u32 ffr;
+	u32 time;
 	int rec_reset_12_13, rec_reset_12_23, rec_reset_13_23, rec_reset;
 
 	/*
@@ -154,6 +161,14 @@ int XTMR_Manager_ResetHandler (XTMR_Manager *InstancePtr)
 		XTMR_Manager_ClearFirstFailingReg(InstancePtr->RegBaseAddress);
 		InstancePtr->Stats.RecoveryCount++;
 
+		/* The time source must keep counting through the reset */
+		if (InstancePtr->GetTime != NULL) {
+			time = InstancePtr->GetTime() - InstancePtr->BreakTime;
+			InstancePtr->Stats.LastRecoveryTime = time;
+			if (time > InstancePtr->Stats.MaxRecoveryTime)
+				InstancePtr->Stats.MaxRecoveryTime = time;
+		}
+
 		/* Restore saved context and resume execution */
 		return 1;
 	} else {
@@ -241,4 +256,30 @@ void XTMR_Manager_SetPostResetHandler(XTMR_Manager *InstancePtr,
 }
 
 
+/****************************************************************************/
+/**
+*
+* Set the time source used for the recovery, checkpoint and restore times of
+* the statistics. It must be a free running counter that is not reset by a
+* recovery reset, such as a timer outside the TMR sub-system.
+*
+* @param	InstancePtr is a pointer to the XTMR_Manager instance.
+* @param	FuncPtr returns the counter value, NULL to stop timing.
+*
+* @note		None.
+*
+******************************************************************************/
+void XTMR_Manager_SetTimeSource(XTMR_Manager *InstancePtr,
+				XTMR_Manager_TimeFunc FuncPtr)
+{
+	/*
+	 * Assert validates the input arguments
+	 */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	InstancePtr->GetTime = FuncPtr;
+}
+
+
 /** @} */
@@ -39,6 +39,7 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.0   sa   04/05/17 First release
+*       adk  10/15/19 Added recovery, checkpoint and restore statistics.
 * </pre>
 *
 *****************************************************************************/
@@ -90,8 +91,7 @@ void XTMR_Manager_GetStats(XTMR_Manager *InstancePtr, XTMR_Manager_Stats *StatsP
 
 	/* Copy the stats from the instance to the specified stats */
 
-	StatsPtr->InterruptCount = InstancePtr->Stats.InterruptCount;
-	StatsPtr->RecoveryCount = InstancePtr->Stats.RecoveryCount;
+	*StatsPtr = InstancePtr->Stats;
 }
 
 /****************************************************************************/
@@ -116,6 +116,13 @@ void XTMR_Manager_ClearStats(XTMR_Manager *InstancePtr)
 
 	InstancePtr->Stats.InterruptCount = 0;
 	InstancePtr->Stats.RecoveryCount = 0;
+	InstancePtr->Stats.LastRecoveryTime = 0;
+	InstancePtr->Stats.MaxRecoveryTime = 0;
+	InstancePtr->Stats.CheckpointCount = 0;
+	InstancePtr->Stats.LastCheckpointTime = 0;
+	InstancePtr->Stats.RestoreCount = 0;
+	InstancePtr->Stats.LastRestoreTime = 0;
+	InstancePtr->Stats.MaxRestoreTime = 0;
 }
 
 /** @} */
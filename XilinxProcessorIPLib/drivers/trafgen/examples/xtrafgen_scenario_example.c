@@ -0,0 +1,272 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xtrafgen_scenario_example.c
+ *
+ * This file demonstrates how to use the scenario layer of the xtrafgen
+ * driver to stress a memory. A scenario made of a sequential write stream
+ * and a rate limited random read stream is loaded into every AXI Traffic
+ * Generator of the design, and the cores are run in lockstep.
+ *
+ * When the design has an AXI Performance Monitor, slot 0 of the monitor is
+ * expected to observe the memory. The bytes it counts and the global clock
+ * counter give the achieved write and read bandwidth, which is compared
+ * with the bytes the scenario issued.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 4.3   adk  10/15/19 First release
+ * </pre>
+ *
+ * ***************************************************************************
+ */
+
+/***************************** Include Files *********************************/
+#include "xtrafgen_scenario.h"
+#include "xparameters.h"
+#include "xil_printf.h"
+
+#ifdef XPAR_AXIPMON_0_DEVICE_ID
+#include "xaxipmon.h"
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#ifdef XPAR_XTRAFGEN_1_DEVICE_ID
+#define NUM_TRAFGEN	2
+#else
+#define NUM_TRAFGEN	1
+#endif
+
+#ifdef XPAR_PSU_DDR_0_S_AXI_BASEADDR
+#define MEM_BASE_ADDR	(XPAR_PSU_DDR_0_S_AXI_BASEADDR + 0x10000000)
+#elif defined(XPAR_MIG7SERIES_0_BASEADDR)
+#define MEM_BASE_ADDR	(XPAR_MIG7SERIES_0_BASEADDR + 0x1000000)
+#else
+#warning CHECK FOR THE VALID DDR ADDRESS IN XPARAMETERS.H, \
+                        DEFAULT SET TO 0x10000000
+#define MEM_BASE_ADDR	0x10000000
+#endif
+
+#define MEM_WINDOW	0x100000	/* Bytes exercised per core */
+#define APM_CLOCK_HZ	100000000	/* APM core clock */
+#define APM_SLOT	0		/* Slot observing the memory */
+
+/************************** Function Prototypes ******************************/
+
+int XTrafGenScenarioExample(void);
+
+/************************** Variable Definitions *****************************/
+
+static XTrafGen XTrafGenInstance[NUM_TRAFGEN];
+
+#ifdef XPAR_AXIPMON_0_DEVICE_ID
+static XAxiPmon AxiPmonInst;
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Main function
+*
+* This function is the main entry of the scenario example.
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if tests pass
+* 		- XST_FAILURE if fails.
+*
+* @note		None.
+*
+******************************************************************************/
+int main()
+{
+	int Status;
+
+	xil_printf("Entering main\n\r");
+
+	Status = XTrafGenScenarioExample();
+	if (Status != XST_SUCCESS) {
+		xil_printf("Traffic Generator Scenario Example Test Failed\n\r");
+		xil_printf("--- Exiting main() ---\n\r");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran Traffic Generator Scenario Example\n\r");
+	xil_printf("--- Exiting main() ---\n\r");
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function demonstrates the usage of the scenario layer.
+* It does the following:
+*	- Initialize the AXI Traffic Generator devices
+*	- Load a scenario into each of them, on its own memory window
+*	- Start the AXI Performance Monitor counters, if present
+*	- Run the cores in lockstep
+*	- Report the issued and the measured bandwidth
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if successful
+*		- XST_FAILURE if unsuccessful
+*
+* @note		None.
+*
+******************************************************************************/
+int XTrafGenScenarioExample(void)
+{
+	XTrafGen *Instances[NUM_TRAFGEN];
+	XTrafGen_Config *Config;
+	XTrafGen_ScnStream Streams[2];
+	XTrafGen_Scenario Scenario;
+	XTrafGen_ScnStats Stats;
+	u64 WrBytes = 0;
+	u64 RdBytes = 0;
+	u32 Errors[NUM_TRAFGEN];
+	u32 Index;
+	int Status;
+#ifdef XPAR_AXIPMON_0_DEVICE_ID
+	XAxiPmon_Config *ApmConfig;
+	u32 ClkHigh;
+	u32 ClkLow;
+	u32 WrCount;
+	u32 RdCount;
+#endif
+
+	memset(Streams, 0, sizeof(Streams));
+
+	/* Back to back 1KB sequential writes */
+	Streams[0].RdWrFlag = XTG_WRITE;
+	Streams[0].AddrPattern = XTG_SCN_ADDR_SEQ;
+	Streams[0].Size = 2;
+	Streams[0].Beats = 256;
+	Streams[0].Count = 64;
+
+	/* 64 byte random reads, one every 32 clocks */
+	Streams[1].RdWrFlag = XTG_READ;
+	Streams[1].AddrPattern = XTG_SCN_ADDR_RAND;
+	Streams[1].Size = 2;
+	Streams[1].Beats = 16;
+	Streams[1].Range = MEM_WINDOW;
+	Streams[1].Count = 128;
+	Streams[1].Delay = 32;
+
+	Scenario.Streams = Streams;
+	Scenario.NumStreams = 2;
+
+	for (Index = 0; Index < NUM_TRAFGEN; Index++) {
+		Config = XTrafGen_LookupConfig(XPAR_XTRAFGEN_0_DEVICE_ID +
+						Index);
+		if (!Config) {
+			return XST_FAILURE;
+		}
+		Status = XTrafGen_CfgInitialize(&XTrafGenInstance[Index],
+					Config, Config->BaseAddress);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		Instances[Index] = &XTrafGenInstance[Index];
+
+		Streams[0].Address = MEM_BASE_ADDR + Index * MEM_WINDOW;
+		Streams[1].Address = Streams[0].Address;
+		Scenario.Seed = Index + 1;
+
+		Status = XTrafGen_ScenarioLoad(Instances[Index], &Scenario,
+						&Stats);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Scenario load failed on core %d\n\r",
+						Index);
+			return XST_FAILURE;
+		}
+		WrBytes += Stats.WrBytes;
+		RdBytes += Stats.RdBytes;
+	}
+
+#ifdef XPAR_AXIPMON_0_DEVICE_ID
+	ApmConfig = XAxiPmon_LookupConfig(XPAR_AXIPMON_0_DEVICE_ID);
+	if (ApmConfig == NULL) {
+		return XST_FAILURE;
+	}
+	XAxiPmon_CfgInitialize(&AxiPmonInst, ApmConfig,
+				ApmConfig->BaseAddress);
+	XAxiPmon_SetMetrics(&AxiPmonInst, APM_SLOT, XAPM_METRIC_SET_2,
+				XAPM_METRIC_COUNTER_0);
+	XAxiPmon_SetMetrics(&AxiPmonInst, APM_SLOT, XAPM_METRIC_SET_3,
+				XAPM_METRIC_COUNTER_1);
+	XAxiPmon_ResetMetricCounter(&AxiPmonInst);
+	XAxiPmon_ResetGlobalClkCounter(&AxiPmonInst);
+	XAxiPmon_StartCounters(&AxiPmonInst, 0xFFFFFFFF);
+#endif
+
+	Status = XTrafGen_ScenarioStart(Instances, NUM_TRAFGEN, 0);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XTrafGen_ScenarioWait(Instances, NUM_TRAFGEN, Errors);
+	for (Index = 0; Index < NUM_TRAFGEN; Index++) {
+		if (Errors[Index] != 0) {
+			xil_printf("Core %d errors 0x%08x\n\r", Index,
+						Errors[Index]);
+		}
+	}
+
+#ifdef XPAR_AXIPMON_0_DEVICE_ID
+	XAxiPmon_StopCounters(&AxiPmonInst);
+	XAxiPmon_GetGlobalClkCounter(&AxiPmonInst, &ClkHigh, &ClkLow);
+	WrCount = XAxiPmon_GetMetricCounter(&AxiPmonInst,
+					XAPM_METRIC_COUNTER_0);
+	RdCount = XAxiPmon_GetMetricCounter(&AxiPmonInst,
+					XAPM_METRIC_COUNTER_1);
+	if (ClkLow != 0) {
+		xil_printf("Measured %d clocks, write %d MB/s read %d MB/s\n\r",
+			ClkLow,
+			(u32)(((u64)WrCount * (APM_CLOCK_HZ / 1000000)) /
+				ClkLow),
+			(u32)(((u64)RdCount * (APM_CLOCK_HZ / 1000000)) /
+				ClkLow));
+	}
+	xil_printf("Monitor counted %d bytes written, %d bytes read\n\r",
+				WrCount, RdCount);
+#endif
+	xil_printf("Scenario issued %d bytes written, %d bytes read\n\r",
+			(u32)WrBytes, (u32)RdBytes);
+
+	return Status;
+}
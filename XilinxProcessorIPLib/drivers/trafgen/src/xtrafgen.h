@@ -200,6 +200,9 @@
 *                    examples.
 * 4.2   ms  04/18/17 Modified tcl file to add suffix U for all macros
 *                    definitions of trafgen in xparameters.h
+* 4.3   adk 10/15/19 Added the scenario layer in xtrafgen_scenario.c/.h,
+*                    which compiles stream descriptions into command RAM
+*                    entries and runs several cores in lockstep.
 * </pre>
 ******************************************************************************/
 
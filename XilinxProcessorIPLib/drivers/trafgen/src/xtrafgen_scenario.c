@@ -0,0 +1,417 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xtrafgen_scenario.c
+* @addtogroup trafgen_v4_2
+* @{
+*
+* This file contains the scenario layer of the AXI Traffic Generator driver.
+* See xtrafgen_scenario.h for a description of the layer.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.3   adk  10/15/19 First release
+* </pre>
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xtrafgen_scenario.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XTG_SCN_BURST_INCR	1	/**< INCR burst type */
+#define XTG_SCN_RESP_ANY	7	/**< Expected response, do not check */
+#define XTG_SCN_MAX_BYTES	4096	/**< AXI bursts do not cross 4KB */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static int XTrafGen_ScnAddStream(XTrafGen *InstancePtr,
+			const XTrafGen_ScnStream *StrPtr, u32 *Lfsr,
+			XTrafGen_ScnStats *StatsPtr);
+static void XTrafGen_ScnInitCmd(XTrafGen_Cmd *CmdPtr,
+			const XTrafGen_ScnStream *StrPtr);
+
+/************************** Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+* Compile a scenario into the command and parameter RAMs of a core.
+*
+* The software list of commands is erased, every stream is turned into one
+* or more command entries in its region, each region is terminated and the
+* list is written to the RAMs. The core must be stopped.
+*
+* @param        InstancePtr is a pointer to the Axi TrafGen instance to be
+*               worked on. It must be in Advanced or Basic mode.
+* @param	ScnPtr is a pointer to the scenario.
+* @param	StatsPtr is where the scenario statistics are returned. It
+*		may be NULL.
+*
+* @return
+*		- XST_SUCCESS if successful
+*		- XST_INVALID_PARAM if a stream is invalid for this core
+*		- XST_FAILURE if a region runs out of command entries or the
+*		  RAMs could not be programmed
+*
+*****************************************************************************/
+int XTrafGen_ScenarioLoad(XTrafGen *InstancePtr,
+			const XTrafGen_Scenario *ScnPtr,
+			XTrafGen_ScnStats *StatsPtr)
+{
+	XTrafGen_ScnStats Stats;
+	XTrafGen_Cmd Cmd;
+	u32 Lfsr;
+	u32 Index;
+	int Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady);
+	Xil_AssertNonvoid(ScnPtr != NULL);
+	Xil_AssertNonvoid((ScnPtr->Streams != NULL) ||
+			(ScnPtr->NumStreams == 0));
+
+	if ((InstancePtr->OperatingMode != XTG_MODE_FULL) &&
+		(InstancePtr->OperatingMode != XTG_MODE_BASIC)) {
+		return XST_INVALID_PARAM;
+	}
+
+	memset(&Stats, 0, sizeof(Stats));
+	Lfsr = (ScnPtr->Seed != 0) ? ScnPtr->Seed : 1;
+
+	Status = XTrafGen_EraseAllCommands(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	for (Index = 0; Index < ScnPtr->NumStreams; Index++) {
+		Status = XTrafGen_ScnAddStream(InstancePtr,
+				&ScnPtr->Streams[Index], &Lfsr, &Stats);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+	}
+
+	/* An invalid command ends each region */
+	for (Index = 0; Index < NUM_BLOCKS; Index++) {
+		memset(&Cmd, 0, sizeof(Cmd));
+		Cmd.RdWrFlag = Index;
+		Status = XTrafGen_AddCommand(InstancePtr, &Cmd);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	Status = XTrafGen_WriteCmdsToHw(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	if (StatsPtr != NULL) {
+		*StatsPtr = Stats;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Start the master logic of several cores in lockstep.
+*
+* The loop bit of every core is set first, then the master logic of the
+* cores is enabled back to back so that their traffic starts together.
+*
+* @param        Instances is an array of pointers to loaded instances.
+* @param	NumInstances is the number of instances.
+* @param	Loop is 1 to replay the scenarios until XTrafGen_ScenarioStop()
+*		is called, 0 to run them once.
+*
+* @return
+*		- XST_SUCCESS if successful
+*		- XST_DEVICE_BUSY if a core is already running
+*
+*****************************************************************************/
+int XTrafGen_ScenarioStart(XTrafGen **Instances, u32 NumInstances, u8 Loop)
+{
+	u32 Index;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(Instances != NULL);
+
+	for (Index = 0; Index < NumInstances; Index++) {
+		Xil_AssertNonvoid(Instances[Index] != NULL);
+		if (!XTrafGen_IsMasterLogicDone(Instances[Index])) {
+			return XST_DEVICE_BUSY;
+		}
+
+		XTrafGen_ClearErrors(Instances[Index], XTG_ERR_ALL_ERR_MASK |
+					XTG_ERR_MSTCMP_MASK);
+		if (Loop) {
+			XTrafGen_LoopEnable(Instances[Index]);
+		} else {
+			XTrafGen_LoopDisable(Instances[Index]);
+		}
+	}
+
+	for (Index = 0; Index < NumInstances; Index++) {
+		XTrafGen_StartMasterLogic(Instances[Index]);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Stop looping scenarios.
+*
+* The loop bit of every core is cleared, each core stops at the end of its
+* current pass. XTrafGen_ScenarioWait() waits for the cores to stop.
+*
+* @param        Instances is an array of pointers to running instances.
+* @param	NumInstances is the number of instances.
+*
+*****************************************************************************/
+void XTrafGen_ScenarioStop(XTrafGen **Instances, u32 NumInstances)
+{
+	u32 Index;
+
+	/* Verify arguments */
+	Xil_AssertVoid(Instances != NULL);
+
+	for (Index = 0; Index < NumInstances; Index++) {
+		XTrafGen_LoopDisable(Instances[Index]);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Wait for the master logic of several cores to complete.
+*
+* @param        Instances is an array of pointers to running instances.
+* @param	NumInstances is the number of instances.
+* @param	Errors is an array of NumInstances words where the master and
+*		slave errors of each core are returned. It may be NULL.
+*
+* @return
+*		- XST_SUCCESS if all the cores completed without errors
+*		- XST_FAILURE if a core reported an error
+*
+*****************************************************************************/
+int XTrafGen_ScenarioWait(XTrafGen **Instances, u32 NumInstances,
+			u32 *Errors)
+{
+	int Status = XST_SUCCESS;
+	u32 Error;
+	u32 Index;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(Instances != NULL);
+
+	for (Index = 0; Index < NumInstances; Index++) {
+		while (!XTrafGen_IsMasterLogicDone(Instances[Index])) {
+			;
+		}
+
+		Error = XTrafGen_ReadErrors(Instances[Index]);
+		if (Error != 0) {
+			Status = XST_FAILURE;
+		}
+		if (Errors != NULL) {
+			Errors[Index] = Error;
+		}
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Add the command entries of a stream.
+*
+* @param        InstancePtr is a pointer to the Axi TrafGen instance to be
+*               worked on.
+* @param	StrPtr is a pointer to the stream.
+* @param	Lfsr is the random address generator state.
+* @param	StatsPtr is a pointer to the statistics to update.
+*
+* @return
+*		- XST_SUCCESS if successful
+*		- XST_INVALID_PARAM if the stream is invalid for this core
+*		- XST_FAILURE if the region runs out of command entries
+*
+*****************************************************************************/
+static int XTrafGen_ScnAddStream(XTrafGen *InstancePtr,
+			const XTrafGen_ScnStream *StrPtr, u32 *Lfsr,
+			XTrafGen_ScnStats *StatsPtr)
+{
+	XTrafGen_CmdInfo *CmdInfo;
+	XTrafGen_Cmd Cmd;
+	UINTPTR Address;
+	u32 Bytes;
+	u32 Align;
+	u32 Left;
+	u32 Count;
+	u32 Used;
+	u32 Free;
+	u32 Entries;
+	int Status;
+
+	if ((StrPtr->Beats == 0) || (StrPtr->Beats > 256) ||
+		(StrPtr->Size > (InstancePtr->MasterWidth + 2)) ||
+		(StrPtr->AddrPattern > XTG_SCN_ADDR_RAND) ||
+		(StrPtr->Delay > XTG_SCN_MAX_DELAY)) {
+		return XST_INVALID_PARAM;
+	}
+
+	Bytes = (u32)StrPtr->Beats << StrPtr->Size;
+	if (Bytes > XTG_SCN_MAX_BYTES) {
+		return XST_INVALID_PARAM;
+	}
+
+	/* Random bursts are aligned so that they never cross 4KB */
+	for (Align = 1; Align < Bytes; Align <<= 1) {
+		;
+	}
+	if ((StrPtr->AddrPattern == XTG_SCN_ADDR_RAND) &&
+			(StrPtr->Range < Align)) {
+		return XST_INVALID_PARAM;
+	}
+
+	if (StrPtr->Count == 0) {
+		return XST_SUCCESS;
+	}
+
+	/* One entry per transaction unless the repeat opcode can be used */
+	if ((StrPtr->AddrPattern == XTG_SCN_ADDR_RAND) ||
+			(StrPtr->Delay != 0)) {
+		Entries = StrPtr->Count;
+	} else {
+		Entries = (StrPtr->Count + XTG_SCN_MAX_REPEAT - 1) /
+					XTG_SCN_MAX_REPEAT;
+	}
+
+	/* Keep one entry for the invalid command ending the region */
+	CmdInfo = &InstancePtr->CmdInfo;
+	Used = (StrPtr->RdWrFlag == XTG_WRITE) ? CmdInfo->WrIndex :
+					CmdInfo->RdIndex;
+	Free = MAX_NUM_ENTRIES - 1 - Used;
+	if (Entries > Free) {
+		return XST_FAILURE;
+	}
+
+	Address = StrPtr->Address;
+	Left = StrPtr->Count;
+	while (Left > 0) {
+		XTrafGen_ScnInitCmd(&Cmd, StrPtr);
+
+		if (StrPtr->AddrPattern == XTG_SCN_ADDR_RAND) {
+			*Lfsr ^= *Lfsr << 13;
+			*Lfsr ^= *Lfsr >> 17;
+			*Lfsr ^= *Lfsr << 5;
+			Cmd.CRamCmd.Address = StrPtr->Address +
+				(*Lfsr % (StrPtr->Range / Align)) * Align;
+		} else {
+			Cmd.CRamCmd.Address = Address;
+		}
+
+		if (Entries == StrPtr->Count) {
+			Count = 1;
+			if (StrPtr->Delay != 0) {
+				Cmd.PRamCmd.Opcode = XTG_PARAM_OP_DELAY;
+				Cmd.PRamCmd.OpCntl0 = StrPtr->Delay;
+			}
+		} else {
+			Count = (Left > XTG_SCN_MAX_REPEAT) ?
+					XTG_SCN_MAX_REPEAT : Left;
+			Cmd.PRamCmd.Opcode = XTG_PARAM_OP_RPT;
+			Cmd.PRamCmd.OpCntl0 = Count - 1;
+			if (StrPtr->AddrPattern == XTG_SCN_ADDR_SEQ) {
+				Cmd.PRamCmd.AddrMode =
+					XTG_PARAM_OP_ADDRMODE_INCR;
+			}
+		}
+
+		Status = XTrafGen_AddCommand(InstancePtr, &Cmd);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		if (StrPtr->AddrPattern == XTG_SCN_ADDR_SEQ) {
+			Address += (UINTPTR)Count * Bytes;
+		}
+		Left -= Count;
+	}
+
+	if (StrPtr->RdWrFlag == XTG_WRITE) {
+		StatsPtr->WrBytes += (u64)StrPtr->Count * Bytes;
+		StatsPtr->WrTransactions += StrPtr->Count;
+		StatsPtr->WrEntries += Entries;
+	} else {
+		StatsPtr->RdBytes += (u64)StrPtr->Count * Bytes;
+		StatsPtr->RdTransactions += StrPtr->Count;
+		StatsPtr->RdEntries += Entries;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Fill the fields of a command common to all the entries of a stream.
+*
+* @param	CmdPtr is a pointer to Command structure.
+* @param	StrPtr is a pointer to the stream.
+*
+*****************************************************************************/
+static void XTrafGen_ScnInitCmd(XTrafGen_Cmd *CmdPtr,
+			const XTrafGen_ScnStream *StrPtr)
+{
+	memset(CmdPtr, 0, sizeof(XTrafGen_Cmd));
+
+	CmdPtr->RdWrFlag = StrPtr->RdWrFlag;
+	CmdPtr->CRamCmd.ValidCmd = 1;
+	CmdPtr->CRamCmd.Burst = XTG_SCN_BURST_INCR;
+	CmdPtr->CRamCmd.Size = StrPtr->Size;
+	CmdPtr->CRamCmd.Length = StrPtr->Beats - 1;
+	CmdPtr->CRamCmd.Qos = StrPtr->Qos;
+	CmdPtr->CRamCmd.Cache = StrPtr->Cache;
+	CmdPtr->CRamCmd.ExpectedResp = XTG_SCN_RESP_ANY;
+
+	CmdPtr->PRamCmd.Opcode = XTG_PARAM_OP_NOP;
+	CmdPtr->PRamCmd.AddrMode = XTG_PARAM_OP_ADDRMODE_CONST;
+	CmdPtr->PRamCmd.IntervalMode = XTG_PARAMOP_INTERVALMODE_CONST;
+}
+/** @} */
@@ -0,0 +1,140 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xtrafgen_scenario.h
+* @addtogroup trafgen_v4_2
+* @{
+*
+* This file contains the scenario layer of the AXI Traffic Generator driver.
+*
+* A scenario is a list of streams. Each stream describes a read or write
+* traffic pattern: burst length and size, address pattern, number of
+* transactions and the idle clocks before each transaction, which sets the
+* rate. XTrafGen_ScenarioLoad() compiles the streams into the command and
+* parameter RAM entries of an Advanced or Basic mode core and programs them.
+*
+* - Fixed and sequential streams without delay take one entry per 2^24
+*   transactions, using the repeat opcode.
+* - Random streams and streams with a delay take one entry per
+*   transaction. Random addresses are drawn from a seeded LFSR, so that a
+*   scenario replays the same addresses on every run.
+*
+* Read and write streams are issued concurrently by the read and write
+* blocks of the core. XTrafGen_ScenarioStart() starts several cores back to
+* back so that they run in lockstep, and XTrafGen_ScenarioWait() waits for
+* all of them and collects their errors. Bandwidth and latency are measured
+* with an AXI Performance Monitor, see xtrafgen_scenario_example.c.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.3   adk  10/15/19 First release
+* </pre>
+******************************************************************************/
+
+#ifndef XTRAFGEN_SCENARIO_H	/* prevent circular inclusions */
+#define XTRAFGEN_SCENARIO_H	/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xtrafgen.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Stream address patterns */
+#define XTG_SCN_ADDR_FIXED	0	/**< Same address every transaction */
+#define XTG_SCN_ADDR_SEQ	1	/**< Address incremented by the
+					  *  transaction size */
+#define XTG_SCN_ADDR_RAND	2	/**< Random aligned address in
+					  *  [Address, Address + Range) */
+
+#define XTG_SCN_MAX_REPEAT	0x1000000	/**< Transactions per repeat
+						  *  entry */
+#define XTG_SCN_MAX_DELAY	0xFFFFFF	/**< Maximum delay in clocks */
+
+/************************** Type Definitions *****************************/
+
+/**
+ * Stream of transactions, described by the user.
+ */
+typedef struct XTrafGen_ScnStream {
+	u8 RdWrFlag;		/**< XTG_READ or XTG_WRITE */
+	u8 AddrPattern;		/**< XTG_SCN_ADDR_* */
+	u8 Size;		/**< Log2 of the bytes per beat */
+	u8 Qos;			/**< Driven to a*_qos line */
+	u8 Cache;		/**< Driven to a*_cache line */
+	u16 Beats;		/**< Beats per burst, 1 to 256 */
+	UINTPTR Address;	/**< Start address */
+	u32 Range;		/**< Random address window in bytes */
+	u32 Count;		/**< Number of transactions */
+	u32 Delay;		/**< Idle clocks before each transaction */
+} XTrafGen_ScnStream;
+
+/**
+ * Scenario, a list of streams loaded into one core.
+ */
+typedef struct XTrafGen_Scenario {
+	const XTrafGen_ScnStream *Streams;	/**< Streams */
+	u32 NumStreams;		/**< Number of streams */
+	u32 Seed;		/**< Random address seed, non zero */
+} XTrafGen_Scenario;
+
+/**
+ * Scenario statistics computed by XTrafGen_ScenarioLoad().
+ */
+typedef struct XTrafGen_ScnStats {
+	u64 WrBytes;		/**< Bytes written per pass */
+	u64 RdBytes;		/**< Bytes read per pass */
+	u32 WrTransactions;	/**< Write transactions per pass */
+	u32 RdTransactions;	/**< Read transactions per pass */
+	u32 WrEntries;		/**< Write command entries used */
+	u32 RdEntries;		/**< Read command entries used */
+} XTrafGen_ScnStats;
+
+/************************** Function Prototypes ******************************/
+
+int XTrafGen_ScenarioLoad(XTrafGen *InstancePtr,
+			const XTrafGen_Scenario *ScnPtr,
+			XTrafGen_ScnStats *StatsPtr);
+int XTrafGen_ScenarioStart(XTrafGen **Instances, u32 NumInstances, u8 Loop);
+void XTrafGen_ScenarioStop(XTrafGen **Instances, u32 NumInstances);
+int XTrafGen_ScenarioWait(XTrafGen **Instances, u32 NumInstances,
+			u32 *Errors);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/** @} */
@@ -68,6 +68,7 @@
 *		      CR#865787.
 * 3.2   sk   11/10/15 Used UINTPTR instead of u32 for Baseaddress CR# 867425.
 *                     Changed the prototype of XUartLite_CfgInitialize API.
+* 3.3   sne  10/15/19 Ring buffer mode is cleared at initialization.
 *
 * </pre>
 *
@@ -158,6 +159,8 @@ int XUartLite_CfgInitialize(XUartLite *InstancePtr, XUartLite_Config *Config,
 
 	InstancePtr->RecvHandler = StubHandler;
 	InstancePtr->SendHandler = StubHandler;
+	InstancePtr->RingMode = 0;
+	InstancePtr->RxRingDropped = 0;
 
 	/* Write to the control register to disable the interrupts, don't
 	 * reset the FIFOs are the user may want the data that's present
@@ -60,6 +60,14 @@
 * to allow data to be sent and received. They are designed to be used in
 * polled or interrupt modes.
 *
+* For sustained high baud rates the driver can instead move data between the
+* FIFOs and two application supplied ring buffers from its interrupt handler,
+* see XUartLite_RingInitialize(). A full RX FIFO is drained and an empty TX
+* FIFO is filled without polling the status register for every byte, and the
+* application only touches the rings, through XUartLite_RingRead() and
+* XUartLite_RingWrite(). The UART Lite has no DMA request interface, so the
+* transfers between FIFO and ring stay with the CPU.
+*
 * The driver provides a status for each received byte indicating any parity
 * frame or overrun error. The driver provides statistics which allow visibility
 * into these errors.
@@ -142,6 +150,8 @@
 * 3.3   sne 09/09/19  Updated driver tcl file for supporting pl and ps ip's.
 * 3.3	sne 09/13/19  Updated driver tcl file for mdm & tmr_sem ip's.
 *
+* 3.3   sne  10/15/19 Added the ring buffer mode.
+*
 * </pre>
 *
 *****************************************************************************/
@@ -196,6 +206,18 @@ typedef struct {
 	unsigned int RemainingBytes;
 } XUartLite_Buffer;
 
+/**
+ * Ring buffer of the ring buffer mode. Head and Tail are free running byte
+ * counts, the byte n is stored in Buf[n & Mask]. The interrupt handler and
+ * the application each advance only one of them.
+ */
+typedef struct {
+	u8 *Buf;		/**< Ring storage */
+	u32 Mask;		/**< Ring size - 1, the size is a power of two */
+	volatile u32 Head;	/**< Bytes written to the ring */
+	volatile u32 Tail;	/**< Bytes read from the ring */
+} XUartLite_Ring;
+
 /**
  * This typedef contains configuration information for the device.
  */
@@ -226,6 +248,11 @@ typedef struct {
 	void *RecvCallBackRef;		/* Callback ref for recv handler */
 	XUartLite_Handler SendHandler;
 	void *SendCallBackRef;		/* Callback ref for send handler */
+
+	u32 RingMode;			/* Ring buffer mode is enabled */
+	XUartLite_Ring RxRing;
+	XUartLite_Ring TxRing;
+	u32 RxRingDropped;		/* Bytes lost to a full RX ring */
 } XUartLite;
 
 
@@ -280,6 +307,19 @@ void XUartLite_SetSendHandler(XUartLite *InstancePtr, XUartLite_Handler FuncPtr,
 
 void XUartLite_InterruptHandler(XUartLite *InstancePtr);
 
+/*
+ * Ring buffer mode functions in xuartlite_ring.c
+ */
+int XUartLite_RingInitialize(XUartLite *InstancePtr, u8 *RxBufPtr,
+			     u32 RxSize, u8 *TxBufPtr, u32 TxSize);
+void XUartLite_RingStop(XUartLite *InstancePtr);
+u32 XUartLite_RingRead(XUartLite *InstancePtr, u8 *DataBufferPtr,
+		       u32 NumBytes);
+u32 XUartLite_RingWrite(XUartLite *InstancePtr, const u8 *DataBufferPtr,
+			u32 NumBytes);
+u32 XUartLite_RingRxCount(XUartLite *InstancePtr);
+u32 XUartLite_RingTxFree(XUartLite *InstancePtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,7 @@
 * 2.00a ktn  10/20/09 The macros have been renamed to remove _m from
 *		      the name. XUartLite_mClearStats macro is removed and
 *		      XUartLite_ClearStats function should be used in its place.
+* 3.3   sne  10/15/19 Added XUartLite_RingInterruptHandler().
 
 * </pre>
 *
@@ -109,6 +110,7 @@ extern XUartLite_Config XUartLite_ConfigTable[];
 
 unsigned int XUartLite_SendBuffer(XUartLite *InstancePtr);
 unsigned int XUartLite_ReceiveBuffer(XUartLite *InstancePtr);
+void XUartLite_RingInterruptHandler(XUartLite *InstancePtr);
 
 #ifdef __cplusplus
 }
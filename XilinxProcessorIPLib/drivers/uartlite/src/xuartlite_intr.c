@@ -45,6 +45,7 @@
 *			callback invocations)
 * 2.00a ktn  10/20/09 Updated to use HAL Processor APIs. The macros have been
 *		      renamed to remove _m from the name.
+* 3.3   sne  10/15/19 Interrupts go to the ring handler in ring buffer mode.
 * </pre>
 *
 *****************************************************************************/
@@ -159,6 +160,11 @@ void XUartLite_InterruptHandler(XUartLite *InstancePtr)
 
 	Xil_AssertVoid(InstancePtr != NULL);
 
+	if (InstancePtr->RingMode) {
+		XUartLite_RingInterruptHandler(InstancePtr);
+		return;
+	}
+
 	/*
 	 * Read the status register to determine which, coulb be both
 	 * interrupt is active
@@ -0,0 +1,436 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xuartlite_ring.c
+* @addtogroup uartlite_v3_3
+* @{
+*
+* This file contains the ring buffer mode of the UART Lite component
+* (XUartLite). The interrupt handler moves the data between the FIFOs and two
+* rings, so the application is decoupled from the FIFO timing. Each ring is
+* shared between the interrupt handler and a single task running on the same
+* processor.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 3.3   sne  10/15/19 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xuartlite.h"
+#include "xuartlite_i.h"
+#include "xil_io.h"
+
+/************************** Constant Definitions ****************************/
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+#define XUartLite_RingCount(RingPtr)	((RingPtr)->Head - (RingPtr)->Tail)
+#define XUartLite_RingSize(RingPtr)	((RingPtr)->Mask + 1)
+
+/************************** Function Prototypes *****************************/
+
+static u32 XUartLite_RingFillTx(XUartLite *InstancePtr);
+static void XUartLite_RingDrainRx(XUartLite *InstancePtr);
+
+/************************** Variable Definitions ****************************/
+
+
+/****************************************************************************/
+/**
+*
+* This function switches the driver to the ring buffer mode and enables the
+* UART interrupt. From then on the interrupt handler receives every byte into
+* the RX ring and sends the bytes queued in the TX ring, XUartLite_Send() and
+* XUartLite_Recv() must not be used. The receive handler is called with the
+* number of bytes in the RX ring when bytes were added to it, the send
+* handler with the number of bytes moved to the FIFO by the last refill when
+* the TX ring became empty.
+*
+* @param	InstancePtr is a pointer to the XUartLite instance.
+* @param	RxBufPtr is the storage of the RX ring.
+* @param	RxSize is the size of the RX ring, a power of two.
+* @param	TxBufPtr is the storage of the TX ring.
+* @param	TxSize is the size of the TX ring, a power of two.
+*
+* @return
+*		- XST_SUCCESS if the ring buffer mode is enabled.
+*		- XST_INVALID_PARAM if a size is not a power of two.
+*
+* @note		Bytes dropped because the RX ring was full are counted in
+*		RxRingDropped, FIFO errors in the driver statistics.
+*
+*****************************************************************************/
+int XUartLite_RingInitialize(XUartLite *InstancePtr, u8 *RxBufPtr,
+			     u32 RxSize, u8 *TxBufPtr, u32 TxSize)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(RxBufPtr != NULL);
+	Xil_AssertNonvoid(TxBufPtr != NULL);
+
+	if ((RxSize < 2) || ((RxSize & (RxSize - 1)) != 0) ||
+	    (TxSize < 2) || ((TxSize & (TxSize - 1)) != 0)) {
+		return XST_INVALID_PARAM;
+	}
+
+	XUartLite_RingStop(InstancePtr);
+
+	InstancePtr->RxRing.Buf = RxBufPtr;
+	InstancePtr->RxRing.Mask = RxSize - 1;
+	InstancePtr->RxRing.Head = 0;
+	InstancePtr->RxRing.Tail = 0;
+	InstancePtr->TxRing.Buf = TxBufPtr;
+	InstancePtr->TxRing.Mask = TxSize - 1;
+	InstancePtr->TxRing.Head = 0;
+	InstancePtr->TxRing.Tail = 0;
+	InstancePtr->RxRingDropped = 0;
+	InstancePtr->RingMode = 1;
+
+	/*
+	 * The receive interrupt is raised when the FIFO goes non empty, pick
+	 * up what arrived while it was disabled before enabling it
+	 */
+	XUartLite_RingDrainRx(InstancePtr);
+	XUartLite_WriteReg(InstancePtr->RegBaseAddress, XUL_CONTROL_REG_OFFSET,
+				XUL_CR_ENABLE_INTR);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function leaves the ring buffer mode and disables the UART interrupt.
+* The bytes left in the rings are discarded.
+*
+* @param	InstancePtr is a pointer to the XUartLite instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void XUartLite_RingStop(XUartLite *InstancePtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	XUartLite_WriteReg(InstancePtr->RegBaseAddress, XUL_CONTROL_REG_OFFSET,
+				0);
+	InstancePtr->RingMode = 0;
+}
+
+/****************************************************************************/
+/**
+*
+* This function copies received bytes out of the RX ring.
+*
+* @param	InstancePtr is a pointer to the XUartLite instance.
+* @param	DataBufferPtr is the destination buffer.
+* @param	NumBytes is the maximum number of bytes to copy.
+*
+* @return	The number of bytes copied, 0 if the ring is empty.
+*
+* @note		Non-blocking. Must not be called concurrently with itself.
+*
+*****************************************************************************/
+u32 XUartLite_RingRead(XUartLite *InstancePtr, u8 *DataBufferPtr,
+		       u32 NumBytes)
+{
+	XUartLite_Ring *Ring;
+	volatile u8 *Buf;
+	u32 Tail;
+	u32 Count;
+	u32 Index;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(DataBufferPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->RingMode != 0);
+
+	Ring = &InstancePtr->RxRing;
+	Buf = Ring->Buf;
+	Tail = Ring->Tail;
+	Count = Ring->Head - Tail;
+	if (Count > NumBytes) {
+		Count = NumBytes;
+	}
+
+	for (Index = 0; Index < Count; Index++) {
+		DataBufferPtr[Index] = Buf[(Tail + Index) & Ring->Mask];
+	}
+
+	/* Release the space only once the bytes are copied out */
+	Ring->Tail = Tail + Count;
+
+	return Count;
+}
+
+/****************************************************************************/
+/**
+*
+* This function queues bytes in the TX ring and starts the transmission if
+* the transmitter is idle.
+*
+* @param	InstancePtr is a pointer to the XUartLite instance.
+* @param	DataBufferPtr is the data to send.
+* @param	NumBytes is the number of bytes to send.
+*
+* @return	The number of bytes queued, less than NumBytes if the ring is
+*		full.
+*
+* @note		Non-blocking. Must not be called concurrently with itself.
+*
+*****************************************************************************/
+u32 XUartLite_RingWrite(XUartLite *InstancePtr, const u8 *DataBufferPtr,
+			u32 NumBytes)
+{
+	XUartLite_Ring *Ring;
+	volatile u8 *Buf;
+	u32 Head;
+	u32 Count;
+	u32 Index;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(DataBufferPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->RingMode != 0);
+
+	Ring = &InstancePtr->TxRing;
+	Buf = Ring->Buf;
+	Head = Ring->Head;
+	Count = XUartLite_RingSize(Ring) - (Head - Ring->Tail);
+	if (Count > NumBytes) {
+		Count = NumBytes;
+	}
+	if (Count == 0) {
+		return 0;
+	}
+
+	for (Index = 0; Index < Count; Index++) {
+		Buf[(Head + Index) & Ring->Mask] = DataBufferPtr[Index];
+	}
+
+	/* Publish the bytes only once they are in the ring */
+	Ring->Head = Head + Count;
+
+	/*
+	 * The transmit interrupt is raised only when the FIFO goes empty, an
+	 * idle transmitter is started from here. Enter a critical region by
+	 * disabling the UART interrupt, the receive side is serviced as well
+	 * since a byte arriving meanwhile raises no interrupt once re-enabled.
+	 */
+	XUartLite_WriteReg(InstancePtr->RegBaseAddress, XUL_CONTROL_REG_OFFSET,
+				0);
+	(void)XUartLite_RingFillTx(InstancePtr);
+	XUartLite_RingDrainRx(InstancePtr);
+	XUartLite_WriteReg(InstancePtr->RegBaseAddress, XUL_CONTROL_REG_OFFSET,
+				XUL_CR_ENABLE_INTR);
+
+	return Count;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the number of bytes waiting in the RX ring.
+*
+* @param	InstancePtr is a pointer to the XUartLite instance.
+*
+* @return	The number of bytes XUartLite_RingRead() can return.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XUartLite_RingRxCount(XUartLite *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return XUartLite_RingCount(&InstancePtr->RxRing);
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the free space of the TX ring.
+*
+* @param	InstancePtr is a pointer to the XUartLite instance.
+*
+* @return	The number of bytes XUartLite_RingWrite() can queue.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XUartLite_RingTxFree(XUartLite *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return XUartLite_RingSize(&InstancePtr->TxRing) -
+		XUartLite_RingCount(&InstancePtr->TxRing);
+}
+
+/****************************************************************************/
+/**
+*
+* This function is the interrupt handler of the ring buffer mode, called by
+* XUartLite_InterruptHandler().
+*
+* @param	InstancePtr is a pointer to the XUartLite instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void XUartLite_RingInterruptHandler(XUartLite *InstancePtr)
+{
+	u32 Sent;
+
+	XUartLite_RingDrainRx(InstancePtr);
+
+	Sent = XUartLite_RingFillTx(InstancePtr);
+	if (Sent != 0) {
+		InstancePtr->Stats.TransmitInterrupts++;
+		if (XUartLite_RingCount(&InstancePtr->TxRing) == 0) {
+			InstancePtr->SendHandler(InstancePtr->SendCallBackRef,
+						 Sent);
+		}
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function moves a burst of bytes from the TX ring to the TX FIFO. The
+* FIFO is filled only when it is empty, so up to XUL_FIFO_SIZE bytes are
+* written with a single status register read.
+*
+* @param	InstancePtr is a pointer to the XUartLite instance.
+*
+* @return	The number of bytes written to the FIFO.
+*
+* @note		None.
+*
+*****************************************************************************/
+static u32 XUartLite_RingFillTx(XUartLite *InstancePtr)
+{
+	XUartLite_Ring *Ring = &InstancePtr->TxRing;
+	volatile u8 *Buf = Ring->Buf;
+	u32 Tail = Ring->Tail;
+	u32 Count;
+	u32 Index;
+
+	Count = Ring->Head - Tail;
+	if ((Count == 0) ||
+	    ((XUartLite_GetStatusReg(InstancePtr->RegBaseAddress) &
+	      XUL_SR_TX_FIFO_EMPTY) == 0)) {
+		return 0;
+	}
+
+	if (Count > XUL_FIFO_SIZE) {
+		Count = XUL_FIFO_SIZE;
+	}
+	for (Index = 0; Index < Count; Index++) {
+		XUartLite_WriteReg(InstancePtr->RegBaseAddress,
+					XUL_TX_FIFO_OFFSET,
+					Buf[(Tail + Index) & Ring->Mask]);
+	}
+	Ring->Tail = Tail + Count;
+	InstancePtr->Stats.CharactersTransmitted += Count;
+
+	return Count;
+}
+
+/****************************************************************************/
+/**
+*
+* This function moves the content of the RX FIFO to the RX ring. A full FIFO
+* is read without polling the status register, the rest byte by byte.
+*
+* @param	InstancePtr is a pointer to the XUartLite instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XUartLite_RingDrainRx(XUartLite *InstancePtr)
+{
+	XUartLite_Ring *Ring = &InstancePtr->RxRing;
+	volatile u8 *Buf = Ring->Buf;
+	u32 Head = Ring->Head;
+	u32 Space = XUartLite_RingSize(Ring) - (Head - Ring->Tail);
+	u32 Received = 0;
+	u32 Dropped = 0;
+	u32 Burst;
+	u32 Data;
+	u32 StatusRegister;
+
+	StatusRegister = XUartLite_GetStatusReg(InstancePtr->RegBaseAddress);
+	while ((StatusRegister & XUL_SR_RX_FIFO_VALID_DATA) != 0) {
+		XUartLite_UpdateStats(InstancePtr, StatusRegister);
+		Burst = ((StatusRegister & XUL_SR_RX_FIFO_FULL) != 0) ?
+			XUL_FIFO_SIZE : 1;
+
+		while (Burst > 0) {
+			Data = XUartLite_ReadReg(InstancePtr->RegBaseAddress,
+						XUL_RX_FIFO_OFFSET);
+			if (Received < Space) {
+				Buf[(Head + Received) & Ring->Mask] = (u8)Data;
+				Received++;
+			} else {
+				Dropped++;
+			}
+			Burst--;
+		}
+		StatusRegister =
+			XUartLite_GetStatusReg(InstancePtr->RegBaseAddress);
+	}
+	XUartLite_UpdateStats(InstancePtr, StatusRegister);
+
+	/* Publish the bytes only once they are in the ring */
+	Ring->Head = Head + Received;
+
+	InstancePtr->RxRingDropped += Dropped;
+	if ((Received + Dropped) != 0) {
+		InstancePtr->Stats.ReceiveInterrupts++;
+		InstancePtr->Stats.CharactersReceived += Received + Dropped;
+	}
+	if (Received != 0) {
+		InstancePtr->RecvHandler(InstancePtr->RecvCallBackRef,
+					 XUartLite_RingCount(Ring));
+	}
+}
+/** @} */
@@ -45,6 +45,7 @@
 * 3.1	kvn    04/10/15 Modified code for latest RTL changes.
 * 3.5	NK     09/26/17 Fix the RX Buffer Overflow issue.
 * 3.7   aru    08/17/18 Resolved MISRA-C mandatory violations.(CR#1007755)
+* 3.8   aru    10/15/19 Ring buffer mode is cleared at initialization.
 * </pre>
 *
 *****************************************************************************/
@@ -155,6 +156,11 @@ s32 XUartPs_CfgInitialize(XUartPs *InstancePtr,
 
 	InstancePtr->is_rxbs_error = 0U;
 
+	/* Ring buffer mode is off until XUartPs_RingInitialize() */
+	InstancePtr->RingMode = 0U;
+	InstancePtr->RxRingDropped = 0U;
+	InstancePtr->RxFifoOverruns = 0U;
+
 	/* Flag that the driver instance is ready to use */
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
 
@@ -105,6 +105,19 @@
 * driver to allow data to be sent and received. They can be used in either
 * polled or interrupt mode.
 *
+* <b>Ring Buffer Mode</b>
+*
+* For sustained high baud rates the driver can instead move data between the
+* FIFOs and two application supplied ring buffers from its interrupt handler,
+* see XUartPs_RingInitialize(). The handler drains the RX FIFO in bursts on
+* the trigger level and receive timeout interrupts, reading a trigger level
+* worth of bytes without polling the status register, and refills the TX
+* FIFO a full FIFO at a time when it empties. The application only touches
+* the rings, through XUartPs_RingRead() and XUartPs_RingWrite(), and is
+* never required to keep a receive request posted. The PS UART has no DMA
+* request interface, so the transfers between FIFO and ring stay with the
+* CPU.
+*
 * @note
 *
 * The default configuration for the UART after initialization is:
@@ -166,6 +179,8 @@
 *                       control register.
 * 3.7   aru    08/17/18 Resolved MISRA-C:2012 compliance mandatory violations.
 *
+* 3.8   aru    10/15/19 Added the ring buffer mode.
+*
 * </pre>
 *
 *****************************************************************************/
@@ -273,6 +288,7 @@ extern "C" {
 #define XUARTPS_EVENT_PARE_FRAME_BRKE	6U /**< A receive parity, frame, break
 											 *	error detected */
 #define XUARTPS_EVENT_RECV_ORERR		7U /**< A receive overrun error detected */
+#define XUARTPS_EVENT_RING_FULL			8U /**< RX ring full, bytes dropped */
 /*@}*/
 
 
@@ -296,6 +312,18 @@ typedef struct {
 	u32 RemainingBytes;
 } XUartPsBuffer;
 
+/**
+ * Ring buffer of the ring buffer mode. Head and Tail are free running byte
+ * counts, the byte n is stored in Buf[n & Mask]. The interrupt handler and
+ * the application each advance only one of them.
+ */
+typedef struct {
+	u8 *Buf;		/**< Ring storage */
+	u32 Mask;		/**< Ring size - 1, the size is a power of two */
+	volatile u32 Head;	/**< Bytes written to the ring */
+	volatile u32 Tail;	/**< Bytes read from the ring */
+} XUartPsRing;
+
 /**
  * Keep track of data format setting of a device.
  */
@@ -343,6 +371,13 @@ typedef struct {
 	void *CallBackRef;	/* Callback reference for event handler */
 	u32 Platform;
 	u8 is_rxbs_error;
+
+	u32 RingMode;		/* Ring buffer mode is enabled */
+	u32 RxTrigger;		/* RX FIFO trigger level in ring mode */
+	XUartPsRing RxRing;
+	XUartPsRing TxRing;
+	u32 RxRingDropped;	/* Bytes lost to a full RX ring */
+	u32 RxFifoOverruns;	/* RX FIFO overrun interrupts */
 } XUartPs;
 
 
@@ -504,6 +539,21 @@ void XUartPs_InterruptHandler(XUartPs *InstancePtr);
 void XUartPs_SetHandler(XUartPs *InstancePtr, XUartPs_Handler FuncPtr,
 			 void *CallBackRef);
 
+/* ring buffer mode functions in xuartps_ring.c */
+s32 XUartPs_RingInitialize(XUartPs *InstancePtr, u8 *RxBufPtr, u32 RxSize,
+			   u8 *TxBufPtr, u32 TxSize, u8 RxTrigger);
+
+void XUartPs_RingStop(XUartPs *InstancePtr);
+
+u32 XUartPs_RingRead(XUartPs *InstancePtr, u8 *BufferPtr, u32 NumBytes);
+
+u32 XUartPs_RingWrite(XUartPs *InstancePtr, const u8 *BufferPtr,
+		      u32 NumBytes);
+
+u32 XUartPs_RingRxCount(XUartPs *InstancePtr);
+
+u32 XUartPs_RingTxFree(XUartPs *InstancePtr);
+
 /* self-test functions in xuartps_selftest.c */
 s32 XUartPs_SelfTest(XUartPs *InstancePtr);
 
@@ -51,6 +51,7 @@
 * 3.1	kvn    04/10/15 Modified code for latest RTL changes.
 * 3.6   ms     02/16/18 Updates flow control mode offset value in
 *			modem control register.
+* 3.8   aru    10/15/19 Added XUARTPS_FIFO_SIZE.
 *
 * </pre>
 *
@@ -222,6 +223,8 @@ extern "C" {
 #define XUARTPS_RXTOUT_DISABLE		0x00000000U  /**< Disable time out */
 #define XUARTPS_RXTOUT_MASK			0x000000FFU  /**< Valid bits mask */
 
+#define XUARTPS_FIFO_SIZE		64U	/**< Depth of the RX and TX FIFOs */
+
 /** @name Receiver FIFO Trigger Level Register
  *
  * Use the Receiver FIFO Trigger Level Register (RTRIG) to set the value at
@@ -41,6 +41,7 @@
 * 3.00  kvn    02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.1	kvn    04/10/15 Modified code for latest RTL changes.
 * 3.7   aru    08/17/18 Resolved MISRA-C mandatory violations.(CR#1007755)
+* 3.8   aru    10/15/19 Interrupts go to the ring handler in ring buffer mode.
 * </pre>
 *
 *****************************************************************************/
@@ -68,6 +69,9 @@ static void ModemHandler(XUartPs *InstancePtr);
 extern u32 XUartPs_ReceiveBuffer(XUartPs *InstancePtr);
 extern u32 XUartPs_SendBuffer(XUartPs *InstancePtr);
 
+/* Internal function prototype implemented in xuartps_ring.c */
+extern void XUartPs_RingInterruptHandler(XUartPs *InstancePtr, u32 IsrStatus);
+
 /************************** Variable Definitions ****************************/
 
 typedef void (*Handler)(XUartPs *InstancePtr);
@@ -193,6 +197,11 @@ void XUartPs_InterruptHandler(XUartPs *InstancePtr)
 	IsrStatus &= XUartPs_ReadReg(InstancePtr->Config.BaseAddress,
 				   XUARTPS_ISR_OFFSET);
 
+	if (InstancePtr->RingMode != (u32)0) {
+		XUartPs_RingInterruptHandler(InstancePtr, IsrStatus);
+		return;
+	}
+
 	/* Dispatch an appropriate handler. */
 	if((IsrStatus & ((u32)XUARTPS_IXR_RXOVR | (u32)XUARTPS_IXR_RXEMPTY |
 			(u32)XUARTPS_IXR_RXFULL)) != (u32)0) {
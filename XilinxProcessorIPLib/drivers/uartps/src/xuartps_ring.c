@@ -0,0 +1,484 @@
+/******************************************************************************
+*
+* Copyright (C) 2010 - 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xuartps_ring.c
+* @addtogroup uartps_v3_8
+* @{
+*
+* This file contains the ring buffer mode of the XUartPs driver. The
+* interrupt handler moves the data between the FIFOs and two rings, so the
+* application is decoupled from the FIFO timing. Each ring is shared between
+* the interrupt handler and a single task running on the same core.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date	Changes
+* ----- ------ -------- -----------------------------------------------
+* 3.8   aru    10/15/19 First Release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xstatus.h"
+#include "xuartps.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Interrupts of the receive side, always enabled in ring mode */
+#define XUARTPS_RING_RX_IXR	((u32)XUARTPS_IXR_RXOVR | (u32)XUARTPS_IXR_RXFULL | \
+				 (u32)XUARTPS_IXR_TOUT | (u32)XUARTPS_IXR_OVER | \
+				 (u32)XUARTPS_IXR_FRAMING | (u32)XUARTPS_IXR_PARITY)
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define XUartPs_RingCount(RingPtr)	((RingPtr)->Head - (RingPtr)->Tail)
+#define XUartPs_RingSize(RingPtr)	((RingPtr)->Mask + (u32)1)
+
+/************************** Function Prototypes ******************************/
+
+void XUartPs_RingInterruptHandler(XUartPs *InstancePtr, u32 IsrStatus);
+static u32 XUartPs_RingFillTx(XUartPs *InstancePtr);
+
+/************************** Variable Definitions *****************************/
+
+
+/****************************************************************************/
+/**
+*
+* This function switches the driver to the ring buffer mode. From then on
+* the interrupt handler receives every byte into the RX ring and sends the
+* bytes queued in the TX ring, XUartPs_Send() and XUartPs_Recv() must not be
+* used. The handler set with XUartPs_SetHandler() is called with
+*
+* - XUARTPS_EVENT_RECV_DATA when bytes were added to the RX ring, with the
+*   number of bytes in the ring
+* - XUARTPS_EVENT_SENT_DATA when the TX ring became empty, with the number of
+*   bytes moved to the FIFO by the last refill
+* - XUARTPS_EVENT_RING_FULL when the RX ring was full, with the number of
+*   bytes dropped
+* - XUARTPS_EVENT_RECV_ORERR when the RX FIFO overran
+* - XUARTPS_EVENT_RECV_ERROR on parity and framing errors, with the
+*   interrupt status
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+* @param	RxBufPtr is the storage of the RX ring.
+* @param	RxSize is the size of the RX ring, a power of two.
+* @param	TxBufPtr is the storage of the TX ring.
+* @param	TxSize is the size of the TX ring, a power of two.
+* @param	RxTrigger is the RX FIFO trigger level, 1 to 63. The handler
+*		reads that many bytes without polling the status register, a
+*		high level cuts the interrupt rate, a low level leaves more of
+*		the FIFO to absorb the interrupt latency.
+*
+* @return
+*		- XST_SUCCESS if the ring buffer mode is enabled.
+*		- XST_INVALID_PARAM if a size is not a power of two.
+*
+* @note		The receive timeout is enabled if it was disabled, so that
+*		the bytes below the trigger level are delivered.
+*
+*****************************************************************************/
+s32 XUartPs_RingInitialize(XUartPs *InstancePtr, u8 *RxBufPtr, u32 RxSize,
+			   u8 *TxBufPtr, u32 TxSize, u8 RxTrigger)
+{
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(RxBufPtr != NULL);
+	Xil_AssertNonvoid(TxBufPtr != NULL);
+	Xil_AssertNonvoid((RxTrigger > (u8)0) &&
+			  (RxTrigger < (u8)XUARTPS_FIFO_SIZE));
+
+	if ((RxSize < (u32)2) || ((RxSize & (RxSize - (u32)1)) != (u32)0) ||
+	    (TxSize < (u32)2) || ((TxSize & (TxSize - (u32)1)) != (u32)0)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	XUartPs_RingStop(InstancePtr);
+
+	InstancePtr->RxRing.Buf = RxBufPtr;
+	InstancePtr->RxRing.Mask = RxSize - (u32)1;
+	InstancePtr->RxRing.Head = 0U;
+	InstancePtr->RxRing.Tail = 0U;
+	InstancePtr->TxRing.Buf = TxBufPtr;
+	InstancePtr->TxRing.Mask = TxSize - (u32)1;
+	InstancePtr->TxRing.Head = 0U;
+	InstancePtr->TxRing.Tail = 0U;
+	InstancePtr->RxRingDropped = 0U;
+	InstancePtr->RxFifoOverruns = 0U;
+	InstancePtr->RxTrigger = RxTrigger;
+
+	XUartPs_SetFifoThreshold(InstancePtr, RxTrigger);
+	if (XUartPs_GetRecvTimeout(InstancePtr) == (u8)0) {
+		XUartPs_SetRecvTimeout(InstancePtr, (u8)1);
+	}
+
+	/* Drop the events of the previous mode */
+	XUartPs_WriteReg(InstancePtr->Config.BaseAddress, XUARTPS_ISR_OFFSET,
+			 XUARTPS_IXR_MASK);
+
+	InstancePtr->RingMode = 1U;
+	XUartPs_WriteReg(InstancePtr->Config.BaseAddress, XUARTPS_IER_OFFSET,
+			 XUARTPS_RING_RX_IXR);
+
+	return (s32)XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function leaves the ring buffer mode. All the interrupts are disabled
+* and the bytes left in the rings are discarded.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void XUartPs_RingStop(XUartPs *InstancePtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	XUartPs_WriteReg(InstancePtr->Config.BaseAddress, XUARTPS_IDR_OFFSET,
+			 XUARTPS_IXR_MASK);
+	InstancePtr->RingMode = 0U;
+}
+
+/****************************************************************************/
+/**
+*
+* This function copies received bytes out of the RX ring.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+* @param	BufferPtr is the destination buffer.
+* @param	NumBytes is the maximum number of bytes to copy.
+*
+* @return	The number of bytes copied, 0 if the ring is empty.
+*
+* @note		Non-blocking. Must not be called concurrently with itself.
+*
+*****************************************************************************/
+u32 XUartPs_RingRead(XUartPs *InstancePtr, u8 *BufferPtr, u32 NumBytes)
+{
+	XUartPsRing *Ring;
+	volatile u8 *Buf;
+	u32 Tail;
+	u32 Count;
+	u32 Index;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(BufferPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->RingMode != (u32)0);
+
+	Ring = &InstancePtr->RxRing;
+	Buf = Ring->Buf;
+	Tail = Ring->Tail;
+	Count = Ring->Head - Tail;
+	if (Count > NumBytes) {
+		Count = NumBytes;
+	}
+
+	for (Index = 0U; Index < Count; Index++) {
+		BufferPtr[Index] = Buf[(Tail + Index) & Ring->Mask];
+	}
+
+	/* Release the space only once the bytes are copied out */
+	Ring->Tail = Tail + Count;
+
+	return Count;
+}
+
+/****************************************************************************/
+/**
+*
+* This function queues bytes in the TX ring and starts the transmission if
+* the transmitter is idle.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+* @param	BufferPtr is the data to send.
+* @param	NumBytes is the number of bytes to send.
+*
+* @return	The number of bytes queued, less than NumBytes if the ring is
+*		full.
+*
+* @note		Non-blocking. Must not be called concurrently with itself.
+*
+*****************************************************************************/
+u32 XUartPs_RingWrite(XUartPs *InstancePtr, const u8 *BufferPtr,
+		      u32 NumBytes)
+{
+	XUartPsRing *Ring;
+	volatile u8 *Buf;
+	u32 Head;
+	u32 Count;
+	u32 Index;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(BufferPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->RingMode != (u32)0);
+
+	Ring = &InstancePtr->TxRing;
+	Buf = Ring->Buf;
+	Head = Ring->Head;
+	Count = XUartPs_RingSize(Ring) - (Head - Ring->Tail);
+	if (Count > NumBytes) {
+		Count = NumBytes;
+	}
+	if (Count == (u32)0) {
+		return 0U;
+	}
+
+	for (Index = 0U; Index < Count; Index++) {
+		Buf[(Head + Index) & Ring->Mask] = BufferPtr[Index];
+	}
+
+	/* Publish the bytes only once they are in the ring */
+	Ring->Head = Head + Count;
+
+	/*
+	 * With the TX interrupt masked the handler does not touch the TX ring,
+	 * refill an idle transmitter from here, the FIFO empty interrupt
+	 * takes over for the rest.
+	 */
+	XUartPs_WriteReg(InstancePtr->Config.BaseAddress, XUARTPS_IDR_OFFSET,
+			 XUARTPS_IXR_TXEMPTY);
+	(void)XUartPs_RingFillTx(InstancePtr);
+	if (XUartPs_RingCount(Ring) != (u32)0) {
+		XUartPs_WriteReg(InstancePtr->Config.BaseAddress,
+				 XUARTPS_IER_OFFSET, XUARTPS_IXR_TXEMPTY);
+	}
+
+	return Count;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the number of bytes waiting in the RX ring.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+*
+* @return	The number of bytes XUartPs_RingRead() can return.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XUartPs_RingRxCount(XUartPs *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return XUartPs_RingCount(&InstancePtr->RxRing);
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the free space of the TX ring.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+*
+* @return	The number of bytes XUartPs_RingWrite() can queue.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XUartPs_RingTxFree(XUartPs *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return XUartPs_RingSize(&InstancePtr->TxRing) -
+		XUartPs_RingCount(&InstancePtr->TxRing);
+}
+
+/****************************************************************************/
+/*
+*
+* This function moves a burst of bytes from the TX ring to the TX FIFO. The
+* FIFO is filled only when it is empty, so up to XUARTPS_FIFO_SIZE bytes are
+* written with a single status register read.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+*
+* @return	The number of bytes written to the FIFO.
+*
+* @note		None.
+*
+*****************************************************************************/
+static u32 XUartPs_RingFillTx(XUartPs *InstancePtr)
+{
+	XUartPsRing *Ring = &InstancePtr->TxRing;
+	volatile u8 *Buf = Ring->Buf;
+	u32 Tail = Ring->Tail;
+	u32 Count;
+	u32 Index;
+
+	if ((XUartPs_ReadReg(InstancePtr->Config.BaseAddress,
+			     XUARTPS_SR_OFFSET) & XUARTPS_SR_TXEMPTY) == (u32)0) {
+		return 0U;
+	}
+
+	Count = Ring->Head - Tail;
+	if (Count > (u32)XUARTPS_FIFO_SIZE) {
+		Count = XUARTPS_FIFO_SIZE;
+	}
+	for (Index = 0U; Index < Count; Index++) {
+		XUartPs_WriteReg(InstancePtr->Config.BaseAddress,
+				 XUARTPS_FIFO_OFFSET,
+				 (u32)Buf[(Tail + Index) & Ring->Mask]);
+	}
+	Ring->Tail = Tail + Count;
+
+	return Count;
+}
+
+/****************************************************************************/
+/*
+*
+* This function moves the content of the RX FIFO to the RX ring. When the
+* FIFO is full or above the trigger level the known number of bytes is read
+* without polling the status register, the rest byte by byte.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XUartPs_RingDrainRx(XUartPs *InstancePtr)
+{
+	XUartPsRing *Ring = &InstancePtr->RxRing;
+	volatile u8 *Buf = Ring->Buf;
+	u32 BaseAddress = InstancePtr->Config.BaseAddress;
+	u32 Head = Ring->Head;
+	u32 Space = XUartPs_RingSize(Ring) - (Head - Ring->Tail);
+	u32 Received = 0U;
+	u32 Dropped = 0U;
+	u32 Burst;
+	u32 Data;
+	u32 Sr;
+
+	Sr = XUartPs_ReadReg(BaseAddress, XUARTPS_SR_OFFSET);
+	while ((Sr & XUARTPS_SR_RXEMPTY) == (u32)0) {
+		if ((Sr & XUARTPS_SR_RXFULL) != (u32)0) {
+			Burst = XUARTPS_FIFO_SIZE;
+		} else if ((Sr & XUARTPS_SR_RXOVR) != (u32)0) {
+			Burst = InstancePtr->RxTrigger;
+		} else {
+			Burst = 1U;
+		}
+
+		while (Burst > (u32)0) {
+			Data = XUartPs_ReadReg(BaseAddress, XUARTPS_FIFO_OFFSET);
+			if (Received < Space) {
+				Buf[(Head + Received) & Ring->Mask] = (u8)Data;
+				Received++;
+			} else {
+				Dropped++;
+			}
+			Burst--;
+		}
+		Sr = XUartPs_ReadReg(BaseAddress, XUARTPS_SR_OFFSET);
+	}
+
+	/* Publish the bytes only once they are in the ring */
+	Ring->Head = Head + Received;
+
+	if (Dropped != (u32)0) {
+		InstancePtr->RxRingDropped += Dropped;
+		InstancePtr->Handler(InstancePtr->CallBackRef,
+				     XUARTPS_EVENT_RING_FULL, Dropped);
+	}
+	if (Received != (u32)0) {
+		InstancePtr->Handler(InstancePtr->CallBackRef,
+				     XUARTPS_EVENT_RECV_DATA,
+				     XUartPs_RingCount(Ring));
+	}
+}
+
+/****************************************************************************/
+/*
+*
+* This function is the interrupt handler of the ring buffer mode, called
+* by XUartPs_InterruptHandler() with the pending enabled interrupts.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+* @param	IsrStatus is the pending enabled interrupts.
+*
+* @return	None.
+*
+* @note		The status is cleared before the FIFOs are serviced so that a
+*		level crossed while servicing them raises a new interrupt.
+*
+*****************************************************************************/
+void XUartPs_RingInterruptHandler(XUartPs *InstancePtr, u32 IsrStatus)
+{
+	u32 Sent;
+
+	XUartPs_WriteReg(InstancePtr->Config.BaseAddress, XUARTPS_ISR_OFFSET,
+			 IsrStatus);
+
+	if ((IsrStatus & XUARTPS_RING_RX_IXR) != (u32)0) {
+		XUartPs_RingDrainRx(InstancePtr);
+	}
+
+	if ((IsrStatus & (u32)XUARTPS_IXR_OVER) != (u32)0) {
+		InstancePtr->RxFifoOverruns++;
+		InstancePtr->Handler(InstancePtr->CallBackRef,
+				     XUARTPS_EVENT_RECV_ORERR, 0U);
+	}
+
+	if ((IsrStatus & ((u32)XUARTPS_IXR_FRAMING |
+			  (u32)XUARTPS_IXR_PARITY)) != (u32)0) {
+		InstancePtr->Handler(InstancePtr->CallBackRef,
+				     XUARTPS_EVENT_RECV_ERROR,
+				     IsrStatus & ((u32)XUARTPS_IXR_FRAMING |
+						  (u32)XUARTPS_IXR_PARITY));
+	}
+
+	if ((IsrStatus & (u32)XUARTPS_IXR_TXEMPTY) != (u32)0) {
+		Sent = XUartPs_RingFillTx(InstancePtr);
+		if (XUartPs_RingCount(&InstancePtr->TxRing) == (u32)0) {
+			XUartPs_WriteReg(InstancePtr->Config.BaseAddress,
+					 XUARTPS_IDR_OFFSET,
+					 XUARTPS_IXR_TXEMPTY);
+			InstancePtr->Handler(InstancePtr->CallBackRef,
+					     XUARTPS_EVENT_SENT_DATA, Sent);
+		}
+	}
+}
+/** @} */
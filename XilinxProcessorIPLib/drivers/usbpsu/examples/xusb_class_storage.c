@@ -43,6 +43,9 @@
  *		       example for all USB IPs.
  * 1.5	  vak 13/02/19  Added support for versal
  * 1.5    vak 03/25/19 Fixed incorrect data_alignment pragma directive for IAR
+ * 1.6    vak 15/10/19 Added the SD card backed disk. READ(10) and WRITE(10)
+ *		       stream chunks between SD and USB without a copy, the SD
+ *		       transfer of a chunk overlapping the USB one of another.
  *
  * </pre>
  *
@@ -55,15 +58,54 @@
 
 /************************** Constant Definitions *****************************/
 
+/* States of an SD chunk buffer */
+#define SD_CHUNK_FREE		0U	/* no data */
+#define SD_CHUNK_SD		1U	/* on the SD bus */
+#define SD_CHUNK_USB		2U	/* on the USB bus */
+#define SD_CHUNK_READY		3U	/* filled, waiting for the other bus */
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /**************************** Type Definitions *******************************/
+#ifdef XUSB_STORAGE_SD
+/*
+ * Pipeline of a READ(10) or WRITE(10) command on the SD card. Chunks are
+ * filled and drained in order: Fill is the next chunk to be filled from the
+ * source (SD for reads, USB for writes) and Drain the next to be written to
+ * the sink.
+ */
+typedef struct {
+	XSdPs_Request Req[SD_NUM_CHUNKS];	/* one SD request per chunk */
+	u32 BlkCnt[SD_NUM_CHUNKS];	/* blocks in each chunk */
+	u8 State[SD_NUM_CHUNKS];	/* SD_CHUNK_* */
+	u32 NextBlock;		/* next card block to be filled */
+	u32 SourceBlocks;	/* blocks not yet taken from the source */
+	u32 SinkBlocks;		/* blocks not yet given to the sink */
+	u8 Fill;
+	u8 Drain;
+	u8 IsWrite;
+	u8 Status;		/* CSW status, 1 on an SD error */
+} SD_PIPE;
+#endif
 
 /************************** Function Prototypes ******************************/
+#ifdef XUSB_STORAGE_SD
+static void StorageSdStart(struct Usb_DevData *InstancePtr, u32 Block,
+				u32 BlkCnt, u8 IsWrite);
+static void StorageSdFill(struct Usb_DevData *InstancePtr);
+static void StorageSdDrain(struct Usb_DevData *InstancePtr);
+static void StorageSdDone(void *CallBackRef, XSdPs_Request *RequestPtr);
+#endif
+static void SendCSWStatus(struct Usb_DevData *InstancePtr, u32 Length,
+				u8 Status);
 
 /************************** Variable Definitions *****************************/
 extern u8 Phase;
+#ifdef XUSB_STORAGE_SD
+extern XSdPs SdInstance;
+#else
 extern u8 VirtFlash[];
+#endif
 
 /*
  * Pre-manufactured response to the SCSI Inquiry command.
@@ -115,8 +157,10 @@ static u8 MaxLUN ALIGNMENT_CACHELINE = 0;
 extern USB_CBW CBW;
 extern USB_CSW CSW;
 
+#ifndef XUSB_STORAGE_SD
 extern u32	rxBytesLeft;
 extern u8	*VirtFlashWritePointer;
+#endif
 
 /* Local transmit buffer for simple replies. */
 #ifdef __ICCARM__
@@ -125,6 +169,24 @@ static u8 txBuffer[128];
 static u8 txBuffer[128] ALIGNMENT_CACHELINE;
 #endif
 
+#ifdef XUSB_STORAGE_SD
+/* Chunk buffers, the target of both the SD and the USB DMA */
+#ifdef __ICCARM__
+#if defined (PLATFORM_ZYNQMP) || defined (versal)
+#pragma data_alignment = 64
+#else
+#pragma data_alignment = 32
+#endif
+static u8 SdChunk[SD_NUM_CHUNKS][SD_CHUNK_BLOCKS * VFLASH_BLOCK_SIZE];
+#else
+static u8 SdChunk[SD_NUM_CHUNKS][SD_CHUNK_BLOCKS * VFLASH_BLOCK_SIZE]
+							ALIGNMENT_CACHELINE;
+#endif
+
+static SD_PIPE SdPipe;
+static u32 SdNumBlocks;
+#endif
+
 /*****************************************************************************/
 /**
 * This function is class handler for Mass storage and is called when
@@ -177,7 +239,9 @@ void ClassReq(struct Usb_DevData *InstancePtr, SetupPacket *SetupData)
 ******************************************************************************/
 void ParseCBW(struct Usb_DevData *InstancePtr)
 {
+#ifndef XUSB_STORAGE_SD
 	u32	Offset;
+#endif
 	u8 Array[50];
 	u8 Index;
 	s32 Status;
@@ -212,7 +276,11 @@ void ParseCBW(struct Usb_DevData *InstancePtr)
 #endif
 		CapList->listLength	= 8;
 		CapList->descCode	= 3;
+#ifdef XUSB_STORAGE_SD
+		CapList->numBlocks	= htonl(SdNumBlocks);
+#else
 		CapList->numBlocks	= htonl(VFLASH_NUM_BLOCKS);
+#endif
 		CapList->blockLength = htons(VFLASH_BLOCK_SIZE);
 
 		Phase = USB_EP_STATE_DATA_IN;
@@ -228,7 +296,11 @@ void ParseCBW(struct Usb_DevData *InstancePtr)
 #ifdef CLASS_STORAGE_DEBUG
 		printf("SCSI: READCAP\r\n");
 #endif
+#ifdef XUSB_STORAGE_SD
+		Cap->numBlocks = htonl(SdNumBlocks - 1);
+#else
 		Cap->numBlocks = htonl(VFLASH_NUM_BLOCKS - 1);
+#endif
 		Cap->blockSize = htonl(VFLASH_BLOCK_SIZE);
 		Phase = USB_EP_STATE_DATA_IN;
 		EpBufferSend(InstancePtr->PrivateData, 1, txBuffer,
@@ -237,6 +309,12 @@ void ParseCBW(struct Usb_DevData *InstancePtr)
 		break;
 
 	case USB_RBC_READ:
+#ifdef XUSB_STORAGE_SD
+		Phase = USB_EP_STATE_DATA_IN;
+		StorageSdStart(InstancePtr,
+			htonl(((SCSI_READ_WRITE *) &CBW.CBWCB)->block),
+			htons(((SCSI_READ_WRITE *) &CBW.CBWCB)->length), 0U);
+#else
 		Offset = htonl(((SCSI_READ_WRITE *) &CBW.CBWCB)-> block) *
 					VFLASH_BLOCK_SIZE;
 #ifdef CLASS_STORAGE_DEBUG
@@ -252,6 +330,7 @@ void ParseCBW(struct Usb_DevData *InstancePtr)
 			xil_printf("Failed: READ Offset 0x%08x\n", Offset);
 			return;
 		}
+#endif
 		break;
 
 	case USB_RBC_MODE_SENSE:
@@ -294,6 +373,12 @@ void ParseCBW(struct Usb_DevData *InstancePtr)
 		break;
 
 	case USB_RBC_WRITE:
+#ifdef XUSB_STORAGE_SD
+		Phase = USB_EP_STATE_DATA_OUT;
+		StorageSdStart(InstancePtr,
+			htonl(((SCSI_READ_WRITE *) &CBW.CBWCB)->block),
+			htons(((SCSI_READ_WRITE *) &CBW.CBWCB)->length), 1U);
+#else
 		Offset = htonl(((SCSI_READ_WRITE *) &CBW.CBWCB)->
 				       block) * VFLASH_BLOCK_SIZE;
 #ifdef CLASS_STORAGE_DEBUG
@@ -307,6 +392,7 @@ void ParseCBW(struct Usb_DevData *InstancePtr)
 		Phase = USB_EP_STATE_DATA_OUT;
 		EpBufferRecv(InstancePtr->PrivateData, 1, &VirtFlash[Offset],
 							rxBytesLeft);
+#endif
 		break;
 
 	case USB_RBC_STARTSTOP_UNIT:
@@ -354,11 +440,323 @@ void ParseCBW(struct Usb_DevData *InstancePtr)
 *
 *****************************************************************************/
 void SendCSW(struct Usb_DevData *InstancePtr, u32 Length)
+{
+	SendCSWStatus(InstancePtr, Length, 0);
+}
+
+/****************************************************************************/
+/**
+* This function is used to send SCSI Command Status Wrapper with a status to
+* Host.
+*
+* @param	InstancePtr is pointer to Usb_DevData instance.
+* @param	Length is the data residue.
+* @param	Status is the command status, 0 for success and 1 for failure.
+*
+* @return	None
+*
+* @note
+*
+*****************************************************************************/
+static void SendCSWStatus(struct Usb_DevData *InstancePtr, u32 Length,
+				u8 Status)
 {
 	CSW.dCSWSignature = 0x53425355;
 	CSW.dCSWTag = CBW.dCBWTag;
 	CSW.dCSWDataResidue = Length;
-	CSW.bCSWStatus = 0;
+	CSW.bCSWStatus = Status;
 	Phase = USB_EP_STATE_STATUS;
 	EpBufferSend(InstancePtr->PrivateData, 1, (void *) &CSW, 13);
 }
+
+#ifdef XUSB_STORAGE_SD
+/****************************************************************************/
+/**
+* This function initializes the SD card and its request queue. The SD
+* interrupt must be connected to XSdPs_IntrHandler().
+*
+* @param	DeviceId is the SD controller ID.
+*
+* @return	XST_SUCCESS else XST_FAILURE.
+*
+* @note		None.
+*
+*****************************************************************************/
+s32 StorageSdInit(u16 DeviceId)
+{
+	XSdPs_Config *SdConfig;
+	s32 Status;
+
+	SdConfig = XSdPs_LookupConfig(DeviceId);
+	if (NULL == SdConfig) {
+		return XST_FAILURE;
+	}
+
+	Status = XSdPs_CfgInitialize(&SdInstance, SdConfig,
+					SdConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XSdPs_CardInitialize(&SdInstance);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XSdPs_EnableRequestQueue(&SdInstance);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	SdNumBlocks = SdInstance.SectorCount;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* This function starts the data phase of a READ(10) or WRITE(10) command on
+* the SD card.
+*
+* @param	InstancePtr is pointer to Usb_DevData instance.
+* @param	Block is the first block of the command.
+* @param	BlkCnt is the number of blocks of the command.
+* @param	IsWrite is 1 for WRITE(10), 0 for READ(10).
+*
+* @return	None
+*
+* @note		None.
+*
+*****************************************************************************/
+static void StorageSdStart(struct Usb_DevData *InstancePtr, u32 Block,
+				u32 BlkCnt, u8 IsWrite)
+{
+	u8 Index;
+
+	for (Index = 0; Index < SD_NUM_CHUNKS; Index++) {
+		SdPipe.State[Index] = SD_CHUNK_FREE;
+	}
+	SdPipe.NextBlock = Block;
+	SdPipe.SourceBlocks = BlkCnt;
+	SdPipe.SinkBlocks = BlkCnt;
+	SdPipe.Fill = 0;
+	SdPipe.Drain = 0;
+	SdPipe.IsWrite = IsWrite;
+	SdPipe.Status = 0;
+
+	if (BlkCnt == 0) {
+		SendCSW(InstancePtr, 0);
+		return;
+	}
+
+	StorageSdFill(InstancePtr);
+}
+
+/****************************************************************************/
+/**
+* This function fills the free chunks from the source. Reads queue an SD
+* request for every free chunk, writes receive into the next free chunk,
+* one bulk OUT transfer at a time.
+*
+* @param	InstancePtr is pointer to Usb_DevData instance.
+*
+* @return	None
+*
+* @note		None.
+*
+*****************************************************************************/
+static void StorageSdFill(struct Usb_DevData *InstancePtr)
+{
+	XSdPs_Request *ReqPtr;
+	u32 BlkCnt;
+	u8 Index;
+
+	while ((SdPipe.SourceBlocks != 0) &&
+			(SdPipe.State[SdPipe.Fill] == SD_CHUNK_FREE)) {
+		Index = SdPipe.Fill;
+		BlkCnt = SdPipe.SourceBlocks;
+		if (BlkCnt > SD_CHUNK_BLOCKS) {
+			BlkCnt = SD_CHUNK_BLOCKS;
+		}
+		SdPipe.BlkCnt[Index] = BlkCnt;
+
+		if (SdPipe.IsWrite != 0U) {
+			/* Only one bulk OUT transfer is outstanding */
+			if ((SdPipe.SourceBlocks != SdPipe.SinkBlocks) &&
+				(SdPipe.State[(Index + SD_NUM_CHUNKS - 1) %
+				SD_NUM_CHUNKS] == SD_CHUNK_USB)) {
+				break;
+			}
+			SdPipe.State[Index] = SD_CHUNK_USB;
+			EpBufferRecv(InstancePtr->PrivateData, 1,
+				SdChunk[Index], BlkCnt * VFLASH_BLOCK_SIZE);
+			SdPipe.SourceBlocks -= BlkCnt;
+			SdPipe.Fill = (Index + 1) % SD_NUM_CHUNKS;
+			break;
+		}
+
+		ReqPtr = &SdPipe.Req[Index];
+		ReqPtr->Arg = (SdInstance.HCS != 0U) ? SdPipe.NextBlock :
+				SdPipe.NextBlock * VFLASH_BLOCK_SIZE;
+		ReqPtr->BlkCnt = BlkCnt;
+		ReqPtr->Buff = SdChunk[Index];
+		ReqPtr->IsWrite = 0U;
+		ReqPtr->Handler = StorageSdDone;
+		ReqPtr->CallBackRef = InstancePtr;
+
+		SdPipe.State[Index] = SD_CHUNK_SD;
+		SdPipe.NextBlock += BlkCnt;
+		SdPipe.SourceBlocks -= BlkCnt;
+		SdPipe.Fill = (Index + 1) % SD_NUM_CHUNKS;
+
+		if (XSdPs_SubmitRequest(&SdInstance, ReqPtr) != XST_SUCCESS) {
+			ReqPtr->Status = XST_FAILURE;
+			StorageSdDone(InstancePtr, ReqPtr);
+		}
+	}
+}
+
+/****************************************************************************/
+/**
+* This function hands the next filled chunk to the sink. Reads send it on
+* bulk IN, writes queue it on the SD card.
+*
+* @param	InstancePtr is pointer to Usb_DevData instance.
+*
+* @return	None
+*
+* @note		None.
+*
+*****************************************************************************/
+static void StorageSdDrain(struct Usb_DevData *InstancePtr)
+{
+	XSdPs_Request *ReqPtr;
+	u8 Index = SdPipe.Drain;
+
+	if (SdPipe.State[Index] != SD_CHUNK_READY) {
+		return;
+	}
+
+	if (SdPipe.IsWrite == 0U) {
+		SdPipe.State[Index] = SD_CHUNK_USB;
+		EpBufferSend(InstancePtr->PrivateData, 1, SdChunk[Index],
+				SdPipe.BlkCnt[Index] * VFLASH_BLOCK_SIZE);
+		return;
+	}
+
+	ReqPtr = &SdPipe.Req[Index];
+	ReqPtr->Arg = (SdInstance.HCS != 0U) ? SdPipe.NextBlock :
+			SdPipe.NextBlock * VFLASH_BLOCK_SIZE;
+	ReqPtr->BlkCnt = SdPipe.BlkCnt[Index];
+	ReqPtr->Buff = SdChunk[Index];
+	ReqPtr->IsWrite = 1U;
+	ReqPtr->Handler = StorageSdDone;
+	ReqPtr->CallBackRef = InstancePtr;
+
+	SdPipe.State[Index] = SD_CHUNK_SD;
+	SdPipe.NextBlock += SdPipe.BlkCnt[Index];
+	SdPipe.Drain = (Index + 1) % SD_NUM_CHUNKS;
+
+	if (XSdPs_SubmitRequest(&SdInstance, ReqPtr) != XST_SUCCESS) {
+		ReqPtr->Status = XST_FAILURE;
+		StorageSdDone(InstancePtr, ReqPtr);
+	}
+}
+
+/****************************************************************************/
+/**
+* This function is the completion handler of the SD requests, called from
+* the SD interrupt.
+*
+* @param	CallBackRef is pointer to Usb_DevData instance.
+* @param	RequestPtr is the completed request.
+*
+* @return	None
+*
+* @note		A failed chunk is still transferred so that the host sees
+*		the whole data phase, the CSW then reports the failure.
+*
+*****************************************************************************/
+static void StorageSdDone(void *CallBackRef, XSdPs_Request *RequestPtr)
+{
+	struct Usb_DevData *InstancePtr = CallBackRef;
+	u8 Index = (u8)(RequestPtr - &SdPipe.Req[0]);
+
+	if (RequestPtr->Status != XST_SUCCESS) {
+		SdPipe.Status = 1;
+	}
+
+	if (SdPipe.IsWrite == 0U) {
+		SdPipe.State[Index] = SD_CHUNK_READY;
+		/* Sent right away unless an earlier chunk is on bulk IN */
+		StorageSdDrain(InstancePtr);
+		return;
+	}
+
+	SdPipe.State[Index] = SD_CHUNK_FREE;
+	SdPipe.SinkBlocks -= RequestPtr->BlkCnt;
+	if (SdPipe.SinkBlocks == 0) {
+		SendCSWStatus(InstancePtr, 0, SdPipe.Status);
+		return;
+	}
+	StorageSdFill(InstancePtr);
+}
+
+/****************************************************************************/
+/**
+* This function is called from the bulk IN handler in the data phase of a
+* READ(10) command on the SD card.
+*
+* @param	InstancePtr is pointer to Usb_DevData instance.
+* @param	BytesTxed is actual number of bytes sent to Host.
+*
+* @return	None
+*
+* @note		None.
+*
+*****************************************************************************/
+void StorageSdBulkIn(struct Usb_DevData *InstancePtr, u32 BytesTxed)
+{
+	u8 Index = SdPipe.Drain;
+
+	(void)BytesTxed;
+
+	SdPipe.State[Index] = SD_CHUNK_FREE;
+	SdPipe.SinkBlocks -= SdPipe.BlkCnt[Index];
+	SdPipe.Drain = (Index + 1) % SD_NUM_CHUNKS;
+
+	if (SdPipe.SinkBlocks == 0) {
+		SendCSWStatus(InstancePtr, 0, SdPipe.Status);
+		return;
+	}
+
+	/* The next chunk is usually read already, send it first */
+	StorageSdDrain(InstancePtr);
+	StorageSdFill(InstancePtr);
+}
+
+/****************************************************************************/
+/**
+* This function is called from the bulk OUT handler in the data phase of a
+* WRITE(10) command on the SD card.
+*
+* @param	InstancePtr is pointer to Usb_DevData instance.
+* @param	BytesTxed is actual number of bytes received from Host.
+*
+* @return	None
+*
+* @note		None.
+*
+*****************************************************************************/
+void StorageSdBulkOut(struct Usb_DevData *InstancePtr, u32 BytesTxed)
+{
+	u8 Index = (SdPipe.Fill + SD_NUM_CHUNKS - 1) % SD_NUM_CHUNKS;
+
+	(void)BytesTxed;
+
+	SdPipe.State[Index] = SD_CHUNK_READY;
+	/* Receive the next chunk while this one is written */
+	StorageSdFill(InstancePtr);
+	StorageSdDrain(InstancePtr);
+}
+#endif
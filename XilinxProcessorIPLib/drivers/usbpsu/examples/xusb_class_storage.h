@@ -38,6 +38,7 @@
  * 1.0   sg  06/06/16  First release
  * 1.4   BK  12/01/18 Renamed the file and added changes to have a common
  *		      example for all USB IPs.
+ * 1.6   vak 15/10/19 Added the SD card backed disk, see XUSB_STORAGE_SD
  *
  * </pre>
  *
@@ -51,8 +52,18 @@ extern "C" {
 #endif
 
 /***************************** Include Files *********************************/
+
+/*
+ * Enable XUSB_STORAGE_SD to export the SD card instead of the RAM disk. SD
+ * reads and writes are then pipelined with the bulk transfers.
+ */
+//#define XUSB_STORAGE_SD		1
+
 #include "xil_types.h"
 #include "xusb_ch9.h"
+#ifdef XUSB_STORAGE_SD
+#include "xsdps.h"
+#endif
 
 /************************** Constant Definitions *****************************/
 /*
@@ -84,6 +95,11 @@ extern "C" {
 #define VFLASH_BLOCK_SIZE	0x200
 #define VFLASH_NUM_BLOCKS	(VFLASH_SIZE/VFLASH_BLOCK_SIZE)
 
+/* SD card disk. Every chunk is one SD request and one bulk transfer.
+ */
+#define SD_CHUNK_BLOCKS		128	/* 64KB chunks */
+#define SD_NUM_CHUNKS		2	/* one on SD while one is on USB */
+
 /* Class request opcodes.
  */
 #define USB_CLASSREQ_MASS_STORAGE_RESET	0xFF
@@ -178,6 +194,11 @@ typedef struct {
 void ClassReq(struct Usb_DevData *InstancePtr, SetupPacket *SetupData);
 void ParseCBW(struct Usb_DevData *InstancePtr);
 void SendCSW(struct Usb_DevData *InstancePtr, u32 Length);
+#ifdef XUSB_STORAGE_SD
+s32 StorageSdInit(u16 DeviceId);
+void StorageSdBulkIn(struct Usb_DevData *InstancePtr, u32 BytesTxed);
+void StorageSdBulkOut(struct Usb_DevData *InstancePtr, u32 BytesTxed);
+#endif
 
 #ifdef __cplusplus
 }
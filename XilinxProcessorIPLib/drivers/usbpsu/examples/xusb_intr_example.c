@@ -44,6 +44,8 @@
  *	 vak 13/03/18 Moved the setup interrupt system calls from driver to
  *		      example.
  * 1.5	 vak 13/02/19 Added support for versal
+ * 1.6	 vak 15/10/19 Added the SD card backed disk, see XUSB_STORAGE_SD in
+ *		      xusb_class_storage.h
  *
  * </pre>
  *
@@ -114,6 +116,10 @@ XScuGic	InterruptController;	/* Interrupt controller instance */
 #define	INTC_DEVICE_ID		XPAR_SCUGIC_SINGLE_DEVICE_ID
 #define	USB_INT_ID		XPAR_XUSBPS_0_INTR
 #define	USB_WAKEUP_INTR_ID	XPAR_XUSBPS_0_WAKE_INTR
+#ifdef XUSB_STORAGE_SD
+#define	SD_DEVICE_ID		XPAR_XSDPS_0_DEVICE_ID
+#define	SD_INTR_ID		XPAR_XSDPS_0_INTR
+#endif
 #else	/* OTHERS */
 #define	INTC_DEVICE_ID		0
 #define	USB_INT_ID		0
@@ -122,29 +128,39 @@ XScuGic	InterruptController;	/* Interrupt controller instance */
 /* Buffer for virtual flash disk space. */
 #ifdef __ICCARM__
 #if defined (PLATFORM_ZYNQMP) || defined (versal)
+#ifndef XUSB_STORAGE_SD
 #pragma data_alignment = 64
 u8 VirtFlash[VFLASH_SIZE];
+#endif
 #pragma data_alignment = 64
 USB_CBW CBW;
 #pragma data_alignment = 64
 USB_CSW CSW;
 #else
+#ifndef XUSB_STORAGE_SD
 #pragma data_alignment = 32
 u8 VirtFlash[VFLASH_SIZE];
+#endif
 #pragma data_alignment = 32
 USB_CBW CBW;
 #pragma data_alignment = 32
 USB_CSW CSW;
 #endif
 #else
+#ifndef XUSB_STORAGE_SD
 u8 VirtFlash[VFLASH_SIZE] ALIGNMENT_CACHELINE;
+#endif
 USB_CBW CBW ALIGNMENT_CACHELINE;
 USB_CSW CSW ALIGNMENT_CACHELINE;
 #endif
 
 u8 Phase;
+#ifdef XUSB_STORAGE_SD
+XSdPs SdInstance;	/* SD card instance, the disk */
+#else
 u32	rxBytesLeft;
 u8 *VirtFlashWritePointer = VirtFlash;
+#endif
 
 /* Initialize a DFU data structure */
 static USBCH9_DATA storage_data = {
@@ -201,6 +217,14 @@ int main(void)
 
 	CacheInit();
 
+#ifdef XUSB_STORAGE_SD
+	Status = StorageSdInit(SD_DEVICE_ID);
+	if (XST_SUCCESS != Status) {
+		xil_printf("SD card initialization failed\r\n");
+		return XST_FAILURE;
+	}
+#endif
+
 	/* We are passing the physical base address as the third argument
 	 * because the physical and virtual base address are the same in our
 	 * example.  For systems that support virtual memory, the third
@@ -277,12 +301,20 @@ void BulkOutHandler(void *CallBackRef, u32 RequestedBytes,
 	if (Phase == USB_EP_STATE_COMMAND) {
 		ParseCBW(InstancePtr);
 	} else if (Phase == USB_EP_STATE_DATA_OUT) {
+#ifdef XUSB_STORAGE_SD
+		if (CBW.CBWCB[0] == USB_RBC_WRITE) {
+			StorageSdBulkOut(InstancePtr, BytesTxed);
+			return;
+		}
+#endif
 		/* WRITE command */
 		switch (CBW.CBWCB[0]) {
+#ifndef XUSB_STORAGE_SD
 		case USB_RBC_WRITE:
 			VirtFlashWritePointer += BytesTxed;
 			rxBytesLeft -= BytesTxed;
 			break;
+#endif
 		default:
 			break;
 		}
@@ -310,6 +342,12 @@ void BulkInHandler(void *CallBackRef, u32 RequestedBytes,
 	struct Usb_DevData *InstancePtr = CallBackRef;
 
 	if (Phase == USB_EP_STATE_DATA_IN) {
+#ifdef XUSB_STORAGE_SD
+		if (CBW.CBWCB[0] == USB_RBC_READ) {
+			StorageSdBulkIn(InstancePtr, BytesTxed);
+			return;
+		}
+#endif
 		/* Send the status */
 		SendCSW(InstancePtr, 0);
 	} else if (Phase == USB_EP_STATE_STATUS) {
@@ -453,6 +491,16 @@ static s32 SetupInterruptSystem(struct XUsbPsu *InstancePtr, u16 IntcDeviceID,
 	}
 #endif
 
+#ifdef XUSB_STORAGE_SD
+	Status = XScuGic_Connect(IntcInstancePtr, SD_INTR_ID,
+							(Xil_ExceptionHandler)XSdPs_IntrHandler,
+							(void *)&SdInstance);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XScuGic_Enable(IntcInstancePtr, SD_INTR_ID);
+#endif
+
 	/*
 	 * Enable the interrupt for the USB
 	 */
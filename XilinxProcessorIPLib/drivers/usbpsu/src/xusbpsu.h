@@ -61,6 +61,7 @@
 * 1.5	vak   02/06/19 Added "xusbpsu_endpoint.h" header
 * 1.5	vak   03/25/19 Fixed incorrect data_alignment pragma directive for IAR
 * 1.6	pm    22/07/19 Removed coverity warnings
+* 1.6	vak   15/10/19 Added TRB ring streaming for bulk endpoints
 *
 * </pre>
 *
@@ -102,6 +103,20 @@ extern "C" {
 
 #define NO_OF_TRB_PER_EP		2U
 
+/*
+ * Number of TRBs in the ring of a streaming endpoint, i.e. the number of
+ * requests which can be queued at a time is XUSBPSU_STREAM_NUM_TRB - 1
+ */
+#ifndef XUSBPSU_STREAM_NUM_TRB
+#define XUSBPSU_STREAM_NUM_TRB		32U
+#endif
+
+/* Flags of XUsbPsu_EpStreamQueue() */
+#define XUSBPSU_STREAM_IOC		0x01U	/**< Interrupt when this request
+						  *  completes */
+#define XUSBPSU_STREAM_MORE		0x02U	/**< More requests follow, the
+						  *  core is told later */
+
 #if defined (PLATFORM_ZYNQMP) || defined (versal)
 #define ALIGNMENT_CACHELINE		__attribute__ ((aligned(64)))
 #else
@@ -339,6 +354,30 @@ typedef struct {
 } __attribute__ ((packed)) SetupPacket;
 #endif
 
+/**
+ * TRB ring of a streaming bulk endpoint. Allocated by the application, one
+ * per endpoint, and attached with XUsbPsu_EpStreamInit().
+ */
+struct XUsbPsu_EpStream {
+#if defined (__ICCARM__)
+    #pragma data_alignment = 64
+	struct XUsbPsu_Trb	Trb[XUSBPSU_STREAM_NUM_TRB + 1U]; /**< One extra Trb is for Link Trb */
+#else
+	struct XUsbPsu_Trb	Trb[XUSBPSU_STREAM_NUM_TRB + 1U] ALIGNMENT_CACHELINE;/**< TRB ring, the last one is the Link Trb */
+#endif
+	u8	*BufferPtr[XUSBPSU_STREAM_NUM_TRB]; /**< Buffer of each request */
+	u32	Length[XUSBPSU_STREAM_NUM_TRB];	/**< Length of each request */
+	u32	Enqueue;		/**< Next Trb to be filled */
+	u32	Dequeue;		/**< Oldest Trb not yet completed */
+	u32	IocInterval;		/**< Interrupt every IocInterval requests */
+	u32	SinceIoc;		/**< Requests queued since the last IOC */
+	void (*Handler)(void *, u8 *, u32, u32);
+					/**< Called for each completed request
+					 *   with the buffer, requested and
+					 *   transferred bytes
+					 */
+};
+
 /**
  * Endpoint representation
  */
@@ -374,6 +413,8 @@ struct XUsbPsu_Ep {
 						 */
 	u8	Direction;		/**< Direction - EP_DIR_OUT/EP_DIR_IN */
 	u8	UnalignedTx;
+	struct XUsbPsu_EpStream *Stream;	/**< TRB ring when streaming,
+						  *  else NULL */
 };
 
 /**
@@ -697,6 +738,19 @@ void XUsbPsu_EpXferComplete(struct XUsbPsu *InstancePtr,
 void XUsbPsu_EpXferNotReady(struct XUsbPsu *InstancePtr,
 							const struct XUsbPsu_Event_Epevt *Event);
 
+/*
+ * Functions in xusbpsu_stream.c
+ */
+s32 XUsbPsu_EpStreamInit(struct XUsbPsu *InstancePtr, u8 UsbEp, u8 Dir,
+			struct XUsbPsu_EpStream *Stream, u32 IocInterval,
+			void (*Handler)(void *, u8 *, u32, u32));
+s32 XUsbPsu_EpStreamQueue(struct XUsbPsu *InstancePtr, u8 UsbEp, u8 Dir,
+			u8 *BufferPtr, u32 Length, u32 Flags);
+u32 XUsbPsu_EpStreamSpace(struct XUsbPsu *InstancePtr, u8 UsbEp, u8 Dir);
+void XUsbPsu_EpStreamComplete(struct XUsbPsu *InstancePtr,
+			struct XUsbPsu_Ep *Ept,
+			const struct XUsbPsu_Event_Epevt *Event);
+
 /*
  * Functions in xusbpsu_controltransfers.c
  */
@@ -44,6 +44,8 @@
 * 1.4	vak 30/05/18 Removed xusb_wrapper files
 * 1.6	pm  22/07/19 Removed coverity warnings
 *	pm  28/08/19 Removed 80-character warnings
+*	vak 15/10/19 Hand over the events of streaming endpoints to
+*		     XUsbPsu_EpStreamComplete()
 * </pre>
 *
 *****************************************************************************/
@@ -290,6 +292,11 @@ s32 XUsbPsu_SetEpConfig(struct XUsbPsu *InstancePtr, u8 UsbEpNum, u8 Dir,
 		Params->Param1 |= XUSBPSU_DEPCFG_XFER_IN_PROGRESS_EN;
 	}
 
+	/* A streaming transfer never ends, its IOC Trbs raise XferInProgress */
+	if (Ept->Stream != NULL) {
+		Params->Param1 |= XUSBPSU_DEPCFG_XFER_IN_PROGRESS_EN;
+	}
+
 	return XUsbPsu_SendEpCmd(InstancePtr, UsbEpNum, Dir,
 						 XUSBPSU_DEPCMD_SETEPCONFIG,
 						 Params);
@@ -472,6 +479,11 @@ s32 XUsbPsu_EpDisable(struct XUsbPsu *InstancePtr, u8 UsbEpNum, u8 Dir)
 	Ept->MaxSize = 0U;
 	Ept->TrbEnqueue	= 0U;
 	Ept->TrbDequeue	= 0U;
+	if (Ept->Stream != NULL) {
+		Ept->Stream->Enqueue = 0U;
+		Ept->Stream->Dequeue = 0U;
+		Ept->Stream->SinceIoc = 0U;
+	}
 
 	return XST_SUCCESS;
 }
@@ -535,12 +547,14 @@ void XUsbPsu_InitializeEps(struct XUsbPsu *InstancePtr)
 		InstancePtr->eps[Epnum].PhyEpNum = Epnum;
 		InstancePtr->eps[Epnum].Direction = XUSBPSU_EP_DIR_OUT;
 		InstancePtr->eps[Epnum].ResourceIndex = 0U;
+		InstancePtr->eps[Epnum].Stream = NULL;
 	}
 	for (i = 0U; i < InstancePtr->NumInEps; i++) {
 		Epnum = (i << 1U) | XUSBPSU_EP_DIR_IN;
 		InstancePtr->eps[Epnum].PhyEpNum = Epnum;
 		InstancePtr->eps[Epnum].Direction = XUSBPSU_EP_DIR_IN;
 		InstancePtr->eps[Epnum].ResourceIndex = 0U;
+		InstancePtr->eps[Epnum].Stream = NULL;
 	}
 }
 
@@ -1136,6 +1150,11 @@ void XUsbPsu_EpXferComplete(struct XUsbPsu *InstancePtr,
 
 	Epnum = Event->Epnumber;
 	Ept = &InstancePtr->eps[Epnum];
+	if (Ept->Stream != NULL) {
+		XUsbPsu_EpStreamComplete(InstancePtr, Ept, Event);
+		return;
+	}
+
 	Dir = Ept->Direction;
 	TrbPtr = &Ept->EpTrb[Ept->TrbDequeue];
 	Xil_AssertVoid(TrbPtr != NULL);
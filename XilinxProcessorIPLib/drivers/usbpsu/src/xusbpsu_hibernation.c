@@ -40,6 +40,7 @@
 * 1.0   Mayank 12/01/18 First release
 * 1.5   VAK    14/03/19 Enable hibernation related functions only when
 *                       XUSBPSU_HIBERNATION_ENABLE is defined
+* 1.6   vak    15/10/19 Restart streaming endpoints from their TRB ring
 *
 * </pre>
 *
@@ -422,6 +423,25 @@ static s32 XUsbPsu_RestartEp(struct XUsbPsu *InstancePtr, u8 EpNum)
 		return XST_SUCCESS;
 	}
 
+	if (Ept->Stream != NULL) {
+		/* The pending TRBs of the ring still own their HWO bit */
+		TrbPtr = &Ept->Stream->Trb[Ept->Stream->Dequeue];
+		Params->Param0 = 0U;
+		Params->Param1 = (UINTPTR)TrbPtr;
+		Ret = XUsbPsu_SendEpCmd(InstancePtr, Ept->UsbEpNum,
+				Ept->Direction, XUSBPSU_DEPCMD_STARTTRANSFER,
+				Params);
+		if (Ret == XST_FAILURE) {
+			return (s32)XST_FAILURE;
+		}
+
+		Ept->EpStatus |= XUSBPSU_EP_BUSY;
+		Ept->ResourceIndex = (u8)XUsbPsu_EpGetTransferIndex(InstancePtr,
+				Ept->UsbEpNum, Ept->Direction);
+
+		return (s32)XST_SUCCESS;
+	}
+
 	if (Ept->UsbEpNum != (u32)0U) {
 		TrbPtr = &Ept->EpTrb[Ept->TrbDequeue];
 	} else {
@@ -0,0 +1,380 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*****************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xusbpsu_stream.c
+* @addtogroup usbpsu_v1_6
+* @{
+*
+* Streaming of bulk endpoints. A streaming endpoint owns a ring of TRBs
+* closed by a Link TRB, so that any number of requests, up to the ring size,
+* can be queued and the core moves from one to the next without waiting for
+* software. The transfer is started once and only updated afterwards.
+*
+* Only the requests flagged with XUSBPSU_STREAM_IOC, and every IocInterval-th
+* request, interrupt the processor. On that interrupt all the requests
+* completed so far are retired in order and the handler is called for each
+* of them.
+*
+* XUsbPsu_EpStreamQueue() must not run concurrently with the interrupt
+* handler of the core, call it from the stream handler or with the USB
+* interrupt disabled.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.6	vak 15/10/19 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xusbpsu_endpoint.h"
+#include "xusbpsu.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+/************************** Variable Definitions *****************************/
+
+/****************************************************************************/
+/**
+* Attaches a TRB ring to a bulk endpoint, or detaches it. Once attached,
+* the endpoint is driven with XUsbPsu_EpStreamQueue() only.
+*
+* @param	InstancePtr is a pointer to the XUsbPsu instance.
+* @param	UsbEp is USB endpoint number.
+* @param	Dir is direction of endpoint - XUSBPSU_EP_DIR_IN/XUSBPSU_EP_DIR_OUT.
+* @param	Stream is the TRB ring to attach, NULL to detach it.
+* @param	IocInterval is the number of requests per interrupt, 1 for an
+*		interrupt on every request.
+* @param	Handler is called for each completed request.
+*
+* @return	XST_SUCCESS else XST_FAILURE if a transfer is in progress.
+*
+* @note		Call it before XUsbPsu_EpEnable(), the XferInProgress event
+*		is enabled at that time.
+*
+*****************************************************************************/
+s32 XUsbPsu_EpStreamInit(struct XUsbPsu *InstancePtr, u8 UsbEp, u8 Dir,
+			struct XUsbPsu_EpStream *Stream, u32 IocInterval,
+			void (*Handler)(void *, u8 *, u32, u32))
+{
+	struct XUsbPsu_Ep *Ept;
+	struct XUsbPsu_Trb *TrbLink;
+	u8 PhyEpNum;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((UsbEp > (u8)0U) && (UsbEp <= (u8)16U));
+	Xil_AssertNonvoid((Dir == XUSBPSU_EP_DIR_IN) ||
+						(Dir == XUSBPSU_EP_DIR_OUT));
+	Xil_AssertNonvoid(IocInterval > 0U);
+
+	PhyEpNum = XUSBPSU_PhysicalEp(UsbEp, Dir);
+	Ept = &InstancePtr->eps[PhyEpNum];
+
+	if ((Ept->EpStatus & XUSBPSU_EP_BUSY) != (u32)0U) {
+		return (s32)XST_FAILURE;
+	}
+
+	Ept->Stream = Stream;
+	if (Stream == NULL) {
+		return (s32)XST_SUCCESS;
+	}
+
+	memset(Stream->Trb, 0x00U, sizeof(Stream->Trb));
+	Stream->Enqueue = 0U;
+	Stream->Dequeue = 0U;
+	Stream->SinceIoc = 0U;
+	Stream->IocInterval = IocInterval;
+	Stream->Handler = Handler;
+
+	/* Link TRB. The HWO bit is never reset */
+	TrbLink = &Stream->Trb[XUSBPSU_STREAM_NUM_TRB];
+	TrbLink->BufferPtrLow = (UINTPTR)&Stream->Trb[0U];
+	TrbLink->BufferPtrHigh = ((UINTPTR)&Stream->Trb[0U] >> 16U) >> 16U;
+	TrbLink->Ctrl = XUSBPSU_TRBCTL_LINK_TRB | XUSBPSU_TRB_CTRL_HWO;
+
+	if (InstancePtr->ConfigPtr->IsCacheCoherent == (u8)0U) {
+		Xil_DCacheFlushRange((INTPTR)Stream->Trb,
+					 sizeof(Stream->Trb));
+	}
+
+	return (s32)XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* Queues a request on a streaming endpoint. The transfer is started on the
+* first request and updated on the following ones, without waiting for the
+* previous requests to complete.
+*
+* @param	InstancePtr is a pointer to the XUsbPsu instance.
+* @param	UsbEp is USB endpoint number.
+* @param	Dir is direction of endpoint - XUSBPSU_EP_DIR_IN/XUSBPSU_EP_DIR_OUT.
+* @param	BufferPtr is pointer to data.
+* @param	Length is length of data to be sent or received.
+* @param	Flags is a combination of
+*		- XUSBPSU_STREAM_IOC to interrupt when this request completes.
+*		  Set it on the last request of a burst, the requests after
+*		  the last IOC one are only retired on the next interrupt.
+*		- XUSBPSU_STREAM_MORE to only fill the TRB. The core is told
+*		  about all the filled TRBs by the next call without this
+*		  flag, with a single command.
+*
+* @return	XST_SUCCESS else XST_FAILURE if the ring is full or the
+*		command to the core failed.
+*
+* @note		An OUT buffer must hold Length rounded up to the maximum packet
+*		size, see section 8.2.5 of the DWC3 databook.
+*
+*****************************************************************************/
+s32 XUsbPsu_EpStreamQueue(struct XUsbPsu *InstancePtr, u8 UsbEp, u8 Dir,
+			u8 *BufferPtr, u32 Length, u32 Flags)
+{
+	struct XUsbPsu_EpStream *Stream;
+	struct XUsbPsu_EpParams *Params;
+	struct XUsbPsu_Trb *TrbPtr;
+	struct XUsbPsu_Ep *Ept;
+	u32 Next;
+	u32 Size;
+	u32 Ctrl;
+	u32 Cmd;
+	u8 PhyEpNum;
+	s32 RetVal;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((UsbEp > (u8)0U) && (UsbEp <= (u8)16U));
+	Xil_AssertNonvoid((Dir == XUSBPSU_EP_DIR_IN) ||
+						(Dir == XUSBPSU_EP_DIR_OUT));
+	Xil_AssertNonvoid(BufferPtr != NULL);
+
+	PhyEpNum = XUSBPSU_PhysicalEp(UsbEp, Dir);
+	Ept = &InstancePtr->eps[PhyEpNum];
+	Stream = Ept->Stream;
+
+	if ((Stream == NULL) ||
+			((Ept->EpStatus & XUSBPSU_EP_ENABLED) == (u32)0U)) {
+		return (s32)XST_FAILURE;
+	}
+
+	Next = Stream->Enqueue + 1U;
+	if (Next == XUSBPSU_STREAM_NUM_TRB) {
+		Next = 0U;
+	}
+	if (Next == Stream->Dequeue) {
+		return (s32)XST_FAILURE;
+	}
+
+	Size = Length;
+	if ((Dir == XUSBPSU_EP_DIR_OUT) && !IS_ALIGNED(Length, Ept->MaxSize)) {
+		Size = (u32)roundup(Length, (u16)Ept->MaxSize);
+	}
+
+	Stream->BufferPtr[Stream->Enqueue] = BufferPtr;
+	Stream->Length[Stream->Enqueue] = Size;
+
+	TrbPtr = &Stream->Trb[Stream->Enqueue];
+	TrbPtr->BufferPtrLow  = (UINTPTR)BufferPtr;
+	TrbPtr->BufferPtrHigh = ((UINTPTR)BufferPtr >> 16U) >> 16U;
+	TrbPtr->Size = Size & XUSBPSU_TRB_SIZE_MASK;
+
+	/*
+	 * No LST, the transfer goes on through the Link TRB. Short OUT
+	 * packets complete their TRB and the core continues with the next.
+	 */
+	Ctrl = XUSBPSU_TRBCTL_NORMAL | XUSBPSU_TRB_CTRL_HWO;
+	if (Dir == XUSBPSU_EP_DIR_OUT) {
+		Ctrl |= XUSBPSU_TRB_CTRL_ISP_IMI | XUSBPSU_TRB_CTRL_CSP;
+	}
+
+	Stream->SinceIoc++;
+	if (((Flags & XUSBPSU_STREAM_IOC) != 0U) ||
+			(Stream->SinceIoc >= Stream->IocInterval)) {
+		Ctrl |= XUSBPSU_TRB_CTRL_IOC;
+		Stream->SinceIoc = 0U;
+	}
+
+	if (InstancePtr->ConfigPtr->IsCacheCoherent == (u8)0U) {
+		if (Dir == XUSBPSU_EP_DIR_IN) {
+			Xil_DCacheFlushRange((INTPTR)BufferPtr, Length);
+		} else {
+			Xil_DCacheInvalidateRange((INTPTR)BufferPtr, Size);
+		}
+	}
+
+	/* HWO last, the core may fetch the TRB as soon as it is set */
+	TrbPtr->Ctrl = Ctrl;
+	if (InstancePtr->ConfigPtr->IsCacheCoherent == (u8)0U) {
+		Xil_DCacheFlushRange((INTPTR)TrbPtr,
+					 sizeof(struct XUsbPsu_Trb));
+	}
+
+	Stream->Enqueue = Next;
+
+	if ((Flags & XUSBPSU_STREAM_MORE) != 0U) {
+		return (s32)XST_SUCCESS;
+	}
+
+	Params = XUsbPsu_GetEpParams(InstancePtr);
+	Xil_AssertNonvoid(Params != NULL);
+
+	if ((Ept->EpStatus & XUSBPSU_EP_BUSY) != (u32)0U) {
+		Cmd = XUSBPSU_DEPCMD_UPDATETRANSFER;
+		Cmd |= XUSBPSU_DEPCMD_PARAM(Ept->ResourceIndex);
+	} else {
+		/* Start from the oldest TRB the core has not completed */
+		TrbPtr = &Stream->Trb[Stream->Dequeue];
+		Params->Param0 = ((UINTPTR)TrbPtr >> 16U) >> 16U;
+		Params->Param1 = (UINTPTR)TrbPtr;
+		Cmd = XUSBPSU_DEPCMD_STARTTRANSFER;
+	}
+
+	RetVal = XUsbPsu_SendEpCmd(InstancePtr, UsbEp, Dir, Cmd, Params);
+	if (RetVal != XST_SUCCESS) {
+		return (s32)XST_FAILURE;
+	}
+
+	if ((Ept->EpStatus & XUSBPSU_EP_BUSY) == (u32)0U) {
+		Ept->ResourceIndex = (u8)XUsbPsu_EpGetTransferIndex(InstancePtr,
+				Ept->UsbEpNum,
+				Ept->Direction);
+
+		Ept->EpStatus |= XUSBPSU_EP_BUSY;
+	}
+
+	return (s32)XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* Returns the number of requests which can still be queued on a streaming
+* endpoint.
+*
+* @param	InstancePtr is a pointer to the XUsbPsu instance.
+* @param	UsbEp is USB endpoint number.
+* @param	Dir is direction of endpoint - XUSBPSU_EP_DIR_IN/XUSBPSU_EP_DIR_OUT.
+*
+* @return	Number of free TRBs, 0 if the endpoint is not streaming.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XUsbPsu_EpStreamSpace(struct XUsbPsu *InstancePtr, u8 UsbEp, u8 Dir)
+{
+	struct XUsbPsu_EpStream *Stream;
+	u32 Used;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(UsbEp <= (u8)16U);
+
+	Stream = InstancePtr->eps[XUSBPSU_PhysicalEp(UsbEp, Dir)].Stream;
+	if (Stream == NULL) {
+		return 0U;
+	}
+
+	Used = (Stream->Enqueue + XUSBPSU_STREAM_NUM_TRB - Stream->Dequeue) %
+		XUSBPSU_STREAM_NUM_TRB;
+
+	return XUSBPSU_STREAM_NUM_TRB - 1U - Used;
+}
+
+/****************************************************************************/
+/**
+* Retires the completed requests of a streaming endpoint, in order, and
+* calls the stream handler for each of them. Called on the XferInProgress
+* and XferComplete events of the endpoint.
+*
+* @param	InstancePtr is a pointer to the XUsbPsu instance.
+* @param	Ept is a pointer to the streaming endpoint.
+* @param	Event is a pointer to the Endpoint event occurred in core.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void XUsbPsu_EpStreamComplete(struct XUsbPsu *InstancePtr,
+			struct XUsbPsu_Ep *Ept,
+			const struct XUsbPsu_Event_Epevt *Event)
+{
+	struct XUsbPsu_EpStream *Stream;
+	struct XUsbPsu_Trb *TrbPtr;
+	u8 *BufferPtr;
+	u32 Requested;
+	u32 Actual;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Ept != NULL);
+	Xil_AssertVoid(Event != NULL);
+
+	Stream = Ept->Stream;
+
+	if (Event->Endpoint_Event == XUSBPSU_DEPEVT_XFERCOMPLETE) {
+		Ept->EpStatus &= ~(XUSBPSU_EP_BUSY);
+		Ept->ResourceIndex = 0U;
+	}
+
+	while (Stream->Dequeue != Stream->Enqueue) {
+		TrbPtr = &Stream->Trb[Stream->Dequeue];
+		if (InstancePtr->ConfigPtr->IsCacheCoherent == (u8)0U) {
+			Xil_DCacheInvalidateRange((INTPTR)TrbPtr,
+						 sizeof(struct XUsbPsu_Trb));
+		}
+
+		if ((TrbPtr->Ctrl & XUSBPSU_TRB_CTRL_HWO) != 0U) {
+			break;
+		}
+
+		BufferPtr = Stream->BufferPtr[Stream->Dequeue];
+		Requested = Stream->Length[Stream->Dequeue];
+		Actual = Requested - (TrbPtr->Size & XUSBPSU_TRB_SIZE_MASK);
+
+		Stream->Dequeue++;
+		if (Stream->Dequeue == XUSBPSU_STREAM_NUM_TRB) {
+			Stream->Dequeue = 0U;
+		}
+
+		if ((Ept->Direction == XUSBPSU_EP_DIR_OUT) &&
+			(InstancePtr->ConfigPtr->IsCacheCoherent == (u8)0U)) {
+			Xil_DCacheInvalidateRange((INTPTR)BufferPtr, Actual);
+		}
+
+		if (Stream->Handler) {
+			Stream->Handler(InstancePtr->AppData, BufferPtr,
+						Requested, Actual);
+		}
+	}
+}
+/** @} */
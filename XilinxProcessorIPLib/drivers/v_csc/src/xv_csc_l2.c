@@ -49,6 +49,8 @@
 * 2.1   rco   02/09/17 Fix c++ warnings
 * 2.2   vyc   10/04/17 Added support for 4:2:0
 * 2.3   viv   06/19/18 Added support for color range
+*       adk   10/15/19 Added deferred coefficient updates, only the changed
+*                      coefficient registers are written
 * </pre>
 *
 ******************************************************************************/
@@ -106,6 +108,8 @@ static void cscFwComputeCoeff(XV_Csc_l2 *CscPtr,
                               s32 K2[3][4]);
 static void cscUpdateIPReg(XV_Csc_l2 *CscPtr,
                            XV_CSC_REG_UPDT_WIN win);
+static void cscWriteIPReg(XV_Csc_l2 *CscPtr,
+                          XV_CSC_REG_UPDT_WIN win);
 /*****************************************************************************/
 /**
 * This function provides the write interface for FW register bank
@@ -1471,9 +1475,9 @@ static void cscFwMatrixMult(s32 K1[3][4], s32 K2[3][4], s32 Kout[3][4])
 
 /*****************************************************************************/
 /**
-* Write computed coefficients to IP HW registers
+* Write computed coefficients to IP HW registers, or mark them pending when the
+* deferred update is enabled
 *
-* @param  pCsc is pointer to csc core instance
 * @param  CscPtr is a pointer to layer 2 fw register bank
 * @param  win is the window mode: Full Frame or Demo window
 *
@@ -1483,91 +1487,114 @@ static void cscFwMatrixMult(s32 K1[3][4], s32 K2[3][4], s32 Kout[3][4])
 static void cscUpdateIPReg(XV_Csc_l2 *CscPtr,
                            XV_CSC_REG_UPDT_WIN win)
 {
-  u8 x,y;
-  s32 K[3][4];
-  u32 clampMin, clipMax;
+  if(CscPtr->DeferUpdate) {
+    CscPtr->UpdatePending |= (u8)(1 << win);
+    return;
+  }
+  cscWriteIPReg(CscPtr, win);
+}
+
+/*****************************************************************************/
+/**
+* Write computed coefficients to IP HW registers. The K11..ClipMax registers
+* of a bank are laid out every 8 bytes and only the registers which differ
+* from the last values written are accessed.
+*
+* @param  CscPtr is a pointer to layer 2 fw register bank
+* @param  win is the window mode: Full Frame or Demo window
+*
+* @return None
+*
+******************************************************************************/
+static void cscWriteIPReg(XV_Csc_l2 *CscPtr,
+                          XV_CSC_REG_UPDT_WIN win)
+{
+  u32 i, bank, fwBase, hwBase;
+  u32 val;
   XV_csc *pCsc = &CscPtr->Csc;
 
   switch(win)
   {
     case UPDT_REG_FULL_FRAME:
-        for(x=0; x<3; ++x)
-        {
-          for(y=0; y<3; ++y)
-          {
-            K[x][y] = cscFw_RegR(CscPtr, (x*3+y)+CSC_FW_REG_K11);
-          }
-        }
-        K[0][3] = cscFw_RegR(CscPtr, CSC_FW_REG_ROffset);
-        K[1][3] = cscFw_RegR(CscPtr, CSC_FW_REG_GOffset);
-        K[2][3] = cscFw_RegR(CscPtr, CSC_FW_REG_BOffset);
-        clampMin = cscFw_RegR(CscPtr, CSC_FW_REG_ClampMin);
-        clipMax  = cscFw_RegR(CscPtr, CSC_FW_REG_ClipMax);
-
-        XV_csc_Set_HwReg_K11(pCsc, K[0][0]);
-        XV_csc_Set_HwReg_K12(pCsc, K[0][1]);
-        XV_csc_Set_HwReg_K13(pCsc, K[0][2]);
-        XV_csc_Set_HwReg_K21(pCsc, K[1][0]);
-        XV_csc_Set_HwReg_K22(pCsc, K[1][1]);
-        XV_csc_Set_HwReg_K23(pCsc, K[1][2]);
-        XV_csc_Set_HwReg_K31(pCsc, K[2][0]);
-        XV_csc_Set_HwReg_K32(pCsc, K[2][1]);
-        XV_csc_Set_HwReg_K33(pCsc, K[2][2]);
-        XV_csc_Set_HwReg_ROffset_V(pCsc,  K[0][3]);
-        XV_csc_Set_HwReg_GOffset_V(pCsc,  K[1][3]);
-        XV_csc_Set_HwReg_BOffset_V(pCsc,  K[2][3]);
-        XV_csc_Set_HwReg_ClampMin_V(pCsc, clampMin);
-        XV_csc_Set_HwReg_ClipMax_V(pCsc,  clipMax);
+        fwBase = CSC_FW_REG_K11;
+        bank   = 0;
         break;
 
     case UPD_REG_DEMO_WIN:
-        for(x=0; x<3; ++x)
-        {
-          for(y=0; y<3; ++y)
-          {
-            K[x][y] = cscFw_RegR(CscPtr, (x*3+y)+CSC_FW_REG_K11_2);
-          }
-        }
-        K[0][3] = cscFw_RegR(CscPtr, CSC_FW_REG_ROffset_2);
-        K[1][3] = cscFw_RegR(CscPtr, CSC_FW_REG_GOffset_2);
-        K[2][3] = cscFw_RegR(CscPtr, CSC_FW_REG_BOffset_2);
-        clampMin = cscFw_RegR(CscPtr, CSC_FW_REG_ClampMin_2);
-        clipMax  = cscFw_RegR(CscPtr, CSC_FW_REG_ClipMax_2);
-        if (XV_CscIsDemoWindowEnabled(CscPtr)) {
-          XV_csc_Set_HwReg_K11_2(pCsc, K[0][0]);
-          XV_csc_Set_HwReg_K12_2(pCsc, K[0][1]);
-          XV_csc_Set_HwReg_K13_2(pCsc, K[0][2]);
-          XV_csc_Set_HwReg_K21_2(pCsc, K[1][0]);
-          XV_csc_Set_HwReg_K22_2(pCsc, K[1][1]);
-          XV_csc_Set_HwReg_K23_2(pCsc, K[1][2]);
-          XV_csc_Set_HwReg_K31_2(pCsc, K[2][0]);
-          XV_csc_Set_HwReg_K32_2(pCsc, K[2][1]);
-          XV_csc_Set_HwReg_K33_2(pCsc, K[2][2]);
-          XV_csc_Set_HwReg_ROffset_2_V(pCsc,  K[0][3]);
-          XV_csc_Set_HwReg_GOffset_2_V(pCsc,  K[1][3]);
-          XV_csc_Set_HwReg_BOffset_2_V(pCsc,  K[2][3]);
-          XV_csc_Set_HwReg_ClampMin_2_V(pCsc, clampMin);
-          XV_csc_Set_HwReg_ClipMax_2_V(pCsc,  clipMax);
-        } else {
-          XV_csc_Set_HwReg_K11(pCsc, K[0][0]);
-          XV_csc_Set_HwReg_K12(pCsc, K[0][1]);
-          XV_csc_Set_HwReg_K13(pCsc, K[0][2]);
-          XV_csc_Set_HwReg_K21(pCsc, K[1][0]);
-          XV_csc_Set_HwReg_K22(pCsc, K[1][1]);
-          XV_csc_Set_HwReg_K23(pCsc, K[1][2]);
-          XV_csc_Set_HwReg_K31(pCsc, K[2][0]);
-          XV_csc_Set_HwReg_K32(pCsc, K[2][1]);
-          XV_csc_Set_HwReg_K33(pCsc, K[2][2]);
-          XV_csc_Set_HwReg_ROffset_V(pCsc,  K[0][3]);
-          XV_csc_Set_HwReg_GOffset_V(pCsc,  K[1][3]);
-          XV_csc_Set_HwReg_BOffset_V(pCsc,  K[2][3]);
-          XV_csc_Set_HwReg_ClampMin_V(pCsc, clampMin);
-          XV_csc_Set_HwReg_ClipMax_V(pCsc,  clipMax);
-        }
+        fwBase = CSC_FW_REG_K11_2;
+        bank   = (XV_CscIsDemoWindowEnabled(CscPtr) ? 1 : 0);
         break;
 
     default:
-        break;
+        return;
+  }
+
+  hwBase = (bank ? XV_CSC_CTRL_ADDR_HWREG_K11_2_DATA :
+                   XV_CSC_CTRL_ADDR_HWREG_K11_DATA);
+
+  for(i=0; i<XV_CSC_COEFF_NUM_REGS; ++i)
+  {
+    val = (u32)cscFw_RegR(CscPtr, fwBase+i);
+    if((CscPtr->HwCoeffValid & (1 << bank)) &&
+       (CscPtr->HwCoeff[bank][i] == val)) {
+      continue;
+    }
+    XV_csc_WriteReg(pCsc->Config.BaseAddress, hwBase+(i*8), val);
+    CscPtr->HwCoeff[bank][i] = val;
+  }
+  CscPtr->HwCoeffValid |= (u8)(1 << bank);
+}
+
+/*****************************************************************************/
+/**
+* This function selects when the coefficients computed by the layer 2 API are
+* written to the core. When deferred, they are only written by
+* XV_CscCommitUpdate(), so that a frame never starts with a partly written
+* coefficient set.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  Enable is TRUE to defer the updates, FALSE to write them
+*         immediately. The pending updates are written when disabled.
+*
+* @return None
+*
+******************************************************************************/
+void XV_CscSetDeferredUpdate(XV_Csc_l2 *InstancePtr, u8 Enable)
+{
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  if(!Enable) {
+    XV_CscCommitUpdate(InstancePtr);
+  }
+  InstancePtr->DeferUpdate = (Enable ? TRUE : FALSE);
+}
+
+/*****************************************************************************/
+/**
+* This function writes the pending coefficient updates to the core. It is to
+* be called during the vertical blanking, for instance from the frame done
+* interrupt, as the core latches its registers when it starts a frame.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+*
+* @return None
+*
+******************************************************************************/
+void XV_CscCommitUpdate(XV_Csc_l2 *InstancePtr)
+{
+  u8 pending;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  pending = InstancePtr->UpdatePending;
+  InstancePtr->UpdatePending = 0;
+
+  /* Full frame first, the demo window set wins when it has no own bank */
+  if(pending & (1 << UPDT_REG_FULL_FRAME)) {
+    cscWriteIPReg(InstancePtr, UPDT_REG_FULL_FRAME);
+  }
+  if(pending & (1 << UPD_REG_DEMO_WIN)) {
+    cscWriteIPReg(InstancePtr, UPD_REG_DEMO_WIN);
   }
 }
 
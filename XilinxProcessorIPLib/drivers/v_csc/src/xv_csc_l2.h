@@ -52,6 +52,17 @@
 *	- Set/Get Input/Output Color Format (RGB, YUV444, YUV422)
 *	- All settings are translated between user range (0-100) and IP supported
 *	  range
+*	- Deferred coefficient updates, see XV_CscSetDeferredUpdate()
+*
+* <b>Coefficient Updates</b>
+*
+* The core latches its coefficient registers when it starts a frame, which
+* it does immediately after the previous frame in auto restart mode. A
+* coefficient set written while the video runs can be latched half written.
+* With XV_CscSetDeferredUpdate() the Set API's only compute the new
+* coefficients, XV_CscCommitUpdate() writes them at once and is called from
+* the vertical blanking. In both modes the registers which hold the value
+* to write already are skipped.
 *
 * <b>Dependency</b>
 *
@@ -98,6 +109,7 @@
 *                        that were added to the XV_csc_Config structure
 * 2.20  vyc   10/04/17   Macro queries Is420Enabled flag that was added to the
 *                        XV_csc_Config structure
+* 2.30  adk   10/15/19   Added deferred coefficient updates
 * </pre>
 *
 ******************************************************************************/
@@ -154,6 +166,9 @@ typedef enum
    CSC_FW_NUM_REGS
 }XV_CSC_FW_REG_MMAP;
 
+/** Coefficient registers of a bank, K11 to ClipMax */
+#define XV_CSC_COEFF_NUM_REGS   (CSC_FW_REG_K11_2 - CSC_FW_REG_K11)
+
 /**
  * Csc driver Layer 2 data. The user is required to allocate a variable
  * of this type for every mixer device in the system. A pointer to a
@@ -183,6 +198,12 @@ typedef struct
   s32 K_active[3][4];
 
   s32 regMap[CSC_FW_NUM_REGS];
+
+  u8  DeferUpdate;    /**< Coefficients written by XV_CscCommitUpdate() */
+  u8  UpdatePending;  /**< Windows with coefficients to write */
+  u8  HwCoeffValid;   /**< Banks of HwCoeff holding the core values */
+  u32 HwCoeff[2][XV_CSC_COEFF_NUM_REGS]; /**< Coefficients last written, full
+                                            frame and demo window banks */
 }XV_Csc_l2;
 
 /************************** Macros Definitions *******************************/
@@ -408,6 +429,8 @@ void XV_CscSetSaturation(XV_Csc_l2 *InstancePtr, s32 val);
 void XV_CscSetRedGain(XV_Csc_l2 *InstancePtr, s32 val);
 void XV_CscSetGreenGain(XV_Csc_l2 *InstancePtr, s32 val);
 void XV_CscSetBlueGain(XV_Csc_l2 *InstancePtr, s32 val);
+void XV_CscSetDeferredUpdate(XV_Csc_l2 *InstancePtr, u8 Enable);
+void XV_CscCommitUpdate(XV_Csc_l2 *InstancePtr);
 void XV_CscDbgReportStatus(XV_Csc_l2 *InstancePtr);
 
 #ifdef __cplusplus
@@ -94,6 +94,27 @@
 *     will configure the IP to keep processing frames without sw intervention.
 *   - Polling mode is the default configuration set during driver initialization
 *
+* <b> Frame Queue </b>
+*
+* After XVFrmbufRd_QueueInitialize(), the frames to display are queued with
+* XVFrmbufRd_QueueFrame(). On each frame done, the interrupt handler programs
+* the next queued frame and gives the frame that was read back to its owner
+* through the release callback. When no frame is queued, the current frame is
+* repeated. With the XVFRMBUFRD_QUEUE_LATEST policy, only the newest queued
+* frame is displayed and the older ones are dropped.
+*
+* XVFrmbufRd_QueueSink() has the prototype of a frame buffer write sink, so
+* the frames written by a frame buffer write instance are displayed without
+* copy:
+*
+*   XVFrmbufRd_QueueSetReleaseCallback(&FrmbufRd,
+*                                      XVFrmbufWr_QueueReleaseHandler,
+*                                      &FrmbufWr);
+*   XVFrmbufWr_QueueSetSink(&FrmbufWr, XVFrmbufRd_QueueSink, &FrmbufRd);
+*
+* The queue uses the done interrupt only, the ready interrupt must stay
+* disabled. The first frame must be queued before the core is started.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -133,6 +154,8 @@ extern "C" {
 #define XVFRMBUFRD_IRQ_DONE_MASK            (0x01)
 #define XVFRMBUFRD_IRQ_READY_MASK           (0x02)
 
+#define XVFRMBUFRD_QUEUE_DEPTH              (8)
+
 /**************************** Type Definitions *******************************/
 
 /****************** Frame Buffer Read status 4096 - 4100  ********************/
@@ -169,6 +192,67 @@ typedef enum {
 */
 typedef void (*XVFrmbufRd_Callback)(void *CallbackRef);
 
+/**
+* Frame queue policy
+*/
+typedef enum {
+  XVFRMBUFRD_QUEUE_FIFO = 0,    /**< Display every queued frame in order */
+  XVFRMBUFRD_QUEUE_LATEST       /**< Display the newest queued frame */
+} XVFrmbufRd_QueuePolicy;
+
+/**
+* Callback type to give a frame back to its owner once it has been read.
+*
+* @param    CallbackRef is the reference passed to
+*           XVFrmbufRd_QueueSetReleaseCallback().
+* @param    BufferId is the buffer index passed to XVFrmbufRd_QueueFrame().
+*
+* @return   None.
+*
+*/
+typedef void (*XVFrmbufRd_ReleaseCallback)(void *CallbackRef, u32 BufferId);
+
+/**
+* Queued frame
+*/
+typedef struct {
+  u32 BufferId;         /**< Buffer index of the owner */
+  UINTPTR LumaAddr;     /**< Address of the buffer */
+  UINTPTR ChromaAddr;   /**< Address of the UV plane, 0 if not used */
+  u32 FrameNum;         /**< Frame count when the frame was queued */
+} XVFrmbufRd_Frame;
+
+/**
+* Frame queue statistics. Latencies are counted in frames, from the call to
+* XVFrmbufRd_QueueFrame() to the start of the display of the frame.
+*/
+typedef struct {
+  u32 FramesDisplayed;  /**< Queued frames that were displayed */
+  u32 FramesRepeated;   /**< Frame done with no new frame queued */
+  u32 FramesDropped;    /**< Queued frames released without display */
+  u32 FramesRejected;   /**< Frames refused because the queue was full */
+  u32 MaxQueued;        /**< Highest number of frames waiting */
+  u32 LatencyMax;       /**< Highest latency */
+  u64 LatencySum;       /**< Sum of the latencies of the displayed frames */
+} XVFrmbufRd_QueueStats;
+
+/**
+* Frame queue data
+*/
+typedef struct {
+  XVFrmbufRd_Frame Fifo[XVFRMBUFRD_QUEUE_DEPTH]; /**< Queued frames */
+  u32 FifoHead;                  /**< Index of the oldest queued frame */
+  u32 FifoCount;                 /**< Number of queued frames */
+  XVFrmbufRd_Frame Active;       /**< Frame programmed in the core */
+  u32 ActiveValid;               /**< Active holds a queued frame */
+  u32 FrameCount;                /**< Number of frame done interrupts */
+  XVFrmbufRd_QueuePolicy Policy; /**< Frame selection policy */
+  XVFrmbufRd_ReleaseCallback ReleaseCallback; /**< Gives the frames back */
+  void *ReleaseRef;              /**< To be passed to the release callback */
+  XVFrmbufRd_QueueStats Stats;   /**< Statistics */
+  u32 IsEnabled;                 /**< Frame queue in use */
+} XVFrmbufRd_Queue;
+
 /**
  * Frame Buffer Read driver Layer 2 data. The user is required to allocate a
  * variable of this type for every frame buffer read device in the system. A
@@ -188,6 +272,8 @@ typedef struct {
                                 callback */
 
     XVidC_VideoStream Stream;    /**< Output AXIS */
+
+    XVFrmbufRd_Queue Queue;      /**< Frame queue */
 }XV_FrmbufRd_l2;
 
 /************************** Macros Definitions *******************************/
@@ -671,6 +757,25 @@ int XVFrmbufRd_SetCallback(XV_FrmbufRd_l2 *InstancePtr,
 void XVFrmbufRd_InterruptEnable(XV_FrmbufRd_l2 *InstancePtr, u32 IrqMask);
 void XVFrmbufRd_InterruptDisable(XV_FrmbufRd_l2 *InstancePtr, u32 IrqMask);
 
+/* Frame queue related functions */
+void XVFrmbufRd_QueueInitialize(XV_FrmbufRd_l2 *InstancePtr,
+                                XVFrmbufRd_QueuePolicy Policy);
+void XVFrmbufRd_QueueDisable(XV_FrmbufRd_l2 *InstancePtr);
+void XVFrmbufRd_QueueSetReleaseCallback(XV_FrmbufRd_l2 *InstancePtr,
+                                        XVFrmbufRd_ReleaseCallback CallbackFunc,
+                                        void *CallbackRef);
+int XVFrmbufRd_QueueFrame(XV_FrmbufRd_l2 *InstancePtr,
+                          u32 BufferId,
+                          UINTPTR LumaAddr,
+                          UINTPTR ChromaAddr);
+int XVFrmbufRd_QueueSink(void *SinkRef,
+                         u32 BufferId,
+                         UINTPTR LumaAddr,
+                         UINTPTR ChromaAddr);
+void XVFrmbufRd_GetQueueStats(XV_FrmbufRd_l2 *InstancePtr,
+                              XVFrmbufRd_QueueStats *StatsPtr);
+void XVFrmbufRd_ResetQueueStats(XV_FrmbufRd_l2 *InstancePtr);
+
 #ifdef __cplusplus
 }
 #endif
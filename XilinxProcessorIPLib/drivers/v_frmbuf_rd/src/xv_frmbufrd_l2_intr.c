@@ -31,7 +31,8 @@
 * @{
 *
 * The functions in this file provides interrupt handler and associated
-* functions that are consumed by layer-2
+* functions that are consumed by layer-2, and the frame queue that is driven
+* by the frame done interrupt
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -45,8 +46,20 @@
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
+#include <string.h>
 #include "xv_frmbufrd_l2.h"
 
+/************************** Function Prototypes ******************************/
+static u32 XVFrmbufRd_QueueLock(XV_FrmbufRd_l2 *InstancePtr);
+static void XVFrmbufRd_QueueUnlock(XV_FrmbufRd_l2 *InstancePtr, u32 Gie);
+static void XVFrmbufRd_QueuePop(XVFrmbufRd_Queue *QueuePtr,
+                                XVFrmbufRd_Frame *FramePtr);
+static void XVFrmbufRd_QueueRelease(XVFrmbufRd_Queue *QueuePtr,
+                                    const XVFrmbufRd_Frame *FramePtr);
+static void XVFrmbufRd_QueueProgram(XV_FrmbufRd_l2 *InstancePtr,
+                                    const XVFrmbufRd_Frame *FramePtr);
+static void XVFrmbufRd_QueueFrameDone(XV_FrmbufRd_l2 *InstancePtr);
+
 
 /*****************************************************************************/
 /**
@@ -141,6 +154,10 @@ void XVFrmbufRd_InterruptHandler(void *InstancePtr)
   if(Status & XVFRMBUFRD_IRQ_DONE_MASK) {
     /* Clear the interrupt */
     XV_frmbufrd_InterruptClear(&FrmbufRdPtr->FrmbufRd, XVFRMBUFRD_IRQ_DONE_MASK);
+    /* Program the next queued frame and release the one that was read */
+    if(FrmbufRdPtr->Queue.IsEnabled) {
+      XVFrmbufRd_QueueFrameDone(FrmbufRdPtr);
+    }
     //Call user registered callback function, if any
     if(FrmbufRdPtr->FrameDoneCallback) {
           FrmbufRdPtr->FrameDoneCallback(FrmbufRdPtr->CallbackDoneRef);
@@ -159,4 +176,413 @@ void XVFrmbufRd_InterruptHandler(void *InstancePtr)
     XV_frmbufrd_Start(&FrmbufRdPtr->FrmbufRd);
   }
 }
+
+/*****************************************************************************/
+/**
+*
+* This function masks the interrupt of the core, so that the frame queue can
+* be updated outside of the interrupt handler.
+*
+* @param    InstancePtr is a pointer to the core instance.
+*
+* @return   Global interrupt enable setting, to be passed to
+*           XVFrmbufRd_QueueUnlock().
+*
+******************************************************************************/
+static u32 XVFrmbufRd_QueueLock(XV_FrmbufRd_l2 *InstancePtr)
+{
+  u32 Gie;
+
+  Gie = XV_frmbufrd_ReadReg(InstancePtr->FrmbufRd.Config.BaseAddress,
+                            XV_FRMBUFRD_CTRL_ADDR_GIE);
+  XV_frmbufrd_InterruptGlobalDisable(&InstancePtr->FrmbufRd);
+
+  return Gie;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function restores the interrupt setting saved by XVFrmbufRd_QueueLock().
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    Gie is the value returned by XVFrmbufRd_QueueLock().
+*
+* @return   None.
+*
+******************************************************************************/
+static void XVFrmbufRd_QueueUnlock(XV_FrmbufRd_l2 *InstancePtr, u32 Gie)
+{
+  if(Gie & 0x1) {
+    XV_frmbufrd_InterruptGlobalEnable(&InstancePtr->FrmbufRd);
+  }
+}
+
+/*****************************************************************************/
+/**
+*
+* This function takes the oldest frame out of the queue. The queue must not
+* be empty.
+*
+* @param    QueuePtr is a pointer to the frame queue.
+* @param    FramePtr is filled with the frame.
+*
+* @return   None.
+*
+******************************************************************************/
+static void XVFrmbufRd_QueuePop(XVFrmbufRd_Queue *QueuePtr,
+                                XVFrmbufRd_Frame *FramePtr)
+{
+  *FramePtr = QueuePtr->Fifo[QueuePtr->FifoHead];
+  QueuePtr->FifoHead = (QueuePtr->FifoHead + 1) % XVFRMBUFRD_QUEUE_DEPTH;
+  QueuePtr->FifoCount--;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function gives a frame back to its owner.
+*
+* @param    QueuePtr is a pointer to the frame queue.
+* @param    FramePtr is the frame to release.
+*
+* @return   None.
+*
+******************************************************************************/
+static void XVFrmbufRd_QueueRelease(XVFrmbufRd_Queue *QueuePtr,
+                                    const XVFrmbufRd_Frame *FramePtr)
+{
+  if(QueuePtr->ReleaseCallback != NULL) {
+    QueuePtr->ReleaseCallback(QueuePtr->ReleaseRef, FramePtr->BufferId);
+  }
+}
+
+/*****************************************************************************/
+/**
+*
+* This function programs a frame in the core. It is read from the next start
+* of the core.
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    FramePtr is the frame to program.
+*
+* @return   None.
+*
+******************************************************************************/
+static void XVFrmbufRd_QueueProgram(XV_FrmbufRd_l2 *InstancePtr,
+                                    const XVFrmbufRd_Frame *FramePtr)
+{
+  XVFrmbufRd_Queue *QueuePtr = &InstancePtr->Queue;
+  u32 Latency;
+
+  XV_frmbufrd_Set_HwReg_frm_buffer_V(&InstancePtr->FrmbufRd,
+                                     FramePtr->LumaAddr);
+  if(FramePtr->ChromaAddr != 0) {
+    XV_frmbufrd_Set_HwReg_frm_buffer2_V(&InstancePtr->FrmbufRd,
+                                        FramePtr->ChromaAddr);
+  }
+  QueuePtr->Active = *FramePtr;
+  QueuePtr->ActiveValid = TRUE;
+
+  Latency = QueuePtr->FrameCount - FramePtr->FrameNum;
+  QueuePtr->Stats.FramesDisplayed++;
+  QueuePtr->Stats.LatencySum += Latency;
+  if(Latency > QueuePtr->Stats.LatencyMax) {
+    QueuePtr->Stats.LatencyMax = Latency;
+  }
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is called on frame done, before the core is restarted. The
+* next queued frame is programmed and the frame that was read is released.
+* When no frame is queued, the current frame is displayed again.
+*
+* @param    InstancePtr is a pointer to the core instance.
+*
+* @return   None.
+*
+******************************************************************************/
+static void XVFrmbufRd_QueueFrameDone(XV_FrmbufRd_l2 *InstancePtr)
+{
+  XVFrmbufRd_Queue *QueuePtr = &InstancePtr->Queue;
+  XVFrmbufRd_Frame Previous;
+  XVFrmbufRd_Frame Next;
+  u32 PreviousValid;
+
+  QueuePtr->FrameCount++;
+
+  if(QueuePtr->FifoCount == 0) {
+    QueuePtr->Stats.FramesRepeated++;
+    return;
+  }
+
+  /* Skip to the newest frame */
+  if(QueuePtr->Policy == XVFRMBUFRD_QUEUE_LATEST) {
+    while(QueuePtr->FifoCount > 1) {
+      XVFrmbufRd_QueuePop(QueuePtr, &Next);
+      QueuePtr->Stats.FramesDropped++;
+      XVFrmbufRd_QueueRelease(QueuePtr, &Next);
+    }
+  }
+
+  Previous = QueuePtr->Active;
+  PreviousValid = QueuePtr->ActiveValid;
+
+  XVFrmbufRd_QueuePop(QueuePtr, &Next);
+  XVFrmbufRd_QueueProgram(InstancePtr, &Next);
+
+  /* The core is done with the previous frame */
+  if(PreviousValid) {
+    XVFrmbufRd_QueueRelease(QueuePtr, &Previous);
+  }
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets up an empty frame queue. The statistics are cleared and
+* the release callback is removed.
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    Policy selects the frames that are displayed.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufRd_QueueInitialize(XV_FrmbufRd_l2 *InstancePtr,
+                                XVFrmbufRd_QueuePolicy Policy)
+{
+  u32 Gie;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+  Xil_AssertVoid(Policy <= XVFRMBUFRD_QUEUE_LATEST);
+
+  Gie = XVFrmbufRd_QueueLock(InstancePtr);
+  memset(&InstancePtr->Queue, 0, sizeof(XVFrmbufRd_Queue));
+  InstancePtr->Queue.Policy = Policy;
+  InstancePtr->Queue.IsEnabled = TRUE;
+  XVFrmbufRd_QueueUnlock(InstancePtr, Gie);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stops the frame queue and releases all the frames it holds,
+* including the frame programmed in the core. It must be called once the
+* core is stopped.
+*
+* @param    InstancePtr is a pointer to the core instance.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufRd_QueueDisable(XV_FrmbufRd_l2 *InstancePtr)
+{
+  XVFrmbufRd_Queue *QueuePtr;
+  XVFrmbufRd_Frame Frame;
+  u32 Gie;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  QueuePtr = &InstancePtr->Queue;
+  Gie = XVFrmbufRd_QueueLock(InstancePtr);
+
+  QueuePtr->IsEnabled = FALSE;
+  while(QueuePtr->FifoCount > 0) {
+    XVFrmbufRd_QueuePop(QueuePtr, &Frame);
+    QueuePtr->Stats.FramesDropped++;
+    XVFrmbufRd_QueueRelease(QueuePtr, &Frame);
+  }
+  if(QueuePtr->ActiveValid) {
+    QueuePtr->ActiveValid = FALSE;
+    XVFrmbufRd_QueueRelease(QueuePtr, &QueuePtr->Active);
+  }
+
+  XVFrmbufRd_QueueUnlock(InstancePtr, Gie);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function installs the callback that gives the frames back to their
+* owner. It is called from the interrupt handler once a frame has been read,
+* or when a queued frame is dropped.
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    CallbackFunc is the release callback, NULL for none.
+* @param    CallbackRef is passed to the callback.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufRd_QueueSetReleaseCallback(XV_FrmbufRd_l2 *InstancePtr,
+                                        XVFrmbufRd_ReleaseCallback CallbackFunc,
+                                        void *CallbackRef)
+{
+  u32 Gie;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  Gie = XVFrmbufRd_QueueLock(InstancePtr);
+  InstancePtr->Queue.ReleaseCallback = CallbackFunc;
+  InstancePtr->Queue.ReleaseRef = CallbackRef;
+  XVFrmbufRd_QueueUnlock(InstancePtr, Gie);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function queues a frame to display. The first frame is programmed in
+* the core at once. When the queue is full, the oldest queued frame is
+* dropped with the XVFRMBUFRD_QUEUE_LATEST policy, the new frame is refused
+* otherwise.
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    BufferId is the index of the buffer for its owner, passed back
+*           to the release callback.
+* @param    LumaAddr is the address of the buffer.
+* @param    ChromaAddr is the address of the UV plane for semi-planar
+*           formats, 0 otherwise.
+*
+* @return
+*           - XST_SUCCESS if the frame is queued. It is released through the
+*             release callback.
+*           - XVFRMBUFRD_ERR_MEM_ADDR_MISALIGNED if an address is not aligned
+*             to the memory width.
+*           - XST_FAILURE if the queue is disabled or full. The frame still
+*             belongs to the caller.
+*
+******************************************************************************/
+int XVFrmbufRd_QueueFrame(XV_FrmbufRd_l2 *InstancePtr,
+                          u32 BufferId,
+                          UINTPTR LumaAddr,
+                          UINTPTR ChromaAddr)
+{
+  XVFrmbufRd_Queue *QueuePtr;
+  XVFrmbufRd_Frame Frame;
+  XVFrmbufRd_Frame Dropped;
+  UINTPTR Align;
+  u32 Tail;
+  u32 Gie;
+  int Status = XST_SUCCESS;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(LumaAddr != 0);
+
+  /* Check if addr is aligned to aximm width (2*PPC*32-bits (4Bytes)) */
+  Align = 2 * InstancePtr->FrmbufRd.Config.PixPerClk * 4;
+  if(((LumaAddr % Align) != 0) || ((ChromaAddr % Align) != 0)) {
+    return(XVFRMBUFRD_ERR_MEM_ADDR_MISALIGNED);
+  }
+
+  QueuePtr = &InstancePtr->Queue;
+  Gie = XVFrmbufRd_QueueLock(InstancePtr);
+
+  Frame.BufferId = BufferId;
+  Frame.LumaAddr = LumaAddr;
+  Frame.ChromaAddr = ChromaAddr;
+  Frame.FrameNum = QueuePtr->FrameCount;
+
+  if(!QueuePtr->IsEnabled) {
+    Status = XST_FAILURE;
+  } else if(!QueuePtr->ActiveValid) {
+    XVFrmbufRd_QueueProgram(InstancePtr, &Frame);
+  } else {
+    if(QueuePtr->FifoCount == XVFRMBUFRD_QUEUE_DEPTH) {
+      if(QueuePtr->Policy == XVFRMBUFRD_QUEUE_LATEST) {
+        XVFrmbufRd_QueuePop(QueuePtr, &Dropped);
+        QueuePtr->Stats.FramesDropped++;
+        XVFrmbufRd_QueueRelease(QueuePtr, &Dropped);
+      } else {
+        QueuePtr->Stats.FramesRejected++;
+        Status = XST_FAILURE;
+      }
+    }
+    if(Status == XST_SUCCESS) {
+      Tail = (QueuePtr->FifoHead + QueuePtr->FifoCount) %
+             XVFRMBUFRD_QUEUE_DEPTH;
+      QueuePtr->Fifo[Tail] = Frame;
+      QueuePtr->FifoCount++;
+      if(QueuePtr->FifoCount > QueuePtr->Stats.MaxQueued) {
+        QueuePtr->Stats.MaxQueued = QueuePtr->FifoCount;
+      }
+    }
+  }
+
+  XVFrmbufRd_QueueUnlock(InstancePtr, Gie);
+
+  return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function queues a frame, with the arguments of a frame buffer write
+* sink. It is meant to be installed with XVFrmbufWr_QueueSetSink().
+*
+* @param    SinkRef is a pointer to the frame buffer read instance.
+* @param    BufferId is the index of the buffer for its owner.
+* @param    LumaAddr is the address of the buffer.
+* @param    ChromaAddr is the address of the UV plane, 0 if not used.
+*
+* @return   See XVFrmbufRd_QueueFrame().
+*
+******************************************************************************/
+int XVFrmbufRd_QueueSink(void *SinkRef,
+                         u32 BufferId,
+                         UINTPTR LumaAddr,
+                         UINTPTR ChromaAddr)
+{
+  Xil_AssertNonvoid(SinkRef != NULL);
+
+  return XVFrmbufRd_QueueFrame((XV_FrmbufRd_l2 *)SinkRef, BufferId,
+                               LumaAddr, ChromaAddr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads the frame queue statistics.
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    StatsPtr is filled with the statistics.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufRd_GetQueueStats(XV_FrmbufRd_l2 *InstancePtr,
+                              XVFrmbufRd_QueueStats *StatsPtr)
+{
+  u32 Gie;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+  Xil_AssertVoid(StatsPtr != NULL);
+
+  Gie = XVFrmbufRd_QueueLock(InstancePtr);
+  *StatsPtr = InstancePtr->Queue.Stats;
+  XVFrmbufRd_QueueUnlock(InstancePtr, Gie);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function clears the frame queue statistics.
+*
+* @param    InstancePtr is a pointer to the core instance.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufRd_ResetQueueStats(XV_FrmbufRd_l2 *InstancePtr)
+{
+  u32 Gie;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  Gie = XVFrmbufRd_QueueLock(InstancePtr);
+  memset(&InstancePtr->Queue.Stats, 0, sizeof(XVFrmbufRd_QueueStats));
+  XVFrmbufRd_QueueUnlock(InstancePtr, Gie);
+}
 /** @} */
@@ -94,6 +94,26 @@
 *     will configure the IP to keep processing frames without sw intervention.
 *   - Polling mode is the default configuration set during driver initialization
 *
+* <b> Frame Queue </b>
+*
+* Instead of programming one buffer address, the application can hand a pool
+* of up to XVFRMBUFWR_QUEUE_MAX_BUFFERS buffers to XVFrmbufWr_QueueInitialize().
+* The interrupt handler then programs the next free buffer on each frame done
+* and queues the written frame. XVFrmbufWr_DequeueFrame() takes the oldest
+* written frame and XVFrmbufWr_ReleaseFrame() gives it back to the pool. When
+* no buffer is free, the policy selects whether the oldest queued frame is
+* overwritten (XVFRMBUFWR_QUEUE_DROP_OLDEST) or the new frame is written again
+* into the same buffer (XVFRMBUFWR_QUEUE_DROP_NEWEST).
+*
+* With XVFrmbufWr_QueueSetSink() the written frames are passed to a consumer,
+* for instance a frame buffer read instance through XVFrmbufRd_QueueSink(),
+* without going through the application. The consumer gives the buffers back
+* with XVFrmbufWr_QueueReleaseHandler().
+*
+* The queue uses the done interrupt only, the ready interrupt must stay
+* disabled. The core does not snoop the caches: a processor that reads a
+* dequeued frame must invalidate it first.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -133,6 +153,8 @@ extern "C" {
 #define XVFRMBUFWR_IRQ_DONE_MASK            (0x01)
 #define XVFRMBUFWR_IRQ_READY_MASK           (0x02)
 
+#define XVFRMBUFWR_QUEUE_MAX_BUFFERS        (8)
+
 /**************************** Type Definitions *******************************/
 
 /****************** Frame Buffer Write status 4096 - 4100  *******************/
@@ -169,6 +191,85 @@ typedef enum {
 */
 typedef void (*XVFrmbufWr_Callback)(void *CallbackRef);
 
+/**
+* Frame queue policy, used when the core completes a frame and no buffer of
+* the pool is free.
+*/
+typedef enum {
+  XVFRMBUFWR_QUEUE_DROP_OLDEST = 0, /**< Overwrite the oldest queued frame */
+  XVFRMBUFWR_QUEUE_DROP_NEWEST      /**< Write again into the same buffer */
+} XVFrmbufWr_QueuePolicy;
+
+/**
+* Owner of a buffer of the frame queue.
+*/
+typedef enum {
+  XVFRMBUFWR_BUFFER_FREE = 0,   /**< In the pool, can be written */
+  XVFRMBUFWR_BUFFER_WRITING,    /**< Programmed in the core */
+  XVFRMBUFWR_BUFFER_QUEUED,     /**< Written, waiting to be dequeued */
+  XVFRMBUFWR_BUFFER_USER        /**< Dequeued, owned by the consumer */
+} XVFrmbufWr_BufferState;
+
+/**
+* Written frame, as returned by XVFrmbufWr_DequeueFrame().
+*/
+typedef struct {
+  u32 BufferId;         /**< Index of the buffer in the pool */
+  UINTPTR LumaAddr;     /**< Address of the buffer */
+  UINTPTR ChromaAddr;   /**< Address of the UV plane, 0 if not used */
+  u32 FrameNum;         /**< Frame count when the frame was written */
+} XVFrmbufWr_Frame;
+
+/**
+* Consumer of the written frames, see XVFrmbufWr_QueueSetSink().
+*
+* @param    SinkRef is the reference passed to XVFrmbufWr_QueueSetSink().
+* @param    BufferId is the index of the buffer in the pool.
+* @param    LumaAddr is the address of the buffer.
+* @param    ChromaAddr is the address of the UV plane, 0 if not used.
+*
+* @return   XST_SUCCESS if the consumer took the buffer. On failure the
+*           frame is dropped and the buffer goes back to the pool.
+*
+*/
+typedef int (*XVFrmbufWr_QueueSink)(void *SinkRef, u32 BufferId,
+                                    UINTPTR LumaAddr, UINTPTR ChromaAddr);
+
+/**
+* Frame queue statistics. Latencies are counted in frames, from the frame
+* done interrupt of a frame to the release of its buffer.
+*/
+typedef struct {
+  u32 FramesWritten;    /**< Frames queued or passed to the sink */
+  u32 FramesDropped;    /**< Frames overwritten or refused by the sink */
+  u32 FramesReleased;   /**< Buffers given back to the pool */
+  u32 MaxQueued;        /**< Highest number of frames waiting */
+  u32 LatencyMax;       /**< Highest latency */
+  u64 LatencySum;       /**< Sum of the latencies of the released frames */
+} XVFrmbufWr_QueueStats;
+
+/**
+* Frame queue data
+*/
+typedef struct {
+  UINTPTR LumaAddr[XVFRMBUFWR_QUEUE_MAX_BUFFERS];   /**< Buffer addresses */
+  UINTPTR ChromaAddr[XVFRMBUFWR_QUEUE_MAX_BUFFERS]; /**< UV plane addresses */
+  u32 FrameNum[XVFRMBUFWR_QUEUE_MAX_BUFFERS];       /**< Frame count of the
+                                                         written frames */
+  u8 State[XVFRMBUFWR_QUEUE_MAX_BUFFERS];           /**< Buffer owners */
+  u8 Fifo[XVFRMBUFWR_QUEUE_MAX_BUFFERS];  /**< Queued buffers, oldest first */
+  u32 FifoHead;                  /**< Index of the oldest queued buffer */
+  u32 FifoCount;                 /**< Number of queued buffers */
+  u32 NumBuffers;                /**< Number of buffers in the pool */
+  u32 Active;                    /**< Buffer programmed in the core */
+  u32 FrameCount;                /**< Number of frame done interrupts */
+  XVFrmbufWr_QueuePolicy Policy; /**< Policy when no buffer is free */
+  XVFrmbufWr_QueueSink SinkFunc; /**< Consumer of the written frames */
+  void *SinkRef;                 /**< To be passed to the consumer */
+  XVFrmbufWr_QueueStats Stats;   /**< Statistics */
+  u32 IsEnabled;                 /**< Frame queue in use */
+} XVFrmbufWr_Queue;
+
 /**
  * Frame Buffer Write driver Layer 2 data. The user is required to allocate a
  * variable of this type for every frame buffer write device in the system. A
@@ -188,6 +289,8 @@ typedef struct {
                                 callback */
 
     XVidC_VideoStream Stream;    /**< Input AXIS */
+
+    XVFrmbufWr_Queue Queue;      /**< Frame queue */
 }XV_FrmbufWr_l2;
 
 /************************** Macros Definitions *******************************/
@@ -624,6 +727,24 @@ int XVFrmbufWr_SetCallback(XV_FrmbufWr_l2 *InstancePtr,
 void XVFrmbufWr_InterruptEnable(XV_FrmbufWr_l2 *InstancePtr, u32 IrqMask);
 void XVFrmbufWr_InterruptDisable(XV_FrmbufWr_l2 *InstancePtr, u32 IrqMask);
 
+/* Frame queue related functions */
+int XVFrmbufWr_QueueInitialize(XV_FrmbufWr_l2 *InstancePtr,
+                               const UINTPTR *LumaAddr,
+                               const UINTPTR *ChromaAddr,
+                               u32 NumBuffers,
+                               XVFrmbufWr_QueuePolicy Policy);
+void XVFrmbufWr_QueueDisable(XV_FrmbufWr_l2 *InstancePtr);
+void XVFrmbufWr_QueueSetSink(XV_FrmbufWr_l2 *InstancePtr,
+                             XVFrmbufWr_QueueSink SinkFunc,
+                             void *SinkRef);
+int XVFrmbufWr_DequeueFrame(XV_FrmbufWr_l2 *InstancePtr,
+                            XVFrmbufWr_Frame *FramePtr);
+int XVFrmbufWr_ReleaseFrame(XV_FrmbufWr_l2 *InstancePtr, u32 BufferId);
+void XVFrmbufWr_QueueReleaseHandler(void *CallbackRef, u32 BufferId);
+void XVFrmbufWr_GetQueueStats(XV_FrmbufWr_l2 *InstancePtr,
+                              XVFrmbufWr_QueueStats *StatsPtr);
+void XVFrmbufWr_ResetQueueStats(XV_FrmbufWr_l2 *InstancePtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,7 +31,8 @@
 * @{
 *
 * The functions in this file provides interrupt handler and associated
-* functions that are consumed by layer-2
+* functions that are consumed by layer-2, and the frame queue that is driven
+* by the frame done interrupt
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -45,8 +46,17 @@
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
+#include <string.h>
 #include "xv_frmbufwr_l2.h"
 
+/************************** Constant Definitions *****************************/
+#define XVFRMBUFWR_QUEUE_NO_BUFFER          (0xFFFFFFFFu)
+
+/************************** Function Prototypes ******************************/
+static u32 XVFrmbufWr_QueueLock(XV_FrmbufWr_l2 *InstancePtr);
+static void XVFrmbufWr_QueueUnlock(XV_FrmbufWr_l2 *InstancePtr, u32 Gie);
+static u32 XVFrmbufWr_QueueGetFree(const XVFrmbufWr_Queue *QueuePtr);
+static void XVFrmbufWr_QueueFrameDone(XV_FrmbufWr_l2 *InstancePtr);
 
 /*****************************************************************************/
 /**
@@ -142,6 +152,10 @@ void XVFrmbufWr_InterruptHandler(void *InstancePtr)
   if(Status & XVFRMBUFWR_IRQ_DONE_MASK) {
     /* Clear the interrupt */
     XV_frmbufwr_InterruptClear(&FrmbufWrPtr->FrmbufWr, XVFRMBUFWR_IRQ_DONE_MASK);
+    /* Queue the written frame and program the next buffer */
+    if(FrmbufWrPtr->Queue.IsEnabled) {
+      XVFrmbufWr_QueueFrameDone(FrmbufWrPtr);
+    }
     //Call user registered callback function, if any
     if(FrmbufWrPtr->FrameDoneCallback) {
           FrmbufWrPtr->FrameDoneCallback(FrmbufWrPtr->CallbackDoneRef);
@@ -160,4 +174,438 @@ void XVFrmbufWr_InterruptHandler(void *InstancePtr)
     XV_frmbufwr_Start(&FrmbufWrPtr->FrmbufWr);
   }
 }
+
+/*****************************************************************************/
+/**
+*
+* This function masks the interrupt of the core, so that the frame queue can
+* be updated outside of the interrupt handler.
+*
+* @param    InstancePtr is a pointer to the core instance.
+*
+* @return   Global interrupt enable setting, to be passed to
+*           XVFrmbufWr_QueueUnlock().
+*
+******************************************************************************/
+static u32 XVFrmbufWr_QueueLock(XV_FrmbufWr_l2 *InstancePtr)
+{
+  u32 Gie;
+
+  Gie = XV_frmbufwr_ReadReg(InstancePtr->FrmbufWr.Config.BaseAddress,
+                            XV_FRMBUFWR_CTRL_ADDR_GIE);
+  XV_frmbufwr_InterruptGlobalDisable(&InstancePtr->FrmbufWr);
+
+  return Gie;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function restores the interrupt setting saved by XVFrmbufWr_QueueLock().
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    Gie is the value returned by XVFrmbufWr_QueueLock().
+*
+* @return   None.
+*
+******************************************************************************/
+static void XVFrmbufWr_QueueUnlock(XV_FrmbufWr_l2 *InstancePtr, u32 Gie)
+{
+  if(Gie & 0x1) {
+    XV_frmbufwr_InterruptGlobalEnable(&InstancePtr->FrmbufWr);
+  }
+}
+
+/*****************************************************************************/
+/**
+*
+* This function looks for a free buffer in the pool.
+*
+* @param    QueuePtr is a pointer to the frame queue.
+*
+* @return   Index of the buffer, XVFRMBUFWR_QUEUE_NO_BUFFER if none is free.
+*
+******************************************************************************/
+static u32 XVFrmbufWr_QueueGetFree(const XVFrmbufWr_Queue *QueuePtr)
+{
+  u32 Index;
+
+  for(Index = 0; Index < QueuePtr->NumBuffers; Index++) {
+    if(QueuePtr->State[Index] == XVFRMBUFWR_BUFFER_FREE) {
+      return Index;
+    }
+  }
+
+  return XVFRMBUFWR_QUEUE_NO_BUFFER;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is called on frame done, before the core is restarted. The
+* buffer of the next frame is programmed in the core, then the written frame
+* is queued or passed to the sink.
+*
+* When no buffer is free, the oldest queued frame is overwritten with the
+* XVFRMBUFWR_QUEUE_DROP_OLDEST policy. Otherwise, or when no frame is queued,
+* the written frame is dropped and its buffer is written again.
+*
+* @param    InstancePtr is a pointer to the core instance.
+*
+* @return   None.
+*
+******************************************************************************/
+static void XVFrmbufWr_QueueFrameDone(XV_FrmbufWr_l2 *InstancePtr)
+{
+  XVFrmbufWr_Queue *QueuePtr = &InstancePtr->Queue;
+  u32 Written = QueuePtr->Active;
+  u32 Next;
+  u32 Tail;
+  int Status;
+
+  QueuePtr->FrameCount++;
+
+  /* Select the buffer of the next frame */
+  Next = XVFrmbufWr_QueueGetFree(QueuePtr);
+  if((Next == XVFRMBUFWR_QUEUE_NO_BUFFER) &&
+     (QueuePtr->Policy == XVFRMBUFWR_QUEUE_DROP_OLDEST) &&
+     (QueuePtr->FifoCount > 0)) {
+    Next = QueuePtr->Fifo[QueuePtr->FifoHead];
+    QueuePtr->FifoHead = (QueuePtr->FifoHead + 1) %
+                         XVFRMBUFWR_QUEUE_MAX_BUFFERS;
+    QueuePtr->FifoCount--;
+    QueuePtr->Stats.FramesDropped++;
+  }
+
+  if(Next == XVFRMBUFWR_QUEUE_NO_BUFFER) {
+    /* Keep the buffer programmed, the next frame overwrites this one */
+    QueuePtr->Stats.FramesDropped++;
+    return;
+  }
+
+  QueuePtr->State[Next] = XVFRMBUFWR_BUFFER_WRITING;
+  QueuePtr->Active = Next;
+  XV_frmbufwr_Set_HwReg_frm_buffer_V(&InstancePtr->FrmbufWr,
+                                     QueuePtr->LumaAddr[Next]);
+  if(QueuePtr->ChromaAddr[Next] != 0) {
+    XV_frmbufwr_Set_HwReg_frm_buffer2_V(&InstancePtr->FrmbufWr,
+                                        QueuePtr->ChromaAddr[Next]);
+  }
+
+  /* Hand over the written frame */
+  QueuePtr->FrameNum[Written] = QueuePtr->FrameCount;
+  if(QueuePtr->SinkFunc != NULL) {
+    /* The sink may release the buffer before it returns */
+    QueuePtr->State[Written] = XVFRMBUFWR_BUFFER_USER;
+    Status = QueuePtr->SinkFunc(QueuePtr->SinkRef, Written,
+                                QueuePtr->LumaAddr[Written],
+                                QueuePtr->ChromaAddr[Written]);
+    if(Status != XST_SUCCESS) {
+      if(QueuePtr->State[Written] == XVFRMBUFWR_BUFFER_USER) {
+        QueuePtr->State[Written] = XVFRMBUFWR_BUFFER_FREE;
+      }
+      QueuePtr->Stats.FramesDropped++;
+      return;
+    }
+  } else {
+    QueuePtr->State[Written] = XVFRMBUFWR_BUFFER_QUEUED;
+    Tail = (QueuePtr->FifoHead + QueuePtr->FifoCount) %
+           XVFRMBUFWR_QUEUE_MAX_BUFFERS;
+    QueuePtr->Fifo[Tail] = (u8)Written;
+    QueuePtr->FifoCount++;
+    if(QueuePtr->FifoCount > QueuePtr->Stats.MaxQueued) {
+      QueuePtr->Stats.MaxQueued = QueuePtr->FifoCount;
+    }
+  }
+  QueuePtr->Stats.FramesWritten++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets up the frame queue with a pool of buffers and programs
+* the first buffer in the core. The statistics are cleared and the sink is
+* disconnected.
+*
+* The queue must be set up before the core is started with the done interrupt
+* enabled. The buffers must be large enough for the memory format set with
+* XVFrmbufWr_SetMemFormat().
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    LumaAddr is an array of NumBuffers buffer addresses.
+* @param    ChromaAddr is an array of NumBuffers UV plane addresses for
+*           semi-planar formats, NULL otherwise.
+* @param    NumBuffers is the number of buffers, from 2 to
+*           XVFRMBUFWR_QUEUE_MAX_BUFFERS.
+* @param    Policy selects the frame dropped when no buffer is free.
+*
+* @return
+*           - XST_SUCCESS if the queue is set up.
+*           - XVFRMBUFWR_ERR_MEM_ADDR_MISALIGNED if an address is not
+*             aligned to the memory width.
+*
+******************************************************************************/
+int XVFrmbufWr_QueueInitialize(XV_FrmbufWr_l2 *InstancePtr,
+                               const UINTPTR *LumaAddr,
+                               const UINTPTR *ChromaAddr,
+                               u32 NumBuffers,
+                               XVFrmbufWr_QueuePolicy Policy)
+{
+  XVFrmbufWr_Queue *QueuePtr;
+  UINTPTR Align;
+  u32 Index;
+  u32 Gie;
+
+  /* Verify arguments */
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(LumaAddr != NULL);
+  Xil_AssertNonvoid((NumBuffers >= 2) &&
+                    (NumBuffers <= XVFRMBUFWR_QUEUE_MAX_BUFFERS));
+  Xil_AssertNonvoid(Policy <= XVFRMBUFWR_QUEUE_DROP_NEWEST);
+
+  /* Check if addr is aligned to aximm width (2*PPC*32-bits (4Bytes)) */
+  Align = 2 * InstancePtr->FrmbufWr.Config.PixPerClk * 4;
+  for(Index = 0; Index < NumBuffers; Index++) {
+    if((LumaAddr[Index] == 0) || ((LumaAddr[Index] % Align) != 0)) {
+      return(XVFRMBUFWR_ERR_MEM_ADDR_MISALIGNED);
+    }
+    if((ChromaAddr != NULL) && ((ChromaAddr[Index] % Align) != 0)) {
+      return(XVFRMBUFWR_ERR_MEM_ADDR_MISALIGNED);
+    }
+  }
+
+  Gie = XVFrmbufWr_QueueLock(InstancePtr);
+
+  QueuePtr = &InstancePtr->Queue;
+  memset(QueuePtr, 0, sizeof(XVFrmbufWr_Queue));
+  for(Index = 0; Index < NumBuffers; Index++) {
+    QueuePtr->LumaAddr[Index] = LumaAddr[Index];
+    if(ChromaAddr != NULL) {
+      QueuePtr->ChromaAddr[Index] = ChromaAddr[Index];
+    }
+  }
+  QueuePtr->NumBuffers = NumBuffers;
+  QueuePtr->Policy = Policy;
+
+  /* The first frame is written to buffer 0 */
+  QueuePtr->Active = 0;
+  QueuePtr->State[0] = XVFRMBUFWR_BUFFER_WRITING;
+  XV_frmbufwr_Set_HwReg_frm_buffer_V(&InstancePtr->FrmbufWr,
+                                     QueuePtr->LumaAddr[0]);
+  if(QueuePtr->ChromaAddr[0] != 0) {
+    XV_frmbufwr_Set_HwReg_frm_buffer2_V(&InstancePtr->FrmbufWr,
+                                        QueuePtr->ChromaAddr[0]);
+  }
+  QueuePtr->IsEnabled = TRUE;
+
+  XVFrmbufWr_QueueUnlock(InstancePtr, Gie);
+
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stops the frame queue. The interrupt handler no longer
+* changes the buffer address. Frames that are queued can still be dequeued.
+*
+* @param    InstancePtr is a pointer to the core instance.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufWr_QueueDisable(XV_FrmbufWr_l2 *InstancePtr)
+{
+  u32 Gie;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  Gie = XVFrmbufWr_QueueLock(InstancePtr);
+  InstancePtr->Queue.IsEnabled = FALSE;
+  XVFrmbufWr_QueueUnlock(InstancePtr, Gie);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function connects a consumer to the frame queue. The written frames are
+* passed to the consumer from the interrupt handler instead of being queued.
+* The consumer gives each buffer back with XVFrmbufWr_ReleaseFrame() or
+* XVFrmbufWr_QueueReleaseHandler().
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    SinkFunc is the consumer, NULL to queue the written frames.
+* @param    SinkRef is passed to the consumer.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufWr_QueueSetSink(XV_FrmbufWr_l2 *InstancePtr,
+                             XVFrmbufWr_QueueSink SinkFunc,
+                             void *SinkRef)
+{
+  u32 Gie;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  Gie = XVFrmbufWr_QueueLock(InstancePtr);
+  InstancePtr->Queue.SinkFunc = SinkFunc;
+  InstancePtr->Queue.SinkRef = SinkRef;
+  XVFrmbufWr_QueueUnlock(InstancePtr, Gie);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function takes the oldest written frame out of the queue. The buffer
+* belongs to the caller until it is released with XVFrmbufWr_ReleaseFrame().
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    FramePtr is filled with the buffer of the frame.
+*
+* @return
+*           - XST_SUCCESS if a frame was dequeued.
+*           - XST_NO_DATA if no frame is queued.
+*
+******************************************************************************/
+int XVFrmbufWr_DequeueFrame(XV_FrmbufWr_l2 *InstancePtr,
+                            XVFrmbufWr_Frame *FramePtr)
+{
+  XVFrmbufWr_Queue *QueuePtr;
+  u32 BufferId;
+  u32 Gie;
+  int Status = XST_NO_DATA;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(FramePtr != NULL);
+
+  QueuePtr = &InstancePtr->Queue;
+  Gie = XVFrmbufWr_QueueLock(InstancePtr);
+
+  if(QueuePtr->FifoCount > 0) {
+    BufferId = QueuePtr->Fifo[QueuePtr->FifoHead];
+    QueuePtr->FifoHead = (QueuePtr->FifoHead + 1) %
+                         XVFRMBUFWR_QUEUE_MAX_BUFFERS;
+    QueuePtr->FifoCount--;
+    QueuePtr->State[BufferId] = XVFRMBUFWR_BUFFER_USER;
+
+    FramePtr->BufferId = BufferId;
+    FramePtr->LumaAddr = QueuePtr->LumaAddr[BufferId];
+    FramePtr->ChromaAddr = QueuePtr->ChromaAddr[BufferId];
+    FramePtr->FrameNum = QueuePtr->FrameNum[BufferId];
+    Status = XST_SUCCESS;
+  }
+
+  XVFrmbufWr_QueueUnlock(InstancePtr, Gie);
+
+  return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function gives a dequeued buffer back to the pool.
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    BufferId is the index of the buffer.
+*
+* @return
+*           - XST_SUCCESS if the buffer was released.
+*           - XST_INVALID_PARAM if the buffer is not owned by the consumer.
+*
+******************************************************************************/
+int XVFrmbufWr_ReleaseFrame(XV_FrmbufWr_l2 *InstancePtr, u32 BufferId)
+{
+  XVFrmbufWr_Queue *QueuePtr;
+  u32 Latency;
+  u32 Gie;
+  int Status = XST_INVALID_PARAM;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+
+  QueuePtr = &InstancePtr->Queue;
+  Gie = XVFrmbufWr_QueueLock(InstancePtr);
+
+  if((BufferId < QueuePtr->NumBuffers) &&
+     (QueuePtr->State[BufferId] == XVFRMBUFWR_BUFFER_USER)) {
+    QueuePtr->State[BufferId] = XVFRMBUFWR_BUFFER_FREE;
+
+    Latency = QueuePtr->FrameCount - QueuePtr->FrameNum[BufferId];
+    QueuePtr->Stats.FramesReleased++;
+    QueuePtr->Stats.LatencySum += Latency;
+    if(Latency > QueuePtr->Stats.LatencyMax) {
+      QueuePtr->Stats.LatencyMax = Latency;
+    }
+    Status = XST_SUCCESS;
+  }
+
+  XVFrmbufWr_QueueUnlock(InstancePtr, Gie);
+
+  return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function releases a buffer, with the arguments of a consumer callback.
+* It is meant to be installed as release callback of the consumer, for
+* instance with XVFrmbufRd_QueueSetReleaseCallback().
+*
+* @param    CallbackRef is a pointer to the frame buffer write instance.
+* @param    BufferId is the index of the buffer.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufWr_QueueReleaseHandler(void *CallbackRef, u32 BufferId)
+{
+  Xil_AssertVoid(CallbackRef != NULL);
+
+  (void)XVFrmbufWr_ReleaseFrame((XV_FrmbufWr_l2 *)CallbackRef, BufferId);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads the frame queue statistics.
+*
+* @param    InstancePtr is a pointer to the core instance.
+* @param    StatsPtr is filled with the statistics.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufWr_GetQueueStats(XV_FrmbufWr_l2 *InstancePtr,
+                              XVFrmbufWr_QueueStats *StatsPtr)
+{
+  u32 Gie;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+  Xil_AssertVoid(StatsPtr != NULL);
+
+  Gie = XVFrmbufWr_QueueLock(InstancePtr);
+  *StatsPtr = InstancePtr->Queue.Stats;
+  XVFrmbufWr_QueueUnlock(InstancePtr, Gie);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function clears the frame queue statistics.
+*
+* @param    InstancePtr is a pointer to the core instance.
+*
+* @return   None.
+*
+******************************************************************************/
+void XVFrmbufWr_ResetQueueStats(XV_FrmbufWr_l2 *InstancePtr)
+{
+  u32 Gie;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  Gie = XVFrmbufWr_QueueLock(InstancePtr);
+  memset(&InstancePtr->Queue.Stats, 0, sizeof(XVFrmbufWr_QueueStats));
+  XVFrmbufWr_QueueUnlock(InstancePtr, Gie);
+}
 /** @} */
@@ -0,0 +1,244 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xv_gamma_lut_l2.c
+* @addtogroup v_gamma_lut_v1_0
+* @{
+* @details
+*
+* The gamma lut Layer-2 Driver. The functions in this file stage the look up
+* tables in RAM and write them to the core at once. See xv_gamma_lut_l2.h for
+* a detailed description of the layer-2 driver
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date    Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.0   adk   10/15/19 Initial Release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "xv_gamma_lut_l2.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/**************************** Local Global *******************************/
+/* Base address of the memory of each look up table */
+static const u32 GammaLutBase[XV_GAMMA_LUT_NUM_CHANNELS] =
+{
+  XV_GAMMA_LUT_CTRL_ADDR_HWREG_GAMMA_LUT_0_BASE,
+  XV_GAMMA_LUT_CTRL_ADDR_HWREG_GAMMA_LUT_1_BASE,
+  XV_GAMMA_LUT_CTRL_ADDR_HWREG_GAMMA_LUT_2_BASE
+};
+
+/************************** Function Prototypes ******************************/
+
+/*****************************************************************************/
+/**
+* This function initializes the core instance
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  DeviceId is instance id of the core
+*
+* @return XST_SUCCESS if device is found and initialized
+*         XST_DEVICE_NOT_FOUND if device is not found
+*
+******************************************************************************/
+int XV_GammaLutInitialize(XV_GammaLut_l2 *InstancePtr, u16 DeviceId)
+{
+  int Status;
+  u32 Entries;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+
+  /* Setup the instance */
+  memset(InstancePtr, 0, sizeof(XV_GammaLut_l2));
+  Status = XV_gamma_lut_Initialize(&InstancePtr->GammaLut, DeviceId);
+
+  if(Status == XST_SUCCESS) {
+    Entries = XV_GAMMA_LUT_MAX_ENTRIES;
+    if(InstancePtr->GammaLut.Config.MaxDataWidth < 10) {
+      Entries = (1 << InstancePtr->GammaLut.Config.MaxDataWidth);
+    }
+    InstancePtr->NumWords = Entries/2;
+  }
+  return(Status);
+}
+
+/*****************************************************************************/
+/**
+* This function copies a look up table into the driver. It is written to the
+* core by the next XV_GammaLutCommit().
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  Channel is the look up table, 0 to XV_GAMMA_LUT_NUM_CHANNELS-1
+* @param  Lut holds 2^MaxDataWidth entries
+*
+* @return None
+*
+******************************************************************************/
+void XV_GammaLutStageChannel(XV_GammaLut_l2 *InstancePtr, u32 Channel,
+                             const u16 *Lut)
+{
+  u32 i;
+  u32 *Words;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+  Xil_AssertVoid(InstancePtr->GammaLut.IsReady == XIL_COMPONENT_IS_READY);
+  Xil_AssertVoid(Channel < XV_GAMMA_LUT_NUM_CHANNELS);
+  Xil_AssertVoid(Lut != NULL);
+
+  /* Two entries per word, even entry in the low half */
+  Words = InstancePtr->Staged[Channel];
+  for(i=0; i<InstancePtr->NumWords; ++i) {
+    Words[i] = (u32)Lut[2*i] | ((u32)Lut[2*i+1] << 16);
+  }
+  InstancePtr->Pending |= (u8)(1 << Channel);
+}
+
+/*****************************************************************************/
+/**
+* This function copies the three look up tables into the driver. They are
+* written to the core by the next XV_GammaLutCommit().
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  Lut0 is the table of channel 0, NULL to keep the current table
+* @param  Lut1 is the table of channel 1, NULL to keep the current table
+* @param  Lut2 is the table of channel 2, NULL to keep the current table
+*
+* @return None
+*
+******************************************************************************/
+void XV_GammaLutStage(XV_GammaLut_l2 *InstancePtr, const u16 *Lut0,
+                      const u16 *Lut1, const u16 *Lut2)
+{
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  if(Lut0 != NULL) {
+    XV_GammaLutStageChannel(InstancePtr, 0, Lut0);
+  }
+  if(Lut1 != NULL) {
+    XV_GammaLutStageChannel(InstancePtr, 1, Lut1);
+  }
+  if(Lut2 != NULL) {
+    XV_GammaLutStageChannel(InstancePtr, 2, Lut2);
+  }
+}
+
+/*****************************************************************************/
+/**
+* This function checks if staged tables wait for XV_GammaLutCommit()
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+*
+* @return 1 if a table is pending, else 0
+*
+******************************************************************************/
+u32 XV_GammaLutIsPending(XV_GammaLut_l2 *InstancePtr)
+{
+  Xil_AssertNonvoid(InstancePtr != NULL);
+
+  return (InstancePtr->Pending != 0);
+}
+
+/*****************************************************************************/
+/**
+* This function writes the staged tables to the core. Only the words which
+* differ from the table in the core are written.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+*
+* @return Number of words written
+*
+* @note   To be called during the vertical blanking, e.g. from the frame done
+*         interrupt of the core or of the video timing controller.
+*
+******************************************************************************/
+u32 XV_GammaLutCommit(XV_GammaLut_l2 *InstancePtr)
+{
+  u32 ch, i, Written = 0;
+  u32 *Staged, *Active;
+  UINTPTR Addr;
+  u8 Valid;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->GammaLut.IsReady == XIL_COMPONENT_IS_READY);
+
+  for(ch=0; ch<XV_GAMMA_LUT_NUM_CHANNELS; ++ch) {
+    if(!(InstancePtr->Pending & (1 << ch))) {
+      continue;
+    }
+
+    Staged = InstancePtr->Staged[ch];
+    Active = InstancePtr->Active[ch];
+    Valid  = InstancePtr->ActiveValid & (1 << ch);
+    Addr   = InstancePtr->GammaLut.Config.BaseAddress + GammaLutBase[ch];
+
+    for(i=0; i<InstancePtr->NumWords; ++i) {
+      if(Valid && (Active[i] == Staged[i])) {
+        continue;
+      }
+      XV_gamma_lut_WriteReg(Addr, i*4, Staged[i]);
+      Active[i] = Staged[i];
+      ++Written;
+    }
+    InstancePtr->ActiveValid |= (u8)(1 << ch);
+  }
+  InstancePtr->Pending = 0;
+
+  if(Written) {
+    ++InstancePtr->Commits;
+    InstancePtr->WordsWritten += Written;
+  }
+  return(Written);
+}
+
+/*****************************************************************************/
+/**
+* This function forgets the tables in the core, so that the next commit
+* writes every word. It is needed after the core was reset or its tables
+* were written through the layer 1 API.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+*
+* @return None
+*
+******************************************************************************/
+void XV_GammaLutInvalidate(XV_GammaLut_l2 *InstancePtr)
+{
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  InstancePtr->ActiveValid = 0;
+}
+/** @} */
@@ -0,0 +1,113 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xv_gamma_lut_l2.h
+* @addtogroup v_gamma_lut_v1_0
+* @{
+* @details
+*
+* This header file contains layer 2 API's of the gamma lut core driver.
+*
+* <b>Shadow Tables</b>
+*
+* The core reads its look up tables while the video runs, so rewriting them
+* entry by entry in the middle of a frame shows up on screen. The layer 2
+* driver keeps the tables in RAM instead:
+*	- XV_GammaLutStageChannel() or XV_GammaLutStage() copy new tables into
+*	  the driver, packed in the layout of the core memories.
+*	- XV_GammaLutCommit() writes the staged tables to the core. It is called
+*	  from the vertical blanking, for instance from the frame done
+*	  interrupt, so the next frame sees the new tables only.
+*	- Only the words which differ from the tables already in the core are
+*	  written, so small adjustments such as a tone map update take a few
+*	  register writes rather than a full reload.
+*
+* The control interface is AXI4-Lite, which does not burst, and the core has
+* no table select register. The staging and the difference based commit are
+* what keeps the update short enough for the blanking.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.0   adk   10/15/19   Initial Release
+* </pre>
+*
+******************************************************************************/
+#ifndef XV_GAMMA_LUT_L2_H       /* prevent circular inclusions */
+#define XV_GAMMA_LUT_L2_H       /* by using protection macros  */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "xv_gamma_lut.h"
+
+/************************** Constant Definitions *****************************/
+#define XV_GAMMA_LUT_NUM_CHANNELS   (3)   /**< Look up tables in the core */
+#define XV_GAMMA_LUT_MAX_ENTRIES    (XV_GAMMA_LUT_CTRL_DEPTH_HWREG_GAMMA_LUT_0)
+                                          /**< Entries of a look up table */
+#define XV_GAMMA_LUT_MAX_WORDS      (XV_GAMMA_LUT_MAX_ENTRIES/2)
+                                          /**< Words of a look up table */
+
+/****************************** Type Definitions ******************************/
+/**
+ * Gamma lut driver Layer 2 data. The user is required to allocate a variable
+ * of this type for every gamma lut device in the system. A pointer to a
+ * variable of this type is then passed to the driver API functions.
+ */
+typedef struct
+{
+  XV_gamma_lut GammaLut;  /**< Layer 1 instance */
+  u32 Staged[XV_GAMMA_LUT_NUM_CHANNELS][XV_GAMMA_LUT_MAX_WORDS];
+                          /**< Tables to be written */
+  u32 Active[XV_GAMMA_LUT_NUM_CHANNELS][XV_GAMMA_LUT_MAX_WORDS];
+                          /**< Tables in the core */
+  u32 NumWords;           /**< Words used for the data width of the core */
+  u8  Pending;            /**< Channels staged but not committed */
+  u8  ActiveValid;        /**< Channels whose Active table is known */
+  u32 Commits;            /**< Commits which wrote to the core */
+  u32 WordsWritten;       /**< Table words written to the core */
+}XV_GammaLut_l2;
+
+/************************** Function Prototypes ******************************/
+int XV_GammaLutInitialize(XV_GammaLut_l2 *InstancePtr, u16 DeviceId);
+void XV_GammaLutStageChannel(XV_GammaLut_l2 *InstancePtr, u32 Channel,
+                             const u16 *Lut);
+void XV_GammaLutStage(XV_GammaLut_l2 *InstancePtr, const u16 *Lut0,
+                      const u16 *Lut1, const u16 *Lut2);
+u32 XV_GammaLutIsPending(XV_GammaLut_l2 *InstancePtr);
+u32 XV_GammaLutCommit(XV_GammaLut_l2 *InstancePtr);
+void XV_GammaLutInvalidate(XV_GammaLut_l2 *InstancePtr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
+/** @} */
@@ -66,6 +66,10 @@
 #define XHSC_MASK_LOW_20BITS	   (0x000FFFFF)
 #define XHSC_MASK_LOW_12BITS	   (0x00000FFF)
 
+/* Coefficient table ids beyond the fixed sets */
+#define XHSC_COEFF_SET_EXT         (XV_HSCALER_NUM_COEFF_SETS)
+#define XHSC_COEFF_SET_NONE        (0xFF)
+
 /**************************** Type Definitions *******************************/
 
 /**************************** Local Global *******************************/
@@ -77,10 +81,31 @@ extern const short XV_hscaler_fixedcoeff_taps8[XV_HSCALER_MAX_H_PHASES][XV_HSCAL
 extern const short XV_hscaler_fixedcoeff_taps10[XV_HSCALER_MAX_H_PHASES][XV_HSCALER_TAPS_10];
 extern const short XV_hscaler_fixedcoeff_taps12[XV_HSCALER_MAX_H_PHASES][XV_HSCALER_TAPS_12];
 
+/* Fixed coefficient tables, indexed by coefficient set id */
+static const short *const XV_HScalerFixedCoeff[XV_HSCALER_NUM_COEFF_SETS] = {
+  &XV_hscaler_fixedcoeff_taps6[0][0],
+  &XV_hscaler_fixedcoeff_taps8[0][0],
+  &XV_hscaler_fixedcoeff_taps10[0][0],
+  &XV_hscaler_fixedcoeff_taps12[0][0]
+};
+
+static const u16 XV_HScalerFixedTaps[XV_HSCALER_NUM_COEFF_SETS] = {
+  XV_HSCALER_TAPS_6,
+  XV_HSCALER_TAPS_8,
+  XV_HSCALER_TAPS_10,
+  XV_HSCALER_TAPS_12
+};
+
 /************************** Function Prototypes ******************************/
-static void XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
-                                  u32 WidthIn,
-                                  u32 WidthOut);
+static u8 XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
+                                u32 WidthIn,
+                                u32 WidthOut);
+static void XV_HScalerPadCoeff(XV_Hscaler_l2 *InstancePtr,
+                               u16 num_phases,
+                               u16 num_taps,
+                               const short *Coeff);
+static void XV_HScalerInitCoeffCache(XV_Hscaler_l2 *InstancePtr);
+static void XV_HScalerWriteCoeff(XV_Hscaler_l2 *HscPtr, const u32 *Words);
 static void CalculatePhases(XV_Hscaler_l2 *HscPtr,
                             u32 WidthIn,
                             u32 WidthOut,
@@ -109,6 +134,13 @@ int XV_HScalerInitialize(XV_Hscaler_l2 *InstancePtr, u16 DeviceId)
   memset(InstancePtr, 0, sizeof(XV_Hscaler_l2));
   Status = XV_hscaler_Initialize(&InstancePtr->Hsc, DeviceId);
 
+  InstancePtr->CoeffLoaded = XHSC_COEFF_SET_NONE;
+  if((Status == XST_SUCCESS) &&
+     (InstancePtr->Hsc.Config.ScalerType == XV_HSCALER_POLYPHASE))
+  {
+    XV_HScalerInitCoeffCache(InstancePtr);
+  }
+
   return(Status);
 }
 
@@ -148,31 +180,28 @@ void XV_HScalerStop(XV_Hscaler_l2 *InstancePtr)
 /*****************************************************************************/
 /**
 * This function determines the internal coeffiecient table to be used based on
-* scaling ratio and loads the filter coefficients in the scaler coefficient
-* storage.
+* scaling ratio
 *
 * @param  InstancePtr is a pointer to the core instance to be worked on.
 * @param  WidthIn is the input stream width
 * @param  Widthout is the output stream width
 *
-* @return None
+* @return Id of the fixed coefficient set to use, or XHSC_COEFF_SET_NONE if
+*         the core tap configuration is not supported
 *
 ******************************************************************************/
-static void XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
-                                  u32 WidthIn,
-                                  u32 WidthOut)
+static u8 XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
+                                u32 WidthIn,
+                                u32 WidthOut)
 {
-  const short *coeff;
-  u16 numTaps, numPhases;
+  u8 Set;
   u16 ScalingRatio;
   u16 IsScaleDown;
 
   /*
    * validate input arguments
    */
-  Xil_AssertVoid(InstancePtr != NULL);
-
-  numPhases = (1<<InstancePtr->Hsc.Config.PhaseShift);
+  Xil_AssertNonvoid(InstancePtr != NULL);
 
   IsScaleDown = (WidthOut < WidthIn);
 
@@ -186,66 +215,49 @@ static void XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
     switch(InstancePtr->Hsc.Config.NumTaps)
     {
       case XV_HSCALER_TAPS_6:
-           coeff = &XV_hscaler_fixedcoeff_taps6[0][0];
-           numTaps = XV_HSCALER_TAPS_6;
+           Set = 0;
            break;
 
       case XV_HSCALER_TAPS_8:
            if(ScalingRatio > 15) {//>1.5
-             coeff = &XV_hscaler_fixedcoeff_taps8[0][0];
-             numTaps = XV_HSCALER_TAPS_8;
+             Set = 1;
            } else {//<=1.5
-             coeff = &XV_hscaler_fixedcoeff_taps6[0][0];
-             numTaps = XV_HSCALER_TAPS_6;
+             Set = 0;
            }
            break;
 
       case XV_HSCALER_TAPS_10:
            if(ScalingRatio > 25) {//2.5
-             coeff = &XV_hscaler_fixedcoeff_taps10[0][0];
-             numTaps = XV_HSCALER_TAPS_10;
+             Set = 2;
            } else if(ScalingRatio > 15) {// 1.6 < ratio <= 2.5
-             coeff = &XV_hscaler_fixedcoeff_taps8[0][0];
-             numTaps = XV_HSCALER_TAPS_8;
+             Set = 1;
            } else {// <= 1.5
-             coeff = &XV_hscaler_fixedcoeff_taps6[0][0];
-             numTaps = XV_HSCALER_TAPS_6;
+             Set = 0;
            }
            break;
 
       case XV_HSCALER_TAPS_12:
            if(ScalingRatio > 35) {//> 3.5
-             coeff = &XV_hscaler_fixedcoeff_taps12[0][0];
-             numTaps = XV_HSCALER_TAPS_12;
+             Set = 3;
            } else if(ScalingRatio > 25) {//2.6 < Ratio <= 3.5
-             coeff = &XV_hscaler_fixedcoeff_taps10[0][0];
-             numTaps = XV_HSCALER_TAPS_10;
+             Set = 2;
            } else if(ScalingRatio > 15) {//1.6 < Ratio <= 2.5
-             coeff = &XV_hscaler_fixedcoeff_taps8[0][0];
-             numTaps = XV_HSCALER_TAPS_8;
+             Set = 1;
            } else {// <=1.5
-             coeff = &XV_hscaler_fixedcoeff_taps6[0][0];
-             numTaps = XV_HSCALER_TAPS_6;
+             Set = 0;
            }
            break;
 
       default:
-          return;
+          return(XHSC_COEFF_SET_NONE);
     }
   }
   else //Scale Up
   {
-    coeff = &XV_hscaler_fixedcoeff_taps6[0][0];
-    numTaps = XV_HSCALER_TAPS_6;
+    Set = 0;
   }
 
-  XV_HScalerLoadExtCoeff(InstancePtr,
-                         numPhases,
-                         numTaps,
-                         coeff);
-
-  /* Disable use of external coefficients */
-  InstancePtr->UseExtCoeff = FALSE;
+  return(Set);
 }
 
 /*****************************************************************************/
@@ -266,8 +278,6 @@ void XV_HScalerLoadExtCoeff(XV_Hscaler_l2 *InstancePtr,
                             u16 num_taps,
                             const short *Coeff)
 {
-  int i,j, pad, offset;
-
   /*
    * validate input arguments
    */
@@ -288,11 +298,38 @@ void XV_HScalerLoadExtCoeff(XV_Hscaler_l2 *InstancePtr,
          return;
   }
 
+  XV_HScalerPadCoeff(InstancePtr, num_phases, num_taps, Coeff);
+
+  /* Enable use of external coefficients and force reload */
+  InstancePtr->UseExtCoeff = TRUE;
+  InstancePtr->CoeffLoaded = XHSC_COEFF_SET_NONE;
+}
+
+/*****************************************************************************/
+/**
+* This function copies a coefficient table into the instance coefficient
+* table, centered and zero padded to the max number of taps
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  num_phases is the number of phases in coefficient table
+* @param  num_taps is the number of taps in coefficient table
+* @param  Coeff is a pointer to the coefficients table
+*
+* @return None
+*
+******************************************************************************/
+static void XV_HScalerPadCoeff(XV_Hscaler_l2 *InstancePtr,
+                               u16 num_phases,
+                               u16 num_taps,
+                               const short *Coeff)
+{
+  int i,j, pad, offset;
+
   //determine if coefficient needs padding (effective vs. max taps)
   pad = XV_HSCALER_MAX_H_TAPS - num_taps;
   offset = ((pad) ? (pad>>1) : 0);
 
-  //Load User defined coefficients into scaler coefficient table
+  //Load coefficients into scaler coefficient table
   for (i = 0; i < num_phases; i++)
   {
     for (j=0; j<num_taps; ++j)
@@ -317,9 +354,54 @@ void XV_HScalerLoadExtCoeff(XV_Hscaler_l2 *InstancePtr,
       }
     }
   }
+}
 
-  /* Enable use of external coefficients */
-  InstancePtr->UseExtCoeff = TRUE;
+/*****************************************************************************/
+/**
+* This function packs every fixed coefficient table usable by the core into
+* the register layout of the coefficient storage, so that switching tables
+* at setup is a plain copy of prepared words
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+*
+* @return None
+*
+* @note   The instance coefficient table is used as scratch and left zeroed
+*
+******************************************************************************/
+static void XV_HScalerInitCoeffCache(XV_Hscaler_l2 *InstancePtr)
+{
+  int num_phases = 1<<InstancePtr->Hsc.Config.PhaseShift;
+  int num_taps   = InstancePtr->Hsc.Config.NumTaps/2;
+  int i,j,offset,rdIndx;
+  u32 *Words;
+  u8 Set;
+
+  offset = (XV_HSCALER_MAX_H_TAPS - InstancePtr->Hsc.Config.NumTaps)/2;
+  for(Set = 0; Set < XV_HSCALER_NUM_COEFF_SETS; Set++)
+  {
+    if(XV_HScalerFixedTaps[Set] > InstancePtr->Hsc.Config.NumTaps)
+    {
+      break;
+    }
+
+    XV_HScalerPadCoeff(InstancePtr, num_phases,
+                       XV_HScalerFixedTaps[Set], XV_HScalerFixedCoeff[Set]);
+
+    Words = InstancePtr->CoeffCache[Set];
+    for (i = 0; i < num_phases; i++)
+    {
+      for(j=0; j < num_taps; j++)
+      {
+        rdIndx = j*2+offset;
+        Words[i*num_taps+j] =
+          ((u32)(u16)InstancePtr->coeff[i][rdIndx+1] << 16) |
+          (u16)InstancePtr->coeff[i][rdIndx];
+      }
+    }
+  }
+
+  memset(InstancePtr->coeff, 0, sizeof(InstancePtr->coeff));
 }
 
 /*****************************************************************************/
@@ -575,6 +657,31 @@ static void XV_HScalerSetCoeff(XV_Hscaler_l2 *HscPtr)
   }
 }
 
+/*****************************************************************************/
+/**
+* This function writes a packed table from the coefficient cache into the
+* core coefficient storage
+*
+* @param  HscPtr is a pointer to the core instance to be worked on.
+* @param  Words is a pointer to the packed table
+*
+* @return None
+*
+******************************************************************************/
+static void XV_HScalerWriteCoeff(XV_Hscaler_l2 *HscPtr, const u32 *Words)
+{
+  int num_words = (1<<HscPtr->Hsc.Config.PhaseShift) *
+                  (HscPtr->Hsc.Config.NumTaps/2);
+  int i;
+  UINTPTR baseAddr;
+
+  baseAddr = XV_hscaler_Get_HwReg_hfltCoeff_BaseAddress(&HscPtr->Hsc);
+  for (i = 0; i < num_words; i++)
+  {
+    Xil_Out32(baseAddr+(i*4), Words[i]);
+  }
+}
+
 /*****************************************************************************/
 /**
 * This function configures the scaler core registers with the specified
@@ -599,6 +706,7 @@ int XV_HScalerSetup(XV_Hscaler_l2  *InstancePtr,
                      u32 ColorFormatOut)
 {
   u32 PixelRate;
+  u8 Set;
 
   /*
    * Assert validates the input arguments
@@ -622,17 +730,35 @@ int XV_HScalerSetup(XV_Hscaler_l2  *InstancePtr,
     if(!InstancePtr->UseExtCoeff)  //No user defined coefficients
     {
       /* Determine coefficient table to use */
-      XV_HScalerSelectCoeff(InstancePtr, WidthIn, WidthOut);
+      Set = XV_HScalerSelectCoeff(InstancePtr, WidthIn, WidthOut);
+      if((Set != XHSC_COEFF_SET_NONE) && (Set != InstancePtr->CoeffLoaded))
+      {
+        /* Program cached coefficients into the IP register bank */
+        XV_HScalerWriteCoeff(InstancePtr, InstancePtr->CoeffCache[Set]);
+        InstancePtr->CoeffLoaded = Set;
+      }
+    }
+    else if(InstancePtr->CoeffLoaded != XHSC_COEFF_SET_EXT)
+    {
+      /* Program user coefficients into the IP register bank */
+      XV_HScalerSetCoeff(InstancePtr);
+      InstancePtr->CoeffLoaded = XHSC_COEFF_SET_EXT;
     }
-    /* Program generated coefficients into the IP register bank */
-    XV_HScalerSetCoeff(InstancePtr);
   }
 
-  /* Compute Phase for 1 line */
-  CalculatePhases(InstancePtr, WidthIn, WidthOut, PixelRate);
+  /* Phases only depend on the widths, skip if already in the core */
+  if((WidthIn != InstancePtr->PhaseWidthIn) ||
+     (WidthOut != InstancePtr->PhaseWidthOut))
+  {
+    /* Compute Phase for 1 line */
+    CalculatePhases(InstancePtr, WidthIn, WidthOut, PixelRate);
+
+    /* Program computed Phase into the IP register bank */
+    XV_HScalerSetPhase(InstancePtr);
 
-  /* Program computed Phase into the IP register bank */
-  XV_HScalerSetPhase(InstancePtr);
+    InstancePtr->PhaseWidthIn  = WidthIn;
+    InstancePtr->PhaseWidthOut = WidthOut;
+  }
 
   XV_hscaler_Set_HwReg_Height(&InstancePtr->Hsc,        HeightIn);
   XV_hscaler_Set_HwReg_WidthIn(&InstancePtr->Hsc,       WidthIn);
@@ -64,6 +64,17 @@
 * Advanced users always have the capability to directly interact with the IP
 * core using Layer-1 API's that perform low level register peek/poke.
 *
+* <b> Coefficient Cache </b>
+*
+* For polyphase cores XV_HScalerInitialize() packs every fixed coefficient
+* table the core can use into register words once, keeping them in the
+* layer 2 instance. XV_HScalerSetup() then only writes the coefficient
+* storage when the scaling ratio selects a different table than the one
+* already loaded, and only recomputes and writes the phase storage when the
+* input or output width changed. Loading user coefficients with
+* XV_HScalerLoadExtCoeff() invalidates the loaded table so the next setup
+* writes them to the core.
+*
 * <b> Interrupts </b>
 *
 * This driver does not have any interrupts
@@ -111,6 +122,7 @@ extern "C" {
 #define XV_HSCALER_MAX_H_TAPS           (12)
 #define XV_HSCALER_MAX_H_PHASES         (64)
 #define XV_HSCALER_MAX_LINE_WIDTH       (8192)
+#define XV_HSCALER_NUM_COEFF_SETS       (4)
 
 /**************************** Type Definitions *******************************/
 /**
@@ -146,6 +158,11 @@ typedef struct
   short coeff[XV_HSCALER_MAX_H_PHASES][XV_HSCALER_MAX_H_TAPS];
   u64 phasesH[XV_HSCALER_MAX_LINE_WIDTH];
   u64 phasesH_H[XV_HSCALER_MAX_LINE_WIDTH];
+  u32 CoeffCache[XV_HSCALER_NUM_COEFF_SETS]
+                [XV_HSCALER_MAX_H_PHASES*(XV_HSCALER_MAX_H_TAPS/2)]; /*<< Packed fixed coefficient tables */
+  u8 CoeffLoaded;     /*<< Coefficient table currently in the core */
+  u32 PhaseWidthIn;   /*<< Input width of the phases in the core */
+  u32 PhaseWidthOut;  /*<< Output width of the phases in the core */
 }XV_Hscaler_l2;
 
 /************************** Macros Definitions *******************************/
@@ -77,7 +77,6 @@
 /************************** Constant Definitions *****************************/
 #define XVMIX_MASK_ENABLE_ALL_LAYERS    (0xFFFFFFFF)
 #define XVMIX_MASK_DISABLE_ALL_LAYERS   (0)
-#define XVMIX_REG_OFFSET                (0x100)
 #define XVMIX_MIN_STRM_WIDTH            (64u)
 #define XVMIX_MIN_STRM_HEIGHT           (64u)
 #define XVMIX_MIN_LOGO_WIDTH            (32u)
@@ -85,6 +84,10 @@
 #define XV_WAIT_FOR_FLUSH_DONE		    (25)
 #define XV_WAIT_FOR_FLUSH_DONE_TIMEOUT	(2000)
 
+/* Index of a layer in the layer update shadow, logo layer uses entry 0 */
+#define XVMIX_SHADOW_INDEX(LayerId) \
+            (((LayerId) == XVMIX_LAYER_LOGO) ? 0 : (LayerId))
+
 /* Pixel values in 8 bit resolution in YUV color space*/
 static const u8 bkgndColorYUV[XVMIX_BKGND_LAST][3] =
 {
@@ -1281,6 +1284,243 @@ UINTPTR XVMix_GetLayerChromaBufferAddr(XV_Mix_l2 *InstancePtr,
   return(ReadVal);
 }
 
+/*****************************************************************************/
+/**
+* This function stages a new window position of the specified layer in the
+* open layer update transaction
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer for which window position is to be set
+* @param  StartX is the new X position
+* @param  StartY is the new Y position
+*
+* @return XST_SUCCESS if change is staged else error code with reason
+*
+* @note   Applicable only for Layer1-8 and Logo Layer. The window is
+*         validated against the current window size and scale factor
+*
+******************************************************************************/
+int XVMix_StageLayerPosition(XV_Mix_l2 *InstancePtr,
+                             XVMix_LayerId LayerId,
+                             u16 StartX,
+                             u16 StartY)
+{
+  XVidC_VideoWindow CurrWin;
+  XVMix_Scalefactor Scale;
+  XVMix_LayerShadow *ShadowPtr;
+  int WinStatus;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId <= XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid((StartX % InstancePtr->Mix.Config.PixPerClk) == 0);
+
+  if(!InstancePtr->Update.IsOpen) {
+    return(XST_FAILURE);
+  }
+
+  /* Get current window */
+  WinStatus = XVMix_GetLayerWindow(InstancePtr, LayerId, &CurrWin);
+  if(WinStatus != XST_SUCCESS) {
+     return(WinStatus);
+  }
+
+  CurrWin.StartX = StartX;
+  CurrWin.StartY = StartY;
+  Scale = (XVMix_Scalefactor)XVMix_GetLayerScaleFactor(InstancePtr, LayerId);
+  if(!IsWindowValid(&InstancePtr->Stream, &CurrWin, Scale)) {
+      return(XVMIX_ERR_LAYER_WINDOW_INVALID);
+  }
+
+  ShadowPtr = &InstancePtr->Update.Layer[XVMIX_SHADOW_INDEX(LayerId)];
+  ShadowPtr->StartX = StartX;
+  ShadowPtr->StartY = StartY;
+  ShadowPtr->Flags |= XVMIX_UPDATE_POSITION;
+
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages a new Alpha level of the specified layer in the open
+* layer update transaction
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be updated
+* @param  Alpha is the new value
+*
+* @return XST_SUCCESS if change is staged else error code with reason
+*
+* @note   Applicable only for Layer1-8 and Logo Layer
+*
+******************************************************************************/
+int XVMix_StageLayerAlpha(XV_Mix_l2 *InstancePtr,
+                          XVMix_LayerId LayerId,
+                          u16 Alpha)
+{
+  XVMix_LayerShadow *ShadowPtr;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId <= XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid(Alpha <= XVMIX_ALPHA_MAX);
+
+  if(!InstancePtr->Update.IsOpen) {
+    return(XST_FAILURE);
+  }
+
+  if(LayerId == XVMIX_LAYER_LOGO) {
+    if(!XVMix_IsLogoEnabled(InstancePtr)) {
+      return(XVMIX_ERR_DISABLED_IN_HW);
+    }
+  } else if((LayerId >= XVMix_GetNumLayers(InstancePtr)) ||
+            (!XVMix_IsAlphaEnabled(InstancePtr, LayerId))) {
+    return(XVMIX_ERR_DISABLED_IN_HW);
+  }
+
+  ShadowPtr = &InstancePtr->Update.Layer[XVMIX_SHADOW_INDEX(LayerId)];
+  ShadowPtr->Alpha = Alpha;
+  ShadowPtr->Flags |= XVMIX_UPDATE_ALPHA;
+
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages a new buffer address of the specified layer in the
+* open layer update transaction
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be updated
+* @param  Addr is the absolute address of buffer in memory
+*
+* @return XST_SUCCESS if change is staged else error code with reason
+*
+* @note   Applicable only for Layer1-8
+*
+******************************************************************************/
+int XVMix_StageLayerBufferAddr(XV_Mix_l2 *InstancePtr,
+                               XVMix_LayerId LayerId,
+                               UINTPTR Addr)
+{
+  XVMix_LayerShadow *ShadowPtr;
+  UINTPTR Align;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId < XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid(Addr != 0);
+
+  if((!InstancePtr->Update.IsOpen) ||
+     (LayerId >= XVMix_GetNumLayers(InstancePtr))) {
+    return(XST_FAILURE);
+  }
+
+  /* Check if addr is aligned to aximm width (2*PPC*32-bits (4Bytes)) */
+  Align = 2 * InstancePtr->Mix.Config.PixPerClk * 4;
+  if((Addr % Align) != 0) {
+    return(XVMIX_ERR_MEM_ADDR_MISALIGNED);
+  }
+
+  ShadowPtr = &InstancePtr->Update.Layer[LayerId];
+  ShadowPtr->BufAddr = Addr;
+  ShadowPtr->Flags |= XVMIX_UPDATE_BUFADDR;
+
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages a new buffer address of the UV plane of the specified
+* layer in the open layer update transaction
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be updated
+* @param  Addr is the absolute address of second buffer in memory
+*
+* @return XST_SUCCESS if change is staged else error code with reason
+*
+* @note   Applicable only for Layer1-8
+*
+******************************************************************************/
+int XVMix_StageLayerChromaBufferAddr(XV_Mix_l2 *InstancePtr,
+                                     XVMix_LayerId LayerId,
+                                     UINTPTR Addr)
+{
+  XVMix_LayerShadow *ShadowPtr;
+  UINTPTR Align;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId < XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid(Addr != 0);
+
+  if((!InstancePtr->Update.IsOpen) ||
+     (LayerId >= XVMix_GetNumLayers(InstancePtr))) {
+    return(XST_FAILURE);
+  }
+
+  /* Check if addr is aligned to aximm width (2*PPC*32-bits (4Bytes)) */
+  Align = 2 * InstancePtr->Mix.Config.PixPerClk * 4;
+  if((Addr % Align) != 0) {
+    return(XVMIX_ERR_MEM_ADDR_MISALIGNED);
+  }
+
+  ShadowPtr = &InstancePtr->Update.Layer[LayerId];
+  ShadowPtr->ChromaBufAddr = Addr;
+  ShadowPtr->Flags |= XVMIX_UPDATE_CHROMA_BUFADDR;
+
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages enabling or disabling the specified layer in the open
+* layer update transaction
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be enabled or disabled
+* @param  Enable is TRUE to enable the layer, FALSE to disable it
+*
+* @return XST_SUCCESS or XST_FAILURE
+*
+* @note   To stage all layers use layer id XVMIX_LAYER_ALL
+*
+******************************************************************************/
+int XVMix_StageLayerEnable(XV_Mix_l2 *InstancePtr,
+                           XVMix_LayerId LayerId,
+                           u8 Enable)
+{
+  u32 Mask;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid((LayerId >= XVMIX_LAYER_MASTER) &&
+                    (LayerId < XVMIX_LAYER_LAST));
+
+  if(!InstancePtr->Update.IsOpen) {
+    return(XST_FAILURE);
+  }
+
+  if(LayerId == XVMIX_LAYER_ALL) {
+    Mask = XVMIX_MASK_ENABLE_ALL_LAYERS;
+  } else if((LayerId < XVMix_GetNumLayers(InstancePtr)) ||
+            ((LayerId == XVMIX_LAYER_LOGO) &&
+             (XVMix_IsLogoEnabled(InstancePtr)))) {
+    Mask = (1<<LayerId);
+  } else {
+    return(XST_FAILURE);
+  }
+
+  if(Enable) {
+    InstancePtr->Update.LayerEnable |= Mask;
+  } else {
+    InstancePtr->Update.LayerEnable &= ~Mask;
+  }
+  InstancePtr->Update.LayerEnableStaged = TRUE;
+
+  return(XST_SUCCESS);
+}
+
 /*****************************************************************************/
 /**
 * This function sets the logo layer color key data
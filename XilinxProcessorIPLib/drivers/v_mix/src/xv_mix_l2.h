@@ -99,6 +99,24 @@
 *     will configure the IP to keep processing frames without sw intervention.
 *   - Polling mode is the default configuration set during driver initialization
 *
+* <b> Layer Update Transactions </b>
+*
+* Layer position, alpha, buffer addresses and enable state can be updated as
+* one transaction instead of with immediate register writes:
+*   - XVMix_BeginUpdate() opens a transaction in the driver shadow state
+*   - XVMix_StageLayerPosition(), XVMix_StageLayerAlpha(),
+*     XVMix_StageLayerBufferAddr(), XVMix_StageLayerChromaBufferAddr() and
+*     XVMix_StageLayerEnable() validate a change and record it in the shadow
+*   - XVMix_CommitUpdate() hands the transaction over for a target frame
+*   - XVMix_GetUpdateStatus() reports if the commit was applied to the target
+*     frame
+* In interrupt mode the interrupt handler writes all staged registers in one
+* pass between frame done and the start of the target frame, so every change
+* of the transaction takes effect on the same frame. A commit that could not
+* be applied before its target frame started is applied on the next frame and
+* reported as XVMIX_ERR_UPDATE_MISSED. In polling mode the core restarts on
+* its own and the commit is written immediately, without frame alignment.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -142,10 +160,16 @@ extern "C" {
 #define XVMIX_MAX_SUPPORTED_LAYERS       (16)
 #define XVMIX_ALPHA_MIN                  (0)
 #define XVMIX_ALPHA_MAX                  (256)
+#define XVMIX_REG_OFFSET                 (0x100)
 
 #define XVMIX_IRQ_DONE_MASK              (0x01)
 #define XVMIX_IRQ_READY_MASK             (0x02)
 
+#define XVMIX_UPDATE_POSITION            (0x01)
+#define XVMIX_UPDATE_ALPHA               (0x02)
+#define XVMIX_UPDATE_BUFADDR             (0x04)
+#define XVMIX_UPDATE_CHROMA_BUFADDR      (0x08)
+
 /**************************** Type Definitions *******************************/
 /**
  * This typedef enumerates supported background colors
@@ -204,13 +228,14 @@ typedef enum {
   XVMIX_LAYER_TYPE_STREAM
 }XVMix_LayerType;
 
-/****************** Mixer status 4096 - 4100  *****************************/
+/****************** Mixer status 4096 - 4101  *****************************/
 typedef enum {
   XVMIX_ERR_LAYER_WINDOW_INVALID     = 0x1000L,
   XVMIX_ERR_WIN_STRIDE_MISALIGNED    = 0x1001L,
   XVMIX_ERR_MEM_ADDR_MISALIGNED      = 0x1002L,
   XVMIX_ERR_LAYER_INTF_TYPE_MISMATCH = 0x1003L,
   XVMIX_ERR_DISABLED_IN_HW           = 0x1004L,
+  XVMIX_ERR_UPDATE_MISSED            = 0x1005L,
   XVMIX_ERR_LAST
 }XVMix_ErrorCodes;
 
@@ -239,6 +264,36 @@ typedef struct {
     };
 }XVMix_Layer;
 
+/**
+ * This typedef contains the staged changes of a layer in a layer update
+ * transaction
+ */
+typedef struct {
+    u8 Flags;                /**< XVMIX_UPDATE_* changes staged */
+    u16 StartX;              /**< Staged window start X */
+    u16 StartY;              /**< Staged window start Y */
+    u16 Alpha;               /**< Staged alpha level */
+    UINTPTR BufAddr;         /**< Staged buffer address */
+    UINTPTR ChromaBufAddr;   /**< Staged chroma buffer address */
+}XVMix_LayerShadow;
+
+/**
+ * This typedef contains the state of a layer update transaction. Entry 0 of
+ * the layer array holds the logo layer, since the master layer has no
+ * updatable settings.
+ */
+typedef struct {
+    XVMix_LayerShadow Layer[XVMIX_MAX_SUPPORTED_LAYERS+1]; /**< Staged layer
+                                                                changes */
+    u32 LayerEnable;         /**< Staged layer enable mask */
+    u8 LayerEnableStaged;    /**< Flag if the enable mask was changed */
+    u8 IsOpen;               /**< Flag if a transaction is being staged */
+    u8 IsPending;            /**< Flag if a commit waits for its frame */
+    u32 TargetFrame;         /**< Frame the pending commit is intended for */
+    u32 AppliedFrame;        /**< Frame the last commit was applied to */
+    int CommitStatus;        /**< Result of the last applied commit */
+}XVMix_Update;
+
 /**
 * Callback type for interrupt.
 *
@@ -271,6 +326,9 @@ typedef struct {
     XVMix_BackgroundId BkgndColor;
 
     XVidC_VideoStream Stream;    /**< Input AXIS */
+
+    XVMix_Update Update;   /**< Layer update transaction */
+    u32 FrameCount;        /**< Frames started by the interrupt handler */
 }XV_Mix_l2;
 
 /************************** Macros Definitions *******************************/
@@ -288,6 +346,22 @@ typedef struct {
 ******************************************************************************/
 #define XVMix_GetNumLayers(InstancePtr)  ((InstancePtr)->Mix.Config.NumLayers)
 
+/*****************************************************************************/
+/**
+*
+* This macro returns the number of frames started by the interrupt handler.
+* Frame numbers passed to XVMix_CommitUpdate() are counted on this basis,
+* the next frame to be started is XVMix_GetFrameCount() + 1.
+*
+* @param    InstancePtr is a pointer to the core instance.
+*
+* @return   Frame count
+*
+* @note     None.
+*
+******************************************************************************/
+#define XVMix_GetFrameCount(InstancePtr)          ((InstancePtr)->FrameCount)
+
 /*****************************************************************************/
 /**
 *
@@ -476,6 +550,23 @@ int XVMix_LoadLogoPixelAlpha(XV_Mix_l2 *InstancePtr,
                              XVidC_VideoWindow *Win,
                              u8 *ABuffer);
 
+int XVMix_StageLayerPosition(XV_Mix_l2 *InstancePtr,
+                             XVMix_LayerId LayerId,
+                             u16 StartX,
+                             u16 StartY);
+int XVMix_StageLayerAlpha(XV_Mix_l2 *InstancePtr,
+                          XVMix_LayerId LayerId,
+                          u16 Alpha);
+int XVMix_StageLayerBufferAddr(XV_Mix_l2 *InstancePtr,
+                               XVMix_LayerId LayerId,
+                               UINTPTR Addr);
+int XVMix_StageLayerChromaBufferAddr(XV_Mix_l2 *InstancePtr,
+                                     XVMix_LayerId LayerId,
+                                     UINTPTR Addr);
+int XVMix_StageLayerEnable(XV_Mix_l2 *InstancePtr,
+                           XVMix_LayerId LayerId,
+                           u8 Enable);
+
 void XVMix_DbgReportStatus(XV_Mix_l2 *InstancePtr);
 void XVMix_DbgLayerInfo(XV_Mix_l2 *InstancePtr, XVMix_LayerId LayerId);
 
@@ -484,6 +575,9 @@ void XVMix_InterruptHandler(void *InstancePtr);
 int XVMix_SetCallback(XV_Mix_l2 *InstancePtr, void *CallbackFunc, void *CallbackRef);
 void XVMix_InterruptEnable(XV_Mix_l2 *InstancePtr);
 void XVMix_InterruptDisable(XV_Mix_l2 *InstancePtr);
+int XVMix_BeginUpdate(XV_Mix_l2 *InstancePtr);
+int XVMix_CommitUpdate(XV_Mix_l2 *InstancePtr, u32 TargetFrame);
+int XVMix_GetUpdateStatus(XV_Mix_l2 *InstancePtr, u32 *AppliedFramePtr);
 
 #ifdef __cplusplus
 }
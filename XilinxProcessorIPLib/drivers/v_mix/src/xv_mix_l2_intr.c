@@ -46,8 +46,13 @@
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
+#include <string.h>
 #include "xv_mix_l2.h"
 
+/************************** Function Prototypes ******************************/
+static u32 XVMix_UpdateLock(XV_Mix_l2 *InstancePtr);
+static void XVMix_UpdateUnlock(XV_Mix_l2 *InstancePtr, u32 Gie);
+static void XVMix_ApplyUpdate(XV_Mix_l2 *InstancePtr, u32 FrameNum);
 
 /*****************************************************************************/
 /**
@@ -85,8 +90,9 @@ int XVMix_SetCallback(XV_Mix_l2 *InstancePtr, void *CallbackFunc, void *Callback
 * This function is the interrupt handler for the mixer core driver.
 *
 * This handler clears the pending interrupt and determined if the source is
-* frame done signal. If yes, starts the next frame processing and calls the
-* registered callback function
+* frame done signal. If yes, calls the registered callback function, applies
+* a committed layer update due for the next frame and starts the next frame
+* processing
 *
 * The application is responsible for connecting this function to the interrupt
 * system. Application beyond this driver is also responsible for providing
@@ -122,7 +128,252 @@ void XVMix_InterruptHandler(void *InstancePtr)
     if(MixPtr->FrameDoneCallback) {
 	      MixPtr->FrameDoneCallback(MixPtr->CallbackRef);
     }
+
+    //Apply committed layer update, if due for the frame to be started
+    if(MixPtr->Update.IsPending &&
+       ((s32)(MixPtr->Update.TargetFrame - (MixPtr->FrameCount + 1)) <= 0)) {
+      XVMix_ApplyUpdate(MixPtr, MixPtr->FrameCount + 1);
+    }
     XV_mix_Start(&MixPtr->Mix);
+    MixPtr->FrameCount++;
+  }
+}
+
+/*****************************************************************************/
+/**
+*
+* This function opens a layer update transaction. Layer changes staged with
+* the XVMix_StageLayer*() functions are kept in the driver shadow state until
+* XVMix_CommitUpdate() is called.
+*
+* @param    InstancePtr is a pointer to the mixer core instance.
+*
+* @return   XST_SUCCESS if the transaction is opened.
+*           XST_DEVICE_BUSY if a previous commit is still pending.
+*
+* @note     Opening a transaction discards changes staged but not committed.
+*
+******************************************************************************/
+int XVMix_BeginUpdate(XV_Mix_l2 *InstancePtr)
+{
+  XVMix_Update *UpdatePtr;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+
+  UpdatePtr = &InstancePtr->Update;
+  if(UpdatePtr->IsPending) {
+    return(XST_DEVICE_BUSY);
+  }
+
+  memset(UpdatePtr->Layer, 0, sizeof(UpdatePtr->Layer));
+  UpdatePtr->LayerEnable = XV_mix_Get_HwReg_layerEnable(&InstancePtr->Mix);
+  UpdatePtr->LayerEnableStaged = FALSE;
+  UpdatePtr->IsOpen = TRUE;
+
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function commits the open layer update transaction.
+*
+* In interrupt mode the transaction is handed over to the interrupt handler,
+* which writes all staged changes between frame done and the start of
+* TargetFrame. In polling mode the staged changes are written immediately.
+*
+* @param    InstancePtr is a pointer to the mixer core instance.
+* @param    TargetFrame is the number of the frame the changes are intended
+*           for, see XVMix_GetFrameCount(). Use 0 for the next frame.
+*
+* @return   XST_SUCCESS if the transaction is committed.
+*           XST_FAILURE if no transaction is open.
+*
+* @note     Use XVMix_GetUpdateStatus() to find out if the commit was applied
+*           to the intended frame.
+*
+******************************************************************************/
+int XVMix_CommitUpdate(XV_Mix_l2 *InstancePtr, u32 TargetFrame)
+{
+  XVMix_Update *UpdatePtr;
+  u32 Gie;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+
+  UpdatePtr = &InstancePtr->Update;
+  if(!UpdatePtr->IsOpen) {
+    return(XST_FAILURE);
+  }
+  UpdatePtr->IsOpen = FALSE;
+
+  Gie = XVMix_UpdateLock(InstancePtr);
+  if(TargetFrame == 0) {
+    TargetFrame = InstancePtr->FrameCount + 1;
+  }
+  UpdatePtr->TargetFrame = TargetFrame;
+
+  if(Gie & 0x1) {
+    /* Interrupt mode, handler applies it at the frame boundary */
+    UpdatePtr->IsPending = TRUE;
+  } else {
+    /* Polling mode, core restarts on its own */
+    XVMix_ApplyUpdate(InstancePtr, TargetFrame);
   }
+  XVMix_UpdateUnlock(InstancePtr, Gie);
+
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the result of the last committed layer update.
+*
+* @param    InstancePtr is a pointer to the mixer core instance.
+* @param    AppliedFramePtr is a pointer to return the number of the frame
+*           the update was applied to. May be NULL.
+*
+* @return   XST_SUCCESS if the update was applied to its target frame.
+*           XVMIX_ERR_UPDATE_MISSED if it was applied to a later frame.
+*           XST_DEVICE_BUSY if it is not applied yet.
+*
+******************************************************************************/
+int XVMix_GetUpdateStatus(XV_Mix_l2 *InstancePtr, u32 *AppliedFramePtr)
+{
+  Xil_AssertNonvoid(InstancePtr != NULL);
+
+  if(InstancePtr->Update.IsPending) {
+    return(XST_DEVICE_BUSY);
+  }
+
+  if(AppliedFramePtr != NULL) {
+    *AppliedFramePtr = InstancePtr->Update.AppliedFrame;
+  }
+  return(InstancePtr->Update.CommitStatus);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function masks the core interrupt output so the layer update state can
+* be changed without racing the interrupt handler.
+*
+* @param    InstancePtr is a pointer to the mixer core instance.
+*
+* @return   Saved global interrupt enable to be passed to
+*           XVMix_UpdateUnlock().
+*
+******************************************************************************/
+static u32 XVMix_UpdateLock(XV_Mix_l2 *InstancePtr)
+{
+  u32 Gie;
+
+  Gie = XV_mix_ReadReg(InstancePtr->Mix.Config.BaseAddress,
+                       XV_MIX_CTRL_ADDR_GIE);
+  XV_mix_InterruptGlobalDisable(&InstancePtr->Mix);
+
+  return Gie;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function restores the interrupt setting saved by XVMix_UpdateLock().
+*
+* @param    InstancePtr is a pointer to the mixer core instance.
+* @param    Gie is the value returned by XVMix_UpdateLock().
+*
+* @return   None.
+*
+******************************************************************************/
+static void XVMix_UpdateUnlock(XV_Mix_l2 *InstancePtr, u32 Gie)
+{
+  if(Gie & 0x1) {
+    XV_mix_InterruptGlobalEnable(&InstancePtr->Mix);
+  }
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes all changes of the committed layer update to the core
+* in one pass and records the result of the commit.
+*
+* @param    InstancePtr is a pointer to the mixer core instance.
+* @param    FrameNum is the number of the frame the changes are applied to.
+*
+* @return   None.
+*
+******************************************************************************/
+static void XVMix_ApplyUpdate(XV_Mix_l2 *InstancePtr, u32 FrameNum)
+{
+  XV_mix *MixPtr = &InstancePtr->Mix;
+  XVMix_Update *UpdatePtr = &InstancePtr->Update;
+  XVMix_LayerShadow *ShadowPtr;
+  UINTPTR BaseAddr = MixPtr->Config.BaseAddress;
+  u32 LayerId, Offset;
+
+  /* Logo layer */
+  ShadowPtr = &UpdatePtr->Layer[0];
+  if(ShadowPtr->Flags & XVMIX_UPDATE_POSITION) {
+    XV_mix_Set_HwReg_logoStartX(MixPtr, ShadowPtr->StartX);
+    XV_mix_Set_HwReg_logoStartY(MixPtr, ShadowPtr->StartY);
+  }
+  if(ShadowPtr->Flags & XVMIX_UPDATE_ALPHA) {
+    XV_mix_Set_HwReg_logoAlpha(MixPtr, ShadowPtr->Alpha);
+  }
+  ShadowPtr->Flags = 0;
+
+  /* Layer1-Layer16 */
+  for(LayerId = XVMIX_LAYER_1; LayerId < XVMix_GetNumLayers(InstancePtr);
+      ++LayerId) {
+    ShadowPtr = &UpdatePtr->Layer[LayerId];
+    if(!ShadowPtr->Flags) {
+      continue;
+    }
+
+    Offset = LayerId*XVMIX_REG_OFFSET;
+    if(ShadowPtr->Flags & XVMIX_UPDATE_POSITION) {
+      XV_mix_WriteReg(BaseAddr,
+                      (XV_MIX_CTRL_ADDR_HWREG_LAYERSTARTX_0_DATA+Offset),
+                      ShadowPtr->StartX);
+      XV_mix_WriteReg(BaseAddr,
+                      (XV_MIX_CTRL_ADDR_HWREG_LAYERSTARTY_0_DATA+Offset),
+                      ShadowPtr->StartY);
+      InstancePtr->Layer[LayerId].Win.StartX = ShadowPtr->StartX;
+      InstancePtr->Layer[LayerId].Win.StartY = ShadowPtr->StartY;
+    }
+    if(ShadowPtr->Flags & XVMIX_UPDATE_ALPHA) {
+      XV_mix_WriteReg(BaseAddr,
+                      (XV_MIX_CTRL_ADDR_HWREG_LAYERALPHA_0_DATA+Offset),
+                      ShadowPtr->Alpha);
+    }
+
+    /* Buffer registers start at layer 1 */
+    Offset -= XVMIX_REG_OFFSET;
+    if(ShadowPtr->Flags & XVMIX_UPDATE_BUFADDR) {
+      XV_mix_WriteReg(BaseAddr,
+                      (XV_MIX_CTRL_ADDR_HWREG_LAYER1_BUF1_V_DATA+Offset),
+                      ShadowPtr->BufAddr);
+      InstancePtr->Layer[LayerId].BufAddr = ShadowPtr->BufAddr;
+    }
+    if(ShadowPtr->Flags & XVMIX_UPDATE_CHROMA_BUFADDR) {
+      XV_mix_WriteReg(BaseAddr,
+                      (XV_MIX_CTRL_ADDR_HWREG_LAYER1_BUF2_V_DATA+Offset),
+                      ShadowPtr->ChromaBufAddr);
+      InstancePtr->Layer[LayerId].ChromaBufAddr = ShadowPtr->ChromaBufAddr;
+    }
+    ShadowPtr->Flags = 0;
+  }
+
+  if(UpdatePtr->LayerEnableStaged) {
+    XV_mix_Set_HwReg_layerEnable(MixPtr, UpdatePtr->LayerEnable);
+    UpdatePtr->LayerEnableStaged = FALSE;
+  }
+
+  UpdatePtr->AppliedFrame = FrameNum;
+  UpdatePtr->CommitStatus = (FrameNum == UpdatePtr->TargetFrame) ?
+                            XST_SUCCESS : XVMIX_ERR_UPDATE_MISSED;
+  UpdatePtr->IsPending = FALSE;
 }
 /** @} */
@@ -38,6 +38,7 @@
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
+#include <string.h>
 #include "xv_multi_scaler_l2.h"
 #include "xvidc.h"
 
@@ -281,9 +282,24 @@ static const void (*XV_MS_Set_DstImgBuf1[XV_MAX_OUTS])(XV_multi_scaler
 	XV_multi_scaler_Set_HwReg_dstImgBuf1_6_V,
 	XV_multi_scaler_Set_HwReg_dstImgBuf1_7_V};
 
+static const short *XV_MS_CoeffSet[XV_MULTISCALER_NUM_COEFF_SETS] = {
+	&XV_multiscaler_fixedcoeff_taps6[0][0],
+	&XV_multiscaler_fixedcoeff_taps8[0][0],
+	&XV_multiscaler_fixedcoeff_taps10[0][0],
+	&XV_multiscaler_fixedcoeff_taps12[0][0]};
+static u32 XV_MS_PackedCoeff[XV_MULTISCALER_NUM_COEFF_SETS]
+	[XV_MULTISCALER_MAX_V_PHASES][XV_MULTISCALER_TAPS_12 / 2];
+static u8 XV_MS_PackedCoeffValid;
+
 /************************** Function Prototypes ******************************/
-static void XV_MultiScalerSetCoeff(XV_multi_scaler *MscPtr,
-				   XV_multi_scaler_Video_Config *MS_cfg);
+static u8 XV_MultiScalerGetCoeffSet(u32 SizeIn, u32 SizeOut);
+static void XV_MultiScalerLoadCoeff(XV_multi_scaler *MscPtr, u32 ChannelId,
+				    u32 CoeffBase, u8 CoeffSet);
+static void XV_MultiScalerProgramDesc(XV_multi_scaler *MscPtr, u32 ChannelId,
+				      const XV_multi_scaler_Desc *DescPtr);
+static u32 XV_MultiScalerSchedLock(XV_multi_scaler *MscPtr);
+static void XV_MultiScalerSchedUnlock(XV_multi_scaler *MscPtr, u32 Gie);
+static void XV_MultiScalerSchedDispatch(XV_multi_scaler_Sched *SchedPtr);
 
 /*****************************************************************************/
 /**
@@ -364,80 +380,115 @@ void XV_MultiScalerSetNumOutputs(XV_multi_scaler *InstancePtr, u32 NumOuts)
 
 /*****************************************************************************/
 /**
-* This function programs the computed filter coefficients and phase data into
-* core registers
+* This function selects the fixed coefficient set for a scale ratio
 *
-* @param	MscPtr is a pointer to the core instance to be worked on.
-* @param	NumOut is the output channel number.
+* @param	SizeIn is the input width or height.
+* @param	SizeOut is the output width or height.
 *
-* @return None
+* @return Index of the coefficient set, in XV_MS_CoeffSet
 *
 ******************************************************************************/
-static void XV_MultiScalerSetCoeff(XV_multi_scaler *MscPtr,
-				   XV_multi_scaler_Video_Config *MS_cfg)
+static u8 XV_MultiScalerGetCoeffSet(u32 SizeIn, u32 SizeOut)
 {
-	u32 num_phases = 1<<MscPtr->PhaseShift;
-	u32 num_taps	= MscPtr->NumTaps/2;
-	u32 val;
-	u32 i;
-	u32 j;
-	u32 baseAddr;
-	short *coeff;
-	u32 vfltcoef_offset;
-	u32 hfltcoef_offset;
 	float scale;
 
-	scale = (float)MS_cfg->HeightIn / MS_cfg->HeightOut;
+	scale = (float)SizeIn / SizeOut;
 
 	if ((scale >= 2) && (scale < 2.5))
-		coeff = &XV_multiscaler_fixedcoeff_taps8[0][0];
+		return 1;
 	else if ((scale >= 2.5) && (scale < 3))
-		coeff = &XV_multiscaler_fixedcoeff_taps10[0][0];
+		return 2;
 	else if ((scale >= 3) && (scale < 3.5))
-		coeff = &XV_multiscaler_fixedcoeff_taps12[0][0];
+		return 3;
 	else
-		coeff = &XV_multiscaler_fixedcoeff_taps6[0][0];
+		return 0;
+}
 
-	vfltcoef_offset = XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_VFLTCOEFF_0_BASE +
-		MS_cfg->ChannelId *
-		XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_FLTCOEFF_OFFSET;
+/*****************************************************************************/
+/**
+* This function programs a fixed filter coefficient set into the coefficient
+* memory of a channel. The register values of the sets are packed once, on
+* first use.
+*
+* @param	MscPtr is a pointer to the core instance to be worked on.
+* @param	ChannelId is the output channel number.
+* @param	CoeffBase is the offset of the horizontal or vertical
+*		coefficient memory of channel 0.
+* @param	CoeffSet is the index of the coefficient set.
+*
+* @return None
+*
+******************************************************************************/
+static void XV_MultiScalerLoadCoeff(XV_multi_scaler *MscPtr, u32 ChannelId,
+				    u32 CoeffBase, u8 CoeffSet)
+{
+	u32 num_phases = 1<<MscPtr->PhaseShift;
+	u32 num_taps	= MscPtr->NumTaps/2;
+	u32 baseAddr;
+	const short *coeff;
+	u32 i;
+	u32 j;
+	u32 k;
 
-	baseAddr = MscPtr->Ctrl_BaseAddress + vfltcoef_offset;
-	for (i = 0; i < num_phases; i++) {
-		for (j = 0; j < XV_MULTISCALER_TAPS_12; j = j + 2) {
-			val = (coeff[i * XV_MULTISCALER_TAPS_12 + (j + 1)] << 16) |
-				(coeff[i * XV_MULTISCALER_TAPS_12 + j] & 0x0000FFFF);
-			XV_multi_scaler_WriteReg(baseAddr,
-				((i * num_taps + j / 2) * 4), val);
+	if (!XV_MS_PackedCoeffValid) {
+		for (k = 0; k < XV_MULTISCALER_NUM_COEFF_SETS; k++) {
+			coeff = XV_MS_CoeffSet[k];
+			for (i = 0; i < XV_MULTISCALER_MAX_V_PHASES; i++) {
+				for (j = 0; j < XV_MULTISCALER_TAPS_12; j = j + 2) {
+					XV_MS_PackedCoeff[k][i][j / 2] =
+					((u32)coeff[i * XV_MULTISCALER_TAPS_12 + (j + 1)] << 16) |
+					((u32)coeff[i * XV_MULTISCALER_TAPS_12 + j] &
+					 XVSC_MASK_LOW_16BITS);
+				}
+			}
 		}
+		XV_MS_PackedCoeffValid = 1;
 	}
 
-	scale = (float)MS_cfg->WidthIn / MS_cfg->WidthOut;
-
-	if ((scale >= 2) && (scale < 2.5))
-		coeff = &XV_multiscaler_fixedcoeff_taps8[0][0];
-	else if ((scale >= 2.5) && (scale < 3))
-		coeff = &XV_multiscaler_fixedcoeff_taps10[0][0];
-	else if ((scale >= 3) && (scale < 3.5))
-		coeff = &XV_multiscaler_fixedcoeff_taps12[0][0];
-	else
-		coeff = &XV_multiscaler_fixedcoeff_taps6[0][0];
-
-	hfltcoef_offset = XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_HFLTCOEFF_0_BASE +
-		MS_cfg->ChannelId *
-		XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_FLTCOEFF_OFFSET;
-
-	baseAddr = MscPtr->Ctrl_BaseAddress + hfltcoef_offset;
+	baseAddr = MscPtr->Ctrl_BaseAddress + CoeffBase +
+		ChannelId * XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_FLTCOEFF_OFFSET;
 	for (i = 0; i < num_phases; i++) {
-		for (j = 0; j < XV_MULTISCALER_TAPS_12; j = j + 2) {
-			val = (coeff[i * XV_MULTISCALER_TAPS_12 + (j + 1)] << 16) |
-				(coeff[i * XV_MULTISCALER_TAPS_12 + j] & 0x0000FFFF);
+		for (j = 0; j < XV_MULTISCALER_TAPS_12 / 2; j++) {
 			XV_multi_scaler_WriteReg(baseAddr,
-				((i * num_taps + j / 2) * 4), val);
+				((i * num_taps + j) * 4),
+				XV_MS_PackedCoeff[CoeffSet][i][j]);
 		}
 	}
 }
 
+/*****************************************************************************/
+/**
+* This function writes a prepared configuration into the registers of a
+* channel. The filter coefficients are not written.
+*
+* @param	MscPtr is a pointer to the core instance to be worked on.
+* @param	ChannelId is the output channel number.
+* @param	DescPtr is a pointer to the prepared configuration.
+*
+* @return None
+*
+******************************************************************************/
+static void XV_MultiScalerProgramDesc(XV_multi_scaler *MscPtr, u32 ChannelId,
+				      const XV_multi_scaler_Desc *DescPtr)
+{
+	u32 i = ChannelId;
+
+	XV_MS_Set_SrcImgBuf0[i](MscPtr, DescPtr->SrcImgBuf0);
+	XV_MS_Set_SrcImgBuf1[i](MscPtr, DescPtr->SrcImgBuf1);
+	XV_MS_Set_HeightIn[i](MscPtr, DescPtr->HeightIn);
+	XV_MS_Set_WidthIn[i](MscPtr, DescPtr->WidthIn);
+	XV_MS_Set_WidthOut[i](MscPtr, DescPtr->WidthOut);
+	XV_MS_Set_HeightOut[i](MscPtr, DescPtr->HeightOut);
+	XV_MS_Set_LineRate[i](MscPtr, DescPtr->LineRate);
+	XV_MS_Set_PixelRate[i](MscPtr, DescPtr->PixelRate);
+	XV_MS_Set_ColorFormatIn[i](MscPtr, DescPtr->ColorFormatIn);
+	XV_MS_Set_ColorFormatOut[i](MscPtr, DescPtr->ColorFormatOut);
+	XV_MS_Set_InStride[i](MscPtr, DescPtr->InStride);
+	XV_MS_Set_OutStride[i](MscPtr, DescPtr->OutStride);
+	XV_MS_Set_DstImgBuf0[i](MscPtr, DescPtr->DstImgBuf0);
+	XV_MS_Set_DstImgBuf1[i](MscPtr, DescPtr->DstImgBuf1);
+}
+
 /*****************************************************************************/
 /**
 * This function reads the channel configuration. The ChannelId of the channel
@@ -481,24 +532,22 @@ void XV_MultiScalerGetChannelConfig(XV_multi_scaler *InstancePtr,
 
 /*****************************************************************************/
 /**
-* This function configures the scaler core registers with the specified
-* configuration parameters
+* This function computes the register values of a channel configuration: the
+* crop offsets, the pixel and line rates and the coefficient sets. The
+* ChannelId of MS_cfg is not used, the descriptor can be programmed in any
+* channel. The Next member of the descriptor is cleared.
 *
 * @param	InstancePtr is a pointer to the core instance to be worked on.
 * @param	MS_cfg is a pointer to the multi scaler config structure.
+* @param	DescPtr is a pointer to the descriptor to fill.
 *
 * @return None
 *
 ******************************************************************************/
-void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
-	XV_multi_scaler_Video_Config *MS_cfg)
+void XV_MultiScalerPrepareDesc(XV_multi_scaler *InstancePtr,
+	XV_multi_scaler_Video_Config *MS_cfg, XV_multi_scaler_Desc *DescPtr)
 {
-	u32 PixelRate;
-	u32 LineRate;
-	u32 i;
 	u16 Cfmt;
-	UINTPTR SrcImgBuf0;
-	UINTPTR SrcImgBuf1;
 	u8 buf0_numerator;
 	u8 buf0_denominator;
 	u8 buf1_numerator;
@@ -509,11 +558,10 @@ void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
 	*/
 	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(MS_cfg != NULL);
+	Xil_AssertVoid(DescPtr != NULL);
 	Xil_AssertVoid((InstancePtr->SamplesPerClock >= XVIDC_PPC_1) &&
 		(InstancePtr->SamplesPerClock <= XVIDC_PPC_4));
 
-	i = MS_cfg->ChannelId;
-	Xil_AssertVoid(i < InstancePtr->MaxOuts);
 	Xil_AssertVoid((MS_cfg->WidthIn > 0) &&
 		(MS_cfg->WidthIn <= InstancePtr->MaxCols));
 	Xil_AssertVoid((MS_cfg->WidthOut > 0) &&
@@ -536,7 +584,6 @@ void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
 		Xil_AssertVoid(MS_cfg->SrcImgBuf1 > (MS_cfg->DstImgBuf1 +
 			(MS_cfg->HeightOut * MS_cfg->OutStride)));
 	}
-	InstancePtr->OutBitMask |= 0x1 << i;
 	if (MS_cfg->CropWin.Crop) {
 		Xil_AssertVoid(MS_cfg->CropWin.StartY <= MS_cfg->HeightIn);
 		Xil_AssertVoid(MS_cfg->CropWin.StartX <= MS_cfg->WidthIn);
@@ -547,8 +594,6 @@ void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
 			(MS_cfg->CropWin.Width <= (MS_cfg->WidthIn -
 			MS_cfg->CropWin.StartX)));
 		Cfmt = MS_cfg->ColorFormatIn;
-		SrcImgBuf0 = MS_cfg->SrcImgBuf0;
-		SrcImgBuf1 = MS_cfg->SrcImgBuf1;
 		/* Table 3 Pixel formats supported in PG325 */
 		switch (Cfmt) {
 			case XV_MULTI_SCALER_Y_UV10:
@@ -602,38 +647,366 @@ void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
 				buf1_denominator = 1;
 				break;
 		}
-		SrcImgBuf0 += (MS_cfg->CropWin.StartY * MS_cfg->InStride)
+		DescPtr->SrcOffset0 = (MS_cfg->CropWin.StartY * MS_cfg->InStride)
 			+ ((MS_cfg->CropWin.StartX * buf0_numerator) / buf0_denominator);
-		SrcImgBuf1 += (MS_cfg->CropWin.StartY * MS_cfg->InStride)
+		DescPtr->SrcOffset1 = (MS_cfg->CropWin.StartY * MS_cfg->InStride)
 			+ ((MS_cfg->CropWin.StartX * buf1_numerator) / buf1_denominator);
-		XV_MS_Set_SrcImgBuf0[i](InstancePtr, SrcImgBuf0);
-		XV_MS_Set_SrcImgBuf1[i](InstancePtr, SrcImgBuf1);
-		PixelRate = (u32) ((float)(MS_cfg->CropWin.Width * STEP_PRECISION +
-			MS_cfg->WidthOut / 2) / MS_cfg->WidthOut);
-		LineRate = (u32) ((float)(MS_cfg->CropWin.Height * STEP_PRECISION +
-			MS_cfg->HeightOut / 2) / MS_cfg->HeightOut);
-		XV_MS_Set_HeightIn[i](InstancePtr, MS_cfg->CropWin.Height);
-		XV_MS_Set_WidthIn[i](InstancePtr, MS_cfg->CropWin.Width);
+		DescPtr->PixelRate = (u32) ((float)(MS_cfg->CropWin.Width *
+			STEP_PRECISION + MS_cfg->WidthOut / 2) / MS_cfg->WidthOut);
+		DescPtr->LineRate = (u32) ((float)(MS_cfg->CropWin.Height *
+			STEP_PRECISION + MS_cfg->HeightOut / 2) / MS_cfg->HeightOut);
+		DescPtr->HeightIn = MS_cfg->CropWin.Height;
+		DescPtr->WidthIn = MS_cfg->CropWin.Width;
 	} else {
-		XV_MS_Set_SrcImgBuf0[i](InstancePtr, MS_cfg->SrcImgBuf0);
-		XV_MS_Set_SrcImgBuf1[i](InstancePtr, MS_cfg->SrcImgBuf1);
-		PixelRate = (u32) ((float)(MS_cfg->WidthIn * STEP_PRECISION +
-			MS_cfg->WidthOut / 2) / MS_cfg->WidthOut);
-		LineRate = (u32) ((float)(MS_cfg->HeightIn * STEP_PRECISION +
-			MS_cfg->HeightOut / 2) / MS_cfg->HeightOut);
-		XV_MS_Set_HeightIn[i](InstancePtr, MS_cfg->HeightIn);
-		XV_MS_Set_WidthIn[i](InstancePtr, MS_cfg->WidthIn);
+		DescPtr->SrcOffset0 = 0;
+		DescPtr->SrcOffset1 = 0;
+		DescPtr->PixelRate = (u32) ((float)(MS_cfg->WidthIn *
+			STEP_PRECISION + MS_cfg->WidthOut / 2) / MS_cfg->WidthOut);
+		DescPtr->LineRate = (u32) ((float)(MS_cfg->HeightIn *
+			STEP_PRECISION + MS_cfg->HeightOut / 2) / MS_cfg->HeightOut);
+		DescPtr->HeightIn = MS_cfg->HeightIn;
+		DescPtr->WidthIn = MS_cfg->WidthIn;
+	}
+	DescPtr->Next = NULL;
+	DescPtr->SrcImgBuf0 = MS_cfg->SrcImgBuf0 + DescPtr->SrcOffset0;
+	DescPtr->SrcImgBuf1 = MS_cfg->SrcImgBuf1 + DescPtr->SrcOffset1;
+	DescPtr->DstImgBuf0 = MS_cfg->DstImgBuf0;
+	DescPtr->DstImgBuf1 = MS_cfg->DstImgBuf1;
+	DescPtr->WidthOut = MS_cfg->WidthOut;
+	DescPtr->HeightOut = MS_cfg->HeightOut;
+	DescPtr->ColorFormatIn = MS_cfg->ColorFormatIn;
+	DescPtr->ColorFormatOut = MS_cfg->ColorFormatOut;
+	DescPtr->InStride = MS_cfg->InStride;
+	DescPtr->OutStride = MS_cfg->OutStride;
+	DescPtr->HCoeffSet = XV_MultiScalerGetCoeffSet(MS_cfg->WidthIn,
+		MS_cfg->WidthOut);
+	DescPtr->VCoeffSet = XV_MultiScalerGetCoeffSet(MS_cfg->HeightIn,
+		MS_cfg->HeightOut);
+}
+
+/*****************************************************************************/
+/**
+* This function sets the buffers of a prepared descriptor. The crop offsets
+* computed by XV_MultiScalerPrepareDesc() are added to the source buffers.
+*
+* @param	DescPtr is a pointer to the descriptor.
+* @param	SrcImgBuf0 is the source buffer.
+* @param	SrcImgBuf1 is the source UV buffer.
+* @param	DstImgBuf0 is the destination buffer.
+* @param	DstImgBuf1 is the destination UV buffer.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerDescSetBuffers(XV_multi_scaler_Desc *DescPtr,
+	UINTPTR SrcImgBuf0, UINTPTR SrcImgBuf1, UINTPTR DstImgBuf0,
+	UINTPTR DstImgBuf1)
+{
+	Xil_AssertVoid(DescPtr != NULL);
+
+	DescPtr->SrcImgBuf0 = SrcImgBuf0 + DescPtr->SrcOffset0;
+	DescPtr->SrcImgBuf1 = SrcImgBuf1 + DescPtr->SrcOffset1;
+	DescPtr->DstImgBuf0 = DstImgBuf0;
+	DescPtr->DstImgBuf1 = DstImgBuf1;
+}
+
+/*****************************************************************************/
+/**
+* This function configures the scaler core registers with the specified
+* configuration parameters
+*
+* @param	InstancePtr is a pointer to the core instance to be worked on.
+* @param	MS_cfg is a pointer to the multi scaler config structure.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
+	XV_multi_scaler_Video_Config *MS_cfg)
+{
+	XV_multi_scaler_Desc Desc;
+	u32 i;
+
+	/*
+	* Assert validates the input arguments
+	*/
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(MS_cfg != NULL);
+
+	i = MS_cfg->ChannelId;
+	Xil_AssertVoid(i < InstancePtr->MaxOuts);
+
+	XV_MultiScalerPrepareDesc(InstancePtr, MS_cfg, &Desc);
+	InstancePtr->OutBitMask |= 0x1 << i;
+
+	XV_MultiScalerLoadCoeff(InstancePtr, i,
+		XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_VFLTCOEFF_0_BASE,
+		Desc.VCoeffSet);
+	XV_MultiScalerLoadCoeff(InstancePtr, i,
+		XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_HFLTCOEFF_0_BASE,
+		Desc.HCoeffSet);
+	XV_MultiScalerProgramDesc(InstancePtr, i, &Desc);
+}
+
+/*****************************************************************************/
+/**
+* This function masks the interrupt of the core, so that the job queue can be
+* updated outside of the interrupt handler.
+*
+* @param	MscPtr is a pointer to the core instance to be worked on.
+*
+* @return Global interrupt enable setting, to be passed to
+*	  XV_MultiScalerSchedUnlock()
+*
+******************************************************************************/
+static u32 XV_MultiScalerSchedLock(XV_multi_scaler *MscPtr)
+{
+	u32 Gie;
+
+	Gie = XV_multi_scaler_ReadReg(MscPtr->Ctrl_BaseAddress,
+		XV_MULTI_SCALER_CTRL_ADDR_GIE);
+	XV_multi_scaler_InterruptGlobalDisable(MscPtr);
+
+	return Gie;
+}
+
+/*****************************************************************************/
+/**
+* This function restores the interrupt setting saved by
+* XV_MultiScalerSchedLock()
+*
+* @param	MscPtr is a pointer to the core instance to be worked on.
+* @param	Gie is the value returned by XV_MultiScalerSchedLock().
+*
+* @return None
+*
+******************************************************************************/
+static void XV_MultiScalerSchedUnlock(XV_multi_scaler *MscPtr, u32 Gie)
+{
+	if (Gie & 0x1)
+		XV_multi_scaler_InterruptGlobalEnable(MscPtr);
+}
+
+/*****************************************************************************/
+/**
+* This function starts a run with the oldest queued jobs, up to one per
+* channel. A job is kept on a channel that holds its coefficient sets when
+* possible, the coefficients of the other channels are written when they
+* differ from the loaded ones.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+*
+* @return None
+*
+******************************************************************************/
+static void XV_MultiScalerSchedDispatch(XV_multi_scaler_Sched *SchedPtr)
+{
+	XV_multi_scaler *MscPtr = SchedPtr->MscPtr;
+	XV_multi_scaler_Desc *Jobs[XV_MAX_OUTS];
+	XV_multi_scaler_Desc *DescPtr;
+	u32 Count = 0;
+	u32 i;
+	u32 j;
+
+	/* Take the oldest jobs */
+	while ((SchedPtr->Head != NULL) && (Count < MscPtr->MaxOuts)) {
+		DescPtr = SchedPtr->Head;
+		SchedPtr->Head = DescPtr->Next;
+		DescPtr->Next = NULL;
+		Jobs[Count] = DescPtr;
+		SchedPtr->Run[Count] = NULL;
+		Count++;
+	}
+	if (SchedPtr->Head == NULL)
+		SchedPtr->Tail = NULL;
+
+	SchedPtr->RunCount = Count;
+	if (Count == 0)
+		return;
+
+	/* Keep the jobs on the channels that hold their coefficients */
+	for (j = 0; j < Count; j++) {
+		for (i = 0; i < Count; i++) {
+			if ((SchedPtr->Run[i] == NULL) &&
+			    (SchedPtr->HCoeffLoaded[i] == Jobs[j]->HCoeffSet) &&
+			    (SchedPtr->VCoeffLoaded[i] == Jobs[j]->VCoeffSet)) {
+				SchedPtr->Run[i] = Jobs[j];
+				Jobs[j] = NULL;
+				break;
+			}
+		}
+	}
+
+	/* Give the remaining channels to the other jobs */
+	i = 0;
+	for (j = 0; j < Count; j++) {
+		if (Jobs[j] == NULL)
+			continue;
+		while (SchedPtr->Run[i] != NULL)
+			i++;
+		SchedPtr->Run[i] = Jobs[j];
+	}
+
+	for (i = 0; i < Count; i++) {
+		DescPtr = SchedPtr->Run[i];
+		if (SchedPtr->VCoeffLoaded[i] != DescPtr->VCoeffSet) {
+			XV_MultiScalerLoadCoeff(MscPtr, i,
+				XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_VFLTCOEFF_0_BASE,
+				DescPtr->VCoeffSet);
+			SchedPtr->VCoeffLoaded[i] = DescPtr->VCoeffSet;
+			SchedPtr->CoeffLoads++;
+		}
+		if (SchedPtr->HCoeffLoaded[i] != DescPtr->HCoeffSet) {
+			XV_MultiScalerLoadCoeff(MscPtr, i,
+				XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_HFLTCOEFF_0_BASE,
+				DescPtr->HCoeffSet);
+			SchedPtr->HCoeffLoaded[i] = DescPtr->HCoeffSet;
+			SchedPtr->CoeffLoads++;
+		}
+		XV_MultiScalerProgramDesc(MscPtr, i, DescPtr);
+	}
+
+	XV_multi_scaler_Set_HwReg_num_outs(MscPtr, Count);
+	SchedPtr->Runs++;
+	SchedPtr->Jobs += Count;
+	XV_multi_scaler_Start(MscPtr);
+}
+
+/*****************************************************************************/
+/**
+* This function sets up the job scheduler of a core. Auto restart is disabled
+* and the done interrupt is enabled. XV_MultiScalerSchedIntrHandler() must be
+* connected to the interrupt of the core, with SchedPtr as argument.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+* @param	InstancePtr is a pointer to the core instance to be worked on.
+* @param	DoneCallback is called for each job once it is processed, NULL
+*		for none.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerSchedInit(XV_multi_scaler_Sched *SchedPtr,
+	XV_multi_scaler *InstancePtr, XV_MultiScalerDescCallback DoneCallback)
+{
+	u32 i;
+
+	Xil_AssertVoid(SchedPtr != NULL);
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid((InstancePtr->MaxOuts > 0) &&
+		(InstancePtr->MaxOuts <= XV_MAX_OUTS));
+
+	memset(SchedPtr, 0, sizeof(XV_multi_scaler_Sched));
+	SchedPtr->MscPtr = InstancePtr;
+	SchedPtr->DoneCallback = DoneCallback;
+
+	/* The content of the coefficient memories is unknown */
+	for (i = 0; i < XV_MAX_OUTS; i++) {
+		SchedPtr->HCoeffLoaded[i] = XV_MULTISCALER_NUM_COEFF_SETS;
+		SchedPtr->VCoeffLoaded[i] = XV_MULTISCALER_NUM_COEFF_SETS;
+	}
+
+	XV_multi_scaler_DisableAutoRestart(InstancePtr);
+	XV_multi_scaler_InterruptEnable(InstancePtr,
+		XV_MULTI_SCALER_ISR_DONE_BIT_MASK);
+	XV_multi_scaler_InterruptGlobalEnable(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+* This function appends a chain of jobs to the queue. If the core is idle, a
+* run is started at once. The descriptors belong to the scheduler until their
+* done callback is called.
+*
+* @param	SchedPtr is a pointer to the scheduler.
+* @param	DescPtr is the first descriptor of the chain. The chain ends
+*		with a NULL Next member.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerSchedSubmit(XV_multi_scaler_Sched *SchedPtr,
+	XV_multi_scaler_Desc *DescPtr)
+{
+	XV_multi_scaler_Desc *LastPtr;
+	u32 Gie;
+
+	Xil_AssertVoid(SchedPtr != NULL);
+	Xil_AssertVoid(DescPtr != NULL);
+
+	for (LastPtr = DescPtr; LastPtr->Next != NULL; LastPtr = LastPtr->Next)
+		;
+
+	Gie = XV_MultiScalerSchedLock(SchedPtr->MscPtr);
+
+	if (SchedPtr->Tail != NULL)
+		SchedPtr->Tail->Next = DescPtr;
+	else
+		SchedPtr->Head = DescPtr;
+	SchedPtr->Tail = LastPtr;
+
+	if (SchedPtr->RunCount == 0)
+		XV_MultiScalerSchedDispatch(SchedPtr);
+
+	XV_MultiScalerSchedUnlock(SchedPtr->MscPtr, Gie);
+}
+
+/*****************************************************************************/
+/**
+* This function returns whether the scheduler has no job running or queued
+*
+* @param	SchedPtr is a pointer to the scheduler.
+*
+* @return TRUE if idle, FALSE otherwise
+*
+******************************************************************************/
+u32 XV_MultiScalerSchedIsIdle(XV_multi_scaler_Sched *SchedPtr)
+{
+	Xil_AssertNonvoid(SchedPtr != NULL);
+
+	return ((SchedPtr->RunCount == 0) && (SchedPtr->Head == NULL));
+}
+
+/*****************************************************************************/
+/**
+* This function is the interrupt handler of the job scheduler. On done, the
+* next run is started, then the done callback is called for each job of the
+* run that completed. The callback can submit new jobs.
+*
+* @param	CallbackRef is a pointer to the scheduler.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerSchedIntrHandler(void *CallbackRef)
+{
+	XV_multi_scaler_Sched *SchedPtr = (XV_multi_scaler_Sched *)CallbackRef;
+	XV_multi_scaler_Desc *Done[XV_MAX_OUTS];
+	XV_multi_scaler *MscPtr;
+	u32 Count;
+	u32 i;
+
+	Xil_AssertVoid(SchedPtr != NULL);
+
+	MscPtr = SchedPtr->MscPtr;
+	if (!(XV_multi_scaler_InterruptGetStatus(MscPtr) &
+	      XV_MULTI_SCALER_ISR_DONE_BIT_MASK))
+		return;
+
+	XV_multi_scaler_InterruptClear(MscPtr,
+		XV_MULTI_SCALER_ISR_DONE_BIT_MASK |
+		XV_MULTI_SCALER_ISR_READY_BIT_MASK);
+
+	Count = SchedPtr->RunCount;
+	for (i = 0; i < Count; i++)
+		Done[i] = SchedPtr->Run[i];
+
+	/* Keep the core busy while the callbacks run */
+	XV_MultiScalerSchedDispatch(SchedPtr);
+
+	if (SchedPtr->DoneCallback != NULL) {
+		for (i = 0; i < Count; i++)
+			SchedPtr->DoneCallback(Done[i]->CallbackRef, Done[i]);
 	}
-	XV_MultiScalerSetCoeff(InstancePtr, MS_cfg);
-	XV_MS_Set_WidthOut[i](InstancePtr, MS_cfg->WidthOut);
-	XV_MS_Set_HeightOut[i](InstancePtr, MS_cfg->HeightOut);
-	XV_MS_Set_LineRate[i](InstancePtr, LineRate);
-	XV_MS_Set_PixelRate[i](InstancePtr, PixelRate);
-	XV_MS_Set_ColorFormatIn[i](InstancePtr, MS_cfg->ColorFormatIn);
-	XV_MS_Set_ColorFormatOut[i](InstancePtr, MS_cfg->ColorFormatOut);
-	XV_MS_Set_InStride[i](InstancePtr, MS_cfg->InStride);
-	XV_MS_Set_OutStride[i](InstancePtr, MS_cfg->OutStride);
-	XV_MS_Set_DstImgBuf0[i](InstancePtr, MS_cfg->DstImgBuf0);
-	XV_MS_Set_DstImgBuf1[i](InstancePtr, MS_cfg->DstImgBuf1);
 }
 /** @} */
@@ -41,6 +41,26 @@
 * through callback functions that user has registered. If there are no
 * registered callback functions, then a stub callback function is called.
 *
+* <b> Job Scheduler </b>
+*
+* A job is a descriptor, XV_multi_scaler_Desc, prepared once per stream with
+* XV_MultiScalerPrepareDesc(). The descriptor holds the register values of a
+* channel, including the pixel and line rates, the crop offsets and the
+* coefficient sets, so that only the buffer addresses are updated per frame
+* with XV_MultiScalerDescSetBuffers().
+*
+* XV_MultiScalerSchedSubmit() appends a chain of descriptors, linked through
+* their Next member, to the job queue. The core processes up to MaxOuts jobs
+* per run: each run takes the oldest queued jobs, one per channel. The
+* XV_MultiScalerSchedIntrHandler() interrupt handler programs and starts the
+* next run on done, then calls the done callback of each job of the previous
+* run. A job is given the channel whose coefficient memory already holds its
+* coefficient sets when possible, and the coefficients are written only when
+* they differ from the ones loaded.
+*
+* The scheduler owns the core: XV_MultiScalerStart() and
+* XV_MultiScalerSetChannelConfig() must not be used at the same time.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -75,6 +95,7 @@ extern "C" {
 #define STEP_PRECISION 65536
 #define XVSC_MASK_LOW_16BITS 0x0000FFFF
 #define XVSC_MASK_HIGH_16BITS 0xFFFF0000
+#define XV_MULTISCALER_NUM_COEFF_SETS 4
 
 /**************************** Type Definitions *******************************/
 /**
@@ -143,6 +164,58 @@ typedef struct {
 	XV_multi_scaler_Crop_Window CropWin;
 } XV_multi_scaler_Video_Config;
 
+/**
+ * Prepared channel configuration, see XV_MultiScalerPrepareDesc(). Next and
+ * CallbackRef are set by the application, the other members by the driver.
+ */
+typedef struct XV_multi_scaler_Desc {
+	struct XV_multi_scaler_Desc *Next; /**< Next job of the chain */
+	void *CallbackRef;	/**< Passed to the done callback */
+	UINTPTR SrcImgBuf0;	/**< Source buffer, crop offset included */
+	UINTPTR SrcImgBuf1;	/**< Source UV buffer, crop offset included */
+	UINTPTR DstImgBuf0;	/**< Destination buffer */
+	UINTPTR DstImgBuf1;	/**< Destination UV buffer */
+	u32 SrcOffset0;		/**< Crop offset of the source buffer */
+	u32 SrcOffset1;		/**< Crop offset of the source UV buffer */
+	u32 WidthIn;		/**< Input width, after crop */
+	u32 HeightIn;		/**< Input height, after crop */
+	u32 WidthOut;
+	u32 HeightOut;
+	u32 PixelRate;
+	u32 LineRate;
+	u32 ColorFormatIn;
+	u32 ColorFormatOut;
+	u32 InStride;
+	u32 OutStride;
+	u8 HCoeffSet;		/**< Horizontal coefficient set */
+	u8 VCoeffSet;		/**< Vertical coefficient set */
+} XV_multi_scaler_Desc;
+
+/**
+ * Job done callback of the scheduler
+ */
+typedef void (*XV_MultiScalerDescCallback)(void *CallbackRef,
+	XV_multi_scaler_Desc *DescPtr);
+
+/**
+ * Job scheduler data. The user is required to allocate a variable of this
+ * type for every multi scaler core scheduled.
+ */
+typedef struct {
+	XV_multi_scaler *MscPtr;	/**< Core instance */
+	XV_multi_scaler_Desc *Head;	/**< Oldest queued job */
+	XV_multi_scaler_Desc *Tail;	/**< Newest queued job */
+	XV_multi_scaler_Desc *Run[XV_MAX_OUTS]; /**< Jobs of the current run,
+						     by channel */
+	u32 RunCount;			/**< Number of jobs of the current run */
+	u8 HCoeffLoaded[XV_MAX_OUTS];	/**< Horizontal set of each channel */
+	u8 VCoeffLoaded[XV_MAX_OUTS];	/**< Vertical set of each channel */
+	XV_MultiScalerDescCallback DoneCallback; /**< Job done callback */
+	u32 Runs;			/**< Number of runs started */
+	u32 Jobs;			/**< Number of jobs started */
+	u32 CoeffLoads;			/**< Coefficient sets written */
+} XV_multi_scaler_Sched;
+
 extern const short XV_multiscaler_fixedcoeff_taps6[XV_MULTISCALER_MAX_V_PHASES]
 	[XV_MULTISCALER_TAPS_12];
 extern const short XV_multiscaler_fixedcoeff_taps8[XV_MULTISCALER_MAX_V_PHASES]
@@ -161,6 +234,17 @@ void XV_MultiScalerGetChannelConfig(XV_multi_scaler  *InstancePtr,
 	XV_multi_scaler_Video_Config *multi_scaler_cfg);
 void XV_MultiScalerSetChannelConfig(XV_multi_scaler  *InstancePtr,
 	XV_multi_scaler_Video_Config *multi_scaler_cfg);
+void XV_MultiScalerPrepareDesc(XV_multi_scaler *InstancePtr,
+	XV_multi_scaler_Video_Config *MS_cfg, XV_multi_scaler_Desc *DescPtr);
+void XV_MultiScalerDescSetBuffers(XV_multi_scaler_Desc *DescPtr,
+	UINTPTR SrcImgBuf0, UINTPTR SrcImgBuf1, UINTPTR DstImgBuf0,
+	UINTPTR DstImgBuf1);
+void XV_MultiScalerSchedInit(XV_multi_scaler_Sched *SchedPtr,
+	XV_multi_scaler *InstancePtr, XV_MultiScalerDescCallback DoneCallback);
+void XV_MultiScalerSchedSubmit(XV_multi_scaler_Sched *SchedPtr,
+	XV_multi_scaler_Desc *DescPtr);
+u32 XV_MultiScalerSchedIsIdle(XV_multi_scaler_Sched *SchedPtr);
+void XV_MultiScalerSchedIntrHandler(void *InstancePtr);
 
 #ifdef __cplusplus
 }
@@ -38,6 +38,8 @@
  * ----- ------ -------- -------------------------------------------------------
  * 1.00  jsr    07/17/17  Initial release.
  * 2.00  kar    01/25/18  Second release.
+*       adk    10/15/19  Restart the search in the application selected mode
+*                        and added fast lock mode detection.
  * </pre>
  *
  ******************************************************************************/
@@ -211,6 +213,8 @@ XV_SdiRxSs_Config *CfgPtr, UINTPTR EffectiveAddr)
 	(void)memcpy((void *)&(InstancePtr->Config), (const void *)CfgPtr,
 	sizeof(XV_SdiRxSs_Config));
 	InstancePtr->Config.BaseAddress = EffectiveAddr;
+	InstancePtr->SearchMode = XV_SDIRX_MULTISEARCHMODE;
+	InstancePtr->LastLockedMode = XV_SDIRXSS_MODE_NONE;
 
 	/* Determine sub-cores included in the provided instance of subsystem */
 	XV_SdiRxSs_GetIncludedSubcores(SdiRxSsPtr, CfgPtr->DeviceId);
@@ -253,8 +257,23 @@ static void XV_SdiRxSs_StreamDownCallback(void *CallbackRef)
 	XV_SdiRxSs_Stop(SdiRxSsPtr);
 	XV_SdiRxSs_StreamFlowDisable(SdiRxSsPtr);
 
-	/* TODO: Should only start RX based on earlier SEARCHMODE selection. */
-	XV_SdiRxSs_Start(SdiRxSsPtr, XV_SDIRX_MULTISEARCHMODE);
+	SdiRxSsPtr->LockTicks = 0;
+
+	/* Most input switches return in the same mode, so force the last
+	 * locked mode first rather than stepping through every mode.
+	 */
+	if (SdiRxSsPtr->IsFastLockEnabled &&
+	    (SdiRxSsPtr->SearchMode == XV_SDIRX_MULTISEARCHMODE) &&
+	    (SdiRxSsPtr->LastLockedMode != XV_SDIRXSS_MODE_NONE)) {
+		SdiRxSsPtr->IsFastLockPending = (TRUE);
+		XV_SdiRx_Start(SdiRxSsPtr->SdiRxPtr,
+			(XV_SdiRx_SearchMode)SdiRxSsPtr->LastLockedMode);
+		XV_SdiRxSs_LogWrite(SdiRxSsPtr, XV_SDIRXSS_LOG_EVT_FASTLOCK,
+				SdiRxSsPtr->LastLockedMode);
+	} else {
+		SdiRxSsPtr->IsFastLockPending = (FALSE);
+		XV_SdiRxSs_Start(SdiRxSsPtr, SdiRxSsPtr->SearchMode);
+	}
 	XV_SdiRxSs_LogWrite(SdiRxSsPtr, XV_SDIRXSS_LOG_EVT_STREAMDOWN, 0);
 
 	/* Check if user callback has been registered */
@@ -329,6 +348,18 @@ static void XV_SdiRxSs_StreamUpCallback(void *CallbackRef)
 	/* Set stream up flag */
 	SdiRxSsPtr->IsStreamUp = (TRUE);
 
+	/* Update the lock statistics */
+	SdiRxSsPtr->LastLockedMode = XV_SdiRx_GetSdiMode(SdiRxSsPtr->SdiRxPtr);
+	if (SdiRxSsPtr->IsFastLockPending) {
+		SdiRxSsPtr->IsFastLockPending = (FALSE);
+		SdiRxSsPtr->LockStats.FastLockHits++;
+	}
+	SdiRxSsPtr->LockStats.LockCount++;
+	SdiRxSsPtr->LockStats.LastLockTicks = SdiRxSsPtr->LockTicks;
+	if (SdiRxSsPtr->LockTicks > SdiRxSsPtr->LockStats.MaxLockTicks) {
+		SdiRxSsPtr->LockStats.MaxLockTicks = SdiRxSsPtr->LockTicks;
+	}
+
 	XV_SdiRxSs_LogWrite(SdiRxSsPtr, XV_SDIRXSS_LOG_EVT_STREAMUP, 0);
 
 	/* Check if user callback has been registered */
@@ -398,7 +429,8 @@ void XV_SdiRxSs_Start(XV_SdiRxSs *InstancePtr, XV_SdiRx_SearchMode Mode)
 {
 	Xil_AssertVoid(InstancePtr != NULL);
 
-	/* TODO: Should only start RX based on earlier SEARCHMODE selection. */
+	/* Remember the selection, the stream down handler restarts with it */
+	InstancePtr->SearchMode = Mode;
 	XV_SdiRx_Start(InstancePtr->SdiRxPtr, Mode);
 
 	/* Stat_reset */
@@ -787,3 +819,97 @@ u32 XV_SdiRxSs_WaitforPayLoad(XV_SdiRxSs *InstancePtr)
 
 	return XV_SdiRx_WaitforPayLoad(InstancePtr->SdiRxPtr);
 }
+
+/*****************************************************************************/
+/**
+*
+* This function enables or disables fast lock mode detection. When enabled
+* and XV_SDIRX_MULTISEARCHMODE is selected, the RX is forced into the last
+* locked mode when the stream goes down, and only falls back to the full
+* search from XV_SdiRxSs_ModeDetectTick.
+*
+* @param	InstancePtr pointer to XV_SdiRxSs instance
+* @param	Enable is TRUE to enable fast lock, FALSE to disable it.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XV_SdiRxSs_SetFastLock(XV_SdiRxSs *InstancePtr, u8 Enable)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->IsFastLockEnabled = Enable ? (TRUE) : (FALSE);
+	(void)memset((void *)&InstancePtr->LockStats, 0,
+		sizeof(XV_SdiRxSs_LockStats));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function advances the mode detection timing. It is expected to be
+* called periodically by the application, e.g. from a 100 ms timer. While
+* the stream is down it accumulates the lock time, and falls back to the
+* selected search mode once a fast lock attempt has been pending for
+* XV_SDIRXSS_FASTLOCK_TICKS calls.
+*
+* @param	InstancePtr pointer to XV_SdiRxSs instance
+*
+* @return	None.
+*
+* @note		Must not be called concurrently with the SDI RX interrupt
+*		handler.
+*
+******************************************************************************/
+void XV_SdiRxSs_ModeDetectTick(XV_SdiRxSs *InstancePtr)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if (InstancePtr->IsStreamUp) {
+		return;
+	}
+
+	InstancePtr->LockTicks++;
+
+	if (InstancePtr->IsFastLockPending &&
+	    (InstancePtr->LockTicks >= XV_SDIRXSS_FASTLOCK_TICKS)) {
+		InstancePtr->IsFastLockPending = (FALSE);
+		InstancePtr->LockStats.FastLockMisses++;
+		XV_SdiRxSs_LogWrite(InstancePtr,
+				XV_SDIRXSS_LOG_EVT_FASTLOCK_MISS, 0);
+
+		XV_SdiRxSs_Stop(InstancePtr);
+		XV_SdiRxSs_Start(InstancePtr, InstancePtr->SearchMode);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function prints the SDI RX SS mode detection statistics.
+*
+* @param	InstancePtr pointer to XV_SdiRxSs instance
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XV_SdiRxSs_ReportLockStats(XV_SdiRxSs *InstancePtr)
+{
+	XV_SdiRxSs_LockStats *Stats = &InstancePtr->LockStats;
+
+	xil_printf("SDI RX lock statistics\n\r");
+	xil_printf("------------\n\r");
+	xil_printf("Fast lock:        %s\n\r",
+			InstancePtr->IsFastLockEnabled ? "On" : "Off");
+	xil_printf("Locks:            %d\n\r", Stats->LockCount);
+	xil_printf("Fast lock hits:   %d\n\r", Stats->FastLockHits);
+	xil_printf("Fast lock misses: %d\n\r", Stats->FastLockMisses);
+	xil_printf("Last lock ticks:  %d\n\r", Stats->LastLockTicks);
+	xil_printf("Max lock ticks:   %d\n\r", Stats->MaxLockTicks);
+	xil_printf("\n\r");
+}
@@ -52,6 +52,9 @@
 * Ver   Who    Date     Changes
 * ----- ------ -------- --------------------------------------------------
 * 1.00  jsr    07/17/17 Initial release.
+* 2.00  adk    10/15/19 Added fast lock mode detection which retries the last
+*                       locked mode before falling back to the selected
+*                       search mode, and lock time statistics.
 * </pre>
 *
 ******************************************************************************/
@@ -82,6 +85,17 @@ extern "C" {
 #define XV_SDIRXSS_IER_OVERFLOW_MASK		XV_SDIRX_IER_OVERFLOW_MASK
 #define XV_SDIRXSS_IER_UNDERFLOW_MASK		XV_SDIRX_IER_UNDERFLOW_MASK
 #define XV_SDIRXSS_IER_ALLINTR_MASK		XV_SDIRX_IER_ALLINTR_MASK
+/*@}*/
+
+/** @name Fast lock mode detection
+ * @{
+ */
+#define XV_SDIRXSS_MODE_NONE		0xFF	/**< No mode locked yet */
+#define XV_SDIRXSS_FASTLOCK_TICKS	2	/**< Mode detect ticks spent in
+						  *  the last locked mode before
+						  *  falling back to the
+						  *  selected search mode */
+/*@}*/
 
 /**************************** Type Definitions *******************************/
 /**
@@ -100,6 +114,8 @@ typedef enum {
 	XV_SDIRXSS_LOG_EVT_UNDERFLOW,	/**< Log event Under flow. */
 	XV_SDIRXSS_LOG_EVT_STREAMSTART, /**< Log event Stream Start. */
 	XV_SDIRXSS_LOG_EVT_SETSTREAM,	/**< Log event SDIRXSS Setstream. */
+	XV_SDIRXSS_LOG_EVT_FASTLOCK,	/**< Log event fast lock attempt. */
+	XV_SDIRXSS_LOG_EVT_FASTLOCK_MISS, /**< Log event fast lock fallback. */
 	XV_SDIRXSS_LOG_EVT_DUMMY,	/**< Dummy Event should be last */
 } XV_SdiRxSs_LogEvent;
 
@@ -114,6 +130,20 @@ typedef struct {
 					  Event/DataBuffer. */
 } XV_SdiRxSs_Log;
 
+/**
+ * This typedef contains the mode detection lock statistics. Lock times are
+ * in units of XV_SdiRxSs_ModeDetectTick calls.
+ */
+typedef struct {
+	u32 LockCount;			/**< Num of times the stream locked */
+	u32 FastLockHits;		/**< Num of locks in the last locked
+					  mode */
+	u32 FastLockMisses;		/**< Num of fallbacks to the selected
+					  search mode */
+	u32 LastLockTicks;		/**< Ticks taken by the last lock */
+	u32 MaxLockTicks;		/**< Longest lock time seen */
+} XV_SdiRxSs_LockStats;
+
 
 /**
  * These constants specify different types of handler and used to differentiate
@@ -186,6 +216,15 @@ typedef struct {
 	void *UnderFlowRef;		/**< To be passed to the Under Flow callback */
 
 	u8 IsStreamUp;			/**< SDI RX Stream Up */
+
+	XV_SdiRx_SearchMode SearchMode;	/**< Search mode selected by the
+					  application */
+	u8 IsFastLockEnabled;		/**< Retry the last locked mode first */
+	u8 IsFastLockPending;		/**< Searching in the last locked mode */
+	u8 LastLockedMode;		/**< Last locked mode or
+					  XV_SDIRXSS_MODE_NONE */
+	u32 LockTicks;			/**< Ticks since the stream went down */
+	XV_SdiRxSs_LockStats LockStats;	/**< Mode detection statistics */
 } XV_SdiRxSs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -237,6 +276,9 @@ u8 XV_SdiRxSs_GetTransportBitRate(XV_SdiRxSs *InstancePtr);
 int XV_SdiRxSs_IsStreamUp(XV_SdiRxSs *InstancePtr);
 void XV_SdiRxSs_IntrEnable(XV_SdiRxSs *InstancePtr, u32 IntrMask);
 void XV_SdiRxSs_IntrDisable(XV_SdiRxSs *InstancePtr, u32 IntrMask);
+void XV_SdiRxSs_SetFastLock(XV_SdiRxSs *InstancePtr, u8 Enable);
+void XV_SdiRxSs_ModeDetectTick(XV_SdiRxSs *InstancePtr);
+void XV_SdiRxSs_ReportLockStats(XV_SdiRxSs *InstancePtr);
 
 /* Self test function in xv_sdirxss_selftest.c */
 u32 XV_SdiRxSs_SelfTest(XV_SdiRxSs *InstancePtr);
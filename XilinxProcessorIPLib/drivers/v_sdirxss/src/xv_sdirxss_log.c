@@ -220,6 +220,12 @@ void XV_SdiRxSs_LogDisplay(XV_SdiRxSs *InstancePtr)
 		case (XV_SDIRXSS_LOG_EVT_SETSTREAM):
 			xil_printf("RX Set Stream, with TMDS (%0d)\r\n", Data);
 			break;
+		case (XV_SDIRXSS_LOG_EVT_FASTLOCK):
+			xil_printf("RX Fast lock in mode (%0d)\r\n", Data);
+			break;
+		case (XV_SDIRXSS_LOG_EVT_FASTLOCK_MISS):
+			xil_printf("RX Fast lock missed, full search\r\n");
+			break;
 		default:
 			xil_printf("Unknown event\r\n");
 			break;
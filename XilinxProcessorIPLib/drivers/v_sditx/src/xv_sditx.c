@@ -42,6 +42,8 @@
 	jsr    10/05/18 Moved 3GB specific video modes timing
 			parameters from video common library
 			to SDI common driver
+*       adk    10/15/19 XV_SdiTx_GetPayload reuses the payload computed
+*                       earlier for the same video format.
 * </pre>
 *
 ******************************************************************************/
@@ -719,12 +721,40 @@ u32 XV_SdiTx_GetPayload(XV_SdiTx *InstancePtr, XVidC_VideoMode VideoMode, XSdiVi
 	u16 VActiveValid;
 	const XVidC_VideoTiming *TimingPtr;
 	XVidC_FrameRate FrameRateValid;
+	XV_SdiTx_PayloadKey Key;
+	XV_SdiTx_PayloadCache *Entry;
+	int Index;
 
 	if (SdiMode == XSDIVID_MODE_3GB)
 		InstancePtr->Stream[DataStream].CAssignment = (DataStream << 1);
 	else
 		InstancePtr->Stream[DataStream].CAssignment = 0;
 
+	/* Use the payload computed earlier for the same format, if any */
+	(void)memset((void *)&Key, 0, sizeof(Key));
+	Key.VmId = VideoMode;
+	Key.SdiMode = SdiMode;
+	Key.FrameRate = InstancePtr->Stream[DataStream].Video.FrameRate;
+	Key.ColorFormatId = InstancePtr->Stream[DataStream].Video.ColorFormatId;
+	Key.AspectRatio = InstancePtr->Stream[DataStream].Video.AspectRatio;
+	Key.HActive = InstancePtr->Stream[DataStream].Video.Timing.HActive;
+	Key.F0PVTotal = InstancePtr->Stream[DataStream].Video.Timing.F0PVTotal;
+	Key.DataStream = DataStream;
+	Key.IsFractional = InstancePtr->Transport.IsFractional;
+	Key.IsLevelB3G = InstancePtr->Transport.IsLevelB3G;
+	Key.IsInterlaced = InstancePtr->Stream[DataStream].Video.IsInterlaced;
+	Key.IsPsF = InstancePtr->Stream[DataStream].IsPsF;
+
+	for (Index = 0; Index < XV_SDITX_PAYLOAD_CACHE_SIZE; Index++) {
+		Entry = &InstancePtr->PayloadCache[Index];
+		if (Entry->IsValid &&
+		    (memcmp(&Entry->Key, &Key, sizeof(Key)) == 0)) {
+			InstancePtr->Stream[DataStream].PayloadId = Entry->Payload;
+			InstancePtr->PayloadCacheHits++;
+			return XST_SUCCESS;
+		}
+	}
+
 	TimingPtr = XVidC_GetTimingInfo((u32)VideoMode);
 	if (!TimingPtr) {
 		return XST_FAILURE;
@@ -791,6 +821,15 @@ u32 XV_SdiTx_GetPayload(XV_SdiTx *InstancePtr, XVidC_VideoMode VideoMode, XSdiVi
 	if (SdiMode == XSDIVID_MODE_3GB)
 		Data |= (DataStream << 1) << XSDI_CH_SHIFT;
 	InstancePtr->Stream[DataStream].PayloadId = Data;
+
+	/* Cache it, replacing the oldest entry */
+	Entry = &InstancePtr->PayloadCache[InstancePtr->PayloadCacheNext];
+	Entry->Key = Key;
+	Entry->Payload = Data;
+	Entry->IsValid = 1;
+	InstancePtr->PayloadCacheNext = (InstancePtr->PayloadCacheNext + 1) %
+					XV_SDITX_PAYLOAD_CACHE_SIZE;
+
 	return XST_SUCCESS;
 }
 
@@ -36,6 +36,7 @@
 * 1.00  jsr    07/17/17 Initial release.
 * 	jsr    02/23/2018 YUV420 color format support.
 # 2.0   vve    10/03/18 Add support for ST352 in C Stream
+*       adk    10/15/19 Added ST352 payload cache keyed by video format.
 * </pre>
 *
 ******************************************************************************/
@@ -59,6 +60,7 @@ extern "C" {
 /************************** Constant Definitions *****************************/
 
 #define XV_SDITX_MAX_DATASTREAM 8
+#define XV_SDITX_PAYLOAD_CACHE_SIZE 8	/**< Num of cached ST352 payloads */
 #define XV_SDITX_COLORFORMAT	(0x0 << 16)
 #define XV_SDITX_COLORDEPTH	(0x1 << 24)
 /**************************** Type Definitions *******************************/
@@ -182,6 +184,33 @@ typedef struct {
 	u8 IsPsF;
 } XV_SdiTx_Stream;
 
+/**
+* This typedef contains every input the ST352 payload is derived from.
+*/
+typedef struct {
+	XVidC_VideoMode		VmId;		/**< Video mode */
+	XSdiVid_TransMode	SdiMode;	/**< SDI mode */
+	XVidC_FrameRate		FrameRate;	/**< Stream frame rate */
+	XVidC_ColorFormat	ColorFormatId;	/**< Stream color format */
+	XVidC_AspectRatio	AspectRatio;	/**< Stream aspect ratio */
+	u16			HActive;	/**< Active pixels per line */
+	u16			F0PVTotal;	/**< Field 0 total lines */
+	u8			DataStream;	/**< Data stream number */
+	u8			IsFractional;	/**< Fractional bit rate */
+	u8			IsLevelB3G;	/**< 3G level B */
+	u8			IsInterlaced;	/**< Interlaced stream */
+	u8			IsPsF;		/**< Progressive segmented frame */
+} XV_SdiTx_PayloadKey;
+
+/**
+* This typedef contains a cached ST352 payload.
+*/
+typedef struct {
+	XV_SdiTx_PayloadKey	Key;		/**< Payload inputs */
+	u32			Payload;	/**< ST352 payload */
+	u8			IsValid;	/**< Entry in use */
+} XV_SdiTx_PayloadCache;
+
 /**
 * Callback type for interrupt.
 *
@@ -222,6 +251,10 @@ typedef struct {
   XSdiVid_Transport	Transport;	/**< SDI TX Transport information */
   XV_SdiTx_State	State;		/**< State */
   u8			IsStreamUp;
+
+  XV_SdiTx_PayloadCache	PayloadCache[XV_SDITX_PAYLOAD_CACHE_SIZE];/**< ST352 payloads per video format */
+  u8			PayloadCacheNext;	/**< Next cache entry to replace */
+  u32			PayloadCacheHits;	/**< Num of payloads served from the cache */
 } XV_SdiTx;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -37,6 +37,7 @@
 * Ver   Who    Date     Changes
 * ----- ------ -------- -------------------------------------------------------
 * 1.00   mmo   02/12/16 Initial release.
+* 1.00   adk   10/15/19 Added XVoipFEC_RX_GetStreamStats.
 
 * </pre>
 *
@@ -323,6 +324,40 @@ XVoipFEC_RX_HitlessStatus XVoipFEC_HitlessStatusRegValue
     return (XVoipFEC_RX_HitlessStatus_RegValue);
 }
 
+/*****************************************************************************/
+/**
+*
+* This function reads the packet statistics and the FEC status of a range
+* of channels into the FECStatistic and FECStatus members of ChannelCfg.
+*
+* @param    InstancePtr is a pointer to the XVoipFEC_RX core instance.
+*
+* @param    FirstChannel is the first channel to read
+*
+* @param    NumChannels is the number of channels to read
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+void XVoipFEC_RX_GetStreamStats(XVoipFEC_RX *InstancePtr, u16 FirstChannel,
+                                u16 NumChannels)
+{
+    u16 Index;
+
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid((u32)FirstChannel + NumChannels <=
+                        XVOIPFEC_RX_MAX_CHANNEL);
+
+    for (Index = FirstChannel; Index < FirstChannel + NumChannels; Index++) {
+        InstancePtr->ChannelCfg[Index].FECStatistic =
+                XVoipFEC_RX_FECStatisticsRegValue(InstancePtr, Index);
+        InstancePtr->ChannelCfg[Index].FECStatus =
+                XVoipFEC_RX_FECStatusRegValue(InstancePtr, Index);
+    }
+}
+
 /*****************************************************************************/
 /**
 *
@@ -72,6 +72,7 @@
 * Ver   Who    Date     Changes
 * ----- ------ -------- --------------------------------------------------
 * 1.00   mmo   02/12/16 Initial release.
+* 1.00   adk   10/15/19 Added per channel statistic read back.
 
 * </pre>
 *
@@ -345,6 +346,8 @@ XVoipFEC_RX_FECStatistics XVoipFEC_RX_FECStatisticsRegValue
                              (XVoipFEC_RX *InstancePtr, u16 Channels);
 XVoipFEC_RX_FECParams XVoipFEC_RX_FECParamsRegValue
                              (XVoipFEC_RX *InstancePtr, u16 Channels);
+void XVoipFEC_RX_GetStreamStats(XVoipFEC_RX *InstancePtr, u16 FirstChannel,
+                             u16 NumChannels);
 XVoipFEC_RX_HitlessStatus XVoipFEC_HitlessStatusRegValue
                              (XVoipFEC_RX *InstancePtr, u16 Channels);
 void XVoipFEC_RX_CoreChannelConfig(XVoipFEC_RX *InstancePtr);
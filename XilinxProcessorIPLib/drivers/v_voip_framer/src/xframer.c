@@ -37,6 +37,7 @@
 * Ver   Who    Date     Changes
 * ----- ------ -------- -------------------------------------------------------
 * 1.00   mmo   02/12/16 Initial release.
+* 1.00   adk   10/15/19 Track the programmed channels for the stream table.
 
 * </pre>
 *
@@ -206,6 +207,9 @@ void XFramer_CoreChannelConfig(XFramer *InstancePtr)
 ******************************************************************************/
 void XFramer_ChannelConfig(XFramer *InstancePtr, u16 Channels) {
 
+    /* Written field by field, let XFramer_StreamCommit rewrite it */
+    InstancePtr->ProgrammedMask &= ~((u32)1 << Channels);
+
     /* Select Channels */
     XFramer_ChannelAccess(InstancePtr,Channels);
 
@@ -388,6 +392,9 @@ void XFramer_SoftReset(XFramer *InstancePtr)
     XFramer_WriteReg((InstancePtr)->Config.BaseAddress,
           (XFRAMER_CONTROL),(RegValue &
                   ~(XFRAMER_CONTROL_SOFT_RESET_MASK)));
+
+    /* The channel registers are cleared, nothing is programmed anymore */
+    InstancePtr->ProgrammedMask = 0;
 }
 
 /*****************************************************************************/
@@ -50,6 +50,17 @@
 * - Call XFramer_CfgInitialize to initialize the device and the driver
 *   instance associated with it.
 *
+* <b> Stream Table </b>
+*
+* ChannelCfg[] is the stream table of the core. XFramer_StreamCommit writes
+* every channel whose entry differs from what was last programmed, with one
+* channel select and one channel update per channel instead of one per
+* field, so a gateway only pays for the streams it actually changed.
+* XFramer_StreamAdd and XFramer_StreamRemove program or stop one channel
+* without touching the others, so the remaining streams keep running.
+* XFramer_GetStreamStats reads the transmitted packet counts of a range of
+* channels.
+*
 * <b> Virtual Memory </b>
 *
 *
@@ -71,6 +82,7 @@
 * Ver   Who    Date     Changes
 * ----- ------ -------- --------------------------------------------------
 * 1.00   mmo   02/12/16 Initial release.
+* 1.00   adk   10/15/19 Added the stream table functions in xframer_stream.c.
 
 * </pre>
 *
@@ -196,6 +208,11 @@ typedef struct {
 
     /* Channel Config */
     XFramer_ChannelCfg    ChannelCfg[XFRAMER_MAX_CHANNEL];
+
+    /* Channel Config last written to the core, valid when the channel bit
+     * of ProgrammedMask is set */
+    XFramer_ChannelCfg    Programmed[XFRAMER_MAX_CHANNEL];
+    u32                   ProgrammedMask;
 } XFramer;
 
 
@@ -266,6 +283,16 @@ void XFramer_UDPSrc(XFramer *InstancePtr, u16 Channels);
 u32 XFramer_GetTXPcktCnt(XFramer *InstancePtr, u16 Channels);
 void XFramer_ClearTXPcktCnt(XFramer *InstancePtr, u16 Channels);
 
+/* Stream table functions in xframer_stream.c */
+void XFramer_StreamProgram(XFramer *InstancePtr, u16 Channels);
+u16 XFramer_StreamCommit(XFramer *InstancePtr);
+int XFramer_StreamAdd(XFramer *InstancePtr, u16 Channels,
+    const XFramer_Header *HeaderPtr, XFramerVLANEnable VlanEnable);
+int XFramer_StreamRemove(XFramer *InstancePtr, u16 Channels);
+void XFramer_StreamInvalidate(XFramer *InstancePtr);
+void XFramer_GetStreamStats(XFramer *InstancePtr, u16 FirstChannel,
+    u16 NumChannels, u32 *TxPcktCnt);
+
 
 /************************** Variable Declarations ****************************/
 
@@ -0,0 +1,352 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xframer_stream.c
+*
+* This file contains the stream table functions of the VoIP Framer driver.
+* Please see xframer.h for more details of the driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ------ -------- -------------------------------------------------------
+* 1.00   adk   10/15/19 Initial release.
+
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xframer.h"
+
+/************************** Constant Definitions *****************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/**************************** Type Definitions *******************************/
+
+/************************** Function Prototypes ******************************/
+
+static int XFramer_StreamChanged(const XFramer_ChannelCfg *CfgPtr,
+                                 const XFramer_ChannelCfg *ProgPtr);
+
+/************************** Variable Definitions *****************************/
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function writes all the Channel Space registers of one channel from
+* the stream table, with a single channel select and a single channel update.
+*
+* @param    InstancePtr is a pointer to the XFramer core instance.
+*
+* @param    Channels is the channel to program
+*
+* @return   None.
+*
+* @note     The packet header and the transmit enable take effect together
+*           on the channel update, so the channel never sends packets with
+*           a partially written header.
+*
+******************************************************************************/
+void XFramer_StreamProgram(XFramer *InstancePtr, u16 Channels)
+{
+    XFramer_ChannelCfg *CfgPtr;
+    UINTPTR BaseAddress;
+    u32 RegValue;
+
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid(Channels < XFRAMER_MAX_CHANNEL);
+
+    CfgPtr = &InstancePtr->ChannelCfg[Channels];
+    BaseAddress = InstancePtr->Config.BaseAddress;
+
+    /* Select the Channel */
+    XFramer_ChannelAccess(InstancePtr, Channels);
+
+    XFramer_WriteReg(BaseAddress, XFRAMER_ETH_DEST_ADDR_LOW,
+            CfgPtr->PcktHeader.Dest_MACAddr_Low);
+    XFramer_WriteReg(BaseAddress, XFRAMER_ETH_DEST_ADDR_HIGH,
+            (CfgPtr->PcktHeader.Dest_MACAddr_High &
+                    XFRAMER_ETH_DEST_ADDR_HIGH_MASK));
+
+    RegValue = (((u32)CfgPtr->is_vlan << XFRAMER_VLAN_TAG_INFO_WITH_VLAN_SHIFT)
+                   & XFRAMER_VLAN_TAG_INFO_WITH_VLAN_MASK);
+    if (CfgPtr->is_vlan == XFRAMER_VLAN_ENABLE) {
+        RegValue |= (CfgPtr->PcktHeader.vlan_pcp_cfi_vid &
+                         XFRAMER_VLAN_TAG_INFO_VLAN_ID_MASK);
+    }
+    XFramer_WriteReg(BaseAddress, XFRAMER_VLAN_TAG_INFO, RegValue);
+
+    XFramer_WriteReg(BaseAddress, XFRAMER_MEDIA_IP_VER_TOS_TTL,
+            ((((u32)CfgPtr->PcktHeader.media_tos <<
+                   XFRAMER_IP_VER_TOS_TTL_TOS_SHIFT) &
+                        XFRAMER_IP_VER_TOS_TTL_TOS_MASK) |
+             (CfgPtr->PcktHeader.media_ttl &
+                   XFRAMER_IP_VER_TOS_TTL_TTL_MASK)));
+    XFramer_WriteReg(BaseAddress, XFRAMER_FEC_IP_VER_TOS_TTL,
+            ((((u32)CfgPtr->PcktHeader.fec_tos <<
+                   XFRAMER_IP_VER_TOS_TTL_TOS_SHIFT) &
+                        XFRAMER_IP_VER_TOS_TTL_TOS_MASK) |
+             (CfgPtr->PcktHeader.fec_ttl &
+                   XFRAMER_IP_VER_TOS_TTL_TTL_MASK)));
+
+    XFramer_WriteReg(BaseAddress, XFRAMER_SRC_IP0,
+            CfgPtr->PcktHeader.ip_src_address);
+    XFramer_WriteReg(BaseAddress, XFRAMER_DEST_IP0,
+            CfgPtr->PcktHeader.ip_dest_address);
+    XFramer_WriteReg(BaseAddress, XFRAMER_SOURCE_UDP_PORT,
+            (CfgPtr->PcktHeader.udp_src_port & XFRAMER_SOURCE_UDP_PORT_MASK));
+    XFramer_WriteReg(BaseAddress, XFRAMER_DEST_UDP_PORT,
+            (CfgPtr->PcktHeader.udp_dest_port & XFRAMER_DEST_UDP_PORT_MASK));
+
+    XFramer_WriteReg(BaseAddress, XFRAMER_CHANNEL_CTRL,
+            (CfgPtr->Transmit_Enable &
+                   XFRAMER_CHANNEL_CTRL_TRANSMIT_ENABLE_MASK));
+
+    /* Update the Channels */
+    XFramer_ChannelUpdate(InstancePtr);
+
+    InstancePtr->Programmed[Channels] = *CfgPtr;
+    InstancePtr->ProgrammedMask |= ((u32)1 << Channels);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function programs the channels of the stream table which have
+* changed since they were last programmed.
+*
+* @param    InstancePtr is a pointer to the XFramer core instance.
+*
+* @return   Number of channels programmed.
+*
+* @note     Channels changed with the per field functions, e.g.
+*           XFramer_IP0Dest, are not tracked. Call XFramer_StreamInvalidate
+*           after using them.
+*
+******************************************************************************/
+u16 XFramer_StreamCommit(XFramer *InstancePtr)
+{
+    u16 Index;
+    u16 Count = 0;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+
+    for (Index = (u16)0x00; Index < XFRAMER_MAX_CHANNEL; Index++) {
+        if (((InstancePtr->ProgrammedMask & ((u32)1 << Index)) != 0) &&
+            (!XFramer_StreamChanged(&InstancePtr->ChannelCfg[Index],
+                                    &InstancePtr->Programmed[Index]))) {
+            continue;
+        }
+
+        XFramer_StreamProgram(InstancePtr, Index);
+        Count++;
+    }
+
+    return (Count);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds a stream on one channel while the other channels keep
+* transmitting.
+*
+* @param    InstancePtr is a pointer to the XFramer core instance.
+*
+* @param    Channels is the channel of the stream
+*
+* @param    HeaderPtr is the packet header of the stream
+*
+* @param    VlanEnable selects packets with a VLAN tag
+*
+* @return
+*       - XST_SUCCESS if the stream was added.
+*       - XST_DEVICE_BUSY if the channel is transmitting already.
+*
+* @note     None.
+*
+******************************************************************************/
+int XFramer_StreamAdd(XFramer *InstancePtr, u16 Channels,
+    const XFramer_Header *HeaderPtr, XFramerVLANEnable VlanEnable)
+{
+    XFramer_ChannelCfg *CfgPtr;
+
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(HeaderPtr != NULL);
+    Xil_AssertNonvoid(Channels < XFRAMER_MAX_CHANNEL);
+
+    CfgPtr = &InstancePtr->ChannelCfg[Channels];
+
+    if (CfgPtr->Transmit_Enable == XFRAMER_MODULE_TRANSMIT_ENABLE) {
+        return (XST_DEVICE_BUSY);
+    }
+
+    CfgPtr->PcktHeader = *HeaderPtr;
+    CfgPtr->is_vlan = VlanEnable;
+    CfgPtr->Transmit_Enable = XFRAMER_MODULE_TRANSMIT_ENABLE;
+
+    XFramer_StreamProgram(InstancePtr, Channels);
+
+    return (XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stops the stream of one channel while the other channels
+* keep transmitting. The packet header of the channel is kept.
+*
+* @param    InstancePtr is a pointer to the XFramer core instance.
+*
+* @param    Channels is the channel of the stream
+*
+* @return
+*       - XST_SUCCESS if the stream was removed.
+*       - XST_FAILURE if the channel was not transmitting.
+*
+* @note     None.
+*
+******************************************************************************/
+int XFramer_StreamRemove(XFramer *InstancePtr, u16 Channels)
+{
+    Xil_AssertNonvoid(InstancePtr != NULL);
+    Xil_AssertNonvoid(Channels < XFRAMER_MAX_CHANNEL);
+
+    if (InstancePtr->ChannelCfg[Channels].Transmit_Enable !=
+            XFRAMER_MODULE_TRANSMIT_ENABLE) {
+        return (XST_FAILURE);
+    }
+
+    InstancePtr->ChannelCfg[Channels].Transmit_Enable =
+            XFRAMER_MODULE_TRANSMIT_DISABLE;
+
+    /* Only the channel control register needs to change */
+    XFramer_TransmitEnable(InstancePtr, Channels);
+    InstancePtr->Programmed[Channels].Transmit_Enable =
+            XFRAMER_MODULE_TRANSMIT_DISABLE;
+
+    return (XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function forgets what was programmed, so that the next
+* XFramer_StreamCommit writes all the channels.
+*
+* @param    InstancePtr is a pointer to the XFramer core instance.
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+void XFramer_StreamInvalidate(XFramer *InstancePtr)
+{
+    Xil_AssertVoid(InstancePtr != NULL);
+
+    InstancePtr->ProgrammedMask = 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads the transmitted packet count of a range of channels
+* and stores them in the stream table.
+*
+* @param    InstancePtr is a pointer to the XFramer core instance.
+*
+* @param    FirstChannel is the first channel to read
+*
+* @param    NumChannels is the number of channels to read
+*
+* @param    TxPcktCnt is an array of NumChannels counts, may be NULL
+*
+* @return   None.
+*
+* @note     None.
+*
+******************************************************************************/
+void XFramer_GetStreamStats(XFramer *InstancePtr, u16 FirstChannel,
+    u16 NumChannels, u32 *TxPcktCnt)
+{
+    u16 Index;
+    u32 RegValue;
+
+    Xil_AssertVoid(InstancePtr != NULL);
+    Xil_AssertVoid((u32)FirstChannel + NumChannels <= XFRAMER_MAX_CHANNEL);
+
+    for (Index = (u16)0x00; Index < NumChannels; Index++) {
+        RegValue = XFramer_GetTXPcktCnt(InstancePtr, FirstChannel + Index);
+        InstancePtr->ChannelCfg[FirstChannel + Index].TX_PcktCnt = RegValue;
+        if (TxPcktCnt != NULL) {
+            TxPcktCnt[Index] = RegValue;
+        }
+    }
+}
+
+/*****************************************************************************/
+/**
+*
+* This function compares a stream table entry with what was programmed.
+*
+* @param    CfgPtr is the stream table entry.
+*
+* @param    ProgPtr is the programmed entry.
+*
+* @return   1 if a register of the channel needs to be written, 0 otherwise.
+*
+* @note     The statistic fields are not compared.
+*
+******************************************************************************/
+static int XFramer_StreamChanged(const XFramer_ChannelCfg *CfgPtr,
+                                 const XFramer_ChannelCfg *ProgPtr)
+{
+    const XFramer_Header *Hdr = &CfgPtr->PcktHeader;
+    const XFramer_Header *Prog = &ProgPtr->PcktHeader;
+
+    return ((CfgPtr->Transmit_Enable != ProgPtr->Transmit_Enable) ||
+            (CfgPtr->is_vlan != ProgPtr->is_vlan) ||
+            (Hdr->Dest_MACAddr_Low != Prog->Dest_MACAddr_Low) ||
+            (Hdr->Dest_MACAddr_High != Prog->Dest_MACAddr_High) ||
+            (Hdr->vlan_pcp_cfi_vid != Prog->vlan_pcp_cfi_vid) ||
+            (Hdr->media_ttl != Prog->media_ttl) ||
+            (Hdr->media_tos != Prog->media_tos) ||
+            (Hdr->fec_ttl != Prog->fec_ttl) ||
+            (Hdr->fec_tos != Prog->fec_tos) ||
+            (Hdr->ip_src_address != Prog->ip_src_address) ||
+            (Hdr->ip_dest_address != Prog->ip_dest_address) ||
+            (Hdr->udp_src_port != Prog->udp_src_port) ||
+            (Hdr->udp_dest_port != Prog->udp_dest_port));
+}
@@ -61,6 +61,10 @@
 #define XVSC_MASK_LOW_16BITS       (0x0000FFFF)
 #define XVSC_MASK_HIGH_16BITS      (0xFFFF0000)
 
+/* Coefficient table ids beyond the fixed sets */
+#define XVSC_COEFF_SET_EXT         (XV_VSCALER_NUM_COEFF_SETS)
+#define XVSC_COEFF_SET_NONE        (0xFF)
+
 /**************************** Type Definitions *******************************/
 
 /**************************** Local Global *******************************/
@@ -69,10 +73,31 @@ extern const short XV_vscaler_fixedcoeff_taps8[XV_VSCALER_MAX_V_PHASES][XV_VSCAL
 extern const short XV_vscaler_fixedcoeff_taps10[XV_VSCALER_MAX_V_PHASES][XV_VSCALER_TAPS_10];
 extern const short XV_vscaler_fixedcoeff_taps12[XV_VSCALER_MAX_V_PHASES][XV_VSCALER_TAPS_12];
 
+/* Fixed coefficient tables, indexed by coefficient set id */
+static const short *const XV_VScalerFixedCoeff[XV_VSCALER_NUM_COEFF_SETS] = {
+  &XV_vscaler_fixedcoeff_taps6[0][0],
+  &XV_vscaler_fixedcoeff_taps8[0][0],
+  &XV_vscaler_fixedcoeff_taps10[0][0],
+  &XV_vscaler_fixedcoeff_taps12[0][0]
+};
+
+static const u16 XV_VScalerFixedTaps[XV_VSCALER_NUM_COEFF_SETS] = {
+  XV_VSCALER_TAPS_6,
+  XV_VSCALER_TAPS_8,
+  XV_VSCALER_TAPS_10,
+  XV_VSCALER_TAPS_12
+};
+
 /************************** Function Prototypes ******************************/
-static void XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
-		                          u32 HeightIn,
-		                          u32 HeightOut);
+static u8 XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
+		                        u32 HeightIn,
+		                        u32 HeightOut);
+static void XV_VScalerPadCoeff(XV_Vscaler_l2 *InstancePtr,
+                               u16 num_phases,
+                               u16 num_taps,
+                               const short *Coeff);
+static void XV_VScalerInitCoeffCache(XV_Vscaler_l2 *InstancePtr);
+static void XV_VScalerWriteCoeff(XV_Vscaler_l2 *VscPtr, const u32 *Words);
 
 static void XV_VScalerSetCoeff(XV_Vscaler_l2 *VscPtr);
 
@@ -96,6 +121,13 @@ int XV_VScalerInitialize(XV_Vscaler_l2 *InstancePtr, u16 DeviceId)
   memset(InstancePtr, 0, sizeof(XV_Vscaler_l2));
   Status = XV_vscaler_Initialize(&InstancePtr->Vsc, DeviceId);
 
+  InstancePtr->CoeffLoaded = XVSC_COEFF_SET_NONE;
+  if((Status == XST_SUCCESS) &&
+     (InstancePtr->Vsc.Config.ScalerType == XV_VSCALER_POLYPHASE))
+  {
+    XV_VScalerInitCoeffCache(InstancePtr);
+  }
+
   return(Status);
 }
 
@@ -134,31 +166,29 @@ void XV_VScalerStop(XV_Vscaler_l2 *InstancePtr)
 
 /*****************************************************************************/
 /**
-* This function loads default filter coefficients in the scaler coefficient
-* storage based on the selected TAP configuration
+* This function determines the default filter coefficient table to be used
+* based on the selected TAP configuration
 *
 * @param  InstancePtr is a pointer to the core instance to be worked on.
 * @param  WidthIn is the input stream height
 * @param  Widthout is the output stream height
 
-* @return None
+* @return Id of the fixed coefficient set to use, or XVSC_COEFF_SET_NONE if
+*         the core tap configuration is not supported
 *
 ******************************************************************************/
-static void XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
-		                          u32 HeightIn,
-		                          u32 HeightOut)
+static u8 XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
+		                        u32 HeightIn,
+		                        u32 HeightOut)
 {
-  const short *coeff;
-  u16 numTaps, numPhases;
+  u8 Set;
   u16 ScalingRatio;
   u16 IsScaleDown;
 
   /*
    * validates input arguments
    */
-  Xil_AssertVoid(InstancePtr != NULL);
-
-  numPhases = (1<<InstancePtr->Vsc.Config.PhaseShift);
+  Xil_AssertNonvoid(InstancePtr != NULL);
 
   IsScaleDown = (HeightOut < HeightIn);
   /* Scale Down Mode will use dynamic filter selection logic
@@ -171,66 +201,49 @@ static void XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
     switch(InstancePtr->Vsc.Config.NumTaps)
     {
       case XV_VSCALER_TAPS_6:
-	       coeff = &XV_vscaler_fixedcoeff_taps6[0][0];
-           numTaps = XV_VSCALER_TAPS_6;
+	       Set = 0;
 		   break;
 
       case XV_VSCALER_TAPS_8:
 	       if(ScalingRatio > 15) {
-		     coeff = &XV_vscaler_fixedcoeff_taps8[0][0];
-	         numTaps = XV_VSCALER_TAPS_8;
+		     Set = 1;
 	       } else {// <= 1.5
-	         coeff = &XV_vscaler_fixedcoeff_taps6[0][0];
-	         numTaps = XV_VSCALER_TAPS_6;
+	         Set = 0;
 	       }
 		   break;
 
       case XV_VSCALER_TAPS_10:
 	       if(ScalingRatio > 25) {// >2.5
-		     coeff = &XV_vscaler_fixedcoeff_taps10[0][0];
-	         numTaps = XV_VSCALER_TAPS_10;
+		     Set = 2;
 	       } else if(ScalingRatio > 15) {// 1.6 < ratio <= 2.5
-	         coeff = &XV_vscaler_fixedcoeff_taps8[0][0];
-	         numTaps = XV_VSCALER_TAPS_8;
+	         Set = 1;
 	       } else {// <= 1.5
-	         coeff = &XV_vscaler_fixedcoeff_taps6[0][0];
-	         numTaps = XV_VSCALER_TAPS_6;
+	         Set = 0;
 	       }
            break;
 
     case XV_VSCALER_TAPS_12:
 	       if(ScalingRatio > 35) {// > 3.5
-		     coeff = &XV_vscaler_fixedcoeff_taps12[0][0];
-	         numTaps = XV_VSCALER_TAPS_12;
+		     Set = 3;
 	       } else if(ScalingRatio > 25) {//2.6 < Ratio <= 3.5
-	         coeff = &XV_vscaler_fixedcoeff_taps10[0][0];
-	         numTaps = XV_VSCALER_TAPS_10;
+	         Set = 2;
 	       } else if(ScalingRatio > 15) {//1.6 < Ratio <= 2.5
-	         coeff = &XV_vscaler_fixedcoeff_taps8[0][0];
-	         numTaps = XV_VSCALER_TAPS_8;
+	         Set = 1;
 	       } else {// <= 1.5
-	         coeff = &XV_vscaler_fixedcoeff_taps6[0][0];
-	         numTaps = XV_VSCALER_TAPS_6;
+	         Set = 0;
 	       }
 		   break;
 
 	  default:
-		  return;
+		  return(XVSC_COEFF_SET_NONE);
 	}
   }
   else //Scale Up
   {
-    coeff = &XV_vscaler_fixedcoeff_taps6[0][0];
-    numTaps = XV_VSCALER_TAPS_6;
+    Set = 0;
   }
 
-  XV_VScalerLoadExtCoeff(InstancePtr,
-		                 numPhases,
-		                 numTaps,
-		                 coeff);
-
-  /* Disable use of external coefficients */
-  InstancePtr->UseExtCoeff = FALSE;
+  return(Set);
 }
 
 /*****************************************************************************/
@@ -251,8 +264,6 @@ void XV_VScalerLoadExtCoeff(XV_Vscaler_l2 *InstancePtr,
                             u16 num_taps,
                             const short *Coeff)
 {
-  int i,j, pad, offset;
-
   /*
    * validate input arguments
    */
@@ -273,11 +284,38 @@ void XV_VScalerLoadExtCoeff(XV_Vscaler_l2 *InstancePtr,
 	     return;
   }
 
+  XV_VScalerPadCoeff(InstancePtr, num_phases, num_taps, Coeff);
+
+  /* Enable use of external coefficients and force reload */
+  InstancePtr->UseExtCoeff = TRUE;
+  InstancePtr->CoeffLoaded = XVSC_COEFF_SET_NONE;
+}
+
+/*****************************************************************************/
+/**
+* This function copies a coefficient table into the instance coefficient
+* table, centered and zero padded to the max number of taps
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  num_phases is the number of phases in coefficient table
+* @param  num_taps is the number of taps in coefficient table
+* @param  Coeff is a pointer to the coefficients table
+*
+* @return None
+*
+******************************************************************************/
+static void XV_VScalerPadCoeff(XV_Vscaler_l2 *InstancePtr,
+                               u16 num_phases,
+                               u16 num_taps,
+                               const short *Coeff)
+{
+  int i,j, pad, offset;
+
   //determine if coefficient needs padding (effective vs. max taps)
   pad = XV_VSCALER_MAX_V_TAPS - num_taps;
   offset = ((pad) ? (pad>>1) : 0);
 
-  //Load User defined coefficients into scaler coefficient table
+  //Load coefficients into scaler coefficient table
   for (i = 0; i < num_phases; i++)
   {
     for (j=0; j<num_taps; ++j)
@@ -302,9 +340,54 @@ void XV_VScalerLoadExtCoeff(XV_Vscaler_l2 *InstancePtr,
       }
     }
   }
+}
 
-  /* Enable use of external coefficients */
-  InstancePtr->UseExtCoeff = TRUE;
+/*****************************************************************************/
+/**
+* This function packs every fixed coefficient table usable by the core into
+* the register layout of the coefficient storage, so that switching tables
+* at setup is a plain copy of prepared words
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+*
+* @return None
+*
+* @note   The instance coefficient table is used as scratch and left zeroed
+*
+******************************************************************************/
+static void XV_VScalerInitCoeffCache(XV_Vscaler_l2 *InstancePtr)
+{
+  int num_phases = 1<<InstancePtr->Vsc.Config.PhaseShift;
+  int num_taps   = InstancePtr->Vsc.Config.NumTaps/2;
+  int i,j,offset,rdIndx;
+  u32 *Words;
+  u8 Set;
+
+  offset = (XV_VSCALER_MAX_V_TAPS - InstancePtr->Vsc.Config.NumTaps)/2;
+  for(Set = 0; Set < XV_VSCALER_NUM_COEFF_SETS; Set++)
+  {
+    if(XV_VScalerFixedTaps[Set] > InstancePtr->Vsc.Config.NumTaps)
+    {
+      break;
+    }
+
+    XV_VScalerPadCoeff(InstancePtr, num_phases,
+                       XV_VScalerFixedTaps[Set], XV_VScalerFixedCoeff[Set]);
+
+    Words = InstancePtr->CoeffCache[Set];
+    for (i = 0; i < num_phases; i++)
+    {
+      for(j=0; j < num_taps; j++)
+      {
+        rdIndx = j*2+offset;
+        Words[i*num_taps+j] =
+          ((u32)(u16)InstancePtr->coeff[i][rdIndx+1] << 16) |
+          (u16)InstancePtr->coeff[i][rdIndx];
+      }
+    }
+  }
+
+  memset(InstancePtr->coeff, 0, sizeof(InstancePtr->coeff));
 }
 
 /*****************************************************************************/
@@ -344,6 +427,31 @@ static void XV_VScalerSetCoeff(XV_Vscaler_l2 *VscPtr)
   }
 }
 
+/*****************************************************************************/
+/**
+* This function writes a packed table from the coefficient cache into the
+* core coefficient storage
+*
+* @param  VscPtr is a pointer to the core instance to be worked on.
+* @param  Words is a pointer to the packed table
+*
+* @return None
+*
+******************************************************************************/
+static void XV_VScalerWriteCoeff(XV_Vscaler_l2 *VscPtr, const u32 *Words)
+{
+  int num_words = (1<<VscPtr->Vsc.Config.PhaseShift) *
+                  (VscPtr->Vsc.Config.NumTaps/2);
+  int i;
+  UINTPTR baseAddr;
+
+  baseAddr = XV_vscaler_Get_HwReg_vfltCoeff_BaseAddress(&VscPtr->Vsc);
+  for (i = 0; i < num_words; i++)
+  {
+    Xil_Out32(baseAddr+(i*4), Words[i]);
+  }
+}
+
 /*****************************************************************************/
 /**
 * This function configures the scaler core registers with the specified
@@ -365,6 +473,7 @@ int XV_VScalerSetup(XV_Vscaler_l2  *InstancePtr,
                     u32            ColorFormat)
 {
   u32 LineRate;
+  u8 Set;
 
   /*
    * Assert validates the input arguments
@@ -385,11 +494,20 @@ int XV_VScalerSetup(XV_Vscaler_l2  *InstancePtr,
     if(!InstancePtr->UseExtCoeff) //No user defined coefficients
     {
       /* Determine coefficient table to use */
-      XV_VScalerSelectCoeff(InstancePtr,  HeightIn, HeightOut);
+      Set = XV_VScalerSelectCoeff(InstancePtr,  HeightIn, HeightOut);
+      if((Set != XVSC_COEFF_SET_NONE) && (Set != InstancePtr->CoeffLoaded))
+      {
+        /* Program cached coefficients into the IP register bank */
+        XV_VScalerWriteCoeff(InstancePtr, InstancePtr->CoeffCache[Set]);
+        InstancePtr->CoeffLoaded = Set;
+      }
+    }
+    else if(InstancePtr->CoeffLoaded != XVSC_COEFF_SET_EXT)
+    {
+      /* Program user coefficients into the IP register bank */
+      XV_VScalerSetCoeff(InstancePtr);
+      InstancePtr->CoeffLoaded = XVSC_COEFF_SET_EXT;
     }
-
-    /* Program coefficients into the IP register bank */
-    XV_VScalerSetCoeff(InstancePtr);
   }
 
   LineRate = (HeightIn * STEP_PRECISION)/HeightOut;
@@ -64,6 +64,15 @@
 * Advanced users always have the capability to directly interact with the IP
 * core using Layer-1 API's that perform low level register peek/poke.
 *
+* <b> Coefficient Cache </b>
+*
+* For polyphase cores XV_VScalerInitialize() packs every fixed coefficient
+* table the core can use into register words once, keeping them in the
+* layer 2 instance. XV_VScalerSetup() then only writes the coefficient
+* storage when the scaling ratio selects a different table than the one
+* already loaded. Loading user coefficients with XV_VScalerLoadExtCoeff()
+* invalidates the loaded table so the next setup writes them to the core.
+*
 * <b> Interrupts </b>
 *
 * This driver does not have any interrupts
@@ -110,6 +119,7 @@ extern "C" {
   */
  #define XV_VSCALER_MAX_V_TAPS           (12)
  #define XV_VSCALER_MAX_V_PHASES         (64)
+ #define XV_VSCALER_NUM_COEFF_SETS       (4)
 
 /**************************** Type Definitions *******************************/
 /**
@@ -143,6 +153,9 @@ typedef struct
   XV_vscaler Vsc; /*<< Layer 1 instance */
   u8 UseExtCoeff;
   short coeff[XV_VSCALER_MAX_V_PHASES][XV_VSCALER_MAX_V_TAPS];
+  u32 CoeffCache[XV_VSCALER_NUM_COEFF_SETS]
+                [XV_VSCALER_MAX_V_PHASES*(XV_VSCALER_MAX_V_TAPS/2)]; /*<< Packed fixed coefficient tables */
+  u8 CoeffLoaded; /*<< Coefficient table currently in the core */
 }XV_Vscaler_l2;
 
 /************************** Macros Definitions *******************************/
@@ -76,6 +76,8 @@
  *                       XVphy_SetTxPreEmphasis from xvphy_i.c/h
  *                     Added XVphy_SetTxPostCursor API
  * 1.9   gm   14/05/18 Added XVphy_SetRxLpm from xvphy_i.c/.h
+ *       adk  15/10/19 Added DRP shadow, XVphy_SetTimeStampHandler and
+ *                     XVphy_CfgCacheClear
  *
  * </pre>
  *
@@ -93,6 +95,8 @@
 /**************************** Function Prototypes *****************************/
 static u32 XVphy_DrpAccess(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 		XVphy_DirectionType Dir, u16 Addr, u16 *Val);
+static XVphy_DrpShadowEntry *XVphy_DrpShadowEntryPtr(XVphy *InstancePtr,
+		XVphy_ChannelId ChId, u16 Addr);
 
 /**************************** Function Definitions ****************************/
 
@@ -280,6 +284,66 @@ void XVphy_SetUserTimerHandler(XVphy *InstancePtr,
 	InstancePtr->UserTimerPtr = CallbackRef;
 }
 
+/******************************************************************************/
+/**
+* This function installs a time stamp function, used to time stamp the stages
+* of the HDMI stream up sequence.
+*
+* @param	InstancePtr is a pointer to the XVphy instance.
+* @param	CallbackFunc is the address to the callback function, NULL to
+*		stop time stamping.
+* @param	CallbackRef is the user data item that will be passed to the
+*		callback function when it is invoked.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XVphy_SetTimeStampHandler(XVphy *InstancePtr,
+		XVphy_TimeStampHandler CallbackFunc, void *CallbackRef)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->TimeStampHandler = CallbackFunc;
+	InstancePtr->TimeStampRef = CallbackRef;
+}
+
+/******************************************************************************/
+/**
+* This function empties the PLL and MMCM parameter caches and the DRP shadow.
+*
+* The PLL dividers and MMCM configurations computed for a reference clock and
+* line rate are cached, so that switching back to a known stream skips the
+* search of the divider values. The caches only depend on the core
+* configuration; clearing them is only needed to measure the calculations.
+*
+* @param	InstancePtr is a pointer to the XVphy instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XVphy_CfgCacheClear(XVphy *InstancePtr)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	(void)memset((void *)InstancePtr->PllCache, 0,
+			sizeof(InstancePtr->PllCache));
+	(void)memset((void *)InstancePtr->MmcmCache, 0,
+			sizeof(InstancePtr->MmcmCache));
+	(void)memset((void *)InstancePtr->DrpShadow, 0,
+			sizeof(InstancePtr->DrpShadow));
+	InstancePtr->PllCacheNext = 0;
+	InstancePtr->MmcmCacheNext = 0;
+	InstancePtr->CacheHits = 0;
+	InstancePtr->CacheMisses = 0;
+	InstancePtr->DrpSkipped = 0;
+}
+
 /******************************************************************************/
 /**
 * This function is the delay/sleep function for the XVphy driver. For the Zynq
@@ -1139,9 +1203,33 @@ void XVphy_SetRxLpm(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 u32 XVphy_DrpWr(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 		u16 Addr, u16 Val)
 {
-	return XVphy_DrpAccess(InstancePtr, QuadId, ChId,
+	u32 Status;
+	XVphy_DrpShadowEntry *EntryPtr;
+
+	if (!InstancePtr->DrpShadowIsEnabled) {
+		return XVphy_DrpAccess(InstancePtr, QuadId, ChId,
+				XVPHY_DIR_TX, /* Write. */
+				Addr, &Val);
+	}
+
+	/* Skip the write if the register already holds the value. */
+	EntryPtr = XVphy_DrpShadowEntryPtr(InstancePtr, ChId, Addr);
+	if (EntryPtr->Valid && (EntryPtr->ChId == ChId) &&
+			(EntryPtr->Addr == Addr) && (EntryPtr->Val == Val)) {
+		InstancePtr->DrpSkipped++;
+		return XST_SUCCESS;
+	}
+
+	Status = XVphy_DrpAccess(InstancePtr, QuadId, ChId,
 			XVPHY_DIR_TX, /* Write. */
 			Addr, &Val);
+
+	EntryPtr->Valid = (Status == XST_SUCCESS);
+	EntryPtr->ChId = ChId;
+	EntryPtr->Addr = Addr;
+	EntryPtr->Val = Val;
+
+	return Status;
 }
 
 /*****************************************************************************/
@@ -1168,6 +1256,18 @@ u16 XVphy_DrpRd(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 {
 	u32 Status;
 	u16 Val;
+	XVphy_DrpShadowEntry *EntryPtr;
+
+	/* Registers written by the driver read back from the shadow. */
+	if (InstancePtr->DrpShadowIsEnabled) {
+		EntryPtr = XVphy_DrpShadowEntryPtr(InstancePtr, ChId, Addr);
+		if (EntryPtr->Valid && (EntryPtr->ChId == ChId) &&
+				(EntryPtr->Addr == Addr)) {
+			InstancePtr->DrpSkipped++;
+			*RetVal = EntryPtr->Val;
+			return XST_SUCCESS;
+		}
+	}
 
 	Status = XVphy_DrpAccess(InstancePtr, QuadId, ChId,
 			XVPHY_DIR_RX, /* Read. */
@@ -1178,6 +1278,36 @@ u16 XVphy_DrpRd(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* This function enables or disables the DRP shadow.
+*
+* With the shadow enabled, the last value written to a DRP address is kept:
+* reads of that address are served without a DRP transaction and writes of
+* the value it already holds are skipped. A stream change then only issues the
+* DRP writes of the attributes which actually change. The shadow must only be
+* enabled when the DRP attributes are not modified by other masters.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+* @param	Enable is 1 to enable the shadow, 0 to disable and empty it.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XVphy_DrpShadowEnable(XVphy *InstancePtr, u8 Enable)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if (!Enable) {
+		(void)memset((void *)InstancePtr->DrpShadow, 0,
+				sizeof(InstancePtr->DrpShadow));
+	}
+	InstancePtr->DrpShadowIsEnabled = Enable;
+}
+
 /*****************************************************************************/
 /**
 * This function will power down the mixed-mode clock manager (MMCM) core.
@@ -1792,3 +1922,26 @@ void XVphy_RegisterDebug(XVphy *InstancePtr)
 		}
 	}
 }
+
+/*****************************************************************************/
+/**
+* This function returns the DRP shadow entry an address maps to.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+* @param	ChId is the channel ID of the DRP port.
+* @param	Addr is the DRP address.
+*
+* @return	A pointer to the shadow entry, which may hold another address.
+*
+* @note		None.
+*
+******************************************************************************/
+static XVphy_DrpShadowEntry *XVphy_DrpShadowEntryPtr(XVphy *InstancePtr,
+		XVphy_ChannelId ChId, u16 Addr)
+{
+	u32 Index;
+
+	Index = ((u32)Addr ^ ((u32)ChId << 4)) & (XVPHY_DRP_SHADOW_SIZE - 1);
+
+	return &InstancePtr->DrpShadow[Index];
+}
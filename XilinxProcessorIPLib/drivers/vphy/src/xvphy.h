@@ -97,6 +97,8 @@
  *                     Added XVphy_SetTxPostCursor API
  * 1.9   gm   14/05/18 Added XVphy_SetRxLpm from xvphy_i.c/.h
  *                     Removed deprecated XVphy_HdmiInitialize API
+ *       adk  15/10/19 Added PLL and MMCM parameter caches, DRP shadow and
+ *                     HDMI stream up stage time stamps
  * </pre>
  *
 *******************************************************************************/
@@ -478,6 +480,17 @@ typedef void (*XVphy_Callback)(void *CallbackRef);
  *
 *******************************************************************************/
 typedef void (*XVphy_ErrorCallback)(void *CallbackRef);
+
+/******************************************************************************/
+/**
+ * Time stamp callback type, returning a free running time stamp.
+ *
+ * @param	CallbackRef is a pointer to the callback reference.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+typedef u64 (*XVphy_TimeStampHandler)(void *CallbackRef);
 /**
  * This typedef contains configuration information for CPLL/QPLL programming.
  */
@@ -613,6 +626,70 @@ typedef struct {
 	u16 ClkOut2Div;
 } XVphy_Mmcm;
 
+/**
+ * This typedef contains a PLL divider set computed by XVphy_PllCalculator for
+ * a reference clock and line rate.
+ */
+typedef struct {
+	u64 LineRateHz;				/**< Line rate. */
+	u32 RefClkHz;				/**< PLL input frequency. */
+	u8 PllId;				/**< XVPHY_CHANNEL_ID_CHA for a
+							CPLL, else the QPLL. */
+	u8 Valid;
+	u8 M;
+	u8 N1;
+	u8 N2;
+	u8 D;
+} XVphy_PllCacheEntry;
+
+/**
+ * This typedef contains an MMCM configuration computed by
+ * XVphy_HdmiCfgCalcMmcmParam for a reference clock and line rate.
+ */
+typedef struct {
+	u64 LineRateHz;				/**< Line rate. */
+	u32 RefClkHz;				/**< HDMI reference clock. */
+	u8 Dir;
+	u8 Ppc;
+	u8 Bpc;
+	u8 SampleRate;				/**< TX sample rate. */
+	u8 TmdsClockRatio;			/**< RX TMDS clock ratio. */
+	u8 Valid;
+	XVphy_Mmcm Mmcm;
+} XVphy_MmcmCacheEntry;
+
+/**
+ * This typedef contains the last value written to a DRP address.
+ */
+typedef struct {
+	u16 Addr;
+	u16 Val;
+	u8 ChId;				/**< DRP port. */
+	u8 Valid;
+} XVphy_DrpShadowEntry;
+
+/**
+ * This typedef enumerates the stages of the HDMI stream up sequence which are
+ * time stamped, see XVphy_HdmiGetStageTimes.
+ */
+typedef enum {
+	XVPHY_HDMI_STAGE_FREQ_CHANGE = 0,	/**< Clock detector frequency
+							change. */
+	XVPHY_HDMI_STAGE_RECONFIG,		/**< Timer timeout, PLL
+							parameters calculated
+							and written. */
+	XVPHY_HDMI_STAGE_PLL_LOCK,		/**< GT PLL locked. */
+	XVPHY_HDMI_STAGE_RESET_DONE,		/**< GT reset done. */
+	XVPHY_HDMI_STAGE_MMCM_LOCK,		/**< MMCM locked. */
+	XVPHY_HDMI_STAGE_READY,			/**< Ready callback. */
+	XVPHY_HDMI_STAGE_NUM
+} XVphy_HdmiStage;
+
+#define XVPHY_PLL_CACHE_SIZE	8	/**< Entries in the PLL cache. */
+#define XVPHY_MMCM_CACHE_SIZE	8	/**< Entries in the MMCM cache. */
+#define XVPHY_DRP_SHADOW_SIZE	128	/**< Entries in the DRP shadow, a
+							power of two. */
+
 /**
  * This typedef represents a GT quad.
  */
@@ -827,6 +904,30 @@ typedef struct {
 	void *UserTimerPtr;			/**< Pointer to a timer instance
 							used by the custom user
 							delay/sleep function. */
+	XVphy_PllCacheEntry PllCache[XVPHY_PLL_CACHE_SIZE]; /**< Computed
+							PLL dividers. */
+	u8 PllCacheNext;			/**< Next PLL cache entry to
+							replace. */
+	XVphy_MmcmCacheEntry MmcmCache[XVPHY_MMCM_CACHE_SIZE]; /**< Computed
+							MMCM configurations. */
+	u8 MmcmCacheNext;			/**< Next MMCM cache entry to
+							replace. */
+	u32 CacheHits;				/**< PLL and MMCM calculations
+							served by the caches. */
+	u32 CacheMisses;			/**< PLL and MMCM calculations
+							performed. */
+	XVphy_DrpShadowEntry DrpShadow[XVPHY_DRP_SHADOW_SIZE]; /**< Values
+							written over DRP. */
+	u8 DrpShadowIsEnabled;			/**< The DRP shadow is used. */
+	u32 DrpSkipped;				/**< DRP accesses served by the
+							shadow. */
+	XVphy_TimeStampHandler TimeStampHandler; /**< Time stamp source of the
+							HDMI stage times. */
+	void *TimeStampRef;			/**< To be passed to the time
+							stamp handler. */
+	u64 HdmiStageTime[2][XVPHY_HDMI_STAGE_NUM]; /**< HDMI stream up
+							stage time stamps, per
+							direction. */
 } XVphy;
 
 /**************************** Function Prototypes *****************************/
@@ -846,6 +947,9 @@ u32 XVphy_GetVersion(XVphy *InstancePtr);
 void XVphy_WaitUs(XVphy *InstancePtr, u32 MicroSeconds);
 void XVphy_SetUserTimerHandler(XVphy *InstancePtr,
 		XVphy_TimerHandler CallbackFunc, void *CallbackRef);
+void XVphy_SetTimeStampHandler(XVphy *InstancePtr,
+		XVphy_TimeStampHandler CallbackFunc, void *CallbackRef);
+void XVphy_CfgCacheClear(XVphy *InstancePtr);
 
 /* xvphy.c: Channel configuration functions - setters. */
 u32 XVphy_CfgLineRate(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
@@ -894,6 +998,7 @@ u32 XVphy_DrpWr(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 		u16 Addr, u16 Val);
 u16 XVphy_DrpRd(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
         u16 Addr, u16 *RetVal);
+void XVphy_DrpShadowEnable(XVphy *InstancePtr, u8 Enable);
 void XVphy_MmcmPowerDown(XVphy *InstancePtr, u8 QuadId, XVphy_DirectionType Dir,
 		u8 Hold);
 void XVphy_MmcmStart(XVphy *InstancePtr, u8 QuadId, XVphy_DirectionType Dir);
@@ -953,6 +1058,8 @@ u32 XVphy_SetHdmiRxParam(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId);
 u32 XVphy_HdmiCfgCalcMmcmParam(XVphy *InstancePtr, u8 QuadId,
 		XVphy_ChannelId ChId, XVphy_DirectionType Dir,
 		XVidC_PixelsPerClock Ppc, XVidC_ColorDepth Bpc);
+void XVphy_HdmiGetStageTimes(XVphy *InstancePtr, XVphy_DirectionType Dir,
+		u64 *StampsPtr);
 
 void XVphy_HdmiUpdateClockSelection(XVphy *InstancePtr, u8 QuadId,
 		XVphy_SysClkDataSelType TxSysPllClkSel,
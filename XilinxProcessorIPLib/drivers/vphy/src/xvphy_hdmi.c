@@ -84,6 +84,8 @@
  *                        obtained from CH1 instead of QPLL0/1
  * 1.9   gm   14/05/18 Added TX and RX MMCM lock event logging
  *                     Removed deprecated XVphy_HdmiInitialize API
+ *       adk  15/10/19 Cached the MMCM parameters, added
+ *                     XVphy_HdmiGetStageTimes
  *
  * </pre>
  *
@@ -1117,6 +1119,11 @@ u32 XVphy_HdmiCfgCalcMmcmParam(XVphy *InstancePtr, u8 QuadId,
 	u64 LineRate = 0;
 	XVphy_Mmcm *MmcmPtr;
 	XVphy_PllType PllType;
+	XVphy_MmcmCacheEntry *EntryPtr;
+	u32 CacheRefClk;
+	u8 SampleRate;
+	u8 TmdsClockRatio;
+	u8 Index;
 
 	/* Suppress Warning Messages */
 	ChId = ChId;
@@ -1154,6 +1161,40 @@ u32 XVphy_HdmiCfgCalcMmcmParam(XVphy *InstancePtr, u8 QuadId,
 		return (XST_FAILURE);
 	}
 
+	/* Reuse the configuration found earlier for this stream. */
+	if (Dir == XVPHY_DIR_RX) {
+		CacheRefClk = InstancePtr->HdmiRxRefClkHz;
+		MmcmPtr = &InstancePtr->Quads[QuadId].RxMmcm;
+		SampleRate = 0;
+		TmdsClockRatio = InstancePtr->HdmiRxTmdsClockRatio;
+	}
+	else {
+		CacheRefClk = InstancePtr->HdmiTxRefClkHz;
+		MmcmPtr = &InstancePtr->Quads[QuadId].TxMmcm;
+		SampleRate = InstancePtr->HdmiTxSampleRate;
+		TmdsClockRatio = 0;
+	}
+
+	for (Index = 0; Index < XVPHY_MMCM_CACHE_SIZE; Index++) {
+		EntryPtr = &InstancePtr->MmcmCache[Index];
+		if (EntryPtr->Valid && (EntryPtr->Dir == Dir) &&
+				(EntryPtr->RefClkHz == CacheRefClk) &&
+				(EntryPtr->LineRateHz == LineRate) &&
+				(EntryPtr->Ppc == Ppc) && (EntryPtr->Bpc == Bpc) &&
+				(EntryPtr->SampleRate == SampleRate) &&
+				(EntryPtr->TmdsClockRatio == TmdsClockRatio)) {
+			InstancePtr->CacheHits++;
+			MmcmPtr->DivClkDivide = EntryPtr->Mmcm.DivClkDivide;
+			MmcmPtr->ClkFbOutMult = EntryPtr->Mmcm.ClkFbOutMult;
+			MmcmPtr->ClkOut0Div = EntryPtr->Mmcm.ClkOut0Div;
+			MmcmPtr->ClkOut1Div = EntryPtr->Mmcm.ClkOut1Div;
+			MmcmPtr->ClkOut2Div = EntryPtr->Mmcm.ClkOut2Div;
+			XVphy_CfgErrIntr(InstancePtr, XVPHY_ERR_MMCM_CFG, 0);
+			return (XST_SUCCESS);
+		}
+	}
+	InstancePtr->CacheMisses++;
+
 	Div = 1;
 
 	do {
@@ -1410,6 +1451,19 @@ u32 XVphy_HdmiCfgCalcMmcmParam(XVphy *InstancePtr, u8 QuadId,
 #endif
 
 	if (Valid) {
+		EntryPtr = &InstancePtr->MmcmCache[InstancePtr->MmcmCacheNext];
+		InstancePtr->MmcmCacheNext = (InstancePtr->MmcmCacheNext + 1) %
+			XVPHY_MMCM_CACHE_SIZE;
+		EntryPtr->LineRateHz = LineRate;
+		EntryPtr->RefClkHz = CacheRefClk;
+		EntryPtr->Dir = Dir;
+		EntryPtr->Ppc = Ppc;
+		EntryPtr->Bpc = Bpc;
+		EntryPtr->SampleRate = SampleRate;
+		EntryPtr->TmdsClockRatio = TmdsClockRatio;
+		EntryPtr->Mmcm = *MmcmPtr;
+		EntryPtr->Valid = 1;
+
 		XVphy_CfgErrIntr(InstancePtr, XVPHY_ERR_MMCM_CFG, 0);
 		return (XST_SUCCESS);
 	}
@@ -2194,6 +2248,37 @@ u32 XVphy_SetHdmiRxParam(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* This function returns the time stamps of the last HDMI stream up sequence
+* of a direction, taken with the handler installed by
+* XVphy_SetTimeStampHandler. The sequence starts with the clock detector
+* frequency change; stages not reached yet read as 0.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+* @param	Dir is an indicator for RX or TX.
+* @param	StampsPtr is a pointer to XVPHY_HDMI_STAGE_NUM time stamps,
+*		indexed by XVphy_HdmiStage.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XVphy_HdmiGetStageTimes(XVphy *InstancePtr, XVphy_DirectionType Dir,
+		u64 *StampsPtr)
+{
+	u8 Stage;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(StampsPtr != NULL);
+
+	for (Stage = 0; Stage < XVPHY_HDMI_STAGE_NUM; Stage++) {
+		StampsPtr[Stage] = InstancePtr->HdmiStageTime[Dir][Stage];
+	}
+}
+
 /*****************************************************************************/
 /**
 * This function sets the Pattern Generator for the GT Channel 4 when it is
@@ -59,6 +59,7 @@
  *                       reset GT TX only when PLL and MMCM are locked
  * 1.7   gm   13/09/17 Added GTYE4 support
  * 1.9   gm   14/05/18 Added TX and RX MMCM lock event logging
+ *       adk  15/10/19 Time stamped the HDMI stream up stages
  * </pre>
  *
 *******************************************************************************/
@@ -80,6 +81,8 @@ extern void XVphy_Ch2Ids(XVphy *InstancePtr, XVphy_ChannelId ChId,
 
 static void XVphy_HdmiGtHandler(XVphy *InstancePtr);
 static void XVphy_ClkDetHandler(XVphy *InstancePtr);
+static void XVphy_HdmiStageStamp(XVphy *InstancePtr, XVphy_DirectionType Dir,
+		XVphy_HdmiStage Stage);
 
 /**************************** Function Definitions ****************************/
 
@@ -241,6 +244,8 @@ void XVphy_HdmiQpllLockHandler(XVphy *InstancePtr)
 		if (XVphy_IsPllLocked(InstancePtr, 0, ChId) == XST_SUCCESS) {
 			/* Log, lock */
 			XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_QPLL_LOCK, 1);
+			XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_RX,
+					XVPHY_HDMI_STAGE_PLL_LOCK);
 
 			/* GT RX reset. */
 			XVphy_ResetGtTxRx(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
@@ -290,6 +295,8 @@ void XVphy_HdmiQpllLockHandler(XVphy *InstancePtr)
 		if (XVphy_IsPllLocked(InstancePtr, 0, ChId) == XST_SUCCESS) {
 			/* Log, lock */
 			XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_QPLL_LOCK, 1);
+			XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_TX,
+					XVPHY_HDMI_STAGE_PLL_LOCK);
 #if (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTXE2)
 			if (XVphy_MmcmLocked(InstancePtr, 0, XVPHY_DIR_TX)) {
 #endif
@@ -353,6 +360,8 @@ void XVphy_HdmiGtpPllLockHandler(XVphy *InstancePtr, u8 Pll)
 			XVphy_LogWrite(InstancePtr, (Pll == 0) ?
 				XVPHY_LOG_EVT_PLL0_LOCK :
 				XVPHY_LOG_EVT_PLL1_LOCK, 1);
+			XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_RX,
+					XVPHY_HDMI_STAGE_PLL_LOCK);
 
 			/* GT RX reset. */
 			XVphy_ResetGtTxRx(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
@@ -400,6 +409,8 @@ void XVphy_HdmiGtpPllLockHandler(XVphy *InstancePtr, u8 Pll)
 			XVphy_LogWrite(InstancePtr, (Pll == 0) ?
 					XVPHY_LOG_EVT_PLL0_LOCK :
 					XVPHY_LOG_EVT_PLL1_LOCK, 1);
+			XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_TX,
+					XVPHY_HDMI_STAGE_PLL_LOCK);
 
 			/* GT TX reset. */
 			XVphy_ResetGtTxRx(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
@@ -457,6 +468,8 @@ void XVphy_HdmiCpllLockHandler(XVphy *InstancePtr)
 		if (XVphy_IsPllLocked(InstancePtr, 0, ChId) == XST_SUCCESS) {
 			/* Log, lock */
 			XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_CPLL_LOCK, 1);
+			XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_RX,
+					XVPHY_HDMI_STAGE_PLL_LOCK);
 			/* GT RX reset. */
 			XVphy_ResetGtTxRx(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
 					XVPHY_DIR_RX, FALSE);
@@ -499,6 +512,8 @@ void XVphy_HdmiCpllLockHandler(XVphy *InstancePtr)
 		if (XVphy_IsPllLocked(InstancePtr, 0, ChId) == XST_SUCCESS) {
 			/* Log, lock */
 			XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_CPLL_LOCK, 1);
+			XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_TX,
+					XVPHY_HDMI_STAGE_PLL_LOCK);
 #if (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTXE2)
 			if (XVphy_MmcmLocked(InstancePtr, 0, XVPHY_DIR_TX)) {
 #endif
@@ -538,6 +553,8 @@ void XVphy_HdmiGtTxResetDoneLockHandler(XVphy *InstancePtr)
 	u8 Id, Id0, Id1;
 
 	XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_TX_RST_DONE, 0);
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_TX,
+			XVPHY_HDMI_STAGE_RESET_DONE);
 
 	if ((InstancePtr->Config.XcvrType == XVPHY_GT_TYPE_GTHE3) ||
             (InstancePtr->Config.XcvrType == XVPHY_GT_TYPE_GTHE4) ||
@@ -557,6 +574,8 @@ void XVphy_HdmiGtTxResetDoneLockHandler(XVphy *InstancePtr)
 				XVPHY_GT_STATE_READY;
 
 			/* TX ready callback. */
+			XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_TX,
+					XVPHY_HDMI_STAGE_READY);
 			if (InstancePtr->HdmiTxReadyCallback) {
 				InstancePtr->HdmiTxReadyCallback(
 						InstancePtr->HdmiTxReadyRef);
@@ -603,6 +622,8 @@ void XVphy_HdmiGtTxAlignDoneLockHandler(XVphy *InstancePtr)
 	}
 
 	/* TX ready callback. */
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_TX,
+			XVPHY_HDMI_STAGE_READY);
 	if (InstancePtr->HdmiTxReadyCallback) {
 		InstancePtr->HdmiTxReadyCallback(InstancePtr->HdmiTxReadyRef);
 	}
@@ -624,6 +645,8 @@ void XVphy_HdmiGtRxResetDoneLockHandler(XVphy *InstancePtr)
 	u8 Id, Id0, Id1;
 
 	XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_RX_RST_DONE, 0);
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_RX,
+			XVPHY_HDMI_STAGE_RESET_DONE);
 
 	XVphy_Ch2Ids(InstancePtr, XVPHY_CHANNEL_ID_CHA, &Id0, &Id1);
 	for (Id = Id0; Id <= Id1; Id++) {
@@ -637,6 +660,8 @@ void XVphy_HdmiGtRxResetDoneLockHandler(XVphy *InstancePtr)
 	}
 
 	/* RX ready callback. */
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_RX,
+			XVPHY_HDMI_STAGE_READY);
 	if (InstancePtr->HdmiRxReadyCallback) {
 		InstancePtr->HdmiRxReadyCallback(InstancePtr->HdmiRxReadyRef);
 	}
@@ -681,6 +706,8 @@ void XVphy_HdmiTxClkDetFreqChangeHandler(XVphy *InstancePtr)
 #endif
 
 	XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_TX_FREQ, 0);
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_TX,
+			XVPHY_HDMI_STAGE_FREQ_CHANGE);
 
 	/* Determine PLL type. */
 	PllType = XVphy_GetPllType(InstancePtr, 0, XVPHY_DIR_TX,
@@ -762,6 +789,8 @@ void XVphy_HdmiRxClkDetFreqChangeHandler(XVphy *InstancePtr)
 	u8 Id, Id0, Id1;
 
 	XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_RX_FREQ, 0);
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_RX,
+			XVPHY_HDMI_STAGE_FREQ_CHANGE);
 
 	XVphy_Ch2Ids(InstancePtr, XVPHY_CHANNEL_ID_CHA, &Id0, &Id1);
 	for (Id = Id0; Id <= Id1; Id++) {
@@ -879,6 +908,8 @@ void XVphy_HdmiTxTimerTimeoutHandler(XVphy *InstancePtr)
 #endif
 
 	XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_TX_TMR, 1);
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_TX,
+			XVPHY_HDMI_STAGE_RECONFIG);
 
 	/* Determine PLL type. */
 	PllType = XVphy_GetPllType(InstancePtr, 0, XVPHY_DIR_TX,
@@ -968,6 +999,8 @@ void XVphy_HdmiRxTimerTimeoutHandler(XVphy *InstancePtr)
 	u8 Id, Id0, Id1;
 
 	XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_RX_TMR, 1);
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_RX,
+			XVPHY_HDMI_STAGE_RECONFIG);
 
 	/* Determine PLL type. */
 	PllType = XVphy_GetPllType(InstancePtr, 0, XVPHY_DIR_RX,
@@ -1111,6 +1144,8 @@ void XVphy_HdmiTxMmcmLockHandler(XVphy *InstancePtr)
 #endif
 
 	XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_TXPLL_LOCK, 1);
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_TX,
+			XVPHY_HDMI_STAGE_MMCM_LOCK);
 
 #if (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTXE2)
 	/* Determine PLL type. */
@@ -1155,6 +1190,8 @@ void XVphy_HdmiRxMmcmLockHandler(XVphy *InstancePtr)
 {
 
 	XVphy_LogWrite(InstancePtr, XVPHY_LOG_EVT_RXPLL_LOCK, 1);
+	XVphy_HdmiStageStamp(InstancePtr, XVPHY_DIR_RX,
+			XVPHY_HDMI_STAGE_MMCM_LOCK);
 
 }
 
@@ -1279,4 +1316,37 @@ void XVphy_ClkDetHandler(XVphy *InstancePtr)
 	XVphy_WriteReg(InstancePtr->Config.BaseAddr, XVPHY_INTR_STS_REG,
 			EventAck);
 }
+
+/*****************************************************************************/
+/**
+* This function records the time stamp of an HDMI stream up stage. The stamps
+* of a direction are cleared when a new frequency change starts the sequence.
+*
+* @param	InstancePtr is a pointer to the VPHY instance.
+* @param	Dir is an indicator for TX or RX.
+* @param	Stage is the stage reached.
+*
+* @return	None.
+*
+* @note		Nothing is recorded when no time stamp handler is installed.
+*
+******************************************************************************/
+static void XVphy_HdmiStageStamp(XVphy *InstancePtr, XVphy_DirectionType Dir,
+		XVphy_HdmiStage Stage)
+{
+	u8 Index;
+
+	if (InstancePtr->TimeStampHandler == NULL) {
+		return;
+	}
+
+	if (Stage == XVPHY_HDMI_STAGE_FREQ_CHANGE) {
+		for (Index = 0; Index < XVPHY_HDMI_STAGE_NUM; Index++) {
+			InstancePtr->HdmiStageTime[Dir][Index] = 0;
+		}
+	}
+
+	InstancePtr->HdmiStageTime[Dir][Stage] =
+		InstancePtr->TimeStampHandler(InstancePtr->TimeStampRef);
+}
 #endif
@@ -48,6 +48,7 @@
  *                       XVphy_SetTxPreEmphasis to xvphy.c/h
  *            05/09/18 Added XVphy_GetRefClkSourcesCount API
  * 1.9   gm   11/04/18 Added XVphy_IsHDMI API
+ *       adk  15/10/19 Cached the XVphy_PllCalculator results
  * </pre>
  *
 *******************************************************************************/
@@ -1106,12 +1107,34 @@ u32 XVphy_PllCalculator(XVphy *InstancePtr, u8 QuadId,
 	u64 PllClkInFreqHzIn = PllClkInFreqHz;
 	XVphy_Channel *PllPtr = &InstancePtr->Quads[QuadId].
 		Plls[XVPHY_CH2IDX(ChId)];
+	XVphy_PllCacheEntry *EntryPtr;
+	u8 PllId;
+	u8 MVal, N1Val, N2Val, DVal;
 
 	if (!PllClkInFreqHzIn) {
 		PllClkInFreqHzIn = XVphy_GetQuadRefClkFreq(InstancePtr, QuadId,
 					PllPtr->PllRefClkSel);
 	}
 
+	/* All CPLLs share the same ranges, the QPLLs may differ. */
+	PllId = XVPHY_ISCH(ChId) ? XVPHY_CHANNEL_ID_CHA : ChId;
+
+	/* Reuse the dividers found earlier for this line rate. */
+	for (Id = 0; Id < XVPHY_PLL_CACHE_SIZE; Id++) {
+		EntryPtr = &InstancePtr->PllCache[Id];
+		if (EntryPtr->Valid && (EntryPtr->PllId == PllId) &&
+				(EntryPtr->RefClkHz == PllClkInFreqHzIn) &&
+				(EntryPtr->LineRateHz == PllPtr->LineRateHz)) {
+			InstancePtr->CacheHits++;
+			MVal = EntryPtr->M;
+			N1Val = EntryPtr->N1;
+			N2Val = EntryPtr->N2;
+			DVal = EntryPtr->D;
+			goto calc_apply;
+		}
+	}
+	InstancePtr->CacheMisses++;
+
 	/* Select PLL value table offsets. */
 	const XVphy_GtPllDivs *GtPllDivs;
 	if (XVPHY_ISCH(ChId)) {
@@ -1152,10 +1175,28 @@ u32 XVphy_PllCalculator(XVphy *InstancePtr, u8 QuadId,
 	return XST_FAILURE;
 
 calc_done:
+	MVal = *M;
+	N1Val = *N1;
+	N2Val = *N2;
+	DVal = *D;
+
+	EntryPtr = &InstancePtr->PllCache[InstancePtr->PllCacheNext];
+	InstancePtr->PllCacheNext = (InstancePtr->PllCacheNext + 1) %
+		XVPHY_PLL_CACHE_SIZE;
+	EntryPtr->LineRateHz = PllPtr->LineRateHz;
+	EntryPtr->RefClkHz = PllClkInFreqHzIn;
+	EntryPtr->PllId = PllId;
+	EntryPtr->M = MVal;
+	EntryPtr->N1 = N1Val;
+	EntryPtr->N2 = N2Val;
+	EntryPtr->D = DVal;
+	EntryPtr->Valid = 1;
+
+calc_apply:
 	/* Found the multiplier and divisor values for requested line rate. */
-	PllPtr->PllParams.MRefClkDiv = *M;
-	PllPtr->PllParams.NFbDiv = *N1;
-	PllPtr->PllParams.N2FbDiv = *N2; /* Won't be used for QPLL.*/
+	PllPtr->PllParams.MRefClkDiv = MVal;
+	PllPtr->PllParams.NFbDiv = N1Val;
+	PllPtr->PllParams.N2FbDiv = N2Val; /* Won't be used for QPLL.*/
 	PllPtr->PllParams.IsLowerBand = 1; /* Won't be used for CPLL. */
 
 	if (XVPHY_ISCMN(ChId)) {
@@ -1166,7 +1207,7 @@ calc_done:
 	XVphy_Ch2Ids(InstancePtr, ChId, &Id0, &Id1);
 	for (Id = Id0; Id <= Id1; Id++) {
 		InstancePtr->Quads[QuadId].Plls[XVPHY_CH2IDX(Id)].OutDiv[Dir] =
-			*D;
+			DVal;
 		if (Dir == XVPHY_DIR_RX) {
 			XVphy_CfgSetCdr(InstancePtr, QuadId, (XVphy_ChannelId)Id);
 		}
@@ -0,0 +1,292 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+/******************************************************************************/
+/**
+* @file xdmapcie_dma_loopback_example.c
+*
+* This file contains a throughput benchmark for the H2C and C2H DMA channels
+* of the XDMA engine, run from the firmware of an end point.
+*
+* The example initializes H2C channel 0 and C2H channel 0 with descriptor
+* rings in DDR, copies a host buffer to card memory through the H2C channel
+* and copies it back to a second host buffer through the C2H channel, keeping
+* up to DMA_QUEUE_DEPTH transfers outstanding on each channel, and prints
+* the throughput of both directions.
+*
+* @note
+*
+* The host driver must allocate the two host buffers, enable bus mastering
+* and pass the PCIe addresses of the buffers to the firmware; the addresses
+* below are placeholders, as are the DMA register base and the card buffer,
+* which must match the design. The host compares the two buffers to check
+* the loopback.
+*
+*<pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 1.1	adk	10/15/19	Initial version of the DMA loopback example
+*</pre>
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xparameters.h"	/* Defines for XPAR constants */
+#include "xdmapcie.h"		/* XDmaPcie level 1 interface */
+#include "xdmapcie_dma.h"	/* XDmaPcie DMA channels */
+#include "xil_printf.h"
+#include "xtime_l.h"
+#include "sleep.h"
+
+
+/************************** Constant Definitions ****************************/
+
+/* Parameters for the waiting for link up routine */
+#define XDMAPCIE_LINK_WAIT_MAX_RETRIES 		10
+#define XDMAPCIE_LINK_WAIT_USLEEP_MIN 		90000
+
+#define XDMAPCIE_DEVICE_ID 	XPAR_XDMAPCIE_0_DEVICE_ID
+
+/*
+ * Base address of the DMA registers on the AXI-Lite slave interface
+ */
+#define DMA_BASEADDR		0xA0000000U
+
+/*
+ * PCIe addresses of the host buffers and AXI address of the card buffer
+ */
+#define HOST_SRC_ADDR		0x100000000ULL
+#define HOST_DST_ADDR		0x110000000ULL
+#define CARD_BUF_ADDR		0x10000000ULL
+
+#define DMA_XFER_SIZE		0x10000U	/* Bytes per transfer */
+#define DMA_NUM_XFERS		1024U		/* Transfers per direction */
+#define DMA_QUEUE_DEPTH		16U		/* Outstanding transfers */
+#define DMA_RING_SIZE		64U		/* Descriptors per ring */
+
+
+/**************************** Type Definitions ******************************/
+
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+
+/************************** Function Prototypes *****************************/
+
+int PcieInitEndPoint(XDmaPcie *XdmaPciePtr, u16 DeviceId);
+int DmaRun(XDmaPcie_DmaChan *ChanPtr, u64 SrcAddr, u64 DstAddr,
+		const char *Name);
+
+
+/************************** Variable Definitions ****************************/
+
+/* Allocate PCIe End Point IP Instance */
+XDmaPcie XdmaPcieInstance;
+
+XDmaPcie_DmaChan H2cChan;
+XDmaPcie_DmaChan C2hChan;
+
+/* Descriptor rings */
+XDmaPcie_DmaDesc H2cRing[DMA_RING_SIZE]
+	__attribute__ ((aligned(XDMAPCIE_DMA_DESC_ALIGN)));
+XDmaPcie_DmaDesc C2hRing[DMA_RING_SIZE]
+	__attribute__ ((aligned(XDMAPCIE_DMA_DESC_ALIGN)));
+
+/****************************************************************************/
+/**
+* This function is the entry point for the PCIe DMA loopback example
+*
+* @param 	None
+*
+* @return
+*		- XST_SUCCESS if successful
+*		- XST_FAILURE if unsuccessful.
+*
+* @note 	None.
+*
+*****************************************************************************/
+int main(void)
+{
+	int Status;
+
+	Status = PcieInitEndPoint(&XdmaPcieInstance, XDMAPCIE_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf("XdmaPcie DMA loopback Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	Status = XDmaPcie_DmaChanInit(&H2cChan, DMA_BASEADDR, XDMAPCIE_DMA_H2C,
+			0U, H2cRing, (UINTPTR)H2cRing, DMA_RING_SIZE);
+	if (Status == XST_SUCCESS) {
+		Status = XDmaPcie_DmaChanInit(&C2hChan, DMA_BASEADDR,
+				XDMAPCIE_DMA_C2H, 0U, C2hRing,
+				(UINTPTR)C2hRing, DMA_RING_SIZE);
+	}
+	if (Status != XST_SUCCESS) {
+		xil_printf("DMA channels not found\r\n");
+		return XST_FAILURE;
+	}
+
+	/* Host to card, then back to the second host buffer */
+	Status = DmaRun(&H2cChan, HOST_SRC_ADDR, CARD_BUF_ADDR, "H2C");
+	if (Status == XST_SUCCESS) {
+		Status = DmaRun(&C2hChan, CARD_BUF_ADDR, HOST_DST_ADDR, "C2H");
+	}
+	if (Status != XST_SUCCESS) {
+		xil_printf("XdmaPcie DMA loopback Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran XdmaPcie DMA loopback Example\r\n");
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* This function initializes a XDMA PCIe IP built as an end point and waits
+* for the link to come up
+*
+* @param	XdmaPciePtr is a pointer to an instance of XDmaPcie data
+*		structure represents an end point IP.
+* @param 	DeviceId is XDMA PCIe IP unique ID
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if unsuccessful.
+*
+* @note 	None.
+*
+******************************************************************************/
+int PcieInitEndPoint(XDmaPcie *XdmaPciePtr, u16 DeviceId)
+{
+	int Status;
+	int Retries;
+	XDmaPcie_Config *ConfigPtr;
+
+	ConfigPtr = XDmaPcie_LookupConfig(DeviceId);
+
+	Status = XDmaPcie_CfgInitialize(XdmaPciePtr, ConfigPtr,
+						ConfigPtr->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Failed to initialize PCIe End Point "
+							"IP Instance\r\n");
+		return XST_FAILURE;
+	}
+
+	if (XdmaPciePtr->Config.IncludeRootComplex) {
+		xil_printf("Failed to initialize...XDMA PCIE is configured"
+							" as root complex\r\n");
+		return XST_FAILURE;
+	}
+
+	/* Make sure link is up. */
+	for (Retries = 0; Retries < XDMAPCIE_LINK_WAIT_MAX_RETRIES; Retries++) {
+		if (XDmaPcie_IsLinkUp(XdmaPciePtr)) {
+			return XST_SUCCESS;
+		}
+		usleep(XDMAPCIE_LINK_WAIT_USLEEP_MIN);
+	}
+
+	xil_printf("Link is not up\r\n");
+	return XST_FAILURE;
+}
+
+/****************************************************************************/
+/**
+* This function runs DMA_NUM_XFERS transfers of DMA_XFER_SIZE bytes on a
+* channel, keeping up to DMA_QUEUE_DEPTH of them outstanding, and prints the
+* throughput
+*
+* @param	ChanPtr is the initialized DMA channel.
+* @param	SrcAddr is the address of the source buffer.
+* @param	DstAddr is the address of the destination buffer.
+* @param	Name is the name of the direction to print.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if unsuccessful.
+*
+* @note 	The source and destination buffers are DMA_XFER_SIZE *
+*		DMA_NUM_XFERS bytes long.
+*
+******************************************************************************/
+int DmaRun(XDmaPcie_DmaChan *ChanPtr, u64 SrcAddr, u64 DstAddr,
+		const char *Name)
+{
+	int Status;
+	u32 Submitted = 0U;
+	u32 Completed = 0U;
+	u64 Offset;
+	u64 Bytes;
+	XTime Start;
+	XTime End;
+	u64 Ticks;
+
+	Status = XDmaPcie_DmaStart(ChanPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XTime_GetTime(&Start);
+	while (Completed < DMA_NUM_XFERS) {
+		/* Keep the queue full */
+		while ((Submitted < DMA_NUM_XFERS) &&
+			(XDmaPcie_DmaGetPending(ChanPtr) < DMA_QUEUE_DEPTH)) {
+			Offset = (u64)Submitted * DMA_XFER_SIZE;
+			Status = XDmaPcie_DmaSubmit(ChanPtr, SrcAddr + Offset,
+					DstAddr + Offset, DMA_XFER_SIZE);
+			if (Status == XST_DEVICE_BUSY) {
+				break;
+			}
+			if (Status != XST_SUCCESS) {
+				xil_printf("%s submit failed\r\n", Name);
+				return XST_FAILURE;
+			}
+			Submitted++;
+		}
+
+		Completed += XDmaPcie_DmaPoll(ChanPtr);
+		if (ChanPtr->IsStarted == 0U) {
+			xil_printf("%s DMA error\r\n", Name);
+			return XST_FAILURE;
+		}
+	}
+	XTime_GetTime(&End);
+
+	XDmaPcie_DmaStop(ChanPtr);
+
+	Ticks = (u64)(End - Start);
+	if (Ticks == 0U) {
+		Ticks = 1U;
+	}
+	Bytes = (u64)DMA_XFER_SIZE * DMA_NUM_XFERS;
+	xil_printf("%s: %d transfers of %d bytes, %d MB/s\r\n", Name,
+		DMA_NUM_XFERS, DMA_XFER_SIZE,
+		(u32)((Bytes * COUNTS_PER_SECOND) / (Ticks * 1000000U)));
+
+	return XST_SUCCESS;
+}
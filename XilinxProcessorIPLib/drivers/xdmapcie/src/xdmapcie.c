@@ -36,6 +36,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- ---------------------------------------------------
 * 1.0	tk	01/30/2019	First release
+* 1.1	adk	10/15/19	Added cached enumeration and link up wait on
+*			several root ports.
 * </pre>
 *
 *****************************************************************************/
@@ -43,9 +45,12 @@
 /****************************** Include Files *******************************/
 #include "xdmapcie.h"
 #include "xdmapcie_common.h"
+#include "sleep.h"
 
 /*************************** Constant Definitions ***************************/
 
+#define XDMAPCIE_LINK_POLL_US	1000	/* Link status poll interval */
+
 /***************************** Type Definitions *****************************/
 
 /****************** Macros (Inline Functions) Definitions *******************/
@@ -54,6 +59,13 @@
 
 /*************************** Function Prototypes ****************************/
 
+static void XDmaPcie_TopoAddFunc(XDmaPcie *InstancePtr, u8 Bus, u8 Device,
+				u8 Function, u32 Id);
+static void XDmaPcie_TopoAddWrite(XDmaPcie *InstancePtr, u8 Ecam, u8 Bus,
+				u8 Device, u8 Function, u32 Offset, u32 Data);
+static void XDmaPcie_EnumWrite(XDmaPcie *InstancePtr, u8 Bus, u8 Device,
+				u8 Function, u16 Offset, u32 Data);
+static u32 XDmaPcie_TopoChecksum(XDmaPcie_Topology *TopoPtr);
 
 
 /****************************************************************************/
@@ -283,12 +295,16 @@ static int XDmaPcie_AllocBarSpace(XDmaPcie *InstancePtr, u32 Headertype, u8 Bus,
 			/* Write actual bar address here */
 			XDmaPcie_WriteReg((InstancePtr->Config.Ecam), Location,
 					  Tmp);
+			XDmaPcie_TopoAddWrite(InstancePtr, 1, Bus, Device,
+					Function, Location, Tmp);
 
 			Tmp = (u32)(BarAddr >> 32);
 
 			/* Write actual bar address here */
 			XDmaPcie_WriteReg((InstancePtr->Config.Ecam),
 						Location_1, Tmp);
+			XDmaPcie_TopoAddWrite(InstancePtr, 1, Bus, Device,
+					Function, Location_1, Tmp);
 			XDmaPcie_Dbg(
 				"bus: %d, device: %d, function: %d: BAR %d, "
 				"ADDR: 0x%p size : %dK\r\n",
@@ -310,6 +326,8 @@ static int XDmaPcie_AllocBarSpace(XDmaPcie *InstancePtr, u32 Headertype, u8 Bus,
 			/* Write actual bar address here */
 			XDmaPcie_WriteReg((InstancePtr->Config.Ecam), Location,
 					Tmp);
+			XDmaPcie_TopoAddWrite(InstancePtr, 1, Bus, Device,
+					Function, Location, Tmp);
 			XDmaPcie_Dbg(
 				"bus: %d, device: %d, function: %d: BAR %d, "
 				"ADDR: 0x%p size : %dK\r\n",
@@ -356,7 +374,6 @@ static void XDmaPcie_IncreamentPMem(XDmaPcie *InstancePtr)
 static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 {
 	u32 ConfigData;
-	static u32 LastBusNum;
 
 	u16 PCIeVendorID;
 	u16 PCIeDeviceID;
@@ -409,6 +426,9 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 					"%04X\r\n",
 					PCIeVendorID, PCIeDeviceID);
 
+				XDmaPcie_TopoAddFunc(InstancePtr, BusNum,
+					PCIeDevNum, PCIeFunNum, ConfigData);
+
 				/* Header Type */
 				XDmaPcie_ReadRemoteConfigSpace(
 					InstancePtr, BusNum, PCIeDevNum,
@@ -447,7 +467,7 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 					ConfigData |= (XDMAPCIE_CFG_CMD_BUSM_EN
 						       | XDMAPCIE_CFG_CMD_MEM_EN);
 
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_CMD_STATUS_REG,
@@ -486,11 +506,11 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 					Adr06 |= 0xFF; /* sub ordinate bus no 0xF
 						     */
 					Adr06 <<= TWO_HEX_NIBBLES;
-					Adr06 |= (++LastBusNum); /* secondary
+					Adr06 |= (++InstancePtr->LastBusNum); /* secondary
 							      bus no */
 					Adr06 <<= TWO_HEX_NIBBLES;
 					Adr06 |= BusNum; /* Primary bus no */
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_BUS_NUMS_T1_REG,
@@ -501,7 +521,7 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 					Adr08 |= ((InstancePtr->Config.NpMemBaseAddr
 						   & 0xFFF00000)
 						  >> FOUR_HEX_NIBBLES);
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_NP_MEM_T1_REG, Adr08);
@@ -509,13 +529,13 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 					Adr09 |= ((InstancePtr->Config.PMemBaseAddr
 						   & 0xFFF00000)
 						  >> FOUR_HEX_NIBBLES);
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_P_MEM_T1_REG, Adr09);
 					Adr0A |= (InstancePtr->Config.PMemBaseAddr
 						  >> EIGHT_HEX_NIBBLES);
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_P_UPPER_MEM_T1_REG,
@@ -523,7 +543,7 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 
 					/* Searches secondary bus devices. */
 					XDmaPcie_FetchDevicesInBus(InstancePtr,
-							  LastBusNum);
+						InstancePtr->LastBusNum);
 
 					/*
 					 * update subordinate bus no
@@ -531,9 +551,9 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 					 */
 					Adr06 &= (~(0xFF << FOUR_HEX_NIBBLES));
 					/* setting subordinate bus no */
-					Adr06 |= (LastBusNum
+					Adr06 |= (InstancePtr->LastBusNum
 						  << FOUR_HEX_NIBBLES);
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_BUS_NUMS_T1_REG,
@@ -556,7 +576,7 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 					XDmaPcie_IncreamentNpMem(InstancePtr);
 					Adr08 |= (InstancePtr->Config.NpMemBaseAddr
 						  & 0xFFF00000);
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_NP_MEM_T1_REG, Adr08);
@@ -564,13 +584,13 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 					XDmaPcie_IncreamentPMem(InstancePtr);
 					Adr09 |= (InstancePtr->Config.PMemBaseAddr
 						  & 0xFFF00000);
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_P_MEM_T1_REG, Adr09);
 					Adr0B |= (InstancePtr->Config.PMemBaseAddr
 						  >> EIGHT_HEX_NIBBLES);
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_P_LIMIT_MEM_T1_REG,
@@ -596,7 +616,7 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 					ConfigData |= (XDMAPCIE_CFG_CMD_BUSM_EN
 						       | XDMAPCIE_CFG_CMD_MEM_EN);
 
-					XDmaPcie_WriteRemoteConfigSpace(
+					XDmaPcie_EnumWrite(
 						InstancePtr, BusNum,
 						PCIeDevNum, PCIeFunNum,
 						XDMAPCIE_CFG_CMD_STATUS_REG,
@@ -626,9 +646,284 @@ static void XDmaPcie_FetchDevicesInBus(XDmaPcie *InstancePtr, u32 BusNum)
 *******************************************************************************/
 void XDmaPcie_EnumerateFabric(XDmaPcie *InstancePtr)
 {
+	InstancePtr->LastBusNum = 0;
 	XDmaPcie_FetchDevicesInBus(InstancePtr, 0);
 }
 
+/******************************************************************************/
+/**
+* This function records a function found by the enumeration in the topology
+* being recorded, if any.
+*
+* @param   	InstancePtr pointer to XDmaPcie Instance Pointer
+* @param   	Bus, Device and Function identify the function
+* @param   	Id is the vendor and device ID register of the function
+*
+* @return 	none
+*
+*******************************************************************************/
+static void XDmaPcie_TopoAddFunc(XDmaPcie *InstancePtr, u8 Bus, u8 Device,
+				u8 Function, u32 Id)
+{
+	XDmaPcie_Topology *TopoPtr = InstancePtr->TopoPtr;
+
+	if (TopoPtr == NULL) {
+		return;
+	}
+	if (TopoPtr->NumFuncs >= XDMAPCIE_TOPO_MAX_FUNCS) {
+		TopoPtr->Overflow = 1;
+		return;
+	}
+
+	TopoPtr->Funcs[TopoPtr->NumFuncs].Bus = Bus;
+	TopoPtr->Funcs[TopoPtr->NumFuncs].Device = Device;
+	TopoPtr->Funcs[TopoPtr->NumFuncs].Function = Function;
+	TopoPtr->Funcs[TopoPtr->NumFuncs].Id = Id;
+	TopoPtr->NumFuncs++;
+}
+
+/******************************************************************************/
+/**
+* This function records a configuration write made by the enumeration in the
+* topology being recorded, if any.
+*
+* @param   	InstancePtr pointer to XDmaPcie Instance Pointer
+* @param   	Ecam is 1 for a direct write at Offset from the ECAM base, 0
+*		for a XDmaPcie_WriteRemoteConfigSpace write
+* @param   	Bus, Device and Function identify the function
+* @param   	Offset is the register number or the ECAM offset
+* @param   	Data is the value written
+*
+* @return 	none
+*
+*******************************************************************************/
+static void XDmaPcie_TopoAddWrite(XDmaPcie *InstancePtr, u8 Ecam, u8 Bus,
+				u8 Device, u8 Function, u32 Offset, u32 Data)
+{
+	XDmaPcie_Topology *TopoPtr = InstancePtr->TopoPtr;
+	XDmaPcie_TopoWrite *WritePtr;
+
+	if (TopoPtr == NULL) {
+		return;
+	}
+	if (TopoPtr->NumWrites >= XDMAPCIE_TOPO_MAX_WRITES) {
+		TopoPtr->Overflow = 1;
+		return;
+	}
+
+	WritePtr = &TopoPtr->Writes[TopoPtr->NumWrites];
+	WritePtr->Ecam = Ecam;
+	WritePtr->Bus = Bus;
+	WritePtr->Device = Device;
+	WritePtr->Function = Function;
+	WritePtr->Offset = Offset;
+	WritePtr->Data = Data;
+	TopoPtr->NumWrites++;
+}
+
+/******************************************************************************/
+/**
+* This function writes the configuration space of a function during the
+* enumeration and records the write.
+*
+* @param   	InstancePtr pointer to XDmaPcie Instance Pointer
+* @param   	Bus, Device and Function identify the function
+* @param   	Offset is the register number
+* @param   	Data is the value to write
+*
+* @return 	none
+*
+*******************************************************************************/
+static void XDmaPcie_EnumWrite(XDmaPcie *InstancePtr, u8 Bus, u8 Device,
+				u8 Function, u16 Offset, u32 Data)
+{
+	XDmaPcie_WriteRemoteConfigSpace(InstancePtr, Bus, Device, Function,
+					Offset, Data);
+	XDmaPcie_TopoAddWrite(InstancePtr, 0, Bus, Device, Function, Offset,
+					Data);
+}
+
+/******************************************************************************/
+/**
+* This function computes the checksum of a topology cache.
+*
+* @param   	TopoPtr pointer to the topology
+*
+* @return 	sum of all the words of the topology that follow the checksum
+*
+*******************************************************************************/
+static u32 XDmaPcie_TopoChecksum(XDmaPcie_Topology *TopoPtr)
+{
+	u32 *WordPtr = (u32 *)&TopoPtr->Ecam;
+	u32 *EndPtr = (u32 *)(TopoPtr + 1);
+	u32 Sum = 0;
+
+	while (WordPtr < EndPtr) {
+		Sum = (Sum << 1) + (Sum >> 31) + *WordPtr;
+		WordPtr++;
+	}
+
+	return Sum;
+}
+
+/******************************************************************************/
+/**
+* This function enumerates the PCIe fabric using a topology cache.
+*
+* If TopoPtr holds a valid topology recorded for the same ECAM base and
+* memory windows, the vendor and device IDs of the recorded functions are
+* read back and, when they all match, the recorded configuration writes are
+* replayed. Otherwise the fabric is enumerated with XDmaPcie_EnumerateFabric
+* and the result is recorded in TopoPtr for the next boot.
+*
+* @param   	InstancePtr pointer to XDmaPcie Instance Pointer
+* @param   	TopoPtr pointer to the topology cache, in memory preserved
+*		across warm boots
+*
+* @return 	- XST_SUCCESS if the cached topology was used
+*		- XST_NO_DATA if the fabric was enumerated
+*
+*******************************************************************************/
+int XDmaPcie_EnumerateFabricCached(XDmaPcie *InstancePtr,
+					XDmaPcie_Topology *TopoPtr)
+{
+	XDmaPcie_TopoFunc *FuncPtr;
+	XDmaPcie_TopoWrite *WritePtr;
+	u32 ConfigData;
+	u32 Index;
+	u32 Match = 0;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(TopoPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if ((TopoPtr->Magic == XDMAPCIE_TOPO_MAGIC) &&
+	    (TopoPtr->Checksum == XDmaPcie_TopoChecksum(TopoPtr)) &&
+	    (TopoPtr->Ecam == InstancePtr->Config.Ecam) &&
+	    (TopoPtr->NpMemStart == InstancePtr->Config.NpMemBaseAddr) &&
+	    (TopoPtr->PMemStart == InstancePtr->Config.PMemBaseAddr) &&
+	    (TopoPtr->NumFuncs <= XDMAPCIE_TOPO_MAX_FUNCS) &&
+	    (TopoPtr->NumWrites <= XDMAPCIE_TOPO_MAX_WRITES)) {
+		/* Only read back the functions expected to be there */
+		Match = 1;
+		for (Index = 0; Index < TopoPtr->NumFuncs; Index++) {
+			FuncPtr = &TopoPtr->Funcs[Index];
+			XDmaPcie_ReadRemoteConfigSpace(InstancePtr,
+				FuncPtr->Bus, FuncPtr->Device,
+				FuncPtr->Function, XDMAPCIE_CFG_ID_REG,
+				&ConfigData);
+			if (ConfigData != FuncPtr->Id) {
+				XDmaPcie_Dbg("Topology changed at %02X:%02X.%X"
+					"\r\n", FuncPtr->Bus, FuncPtr->Device,
+					FuncPtr->Function);
+				Match = 0;
+				break;
+			}
+		}
+	}
+
+	if (Match != 0) {
+		for (Index = 0; Index < TopoPtr->NumWrites; Index++) {
+			WritePtr = &TopoPtr->Writes[Index];
+			if (WritePtr->Ecam != 0) {
+				XDmaPcie_WriteReg((InstancePtr->Config.Ecam),
+					WritePtr->Offset, WritePtr->Data);
+			} else {
+				XDmaPcie_WriteRemoteConfigSpace(InstancePtr,
+					WritePtr->Bus, WritePtr->Device,
+					WritePtr->Function,
+					(u16)WritePtr->Offset, WritePtr->Data);
+			}
+		}
+		InstancePtr->Config.NpMemBaseAddr = TopoPtr->NpMemEnd;
+		InstancePtr->Config.PMemBaseAddr = TopoPtr->PMemEnd;
+		InstancePtr->LastBusNum = TopoPtr->LastBusNum;
+		return XST_SUCCESS;
+	}
+
+	/* Enumerate and record */
+	memset(TopoPtr, 0, sizeof(XDmaPcie_Topology));
+	TopoPtr->Ecam = InstancePtr->Config.Ecam;
+	TopoPtr->NpMemStart = InstancePtr->Config.NpMemBaseAddr;
+	TopoPtr->PMemStart = InstancePtr->Config.PMemBaseAddr;
+
+	InstancePtr->TopoPtr = TopoPtr;
+	XDmaPcie_EnumerateFabric(InstancePtr);
+	InstancePtr->TopoPtr = NULL;
+
+	TopoPtr->NpMemEnd = InstancePtr->Config.NpMemBaseAddr;
+	TopoPtr->PMemEnd = InstancePtr->Config.PMemBaseAddr;
+	TopoPtr->LastBusNum = InstancePtr->LastBusNum;
+	if (TopoPtr->Overflow == 0) {
+		TopoPtr->Checksum = XDmaPcie_TopoChecksum(TopoPtr);
+		TopoPtr->Magic = XDMAPCIE_TOPO_MAGIC;
+	}
+
+	return XST_NO_DATA;
+}
+
+/******************************************************************************/
+/**
+* This function invalidates a topology cache, so that the next
+* XDmaPcie_EnumerateFabricCached call enumerates the fabric.
+*
+* @param   	TopoPtr pointer to the topology cache
+*
+* @return 	none
+*
+*******************************************************************************/
+void XDmaPcie_InvalidateTopology(XDmaPcie_Topology *TopoPtr)
+{
+	Xil_AssertVoid(TopoPtr != NULL);
+
+	TopoPtr->Magic = 0;
+}
+
+/******************************************************************************/
+/**
+* This function waits for the links of several root ports to come up. The
+* links are polled together, so the wait lasts as long as the slowest link
+* instead of the sum of the link training times.
+*
+* @param   	InstancePtrs array of XDmaPcie Instance Pointers
+* @param   	NumInstances number of instances in the array, 32 at most
+* @param   	TimeoutUs time to wait, in micro seconds
+*
+* @return 	bit mask of the instances whose link is up, bit n for
+*		InstancePtrs[n]
+*
+*******************************************************************************/
+u32 XDmaPcie_WaitLinkUpAll(XDmaPcie **InstancePtrs, u32 NumInstances,
+					u32 TimeoutUs)
+{
+	u32 Index;
+	u32 LinkUp = 0;
+	u32 AllUp;
+	u32 Waited = 0;
+
+	Xil_AssertNonvoid(InstancePtrs != NULL);
+	Xil_AssertNonvoid((NumInstances > 0) && (NumInstances <= 32));
+
+	AllUp = (NumInstances == 32) ? DATA_MASK_32 :
+			((1U << NumInstances) - 1U);
+
+	while (1) {
+		for (Index = 0; Index < NumInstances; Index++) {
+			if (((LinkUp & (1U << Index)) == 0) &&
+			    XDmaPcie_IsLinkUp(InstancePtrs[Index])) {
+				LinkUp |= (1U << Index);
+			}
+		}
+		if ((LinkUp == AllUp) || (Waited >= TimeoutUs)) {
+			break;
+		}
+		usleep(XDMAPCIE_LINK_POLL_US);
+		Waited += XDMAPCIE_LINK_POLL_US;
+	}
+
+	return LinkUp;
+}
+
 /****************************************************************************/
 /**
 * This API is used to read the VSEC Capability Register.
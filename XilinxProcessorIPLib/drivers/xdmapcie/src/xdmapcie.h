@@ -36,6 +36,22 @@
 * The driver provides its user with entry points
 *   - To initialize and configure itself and the hardware
 *   - To access PCIe configuration space locally
+*   - To move data through the H2C and C2H DMA channels of an end point,
+*     see xdmapcie_dma.h
+*
+* <b>Enumeration</b>
+*
+* XDmaPcie_EnumerateFabric() probes every bus, device and function behind a
+* root port. XDmaPcie_EnumerateFabricCached() records the functions found and
+* the configuration writes made in a XDmaPcie_Topology, which the user keeps
+* in memory that survives a warm boot. On the next boot only the vendor and
+* device IDs of the recorded functions are read back and, when they all
+* match, the recorded writes are replayed instead of probing the fabric.
+* Devices added to previously empty slots are not noticed until the cache is
+* invalidated with XDmaPcie_InvalidateTopology().
+*
+* XDmaPcie_WaitLinkUpAll() waits for the links of several root ports at
+* once, so that their link training overlaps.
 *
 * <b>Driver Initialization & Configuration</b>
 *
@@ -70,6 +86,9 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- ---------------------------------------------------
 * 1.0	tk	01/30/2019	First release
+* 1.1	adk	10/15/19	Added the H2C/C2H DMA channel API.
+*			Added cached enumeration and XDmaPcie_WaitLinkUpAll,
+*			made the bus number counter per instance.
 * </pre>
 *
 *****************************************************************************/
@@ -104,6 +123,13 @@ extern "C" {
  */
 #define ALIGN_4KB		0xFFFFF000
 
+/*
+ * Topology cache sizes
+ */
+#define XDMAPCIE_TOPO_MAX_FUNCS		64  /**< Functions recorded */
+#define XDMAPCIE_TOPO_MAX_WRITES	512 /**< Config writes recorded */
+#define XDMAPCIE_TOPO_MAGIC		0x58504354U /**< Valid cache */
+
 /*
  * Version Specific Enhanced Capability register numbers.
  */
@@ -136,6 +162,48 @@ typedef  struct {
 	u64	PMemMaxAddr;	/**< prefetchable memory max base address */
 } XDmaPcie_Config;
 
+/**
+ * Function found by the enumeration.
+ */
+typedef struct {
+	u8 Bus;				/**< Bus number */
+	u8 Device;			/**< Device number */
+	u8 Function;			/**< Function number */
+	u32 Id;				/**< Vendor and device ID */
+} XDmaPcie_TopoFunc;
+
+/**
+ * Configuration write made by the enumeration.
+ */
+typedef struct {
+	u8 Ecam;			/**< Direct ECAM write at Offset */
+	u8 Bus;				/**< Bus number */
+	u8 Device;			/**< Device number */
+	u8 Function;			/**< Function number */
+	u32 Offset;			/**< Register or ECAM offset */
+	u32 Data;			/**< Value written */
+} XDmaPcie_TopoWrite;
+
+/**
+ * Topology cache. The user allocates it in memory which is preserved across
+ * warm boots and passes it to XDmaPcie_EnumerateFabricCached().
+ */
+typedef struct {
+	u32 Magic;			/**< XDMAPCIE_TOPO_MAGIC when valid */
+	u32 Checksum;			/**< Sum of the words that follow */
+	u64 Ecam;			/**< ECAM base the cache is for */
+	u32 NpMemStart;			/**< NP memory base before enumeration */
+	u64 PMemStart;			/**< P memory base before enumeration */
+	u32 NpMemEnd;			/**< NP memory base after enumeration */
+	u64 PMemEnd;			/**< P memory base after enumeration */
+	u32 LastBusNum;			/**< Last bus number assigned */
+	u32 NumFuncs;			/**< Entries in Funcs */
+	u32 NumWrites;			/**< Entries in Writes */
+	u32 Overflow;			/**< Set when an array was too small */
+	XDmaPcie_TopoFunc Funcs[XDMAPCIE_TOPO_MAX_FUNCS];
+	XDmaPcie_TopoWrite Writes[XDMAPCIE_TOPO_MAX_WRITES];
+} XDmaPcie_Topology;
+
 /**
  * The XDmaPcie driver instance data. The user is required to allocate a
  * variable of this type for every PCIe device in the system that will be
@@ -148,6 +216,9 @@ typedef struct {
 	u32 IsReady;			/**< Is IP been initialized and ready */
 	u32 MaxNumOfBuses;		/**< If this is RC IP, Max Number of
 					 * Buses */
+	u32 LastBusNum;			/**< Last bus number assigned by the
+					 * enumeration */
+	XDmaPcie_Topology *TopoPtr;	/**< Topology being recorded */
 
 } XDmaPcie;
 
@@ -264,6 +335,11 @@ void XDmaPcie_WriteRemoteConfigSpace(XDmaPcie *InstancePtr, u8 Bus, u8 Device,
 u32 XDmaPcie_ComposeExternalConfigAddress(u8 Bus, u8 Device, u8 Function,
 								 u16 Offset);
 void XDmaPcie_EnumerateFabric(XDmaPcie *XdmaPciePtr);
+int XDmaPcie_EnumerateFabricCached(XDmaPcie *InstancePtr,
+					XDmaPcie_Topology *TopoPtr);
+void XDmaPcie_InvalidateTopology(XDmaPcie_Topology *TopoPtr);
+u32 XDmaPcie_WaitLinkUpAll(XDmaPcie **InstancePtrs, u32 NumInstances,
+					u32 TimeoutUs);
 
 /*
  * Interrupt Functions.
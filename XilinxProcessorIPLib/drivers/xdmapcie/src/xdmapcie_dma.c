@@ -0,0 +1,560 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+/******************************************************************************/
+/**
+* @file xdmapcie_dma.c
+*
+* Implements the H2C and C2H DMA channel functions of the XDmaPcie driver.
+* See xdmapcie_dma.h for a description of the descriptor rings.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 1.1	adk	10/15/19	First release
+* </pre>
+*
+******************************************************************************/
+
+/****************************** Include Files ********************************/
+#include "xdmapcie_dma.h"
+
+/*************************** Constant Definitions ****************************/
+
+#define XDMAPCIE_DMA_STOP_TIMEOUT	1000000U /**< Busy polls on stop */
+
+/***************************** Type Definitions ******************************/
+
+/****************** Macros (Inline Functions) Definitions ********************/
+
+/*************************** Variable Definitions ****************************/
+
+/*************************** Function Prototypes *****************************/
+
+static u32 XDmaPcie_DmaReap(XDmaPcie_DmaChan *ChanPtr, u32 Status);
+static void XDmaPcie_DmaAbort(XDmaPcie_DmaChan *ChanPtr);
+
+/*****************************************************************************/
+/**
+* Initialize a DMA channel and link its descriptor ring. The channel is left
+* stopped.
+*
+* @param	ChanPtr is the channel instance to initialize.
+* @param	DmaBaseAddr is the base address of the DMA registers.
+* @param	Dir is XDMAPCIE_DMA_H2C or XDMAPCIE_DMA_C2H.
+* @param	ChanId is the channel number.
+* @param	Ring is the descriptor ring, XDMAPCIE_DMA_DESC_ALIGN aligned.
+* @param	RingAddr is the address of the ring for the DMA engine.
+* @param	RingSize is the number of descriptors in the ring, a power
+*		of 2.
+*
+* @return
+*		- XST_SUCCESS if the channel is initialized
+*		- XST_DEVICE_NOT_FOUND if the channel is not in the hardware
+*
+* @note		None.
+*
+******************************************************************************/
+int XDmaPcie_DmaChanInit(XDmaPcie_DmaChan *ChanPtr, UINTPTR DmaBaseAddr,
+		u32 Dir, u32 ChanId, XDmaPcie_DmaDesc *Ring, u64 RingAddr,
+		u32 RingSize)
+{
+	u32 Id;
+	u32 Index;
+	u32 NumH2c = 0U;
+	u64 NextAddr;
+
+	Xil_AssertNonvoid(ChanPtr != NULL);
+	Xil_AssertNonvoid(Ring != NULL);
+	Xil_AssertNonvoid(Dir <= XDMAPCIE_DMA_C2H);
+	Xil_AssertNonvoid(ChanId < XDMAPCIE_DMA_MAX_CHANNELS);
+	Xil_AssertNonvoid(RingSize >= 2U);
+	Xil_AssertNonvoid((RingSize & (RingSize - 1U)) == 0U);
+	Xil_AssertNonvoid((RingAddr & (XDMAPCIE_DMA_DESC_ALIGN - 1U)) == 0U);
+
+	ChanPtr->IsReady = 0U;
+	ChanPtr->IsStarted = 0U;
+	ChanPtr->DmaBase = DmaBaseAddr;
+	ChanPtr->Dir = Dir;
+	ChanPtr->ChanId = ChanId;
+	if (Dir == XDMAPCIE_DMA_H2C) {
+		ChanPtr->ChanBase = DmaBaseAddr + XDMAPCIE_DMA_H2C_OFFSET;
+		ChanPtr->SgBase = DmaBaseAddr + XDMAPCIE_DMA_H2C_SG_OFFSET;
+	} else {
+		ChanPtr->ChanBase = DmaBaseAddr + XDMAPCIE_DMA_C2H_OFFSET;
+		ChanPtr->SgBase = DmaBaseAddr + XDMAPCIE_DMA_C2H_SG_OFFSET;
+	}
+	ChanPtr->ChanBase += ChanId * XDMAPCIE_DMA_CHAN_STRIDE;
+	ChanPtr->SgBase += ChanId * XDMAPCIE_DMA_CHAN_STRIDE;
+
+	Id = XDmaPcie_ReadReg(ChanPtr->ChanBase, XDMAPCIE_DMA_CH_ID_OFFSET);
+	if (((Id & XDMAPCIE_DMA_ID_SUBSYS_MASK) != XDMAPCIE_DMA_ID_SUBSYS) ||
+		(((Id & XDMAPCIE_DMA_ID_TARGET_MASK) >>
+		XDMAPCIE_DMA_ID_TARGET_SHIFT) != Dir)) {
+		return XST_DEVICE_NOT_FOUND;
+	}
+
+	/*
+	 * The channel interrupt bits of the IRQ block list the H2C channels
+	 * first, then the C2H channels
+	 */
+	if (Dir == XDMAPCIE_DMA_C2H) {
+		for (Index = 0U; Index < XDMAPCIE_DMA_MAX_CHANNELS; Index++) {
+			Id = XDmaPcie_ReadReg(DmaBaseAddr +
+				XDMAPCIE_DMA_H2C_OFFSET +
+				(Index * XDMAPCIE_DMA_CHAN_STRIDE),
+				XDMAPCIE_DMA_CH_ID_OFFSET);
+			if ((Id & XDMAPCIE_DMA_ID_SUBSYS_MASK) !=
+					XDMAPCIE_DMA_ID_SUBSYS) {
+				break;
+			}
+			NumH2c++;
+		}
+	}
+	ChanPtr->IrqBit = NumH2c + ChanId;
+
+	/* Make sure the engine is stopped and its status clear */
+	XDmaPcie_WriteReg(ChanPtr->ChanBase, XDMAPCIE_DMA_CH_CTRL_W1C_OFFSET,
+			XDMAPCIE_DMA_CTRL_RUN_MASK);
+	(void)XDmaPcie_ReadReg(ChanPtr->ChanBase,
+			XDMAPCIE_DMA_CH_STS_RC_OFFSET);
+
+	/* Link the descriptors in a circle, they are never changed again */
+	for (Index = 0U; Index < RingSize; Index++) {
+		NextAddr = RingAddr + ((u64)((Index + 1U) & (RingSize - 1U)) *
+				sizeof(XDmaPcie_DmaDesc));
+		memset(&Ring[Index], 0, sizeof(XDmaPcie_DmaDesc));
+		Ring[Index].Control = XDMAPCIE_DMA_DESC_MAGIC;
+		Ring[Index].NxtAddrLo = (u32)NextAddr;
+		Ring[Index].NxtAddrHi = (u32)(NextAddr >> 32U);
+	}
+	Xil_DCacheFlushRange((INTPTR)Ring, RingSize * sizeof(XDmaPcie_DmaDesc));
+
+	ChanPtr->Ring = Ring;
+	ChanPtr->RingAddr = RingAddr;
+	ChanPtr->RingSize = RingSize;
+	ChanPtr->Head = 0U;
+	ChanPtr->Tail = 0U;
+	ChanPtr->XferHead = 0U;
+	ChanPtr->XferTail = 0U;
+	ChanPtr->Handler = NULL;
+	ChanPtr->CallBackRef = NULL;
+
+	/* Fetch descriptors only as credits are given */
+	XDmaPcie_WriteReg(DmaBaseAddr + XDMAPCIE_DMA_SG_COMMON_OFFSET,
+		XDMAPCIE_DMA_SG_CREDIT_W1S_OFFSET,
+		(u32)1U << ((Dir == XDMAPCIE_DMA_C2H) ?
+		(ChanId + XDMAPCIE_DMA_SG_CREDIT_C2H_SHIFT) : ChanId));
+
+	XDmaPcie_WriteReg(ChanPtr->ChanBase, XDMAPCIE_DMA_CH_IE_OFFSET,
+			XDMAPCIE_DMA_IE_MASK);
+
+	ChanPtr->IsReady = XIL_COMPONENT_IS_READY;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Start a DMA channel. The engine starts at the first descriptor of the ring
+* and waits for credits.
+*
+* @param	ChanPtr is the channel to operate on.
+*
+* @return
+*		- XST_SUCCESS if the channel is started
+*		- XST_DEVICE_BUSY if transfers are still outstanding
+*
+* @note		None.
+*
+******************************************************************************/
+int XDmaPcie_DmaStart(XDmaPcie_DmaChan *ChanPtr)
+{
+	Xil_AssertNonvoid(ChanPtr != NULL);
+	Xil_AssertNonvoid(ChanPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (ChanPtr->IsStarted != 0U) {
+		return XST_SUCCESS;
+	}
+	if (ChanPtr->XferHead != ChanPtr->XferTail) {
+		return XST_DEVICE_BUSY;
+	}
+
+	/* The completed descriptor count restarts from 0 with the engine */
+	ChanPtr->Head = 0U;
+	ChanPtr->Tail = 0U;
+
+	XDmaPcie_WriteReg(ChanPtr->SgBase, XDMAPCIE_DMA_SG_ADDR_LO_OFFSET,
+			(u32)ChanPtr->RingAddr);
+	XDmaPcie_WriteReg(ChanPtr->SgBase, XDMAPCIE_DMA_SG_ADDR_HI_OFFSET,
+			(u32)(ChanPtr->RingAddr >> 32U));
+	XDmaPcie_WriteReg(ChanPtr->SgBase, XDMAPCIE_DMA_SG_ADJ_OFFSET, 0U);
+
+	(void)XDmaPcie_ReadReg(ChanPtr->ChanBase,
+			XDMAPCIE_DMA_CH_STS_RC_OFFSET);
+	XDmaPcie_WriteReg(ChanPtr->ChanBase, XDMAPCIE_DMA_CH_CTRL_OFFSET,
+			XDMAPCIE_DMA_IE_MASK | XDMAPCIE_DMA_CTRL_RUN_MASK);
+
+	ChanPtr->IsStarted = 1U;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Stop a DMA channel. Transfers completed by the engine are reported to the
+* handler as completed, the others as failed with XST_DMA_ERROR.
+*
+* @param	ChanPtr is the channel to operate on.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XDmaPcie_DmaStop(XDmaPcie_DmaChan *ChanPtr)
+{
+	u32 Timeout = XDMAPCIE_DMA_STOP_TIMEOUT;
+
+	Xil_AssertVoid(ChanPtr != NULL);
+	Xil_AssertVoid(ChanPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (ChanPtr->IsStarted == 0U) {
+		return;
+	}
+
+	XDmaPcie_WriteReg(ChanPtr->ChanBase, XDMAPCIE_DMA_CH_CTRL_W1C_OFFSET,
+			XDMAPCIE_DMA_CTRL_RUN_MASK);
+	while (((XDmaPcie_ReadReg(ChanPtr->ChanBase,
+			XDMAPCIE_DMA_CH_STS_OFFSET) &
+			XDMAPCIE_DMA_STS_BUSY_MASK) != 0U) && (Timeout > 0U)) {
+		Timeout--;
+	}
+
+	(void)XDmaPcie_DmaReap(ChanPtr, 0U);
+	XDmaPcie_DmaAbort(ChanPtr);
+}
+
+/*****************************************************************************/
+/**
+* Set the handler called for every completed transfer.
+*
+* @param	ChanPtr is the channel to operate on.
+* @param	Handler is the completion handler, NULL for none.
+* @param	CallBackRef is passed to the handler.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XDmaPcie_DmaSetHandler(XDmaPcie_DmaChan *ChanPtr,
+		XDmaPcie_DmaHandler Handler, void *CallBackRef)
+{
+	Xil_AssertVoid(ChanPtr != NULL);
+	Xil_AssertVoid(ChanPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	ChanPtr->Handler = Handler;
+	ChanPtr->CallBackRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+* Route the channel interrupt to an MSI-X vector and enable it in the IRQ
+* block.
+*
+* @param	ChanPtr is the channel to operate on.
+* @param	Vector is the MSI-X vector number, 0 to 31.
+*
+* @return
+*		- XST_SUCCESS if the vector is set
+*		- XST_INVALID_PARAM if the vector is out of range
+*
+* @note		None.
+*
+******************************************************************************/
+int XDmaPcie_DmaSetVector(XDmaPcie_DmaChan *ChanPtr, u32 Vector)
+{
+	u32 Offset;
+	u32 Shift;
+	u32 Data;
+
+	Xil_AssertNonvoid(ChanPtr != NULL);
+	Xil_AssertNonvoid(ChanPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (Vector > XDMAPCIE_DMA_IRQ_VEC_MASK) {
+		return XST_INVALID_PARAM;
+	}
+
+	Offset = XDMAPCIE_DMA_IRQ_OFFSET + ((ChanPtr->Dir == XDMAPCIE_DMA_H2C) ?
+		XDMAPCIE_DMA_IRQ_H2C_VEC_OFFSET :
+		XDMAPCIE_DMA_IRQ_C2H_VEC_OFFSET);
+	Shift = ChanPtr->ChanId * XDMAPCIE_DMA_IRQ_VEC_SHIFT;
+
+	Data = XDmaPcie_ReadReg(ChanPtr->DmaBase, Offset);
+	Data &= ~(XDMAPCIE_DMA_IRQ_VEC_MASK << Shift);
+	Data |= Vector << Shift;
+	XDmaPcie_WriteReg(ChanPtr->DmaBase, Offset, Data);
+
+	XDmaPcie_WriteReg(ChanPtr->DmaBase + XDMAPCIE_DMA_IRQ_OFFSET,
+			XDMAPCIE_DMA_IRQ_CH_EN_W1S_OFFSET,
+			(u32)1U << ChanPtr->IrqBit);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Queue a transfer on a started channel. The engine is given credits for the
+* descriptors of the transfer and starts it as soon as the transfers queued
+* before it are done; the function does not wait.
+*
+* @param	ChanPtr is the channel to operate on.
+* @param	SrcAddr is the source address, a PCIe address for H2C and an
+*		AXI address for C2H.
+* @param	DstAddr is the destination address, an AXI address for H2C
+*		and a PCIe address for C2H.
+* @param	Length is the number of bytes to transfer.
+*
+* @return
+*		- XST_SUCCESS if the transfer is queued
+*		- XST_DEVICE_IS_STOPPED if the channel is not started
+*		- XST_DEVICE_BUSY if the ring or the transfer list is full
+*		- XST_INVALID_PARAM if Length is 0
+*
+* @note		The data buffers must be flushed or invalidated by the
+*		caller.
+*
+******************************************************************************/
+int XDmaPcie_DmaSubmit(XDmaPcie_DmaChan *ChanPtr, u64 SrcAddr, u64 DstAddr,
+		u32 Length)
+{
+	XDmaPcie_DmaDesc *Desc;
+	u32 NumDesc;
+	u32 Credits;
+	u32 Chunk;
+
+	Xil_AssertNonvoid(ChanPtr != NULL);
+	Xil_AssertNonvoid(ChanPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (ChanPtr->IsStarted == 0U) {
+		return XST_DEVICE_IS_STOPPED;
+	}
+	if (Length == 0U) {
+		return XST_INVALID_PARAM;
+	}
+
+	NumDesc = (Length + XDMAPCIE_DMA_DESC_MAX_LEN - 1U) /
+			XDMAPCIE_DMA_DESC_MAX_LEN;
+	if (((ChanPtr->XferHead - ChanPtr->XferTail) >=
+			XDMAPCIE_DMA_MAX_XFERS) ||
+		(NumDesc > (ChanPtr->RingSize -
+			(ChanPtr->Head - ChanPtr->Tail)))) {
+		return XST_DEVICE_BUSY;
+	}
+
+	for (Credits = NumDesc; Credits > 0U; Credits--) {
+		Desc = &ChanPtr->Ring[ChanPtr->Head & (ChanPtr->RingSize - 1U)];
+		Chunk = (Length > XDMAPCIE_DMA_DESC_MAX_LEN) ?
+				XDMAPCIE_DMA_DESC_MAX_LEN : Length;
+
+		/* Only the last descriptor of a transfer interrupts */
+		Desc->Control = XDMAPCIE_DMA_DESC_MAGIC;
+		if (Credits == 1U) {
+			Desc->Control |= XDMAPCIE_DMA_DESC_CMPL_MASK |
+					XDMAPCIE_DMA_DESC_EOP_MASK;
+		}
+		Desc->Length = Chunk;
+		Desc->SrcAddrLo = (u32)SrcAddr;
+		Desc->SrcAddrHi = (u32)(SrcAddr >> 32U);
+		Desc->DstAddrLo = (u32)DstAddr;
+		Desc->DstAddrHi = (u32)(DstAddr >> 32U);
+		Xil_DCacheFlushRange((INTPTR)Desc, sizeof(XDmaPcie_DmaDesc));
+
+		SrcAddr += Chunk;
+		DstAddr += Chunk;
+		Length -= Chunk;
+		ChanPtr->Head++;
+	}
+
+	ChanPtr->XferEnd[ChanPtr->XferHead % XDMAPCIE_DMA_MAX_XFERS] =
+			ChanPtr->Head;
+	ChanPtr->XferHead++;
+
+	/* Hand the descriptors to the engine */
+	while (NumDesc > 0U) {
+		Credits = (NumDesc > XDMAPCIE_DMA_SG_CREDITS_MAX) ?
+				XDMAPCIE_DMA_SG_CREDITS_MAX : NumDesc;
+		XDmaPcie_WriteReg(ChanPtr->SgBase,
+				XDMAPCIE_DMA_SG_CREDITS_OFFSET, Credits);
+		NumDesc -= Credits;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Reap the transfers completed by a channel and call the handler for each of
+* them. An error reported by the engine stops the channel and fails all the
+* transfers outstanding; the channel must be started again.
+*
+* @param	ChanPtr is the channel to operate on.
+*
+* @return	The number of transfers reaped.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XDmaPcie_DmaPoll(XDmaPcie_DmaChan *ChanPtr)
+{
+	u32 Status;
+
+	Xil_AssertNonvoid(ChanPtr != NULL);
+	Xil_AssertNonvoid(ChanPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Status = XDmaPcie_ReadReg(ChanPtr->ChanBase,
+			XDMAPCIE_DMA_CH_STS_OFFSET);
+	Status &= ~XDMAPCIE_DMA_STS_BUSY_MASK;
+	if (Status != 0U) {
+		XDmaPcie_WriteReg(ChanPtr->ChanBase,
+				XDMAPCIE_DMA_CH_STS_OFFSET, Status);
+	}
+
+	return XDmaPcie_DmaReap(ChanPtr, Status);
+}
+
+/*****************************************************************************/
+/**
+* Get the number of transfers queued and not reaped yet.
+*
+* @param	ChanPtr is the channel to operate on.
+*
+* @return	The number of transfers outstanding.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XDmaPcie_DmaGetPending(XDmaPcie_DmaChan *ChanPtr)
+{
+	Xil_AssertNonvoid(ChanPtr != NULL);
+
+	return ChanPtr->XferHead - ChanPtr->XferTail;
+}
+
+/*****************************************************************************/
+/**
+* Interrupt handler of a DMA channel, to be connected to the interrupt the
+* channel is routed to.
+*
+* @param	CallBackRef is the XDmaPcie_DmaChan instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XDmaPcie_DmaIntrHandler(void *CallBackRef)
+{
+	XDmaPcie_DmaChan *ChanPtr = (XDmaPcie_DmaChan *)CallBackRef;
+	u32 Status;
+
+	Xil_AssertVoid(ChanPtr != NULL);
+
+	/* Reading the clear on read status acknowledges the interrupt */
+	Status = XDmaPcie_ReadReg(ChanPtr->ChanBase,
+			XDMAPCIE_DMA_CH_STS_RC_OFFSET);
+
+	(void)XDmaPcie_DmaReap(ChanPtr, Status);
+}
+
+/*****************************************************************************/
+/**
+* Complete the transfers covered by the completed descriptor count.
+*
+* @param	ChanPtr is the channel to operate on.
+* @param	Status is the channel status read by the caller.
+*
+* @return	The number of transfers reaped.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XDmaPcie_DmaReap(XDmaPcie_DmaChan *ChanPtr, u32 Status)
+{
+	u32 Count = 0U;
+	u32 End;
+
+	ChanPtr->Tail = XDmaPcie_ReadReg(ChanPtr->ChanBase,
+			XDMAPCIE_DMA_CH_CMPL_OFFSET);
+
+	while (ChanPtr->XferTail != ChanPtr->XferHead) {
+		End = ChanPtr->XferEnd[ChanPtr->XferTail %
+				XDMAPCIE_DMA_MAX_XFERS];
+		if ((s32)(ChanPtr->Tail - End) < 0) {
+			break;
+		}
+		ChanPtr->XferTail++;
+		Count++;
+		if (ChanPtr->Handler != NULL) {
+			ChanPtr->Handler(ChanPtr->CallBackRef, XST_SUCCESS);
+		}
+	}
+
+	if ((Status & XDMAPCIE_DMA_STS_ERR_MASK) != 0U) {
+		XDmaPcie_WriteReg(ChanPtr->ChanBase,
+				XDMAPCIE_DMA_CH_CTRL_W1C_OFFSET,
+				XDMAPCIE_DMA_CTRL_RUN_MASK);
+		Count += ChanPtr->XferHead - ChanPtr->XferTail;
+		XDmaPcie_DmaAbort(ChanPtr);
+	}
+
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+* Fail the outstanding transfers of a stopped channel.
+*
+* @param	ChanPtr is the channel to operate on.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XDmaPcie_DmaAbort(XDmaPcie_DmaChan *ChanPtr)
+{
+	ChanPtr->IsStarted = 0U;
+	while (ChanPtr->XferTail != ChanPtr->XferHead) {
+		ChanPtr->XferTail++;
+		if (ChanPtr->Handler != NULL) {
+			ChanPtr->Handler(ChanPtr->CallBackRef, XST_DMA_ERROR);
+		}
+	}
+	ChanPtr->Tail = ChanPtr->Head;
+}
@@ -0,0 +1,272 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+/******************************************************************************/
+/**
+*
+* @file xdmapcie_dma.h
+*
+* This file contains the software API of the H2C (host to card) and C2H
+* (card to host) channels of the XDMA engine, for use by the firmware of an
+* end point design that has the DMA registers mapped on its AXI-Lite slave
+* interface.
+*
+* <b>Descriptor rings</b>
+*
+* Each channel owns a ring of descriptors allocated by the user, typically in
+* DDR. The descriptors are linked in a circle once, at initialization, and
+* the channel runs in descriptor credit mode: the engine only fetches the
+* descriptors it has been given credits for and waits for more credits
+* instead of stopping at the end of a list. Submitting a transfer therefore
+* fills the next descriptors of the ring and adds credits, without stopping
+* the engine, so that many transfers can be outstanding on a channel.
+*
+* The ring address passed to XDmaPcie_DmaChanInit() is the address of the
+* ring as seen by the descriptor fetch of the engine, the pointer is the
+* address used by the processor; they only differ when the ring is accessed
+* through an address translation.
+*
+* <b>Completions</b>
+*
+* The last descriptor of every transfer has the completed bit set, so that
+* the engine raises the channel interrupt, which is routed to the MSI-X
+* vector programmed by XDmaPcie_DmaSetVector(). Completed transfers are
+* reaped from the completed descriptor count of the channel by
+* XDmaPcie_DmaPoll(), either polled or from XDmaPcie_DmaIntrHandler() when
+* the channel interrupt reaches the processor, and the completion handler is
+* called once per transfer in submission order.
+*
+* @note
+*
+* The data buffers are not flushed or invalidated by the driver; the
+* descriptor ring is.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 1.1	adk	10/15/19	First release
+* </pre>
+*
+*****************************************************************************/
+#ifndef XDMAPCIE_DMA_H			/* prevent circular inclusions */
+#define XDMAPCIE_DMA_H			/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files ********************************/
+#include "xdmapcie.h"
+
+/************************** Constant Definitions ****************************/
+
+/** @name DMA directions
+ * @{
+ */
+#define XDMAPCIE_DMA_H2C		0U /**< Host to card */
+#define XDMAPCIE_DMA_C2H		1U /**< Card to host */
+/*@}*/
+
+#define XDMAPCIE_DMA_MAX_CHANNELS	4U /**< Channels per direction */
+
+/**
+ * Maximum number of transfers outstanding on a channel
+ */
+#define XDMAPCIE_DMA_MAX_XFERS		32U
+
+/**
+ * Maximum length of a descriptor. Longer transfers use several
+ * descriptors.
+ */
+#define XDMAPCIE_DMA_DESC_MAX_LEN	0x0FFFF000U
+
+#define XDMAPCIE_DMA_DESC_ALIGN		32U /**< Descriptor alignment */
+
+/** @name DMA register blocks
+ *
+ * Offsets of the register blocks from the DMA register base. Channel
+ * registers are repeated every XDMAPCIE_DMA_CHAN_STRIDE bytes.
+ * @{
+ */
+#define XDMAPCIE_DMA_H2C_OFFSET		0x0000U /**< H2C channels */
+#define XDMAPCIE_DMA_C2H_OFFSET		0x1000U /**< C2H channels */
+#define XDMAPCIE_DMA_IRQ_OFFSET		0x2000U /**< IRQ block */
+#define XDMAPCIE_DMA_H2C_SG_OFFSET	0x4000U /**< H2C SGDMA */
+#define XDMAPCIE_DMA_C2H_SG_OFFSET	0x5000U /**< C2H SGDMA */
+#define XDMAPCIE_DMA_SG_COMMON_OFFSET	0x6000U /**< SGDMA common */
+#define XDMAPCIE_DMA_CHAN_STRIDE	0x100U
+/*@}*/
+
+/** @name Channel registers
+ * @{
+ */
+#define XDMAPCIE_DMA_CH_ID_OFFSET	0x00U /**< Identifier */
+#define XDMAPCIE_DMA_CH_CTRL_OFFSET	0x04U /**< Control */
+#define XDMAPCIE_DMA_CH_CTRL_W1S_OFFSET	0x08U /**< Control set */
+#define XDMAPCIE_DMA_CH_CTRL_W1C_OFFSET	0x0CU /**< Control clear */
+#define XDMAPCIE_DMA_CH_STS_OFFSET	0x40U /**< Status, write 1 to clear */
+#define XDMAPCIE_DMA_CH_STS_RC_OFFSET	0x44U /**< Status, clear on read */
+#define XDMAPCIE_DMA_CH_CMPL_OFFSET	0x48U /**< Completed descriptors */
+#define XDMAPCIE_DMA_CH_IE_OFFSET	0x90U /**< Interrupt enable mask */
+/*@}*/
+
+/** @name Identifier register
+ * @{
+ */
+#define XDMAPCIE_DMA_ID_SUBSYS_MASK	0xFFF00000U /**< Subsystem */
+#define XDMAPCIE_DMA_ID_SUBSYS		0x1FC00000U /**< XDMA subsystem */
+#define XDMAPCIE_DMA_ID_TARGET_MASK	0x000F0000U /**< Target */
+#define XDMAPCIE_DMA_ID_TARGET_SHIFT	16U
+#define XDMAPCIE_DMA_ID_STREAM_MASK	0x00008000U /**< AXI-ST channel */
+/*@}*/
+
+/** @name Control, status and interrupt enable bits
+ * @{
+ */
+#define XDMAPCIE_DMA_CTRL_RUN_MASK	0x00000001U /**< Run */
+#define XDMAPCIE_DMA_STS_BUSY_MASK	0x00000001U /**< Busy */
+#define XDMAPCIE_DMA_STS_STOPPED_MASK	0x00000002U /**< Descriptor stopped */
+#define XDMAPCIE_DMA_STS_CMPL_MASK	0x00000004U /**< Descriptor completed */
+#define XDMAPCIE_DMA_STS_ERR_MASK	0x00FFFFF8U /**< Alignment, magic,
+						      *  length, read, write
+						      *  and descriptor
+						      *  errors */
+#define XDMAPCIE_DMA_IE_MASK		(XDMAPCIE_DMA_STS_CMPL_MASK | \
+					 XDMAPCIE_DMA_STS_ERR_MASK)
+/*@}*/
+
+/** @name SGDMA registers
+ * @{
+ */
+#define XDMAPCIE_DMA_SG_ADDR_LO_OFFSET	0x80U /**< Descriptor address low */
+#define XDMAPCIE_DMA_SG_ADDR_HI_OFFSET	0x84U /**< Descriptor address high */
+#define XDMAPCIE_DMA_SG_ADJ_OFFSET	0x88U /**< Adjacent descriptors */
+#define XDMAPCIE_DMA_SG_CREDITS_OFFSET	0x8CU /**< Descriptor credits */
+#define XDMAPCIE_DMA_SG_CREDITS_MAX	0x3FFU /**< Credits per write */
+
+#define XDMAPCIE_DMA_SG_CREDIT_W1S_OFFSET 0x24U /**< Credit mode enable set,
+						  *  in the SGDMA common
+						  *  block */
+#define XDMAPCIE_DMA_SG_CREDIT_C2H_SHIFT 16U /**< C2H channel bits */
+/*@}*/
+
+/** @name IRQ block registers
+ * @{
+ */
+#define XDMAPCIE_DMA_IRQ_CH_EN_W1S_OFFSET 0x14U /**< Channel interrupt
+						  *  enable set */
+#define XDMAPCIE_DMA_IRQ_CH_EN_W1C_OFFSET 0x18U /**< Channel interrupt
+						  *  enable clear */
+#define XDMAPCIE_DMA_IRQ_H2C_VEC_OFFSET	0xA0U /**< H2C vector numbers */
+#define XDMAPCIE_DMA_IRQ_C2H_VEC_OFFSET	0xA4U /**< C2H vector numbers */
+#define XDMAPCIE_DMA_IRQ_VEC_MASK	0x1FU /**< Vector number field */
+#define XDMAPCIE_DMA_IRQ_VEC_SHIFT	8U    /**< Field stride */
+/*@}*/
+
+/** @name Descriptor control word
+ * @{
+ */
+#define XDMAPCIE_DMA_DESC_MAGIC		0xAD4B0000U /**< Magic */
+#define XDMAPCIE_DMA_DESC_EOP_MASK	0x00000010U /**< End of packet */
+#define XDMAPCIE_DMA_DESC_CMPL_MASK	0x00000002U /**< Interrupt when
+						     *  completed */
+#define XDMAPCIE_DMA_DESC_STOP_MASK	0x00000001U /**< Stop engine */
+/*@}*/
+
+/**************************** Type Definitions ******************************/
+
+/**
+ * Hardware descriptor, 32 bytes long and 32 byte aligned.
+ */
+typedef struct {
+	u32 Control;		/**< Magic and control bits */
+	u32 Length;		/**< Length in bytes */
+	u32 SrcAddrLo;		/**< Source address */
+	u32 SrcAddrHi;
+	u32 DstAddrLo;		/**< Destination address */
+	u32 DstAddrHi;
+	u32 NxtAddrLo;		/**< Next descriptor address */
+	u32 NxtAddrHi;
+} XDmaPcie_DmaDesc;
+
+/**
+ * Completion handler, called once per completed transfer with
+ * XST_SUCCESS, or with XST_DMA_ERROR for every transfer outstanding when
+ * the channel reported an error.
+ */
+typedef void (*XDmaPcie_DmaHandler)(void *CallBackRef, u32 Status);
+
+/**
+ * DMA channel instance.
+ */
+typedef struct {
+	UINTPTR ChanBase;		/**< Channel registers */
+	UINTPTR SgBase;			/**< SGDMA registers */
+	UINTPTR DmaBase;		/**< DMA register base */
+	u32 Dir;			/**< XDMAPCIE_DMA_H2C or C2H */
+	u32 ChanId;			/**< Channel number */
+	u32 IrqBit;			/**< Bit in the IRQ block masks */
+	XDmaPcie_DmaDesc *Ring;		/**< Descriptor ring */
+	u64 RingAddr;			/**< Ring address for the engine */
+	u32 RingSize;			/**< Descriptors in the ring */
+	u32 Head;			/**< Descriptors submitted */
+	u32 Tail;			/**< Descriptors completed */
+	u32 XferEnd[XDMAPCIE_DMA_MAX_XFERS];	/**< Descriptor count at the
+						  *  end of each transfer */
+	u32 XferHead;			/**< Transfers submitted */
+	u32 XferTail;			/**< Transfers completed */
+	XDmaPcie_DmaHandler Handler;	/**< Completion handler */
+	void *CallBackRef;		/**< Handler argument */
+	u32 IsReady;			/**< Channel initialized */
+	u32 IsStarted;			/**< Run bit set */
+} XDmaPcie_DmaChan;
+
+/************************** Function Prototypes *****************************/
+
+/*
+ * DMA channel functions.
+ * This API is implemented in xdmapcie_dma.c
+ */
+int XDmaPcie_DmaChanInit(XDmaPcie_DmaChan *ChanPtr, UINTPTR DmaBaseAddr,
+		u32 Dir, u32 ChanId, XDmaPcie_DmaDesc *Ring, u64 RingAddr,
+		u32 RingSize);
+int XDmaPcie_DmaStart(XDmaPcie_DmaChan *ChanPtr);
+void XDmaPcie_DmaStop(XDmaPcie_DmaChan *ChanPtr);
+void XDmaPcie_DmaSetHandler(XDmaPcie_DmaChan *ChanPtr,
+		XDmaPcie_DmaHandler Handler, void *CallBackRef);
+int XDmaPcie_DmaSetVector(XDmaPcie_DmaChan *ChanPtr, u32 Vector);
+int XDmaPcie_DmaSubmit(XDmaPcie_DmaChan *ChanPtr, u64 SrcAddr, u64 DstAddr,
+		u32 Length);
+u32 XDmaPcie_DmaPoll(XDmaPcie_DmaChan *ChanPtr);
+u32 XDmaPcie_DmaGetPending(XDmaPcie_DmaChan *ChanPtr);
+void XDmaPcie_DmaIntrHandler(void *CallBackRef);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
@@ -0,0 +1,405 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xzdma_memcpy_example.c
+*
+* This file contains an example of the XZDma memcpy job queue. The copies of
+* a buffer are queued as jobs on the 8 GDMA channels, checked, and timed
+* against memcpy() on the CPU for several job sizes.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.8   adk    10/15/19  First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xzdma.h"
+#include "xparameters.h"
+#include "xscugic.h"
+#include "xtime_l.h"
+#include "xil_printf.h"
+
+/************************** Constant Definitions ******************************/
+
+/*
+ * The following constants map to the XPAR parameters created in the
+ * xparameters.h file. They are defined here such that a user can easily
+ * change all the needed parameters in one place.
+ */
+#define ZDMA_INTC_DEVICE_ID	XPAR_SCUGIC_SINGLE_DEVICE_ID
+						/**< SCUGIC Device ID */
+#define NUM_CHANNELS		8U	/**< GDMA channels used */
+
+#define BUF_SIZE		(4U * 1024U * 1024U)	/**< Bytes copied */
+#define MIN_JOB_SIZE		(4U * 1024U)	/**< Smallest job size */
+#define TESTVALUE		0x1230U		/**< Test value */
+
+/**************************** Type Definitions *******************************/
+
+
+/************************** Function Prototypes ******************************/
+
+int XZDma_MemcpyExample(void);
+static int SetupInterruptSystem(XScuGic *IntcInstancePtr);
+static int RunDma(u32 JobSize, XTime *TimePtr);
+static void JobHandler(void *CallBackRef, s32 Status);
+static u32 MBps(u32 Bytes, XTime Time);
+
+/************************** Variable Definitions *****************************/
+
+static const u16 DeviceId[NUM_CHANNELS] = {
+	XPAR_PSU_GDMA_0_DEVICE_ID, XPAR_PSU_GDMA_1_DEVICE_ID,
+	XPAR_PSU_GDMA_2_DEVICE_ID, XPAR_PSU_GDMA_3_DEVICE_ID,
+	XPAR_PSU_GDMA_4_DEVICE_ID, XPAR_PSU_GDMA_5_DEVICE_ID,
+	XPAR_PSU_GDMA_6_DEVICE_ID, XPAR_PSU_GDMA_7_DEVICE_ID
+};
+
+static const u16 IntrId[NUM_CHANNELS] = {
+	XPAR_PSU_GDMA_0_INTR, XPAR_PSU_GDMA_1_INTR,
+	XPAR_PSU_GDMA_2_INTR, XPAR_PSU_GDMA_3_INTR,
+	XPAR_PSU_GDMA_4_INTR, XPAR_PSU_GDMA_5_INTR,
+	XPAR_PSU_GDMA_6_INTR, XPAR_PSU_GDMA_7_INTR
+};
+
+XZDma ZDma[NUM_CHANNELS];	/**< Instances of the GDMA channels */
+XScuGic Intc;			/**< XScuGic Instance */
+#if defined(__ICCARM__)
+    #pragma data_alignment = 64
+	XZDma_Memcpy Memcpy;	/**< Memcpy job queue */
+    #pragma data_alignment = 64
+	u8 DstBuf[BUF_SIZE];	/**< Destination buffer */
+    #pragma data_alignment = 64
+	u8 SrcBuf[BUF_SIZE];	/**< Source buffer */
+#else
+XZDma_Memcpy Memcpy;		/**< Memcpy job queue */
+u8 DstBuf[BUF_SIZE] __attribute__ ((aligned (64)));	/**< Destination buffer */
+u8 SrcBuf[BUF_SIZE] __attribute__ ((aligned (64)));	/**< Source buffer */
+#endif
+volatile static u32 JobsDone = 0;	/**< Jobs completed */
+volatile static u32 JobsFailed = 0;	/**< Jobs completed with an error */
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the example.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None.
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+
+	/* Run the memcpy example */
+	Status = XZDma_MemcpyExample();
+	if (Status != XST_SUCCESS) {
+		xil_printf("ZDMA Memcpy Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran ZDMA Memcpy Example\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds the GDMA channels to a memcpy job queue, then copies
+* BUF_SIZE bytes with jobs of MIN_JOB_SIZE up to BUF_SIZE bytes and prints
+* the throughput of the copies next to the one of memcpy().
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		The DMA time includes the cache maintenance of the buffers
+*		when GDMA is not cache coherent.
+*
+******************************************************************************/
+int XZDma_MemcpyExample(void)
+{
+	XZDma_Config *Config;
+	XZDma_DataConfig Configure;
+	XTime Start;
+	XTime End;
+	XTime CpuTime;
+	XTime DmaTime;
+	u32 JobSize;
+	u32 Index;
+	int Status;
+
+	XZDma_MemcpyInitialize(&Memcpy);
+
+	for (Index = 0; Index < NUM_CHANNELS; Index++) {
+		Config = XZDma_LookupConfig(DeviceId[Index]);
+		if (NULL == Config) {
+			return XST_FAILURE;
+		}
+
+		Status = XZDma_CfgInitialize(&ZDma[Index], Config,
+						Config->BaseAddress);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		/* Longest bursts and most outstanding reads */
+		XZDma_GetChDataConfig(&ZDma[Index], &Configure);
+		Configure.OverFetch = 1;
+		Configure.SrcIssue = 0x1F;
+		Configure.SrcBurstType = XZDMA_INCR_BURST;
+		Configure.SrcBurstLen = 0xF;
+		Configure.DstBurstType = XZDMA_INCR_BURST;
+		Configure.DstBurstLen = 0xF;
+		Configure.SrcCache = 0x2;
+		Configure.DstCache = 0x2;
+		if (Config->IsCacheCoherent) {
+			Configure.SrcCache = 0xF;
+			Configure.DstCache = 0xF;
+		}
+		XZDma_SetChDataConfig(&ZDma[Index], &Configure);
+
+		Status = XZDma_MemcpyAddChannel(&Memcpy, &ZDma[Index]);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	Status = SetupInterruptSystem(&Intc);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	for (Index = 0; Index < BUF_SIZE; Index++) {
+		SrcBuf[Index] = (u8)(TESTVALUE + Index);
+	}
+
+	/* CPU reference, the buffers are warm as for the DMA runs */
+	memset(DstBuf, 0, BUF_SIZE);
+	XTime_GetTime(&Start);
+	memcpy(DstBuf, SrcBuf, BUF_SIZE);
+	XTime_GetTime(&End);
+	CpuTime = End - Start;
+	xil_printf("memcpy    %d bytes: %d MB/s\r\n", BUF_SIZE,
+			MBps(BUF_SIZE, CpuTime));
+
+	for (JobSize = MIN_JOB_SIZE; JobSize <= BUF_SIZE; JobSize <<= 2) {
+		memset(DstBuf, 0, BUF_SIZE);
+
+		Status = RunDma(JobSize, &DmaTime);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		if (memcmp(DstBuf, SrcBuf, BUF_SIZE) != 0) {
+			xil_printf("Data mismatch with %d byte jobs\r\n",
+					JobSize);
+			return XST_FAILURE;
+		}
+
+		xil_printf("zdma x%d  %d byte jobs: %d MB/s\r\n",
+				NUM_CHANNELS, JobSize,
+				MBps(BUF_SIZE, DmaTime));
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function copies SrcBuf to DstBuf with jobs of JobSize bytes and waits
+* for all of them.
+*
+* @param	JobSize is the size of a job in bytes.
+* @param	TimePtr is a pointer to the time of the copy.
+*
+* @return
+*		- XST_SUCCESS if all the jobs succeeded.
+*		- XST_FAILURE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static int RunDma(u32 JobSize, XTime *TimePtr)
+{
+	XZDma_MemcpyJob Job;
+	XTime Start;
+	XTime End;
+	u32 Offset;
+	int Status;
+
+	JobsDone = 0;
+	JobsFailed = 0;
+	Job.Handler = JobHandler;
+	Job.CallBackRef = &Memcpy;
+	Job.Size = JobSize;
+
+	XTime_GetTime(&Start);
+	for (Offset = 0; Offset < BUF_SIZE; Offset += JobSize) {
+		Job.SrcAddr = (UINTPTR)&SrcBuf[Offset];
+		Job.DstAddr = (UINTPTR)&DstBuf[Offset];
+
+		/* Wait for room in the queue */
+		do {
+			Status = XZDma_MemcpySubmit(&Memcpy, &Job);
+		} while (Status == XST_DEVICE_BUSY);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+	while (XZDma_MemcpyPending(&Memcpy) != 0U);
+	XTime_GetTime(&End);
+	*TimePtr = End - Start;
+
+	if ((JobsFailed != 0U) || (JobsDone != (BUF_SIZE / JobSize))) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the throughput of a copy in MB/s.
+*
+* @param	Bytes is the size of the copy.
+* @param	Time is the time of the copy in XTime counts.
+*
+* @return	Throughput in MB/s.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 MBps(u32 Bytes, XTime Time)
+{
+	if (Time == 0U) {
+		return 0U;
+	}
+
+	return (u32)(((u64)Bytes * COUNTS_PER_SECOND) /
+			((u64)Time * 1024U * 1024U));
+}
+
+/*****************************************************************************/
+/**
+* This function sets up the interrupt system so interrupts can occur for the
+* GDMA channels. This function is application-specific. The user should
+* modify this function to fit the application.
+*
+* @param	IntcInstancePtr is a pointer to the instance of the INTC.
+*
+* @return
+*		- XST_SUCCESS if successful
+*		- XST_FAILURE if failed
+*
+* @note		None.
+*
+****************************************************************************/
+static int SetupInterruptSystem(XScuGic *IntcInstancePtr)
+{
+	XScuGic_Config *IntcConfig; /* Config for interrupt controller */
+	u32 Index;
+	int Status;
+
+	/*
+	 * Initialize the interrupt controller driver
+	 */
+	IntcConfig = XScuGic_LookupConfig(ZDMA_INTC_DEVICE_ID);
+	if (NULL == IntcConfig) {
+		return XST_FAILURE;
+	}
+
+	Status = XScuGic_CfgInitialize(IntcInstancePtr, IntcConfig,
+					IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Connect the interrupt controller interrupt handler to the
+	 * hardware interrupt handling logic in the processor.
+	 */
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler) XScuGic_InterruptHandler,
+				IntcInstancePtr);
+
+	/*
+	 * Connect the driver interrupt handler of every channel, the queue
+	 * has installed the channel callbacks
+	 */
+	for (Index = 0; Index < NUM_CHANNELS; Index++) {
+		Status = XScuGic_Connect(IntcInstancePtr, IntrId[Index],
+				(Xil_ExceptionHandler) XZDma_IntrHandler,
+				(void *) &ZDma[Index]);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		XScuGic_Enable(IntcInstancePtr, IntrId[Index]);
+	}
+
+	/*
+	 * Enable interrupts
+	 */
+	Xil_ExceptionEnableMask(XIL_EXCEPTION_IRQ);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This static function is the handler of the memcpy jobs.
+*
+* @param	CallBackRef is the callback reference of the job.
+* @param	Status is XST_SUCCESS or XST_FAILURE.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void JobHandler(void *CallBackRef, s32 Status)
+{
+	(void)CallBackRef;
+
+	if (Status != XST_SUCCESS) {
+		JobsFailed++;
+	}
+	JobsDone++;
+}
@@ -131,6 +131,12 @@
 * 1.7	adk	08/03/19 Added support for versal IP.
 * 1.7   adk     18/03/19 Updated the writeonly mode example data verification
 *			 check to support versal adma IP.
+* 1.8   adk     10/15/19 Added the memcpy job queue, XZDma_Memcpy*() APIs in
+*			 xzdma_memcpy.c, which spreads copies over several
+*			 channels in scatter gather mode.
+*			 Clear the pending interrupts before calling the
+*			 callbacks in XZDma_IntrHandler so that a transfer
+*			 started from the done callback is not lost.
 * </pre>
 *
 ******************************************************************************/
@@ -152,6 +158,21 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+/** @name Memcpy job queue
+ * @{
+ */
+#define XZDMA_MEMCPY_MAX_CHANNELS	8U	/**< Channels of one DMA */
+#ifndef XZDMA_MEMCPY_QUEUE_DEPTH
+#define XZDMA_MEMCPY_QUEUE_DEPTH	64U	/**< Queued jobs, must be a
+						  *  power of two */
+#endif
+#ifndef XZDMA_MEMCPY_CHAIN_LEN
+#define XZDMA_MEMCPY_CHAIN_LEN		16U	/**< Jobs in one descriptor
+						  *  chain of a channel */
+#endif
+#define XZDMA_MEMCPY_MAX_SIZE		XZDMA_WORD2_SIZE_MASK
+						/**< Largest job in bytes */
+/*@}*/
 
 /**************************** Type Definitions *******************************/
 
@@ -368,6 +389,74 @@ typedef struct {
 				  *  this transfer only for SG mode */
 } XZDma_Transfer;
 
+/******************************************************************************/
+/**
+*
+* Callback of a memcpy job, Status is XST_SUCCESS or XST_FAILURE on an AXI
+* error of the channel which ran the job.
+*/
+typedef void (*XZDma_MemcpyHandler) (void *CallBackRef, s32 Status);
+
+/******************************************************************************/
+/**
+*
+* This typedef contains a job of the memcpy queue.
+*/
+typedef struct {
+	UINTPTR DstAddr;		/**< Destination address */
+	UINTPTR SrcAddr;		/**< Source address */
+	u32 Size;			/**< Bytes to copy */
+	XZDma_MemcpyHandler Handler;	/**< Called when the copy is done,
+					  *  can be NULL */
+	void *CallBackRef;		/**< Passed to the handler */
+} XZDma_MemcpyJob;
+
+struct XZDma_MemcpyTag;
+
+/******************************************************************************/
+/**
+*
+* This typedef contains a channel of the memcpy queue. The linear descriptors,
+* source ones followed by destination ones, are reused by every chain that
+* runs on the channel.
+*/
+typedef struct {
+#if defined (__ICCARM__)
+	XZDma_LiDscr Dscr[2U * XZDMA_MEMCPY_CHAIN_LEN];
+				/**< Descriptors, the XZDma_Memcpy instance
+				  *  must be 64 byte aligned */
+#else
+	XZDma_LiDscr Dscr[2U * XZDMA_MEMCPY_CHAIN_LEN]
+				__attribute__ ((aligned (64)));
+				/**< Descriptors */
+#endif
+	XZDma_MemcpyJob Jobs[XZDMA_MEMCPY_CHAIN_LEN];
+				/**< Jobs of the running chain */
+	u32 NumJobs;		/**< Jobs in the running chain */
+	u32 Bytes;		/**< Bytes of the running chain */
+	XZDma *Dma;		/**< Channel instance */
+	struct XZDma_MemcpyTag *Memcpy;	/**< Owning queue */
+} XZDma_MemcpyChannel;
+
+/******************************************************************************/
+/**
+*
+* The memcpy job queue. Jobs are queued by XZDma_MemcpySubmit() and dealt,
+* as descriptor chains, to the idle channels, always to the one which got the
+* fewest bytes so far.
+*/
+typedef struct XZDma_MemcpyTag {
+	XZDma_MemcpyChannel Channel[XZDMA_MEMCPY_MAX_CHANNELS];
+				/**< Channels */
+	u32 NumChannels;	/**< Channels added */
+	XZDma_MemcpyJob Queue[XZDMA_MEMCPY_QUEUE_DEPTH];
+				/**< Jobs not started yet */
+	u32 Head;		/**< Jobs queued so far */
+	u32 Tail;		/**< Jobs started so far */
+	u32 Running;		/**< Jobs started and not completed */
+	u32 Locked;		/**< Nesting count of the queue lock */
+} XZDma_Memcpy;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -705,6 +794,11 @@ void XZDma_IntrHandler(void *Instance);
 s32 XZDma_SetCallBack(XZDma *InstancePtr, XZDma_Handler HandlerType,
 	void *CallBackFunc, void *CallBackRef);
 
+void XZDma_MemcpyInitialize(XZDma_Memcpy *MemcpyPtr);
+s32 XZDma_MemcpyAddChannel(XZDma_Memcpy *MemcpyPtr, XZDma *InstancePtr);
+s32 XZDma_MemcpySubmit(XZDma_Memcpy *MemcpyPtr, XZDma_MemcpyJob *JobPtr);
+u32 XZDma_MemcpyPending(XZDma_Memcpy *MemcpyPtr);
+
 /*@}*/
 
 #ifdef __cplusplus
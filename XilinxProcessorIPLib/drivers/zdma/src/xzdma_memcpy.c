@@ -0,0 +1,562 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xzdma_memcpy.c
+* @addtogroup zdma_v1_7
+* @{
+*
+* This file contains the memcpy job queue of the ZDMA driver.
+*
+* Jobs are queued with XZDma_MemcpySubmit() and run on the channels added with
+* XZDma_MemcpyAddChannel(), up to all the 8 channels of GDMA or ADMA. Every
+* channel runs in scatter gather mode with linear descriptors owned by the
+* queue. When a channel is idle the queued jobs are dealt to it as one
+* descriptor chain of up to XZDMA_MEMCPY_CHAIN_LEN jobs, when several channels
+* are idle each job goes to the one with the fewest bytes so far. When the
+* chain is done the handler of every job is called and the descriptors are
+* reused for the next chain.
+*
+* The application connects XZDma_IntrHandler() of every channel to the
+* interrupt controller, the queue installs the channel callbacks. Job handlers
+* run in interrupt context and may submit new jobs.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- ------------------------------------------------------
+* 1.8   adk    10/15/19  First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xzdma.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XZDMA_MEMCPY_QUEUE_MASK	(XZDMA_MEMCPY_QUEUE_DEPTH - 1U)
+
+/* Errors which stop the channel */
+#define XZDMA_MEMCPY_AXI_ERR_MASK	(XZDMA_IXR_AXI_WR_DATA_MASK | \
+					XZDMA_IXR_AXI_RD_DATA_MASK | \
+					XZDMA_IXR_AXI_RD_DST_DSCR_MASK | \
+					XZDMA_IXR_AXI_RD_SRC_DSCR_MASK)
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+
+/**************************** Type Definitions *******************************/
+
+
+/************************** Function Prototypes ******************************/
+
+static s32 XZDma_MemcpySetupChannel(XZDma_MemcpyChannel *ChannelPtr);
+static void XZDma_MemcpyLock(XZDma_Memcpy *MemcpyPtr);
+static void XZDma_MemcpyUnlock(XZDma_Memcpy *MemcpyPtr);
+static void XZDma_MemcpyDispatch(XZDma_Memcpy *MemcpyPtr);
+static void XZDma_MemcpyStartChain(XZDma_MemcpyChannel *ChannelPtr);
+static void XZDma_MemcpyComplete(XZDma_MemcpyChannel *ChannelPtr, s32 Status);
+static void XZDma_MemcpyDoneHandler(void *CallBackRef);
+static void XZDma_MemcpyErrorHandler(void *CallBackRef, u32 Mask);
+
+/************************** Variable Definitions *****************************/
+
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a memcpy job queue with no channel.
+*
+* @param	MemcpyPtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XZDma_MemcpyInitialize(XZDma_Memcpy *MemcpyPtr)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(MemcpyPtr != NULL);
+
+	MemcpyPtr->NumChannels = 0x00U;
+	MemcpyPtr->Head = 0x00U;
+	MemcpyPtr->Tail = 0x00U;
+	MemcpyPtr->Running = 0x00U;
+	MemcpyPtr->Locked = 0x00U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds a channel to a memcpy job queue. The channel is set in
+* scatter gather mode with the linear descriptors of the queue and its done
+* and error callbacks are installed.
+*
+* @param	MemcpyPtr is a pointer to the XZDma_Memcpy instance.
+* @param	InstancePtr is a pointer to an initialized and idle XZDma
+*		instance. It belongs to the queue until the application resets
+*		it.
+*
+* @return
+*		- XST_SUCCESS if the channel is added.
+*		- XST_FAILURE if XZDMA_MEMCPY_MAX_CHANNELS channels are added
+*		or if the channel is busy.
+*
+* @note		All the channels of a queue must have the same cache coherency.
+*		The data configuration set with XZDma_SetChDataConfig() before
+*		this call is kept.
+*
+******************************************************************************/
+s32 XZDma_MemcpyAddChannel(XZDma_Memcpy *MemcpyPtr, XZDma *InstancePtr)
+{
+	XZDma_MemcpyChannel *ChannelPtr;
+	s32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(MemcpyPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady ==
+				(u32)(XIL_COMPONENT_IS_READY));
+	Xil_AssertNonvoid((MemcpyPtr->NumChannels == 0x00U) ||
+		(InstancePtr->Config.IsCacheCoherent ==
+		MemcpyPtr->Channel[0].Dma->Config.IsCacheCoherent));
+
+	if (MemcpyPtr->NumChannels >= XZDMA_MEMCPY_MAX_CHANNELS) {
+		Status = XST_FAILURE;
+		goto End;
+	}
+
+	ChannelPtr = &MemcpyPtr->Channel[MemcpyPtr->NumChannels];
+	ChannelPtr->Dma = InstancePtr;
+	ChannelPtr->Memcpy = MemcpyPtr;
+	ChannelPtr->NumJobs = 0x00U;
+	ChannelPtr->Bytes = 0x00U;
+
+	Status = XZDma_MemcpySetupChannel(ChannelPtr);
+	if (Status == XST_SUCCESS) {
+		MemcpyPtr->NumChannels++;
+	}
+
+End:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function queues a copy. The job is started right away when a channel
+* is idle, else when a channel completes its chain.
+*
+* @param	MemcpyPtr is a pointer to the XZDma_Memcpy instance.
+* @param	JobPtr is a pointer to the job. It is copied, so it can be
+*		reused once this function returns.
+*
+* @return
+*		- XST_SUCCESS if the job is queued.
+*		- XST_INVALID_PARAM if the size is 0 or above
+*		XZDMA_MEMCPY_MAX_SIZE.
+*		- XST_DEVICE_BUSY if XZDMA_MEMCPY_QUEUE_DEPTH jobs are waiting
+*		for a channel.
+*		- XST_FAILURE if the queue has no channel.
+*
+* @note		When the channels are not cache coherent the source and
+*		destination buffers are flushed here and the destination is
+*		invalidated again before the handler is called. The destination
+*		should be cache line aligned and a multiple of the cache line
+*		size.
+*
+******************************************************************************/
+s32 XZDma_MemcpySubmit(XZDma_Memcpy *MemcpyPtr, XZDma_MemcpyJob *JobPtr)
+{
+	s32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(MemcpyPtr != NULL);
+	Xil_AssertNonvoid(JobPtr != NULL);
+
+	if ((JobPtr->Size == 0x00U) || (JobPtr->Size > XZDMA_MEMCPY_MAX_SIZE)) {
+		Status = XST_INVALID_PARAM;
+		goto End;
+	}
+
+	if (MemcpyPtr->NumChannels == 0x00U) {
+		Status = XST_FAILURE;
+		goto End;
+	}
+
+	if (MemcpyPtr->Channel[0].Dma->Config.IsCacheCoherent == 0U) {
+		Xil_DCacheFlushRange(JobPtr->SrcAddr, JobPtr->Size);
+		Xil_DCacheFlushRange(JobPtr->DstAddr, JobPtr->Size);
+	}
+
+	XZDma_MemcpyLock(MemcpyPtr);
+
+	if ((MemcpyPtr->Head - MemcpyPtr->Tail) >= XZDMA_MEMCPY_QUEUE_DEPTH) {
+		Status = XST_DEVICE_BUSY;
+	}
+	else {
+		MemcpyPtr->Queue[MemcpyPtr->Head & XZDMA_MEMCPY_QUEUE_MASK] =
+								*JobPtr;
+		MemcpyPtr->Head++;
+		Status = XST_SUCCESS;
+	}
+
+	XZDma_MemcpyUnlock(MemcpyPtr);
+
+End:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the number of jobs submitted and not completed, the
+* running ones included.
+*
+* @param	MemcpyPtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	Number of pending jobs.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XZDma_MemcpyPending(XZDma_Memcpy *MemcpyPtr)
+{
+	/* Verify arguments */
+	Xil_AssertNonvoid(MemcpyPtr != NULL);
+
+	return (MemcpyPtr->Head - MemcpyPtr->Tail) + MemcpyPtr->Running;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets a channel in scatter gather mode with the descriptors
+* of the queue, installs the callbacks and enables the done and AXI error
+* interrupts.
+*
+* @param	ChannelPtr is a pointer to the channel.
+*
+* @return
+*		- XST_SUCCESS if the channel is set.
+*		- XST_FAILURE if the channel is busy.
+*
+* @note		None.
+*
+******************************************************************************/
+static s32 XZDma_MemcpySetupChannel(XZDma_MemcpyChannel *ChannelPtr)
+{
+	XZDma *InstancePtr = ChannelPtr->Dma;
+	s32 Status;
+
+	Status = XZDma_SetMode(InstancePtr, TRUE, XZDMA_NORMAL_MODE);
+	if (Status != XST_SUCCESS) {
+		goto End;
+	}
+
+	(void)XZDma_CreateBDList(InstancePtr, XZDMA_LINEAR,
+			(UINTPTR)ChannelPtr->Dscr, sizeof(ChannelPtr->Dscr));
+
+	(void)XZDma_SetCallBack(InstancePtr, XZDMA_HANDLER_DONE,
+			(void *)XZDma_MemcpyDoneHandler, ChannelPtr);
+	(void)XZDma_SetCallBack(InstancePtr, XZDMA_HANDLER_ERROR,
+			(void *)XZDma_MemcpyErrorHandler, ChannelPtr);
+
+	XZDma_EnableIntr(InstancePtr, (XZDMA_IXR_DMA_DONE_MASK |
+					XZDMA_MEMCPY_AXI_ERR_MASK));
+
+End:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function keeps the interrupts of all the channels out while the queue
+* is updated. It nests, the interrupts are enabled again by the outermost
+* XZDma_MemcpyUnlock().
+*
+* @param	MemcpyPtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	None.
+*
+* @note		The count is raised before the channels are masked, a channel
+*		interrupt taken in between completes its chain but leaves the
+*		dispatch to the outermost unlock.
+*
+******************************************************************************/
+static void XZDma_MemcpyLock(XZDma_Memcpy *MemcpyPtr)
+{
+	u32 Index;
+
+	MemcpyPtr->Locked++;
+
+	for (Index = 0x00U; Index < MemcpyPtr->NumChannels; Index++) {
+		XZDma_DisableIntr(MemcpyPtr->Channel[Index].Dma,
+					XZDMA_IXR_ALL_INTR_MASK);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function releases the lock taken by XZDma_MemcpyLock(). The outermost
+* unlock deals the queued jobs to the idle channels and then enables the
+* interrupts of the busy channels again.
+*
+* @param	MemcpyPtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XZDma_MemcpyUnlock(XZDma_Memcpy *MemcpyPtr)
+{
+	XZDma *InstancePtr;
+	u32 Index;
+
+	if (MemcpyPtr->Locked > 0x01U) {
+		MemcpyPtr->Locked--;
+	}
+	else {
+		XZDma_MemcpyDispatch(MemcpyPtr);
+		MemcpyPtr->Locked = 0x00U;
+
+		for (Index = 0x00U; Index < MemcpyPtr->NumChannels; Index++) {
+			InstancePtr = MemcpyPtr->Channel[Index].Dma;
+			if (InstancePtr->ChannelState == XZDMA_BUSY) {
+				XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+					XZDMA_CH_IEN_OFFSET,
+					(InstancePtr->IntrMask &
+					XZDMA_IXR_ALL_INTR_MASK));
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function deals the queued jobs to the idle channels, each job to the
+* idle channel with the fewest bytes and room left in its chain, and starts
+* the chains.
+*
+* @param	MemcpyPtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	None.
+*
+* @note		Called with the queue locked.
+*
+******************************************************************************/
+static void XZDma_MemcpyDispatch(XZDma_Memcpy *MemcpyPtr)
+{
+	XZDma_MemcpyChannel *ChannelPtr;
+	XZDma_MemcpyChannel *LeastPtr;
+	XZDma_MemcpyJob *JobPtr;
+	u32 Idle = 0x00U;
+	u32 Index;
+
+	for (Index = 0x00U; Index < MemcpyPtr->NumChannels; Index++) {
+		ChannelPtr = &MemcpyPtr->Channel[Index];
+		if ((ChannelPtr->NumJobs == 0x00U) &&
+			(ChannelPtr->Dma->ChannelState == XZDMA_IDLE)) {
+			Idle |= ((u32)1U << Index);
+		}
+	}
+
+	while ((Idle != 0x00U) && (MemcpyPtr->Tail != MemcpyPtr->Head)) {
+		LeastPtr = NULL;
+		for (Index = 0x00U; Index < MemcpyPtr->NumChannels; Index++) {
+			ChannelPtr = &MemcpyPtr->Channel[Index];
+			if (((Idle & ((u32)1U << Index)) == 0x00U) ||
+				(ChannelPtr->NumJobs >=
+					XZDMA_MEMCPY_CHAIN_LEN)) {
+				continue;
+			}
+			if ((LeastPtr == NULL) ||
+				(ChannelPtr->Bytes < LeastPtr->Bytes)) {
+				LeastPtr = ChannelPtr;
+			}
+		}
+		if (LeastPtr == NULL) {
+			break;
+		}
+
+		JobPtr = &MemcpyPtr->Queue[MemcpyPtr->Tail &
+					XZDMA_MEMCPY_QUEUE_MASK];
+		LeastPtr->Jobs[LeastPtr->NumJobs] = *JobPtr;
+		LeastPtr->NumJobs++;
+		LeastPtr->Bytes += JobPtr->Size;
+		MemcpyPtr->Tail++;
+		MemcpyPtr->Running++;
+	}
+
+	for (Index = 0x00U; Index < MemcpyPtr->NumChannels; Index++) {
+		ChannelPtr = &MemcpyPtr->Channel[Index];
+		if (((Idle & ((u32)1U << Index)) != 0x00U) &&
+				(ChannelPtr->NumJobs != 0x00U)) {
+			XZDma_MemcpyStartChain(ChannelPtr);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes the jobs of a channel in its descriptors and starts
+* the chain.
+*
+* @param	ChannelPtr is a pointer to the channel.
+*
+* @return	None.
+*
+* @note		The interrupts of the channel are left disabled,
+*		XZDma_MemcpyUnlock() enables them.
+*
+******************************************************************************/
+static void XZDma_MemcpyStartChain(XZDma_MemcpyChannel *ChannelPtr)
+{
+	XZDma_Transfer Data[XZDMA_MEMCPY_CHAIN_LEN];
+	XZDma *InstancePtr = ChannelPtr->Dma;
+	u32 IntrMask;
+	u32 Index;
+	u8 Coherent = (u8)InstancePtr->Config.IsCacheCoherent;
+
+	for (Index = 0x00U; Index < ChannelPtr->NumJobs; Index++) {
+		Data[Index].SrcAddr = ChannelPtr->Jobs[Index].SrcAddr;
+		Data[Index].DstAddr = ChannelPtr->Jobs[Index].DstAddr;
+		Data[Index].Size = ChannelPtr->Jobs[Index].Size;
+		Data[Index].SrcCoherent = Coherent;
+		Data[Index].DstCoherent = Coherent;
+		Data[Index].Pause = FALSE;
+	}
+
+	IntrMask = InstancePtr->IntrMask;
+	InstancePtr->IntrMask = 0x00U;
+	(void)XZDma_Start(InstancePtr, Data, ChannelPtr->NumJobs);
+	InstancePtr->IntrMask = IntrMask;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function completes the jobs of the chain of a channel and calls their
+* handlers. The descriptors of the channel are free when it returns.
+*
+* @param	ChannelPtr is a pointer to the channel.
+* @param	Status is passed to the handlers.
+*
+* @return	None.
+*
+* @note		Called with the queue locked, so a job submitted by a handler
+*		is only queued.
+*
+******************************************************************************/
+static void XZDma_MemcpyComplete(XZDma_MemcpyChannel *ChannelPtr, s32 Status)
+{
+	XZDma_Memcpy *MemcpyPtr = ChannelPtr->Memcpy;
+	XZDma_MemcpyJob *JobPtr;
+	u32 Index;
+
+	for (Index = 0x00U; Index < ChannelPtr->NumJobs; Index++) {
+		JobPtr = &ChannelPtr->Jobs[Index];
+		if (ChannelPtr->Dma->Config.IsCacheCoherent == 0U) {
+			Xil_DCacheInvalidateRange(JobPtr->DstAddr,
+							JobPtr->Size);
+		}
+		MemcpyPtr->Running--;
+		if (JobPtr->Handler != NULL) {
+			JobPtr->Handler(JobPtr->CallBackRef, Status);
+		}
+	}
+
+	ChannelPtr->NumJobs = 0x00U;
+	ChannelPtr->Bytes = 0x00U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the done callback of the channels of a memcpy queue. It
+* completes the jobs of the chain and starts the next chain.
+*
+* @param	CallBackRef is a pointer to the channel.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XZDma_MemcpyDoneHandler(void *CallBackRef)
+{
+	XZDma_MemcpyChannel *ChannelPtr =
+				(XZDma_MemcpyChannel *)CallBackRef;
+
+	XZDma_MemcpyLock(ChannelPtr->Memcpy);
+	XZDma_MemcpyComplete(ChannelPtr, XST_SUCCESS);
+	XZDma_MemcpyUnlock(ChannelPtr->Memcpy);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the error callback of the channels of a memcpy queue. On
+* an AXI error, which stops the channel, the channel is reset and set up
+* again and the jobs of its chain complete with XST_FAILURE.
+*
+* @param	CallBackRef is a pointer to the channel.
+* @param	Mask is the error interrupt mask.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XZDma_MemcpyErrorHandler(void *CallBackRef, u32 Mask)
+{
+	XZDma_MemcpyChannel *ChannelPtr =
+				(XZDma_MemcpyChannel *)CallBackRef;
+
+	if (((Mask & XZDMA_MEMCPY_AXI_ERR_MASK) == 0x00U) ||
+		(ChannelPtr->Dma->ChannelState != XZDMA_IDLE)) {
+		return;
+	}
+
+	XZDma_MemcpyLock(ChannelPtr->Memcpy);
+	XZDma_Reset(ChannelPtr->Dma);
+	(void)XZDma_MemcpySetupChannel(ChannelPtr);
+	XZDma_MemcpyComplete(ChannelPtr, XST_FAILURE);
+	XZDma_MemcpyUnlock(ChannelPtr->Memcpy);
+}
+/** @} */
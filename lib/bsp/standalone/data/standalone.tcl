@@ -54,6 +54,11 @@
 #                     accessible to the cortexr5 processor CR#1015725
 # 7.1   mus  05/20/19 Updated outbyte/inbyte in case stdout/stdin is set as
 #                     "none". This is done to fix warnings CR#1031423
+# 7.1   mus  10/14/19 Export XIL_TRACE_ENABLE and XIL_TRACE_RECORDS to
+#                     bspconfig.h based on the trace_buffer parameters.
+# 7.1   mus  10/14/19 Export XIL_PRINTF_BUF_SIZE and XIL_PRINTF_DEFERRED_ENTRIES
+#                     to bspconfig.h based on the xil_printf_buffering
+#                     parameters.
 #
 ##############################################################################
 
@@ -728,6 +733,34 @@ proc generate {os_handle} {
 			}
 		}
     }
+
+    if { $proctype != "microblaze" } {
+	set enable_trace [common::get_property CONFIG.enable_trace_buffer $os_handle]
+	if { $enable_trace == "true" } {
+		set trace_records [common::get_property CONFIG.trace_buffer_records $os_handle]
+		if { $trace_records <= 0 || ($trace_records & ($trace_records - 1)) != 0 } {
+			error "ERROR: trace_buffer_records must be a power of two"
+		}
+		puts $bspcfg_fh ""
+		puts $bspcfg_fh "/* Definitions for the trace buffer */"
+		puts $bspcfg_fh "#define XIL_TRACE_ENABLE 1"
+		puts $bspcfg_fh "#define XIL_TRACE_RECORDS ${trace_records}U"
+	}
+    }
+
+    set printf_buf_size [common::get_property CONFIG.xil_printf_buffer_size $os_handle]
+    set printf_deferred [common::get_property CONFIG.xil_printf_deferred_entries $os_handle]
+    foreach {name value} [list xil_printf_buffer_size $printf_buf_size xil_printf_deferred_entries $printf_deferred] {
+	if { $value < 0 || ($value & ($value - 1)) != 0 } {
+		error "ERROR: $name must be 0 or a power of two"
+	}
+    }
+    if { $printf_buf_size > 0 || $printf_deferred > 0 } {
+	puts $bspcfg_fh ""
+	puts $bspcfg_fh "/* Definitions for the xil_printf output rings */"
+	puts $bspcfg_fh "#define XIL_PRINTF_BUF_SIZE ${printf_buf_size}U"
+	puts $bspcfg_fh "#define XIL_PRINTF_DEFERRED_ENTRIES ${printf_deferred}U"
+    }
 	puts $bspcfg_fh ""
     puts $bspcfg_fh "\#endif /*end of __BSPCONFIG_H_*/"
     close $bspcfg_fh
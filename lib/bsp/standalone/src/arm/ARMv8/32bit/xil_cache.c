@@ -45,6 +45,9 @@
  * 6.8  asa  11/10/18 Fix issues in cache Xil_DCacheInvalidate and
  * 			Xil_DCacheFlush that got introduced in the optimization
  * 			changes done in the previous patch for this file.
+ * 7.1  mus  10/14/19 Added Xil_DCacheInvalidateRangeNoDsb and
+ *			Xil_DCacheFlushRangeNoDsb, used by the Xil_DCacheBatch
+ *			APIs to issue several ranges with a single barrier.
  *
  ******************************************************************************/
  /***************************** Include Files *********************************/
@@ -488,6 +491,83 @@ void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 	mtcpsr(currmask);
 }
 
+/****************************************************************************/
+/**
+ * @brief	Invalidate the Data cache lines of the given address range
+ *		without waiting for the operations to complete. Unaligned
+ *		start and end lines are flushed first, as in
+ *		Xil_DCacheInvalidateRange.
+ *
+ * @param	adr: 32bit start address of the range to be invalidated.
+ * @param	len: Length of the range to be invalidated in bytes.
+ *
+ * @return	None.
+ *
+ * @notice	The maintenance is done by MVA to the point of coherency, one
+ *		operation covers all cache levels. The caller must mask IRQ/FIQ
+ *		and issue a dsb before relying on the result. Used by the
+ *		Xil_DCacheBatch APIs.
+ *
+ ****************************************************************************/
+void Xil_DCacheInvalidateRangeNoDsb(INTPTR adr, u32 len)
+{
+	const u32 cacheline = 64U;
+	u32 tempadr = adr;
+	u32 tempend;
+
+	if (len != 0U) {
+		tempend = tempadr + len;
+
+		if ((tempadr & (cacheline-1U)) != 0U) {
+			tempadr &= (~(cacheline - 1U));
+			Xil_DCacheFlushLine(tempadr);
+			tempadr += cacheline;
+		}
+		if ((tempend & (cacheline-1U)) != 0U) {
+			tempend &= (~(cacheline - 1U));
+			Xil_DCacheFlushLine(tempend);
+		}
+
+		while (tempadr < tempend) {
+			mtcp(XREG_CP15_INVAL_DC_LINE_MVA_POC, tempadr);
+			tempadr += cacheline;
+		}
+	}
+}
+
+/****************************************************************************/
+/**
+ * @brief	Flush the Data cache lines of the given address range without
+ *		waiting for the operations to complete.
+ *
+ * @param	adr: 32bit start address of the range to be flushed.
+ * @param	len: Length of range to be flushed in bytes.
+ *
+ * @return	None.
+ *
+ * @notice	The maintenance is done by MVA to the point of coherency, one
+ *		operation covers all cache levels. The caller must mask IRQ/FIQ
+ *		and issue a dsb before relying on the result. Used by the
+ *		Xil_DCacheBatch APIs.
+ *
+ ****************************************************************************/
+void Xil_DCacheFlushRangeNoDsb(INTPTR adr, u32 len)
+{
+	const u32 cacheline = 64U;
+	u32 tempadr = adr;
+	u32 end;
+
+	if (len != 0U) {
+		end = tempadr + len;
+		tempadr &= (~(cacheline - 1U));
+
+		while (tempadr < end) {
+			mtcp(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC, tempadr);
+			tempadr += cacheline;
+		}
+	}
+}
+
 /****************************************************************************/
 /**
  * @brief	Enable the instruction cache.
@@ -43,6 +43,7 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 5.2	pkp  28/05/15 First release
+* 7.1	mus  10/14/19 Added the NoDsb range variants.
 * </pre>
 *
 ******************************************************************************/
@@ -59,8 +60,10 @@ void Xil_DCacheEnable(void);
 void Xil_DCacheDisable(void);
 void Xil_DCacheInvalidate(void);
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len);
+void Xil_DCacheInvalidateRangeNoDsb(INTPTR adr, u32 len);
 void Xil_DCacheFlush(void);
 void Xil_DCacheFlushRange(INTPTR adr, u32 len);
+void Xil_DCacheFlushRangeNoDsb(INTPTR adr, u32 len);
 void Xil_DCacheInvalidateLine(u32 adr);
 void Xil_DCacheFlushLine(u32 adr);
 
@@ -80,6 +80,9 @@
 *                    Xil_DCacheFlushRange function implementation and defined it as
 *                    macro. Xil_DCacheFlushRange macro points to the
 *                    Xil_DCacheInvalidateRange API to avoid code duplication.
+* 7.1 mus  10/14/19  Added Xil_DCacheInvalidateRangeNoDsb, used by the
+*                    Xil_DCacheBatch APIs to issue several ranges with a
+*                    single barrier.
 *
 * </pre>
 *
@@ -432,21 +435,41 @@ void Xil_DCacheInvalidateLine(INTPTR adr)
 *
 ****************************************************************************/
 void Xil_DCacheInvalidateRange(INTPTR  adr, INTPTR len)
+{
+	u32 currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+	Xil_DCacheInvalidateRangeNoDsb(adr, len);
+	/* Wait for invalidate to complete */
+	dsb();
+	mtcpsr(currmask);
+}
+
+/****************************************************************************/
+/**
+* @brief	Clean and invalidate the Data cache lines of the given address
+*			range without waiting for the operations to complete.
+*
+* @param	adr: 64bit start address of the range to be invalidated.
+* @param	len: Length of the range to be invalidated in bytes.
+*
+* @return	None.
+*
+* @note		The caller must mask IRQ/FIQ and issue a dsb before relying on
+*			the result. Used by the Xil_DCacheBatch APIs so that several
+*			ranges complete with a single barrier.
+*
+****************************************************************************/
+void Xil_DCacheInvalidateRangeNoDsb(INTPTR adr, INTPTR len)
 {
 	const INTPTR cacheline = 64U;
 	INTPTR end = adr + len;
 	adr = adr & (~0x3F);
-	u32 currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
 	if (len != 0U) {
 		while (adr < end) {
 			mtcpdc(CIVAC,adr);
 			adr += cacheline;
 		}
 	}
-	/* Wait for invalidate to complete */
-	dsb();
-	mtcpsr(currmask);
 }
 
 /****************************************************************************/
@@ -43,6 +43,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 5.00 	pkp  05/29/14 First release
+* 7.1   mus  10/14/19 Added Xil_DCacheInvalidateRangeNoDsb and the
+*                     Xil_DCacheFlushRangeNoDsb alias.
 * </pre>
 *
 ******************************************************************************/
@@ -61,12 +63,14 @@ extern "C" {
 
 /***************** Macros (Inline Functions) Definitions *********************/
 #define Xil_DCacheFlushRange Xil_DCacheInvalidateRange
+#define Xil_DCacheFlushRangeNoDsb Xil_DCacheInvalidateRangeNoDsb
 
 /************************** Function Prototypes ******************************/
 void Xil_DCacheEnable(void);
 void Xil_DCacheDisable(void);
 void Xil_DCacheInvalidate(void);
 void Xil_DCacheInvalidateRange(INTPTR adr, INTPTR len);
+void Xil_DCacheInvalidateRangeNoDsb(INTPTR adr, INTPTR len);
 void Xil_DCacheInvalidateLine(INTPTR adr);
 void Xil_DCacheFlush(void);
 void Xil_DCacheFlushLine(INTPTR adr);
@@ -39,6 +39,9 @@
 * ----- ---- -------- ---------------------------------------------------
 * 5.00 	pkp  05/29/14 First release
 * 6.02  pkp	 01/22/17 Added support for EL1 non-secure
+* 7.1   adk  10/15/19 Added Xil_SetTlbAttributesRange and
+*                     Xil_SetTlbAttributesRegions, which map a range with the
+*                     largest possible blocks and invalidate the TLB once.
 * </pre>
 *
 * @note
@@ -63,6 +66,9 @@
 #define BLOCK_SIZE_2MB 0x200000U
 #define BLOCK_SIZE_1GB 0x40000000U
 #define ADDRESS_LIMIT_4GB 0x100000000UL
+#define L2_ENTRIES 512U
+#define DESC_TYPE_MASK 0x3U
+#define DESC_TYPE_TABLE 0x3U
 
 /************************** Variable Definitions *****************************/
 
@@ -70,6 +76,12 @@ extern INTPTR MMUTableL1;
 extern INTPTR MMUTableL2;
 
 /************************** Function Prototypes ******************************/
+
+static void Xil_MmuSetBlock2MB(UINTPTR Addr, u64 attrib);
+static void Xil_MmuSetBlock1GB(UINTPTR Addr, u64 attrib);
+static void Xil_MmuMapRange(UINTPTR Addr, u64 Size, u64 attrib);
+static void Xil_MmuSync(void);
+
 /*****************************************************************************/
 /**
 * brief		It sets the memory attributes for a section, in the translation
@@ -91,25 +103,181 @@ extern INTPTR MMUTableL2;
 ******************************************************************************/
 void Xil_SetTlbAttributes(UINTPTR Addr, u64 attrib)
 {
-	INTPTR *ptr;
-	INTPTR section;
-	u64 block_size;
 	/* if region is less than 4GB MMUTable level 2 need to be modified */
 	if(Addr < ADDRESS_LIMIT_4GB){
-		/* block size is 2MB for addressed < 4GB*/
-		block_size = BLOCK_SIZE_2MB;
-		section = Addr / block_size;
-		ptr = &MMUTableL2 + section;
+		Xil_MmuSetBlock2MB(Addr, attrib);
 	}
 	/* if region is greater than 4GB MMUTable level 1 need to be modified */
 	else{
-		/* block size is 1GB for addressed > 4GB */
-		block_size = BLOCK_SIZE_1GB;
-		section = Addr / block_size;
-		ptr = &MMUTableL1 + section;
+		Xil_MmuSetBlock1GB(Addr & (~((UINTPTR)BLOCK_SIZE_1GB-1)), attrib);
+	}
+
+	Xil_MmuSync();
+}
+
+/*****************************************************************************/
+/**
+* brief		It sets the memory attributes for a range of memory, in the
+*			translation table. The range is mapped with 1GB blocks wherever
+*			it covers a whole 1GB aligned region and with 2MB blocks for
+*			the rest of the range below 4GB. Above 4GB the granularity is
+*			1GB, as for Xil_SetTlbAttributes. The TLB is invalidated once,
+*			after all the descriptors are written.
+*
+* @param	Addr: 64-bit start address of the range.
+* @param	Size: Size of the range in bytes. The range is extended to the
+*			block boundaries.
+* @param	attrib: Attribute for the specified memory region. xil_mmu.h
+*			contains commonly used memory attributes definitions which can be
+*			utilized for this function.
+*
+* @return	None.
+*
+* @note		The MMU and D-cache need not be disabled before changing an
+*			translation table attribute.
+*
+******************************************************************************/
+void Xil_SetTlbAttributesRange(UINTPTR Addr, u64 Size, u64 attrib)
+{
+	Xil_MmuMapRange(Addr, Size, attrib);
+	Xil_MmuSync();
+}
+
+/*****************************************************************************/
+/**
+* brief		It applies a list of memory regions to the translation table,
+*			typically at boot before the caches are used for the regions.
+*			Each region is mapped as by Xil_SetTlbAttributesRange, in the
+*			order given, so that a later region overrides an earlier one
+*			where they overlap. The TLB is invalidated once for the list.
+*
+* @param	RegionPtr: Pointer to the array of regions.
+* @param	NumRegions: Number of regions in the array.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_SetTlbAttributesRegions(const Xil_MmuRegion *RegionPtr, u32 NumRegions)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < NumRegions; Index++) {
+		Xil_MmuMapRange(RegionPtr[Index].Addr, RegionPtr[Index].Size,
+				RegionPtr[Index].Attrib);
+	}
+	Xil_MmuSync();
+}
+
+/*****************************************************************************/
+/**
+* brief		It writes the level 2 descriptor of a 2MB block below 4GB. If
+*			the 1GB region holding the block is mapped by a level 1 block,
+*			the level 1 entry is turned back into a table descriptor; the
+*			level 2 table is kept in step with such blocks by
+*			Xil_MmuSetBlock1GB.
+*
+* @param	Addr: Address within the 2MB block.
+* @param	attrib: Attribute for the block.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Xil_MmuSetBlock2MB(UINTPTR Addr, u64 attrib)
+{
+	INTPTR *ptr;
+	INTPTR *L1ptr;
+
+	ptr = &MMUTableL2 + (Addr / BLOCK_SIZE_2MB);
+	*ptr = (Addr & (~((UINTPTR)BLOCK_SIZE_2MB-1))) | attrib;
+
+	L1ptr = &MMUTableL1 + (Addr / BLOCK_SIZE_1GB);
+	if (((u64)*L1ptr & DESC_TYPE_MASK) != DESC_TYPE_TABLE) {
+		*L1ptr = (INTPTR)(&MMUTableL2 +
+				((Addr / BLOCK_SIZE_1GB) * L2_ENTRIES)) |
+				DESC_TYPE_TABLE;
+	}
+}
+
+/*****************************************************************************/
+/**
+* brief		It writes the level 1 descriptor of a 1GB block. Below 4GB the
+*			512 level 2 entries of the region are updated as well, so that
+*			a later 2MB change can split the block again.
+*
+* @param	Addr: 1GB aligned address of the block.
+* @param	attrib: Attribute for the block.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Xil_MmuSetBlock1GB(UINTPTR Addr, u64 attrib)
+{
+	INTPTR *ptr;
+	u32 Index;
+
+	if (Addr < ADDRESS_LIMIT_4GB) {
+		ptr = &MMUTableL2 + (Addr / BLOCK_SIZE_2MB);
+		for (Index = 0U; Index < L2_ENTRIES; Index++) {
+			ptr[Index] = (Addr + ((UINTPTR)Index * BLOCK_SIZE_2MB)) |
+					attrib;
+		}
+	}
+
+	ptr = &MMUTableL1 + (Addr / BLOCK_SIZE_1GB);
+	*ptr = Addr | attrib;
+}
+
+/*****************************************************************************/
+/**
+* brief		It writes the descriptors of a range with the largest blocks
+*			possible, without any TLB maintenance.
+*
+* @param	Addr: Start address of the range.
+* @param	Size: Size of the range in bytes.
+* @param	attrib: Attribute for the range.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Xil_MmuMapRange(UINTPTR Addr, u64 Size, u64 attrib)
+{
+	UINTPTR Cur;
+	UINTPTR End;
+
+	if (Size == 0U) {
+		return;
+	}
+	End = Addr + Size;
+
+	if (Addr < ADDRESS_LIMIT_4GB) {
+		Cur = Addr & (~((UINTPTR)BLOCK_SIZE_2MB-1));
+	} else {
+		Cur = Addr & (~((UINTPTR)BLOCK_SIZE_1GB-1));
 	}
-	*ptr = (Addr & (~(block_size-1))) | attrib;
 
+	while (Cur < End) {
+		if (((Cur & ((UINTPTR)BLOCK_SIZE_1GB-1)) == 0U) &&
+			((Cur >= ADDRESS_LIMIT_4GB) ||
+			((End - Cur) >= BLOCK_SIZE_1GB))) {
+			Xil_MmuSetBlock1GB(Cur, attrib);
+			Cur += BLOCK_SIZE_1GB;
+		} else {
+			Xil_MmuSetBlock2MB(Cur, attrib);
+			Cur += BLOCK_SIZE_2MB;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+* brief		It makes the translation table updates visible to the MMU and
+*			invalidates the TLB.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Xil_MmuSync(void)
+{
 	Xil_DCacheFlush();
 
 	if (EL3 == 1)
@@ -40,6 +40,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- ---------------------------------------------------
 * 5.00 	pkp  05/29/14 First release
+* 7.1   adk  10/15/19 Added Xil_MmuRegion, Xil_SetTlbAttributesRange and
+*                     Xil_SetTlbAttributesRegions
 * </pre>
 *
 * @note
@@ -63,6 +65,13 @@ extern "C" {
 
 /**************************** Type Definitions *******************************/
 
+/* Memory region for Xil_SetTlbAttributesRegions */
+typedef struct {
+	UINTPTR Addr;	/* Start address */
+	u64 Size;	/* Size in bytes */
+	u64 Attrib;	/* Memory attributes */
+} Xil_MmuRegion;
+
 /************************** Constant Definitions *****************************/
 
 /* Memory type */
@@ -96,6 +105,8 @@ extern "C" {
 /************************** Function Prototypes ******************************/
 
 void Xil_SetTlbAttributes(UINTPTR Addr, u64 attrib);
+void Xil_SetTlbAttributesRange(UINTPTR Addr, u64 Size, u64 attrib);
+void Xil_SetTlbAttributesRegions(const Xil_MmuRegion *RegionPtr, u32 NumRegions);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,213 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_cache_batch.c
+*
+* Contains the data cache batch functions, which merge the ranges of several
+* buffers and complete their maintenance with a single barrier. The line
+* operations are done by the processor specific Xil_DCacheFlushRangeNoDsb
+* and Xil_DCacheInvalidateRangeNoDsb APIs.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 7.1   mus  10/14/19 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_cache_batch.h"
+#include "xpseudo_asm.h"
+
+/************************** Constant Definitions *****************************/
+
+#define IRQ_FIQ_MASK 0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
+
+/************************** Function Prototypes ******************************/
+
+static void Xil_DCacheBatchDrain(Xil_DCacheBatch *Batch);
+
+/****************************************************************************/
+/**
+* @brief	Initialize an empty data cache batch.
+*
+* @param	Batch: Pointer to the batch.
+* @param	Op: XIL_DCACHE_BATCH_FLUSH to clean and invalidate the ranges
+*			or XIL_DCACHE_BATCH_INVALIDATE to invalidate them.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheBatchInit(Xil_DCacheBatch *Batch, u32 Op)
+{
+	Batch->Count = 0U;
+	Batch->Op = Op;
+	Batch->Bytes = 0U;
+	Batch->Drained = 0U;
+	Batch->FullFlush = 0U;
+}
+
+/****************************************************************************/
+/**
+* @brief	Add an address range to a data cache batch. The range is merged
+*			with every range of the batch it overlaps or touches. Flush
+*			ranges are widened to whole cache lines first, so buffers that
+*			share a line are merged as well. Invalidate ranges are kept at
+*			byte granularity, as the partial lines at their ends must be
+*			flushed rather than invalidated.
+*
+* @param	Batch: Pointer to the batch.
+* @param	Addr: Start address of the range.
+* @param	Len: Length of the range in bytes.
+*
+* @return	None.
+*
+* @note		When all the slots are in use, the line operations of the
+*			ranges collected so far are issued right away and only the dsb
+*			is left to Xil_DCacheBatchCommit.
+*
+****************************************************************************/
+void Xil_DCacheBatchAdd(Xil_DCacheBatch *Batch, INTPTR Addr, u32 Len)
+{
+	UINTPTR Start = (UINTPTR)Addr;
+	UINTPTR End = (UINTPTR)Addr + Len;
+	u32 Index;
+
+	if ((Len == 0U) || (Batch->FullFlush != 0U)) {
+		return;
+	}
+
+	Batch->Bytes += Len;
+	if ((Batch->Op == XIL_DCACHE_BATCH_FLUSH) &&
+	    (Batch->Bytes >= XIL_DCACHE_BATCH_FULL_FLUSH_SIZE)) {
+		Batch->FullFlush = 1U;
+		Batch->Count = 0U;
+		return;
+	}
+
+	if (Batch->Op == XIL_DCACHE_BATCH_FLUSH) {
+		Start &= ~((UINTPTR)XIL_DCACHE_BATCH_LINE_SIZE - 1U);
+		End = (End + XIL_DCACHE_BATCH_LINE_SIZE - 1U) &
+			~((UINTPTR)XIL_DCACHE_BATCH_LINE_SIZE - 1U);
+	}
+
+	/*
+	 * Absorb every range the new one overlaps or touches. A merge can make
+	 * the new range reach a slot that was already checked, so the scan is
+	 * restarted after each merge.
+	 */
+	Index = 0U;
+	while (Index < Batch->Count) {
+		if ((Start <= Batch->End[Index]) && (End >= Batch->Start[Index])) {
+			if (Batch->Start[Index] < Start) {
+				Start = Batch->Start[Index];
+			}
+			if (Batch->End[Index] > End) {
+				End = Batch->End[Index];
+			}
+			Batch->Count--;
+			Batch->Start[Index] = Batch->Start[Batch->Count];
+			Batch->End[Index] = Batch->End[Batch->Count];
+			Index = 0U;
+		} else {
+			Index++;
+		}
+	}
+
+	if (Batch->Count == XIL_DCACHE_BATCH_MAX_RANGES) {
+		Xil_DCacheBatchDrain(Batch);
+	}
+
+	Batch->Start[Batch->Count] = Start;
+	Batch->End[Batch->Count] = End;
+	Batch->Count++;
+}
+
+/****************************************************************************/
+/**
+* @brief	Complete a data cache batch. The line operations of all the
+*			ranges are issued with IRQ/FIQ masked and followed by a single
+*			dsb. A flush batch that went past the full flush threshold is
+*			completed with Xil_DCacheFlush instead. The batch is empty on
+*			return and can be reused for the same operation.
+*
+* @param	Batch: Pointer to the batch.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheBatchCommit(Xil_DCacheBatch *Batch)
+{
+	if (Batch->FullFlush != 0U) {
+		Xil_DCacheFlush();
+	} else if ((Batch->Count != 0U) || (Batch->Drained != 0U)) {
+		Xil_DCacheBatchDrain(Batch);
+		/* Wait for the maintenance of all the ranges to complete */
+		dsb();
+	}
+
+	Xil_DCacheBatchInit(Batch, Batch->Op);
+}
+
+/****************************************************************************/
+/**
+* @brief	Issue the line operations of the ranges of a batch without
+*			waiting for them to complete and empty the range slots.
+*
+* @param	Batch: Pointer to the batch.
+*
+* @return	None.
+*
+****************************************************************************/
+static void Xil_DCacheBatchDrain(Xil_DCacheBatch *Batch)
+{
+	u32 currmask;
+	u32 Index;
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	for (Index = 0U; Index < Batch->Count; Index++) {
+		if (Batch->Op == XIL_DCACHE_BATCH_FLUSH) {
+			Xil_DCacheFlushRangeNoDsb((INTPTR)Batch->Start[Index],
+				(u32)(Batch->End[Index] - Batch->Start[Index]));
+		} else {
+			Xil_DCacheInvalidateRangeNoDsb((INTPTR)Batch->Start[Index],
+				(u32)(Batch->End[Index] - Batch->Start[Index]));
+		}
+	}
+
+	mtcpsr(currmask);
+
+	Batch->Count = 0U;
+	Batch->Drained = 1U;
+}
@@ -0,0 +1,138 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_cache_batch.h
+*
+* @addtogroup arm_cache_batch_apis ARM Data Cache Batch Functions
+*
+* The batch APIs collect the address ranges of several buffers that need the
+* same data cache maintenance, for example all the fragments of a frame that
+* is handed to a DMA engine. Adjacent and overlapping ranges are merged as
+* they are added and Xil_DCacheBatchCommit issues the line operations of all
+* the ranges followed by a single dsb, instead of a loop setup and a barrier
+* per buffer.
+*
+* A flush batch that grows beyond XIL_DCACHE_BATCH_FULL_FLUSH_SIZE bytes is
+* committed with Xil_DCacheFlush, as cleaning the whole cache by set/way is
+* then cheaper than walking the ranges line by line. Invalidate batches are
+* always done by range.
+*
+* A batch is a plain structure, usually placed on the stack of the caller:
+* @code
+*	Xil_DCacheBatch Batch;
+*
+*	Xil_DCacheBatchInit(&Batch, XIL_DCACHE_BATCH_FLUSH);
+*	for (each buffer)
+*		Xil_DCacheBatchAdd(&Batch, (INTPTR)Buf, Len);
+*	Xil_DCacheBatchCommit(&Batch);
+* @endcode
+*
+* @{
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 7.1   mus  10/14/19 First release
+* </pre>
+*
+******************************************************************************/
+#ifndef XIL_CACHE_BATCH_H
+#define XIL_CACHE_BATCH_H
+
+#include "xil_types.h"
+#include "xil_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************** Constant Definitions *****************************/
+
+/* Batch operations */
+#define XIL_DCACHE_BATCH_FLUSH		0U	/* clean and invalidate */
+#define XIL_DCACHE_BATCH_INVALIDATE	1U
+
+/* Number of disjoint ranges a batch holds before it is drained early */
+#ifndef XIL_DCACHE_BATCH_MAX_RANGES
+#define XIL_DCACHE_BATCH_MAX_RANGES	16U
+#endif
+
+#if defined (__aarch64__) || defined (ARMA53_32)
+#define XIL_DCACHE_BATCH_LINE_SIZE	64U
+#else
+#define XIL_DCACHE_BATCH_LINE_SIZE	32U
+#endif
+
+/*
+ * Flush batches of at least this many bytes fall back to Xil_DCacheFlush.
+ * The default is the size of the cache hierarchy cleaned by Xil_DCacheFlush,
+ * 1 MB L2 on the Cortex-A53/A72, 512 KB L2 on the Cortex-A9 and 32 KB L1 on
+ * the Cortex-R5.
+ */
+#ifndef XIL_DCACHE_BATCH_FULL_FLUSH_SIZE
+#if defined (__aarch64__) || defined (ARMA53_32)
+#define XIL_DCACHE_BATCH_FULL_FLUSH_SIZE	0x100000U
+#elif defined (ARMR5)
+#define XIL_DCACHE_BATCH_FULL_FLUSH_SIZE	0x8000U
+#else
+#define XIL_DCACHE_BATCH_FULL_FLUSH_SIZE	0x80000U
+#endif
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Data cache maintenance batch. The ranges are kept disjoint and, for flush
+ * batches, cache line aligned.
+ */
+typedef struct {
+	UINTPTR Start[XIL_DCACHE_BATCH_MAX_RANGES];	/**< Range start */
+	UINTPTR End[XIL_DCACHE_BATCH_MAX_RANGES];	/**< Range end, exclusive */
+	u32 Count;	/**< Number of ranges in use */
+	u32 Op;		/**< XIL_DCACHE_BATCH_FLUSH or _INVALIDATE */
+	u32 Bytes;	/**< Bytes added since the batch was initialized */
+	u32 Drained;	/**< Ranges were issued early, commit owes a dsb */
+	u32 FullFlush;	/**< Commit with Xil_DCacheFlush */
+} Xil_DCacheBatch;
+
+/************************** Function Prototypes ******************************/
+
+void Xil_DCacheBatchInit(Xil_DCacheBatch *Batch, u32 Op);
+void Xil_DCacheBatchAdd(Xil_DCacheBatch *Batch, INTPTR Addr, u32 Len);
+void Xil_DCacheBatchCommit(Xil_DCacheBatch *Batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+* @} End of "addtogroup arm_cache_batch_apis".
+*/
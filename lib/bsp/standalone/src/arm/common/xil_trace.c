@@ -0,0 +1,238 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_trace.c
+*
+* Contains the setup and readout functions of the trace buffer. Records are
+* added with the inline Xil_TraceEmit(), see xil_trace.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 7.1   mus  10/14/19 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_trace.h"
+
+#ifdef XIL_TRACE_ENABLE
+
+#include "xil_printf.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+/* PMU control register bits */
+#define XIL_TRACE_PMCR_E	0x00000001U	/* Enable all counters */
+#define XIL_TRACE_PMCR_C	0x00000004U	/* Reset the cycle counter */
+#define XIL_TRACE_PMCR_D	0x00000008U	/* Count every 64th cycle */
+#define XIL_TRACE_PMCNTEN_C	0x80000000U	/* Cycle counter enable */
+
+/************************** Variable Definitions *****************************/
+
+#ifdef __GNUC__
+static XilTrace_Record XilTraceBuffer[XIL_TRACE_RECORDS]
+	__attribute__ ((aligned (16)));
+#else
+static XilTrace_Record XilTraceBuffer[XIL_TRACE_RECORDS];
+#endif
+
+/*
+ * Statically initialized so that records emitted before Xil_TraceInit()
+ * are not lost.
+ */
+XilTrace_Ring XilTraceRing = {
+	0U,
+	XIL_TRACE_RECORDS - 1U,
+	XilTraceBuffer,
+#if defined (XIL_TRACE_USE_XTIME) || !defined (__GNUC__)
+	XIL_TRACE_TIME_XTIME,
+#else
+	XIL_TRACE_TIME_CYCLES,
+#endif
+};
+
+/****************************************************************************/
+/**
+* @brief	Enable the PMU cycle counter used to stamp the records and empty
+*			the trace ring. The cycle counter is reset and counts every
+*			cycle.
+*
+* @return	None.
+*
+* @note		Nothing is done to the PMU when the records are stamped with
+*			XTime_GetTime().
+*
+****************************************************************************/
+void Xil_TraceInit(void)
+{
+#if !defined (XIL_TRACE_USE_XTIME) && defined (__GNUC__)
+	u32 Reg;
+
+#if defined (__aarch64__)
+	Reg = (u32)mfcp(PMCR_EL0);
+	Reg |= XIL_TRACE_PMCR_E | XIL_TRACE_PMCR_C;
+	Reg &= ~XIL_TRACE_PMCR_D;
+	mtcp(PMCR_EL0, (u64)Reg);
+	mtcp(PMCNTENSET_EL0, (u64)XIL_TRACE_PMCNTEN_C);
+#else
+	Reg = mfcp(XREG_CP15_PERF_MONITOR_CTRL);
+	Reg |= XIL_TRACE_PMCR_E | XIL_TRACE_PMCR_C;
+	Reg &= ~XIL_TRACE_PMCR_D;
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, XIL_TRACE_PMCNTEN_C);
+#endif
+	isb();
+#endif
+
+	Xil_TraceReset();
+}
+
+/****************************************************************************/
+/**
+* @brief	Empty the trace ring.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_TraceReset(void)
+{
+	XilTraceRing.Head = 0U;
+	dsb();
+}
+
+/****************************************************************************/
+/**
+* @brief	Move the trace ring to a buffer supplied by the caller, for
+*			example a memory region reserved for the host to read over
+*			JTAG. The ring is emptied.
+*
+* @param	Buffer: Pointer to the records, must be 16 byte aligned.
+* @param	NumRecords: Number of records in Buffer, a power of two.
+*
+* @return
+*		- XST_SUCCESS if the ring now uses Buffer.
+*		- XST_INVALID_PARAM if Buffer is NULL or NumRecords is not a
+*		  power of two.
+*
+* @note		Must not be called while other contexts emit records.
+*
+****************************************************************************/
+s32 Xil_TraceSetBuffer(XilTrace_Record *Buffer, u32 NumRecords)
+{
+	if ((Buffer == NULL) || (NumRecords == 0U) ||
+	    ((NumRecords & (NumRecords - 1U)) != 0U)) {
+		return XST_INVALID_PARAM;
+	}
+
+	XilTraceRing.Buffer = Buffer;
+	XilTraceRing.Mask = NumRecords - 1U;
+	Xil_TraceReset();
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* @brief	Copy the most recent records of the trace ring, oldest first.
+*
+* @param	Dst: Pointer to the destination records.
+* @param	MaxRecords: Number of records Dst can hold.
+*
+* @return	Number of records copied.
+*
+* @note		Records emitted while the copy runs may overwrite the oldest
+*			ones, stop tracing first for an exact snapshot.
+*
+****************************************************************************/
+u32 Xil_TraceCopy(XilTrace_Record *Dst, u32 MaxRecords)
+{
+	u32 Head = XilTraceRing.Head;
+	u32 Count = XilTraceRing.Mask + 1U;
+	u32 Index;
+
+	if (Head < Count) {
+		Count = Head;
+	}
+	if (Count > MaxRecords) {
+		Count = MaxRecords;
+	}
+
+	for (Index = 0U; Index < Count; Index++) {
+		Dst[Index] = XilTraceRing.Buffer[(Head - Count + Index) &
+						 XilTraceRing.Mask];
+	}
+
+	return Count;
+}
+
+/****************************************************************************/
+/**
+* @brief	Print the records of the trace ring on stdout, oldest first.
+*			Each line holds the timestamp, the time elapsed since the
+*			previous record, the event id and the argument.
+*
+* @return	None.
+*
+* @note		Printing is slow, stop tracing first for an exact snapshot.
+*
+****************************************************************************/
+void Xil_TraceDump(void)
+{
+	u32 Head = XilTraceRing.Head;
+	u32 Count = XilTraceRing.Mask + 1U;
+	XilTrace_Record *Rec;
+	u64 Prev;
+	u32 Index;
+
+	if (Head < Count) {
+		Count = Head;
+	}
+
+	xil_printf("Trace: %d records, %d overwritten, time base %s\r\n",
+		   Count, Head - Count,
+		   (XilTraceRing.TimeBase == XIL_TRACE_TIME_XTIME) ?
+		   "XTime" : "cycles");
+
+	Prev = XilTraceRing.Buffer[(Head - Count) & XilTraceRing.Mask].Timestamp;
+	for (Index = 0U; Index < Count; Index++) {
+		Rec = &XilTraceRing.Buffer[(Head - Count + Index) &
+					   XilTraceRing.Mask];
+		xil_printf("%08x%08x +%u 0x%04x 0x%08x\r\n",
+			   (u32)(Rec->Timestamp >> 32U), (u32)Rec->Timestamp,
+			   (u32)(Rec->Timestamp - Prev), Rec->Event, Rec->Arg);
+		Prev = Rec->Timestamp;
+	}
+}
+
+#endif /* XIL_TRACE_ENABLE */
@@ -0,0 +1,214 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_trace.h
+*
+* @addtogroup arm_trace_apis ARM Trace Buffer Functions
+*
+* The trace buffer is a ring of (timestamp, event, argument) records that
+* drivers, libraries and applications fill from their hot paths, interrupt
+* handlers included, with XIL_TRACE(). Emitting a record reserves a slot with
+* a single atomic increment and writes it with three stores, no lock is taken
+* and interrupts are not masked. When the ring is full the oldest records are
+* overwritten.
+*
+* Every standalone image has its own ring, so on a multi core system each
+* core traces into its own buffer. The ring can be printed on stdout (UART or
+* JTAG UART) with Xil_TraceDump(), copied with Xil_TraceCopy(), or placed in
+* a memory region that the host reads directly with Xil_TraceSetBuffer().
+*
+* Records are stamped with the PMU cycle counter, which Xil_TraceInit()
+* enables. Define XIL_TRACE_USE_XTIME to stamp them with XTime_GetTime()
+* instead, a slower read but a time base that is common to all the cores.
+*
+* The trace buffer is enabled with the enable_trace_buffer BSP parameter.
+* When it is disabled XIL_TRACE() compiles to nothing.
+*
+* Event ids 0x0000 - 0x0FFF are reserved for the BSP, 0x1000 - 0x7FFF for
+* drivers and libraries and 0x8000 - 0xFFFFFFFF for applications.
+*
+* @{
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 7.1   mus  10/14/19 First release
+* </pre>
+*
+******************************************************************************/
+#ifndef XIL_TRACE_H
+#define XIL_TRACE_H
+
+#include "xil_types.h"
+#include "xil_io.h"
+#include "bspconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_TRACE_EVENT_BSP		0x0000U	/**< First BSP event id */
+#define XIL_TRACE_EVENT_DRIVER		0x1000U	/**< First driver event id */
+#define XIL_TRACE_EVENT_USER		0x8000U	/**< First application id */
+
+/* Time base of the record timestamps */
+#define XIL_TRACE_TIME_CYCLES		0U	/**< PMU cycle counter */
+#define XIL_TRACE_TIME_XTIME		1U	/**< XTime_GetTime() */
+
+#ifdef XIL_TRACE_ENABLE
+
+#include "xpseudo_asm.h"
+#if defined (XIL_TRACE_USE_XTIME) || !defined (__GNUC__)
+#include "xtime_l.h"
+#endif
+
+/* Default number of records, must be a power of two */
+#ifndef XIL_TRACE_RECORDS
+#define XIL_TRACE_RECORDS		1024U
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Trace record. Records are 16 bytes and, in a 16 byte aligned buffer, never
+ * straddle a cache line.
+ */
+typedef struct {
+	u64 Timestamp;	/**< Cycle counter or XTime value */
+	u32 Event;	/**< Event id */
+	u32 Arg;	/**< Event argument */
+} XilTrace_Record;
+
+/**
+ * Trace ring. Head counts all the records emitted since the ring was reset,
+ * the record n is stored in Buffer[n & Mask].
+ */
+typedef struct {
+	u32 Head;		/**< Number of records emitted */
+	u32 Mask;		/**< Number of records in Buffer - 1 */
+	XilTrace_Record *Buffer;	/**< Records */
+	u32 TimeBase;		/**< XIL_TRACE_TIME_CYCLES or _XTIME */
+} XilTrace_Ring;
+
+/************************** Variable Definitions *****************************/
+
+extern XilTrace_Ring XilTraceRing;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/****************************************************************************/
+/**
+* @brief	Read the timestamp of a trace record.
+*
+* @return	PMU cycle counter, or XTime_GetTime() when XIL_TRACE_USE_XTIME
+*			is defined or the compiler is not GCC.
+*
+****************************************************************************/
+#if defined (XIL_TRACE_USE_XTIME) || !defined (__GNUC__)
+static INLINE u64 Xil_TraceTimestamp(void)
+{
+	XTime Time;
+
+	XTime_GetTime(&Time);
+	return (u64)Time;
+}
+#elif defined (__aarch64__)
+static INLINE u64 Xil_TraceTimestamp(void)
+{
+	return (u64)mfcp(PMCCNTR_EL0);
+}
+#else
+static INLINE u64 Xil_TraceTimestamp(void)
+{
+	return (u64)mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+}
+#endif
+
+/****************************************************************************/
+/**
+* @brief	Add a record to the trace ring.
+*
+* @param	Event: Event id.
+* @param	Arg: Event argument.
+*
+* @return	None.
+*
+* @note		Safe to call from interrupt handlers. A handler that interrupts
+*			another emitter gets the next slot, so the records of nested
+*			contexts can be out of order by the length of the handler.
+*
+****************************************************************************/
+static INLINE void Xil_TraceEmit(u32 Event, u32 Arg)
+{
+	XilTrace_Record *Rec;
+	u32 Slot;
+
+#ifdef __GNUC__
+	Slot = __atomic_fetch_add(&XilTraceRing.Head, 1U, __ATOMIC_RELAXED);
+#else
+	u32 CurrMask = mfcpsr();
+
+	mtcpsr(CurrMask | 0xC0U);
+	Slot = XilTraceRing.Head;
+	XilTraceRing.Head = Slot + 1U;
+	mtcpsr(CurrMask);
+#endif
+	Rec = &XilTraceRing.Buffer[Slot & XilTraceRing.Mask];
+	Rec->Timestamp = Xil_TraceTimestamp();
+	Rec->Event = Event;
+	Rec->Arg = Arg;
+}
+
+#define XIL_TRACE(Event, Arg)	Xil_TraceEmit((u32)(Event), (u32)(Arg))
+
+/************************** Function Prototypes ******************************/
+
+void Xil_TraceInit(void);
+void Xil_TraceReset(void);
+s32 Xil_TraceSetBuffer(XilTrace_Record *Buffer, u32 NumRecords);
+u32 Xil_TraceCopy(XilTrace_Record *Dst, u32 MaxRecords);
+void Xil_TraceDump(void);
+
+#else
+
+#define XIL_TRACE(Event, Arg)
+
+#endif /* XIL_TRACE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+* @} End of "addtogroup arm_trace_apis".
+*/
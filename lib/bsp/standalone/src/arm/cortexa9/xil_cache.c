@@ -92,6 +92,12 @@
 * 6.6    asa 16/01/18 Changes made in Xil_L1DCacheInvalidate and Xil_L2CacheInvalidate
 *					  routines to ensure the stack data flushed only when the respective
 *					  caches are enabled. This fixes CR-992023.
+* 7.1    mus 10/14/19 Added Xil_DCacheInvalidateRangeNoDsb and
+*                     Xil_DCacheFlushRangeNoDsb, used by the Xil_DCacheBatch
+*                     APIs to issue several ranges with a single dsb.
+* 7.1    adk 10/15/19 Added Xil_L2CacheSetPrefetch, Xil_L2CacheSetEarlyBresp,
+*                     Xil_L2CacheLockRange and Xil_L2CacheUnlockAll to tune
+*                     the PL310 and lock a hot region into L2 ways.
 *
 * </pre>
 *
@@ -108,6 +114,7 @@
 #include "xl2cc.h"
 #include "xil_errata.h"
 #include "xil_exception.h"
+#include "xstatus.h"
 
 /************************** Function Prototypes ******************************/
 
@@ -325,18 +332,43 @@ void Xil_DCacheInvalidateLine(u32 adr)
 *
 ****************************************************************************/
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
+{
+	u32 currmask;
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	Xil_DCacheInvalidateRangeNoDsb(adr, len);
+
+	dsb();
+	mtcpsr(currmask);
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate the L1 and L2 Data cache lines of the given address
+* 			range without the closing dsb. Unaligned start and end lines are
+* 			flushed first, as in Xil_DCacheInvalidateRange. Each L2 operation
+* 			is still followed by a L2 cache sync.
+*
+* @param	adr: 32bit start address of the range to be invalidated.
+* @param	len: Length of the range to be invalidated in bytes.
+*
+* @return	None.
+*
+* @note		The caller must mask IRQ/FIQ and issue a dsb before relying on
+* 			the result. Used by the Xil_DCacheBatch APIs.
+*
+****************************************************************************/
+void Xil_DCacheInvalidateRangeNoDsb(INTPTR adr, u32 len)
 {
 	const u32 cacheline = 32U;
 	u32 end;
 	u32 tempadr = adr;
 	u32 tempend;
-	u32 currmask;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INVLD_PA_OFFSET);
 
-	currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
-
 	if (len != 0U) {
 		end = tempadr + len;
 		tempend = end;
@@ -389,9 +421,6 @@ void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 			tempadr += cacheline;
 		}
 	}
-
-	dsb();
-	mtcpsr(currmask);
 }
 
 /****************************************************************************/
@@ -471,17 +500,41 @@ void Xil_DCacheFlushLine(u32 adr)
 *
 ****************************************************************************/
 void Xil_DCacheFlushRange(INTPTR adr, u32 len)
+{
+	u32 currmask;
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	Xil_DCacheFlushRangeNoDsb(adr, len);
+
+	dsb();
+	mtcpsr(currmask);
+}
+
+/****************************************************************************/
+/**
+* @brief	Flush the L1 and L2 Data cache lines of the given address range
+* 			without the closing dsb. Each L2 operation is still followed by
+* 			a L2 cache sync.
+*
+* @param	adr: 32bit start address of the range to be flushed.
+* @param	len: Length of the range to be flushed in bytes.
+*
+* @return	None.
+*
+* @note		The caller must mask IRQ/FIQ and issue a dsb before relying on
+* 			the result. Used by the Xil_DCacheBatch APIs.
+*
+****************************************************************************/
+void Xil_DCacheFlushRangeNoDsb(INTPTR adr, u32 len)
 {
 	u32 LocalAddr = adr;
 	const u32 cacheline = 32U;
 	u32 end;
-	u32 currmask;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INV_CLN_PA_OFFSET);
 
-	currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
-
 	if (len != 0U) {
 		/* Back the starting address up to the start of a cache line
 		 * perform cache operations until adr+len
@@ -507,8 +560,6 @@ void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 			LocalAddr += cacheline;
 		}
 	}
-	dsb();
-	mtcpsr(currmask);
 }
 /****************************************************************************/
 /**
@@ -1632,4 +1683,193 @@ void Xil_L2CacheStoreLine(u32 adr)
 	/* synchronize the processor */
 	dsb();
 }
+
+/****************************************************************************/
+/**
+* @brief	Set the prefetch control register of the L2 cache controller.
+*
+* @param	PrefetchCtrl: OR of the XPS_L2CC_PREFETCH_*_MASK bits to enable
+*			and of the prefetch offset, in lines. Bits not given are
+*			cleared.
+*
+* @return	None.
+*
+* @note		Double linefill and data prefetching are only effective when
+*			the Cortex-A9 L2 prefetch hint and full line of zero bits of
+*			the auxiliary control register are set accordingly.
+*
+****************************************************************************/
+void Xil_L2CacheSetPrefetch(u32 PrefetchCtrl)
+{
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_PREFETCH_CTRL_OFFSET,
+		  PrefetchCtrl & (XPS_L2CC_PREFETCH_VALID_MASK |
+				  XPS_L2CC_PREFETCH_OFFSET_MASK));
+	Xil_L2CacheSync();
+	dsb();
+}
+
+/****************************************************************************/
+/**
+* @brief	Enable or disable early BRESP in the L2 cache controller. The
+*			auxiliary control register can only be written with the L2
+*			cache disabled, so an enabled L2 cache is flushed, disabled
+*			and enabled again around the update.
+*
+* @param	Enable: 1 to enable early BRESP, 0 to disable it.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+void Xil_L2CacheSetEarlyBresp(u32 Enable)
+{
+	register u32 L2CCReg;
+	u32 IsEnabled;
+	u32 currmask;
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	IsEnabled = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CNTRL_OFFSET) &
+			XPS_L2CC_ENABLE_MASK;
+	if (IsEnabled != 0U) {
+		Xil_L2CacheDisable();
+	}
+
+	L2CCReg = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_AUX_CNTRL_OFFSET);
+	if (Enable != 0U) {
+		L2CCReg |= XPS_L2CC_AUX_EBRESPE_MASK;
+	} else {
+		L2CCReg &= ~XPS_L2CC_AUX_EBRESPE_MASK;
+	}
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_AUX_CNTRL_OFFSET, L2CCReg);
+
+	if (IsEnabled != 0U) {
+		/* The cache was cleaned and invalidated by the disable */
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CNTRL_OFFSET,
+			  XPS_L2CC_ENABLE_MASK);
+		Xil_L2CacheSync();
+	}
+	dsb();
+	mtcpsr(currmask);
+}
+
+/****************************************************************************/
+/**
+* @brief	Write the data and instruction lockdown registers of all masters.
+*
+* @param	WayMask: Ways in which line fills are not allowed.
+*
+* @return	None.
+*
+****************************************************************************/
+static void Xil_L2CacheWriteLockdown(u32 WayMask)
+{
+	u32 Master;
+	u32 Offset;
+
+	for (Master = 0U; Master < XPS_L2CC_LCKDWN_MASTERS; Master++) {
+		Offset = Master * XPS_L2CC_LCKDWN_STRIDE;
+		Xil_Out32(XPS_L2CC_BASEADDR +
+			  XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET + Offset, WayMask);
+		Xil_Out32(XPS_L2CC_BASEADDR +
+			  XPS_L2CC_CACHE_ILCKDWN_0_WAY_OFFSET + Offset, WayMask);
+	}
+	Xil_L2CacheSync();
+	dsb();
+}
+
+/****************************************************************************/
+/**
+* @brief	Lock an address range into a set of L2 cache ways. The range is
+*			flushed, then read with line fills restricted to the given
+*			ways, and the ways are locked against replacement for all
+*			masters. The rest of the ways remain available to other data.
+*
+* @param	adr: 32bit start address of the range.
+* @param	len: Length of the range in bytes.
+* @param	WayMask: Ways to hold the range, one bit per way.
+*
+* @return	XST_SUCCESS if the range is locked, XST_FAILURE if the L2
+*			cache is disabled, the mask is empty or leaves no way
+*			unlocked, or the range does not fit in the ways.
+*
+* @note		Other lines filled while the range is read, such as the
+*			stack, may also end up in the locked ways. A later call
+*			replaces the lockdown of the earlier one.
+*
+****************************************************************************/
+u32 Xil_L2CacheLockRange(u32 adr, u32 len, u32 WayMask)
+{
+	const u32 cacheline = 32U;
+	u32 AuxReg;
+	u32 AllWays;
+	u32 WaySize;
+	u32 NumWays = 0U;
+	u32 Mask;
+	u32 LocalAddr;
+	u32 end;
+	u32 currmask;
+	volatile u32 Data;
+
+	if ((Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CNTRL_OFFSET) &
+			XPS_L2CC_ENABLE_MASK) == 0U) {
+		return XST_FAILURE;
+	}
+
+	AuxReg = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_AUX_CNTRL_OFFSET);
+	AllWays = ((AuxReg & XPS_L2CC_AUX_ASSOC_MASK) != 0U) ? 0xFFFFU : 0xFFU;
+	WaySize = 0x2000U << ((AuxReg & XPS_L2CC_AUX_WAY_SIZE_MASK) >>
+			XPS_L2CC_AUX_WAY_SIZE_SHIFT);
+	WayMask &= AllWays;
+	for (Mask = WayMask; Mask != 0U; Mask &= Mask - 1U) {
+		NumWays++;
+	}
+	if ((WayMask == 0U) || (WayMask == AllWays) ||
+	    (len > (NumWays * WaySize))) {
+		return XST_FAILURE;
+	}
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	Xil_DCacheFlushRange((INTPTR)adr, len);
+
+	/* Allocate into the requested ways only */
+	Xil_L2CacheWriteLockdown(AllWays & ~WayMask);
+
+	end = adr + len;
+	LocalAddr = adr & ~(cacheline - 1U);
+	while (LocalAddr < end) {
+		Data = *(volatile u32 *)(UINTPTR)LocalAddr;
+		LocalAddr += cacheline;
+	}
+	(void)Data;
+	dsb();
+
+	/* Keep every master from replacing the locked ways */
+	Xil_L2CacheWriteLockdown(WayMask);
+
+	mtcpsr(currmask);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* @brief	Unlock all the L2 cache ways locked by Xil_L2CacheLockRange.
+*			The lines stay in the cache until they are replaced.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+void Xil_L2CacheUnlockAll(void)
+{
+	Xil_L2CacheWriteLockdown(0U);
+}
 #endif
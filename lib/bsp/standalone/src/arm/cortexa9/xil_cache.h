@@ -46,6 +46,7 @@
 * 3.04a sdm  01/02/12 Remove redundant dsb/dmb instructions in cache maintenance
 *		      APIs.
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
+* 7.1   mus  10/14/19 Added the NoDsb range variants.
 * </pre>
 *
 ******************************************************************************/
@@ -98,8 +99,10 @@ void Xil_DCacheEnable(void);
 void Xil_DCacheDisable(void);
 void Xil_DCacheInvalidate(void);
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len);
+void Xil_DCacheInvalidateRangeNoDsb(INTPTR adr, u32 len);
 void Xil_DCacheFlush(void);
 void Xil_DCacheFlushRange(INTPTR adr, u32 len);
+void Xil_DCacheFlushRangeNoDsb(INTPTR adr, u32 len);
 
 void Xil_ICacheEnable(void);
 void Xil_ICacheDisable(void);
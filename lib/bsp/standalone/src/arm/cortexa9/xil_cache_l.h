@@ -41,6 +41,7 @@
 * ----- ---- -------- -----------------------------------------------
 * 1.00a ecm  01/24/10 First release
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
+* 7.1   adk  10/15/19 Added the L2 prefetch, early BRESP and lockdown APIs.
 * </pre>
 *
 ******************************************************************************/
@@ -84,6 +85,10 @@ void Xil_L2CacheFlush(void);
 void Xil_L2CacheFlushLine(u32 adr);
 void Xil_L2CacheFlushRange(u32 adr, u32 len);
 void Xil_L2CacheStoreLine(u32 adr);
+void Xil_L2CacheSetPrefetch(u32 PrefetchCtrl);
+void Xil_L2CacheSetEarlyBresp(u32 Enable);
+u32 Xil_L2CacheLockRange(u32 adr, u32 len, u32 WayMask);
+void Xil_L2CacheUnlockAll(void);
 
 #ifdef __cplusplus
 }
@@ -38,6 +38,8 @@
 * 1.00a sdm  02/01/10 Initial version
 * 3.10a srt 04/18/13 Implemented ARM Erratas. Please refer to file
 *		      'xil_errata.h' for errata description
+* 7.1   adk  10/15/19 Added the prefetch control register and lockdown
+*		      definitions.
 * </pre>
 *
 * @note
@@ -108,6 +110,22 @@ extern "C" {
 #define XPS_L2CC_ADDR_FILTER_END_OFFSET		0x0C04U		/* Start of address filtering */
 
 #define XPS_L2CC_DEBUG_CTRL_OFFSET		0x0F40U		/* Debug Control Register */
+#define XPS_L2CC_PREFETCH_CTRL_OFFSET		0x0F60U		/* Prefetch Control Register */
+
+#define XPS_L2CC_LCKDWN_MASTERS			8U		/* Lockdown by master register pairs */
+#define XPS_L2CC_LCKDWN_STRIDE			0x8U		/* Offset between master pairs */
+
+/* Prefetch control bits */
+#define XPS_L2CC_PREFETCH_DLFE_MASK	0x40000000U	/* Double linefill enable */
+#define XPS_L2CC_PREFETCH_IPFE_MASK	0x20000000U	/* Instruction prefetch enable */
+#define XPS_L2CC_PREFETCH_DPFE_MASK	0x10000000U	/* Data prefetch enable */
+#define XPS_L2CC_PREFETCH_DLFWRD_MASK	0x08000000U	/* Double linefill on WRAP read disable */
+#define XPS_L2CC_PREFETCH_PDE_MASK	0x01000000U	/* Prefetch drop enable */
+#define XPS_L2CC_PREFETCH_IDLFE_MASK	0x00800000U	/* Incr double linefill enable */
+#define XPS_L2CC_PREFETCH_OFFSET_MASK	0x0000001FU	/* Prefetch offset */
+#define XPS_L2CC_PREFETCH_VALID_MASK	0x79800000U	/* Bits set by Xil_L2CacheSetPrefetch */
+
+#define XPS_L2CC_AUX_WAY_SIZE_SHIFT	17U
 
 /* XPS_L2CC_CNTRL_OFFSET bit masks */
 #define XPS_L2CC_ENABLE_MASK		0x00000001U	/* enables the L2CC */
@@ -40,6 +40,7 @@
 * 1.00a sdm  07/11/11 First release
 * 3.07a asa  08/30/12 Updated for CR 675636 to provide the L2 Base Address
 *		      inside the APIs
+* 7.1   adk  10/15/19 Added XL2cc_MeasureHitRate.
 * </pre>
 *
 ******************************************************************************/
@@ -161,3 +162,42 @@ void XL2cc_EventCtrReset(void)
 {
 	*((volatile u32*)(XPS_L2CC_BASEADDR + XPS_L2CC_EVNT_CNTRL_OFFSET)) = 0x6U;
 }
+
+/****************************************************************************/
+/**
+*
+* @brief	This function counts a pair of hit and request events in the L2
+*			Cache controller while a user function runs, and returns the
+*			hit rate. It is used to check the effect of the prefetch and
+*			lockdown settings on a piece of code.
+*
+* @param	HitEvent: Hit event code, for example XL2CC_DRHIT or
+*			XL2CC_IRHIT.
+* @param	ReqEvent: Request event code, for example XL2CC_DRREQ or
+*			XL2CC_IRREQ.
+* @param	WorkFunc: Function measured.
+* @param	CallBackRef: Argument of WorkFunc.
+* @param	Hits: Output parameter which returns the hit count.
+* @param	Reqs: Output parameter which returns the request count.
+*
+* @return	Hit rate in percent, 0 when there was no request.
+*
+* @note		The event counters are reset.
+*
+*****************************************************************************/
+u32 XL2cc_MeasureHitRate(s32 HitEvent, s32 ReqEvent,
+			 void (*WorkFunc)(void *CallBackRef), void *CallBackRef,
+			 u32 *Hits, u32 *Reqs)
+{
+	u32 HitRate = 0U;
+
+	XL2cc_EventCtrInit(HitEvent, ReqEvent);
+	XL2cc_EventCtrStart();
+	WorkFunc(CallBackRef);
+	XL2cc_EventCtrStop(Hits, Reqs);
+
+	if (*Reqs != 0U) {
+		HitRate = (u32)(((u64)*Hits * 100U) / *Reqs);
+	}
+	return HitRate;
+}
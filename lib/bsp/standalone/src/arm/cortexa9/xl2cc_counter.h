@@ -49,6 +49,7 @@
 * 3.07a asa  08/30/12 Updated for CR 675636 to provide the L2 Base Address
 *		      inside the APIs
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
+* 7.1   adk  10/15/19 Added XL2cc_MeasureHitRate.
 * </pre>
 *
 ******************************************************************************/
@@ -97,6 +98,9 @@ extern "C" {
 void XL2cc_EventCtrInit(s32 Event0, s32 Event1);
 void XL2cc_EventCtrStart(void);
 void XL2cc_EventCtrStop(u32 *EveCtr0, u32 *EveCtr1);
+u32 XL2cc_MeasureHitRate(s32 HitEvent, s32 ReqEvent,
+			 void (*WorkFunc)(void *CallBackRef), void *CallBackRef,
+			 u32 *Hits, u32 *Reqs);
 
 #ifdef __cplusplus
 }
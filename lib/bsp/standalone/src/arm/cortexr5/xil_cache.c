@@ -37,6 +37,9 @@
 * ----- ---- -------- -----------------------------------------------
 * 5.00 	pkp  02/20/14 First release
 * 6.2   mus  01/27/17 Updated to support IAR compiler
+* 7.1   mus  10/14/19 Added Xil_DCacheInvalidateRangeNoDsb and
+*                     Xil_DCacheFlushRangeNoDsb, used by the Xil_DCacheBatch
+*                     APIs to issue several ranges with a single barrier.
 * </pre>
 *
 ******************************************************************************/
@@ -206,15 +209,39 @@ void Xil_DCacheInvalidateLine(INTPTR adr)
 ****************************************************************************/
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 {
-	const u32 cacheline = 32U;
-	u32 end;
-	u32 tempadr = adr;
-	u32 tempend;
 	u32 currmask;
 
 	currmask = mfcpsr();
 	mtcpsr(currmask | IRQ_FIQ_MASK);
 
+	Xil_DCacheInvalidateRangeNoDsb(adr, len);
+
+	dsb();
+	mtcpsr(currmask);
+}
+
+/****************************************************************************/
+/**
+* @brief    Invalidate the Data cache lines of the given address range
+*           without waiting for the operations to complete. Partial lines at
+*           either end are flushed, as in Xil_DCacheInvalidateRange.
+*
+* @param	adr: 32bit start address of the range to be invalidated.
+* @param	len: Length of range to be invalidated in bytes.
+*
+* @return	None.
+*
+* @note		The caller must mask IRQ/FIQ and issue a dsb before relying on
+*			the result. Used by the Xil_DCacheBatch APIs.
+*
+****************************************************************************/
+void Xil_DCacheInvalidateRangeNoDsb(INTPTR adr, u32 len)
+{
+	const u32 cacheline = 32U;
+	u32 end;
+	u32 tempadr = adr;
+	u32 tempend;
+
 	if (len != 0U) {
 		end = tempadr + len;
 		tempend = end;
@@ -240,9 +267,6 @@ void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 		tempadr += cacheline;
 		}
 	}
-
-	dsb();
-	mtcpsr(currmask);
 }
 
 /****************************************************************************/
@@ -358,14 +382,37 @@ void Xil_DCacheFlushLine(INTPTR adr)
 ****************************************************************************/
 void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 {
-	u32 LocalAddr = adr;
-	const u32 cacheline = 32U;
-	u32 end;
 	u32 currmask;
 
 	currmask = mfcpsr();
 	mtcpsr(currmask | IRQ_FIQ_MASK);
 
+	Xil_DCacheFlushRangeNoDsb(adr, len);
+
+	dsb();
+	mtcpsr(currmask);
+}
+
+/****************************************************************************/
+/**
+* @brief    Flush the Data cache lines of the given address range without
+*           waiting for the operations to complete.
+*
+* @param	adr: 32bit start address of the range to be flushed.
+* @param	len: Length of the range to be flushed in bytes
+*
+* @return	None.
+*
+* @note		The caller must mask IRQ/FIQ and issue a dsb before relying on
+*			the result. Used by the Xil_DCacheBatch APIs.
+*
+****************************************************************************/
+void Xil_DCacheFlushRangeNoDsb(INTPTR adr, u32 len)
+{
+	u32 LocalAddr = adr;
+	const u32 cacheline = 32U;
+	u32 end;
+
 	if (len != 0x00000000U) {
 		/* Back the starting address up to the start of a cache line
 		 * perform cache operations until adr+len
@@ -380,8 +427,6 @@ void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 			LocalAddr += cacheline;
 		}
 	}
-	dsb();
-	mtcpsr(currmask);
 }
 /****************************************************************************/
 /**
@@ -43,6 +43,7 @@
 * ----- ---- -------- -----------------------------------------------
 * 5.00 	pkp  02/20/14 First release
 * 6.2   mus  01/27/17 Updated to support IAR compiler
+* 7.1   mus  10/14/19 Added the NoDsb range variants.
 * </pre>
 *
 ******************************************************************************/
@@ -85,8 +86,10 @@ void Xil_DCacheEnable(void);
 void Xil_DCacheDisable(void);
 void Xil_DCacheInvalidate(void);
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len);
+void Xil_DCacheInvalidateRangeNoDsb(INTPTR adr, u32 len);
 void Xil_DCacheFlush(void);
 void Xil_DCacheFlushRange(INTPTR adr, u32 len);
+void Xil_DCacheFlushRangeNoDsb(INTPTR adr, u32 len);
 void Xil_DCacheInvalidateLine(INTPTR adr);
 void Xil_DCacheFlushLine(INTPTR adr);
 void Xil_DCacheStoreLine(INTPTR adr);
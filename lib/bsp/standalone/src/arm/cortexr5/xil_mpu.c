@@ -47,6 +47,9 @@
 * 					  represent the MPU configuration table.
 * 6.8  aru  07/02/18 Returned the pointer instead of address
 *			of that pointer in Xil_MemMap().
+* 7.1  adk  10/15/19 Added Xil_PlanMPURegions, Xil_ApplyMPUPlan and
+*			Xil_SetMPURegions which compute and program a minimal
+*			region set for a memory map.
 * </pre>
 *
 *
@@ -106,6 +109,9 @@ XMpu_Config Mpu_Config;
 
 /************************** Function Prototypes ******************************/
 void Xil_InitializeExistingMPURegConfig(void);
+static u32 Xil_MpuSizeEncoding(u64 size);
+static u32 Xil_MpuIsCovered(const XMpu_Region *Map, u32 From, u32 NumMap,
+		u64 Low, u64 High);
 /*****************************************************************************/
 /**
 * @brief    This function sets the memory attributes for a section covering
@@ -620,3 +626,242 @@ void *Xil_MemMap(UINTPTR Physaddr, size_t size, u32 flags)
 	}
 	return NULL;
 }
+
+/*****************************************************************************/
+/**
+* @brief    Returns the region size encoding for a power of two size.
+*
+* @param	size: Region size, from 32 bytes to 4GB.
+* @return	Encoding of the size, as written to the region size register.
+*
+******************************************************************************/
+static u32 Xil_MpuSizeEncoding(u64 size)
+{
+	u32 Index;
+	u32 Encoding = REGION_4G;
+
+	for (Index = 0U; Index <
+			sizeof region_size / sizeof region_size[0]; Index++) {
+		if (size <= region_size[Index].size) {
+			Encoding = region_size[Index].encoding;
+			break;
+		}
+	}
+	return Encoding;
+}
+
+/*****************************************************************************/
+/**
+* @brief    Checks if a range is covered by the union of a part of the memory
+*           map.
+*
+* @param	Map: Memory map.
+* @param	From: First map entry considered.
+* @param	NumMap: Number of map entries.
+* @param	Low: Start of the range.
+* @param	High: End of the range, exclusive.
+* @return	1 if every byte of the range is mapped by an entry from From
+*			onwards, 0 otherwise.
+*
+******************************************************************************/
+static u32 Xil_MpuIsCovered(const XMpu_Region *Map, u32 From, u32 NumMap,
+		u64 Low, u64 High)
+{
+	u64 Cur = Low;
+	u64 Start;
+	u64 End;
+	u32 Index;
+	u32 Found = 1U;
+
+	while ((Cur < High) && (Found == 1U)) {
+		Found = 0U;
+		for (Index = From; Index < NumMap; Index++) {
+			Start = (u32)Map[Index].BaseAddress;
+			End = Start + Map[Index].Size;
+			if ((Start <= Cur) && (Cur < End)) {
+				Cur = End;
+				Found = 1U;
+				break;
+			}
+		}
+	}
+	return Found;
+}
+
+/*****************************************************************************/
+/**
+* @brief    Computes the MPU regions for a memory map, without programming
+*           the MPU.
+*
+*           The regions are emitted in map order, so that a later map entry
+*           gets a higher region number and takes priority over an earlier
+*           one. An entry is mapped by a single power of two region when the
+*           bytes the region adds around it are all mapped by later entries.
+*           Otherwise it is split into the largest aligned power of two
+*           regions. Listing the large cacheable ranges first and the device
+*           or non-cacheable holes after them therefore gives the fewest
+*           regions.
+*
+* @param	Map: Memory map.
+* @param	NumMap: Number of map entries.
+* @param	Plan: Filled with the regions, from region 0 onwards.
+* @param	NumPlanned: Number of regions used.
+* @return	XST_SUCCESS: The map fits in the MPU regions.
+* 			XST_FAILURE: A map entry is not 32 byte aligned or the map
+*			needs more than 16 regions.
+*
+******************************************************************************/
+u32 Xil_PlanMPURegions(const XMpu_Region *Map, u32 NumMap,
+		XMpu_Config Plan, u32 *NumPlanned)
+{
+	u32 ReturnVal = XST_SUCCESS;
+	u32 Count = 0U;
+	u32 Index;
+	u64 Start;
+	u64 End;
+	u64 Base;
+	u64 Size;
+	u64 Cur;
+
+	for (Index = 0U; Index < NumMap; Index++) {
+		Start = (u32)Map[Index].BaseAddress;
+		End = Start + Map[Index].Size;
+		if ((Map[Index].Size < MPU_REGION_SIZE_MIN) ||
+			((Start & (MPU_REGION_SIZE_MIN - 1U)) != 0U) ||
+			((Map[Index].Size & (MPU_REGION_SIZE_MIN - 1U)) != 0U) ||
+			(End > 0x100000000ULL)) {
+			xdbg_printf(DEBUG, "Invalid map entry %d\r\n", Index);
+			ReturnVal = XST_FAILURE;
+			goto exit3;
+		}
+
+		/* Smallest aligned power of two region holding the entry */
+		Size = MPU_REGION_SIZE_MIN;
+		while (Size < Map[Index].Size) {
+			Size <<= 1U;
+		}
+		Base = Start & ~(Size - 1U);
+		while ((Base + Size) < End) {
+			Size <<= 1U;
+			Base = Start & ~(Size - 1U);
+		}
+
+		if ((Xil_MpuIsCovered(Map, Index + 1U, NumMap, Base,
+				Start) == 1U) &&
+			(Xil_MpuIsCovered(Map, Index + 1U, NumMap, End,
+				Base + Size) == 1U)) {
+			if (Count >= MAX_POSSIBLE_MPU_REGS) {
+				ReturnVal = XST_FAILURE;
+				goto exit3;
+			}
+			Plan[Count].RegionStatus = MPU_REG_ENABLED;
+			Plan[Count].BaseAddress = (INTPTR)Base;
+			Plan[Count].Size = Size;
+			Plan[Count].Attribute = Map[Index].Attribute;
+			Count++;
+			continue;
+		}
+
+		/* Split into the largest aligned power of two regions */
+		Cur = Start;
+		while (Cur < End) {
+			Size = MPU_REGION_SIZE_MIN;
+			while (((Cur & ((Size << 1U) - 1U)) == 0U) &&
+				((Cur + (Size << 1U)) <= End)) {
+				Size <<= 1U;
+			}
+			if (Count >= MAX_POSSIBLE_MPU_REGS) {
+				ReturnVal = XST_FAILURE;
+				goto exit3;
+			}
+			Plan[Count].RegionStatus = MPU_REG_ENABLED;
+			Plan[Count].BaseAddress = (INTPTR)Cur;
+			Plan[Count].Size = Size;
+			Plan[Count].Attribute = Map[Index].Attribute;
+			Count++;
+			Cur += Size;
+		}
+	}
+
+exit3:
+	if (ReturnVal != XST_SUCCESS) {
+		xdbg_printf(DEBUG, "Memory map does not fit in the MPU\r\n");
+	}
+	*NumPlanned = Count;
+	return ReturnVal;
+}
+
+/*****************************************************************************/
+/**
+* @brief    Programs all the MPU regions from a plan computed by
+*           Xil_PlanMPURegions. Regions beyond the plan are disabled. The
+*           MPU is disabled while the regions are written and the global MPU
+*           configuration table is updated.
+*
+* @param	Plan: Regions to program, from region 0 onwards.
+* @param	NumPlanned: Number of regions in the plan.
+* @return	XST_SUCCESS: The MPU is programmed.
+* 			XST_FAILURE: The plan has more than 16 regions.
+*
+******************************************************************************/
+u32 Xil_ApplyMPUPlan(XMpu_Config Plan, u32 NumPlanned)
+{
+	u32 Index;
+	u32 Regionsize;
+
+	if (NumPlanned > MAX_POSSIBLE_MPU_REGS) {
+		xdbg_printf(DEBUG, "Invalid number of regions\r\n");
+		return XST_FAILURE;
+	}
+
+	Xil_DisableMPU();
+
+	for (Index = 0U; Index < MAX_POSSIBLE_MPU_REGS; Index++) {
+		mtcp(XREG_CP15_MPU_MEMORY_REG_NUMBER, Index);
+		isb();
+		if (Index < NumPlanned) {
+			Regionsize = Xil_MpuSizeEncoding(Plan[Index].Size);
+			Regionsize <<= 1;
+			Regionsize |= REGION_EN;
+			mtcp(XREG_CP15_MPU_REG_BASEADDR, Plan[Index].BaseAddress);
+			mtcp(XREG_CP15_MPU_REG_ACCESS_CTRL, Plan[Index].Attribute);
+			mtcp(XREG_CP15_MPU_REG_SIZE_EN, Regionsize);
+			Xil_UpdateMPUConfig(Index, Plan[Index].BaseAddress,
+					Regionsize, Plan[Index].Attribute);
+		} else {
+			mtcp(XREG_CP15_MPU_REG_SIZE_EN, 0U);
+			Xil_UpdateMPUConfig(Index, 0U, 0U, 0U);
+		}
+	}
+	dsb();
+	isb();
+
+	Xil_EnableMPU();
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief    Replaces the MPU configuration by the minimal region set for a
+*           memory map.
+*
+* @param	Map: Memory map, see Xil_PlanMPURegions.
+* @param	NumMap: Number of map entries.
+* @return	XST_SUCCESS: The MPU is programmed.
+* 			XST_FAILURE: The map does not fit in the MPU regions, the MPU
+*			is left unchanged.
+*
+******************************************************************************/
+u32 Xil_SetMPURegions(const XMpu_Region *Map, u32 NumMap)
+{
+	XMpu_Config Plan;
+	u32 NumPlanned;
+	u32 Status;
+
+	Status = Xil_PlanMPURegions(Map, NumMap, Plan, &NumPlanned);
+	if (Status == XST_SUCCESS) {
+		Status = Xil_ApplyMPUPlan(Plan, NumPlanned);
+	}
+	return Status;
+}
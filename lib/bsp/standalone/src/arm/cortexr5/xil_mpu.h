@@ -69,6 +69,9 @@
 * 					  Xil_InitializeExistingMPURegConfig.
 * 					  Added a new array of structure of type XMpuConfig to
 * 					  represent the MPU configuration table.
+* 7.1   adk  10/15/19 Added XMpu_Region, Xil_PlanMPURegions,
+* 					  Xil_ApplyMPUPlan and Xil_SetMPURegions to program
+* 					  the MPU from a memory map.
 * </pre>
 *
 
@@ -99,6 +102,18 @@ struct XMpuConfig{
 
 typedef struct XMpuConfig XMpu_Config[MAX_POSSIBLE_MPU_REGS];
 
+/*
+ * Entry of the memory map given to Xil_PlanMPURegions. Base address and size
+ * are multiples of 32 bytes and need not be a power of two. Later entries
+ * take priority where they overlap earlier ones, e.g. a shared non-cacheable
+ * OpenAMP buffer listed after the cacheable DDR holding it.
+ */
+typedef struct {
+	INTPTR BaseAddress; /* Start of the memory range */
+	u64 Size; /* Size of the memory range */
+	u32 Attribute; /* MPU region attribute */
+} XMpu_Region;
+
 extern XMpu_Config Mpu_Config;
 /************************** Constant Definitions *****************************/
 
@@ -118,6 +133,10 @@ u32 Xil_DisableMPURegionByRegNum (u32 reg_num);
 u16 Xil_GetMPUFreeRegMask (void);
 u32 Xil_SetMPURegionByRegNum (u32 reg_num, INTPTR addr, u64 size, u32 attrib);
 void* Xil_MemMap(UINTPTR Physaddr, size_t size, u32 flags);
+u32 Xil_PlanMPURegions(const XMpu_Region *Map, u32 NumMap,
+		XMpu_Config Plan, u32 *NumPlanned);
+u32 Xil_ApplyMPUPlan(XMpu_Config Plan, u32 NumPlanned);
+u32 Xil_SetMPURegions(const XMpu_Region *Map, u32 NumMap);
 
 #ifdef __cplusplus
 }
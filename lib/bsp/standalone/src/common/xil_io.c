@@ -41,6 +41,8 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 5.00 	pkp  	 05/29/14 First release
+* 7.1   adk      10/15/19 Added Xil_OutBlock32, Xil_InBlock32, Xil_OutBlock64,
+*                         Xil_InBlock64, Xil_OutSeq32 and Xil_MemCpyWc
 * </pre>
 ******************************************************************************/
 
@@ -94,3 +96,165 @@ u32 Xil_EndianSwap32(u32 Data)
 
 	return ((((u32)LoWord) << (u32)16U) | (u32)HiWord);
 }
+
+/*****************************************************************************/
+/**
+*
+* @brief    Writes an array of 32 bit values to consecutive registers, with a
+*           single barrier after the last write.
+*
+* @param	Addr: address of the first register
+* @param	Values: values to be written
+* @param	Count: number of registers
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_OutBlock32(UINTPTR Addr, const u32 *Values, u32 Count)
+{
+	volatile u32 *LocalAddr = (volatile u32 *)Addr;
+	u32 Index;
+
+	for (Index = 0U; Index < Count; Index++) {
+		LocalAddr[Index] = Values[Index];
+	}
+	Xil_IoSync();
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Reads consecutive 32 bit registers into an array.
+*
+* @param	Addr: address of the first register
+* @param	Values: filled with the values read
+* @param	Count: number of registers
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_InBlock32(UINTPTR Addr, u32 *Values, u32 Count)
+{
+	const volatile u32 *LocalAddr = (const volatile u32 *)Addr;
+	u32 Index;
+
+	for (Index = 0U; Index < Count; Index++) {
+		Values[Index] = LocalAddr[Index];
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Writes an array of 64 bit values to consecutive registers, with a
+*           single barrier after the last write.
+*
+* @param	Addr: address of the first register, 64 bit aligned
+* @param	Values: values to be written
+* @param	Count: number of registers
+*
+* @return	None.
+*
+* @note		On 32 bit processors each value is written by two 32 bit
+*			accesses.
+*
+******************************************************************************/
+void Xil_OutBlock64(UINTPTR Addr, const u64 *Values, u32 Count)
+{
+	volatile u64 *LocalAddr = (volatile u64 *)Addr;
+	u32 Index;
+
+	for (Index = 0U; Index < Count; Index++) {
+		LocalAddr[Index] = Values[Index];
+	}
+	Xil_IoSync();
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Reads consecutive 64 bit registers into an array.
+*
+* @param	Addr: address of the first register, 64 bit aligned
+* @param	Values: filled with the values read
+* @param	Count: number of registers
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_InBlock64(UINTPTR Addr, u64 *Values, u32 Count)
+{
+	const volatile u64 *LocalAddr = (const volatile u64 *)Addr;
+	u32 Index;
+
+	for (Index = 0U; Index < Count; Index++) {
+		Values[Index] = LocalAddr[Index];
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Performs a register programming sequence, in order, with a single
+*           barrier after the last write. The writes are not routed through
+*           the safety library.
+*
+* @param	BaseAddr: base address of the device
+* @param	Seq: register offsets and values
+* @param	Count: number of writes
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_OutSeq32(UINTPTR BaseAddr, const Xil_RegWrite *Seq, u32 Count)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Count; Index++) {
+		Xil_Out32Relaxed(BaseAddr + Seq[Index].Offset, Seq[Index].Value);
+	}
+	Xil_IoSync();
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Copies a buffer to a region mapped as normal non-cacheable memory,
+*           such as a frame or coefficient buffer in the PL, using the
+*           widest stores the alignment allows so that the write buffer can
+*           merge them into bursts, and a single barrier at the end.
+*
+* @param	Dst: destination address
+* @param	Src: source buffer
+* @param	Len: number of bytes
+*
+* @return	None.
+*
+* @note		Device memory does not merge writes and may require accesses
+*			of a given size, so use Xil_OutBlock32 for device registers.
+*
+******************************************************************************/
+void Xil_MemCpyWc(UINTPTR Dst, const void *Src, u32 Len)
+{
+	const u8 *SrcPtr = (const u8 *)Src;
+	u32 Offset = 0U;
+
+#if defined (__aarch64__)
+	if (((Dst | (UINTPTR)SrcPtr) & 0x7U) == 0U) {
+		for ( ; (Offset + 8U) <= Len; Offset += 8U) {
+			*(volatile u64 *)(Dst + Offset) =
+				*(const u64 *)(const void *)(SrcPtr + Offset);
+		}
+	}
+#endif
+	if (((Dst | (UINTPTR)SrcPtr) & 0x3U) == 0U) {
+		for ( ; (Offset + 4U) <= Len; Offset += 4U) {
+			*(volatile u32 *)(Dst + Offset) =
+				*(const u32 *)(const void *)(SrcPtr + Offset);
+		}
+	}
+	for ( ; Offset < Len; Offset++) {
+		*(volatile u8 *)(Dst + Offset) = SrcPtr[Offset];
+	}
+	Xil_IoSync();
+}
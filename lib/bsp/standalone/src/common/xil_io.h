@@ -43,6 +43,8 @@
 * 5.00 	pkp  	 05/29/14 First release
 * 6.00  mus      08/19/16 Remove checking of __LITTLE_ENDIAN__ flag for
 *                         ARM processors
+* 7.1   adk      10/15/19 Added relaxed accessors, Xil_IoSync and the block,
+*                         sequence and write-combining copy APIs
 * </pre>
 ******************************************************************************/
 
@@ -64,9 +66,25 @@ extern "C" {
 #include "xpseudo_asm.h"
 #endif
 
+/**************************** Type Definitions *******************************/
+
+/**
+ * Register write of a sequence given to Xil_OutSeq32
+ */
+typedef struct {
+	u32 Offset;	/**< Register offset from the base address */
+	u32 Value;	/**< Value written */
+} Xil_RegWrite;
+
 /************************** Function Prototypes ******************************/
 u16 Xil_EndianSwap16(u16 Data);
 u32 Xil_EndianSwap32(u32 Data);
+void Xil_OutBlock32(UINTPTR Addr, const u32 *Values, u32 Count);
+void Xil_InBlock32(UINTPTR Addr, u32 *Values, u32 Count);
+void Xil_OutBlock64(UINTPTR Addr, const u64 *Values, u32 Count);
+void Xil_InBlock64(UINTPTR Addr, u64 *Values, u32 Count);
+void Xil_OutSeq32(UINTPTR BaseAddr, const Xil_RegWrite *Seq, u32 Count);
+void Xil_MemCpyWc(UINTPTR Dst, const void *Src, u32 Len);
 #ifdef ENABLE_SAFETY
 extern u32 XStl_RegUpdate(u32 RegAddr, u32 RegVal);
 #endif
@@ -242,6 +260,93 @@ static INLINE void Xil_Out64(UINTPTR Addr, u64 Value)
 	*LocalAddr = Value;
 }
 
+/*****************************************************************************/
+/**
+*
+* @brief    Performs a 32 bit input operation without any ordering or safety
+*           handling. The plain accessors of this file do not issue a
+*           barrier either; the relaxed variants document that the caller
+*           orders the accesses, typically with Xil_IoSync at the end of a
+*           sequence.
+*
+* @param	Addr: contains the address to perform the input operation
+*
+* @return	The 32 bit Value read from the specified input address.
+*
+******************************************************************************/
+static INLINE u32 Xil_In32Relaxed(UINTPTR Addr)
+{
+	return *(volatile u32 *) Addr;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Performs a 32 bit output operation without any ordering or safety
+*           handling. Unlike Xil_Out32, the write is not routed through
+*           XStl_RegUpdate when ENABLE_SAFETY is defined, so it must not be
+*           used for registers monitored by the safety library.
+*
+* @param	Addr contains the address to perform the output operation
+* @param	Value contains the 32 bit Value to be written at the specified
+*           address.
+*
+* @return	None.
+*
+******************************************************************************/
+static INLINE void Xil_Out32Relaxed(UINTPTR Addr, u32 Value)
+{
+	volatile u32 *LocalAddr = (volatile u32 *)Addr;
+	*LocalAddr = Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Performs a 64 bit input operation without any ordering handling.
+*
+* @param	Addr: contains the address to perform the input operation
+*
+* @return	The 64 bit Value read from the specified input address.
+*
+******************************************************************************/
+static INLINE u64 Xil_In64Relaxed(UINTPTR Addr)
+{
+	return *(volatile u64 *) Addr;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Performs a 64 bit output operation without any ordering handling.
+*
+* @param	Addr contains the address to perform the output operation
+* @param	Value contains 64 bit Value to be written at the specified address.
+*
+* @return	None.
+*
+******************************************************************************/
+static INLINE void Xil_Out64Relaxed(UINTPTR Addr, u64 Value)
+{
+	volatile u64 *LocalAddr = (volatile u64 *)Addr;
+	*LocalAddr = Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Waits for the completion of all the preceding memory accesses,
+*           so that a sequence of relaxed writes is seen by the device before
+*           the accesses that follow.
+*
+* @return	None.
+*
+******************************************************************************/
+static INLINE void Xil_IoSync(void)
+{
+	DATA_SYNC;
+}
+
 #if defined (__MICROBLAZE__)
 #ifdef __LITTLE_ENDIAN__
 # define Xil_In16LE	Xil_In16
@@ -27,8 +27,11 @@
 /**
 * @file xil_mem.c
 *
-* This file contains xil mem copy function to use in case of word aligned
-* data copies.
+* This file contains xil mem copy and set functions. On ARM processors
+* blocks of co-aligned data are moved with LDP/STP (ARMv8, NEON registers
+* when available) or LDM/STM (ARMv7, Cortex-R5) loops, and copies above a
+* registered threshold can be handed to a DMA engine, see
+* Xil_MemCpySetOffload().
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -36,6 +39,9 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
+* 7.1   mus      09/05/19 Added block copy loops for ARM, Xil_MemSet() and
+*                         Xil_MemCpySetOffload().
+* 7.1   adk      10/15/19 Added cache line sized block loops for MicroBlaze.
 *
 * </pre>
 *
@@ -44,8 +50,206 @@
 /***************************** Include Files ********************************/
 
 #include "xil_types.h"
+#include "xil_mem.h"
+#include "xstatus.h"
+#ifdef __MICROBLAZE__
+#include "xparameters.h"
+#endif
+
+/************************** Constant Definitions ****************************/
+
+/*
+ * XIL_MEM_BLOCK_SIZE bytes are moved per iteration of the block loop, which
+ * is used when source and destination have the same offset from an
+ * XIL_MEM_ALIGN boundary.
+ */
+#if defined (__aarch64__)
+#define XIL_MEM_BLOCK_SIZE	64U
+#define XIL_MEM_ALIGN		8U
+#elif defined (__arm__)
+#define XIL_MEM_BLOCK_SIZE	32U
+#define XIL_MEM_ALIGN		4U
+#elif defined (__MICROBLAZE__)
+#if defined (XPAR_MICROBLAZE_USE_DCACHE) && (XPAR_MICROBLAZE_USE_DCACHE != 0) \
+	&& defined (XPAR_MICROBLAZE_DCACHE_LINE_LEN)
+#define XIL_MEM_LINE_SIZE	(XPAR_MICROBLAZE_DCACHE_LINE_LEN * 4U)
+#else
+#define XIL_MEM_LINE_SIZE	32U
+#endif
+#ifdef __arch64__
+#define XIL_MEM_ALIGN		8U
+typedef u64 Xil_MemWord;
+#else
+#define XIL_MEM_ALIGN		4U
+typedef u32 Xil_MemWord;
+#endif
+/* Words moved per iteration of the unrolled loops */
+#define XIL_MEM_UNROLL		4U
+#if (XIL_MEM_LINE_SIZE < (XIL_MEM_UNROLL * XIL_MEM_ALIGN))
+#define XIL_MEM_BLOCK_SIZE	(XIL_MEM_UNROLL * XIL_MEM_ALIGN)
+#else
+#define XIL_MEM_BLOCK_SIZE	XIL_MEM_LINE_SIZE
+#endif
+#endif
+
+/************************** Variable Definitions ****************************/
+
+static Xil_MemCpyOffloadFn MemCpyOffload;
+static u32 MemCpyOffloadThreshold;
 
 /***************** Inline Functions Definitions ********************/
+
+#ifdef XIL_MEM_BLOCK_SIZE
+/*****************************************************************************/
+/**
+* @brief       Copies Blocks * XIL_MEM_BLOCK_SIZE bytes. Dst and Src must be
+*              XIL_MEM_ALIGN aligned and Blocks must not be zero.
+*
+*****************************************************************************/
+static inline void Xil_MemCpyBlocks(u8 *Dst, const u8 *Src, u32 Blocks)
+{
+#if defined (__aarch64__) && defined (__ARM_NEON)
+	__asm__ __volatile__(
+		"1:	ldp	q0, q1, [%1], #32\n"
+		"	ldp	q2, q3, [%1], #32\n"
+		"	subs	%w2, %w2, #1\n"
+		"	stp	q0, q1, [%0], #32\n"
+		"	stp	q2, q3, [%0], #32\n"
+		"	b.ne	1b\n"
+		: "+r" (Dst), "+r" (Src), "+r" (Blocks)
+		:
+		: "v0", "v1", "v2", "v3", "cc", "memory");
+#elif defined (__aarch64__)
+	__asm__ __volatile__(
+		"1:	ldp	x3, x4, [%1], #16\n"
+		"	ldp	x5, x6, [%1], #16\n"
+		"	ldp	x7, x8, [%1], #16\n"
+		"	ldp	x9, x10, [%1], #16\n"
+		"	subs	%w2, %w2, #1\n"
+		"	stp	x3, x4, [%0], #16\n"
+		"	stp	x5, x6, [%0], #16\n"
+		"	stp	x7, x8, [%0], #16\n"
+		"	stp	x9, x10, [%0], #16\n"
+		"	b.ne	1b\n"
+		: "+r" (Dst), "+r" (Src), "+r" (Blocks)
+		:
+		: "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10", "cc",
+		  "memory");
+#elif defined (__arm__)
+	__asm__ __volatile__(
+		"1:	ldmia	%1!, {r3, r4, r5, r6, r8, r10, r12, lr}\n"
+		"	subs	%2, %2, #1\n"
+		"	stmia	%0!, {r3, r4, r5, r6, r8, r10, r12, lr}\n"
+		"	bne	1b\n"
+		: "+r" (Dst), "+r" (Src), "+r" (Blocks)
+		:
+		: "r3", "r4", "r5", "r6", "r8", "r10", "r12", "lr", "cc",
+		  "memory");
+#elif defined (__MICROBLAZE__)
+	Xil_MemWord *d = (Xil_MemWord *)(void *)Dst;
+	const Xil_MemWord *s = (const Xil_MemWord *)(const void *)Src;
+	Xil_MemWord w0, w1, w2, w3;
+	u32 Cnt = Blocks * (XIL_MEM_BLOCK_SIZE /
+			    (XIL_MEM_UNROLL * sizeof (Xil_MemWord)));
+
+	/*
+	 * All loads of an iteration are issued before the stores so that the
+	 * load latency is not exposed on every word.
+	 */
+	while (Cnt > 0U) {
+		w0 = s[0];
+		w1 = s[1];
+		w2 = s[2];
+		w3 = s[3];
+		d[0] = w0;
+		d[1] = w1;
+		d[2] = w2;
+		d[3] = w3;
+		d += XIL_MEM_UNROLL;
+		s += XIL_MEM_UNROLL;
+		Cnt -= 1U;
+	}
+#endif
+}
+
+/*****************************************************************************/
+/**
+* @brief       Fills Blocks * XIL_MEM_BLOCK_SIZE bytes with the byte Val.
+*              Dst must be XIL_MEM_ALIGN aligned and Blocks must not be zero.
+*
+*****************************************************************************/
+static inline void Xil_MemSetBlocks(u8 *Dst, u8 Val, u32 Blocks)
+{
+#if defined (__aarch64__) && defined (__ARM_NEON)
+	__asm__ __volatile__(
+		"	dup	v0.16b, %w2\n"
+		"1:	subs	%w1, %w1, #1\n"
+		"	stp	q0, q0, [%0], #32\n"
+		"	stp	q0, q0, [%0], #32\n"
+		"	b.ne	1b\n"
+		: "+r" (Dst), "+r" (Blocks)
+		: "r" ((u32)Val)
+		: "v0", "cc", "memory");
+#elif defined (__aarch64__)
+	u64 Fill = (u64)Val * 0x0101010101010101U;
+
+	__asm__ __volatile__(
+		"1:	subs	%w1, %w1, #1\n"
+		"	stp	%2, %2, [%0], #16\n"
+		"	stp	%2, %2, [%0], #16\n"
+		"	stp	%2, %2, [%0], #16\n"
+		"	stp	%2, %2, [%0], #16\n"
+		"	b.ne	1b\n"
+		: "+r" (Dst), "+r" (Blocks)
+		: "r" (Fill)
+		: "cc", "memory");
+#elif defined (__arm__)
+	u32 Fill = (u32)Val * 0x01010101U;
+
+	__asm__ __volatile__(
+		"	mov	r3, %2\n"
+		"	mov	r4, %2\n"
+		"	mov	r5, %2\n"
+		"	mov	r6, %2\n"
+		"	mov	r8, %2\n"
+		"	mov	r10, %2\n"
+		"	mov	r12, %2\n"
+		"	mov	lr, %2\n"
+		"1:	subs	%1, %1, #1\n"
+		"	stmia	%0!, {r3, r4, r5, r6, r8, r10, r12, lr}\n"
+		"	bne	1b\n"
+		: "+r" (Dst), "+r" (Blocks)
+		: "r" (Fill)
+		: "r3", "r4", "r5", "r6", "r8", "r10", "r12", "lr", "cc",
+		  "memory");
+#elif defined (__MICROBLAZE__)
+	Xil_MemWord *d = (Xil_MemWord *)(void *)Dst;
+	Xil_MemWord Fill = Val;
+	u32 Cnt = Blocks * (XIL_MEM_BLOCK_SIZE /
+			    (XIL_MEM_UNROLL * sizeof (Xil_MemWord)));
+
+	/*
+	 * The fill word is built with shifts, there may be no hardware
+	 * multiplier.
+	 */
+	Fill |= Fill << 8;
+	Fill |= Fill << 16;
+#ifdef __arch64__
+	Fill |= Fill << 32;
+#endif
+
+	while (Cnt > 0U) {
+		d[0] = Fill;
+		d[1] = Fill;
+		d[2] = Fill;
+		d[3] = Fill;
+		d += XIL_MEM_UNROLL;
+		Cnt -= 1U;
+	}
+#endif
+}
+#endif
+
 /*****************************************************************************/
 /**
 * @brief       This  function copies memory from once location to other.
@@ -56,11 +260,42 @@
 *
 * @param       cnt: 32 bit length of bytes to be copied
 *
+* @note        Copies of at least the threshold given to
+*              Xil_MemCpySetOffload() are first offered to the offload
+*              function.
+*
 *****************************************************************************/
 void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 {
 	char *d = (char*)(void *)dst;
 	const char *s = src;
+#ifdef XIL_MEM_BLOCK_SIZE
+	u32 Blocks;
+#endif
+
+	if ((MemCpyOffload != NULL) && (cnt >= MemCpyOffloadThreshold) &&
+	    (MemCpyOffload(dst, src, cnt) == (s32)XST_SUCCESS)) {
+		return;
+	}
+
+#ifdef XIL_MEM_BLOCK_SIZE
+	if ((cnt >= XIL_MEM_BLOCK_SIZE) &&
+	    ((((UINTPTR)d ^ (UINTPTR)s) & (XIL_MEM_ALIGN - 1U)) == 0U)) {
+		while (((UINTPTR)d & (XIL_MEM_ALIGN - 1U)) != 0U) {
+			*d = *s;
+			d += 1U;
+			s += 1U;
+			cnt -= 1U;
+		}
+		Blocks = cnt / XIL_MEM_BLOCK_SIZE;
+		if (Blocks != 0U) {
+			Xil_MemCpyBlocks((u8 *)d, (const u8 *)s, Blocks);
+			d += Blocks * XIL_MEM_BLOCK_SIZE;
+			s += Blocks * XIL_MEM_BLOCK_SIZE;
+			cnt -= Blocks * XIL_MEM_BLOCK_SIZE;
+		}
+	}
+#endif
 
 	while (cnt >= sizeof (int)) {
 		*(int*)d = *(int*)s;
@@ -81,3 +316,62 @@ void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 		cnt -= 1U;
 	}
 }
+
+/*****************************************************************************/
+/**
+* @brief       This function fills memory with a byte value.
+*
+* @param       dst: pointer pointing to destination memory
+*
+* @param       val: value of each byte, only the lower 8 bits are used
+*
+* @param       cnt: 32 bit length of bytes to be set
+*
+*****************************************************************************/
+void Xil_MemSet(void* dst, s32 val, u32 cnt)
+{
+	u8 *d = (u8 *)dst;
+	u8 v = (u8)val;
+#ifdef XIL_MEM_BLOCK_SIZE
+	u32 Blocks;
+
+	if (cnt >= XIL_MEM_BLOCK_SIZE) {
+		while (((UINTPTR)d & (XIL_MEM_ALIGN - 1U)) != 0U) {
+			*d = v;
+			d += 1U;
+			cnt -= 1U;
+		}
+		Blocks = cnt / XIL_MEM_BLOCK_SIZE;
+		if (Blocks != 0U) {
+			Xil_MemSetBlocks(d, v, Blocks);
+			d += Blocks * XIL_MEM_BLOCK_SIZE;
+			cnt -= Blocks * XIL_MEM_BLOCK_SIZE;
+		}
+	}
+#endif
+
+	while ((cnt) > 0U) {
+		*d = v;
+		d += 1U;
+		cnt -= 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief       Registers a function that Xil_MemCpy() offers copies of at
+*              least Threshold bytes to, typically one that programs a DMA
+*              engine. When the function does not return XST_SUCCESS the copy
+*              is done by the CPU. The function is responsible for any cache
+*              maintenance of the two buffers.
+*
+* @param       OffloadFn: offload function, NULL disables offloading
+*
+* @param       Threshold: smallest copy in bytes offered to OffloadFn
+*
+*****************************************************************************/
+void Xil_MemCpySetOffload(Xil_MemCpyOffloadFn OffloadFn, u32 Threshold)
+{
+	MemCpyOffloadThreshold = Threshold;
+	MemCpyOffload = OffloadFn;
+}
@@ -41,6 +41,9 @@
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
 * 7.0   mus      01/07/19 Add cpp extern macro
+* 7.1   mus      09/05/19 Add Xil_MemSet and Xil_MemCpySetOffload
+* 7.1   adk      10/15/19 Xil_MemCpy and Xil_MemSet use cache line sized
+*                         blocks on MicroBlaze
 *
 * </pre>
 *
@@ -52,9 +55,23 @@
 extern "C" {
 #endif
 
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Copy offload function, see Xil_MemCpySetOffload(). Returns XST_SUCCESS
+ * when it copied Cnt bytes from Src to Dst.
+ */
+typedef s32 (*Xil_MemCpyOffloadFn)(void *Dst, const void *Src, u32 Cnt);
+
 /************************** Function Prototypes *****************************/
 
 void Xil_MemCpy(void* dst, const void* src, u32 cnt);
+void Xil_MemSet(void* dst, s32 val, u32 cnt);
+void Xil_MemCpySetOffload(Xil_MemCpyOffloadFn OffloadFn, u32 Threshold);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,489 @@
+/******************************************************************************/
+/**
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+* @file xil_mempool.c
+*
+* This file contains the fixed size block pool functions, see xil_mempool.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 7.1   mus      10/14/19 First release
+*
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xil_mempool.h"
+#include "xstatus.h"
+#if defined (__MICROBLAZE__)
+#include "mb_interface.h"
+#else
+#include "xpseudo_asm.h"
+#endif
+
+/************************** Constant Definitions ****************************/
+
+#define MSR_IE		0x2U	/* MicroBlaze interrupt enable */
+#define IRQ_FIQ_MASK	0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
+
+/* Spinlocks need the GCC atomic builtins and exclusive accesses */
+#if defined (__GNUC__) && !defined (__MICROBLAZE__)
+#define XIL_MEMPOOL_HAS_SPINLOCK
+#endif
+
+/************************** Function Prototypes *****************************/
+
+static u32 Xil_MemPoolIrqSave(void);
+static void Xil_MemPoolIrqRestore(u32 Mask);
+static u32 Xil_MemPoolLock(XilMemPool *Pool);
+static void Xil_MemPoolUnlock(XilMemPool *Pool, u32 Mask);
+static void *Xil_MemPoolPop(XilMemPool *Pool);
+static void Xil_MemPoolPush(XilMemPool *Pool, void *Block);
+static s32 Xil_MemPoolIsBlock(const XilMemPool *Pool, const void *Block);
+
+/*****************************************************************************/
+/**
+* @brief       Initializes a block pool over a memory region. The region is
+*              not accessed until blocks are allocated from it.
+*
+* @param       Pool: Pointer to the pool.
+* @param       Mem: Start of the memory region, rounded up to
+*              XIL_MEMPOOL_ALIGN.
+* @param       MemSize: Size of the memory region in bytes.
+* @param       BlockSize: Block size in bytes, rounded up to a multiple of
+*              XIL_MEMPOOL_ALIGN.
+* @param       Flags: 0 or XIL_MEMPOOL_SHARED.
+*
+* @return
+*              - XST_SUCCESS if the pool was initialized.
+*              - XST_INVALID_PARAM if a parameter is NULL or 0, the region
+*                cannot hold a single block, or XIL_MEMPOOL_SHARED is
+*                requested on a processor without spinlock support.
+*
+******************************************************************************/
+s32 Xil_MemPoolInit(XilMemPool *Pool, void *Mem, u32 MemSize, u32 BlockSize,
+		u32 Flags)
+{
+	UINTPTR Base;
+	UINTPTR End;
+	u32 NumBlocks;
+
+	if ((Pool == NULL) || (Mem == NULL) || (BlockSize == 0U)) {
+		return XST_INVALID_PARAM;
+	}
+#ifndef XIL_MEMPOOL_HAS_SPINLOCK
+	if ((Flags & XIL_MEMPOOL_SHARED) != 0U) {
+		return XST_INVALID_PARAM;
+	}
+#endif
+
+	BlockSize = XIL_MEMPOOL_BLOCK_SIZE(BlockSize);
+	Base = ((UINTPTR)Mem + XIL_MEMPOOL_ALIGN - 1U) &
+		~((UINTPTR)XIL_MEMPOOL_ALIGN - 1U);
+	End = (UINTPTR)Mem + MemSize;
+	if (End < (Base + BlockSize)) {
+		return XST_INVALID_PARAM;
+	}
+	NumBlocks = (u32)((End - Base) / BlockSize);
+
+	Pool->FreeList = NULL;
+	Pool->Next = Base;
+	Pool->Base = Base;
+	Pool->End = Base + ((UINTPTR)NumBlocks * BlockSize);
+	Pool->Flags = Flags;
+	Pool->Lock = 0U;
+	Pool->Stats.BlockSize = BlockSize;
+	Pool->Stats.NumBlocks = NumBlocks;
+	Pool->Stats.FreeBlocks = NumBlocks;
+	Pool->Stats.MinFree = NumBlocks;
+	Pool->Stats.Allocs = 0U;
+	Pool->Stats.Fails = 0U;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Allocates a block from a pool.
+*
+* @param       Pool: Pointer to the pool.
+*
+* @return      Pointer to the block, aligned to XIL_MEMPOOL_ALIGN, or NULL
+*              if the pool is empty.
+*
+* @note        The content of the block is undefined.
+*
+******************************************************************************/
+void *Xil_MemPoolAlloc(XilMemPool *Pool)
+{
+	void *Block;
+	u32 Mask;
+
+	Mask = Xil_MemPoolLock(Pool);
+	Block = Xil_MemPoolPop(Pool);
+	Xil_MemPoolUnlock(Pool, Mask);
+
+	return Block;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Returns a block to its pool.
+*
+* @param       Pool: Pointer to the pool.
+* @param       Block: Pointer to the block, as returned by
+*              Xil_MemPoolAlloc() or Xil_MemPoolCacheAlloc().
+*
+* @return
+*              - XST_SUCCESS if the block was freed.
+*              - XST_INVALID_PARAM if Block is not a block of the pool.
+*
+******************************************************************************/
+s32 Xil_MemPoolFree(XilMemPool *Pool, void *Block)
+{
+	u32 Mask;
+
+	if (Xil_MemPoolIsBlock(Pool, Block) == 0) {
+		return XST_INVALID_PARAM;
+	}
+
+	Mask = Xil_MemPoolLock(Pool);
+	Xil_MemPoolPush(Pool, Block);
+	Xil_MemPoolUnlock(Pool, Mask);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Reads the statistics of a pool.
+*
+* @param       Pool: Pointer to the pool.
+* @param       Stats: Pointer to the statistics to fill.
+*
+* @return      None.
+*
+* @note        Blocks held by per-core caches are counted as allocated.
+*
+******************************************************************************/
+void Xil_MemPoolGetStats(XilMemPool *Pool, XilMemPool_Stats *Stats)
+{
+	u32 Mask;
+
+	Mask = Xil_MemPoolLock(Pool);
+	*Stats = Pool->Stats;
+	Xil_MemPoolUnlock(Pool, Mask);
+}
+
+/*****************************************************************************/
+/**
+* @brief       Initializes an empty per-core cache of a pool.
+*
+* @param       Cache: Pointer to the cache.
+* @param       Pool: Pointer to the pool.
+*
+* @return      None.
+*
+******************************************************************************/
+void Xil_MemPoolCacheInit(XilMemPool_Cache *Cache, XilMemPool *Pool)
+{
+	Cache->Pool = Pool;
+	Cache->Count = 0U;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Allocates a block through a per-core cache. An empty cache is
+*              refilled with up to XIL_MEMPOOL_CACHE_BATCH blocks from the
+*              pool.
+*
+* @param       Cache: Pointer to the cache.
+*
+* @return      Pointer to the block or NULL if the cache and the pool are
+*              empty.
+*
+******************************************************************************/
+void *Xil_MemPoolCacheAlloc(XilMemPool_Cache *Cache)
+{
+	XilMemPool *Pool = Cache->Pool;
+	void *Block = NULL;
+	u32 PoolMask;
+	u32 Mask;
+
+	Mask = Xil_MemPoolIrqSave();
+	if (Cache->Count == 0U) {
+		PoolMask = Xil_MemPoolLock(Pool);
+		while (Cache->Count < XIL_MEMPOOL_CACHE_BATCH) {
+			Block = Xil_MemPoolPop(Pool);
+			if (Block == NULL) {
+				break;
+			}
+			Cache->Blocks[Cache->Count] = Block;
+			Cache->Count++;
+		}
+		Xil_MemPoolUnlock(Pool, PoolMask);
+	}
+	if (Cache->Count != 0U) {
+		Cache->Count--;
+		Block = Cache->Blocks[Cache->Count];
+	}
+	Xil_MemPoolIrqRestore(Mask);
+
+	return Block;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Frees a block through a per-core cache. A full cache first
+*              returns XIL_MEMPOOL_CACHE_BATCH blocks to the pool.
+*
+* @param       Cache: Pointer to the cache.
+* @param       Block: Pointer to a block of the pool of the cache.
+*
+* @return
+*              - XST_SUCCESS if the block was freed.
+*              - XST_INVALID_PARAM if Block is not a block of the pool.
+*
+******************************************************************************/
+s32 Xil_MemPoolCacheFree(XilMemPool_Cache *Cache, void *Block)
+{
+	XilMemPool *Pool = Cache->Pool;
+	u32 PoolMask;
+	u32 Mask;
+
+	if (Xil_MemPoolIsBlock(Pool, Block) == 0) {
+		return XST_INVALID_PARAM;
+	}
+
+	Mask = Xil_MemPoolIrqSave();
+	if (Cache->Count == XIL_MEMPOOL_CACHE_SIZE) {
+		PoolMask = Xil_MemPoolLock(Pool);
+		while (Cache->Count > (XIL_MEMPOOL_CACHE_SIZE -
+				       XIL_MEMPOOL_CACHE_BATCH)) {
+			Cache->Count--;
+			Xil_MemPoolPush(Pool, Cache->Blocks[Cache->Count]);
+		}
+		Xil_MemPoolUnlock(Pool, PoolMask);
+	}
+	Cache->Blocks[Cache->Count] = Block;
+	Cache->Count++;
+	Xil_MemPoolIrqRestore(Mask);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Returns all the blocks of a per-core cache to the pool.
+*
+* @param       Cache: Pointer to the cache.
+*
+* @return      None.
+*
+******************************************************************************/
+void Xil_MemPoolCacheDrain(XilMemPool_Cache *Cache)
+{
+	XilMemPool *Pool = Cache->Pool;
+	u32 PoolMask;
+	u32 Mask;
+
+	Mask = Xil_MemPoolIrqSave();
+	PoolMask = Xil_MemPoolLock(Pool);
+	while (Cache->Count != 0U) {
+		Cache->Count--;
+		Xil_MemPoolPush(Pool, Cache->Blocks[Cache->Count]);
+	}
+	Xil_MemPoolUnlock(Pool, PoolMask);
+	Xil_MemPoolIrqRestore(Mask);
+}
+
+/*****************************************************************************/
+/**
+* @brief       Masks the interrupts.
+*
+* @return      Interrupt state to pass to Xil_MemPoolIrqRestore().
+*
+******************************************************************************/
+static u32 Xil_MemPoolIrqSave(void)
+{
+	u32 Mask;
+
+#if defined (__MICROBLAZE__)
+	Mask = (u32)mfmsr();
+	mtmsr(Mask & ~((u32)MSR_IE));
+#else
+	Mask = (u32)mfcpsr();
+	mtcpsr(Mask | IRQ_FIQ_MASK);
+#endif
+	return Mask;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Restores the interrupt state saved by Xil_MemPoolIrqSave().
+*
+* @param       Mask: Saved interrupt state.
+*
+* @return      None.
+*
+******************************************************************************/
+static void Xil_MemPoolIrqRestore(u32 Mask)
+{
+#if defined (__MICROBLAZE__)
+	mtmsr(Mask);
+#else
+	mtcpsr(Mask);
+#endif
+}
+
+/*****************************************************************************/
+/**
+* @brief       Masks the interrupts and, for a shared pool, takes its
+*              spinlock.
+*
+* @param       Pool: Pointer to the pool.
+*
+* @return      Interrupt state to pass to Xil_MemPoolUnlock().
+*
+******************************************************************************/
+static u32 Xil_MemPoolLock(XilMemPool *Pool)
+{
+	u32 Mask = Xil_MemPoolIrqSave();
+
+#ifdef XIL_MEMPOOL_HAS_SPINLOCK
+	if ((Pool->Flags & XIL_MEMPOOL_SHARED) != 0U) {
+		while (__atomic_exchange_n(&Pool->Lock, 1U,
+					   __ATOMIC_ACQUIRE) != 0U) {
+			/* the other core holds the lock for a few stores */
+		}
+	}
+#else
+	(void)Pool;
+#endif
+	return Mask;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Releases the spinlock of a shared pool and restores the
+*              interrupts.
+*
+* @param       Pool: Pointer to the pool.
+* @param       Mask: Interrupt state returned by Xil_MemPoolLock().
+*
+* @return      None.
+*
+******************************************************************************/
+static void Xil_MemPoolUnlock(XilMemPool *Pool, u32 Mask)
+{
+#ifdef XIL_MEMPOOL_HAS_SPINLOCK
+	if ((Pool->Flags & XIL_MEMPOOL_SHARED) != 0U) {
+		__atomic_store_n(&Pool->Lock, 0U, __ATOMIC_RELEASE);
+	}
+#else
+	(void)Pool;
+#endif
+	Xil_MemPoolIrqRestore(Mask);
+}
+
+/*****************************************************************************/
+/**
+* @brief       Takes a block from a locked pool, from the free list first and
+*              then from the blocks that were never used.
+*
+* @param       Pool: Pointer to the pool.
+*
+* @return      Pointer to the block or NULL if the pool is empty.
+*
+******************************************************************************/
+static void *Xil_MemPoolPop(XilMemPool *Pool)
+{
+	void *Block = Pool->FreeList;
+
+	if (Block != NULL) {
+		Pool->FreeList = *(void **)Block;
+	} else if (Pool->Next != Pool->End) {
+		Block = (void *)Pool->Next;
+		Pool->Next += Pool->Stats.BlockSize;
+	} else {
+		Pool->Stats.Fails++;
+		return NULL;
+	}
+
+	Pool->Stats.FreeBlocks--;
+	if (Pool->Stats.FreeBlocks < Pool->Stats.MinFree) {
+		Pool->Stats.MinFree = Pool->Stats.FreeBlocks;
+	}
+	Pool->Stats.Allocs++;
+
+	return Block;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Puts a block on the free list of a locked pool.
+*
+* @param       Pool: Pointer to the pool.
+* @param       Block: Pointer to the block.
+*
+* @return      None.
+*
+******************************************************************************/
+static void Xil_MemPoolPush(XilMemPool *Pool, void *Block)
+{
+	*(void **)Block = Pool->FreeList;
+	Pool->FreeList = Block;
+	Pool->Stats.FreeBlocks++;
+}
+
+/*****************************************************************************/
+/**
+* @brief       Checks that an address is the start of a block of a pool that
+*              was handed out.
+*
+* @param       Pool: Pointer to the pool.
+* @param       Block: Address to check.
+*
+* @return      1 if Block is a block of the pool, 0 otherwise.
+*
+******************************************************************************/
+static s32 Xil_MemPoolIsBlock(const XilMemPool *Pool, const void *Block)
+{
+	UINTPTR Addr = (UINTPTR)Block;
+
+	if ((Addr < Pool->Base) || (Addr >= Pool->Next) ||
+	    (((Addr - Pool->Base) % Pool->Stats.BlockSize) != 0U)) {
+		return 0;
+	}
+
+	return 1;
+}
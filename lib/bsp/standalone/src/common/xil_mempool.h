@@ -0,0 +1,181 @@
+/******************************************************************************/
+/**
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+* @file xil_mempool.h
+*
+* @addtogroup common_mempool_api Fixed Size Block Pool APIs
+*
+* A block pool hands out blocks of one size from a memory region supplied by
+* the application, a static array or a linker section. Allocation and free
+* are O(1): free blocks are kept on a singly linked list threaded through the
+* blocks themselves, and the blocks that were never used are carved from the
+* end of the region on demand, so Xil_MemPoolInit() does not touch it.
+*
+* Blocks start on an XIL_MEMPOOL_ALIGN boundary and their size is rounded up
+* to a multiple of it, so a block never shares a cache line with another
+* block or with unrelated data and can be flushed or invalidated for DMA on
+* its own. The pools are meant as the allocation backend of drivers and
+* stacks that need deterministic buffers, in place of malloc.
+*
+* The pool is protected by masking the interrupts, so it can be used from
+* interrupt handlers. A pool created with XIL_MEMPOOL_SHARED is placed in
+* memory that is coherent between the cores, or not cached, and is in
+* addition protected by a spinlock so that several processors (each running
+* its own standalone image) can allocate from it. A per-core cache avoids
+* taking the spinlock for every block: it keeps a few blocks of its own and
+* refills or drains them in batches of XIL_MEMPOOL_CACHE_BATCH.
+*
+* @code
+*	XIL_MEMPOOL_DEFINE_MEM(RxMem, 1536U, 64U);
+*	XilMemPool RxPool;
+*	void *Buf;
+*
+*	Xil_MemPoolInit(&RxPool, RxMem, sizeof(RxMem), 1536U, 0U);
+*	Buf = Xil_MemPoolAlloc(&RxPool);
+*	...
+*	Xil_MemPoolFree(&RxPool, Buf);
+* @endcode
+*
+* @{
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 7.1   mus      10/14/19 First release
+*
+* </pre>
+*
+*****************************************************************************/
+#ifndef XIL_MEMPOOL_H		/* prevent circular inclusions */
+#define XIL_MEMPOOL_H		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Alignment and size granule of the blocks, the data cache line size */
+#ifndef XIL_MEMPOOL_ALIGN
+#if defined (__aarch64__) || defined (ARMA53_32)
+#define XIL_MEMPOOL_ALIGN		64U
+#else
+#define XIL_MEMPOOL_ALIGN		32U
+#endif
+#endif
+
+/* Number of blocks a per-core cache holds */
+#ifndef XIL_MEMPOOL_CACHE_SIZE
+#define XIL_MEMPOOL_CACHE_SIZE		16U
+#endif
+
+/* Number of blocks moved between a cache and its pool at a time */
+#define XIL_MEMPOOL_CACHE_BATCH		(XIL_MEMPOOL_CACHE_SIZE / 2U)
+
+/* Pool flags */
+#define XIL_MEMPOOL_SHARED		0x1U	/**< Shared between cores */
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/* Size of a block of Size bytes once rounded up to XIL_MEMPOOL_ALIGN */
+#define XIL_MEMPOOL_BLOCK_SIZE(Size) \
+	(((Size) + XIL_MEMPOOL_ALIGN - 1U) & ~(XIL_MEMPOOL_ALIGN - 1U))
+
+/* Define an aligned memory region holding NumBlocks blocks of Size bytes */
+#if defined (__GNUC__)
+#define XIL_MEMPOOL_DEFINE_MEM(Name, Size, NumBlocks) \
+	u8 Name[XIL_MEMPOOL_BLOCK_SIZE(Size) * (NumBlocks)] \
+		__attribute__ ((aligned (XIL_MEMPOOL_ALIGN)))
+#else
+#define XIL_MEMPOOL_DEFINE_MEM(Name, Size, NumBlocks) \
+	u8 Name[(XIL_MEMPOOL_BLOCK_SIZE(Size) * (NumBlocks)) + \
+		XIL_MEMPOOL_ALIGN]
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Pool statistics, see Xil_MemPoolGetStats().
+ */
+typedef struct {
+	u32 BlockSize;	/**< Block size after rounding */
+	u32 NumBlocks;	/**< Number of blocks in the pool */
+	u32 FreeBlocks;	/**< Blocks currently free */
+	u32 MinFree;	/**< Lowest number of free blocks seen */
+	u32 Allocs;	/**< Successful allocations */
+	u32 Fails;	/**< Allocations that found the pool empty */
+} XilMemPool_Stats;
+
+/**
+ * Block pool. All the fields are private to xil_mempool.c.
+ */
+typedef struct {
+	void *FreeList;		/**< Freed blocks */
+	UINTPTR Next;		/**< First block that was never used */
+	UINTPTR Base;		/**< First block */
+	UINTPTR End;		/**< End of the last block */
+	u32 Flags;		/**< XIL_MEMPOOL_SHARED */
+	volatile u32 Lock;	/**< Spinlock of shared pools */
+	XilMemPool_Stats Stats;	/**< Statistics */
+} XilMemPool;
+
+/**
+ * Per-core cache of a pool. Each core, or each image, uses its own cache
+ * structure in its own memory.
+ */
+typedef struct {
+	XilMemPool *Pool;	/**< Pool the blocks come from */
+	u32 Count;		/**< Blocks in the cache */
+	void *Blocks[XIL_MEMPOOL_CACHE_SIZE];	/**< Cached blocks */
+} XilMemPool_Cache;
+
+/************************** Function Prototypes *****************************/
+
+s32 Xil_MemPoolInit(XilMemPool *Pool, void *Mem, u32 MemSize, u32 BlockSize,
+		u32 Flags);
+void *Xil_MemPoolAlloc(XilMemPool *Pool);
+s32 Xil_MemPoolFree(XilMemPool *Pool, void *Block);
+void Xil_MemPoolGetStats(XilMemPool *Pool, XilMemPool_Stats *Stats);
+
+void Xil_MemPoolCacheInit(XilMemPool_Cache *Cache, XilMemPool *Pool);
+void *Xil_MemPoolCacheAlloc(XilMemPool_Cache *Cache);
+s32 Xil_MemPoolCacheFree(XilMemPool_Cache *Cache, void *Block);
+void Xil_MemPoolCacheDrain(XilMemPool_Cache *Cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XIL_MEMPOOL_H */
+/**
+* @} End of "addtogroup common_mempool_api".
+*/
@@ -11,10 +11,20 @@
 #include <ctype.h>
 #include <string.h>
 #include <stdarg.h>
+#include "xstatus.h"
+#if (XIL_PRINTF_BUF_SIZE > 0) || (XIL_PRINTF_DEFERRED_ENTRIES > 0)
+#if defined (__MICROBLAZE__)
+#include "mb_interface.h"
+#else
+#include "xpseudo_asm.h"
+#endif
+#endif
 
-static void padding( const s32 l_flag,const struct params_s *par);
-static void outs(const charptr lp, struct params_s *par);
-static s32 getnum( charptr* linep);
+/* Characters formatted on the stack before they are copied to the ring */
+#define XIL_PRINTF_LINE_SIZE	64U
+
+#define XIL_PRINTF_MSR_IE		0x2U	/* MicroBlaze interrupt enable */
+#define XIL_PRINTF_IRQ_FIQ_MASK	0xC0U	/* Mask IRQ and FIQ in cpsr */
 
 typedef struct params_s {
     s32 len;
@@ -24,8 +34,47 @@ typedef struct params_s {
     s32 do_padding;
     s32 left_flag;
     s32 unsigned_flag;
+    char8 *line;	/* NULL: characters go straight to outbyte */
+    u32 line_len;
 } params_t;
 
+/*---------------------------------------------------*/
+/* Arguments of a format, taken from the va_list of  */
+/* the caller or from the values saved in a deferred */
+/* entry.                                            */
+/*---------------------------------------------------*/
+typedef struct {
+    va_list *ap;
+    const UINTPTR *argv;
+    u32 argc;
+} args_t;
+
+static void padding( const s32 l_flag, struct params_s *par);
+static void outs(const charptr lp, struct params_s *par);
+static s32 getnum( charptr* linep);
+static void format(const char8 *ctrl1, args_t *args, params_t *par);
+
+#if XIL_PRINTF_BUF_SIZE > 0
+static void ring_write(const char8 *buf, u32 len);
+
+static char8 ring[XIL_PRINTF_BUF_SIZE];
+static volatile u32 ring_head;	/* characters written */
+static volatile u32 ring_tail;	/* characters sent to outbyte */
+#endif
+
+#if XIL_PRINTF_DEFERRED_ENTRIES > 0
+/*
+ * Kept global so that a debugger or host tool can find the ring through the
+ * ELF symbol table and format the pending entries itself.
+ */
+xil_printf_ring_t XilPrintfDeferredRing;
+#endif
+
+#if (XIL_PRINTF_BUF_SIZE > 0) || (XIL_PRINTF_DEFERRED_ENTRIES > 0)
+static u32 printf_mode = XIL_PRINTF_MODE_DIRECT;
+static u32 printf_dropped;
+#endif
+
 
 /*---------------------------------------------------*/
 /* The purpose of this routine is to output data the */
@@ -36,21 +85,95 @@ typedef struct params_s {
 /*---------------------------------------------------*/
 
 
+/*---------------------------------------------------*/
+/*                                                   */
+/* This routine puts a character into the output     */
+/* buffer, or on stdout when there is none.          */
+/*                                                   */
+static void outc( const char8 c, struct params_s *par)
+{
+#if XIL_PRINTF_BUF_SIZE > 0
+    if (par->line != NULL) {
+        par->line[par->line_len] = c;
+        par->line_len++;
+        if (par->line_len == XIL_PRINTF_LINE_SIZE) {
+            ring_write(par->line, par->line_len);
+            par->line_len = 0U;
+        }
+        return;
+    }
+#else
+    (void)par;
+#endif
+#ifdef STDOUT_BASEADDRESS
+    outbyte(c);
+#else
+    (void)c;
+#endif
+}
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* These routines take the next argument of the      */
+/* format. Missing deferred arguments read as 0.     */
+/*                                                   */
+static s32 arg_s32( args_t *args)
+{
+    s32 n = 0;
+
+    if (args->ap != NULL) {
+        n = va_arg(*args->ap, s32);
+    } else if (args->argc != 0U) {
+        n = (s32)(*args->argv);
+        args->argv++;
+        args->argc--;
+    }
+    return n;
+}
+
+#if defined (__aarch64__) || defined (__arch64__)
+static s64 arg_s64( args_t *args)
+{
+    s64 n = 0;
+
+    if (args->ap != NULL) {
+        n = va_arg(*args->ap, s64);
+    } else if (args->argc != 0U) {
+        n = (s64)(*args->argv);
+        args->argv++;
+        args->argc--;
+    }
+    return n;
+}
+#endif
+
+static charptr arg_ptr( args_t *args)
+{
+    charptr p = NULL;
+
+    if (args->ap != NULL) {
+        p = va_arg(*args->ap, char8 *);
+    } else if (args->argc != 0U) {
+        p = (charptr)(*args->argv);
+        args->argv++;
+        args->argc--;
+    }
+    return p;
+}
+
 /*---------------------------------------------------*/
 /*                                                   */
 /* This routine puts pad characters into the output  */
 /* buffer.                                           */
 /*                                                   */
-static void padding( const s32 l_flag, const struct params_s *par)
+static void padding( const s32 l_flag, struct params_s *par)
 {
     s32 i;
 
     if ((par->do_padding != 0) && (l_flag != 0) && (par->len < par->num1)) {
 		i=(par->len);
         for (; i<(par->num1); i++) {
-#ifdef STDOUT_BASEADDRESS
-            outbyte( par->pad_character);
-#endif
+            outc( par->pad_character, par);
 		}
     }
 }
@@ -73,9 +196,7 @@ static void outs(const charptr lp, struct params_s *par)
     /* Move string to the buffer                     */
     while (((*LocalPtr) != (char8)0) && ((par->num2) != 0)) {
 		(par->num2)--;
-#ifdef STDOUT_BASEADDRESS
-        outbyte(*LocalPtr);
-#endif
+        outc(*LocalPtr, par);
 		LocalPtr += 1;
 }
 
@@ -133,9 +254,7 @@ static void outnum( const s32 n, const s32 base, struct params_s *par)
     par->len = (s32)strlen(outbuf);
     padding( !(par->left_flag), par);
     while (&outbuf[i] >= outbuf) {
-#ifdef STDOUT_BASEADDRESS
-	outbyte( outbuf[i] );
-#endif
+	outc( outbuf[i], par);
 		i--;
 }
     padding( par->left_flag, par);
@@ -189,7 +308,7 @@ static void outnum1( const s64 n, const s32 base, params_t *par)
     par->len = (s32)strlen(outbuf);
     padding( !(par->left_flag), par);
     while (&outbuf[i] >= outbuf) {
-	outbyte( outbuf[i] );
+	outc( outbuf[i], par);
 		i--;
 }
     padding( par->left_flag, par);
@@ -226,8 +345,7 @@ static s32 getnum( charptr* linep)
 
 /*---------------------------------------------------*/
 /*                                                   */
-/* This routine operates just like a printf/sprintf  */
-/* routine. It outputs a set of data under the       */
+/* This routine formats a set of arguments under the */
 /* control of a formatting string. Not all of the    */
 /* standard C format control are supported. The ones */
 /* provided are primarily those needed for embedded  */
@@ -236,15 +354,7 @@ static s32 getnum( charptr* linep)
 /* added easily by following the examples shown for  */
 /* the supported formats.                            */
 /*                                                   */
-
-/* void esp_printf( const func_ptr f_ptr,
-   const charptr ctrl1, ...) */
-#if  defined (__aarch64__) && HYP_GUEST && EL1_NONSECURE && XEN_USE_PV_CONSOLE
-void xil_printf( const char8 *ctrl1, ...){
-	XPVXenConsole_Printf(ctrl1);
-}
-#else
-void xil_printf( const char8 *ctrl1, ...)
+static void format(const char8 *ctrl1, args_t *args, params_t *par)
 {
 	s32 Check;
 #if defined (__aarch64__) || defined (__arch64__)
@@ -252,22 +362,15 @@ void xil_printf( const char8 *ctrl1, ...)
 #endif
     s32 dot_flag;
 
-    params_t par;
-
     char8 ch;
-    va_list argp;
     char8 *ctrl = (char8 *)ctrl1;
 
-    va_start( argp, ctrl1);
-
     while ((ctrl != NULL) && (*ctrl != (char8)0)) {
 
         /* move format string chars to buffer until a  */
         /* format control is found.                    */
         if (*ctrl != '%') {
-#ifdef STDOUT_BASEADDRESS
-            outbyte(*ctrl);
-#endif
+            outc(*ctrl, par);
 			ctrl += 1;
             continue;
         }
@@ -277,13 +380,13 @@ void xil_printf( const char8 *ctrl1, ...)
 #if defined (__aarch64__) || defined (__arch64__)
 		long_flag = 0;
 #endif
-        par.unsigned_flag = 0;
-		par.left_flag = 0;
-		par.do_padding = 0;
-        par.pad_character = ' ';
-        par.num2=32767;
-		par.num1=0;
-		par.len=0;
+        par->unsigned_flag = 0;
+		par->left_flag = 0;
+		par->do_padding = 0;
+        par->pad_character = ' ';
+        par->num2=32767;
+		par->num1=0;
+		par->len=0;
 
  try_next:
 		if(ctrl != NULL) {
@@ -297,16 +400,16 @@ void xil_printf( const char8 *ctrl1, ...)
 
         if (isdigit((s32)ch) != 0) {
             if (dot_flag != 0) {
-                par.num2 = getnum(&ctrl);
+                par->num2 = getnum(&ctrl);
 			}
             else {
                 if (ch == '0') {
-                    par.pad_character = '0';
+                    par->pad_character = '0';
 				}
 				if(ctrl != NULL) {
-			par.num1 = getnum(&ctrl);
+			par->num1 = getnum(&ctrl);
 				}
-                par.do_padding = 1;
+                par->do_padding = 1;
             }
             if(ctrl != NULL) {
 			ctrl -= 1;
@@ -316,14 +419,12 @@ void xil_printf( const char8 *ctrl1, ...)
 
         switch (tolower((s32)ch)) {
             case '%':
-#ifdef STDOUT_BASEADDRESS
-                outbyte( '%');
-#endif
+                outc( '%', par);
                 Check = 1;
                 break;
 
             case '-':
-                par.left_flag = 1;
+                par->left_flag = 1;
                 Check = 0;
                 break;
 
@@ -340,84 +441,72 @@ void xil_printf( const char8 *ctrl1, ...)
                 break;
 
             case 'u':
-                par.unsigned_flag = 1;
+                par->unsigned_flag = 1;
                 /* fall through */
             case 'i':
             case 'd':
                 #if defined (__aarch64__) || defined (__arch64__)
                 if (long_flag != 0){
-			        outnum1((s64)va_arg(argp, s64), 10L, &par);
+			        outnum1(arg_s64(args), 10L, par);
                 }
                 else {
-                    outnum( va_arg(argp, s32), 10L, &par);
+                    outnum( arg_s32(args), 10L, par);
                 }
                 #else
-                    outnum( va_arg(argp, s32), 10L, &par);
+                    outnum( arg_s32(args), 10L, par);
                 #endif
 				Check = 1;
                 break;
             case 'p':
                 #if defined (__aarch64__) || defined (__arch64__)
-                par.unsigned_flag = 1;
-			    outnum1((s64)va_arg(argp, s64), 16L, &par);
+                par->unsigned_flag = 1;
+			    outnum1(arg_s64(args), 16L, par);
 			    Check = 1;
                 break;
                 #endif
             case 'X':
             case 'x':
-                par.unsigned_flag = 1;
+                par->unsigned_flag = 1;
                 #if defined (__aarch64__) || defined (__arch64__)
                 if (long_flag != 0) {
-				    outnum1((s64)va_arg(argp, s64), 16L, &par);
+				    outnum1(arg_s64(args), 16L, par);
 				}
 				else {
-				    outnum((s32)va_arg(argp, s32), 16L, &par);
+				    outnum(arg_s32(args), 16L, par);
                 }
                 #else
-                outnum((s32)va_arg(argp, s32), 16L, &par);
+                outnum(arg_s32(args), 16L, par);
                 #endif
                 Check = 1;
                 break;
 
             case 's':
-                outs( va_arg( argp, char *), &par);
+                outs( arg_ptr(args), par);
                 Check = 1;
                 break;
 
             case 'c':
-#ifdef STDOUT_BASEADDRESS
-                outbyte( va_arg( argp, s32));
-#endif
+                outc( (char8)arg_s32(args), par);
                 Check = 1;
                 break;
 
             case '\\':
                 switch (*ctrl) {
                     case 'a':
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( ((char8)0x07));
-#endif
+                        outc( ((char8)0x07), par);
                         break;
                     case 'h':
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( ((char8)0x08));
-#endif
+                        outc( ((char8)0x08), par);
                         break;
                     case 'r':
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( ((char8)0x0D));
-#endif
+                        outc( ((char8)0x0D), par);
                         break;
                     case 'n':
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( ((char8)0x0D));
-                        outbyte( ((char8)0x0A));
-#endif
+                        outc( ((char8)0x0D), par);
+                        outc( ((char8)0x0A), par);
                         break;
                     default:
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( *ctrl);
-#endif
+                        outc( *ctrl, par);
                         break;
                 }
                 ctrl += 1;
@@ -436,7 +525,303 @@ void xil_printf( const char8 *ctrl1, ...)
         }
         goto try_next;
     }
+}
+
+#if (XIL_PRINTF_BUF_SIZE > 0) || (XIL_PRINTF_DEFERRED_ENTRIES > 0)
+/*---------------------------------------------------*/
+/*                                                   */
+/* These routines mask and restore the interrupts    */
+/* around the updates of the rings, so that          */
+/* xil_printf can be called from interrupt handlers. */
+/*                                                   */
+static u32 irq_save(void)
+{
+    u32 mask;
+
+#if defined (__MICROBLAZE__)
+    mask = (u32)mfmsr();
+    mtmsr(mask & ~((u32)XIL_PRINTF_MSR_IE));
+#else
+    mask = (u32)mfcpsr();
+    mtcpsr(mask | XIL_PRINTF_IRQ_FIQ_MASK);
+#endif
+    return mask;
+}
+
+static void irq_restore(const u32 mask)
+{
+#if defined (__MICROBLAZE__)
+    mtmsr(mask);
+#else
+    mtcpsr(mask);
+#endif
+}
+#endif
+
+#if XIL_PRINTF_BUF_SIZE > 0
+/*---------------------------------------------------*/
+/*                                                   */
+/* This routine copies formatted characters to the   */
+/* output ring. Characters that do not fit are       */
+/* dropped and counted.                              */
+/*                                                   */
+static void ring_write(const char8 *buf, u32 len)
+{
+    u32 mask;
+    u32 i;
+
+    mask = irq_save();
+    if ((XIL_PRINTF_BUF_SIZE - (ring_head - ring_tail)) < len) {
+        printf_dropped++;
+    } else {
+        for (i = 0U; i < len; i++) {
+            ring[(ring_head + i) & (XIL_PRINTF_BUF_SIZE - 1U)] = buf[i];
+        }
+        ring_head += len;
+    }
+    irq_restore(mask);
+}
+#endif
+
+#if XIL_PRINTF_DEFERRED_ENTRIES > 0
+/*---------------------------------------------------*/
+/*                                                   */
+/* This routine saves the arguments of a format, as  */
+/* format() would read them, and returns how many    */
+/* were saved.                                       */
+/*                                                   */
+static u32 capture(const char8 *ctrl, va_list *ap, UINTPTR *argv)
+{
+    u32 argc = 0U;
+    s32 long_flag;
+    s32 ch;
+
+    while ((*ctrl != (char8)0) && (argc < XIL_PRINTF_DEFERRED_ARGS)) {
+        if (*ctrl != '%') {
+            ctrl += 1;
+            continue;
+        }
+
+        /* skip the flags, width and precision         */
+        long_flag = 0;
+        ctrl += 1;
+        ch = tolower((s32)*ctrl);
+        while ((isdigit(ch) != 0) || (ch == '-') || (ch == '.') ||
+               (ch == 'l') || (ch == '\\')) {
+            if (ch == 'l') {
+                long_flag = 1;
+            }
+            if ((ch == '\\') && (ctrl[1] != (char8)0)) {
+                ctrl += 1;
+            }
+            ctrl += 1;
+            ch = tolower((s32)*ctrl);
+        }
+        if (ch == 0) {
+            break;
+        }
+        ctrl += 1;
+
+        switch (ch) {
+            case 'u':
+            case 'i':
+            case 'd':
+            case 'x':
+            #if defined (__aarch64__) || defined (__arch64__)
+                if (long_flag != 0) {
+                    argv[argc] = (UINTPTR)va_arg(*ap, s64);
+                    argc++;
+                    break;
+                }
+            #endif
+                /* fall through */
+            case 'c':
+                argv[argc] = (UINTPTR)va_arg(*ap, s32);
+                argc++;
+                break;
+            case 'p':
+            #if defined (__aarch64__) || defined (__arch64__)
+                argv[argc] = (UINTPTR)va_arg(*ap, s64);
+            #else
+                argv[argc] = (UINTPTR)va_arg(*ap, s32);
+            #endif
+                argc++;
+                break;
+            case 's':
+                argv[argc] = (UINTPTR)va_arg(*ap, char8 *);
+                argc++;
+                break;
+            default:
+                break;
+        }
+    }
+    (void)long_flag;
+    return argc;
+}
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* This routine queues a format and its arguments in */
+/* the deferred ring. Formats that do not fit are    */
+/* dropped and counted.                              */
+/*                                                   */
+static void deferred_write(const char8 *ctrl1, va_list *ap)
+{
+    xil_printf_entry_t *entry;
+    u32 mask;
+
+    mask = irq_save();
+    if ((XilPrintfDeferredRing.head - XilPrintfDeferredRing.tail) >=
+        XIL_PRINTF_DEFERRED_ENTRIES) {
+        printf_dropped++;
+    } else {
+        entry = &XilPrintfDeferredRing.entries[XilPrintfDeferredRing.head &
+                                       (XIL_PRINTF_DEFERRED_ENTRIES - 1U)];
+        entry->fmt = ctrl1;
+        entry->argc = capture(ctrl1, ap, entry->argv);
+        XilPrintfDeferredRing.head++;
+    }
+    irq_restore(mask);
+}
+#endif
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* This routine operates just like a printf/sprintf  */
+/* routine. It outputs a set of data under the       */
+/* control of a formatting string, on stdout or, as  */
+/* selected by xil_printf_setmode, in the output     */
+/* ring or the deferred ring.                        */
+/*                                                   */
+
+/* void esp_printf( const func_ptr f_ptr,
+   const charptr ctrl1, ...) */
+#if  defined (__aarch64__) && HYP_GUEST && EL1_NONSECURE && XEN_USE_PV_CONSOLE
+void xil_printf( const char8 *ctrl1, ...){
+	XPVXenConsole_Printf(ctrl1);
+}
+#else
+void xil_printf( const char8 *ctrl1, ...)
+{
+    params_t par;
+    args_t args;
+    va_list argp;
+#if XIL_PRINTF_BUF_SIZE > 0
+    char8 line[XIL_PRINTF_LINE_SIZE];
+#endif
+
+    va_start( argp, ctrl1);
+
+#if XIL_PRINTF_DEFERRED_ENTRIES > 0
+    if ((printf_mode == XIL_PRINTF_MODE_DEFERRED) && (ctrl1 != NULL)) {
+        deferred_write(ctrl1, &argp);
+        va_end( argp);
+        return;
+    }
+#endif
+
+    args.ap = &argp;
+    args.argv = NULL;
+    args.argc = 0U;
+    par.line = NULL;
+    par.line_len = 0U;
+#if XIL_PRINTF_BUF_SIZE > 0
+    if (printf_mode == XIL_PRINTF_MODE_BUFFERED) {
+        par.line = line;
+    }
+#endif
+
+    format(ctrl1, &args, &par);
+
+#if XIL_PRINTF_BUF_SIZE > 0
+    if (par.line_len != 0U) {
+        ring_write(line, par.line_len);
+    }
+#endif
     va_end( argp);
 }
 #endif
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* This routine selects where xil_printf puts its    */
+/* output. The pending output is written first.      */
+/*                                                   */
+s32 xil_printf_setmode(const u32 mode)
+{
+    if (mode == XIL_PRINTF_MODE_DIRECT) {
+        /* always available */
+#if XIL_PRINTF_BUF_SIZE > 0
+    } else if (mode == XIL_PRINTF_MODE_BUFFERED) {
+        /* output ring configured */
+#endif
+#if XIL_PRINTF_DEFERRED_ENTRIES > 0
+    } else if (mode == XIL_PRINTF_MODE_DEFERRED) {
+        /* deferred ring configured */
+#endif
+    } else {
+        return XST_INVALID_PARAM;
+    }
+
+    xil_printf_flush();
+#if (XIL_PRINTF_BUF_SIZE > 0) || (XIL_PRINTF_DEFERRED_ENTRIES > 0)
+    printf_mode = mode;
+#endif
+    return XST_SUCCESS;
+}
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* This routine writes the pending output on stdout: */
+/* the characters of the output ring, then the       */
+/* formats of the deferred ring. It is meant to be   */
+/* called from a single context, usually the idle    */
+/* loop or task.                                     */
+/*                                                   */
+void xil_printf_flush(void)
+{
+#if XIL_PRINTF_DEFERRED_ENTRIES > 0
+    const xil_printf_entry_t *entry;
+    params_t par;
+    args_t args;
+#endif
+
+#if XIL_PRINTF_BUF_SIZE > 0
+    while (ring_tail != ring_head) {
+#ifdef STDOUT_BASEADDRESS
+        outbyte(ring[ring_tail & (XIL_PRINTF_BUF_SIZE - 1U)]);
+#endif
+        ring_tail++;
+    }
+#endif
+
+#if XIL_PRINTF_DEFERRED_ENTRIES > 0
+    while (XilPrintfDeferredRing.tail != XilPrintfDeferredRing.head) {
+        entry = &XilPrintfDeferredRing.entries[XilPrintfDeferredRing.tail &
+                                       (XIL_PRINTF_DEFERRED_ENTRIES - 1U)];
+        args.ap = NULL;
+        args.argv = entry->argv;
+        args.argc = entry->argc;
+        par.line = NULL;
+        par.line_len = 0U;
+        format(entry->fmt, &args, &par);
+        XilPrintfDeferredRing.tail++;
+    }
+#endif
+}
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* This routine returns the number of writes to the  */
+/* output and deferred rings that were dropped       */
+/* because the ring was full.                        */
+/*                                                   */
+u32 xil_printf_dropped(void)
+{
+#if (XIL_PRINTF_BUF_SIZE > 0) || (XIL_PRINTF_DEFERRED_ENTRIES > 0)
+    return printf_dropped;
+#else
+    return 0U;
+#endif
+}
 /*---------------------------------------------------*/
@@ -15,6 +15,37 @@ extern "C" {
 #include "xen_console.h"
 #endif
 
+/*----------------------------------------------------*/
+/* Output modes of xil_printf, see xil_printf_setmode.*/
+/* DIRECT writes each character with outbyte in the   */
+/* context of the caller. BUFFERED copies the output  */
+/* to a ring of XIL_PRINTF_BUF_SIZE characters and    */
+/* DEFERRED queues the format pointer and the raw     */
+/* arguments in a ring of XIL_PRINTF_DEFERRED_ENTRIES */
+/* entries, without formatting. Both rings are        */
+/* written out by xil_printf_flush, usually from the  */
+/* idle loop. In DEFERRED mode the format and the     */
+/* strings passed for %s must still be valid when the */
+/* entry is flushed, string literals are. The ring    */
+/* sizes are BSP parameters, powers of two, and a     */
+/* ring of size 0 leaves its mode out.                */
+/*----------------------------------------------------*/
+
+#define XIL_PRINTF_MODE_DIRECT		0U
+#define XIL_PRINTF_MODE_BUFFERED	1U
+#define XIL_PRINTF_MODE_DEFERRED	2U
+
+#ifndef XIL_PRINTF_BUF_SIZE
+#define XIL_PRINTF_BUF_SIZE		0U
+#endif
+#ifndef XIL_PRINTF_DEFERRED_ENTRIES
+#define XIL_PRINTF_DEFERRED_ENTRIES	0U
+#endif
+/* Arguments saved per deferred entry, the others read as 0 */
+#ifndef XIL_PRINTF_DEFERRED_ARGS
+#define XIL_PRINTF_DEFERRED_ARGS	8U
+#endif
+
 /*----------------------------------------------------*/
 /* Use the following parameter passing structure to   */
 /* make xil_printf re-entrant.                        */
@@ -34,9 +65,33 @@ struct params_s;
 typedef char8* charptr;
 typedef s32 (*func_ptr)(int c);
 
+#if XIL_PRINTF_DEFERRED_ENTRIES > 0
+/*----------------------------------------------------*/
+/* Deferred ring, entry n is entries[n & (ENTRIES-1)].*/
+/* It is global so that a host tool can read it and   */
+/* format the entries from the ELF file.              */
+/*----------------------------------------------------*/
+typedef struct {
+    const char8 *fmt;
+    u32 argc;
+    UINTPTR argv[XIL_PRINTF_DEFERRED_ARGS];
+} xil_printf_entry_t;
+
+typedef struct {
+    volatile u32 head;	/* entries queued */
+    volatile u32 tail;	/* entries flushed */
+    xil_printf_entry_t entries[XIL_PRINTF_DEFERRED_ENTRIES];
+} xil_printf_ring_t;
+
+extern xil_printf_ring_t XilPrintfDeferredRing;
+#endif
+
 /*                                                   */
 
 void xil_printf( const char8 *ctrl1, ...);
+s32 xil_printf_setmode(const u32 mode);
+void xil_printf_flush(void);
+u32 xil_printf_dropped(void);
 void print( const char8 *ptr);
 extern void outbyte (char8 c);
 extern char8 inbyte(void);
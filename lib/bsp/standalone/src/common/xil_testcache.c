@@ -38,6 +38,8 @@
 * 1.00a hbm  07/28/09 Initial release
 * 4.1   asa  05/09/14 Ensured that the address uses for cache test is aligned
 *				      cache line.
+* 7.1   adk  10/15/19 Added Xil_TestCacheBandwidth to measure the read and
+*				      write bandwidth of a memory region.
 * </pre>
 *
 * @note
@@ -49,6 +51,7 @@
 #include "xil_testcache.h"
 #include "xil_types.h"
 #include "xpseudo_asm.h"
+#include "xtime_l.h"
 #ifdef __aarch64__
 #include "xreg_cortexa53.h"
 #else
@@ -362,4 +365,71 @@ s32 Xil_TestICacheAll(void)
 	xil_printf("-- Invalidate icache all done --\r\n");
 	return 0;
 }
+
+#if !defined (ARMR5) || defined (SLEEP_TIMER_BASEADDR)
+/*****************************************************************************/
+/**
+* @brief    Measure the write and read bandwidth of a memory region, as set
+*           up by the MMU or MPU attributes of the region. The region is
+*           written with word stores, then invalidated from the data cache
+*           and read back, so that both passes start from memory.
+*
+* @param	Addr: Start of the region, cache line aligned.
+* @param	Len: Length of the region in bytes, a multiple of the cache line.
+* @param	WriteMBps: Write bandwidth in MB/s.
+* @param	ReadMBps: Read bandwidth in MB/s.
+*
+* @return
+*     - 0 is returned for a pass
+*     - -1 is returned when the timer did not advance
+* @note
+*     The contents of the region are overwritten. On Cortex-R5 the function
+*     needs the TTC time base of xtime_l.h.
+*****************************************************************************/
+s32 Xil_TestCacheBandwidth(INTPTR Addr, u32 Len, u32 *WriteMBps,
+			   u32 *ReadMBps)
+{
+	volatile u32 *Ptr = (volatile u32 *)Addr;
+	u32 Words = Len / 4U;
+	u32 Index;
+	u32 Sum = 0U;
+	XTime Start;
+	XTime End;
+	u64 WriteTicks;
+	u64 ReadTicks;
+
+	Xil_DCacheFlushRange(Addr, Len);
+
+	XTime_GetTime(&Start);
+	for (Index = 0U; Index < Words; Index++) {
+		Ptr[Index] = Index;
+	}
+	Xil_DCacheFlushRange(Addr, Len);
+	XTime_GetTime(&End);
+	WriteTicks = (u64)(End - Start);
+
+	Xil_DCacheInvalidateRange(Addr, Len);
+
+	XTime_GetTime(&Start);
+	for (Index = 0U; Index < Words; Index++) {
+		Sum += Ptr[Index];
+	}
+	XTime_GetTime(&End);
+	ReadTicks = (u64)(End - Start);
+
+	if ((WriteTicks == 0U) || (ReadTicks == 0U)) {
+		return -1;
+	}
+
+	*WriteMBps = (u32)(((u64)Len * COUNTS_PER_SECOND) /
+			(WriteTicks * 1000000U));
+	*ReadMBps = (u32)(((u64)Len * COUNTS_PER_SECOND) /
+			(ReadTicks * 1000000U));
+
+	xil_printf("-- Bandwidth at 0x%x: write %d MB/s, read %d MB/s "
+		   "(sum 0x%x) --\r\n", (u32)Addr, *WriteMBps, *ReadMBps, Sum);
+
+	return 0;
+}
+#endif
 #endif
@@ -37,6 +37,7 @@
 * Ver    Who    Date    Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00a hbm  07/29/09 First release
+* 7.1   adk  10/15/19 Added Xil_TestCacheBandwidth
 * </pre>
 *
 ******************************************************************************/
@@ -54,6 +55,8 @@ extern s32 Xil_TestDCacheRange(void);
 extern s32 Xil_TestDCacheAll(void);
 extern s32 Xil_TestICacheRange(void);
 extern s32 Xil_TestICacheAll(void);
+extern s32 Xil_TestCacheBandwidth(INTPTR Addr, u32 Len, u32 *WriteMBps,
+				  u32 *ReadMBps);
 
 #ifdef __cplusplus
 }
@@ -36,6 +36,7 @@
 * Ver    Who    Date    Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00a hbm  08/25/09 First release
+* 7.1   mus  09/05/19 Added Xil_TestMemCpyPerf
 * </pre>
 *
 *****************************************************************************/
@@ -44,8 +45,31 @@
 #include "xil_testmem.h"
 #include "xil_io.h"
 #include "xil_assert.h"
+#if defined (__aarch64__) || defined (__arm__)
+#include "xil_mem.h"
+#include "xil_printf.h"
+#include "xparameters.h"
+#include "xtime_l.h"
+#endif
 
 /************************** Constant Definitions ****************************/
+
+#if defined (__aarch64__) || defined (__arm__)
+#if defined (versal) && defined (__aarch64__)
+#define TESTMEM_CPU_FREQ_HZ	XPAR_CPU_CORTEXA72_CORE_CLOCK_FREQ_HZ
+#elif defined (__aarch64__) || defined (ARMA53_32)
+#define TESTMEM_CPU_FREQ_HZ	XPAR_CPU_CORTEXA53_CORE_CLOCK_FREQ_HZ
+#elif defined (ARMR5)
+#define TESTMEM_CPU_FREQ_HZ	XPAR_CPU_CORTEXR5_CORE_CLOCK_FREQ_HZ
+#else
+#define TESTMEM_CPU_FREQ_HZ	XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ
+#endif
+
+/* The Cortex-R5 time base is only available with the sleep timer (TTC) */
+#if !defined (ARMR5) || defined (SLEEP_TIMER_BASEADDR)
+#define TESTMEM_HAS_TIMER
+#endif
+#endif
 /************************** Function Prototypes *****************************/
 
 static u32 RotateLeft(u32 Input, u8 Width);
@@ -763,6 +787,119 @@ End_Label:
 }
 
 
+#ifdef TESTMEM_HAS_TIMER
+/*****************************************************************************/
+/**
+*
+* @brief   Converts a measurement into bytes per CPU cycle
+*
+* @param    Start is the time base value before the transfers
+* @param    End is the time base value after the transfers
+* @param    Bytes is the number of bytes transferred
+*
+* @return
+*           Bytes per CPU cycle, multiplied by 100
+*
+*****************************************************************************/
+static u32 TestMemRate(XTime Start, XTime End, u64 Bytes)
+{
+	u64 Cycles;
+
+	Cycles = ((u64)(End - Start) * (u64)TESTMEM_CPU_FREQ_HZ) /
+			(u64)COUNTS_PER_SECOND;
+	if (Cycles == 0U) {
+		return 0U;
+	}
+
+	return (u32)((Bytes * 100U) / Cycles);
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* @brief    Measures Xil_MemCpy() and Xil_MemSet() for transfer sizes from
+*           16 bytes up to MaxLen, growing by a factor of four, and prints
+*           the throughput of each size class in bytes per CPU cycle.
+*
+* @param    Dst is the destination buffer of at least MaxLen bytes
+* @param    Src is the source buffer of at least MaxLen bytes
+* @param    MaxLen is the largest transfer size in bytes
+* @param    Iterations is the number of transfers timed per size
+*
+* @return
+*           - 0 is returned for a pass
+*           - -1 is returned if a transfer corrupted data or no time base
+*             is available
+*
+* @note
+* The buffers are used with the data cache in its current state, so sizes
+* that fit in the cache report cache to cache throughput.
+*
+*****************************************************************************/
+s32 Xil_TestMemCpyPerf(u8 *Dst, u8 *Src, u32 MaxLen, u32 Iterations)
+{
+#ifdef TESTMEM_HAS_TIMER
+	u32 I;
+	u32 Len;
+	u32 CpyRate;
+	u32 SetRate;
+	XTime Start;
+	XTime End;
+	s32 Status = 0;
+
+	Xil_AssertNonvoid(Dst != NULL);
+	Xil_AssertNonvoid(Src != NULL);
+	Xil_AssertNonvoid(Iterations != (u32)0);
+
+	for (I = 0U; I < MaxLen; I++) {
+		Src[I] = (u8)((I * 7U) + 1U);
+	}
+
+	xil_printf("    Size  MemCpy B/cycle  MemSet B/cycle\r\n");
+	for (Len = 16U; Len <= MaxLen; Len <<= 2) {
+		XTime_GetTime(&Start);
+		for (I = 0U; I < Iterations; I++) {
+			Xil_MemCpy(Dst, Src, Len);
+		}
+		XTime_GetTime(&End);
+		CpyRate = TestMemRate(Start, End, (u64)Len * Iterations);
+		for (I = 0U; I < Len; I++) {
+			if (Dst[I] != Src[I]) {
+				Status = -1;
+				goto End_Label;
+			}
+		}
+
+		XTime_GetTime(&Start);
+		for (I = 0U; I < Iterations; I++) {
+			Xil_MemSet(Dst, 0xA5, Len);
+		}
+		XTime_GetTime(&End);
+		SetRate = TestMemRate(Start, End, (u64)Len * Iterations);
+		for (I = 0U; I < Len; I++) {
+			if (Dst[I] != 0xA5U) {
+				Status = -1;
+				goto End_Label;
+			}
+		}
+
+		xil_printf("%8d  %11d.%02d  %11d.%02d\r\n", Len,
+			CpyRate / 100U, CpyRate % 100U,
+			SetRate / 100U, SetRate % 100U);
+	}
+
+End_Label:
+	return Status;
+#else
+	(void)Dst;
+	(void)Src;
+	(void)MaxLen;
+	(void)Iterations;
+	return -1;
+#endif
+}
+
 /*****************************************************************************/
 /**
 *
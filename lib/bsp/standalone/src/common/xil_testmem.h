@@ -93,6 +93,7 @@
 * Ver    Who    Date    Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00a hbm  08/25/09 First release
+* 7.1   mus  09/05/19 Added Xil_TestMemCpyPerf
 * </pre>
 *
 ******************************************************************************/
@@ -142,6 +143,10 @@ extern s32 Xil_TestMem32(u32 *Addr, u32 Words, u32 Pattern, u8 Subtest);
 extern s32 Xil_TestMem16(u16 *Addr, u32 Words, u16 Pattern, u8 Subtest);
 extern s32 Xil_TestMem8(u8 *Addr, u32 Words, u8 Pattern, u8 Subtest);
 
+#if defined (__aarch64__) || defined (__arm__)
+extern s32 Xil_TestMemCpyPerf(u8 *Dst, u8 *Src, u32 MaxLen, u32 Iterations);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
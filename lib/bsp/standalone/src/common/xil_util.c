@@ -35,6 +35,8 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 6.4   mmd      04/21/19 First release.
+* 7.1   adk      10/15/19 Added Xil_WaitForEventTimed and
+*                         Xil_WaitForEventsTimed.
 *
 * </pre>
 *
@@ -42,10 +44,23 @@
 
 /****************************** Include Files *********************************/
 #include "xil_util.h"
+#include "xparameters.h"
+#include "sleep.h"
+#if !defined (__MICROBLAZE__) && \
+	(!defined (ARMR5) || defined (SLEEP_TIMER_BASEADDR))
+#include "xtime_l.h"
+#define XIL_UTIL_TIME_BASE
+#endif
 
 /************************** Constant Definitions ****************************/
 #define MAX_NIBBLES			8U
 
+/* Longest sleep between two polls once the spin phase is over */
+#define XIL_POLL_MAX_BACKOFF_US		64U
+
+/* CNTKCTL_EL1.EVNTEN, generic timer event stream enable */
+#define XIL_CNTKCTL_EVNTEN_MASK		0x4U
+
 /************************** Function Prototypes *****************************/
 /****************************************************************************/
 /**
@@ -213,6 +228,224 @@ u32 Xil_WaitForEvents(u32 EventsRegAddr, u32 EventsMask, u32 WaitEvents,
 	return Status;
 }
 
+/******************************************************************************/
+/**
+ * Returns the time elapsed since a start time stamp, in microseconds.
+ *
+ * @param   Start   - Time stamp returned by Xil_PollTime
+ * @param   SleptUs - Time slept in the backoff phase, used when there is no
+ *                    time base
+ *
+ * @return  Elapsed time in microseconds
+ *
+ ******************************************************************************/
+static u64 Xil_PollElapsedUs(u64 Start, u64 SleptUs)
+{
+#ifdef XIL_UTIL_TIME_BASE
+	XTime Now;
+
+	(void)SleptUs;
+	XTime_GetTime(&Now);
+	return (((u64)(XTime)((XTime)Now - (XTime)Start)) * 1000000U) /
+		(u64)COUNTS_PER_SECOND;
+#else
+	(void)Start;
+	return SleptUs;
+#endif
+}
+
+/******************************************************************************/
+/**
+ * Returns the current time stamp, 0 when there is no time base.
+ *
+ ******************************************************************************/
+static u64 Xil_PollTime(void)
+{
+#ifdef XIL_UTIL_TIME_BASE
+	XTime Now;
+
+	XTime_GetTime(&Now);
+	return (u64)Now;
+#else
+	return 0U;
+#endif
+}
+
+/******************************************************************************/
+/**
+ * Waits before the next poll of the backoff phase. On ARMv8 with the generic
+ * timer event stream enabled the core sleeps in WFE until the next event,
+ * otherwise it sleeps for Backoff microseconds, doubled on each call.
+ *
+ * @param   Backoff   - Current sleep time, updated
+ * @param   MaxUs     - Time left before the timeout
+ *
+ * @return  Time slept in microseconds, 0 for WFE
+ *
+ ******************************************************************************/
+static u32 Xil_PollBackoff(u32 *Backoff, u64 MaxUs)
+{
+	u32 SleepUs = *Backoff;
+
+#if defined (__aarch64__)
+	if ((mfcp(CNTKCTL_EL1) & XIL_CNTKCTL_EVNTEN_MASK) != 0U) {
+		__asm__ __volatile__ ("wfe");
+		return 0U;
+	}
+#endif
+	if ((u64)SleepUs > MaxUs) {
+		SleepUs = (u32)MaxUs;
+	}
+	if (SleepUs == 0U) {
+		SleepUs = 1U;
+	}
+	usleep(SleepUs);
+	if (*Backoff < XIL_POLL_MAX_BACKOFF_US) {
+		*Backoff <<= 1U;
+	}
+
+	return SleepUs;
+}
+
+/******************************************************************************/
+/**
+ * Waits for the events with a time based timeout. The register is polled
+ * back to back SpinCount times, for short latencies, and then with an
+ * increasing sleep between polls so that long waits do not keep the bus and
+ * the core busy.
+ *
+ * @param   RegAddr    - Address of register to be checked for event(s)
+ *                       occurrence
+ * @param   EventMask  - Mask indicating event(s) to be checked
+ * @param   Event      - Value of the masked register to wait for, or 0 to
+ *                       wait for any event of the mask
+ * @param   SpinCount  - Number of polls before backing off
+ * @param   TimeoutUs  - Timeout in microseconds
+ * @param   Events     - Masked register value returned in memory pointed by
+ *                       this variable, may be NULL
+ * @param   WaitUs     - Time waited in microseconds, may be NULL
+ *
+ * @return
+ *          XST_SUCCESS - On occurrence of the event(s).
+ *          XST_TIMEOUT - Event did not occur before the timeout
+ *
+ ******************************************************************************/
+static u32 Xil_PollEvent(UINTPTR RegAddr, u32 EventMask, u32 Event,
+			 u32 SpinCount, u32 TimeoutUs, u32 *Events, u32 *WaitUs)
+{
+	u32 Status = XST_TIMEOUT;
+	u32 EventStatus = 0U;
+	u32 Polls = 0U;
+	u32 Backoff = 1U;
+	u64 SleptUs = 0U;
+	u64 ElapsedUs = 0U;
+	u64 Start;
+
+	Start = Xil_PollTime();
+	for (;;) {
+		EventStatus = Xil_In32(RegAddr) & EventMask;
+		if (((Event != 0U) && (EventStatus == Event)) ||
+		    ((Event == 0U) && (EventStatus != 0U))) {
+			Status = XST_SUCCESS;
+			break;
+		}
+		if (Polls < SpinCount) {
+			Polls++;
+			continue;
+		}
+		ElapsedUs = Xil_PollElapsedUs(Start, SleptUs);
+		if (ElapsedUs >= TimeoutUs) {
+			break;
+		}
+		SleptUs += Xil_PollBackoff(&Backoff, TimeoutUs - ElapsedUs);
+	}
+
+	if (Events != NULL) {
+		*Events = EventStatus;
+	}
+	if (WaitUs != NULL) {
+		ElapsedUs = Xil_PollElapsedUs(Start, SleptUs);
+		*WaitUs = (ElapsedUs > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (u32)ElapsedUs;
+	}
+
+	return Status;
+}
+
+/******************************************************************************/
+/**
+ * Waits for the event with a timeout in microseconds, see Xil_WaitForEvent
+ * for the polling by count.
+ *
+ * @param   RegAddr   - Address of register to be checked for event(s)
+ *                      occurance
+ * @param   EventMask - Mask indicating event(s) to be checked
+ * @param   Event     - Specific event(s) value to be checked
+ * @param   SpinCount - Number of back to back polls before backing off
+ * @param   TimeoutUs - Timeout in microseconds
+ * @param   WaitUs    - Time waited in microseconds, may be NULL
+ *
+ * @return
+ *          XST_SUCCESS - On occurance of the event(s).
+ *          XST_FAILURE - Event did not occur before the timeout
+ *
+ * @note    Without a time base (MicroBlaze, or Cortex-R5 without TTC) the
+ *          time spent in the spin phase is not accounted for, so the timeout
+ *          and WaitUs only cover the backoff phase.
+ *
+ *****************************************************************************/
+u32 Xil_WaitForEventTimed(UINTPTR RegAddr, u32 EventMask, u32 Event,
+			  u32 SpinCount, u32 TimeoutUs, u32 *WaitUs)
+{
+	u32 Status;
+
+	Status = Xil_PollEvent(RegAddr, EventMask, Event, SpinCount,
+			       TimeoutUs, NULL, WaitUs);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+	}
+
+	return Status;
+}
+
+/******************************************************************************/
+/**
+ * Waits for the events with a timeout in microseconds. Returns on occurrence
+ * of first event / timeout.
+ *
+ * @param   EventsRegAddr - Address of register to be checked for event(s)
+ *                          occurrence
+ * @param   EventsMask    - Mask indicating event(s) to be checked
+ * @param   WaitEvents    - Specific event(s) to be checked
+ * @param   SpinCount     - Number of back to back polls before backing off
+ * @param   TimeoutUs     - Timeout in microseconds
+ * @param   Events        - Mask of Events occured returned in memory pointed
+ *                          by this variable
+ * @param   WaitUs        - Time waited in microseconds, may be NULL
+ *
+ * @return
+ *          XST_SUCCESS - On occurrence of the event(s).
+ *          XST_TIMEOUT - Event did not occur before the timeout
+ *
+ * @note    See Xil_WaitForEventTimed.
+ *
+ ******************************************************************************/
+u32 Xil_WaitForEventsTimed(UINTPTR EventsRegAddr, u32 EventsMask,
+			   u32 WaitEvents, u32 SpinCount, u32 TimeoutUs,
+			   u32 *Events, u32 *WaitUs)
+{
+	u32 Status;
+	u32 EventStatus;
+
+	*Events = 0x00U;
+	Status = Xil_PollEvent(EventsRegAddr, EventsMask & WaitEvents, 0U,
+			       SpinCount, TimeoutUs, &EventStatus, WaitUs);
+	if (Status == XST_SUCCESS) {
+		*Events = Xil_In32(EventsRegAddr) & EventsMask;
+	}
+
+	return Status;
+}
+
 /******************************************************************************/
 /**
  * Checks whether the passed character is a valid hex digit
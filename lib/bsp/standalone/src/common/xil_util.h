@@ -35,6 +35,8 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 6.4   mmd      04/21/19 First release.
+* 7.1   adk      10/15/19 Added Xil_WaitForEventTimed and
+*                         Xil_WaitForEventsTimed.
 *
 * </pre>
 *
@@ -93,6 +95,15 @@ u32 Xil_WaitForEvent(u32 RegAddr, u32 EventMask, u32 Event, u32 Timeout);
 u32 Xil_WaitForEvents(u32 EventsRegAddr, u32 EventsMask, u32 WaitEvents,
 			 u32 Timeout, u32* Events);
 
+/* Waits for specified event, timeout in microseconds */
+u32 Xil_WaitForEventTimed(UINTPTR RegAddr, u32 EventMask, u32 Event,
+			  u32 SpinCount, u32 TimeoutUs, u32 *WaitUs);
+
+/* Waits for specified events, timeout in microseconds */
+u32 Xil_WaitForEventsTimed(UINTPTR EventsRegAddr, u32 EventsMask,
+			   u32 WaitEvents, u32 SpinCount, u32 TimeoutUs,
+			   u32 *Events, u32 *WaitUs);
+
 /* Validate input hex character */
 u32 Xil_IsValidHexChar(const char Ch);
 
@@ -33,6 +33,7 @@
 
 #include <sleep.h>
 #include <xil_cache.h>
+#include <xtime_l.h>
 #include <xscugic.h>
 #include "pm_api_sys.h"
 #include "pm_client.h"
@@ -49,6 +50,16 @@ static XIpiPsu IpiInst;
 #define DDR_STATE_ON	2U
 #define DDR_STATE_MAX	3U
 
+/*
+ * The latencies are timed with the TTC sleep timer, XTime is not available
+ * on R5 without it
+ */
+#ifdef SLEEP_TIMER_BASEADDR
+/* Microseconds elapsed since Start */
+#define ELAPSED_US(Start, End)	\
+	((u32)(((End) - (Start)) / (COUNTS_PER_SECOND / 1000000U)))
+#endif
+
 /**
  * IpiConfigure() - Call to configure IPI peripheral and enable its interrupt
  *		in both peripheral and at the GIC
@@ -175,6 +186,9 @@ int main(void)
 {
 	XStatus status;
 	XPm_NodeStatus nodestatus;
+#ifdef SLEEP_TIMER_BASEADDR
+	XTime tStart, tEnd;
+#endif
 
 	/* Initialize GIC, IPIs, and Xilpm */
 	status = PmInit(&GicInst, &IpiInst);
@@ -204,8 +218,16 @@ int main(void)
 	Xil_DCacheDisable();
 
 	xil_printf("Put DDR in retention mode.\r\n");
+#ifdef SLEEP_TIMER_BASEADDR
+	XTime_GetTime(&tStart);
+#endif
 	status = XPm_SetRequirement(NODE_DDR, PM_CAP_CONTEXT, 0,
 				    REQUEST_ACK_NO);
+#ifdef SLEEP_TIMER_BASEADDR
+	XTime_GetTime(&tEnd);
+	xil_printf("Self-refresh entry took %d us\r\n",
+		   ELAPSED_US(tStart, tEnd));
+#endif
 	if (XST_SUCCESS != status) {
 		xil_printf("Failed to set DDR requirement\n");
 	} else {
@@ -227,7 +249,15 @@ int main(void)
 	sleep(10);
 
 	xil_printf("Bring DDR out of retention mode.\r\n");
+#ifdef SLEEP_TIMER_BASEADDR
+	XTime_GetTime(&tStart);
+#endif
 	status = XPm_SetRequirement(NODE_DDR, PM_CAP_ACCESS, 0, REQUEST_ACK_NO);
+#ifdef SLEEP_TIMER_BASEADDR
+	XTime_GetTime(&tEnd);
+	xil_printf("Self-refresh exit took %d us\r\n",
+		   ELAPSED_US(tStart, tEnd));
+#endif
 	if (XST_SUCCESS != status) {
 		xil_printf("Failed to set DDR requirement\n");
 	} else {
@@ -0,0 +1,335 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file intr_latency.c
+*
+* Measurement and report helpers of the interrupt latency benchmark, see
+* intr_latency.h.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "intr_latency.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+#include "xpseudo_asm.h"
+
+/************************** Constant Definitions *****************************/
+
+#define PMCR_ENABLE		0x00000001U
+#define PMCR_CYCLE_RESET	0x00000004U
+#define PMCR_CYCLE_DIV64	0x00000008U
+#define PMCNTEN_CYCLE		0x80000000U
+
+/************************** Variable Definitions *****************************/
+
+/* TTC input clock divided by the prescaler */
+static u32 TtcCountHz;
+
+/*****************************************************************************/
+/**
+* Enable the PMU cycle counter of the calling core and reset it.
+*
+* @return	None.
+*
+******************************************************************************/
+void Bench_CycleCounterInit(void)
+{
+	u32 Reg;
+
+#if defined (__aarch64__)
+	Reg = (u32)mfcp(PMCR_EL0);
+	Reg |= PMCR_ENABLE | PMCR_CYCLE_RESET;
+	Reg &= ~PMCR_CYCLE_DIV64;
+	mtcp(PMCR_EL0, (u64)Reg);
+	mtcp(PMCNTENSET_EL0, (u64)PMCNTEN_CYCLE);
+#else
+	Reg = mfcp(XREG_CP15_PERF_MONITOR_CTRL);
+	Reg |= PMCR_ENABLE | PMCR_CYCLE_RESET;
+	Reg &= ~PMCR_CYCLE_DIV64;
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, PMCNTEN_CYCLE);
+#endif
+}
+
+/*****************************************************************************/
+/**
+* Read the PMU cycle counter of the calling core.
+*
+* @return	Low 32 bits of the counter, differences are valid across a
+*		wrap around.
+*
+******************************************************************************/
+u32 Bench_CycleCounterRead(void)
+{
+#if defined (__aarch64__)
+	return (u32)mfcp(PMCCNTR_EL0);
+#else
+	return mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+#endif
+}
+
+/*****************************************************************************/
+/**
+* Convert a number of PMU cycles to nanoseconds.
+*
+* @param	Cycles is the number of cycles.
+*
+* @return	Nanoseconds.
+*
+******************************************************************************/
+u32 Bench_CyclesToNs(u32 Cycles)
+{
+	return (u32)(((u64)Cycles * 1000000000U) / BENCH_CPU_FREQ_HZ);
+}
+
+/*****************************************************************************/
+/**
+* Set up the benchmark TTC counter in interval mode at BENCH_TTC_FREQ_HZ with
+* the interval interrupt enabled. The counter is left stopped.
+*
+* @param	TtcPtr is the TTC instance to initialize.
+*
+* @return	XST_SUCCESS or XST_FAILURE.
+*
+******************************************************************************/
+s32 Bench_TtcInit(XTtcPs *TtcPtr)
+{
+	XTtcPs_Config *ConfigPtr;
+	XInterval Interval;
+	u8 Prescaler;
+	s32 Status;
+
+	ConfigPtr = XTtcPs_LookupConfig(BENCH_TTC_DEVICE_ID);
+	if (ConfigPtr == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XTtcPs_CfgInitialize(TtcPtr, ConfigPtr, ConfigPtr->BaseAddress);
+	if (Status == (s32)XST_DEVICE_IS_STARTED) {
+		XTtcPs_Stop(TtcPtr);
+		Status = XTtcPs_CfgInitialize(TtcPtr, ConfigPtr,
+					      ConfigPtr->BaseAddress);
+	}
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	(void)XTtcPs_SetOptions(TtcPtr, XTTCPS_OPTION_INTERVAL_MODE |
+				XTTCPS_OPTION_WAVE_DISABLE);
+	XTtcPs_CalcIntervalFromFreq(TtcPtr, BENCH_TTC_FREQ_HZ, &Interval,
+				    &Prescaler);
+	if (Prescaler == 0xFFU) {
+		return XST_FAILURE;
+	}
+	XTtcPs_SetInterval(TtcPtr, Interval);
+	XTtcPs_SetPrescaler(TtcPtr, Prescaler);
+	if (Prescaler == XTTCPS_CLK_CNTRL_PS_DISABLE) {
+		TtcCountHz = ConfigPtr->InputClockHz;
+	} else {
+		TtcCountHz = ConfigPtr->InputClockHz >> (Prescaler + 1U);
+	}
+
+	XTtcPs_ClearInterruptStatus(TtcPtr,
+				    XTtcPs_GetInterruptStatus(TtcPtr));
+	XTtcPs_EnableInterrupts(TtcPtr, XTTCPS_IXR_INTERVAL_MASK);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Convert a number of TTC counter ticks to nanoseconds.
+*
+* @param	Ticks is the number of ticks.
+*
+* @return	Nanoseconds.
+*
+******************************************************************************/
+u32 Bench_TtcTicksToNs(u32 Ticks)
+{
+	return (u32)(((u64)Ticks * 1000000000U) / TtcCountHz);
+}
+
+/*****************************************************************************/
+/**
+* Clear the results of a test.
+*
+* @param	StatsPtr is the test results.
+* @param	Name is the test name printed in the report.
+*
+* @return	None.
+*
+******************************************************************************/
+void Bench_StatsInit(BenchStats *StatsPtr, const char *Name)
+{
+	u32 Bin;
+
+	StatsPtr->Name = Name;
+	StatsPtr->Samples = 0U;
+	StatsPtr->MinNs = 0xFFFFFFFFU;
+	StatsPtr->MaxNs = 0U;
+	StatsPtr->SumNs = 0U;
+	StatsPtr->Overflows = 0U;
+	for (Bin = 0U; Bin < BENCH_HIST_BINS; Bin++) {
+		StatsPtr->Hist[Bin] = 0U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* Add a sample to the results of a test.
+*
+* @param	StatsPtr is the test results.
+* @param	Ns is the measured time in nanoseconds.
+*
+* @return	None.
+*
+******************************************************************************/
+void Bench_StatsAdd(BenchStats *StatsPtr, u32 Ns)
+{
+	u32 Bin;
+
+	StatsPtr->Samples++;
+	StatsPtr->SumNs += Ns;
+	if (Ns < StatsPtr->MinNs) {
+		StatsPtr->MinNs = Ns;
+	}
+	if (Ns > StatsPtr->MaxNs) {
+		StatsPtr->MaxNs = Ns;
+	}
+	Bin = Ns / BENCH_HIST_BIN_NS;
+	if (Bin < BENCH_HIST_BINS) {
+		StatsPtr->Hist[Bin]++;
+	} else {
+		StatsPtr->Overflows++;
+	}
+}
+
+/*****************************************************************************/
+/**
+* Upper bound of the bin holding a given fraction of the samples.
+*
+* @param	StatsPtr is the test results.
+* @param	Permille is the fraction of the samples, in 1/1000.
+*
+* @return	Nanoseconds, the maximum when the bin is the overflow.
+*
+******************************************************************************/
+static u32 Bench_Percentile(const BenchStats *StatsPtr, u32 Permille)
+{
+	u32 Target;
+	u32 Count = 0U;
+	u32 Bin;
+
+	Target = (u32)(((u64)StatsPtr->Samples * Permille + 999U) / 1000U);
+	for (Bin = 0U; Bin < BENCH_HIST_BINS; Bin++) {
+		Count += StatsPtr->Hist[Bin];
+		if (Count >= Target) {
+			return (Bin + 1U) * BENCH_HIST_BIN_NS;
+		}
+	}
+	return StatsPtr->MaxNs;
+}
+
+/*****************************************************************************/
+/**
+* Print the report header: format version, processor, OS and time bases.
+*
+* @param	Os is the name of the OS the benchmark runs on.
+*
+* @return	None.
+*
+******************************************************************************/
+void Bench_ReportHeader(const char *Os)
+{
+#if defined (ARMR5)
+	const char *Cpu = "cortexr5";
+#elif defined (versal)
+	const char *Cpu = "cortexa72";
+#elif defined (__aarch64__) || defined (ARMA53_32)
+	const char *Cpu = "cortexa53";
+#else
+	const char *Cpu = "cortexa9";
+#endif
+
+	xil_printf("#version,%d\r\n", BENCH_REPORT_VERSION);
+	xil_printf("#config,%s,%s,cpu_hz=%d,ttc_hz=%d,samples=%d,bin_ns=%d\r\n",
+		   Cpu, Os, BENCH_CPU_FREQ_HZ, TtcCountHz, BENCH_SAMPLES,
+		   BENCH_HIST_BIN_NS);
+	xil_printf("#columns,test,samples,min_ns,avg_ns,p50_ns,p99_ns,max_ns,"
+		   "overflows\r\n");
+}
+
+/*****************************************************************************/
+/**
+* Print the results of a test: one summary line, then one line per non empty
+* histogram bin.
+*
+* @param	StatsPtr is the test results.
+*
+* @return	None.
+*
+******************************************************************************/
+void Bench_Report(const BenchStats *StatsPtr)
+{
+	u32 Avg = 0U;
+	u32 Bin;
+
+	if (StatsPtr->Samples == 0U) {
+		xil_printf("%s,0\r\n", StatsPtr->Name);
+		return;
+	}
+	Avg = (u32)(StatsPtr->SumNs / StatsPtr->Samples);
+	xil_printf("%s,%d,%d,%d,%d,%d,%d,%d\r\n", StatsPtr->Name,
+		   StatsPtr->Samples, StatsPtr->MinNs, Avg,
+		   Bench_Percentile(StatsPtr, 500U),
+		   Bench_Percentile(StatsPtr, 990U), StatsPtr->MaxNs,
+		   StatsPtr->Overflows);
+	for (Bin = 0U; Bin < BENCH_HIST_BINS; Bin++) {
+		if (StatsPtr->Hist[Bin] != 0U) {
+			xil_printf("#hist,%s,%d,%d\r\n", StatsPtr->Name,
+				   Bin * BENCH_HIST_BIN_NS,
+				   StatsPtr->Hist[Bin]);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+* Write back and invalidate the data caches and invalidate the instruction
+* cache, so that the next sample runs from memory.
+*
+* @return	None.
+*
+******************************************************************************/
+void Bench_CachesCold(void)
+{
+	Xil_DCacheFlush();
+	Xil_ICacheInvalidate();
+}
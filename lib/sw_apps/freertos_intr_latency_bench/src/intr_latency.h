@@ -0,0 +1,123 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file intr_latency.h
+*
+* Measurement and report helpers of the interrupt latency benchmark.
+*
+* Latencies are measured with a TTC counter in interval mode. The counter
+* restarts from 0 when it raises the interval interrupt, so its value read by
+* the handler is the time elapsed since the interrupt was signalled. Times
+* between two points of code executed on the same core are measured with the
+* PMU cycle counter.
+*
+* Every test fills a histogram of BENCH_HIST_BINS bins of BENCH_HIST_BIN_NS
+* nanoseconds. The report is plain comma separated text so that the results
+* of two releases can be compared with a diff or a script.
+*
+******************************************************************************/
+#ifndef INTR_LATENCY_H
+#define INTR_LATENCY_H
+
+#include "xil_types.h"
+#include "xparameters.h"
+#include "xttcps.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Version of the report format, bumped when a field changes */
+#define BENCH_REPORT_VERSION	1
+
+/* Samples per test */
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES		10000U
+#endif
+
+/* Histogram of latencies */
+#ifndef BENCH_HIST_BIN_NS
+#define BENCH_HIST_BIN_NS	50U
+#endif
+#ifndef BENCH_HIST_BINS
+#define BENCH_HIST_BINS		64U
+#endif
+
+/*
+ * TTC counter used to raise the interrupts. FreeRTOS uses the counters of
+ * TTC 0 for its tick, so the first counter of TTC 1 is used by default.
+ */
+#ifndef BENCH_TTC_DEVICE_ID
+#define BENCH_TTC_DEVICE_ID	XPAR_XTTCPS_3_DEVICE_ID
+#define BENCH_TTC_INTR_ID	XPAR_XTTCPS_3_INTR
+#endif
+
+/* Rate of the TTC interval interrupt, also the upper bound of a latency */
+#ifndef BENCH_TTC_FREQ_HZ
+#define BENCH_TTC_FREQ_HZ	10000U
+#endif
+
+/* Frequency of the PMU cycle counter */
+#if defined (ARMR5)
+#define BENCH_CPU_FREQ_HZ	XPAR_CPU_CORTEXR5_0_CPU_CLK_FREQ_HZ
+#elif defined (versal)
+#define BENCH_CPU_FREQ_HZ	XPAR_CPU_CORTEXA72_0_CPU_CLK_FREQ_HZ
+#elif defined (__aarch64__) || defined (ARMA53_32)
+#define BENCH_CPU_FREQ_HZ	XPAR_CPU_CORTEXA53_0_CPU_CLK_FREQ_HZ
+#else
+#define BENCH_CPU_FREQ_HZ	XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/* Results of a test, all the times are in nanoseconds */
+typedef struct {
+	const char *Name;
+	u32 Samples;
+	u32 MinNs;
+	u32 MaxNs;
+	u64 SumNs;
+	u32 Overflows;		/* Samples beyond the last bin */
+	u32 Hist[BENCH_HIST_BINS];
+} BenchStats;
+
+/************************** Function Prototypes ******************************/
+
+void Bench_CycleCounterInit(void);
+u32 Bench_CycleCounterRead(void);
+u32 Bench_CyclesToNs(u32 Cycles);
+
+s32 Bench_TtcInit(XTtcPs *TtcPtr);
+u32 Bench_TtcTicksToNs(u32 Ticks);
+
+void Bench_StatsInit(BenchStats *StatsPtr, const char *Name);
+void Bench_StatsAdd(BenchStats *StatsPtr, u32 Ns);
+void Bench_ReportHeader(const char *Os);
+void Bench_Report(const BenchStats *StatsPtr);
+
+void Bench_CachesCold(void);
+
+#endif
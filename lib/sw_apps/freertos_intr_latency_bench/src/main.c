@@ -0,0 +1,223 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file main.c
+*
+* Interrupt latency benchmark for freertos10_xilinx.
+*
+* A TTC counter in interval mode raises the interrupts, and the counter value
+* read by the handler and by the task it wakes up gives the time elapsed since
+* the interrupt, see intr_latency.h. The tests are:
+*
+*   irq_entry		Interrupt to handler, through the port IRQ handler.
+*   irq_to_task		Interrupt to the task woken up by the handler.
+*   irq_entry_cold	As irq_entry, caches written back and invalidated
+*			before each sample.
+*   irq_to_task_cold	As irq_to_task, with cold caches.
+*   ctx_switch		xTaskNotifyGive() in a task to the return from
+*			ulTaskNotifyTake() in the higher priority task it
+*			unblocks.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xparameters.h"
+#include "xil_printf.h"
+#include "xttcps.h"
+#include "intr_latency.h"
+
+/************************** Constant Definitions *****************************/
+
+#define BENCH_TASK_PRIORITY	( configMAX_PRIORITIES - 1 )
+#define BENCH_TASK_STACK	( configMINIMAL_STACK_SIZE * 4 )
+
+/************************** Function Prototypes ******************************/
+
+static void prvTtcHandler( void *pvCallBackRef );
+static void prvRunIrq( uint32_t ulCold );
+static void prvGiveTask( void *pvParameters );
+static void prvRunContextSwitch( void );
+static void prvBenchTask( void *pvParameters );
+
+/************************** Variable Definitions *****************************/
+
+static XTtcPs xTtc;
+static TaskHandle_t xBenchTask;
+
+static volatile uint32_t ulHandlerTicks;
+static volatile uint32_t ulGiveCycles;
+
+static BenchStats xEntryStats;
+static BenchStats xTaskStats;
+/*-----------------------------------------------------------*/
+
+/* TTC interval interrupt handler, the counter is read before anything else.
+The counter is left running, the woken task reads it again and stops it. */
+static void prvTtcHandler( void *pvCallBackRef )
+{
+XTtcPs *pxTtc = ( XTtcPs * ) pvCallBackRef;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+uint32_t ulTicks;
+
+	ulTicks = XTtcPs_GetCounterValue( pxTtc );
+	XTtcPs_ClearInterruptStatus( pxTtc, XTtcPs_GetInterruptStatus( pxTtc ) );
+	ulHandlerTicks = ulTicks;
+
+	vTaskNotifyGiveFromISR( xBenchTask, &xHigherPriorityTaskWoken );
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+/* Interrupt to handler and interrupt to task latencies.  The task latency is
+only valid while it is below the TTC interval, as the counter wraps again. */
+static void prvRunIrq( uint32_t ulCold )
+{
+uint32_t ulSample;
+uint32_t ulTicks;
+
+	for( ulSample = 0; ulSample < BENCH_SAMPLES; ulSample++ )
+	{
+		if( ulCold != 0U )
+		{
+			Bench_CachesCold();
+		}
+		XTtcPs_ResetCounterValue( &xTtc );
+		XTtcPs_Start( &xTtc );
+
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		ulTicks = XTtcPs_GetCounterValue( &xTtc );
+		XTtcPs_Stop( &xTtc );
+
+		Bench_StatsAdd( &xEntryStats, Bench_TtcTicksToNs( ulHandlerTicks ) );
+		Bench_StatsAdd( &xTaskStats, Bench_TtcTicksToNs( ulTicks ) );
+	}
+
+	Bench_Report( &xEntryStats );
+	Bench_Report( &xTaskStats );
+}
+/*-----------------------------------------------------------*/
+
+/* Lower priority side of the context switch test, it only runs while the
+benchmark task is blocked. */
+static void prvGiveTask( void *pvParameters )
+{
+uint32_t ulSample;
+
+	( void ) pvParameters;
+
+	for( ulSample = 0; ulSample < BENCH_SAMPLES; ulSample++ )
+	{
+		ulGiveCycles = Bench_CycleCounterRead();
+		xTaskNotifyGive( xBenchTask );
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunContextSwitch( void )
+{
+uint32_t ulSample;
+uint32_t ulCycles;
+
+	if( xTaskCreate( prvGiveTask, ( const char * ) "Give", BENCH_TASK_STACK,
+					 NULL, BENCH_TASK_PRIORITY - 1, NULL ) != pdPASS )
+	{
+		xil_printf( "ERROR: failed to create the context switch task\r\n" );
+		return;
+	}
+
+	for( ulSample = 0; ulSample < BENCH_SAMPLES; ulSample++ )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		ulCycles = Bench_CycleCounterRead() - ulGiveCycles;
+		Bench_StatsAdd( &xTaskStats, Bench_CyclesToNs( ulCycles ) );
+	}
+
+	Bench_Report( &xTaskStats );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	Bench_CycleCounterInit();
+	Bench_ReportHeader( "freertos" );
+
+	Bench_StatsInit( &xEntryStats, "irq_entry" );
+	Bench_StatsInit( &xTaskStats, "irq_to_task" );
+	prvRunIrq( 0U );
+
+	Bench_StatsInit( &xEntryStats, "irq_entry_cold" );
+	Bench_StatsInit( &xTaskStats, "irq_to_task_cold" );
+	prvRunIrq( 1U );
+
+	Bench_StatsInit( &xTaskStats, "ctx_switch" );
+	prvRunContextSwitch();
+
+	xil_printf( "#done\r\n" );
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xil_printf( "FreeRTOS interrupt latency benchmark\r\n" );
+
+	if( Bench_TtcInit( &xTtc ) != XST_SUCCESS )
+	{
+		xil_printf( "ERROR: TTC %d initialization failed\r\n", BENCH_TTC_DEVICE_ID );
+		return XST_FAILURE;
+	}
+
+	/* The default GIC priority of the interrupt is below
+	configMAX_API_CALL_INTERRUPT_PRIORITY, so the handler can use the FreeRTOS
+	API. */
+	if( xPortInstallInterruptHandler( BENCH_TTC_INTR_ID, prvTtcHandler, &xTtc ) != pdPASS )
+	{
+		xil_printf( "ERROR: interrupt setup failed\r\n" );
+		return XST_FAILURE;
+	}
+	vPortEnableInterrupt( BENCH_TTC_INTR_ID );
+
+	xTaskCreate( prvBenchTask, ( const char * ) "Bench", BENCH_TASK_STACK,
+				 NULL, BENCH_TASK_PRIORITY, &xBenchTask );
+
+	vTaskStartScheduler();
+
+	/* The scheduler only returns when there is not enough heap for the idle
+	and timer tasks. */
+	for( ;; );
+}
@@ -0,0 +1,97 @@
+#/******************************************************************************
+#*
+#* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+#*
+#* Permission is hereby granted, free of charge, to any person obtaining a copy
+#* of this software and associated documentation files (the "Software"), to deal
+#* in the Software without restriction, including without limitation the rights
+#* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#* copies of the Software, and to permit persons to whom the Software is
+#* furnished to do so, subject to the following conditions:
+#*
+#* The above copyright notice and this permission notice shall be included in
+#* all copies or substantial portions of the Software.
+#*
+#* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#* THE SOFTWARE.
+#*
+#*
+#*
+#******************************************************************************/
+
+proc swapp_get_name {} {
+    return "Interrupt Latency Benchmark";
+}
+
+proc swapp_get_description {} {
+    return "The Interrupt Latency Benchmark measures the latency from a TTC interrupt to the entry of its handler and back to the interrupted code, with warm, cold and disabled caches and with the WFI wake up. The results are printed on the serial console as histograms in a text format which can be compared between releases."
+}
+
+proc check_standalone_os {} {
+    set oslist [hsi::get_os];
+
+    if { [llength $oslist] != 1 } {
+        return 0;
+    }
+    set os [lindex $oslist 0];
+
+    if { $os != "standalone" } {
+        error "This application is supported only on the Standalone Board Support Package.";
+    }
+}
+
+proc check_ttc_hw {} {
+    set ttcs [hsi::get_cells -hier -filter {IP_NAME == "ps7_ttc" || IP_NAME == "psu_ttc" || IP_NAME == "psv_ttc"}];
+    if { [llength $ttcs] < 2 } {
+        error "This application requires the second TTC of the processing system.";
+    }
+}
+
+proc swapp_is_supported_sw {} {
+    check_standalone_os;
+
+    return 1;
+}
+
+proc swapp_is_supported_hw {} {
+    set proc_instance [hsi::get_sw_processor];
+    set hw_processor [common::get_property HW_INSTANCE $proc_instance]
+    set proc_type [common::get_property IP_NAME [hsi::get_cells -hier $hw_processor]];
+
+    if { $proc_type != "psu_cortexr5" && $proc_type != "psv_cortexr5" && $proc_type != "ps7_cortexa9" && $proc_type != "psu_cortexa53" && $proc_type != "psv_cortexa72" } {
+        error "This application is supported only for CortexR5/CortexA9/CortexA53/CortexA72 processors.";
+    }
+
+    check_ttc_hw;
+
+    return 1;
+}
+
+proc get_stdout {} {
+    return;
+}
+
+proc check_stdout_hw {} {
+    return;
+}
+
+proc swapp_generate {} {
+    return;
+}
+
+proc swapp_get_linker_constraints {} {
+    return "";
+}
+
+proc swapp_get_supported_processors {} {
+    return "psu_cortexr5 psv_cortexr5 ps7_cortexa9 psu_cortexa53 psv_cortexa72";
+}
+
+proc swapp_get_supported_os {} {
+    return "standalone";
+}
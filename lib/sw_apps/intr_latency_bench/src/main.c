@@ -0,0 +1,237 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file main.c
+*
+* Interrupt latency benchmark for the standalone BSP.
+*
+* A TTC counter is started for each sample and raises its interval interrupt
+* BENCH_TTC_FREQ_HZ later. The handler reads the counter first, which gives
+* the time from the interrupt to the handler entry, then stamps the PMU cycle
+* counter, which the main loop uses to get the time from the handler exit to
+* the interrupted code. The tests are:
+*
+*   irq_entry		Caches enabled and warm, the CPU spins on a flag.
+*   irq_exit		Handler exit to the spinning loop, same run.
+*   irq_entry_fast	As irq_entry, through XScuGic_FastInterruptHandler().
+*   irq_entry_wfi	The CPU waits for the interrupt in WFI.
+*   irq_entry_cold	Caches written back and invalidated before each sample.
+*   irq_entry_nocache	Instruction and data caches disabled.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_cache.h"
+#include "xil_exception.h"
+#include "xil_printf.h"
+#include "xscugic.h"
+#include "xttcps.h"
+#include "intr_latency.h"
+
+/************************** Constant Definitions *****************************/
+
+#define INTC_DEVICE_ID		XPAR_SCUGIC_SINGLE_DEVICE_ID
+
+/* How a test waits for the interrupt and prepares each sample */
+#define WAIT_SPIN		0U
+#define WAIT_WFI		1U
+#define WAIT_COLD		2U
+
+/************************** Function Prototypes ******************************/
+
+static void Bench_TtcHandler(void *CallBackRef);
+static void Bench_Run(BenchStats *EntryPtr, BenchStats *ExitPtr, u32 Wait);
+static s32 Bench_SetupIntr(void);
+
+/************************** Variable Definitions *****************************/
+
+static XScuGic Gic;
+static XTtcPs Ttc;
+
+static volatile u32 SampleDone;
+static volatile u32 SampleTicks;
+static volatile u32 SampleExitCycles;
+
+static BenchStats EntryStats;
+static BenchStats ExitStats;
+
+/*****************************************************************************/
+/**
+* TTC interval interrupt handler. The counter is read before anything else.
+*
+* @param	CallBackRef is the TTC instance.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Bench_TtcHandler(void *CallBackRef)
+{
+	XTtcPs *TtcPtr = (XTtcPs *)CallBackRef;
+	u32 Ticks;
+
+	Ticks = XTtcPs_GetCounterValue(TtcPtr);
+	XTtcPs_Stop(TtcPtr);
+	XTtcPs_ClearInterruptStatus(TtcPtr, XTtcPs_GetInterruptStatus(TtcPtr));
+
+	SampleTicks = Ticks;
+	SampleDone = 1U;
+	SampleExitCycles = Bench_CycleCounterRead();
+}
+
+/*****************************************************************************/
+/**
+* Run a test of BENCH_SAMPLES samples and print its report.
+*
+* @param	EntryPtr gets the interrupt to handler entry latencies.
+* @param	ExitPtr gets the handler exit to interrupted code latencies,
+*		only measured with WAIT_SPIN, or NULL.
+* @param	Wait is WAIT_SPIN, WAIT_WFI or WAIT_COLD.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Bench_Run(BenchStats *EntryPtr, BenchStats *ExitPtr, u32 Wait)
+{
+	u32 Sample;
+	u32 Cycles;
+
+	for (Sample = 0U; Sample < BENCH_SAMPLES; Sample++) {
+		if (Wait == WAIT_COLD) {
+			Bench_CachesCold();
+		}
+		SampleDone = 0U;
+		XTtcPs_ResetCounterValue(&Ttc);
+		XTtcPs_Start(&Ttc);
+		if (Wait == WAIT_WFI) {
+			while (SampleDone == 0U) {
+				__asm__ __volatile__ ("wfi");
+			}
+		} else {
+			while (SampleDone == 0U) {
+				;
+			}
+		}
+		Cycles = Bench_CycleCounterRead();
+
+		Bench_StatsAdd(EntryPtr, Bench_TtcTicksToNs(SampleTicks));
+		if (ExitPtr != NULL) {
+			Bench_StatsAdd(ExitPtr,
+				Bench_CyclesToNs(Cycles - SampleExitCycles));
+		}
+	}
+
+	Bench_Report(EntryPtr);
+	if (ExitPtr != NULL) {
+		Bench_Report(ExitPtr);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Set up the GIC and connect the TTC interrupt.
+*
+* @return	XST_SUCCESS or XST_FAILURE.
+*
+******************************************************************************/
+static s32 Bench_SetupIntr(void)
+{
+	XScuGic_Config *ConfigPtr;
+	s32 Status;
+
+	ConfigPtr = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (ConfigPtr == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(&Gic, ConfigPtr,
+				       ConfigPtr->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Xil_ExceptionInit();
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler, &Gic);
+
+	Status = XScuGic_Connect(&Gic, BENCH_TTC_INTR_ID,
+				 (Xil_InterruptHandler)Bench_TtcHandler, &Ttc);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XScuGic_Enable(&Gic, BENCH_TTC_INTR_ID);
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
+
+int main(void)
+{
+	xil_printf("Interrupt latency benchmark\r\n");
+
+	if (Bench_TtcInit(&Ttc) != XST_SUCCESS) {
+		xil_printf("ERROR: TTC %d initialization failed\r\n",
+			   BENCH_TTC_DEVICE_ID);
+		return XST_FAILURE;
+	}
+	if (Bench_SetupIntr() != XST_SUCCESS) {
+		xil_printf("ERROR: interrupt setup failed\r\n");
+		return XST_FAILURE;
+	}
+	Bench_CycleCounterInit();
+
+	Bench_ReportHeader("standalone");
+
+	Bench_StatsInit(&EntryStats, "irq_entry");
+	Bench_StatsInit(&ExitStats, "irq_exit");
+	Bench_Run(&EntryStats, &ExitStats, WAIT_SPIN);
+
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XScuGic_FastInterruptHandler, &Gic);
+	Bench_StatsInit(&EntryStats, "irq_entry_fast");
+	Bench_Run(&EntryStats, NULL, WAIT_SPIN);
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler, &Gic);
+
+	Bench_StatsInit(&EntryStats, "irq_entry_wfi");
+	Bench_Run(&EntryStats, NULL, WAIT_WFI);
+
+	Bench_StatsInit(&EntryStats, "irq_entry_cold");
+	Bench_Run(&EntryStats, NULL, WAIT_COLD);
+
+	Xil_DCacheDisable();
+	Xil_ICacheDisable();
+	Bench_StatsInit(&EntryStats, "irq_entry_nocache");
+	Bench_Run(&EntryStats, NULL, WAIT_SPIN);
+	Xil_ICacheEnable();
+	Xil_DCacheEnable();
+
+	xil_printf("#done\r\n");
+
+	return XST_SUCCESS;
+}
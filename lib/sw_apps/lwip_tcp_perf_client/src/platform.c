@@ -176,4 +176,10 @@ u64_t get_time_ms()
 	return tickcntr * 10;
 }
 
+/* The timer ticks every 10 ms, the result has no better resolution */
+u64_t get_time_us()
+{
+	return tickcntr * 10000;
+}
+
 #endif
@@ -37,4 +37,5 @@ void timer_callback();
 void platform_setup_timer();
 void platform_enable_interrupts();
 u64_t get_time_ms();
+u64_t get_time_us();
 #endif
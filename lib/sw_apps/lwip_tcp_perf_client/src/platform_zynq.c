@@ -229,5 +229,13 @@ u64_t get_time_ms()
 	return (tCur/COUNTS_PER_MILLI_SECOND);
 }
 
+u64_t get_time_us()
+{
+	XTime tCur = 0;
+	XTime_GetTime(&tCur);
+	return ((tCur / COUNTS_PER_SECOND) * 1000000U +
+		((tCur % COUNTS_PER_SECOND) * 1000000U) / COUNTS_PER_SECOND);
+}
+
 #endif
 #endif
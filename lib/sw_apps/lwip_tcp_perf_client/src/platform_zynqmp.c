@@ -204,5 +204,26 @@ u64_t get_time_ms()
 #endif
 }
 
+u64_t get_time_us()
+{
+#if defined(ARMR5)
+	XTime tCur = 0;
+	static XTime tlast = 0, tHigh = 0;
+	u64_t time;
+	XTime_GetTime(&tCur);
+	if (tCur < tlast)
+		tHigh++;
+	tlast = tCur;
+	time = (((u64_t) tHigh) << 32U) | (u64_t)tCur;
+	return ((time / COUNTS_PER_SECOND) * 1000000U +
+		((time % COUNTS_PER_SECOND) * 1000000U) / COUNTS_PER_SECOND);
+#else
+	XTime tCur = 0;
+	XTime_GetTime(&tCur);
+	return ((tCur / COUNTS_PER_SECOND) * 1000000U +
+		((tCur % COUNTS_PER_SECOND) * 1000000U) / COUNTS_PER_SECOND);
+#endif
+}
+
 #endif
 #endif
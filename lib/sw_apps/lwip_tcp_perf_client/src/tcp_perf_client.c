@@ -30,9 +30,13 @@
 
 #include "tcp_perf_client.h"
 
-static struct tcp_pcb *c_pcb;
+extern struct netif server_netif;
+static struct tcp_pcb *c_pcb[TCP_NUM_OF_STREAMS];
+static u8_t connected_streams;
 static char send_buf[TCP_SEND_BUFSIZE];
 static struct perf_stats client;
+/* Time in ms to count the main loop polls of an idle CPU */
+#define IDLE_CALIBRATION_TIME 100
 
 void print_app_header()
 {
@@ -47,23 +51,33 @@ void print_app_header()
 	xil_printf("On Host: Run $iperf -s -i %d -w 2M\r\n",
 			INTERIM_REPORT_INTERVAL);
 #endif /* LWIP_IPV6 */
+	xil_printf("%d streams of %d bytes writes", TCP_NUM_OF_STREAMS,
+			TCP_SEND_BUFSIZE);
+#if TCP_TARGET_BANDWIDTH
+	xil_printf(" at %d Kbits/sec each", TCP_TARGET_BANDWIDTH / 1000);
+#endif
+	xil_printf("\r\n");
 }
 
 static void print_tcp_conn_stats()
 {
+	u8_t i;
+
+	for (i = 0; i < TCP_NUM_OF_STREAMS; i++) {
 #if LWIP_IPv6==1
-	xil_printf("[%3d] local %s port %d connected with ",
-			client.client_id, inet6_ntoa(c_pcb->local_ip),
-			c_pcb->local_port);
-	xil_printf("%s port %d\r\n",inet6_ntoa(c_pcb->remote_ip),
-			c_pcb->remote_port);
+		xil_printf("[%3d] local %s port %d connected with ",
+				client.client_id, inet6_ntoa(c_pcb[i]->local_ip),
+				c_pcb[i]->local_port);
+		xil_printf("%s port %d\r\n",inet6_ntoa(c_pcb[i]->remote_ip),
+				c_pcb[i]->remote_port);
 #else
-	xil_printf("[%3d] local %s port %d connected with ",
-			client.client_id, inet_ntoa(c_pcb->local_ip),
-			c_pcb->local_port);
-	xil_printf("%s port %d\r\n",inet_ntoa(c_pcb->remote_ip),
-			c_pcb->remote_port);
+		xil_printf("[%3d] local %s port %d connected with ",
+				client.client_id, inet_ntoa(c_pcb[i]->local_ip),
+				c_pcb[i]->local_port);
+		xil_printf("%s port %d\r\n",inet_ntoa(c_pcb[i]->remote_ip),
+				c_pcb[i]->remote_port);
 #endif /* LWIP_IPV6 */
+	}
 
 	xil_printf("[ ID] Interval\t\tTransfer   Bandwidth\n\r");
 }
@@ -94,6 +108,15 @@ static void stats_buffer(char* outString,
 	sprintf(outString, format, data, kLabel[conv]);
 }
 
+/* Share of the main loop polls which found something to send, in % */
+static u32_t cpu_load(u64_t diff_ms)
+{
+	u64_t idle_max = (u64_t)client.idle_polls_per_ms * diff_ms;
+
+	if (idle_max == 0 || client.idle_polls >= idle_max)
+		return (idle_max == 0) ? 100 : 0;
+	return (u32_t)(100 - (client.idle_polls * 100) / idle_max);
+}
 
 /** The report function of a TCP client session */
 static void tcp_conn_report(u64_t diff,
@@ -102,6 +125,7 @@ static void tcp_conn_report(u64_t diff,
 	u64_t total_len;
 	double duration, bandwidth = 0;
 	char data[16], perf[16], time[64];
+	u8_t i;
 
 	if (report_type == INTER_REPORT) {
 		total_len = client.i_report.total_bytes;
@@ -126,11 +150,36 @@ static void tcp_conn_report(u64_t diff,
 	sprintf(time, "%4.1f-%4.1f sec",
 			(double)client.i_report.last_report_time,
 			(double)(client.i_report.last_report_time + duration));
-	xil_printf("[%3d] %s  %sBytes  %sbits/sec\n\r", client.client_id,
+	xil_printf("[%3d] %s  %sBytes  %sbits/sec", client.client_id,
 			time, data, perf);
+	if (report_type == INTER_REPORT) {
+		xil_printf("  cpu %d%%", cpu_load(diff));
+		client.idle_polls = 0;
+	}
+	xil_printf("\n\r");
 
-	if (report_type == INTER_REPORT)
+	if (report_type == INTER_REPORT) {
 		client.i_report.last_report_time += duration;
+	} else if (TCP_NUM_OF_STREAMS > 1) {
+		for (i = 0; i < TCP_NUM_OF_STREAMS; i++) {
+			bandwidth = 0;
+			if (duration)
+				bandwidth = (client.stream_bytes[i] / duration)
+						* 8.0;
+			stats_buffer(data, client.stream_bytes[i], BYTES);
+			stats_buffer(perf, bandwidth, SPEED);
+			xil_printf("[%3d] stream %d  %sBytes  %sbits/sec\n\r",
+					client.client_id, i, data, perf);
+		}
+	}
+
+#if XLWIP_CONFIG_NETIF_STATS
+	/* netif counters of the finished test, cleared for the next one */
+	if (report_type != INTER_REPORT) {
+		xemacif_print_stats(&server_netif);
+		xemacif_clear_stats(&server_netif);
+	}
+#endif
 }
 
 /** Close a tcp session */
@@ -149,6 +198,18 @@ static void tcp_client_close(struct tcp_pcb *pcb)
 	}
 }
 
+/** Close all the streams of the test */
+static void tcp_client_close_all(void)
+{
+	u8_t i;
+
+	for (i = 0; i < TCP_NUM_OF_STREAMS; i++) {
+		tcp_client_close(c_pcb[i]);
+		c_pcb[i] = NULL;
+	}
+	connected_streams = 0;
+}
+
 /** Error callback, tcp session aborted */
 static void tcp_client_err(void *arg, err_t err)
 {
@@ -156,37 +217,44 @@ static void tcp_client_err(void *arg, err_t err)
 	u64_t now = get_time_ms();
 	u64_t diff_ms = now - client.start_time;
 
-	tcp_client_close(c_pcb);
-	c_pcb = NULL;
+	/* lwIP already freed the pcb of this stream */
+	c_pcb[(UINTPTR)arg] = NULL;
+	tcp_client_close_all();
 	tcp_conn_report(diff_ms, TCP_ABORTED_REMOTE);
 	xil_printf("TCP connection aborted\n\r");
 }
 
-static err_t tcp_send_perf_traffic(void)
+#if TCP_TARGET_BANDWIDTH
+/** Bytes a stream may have written by now to keep its pace */
+static u64_t tcp_pacing_budget(u64_t now_us)
 {
-	err_t err;
-	u8_t apiflags = TCP_WRITE_FLAG_COPY | TCP_WRITE_FLAG_MORE;
-
-	if (c_pcb == NULL) {
-		return ERR_CONN;
-	}
+	return ((now_us - client.start_time_us) * TCP_TARGET_BANDWIDTH)
+			/ 8000000 + TCP_PACING_BURST * TCP_SEND_BUFSIZE;
+}
+#endif
 
-#ifdef __MICROBLAZE__
-	/* Zero-copy pbufs is used to get maximum performance for Microblaze.
-	 * For Zynq A9, ZynqMP A53 and R5 zero-copy pbufs does not give
-	 * significant improvement hense not used. */
-	apiflags = 0;
+/** Fill the send buffer of a stream */
+static err_t tcp_stream_send(u8_t i, u8_t apiflags)
+{
+	struct tcp_pcb *pcb = c_pcb[i];
+	err_t err;
+#if TCP_TARGET_BANDWIDTH
+	u64_t budget = tcp_pacing_budget(get_time_us());
 #endif
 
-	while (tcp_sndbuf(c_pcb) > TCP_SEND_BUFSIZE) {
-		err = tcp_write(c_pcb, send_buf, TCP_SEND_BUFSIZE, apiflags);
+	while (tcp_sndbuf(pcb) > TCP_SEND_BUFSIZE) {
+#if TCP_TARGET_BANDWIDTH
+		if (client.stream_bytes[i] >= budget)
+			break;
+#endif
+		err = tcp_write(pcb, send_buf, TCP_SEND_BUFSIZE, apiflags);
 		if (err != ERR_OK) {
 			xil_printf("TCP client: Error on tcp_write: %d\r\n",
 					err);
 			return err;
 		}
 
-		err = tcp_output(c_pcb);
+		err = tcp_output(pcb);
 		if (err != ERR_OK) {
 			xil_printf("TCP client: Error on tcp_output: %d\r\n",
 					err);
@@ -194,6 +262,33 @@ static err_t tcp_send_perf_traffic(void)
 		}
 		client.total_bytes += TCP_SEND_BUFSIZE;
 		client.i_report.total_bytes += TCP_SEND_BUFSIZE;
+		client.stream_bytes[i] += TCP_SEND_BUFSIZE;
+	}
+	return ERR_OK;
+}
+
+static err_t tcp_send_perf_traffic(void)
+{
+	err_t err;
+	u8_t apiflags = TCP_WRITE_FLAG_COPY | TCP_WRITE_FLAG_MORE;
+	u8_t i;
+
+	/* The test starts once all the streams are connected */
+	if (connected_streams < TCP_NUM_OF_STREAMS) {
+		return ERR_CONN;
+	}
+
+#ifdef __MICROBLAZE__
+	/* Zero-copy pbufs is used to get maximum performance for Microblaze.
+	 * For Zynq A9, ZynqMP A53 and R5 zero-copy pbufs does not give
+	 * significant improvement hense not used. */
+	apiflags = 0;
+#endif
+
+	for (i = 0; i < TCP_NUM_OF_STREAMS; i++) {
+		err = tcp_stream_send(i, apiflags);
+		if (err != ERR_OK)
+			return err;
 	}
 
 	if (client.end_time || client.i_report.report_interval_time) {
@@ -220,8 +315,7 @@ static err_t tcp_send_perf_traffic(void)
 				 * close the connection */
 				tcp_conn_report(diff_ms, TCP_DONE_CLIENT);
 				xil_printf("TCP test passed Successfully\n\r");
-				tcp_client_close(c_pcb);
-				c_pcb = NULL;
+				tcp_client_close_all();
 				return ERR_OK;
 			}
 		}
@@ -238,18 +332,31 @@ static err_t tcp_client_sent(void *arg, struct tcp_pcb *tpcb, u16_t len)
 /** TCP connected callback (active connection), send data now */
 static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
 {
+	u8_t i;
+
 	if (err != ERR_OK) {
 		tcp_client_close(tpcb);
 		xil_printf("Connection error\n\r");
 		return err;
 	}
 	/* store state */
-	c_pcb = tpcb;
+	c_pcb[(UINTPTR)arg] = tpcb;
+
+	/* set callback values & functions */
+	tcp_sent(tpcb, tcp_client_sent);
+	tcp_err(tpcb, tcp_client_err);
+
+	if (++connected_streams < TCP_NUM_OF_STREAMS)
+		return ERR_OK;
 
 	client.start_time = get_time_ms();
+	client.start_time_us = get_time_us();
 	client.end_time = TCP_TIME_INTERVAL * 1000; /* ms */
 	client.client_id++;
 	client.total_bytes = 0;
+	client.idle_polls = 0;
+	for (i = 0; i < TCP_NUM_OF_STREAMS; i++)
+		client.stream_bytes[i] = 0;
 
 	/* report interval time in ms */
 	client.i_report.report_interval_time = INTERIM_REPORT_INTERVAL * 1000;
@@ -259,19 +366,33 @@ static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
 
 	print_tcp_conn_stats();
 
-	/* set callback values & functions */
-	tcp_arg(c_pcb, NULL);
-	tcp_sent(c_pcb, tcp_client_sent);
-	tcp_err(c_pcb, tcp_client_err);
-
 	/* initiate data transfer */
 	return ERR_OK;
 }
 
 void transfer_data(void)
 {
-	if (client.client_id)
-		tcp_send_perf_traffic();
+	u64_t total_bytes = client.total_bytes;
+
+	if (connected_streams < TCP_NUM_OF_STREAMS)
+		return;
+	tcp_send_perf_traffic();
+	/* Nothing was written: waiting for ACKs or for the pacing */
+	if (client.total_bytes == total_bytes)
+		client.idle_polls++;
+}
+
+/* Count the main loop polls per ms when there is nothing to send */
+static void calibrate_idle(void)
+{
+	u64_t start = get_time_ms();
+	u32_t polls = 0;
+
+	while (get_time_ms() - start < IDLE_CALIBRATION_TIME) {
+		xemacif_input(&server_netif);
+		polls++;
+	}
+	client.idle_polls_per_ms = polls / IDLE_CALIBRATION_TIME;
 }
 
 void start_application(void)
@@ -293,21 +414,27 @@ void start_application(void)
 		return;
 	}
 
-	/* Create Client PCB */
-	pcb = tcp_new_ip_type(IPADDR_TYPE_ANY);
-	if (!pcb) {
-		xil_printf("Error in PCB creation. out of memory\r\n");
-		return;
-	}
+	calibrate_idle();
+	client.client_id = 0;
+	connected_streams = 0;
+
+	for (i = 0; i < TCP_NUM_OF_STREAMS; i++) {
+		/* Create Client PCB */
+		pcb = tcp_new_ip_type(IPADDR_TYPE_ANY);
+		if (!pcb) {
+			xil_printf("Error in PCB creation. out of memory\r\n");
+			return;
+		}
 
-	err = tcp_connect(pcb, &remote_addr, TCP_CONN_PORT,
-			tcp_client_connected);
-	if (err) {
-		xil_printf("Error on tcp_connect: %d\r\n", err);
-		tcp_client_close(pcb);
-		return;
+		tcp_arg(pcb, (void *)(UINTPTR)i);
+		err = tcp_connect(pcb, &remote_addr, TCP_CONN_PORT,
+				tcp_client_connected);
+		if (err) {
+			xil_printf("Error on tcp_connect: %d\r\n", err);
+			tcp_client_close(pcb);
+			return;
+		}
 	}
-	client.client_id = 0;
 
 	/* initialize data buffer being sent with same as used in iperf */
 	for (i = 0; i < TCP_SEND_BUFSIZE; i++)
@@ -30,13 +30,18 @@
 #define __TCP_PERF_CLIENT_H_
 
 #include "lwipopts.h"
+#include "xlwipconfig.h"
 #include "lwip/ip_addr.h"
 #include "lwip/err.h"
 #include "lwip/tcp.h"
 #include "lwip/inet.h"
+#include "netif/xadapter.h"
 #include "xil_printf.h"
 #include "platform.h"
 
+/* Number of parallel TCP streams, as iperf -P */
+#define TCP_NUM_OF_STREAMS 1
+
 /* used as indices into kLabel[] */
 enum {
 	KCONV_UNIT,
@@ -83,6 +88,11 @@ struct perf_stats {
 	u64_t end_time;
 	u64_t total_bytes;
 	struct interim_report i_report;
+	u64_t start_time_us;
+	u64_t stream_bytes[TCP_NUM_OF_STREAMS];
+	/* Main loop polls with nothing to send, for the CPU load */
+	u32_t idle_polls;
+	u32_t idle_polls_per_ms;
 };
 
 /* seconds between periodic bandwidth reports */
@@ -104,4 +114,12 @@ struct perf_stats {
 
 #define TCP_SEND_BUFSIZE (5*TCP_MSS)
 
+/* Target bandwidth of each stream in bits/sec, 0 to send as fast as
+ * possible. Writes are paced on the microsecond clock.
+ */
+#define TCP_TARGET_BANDWIDTH 0
+
+/* Writes of TCP_SEND_BUFSIZE a stream may queue ahead of its pace */
+#define TCP_PACING_BURST 4
+
 #endif /* __TCP_PERF_CLIENT_H_ */
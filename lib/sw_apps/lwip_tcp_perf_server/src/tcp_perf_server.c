@@ -131,6 +131,14 @@ static void tcp_conn_report(u64_t diff,
 
 	if (report_type == INTER_REPORT)
 		server.i_report.last_report_time += duration;
+
+#if XLWIP_CONFIG_NETIF_STATS
+	/* netif counters of the finished test, cleared for the next one */
+	if (report_type != INTER_REPORT) {
+		xemacif_print_stats(&server_netif);
+		xemacif_clear_stats(&server_netif);
+	}
+#endif
 }
 
 /** Close a tcp session */
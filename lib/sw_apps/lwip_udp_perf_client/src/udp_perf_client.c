@@ -35,17 +35,46 @@ static struct udp_pcb *pcb[NUM_OF_PARALLEL_CLIENTS];
 static struct perf_stats client;
 static char send_buf[UDP_SEND_BUFSIZE];
 #define FINISH	1
+
+/* iperf datagram header: id, seconds, microseconds */
+#define UDP_HDR_LEN (3 * sizeof(int))
 /* Report interval time in ms */
 #define REPORT_INTERVAL_TIME (INTERIM_REPORT_INTERVAL * 1000)
 /* End time in ms */
 #define END_TIME (UDP_TIME_INTERVAL * 1000)
+/* Time in ms to count the main loop polls of an idle CPU */
+#define IDLE_CALIBRATION_TIME 100
+
+#if UDP_TARGET_BANDWIDTH
+/* Time in us between two datagrams of a stream */
+#define UDP_PACING_INTERVAL_US \
+	((u64_t)UDP_SEND_BUFSIZE * 8 * 1000000 / UDP_TARGET_BANDWIDTH)
+static u64_t next_send_us;
+#endif
+
+#if UDP_RTT_ECHO_PORT
+#define UDP_SERVER_PORT UDP_RTT_ECHO_PORT
+#else
+#define UDP_SERVER_PORT UDP_CONN_PORT
+#endif
 
 void print_app_header(void)
 {
 	xil_printf("UDP client connecting to %s on port %d\r\n",
-			UDP_SERVER_IP_ADDRESS, UDP_CONN_PORT);
+			UDP_SERVER_IP_ADDRESS, UDP_SERVER_PORT);
+#if UDP_RTT_ECHO_PORT
+	xil_printf("On Host: Run a UDP echo server on port %d\r\n\r\n",
+			UDP_RTT_ECHO_PORT);
+#else
 	xil_printf("On Host: Run $iperf -s -i %d -u\r\n\r\n",
 			INTERIM_REPORT_INTERVAL);
+#endif
+	xil_printf("%d streams of %d bytes datagrams", NUM_OF_PARALLEL_CLIENTS,
+			UDP_SEND_BUFSIZE);
+#if UDP_TARGET_BANDWIDTH
+	xil_printf(" at %d Kbits/sec each", UDP_TARGET_BANDWIDTH / 1000);
+#endif
+	xil_printf("\r\n");
 }
 
 static void print_udp_conn_stats(void)
@@ -84,6 +113,36 @@ static void stats_buffer(char* outString,
 	sprintf(outString, format, data, kLabel[conv]);
 }
 
+/* Share of the main loop polls which did not wait for the pacing, in % */
+static u32_t cpu_load(u64_t diff_ms)
+{
+	u64_t idle_max = (u64_t)client.idle_polls_per_ms * diff_ms;
+
+	if (idle_max == 0 || client.idle_polls >= idle_max)
+		return (idle_max == 0) ? 100 : 0;
+	return (u32_t)(100 - (client.idle_polls * 100) / idle_max);
+}
+
+/* The final report of each stream */
+static void udp_stream_report(u8_t i, double duration)
+{
+	struct stream_stats *stream = &client.stream[i];
+	char data[16], perf[16];
+	double bandwidth = 0;
+
+	if (duration)
+		bandwidth = (stream->total_bytes / duration) * 8.0;
+	stats_buffer(data, stream->total_bytes, BYTES);
+	stats_buffer(perf, bandwidth, SPEED);
+	xil_printf("[%3d] stream %d  %sBytes  %sbits/sec", client.client_id,
+			i, data, perf);
+	if (stream->rtt_cnt)
+		xil_printf("  rtt min/avg/max %d/%d/%d us",
+				stream->rtt_min_us,
+				(u32_t)(stream->rtt_sum_us / stream->rtt_cnt),
+				stream->rtt_max_us);
+	xil_printf("\n\r");
+}
 
 /* The report function of a UDP client session */
 static void udp_conn_report(u64_t diff,
@@ -92,6 +151,7 @@ static void udp_conn_report(u64_t diff,
 	u64_t total_len;
 	double duration, bandwidth = 0;
 	char data[16], perf[16], time[64];
+	u8_t i;
 
 	if (report_type == INTER_REPORT) {
 		total_len = client.i_report.total_bytes;
@@ -116,19 +176,64 @@ static void udp_conn_report(u64_t diff,
 	sprintf(time, "%4.1f-%4.1f sec",
 			(double)client.i_report.last_report_time,
 			(double)(client.i_report.last_report_time + duration));
-	xil_printf("[%3d] %s  %sBytes  %sbits/sec\n\r", client.client_id,
+	xil_printf("[%3d] %s  %sBytes  %sbits/sec", client.client_id,
 			time, data, perf);
+	if (report_type == INTER_REPORT) {
+		xil_printf("  cpu %d%%", cpu_load(diff));
+		client.idle_polls = 0;
+	}
+	xil_printf("\n\r");
 
-	if (report_type == INTER_REPORT)
+	if (report_type == INTER_REPORT) {
 		client.i_report.last_report_time += duration;
-	else
+	} else {
+		for (i = 0; i < NUM_OF_PARALLEL_CLIENTS; i++)
+			udp_stream_report(i, duration);
 		xil_printf("[%3d] sent %llu datagrams\n\r",
 				client.client_id, client.cnt_datagrams);
+	}
+
+#if XLWIP_CONFIG_NETIF_STATS
+	/* netif counters of the finished test, cleared for the next one */
+	if (report_type != INTER_REPORT) {
+		xemacif_print_stats(&server_netif);
+		xemacif_clear_stats(&server_netif);
+	}
+#endif
 }
 
+#if UDP_RTT_ECHO_PORT
+/* Round trip time of an echoed datagram, from its iperf timestamp */
+static void udp_echo_recv(void *arg, struct udp_pcb *upcb, struct pbuf *p,
+		const ip_addr_t *addr, u16_t port)
+{
+	struct stream_stats *stream = (struct stream_stats *)arg;
+	u32_t hdr[3];
+	u64_t sent_us;
+	u32_t rtt;
+
+	LWIP_UNUSED_ARG(upcb);
+	LWIP_UNUSED_ARG(addr);
+	LWIP_UNUSED_ARG(port);
+
+	if (pbuf_copy_partial(p, hdr, sizeof(hdr), 0) == sizeof(hdr)) {
+		sent_us = (u64_t)ntohl(hdr[1]) * 1000000 + ntohl(hdr[2]);
+		rtt = (u32_t)(get_time_us() - sent_us);
+		stream->rtt_sum_us += rtt;
+		stream->rtt_cnt++;
+		if (rtt < stream->rtt_min_us)
+			stream->rtt_min_us = rtt;
+		if (rtt > stream->rtt_max_us)
+			stream->rtt_max_us = rtt;
+	}
+	pbuf_free(p);
+}
+#endif
 
 static void reset_stats(void)
 {
+	u8_t i;
+
 	client.client_id++;
 	/* Print connection statistics */
 	print_udp_conn_stats();
@@ -136,6 +241,16 @@ static void reset_stats(void)
 	client.start_time = get_time_ms();
 	client.total_bytes = 0;
 	client.cnt_datagrams = 0;
+	client.idle_polls = 0;
+
+	for (i = 0; i < NUM_OF_PARALLEL_CLIENTS; i++) {
+		client.stream[i].total_bytes = 0;
+		client.stream[i].cnt_datagrams = 0;
+		client.stream[i].rtt_sum_us = 0;
+		client.stream[i].rtt_min_us = 0xFFFFFFFF;
+		client.stream[i].rtt_max_us = 0;
+		client.stream[i].rtt_cnt = 0;
+	}
 
 	/* Initialize Interim report parameters */
 	client.i_report.start_time = 0;
@@ -143,31 +258,77 @@ static void reset_stats(void)
 	client.i_report.last_report_time = 0;
 }
 
+/* Count the main loop polls per ms when there is nothing to send */
+static void calibrate_idle(void)
+{
+	u64_t start = get_time_ms();
+	u32_t polls = 0;
+
+	while (get_time_ms() - start < IDLE_CALIBRATION_TIME) {
+		xemacif_input(&server_netif);
+		(void)get_time_us();
+		polls++;
+	}
+	client.idle_polls_per_ms = polls / IDLE_CALIBRATION_TIME;
+}
+
+/* Returns 1 when the streams are ahead of their pace */
+static u8_t udp_pacing_wait(void)
+{
+#if UDP_TARGET_BANDWIDTH
+	u64_t now_us = get_time_us();
+
+	if (now_us < next_send_us)
+		return 1;
+	next_send_us += UDP_PACING_INTERVAL_US;
+	/* Do not send more than a burst to catch up after a stall */
+	if (next_send_us + UDP_PACING_BURST * UDP_PACING_INTERVAL_US < now_us)
+		next_send_us = now_us;
+#endif
+	return 0;
+}
+
 static void udp_packet_send(u8_t finished)
 {
 	int *payload;
 	static int packet_id;
 	u8_t i;
 	u8_t retries = MAX_SEND_RETRY;
-	struct pbuf *packet;
+	struct pbuf *packet, *body;
 	err_t err;
+	u64_t now_us;
 
 	for (i = 0; i < NUM_OF_PARALLEL_CLIENTS; i++) {
 
-		packet = pbuf_alloc(PBUF_TRANSPORT, UDP_SEND_BUFSIZE, PBUF_POOL);
-		if (!packet) {
+		/*
+		 * Only the datagram header changes between packets, the
+		 * payload is sent in place from send_buf by a PBUF_REF
+		 * chained behind it instead of being copied every time.
+		 */
+		packet = pbuf_alloc(PBUF_TRANSPORT, UDP_HDR_LEN, PBUF_RAM);
+		body = pbuf_alloc(PBUF_RAW, UDP_SEND_BUFSIZE - UDP_HDR_LEN,
+				PBUF_REF);
+		if (!packet || !body) {
 			xil_printf("error allocating pbuf to send\r\n");
+			if (packet)
+				pbuf_free(packet);
+			if (body)
+				pbuf_free(body);
 			return;
-		} else {
-			memcpy(packet->payload, send_buf, UDP_SEND_BUFSIZE);
 		}
+		body->payload = send_buf + UDP_HDR_LEN;
+		pbuf_cat(packet, body);
 
 		/* always increment the id */
 		payload = (int*) (packet->payload);
 		if (finished == FINISH)
 			packet_id = -1;
 
+		/* iperf datagram header: id, then the send time */
+		now_us = get_time_us();
 		payload[0] = htonl(packet_id);
+		payload[1] = htonl((u32_t)(now_us / 1000000));
+		payload[2] = htonl((u32_t)(now_us % 1000000));
 
 		while (retries) {
 			err = udp_send(pcb[i], packet);
@@ -179,6 +340,8 @@ static void udp_packet_send(u8_t finished)
 				client.total_bytes += UDP_SEND_BUFSIZE;
 				client.cnt_datagrams++;
 				client.i_report.total_bytes += UDP_SEND_BUFSIZE;
+				client.stream[i].total_bytes += UDP_SEND_BUFSIZE;
+				client.stream[i].cnt_datagrams++;
 				break;
 			}
 		}
@@ -249,6 +412,10 @@ void transfer_data(void)
 		}
 	}
 
+	if (udp_pacing_wait()) {
+		client.idle_polls++;
+		return;
+	}
 	udp_packet_send(!FINISH);
 }
 
@@ -272,16 +439,23 @@ void start_application(void)
 			return;
 		}
 
-		err = udp_connect(pcb[i], &remote_addr, UDP_CONN_PORT);
+		err = udp_connect(pcb[i], &remote_addr, UDP_SERVER_PORT);
 		if (err != ERR_OK) {
 			xil_printf("udp_client: Error on udp_connect: %d\r\n", err);
 			udp_remove(pcb[i]);
 			return;
 		}
+#if UDP_RTT_ECHO_PORT
+		udp_recv(pcb[i], udp_echo_recv, &client.stream[i]);
+#endif
 	}
 	/* Wait for successful connection */
 	usleep(10);
+	calibrate_idle();
 	reset_stats();
+#if UDP_TARGET_BANDWIDTH
+	next_send_us = get_time_us();
+#endif
 
 	/* initialize data buffer being sent with same as used in iperf */
 	for (i = 0; i < UDP_SEND_BUFSIZE; i++)
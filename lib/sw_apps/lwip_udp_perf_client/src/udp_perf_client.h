@@ -35,10 +35,14 @@
 #include "lwip/err.h"
 #include "lwip/udp.h"
 #include "lwip/inet.h"
+#include "netif/xadapter.h"
 #include "xil_printf.h"
 #include "platform.h"
 #include <sleep.h>
 
+/* Number of parallel UDP clients */
+#define NUM_OF_PARALLEL_CLIENTS 2
+
 /* used as indices into kLabel[] */
 enum {
 	KCONV_UNIT,
@@ -78,12 +82,26 @@ struct interim_report {
 	u32_t total_bytes;
 };
 
+/* Per stream counters */
+struct stream_stats {
+	u64_t total_bytes;
+	u64_t cnt_datagrams;
+	u64_t rtt_sum_us;
+	u32_t rtt_min_us;
+	u32_t rtt_max_us;
+	u32_t rtt_cnt;
+};
+
 struct perf_stats {
 	u8_t client_id;
 	u64_t start_time;
 	u64_t total_bytes;
 	u64_t cnt_datagrams;
 	struct interim_report i_report;
+	struct stream_stats stream[NUM_OF_PARALLEL_CLIENTS];
+	/* Main loop polls spent waiting on the pacing, for the CPU load */
+	u32_t idle_polls;
+	u32_t idle_polls_per_ms;
 };
 
 /* seconds between periodic bandwidth reports */
@@ -101,10 +119,21 @@ struct perf_stats {
 /* UDP buffer length in bytes */
 #define UDP_SEND_BUFSIZE 1440
 
+/* Target bandwidth of each stream in bits/sec, 0 to send as fast as
+ * possible. Datagrams are paced on the microsecond clock.
+ */
+#define UDP_TARGET_BANDWIDTH 0
+
+/* Datagrams a stream may send back to back to catch up with its pace */
+#define UDP_PACING_BURST 8
+
+/* Non zero to send to a UDP echo server on this port, instead of iperf,
+ * and report the round trip time of the echoed datagrams.
+ */
+#define UDP_RTT_ECHO_PORT 0
+
 /* MAX UDP send retries */
 #define MAX_SEND_RETRY 10
 
-/* Number of parallel UDP clients */
-#define NUM_OF_PARALLEL_CLIENTS 2
 
 #endif /* __UDP_PERF_CLIENT_H_ */
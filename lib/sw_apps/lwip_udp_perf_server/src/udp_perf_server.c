@@ -135,6 +135,14 @@ static void udp_conn_report(u64_t diff,
 				server.client_id, time,
 				cnt_out_of_order_datagrams);
 	}
+
+#if XLWIP_CONFIG_NETIF_STATS
+	/* netif counters of the finished test, cleared for the next one */
+	if (report_type != INTER_REPORT) {
+		xemacif_print_stats(&server_netif);
+		xemacif_clear_stats(&server_netif);
+	}
+#endif
 }
 
 
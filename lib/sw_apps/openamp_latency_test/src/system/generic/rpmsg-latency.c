@@ -0,0 +1,213 @@
+/* This is a sample application that measures the rpmsg round trip latency
+between this remote CPU and the master core.
+This application is meant to run on the remote CPU running baremetal code.
+The master core answers each message it receives, as the Linux
+rpmsg_client_sample driver does. The remote sends a message, waits for the
+answer and records the time between the two, using the PMU cycle counter.
+
+In polling mode (the default) the remote reads the receive vring directly,
+and the master does not raise an IPI for the messages it sends. Define
+LATENCY_POLL_MODE to 0 to measure the interrupt path instead. */
+
+#include "xil_printf.h"
+#include "xparameters.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexr5.h"
+#include <openamp/open_amp.h>
+#include "platform_info.h"
+#include "rpmsg-latency.h"
+
+/* Receive with rpmsg_virtio_poll() instead of the IPI */
+#ifndef LATENCY_POLL_MODE
+#define LATENCY_POLL_MODE	1
+#endif
+
+/* Number of round trips, the client sample driver answers 99 messages */
+#ifndef LATENCY_ROUND_TRIPS
+#define LATENCY_ROUND_TRIPS	99
+#endif
+
+/* Payload size of the messages sent */
+#ifndef LATENCY_PAYLOAD_SIZE
+#define LATENCY_PAYLOAD_SIZE	16
+#endif
+
+#define CYCLES_PER_USEC (XPAR_CPU_CORTEXR5_0_CPU_CLK_FREQ_HZ / 1000000U)
+
+/* PMU control register and count enable bits */
+#define PMCR_ENABLE		0x00000001U
+#define PMCR_CYCLE_RESET	0x00000004U
+#define PMCR_CYCLE_DIV64	0x00000008U
+#define PMCNTEN_CYCLE		0x80000000U
+
+#define LPRINTF(format, ...) xil_printf(format, ##__VA_ARGS__)
+#define LPERROR(format, ...) LPRINTF("ERROR: " format, ##__VA_ARGS__)
+
+static struct rpmsg_endpoint lept;
+static volatile int done = 0;
+
+static unsigned char payload[LATENCY_PAYLOAD_SIZE];
+static int started = 0;
+static u32 send_time;
+static unsigned int round_trips;
+static u32 min_cycles = 0xFFFFFFFFU;
+static u32 max_cycles;
+static u64 sum_cycles;
+
+/* External functions */
+extern int init_system(void);
+extern void cleanup_system(void);
+
+/*-----------------------------------------------------------------------------*
+ *  Cycle counter
+ *-----------------------------------------------------------------------------*/
+static void cycle_counter_init(void)
+{
+	u32 reg;
+
+	reg = mfcp(XREG_CP15_PERF_MONITOR_CTRL);
+	reg |= PMCR_ENABLE | PMCR_CYCLE_RESET;
+	reg &= ~PMCR_CYCLE_DIV64;
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, reg);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, PMCNTEN_CYCLE);
+}
+
+static inline u32 cycle_counter_read(void)
+{
+	return mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+}
+
+/*-----------------------------------------------------------------------------*
+ *  RPMSG endpoint callbacks
+ *-----------------------------------------------------------------------------*/
+static int rpmsg_endpoint_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+			     uint32_t src, void *priv)
+{
+	u32 cycles;
+
+	(void)data;
+	(void)len;
+	(void)src;
+	(void)priv;
+
+	/* The first message comes from the master, no round trip yet */
+	if (started) {
+		/* The cycle counter is 32 bits, a round trip is much shorter */
+		cycles = cycle_counter_read() - send_time;
+		if (cycles < min_cycles)
+			min_cycles = cycles;
+		if (cycles > max_cycles)
+			max_cycles = cycles;
+		sum_cycles += cycles;
+		round_trips++;
+	}
+
+	if (round_trips == LATENCY_ROUND_TRIPS) {
+		done = 1;
+		return RPMSG_SUCCESS;
+	}
+
+	started = 1;
+	payload[0] = (unsigned char)round_trips;
+	send_time = cycle_counter_read();
+	if (rpmsg_send(ept, payload, sizeof(payload)) < 0) {
+		LPERROR("rpmsg_send failed\n");
+		done = 1;
+	}
+	return RPMSG_SUCCESS;
+}
+
+static void rpmsg_service_unbind(struct rpmsg_endpoint *ept)
+{
+	(void)ept;
+	LPRINTF("unexpected Remote endpoint destroy\n");
+	done = 1;
+}
+
+/*-----------------------------------------------------------------------------*
+ *  Application
+ *-----------------------------------------------------------------------------*/
+int app(struct rpmsg_device *rdev, void *priv)
+{
+	struct rpmsg_virtio_device *rvdev;
+	int ret;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+
+	cycle_counter_init();
+
+	LPRINTF("Try to create rpmsg endpoint.\n");
+
+	ret = rpmsg_create_ept(&lept, rdev, RPMSG_SERVICE_NAME,
+			       0, RPMSG_ADDR_ANY, rpmsg_endpoint_cb,
+			       rpmsg_service_unbind);
+	if (ret) {
+		LPERROR("Failed to create endpoint.\n");
+		return -1;
+	}
+
+	LPRINTF("Successfully created rpmsg endpoint.\n");
+#if LATENCY_POLL_MODE
+	(void)priv;
+	LPRINTF("Polling mode, %d round trips of %d bytes.\n",
+		LATENCY_ROUND_TRIPS, LATENCY_PAYLOAD_SIZE);
+	rpmsg_virtio_set_rx_poll(rvdev, true);
+	while (!done)
+		rpmsg_virtio_poll(rvdev);
+	rpmsg_virtio_set_rx_poll(rvdev, false);
+#else
+	(void)rvdev;
+	LPRINTF("Interrupt mode, %d round trips of %d bytes.\n",
+		LATENCY_ROUND_TRIPS, LATENCY_PAYLOAD_SIZE);
+	while (!done)
+		platform_poll(priv);
+#endif
+
+	if (round_trips) {
+		LPRINTF("Round trips: %d\n", round_trips);
+		LPRINTF("Latency (ns): min %d avg %d max %d\n",
+			(int)((u64)min_cycles * 1000U / CYCLES_PER_USEC),
+			(int)(sum_cycles * 1000U / CYCLES_PER_USEC /
+			      round_trips),
+			(int)((u64)max_cycles * 1000U / CYCLES_PER_USEC));
+	}
+	rpmsg_destroy_ept(&lept);
+
+	return 0;
+}
+
+/*-----------------------------------------------------------------------------*
+ *  Application entry point
+ *-----------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+	void *platform;
+	struct rpmsg_device *rpdev;
+	int ret;
+
+	LPRINTF("Starting application...\n");
+
+	/* Initialize platform */
+	ret = platform_init(argc, argv, &platform);
+	if (ret) {
+		LPERROR("Failed to initialize platform.\n");
+		ret = -1;
+	} else {
+		rpdev = platform_create_rpmsg_vdev(platform, 0,
+						   VIRTIO_DEV_SLAVE,
+						   NULL, NULL);
+		if (!rpdev) {
+			LPERROR("Failed to create rpmsg virtio device.\n");
+			ret = -1;
+		} else {
+			app(rpdev, platform);
+			platform_release_rpmsg_vdev(rpdev);
+			ret = 0;
+		}
+	}
+
+	LPRINTF("Stopping application...\n");
+	platform_cleanup(platform);
+
+	return ret;
+}
@@ -0,0 +1,10 @@
+#ifndef RPMSG_LATENCY_H
+#define RPMSG_LATENCY_H
+
+/*
+ * The Linux rpmsg_client_sample driver binds to this service, and answers
+ * each message until it received 100 of them.
+ */
+#define RPMSG_SERVICE_NAME         "rpmsg-client-sample"
+
+#endif /* RPMSG_LATENCY_H */
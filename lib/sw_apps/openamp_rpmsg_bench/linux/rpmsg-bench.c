@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Linux side of the OpenAMP rpmsg-bench application.
+ *
+ * The remote runs the rpmsg-bench firmware (baremetal or FreeRTOS), and its
+ * rpmsg-openamp-demo-channel endpoint is exposed by the rpmsg_char driver,
+ * as for the echo test. For each buffer mode of the remote (copy and
+ * zero-copy) this tool reports:
+ *  - round trip latency percentiles for each message size
+ *  - master to remote throughput for each message size
+ *  - remote to master throughput for each message size
+ * Message sizes go from 16 bytes (the benchmark header) to the largest
+ * message the remote can send, doubling at each step.
+ *
+ * Build: gcc -O2 -I../src/system/generic -o rpmsg-bench rpmsg-bench.c
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "rpmsg-bench.h"
+
+#define DEFAULT_DEVICE		"/dev/rpmsg0"
+#define DEFAULT_ITERATIONS	1000U
+#define MIN_SIZE		((uint32_t)sizeof(struct bench_msg))
+
+static int fd = -1;
+static unsigned char tx_buf[4096];
+static unsigned char rx_buf[4096];
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int msg_write(const void *buf, size_t len)
+{
+	ssize_t ret = write(fd, buf, len);
+
+	if (ret != (ssize_t)len) {
+		fprintf(stderr, "write failed: %s\n", strerror(errno));
+		return -1;
+	}
+	return 0;
+}
+
+static ssize_t msg_read(void *buf, size_t len)
+{
+	ssize_t ret = read(fd, buf, len);
+
+	if (ret < 0)
+		fprintf(stderr, "read failed: %s\n", strerror(errno));
+	return ret;
+}
+
+static int send_cmd(uint32_t cmd, uint32_t len, uint32_t count)
+{
+	struct bench_msg msg = {
+		.cmd = cmd,
+		.seq = 0,
+		.len = len,
+		.count = count,
+	};
+
+	return msg_write(&msg, sizeof(msg));
+}
+
+static int get_stats(struct bench_stats *stats)
+{
+	ssize_t ret;
+
+	if (send_cmd(BENCH_CMD_STATS, 0, 0))
+		return -1;
+	ret = msg_read(stats, sizeof(*stats));
+	if (ret != (ssize_t)sizeof(*stats) || stats->cmd != BENCH_CMD_STATS) {
+		fprintf(stderr, "bad stats reply\n");
+		return -1;
+	}
+	return 0;
+}
+
+static uint32_t payload_sum(const unsigned char *buf, uint32_t len)
+{
+	uint32_t sum = 0;
+	uint32_t i;
+
+	for (i = MIN_SIZE; i < len; i++)
+		sum += buf[i];
+
+	return sum;
+}
+
+static double mbps(uint64_t bytes, uint64_t ns)
+{
+	return ns ? (double)bytes * 1000.0 / (double)ns : 0.0;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const uint64_t *sorted, uint32_t n, uint32_t pm)
+{
+	/* pm is in per mille */
+	uint64_t idx = ((uint64_t)n * pm + 999U) / 1000U;
+
+	return sorted[idx ? idx - 1U : 0U];
+}
+
+static int bench_latency(uint32_t size, uint32_t iterations)
+{
+	struct bench_msg *msg = (struct bench_msg *)tx_buf;
+	uint64_t *samples;
+	uint64_t start, sum = 0;
+	uint32_t i;
+	ssize_t ret;
+
+	samples = calloc(iterations, sizeof(*samples));
+	if (!samples)
+		return -1;
+
+	msg->cmd = BENCH_CMD_ECHO;
+	msg->len = size;
+	msg->count = iterations;
+	for (i = 0; i < iterations; i++) {
+		msg->seq = i;
+		start = now_ns();
+		if (msg_write(tx_buf, size))
+			goto err;
+		ret = msg_read(rx_buf, sizeof(rx_buf));
+		samples[i] = now_ns() - start;
+		if (ret != (ssize_t)size ||
+		    ((struct bench_msg *)rx_buf)->seq != i) {
+			fprintf(stderr, "bad echo reply %u\n", i);
+			goto err;
+		}
+		sum += samples[i];
+	}
+
+	qsort(samples, iterations, sizeof(*samples), cmp_u64);
+	printf("  %5u B  min %7.1f  avg %7.1f  p50 %7.1f  p90 %7.1f  "
+	       "p99 %7.1f  p99.9 %7.1f  max %7.1f us\n", size,
+	       samples[0] / 1000.0, sum / iterations / 1000.0,
+	       percentile(samples, iterations, 500U) / 1000.0,
+	       percentile(samples, iterations, 900U) / 1000.0,
+	       percentile(samples, iterations, 990U) / 1000.0,
+	       percentile(samples, iterations, 999U) / 1000.0,
+	       samples[iterations - 1U] / 1000.0);
+	free(samples);
+	return 0;
+
+err:
+	free(samples);
+	return -1;
+}
+
+static int bench_tx(uint32_t size, uint32_t iterations)
+{
+	struct bench_msg *msg = (struct bench_msg *)tx_buf;
+	struct bench_stats stats;
+	uint64_t start, ns;
+	uint32_t sum;
+	uint32_t i;
+
+	for (i = MIN_SIZE; i < size; i++)
+		tx_buf[i] = (unsigned char)i;
+	msg->cmd = BENCH_CMD_SINK;
+	msg->len = size;
+	msg->count = iterations;
+	sum = payload_sum(tx_buf, size) * iterations;
+	start = now_ns();
+	for (i = 0; i < iterations; i++) {
+		msg->seq = i;
+		if (msg_write(tx_buf, size))
+			return -1;
+	}
+	/* The stats reply comes after the remote consumed all messages */
+	if (get_stats(&stats))
+		return -1;
+	ns = now_ns() - start;
+
+	printf("  %5u B  %8.2f MB/s  %8.0f msg/s  remote %8.2f MB/s%s\n",
+	       size, mbps((uint64_t)size * iterations, ns),
+	       (double)iterations * 1e9 / (double)ns,
+	       mbps(stats.bytes, stats.ns),
+	       (stats.msgs != iterations || stats.checksum != sum) ?
+	       "  DATA MISMATCH" : "");
+	return 0;
+}
+
+static int bench_rx(uint32_t size, uint32_t iterations)
+{
+	struct bench_stats stats;
+	uint64_t start, ns;
+	uint32_t sum = 0;
+	uint32_t i;
+	ssize_t ret;
+	int bad = 0;
+
+	start = now_ns();
+	if (send_cmd(BENCH_CMD_SOURCE, size, iterations))
+		return -1;
+	for (i = 0; i < iterations; i++) {
+		ret = msg_read(rx_buf, sizeof(rx_buf));
+		if (ret != (ssize_t)size ||
+		    ((struct bench_msg *)rx_buf)->seq != i)
+			bad = 1;
+		if (ret > 0)
+			sum += payload_sum(rx_buf, (uint32_t)ret);
+	}
+	ns = now_ns() - start;
+	if (get_stats(&stats))
+		return -1;
+
+	printf("  %5u B  %8.2f MB/s  %8.0f msg/s  remote %8.2f MB/s%s\n",
+	       size, mbps((uint64_t)size * iterations, ns),
+	       (double)iterations * 1e9 / (double)ns,
+	       mbps(stats.bytes, stats.ns),
+	       (bad || stats.checksum != sum) ? "  DATA MISMATCH" : "");
+	return 0;
+}
+
+/* Doubling sizes, ending with max_size */
+static uint32_t next_size(uint32_t size, uint32_t max_size)
+{
+	if (size == max_size)
+		return max_size + 1U;
+
+	return (size * 2U < max_size) ? size * 2U : max_size;
+}
+
+static int run_mode(uint32_t mode, uint32_t max_size, uint32_t iterations)
+{
+	struct bench_stats stats;
+	uint32_t size;
+	int ret = 0;
+
+	if (send_cmd(BENCH_CMD_MODE, 0, mode) || get_stats(&stats))
+		return -1;
+
+	printf("\n%s mode\n", mode == BENCH_MODE_COPY ? "Copy" : "Zero-copy");
+
+	printf(" Round trip latency (%u messages)\n", iterations);
+	for (size = MIN_SIZE; !ret && size <= max_size;
+	     size = next_size(size, max_size))
+		ret = bench_latency(size, iterations);
+
+	printf(" Master to remote throughput (%u messages)\n", iterations);
+	for (size = MIN_SIZE; !ret && size <= max_size;
+	     size = next_size(size, max_size))
+		ret = bench_tx(size, iterations);
+
+	printf(" Remote to master throughput (%u messages)\n", iterations);
+	for (size = MIN_SIZE; !ret && size <= max_size;
+	     size = next_size(size, max_size))
+		ret = bench_rx(size, iterations);
+
+	return ret;
+}
+
+static void usage(const char *name)
+{
+	printf("Usage: %s [-d device] [-n iterations] [-m copy|zero|both] [-s]\n"
+	       "  -d  rpmsg char device, default " DEFAULT_DEVICE "\n"
+	       "  -n  messages per measurement, default %u\n"
+	       "  -m  remote buffer mode, default both\n"
+	       "  -s  shut the remote application down when done\n",
+	       name, DEFAULT_ITERATIONS);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *dev = DEFAULT_DEVICE;
+	uint32_t iterations = DEFAULT_ITERATIONS;
+	struct bench_stats stats;
+	uint32_t max_size;
+	int copy = 1, zero = 1, shutdown = 0;
+	uint32_t shutdown_msg = SHUTDOWN_MSG;
+	int opt, ret;
+
+	while ((opt = getopt(argc, argv, "d:n:m:sh")) != -1) {
+		switch (opt) {
+		case 'd':
+			dev = optarg;
+			break;
+		case 'n':
+			iterations = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'm':
+			copy = strcmp(optarg, "zero") != 0;
+			zero = strcmp(optarg, "copy") != 0;
+			break;
+		case 's':
+			shutdown = 1;
+			break;
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? 0 : 1;
+		}
+	}
+	if (!iterations) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	fd = open(dev, O_RDWR);
+	if (fd < 0) {
+		fprintf(stderr, "cannot open %s: %s\n", dev, strerror(errno));
+		return 1;
+	}
+
+	/* Also clears anything the remote counted before */
+	ret = get_stats(&stats);
+	if (ret)
+		goto out;
+	max_size = stats.max_payload;
+	if (max_size > sizeof(tx_buf))
+		max_size = sizeof(tx_buf);
+	printf("rpmsg-bench on %s, largest message %u bytes\n", dev, max_size);
+
+	if (copy)
+		ret = run_mode(BENCH_MODE_COPY, max_size, iterations);
+	if (!ret && zero)
+		ret = run_mode(BENCH_MODE_ZERO_COPY, max_size, iterations);
+
+	if (shutdown)
+		(void)msg_write(&shutdown_msg, sizeof(shutdown_msg));
+out:
+	close(fd);
+	return ret ? 1 : 0;
+}
@@ -0,0 +1,328 @@
+/* This is a benchmark application that measures rpmsg performance between
+this remote CPU and the master core.
+This application is meant to run on the remote CPU running baremetal code.
+The master core drives the benchmark with the rpmsg-bench Linux tool found in
+the linux directory of this application, using the commands of rpmsg-bench.h:
+ - BENCH_CMD_ECHO messages are sent back, for round trip latency
+ - BENCH_CMD_SINK messages are consumed, for master to remote throughput
+ - BENCH_CMD_SOURCE sends a burst of messages, for remote to master throughput
+ - BENCH_CMD_MODE selects copy or zero-copy buffer handling on this side
+ - BENCH_CMD_STATS returns what this side measured, using the PMU cycle
+   counter */
+
+#include <string.h>
+#include "xil_printf.h"
+#include "xparameters.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexr5.h"
+#include <openamp/open_amp.h>
+#include "platform_info.h"
+#include "rpmsg-bench.h"
+
+#define CYCLES_PER_USEC (XPAR_CPU_CORTEXR5_0_CPU_CLK_FREQ_HZ / 1000000U)
+
+/* PMU control register and count enable bits */
+#define PMCR_ENABLE		0x00000001U
+#define PMCR_CYCLE_RESET	0x00000004U
+#define PMCR_CYCLE_DIV64	0x00000008U
+#define PMCNTEN_CYCLE		0x80000000U
+
+#define LPRINTF(format, ...) xil_printf(format, ##__VA_ARGS__)
+#define LPERROR(format, ...) LPRINTF("ERROR: " format, ##__VA_ARGS__)
+
+static struct rpmsg_endpoint lept;
+static struct rpmsg_device *bench_rdev;
+static int shutdown_req = 0;
+
+static uint32_t bench_mode = BENCH_MODE_COPY;
+/* Local buffer of the copy mode */
+static unsigned char app_buf[RPMSG_BUFFER_SIZE];
+
+/* Burst requested by BENCH_CMD_SOURCE, sent from the main loop */
+static struct bench_msg source_req;
+static volatile int source_pending = 0;
+
+static struct bench_stats stats;
+static uint64_t stats_cycles;
+static u32 last_cycles;
+
+/* External functions */
+extern int init_system(void);
+extern void cleanup_system(void);
+
+/*-----------------------------------------------------------------------------*
+ *  Cycle counter
+ *-----------------------------------------------------------------------------*/
+static void cycle_counter_init(void)
+{
+	u32 reg;
+
+	reg = mfcp(XREG_CP15_PERF_MONITOR_CTRL);
+	reg |= PMCR_ENABLE | PMCR_CYCLE_RESET;
+	reg &= ~PMCR_CYCLE_DIV64;
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, reg);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, PMCNTEN_CYCLE);
+}
+
+static inline u32 cycle_counter_read(void)
+{
+	return mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+}
+
+/*-----------------------------------------------------------------------------*
+ *  Statistics
+ *-----------------------------------------------------------------------------*/
+static void stats_account(size_t len)
+{
+	u32 now = cycle_counter_read();
+
+	/*
+	 * Sum the time between messages rather than the time since the first
+	 * one, the 32 bits cycle counter wraps within a few seconds
+	 */
+	if (stats.msgs)
+		stats_cycles += now - last_cycles;
+	last_cycles = now;
+	stats.msgs++;
+	stats.bytes += len;
+}
+
+static uint32_t payload_sum(const unsigned char *buf, size_t len)
+{
+	uint32_t sum = 0;
+	size_t i;
+
+	for (i = sizeof(struct bench_msg); i < len; i++)
+		sum += buf[i];
+
+	return sum;
+}
+
+static void stats_send(struct rpmsg_endpoint *ept)
+{
+	stats.cmd = BENCH_CMD_STATS;
+	stats.ns = stats_cycles * 1000U / CYCLES_PER_USEC;
+	stats.max_payload = rpmsg_virtio_get_buffer_size(bench_rdev);
+	if (rpmsg_send(ept, &stats, sizeof(stats)) < 0)
+		LPERROR("rpmsg_send failed\n");
+
+	memset(&stats, 0, sizeof(stats));
+	stats_cycles = 0;
+}
+
+/*-----------------------------------------------------------------------------*
+ *  Benchmark commands
+ *-----------------------------------------------------------------------------*/
+static void bench_echo(struct rpmsg_endpoint *ept, void *data, size_t len)
+{
+	uint32_t size;
+	void *tx;
+
+	if (bench_mode == BENCH_MODE_ZERO_COPY) {
+		/* Write the reply straight into a shared TX buffer */
+		tx = rpmsg_get_tx_payload_buffer(ept, &size, 1);
+		if (!tx || size < len) {
+			LPERROR("no TX buffer\n");
+			return;
+		}
+		memcpy(tx, data, len);
+		if (rpmsg_send_nocopy(ept, tx, len) < 0)
+			LPERROR("rpmsg_send_nocopy failed\n");
+	} else {
+		memcpy(app_buf, data, len);
+		if (rpmsg_send(ept, app_buf, len) < 0)
+			LPERROR("rpmsg_send failed\n");
+	}
+}
+
+static void bench_sink(void *data, size_t len)
+{
+	if (bench_mode == BENCH_MODE_ZERO_COPY) {
+		/* Consume the payload in place in the shared RX buffer */
+		stats.checksum += payload_sum(data, len);
+	} else {
+		memcpy(app_buf, data, len);
+		stats.checksum += payload_sum(app_buf, len);
+	}
+	stats_account(len);
+}
+
+static void bench_fill(unsigned char *buf, uint32_t seq, uint32_t len)
+{
+	struct bench_msg *msg = (struct bench_msg *)buf;
+	uint32_t i;
+
+	msg->cmd = BENCH_CMD_SOURCE;
+	msg->seq = seq;
+	msg->len = len;
+	msg->count = source_req.count;
+	for (i = sizeof(*msg); i < len; i++)
+		buf[i] = (unsigned char)(seq + i);
+}
+
+static void bench_source(struct rpmsg_endpoint *ept)
+{
+	uint32_t len = source_req.len;
+	uint32_t seq, size;
+	unsigned char *tx;
+	int ret;
+
+	if (len < sizeof(struct bench_msg) ||
+	    len > (uint32_t)rpmsg_virtio_get_buffer_size(bench_rdev)) {
+		LPERROR("invalid source length %d\n", (int)len);
+		return;
+	}
+
+	for (seq = 0; seq < source_req.count; seq++) {
+		if (bench_mode == BENCH_MODE_ZERO_COPY) {
+			/* Build the message in the shared TX buffer */
+			tx = rpmsg_get_tx_payload_buffer(ept, &size, 1);
+			if (!tx) {
+				LPERROR("no TX buffer\n");
+				return;
+			}
+			bench_fill(tx, seq, len);
+			stats.checksum += payload_sum(tx, len);
+			ret = rpmsg_send_nocopy(ept, tx, len);
+		} else {
+			bench_fill(app_buf, seq, len);
+			stats.checksum += payload_sum(app_buf, len);
+			ret = rpmsg_send(ept, app_buf, len);
+		}
+		if (ret < 0) {
+			LPERROR("send failed %d\n", ret);
+			return;
+		}
+		stats_account(len);
+	}
+}
+
+/*-----------------------------------------------------------------------------*
+ *  RPMSG endpoint callbacks
+ *-----------------------------------------------------------------------------*/
+static int rpmsg_endpoint_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+			     uint32_t src, void *priv)
+{
+	struct bench_msg *msg = data;
+
+	(void)priv;
+	(void)src;
+
+	/* On reception of a shutdown we signal the application to terminate */
+	if (len >= sizeof(uint32_t) && msg->cmd == SHUTDOWN_MSG) {
+		LPRINTF("shutdown message is received.\n");
+		shutdown_req = 1;
+		return RPMSG_SUCCESS;
+	}
+
+	if (len < sizeof(*msg)) {
+		LPERROR("short message of %d bytes\n", (int)len);
+		return RPMSG_SUCCESS;
+	}
+
+	switch (msg->cmd) {
+	case BENCH_CMD_ECHO:
+		bench_echo(ept, data, len);
+		break;
+	case BENCH_CMD_SINK:
+		bench_sink(data, len);
+		break;
+	case BENCH_CMD_SOURCE:
+		source_req = *msg;
+		source_pending = 1;
+		break;
+	case BENCH_CMD_MODE:
+		bench_mode = msg->count;
+		break;
+	case BENCH_CMD_STATS:
+		stats_send(ept);
+		break;
+	default:
+		LPERROR("unknown command 0x%x\n", (unsigned int)msg->cmd);
+		break;
+	}
+
+	return RPMSG_SUCCESS;
+}
+
+static void rpmsg_service_unbind(struct rpmsg_endpoint *ept)
+{
+	(void)ept;
+	LPRINTF("unexpected Remote endpoint destroy\n");
+	shutdown_req = 1;
+}
+
+/*-----------------------------------------------------------------------------*
+ *  Application
+ *-----------------------------------------------------------------------------*/
+int app(struct rpmsg_device *rdev, void *priv)
+{
+	int ret;
+
+	bench_rdev = rdev;
+	cycle_counter_init();
+
+	/* Initialize RPMSG framework */
+	LPRINTF("Try to create rpmsg endpoint.\n");
+
+	ret = rpmsg_create_ept(&lept, rdev, RPMSG_SERVICE_NAME,
+			       0, RPMSG_ADDR_ANY, rpmsg_endpoint_cb,
+			       rpmsg_service_unbind);
+	if (ret) {
+		LPERROR("Failed to create endpoint.\n");
+		return -1;
+	}
+
+	LPRINTF("Successfully created rpmsg endpoint.\n");
+	while(1) {
+		platform_poll(priv);
+		/* Bursts are sent from here, sends may wait for buffers */
+		if (source_pending) {
+			source_pending = 0;
+			bench_source(&lept);
+		}
+		/* we got a shutdown request, exit */
+		if (shutdown_req) {
+			break;
+		}
+	}
+	rpmsg_destroy_ept(&lept);
+
+	return 0;
+}
+
+/*-----------------------------------------------------------------------------*
+ *  Application entry point
+ *-----------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+	void *platform;
+	struct rpmsg_device *rpdev;
+	int ret;
+
+	LPRINTF("Starting application...\n");
+
+	/* Initialize platform */
+	ret = platform_init(argc, argv, &platform);
+	if (ret) {
+		LPERROR("Failed to initialize platform.\n");
+		ret = -1;
+	} else {
+		rpdev = platform_create_rpmsg_vdev(platform, 0,
+						   VIRTIO_DEV_SLAVE,
+						   NULL, NULL);
+		if (!rpdev) {
+			LPERROR("Failed to create rpmsg virtio device.\n");
+			ret = -1;
+		} else {
+			app(rpdev, platform);
+			platform_release_rpmsg_vdev(rpdev);
+			ret = 0;
+		}
+	}
+
+	LPRINTF("Stopping application...\n");
+	platform_cleanup(platform);
+
+	return ret;
+}
@@ -0,0 +1,42 @@
+#ifndef RPMSG_BENCH_H
+#define RPMSG_BENCH_H
+
+#include <stdint.h>
+
+#define RPMSG_SERVICE_NAME         "rpmsg-openamp-demo-channel"
+
+#define SHUTDOWN_MSG               0xEF56A55AU
+
+/*
+ * Commands, in the first word of each message sent by the master. This
+ * header is shared with the rpmsg-bench Linux tool.
+ */
+#define BENCH_CMD_ECHO             0xBE000001U /* send the message back */
+#define BENCH_CMD_SINK             0xBE000002U /* consume the message */
+#define BENCH_CMD_SOURCE           0xBE000003U /* send count messages of len bytes */
+#define BENCH_CMD_MODE             0xBE000004U /* select the mode in count */
+#define BENCH_CMD_STATS            0xBE000005U /* reply with bench_stats, reset them */
+
+/* Buffer handling on the remote */
+#define BENCH_MODE_COPY            0U /* through a local buffer */
+#define BENCH_MODE_ZERO_COPY       1U /* in place in the shared buffers */
+
+/* Header of each benchmark message, the payload follows */
+struct bench_msg {
+	uint32_t cmd;
+	uint32_t seq;
+	uint32_t len;
+	uint32_t count;
+};
+
+/* What the remote measured since the previous BENCH_CMD_STATS */
+struct bench_stats {
+	uint32_t cmd;
+	uint32_t msgs;
+	uint64_t bytes;
+	uint64_t ns;          /* from the first to the last message handled */
+	uint32_t checksum;    /* byte sum of the payloads consumed or sent */
+	uint32_t max_payload; /* largest message the remote can send */
+};
+
+#endif /* RPMSG_BENCH_H */
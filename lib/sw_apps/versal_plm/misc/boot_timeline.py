@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+###############################################################################
+# Copyright (C) 2019 Xilinx, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+###############################################################################
+#
+# Prints and compares boot timelines of the versal PLM and of zynqmp_fsbl.
+#
+# A timeline is the binary image of XPlmi_Timeline (xplmi_timeline.h), as
+# copied by the PLM XPlmi_GetTimeline command, or of XFsbl_Timeline
+# (xfsbl_timeline.h), as left by FSBL at the address held in
+# PMU_GLOBAL_PERS_GLOB_GEN_STORAGE5.
+#
+#   boot_timeline.py show TIMELINE
+#   boot_timeline.py diff OLD NEW [--threshold PERCENT] [--min-us US]
+#
+# diff matches the events of both timelines and prints the change of their
+# durations. It exits with 1 when an event got slower than the threshold, so
+# it can gate a release against the timeline of the previous one.
+#
+###############################################################################
+
+import argparse
+import struct
+import sys
+
+HEADER = struct.Struct('<6IQ')
+EVENT = struct.Struct('<4IQ')
+
+# Magic: (name, events, slow CDO commands), the array sizes of the loader
+LAYOUTS = {
+    0x4C544C50: ('PLM', 48, 16),
+    0x4C545346: ('FSBL', 32, 0),
+}
+
+EVENT_TYPES = {
+    1: 'image',
+    2: 'partition',
+    3: 'secure hash',
+    4: 'secure aes',
+    5: 'cdo cmd',
+    6: 'stage',
+}
+
+STAGES = {
+    1: 'init',
+    2: 'boot device',
+    3: 'handoff',
+}
+
+
+class Timeline(object):
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            data = f.read()
+        if len(data) < HEADER.size:
+            raise ValueError('%s: too short for a timeline' % path)
+        (magic, version, self.freq, num_events, self.dropped, num_slow,
+         self.rom_time) = HEADER.unpack_from(data, 0)
+        if magic not in LAYOUTS:
+            raise ValueError('%s: unknown magic 0x%08x' % (path, magic))
+        self.loader, max_events, max_slow = LAYOUTS[magic]
+        if version != 1:
+            raise ValueError('%s: unsupported version %d' % (path, version))
+        if self.freq == 0:
+            raise ValueError('%s: timer frequency is 0' % path)
+        self.events = self._events(data, HEADER.size,
+                                   min(num_events, max_events))
+        self.slow_cmds = self._events(data,
+                                      HEADER.size + max_events * EVENT.size,
+                                      min(num_slow, max_slow))
+
+    @staticmethod
+    def _events(data, offset, count):
+        events = []
+        for i in range(count):
+            pos = offset + i * EVENT.size
+            if pos + EVENT.size > len(data):
+                break
+            events.append(EVENT.unpack_from(data, pos))
+        return events
+
+    def us(self, ticks):
+        return ticks * 1000000.0 / self.freq
+
+    def keyed(self):
+        """Events by (type, id, arg, occurrence), durations in us"""
+        keyed = {}
+        for (etype, eid, arg, duration, start) in self.events:
+            key = (etype, eid, arg)
+            n = 0
+            while key + (n,) in keyed:
+                n += 1
+            keyed[key + (n,)] = self.us(duration)
+        return keyed
+
+
+def describe(etype, eid, arg):
+    name = EVENT_TYPES.get(etype, 'type %d' % etype)
+    if etype == 6:
+        return '%s %s' % (name, STAGES.get(eid, str(eid)))
+    return '%s 0x%x (%d)' % (name, eid, arg)
+
+
+def show(args):
+    tl = Timeline(args.timeline)
+    print('%s timeline, timer %d Hz' % (tl.loader, tl.freq))
+    if tl.rom_time != 0:
+        print('ROM time: %.1f us' % tl.us(tl.rom_time))
+    print('%12s %12s  %s' % ('start us', 'duration us', 'event'))
+    for (etype, eid, arg, duration, start) in tl.events:
+        print('%12.1f %12.1f  %s' % (tl.us(start), tl.us(duration),
+                                     describe(etype, eid, arg)))
+    if tl.dropped != 0:
+        print('%d events dropped' % tl.dropped)
+    if tl.slow_cmds:
+        print('Slowest CDO commands:')
+        for (etype, eid, arg, duration, start) in tl.slow_cmds:
+            print('%12.1f %12.1f  %s' % (tl.us(start), tl.us(duration),
+                                         describe(etype, eid, arg)))
+    return 0
+
+
+def diff(args):
+    old = Timeline(args.old)
+    new = Timeline(args.new)
+    if old.loader != new.loader:
+        raise ValueError('cannot compare a %s timeline with a %s one'
+                         % (old.loader, new.loader))
+    old_events = old.keyed()
+    new_events = new.keyed()
+    regressions = 0
+    print('%12s %12s %12s %8s  %s' % ('old us', 'new us', 'delta us',
+                                      'delta %', 'event'))
+    keys = list(old_events) + [k for k in new_events if k not in old_events]
+    for key in keys:
+        desc = describe(key[0], key[1], key[2])
+        if key not in new_events:
+            print('%12.1f %12s %12s %8s  %s' % (old_events[key], '-', '-',
+                                                '-', desc))
+            continue
+        if key not in old_events:
+            print('%12s %12.1f %12s %8s  %s' % ('-', new_events[key], '-',
+                                                '-', desc))
+            continue
+        delta = new_events[key] - old_events[key]
+        pct = 0.0
+        if old_events[key] != 0:
+            pct = delta * 100.0 / old_events[key]
+        mark = ''
+        if pct > args.threshold and delta > args.min_us:
+            mark = '  <- slower'
+            regressions += 1
+        print('%12.1f %12.1f %+12.1f %+7.1f%%  %s%s' % (
+            old_events[key], new_events[key], delta, pct, desc, mark))
+    if regressions != 0:
+        print('%d events slower than %.1f%%' % (regressions, args.threshold))
+        return 1
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Print and compare PLM and FSBL boot timelines')
+    sub = parser.add_subparsers(dest='command')
+    p = sub.add_parser('show', help='print a timeline')
+    p.add_argument('timeline')
+    p.set_defaults(func=show)
+    p = sub.add_parser('diff', help='compare two timelines')
+    p.add_argument('old')
+    p.add_argument('new')
+    p.add_argument('--threshold', type=float, default=5.0,
+                   help='percent an event may get slower, default 5')
+    p.add_argument('--min-us', type=float, default=100.0,
+                   help='ignore changes below this many us, default 100')
+    p.set_defaults(func=diff)
+    args = parser.parse_args()
+    if not hasattr(args, 'func'):
+        parser.print_help()
+        return 2
+    try:
+        return args.func(args)
+    except (IOError, ValueError) as e:
+        sys.stderr.write('%s\n' % e)
+        return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   08/20/2018 Initial release
+*       adk  10/15/2019 Added PLM init and boot PDI stages to boot timeline
 *
 * </pre>
 *
@@ -88,6 +89,10 @@ int XPlm_LoadBootPdi(void *arg)
 
 	XPlmi_PrintPlmTimeStamp();
 	XPlmi_Printf(DEBUG_PRINT_PERF, "PLM Initialization Time \n\r");
+#ifdef PLM_BOOT_TIMELINE
+	XPlmi_TlRecord(XPLMI_TL_EVENT_STAGE, XPLMI_TL_STAGE_INIT, 0U,
+			XPLMI_TL_TIMER_RESET_VALUE);
+#endif
 
 	/**
 	 * 1. Read Boot mode register and multiboot offset register
@@ -130,6 +135,10 @@ int XPlm_LoadBootPdi(void *arg)
 	XPlmi_PrintRomTime();
 	XPlmi_PrintPlmTimeStamp();
 	XPlmi_Printf(DEBUG_PRINT_PERF, "Total PLM Boot Time \n\r");
+#ifdef PLM_BOOT_TIMELINE
+	XPlmi_TlRecord(XPLMI_TL_EVENT_STAGE, XPLMI_TL_STAGE_HANDOFF, 0U,
+			XPLMI_TL_TIMER_RESET_VALUE);
+#endif
 END:
 	/**
 	 * This is used to identify PLM has completed boot PDI
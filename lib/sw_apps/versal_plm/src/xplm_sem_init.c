@@ -35,6 +35,8 @@
 * Ver   Who  Date        Changes
 * ====  ==== ======== ======================================================-
 * 1.00  rm   09/22/2019 Initial release
+* 1.01  adk  10/15/2019 Run the NPI scan with a duty cycle, allow pausing it
+*                       and keep its statistics
 *
 * </pre>
 *
@@ -47,16 +49,29 @@
 #include "xplmi_scheduler.h"
 #include "xilsem.h"
 #include "xplm_default.h"
+#include "xplmi_timeline.h"
 
 /************************** Constant Definitions *****************************/
+#define XSEM_SCAN_TICK_US	(XPLMI_SCHED_TICK_MS * 1000U)
 
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
+#ifdef XSEM_NPISCAN_EN
+static int XSem_NpiScanTask(void);
+#endif
 
 /************************** Variable Definitions *****************************/
+static struct {
+	u32 DutyCycle;		/* Percent of the PMC time for the scan */
+	u32 PauseCount;		/* Nested pauses */
+	u32 SkipTicks;		/* Scheduler periods left before the next scan */
+	XSem_ScanStats Stats;
+} ScanCtrl = {
+	.DutyCycle = XSEM_SCAN_DUTY_CYCLE_DEFAULT,
+};
 
 /*****************************************************************************/
 
@@ -85,7 +100,8 @@ int XSem_Init(void)
 	if (Status != XST_SUCCESS) {
 		goto END;
 	} else {
-		Status = XPlmi_SchedulerAddTask(XSem_NpiRunScan, 100U);
+		Status = XPlmi_SchedulerAddTask(XSem_NpiScanTask,
+				XPLMI_SCHED_TICK_MS);
 	}
 END:
 
@@ -93,3 +109,137 @@ END:
 	return Status;
 }
 
+
+#ifdef XSEM_NPISCAN_EN
+/*****************************************************************************/
+/**
+ * @brief This function is called by the scheduler every scheduler period and
+ * runs the NPI scan, unless the scan is paused or the duty cycle requires
+ * idle periods after the previous scan.
+ *
+ * @param	None
+ *
+ * @return	Status of the scan, XST_SUCCESS when no scan is run
+ *
+ *****************************************************************************/
+static int XSem_NpiScanTask(void)
+{
+	int Status = XST_SUCCESS;
+	u32 StartTicks;
+	u32 ScanTime;
+	u32 TicksPerUs;
+	u64 PeriodUs;
+
+	if ((ScanCtrl.PauseCount != 0U) || (ScanCtrl.SkipTicks != 0U)) {
+		if (ScanCtrl.SkipTicks != 0U) {
+			ScanCtrl.SkipTicks--;
+		}
+		ScanCtrl.Stats.SkipCount++;
+		goto END;
+	}
+
+	StartTicks = XPlmi_TlGetTicks();
+	Status = XSem_NpiRunScan();
+	/* PLM timer decrements */
+	ScanTime = StartTicks - XPlmi_TlGetTicks();
+	TicksPerUs = XPlmi_GetPmcIroFreq() / 1000000U;
+	if (TicksPerUs != 0U) {
+		ScanTime /= TicksPerUs;
+	}
+
+	ScanCtrl.Stats.ScanCount++;
+	ScanCtrl.Stats.LastScanTime = ScanTime;
+	ScanCtrl.Stats.TotalScanTime += ScanTime;
+	if (ScanTime > ScanCtrl.Stats.MaxScanTime) {
+		ScanCtrl.Stats.MaxScanTime = ScanTime;
+	}
+
+	/*
+	 * Skip the scheduler periods needed for the scan to take at most
+	 * DutyCycle percent of the time between two scans
+	 */
+	PeriodUs = ((u64)ScanTime * XSEM_SCAN_DUTY_CYCLE_MAX) /
+			ScanCtrl.DutyCycle;
+	ScanCtrl.SkipTicks = (u32)((PeriodUs + XSEM_SCAN_TICK_US - 1U) /
+			XSEM_SCAN_TICK_US);
+	if (ScanCtrl.SkipTicks != 0U) {
+		ScanCtrl.SkipTicks--;
+	}
+
+END:
+	return Status;
+}
+#endif
+
+/*****************************************************************************/
+/**
+ * @brief This function sets the share of the PMC time the NPI scan may take.
+ * The scan still runs at most once per scheduler period.
+ *
+ * @param	DutyCycle in percent, 1 to XSEM_SCAN_DUTY_CYCLE_MAX
+ *
+ * @return	XST_SUCCESS or XST_INVALID_PARAM
+ *
+ *****************************************************************************/
+int XSem_SetScanDutyCycle(u32 DutyCycle)
+{
+	int Status = XST_INVALID_PARAM;
+
+	if ((DutyCycle == 0U) || (DutyCycle > XSEM_SCAN_DUTY_CYCLE_MAX)) {
+		goto END;
+	}
+
+	ScanCtrl.DutyCycle = DutyCycle;
+	ScanCtrl.SkipTicks = 0U;
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function pauses the NPI scan, for latency critical operations
+ * like partial reconfiguration or PDI loads. The scans run from PLM tasks so
+ * no scan is in progress when this is called from another task. Pauses nest.
+ *
+ * @param	None
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XSem_PauseScan(void)
+{
+	ScanCtrl.PauseCount++;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function ends a pause of the NPI scan. The scan restarts at
+ * the next scheduler period once all the pauses are ended.
+ *
+ * @param	None
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XSem_ResumeScan(void)
+{
+	if (ScanCtrl.PauseCount != 0U) {
+		ScanCtrl.PauseCount--;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function returns the NPI scan statistics.
+ *
+ * @param	Stats is filled with the statistics
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XSem_GetScanStats(XSem_ScanStats *Stats)
+{
+	*Stats = ScanCtrl.Stats;
+}
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ====  ==== ======== ======================================================-
 * 1.00  rm   09/22/2019 Initial release
+* 1.01  adk  10/15/2019 Added NPI scan duty cycle, pause and statistics
 *
 * </pre>
 *
@@ -49,16 +50,31 @@ extern "C" {
 #endif
 
 /***************************** Include Files *********************************/
-
+#include "xil_types.h"
 
 /************************** Constant Definitions *****************************/
+/* Share of the PMC time the NPI scan may take, in percent */
+#define XSEM_SCAN_DUTY_CYCLE_MAX	(100U)
+#define XSEM_SCAN_DUTY_CYCLE_DEFAULT	XSEM_SCAN_DUTY_CYCLE_MAX
 
 /**************************** Type Definitions *******************************/
+/* NPI scan statistics, the times are in us */
+typedef struct {
+	u32 ScanCount;		/* Scans run */
+	u32 SkipCount;		/* Scheduler periods without a scan */
+	u32 LastScanTime;	/* Time of the last scan */
+	u32 MaxScanTime;	/* Longest scan */
+	u64 TotalScanTime;	/* Sum of the scans */
+} XSem_ScanStats;
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 int XSem_Init(void);
+int XSem_SetScanDutyCycle(u32 DutyCycle);
+void XSem_PauseScan(void);
+void XSem_ResumeScan(void);
+void XSem_GetScanStats(XSem_ScanStats *Stats);
 
 /************************** Variable Definitions *****************************/
 
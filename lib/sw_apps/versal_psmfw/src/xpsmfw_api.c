@@ -85,18 +85,54 @@ done:
 	return Status;
 }
 
+/****************************************************************************/
+/**
+ * @brief	Read power transition counters of a processor into a response
+ *
+ * @param DeviceId	Device ID of processor
+ * @param Response	IPI response, counters are stored from Response[1]
+ *
+ * @return	XST_SUCCESS or error code
+ *
+ * @note	None
+ *
+ ****************************************************************************/
+static XStatus XPsmFw_PwrStatsResponse(u32 DeviceId, u32 *Response)
+{
+	XStatus Status;
+	struct XPsmFwPwrStats_t Stats;
+
+	Status = XPsmFw_GetPwrStats(DeviceId, &Stats);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+
+	Response[1] = Stats.PwrUpCount;
+	Response[2] = Stats.PwrUpLastCycles;
+	Response[3] = Stats.PwrUpMaxCycles;
+	Response[4] = Stats.PwrDwnCount;
+	Response[5] = Stats.PwrDwnLastCycles;
+	Response[6] = Stats.PwrDwnMaxCycles;
+
+done:
+	return Status;
+}
+
 /****************************************************************************/
 /**
  * @brief	Process IPI commands
  *
  * @param Payload	API ID and call arguments
+ * @param Response	Response words following the status, filled by
+ *			commands which return data
  *
  * @return	XST_SUCCESS or error code
  *
- * @note	None
+ * @note	Batched power up/down commands carry the number of processors
+ *		in Payload[1] followed by their device IDs.
  *
  ****************************************************************************/
-XStatus XPsmFw_ProcessIpi(u32 *Payload)
+XStatus XPsmFw_ProcessIpi(u32 *Payload, u32 *Response)
 {
 	XStatus Status = XST_FAILURE;
 	u32 ApiId = Payload[0];
@@ -111,6 +147,23 @@ XStatus XPsmFw_ProcessIpi(u32 *Payload)
 		case PSM_API_FPD_HOUSECLEAN:
 			Status = XPsmFw_FpHouseClean(Payload[1]);
 			break;
+		case PSM_API_GET_PWR_STATS:
+			Status = XPsmFw_PwrStatsResponse(Payload[1], Response);
+			break;
+		case PSM_API_BATCH_PWR_DWN:
+			if (Payload[1] > (PAYLOAD_ARG_CNT - 2U)) {
+				Status = XST_INVALID_PARAM;
+				break;
+			}
+			Status = XPsmFw_DirectPwrDwnBatch(&Payload[2], Payload[1]);
+			break;
+		case PSM_API_BATCH_PWR_UP:
+			if (Payload[1] > (PAYLOAD_ARG_CNT - 2U)) {
+				Status = XST_INVALID_PARAM;
+				break;
+			}
+			Status = XPsmFw_DirectPwrUpBatch(&Payload[2], Payload[1]);
+			break;
 		default:
 			Status = XST_INVALID_PARAM;
 			break;
@@ -88,6 +88,9 @@ extern "C" {
 #define PSM_API_DIRECT_PWR_DWN	(1U)
 #define PSM_API_DIRECT_PWR_UP	(2U)
 #define PSM_API_FPD_HOUSECLEAN	(3U)
+#define PSM_API_GET_PWR_STATS	(4U)
+#define PSM_API_BATCH_PWR_DWN	(5U)
+#define PSM_API_BATCH_PWR_UP	(6U)
 
 /**
  *  PM init node functions
@@ -104,7 +107,7 @@ enum XPmInitFunctions {
 
 XStatus XPsmFw_PowerDownEvent(u32 DevId);
 XStatus XPsmFw_WakeEvent(u32 DevId);
-XStatus XPsmFw_ProcessIpi(u32 *Payload);
+XStatus XPsmFw_ProcessIpi(u32 *Payload, u32 *Response);
 
 #ifdef __cplusplus
 }
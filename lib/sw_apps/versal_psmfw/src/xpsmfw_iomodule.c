@@ -36,6 +36,7 @@
 * Ver	Who		Date		Changes
 * ---- ---- -------- ------------------------------
 * 1.00  ma   04/09/2018 Initial release
+* 1.01  adk  10/15/2019 Free running cycle counter on PIT4
 *
 * </pre>
 *
@@ -52,7 +53,11 @@
 
 #define XPSMFW_MB_MSR_BIP_MASK		(0x8U)
 
+/* PIT used as free running cycle counter (PIT4) */
+#define XPSMFW_CYCLE_TIMER		(3U)
+
 static XIOModule IOModule;
+static u32 CycleTimerMask;
 
 static void XPsmFw_IpiHandler(void)
 {
@@ -181,6 +186,8 @@ int XPsmFw_IoModuleInit(u32 DeviceId)
         goto END;
     }
 
+	XPsmFw_CycleTimerInit();
+
 	Status = SetUpInterruptSystem();
 	if (Status != XST_SUCCESS) {
 		XPsmFw_Printf(DEBUG_ERROR,
@@ -257,6 +264,64 @@ int SetUpInterruptSystem(void)
     return XST_SUCCESS;
 }
 
+/**
+ * XPsmFw_CycleTimerInit() - Start the free running cycle counter
+ *
+ * The counter is only started when the PIT is present and readable,
+ * otherwise XPsmFw_GetCycles() returns 0.
+ */
+void XPsmFw_CycleTimerInit(void)
+{
+	XIOModule_Config *CfgPtr = IOModule.CfgPtr;
+
+	if ((0U == CfgPtr->PitUsed[XPSMFW_CYCLE_TIMER]) ||
+	    (0U == CfgPtr->PitReadable[XPSMFW_CYCLE_TIMER])) {
+		XPsmFw_Printf(DEBUG_DETAILED, "No cycle counter\r\n");
+		goto done;
+	}
+
+	XIOModule_Timer_Stop(&IOModule, XPSMFW_CYCLE_TIMER);
+	XIOModule_SetResetValue(&IOModule, XPSMFW_CYCLE_TIMER,
+				CfgPtr->PitMask[XPSMFW_CYCLE_TIMER]);
+	XIOModule_Timer_SetOptions(&IOModule, XPSMFW_CYCLE_TIMER,
+				   XTC_AUTO_RELOAD_OPTION);
+	XIOModule_Timer_Start(&IOModule, XPSMFW_CYCLE_TIMER);
+	CycleTimerMask = CfgPtr->PitMask[XPSMFW_CYCLE_TIMER];
+
+done:
+	return;
+}
+
+/**
+ * XPsmFw_GetCycles() - Read the free running cycle counter
+ *
+ * @return	Number of PSM clock cycles, wraps at the PIT width
+ */
+u32 XPsmFw_GetCycles(void)
+{
+	u32 Cycles = 0U;
+
+	if (0U != CycleTimerMask) {
+		/* PIT counts down from its reset value */
+		Cycles = ~XIOModule_GetValue(&IOModule, XPSMFW_CYCLE_TIMER) &
+			 CycleTimerMask;
+	}
+
+	return Cycles;
+}
+
+/**
+ * XPsmFw_CyclesSince() - Cycles elapsed since a previous counter reading
+ *
+ * @Start	Value returned by XPsmFw_GetCycles()
+ *
+ * @return	Number of PSM clock cycles since Start
+ */
+u32 XPsmFw_CyclesSince(u32 Start)
+{
+	return (XPsmFw_GetCycles() - Start) & CycleTimerMask;
+}
+
 /**
  * XPsmFw_IntrHandler() - Interrupt handler
  *
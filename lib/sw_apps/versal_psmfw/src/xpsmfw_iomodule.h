@@ -258,6 +258,9 @@ extern "C" {
 int XPsmFw_IoModuleInit(u32 DeviceId);
 int SetUpInterruptSystem(void);
 void XPsmFw_IntrHandler(void *IntrNumber);
+void XPsmFw_CycleTimerInit(void);
+u32 XPsmFw_GetCycles(void);
+u32 XPsmFw_CyclesSince(u32 Start);
 
 #ifdef __cplusplus
 }
@@ -36,6 +36,7 @@
 * Ver	Who		Date		Changes
 * ---- ---- -------- ------------------------------
 * 1.00  ma   04/09/2018 Initial release
+* 1.01  adk  10/15/2019 Commands can return data in the IPI response
 *
 * </pre>
 *
@@ -95,7 +96,7 @@ int XPsmFw_DispatchIpiHandler(u32 SrcMask)
 	int Status;
 	u32 MaskIndex;
 	u32 Payload[XPSMFW_IPI_MAX_MSG_LEN];
-	u32 Response[XPSMFW_IPI_MAX_MSG_LEN];
+	u32 Response[XPSMFW_IPI_MAX_MSG_LEN] = {0U};
 
 	XPsmFw_Printf(DEBUG_DETAILED, "In IPI handler\r\n");
 
@@ -106,7 +107,7 @@ int XPsmFw_DispatchIpiHandler(u32 SrcMask)
 			if (XST_SUCCESS != Status) {
 				XPsmFw_Printf(DEBUG_ERROR, "Failure to read IPI msg\r\n");
 			} else {
-				Status = XPsmFw_ProcessIpi(&Payload[0]);
+				Status = XPsmFw_ProcessIpi(&Payload[0], &Response[0]);
 
 				Response[0] = Status;
 				XPsmFw_IpiSendResponse(IPI_PSM_IER_PMC_MASK,
@@ -36,6 +36,8 @@
 * Ver	Who	Date		Changes
 * ---- ---- -------- ------------------------------
 * 1.00	rp	07/13/2018 	Initial release
+* 1.01	adk	10/15/2019	Batched processor power up/down and
+*				transition cycle counters
 *
 * </pre>
 *
@@ -53,10 +55,14 @@
 #include "crl.h"
 #include "crf.h"
 #include "pmc_global.h"
+#include "xpsmfw_iomodule.h"
 #define CHECK_BIT(reg, mask)	((reg & mask) == mask)
 
 static u32 LocalPwrState;
 
+/* Direct power transition counters, indexed as in XPsmFwGetCore() */
+static struct XPsmFwPwrStats_t CorePwrStats[XPSMFW_NUM_CORES];
+
 static struct XPsmFwPwrCtrl_t Acpu0PwrCtrl = {
 	.PwrStateMask = PSM_LOCAL_PWR_STATE_ACPU0_MASK,
 	.PwrCtrlAddr = PSM_LOCAL_ACPU0_PWR_CNTRL,
@@ -431,6 +437,12 @@ static XStatus XPsmFwIslandPwrUp(struct XPsmFwPwrCtrl_t *Args)
 
 	/* Power up island */
 	for (Index = 0; Index < PSM_LOCAL_PWR_CTRL_GATES_WIDTH; Index++) {
+		/* Skip the stage if already powered, e.g. by a batched power up */
+		if (0U != (XPsmFw_Read32(Args->PwrStatusAddr) & (1U << Bit))) {
+			Bit++;
+			continue;
+		}
+
 		/* Enable this power stage */
 		XPsmFw_RMW32(Args->PwrCtrlAddr, (1 << Bit), (1 << Bit));
 
@@ -449,6 +461,59 @@ done:
 	return Status;
 }
 
+/**
+ * XPsmFwIslandPwrUpBatch() - Power up several islands in parallel
+ *
+ * @Args	Power control structures of the islands
+ * @Count	Number of islands
+ *
+ * @return	XST_SUCCESS or error code
+ *
+ * @note	Each power stage is enabled on all islands before the acks are
+ *		polled, and the ramp up wait is done once per stage for all
+ *		islands. Stages which are already powered are left as is.
+ */
+static XStatus XPsmFwIslandPwrUpBatch(struct XPsmFwPwrCtrl_t **Args, u32 Count)
+{
+	XStatus Status = XST_SUCCESS;
+	u32 Index;
+	u32 Stage;
+	u32 WaitTime;
+	u32 Bit = PSM_LOCAL_PWR_CTRL_GATES_SHIFT;
+
+	for (Stage = 0U; Stage < PSM_LOCAL_PWR_CTRL_GATES_WIDTH; Stage++) {
+		WaitTime = 0U;
+
+		/* Enable this power stage of all islands */
+		for (Index = 0U; Index < Count; Index++) {
+			if (0U != (XPsmFw_Read32(Args[Index]->PwrStatusAddr) & (1U << Bit))) {
+				continue;
+			}
+			XPsmFw_RMW32(Args[Index]->PwrCtrlAddr, (1U << Bit), (1U << Bit));
+			if (Args[Index]->PwrUpWaitTime[Stage] > WaitTime) {
+				WaitTime = Args[Index]->PwrUpWaitTime[Stage];
+			}
+		}
+
+		/* Poll the power stage status of all islands */
+		for (Index = 0U; Index < Count; Index++) {
+			Status = XPsmFw_UtilPollForMask(Args[Index]->PwrStatusAddr,
+					(1U << Bit), Args[Index]->PwrUpAckTimeout[Stage]);
+			if (XST_SUCCESS != Status) {
+				goto done;
+			}
+		}
+
+		/* Wait for power to ramp up on all islands */
+		XPsmFw_UtilWait(WaitTime);
+
+		Bit++;
+	}
+
+done:
+	return Status;
+}
+
 static XStatus XPsmFwACPUxPwrUp(struct XPsmFwPwrCtrl_t *Args, enum XPsmFWPwrUpDwnType Type)
 {
 	XStatus Status = XST_SUCCESS;
@@ -1513,33 +1578,37 @@ static XStatus R51Sleep(void)
 	return XPsmFw_PowerDownEvent(XPSMFW_DEV_RPU0_1);
 }
 
-/****************************************************************************/
 /**
- * @brief	Direct power down processor
+ * XPsmFwGetCore() - Get power control structure of a processor
  *
- * @param DeviceId	Device ID of processor
+ * @DeviceId	Device ID of processor
+ * @Args	Pointer to the location where the power control structure is
+ *		stored
+ * @Index	Pointer to the location where the processor index is stored
  *
- * @return	XST_SUCCESS or error code
- *
- * @note	None
- *
- ****************************************************************************/
-XStatus XPsmFw_DirectPwrDwn(const u32 DeviceId)
+ * @return	XST_SUCCESS or XST_INVALID_PARAM
+ */
+static XStatus XPsmFwGetCore(const u32 DeviceId, struct XPsmFwPwrCtrl_t **Args,
+			     u32 *Index)
 {
 	XStatus Status = XST_SUCCESS;
 
 	switch (DeviceId) {
 		case XPSMFW_DEV_ACPU_0:
-			Status = XPsmFwACPUxDirectPwrDwn(&Acpu0PwrCtrl);
+			*Args = &Acpu0PwrCtrl;
+			*Index = 0U;
 			break;
 		case XPSMFW_DEV_ACPU_1:
-			Status = XPsmFwACPUxDirectPwrDwn(&Acpu1PwrCtrl);
+			*Args = &Acpu1PwrCtrl;
+			*Index = 1U;
 			break;
 		case XPSMFW_DEV_RPU0_0:
-			Status = XPsmFwRPUxDirectPwrDwn(&Rpu0PwrCtrl);
+			*Args = &Rpu0PwrCtrl;
+			*Index = 2U;
 			break;
 		case XPSMFW_DEV_RPU0_1:
-			Status = XPsmFwRPUxDirectPwrDwn(&Rpu1PwrCtrl);
+			*Args = &Rpu1PwrCtrl;
+			*Index = 3U;
 			break;
 		default:
 			Status = XST_INVALID_PARAM;
@@ -1549,6 +1618,125 @@ XStatus XPsmFw_DirectPwrDwn(const u32 DeviceId)
 	return Status;
 }
 
+/**
+ * XPsmFwIsRpu() - Check if a power control structure belongs to a RPU core
+ *
+ * @Args	Power control structure
+ *
+ * @return	TRUE for RPU cores, FALSE otherwise
+ */
+static u32 XPsmFwIsRpu(const struct XPsmFwPwrCtrl_t *Args)
+{
+	return ((Args == &Rpu0PwrCtrl) || (Args == &Rpu1PwrCtrl)) ? TRUE : FALSE;
+}
+
+/**
+ * XPsmFwCoreDirectPwrDwn() - Direct power down processor
+ *
+ * @Args	Power control structure of the processor
+ *
+ * @return	XST_SUCCESS or error code
+ */
+static XStatus XPsmFwCoreDirectPwrDwn(struct XPsmFwPwrCtrl_t *Args)
+{
+	XStatus Status;
+
+	if (TRUE == XPsmFwIsRpu(Args)) {
+		Status = XPsmFwRPUxDirectPwrDwn(Args);
+	} else {
+		Status = XPsmFwACPUxDirectPwrDwn(Args);
+	}
+
+	return Status;
+}
+
+/**
+ * XPsmFwCoreDirectPwrUp() - Direct power up processor
+ *
+ * @Args	Power control structure of the processor
+ *
+ * @return	XST_SUCCESS or error code
+ */
+static XStatus XPsmFwCoreDirectPwrUp(struct XPsmFwPwrCtrl_t *Args)
+{
+	XStatus Status;
+
+	if (TRUE == XPsmFwIsRpu(Args)) {
+		Status = XPsmFwRPUxDirectPwrUp(Args);
+	} else {
+		Status = XPsmFwACPUxDirectPwrUp(Args);
+	}
+
+	return Status;
+}
+
+/**
+ * XPsmFwRecordPwrDwn() - Account a completed power down
+ *
+ * @Index	Processor index
+ * @Cycles	Duration of the power down in PSM clock cycles
+ */
+static void XPsmFwRecordPwrDwn(u32 Index, u32 Cycles)
+{
+	struct XPsmFwPwrStats_t *Stats = &CorePwrStats[Index];
+
+	Stats->PwrDwnCount++;
+	Stats->PwrDwnLastCycles = Cycles;
+	if (Cycles > Stats->PwrDwnMaxCycles) {
+		Stats->PwrDwnMaxCycles = Cycles;
+	}
+}
+
+/**
+ * XPsmFwRecordPwrUp() - Account a completed power up
+ *
+ * @Index	Processor index
+ * @Cycles	Duration of the power up in PSM clock cycles
+ */
+static void XPsmFwRecordPwrUp(u32 Index, u32 Cycles)
+{
+	struct XPsmFwPwrStats_t *Stats = &CorePwrStats[Index];
+
+	Stats->PwrUpCount++;
+	Stats->PwrUpLastCycles = Cycles;
+	if (Cycles > Stats->PwrUpMaxCycles) {
+		Stats->PwrUpMaxCycles = Cycles;
+	}
+}
+
+/****************************************************************************/
+/**
+ * @brief	Direct power down processor
+ *
+ * @param DeviceId	Device ID of processor
+ *
+ * @return	XST_SUCCESS or error code
+ *
+ * @note	None
+ *
+ ****************************************************************************/
+XStatus XPsmFw_DirectPwrDwn(const u32 DeviceId)
+{
+	XStatus Status;
+	struct XPsmFwPwrCtrl_t *Args;
+	u32 Index;
+	u32 Start;
+
+	Status = XPsmFwGetCore(DeviceId, &Args, &Index);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+
+	Start = XPsmFw_GetCycles();
+	Status = XPsmFwCoreDirectPwrDwn(Args);
+	if (XST_SUCCESS == Status) {
+		XPsmFwRecordPwrDwn(Index, XPsmFw_CyclesSince(Start));
+	}
+
+done:
+	return Status;
+}
+
 /****************************************************************************/
 /**
  * @brief	Direct power up processor
@@ -1561,25 +1749,158 @@ XStatus XPsmFw_DirectPwrDwn(const u32 DeviceId)
  *
  ****************************************************************************/
 XStatus XPsmFw_DirectPwrUp(const u32 DeviceId)
+{
+	XStatus Status;
+	struct XPsmFwPwrCtrl_t *Args;
+	u32 Index;
+	u32 Start;
+
+	Status = XPsmFwGetCore(DeviceId, &Args, &Index);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+
+	Start = XPsmFw_GetCycles();
+	Status = XPsmFwCoreDirectPwrUp(Args);
+	if (XST_SUCCESS == Status) {
+		XPsmFwRecordPwrUp(Index, XPsmFw_CyclesSince(Start));
+	}
+
+done:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+ * @brief	Direct power down of several processors
+ *
+ * @param DeviceIds	Device IDs of processors
+ * @param Count		Number of processors
+ *
+ * @return	XST_SUCCESS or the error code of the first failing processor
+ *
+ * @note	All processors are handled even if one of them fails. The
+ *		power down sequences share registers between cores (resets,
+ *		lock-step RPU), so they are done one after the other.
+ *
+ ****************************************************************************/
+XStatus XPsmFw_DirectPwrDwnBatch(const u32 *DeviceIds, u32 Count)
 {
 	XStatus Status = XST_SUCCESS;
+	XStatus CoreStatus;
+	u32 Idx;
 
-	switch (DeviceId) {
-		case XPSMFW_DEV_ACPU_0:
-			Status = XPsmFwACPUxDirectPwrUp(&Acpu0PwrCtrl);
-			break;
-		case XPSMFW_DEV_ACPU_1:
-			Status = XPsmFwACPUxDirectPwrUp(&Acpu1PwrCtrl);
-			break;
-		case XPSMFW_DEV_RPU0_0:
-			Status = XPsmFwRPUxDirectPwrUp(&Rpu0PwrCtrl);
-			break;
-		case XPSMFW_DEV_RPU0_1:
-			Status = XPsmFwRPUxDirectPwrUp(&Rpu1PwrCtrl);
-			break;
-		default:
-			Status = XST_INVALID_PARAM;
-			break;
+	if (Count > XPSMFW_NUM_CORES) {
+		Status = XST_INVALID_PARAM;
+		goto done;
+	}
+
+	for (Idx = 0U; Idx < Count; Idx++) {
+		CoreStatus = XPsmFw_DirectPwrDwn(DeviceIds[Idx]);
+		if ((XST_SUCCESS != CoreStatus) && (XST_SUCCESS == Status)) {
+			Status = CoreStatus;
+		}
+	}
+
+done:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+ * @brief	Direct power up of several processors
+ *
+ * @param DeviceIds	Device IDs of processors
+ * @param Count		Number of processors
+ *
+ * @return	XST_SUCCESS or the error code of the first failing processor
+ *
+ * @note	The power islands of the processors which are down are powered
+ *		up in parallel first, then the per core sequences (clocks,
+ *		isolation, resets) run one after the other. The cycles spent
+ *		on the islands are accounted to each processor.
+ *
+ ****************************************************************************/
+XStatus XPsmFw_DirectPwrUpBatch(const u32 *DeviceIds, u32 Count)
+{
+	XStatus Status = XST_SUCCESS;
+	XStatus CoreStatus;
+	struct XPsmFwPwrCtrl_t *Args[XPSMFW_NUM_CORES];
+	struct XPsmFwPwrCtrl_t *Islands[XPSMFW_NUM_CORES];
+	u32 Index[XPSMFW_NUM_CORES];
+	u32 NumIslands = 0U;
+	u32 IslandCycles;
+	u32 Start;
+	u32 Idx;
+
+	if (Count > XPSMFW_NUM_CORES) {
+		Status = XST_INVALID_PARAM;
+		goto done;
+	}
+
+	for (Idx = 0U; Idx < Count; Idx++) {
+		Status = XPsmFwGetCore(DeviceIds[Idx], &Args[Idx], &Index[Idx]);
+		if (XST_SUCCESS != Status) {
+			goto done;
+		}
+		if (CHECK_BIT(XPsmFw_Read32(PSM_GLOBAL_REG_PWR_STATE),
+			      Args[Idx]->PwrStateMask)) {
+			continue;
+		}
+		if (TRUE == XPsmFwIsRpu(Args[Idx])) {
+			/* Assert reset to RPU core before its island is powered */
+			XPsmFw_RMW32(CRL_RST_CPU_R5, Args[Idx]->RstCtrlMask,
+				     Args[Idx]->RstCtrlMask);
+		}
+		Islands[NumIslands] = Args[Idx];
+		NumIslands++;
+	}
+
+	Start = XPsmFw_GetCycles();
+	Status = XPsmFwIslandPwrUpBatch(Islands, NumIslands);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+	IslandCycles = XPsmFw_CyclesSince(Start);
+
+	for (Idx = 0U; Idx < Count; Idx++) {
+		Start = XPsmFw_GetCycles();
+		CoreStatus = XPsmFwCoreDirectPwrUp(Args[Idx]);
+		if (XST_SUCCESS == CoreStatus) {
+			XPsmFwRecordPwrUp(Index[Idx], IslandCycles +
+					  XPsmFw_CyclesSince(Start));
+		} else if (XST_SUCCESS == Status) {
+			Status = CoreStatus;
+		} else {
+			/* Required by MISRA */
+		}
+	}
+
+done:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+ * @brief	Get power transition counters of a processor
+ *
+ * @param DeviceId	Device ID of processor
+ * @param Stats		Pointer to the location where the counters are stored
+ *
+ * @return	XST_SUCCESS or XST_INVALID_PARAM
+ *
+ * @note	None
+ *
+ ****************************************************************************/
+XStatus XPsmFw_GetPwrStats(const u32 DeviceId, struct XPsmFwPwrStats_t *Stats)
+{
+	XStatus Status;
+	struct XPsmFwPwrCtrl_t *Args;
+	u32 Index;
+
+	Status = XPsmFwGetCore(DeviceId, &Args, &Index);
+	if (XST_SUCCESS == Status) {
+		*Stats = CorePwrStats[Index];
 	}
 
 	return Status;
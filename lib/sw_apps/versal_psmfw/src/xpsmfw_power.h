@@ -36,6 +36,8 @@
 * Ver	Who	Date		Changes
 * ---- ---- -------- ------------------------------
 * 1.00	rp	07/13/2018	Initial release
+* 1.01	adk	10/15/2019	Batched processor power up/down and
+*				transition cycle counters
 *
 * </pre>
 *
@@ -248,12 +250,39 @@ struct XPsmFwGemPwrCtrl_t {
         u32 RstCtrlMask;
 };
 
+/* Number of processors handled by direct power up/down */
+#define XPSMFW_NUM_CORES	(4U)
+
+/* Cycle counters of the direct power transitions of a processor */
+struct XPsmFwPwrStats_t {
+	/* Number of completed power ups */
+	u32 PwrUpCount;
+
+	/* Duration of the last power up, in PSM clock cycles */
+	u32 PwrUpLastCycles;
+
+	/* Longest power up, in PSM clock cycles */
+	u32 PwrUpMaxCycles;
+
+	/* Number of completed power downs */
+	u32 PwrDwnCount;
+
+	/* Duration of the last power down, in PSM clock cycles */
+	u32 PwrDwnLastCycles;
+
+	/* Longest power down, in PSM clock cycles */
+	u32 PwrDwnMaxCycles;
+};
+
 XStatus XPsmFw_DispatchPwrUpHandler(u32 PwrUpStatus, u32 PwrUpIntMask);
 XStatus XPsmFw_DispatchPwrDwnHandler(u32 PwrDwnStatus, u32 PwrDwnIntMask, u32 PwrUpStatus, u32 PwrUpIntMask);
 XStatus XPsmFw_DispatchWakeupHandler(u32 WakeupStatus, u32 WakeupIntMask);
 XStatus XPsmFw_DispatchPwrCtlHandler(u32 PwrCtlStatus, u32 PwrCtlIntMask);
 XStatus XPsmFw_DirectPwrDwn(const u32 DeviceId);
 XStatus XPsmFw_DirectPwrUp(const u32 DeviceId);
+XStatus XPsmFw_DirectPwrDwnBatch(const u32 *DeviceIds, u32 Count);
+XStatus XPsmFw_DirectPwrUpBatch(const u32 *DeviceIds, u32 Count);
+XStatus XPsmFw_GetPwrStats(const u32 DeviceId, struct XPsmFwPwrStats_t *Stats);
 int XPsmFw_FpdPreHouseClean();
 int XPsmFw_FpdPostHouseClean();
 int XPsmFw_FpdScanClear();
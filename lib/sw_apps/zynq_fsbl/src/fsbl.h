@@ -235,6 +235,7 @@
 * 17.00a bsv 27/03/18	Fix for CR# 996973  Add code under JTAG_ENABLE_LEVEL_SHIFTERS macro
 * 						to enable level shifters in jtag boot mode.
 * 18.00a ka  10/29/18   Fix for CR# 1006294 Added macro for FORCE_USE_AES_EXCLUDE
+* 19.00a adk 10/15/19   Added FSBL_STREAM_BITSTREAM flag
 *
 * </pre>
 *
@@ -306,6 +307,13 @@
 * Note : Changing the default behaviour is not recommended from
 * Security perspective.
 *
+* FSBL_STREAM_BITSTREAM
+* Defining this flag streams a bitstream with a checksum to PCAP while the
+* checksum is being computed, instead of computing the checksum first. The PL
+* may then be configured with a corrupted bitstream before FSBL falls back to
+* the next image. Signed bitstreams are always authenticated before the
+* download.
+*
 *******************************************************************************/
 #ifndef XIL_FSBL_H
 #define XIL_FSBL_H
@@ -69,6 +69,9 @@
 * 						encryption with E-Fuse - Enhancement
 * 11.00a ka 10/12/18    Fix for CR#1006294 Zynq FSBL - Zynq FSBL does not check
 * 						USE_AES_ONLY eFuse
+* 12.00a adk 10/15/19   Checksum partitions with the data cache enabled.
+* 						Under FSBL_STREAM_BITSTREAM, checksum an unsigned
+* 						bitstream while it streams to PCAP.
 *
 * </pre>
 *
@@ -90,15 +93,17 @@
 #include "xwdtps.h"
 #endif
 
+#include "xil_cache.h"
+
 #ifdef RSA_SUPPORT
 #include "rsa.h"
-#include "xil_cache.h"
 #endif
 /************************** Constant Definitions *****************************/
 
 /* We are 32-bit machine */
 #define MAXIMUM_IMAGE_WORD_LEN 0x40000000
 #define MD5_CHECKSUM_SIZE   16
+#define MD5_CHUNK_SIZE		0x100000 /* Bytes hashed between WDT restarts */
 
 /**************************** Type Definitions *******************************/
 
@@ -169,6 +174,9 @@ u32 LoadBootImage(void)
 	u32 PartitionStartAddr;
 	u32 PartitionChecksumOffset;
 	u8 ExecAddrFlag = 0 ;
+#ifdef FSBL_STREAM_BITSTREAM
+	u8 StreamFlag;
+#endif
 	u32 Status;
 	PartHeader *HeaderPtr;
 	u32 EfuseStatusRegValue;
@@ -477,6 +485,26 @@ u32 LoadBootImage(void)
 				PartitionStartAddr = PartitionLoadAddr;
 			}
 
+#ifdef FSBL_STREAM_BITSTREAM
+			/*
+			 * Unsigned bitstream is streamed to PCAP and the checksum
+			 * is computed meanwhile, a checksum failure falls back
+			 */
+			StreamFlag = PLPartitionFlag && (!SignedPartitionFlag);
+			if (StreamFlag) {
+				Status = PcapStartLoadPartition((u32*)PartitionStartAddr,
+						(u32*)PartitionLoadAddr,
+						PartitionImageLength,
+						PartitionDataLength,
+						EncryptedPartitionFlag);
+				if (Status != XST_SUCCESS) {
+					fsbl_printf(DEBUG_GENERAL,"BITSTREAM_DOWNLOAD_FAIL\r\n");
+					OutputStatus(BITSTREAM_DOWNLOAD_FAIL);
+					FsblFallback();
+				}
+			}
+#endif
+
 			if (PartitionChecksumFlag) {
 				/*
 				 * Validate the partition data with checksum
@@ -540,11 +568,18 @@ u32 LoadBootImage(void)
 			 * Load Signed PL partition in Fabric
 			 */
 			if (PLPartitionFlag) {
-				Status = PcapLoadPartition((u32*)PartitionStartAddr,
-						(u32*)PartitionLoadAddr,
-						PartitionImageLength,
-						PartitionDataLength,
-						EncryptedPartitionFlag);
+#ifdef FSBL_STREAM_BITSTREAM
+				if (StreamFlag) {
+					Status = PcapWaitLoadPartition();
+				} else
+#endif
+				{
+					Status = PcapLoadPartition((u32*)PartitionStartAddr,
+							(u32*)PartitionLoadAddr,
+							PartitionImageLength,
+							PartitionDataLength,
+							EncryptedPartitionFlag);
+				}
 				if (Status != XST_SUCCESS) {
 					fsbl_printf(DEBUG_GENERAL,"BITSTREAM_DOWNLOAD_FAIL\r\n");
 					OutputStatus(BITSTREAM_DOWNLOAD_FAIL);
@@ -1336,10 +1371,34 @@ u32 GetPartitionChecksum(u32 ChecksumOffset, u8 *Checksum)
 *******************************************************************************/
 u32 CalcPartitionChecksum(u32 SourceAddr, u32 DataLength, u8 *Checksum)
 {
+	MD5Context Context;
+	u32 Length;
+
 	/*
-	 * Calculate checksum using MD5 algorithm
+	 * Calculate checksum using MD5 algorithm. The data cache is enabled
+	 * for the hash, the data is only read so nothing has to be written
+	 * back to DDR.
 	 */
-	md5((u8*)SourceAddr, DataLength, Checksum, 0 );
+	Xil_DCacheEnable();
+
+	MD5Init(&Context);
+	while (DataLength > 0) {
+		Length = (DataLength > MD5_CHUNK_SIZE) ? MD5_CHUNK_SIZE : DataLength;
+		MD5Update(&Context, (u8*)SourceAddr, Length, 0);
+		SourceAddr += Length;
+		DataLength -= Length;
+
+#ifdef	XPAR_XWDTPS_0_BASEADDR
+		/*
+		 * Prevent WDT reset
+		 */
+		XWdtPs_RestartWdt(&Watchdog);
+#endif
+	}
+	MD5Final(&Context, Checksum, 0);
+
+	Xil_DCacheFlush();
+	Xil_DCacheDisable();
 
     return XST_SUCCESS;
 }
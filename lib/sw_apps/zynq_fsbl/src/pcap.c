@@ -79,6 +79,9 @@
 * 											In pcap.c, check pl power
 * 											through MCTRL register for
 * 											3.0 and later versions of silicon.
+* 19.00a adk 10/15/19   Split PcapLoadPartition() in a start and a wait
+* 						part so that the caller can work while the
+* 						bitstream streams to PCAP.
 * </pre>
 *
 * @note
@@ -235,10 +238,15 @@ u32 PcapDataTransfer(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 }
 
 
+#ifdef FSBL_PERF
+static XTime tLoadCur = 0;
+#endif
+
 /******************************************************************************/
 /**
 *
-* This function loads PL partition using PCAP
+* This function starts loading a PL partition using PCAP, and returns
+* without waiting for the transfer. PcapWaitLoadPartition completes it.
 *
 * @param 	SourceDataPtr is a pointer to where the data is read from
 * @param 	DestinationDataPtr is a pointer to where the data is written to
@@ -248,17 +256,16 @@ u32 PcapDataTransfer(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 * 			non-encrypted
 *
 * @return
-*		- XST_SUCCESS if the transfer is successful
-*		- XST_FAILURE if the transfer fails
+*		- XST_SUCCESS if the transfer is started
+*		- XST_FAILURE if the transfer cannot be started
 *
-* @note		 None
+* @note		The source data must not change until the transfer completes
 *
 ****************************************************************************/
-u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
+u32 PcapStartLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 		u32 SourceLength, u32 DestinationLength, u32 SecureTransfer)
 {
 	u32 Status;
-	u32 IntrStsReg;
 	u32 PcapTransferType = XDCFG_NON_SECURE_PCAP_WRITE;
 
 	/*
@@ -269,8 +276,7 @@ u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 	}
 
 #ifdef FSBL_PERF
-	XTime tXferCur = 0;
-	FsblGetGlobalTime(&tXferCur);
+	FsblGetGlobalTime(&tLoadCur);
 #endif
 
 	/*
@@ -327,6 +333,28 @@ u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 	 */
 	PcapDumpRegisters();
 
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function waits for the PL partition load started by
+* PcapStartLoadPartition
+*
+* @param 	None
+*
+* @return
+*		- XST_SUCCESS if the PL is configured
+*		- XST_FAILURE if the transfer or the configuration fails
+*
+* @note		 None
+*
+****************************************************************************/
+u32 PcapWaitLoadPartition(void)
+{
+	u32 Status;
+	u32 IntrStsReg;
 
 	/*
 	 * Poll for the DMA done
@@ -365,12 +393,45 @@ u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 #ifdef FSBL_PERF
 	XTime tXferEnd = 0;
 	fsbl_printf(DEBUG_GENERAL,"Time taken is ");
-	FsblMeasurePerfTime(tXferCur,tXferEnd);
+	FsblMeasurePerfTime(tLoadCur,tXferEnd);
 #endif
 
 	return XST_SUCCESS;
 }
 
+/******************************************************************************/
+/**
+*
+* This function loads PL partition using PCAP
+*
+* @param 	SourceDataPtr is a pointer to where the data is read from
+* @param 	DestinationDataPtr is a pointer to where the data is written to
+* @param 	SourceLength is the length of the data to be moved in words
+* @param 	DestinationLength is the length of the data to be moved in words
+* @param 	SecureTransfer indicated the encryption key location, 0 for
+* 			non-encrypted
+*
+* @return
+*		- XST_SUCCESS if the transfer is successful
+*		- XST_FAILURE if the transfer fails
+*
+* @note		 None
+*
+****************************************************************************/
+u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
+		u32 SourceLength, u32 DestinationLength, u32 SecureTransfer)
+{
+	u32 Status;
+
+	Status = PcapStartLoadPartition(SourceDataPtr, DestinationDataPtr,
+			SourceLength, DestinationLength, SecureTransfer);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return PcapWaitLoadPartition();
+}
+
 /******************************************************************************/
 /**
 *
@@ -42,6 +42,7 @@
 * 						Fabric Initialization sequence is modified to check
 * 						the PL power before sequence starts and checking INIT_B
 * 						reset status twice in case of failure.
+* 19.00a adk 10/15/19   Added PcapStartLoadPartition and PcapWaitLoadPartition
 * </pre>
 *
 * @note
@@ -90,6 +91,9 @@ u32 FabricInit(void);
 int XDcfgPollDone(u32 MaskValue, u32 MaxCount);
 u32 PcapLoadPartition(u32 *SourceData, u32 *DestinationData, u32 SourceLength,
 		 	u32 DestinationLength, u32 Flags);
+u32 PcapStartLoadPartition(u32 *SourceData, u32 *DestinationData,
+			u32 SourceLength, u32 DestinationLength, u32 Flags);
+u32 PcapWaitLoadPartition(void);
 u32 PcapDataTransfer(u32 *SourceData, u32 *DestinationData, u32 SourceLength,
  			u32 DestinationLength, u32 Flags);
 /************************** Variable Definitions *****************************/
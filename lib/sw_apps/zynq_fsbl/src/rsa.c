@@ -48,6 +48,8 @@
 *					 					 fallback unless FSBL* and FSBL are
 *					 					 identical in length
 *					 Fix for CR#791245 - Use of xilrsa in FSBL
+* 19.00a adk 10/15/19 Use rsa2048_pubexp_fast, the PPK and SPK stay prepared
+*                     between partitions
 * </pre>
 *
 * @note
@@ -249,7 +251,7 @@ u32 AuthenticatePartition(u8 *Buffer, u32 Size)
 	/*
 	 * Decrypt SPK Signature
 	 */
-	rsa2048_pubexp((RSA_NUMBER)DecryptSignature,
+	rsa2048_pubexp_fast((RSA_NUMBER)DecryptSignature,
 			(RSA_NUMBER)SignaturePtr,
 			(u32)PpkExp,
 			(RSA_NUMBER)PpkModular,
@@ -269,7 +271,7 @@ u32 AuthenticatePartition(u8 *Buffer, u32 Size)
 	/*
 	 * Decrypt Partition Signature
 	 */
-	rsa2048_pubexp((RSA_NUMBER)DecryptSignature,
+	rsa2048_pubexp_fast((RSA_NUMBER)DecryptSignature,
 			(RSA_NUMBER)SignaturePtr,
 			(u32)SpkExp,
 			(RSA_NUMBER)SpkModular,
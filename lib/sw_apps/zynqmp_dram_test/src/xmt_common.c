@@ -42,6 +42,7 @@
  *       mn   12/17/18 Limit VRefMin to minimum of 0 for 2D eye scan
  *       mn   07/01/19 Add support to specify number of iteration for memtest
  *       mn   09/09/19 Correct the DDR type name for LPDDR4
+ * 1.1   adk  10/15/19 Add the Performance Test to the help menu
  *
  * </pre>
  *
@@ -651,6 +652,7 @@ void XMt_PrintHelp(void)
 	xil_printf("   | '9' | Test first 8GB region of DDR                                 |\r\n");
 	xil_printf("   | 'm' | Test user specified size in MB of DDR                        |\r\n");
 	xil_printf("   | 'g' | Test user specified size in GB of DDR                        |\r\n");
+	xil_printf("   | 'p' | Perform a bandwidth and latency test (160MB)                 |\r\n");
 	xil_printf("   +-----+--------------------------------------------------------------+\r\n");
 	xil_printf("   |  Eye Tests                                                         |\r\n");
 	xil_printf("   +-----+--------------------------------------------------------------+\r\n");
@@ -39,6 +39,7 @@
  * ----- ---- -------- -------------------------------------------------------
  * 1.0   mn   08/17/18 Initial release
  *       mn   09/27/18 Modify code to add 2D Read/Write Eye Tests support
+ * 1.1   adk  10/15/19 Add DDR Performance Test support
  *
  * </pre>
  *
@@ -203,6 +204,9 @@ extern "C" {
 #define XMT_DDR_CONFIG_64BIT_WIDTH			64U
 #define XMT_DDR_CONFIG_32BIT_WIDTH			32U
 
+/* DDR used by the Performance Test: 32MB per A53 core and 32MB for ZDMA */
+#define XMT_PERF_TEST_SIZE			0xA000000U
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -321,6 +325,7 @@ void XMt_ResetVrefAuto(XMt_CfgData *XMtPtr);
 void XMt_Print2DEyeResults(XMt_CfgData *XMtPtr, u32 VRef);
 u32 XMt_GetVRefAutoMin(XMt_CfgData *XMtPtr);
 u32 XMt_GetVRefAutoMax(XMt_CfgData *XMtPtr);
+u32 XMt_RunPerfTest(XMt_CfgData *XMtPtr, u64 StartAddr);
 
 #ifdef __cplusplus
 }
@@ -42,6 +42,7 @@
  *       mn   09/27/18 Modify code to add 2D Read/Write Eye Tests support
  *       mn   04/09/19 Add check for Carriage return when entering the test size
  *       mn   07/01/19 Add support to specify number of iteration for memtest
+ * 1.1   adk  10/15/19 Add DDR Performance Test (bandwidth and latency)
  *
  * </pre>
  *
@@ -787,6 +788,18 @@ int main(void)
 				}
 			}
 
+		} else if ((Ch == 'p') || (Ch == 'P')) {
+			if ((StartAddr + XMT_PERF_TEST_SIZE) <= XMT_DDR_MAX_SIZE) {
+				for (Index = 0; Index < Iter; Index++) {
+					Status = XMt_RunPerfTest(&XMt, StartAddr);
+					if (Status != XST_SUCCESS) {
+						break;
+					}
+				}
+			} else {
+				xil_printf("\r\nPlease select the address within DDR range\r\n");
+			}
+
 		} else if ((Ch == 'a') || (Ch == 'A')) {
 			xil_printf("Test Start address = 0x%016lx\r\n", StartAddr);
 
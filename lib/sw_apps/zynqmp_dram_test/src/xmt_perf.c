@@ -0,0 +1,841 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+ ******************************************************************************/
+
+/*****************************************************************************/
+/**
+ *
+ * @file xmt_perf.c
+ *
+ * This is the file containing code for the DDR Performance Test. This
+ * measures the STREAM like Copy, Read and Write bandwidth from one, two and
+ * all the A53 cores, with and without a concurrent GDMA (ZDMA) copy, and the
+ * load to use latency of a random pointer chase over region sizes from 4KB
+ * to 64MB, which shows the L1, L2 and DDR boundaries.
+ *
+ * The results are printed under a DDR configuration ID, computed from the
+ * DDR controller and PHY timing registers, so that the runs made with the
+ * same DDR settings can be grouped together.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date        Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 1.1   adk  10/15/19 Initial release
+ *
+ * </pre>
+ *
+ * @note
+ * The secondary A53 cores are released from reset to run the bandwidth
+ * kernels only when the application runs at EL3. They stay parked in this
+ * application afterwards.
+ *
+ ******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xmt_common.h"
+#include "bspconfig.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XMT_PERF_NUM_CPUS		4U
+#define XMT_PERF_CPU_REGION		0x2000000U	/* DDR region per A53 */
+#define XMT_PERF_ARRAY_SIZE		0x1000000U	/* 16 times the L2 size */
+#define XMT_PERF_CHUNK_SIZE		0x100000U
+#define XMT_PERF_REPS			4U
+#define XMT_PERF_RUNS			3U
+#define XMT_PERF_STACK_SIZE		0x1000U	/* Matches XMt_PerfSecondaryEntry */
+#define XMT_PERF_TIMEOUT_SEC		5U
+
+#define XMT_PERF_LINE_SIZE		64U
+#define XMT_PERF_LAT_MIN_SIZE		0x1000U
+#define XMT_PERF_LAT_MAX_SIZE		0x4000000U
+#define XMT_PERF_LAT_LOADS		0x100000U
+
+#define XMT_PERF_KERNEL_IDLE		0U
+#define XMT_PERF_KERNEL_COPY		1U
+#define XMT_PERF_KERNEL_READ		2U
+#define XMT_PERF_KERNEL_WRITE		3U
+
+/* APU, CRF_APB and PMU_GLOBAL registers used to start the A53 cores */
+#define XMT_APU_RVBARADDR0L			0xFD5C0040
+#define XMT_APU_RVBARADDR0H			0xFD5C0044
+#define XMT_CRF_APB_RST_FPD_APU			0xFD1A0104
+#define XMT_RST_FPD_APU_ACPU0_RESET_MASK	0x00000001
+#define XMT_RST_FPD_APU_ACPU0_PWRON_RESET_MASK	0x00000400
+#define XMT_PMU_GLOBAL_REQ_PWRUP_STATUS		0xFFD80110
+#define XMT_PMU_GLOBAL_REQ_PWRUP_INT_EN		0xFFD80118
+#define XMT_PMU_GLOBAL_REQ_PWRUP_TRIG		0xFFD80120
+#define XMT_PMU_GLOBAL_PWR_STATE_ACPU0_MASK	0x00000001
+
+/* GDMA channel 0 registers */
+#define XMT_ZDMA_BASEADDR			0xFD500000
+#define XMT_ZDMA_CH_ISR				(XMT_ZDMA_BASEADDR + 0x100)
+#define XMT_ZDMA_CH_CTRL0			(XMT_ZDMA_BASEADDR + 0x110)
+#define XMT_ZDMA_CH_STATUS			(XMT_ZDMA_BASEADDR + 0x11C)
+#define XMT_ZDMA_CH_SRC_DSCR_WORD0		(XMT_ZDMA_BASEADDR + 0x128)
+#define XMT_ZDMA_CH_SRC_DSCR_WORD1		(XMT_ZDMA_BASEADDR + 0x12C)
+#define XMT_ZDMA_CH_SRC_DSCR_WORD2		(XMT_ZDMA_BASEADDR + 0x130)
+#define XMT_ZDMA_CH_SRC_DSCR_WORD3		(XMT_ZDMA_BASEADDR + 0x134)
+#define XMT_ZDMA_CH_DST_DSCR_WORD0		(XMT_ZDMA_BASEADDR + 0x138)
+#define XMT_ZDMA_CH_DST_DSCR_WORD1		(XMT_ZDMA_BASEADDR + 0x13C)
+#define XMT_ZDMA_CH_DST_DSCR_WORD2		(XMT_ZDMA_BASEADDR + 0x140)
+#define XMT_ZDMA_CH_DST_DSCR_WORD3		(XMT_ZDMA_BASEADDR + 0x144)
+#define XMT_ZDMA_CH_CTRL2			(XMT_ZDMA_BASEADDR + 0x200)
+#define XMT_ZDMA_CH_ISR_ALL_MASK		0x00000FFF
+#define XMT_ZDMA_CH_ISR_DMA_DONE_MASK		0x00000400
+#define XMT_ZDMA_CH_CTRL0_MODE_MASK		0x00000070
+#define XMT_ZDMA_CH_STATUS_BUSY			0x00000002
+#define XMT_ZDMA_CH_STATUS_MASK			0x00000003
+#define XMT_ZDMA_CH_CTRL2_EN_MASK		0x00000001
+
+/* DDR controller and PHY timing registers making the configuration ID */
+#define XMT_DDRC_RFSHTMG			0xFD070064
+#define XMT_DDRC_DRAMTMG0			0xFD070100
+#define XMT_DDRC_DRAMTMG_NUM			15U
+#define XMT_DDR_PHY_DTPR0			0xFD080110
+#define XMT_DDR_PHY_DTPR_NUM			7U
+
+/**************************** Type Definitions *******************************/
+
+/* Mailbox of one A53 core, on its own cache line */
+typedef struct {
+	volatile u32 Online;
+	volatile u32 Kernel;
+	volatile u32 Done;
+	volatile u32 Reserved;
+	volatile u64 Addr;
+	volatile u64 Start;
+	volatile u64 End;
+	volatile u64 Sum;
+} __attribute__((aligned(64))) XMt_PerfCore;
+
+/* Bandwidth of one run, in MB/s */
+typedef struct {
+	u32 Cpu;
+	u32 Zdma;
+} XMt_PerfResult;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+void XMt_PerfSecondaryEntry(void);
+void XMt_PerfSecondaryMain(u64 Cpu);
+
+/************************** Variable Definitions *****************************/
+
+static XMt_PerfCore XMt_PerfCores[XMT_PERF_NUM_CPUS];
+static volatile u32 XMt_PerfGo;
+static volatile u64 XMt_PerfSink;
+
+/* ZDMA state, owned by core 0 */
+static u64 XMt_PerfZdmaAddr;
+static u32 XMt_PerfZdmaRun;
+static u32 XMt_PerfZdmaBusy;
+static u32 XMt_PerfZdmaCount;
+static XTime XMt_PerfZdmaEnd;
+
+/*
+ * Used by XMt_PerfSecondaryEntry: the MAIR, TCR, TTBR0, SCTLR and VBAR
+ * values of core 0, and the stacks of the secondary A53 cores.
+ */
+u64 XMt_PerfSysRegs[5];
+u8 XMt_PerfStack[XMT_PERF_NUM_CPUS - 1U][XMT_PERF_STACK_SIZE]
+	__attribute__((aligned(16)));
+
+#if EL3 == 1
+/*
+ * Reset entry of the secondary A53 cores: enable SMP coherency and FP/SIMD,
+ * switch the MMU and caches on with the translation tables of core 0, then
+ * call XMt_PerfSecondaryMain with the core number.
+ */
+__asm__(
+	"	.pushsection .text\n"
+	"	.align 6\n"
+	"	.global XMt_PerfSecondaryEntry\n"
+	"	.type XMt_PerfSecondaryEntry, %function\n"
+	"XMt_PerfSecondaryEntry:\n"
+	"	mrs	x0, MPIDR_EL1\n"
+	"	and	x0, x0, #0xFF\n"
+	"	msr	CPTR_EL3, xzr\n"
+	"	mrs	x1, S3_1_c15_c2_1\n"
+	"	orr	x1, x1, #(1 << 6)\n"
+	"	msr	S3_1_c15_c2_1, x1\n"
+	"	isb\n"
+	"	ldr	x2, =XMt_PerfSysRegs\n"
+	"	ldr	x1, [x2, #0]\n"
+	"	msr	MAIR_EL3, x1\n"
+	"	ldr	x1, [x2, #8]\n"
+	"	msr	TCR_EL3, x1\n"
+	"	ldr	x1, [x2, #16]\n"
+	"	msr	TTBR0_EL3, x1\n"
+	"	ldr	x1, [x2, #32]\n"
+	"	msr	VBAR_EL3, x1\n"
+	"	tlbi	ALLE3\n"
+	"	ic	IALLU\n"
+	"	dsb	sy\n"
+	"	isb\n"
+	"	ldr	x1, [x2, #24]\n"
+	"	msr	SCTLR_EL3, x1\n"
+	"	dsb	sy\n"
+	"	isb\n"
+	"	ldr	x2, =XMt_PerfStack\n"
+	"	add	x2, x2, x0, lsl #12\n"
+	"	mov	sp, x2\n"
+	"	bl	XMt_PerfSecondaryMain\n"
+	"1:	wfe\n"
+	"	b	1b\n"
+	"	.ltorg\n"
+	"	.popsection\n"
+);
+#endif
+
+/*****************************************************************************/
+/**
+ * This function runs one chunk of a bandwidth kernel
+ *
+ * @param Kernel is the kernel to run
+ * @param Addr is the address of the A array, B follows it
+ * @param Offset is the offset of the chunk in the arrays
+ *
+ * @return Sum of the data read
+ *
+ * @note none
+ *****************************************************************************/
+static u64 XMt_PerfKernel(u32 Kernel, u64 Addr, u64 Offset)
+{
+	u64 *SrcPtr = (u64 *)(UINTPTR)(Addr + Offset);
+	u64 *DstPtr = (u64 *)(UINTPTR)(Addr + XMT_PERF_ARRAY_SIZE + Offset);
+	u64 Sum0 = 0U;
+	u64 Sum1 = 0U;
+	u64 Sum2 = 0U;
+	u64 Sum3 = 0U;
+	u32 Index;
+
+	if (Kernel == XMT_PERF_KERNEL_COPY) {
+		for (Index = 0U; Index < (XMT_PERF_CHUNK_SIZE / 8U); Index += 4U) {
+			DstPtr[Index] = SrcPtr[Index];
+			DstPtr[Index + 1U] = SrcPtr[Index + 1U];
+			DstPtr[Index + 2U] = SrcPtr[Index + 2U];
+			DstPtr[Index + 3U] = SrcPtr[Index + 3U];
+		}
+	} else if (Kernel == XMT_PERF_KERNEL_READ) {
+		for (Index = 0U; Index < (XMT_PERF_CHUNK_SIZE / 8U); Index += 4U) {
+			Sum0 += SrcPtr[Index];
+			Sum1 += SrcPtr[Index + 1U];
+			Sum2 += SrcPtr[Index + 2U];
+			Sum3 += SrcPtr[Index + 3U];
+		}
+	} else if (Kernel == XMT_PERF_KERNEL_WRITE) {
+		for (Index = 0U; Index < (XMT_PERF_CHUNK_SIZE / 8U); Index += 4U) {
+			DstPtr[Index] = Index;
+			DstPtr[Index + 1U] = Index;
+			DstPtr[Index + 2U] = Index;
+			DstPtr[Index + 3U] = Index;
+		}
+	}
+
+	return Sum0 + Sum1 + Sum2 + Sum3;
+}
+
+/*****************************************************************************/
+/**
+ * This function starts a ZDMA copy of one array
+ *
+ * @param none
+ *
+ * @return none
+ *
+ * @note none
+ *****************************************************************************/
+static void XMt_PerfZdmaStart(void)
+{
+	u64 DstAddr = XMt_PerfZdmaAddr + XMT_PERF_ARRAY_SIZE;
+
+	Xil_Out32(XMT_ZDMA_CH_ISR, XMT_ZDMA_CH_ISR_ALL_MASK);
+	Xil_Out32(XMT_ZDMA_CH_SRC_DSCR_WORD0, (u32)XMt_PerfZdmaAddr);
+	Xil_Out32(XMT_ZDMA_CH_SRC_DSCR_WORD1, (u32)(XMt_PerfZdmaAddr >> 32U));
+	Xil_Out32(XMT_ZDMA_CH_SRC_DSCR_WORD2, XMT_PERF_ARRAY_SIZE);
+	Xil_Out32(XMT_ZDMA_CH_SRC_DSCR_WORD3, 0U);
+	Xil_Out32(XMT_ZDMA_CH_DST_DSCR_WORD0, (u32)DstAddr);
+	Xil_Out32(XMT_ZDMA_CH_DST_DSCR_WORD1, (u32)(DstAddr >> 32U));
+	Xil_Out32(XMT_ZDMA_CH_DST_DSCR_WORD2, XMT_PERF_ARRAY_SIZE);
+	Xil_Out32(XMT_ZDMA_CH_DST_DSCR_WORD3, 0U);
+	Xil_Out32(XMT_ZDMA_CH_CTRL2, XMT_ZDMA_CH_CTRL2_EN_MASK);
+	XMt_PerfZdmaBusy = 1U;
+}
+
+/*****************************************************************************/
+/**
+ * This function counts the completed ZDMA copy and starts the next one while
+ * XMt_PerfZdmaRun is set
+ *
+ * @param none
+ *
+ * @return none
+ *
+ * @note none
+ *****************************************************************************/
+static void XMt_PerfZdmaPoll(void)
+{
+	if ((XMt_PerfZdmaBusy != 0U) &&
+	    ((Xil_In32(XMT_ZDMA_CH_ISR) & XMT_ZDMA_CH_ISR_DMA_DONE_MASK) != 0U)) {
+		XTime_GetTime(&XMt_PerfZdmaEnd);
+		XMt_PerfZdmaBusy = 0U;
+		XMt_PerfZdmaCount++;
+		if (XMt_PerfZdmaRun != 0U) {
+			XMt_PerfZdmaStart();
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * This function runs the bandwidth kernel selected in a core mailbox
+ *
+ * @param CorePtr is the pointer to the core mailbox
+ * @param PollZdma keeps the ZDMA busy between the chunks when non zero
+ *
+ * @return none
+ *
+ * @note none
+ *****************************************************************************/
+static void XMt_PerfExec(XMt_PerfCore *CorePtr, u32 PollZdma)
+{
+	XTime tStart;
+	XTime tEnd;
+	u64 Offset;
+	u64 Sum = 0U;
+	u32 Rep;
+
+	XTime_GetTime(&tStart);
+	for (Rep = 0U; Rep < XMT_PERF_REPS; Rep++) {
+		for (Offset = 0U; Offset < XMT_PERF_ARRAY_SIZE;
+		     Offset += XMT_PERF_CHUNK_SIZE) {
+			Sum += XMt_PerfKernel(CorePtr->Kernel, CorePtr->Addr,
+					      Offset);
+			if (PollZdma != 0U) {
+				XMt_PerfZdmaPoll();
+			}
+		}
+	}
+	XTime_GetTime(&tEnd);
+
+	CorePtr->Start = tStart;
+	CorePtr->End = tEnd;
+	CorePtr->Sum = Sum;
+}
+
+/*****************************************************************************/
+/**
+ * This is the main loop of the secondary A53 cores. It runs the kernel of
+ * the core mailbox each time core 0 advances XMt_PerfGo.
+ *
+ * @param Cpu is the core number
+ *
+ * @return none
+ *
+ * @note none
+ *****************************************************************************/
+void XMt_PerfSecondaryMain(u64 Cpu)
+{
+	XMt_PerfCore *CorePtr = &XMt_PerfCores[Cpu];
+	u32 Seq = XMt_PerfGo;
+
+	CorePtr->Done = Seq;
+	dsb();
+	CorePtr->Online = 1U;
+
+	while (1) {
+		while (XMt_PerfGo == Seq) {
+			;
+		}
+		Seq = XMt_PerfGo;
+		dsb();
+
+		if (CorePtr->Kernel != XMT_PERF_KERNEL_IDLE) {
+			XMt_PerfExec(CorePtr, 0U);
+		}
+
+		dsb();
+		CorePtr->Done = Seq;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * This function checks if a wait started at tStart has timed out
+ *
+ * @param tStart is the start time of the wait
+ *
+ * @return 1 on time out, 0 otherwise
+ *
+ * @note none
+ *****************************************************************************/
+static u32 XMt_PerfTimedOut(XTime tStart)
+{
+	XTime tCur;
+
+	XTime_GetTime(&tCur);
+
+	return ((tCur - tStart) >
+		((XTime)XMT_PERF_TIMEOUT_SEC * COUNTS_PER_SECOND)) ? 1U : 0U;
+}
+
+/*****************************************************************************/
+/**
+ * This function releases the secondary A53 cores from reset into
+ * XMt_PerfSecondaryEntry. Cores already out of reset are left alone.
+ *
+ * @param none
+ *
+ * @return Number of A53 cores available, including core 0
+ *
+ * @note none
+ *****************************************************************************/
+static u32 XMt_PerfStartCores(void)
+{
+	u32 NumCpus = 1U;
+#if EL3 == 1
+	u32 Cpu;
+	u32 RstVal;
+	u32 Mask;
+	XTime tStart;
+
+	XMt_PerfSysRegs[0] = mfcp(MAIR_EL3);
+	XMt_PerfSysRegs[1] = mfcp(TCR_EL3);
+	XMt_PerfSysRegs[2] = mfcp(TTBR0_EL3);
+	XMt_PerfSysRegs[3] = mfcp(SCTLR_EL3);
+	XMt_PerfSysRegs[4] = mfcp(VBAR_EL3);
+	/* Read by the cores before their caches are on */
+	Xil_DCacheFlushRange((INTPTR)XMt_PerfSysRegs, sizeof(XMt_PerfSysRegs));
+
+	for (Cpu = 1U; Cpu < XMT_PERF_NUM_CPUS; Cpu++) {
+		if (XMt_PerfCores[Cpu].Online != 0U) {
+			NumCpus++;
+			continue;
+		}
+
+		RstVal = Xil_In32(XMT_CRF_APB_RST_FPD_APU);
+		if ((RstVal & (XMT_RST_FPD_APU_ACPU0_RESET_MASK << Cpu)) == 0U) {
+			xil_printf("A53-%d is running other software, not used\r\n",
+				   Cpu);
+			continue;
+		}
+
+		Mask = XMT_PMU_GLOBAL_PWR_STATE_ACPU0_MASK << Cpu;
+		Xil_Out32(XMT_PMU_GLOBAL_REQ_PWRUP_INT_EN, Mask);
+		Xil_Out32(XMT_PMU_GLOBAL_REQ_PWRUP_TRIG, Mask);
+		XTime_GetTime(&tStart);
+		while ((Xil_In32(XMT_PMU_GLOBAL_REQ_PWRUP_STATUS) & Mask) != 0U) {
+			if (XMt_PerfTimedOut(tStart) != 0U) {
+				break;
+			}
+		}
+
+		Xil_Out32(XMT_APU_RVBARADDR0L + (Cpu * 8U),
+			  (u32)(UINTPTR)XMt_PerfSecondaryEntry);
+		Xil_Out32(XMT_APU_RVBARADDR0H + (Cpu * 8U),
+			  (u32)((u64)(UINTPTR)XMt_PerfSecondaryEntry >> 32U));
+		dsb();
+
+		RstVal &= ~((XMT_RST_FPD_APU_ACPU0_RESET_MASK |
+			     XMT_RST_FPD_APU_ACPU0_PWRON_RESET_MASK) << Cpu);
+		Xil_Out32(XMT_CRF_APB_RST_FPD_APU, RstVal);
+
+		XTime_GetTime(&tStart);
+		while (XMt_PerfCores[Cpu].Online == 0U) {
+			if (XMt_PerfTimedOut(tStart) != 0U) {
+				break;
+			}
+		}
+
+		if (XMt_PerfCores[Cpu].Online != 0U) {
+			NumCpus++;
+		} else {
+			xil_printf("A53-%d did not start\r\n", Cpu);
+		}
+	}
+#else
+	xil_printf("Not running at EL3, bandwidth is measured on A53-0 only\r\n");
+#endif
+
+	return NumCpus;
+}
+
+/*****************************************************************************/
+/**
+ * This function runs a bandwidth kernel on the first NumCpus cores and,
+ * optionally, a ZDMA copy at the same time. With NumCpus as 0, the ZDMA
+ * copy runs alone.
+ *
+ * @param StartAddr is the test start address
+ * @param Kernel is the kernel to run
+ * @param NumCpus is the number of A53 cores running the kernel
+ * @param UseZdma runs the ZDMA copy at the same time when non zero
+ * @param ResultPtr is the pointer to the measured bandwidths
+ *
+ * @return XST_SUCCESS or XST_FAILURE on time out
+ *
+ * @note none
+ *****************************************************************************/
+static u32 XMt_PerfRun(u64 StartAddr, u32 Kernel, u32 NumCpus, u32 UseZdma,
+		       XMt_PerfResult *ResultPtr)
+{
+	XMt_PerfCore *CorePtr;
+	XTime tStart;
+	XTime tZdma;
+	XTime tEnd = 0U;
+	u64 Bytes;
+	u32 Cpu;
+	u32 Seq;
+
+	ResultPtr->Cpu = 0U;
+	ResultPtr->Zdma = 0U;
+
+	for (Cpu = 1U; Cpu < XMT_PERF_NUM_CPUS; Cpu++) {
+		if (XMt_PerfCores[Cpu].Online != 0U) {
+			XMt_PerfCores[Cpu].Kernel = (Cpu < NumCpus) ? Kernel :
+						    XMT_PERF_KERNEL_IDLE;
+			XMt_PerfCores[Cpu].Addr = StartAddr +
+						  (Cpu * XMT_PERF_CPU_REGION);
+		}
+	}
+	XMt_PerfCores[0].Kernel = Kernel;
+	XMt_PerfCores[0].Addr = StartAddr;
+
+	if (UseZdma != 0U) {
+		XMt_PerfZdmaAddr = StartAddr +
+				   (XMT_PERF_NUM_CPUS * XMT_PERF_CPU_REGION);
+		XMt_PerfZdmaCount = 0U;
+		XMt_PerfZdmaRun = 1U;
+		XTime_GetTime(&tZdma);
+		XMt_PerfZdmaStart();
+	}
+
+	dsb();
+	Seq = XMt_PerfGo + 1U;
+	XMt_PerfGo = Seq;
+	dsb();
+
+	if (NumCpus != 0U) {
+		XMt_PerfExec(&XMt_PerfCores[0], UseZdma);
+	} else {
+		while (XMt_PerfZdmaCount < XMT_PERF_REPS) {
+			XMt_PerfZdmaPoll();
+			if (XMt_PerfTimedOut(tZdma) != 0U) {
+				goto TIMEOUT;
+			}
+		}
+	}
+
+	for (Cpu = 1U; Cpu < XMT_PERF_NUM_CPUS; Cpu++) {
+		CorePtr = &XMt_PerfCores[Cpu];
+		XTime_GetTime(&tStart);
+		while ((CorePtr->Online != 0U) && (CorePtr->Done != Seq)) {
+			if (UseZdma != 0U) {
+				XMt_PerfZdmaPoll();
+			}
+			if (XMt_PerfTimedOut(tStart) != 0U) {
+				goto TIMEOUT;
+			}
+		}
+	}
+
+	if (UseZdma != 0U) {
+		XMt_PerfZdmaRun = 0U;
+		XTime_GetTime(&tStart);
+		while (XMt_PerfZdmaBusy != 0U) {
+			XMt_PerfZdmaPoll();
+			if (XMt_PerfTimedOut(tStart) != 0U) {
+				goto TIMEOUT;
+			}
+		}
+		Bytes = 2U * (u64)XMt_PerfZdmaCount * XMT_PERF_ARRAY_SIZE;
+		ResultPtr->Zdma = (u32)(((double)Bytes * COUNTS_PER_SECOND) /
+				((double)(XMt_PerfZdmaEnd - tZdma) * XMT_MB2BYTE));
+	}
+
+	if (NumCpus != 0U) {
+		tStart = XMt_PerfCores[0].Start;
+		for (Cpu = 0U; Cpu < NumCpus; Cpu++) {
+			CorePtr = &XMt_PerfCores[Cpu];
+			XMt_PerfSink += CorePtr->Sum;
+			if (CorePtr->Start < tStart) {
+				tStart = CorePtr->Start;
+			}
+			if (CorePtr->End > tEnd) {
+				tEnd = CorePtr->End;
+			}
+		}
+		Bytes = (u64)NumCpus * XMT_PERF_REPS * XMT_PERF_ARRAY_SIZE;
+		if (Kernel == XMT_PERF_KERNEL_COPY) {
+			Bytes *= 2U;
+		}
+		ResultPtr->Cpu = (u32)(((double)Bytes * COUNTS_PER_SECOND) /
+				((double)(tEnd - tStart) * XMT_MB2BYTE));
+	}
+
+	return XST_SUCCESS;
+
+TIMEOUT:
+	XMt_PerfZdmaRun = 0U;
+	xil_printf("Bandwidth test timed out\r\n");
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+ * This function measures the load to use latency of a random pointer chase
+ * through all the cache lines of a region
+ *
+ * @param Addr is the region start address
+ * @param Size is the region size in bytes
+ *
+ * @return Latency per load in ps
+ *
+ * @note none
+ *****************************************************************************/
+static u32 XMt_PerfChase(u64 Addr, u64 Size)
+{
+	u64 *LinePtr = (u64 *)(UINTPTR)Addr;
+	u64 Lines = Size / XMT_PERF_LINE_SIZE;
+	u64 Step = XMT_PERF_LINE_SIZE / sizeof(u64);
+	u64 Seed = 0x2545F4914F6CDD1DU;
+	u64 Index;
+	u64 Rand;
+	u64 Tmp;
+	u64 Ptr;
+	XTime tStart;
+	XTime tEnd;
+
+	/*
+	 * Sattolo's shuffle of the line numbers makes a single random cycle
+	 * through all the lines, which the prefetchers cannot follow
+	 */
+	for (Index = 0U; Index < Lines; Index++) {
+		LinePtr[Index * Step] = Index;
+	}
+	for (Index = Lines - 1U; Index > 0U; Index--) {
+		Seed ^= Seed << 13U;
+		Seed ^= Seed >> 7U;
+		Seed ^= Seed << 17U;
+		Rand = Seed % Index;
+		Tmp = LinePtr[Index * Step];
+		LinePtr[Index * Step] = LinePtr[Rand * Step];
+		LinePtr[Rand * Step] = Tmp;
+	}
+	for (Index = 0U; Index < Lines; Index++) {
+		LinePtr[Index * Step] = Addr +
+			(LinePtr[Index * Step] * XMT_PERF_LINE_SIZE);
+	}
+
+	/* One pass to warm the caches up */
+	Ptr = Addr;
+	for (Index = 0U; Index < Lines; Index++) {
+		Ptr = *(u64 *)(UINTPTR)Ptr;
+	}
+
+	XTime_GetTime(&tStart);
+	for (Index = 0U; Index < XMT_PERF_LAT_LOADS; Index += 4U) {
+		Ptr = *(u64 *)(UINTPTR)Ptr;
+		Ptr = *(u64 *)(UINTPTR)Ptr;
+		Ptr = *(u64 *)(UINTPTR)Ptr;
+		Ptr = *(u64 *)(UINTPTR)Ptr;
+	}
+	XTime_GetTime(&tEnd);
+	XMt_PerfSink += Ptr;
+
+	return (u32)(((double)(tEnd - tStart) * 1000000000000.0) /
+		     ((double)COUNTS_PER_SECOND * XMT_PERF_LAT_LOADS));
+}
+
+/*****************************************************************************/
+/**
+ * This function prints the DDR configuration the results belong to
+ *
+ * @param XMtPtr is the pointer to the Memtest Data Structure
+ *
+ * @return none
+ *
+ * @note none
+ *****************************************************************************/
+static void XMt_PerfPrintConfig(XMt_CfgData *XMtPtr)
+{
+	u32 ConfigId;
+	u32 Index;
+
+	ConfigId = Xil_In32(XMT_DDRC_MSTR) ^ Xil_In32(XMT_DDRC_RFSHTMG);
+	for (Index = 0U; Index < XMT_DDRC_DRAMTMG_NUM; Index++) {
+		ConfigId = ((ConfigId << 5U) | (ConfigId >> 27U)) ^
+			   Xil_In32(XMT_DDRC_DRAMTMG0 + (Index * 4U));
+	}
+	for (Index = 0U; Index < XMT_DDR_PHY_DTPR_NUM; Index++) {
+		ConfigId = ((ConfigId << 5U) | (ConfigId >> 27U)) ^
+			   Xil_In32(XMT_DDR_PHY_DTPR0 + (Index * 4U));
+	}
+
+	xil_printf("\r\n========================================================\r\n");
+	XMt_PrintDdrConfigParams(XMtPtr);
+	xil_printf("DDR Configuration ID : 0x%08x\r\n", ConfigId);
+	xil_printf("DDR Frequency        : %d MHz\r\n", (u32)XMtPtr->DdrFreq);
+	xil_printf("ECC                  : %s\r\n",
+		   XMtPtr->EccEnabled ? "ENABLED" : "DISABLED");
+	xil_printf("D-cache              : %s\r\n",
+		   XMtPtr->DCacheEnable ? "enable" : "disable");
+	xil_printf("========================================================\r\n");
+}
+
+/*****************************************************************************/
+/**
+ * This function runs the DDR Performance Test: bandwidth from the A53 cores
+ * and the ZDMA, then latency across the region sizes.
+ *
+ * @param XMtPtr is the pointer to the Memtest Data Structure
+ * @param StartAddr is the test start address
+ *
+ * @return XST_SUCCESS or XST_FAILURE
+ *
+ * @note The test uses XMT_PERF_TEST_SIZE bytes of DDR from StartAddr
+ *****************************************************************************/
+u32 XMt_RunPerfTest(XMt_CfgData *XMtPtr, u64 StartAddr)
+{
+	XMt_PerfResult Best[3];
+	XMt_PerfResult Result;
+	u32 ZdmaSum;
+	u32 CpuCount[3];
+	u32 NumRows;
+	u32 NumCpus;
+	u32 UseZdma;
+	u32 Row;
+	u32 Kernel;
+	u32 Run;
+	u32 Latency;
+	u64 Size;
+	u32 Status;
+
+	XMt_PerfPrintConfig(XMtPtr);
+
+	NumCpus = XMt_PerfStartCores();
+
+	UseZdma = 1U;
+	if ((Xil_In32(XMT_ZDMA_CH_STATUS) & XMT_ZDMA_CH_STATUS_MASK) ==
+	    XMT_ZDMA_CH_STATUS_BUSY) {
+		xil_printf("GDMA channel 0 is busy, ZDMA not used\r\n");
+		UseZdma = 0U;
+	} else {
+		/* Simple mode, normal read and write */
+		Xil_Out32(XMT_ZDMA_CH_CTRL0, Xil_In32(XMT_ZDMA_CH_CTRL0) &
+			  ~XMT_ZDMA_CH_CTRL0_MODE_MASK);
+	}
+
+	/* Rows of 1, 2 and all the A53 cores */
+	CpuCount[0] = 1U;
+	CpuCount[1] = 2U;
+	CpuCount[2] = NumCpus;
+	NumRows = (NumCpus > 2U) ? 3U : NumCpus;
+
+	xil_printf("\r\nBandwidth (MB/s), best of %d runs\r\n", XMT_PERF_RUNS);
+	xil_printf("-------------+--------+--------+--------+--------\r\n");
+	xil_printf("  AGENTS     |  COPY  |  READ  | WRITE  |  ZDMA\r\n");
+	xil_printf("-------------+--------+--------+--------+--------\r\n");
+
+	for (Row = 0U; Row < (NumRows + (2U * UseZdma)); Row++) {
+		ZdmaSum = 0U;
+		for (Kernel = 0U; Kernel < 3U; Kernel++) {
+			Best[Kernel].Cpu = 0U;
+			Best[Kernel].Zdma = 0U;
+			for (Run = 0U; Run < XMT_PERF_RUNS; Run++) {
+				if (Row < NumRows) {
+					Status = XMt_PerfRun(StartAddr, Kernel + 1U,
+							CpuCount[Row], 0U, &Result);
+				} else if (Row == NumRows) {
+					Status = XMt_PerfRun(StartAddr, Kernel + 1U,
+							NumCpus, 1U, &Result);
+				} else {
+					Status = XMt_PerfRun(StartAddr,
+							XMT_PERF_KERNEL_IDLE, 0U, 1U,
+							&Result);
+				}
+				if (Status != XST_SUCCESS) {
+					return XST_FAILURE;
+				}
+				if (Result.Cpu > Best[Kernel].Cpu) {
+					Best[Kernel].Cpu = Result.Cpu;
+				}
+				if (Result.Zdma > Best[Kernel].Zdma) {
+					Best[Kernel].Zdma = Result.Zdma;
+				}
+			}
+			ZdmaSum += Best[Kernel].Zdma;
+			if (Row > NumRows) {
+				/* ZDMA alone does not depend on the kernel */
+				break;
+			}
+		}
+
+		if (Row < NumRows) {
+			xil_printf("  A53 x%d     | %6d | %6d | %6d |   -\r\n",
+				   CpuCount[Row], Best[0].Cpu, Best[1].Cpu,
+				   Best[2].Cpu);
+		} else if (Row == NumRows) {
+			/* ZDMA column is the average over the three kernels */
+			xil_printf("  A53 x%d+ZDMA| %6d | %6d | %6d | %6d\r\n",
+				   NumCpus, Best[0].Cpu, Best[1].Cpu,
+				   Best[2].Cpu, ZdmaSum / 3U);
+		} else {
+			xil_printf("  ZDMA       |   -    |   -    |   -    | %6d\r\n",
+				   ZdmaSum);
+		}
+	}
+	xil_printf("-------------+--------+--------+--------+--------\r\n");
+	xil_printf("  %d MB arrays per agent, COPY counts the bytes read and written\r\n",
+		   XMT_PERF_ARRAY_SIZE / XMT_MB2BYTE);
+
+	xil_printf("\r\nLatency (A53-0, random pointer chase, %d byte lines)\r\n",
+		   XMT_PERF_LINE_SIZE);
+	xil_printf("-------------+------------\r\n");
+	xil_printf("  REGION     |  ns/load\r\n");
+	xil_printf("-------------+------------\r\n");
+	for (Size = XMT_PERF_LAT_MIN_SIZE; Size <= XMT_PERF_LAT_MAX_SIZE;
+	     Size <<= 1U) {
+		Latency = XMt_PerfChase(StartAddr, Size);
+		if (Size < XMT_MB2BYTE) {
+			xil_printf("  %4d KB    | %4d.%02d\r\n",
+				   (u32)(Size / XMT_KB2BYTE), Latency / 1000U,
+				   (Latency % 1000U) / 10U);
+		} else {
+			xil_printf("  %4d MB    | %4d.%02d\r\n",
+				   (u32)(Size / XMT_MB2BYTE), Latency / 1000U,
+				   (Latency % 1000U) / 10U);
+		}
+	}
+	xil_printf("-------------+------------\r\n");
+
+	return XST_SUCCESS;
+}
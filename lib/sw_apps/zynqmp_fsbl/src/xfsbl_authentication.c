@@ -54,6 +54,12 @@
 * 6.0   vns  03/12/19 Modified function call XSecure_RsaDecrypt to
 *                     XSecure_RsaPublicEncrypt, as XSecure_RsaDecrypt is
 *                     deprecated.
+* 7.0   vns  10/14/19 Verified SPK is cached so that the SPK signature of
+*                     every partition is verified only once, and the
+*                     partition signature is decrypted while the partition
+*                     is hashed.
+*       adk  10/15/19 SPK key is kept loaded in the RSA core between
+*                     partitions signed with the same SPK.
 *
 * </pre>
 *
@@ -71,10 +77,19 @@
 u32 XFsbl_SpkVer(u64 AcOffset, u32 HashLen);
 u32 XFsbl_PpkVer(u64 AcOffset, u32 HashLen);
 void XFsbl_ReadPpkHash(u32 *PpkHash, u8 PpkSelect);
+static u32 XFsbl_SpkSignVer(u8 *AcPtr, u8 *SpkHash, u32 HashLen);
 /*****************************************************************************/
 
 static XSecure_Rsa SecureRsa;
 
+/*
+ * Hash of the authentication header and SPK that was last verified with
+ * the PPK. Partitions signed with the same SPK skip the RSA verification of
+ * the SPK signature.
+ */
+static u8 VerifiedSpkHash[XFSBL_HASH_TYPE_SHA3] __attribute__ ((aligned (4)))={0U};
+static u32 VerifiedSpkHashLen = 0U;
+
 #if defined(XFSBL_BS)
 extern u8 ReadBuffer[READ_BUFFER_SIZE];
 #endif
@@ -100,17 +115,11 @@ u8 EfusePpkKey[XFSBL_PPK_SIZE]__attribute__ ((aligned (32))) = {0U};
 u32 XFsbl_SpkVer(u64 AcOffset, u32 HashLen)
 {
 	u8 SpkHash[XFSBL_HASH_TYPE_SHA3] __attribute__ ((aligned (4)))={0};
-	u8* PpkModular;
-	u8* PpkModularEx;
-	u8* PpkExpPtr;
-	u32 PpkExp;
 	u8 * AcPtr = (u8*) (PTRSIZE) AcOffset;
 	u8 SpkIdFuseSel = ((*(u32 *)(AcPtr) & XFSBL_AH_ATTR_SPK_ID_FUSE_SEL_MASK)) >>
 		                                        XFSBL_AH_ATTR_SPK_ID_FUSE_SEL_SHIFT;
 	u32 Status;
 	void * ShaCtx = (void * )NULL;
-	u8 XFsbl_RsaSha3Array[512] = {0};
-	u8 *PpkKey = EfusePpkKey;
 	u32 EfuseRsa = XFsbl_In32(EFUSE_SEC_CTRL);
 	u32 EfuseSpkId;
 	u32 *SpkId = (u32 *)(AcPtr + XFSBL_SPKID_AC_ALIGN);
@@ -151,6 +160,97 @@ u32 XFsbl_SpkVer(u64 AcOffset, u32 HashLen)
 
 	XFsbl_ShaFinish(ShaCtx, (u8 *)SpkHash, HashLen);
 
+	/* Verify the SPK signature, unless this SPK is already verified */
+	if ((VerifiedSpkHashLen != HashLen) ||
+	    (XFsbl_CompareHashs(SpkHash, VerifiedSpkHash, HashLen) !=
+				XFSBL_SUCCESS)) {
+		Status = XFsbl_SpkSignVer(AcPtr, SpkHash, HashLen);
+		if (Status != XFSBL_SUCCESS) {
+			VerifiedSpkHashLen = 0U;
+			goto END;
+		}
+		(void)memcpy(VerifiedSpkHash, SpkHash, HashLen);
+		VerifiedSpkHashLen = HashLen;
+	}
+	else {
+		XFsbl_Printf(DEBUG_INFO, "XFsbl_SpkVer: SPK already verified\r\n");
+	}
+
+	/* SPK revocation check */
+	if ((EfuseRsa & EFUSE_SEC_CTRL_RSA_EN_MASK) != 0x00) {
+		EfuseSpkId = Xil_In32(EFUSE_SPKID);
+
+		/* If SPKID Efuse is selected , Verifies SPKID with Efuse SPKID*/
+		if (SpkIdFuseSel == XFSBL_SPKID_EFUSE) {
+			if (EfuseSpkId != *SpkId) {
+				Status = XFSBL_ERROR_SPKID_VERIFICATION;
+				XFsbl_Printf(DEBUG_INFO,
+						"Image's SPK ID : %x\n\r", SpkId);
+				XFsbl_Printf(DEBUG_INFO,
+						"eFUSE SPK ID: %x\n\r", EfuseSpkId);
+				XFsbl_Printf(DEBUG_GENERAL,
+						"XFsbl_SpkVer: "
+						"XFSBL_ERROR_SPKID_VERIFICATION\r\n");
+				goto END;
+			}
+		}
+		/*
+		 * If User EFUSE is selected, checks the corresponding User-Efuse bit
+		 * programmed or not. If Programmed (indicates that key is revocated)
+		 * throws an error
+		 */
+		else if (SpkIdFuseSel == XFSBL_USER_EFUSE) {
+			if ((*SpkId >= XFSBL_USER_EFUSE_MIN_VALUE) &&
+				(*SpkId <= XFSBL_USER_EFUSE_MAX_VALUE)) {
+				UserFuseAddr = XFSBL_USER_EFUSE_ADDR +
+								(((*SpkId - 1) / XFSBL_WORD_SHIFT) *
+											XFSBL_WORD_LEN_IN_BYTES);
+				UserFuseVal = Xil_In32(UserFuseAddr);
+				if ((UserFuseVal & (0x1U << ((*SpkId - 1) %
+									XFSBL_WORD_SHIFT))) != 0x0U) {
+					Status = XFSBL_ERROR_USER_EFUSE_ISREVOKED;
+					XFsbl_Printf(DEBUG_GENERAL,
+							"XFsbl_SpkVer: "
+							"XFSBL_ERROR_USER_EFUSE_ISREVOKED\r\n");
+					goto END;
+				}
+			}
+			else {
+				Status = XFSBL_ERROR_OUT_OF_RANGE_USER_EFUSE;
+				XFsbl_Printf(DEBUG_GENERAL,
+								"XFsbl_SpkVer: "
+								"XFSBL_ERROR_OUT_OF_RANGE_USER_EFUSE\r\n");
+				goto END;
+			}
+		}
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Verifies the SPK signature of an authentication certificate with the PPK
+ * saved at the boot header authentication.
+ *
+ * @param	AcPtr is the pointer to the authentication certificate
+ * @param	SpkHash is the hash of the authentication header and SPK
+ * @param	HashLen is the length of the hash
+ *
+ * @return	XFSBL_SUCCESS on success, else an error code
+ *
+ ******************************************************************************/
+static u32 XFsbl_SpkSignVer(u8 *AcPtr, u8 *SpkHash, u32 HashLen)
+{
+	u8* PpkModular;
+	u8* PpkModularEx;
+	u8* PpkExpPtr;
+	u32 PpkExp;
+	u32 Status;
+	u8 XFsbl_RsaSha3Array[512] = {0};
+	u8 *PpkKey = EfusePpkKey;
+
 	/* Set PPK pointer */
 	PpkModular = (u8 *)PpkKey;
 	PpkKey += XFSBL_PPK_MOD_SIZE;
@@ -208,54 +308,7 @@ u32 XFsbl_SpkVer(u64 AcOffset, u32 HashLen)
 		goto END;
 	}
 
-	/* SPK revocation check */
-	if ((EfuseRsa & EFUSE_SEC_CTRL_RSA_EN_MASK) != 0x00) {
-		EfuseSpkId = Xil_In32(EFUSE_SPKID);
-
-		/* If SPKID Efuse is selected , Verifies SPKID with Efuse SPKID*/
-		if (SpkIdFuseSel == XFSBL_SPKID_EFUSE) {
-			if (EfuseSpkId != *SpkId) {
-				Status = XFSBL_ERROR_SPKID_VERIFICATION;
-				XFsbl_Printf(DEBUG_INFO,
-						"Image's SPK ID : %x\n\r", SpkId);
-				XFsbl_Printf(DEBUG_INFO,
-						"eFUSE SPK ID: %x\n\r", EfuseSpkId);
-				XFsbl_Printf(DEBUG_GENERAL,
-						"XFsbl_SpkVer: "
-						"XFSBL_ERROR_SPKID_VERIFICATION\r\n");
-				goto END;
-			}
-		}
-		/*
-		 * If User EFUSE is selected, checks the corresponding User-Efuse bit
-		 * programmed or not. If Programmed (indicates that key is revocated)
-		 * throws an error
-		 */
-		else if (SpkIdFuseSel == XFSBL_USER_EFUSE) {
-			if ((*SpkId >= XFSBL_USER_EFUSE_MIN_VALUE) &&
-				(*SpkId <= XFSBL_USER_EFUSE_MAX_VALUE)) {
-				UserFuseAddr = XFSBL_USER_EFUSE_ADDR +
-								(((*SpkId - 1) / XFSBL_WORD_SHIFT) *
-											XFSBL_WORD_LEN_IN_BYTES);
-				UserFuseVal = Xil_In32(UserFuseAddr);
-				if ((UserFuseVal & (0x1U << ((*SpkId - 1) %
-									XFSBL_WORD_SHIFT))) != 0x0U) {
-					Status = XFSBL_ERROR_USER_EFUSE_ISREVOKED;
-					XFsbl_Printf(DEBUG_GENERAL,
-							"XFsbl_SpkVer: "
-							"XFSBL_ERROR_USER_EFUSE_ISREVOKED\r\n");
-					goto END;
-				}
-			}
-			else {
-				Status = XFSBL_ERROR_OUT_OF_RANGE_USER_EFUSE;
-				XFsbl_Printf(DEBUG_GENERAL,
-								"XFsbl_SpkVer: "
-								"XFSBL_ERROR_OUT_OF_RANGE_USER_EFUSE\r\n");
-				goto END;
-			}
-		}
-	}
+	Status = XFSBL_SUCCESS;
 
 END:
 	return Status;
@@ -293,6 +346,63 @@ static u32 XFsbl_PartitionSignVer(const XFsblPs *FsblInstancePtr, u64 PartitionO
 
 	XFsbl_Printf(DEBUG_INFO, "Doing Partition Sign verification\r\n");
 
+	/* Set SPK pointer */
+	AcPtr += (XFSBL_RSA_AC_ALIGN + XFSBL_PPK_SIZE);
+	SpkModular = AcPtr;
+	AcPtr += XFSBL_SPK_MOD_SIZE;
+	SpkModularEx = AcPtr;
+	AcPtr += XFSBL_SPK_MOD_EXT_SIZE;
+	SpkExp = *((u32 *)AcPtr);
+	AcPtr += XFSBL_RSA_AC_ALIGN;
+
+	/* Increment by  SPK Signature pointer */
+	AcPtr += XFSBL_SPK_SIG_SIZE;
+	/* Increment by  BHDR Signature pointer */
+	AcPtr += XFSBL_BHDR_SIG_SIZE;
+	if((SpkModular != NULL) && (SpkModularEx != NULL)) {
+	XFsbl_Printf(DEBUG_DETAILED,
+		"XFsbl_PartVer: Spk Mod %0x, Spk Mod Ex %0x, Spk Exp %0x\r\n",
+		SpkModular, SpkModularEx, SpkExp);
+		XFsbl_PrintArray(DEBUG_DETAILED, SpkModular, XFSBL_SPK_MOD_SIZE, "Spk Modular");
+		XFsbl_PrintArray(DEBUG_DETAILED, SpkModularEx, XFSBL_SPK_MOD_EXT_SIZE, "Spk ModularEx");
+		XFsbl_Printf(DEBUG_DETAILED, "Spk Exp %x\n\r", SpkExp);
+	}
+
+	/*
+	 * The SPK key loaded for the previous partition is still in the RSA
+	 * core unless an other key was used since, XFsbl_SpkVer then
+	 * verified this SPK is the same one
+	 */
+	if (XSecure_RsaIsKeyLoaded(&SecureRsa) == (u32)TRUE) {
+		XFsbl_Printf(DEBUG_INFO, "XFsbl_PartVer: SPK already loaded\r\n");
+		SecureRsa.ModExt = SpkModularEx;
+	}
+	else {
+		SStatus = XSecure_RsaInitialize(&SecureRsa, SpkModular,
+					SpkModularEx, (u8 *)&SpkExp);
+		if (SStatus != XFSBL_SUCCESS) {
+			Status = XFSBL_ERROR_RSA_INITIALIZE;
+			XFsbl_Printf(DEBUG_GENERAL,
+				"XFSBL_ERROR_RSA_INITIALIZE\r\n");
+			goto END;
+		}
+		(void)XSecure_RsaKeyLoad(&SecureRsa, XSECURE_RSA_4096_KEY_SIZE);
+	}
+
+	/*
+	 * Start the decryption of the partition signature. It does not depend
+	 * on the partition hash, so the RSA engine runs while the partition is
+	 * hashed.
+	 */
+	if(XFSBL_SUCCESS != XSecure_RsaOperationStart(&SecureRsa, AcPtr,
+				XSECURE_RSA_SIGN_ENC, XSECURE_RSA_4096_KEY_SIZE))
+	{
+		XFsbl_Printf(DEBUG_GENERAL,
+			"XFsbl_SpkVer: XFSBL_ERROR_PART_RSA_DECRYPT\r\n");
+		Status = XFSBL_ERROR_PART_RSA_DECRYPT;
+		goto END;
+	}
+
 	/**
 	 * total partition length to be hashed except the AC
 	 */
@@ -317,6 +427,9 @@ static u32 XFsbl_PartitionSignVer(const XFsblPs *FsblInstancePtr, u64 PartitionO
 		{
 			XFsbl_Printf(DEBUG_GENERAL,
 			"XFsbl_PartitionVer: XFSBL_ERROR_PART_RSA_DECRYPT\r\n");
+			/* Complete the RSA operation, it clears the RSA memory */
+			(void)XSecure_RsaOperationWait(&SecureRsa,
+					XFsbl_RsaSha3Array);
 			Status = XFSBL_ERROR_PART_RSA_DECRYPT;
 			goto END;
 		}
@@ -343,41 +456,12 @@ static u32 XFsbl_PartitionSignVer(const XFsblPs *FsblInstancePtr, u64 PartitionO
 
 	XFsbl_ShaFinish(ShaCtx, (u8 *)PartitionHash, HashLen);
 
-	/* Set SPK pointer */
-	AcPtr += (XFSBL_RSA_AC_ALIGN + XFSBL_PPK_SIZE);
-	SpkModular = AcPtr;
-	AcPtr += XFSBL_SPK_MOD_SIZE;
-	SpkModularEx = AcPtr;
-	AcPtr += XFSBL_SPK_MOD_EXT_SIZE;
-	SpkExp = *((u32 *)AcPtr);
-	AcPtr += XFSBL_RSA_AC_ALIGN;
-
-	/* Increment by  SPK Signature pointer */
-	AcPtr += XFSBL_SPK_SIG_SIZE;
-	/* Increment by  BHDR Signature pointer */
-	AcPtr += XFSBL_BHDR_SIG_SIZE;
-	if((SpkModular != NULL) && (SpkModularEx != NULL)) {
-	XFsbl_Printf(DEBUG_DETAILED,
-		"XFsbl_PartVer: Spk Mod %0x, Spk Mod Ex %0x, Spk Exp %0x\r\n",
-		SpkModular, SpkModularEx, SpkExp);
-		XFsbl_PrintArray(DEBUG_DETAILED, SpkModular, XFSBL_SPK_MOD_SIZE, "Spk Modular");
-		XFsbl_PrintArray(DEBUG_DETAILED, SpkModularEx, XFSBL_SPK_MOD_EXT_SIZE, "Spk ModularEx");
-		XFsbl_Printf(DEBUG_DETAILED, "Spk Exp %x\n\r", SpkExp);
-	}
 	XFsbl_Printf(DEBUG_INFO,
 			"Partition Verification done \r\n");
 
-	SStatus = XSecure_RsaInitialize(&SecureRsa, SpkModular,
-				SpkModularEx, (u8 *)&SpkExp);
-	if (SStatus != XFSBL_SUCCESS) {
-		Status = XFSBL_ERROR_RSA_INITIALIZE;
-		XFsbl_Printf(DEBUG_GENERAL, "XFSBL_ERROR_RSA_INITIALIZE\r\n");
-		goto END;
-	}
-	/* Decrypt Partition Signature. */
+	/* Get the decrypted Partition Signature. */
 	if(XFSBL_SUCCESS !=
-		XSecure_RsaPublicEncrypt(&SecureRsa, AcPtr, XSECURE_RSA_4096_KEY_SIZE,
-				XFsbl_RsaSha3Array))
+		XSecure_RsaOperationWait(&SecureRsa, XFsbl_RsaSha3Array))
 	{
 		XFsbl_Printf(DEBUG_GENERAL,
 			"XFsbl_SpkVer: XFSBL_ERROR_PART_RSA_DECRYPT\r\n");
@@ -730,6 +814,8 @@ u32 XFsbl_BhAuthentication(const XFsblPs * FsblInstancePtr, u8 *Data,
 	/* Copy PPK to global variable for future use */
 	XFsbl_MemCpy(EfusePpkKey, AcPtr + XFSBL_AUTH_CERT_PPK_OFFSET,
 						XFSBL_PPK_SIZE);
+	/* SPK verified with the previous PPK is no more valid */
+	VerifiedSpkHashLen = 0U;
 
 	/* SPK verify */
 	Status = XFsbl_SpkVer(AcOffset, HashLen);
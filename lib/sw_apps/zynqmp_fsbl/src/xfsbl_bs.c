@@ -40,6 +40,9 @@
  * 2.0   bv   12/05/16 Made compliance to MISRAC 2012 guidelines
  *                     Chunk for bitstream is been storing at bitstream_buffer
  *                     section
+ * 3.0   bv   10/14/19 Double buffered the chunked bitstream transfer so that
+ *                     the boot device read of a chunk overlaps with the
+ *                     PCAP transfer of the previous chunk
  *
  * </pre>
  *
@@ -59,6 +62,8 @@
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
+static void XFsbl_PcapDmaStart(u32 WrSize, u8 *WrAddr);
+static u32 XFsbl_PcapDmaWait(void);
 
 /************************** Variable Definitions *****************************/
 /* Global OCM buffer to store data chunks */
@@ -175,7 +180,8 @@ u32 XFsbl_PcapWaitForDone(void) {
 }
 
 /*****************************************************************************/
-/** This is the function to write data to PCAP interface
+/** This function starts the CSU DMA transfer of data to the PCAP interface,
+ * without waiting for it to complete
  *
  * @param	WrSize: Number of 32bit words that the DMA should write to
  *          the PCAP interface
@@ -185,9 +191,8 @@ u32 XFsbl_PcapWaitForDone(void) {
  * @return	None
  *
  *****************************************************************************/
-u32 XFsbl_WriteToPcap(u32 WrSize, u8 *WrAddr) {
+static void XFsbl_PcapDmaStart(u32 WrSize, u8 *WrAddr) {
 	u32 RegVal;
-	u32 Status;
 
 	/*
 	 * Setup the  SSS, setup the PCAP to receive from DMA source
@@ -199,6 +204,19 @@ u32 XFsbl_WriteToPcap(u32 WrSize, u8 *WrAddr) {
 
 	/* Setup the source DMA channel */
 	XCsuDma_Transfer(&CsuDma, XCSUDMA_SRC_CHANNEL, (PTRSIZE) WrAddr, WrSize, 0);
+}
+
+/*****************************************************************************/
+/** This function waits for the CSU DMA transfer started with
+ * XFsbl_PcapDmaStart to complete and for the PCAP to be idle
+ *
+ * @param	None
+ *
+ * @return	error status based on implemented functionality (SUCCESS by default)
+ *
+ *****************************************************************************/
+static u32 XFsbl_PcapDmaWait(void) {
+	u32 Status;
 
 	/* wait for the SRC_DMA to complete and the pcap to be IDLE */
 	XCsuDma_WaitForDone(&CsuDma, XCSUDMA_SRC_CHANNEL){}
@@ -208,11 +226,28 @@ u32 XFsbl_WriteToPcap(u32 WrSize, u8 *WrAddr) {
 
 	XFsbl_Printf(DEBUG_INFO, "DMA transfer done \r\n");
 	Status = XFsbl_PcapWaitForDone();
-	if (Status != XFSBL_SUCCESS) {
-		goto END;
-	}
 
-	END: return Status;
+	return Status;
+}
+
+/*****************************************************************************/
+/** This is the function to write data to PCAP interface
+ *
+ * @param	WrSize: Number of 32bit words that the DMA should write to
+ *          the PCAP interface
+ * @param   WrAddr: Linear memory space from where CSUDMA will read
+ *	        the data to be written to PCAP interface
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+u32 XFsbl_WriteToPcap(u32 WrSize, u8 *WrAddr) {
+	u32 Status;
+
+	XFsbl_PcapDmaStart(WrSize, WrAddr);
+	Status = XFsbl_PcapDmaWait();
+
+	return Status;
 }
 
 /*****************************************************************************/
@@ -266,24 +301,35 @@ u32 XFsbl_PLWaitForDone(void) {
 
 /*****************************************************************************/
 /** This is the function to download nonsebitstream to PL using chunking.
+ *
+ * ReadBuffer is used as two buffers of XFSBL_BS_CHUNK_SIZE. While a chunk
+ * is pushed to PCAP by the CSU DMA from one buffer, the next chunk is read
+ * from the boot device to the other buffer, so the transfer runs at the
+ * speed of the slower of the two.
  *
  * @param	None
  *
  * @return	error status based on implemented functionality(SUCCESS by default)
  *
+ * @note	The USB boot device copies with the CSU DMA, so for USB the
+ *		PCAP transfer is completed before the next chunk is read.
+ *
  *****************************************************************************/
 #ifndef XFSBL_PS_DDR
 u32 XFsbl_ChunkedBSTxfer(XFsblPs *FsblInstancePtr, u32 PartitionNum)
 {
 	u32 Status = XFSBL_SUCCESS;
+	u32 PcapStatus;
 	XFsblPs_PartitionHeader *PartitionHeader;
-	u32 NumChunks = 0U;
 	u32 RemainingBytes = 0U;
-	u32 Index = 0U;
+	u32 ChunkBytes = 0U;
 	u32 BitStreamSizeWord = 0U;
 	u32 BitStreamSizeByte = 0U;
 	u32 ImageOffset = 0U;
 	u32 StartAddrByte = 0U;
+	u8 *ChunkBuffer = ReadBuffer;
+	u32 IsPcapBusy = FALSE;
+	u32 IsCopyDma = FALSE;
 
 	XFsbl_Printf(DEBUG_GENERAL,
 		"Nonsecure Bitstream transfer in chunks to begin now\r\n");
@@ -305,35 +351,33 @@ u32 XFsbl_ChunkedBSTxfer(XFsblPs *FsblInstancePtr, u32 PartitionNum)
 
 	/* Converting size in words to bytes */
 	BitStreamSizeByte = BitStreamSizeWord*4;
+	RemainingBytes = BitStreamSizeByte;
 
-	NumChunks = BitStreamSizeByte / READ_BUFFER_SIZE;
-	RemainingBytes = BitStreamSizeByte % READ_BUFFER_SIZE;
+	/* The USB copy uses the CSU DMA that also feeds PCAP */
+	if ((FsblInstancePtr->PrimaryBootDevice == XFSBL_USB_BOOT_MODE) ||
+		(FsblInstancePtr->SecondaryBootDevice == XFSBL_USB_BOOT_MODE)) {
+		IsCopyDma = TRUE;
+	}
 
-	for(Index = 0; Index < NumChunks; Index++)
+	while (RemainingBytes != 0U)
 	{
-		Status = FsblInstancePtr->DeviceOps.DeviceCopy(StartAddrByte,
-				(PTRSIZE)ReadBuffer, READ_BUFFER_SIZE);
-
-		if (XFSBL_SUCCESS != Status)
-		{
-			XFsbl_Printf(DEBUG_GENERAL,
-				"Copy of chunk from flash to OCM failed \r\n");
-			goto END;
+		ChunkBytes = XFSBL_BS_CHUNK_SIZE;
+		if (RemainingBytes < ChunkBytes) {
+			ChunkBytes = RemainingBytes;
 		}
 
-		Status = XFsbl_WriteToPcap((READ_BUFFER_SIZE/4), &ReadBuffer[0]);
-		if (XFSBL_SUCCESS != Status)
-		{
-			goto END;
+		if ((IsCopyDma == TRUE) && (IsPcapBusy == TRUE)) {
+			IsPcapBusy = FALSE;
+			Status = XFsbl_PcapDmaWait();
+			if (XFSBL_SUCCESS != Status)
+			{
+				goto END;
+			}
 		}
 
-		StartAddrByte += READ_BUFFER_SIZE;
-	}
-
-	if(RemainingBytes != 0U)
-	{
+		/* Read this chunk while the previous one goes to PCAP */
 		Status = FsblInstancePtr->DeviceOps.DeviceCopy(StartAddrByte,
-					(PTRSIZE)ReadBuffer, RemainingBytes);
+				(PTRSIZE)ChunkBuffer, ChunkBytes);
 		if (XFSBL_SUCCESS != Status)
 		{
 			XFsbl_Printf(DEBUG_GENERAL,
@@ -341,10 +385,37 @@ u32 XFsbl_ChunkedBSTxfer(XFsblPs *FsblInstancePtr, u32 PartitionNum)
 			goto END;
 		}
 
-		Status = XFsbl_WriteToPcap((RemainingBytes/4), &ReadBuffer[0]);
+		if (IsPcapBusy == TRUE) {
+			IsPcapBusy = FALSE;
+			Status = XFsbl_PcapDmaWait();
+			if (XFSBL_SUCCESS != Status)
+			{
+				goto END;
+			}
+		}
+
+		XFsbl_PcapDmaStart((ChunkBytes/4U), ChunkBuffer);
+		IsPcapBusy = TRUE;
+
+		/* Switch to the other half of ReadBuffer */
+		if (ChunkBuffer == ReadBuffer) {
+			ChunkBuffer = &ReadBuffer[XFSBL_BS_CHUNK_SIZE];
+		}
+		else {
+			ChunkBuffer = ReadBuffer;
+		}
+		StartAddrByte += ChunkBytes;
+		RemainingBytes -= ChunkBytes;
 	}
 
 END:
+	/* Complete the last transfer, also on error to leave the DMA idle */
+	if (IsPcapBusy == TRUE) {
+		PcapStatus = XFsbl_PcapDmaWait();
+		if (Status == XFSBL_SUCCESS) {
+			Status = PcapStatus;
+		}
+	}
 	return Status;
 }
 #endif
@@ -40,6 +40,8 @@
 * 1.00  ba   11/17/14 Initial release
 * 2.0   bv   12/05/16 Made compliance to MISRAC 2012 guidelines
 *                     Modified bitstream chunk size to 56KB
+* 3.0   bv   10/14/19 Added XFSBL_BS_CHUNK_SIZE for the double buffered
+*                     bitstream transfer
 *
 * </pre>
 *
@@ -81,6 +83,10 @@ extern "C" {
 #define HASH_BUFFER_SIZE			(7*1024)
 					 /**< Buffer to store chunk's
 						hashes of each block. */
+#define XFSBL_BS_CHUNK_SIZE			(READ_BUFFER_SIZE/2U)
+					/**< Chunk size of the double
+					buffered non secure bitstream
+					transfer */
 
 /**************************** Type Definitions *******************************/
 
@@ -42,6 +42,10 @@
 *                     Added FSBL_PL_CLEAR_EXCLUDE_VAL, FSBL_USB_EXCLUDE_VAL,
 *                     FSBL_PROT_BYPASS_EXCLUDE_VAL configurations
 * 3.0   vns  03/07/18 Added FSBL_FORCE_ENC_EXCLUDE_VAL configuration
+*       adk  10/15/19 Added FSBL_ECC_BKGND_EXCLUDE_VAL configuration
+*       adk  10/15/19 Added XFSBL_NAND_BBT_CACHE_ADDRESS
+*       adk  10/15/19 Added FSBL_TIMELINE_EXCLUDE_VAL configuration and
+*                     XFSBL_TIMELINE_ADDRESS
 *</pre>
 *
 * @note
@@ -63,6 +67,22 @@ extern "C" {
 /* This is the address in DDR where boot.bin will be copied in USB boot mode */
 #define XFSBL_DDR_TEMP_BUFFER_ADDRESS			(0x4000000U)
 
+/*
+ * This is the address in DDR where the NAND bad block table is kept across
+ * warm boots, 0 to always search it in flash. The copy is not valid after a
+ * power on or when DDR ECC is initialized, the table is searched in flash
+ * then.
+ */
+#define XFSBL_NAND_BBT_CACHE_ADDRESS			(0x0U)
+
+/*
+ * This is the address in DDR where the boot timeline is copied at handoff,
+ * when FSBL_TIMELINE_EXCLUDE_VAL is 0. The OS finds it in
+ * PMU_GLOBAL_PERS_GLOB_GEN_STORAGE5 and must not use this memory before
+ * reading the timeline.
+ */
+#define XFSBL_TIMELINE_ADDRESS			(0x7FF00000U)
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -128,6 +148,10 @@ extern "C" {
  *     	 contains bitstream
  *     - FSBL_FORCE_ENC_EXCLUDE_VAL Forcing encryption for every partition
  *       when ENC only bit is blown will be excluded.
+ *     - FSBL_ECC_BKGND_EXCLUDE_VAL Background DDR ECC initialization will
+ *       be excluded, DDR ECC is initialized before loading the partitions.
+ *     - FSBL_TIMELINE_EXCLUDE_VAL Boot timeline recording and its copy to
+ *       XFSBL_TIMELINE_ADDRESS will be excluded
  */
 #define FSBL_NAND_EXCLUDE_VAL			(0U)
 #define FSBL_QSPI_EXCLUDE_VAL			(0U)
@@ -144,6 +168,8 @@ extern "C" {
 #define FSBL_PARTITION_LOAD_EXCLUDE_VAL (0U)
 #define FSBL_FORCE_ENC_EXCLUDE_VAL		(0U)
 #define FSBL_DDR_SR_EXCLUDE_VAL			(1U)
+#define FSBL_ECC_BKGND_EXCLUDE_VAL		(1U)
+#define FSBL_TIMELINE_EXCLUDE_VAL		(1U)
 
 #if FSBL_NAND_EXCLUDE_VAL
 #define FSBL_NAND_EXCLUDE
@@ -204,6 +230,14 @@ extern "C" {
 #if (FSBL_DDR_SR_EXCLUDE_VAL == 0U)
 #define XFSBL_ENABLE_DDR_SR
 #endif
+
+#if FSBL_ECC_BKGND_EXCLUDE_VAL
+#define FSBL_ECC_BKGND_EXCLUDE
+#endif
+
+#if FSBL_TIMELINE_EXCLUDE_VAL
+#define FSBL_TIMELINE_EXCLUDE
+#endif
 /************************** Function Prototypes ******************************/
 
 /************************** Variable Definitions *****************************/
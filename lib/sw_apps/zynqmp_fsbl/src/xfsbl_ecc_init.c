@@ -0,0 +1,537 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xfsbl_ecc_init.c
+ *
+ * Contains the ECC initialization engine.
+ *
+ * Regions added with XFsbl_EccInitAdd() are split in chunks of
+ * XFSBL_ECC_INIT_CHUNK_SIZE bytes. Every idle ADMA channel is given the next
+ * chunk, so up to XFSBL_ECC_INIT_NUM_CH chunks are written at the same time.
+ * Nothing runs from interrupts, the engine moves forward each time it is
+ * polled, which XFsbl_EccInitWait() and XFsbl_EccInitWaitAll() do until the
+ * requested memory is initialized.
+ *
+ * A range waited for is given the channels first: when it lies in the middle
+ * of a region, the region is split so that the range is initialized before
+ * the memory below it. This lets the loader use a partition load address as
+ * soon as its own memory is done.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date        Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 5.0   adk  10/15/19 Initial release
+ *
+ * </pre>
+ *
+ * @note
+ *
+ ******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xfsbl_main.h"
+#include "xfsbl_ecc_init.h"
+#include "xil_cache.h"
+/************************** Constant Definitions *****************************/
+/* Progress is printed every XFSBL_ECC_INIT_REPORT_STEP percent */
+#define XFSBL_ECC_INIT_REPORT_STEP	(25U)
+
+/**************************** Type Definitions *******************************/
+/**
+ * Region pending initialization. Memory below Next has been given to a
+ * channel, memory from Next to End is not started yet.
+ */
+typedef struct {
+	u64 Next;
+	u64 End;
+} XFsbl_EccRegion;
+
+/**
+ * Chunk being written by an ADMA channel.
+ */
+typedef struct {
+	u64 Addr;
+	u64 End;
+	u32 Busy;
+} XFsbl_EccChannel;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+/* Address of register Reg, given for channel 0, in the ADMA channel Ch */
+#define XFSBL_ECC_CH_REG(Ch, Reg)	((Reg) + \
+		(((Ch) + XFSBL_ECC_INIT_FIRST_CH) * XFSBL_ECC_INIT_CH_OFFSET))
+
+/************************** Function Prototypes ******************************/
+static void XFsbl_EccInitChStart(u32 Ch, u64 DestAddr, u32 Length);
+static void XFsbl_EccInitChRestore(u32 Ch);
+static u32 XFsbl_EccInitNextRegion(void);
+static void XFsbl_EccInitDispatch(void);
+static u32 XFsbl_EccInitPending(u64 Start, u64 End);
+
+/************************** Variable Definitions *****************************/
+static XFsbl_EccRegion EccRegion[XFSBL_ECC_INIT_MAX_REGIONS];
+static u32 EccNumRegions = 0U;
+static XFsbl_EccChannel EccChannel[XFSBL_ECC_INIT_NUM_CH];
+static u64 EccTotalBytes = 0U;
+static u64 EccDoneBytes = 0U;
+static u32 EccNextReport = 0U;
+static u32 EccStatus = XFSBL_SUCCESS;
+/* Range being waited for, it is given the channels first */
+static u64 EccWantStart = 0U;
+static u64 EccWantEnd = 0U;
+#ifdef XFSBL_PERF
+static XTime EccStartTime = 0U;
+#endif
+
+/*****************************************************************************/
+/**
+ * This function starts an ADMA channel in write only mode
+ *
+ * @param	Ch is the engine channel index
+ * @param	DestAddr is the start address of the chunk
+ * @param	Length is the length of the chunk in bytes
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XFsbl_EccInitChStart(u32 Ch, u64 DestAddr, u32 Length)
+{
+	u32 RegVal;
+
+	/* Enable Simple (Write Only) Mode */
+	RegVal = XFsbl_In32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_CTRL0));
+	RegVal &= (ADMA_CH0_ZDMA_CH_CTRL0_POINT_TYPE_MASK |
+			ADMA_CH0_ZDMA_CH_CTRL0_MODE_MASK);
+	RegVal |= (ADMA_CH0_ZDMA_CH_CTRL0_POINT_TYPE_NORMAL |
+			ADMA_CH0_ZDMA_CH_CTRL0_MODE_WR_ONLY);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_CTRL0), RegVal);
+
+	/* Fill in the data to be written */
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_WR_ONLY_WORD0),
+			XFSBL_ECC_INIT_VAL_WORD);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_WR_ONLY_WORD1),
+			XFSBL_ECC_INIT_VAL_WORD);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_WR_ONLY_WORD2),
+			XFSBL_ECC_INIT_VAL_WORD);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_WR_ONLY_WORD3),
+			XFSBL_ECC_INIT_VAL_WORD);
+
+	/* Write Destination Address */
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_DST_DSCR_WORD0),
+			(u32)(DestAddr & ADMA_CH0_ZDMA_CH_DST_DSCR_WORD0_LSB_MASK));
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_DST_DSCR_WORD1),
+			(u32)((DestAddr >> 32U) &
+					ADMA_CH0_ZDMA_CH_DST_DSCR_WORD1_MSB_MASK));
+
+	/* Size to be Transferred. Recommended to set both src and dest sizes */
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_SRC_DSCR_WORD2), Length);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_DST_DSCR_WORD2), Length);
+
+	/* DMA Enable */
+	RegVal = XFsbl_In32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_CTRL2));
+	RegVal |= ADMA_CH0_ZDMA_CH_CTRL2_EN_MASK;
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_CTRL2), RegVal);
+}
+
+/*****************************************************************************/
+/**
+ * This function restores the reset values of the ADMA channel registers
+ * used by the engine
+ *
+ * @param	Ch is the engine channel index
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XFsbl_EccInitChRestore(u32 Ch)
+{
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_CTRL0), 0x00000080U);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_WR_ONLY_WORD0),
+			0x00000000U);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_WR_ONLY_WORD1),
+			0x00000000U);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_WR_ONLY_WORD2),
+			0x00000000U);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_WR_ONLY_WORD3),
+			0x00000000U);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_DST_DSCR_WORD0),
+			0x00000000U);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_DST_DSCR_WORD1),
+			0x00000000U);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_SRC_DSCR_WORD2),
+			0x00000000U);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_DST_DSCR_WORD2),
+			0x00000000U);
+	XFsbl_Out32(XFSBL_ECC_CH_REG(Ch,
+			ADMA_CH0_ZDMA_CH_CTRL0_TOTAL_BYTE_COUNT), 0x00000000U);
+}
+
+/*****************************************************************************/
+/**
+ * This function selects the region the next chunk is taken from. A region
+ * overlapping the range waited for is preferred, and is split at the start
+ * of that range when there is room for one more region.
+ *
+ * @param	None
+ *
+ * @return	Index of the region, EccNumRegions if none is pending
+ *
+ *****************************************************************************/
+static u32 XFsbl_EccInitNextRegion(void)
+{
+	u32 Index;
+
+	if (EccNumRegions == 0U) {
+		goto END;
+	}
+
+	for (Index = 0U; Index < EccNumRegions; Index++) {
+		if ((EccRegion[Index].Next < EccWantEnd) &&
+				(EccRegion[Index].End > EccWantStart)) {
+			break;
+		}
+	}
+
+	if (Index == EccNumRegions) {
+		Index = 0U;
+		goto END;
+	}
+
+	if ((EccRegion[Index].Next < EccWantStart) &&
+			(EccNumRegions < XFSBL_ECC_INIT_MAX_REGIONS)) {
+		/* Memory below the range is done after the range */
+		EccRegion[EccNumRegions].Next = EccRegion[Index].Next;
+		EccRegion[EccNumRegions].End = EccWantStart;
+		EccNumRegions++;
+		EccRegion[Index].Next = EccWantStart;
+	}
+
+END:
+	return Index;
+}
+
+/*****************************************************************************/
+/**
+ * This function gives the next chunks to the idle channels
+ *
+ * @param	None
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XFsbl_EccInitDispatch(void)
+{
+	u32 Ch;
+	u32 Index;
+	u64 Length;
+
+	for (Ch = 0U; Ch < XFSBL_ECC_INIT_NUM_CH; Ch++) {
+		if (EccChannel[Ch].Busy == TRUE) {
+			continue;
+		}
+
+		Index = XFsbl_EccInitNextRegion();
+		if (Index == EccNumRegions) {
+			break;
+		}
+
+		Length = EccRegion[Index].End - EccRegion[Index].Next;
+		if (Length > XFSBL_ECC_INIT_CHUNK_SIZE) {
+			Length = XFSBL_ECC_INIT_CHUNK_SIZE;
+		}
+
+		EccChannel[Ch].Addr = EccRegion[Index].Next;
+		EccChannel[Ch].End = EccRegion[Index].Next + Length;
+		EccChannel[Ch].Busy = TRUE;
+		XFsbl_EccInitChStart(Ch, EccChannel[Ch].Addr, (u32)Length);
+
+		EccRegion[Index].Next += Length;
+		if (EccRegion[Index].Next == EccRegion[Index].End) {
+			/* Every chunk of the region is started, drop it */
+			EccNumRegions--;
+			for (; Index < EccNumRegions; Index++) {
+				EccRegion[Index] = EccRegion[Index + 1U];
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * This function checks if a range still has memory to be initialized
+ *
+ * @param	Start is the start address of the range
+ * @param	End is the end address of the range, exclusive
+ *
+ * @return	TRUE if any part of the range is not initialized yet,
+ *		FALSE otherwise
+ *
+ *****************************************************************************/
+static u32 XFsbl_EccInitPending(u64 Start, u64 End)
+{
+	u32 Index;
+	u32 Pending = FALSE;
+
+	for (Index = 0U; Index < EccNumRegions; Index++) {
+		if ((EccRegion[Index].Next < End) &&
+				(EccRegion[Index].End > Start)) {
+			Pending = TRUE;
+			goto END;
+		}
+	}
+
+	for (Index = 0U; Index < XFSBL_ECC_INIT_NUM_CH; Index++) {
+		if ((EccChannel[Index].Busy == TRUE) &&
+				(EccChannel[Index].Addr < End) &&
+				(EccChannel[Index].End > Start)) {
+			Pending = TRUE;
+			goto END;
+		}
+	}
+
+END:
+	return Pending;
+}
+
+/*****************************************************************************/
+/**
+ * This function adds a memory region to be ECC initialized and starts the
+ * idle channels. It returns without waiting for the region.
+ *
+ * @param	DestAddr is start address from where to calculate ECC
+ * @param	LengthBytes is length in bytes from start address to calculate
+ *		ECC, it must be a multiple of 8
+ *
+ * @return
+ * 		- XFSBL_SUCCESS if the region is added
+ * 		- XFSBL_FAILURE if a previous chunk failed
+ *
+ *****************************************************************************/
+u32 XFsbl_EccInitAdd(u64 DestAddr, u64 LengthBytes)
+{
+	u32 Status;
+
+	if (LengthBytes == 0U) {
+		Status = EccStatus;
+		goto END;
+	}
+
+	/* Wait for a free region slot */
+	do {
+		Status = XFsbl_EccInitPoll();
+		if (XFSBL_SUCCESS != Status) {
+			goto END;
+		}
+	} while (EccNumRegions == XFSBL_ECC_INIT_MAX_REGIONS);
+
+	if (EccTotalBytes == 0U) {
+		EccNextReport = XFSBL_ECC_INIT_REPORT_STEP;
+#ifdef XFSBL_PERF
+		XTime_GetTime(&EccStartTime);
+#endif
+	}
+
+	EccRegion[EccNumRegions].Next = DestAddr;
+	EccRegion[EccNumRegions].End = DestAddr + LengthBytes;
+	EccNumRegions++;
+	EccTotalBytes += LengthBytes;
+
+	Status = XFsbl_EccInitPoll();
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function moves the engine forward. It completes the chunks that are
+ * done, starts the next ones on the idle channels, prints the progress and,
+ * once all the regions are initialized, the time taken.
+ *
+ * @param	None
+ *
+ * @return
+ * 		- XFSBL_SUCCESS if no chunk failed
+ * 		- XFSBL_FAILURE if an ADMA channel reported an error
+ *
+ *****************************************************************************/
+u32 XFsbl_EccInitPoll(void)
+{
+	u32 Ch;
+	u32 RegVal;
+	u32 Percent;
+	u32 Status;
+
+	if (XFSBL_SUCCESS != EccStatus) {
+		Status = EccStatus;
+		goto END;
+	}
+
+	for (Ch = 0U; Ch < XFSBL_ECC_INIT_NUM_CH; Ch++) {
+		if (EccChannel[Ch].Busy != TRUE) {
+			continue;
+		}
+
+		RegVal = XFsbl_In32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_ISR));
+		if ((RegVal & ADMA_CH0_ZDMA_CH_ISR_DMA_DONE_MASK) == 0U) {
+			continue;
+		}
+
+		/* Clear DMA status */
+		XFsbl_Out32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_ISR),
+				ADMA_CH0_ZDMA_CH_ISR_DMA_DONE_MASK);
+		EccChannel[Ch].Busy = FALSE;
+
+		/* Read the channel status for errors */
+		RegVal = XFsbl_In32(XFSBL_ECC_CH_REG(Ch, ADMA_CH0_ZDMA_CH_STATUS));
+		RegVal &= ADMA_CH0_ZDMA_CH_STATUS_STATE_MASK;
+		if (RegVal == ADMA_CH0_ZDMA_CH_STATUS_STATE_ERR) {
+			XFsbl_Printf(DEBUG_GENERAL,
+				"ECC init failed at 0x%0lx, ADMA channel %u\r\n",
+				EccChannel[Ch].Addr, Ch + XFSBL_ECC_INIT_FIRST_CH);
+			EccStatus = XFSBL_FAILURE;
+		}
+
+		EccDoneBytes += EccChannel[Ch].End - EccChannel[Ch].Addr;
+	}
+
+	if (XFSBL_SUCCESS != EccStatus) {
+		Status = EccStatus;
+		goto END;
+	}
+
+	XFsbl_EccInitDispatch();
+
+	if (EccTotalBytes == 0U) {
+		Status = XFSBL_SUCCESS;
+		goto END;
+	}
+
+	Percent = (u32)((EccDoneBytes * 100U) / EccTotalBytes);
+	if (Percent >= EccNextReport) {
+		XFsbl_Printf(DEBUG_INFO, "ECC init %u%% of 0x%0lx bytes\r\n",
+				Percent, EccTotalBytes);
+		while (EccNextReport <= Percent) {
+			EccNextReport += XFSBL_ECC_INIT_REPORT_STEP;
+		}
+	}
+
+	if (EccDoneBytes == EccTotalBytes) {
+		for (Ch = 0U; Ch < XFSBL_ECC_INIT_NUM_CH; Ch++) {
+			XFsbl_EccInitChRestore(Ch);
+		}
+
+#ifdef XFSBL_PERF
+		XFsbl_MeasurePerfTime(EccStartTime);
+		XFsbl_Printf(DEBUG_PRINT_ALWAYS, ": ECC Init time, Size: 0x%0lx \r\n",
+				EccTotalBytes);
+#endif
+		EccTotalBytes = 0U;
+		EccDoneBytes = 0U;
+	}
+
+	Status = XFSBL_SUCCESS;
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function waits until a memory range is ECC initialized. Chunks of
+ * the range are started before the other pending memory. When the range had
+ * to be waited for, the data cache is flushed so that no line fetched before
+ * the initialization is used afterwards.
+ *
+ * @param	DestAddr is start address of the range
+ * @param	LengthBytes is length in bytes of the range
+ *
+ * @return
+ * 		- XFSBL_SUCCESS when the range is initialized
+ * 		- XFSBL_FAILURE if an ADMA channel reported an error
+ *
+ *****************************************************************************/
+u32 XFsbl_EccInitWait(u64 DestAddr, u64 LengthBytes)
+{
+	u32 Status = XFSBL_SUCCESS;
+	u64 End = DestAddr + LengthBytes;
+
+	if ((LengthBytes == 0U) ||
+			(XFsbl_EccInitPending(DestAddr, End) == FALSE)) {
+		Status = EccStatus;
+		goto END;
+	}
+
+	EccWantStart = DestAddr;
+	EccWantEnd = End;
+	do {
+		Status = XFsbl_EccInitPoll();
+		if (XFSBL_SUCCESS != Status) {
+			break;
+		}
+	} while (XFsbl_EccInitPending(DestAddr, End) == TRUE);
+	EccWantStart = 0U;
+	EccWantEnd = 0U;
+
+	Xil_DCacheFlush();
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function waits until all the regions added are ECC initialized
+ *
+ * @param	None
+ *
+ * @return
+ * 		- XFSBL_SUCCESS when all the regions are initialized
+ * 		- XFSBL_FAILURE if an ADMA channel reported an error
+ *
+ *****************************************************************************/
+u32 XFsbl_EccInitWaitAll(void)
+{
+	u32 Status = EccStatus;
+
+	if (EccTotalBytes == 0U) {
+		goto END;
+	}
+
+	do {
+		Status = XFsbl_EccInitPoll();
+		if (XFSBL_SUCCESS != Status) {
+			goto END;
+		}
+	} while (EccTotalBytes != 0U);
+
+	Xil_DCacheFlush();
+
+END:
+	return Status;
+}
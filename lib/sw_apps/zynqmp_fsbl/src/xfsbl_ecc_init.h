@@ -0,0 +1,87 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xfsbl_ecc_init.h
+*
+* Contains declarations for the ECC initialization engine. Memory regions
+* are split in chunks that are written in parallel by the ADMA channels in
+* write only mode.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 5.0   adk  10/15/19 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+#ifndef XFSBL_ECC_INIT_H
+#define XFSBL_ECC_INIT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xfsbl_hw.h"
+/**************************** Macros Definitions *****************************/
+/**
+ * ADMA channels used for ECC initialization. Channel 0 is left to
+ * XFsbl_AdmaCopy, so that it can run while the DDR is initialized in
+ * background.
+ */
+#define XFSBL_ECC_INIT_FIRST_CH		(1U)
+#define XFSBL_ECC_INIT_NUM_CH		(7U)
+#define XFSBL_ECC_INIT_CH_OFFSET	(0x10000U)
+
+/**
+ * Size of the chunks the regions are split in. It is a multiple of 8 bytes
+ * to keep the transfers 64 bit aligned.
+ */
+#define XFSBL_ECC_INIT_CHUNK_SIZE	(0x4000000U)
+
+/* Maximum number of regions pending initialization */
+#define XFSBL_ECC_INIT_MAX_REGIONS	(8U)
+
+/************************** Function Prototypes ******************************/
+u32 XFsbl_EccInitAdd(u64 DestAddr, u64 LengthBytes);
+u32 XFsbl_EccInitPoll(void);
+u32 XFsbl_EccInitWait(u64 DestAddr, u64 LengthBytes);
+u32 XFsbl_EccInitWaitAll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XFSBL_ECC_INIT_H */
@@ -44,6 +44,8 @@
  *                     it is by passed.
  *       bv   03/17/17 Modified such that XFsbl_PmInit is done only duing
  *                     system reset
+ * 5.0   adk  10/15/19 Wait for the background DDR ECC initialization before
+ *                     handoff.
  * </pre>
  *
  * @note
@@ -57,6 +59,7 @@
 #include "xfsbl_main.h"
 #include "xfsbl_image_header.h"
 #include "xfsbl_bs.h"
+#include "xfsbl_ecc_init.h"
 
 /************************** Constant Definitions *****************************/
 #define XFSBL_CPU_POWER_UP		(0x1U)
@@ -749,6 +752,19 @@ u32 XFsbl_Handoff (const XFsblPs * FsblInstancePtr, u32 PartitionNum, u32 EarlyH
 			(void)psu_ps_pl_reset_config_data();
 		}
 
+#ifdef XFSBL_ECC_BKGND
+	/**
+	 * Memory no partition is loaded to may still be initialized, the
+	 * applications expect all the DDR to be ready
+	 */
+	Status = XFsbl_EccInitWaitAll();
+	if (Status != XFSBL_SUCCESS) {
+		Status = XFSBL_ERROR_DDR_ECC_INIT;
+		XFsbl_Printf(DEBUG_GENERAL, "XFSBL_ERROR_DDR_ECC_INIT\r\n");
+		goto END;
+	}
+#endif
+
 	/**
 	 * Flush the L1 data cache and L2 cache, Disable Data Cache
 	*/
@@ -44,6 +44,8 @@
 *                     deprecation in future releases.
 *       vns  03/07/18 Added ENC_ONLY mask
 * 4.0   vns  03/14/19 Added AES reset offset and Mask values.
+*       adk  10/15/19 Added XFSBL_ECC_BKGND definition.
+*       adk  10/15/19 Added XFSBL_TIMELINE definition.
 *
 * </pre>
 *
@@ -902,6 +904,14 @@ extern "C" {
 #define XFSBL_FORCE_ENC
 #endif
 
+/*
+ * Definition for DDR ECC initialization in background, while the
+ * partitions are loaded
+ */
+#if !defined(FSBL_ECC_BKGND_EXCLUDE)
+#define XFSBL_ECC_BKGND
+#endif
+
 #define XFSBL_QSPI_LINEAR_BASE_ADDRESS_START		(0xC0000000U)
 #define XFSBL_QSPI_LINEAR_BASE_ADDRESS_END		(0xDFFFFFFFU)
 
@@ -939,6 +949,21 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * Definition for boot timeline to be included, it uses the same timer as the
+ * performance measurement and is handed to the OS in DDR
+ */
+#if !defined(FSBL_TIMELINE_EXCLUDE) && defined(XFSBL_PS_DDR) && \
+	(!defined(ARMR5) || (defined(ARMR5) && defined(SLEEP_TIMER_BASEADDR)))
+#define XFSBL_TIMELINE
+#endif
+
+/*
+ * The boot timeline address is handed to the OS in
+ * PMU_GLOBAL_PERS_GLOB_GEN_STORAGE5
+ */
+#define XFSBL_TIMELINE_ADDR_REG		(PMU_GLOBAL_PERS_GLOB_GEN_STORAGE5)
+
 #ifdef XFSBL_ENABLE_DDR_SR
 /*
  * For DDR status PMU_GLOBAL_PERS_GLOB_GEN_STORAGE7 is used
@@ -58,6 +58,9 @@
 * 5.0   mn   07/06/18 Add DDR initialization support for new DDR DIMM part
 *       mus  02/26/19 Added support for armclang compiler
 *       vns  03/14/19 Setting AES and SHA hardware engines into reset.
+*       adk  10/15/19 ECC initialization uses the multi channel engine of
+*                     xfsbl_ecc_init.c, DDR is initialized in background
+*                     when XFSBL_ECC_BKGND is defined.
 * </pre>
 *
 * @note
@@ -78,6 +81,7 @@
 #include "xfsbl_usb.h"
 #include "xfsbl_authentication.h"
 #include "xfsbl_ddr_init.h"
+#include "xfsbl_ecc_init.h"
 
 /************************** Constant Definitions *****************************/
 #define PART_NAME_LEN_MAX		20U
@@ -1575,100 +1579,26 @@ END:
  *****************************************************************************/
 static u32 XFsbl_EccInit(u64 DestAddr, u64 LengthBytes)
 {
-	u32 RegVal;
 	u32 Status;
-	u32 Length;
-	u64 StartAddr = DestAddr;
-	u64 NumBytes = LengthBytes;
 
 	Xil_DCacheDisable();
 
-	while (NumBytes > 0U) {
-		if (NumBytes > ZDMA_TRANSFER_MAX_LEN) {
-			Length = ZDMA_TRANSFER_MAX_LEN;
-		} else {
-			Length = (u32)NumBytes;
-		}
-
-		/* Wait until the DMA is in idle state */
-		do {
-			RegVal = XFsbl_In32(ADMA_CH0_ZDMA_CH_STATUS);
-			RegVal &= ADMA_CH0_ZDMA_CH_STATUS_STATE_MASK;
-		} while ((RegVal != ADMA_CH0_ZDMA_CH_STATUS_STATE_DONE) &&
-				(RegVal != ADMA_CH0_ZDMA_CH_STATUS_STATE_ERR));
-
-		/* Enable Simple (Write Only) Mode */
-		RegVal = XFsbl_In32(ADMA_CH0_ZDMA_CH_CTRL0);
-		RegVal &= (ADMA_CH0_ZDMA_CH_CTRL0_POINT_TYPE_MASK |
-				ADMA_CH0_ZDMA_CH_CTRL0_MODE_MASK);
-		RegVal |= (ADMA_CH0_ZDMA_CH_CTRL0_POINT_TYPE_NORMAL |
-				ADMA_CH0_ZDMA_CH_CTRL0_MODE_WR_ONLY);
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_CTRL0, RegVal);
-
-		/* Fill in the data to be written */
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_WR_ONLY_WORD0, XFSBL_ECC_INIT_VAL_WORD);
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_WR_ONLY_WORD1, XFSBL_ECC_INIT_VAL_WORD);
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_WR_ONLY_WORD2, XFSBL_ECC_INIT_VAL_WORD);
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_WR_ONLY_WORD3, XFSBL_ECC_INIT_VAL_WORD);
-
-		/* Write Destination Address */
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_DST_DSCR_WORD0,
-				(u32)(StartAddr & ADMA_CH0_ZDMA_CH_DST_DSCR_WORD0_LSB_MASK));
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_DST_DSCR_WORD1,
-				(u32)((StartAddr >> 32U) &
-						ADMA_CH0_ZDMA_CH_DST_DSCR_WORD1_MSB_MASK));
-
-		/* Size to be Transferred. Recommended to set both src and dest sizes */
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_SRC_DSCR_WORD2, Length);
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_DST_DSCR_WORD2, Length);
-
-		/* DMA Enable */
-		RegVal = XFsbl_In32(ADMA_CH0_ZDMA_CH_CTRL2);
-		RegVal |= ADMA_CH0_ZDMA_CH_CTRL2_EN_MASK;
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_CTRL2, RegVal);
-
-		/* Check the status of the transfer by polling on DMA Done */
-		do {
-			RegVal = XFsbl_In32(ADMA_CH0_ZDMA_CH_ISR);
-			RegVal &= ADMA_CH0_ZDMA_CH_ISR_DMA_DONE_MASK;
-		} while (RegVal != ADMA_CH0_ZDMA_CH_ISR_DMA_DONE_MASK);
-
-		/* Clear DMA status */
-		RegVal = XFsbl_In32(ADMA_CH0_ZDMA_CH_ISR);
-		RegVal |= ADMA_CH0_ZDMA_CH_ISR_DMA_DONE_MASK;
-		XFsbl_Out32(ADMA_CH0_ZDMA_CH_ISR, ADMA_CH0_ZDMA_CH_ISR_DMA_DONE_MASK);
-
-		/* Read the channel status for errors */
-		RegVal = XFsbl_In32(ADMA_CH0_ZDMA_CH_STATUS);
-		if (RegVal == ADMA_CH0_ZDMA_CH_STATUS_STATE_ERR) {
-			Status = XFSBL_FAILURE;
-			Xil_DCacheEnable();
-			goto END;
-		}
-
-		NumBytes -= Length;
-		StartAddr += Length;
+	/* Chunks of the region are written in parallel by the ADMA channels */
+	Status = XFsbl_EccInitAdd(DestAddr, LengthBytes);
+	if (XFSBL_SUCCESS == Status) {
+		Status = XFsbl_EccInitWait(DestAddr, LengthBytes);
 	}
 
 	Xil_DCacheEnable();
 
-	/* Restore reset values for the DMA registers used */
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_CTRL0, 0x00000080U);
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_WR_ONLY_WORD0, 0x00000000U);
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_WR_ONLY_WORD1, 0x00000000U);
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_WR_ONLY_WORD2, 0x00000000U);
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_WR_ONLY_WORD3, 0x00000000U);
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_DST_DSCR_WORD0, 0x00000000U);
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_DST_DSCR_WORD1, 0x00000000U);
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_SRC_DSCR_WORD2, 0x00000000U);
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_DST_DSCR_WORD2, 0x00000000U);
-	XFsbl_Out32(ADMA_CH0_ZDMA_CH_CTRL0_TOTAL_BYTE_COUNT,0x00000000U);
+	if (XFSBL_SUCCESS != Status) {
+		goto END;
+	}
 
 	XFsbl_Printf(DEBUG_INFO,
 			"Address 0x%0lx, Length %0lx, ECC initialized \r\n",
 			DestAddr, LengthBytes);
 
-	Status = XFSBL_SUCCESS;
 END:
 	return Status;
 }
@@ -1693,9 +1623,19 @@ static u32 XFsbl_DdrEccInit(void)
 			(XFSBL_PS_DDR_END_ADDRESS - XFSBL_PS_DDR_INIT_START_ADDRESS) + 1;
 	u64 DestAddr = XFSBL_PS_DDR_INIT_START_ADDRESS;
 
+#ifdef XFSBL_ECC_BKGND
+	/*
+	 * The regions are only queued, the memory is waited for when it is
+	 * first used and before handoff
+	 */
+	XFsbl_Printf(DEBUG_GENERAL,"Initializing DDR ECC in background\n\r");
+
+	Status = XFsbl_EccInitAdd(DestAddr, LengthBytes);
+#else
 	XFsbl_Printf(DEBUG_GENERAL,"Initializing DDR ECC\n\r");
 
 	Status = XFsbl_EccInit(DestAddr, LengthBytes);
+#endif
 	if (XFSBL_SUCCESS != Status) {
 		Status = XFSBL_ERROR_DDR_ECC_INIT;
 		XFsbl_Printf(DEBUG_GENERAL,"XFSBL_ERROR_DDR_ECC_INIT\n\r");
@@ -1708,7 +1648,11 @@ static u32 XFsbl_DdrEccInit(void)
 		(XFSBL_PS_HI_DDR_END_ADDRESS - XFSBL_PS_HI_DDR_START_ADDRESS) + 1;
 	DestAddr = XFSBL_PS_HI_DDR_START_ADDRESS;
 
+#ifdef XFSBL_ECC_BKGND
+	Status = XFsbl_EccInitAdd(DestAddr, LengthBytes);
+#else
 	Status = XFsbl_EccInit(DestAddr, LengthBytes);
+#endif
 	if (XFSBL_SUCCESS != Status) {
 		Status = XFSBL_ERROR_DDR_ECC_INIT;
 		XFsbl_Printf(DEBUG_GENERAL,"XFSBL_ERROR_DDR_ECC_INIT\n\r");
@@ -40,6 +40,7 @@
 * 1.00  ba   02/22/16 Added performance measurement feature.
 * 2.0   bv   12/02/16 Made compliance to MISRAC 2012 guidelines
 *                     Added warm restart support
+* 5.0   adk  10/15/19 Added the boot timeline of stages and partitions
 *
 * </pre>
 *
@@ -50,6 +51,7 @@
 /***************************** Include Files *********************************/
 #include "xfsbl_hw.h"
 #include "xfsbl_main.h"
+#include "xfsbl_timeline.h"
 #include "bspconfig.h"
 
 /************************** Constant Definitions *****************************/
@@ -82,9 +84,13 @@ int main(void )
 	u32 FsblStage = XFSBL_STAGE1;
 	u32 PartitionNum=0U;
 	u32 EarlyHandoff = FALSE;
-#ifdef XFSBL_PERF
+#if defined(XFSBL_PERF) || defined(XFSBL_TIMELINE)
 	XTime tCur = 0;
 #endif
+#ifdef XFSBL_TIMELINE
+	XTime tTlStart = 0;
+	XTime tPrtnStart = 0;
+#endif
 #ifdef ENABLE_POS
 	u32 WarmBoot;
 
@@ -111,6 +117,10 @@ int main(void )
 				/**
 				 * Initialize the system
 				 */
+#ifdef XFSBL_TIMELINE
+				XTime_GetTime(&tTlStart);
+				XFsbl_TlInit(tTlStart);
+#endif
 
 				FsblStatus = XFsbl_Initialize(&FsblInstance);
 				if (XFSBL_SUCCESS != FsblStatus)
@@ -124,6 +134,10 @@ int main(void )
 					 * Include the code for FSBL time measurements
 					 * Initialize the global timer and get the value
 					 */
+#ifdef XFSBL_TIMELINE
+					XFsbl_TlRecord(XFSBL_TL_EVENT_STAGE,
+						XFSBL_TL_STAGE_INIT, 0U, tTlStart);
+#endif
 
 					FsblStage = XFSBL_STAGE2;
 				}
@@ -132,7 +146,7 @@ int main(void )
 		case XFSBL_STAGE2:
 			{
 				/* Reading Timer value for Performance measurement.*/
-#ifdef XFSBL_PERF
+#if defined(XFSBL_PERF) || defined(XFSBL_TIMELINE)
 				/* Get Start time for Boot Device init. */
 				XTime_GetTime(&tCur);
 #endif
@@ -191,6 +205,10 @@ int main(void )
 #ifdef XFSBL_PERF
 				XFsbl_MeasurePerfTime(tCur);
 				XFsbl_Printf(DEBUG_PRINT_ALWAYS, " : Boot Dev. Init. Time\n\r");
+#endif
+#ifdef XFSBL_TIMELINE
+				XFsbl_TlRecord(XFSBL_TL_EVENT_STAGE,
+					XFSBL_TL_STAGE_BOOT_DEVICE, 0U, tCur);
 #endif
 			} break;
 
@@ -207,6 +225,9 @@ int main(void )
 				 *  partition header
 				 *  partition parameters
 				 */
+#ifdef XFSBL_TIMELINE
+				XTime_GetTime(&tPrtnStart);
+#endif
 				FsblStatus = XFsbl_PartitionLoad(&FsblInstance,
 								  PartitionNum);
 				if (XFSBL_SUCCESS != FsblStatus)
@@ -221,6 +242,12 @@ int main(void )
 				} else {
 					XFsbl_Printf(DEBUG_INFO,"Partition %d Load Success \n\r",
 									PartitionNum);
+#ifdef XFSBL_TIMELINE
+					XFsbl_TlRecord(XFSBL_TL_EVENT_PRTN, PartitionNum,
+						XFsbl_GetDestinationCpu(&FsblInstance.
+							ImageHeader.PartitionHeader[PartitionNum]),
+						tPrtnStart);
+#endif
 
 					XFsbl_MarkUsedRPUCores(&FsblInstance,
 							       PartitionNum);
@@ -274,6 +301,11 @@ int main(void )
 				 * xip
 				 * ps7 post config
 				 */
+#ifdef XFSBL_TIMELINE
+				XFsbl_TlRecord(XFSBL_TL_EVENT_STAGE,
+					XFSBL_TL_STAGE_HANDOFF, 0U, tTlStart);
+				XFsbl_TlPublish();
+#endif
 				FsblStatus = XFsbl_Handoff(&FsblInstance, PartitionNum, EarlyHandoff);
 
 				if (XFSBL_STATUS_CONTINUE_PARTITION_LOAD == FsblStatus) {
@@ -37,6 +37,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   04/21/14 Initial release
+*       adk  10/15/19 Reuse the bad block table kept at
+*                     XFSBL_NAND_BBT_CACHE_ADDRESS across warm boots
 *
 * </pre>
 *
@@ -90,8 +92,14 @@ u32 XFsbl_NandInit(void )
         /**
          * Initialize the NAND flash driver.
          */
+#if (XFSBL_NAND_BBT_CACHE_ADDRESS != 0U)
+        Status = (u32)XNandPsu_CfgInitializeBbtCache(NandInstPtr, Config,
+                        Config->BaseAddress,
+                        (XNandPsu_BbtCache *)(UINTPTR)XFSBL_NAND_BBT_CACHE_ADDRESS);
+#else
         Status = (u32)XNandPsu_CfgInitialize(NandInstPtr, Config,
                         Config->BaseAddress);
+#endif
         if (Status != XST_SUCCESS) {
                 Status = XFSBL_ERROR_NAND_INIT;
 		XFsbl_Printf(DEBUG_GENERAL,"XFSBL_ERROR_NAND_INIT\r\n");
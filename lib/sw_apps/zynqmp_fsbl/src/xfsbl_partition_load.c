@@ -56,6 +56,8 @@
 *                     internal memory), using same way for non authenticated
 *                     case as well.
 *       mus  02/26/19 Added support for armclang compiler.
+*       adk  10/15/19 Wait for the ECC initialization of the load address
+*                     range before copying the partition.
 *
 * </pre>
 *
@@ -73,6 +75,7 @@
 #include "xfsbl_bs.h"
 #include "psu_init.h"
 #include "xfsbl_plpartition_valid.h"
+#include "xfsbl_ecc_init.h"
 /************************** Constant Definitions *****************************/
 
 /**************************** Type Definitions *******************************/
@@ -1074,6 +1077,19 @@ static u32 XFsbl_PartitionCopy(XFsblPs * FsblInstancePtr, u32 PartitionNum)
 		} while (1);
 	}
 
+#ifdef XFSBL_ECC_BKGND
+	/**
+	 * DDR ECC initialization runs in background, only the memory
+	 * the partition is loaded to has to be done
+	 */
+	Status = XFsbl_EccInitWait(LoadAddress, Length);
+	if (XFSBL_SUCCESS != Status) {
+		Status = XFSBL_ERROR_DDR_ECC_INIT;
+		XFsbl_Printf(DEBUG_GENERAL,"XFSBL_ERROR_DDR_ECC_INIT\n\r");
+		goto END;
+	}
+#endif
+
 #ifdef XFSBL_PERF
 	XTime tCur = 0;
 	XTime_GetTime(&tCur);
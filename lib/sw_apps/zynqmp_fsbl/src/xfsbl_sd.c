@@ -38,6 +38,8 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   04/21/14 Initial release
 * 2.0   bv   12/02/16 Made compliance to MISRAC 2012 guidelines
+*       adk  10/15/19 Boot file is opened in fast seek mode and read with
+*                     f_read_at
 *
 * </pre>
 *
@@ -54,6 +56,8 @@
 #include "ff.h"
 
 /************************** Constant Definitions *****************************/
+/** Fragments of the boot file kept in the fast seek table */
+#define XFSBL_SD_MAX_FRAGMENTS		32U
 
 /**************************** Type Definitions *******************************/
 
@@ -68,6 +72,10 @@ extern u32 XFsbl_GetDrvNumSD(u32 DeviceFlags);
 /************************** Variable Definitions *****************************/
 
 static FIL fil;		/* File object */
+#if FF_USE_FASTSEEK
+/* Cluster link map table of the boot file */
+static DWORD SdClmt[FF_CLMT_ITEMS(XFSBL_SD_MAX_FRAGMENTS)];
+#endif
 
 /*****************************************************************************/
 /**
@@ -118,7 +126,20 @@ u32 XFsbl_SdInit(u32 DeviceFlags)
 	XFsbl_MakeSdFileName(boot_file, MultiBootOffset, DrvNum);
 
 	if(boot_file!=NULL) {
+#if FF_USE_FASTSEEK
+		/**
+		 * Map the fragments of the boot file once, the copies then
+		 * read each fragment with one multi block read. A boot file
+		 * with more fragments is read cluster by cluster.
+		 */
+		rc = f_open_fastseek(&fil, boot_file, (BYTE)FA_READ, SdClmt,
+				FF_CLMT_ITEMS(XFSBL_SD_MAX_FRAGMENTS));
+		if (rc == FR_NOT_ENOUGH_CORE) {
+			rc = f_open(&fil, boot_file, (BYTE)FA_READ);
+		}
+#else
 		rc = f_open(&fil, boot_file, (BYTE)FA_READ);
+#endif
 		if (rc!=FR_OK) {
 		XFsbl_Printf(DEBUG_INFO,
 			"SD: Unable to open file %s: %d\n", boot_file, rc);
@@ -171,7 +192,8 @@ u32 XFsbl_SdCopy(u32 SrcAddress, PTRSIZE DestAddress, u32 Length)
 		goto END;
 	}
 
-	rc = f_read(&fil, (void*)DestAddress, Length, &br);
+	/* Whole sectors go from the card to DestAddress by ADMA2 */
+	rc = f_read_at(&fil, SrcAddress, (void*)DestAddress, Length, &br);
 
 	if (rc != FR_OK) {
 		XFsbl_Printf(DEBUG_GENERAL,
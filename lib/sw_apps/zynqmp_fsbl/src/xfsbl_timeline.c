@@ -0,0 +1,166 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xfsbl_timeline.c
+ *
+ * Contains the FSBL boot timeline recording and its handoff to the OS.
+ *
+ * The timeline is kept in OCM with the FSBL data while partitions are
+ * loaded, it is only copied to DDR when a handoff is done.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date        Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 5.0   adk  10/15/19 Initial release
+ *
+ * </pre>
+ *
+ * @note
+ *
+ ******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xfsbl_main.h"
+#include "xfsbl_misc.h"
+#include "xfsbl_ecc_init.h"
+#include "xfsbl_timeline.h"
+#include "xil_cache.h"
+
+#ifdef XFSBL_TIMELINE
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+/************************** Variable Definitions *****************************/
+static XFsbl_Timeline Timeline = {XFSBL_TL_MAGIC, XFSBL_TL_VERSION};
+static XTime TlStartTime;
+
+/*****************************************************************************/
+/**
+ * This function starts the timeline, the start times of the events are
+ * counted from the given time.
+ *
+ * @param	StartTime is the FSBL start time, as read with XTime_GetTime
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XFsbl_TlInit(XTime StartTime)
+{
+	TlStartTime = StartTime;
+	Timeline.NumEvents = 0U;
+	Timeline.DroppedEvents = 0U;
+}
+
+/*****************************************************************************/
+/**
+ * This function adds an event that ends now to the timeline
+ *
+ * @param	Type of the event
+ * @param	Id is the stage ID or the partition number
+ * @param	Arg is the event specific argument
+ * @param	StartTime is the time at the start of the event, as read with
+ *		XTime_GetTime
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XFsbl_TlRecord(u32 Type, u32 Id, u32 Arg, XTime StartTime)
+{
+	XFsbl_TlEvent *Event;
+	XTime EndTime = 0U;
+	u64 Duration;
+
+	XTime_GetTime(&EndTime);
+
+	if (Timeline.NumEvents >= XFSBL_TL_MAX_EVENTS) {
+		Timeline.DroppedEvents++;
+		goto END;
+	}
+
+	Event = &Timeline.Events[Timeline.NumEvents];
+	Event->Type = Type;
+	Event->Id = Id;
+	Event->Arg = Arg;
+	Duration = (u64)(EndTime - StartTime);
+	if (Duration < (u64)0xFFFFFFFFU) {
+		Event->Duration = (u32)Duration;
+	} else {
+		Event->Duration = 0xFFFFFFFFU;
+	}
+	Event->Start = (u64)(StartTime - TlStartTime);
+	Timeline.NumEvents++;
+
+END:
+	return;
+}
+
+/*****************************************************************************/
+/**
+ * This function copies the timeline to XFSBL_TIMELINE_ADDRESS and hands its
+ * address to the OS in XFSBL_TIMELINE_ADDR_REG. It is called before every
+ * handoff, the last copy has all the partitions.
+ *
+ * @param	None
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XFsbl_TlPublish(void)
+{
+	u32 Len = (u32)sizeof(Timeline);
+
+	Timeline.TimerFreq = (u32)COUNTS_PER_SECOND;
+
+#ifdef XFSBL_ECC_BKGND
+	/**
+	 * The copy must not be overwritten by the DDR ECC initialization
+	 */
+	if (XFsbl_EccInitWait(XFSBL_TIMELINE_ADDRESS, Len) != XFSBL_SUCCESS) {
+		XFsbl_Printf(DEBUG_GENERAL, "Boot timeline not copied\n\r");
+		goto END;
+	}
+#endif
+
+	(void)XFsbl_MemCpy((void *)(PTRSIZE)XFSBL_TIMELINE_ADDRESS, &Timeline,
+			Len);
+	Xil_DCacheFlushRange((INTPTR)XFSBL_TIMELINE_ADDRESS, Len);
+	XFsbl_Out32(XFSBL_TIMELINE_ADDR_REG, XFSBL_TIMELINE_ADDRESS);
+
+#ifdef XFSBL_ECC_BKGND
+END:
+#endif
+	return;
+}
+#endif /* XFSBL_TIMELINE */
@@ -0,0 +1,119 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+*******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xfsbl_timeline.h
+*
+* Contains declarations for the FSBL boot timeline. The timeline is a binary
+* record of the time taken by the FSBL stages and by each partition load. At
+* every handoff it is copied to XFSBL_TIMELINE_ADDRESS in DDR, and that
+* address is left in PMU_GLOBAL_PERS_GLOB_GEN_STORAGE5 for the OS.
+*
+* The header and event layouts, the event types and the stage IDs are the same
+* as in the versal PLM timeline (xplmi_timeline.h), boot_timeline.py in
+* versal_plm misc prints and compares the timelines of both loaders.
+*
+* All the times are in ticks of the timer used by XTime_GetTime, the frequency
+* is given in the timeline header. Start times are counted from the FSBL start.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 5.0   adk  10/15/19 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+#ifndef XFSBL_TIMELINE_H
+#define XFSBL_TIMELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xfsbl_hw.h"
+#include "xtime_l.h"
+/**************************** Macros Definitions *****************************/
+#define XFSBL_TL_MAGIC			(0x4C545346U) /* "FSTL" */
+#define XFSBL_TL_VERSION		(1U)
+#define XFSBL_TL_MAX_EVENTS		(32U)
+
+/**
+ * Event types, numbered as in the PLM timeline
+ *  - PRTN: Id is the partition number, Arg the destination CPU
+ *  - STAGE: Id is the boot stage ID, Arg is 0
+ */
+#define XFSBL_TL_EVENT_PRTN		(2U)
+#define XFSBL_TL_EVENT_STAGE		(6U)
+
+/**
+ * Boot stage IDs
+ *  - INIT: FSBL initialization (stage 1), from the FSBL start
+ *  - BOOT_DEVICE: Initialization of the boot device (stage 2)
+ *  - HANDOFF: Partitions loaded up to a handoff, from the FSBL start
+ */
+#define XFSBL_TL_STAGE_INIT		(1U)
+#define XFSBL_TL_STAGE_BOOT_DEVICE	(2U)
+#define XFSBL_TL_STAGE_HANDOFF		(3U)
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u32 Type;	/**< Event type */
+	u32 Id;		/**< Stage ID or partition number */
+	u32 Arg;	/**< Event specific argument */
+	u32 Duration;	/**< Ticks, saturated to 0xFFFFFFFF */
+	u64 Start;	/**< Ticks since the FSBL start */
+} XFsbl_TlEvent;
+
+typedef struct {
+	u32 Magic;		/**< XFSBL_TL_MAGIC */
+	u32 Version;		/**< XFSBL_TL_VERSION */
+	u32 TimerFreq;		/**< Tick frequency in Hz */
+	u32 NumEvents;		/**< Valid entries in Events */
+	u32 DroppedEvents;	/**< Events lost because Events was full */
+	u32 NumSlowCmds;	/**< Always 0, kept for the PLM layout */
+	u64 RomTime;		/**< Always 0, not known to FSBL */
+	XFsbl_TlEvent Events[XFSBL_TL_MAX_EVENTS];	/**< In order of end */
+} XFsbl_Timeline;
+
+/************************** Function Prototypes ******************************/
+void XFsbl_TlInit(XTime StartTime);
+void XFsbl_TlRecord(u32 Type, u32 Id, u32 Arg, XTime StartTime);
+void XFsbl_TlPublish(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XFSBL_TIMELINE_H */
@@ -37,6 +37,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   bvikram  02/01/17 First release
+* 2.0   adk  10/15/19 Wait for the background DDR ECC initialization before
+*                     the boot image is downloaded to DDR.
 *
 * </pre>
 *
@@ -52,6 +54,7 @@
 #include "sleep.h"
 #include "xcsudma.h"
 #include "xfsbl_csu_dma.h"
+#include "xfsbl_ecc_init.h"
 #include "xfsbl_dfu_util.h"
 
 /************************** Constant Definitions ****************************/
@@ -96,6 +99,15 @@ u32 XFsbl_UsbInit(u32 DeviceFlags)
 		goto END;
 	}
 
+#ifdef XFSBL_ECC_BKGND
+	/* The downloaded image can fill the DDR up to its end */
+	Status = XFsbl_EccInitWaitAll();
+	if (Status != XFSBL_SUCCESS) {
+		Status = XFSBL_ERROR_DDR_ECC_INIT;
+		goto END;
+	}
+#endif
+
 	(void)memset(&UsbInstance,0,sizeof(UsbInstance));
 	(void)memset(&DfuObj, 0, sizeof(DfuObj));
 
@@ -2792,6 +2792,13 @@ done:
 	return;
 }
 
+/*
+ * Clocks indexed by clock ID, filled on the first lookup. Entries hold the
+ * index in pmClocks plus one, or zero if there is no clock with the ID.
+ */
+static u8 pmClockIndex[256];
+static bool pmClocksIndexed;
+
 /**
  * PmClockGetById() - Get clock structure based on clock ID
  * @clockId	ID of the clock to get
@@ -2803,11 +2810,17 @@ PmClock* PmClockGetById(const u32 clockId)
 	u32 i;
 	PmClock* clock = NULL;
 
-	for (i = 0U; i < ARRAY_SIZE(pmClocks); i++) {
-		if (clockId == pmClocks[i]->id) {
-			clock = pmClocks[i];
-			break;
+	if (false == pmClocksIndexed) {
+		for (i = ARRAY_SIZE(pmClocks); i > 0U; i--) {
+			/* Walk backwards, the first clock with the ID wins */
+			pmClockIndex[pmClocks[i - 1U]->id] = (u8)i;
 		}
+		pmClocksIndexed = true;
+	}
+
+	if ((clockId < ARRAY_SIZE(pmClockIndex)) &&
+	    (0U != pmClockIndex[clockId])) {
+		clock = pmClocks[pmClockIndex[clockId] - 1U];
 	}
 
 	return clock;
@@ -170,6 +170,11 @@
 #define DDRPHY_ZQDR1(n)		(DDRPHY_BASE + 0x690U + (0x20U * (n)))
 #define DDRPHY_DXGCR(n, m)	(DDRPHY_BASE + 0X700U + (0x100U * (n)) + (4U * (m)))
 #define DDRPHY_DXGSR0(n)	(DDRPHY_BASE + 0X7e0U + (0x100U * (n)))
+#define DDRPHY_DXBDLR0(n)	(DDRPHY_BASE + 0X740U + (0x100U * (n)))
+#define DDRPHY_DXBDLR3(n)	(DDRPHY_BASE + 0X750U + (0x100U * (n)))
+#define DDRPHY_DXBDLR6(n)	(DDRPHY_BASE + 0X760U + (0x100U * (n)))
+#define DDRPHY_DXLCDLR(n, m)	(DDRPHY_BASE + 0X780U + (0x100U * (n)) + (4U * (m)))
+#define DDRPHY_DXGTR0(n)	(DDRPHY_BASE + 0X7C0U + (0x100U * (n)))
 #define DDRPHY_DX8SLNOSC(n)	(DDRPHY_BASE + 0x1400U + (0x40U * (n)))
 #define DDRPHY_DX8SLPLLCR(n, m)	(DDRPHY_BASE + 0X1404U + (0x40U * (n)) + (4U * (m)))
 #define DDRPHY_DX8SLDQSCTL(n)	(DDRPHY_BASE + 0x141cU + (0x40U * (n)))
@@ -304,6 +309,13 @@
 #define DDRPHY_RANK1_WRITE		BIT(1U)
 #define DDRPHY_RANK0_READ		BIT(16U)
 #define DDRPHY_RANK1_READ		BIT(17U)
+#define DDRPHY_RANKRID_SHIFT		16U
+#define DDRPHY_MAX_RANKS		2U
+
+#define DDRPHY_PGCR6_INHVT		BIT(0U)
+
+#define DDRPHY_DX_NUM			9U
+#define DDRPHY_DX_STRIDE		0x100U
 
 #define DDRQOS_BASE		0xFD090000U
 #define DDRQOS_DDR_CLK_CTRL	(DDRQOS_BASE + 0x700U)
@@ -368,6 +380,41 @@
 #define ADDR_HI(ADDR)	((u32)((u64)(ADDR) >> 32U))
 #define ADDR_LO(ADDR)	((u32)((u64)(ADDR) & 0x00000000FFFFFFFFULL))
 
+/* Steps of DDR self-refresh entry and exit that are timed */
+#define DDR_SR_STEP_TRAIN_SAVE		0U
+#define DDR_SR_STEP_CTX_SAVE		1U
+#define DDR_SR_STEP_SR_ENTRY		2U
+#define DDR_SR_STEP_CTX_RESTORE		3U
+#define DDR_SR_STEP_PHY_INIT		4U
+#define DDR_SR_STEP_TRAINING		5U
+#define DDR_SR_STEP_TRAIN_RESTORE	6U
+#define DDR_SR_STEP_MAX			7U
+
+/* PMU clock cycles, the free running PIT3 counts down */
+#define DDR_SR_CYCLES()		(~Xil_In32(PMU_IOMODULE_PIT3_COUNTER))
+
+/**
+ * PmDdrCtxRange - Run of consecutive registers in a DDR register context
+ * @offset	Offset of the first register from the context base address
+ * @count	Number of registers in the run, 0 terminates the list
+ */
+typedef struct {
+	const u16 offset;
+	const u16 count;
+} PmDdrCtxRange;
+
+/**
+ * PmDdrCtx - DDR register context
+ * @base	Base address of the register block
+ * @ranges	Register runs, in the order they are restored
+ * @values	Saved values, one per register of the runs
+ */
+typedef struct {
+	const u32 base;
+	const PmDdrCtxRange *const ranges;
+	u32 *const values;
+} PmDdrCtx;
+
 /* DDR states */
 static const u32 pmDdrStates[PM_DDR_STATE_MAX] = {
 	[PM_DDR_STATE_OFF] = 0U,
@@ -401,281 +448,170 @@ static const PmStateTran pmDdrTransitions[] = {
 /* If it is required to enable drift */
 static u8 drift_enable_req __attribute__((__section__(".srdata")));
 
-static PmRegisterContext ctx_ddrc[] __attribute__((__section__(".srdata"))) = {
-	{ .addr = DDRC_MSTR, },
-	{ .addr = DDRC_MRCTRL0, },
-	{ .addr = DDRC_DERATEEN, },
-	{ .addr = DDRC_DERATEINT, },
-	{ .addr = DDRC_PWRCTL, },
-	{ .addr = DDRC_PWRTMG, },
-	{ .addr = DDRC_RFSHCTL0, },
-	{ .addr = DDRC_RFSHCTL1, },
-	{ .addr = DDRC_RFSHCTL3, },
-	{ .addr = DDRC_RFSHTMG, },
-	{ .addr = DDRC_ECCCFG0, },
-	{ .addr = DDRC_ECCCFG1, },
-	{ .addr = DDRC_CRCPARCTL1, },
-	{ .addr = DDRC_CRCPARCTL2, },
-	{ .addr = DDRC_INIT(0U), },
-	{ .addr = DDRC_INIT(1U), },
-	{ .addr = DDRC_INIT(2U), },
-	{ .addr = DDRC_INIT(3U), },
-	{ .addr = DDRC_INIT(4U), },
-	{ .addr = DDRC_INIT(5U), },
-	{ .addr = DDRC_INIT(6U), },
-	{ .addr = DDRC_INIT(7U), },
-	{ .addr = DDRC_DIMMCTL, },
-	{ .addr = DDRC_RANKCTL, },
-	{ .addr = DDRC_DRAMTMG(0U), },
-	{ .addr = DDRC_DRAMTMG(1U), },
-	{ .addr = DDRC_DRAMTMG(2U), },
-	{ .addr = DDRC_DRAMTMG(3U), },
-	{ .addr = DDRC_DRAMTMG(4U), },
-	{ .addr = DDRC_DRAMTMG(5U), },
-	{ .addr = DDRC_DRAMTMG(6U), },
-	{ .addr = DDRC_DRAMTMG(7U), },
-	{ .addr = DDRC_DRAMTMG(8U), },
-	{ .addr = DDRC_DRAMTMG(9U), },
-	{ .addr = DDRC_DRAMTMG(11U), },
-	{ .addr = DDRC_DRAMTMG(12U), },
-	{ .addr = DDRC_DRAMTMG(13U), },
-	{ .addr = DDRC_DRAMTMG(14U), },
-	{ .addr = DDRC_ZQCTL(0U), },
-	{ .addr = DDRC_ZQCTL(1U), },
-	{ .addr = DDRC_DFITMG0, },
-	{ .addr = DDRC_DFITMG1, },
-	{ .addr = DDRC_DFILPCFG(0U), },
-	{ .addr = DDRC_DFILPCFG(1U), },
-	{ .addr = DDRC_DFIUPD0, },
-	{ .addr = DDRC_DFIUPD1, },
-	{ .addr = DDRC_DFIMISC, },
-	{ .addr = DDRC_DFITMG2, },
-	{ .addr = DDRC_DBICTL, },
-	{ .addr = DDRC_ADDRMAP(0U), },
-	{ .addr = DDRC_ADDRMAP(1U), },
-	{ .addr = DDRC_ADDRMAP(2U), },
-	{ .addr = DDRC_ADDRMAP(3U), },
-	{ .addr = DDRC_ADDRMAP(4U), },
-	{ .addr = DDRC_ADDRMAP(5U), },
-	{ .addr = DDRC_ADDRMAP(6U), },
-	{ .addr = DDRC_ADDRMAP(7U), },
-	{ .addr = DDRC_ADDRMAP(8U), },
-	{ .addr = DDRC_ADDRMAP(9U), },
-	{ .addr = DDRC_ADDRMAP(10U), },
-	{ .addr = DDRC_ADDRMAP(11U), },
-	{ .addr = DDRC_ODTCFG, },
-	{ .addr = DDRC_ODTMAP, },
-	{ .addr = DDRC_SCHED, },
-	{ .addr = DDRC_PERFLPR1, },
-	{ .addr = DDRC_PERFWR1, },
-	{ .addr = DDRC_DQMAP5, },
-	{ .addr = DDRC_DBG0, },
-	{ .addr = DDRC_DBGCMD, },
-	{ .addr = DDRC_PCCFG, },
-	{ .addr = DDRC_PCFGR(0U), },
-	{ .addr = DDRC_PCFGW(0U), },
-	{ .addr = DDRC_PCTRL(0U), },
-	{ .addr = DDRC_PCFGQOS(0U, 0U), },
-	{ .addr = DDRC_PCFGQOS(1U, 0U), },
-	{ .addr = DDRC_PCFGR(1U), },
-	{ .addr = DDRC_PCFGW(1U), },
-	{ .addr = DDRC_PCTRL(1U), },
-	{ .addr = DDRC_PCFGQOS(0U, 1U), },
-	{ .addr = DDRC_PCFGQOS(1U, 1U), },
-	{ .addr = DDRC_PCFGR(2U), },
-	{ .addr = DDRC_PCFGW(2U), },
-	{ .addr = DDRC_PCTRL(2U), },
-	{ .addr = DDRC_PCFGQOS(0U, 2U), },
-	{ .addr = DDRC_PCFGQOS(1U, 2U), },
-	{ .addr = DDRC_PCFGR(3U), },
-	{ .addr = DDRC_PCFGW(3U), },
-	{ .addr = DDRC_PCTRL(3U), },
-	{ .addr = DDRC_PCFGQOS(0U, 3U), },
-	{ .addr = DDRC_PCFGQOS(1U, 3U), },
-	{ .addr = DDRC_PCFGWQOS(0U, 3U), },
-	{ .addr = DDRC_PCFGWQOS(1U, 3U), },
-	{ .addr = DDRC_PCFGR(4U), },
-	{ .addr = DDRC_PCFGW(4U), },
-	{ .addr = DDRC_PCTRL(4U), },
-	{ .addr = DDRC_PCFGQOS(0U, 4U), },
-	{ .addr = DDRC_PCFGQOS(1U, 4U), },
-	{ .addr = DDRC_PCFGWQOS(0U, 4U), },
-	{ .addr = DDRC_PCFGWQOS(1U, 4U), },
-	{ .addr = DDRC_PCFGR(5U), },
-	{ .addr = DDRC_PCFGW(5U), },
-	{ .addr = DDRC_PCTRL(5U), },
-	{ .addr = DDRC_PCFGQOS(0U, 5U), },
-	{ .addr = DDRC_PCFGQOS(1U, 5U), },
-	{ .addr = DDRC_PCFGWQOS(0U, 5U), },
-	{ .addr = DDRC_PCFGWQOS(1U, 5U), },
-	{ .addr = DDRC_SARBASE(0U), },
-	{ .addr = DDRC_SARSIZE(0U), },
-	{ .addr = DDRC_SARBASE(1U), },
-	{ .addr = DDRC_SARSIZE(1U), },
-	{ },
-};
+/*
+ * Register context is kept as runs of consecutive registers. Only the values
+ * are placed in .srdata (which is copied to flash for Power Off Suspend), the
+ * register layout stays in read-only memory.
+ */
+#define DDR_CTX_RANGE(reg, n)	{ .offset = (u16)((reg) & 0xFFFFU), .count = (n), },
+#define DDR_CTX_COUNT(reg, n)	+ (n)
+
+#define DDR_CTX_DEFINE(name, base_addr, LIST) \
+	static const PmDdrCtxRange name##_ranges[] = { \
+		LIST(DDR_CTX_RANGE) \
+		{ }, \
+	}; \
+	static u32 name##_values[0U LIST(DDR_CTX_COUNT)] \
+		__attribute__((__section__(".srdata"))); \
+	static const PmDdrCtx name = { \
+		.base = (base_addr), \
+		.ranges = name##_ranges, \
+		.values = name##_values, \
+	}
 
-static PmRegisterContext ctx_ddrphy[] __attribute__((__section__(".srdata"))) = {
-	{ .addr = DDRPHY_PGCR(0U), },
-	{ .addr = DDRPHY_PGCR(2U), },
-	{ .addr = DDRPHY_PGCR(3U), },
-	{ .addr = DDRPHY_PGCR(5U), },
-	{ .addr = DDRPHY_PTR(0U), },
-	{ .addr = DDRPHY_PTR(1U), },
-	{ .addr = DDRPHY_PLLCR(0U), },
-	{ .addr = DDRPHY_DSGCR, },
-	{ .addr = DDRPHY_GPR(0U), },
-	{ .addr = DDRPHY_DCR, },
-	{ .addr = DDRPHY_DTPR(0U), },
-	{ .addr = DDRPHY_DTPR(1U), },
-	{ .addr = DDRPHY_DTPR(2U), },
-	{ .addr = DDRPHY_DTPR(3U), },
-	{ .addr = DDRPHY_DTPR(4U), },
-	{ .addr = DDRPHY_DTPR(5U), },
-	{ .addr = DDRPHY_DTPR(6U), },
-	{ .addr = DDRPHY_RDIMMGCR(0U), },
-	{ .addr = DDRPHY_RDIMMGCR(1U), },
-	{ .addr = DDRPHY_RDIMMCR(0U), },
-	{ .addr = DDRPHY_RDIMMCR(1U), },
-	{ .addr = DDRPHY_MR(0U), },
-	{ .addr = DDRPHY_MR(1U), },
-	{ .addr = DDRPHY_MR(2U), },
-	{ .addr = DDRPHY_MR(3U), },
-	{ .addr = DDRPHY_MR(4U), },
-	{ .addr = DDRPHY_MR(5U), },
-	{ .addr = DDRPHY_MR(6U), },
-	{ .addr = DDRPHY_MR(11U), },
-	{ .addr = DDRPHY_MR(12U), },
-	{ .addr = DDRPHY_MR(13U), },
-	{ .addr = DDRPHY_MR(14U), },
-	{ .addr = DDRPHY_MR(22U), },
-	{ .addr = DDRPHY_DTCR(0U), },
-	{ .addr = DDRPHY_DTCR(1U), },
-	{ .addr = DDRPHY_CATR(0U), },
-	{ .addr = DDRPHY_RIOCR(5U), },
-	{ .addr = DDRPHY_ACIOCR(0U), },
-	{ .addr = DDRPHY_ACIOCR(2U), },
-	{ .addr = DDRPHY_ACIOCR(3U), },
-	{ .addr = DDRPHY_ACIOCR(4U), },
-	{ .addr = DDRPHY_ACIOCR(5U), },
-	{ .addr = DDRPHY_IOVCR(0U), },
-	{ .addr = DDRPHY_VTCR(0U), },
-	{ .addr = DDRPHY_VTCR(1U), },
-	{ .addr = DDRPHY_DQSDR(0U), },
-	{ .addr = DDRPHY_DQSDR(1U), },
-	{ .addr = DDRPHY_ACBDLR(1U), },
-	{ .addr = DDRPHY_ACBDLR(2U), },
-	{ .addr = DDRPHY_ACBDLR(6U), },
-	{ .addr = DDRPHY_ACBDLR(7U), },
-	{ .addr = DDRPHY_ACBDLR(8U), },
-	{ .addr = DDRPHY_ACBDLR(9U), },
-	{ .addr = DDRPHY_ZQCR, },
-	{ .addr = DDRPHY_ZQPR(0U, 0U), },
-	{ .addr = DDRPHY_ZQPR(1U, 0U), },
-	{ .addr = DDRPHY_DXGCR(0U, 0U), },
-	{ .addr = DDRPHY_DXGCR(0U, 1U), },
-	{ .addr = DDRPHY_DXGCR(0U, 2U), },
-	{ .addr = DDRPHY_DXGCR(0U, 3U), },
-	{ .addr = DDRPHY_DXGCR(0U, 4U), },
-	{ .addr = DDRPHY_DXGCR(0U, 5U), },
-	{ .addr = DDRPHY_DXGCR(0U, 6U), },
-	{ .addr = DDRPHY_DXGCR(1U, 0U), },
-	{ .addr = DDRPHY_DXGCR(1U, 1U), },
-	{ .addr = DDRPHY_DXGCR(1U, 2U), },
-	{ .addr = DDRPHY_DXGCR(1U, 3U), },
-	{ .addr = DDRPHY_DXGCR(1U, 4U), },
-	{ .addr = DDRPHY_DXGCR(1U, 5U), },
-	{ .addr = DDRPHY_DXGCR(1U, 6U), },
-	{ .addr = DDRPHY_DXGCR(2U, 0U), },
-	{ .addr = DDRPHY_DXGCR(2U, 1U), },
-	{ .addr = DDRPHY_DXGCR(2U, 2U), },
-	{ .addr = DDRPHY_DXGCR(2U, 3U), },
-	{ .addr = DDRPHY_DXGCR(2U, 4U), },
-	{ .addr = DDRPHY_DXGCR(2U, 5U), },
-	{ .addr = DDRPHY_DXGCR(2U, 6U), },
-	{ .addr = DDRPHY_DXGCR(3U, 0U), },
-	{ .addr = DDRPHY_DXGCR(3U, 1U), },
-	{ .addr = DDRPHY_DXGCR(3U, 2U), },
-	{ .addr = DDRPHY_DXGCR(3U, 3U), },
-	{ .addr = DDRPHY_DXGCR(3U, 4U), },
-	{ .addr = DDRPHY_DXGCR(3U, 5U), },
-	{ .addr = DDRPHY_DXGCR(3U, 6U), },
-	{ .addr = DDRPHY_DXGCR(4U, 0U), },
-	{ .addr = DDRPHY_DXGCR(4U, 1U), },
-	{ .addr = DDRPHY_DXGCR(4U, 2U), },
-	{ .addr = DDRPHY_DXGCR(4U, 3U), },
-	{ .addr = DDRPHY_DXGCR(4U, 4U), },
-	{ .addr = DDRPHY_DXGCR(4U, 5U), },
-	{ .addr = DDRPHY_DXGCR(4U, 6U), },
-	{ .addr = DDRPHY_DXGCR(5U, 0U), },
-	{ .addr = DDRPHY_DXGCR(5U, 1U), },
-	{ .addr = DDRPHY_DXGCR(5U, 2U), },
-	{ .addr = DDRPHY_DXGCR(5U, 3U), },
-	{ .addr = DDRPHY_DXGCR(5U, 4U), },
-	{ .addr = DDRPHY_DXGCR(5U, 5U), },
-	{ .addr = DDRPHY_DXGCR(5U, 6U), },
-	{ .addr = DDRPHY_DXGCR(6U, 0U), },
-	{ .addr = DDRPHY_DXGCR(6U, 1U), },
-	{ .addr = DDRPHY_DXGCR(6U, 2U), },
-	{ .addr = DDRPHY_DXGCR(6U, 3U), },
-	{ .addr = DDRPHY_DXGCR(6U, 4U), },
-	{ .addr = DDRPHY_DXGCR(6U, 5U), },
-	{ .addr = DDRPHY_DXGCR(6U, 6U), },
-	{ .addr = DDRPHY_DXGCR(7U, 0U), },
-	{ .addr = DDRPHY_DXGCR(7U, 1U), },
-	{ .addr = DDRPHY_DXGCR(7U, 2U), },
-	{ .addr = DDRPHY_DXGCR(7U, 3U), },
-	{ .addr = DDRPHY_DXGCR(7U, 4U), },
-	{ .addr = DDRPHY_DXGCR(7U, 5U), },
-	{ .addr = DDRPHY_DXGCR(7U, 6U), },
-	{ .addr = DDRPHY_DXGCR(8U, 0U), },
-	{ .addr = DDRPHY_DXGCR(8U, 1U), },
-	{ .addr = DDRPHY_DXGCR(8U, 2U), },
-	{ .addr = DDRPHY_DXGCR(8U, 3U), },
-	{ .addr = DDRPHY_DXGCR(8U, 4U), },
-	{ .addr = DDRPHY_DXGCR(8U, 5U), },
-	{ .addr = DDRPHY_DXGCR(8U, 6U), },
-	{ .addr = DDRPHY_DX8SLNOSC(0U), },
-	{ .addr = DDRPHY_DX8SLPLLCR(0U, 0U), },
-	{ .addr = DDRPHY_DX8SLDQSCTL(0U), },
-	{ .addr = DDRPHY_DX8SLDXCTL2(0U), },
-	{ .addr = DDRPHY_DX8SLIOCR(0U), },
-	{ .addr = DDRPHY_DX8SLNOSC(1U), },
-	{ .addr = DDRPHY_DX8SLPLLCR(1U, 0U), },
-	{ .addr = DDRPHY_DX8SLDQSCTL(1U), },
-	{ .addr = DDRPHY_DX8SLDXCTL2(1U), },
-	{ .addr = DDRPHY_DX8SLIOCR(1U), },
-	{ .addr = DDRPHY_DX8SLNOSC(2U), },
-	{ .addr = DDRPHY_DX8SLPLLCR(2U, 0U), },
-	{ .addr = DDRPHY_DX8SLDQSCTL(2U), },
-	{ .addr = DDRPHY_DX8SLDXCTL2(2U), },
-	{ .addr = DDRPHY_DX8SLIOCR(2U), },
-	{ .addr = DDRPHY_DX8SLNOSC(3U), },
-	{ .addr = DDRPHY_DX8SLPLLCR(3U, 0U), },
-	{ .addr = DDRPHY_DX8SLDQSCTL(3U), },
-	{ .addr = DDRPHY_DX8SLDXCTL2(3U), },
-	{ .addr = DDRPHY_DX8SLIOCR(3U), },
-	{ .addr = DDRPHY_DX8SLNOSC(4U), },
-	{ .addr = DDRPHY_DX8SLPLLCR(4U, 0U), },
-	{ .addr = DDRPHY_DX8SLDQSCTL(4U), },
-	{ .addr = DDRPHY_DX8SLDXCTL2(4U), },
-	{ .addr = DDRPHY_DX8SLIOCR(4U), },
-	{ },
-};
+#define DDRC_CTX_LIST(R) \
+	R(DDRC_MSTR, 1U) \
+	R(DDRC_MRCTRL0, 1U) \
+	R(DDRC_DERATEEN, 2U) \
+	R(DDRC_PWRCTL, 2U) \
+	R(DDRC_RFSHCTL0, 2U) \
+	R(DDRC_RFSHCTL3, 2U) \
+	R(DDRC_ECCCFG0, 2U) \
+	R(DDRC_CRCPARCTL1, 2U) \
+	R(DDRC_INIT(0U), 10U) \
+	R(DDRC_DRAMTMG(0U), 10U) \
+	R(DDRC_DRAMTMG(11U), 4U) \
+	R(DDRC_ZQCTL(0U), 2U) \
+	R(DDRC_DFITMG0, 6U) \
+	R(DDRC_DFIMISC, 2U) \
+	R(DDRC_DBICTL, 1U) \
+	R(DDRC_ADDRMAP(0U), 12U) \
+	R(DDRC_ODTCFG, 2U) \
+	R(DDRC_SCHED, 1U) \
+	R(DDRC_PERFLPR1, 1U) \
+	R(DDRC_PERFWR1, 1U) \
+	R(DDRC_DQMAP5, 1U) \
+	R(DDRC_DBG0, 1U) \
+	R(DDRC_DBGCMD, 1U) \
+	R(DDRC_PCCFG, 3U) \
+	R(DDRC_PCTRL(0U), 3U) \
+	R(DDRC_PCFGR(1U), 2U) \
+	R(DDRC_PCTRL(1U), 3U) \
+	R(DDRC_PCFGR(2U), 2U) \
+	R(DDRC_PCTRL(2U), 3U) \
+	R(DDRC_PCFGR(3U), 2U) \
+	R(DDRC_PCTRL(3U), 5U) \
+	R(DDRC_PCFGR(4U), 2U) \
+	R(DDRC_PCTRL(4U), 5U) \
+	R(DDRC_PCFGR(5U), 2U) \
+	R(DDRC_PCTRL(5U), 5U) \
+	R(DDRC_SARBASE(0U), 4U)
+
+DDR_CTX_DEFINE(ctx_ddrc, DDRC_BASE, DDRC_CTX_LIST);
+
+#define DDRPHY_CTX_LIST(R) \
+	R(DDRPHY_PGCR(0U), 1U) \
+	R(DDRPHY_PGCR(2U), 2U) \
+	R(DDRPHY_PGCR(5U), 1U) \
+	R(DDRPHY_PTR(0U), 2U) \
+	R(DDRPHY_PLLCR(0U), 1U) \
+	R(DDRPHY_DSGCR, 1U) \
+	R(DDRPHY_GPR(0U), 1U) \
+	R(DDRPHY_DCR, 1U) \
+	R(DDRPHY_DTPR(0U), 7U) \
+	R(DDRPHY_RDIMMGCR(0U), 2U) \
+	R(DDRPHY_RDIMMCR(0U), 2U) \
+	R(DDRPHY_MR(0U), 7U) \
+	R(DDRPHY_MR(11U), 4U) \
+	R(DDRPHY_MR(22U), 1U) \
+	R(DDRPHY_DTCR(0U), 2U) \
+	R(DDRPHY_CATR(0U), 1U) \
+	R(DDRPHY_RIOCR(5U), 1U) \
+	R(DDRPHY_ACIOCR(0U), 1U) \
+	R(DDRPHY_ACIOCR(2U), 4U) \
+	R(DDRPHY_IOVCR(0U), 1U) \
+	R(DDRPHY_VTCR(0U), 2U) \
+	R(DDRPHY_DQSDR(0U), 2U) \
+	R(DDRPHY_ACBDLR(1U), 2U) \
+	R(DDRPHY_ACBDLR(6U), 4U) \
+	R(DDRPHY_ZQCR, 2U) \
+	R(DDRPHY_ZQPR(1U, 0U), 1U) \
+	R(DDRPHY_DXGCR(0U, 0U), 7U) \
+	R(DDRPHY_DXGCR(1U, 0U), 7U) \
+	R(DDRPHY_DXGCR(2U, 0U), 7U) \
+	R(DDRPHY_DXGCR(3U, 0U), 7U) \
+	R(DDRPHY_DXGCR(4U, 0U), 7U) \
+	R(DDRPHY_DXGCR(5U, 0U), 7U) \
+	R(DDRPHY_DXGCR(6U, 0U), 7U) \
+	R(DDRPHY_DXGCR(7U, 0U), 7U) \
+	R(DDRPHY_DXGCR(8U, 0U), 7U) \
+	R(DDRPHY_DX8SLNOSC(0U), 2U) \
+	R(DDRPHY_DX8SLDQSCTL(0U), 1U) \
+	R(DDRPHY_DX8SLDXCTL2(0U), 2U) \
+	R(DDRPHY_DX8SLNOSC(1U), 2U) \
+	R(DDRPHY_DX8SLDQSCTL(1U), 1U) \
+	R(DDRPHY_DX8SLDXCTL2(1U), 2U) \
+	R(DDRPHY_DX8SLNOSC(2U), 2U) \
+	R(DDRPHY_DX8SLDQSCTL(2U), 1U) \
+	R(DDRPHY_DX8SLDXCTL2(2U), 2U) \
+	R(DDRPHY_DX8SLNOSC(3U), 2U) \
+	R(DDRPHY_DX8SLDQSCTL(3U), 1U) \
+	R(DDRPHY_DX8SLDXCTL2(3U), 2U) \
+	R(DDRPHY_DX8SLNOSC(4U), 2U) \
+	R(DDRPHY_DX8SLDQSCTL(4U), 1U) \
+	R(DDRPHY_DX8SLDXCTL2(4U), 2U)
+
+DDR_CTX_DEFINE(ctx_ddrphy, DDRPHY_BASE, DDRPHY_CTX_LIST);
 
 static PmRegisterContext ctx_ddrphy_odtcr[] __attribute__((__section__(".srdata"))) = {
 	{ .addr = DDRPHY_ODTCR, },
 	{ .addr = DDRPHY_ODTCR, },
 };
 
-static PmRegisterContext ctx_ddrphy_zqdata[] __attribute__((__section__(".srdata"))) = {
-	{ .addr = DDRPHY_ZQDR0(0U), },
-	{ .addr = DDRPHY_ZQDR1(0U), },
-	{ .addr = DDRPHY_ZQDR0(1U), },
-	{ .addr = DDRPHY_ZQDR1(1U), },
+#define DDRPHY_ZQDATA_CTX_LIST(R) \
+	R(DDRPHY_ZQDR0(0U), 2U) \
+	R(DDRPHY_ZQDR0(1U), 2U)
+
+DDR_CTX_DEFINE(ctx_ddrphy_zqdata, DDRPHY_BASE, DDRPHY_ZQDATA_CTX_LIST);
+
+#ifdef ENABLE_DDR_SR_FAST_RESTORE
+/* Trained delays of one byte lane, DDRPHY_DX_STRIDE apart per lane */
+#define DDRPHY_DX_TRAIN_LIST(R) \
+	R(DDRPHY_DXBDLR0(0U), 3U) \
+	R(DDRPHY_DXBDLR3(0U), 3U) \
+	R(DDRPHY_DXBDLR6(0U), 1U) \
+	R(DDRPHY_DXLCDLR(0U, 0U), 6U) \
+	R(DDRPHY_DXGTR0(0U), 1U)
+
+static const PmDdrCtxRange ctx_dx_train_ranges[] = {
+	DDRPHY_DX_TRAIN_LIST(DDR_CTX_RANGE)
 	{ },
 };
 
+/* Trained delays of all byte lanes, per rank */
+static u32 ctx_dx_train_values[DDRPHY_MAX_RANKS]
+			      [DDRPHY_DX_NUM * (0U DDRPHY_DX_TRAIN_LIST(DDR_CTX_COUNT))]
+	__attribute__((__section__(".srdata")));
+
+/* Set when the PHY delays are restored instead of retraining on SR exit */
+static u8 ddr_fast_restore __attribute__((__section__(".srdata")));
+#endif
+
+#if defined(PM_LOG_LEVEL) && (PM_LOG_LEVEL >= PM_INFO)
+static const char *const ddrSrStepNames[DDR_SR_STEP_MAX] = {
+	[DDR_SR_STEP_TRAIN_SAVE] = "training save",
+	[DDR_SR_STEP_CTX_SAVE] = "context save",
+	[DDR_SR_STEP_SR_ENTRY] = "SR entry",
+	[DDR_SR_STEP_CTX_RESTORE] = "context restore",
+	[DDR_SR_STEP_PHY_INIT] = "PHY init",
+	[DDR_SR_STEP_TRAINING] = "training",
+	[DDR_SR_STEP_TRAIN_RESTORE] = "training restore",
+};
+#endif
+
+/* PMU cycles spent in each step of the last SR entry/exit */
+static u32 ddrSrStepCycles[DDR_SR_STEP_MAX];
+
 static void ddr_disable_wr_drift(void)
 {
 	u32 r;
@@ -964,69 +900,129 @@ static void ddr_clock_enable(void)
 	Xil_Out32(DDRQOS_DDR_CLK_CTRL, r);
 }
 
-static void store_state(PmRegisterContext *context)
+static u32 store_state_fixup(u32 addr, u32 value)
 {
-	while (context->addr != 0U) {
-		context->value = Xil_In32(context->addr);
+	u32 val = value;
+
+	if (addr == DDRC_RFSHCTL3) {
+		/* disable auto-refresh */
+		val |= DDRC_RFSHCTL3_AUTORF_DIS;
+	} else if (addr == DDRC_ZQCTL(0U)) {
+		/* disable auto-sq */
+		val |= DDRC_ZQCTL0_ZQ_DIS;
+	} else if (addr == DDRC_PWRCTL) {
+		/* self-refresh mode */
+		val = 0x00000020U;
+	} else if (addr == DDRC_INIT(0U)) {
+		/* skip DRAM init and start in self-refresh */
+		val |= 0xc0000000U;
+	} else if (addr == DDRC_DFIMISC) {
+		val &= ~1U;
+	} else if (addr == DDRPHY_PGCR(0U)) {
+		/* assert FIFO reset */
+		val &= ~DDRPHY_PGCR0_PHYFRST;
+	} else if (addr == DDRPHY_DX8SLNOSC(0U) ||
+		   addr == DDRPHY_DX8SLNOSC(1U) ||
+		   addr == DDRPHY_DX8SLNOSC(2U) ||
+		   addr == DDRPHY_DX8SLNOSC(3U) ||
+		   addr == DDRPHY_DX8SLNOSC(4U)) {
+		/* assert FIFO reset */
+		val &= ~DDRPHY_DX8SLBOSC_PHYFRST;
+	} else {
+		/* no modification needed */
+	}
+
+	return val;
+}
+
+/**
+ * ddr_ctx_read() - Read registers of a range list
+ * @base	Base address the range offsets are relative to
+ * @range	Range list, terminated by a zero count
+ * @value	Location to store the first value to
+ *
+ * @return	Location following the last value stored
+ */
+static u32 *ddr_ctx_read(u32 base, const PmDdrCtxRange *range, u32 *value)
+{
+	u32 addr;
+	u32 i;
 
-		if (context->addr == DDRC_RFSHCTL3) {
-			/* disable auto-refresh */
-			context->value |= DDRC_RFSHCTL3_AUTORF_DIS;
-		} else if (context->addr == DDRC_ZQCTL(0U)) {
-			/* disable auto-sq */
-			context->value |= DDRC_ZQCTL0_ZQ_DIS;
-		} else if (context->addr == DDRC_PWRCTL) {
-			/* self-refresh mode */
-			context->value = 0x00000020U;
-		} else if (context->addr == DDRC_INIT(0U)) {
-			/* skip DRAM init and start in self-refresh */
-			context->value |= 0xc0000000U;
-		} else if (context->addr == DDRC_DFIMISC) {
-			context->value &= ~1U;
-		} else if (context->addr == DDRPHY_PGCR(0U)) {
-			/* assert FIFO reset */
-			context->value &= ~DDRPHY_PGCR0_PHYFRST;
-		} else if (context->addr == DDRPHY_DX8SLNOSC(0U) ||
-			   context->addr == DDRPHY_DX8SLNOSC(1U) ||
-			   context->addr == DDRPHY_DX8SLNOSC(2U) ||
-			   context->addr == DDRPHY_DX8SLNOSC(3U) ||
-			   context->addr == DDRPHY_DX8SLNOSC(4U)) {
-			/* assert FIFO reset */
-			context->value &= ~DDRPHY_DX8SLBOSC_PHYFRST;
+	for (; range->count != 0U; range++) {
+		addr = base + range->offset;
+		for (i = 0U; i < range->count; i++) {
+			*value = Xil_In32(addr);
+			value++;
+			addr += 4U;
 		}
-#ifdef DDRSR_DEBUG_STATE
-		ddr_print_dbg("%s: addr:%lx, value:%lx\r\n",
-			      __func__, context->addr, context->value);
-#endif
-		context++;
 	}
+
+	return value;
 }
 
-static void restore_state(PmRegisterContext *context)
+/**
+ * ddr_ctx_write() - Write registers of a range list
+ * @base	Base address the range offsets are relative to
+ * @range	Range list, terminated by a zero count
+ * @value	Location of the first value to write
+ *
+ * @return	Location following the last value written
+ */
+static const u32 *ddr_ctx_write(u32 base, const PmDdrCtxRange *range,
+				const u32 *value)
 {
-	while (context->addr != 0U) {
+	u32 addr;
+	u32 i;
+
+	for (; range->count != 0U; range++) {
+		addr = base + range->offset;
+		for (i = 0U; i < range->count; i++) {
 #ifdef DDRSR_DEBUG_STATE
-		ddr_print_dbg("%s: addr:0x%lx, value:0x%lx\r\n",
-			      __func__, context->addr, context->value);
+			ddr_print_dbg("%s: addr:0x%lx, value:0x%lx\r\n",
+				      __func__, addr, *value);
 #endif
-		Xil_Out32(context->addr, context->value);
-		context++;
+			Xil_Out32(addr, *value);
+			value++;
+			addr += 4U;
+		}
 	}
+
+	return value;
 }
 
-static void restore_ddrphy_zqdata(PmRegisterContext *context)
+static void store_state(const PmDdrCtx *const ctx)
 {
-	while (context->addr != 0U) {
+	const PmDdrCtxRange *range;
+	u32 *value = ctx->values;
+	u32 addr;
+	u32 i;
+
+	for (range = ctx->ranges; range->count != 0U; range++) {
+		addr = ctx->base + range->offset;
+		for (i = 0U; i < range->count; i++) {
+			*value = store_state_fixup(addr, Xil_In32(addr));
 #ifdef DDRSR_DEBUG_STATE
-		ddr_print_dbg("%s: addr:%lx, value:%lx\r\n",
-			      __func__, context->addr + 8U, context->value);
+			ddr_print_dbg("%s: addr:%lx, value:%lx\r\n",
+				      __func__, addr, *value);
 #endif
-		/* write result data back to override register */
-		Xil_Out32(context->addr + DDRPHY_ZQnOR_OFFSET, context->value);
-		context++;
+			value++;
+			addr += 4U;
+		}
 	}
 }
 
+static void restore_state(const PmDdrCtx *const ctx)
+{
+	(void)ddr_ctx_write(ctx->base, ctx->ranges, ctx->values);
+}
+
+static void restore_ddrphy_zqdata(const PmDdrCtx *const ctx)
+{
+	/* write result data back to override register */
+	(void)ddr_ctx_write(ctx->base + DDRPHY_ZQnOR_OFFSET, ctx->ranges,
+			    ctx->values);
+}
+
 static void store_ddrphy_odtcr(PmRegisterContext *context)
 {
 	u32 rank = Xil_In32(DDRC_MSTR) & DDRC_DUAL_RANK_MASK;
@@ -1063,6 +1059,91 @@ static void restore_ddrphy_odtcr(PmRegisterContext *context)
 	}
 }
 
+#ifdef ENABLE_DDR_SR_FAST_RESTORE
+/**
+ * ddr_fast_restore_supported() - Check if trained delays can be restored
+ *
+ * @return	True for DDR3/DDR4, LPDDR3/LPDDR4 retrain on every SR exit
+ */
+static bool ddr_fast_restore_supported(void)
+{
+	u32 ddrType = Xil_In32(DDRC_MSTR) & DDRC_MSTR_DDR_TYPE;
+
+	return ((DDRC_MSTR_DDR3 == ddrType) || (DDRC_MSTR_DDR4 == ddrType));
+}
+
+static u32 ddr_rank_count(void)
+{
+	u32 rank = Xil_In32(DDRC_MSTR) & DDRC_DUAL_RANK_MASK;
+
+	return (DDRC_DUAL_RANK_MASK == rank) ? 2U : 1U;
+}
+
+/**
+ * store_ddrphy_train() - Save trained delays of all byte lanes and ranks
+ */
+static void store_ddrphy_train(void)
+{
+	u32 rank, lane;
+	u32 *value;
+
+	for (rank = 0U; rank < ddr_rank_count(); rank++) {
+		XPfw_RMW32(DDRPHY_RANKIDR, DDRPHY_RANKRID_MASK,
+			   rank << DDRPHY_RANKRID_SHIFT);
+		value = ctx_dx_train_values[rank];
+		for (lane = 0U; lane < DDRPHY_DX_NUM; lane++) {
+			value = ddr_ctx_read(DDRPHY_BASE +
+					     (DDRPHY_DX_STRIDE * lane),
+					     ctx_dx_train_ranges, value);
+		}
+	}
+	XPfw_RMW32(DDRPHY_RANKIDR, DDRPHY_RANKRID_MASK, 0U);
+}
+
+/**
+ * restore_ddrphy_train() - Write back trained delays saved on SR entry
+ *
+ * @note	VT compensation is inhibited while the delay lines are written
+ */
+static void restore_ddrphy_train(void)
+{
+	u32 rank, lane;
+	const u32 *value;
+
+	XPfw_RMW32(DDRPHY_PGCR(6U), DDRPHY_PGCR6_INHVT, DDRPHY_PGCR6_INHVT);
+	for (rank = 0U; rank < ddr_rank_count(); rank++) {
+		XPfw_RMW32(DDRPHY_RANKIDR, DDRPHY_RANKWID_MASK, rank);
+		value = ctx_dx_train_values[rank];
+		for (lane = 0U; lane < DDRPHY_DX_NUM; lane++) {
+			value = ddr_ctx_write(DDRPHY_BASE +
+					      (DDRPHY_DX_STRIDE * lane),
+					      ctx_dx_train_ranges, value);
+		}
+	}
+	XPfw_RMW32(DDRPHY_RANKIDR, DDRPHY_RANKWID_MASK, 0U);
+	XPfw_RMW32(DDRPHY_PGCR(6U), DDRPHY_PGCR6_INHVT, 0U);
+}
+#endif
+
+/**
+ * ddr_sr_report() - Print time spent in each step of the last SR entry/exit
+ */
+static void ddr_sr_report(void)
+{
+#if defined(PM_LOG_LEVEL) && (PM_LOG_LEVEL >= PM_INFO)
+	u32 i;
+	u32 total = 0U;
+
+	for (i = 0U; i < DDR_SR_STEP_MAX; i++) {
+		PmInfo("DDR SR %s: %lu us\r\n", ddrSrStepNames[i],
+		       ddrSrStepCycles[i] / (XPFW_CFG_PMU_CLK_FREQ / 1000000U));
+		total += ddrSrStepCycles[i];
+	}
+	PmInfo("DDR SR total: %lu us\r\n",
+	       total / (XPFW_CFG_PMU_CLK_FREQ / 1000000U));
+#endif
+}
+
 static void ddr_io_retention_set(bool en)
 {
 	u32 r = Xil_In32(PMU_GLOBAL_DDR_CNTRL);
@@ -1201,6 +1282,14 @@ static void DDR_reinit(bool ddrss_is_reset)
 	size_t i;
 	u32 readVal, busWidth;
 	XStatus status = XST_FAILURE;
+	u32 cycles = DDR_SR_CYCLES();
+	bool retrain = true;
+
+#ifdef ENABLE_DDR_SR_FAST_RESTORE
+	if (0U != ddr_fast_restore) {
+		retrain = false;
+	}
+#endif
 
 	if (true == ddrss_is_reset) {
 		/* Data Bus Width */
@@ -1294,7 +1383,7 @@ static void DDR_reinit(bool ddrss_is_reset)
 			Xil_Out32(DDRPHY_ZQPR(i, 0U), readVal);
 		}
 		restore_ddrphy_odtcr(ctx_ddrphy_odtcr);
-		restore_ddrphy_zqdata(ctx_ddrphy_zqdata);
+		restore_ddrphy_zqdata(&ctx_ddrphy_zqdata);
 
 		Xil_Out32(DDRPHY_PIR, DDRPHY_PIR_CTLDINIT);
 		Xil_Out32(DDRPHY_PIR, DDRPHY_PIR_CTLDINIT |
@@ -1338,6 +1427,11 @@ static void DDR_reinit(bool ddrss_is_reset)
 					      PM_DDR_POLL_PERIOD);
 		REPORT_IF_ERROR(status);
 
+#ifdef ENABLE_DDR_SR_FAST_RESTORE
+		if (false == retrain) {
+			restore_ddrphy_train();
+		}
+#endif
 		ddr_enable_drift();
 
 		/* FIFO reset */
@@ -1369,9 +1463,14 @@ static void DDR_reinit(bool ddrss_is_reset)
 		readVal >>= DDRC_STAT_OPMODE_SHIFT;
 	} while (readVal != DDRC_STAT_OPMODE_NORMAL);
 
+	ddrSrStepCycles[DDR_SR_STEP_PHY_INIT] = DDR_SR_CYCLES() - cycles;
+	cycles = DDR_SR_CYCLES();
+
 	if (true == ddrss_is_reset) {
 		readVal = Xil_In32(DDRC_MSTR) & DDRC_MSTR_DDR_TYPE;
-		if (readVal == DDRC_MSTR_LPDDR3 ) {
+		if (false == retrain) {
+			/* trained delays were restored, skip data training */
+		} else if (readVal == DDRC_MSTR_LPDDR3 ) {
 			Xil_Out32(DDRPHY_PIR, DDRPHY_PIR_CTLDINIT |
 					      DDRPHY_PIR_WREYE |
 					      DDRPHY_PIR_RDEYE |
@@ -1521,19 +1620,21 @@ static void DDR_reinit(bool ddrss_is_reset)
 		readVal &= ~DDRC_ZQCTL0_ZQ_DIS;
 		Xil_Out32(DDRC_ZQCTL(0U), readVal);
 	} else {
-		Xil_Out32(DDRPHY_PIR, DDRPHY_PIR_WREYE |
-				      DDRPHY_PIR_RDEYE |
-				      DDRPHY_PIR_WRDSKW |
-				      DDRPHY_PIR_RDDSKW);
-		status = XPfw_UtilPollForMask(DDRPHY_PGSR(0U),
-					      DDRPHY_PGSR0_IDONE,
-					      PM_DDR_POLL_PERIOD);
-		REPORT_IF_ERROR(status);
+		if (true == retrain) {
+			Xil_Out32(DDRPHY_PIR, DDRPHY_PIR_WREYE |
+					      DDRPHY_PIR_RDEYE |
+					      DDRPHY_PIR_WRDSKW |
+					      DDRPHY_PIR_RDDSKW);
+			status = XPfw_UtilPollForMask(DDRPHY_PGSR(0U),
+						      DDRPHY_PGSR0_IDONE,
+						      PM_DDR_POLL_PERIOD);
+			REPORT_IF_ERROR(status);
 
-		status = XPfw_UtilPollForZero(DDRPHY_PGSR(0U),
-					      DDRPHY_PGSR0_TRAIN_ERRS,
-					      PM_DDR_POLL_PERIOD);
-		REPORT_IF_ERROR(status);
+			status = XPfw_UtilPollForZero(DDRPHY_PGSR(0U),
+						      DDRPHY_PGSR0_TRAIN_ERRS,
+						      PM_DDR_POLL_PERIOD);
+			REPORT_IF_ERROR(status);
+		}
 
 		/* enable AXI ports */
 		for (i = 0U; i < 6U; i++) {
@@ -1545,6 +1646,8 @@ static void DDR_reinit(bool ddrss_is_reset)
 			Xil_Out32(DDRC_PCTRL(i), readVal);
 		}
 	}
+
+	ddrSrStepCycles[DDR_SR_STEP_TRAINING] = DDR_SR_CYCLES() - cycles;
 }
 
 static inline u32 get_old_map_offset(void)
@@ -1805,13 +1908,27 @@ static void restore_training_data(void)
 
 static s32 pm_ddr_sr_enter(void)
 {
-	s32 ret;
+	s32 ret = XST_SUCCESS;
+	u32 cycles = DDR_SR_CYCLES();
 
-	ret = store_training_data();
+#ifdef ENABLE_DDR_SR_FAST_RESTORE
+	/*
+	 * Without data training the training area in DDR is not overwritten
+	 * on SR exit, so there is nothing to save
+	 */
+	ddr_fast_restore = ddr_fast_restore_supported() ? 1U : 0U;
+	if (0U == ddr_fast_restore)
+#endif
+	{
+		ret = store_training_data();
+	}
 	if (XST_SUCCESS != ret) {
 		goto err;
 	}
 
+	ddrSrStepCycles[DDR_SR_STEP_TRAIN_SAVE] = DDR_SR_CYCLES() - cycles;
+	cycles = DDR_SR_CYCLES();
+
 	/* Identify if drift is enabled */
 	if ((Xil_In32(DDRPHY_DQSDR(0U)) & DDRPHY_DQSDR0_DFTDTEN) != 0U) {
 		drift_enable_req = 1U;
@@ -1821,16 +1938,26 @@ static s32 pm_ddr_sr_enter(void)
 	ddr_disable_rd_drift();
 	ddr_disable_wr_drift();
 
-	store_state(ctx_ddrc);
-	store_state(ctx_ddrphy);
-	store_state(ctx_ddrphy_zqdata);
+	store_state(&ctx_ddrc);
+	store_state(&ctx_ddrphy);
+	store_state(&ctx_ddrphy_zqdata);
 	store_ddrphy_odtcr(ctx_ddrphy_odtcr);
+#ifdef ENABLE_DDR_SR_FAST_RESTORE
+	if (0U != ddr_fast_restore) {
+		store_ddrphy_train();
+	}
+#endif
+
+	ddrSrStepCycles[DDR_SR_STEP_CTX_SAVE] = DDR_SR_CYCLES() - cycles;
+	cycles = DDR_SR_CYCLES();
 
 	ret = ddrc_enable_sr();
 	if (XST_SUCCESS != ret) {
 		goto err;
 	}
 
+	ddrSrStepCycles[DDR_SR_STEP_SR_ENTRY] = DDR_SR_CYCLES() - cycles;
+
 #ifdef ENABLE_DDR_SR_WR
 	/* Set self refresh mode indication flag */
 	XPfw_RMW32(XPFW_DDR_STATUS_REGISTER_OFFSET, DDR_STATUS_FLAG_MASK,
@@ -1845,6 +1972,8 @@ err:
 
 static void pm_ddr_sr_exit(bool ddrss_is_reset)
 {
+	u32 cycles = DDR_SR_CYCLES();
+
 	if (true == ddrss_is_reset) {
 		u32 readVal;
 
@@ -1852,18 +1981,29 @@ static void pm_ddr_sr_exit(bool ddrss_is_reset)
 		ddr_clock_enable();
 
 		Xil_Out32(DDRC_SWCTL, 0U);
-		restore_state(ctx_ddrc);
+		restore_state(&ctx_ddrc);
 
 		readVal = Xil_In32(CRF_APB_RST_DDR_SS);
 		readVal &= ~CRF_APB_RST_DDR_SS_DDR_RESET_MASK;
 		Xil_Out32(CRF_APB_RST_DDR_SS, readVal);
 
-		restore_state(ctx_ddrphy);
+		restore_state(&ctx_ddrphy);
 	}
 
+	ddrSrStepCycles[DDR_SR_STEP_CTX_RESTORE] = DDR_SR_CYCLES() - cycles;
+
 	DDR_reinit(ddrss_is_reset);
 
-	restore_training_data();
+	cycles = DDR_SR_CYCLES();
+#ifdef ENABLE_DDR_SR_FAST_RESTORE
+	if (0U == ddr_fast_restore)
+#endif
+	{
+		restore_training_data();
+	}
+	ddrSrStepCycles[DDR_SR_STEP_TRAIN_RESTORE] = DDR_SR_CYCLES() - cycles;
+
+	ddr_sr_report();
 }
 
 #ifdef ENABLE_DDR_SR_WR
@@ -1899,20 +2039,20 @@ void PmDdrExitSr(void)
 			     DDRC_INIT_FLAG_MASK, DDR_FLAG_POLL_PERIOD);
 
 	/* Read DDRC & DDR PHY register values and modify some bitfields */
-	store_state(ctx_ddrc);
-	store_state(ctx_ddrphy);
+	store_state(&ctx_ddrc);
+	store_state(&ctx_ddrphy);
 
 	XPfw_RMW32(CRF_APB_RST_DDR_SS, CRF_APB_RST_DDR_SS_DDR_RESET_MASK,
 		   CRF_APB_RST_DDR_SS_DDR_RESET_MASK);
 
 	/* Write modified values to DDRC registers */
-	restore_state(ctx_ddrc);
+	restore_state(&ctx_ddrc);
 
 	XPfw_RMW32(CRF_APB_RST_DDR_SS, CRF_APB_RST_DDR_SS_DDR_RESET_MASK,
 		   ~CRF_APB_RST_DDR_SS_DDR_RESET_MASK);
 
 	/* Write modified values to DDR PHY registers */
-	restore_state(ctx_ddrphy);
+	restore_state(&ctx_ddrphy);
 
 	DDR_reinit(true);
 
@@ -343,14 +343,27 @@ static PmMaster *const pmMastersAll[] = {
 	&pmMasterRpu1_g,	/* RPU split mode, core 1 */
 };
 
+/*
+ * Masters of the list indexed by IPI channel (bit of the IPI mask), the
+ * master added last wins as it is the first one found in the list
+ */
+static PmMaster* pmMastersByIpi[32];
+
 /**
  * PmMasterAdd() - Add new master in the list
  * @newMaster   Master to be added in the list
  */
 static void PmMasterAdd(PmMaster* const newMaster)
 {
+	u32 mask = newMaster->ipiMask;
+
 	newMaster->nextMaster = pmMasterHead;
 	pmMasterHead = newMaster;
+
+	while (0U != mask) {
+		pmMastersByIpi[__builtin_ctz(mask)] = newMaster;
+		mask &= mask - 1U;
+	}
 }
 
 /**
@@ -414,6 +427,7 @@ void PmMasterClearConfig(void)
 
 	/* Delete the list of available masters */
 	pmMasterHead = NULL;
+	(void)memset(pmMastersByIpi, 0U, sizeof(pmMastersByIpi));
 
 	/* Free allocated requirements from the heap */
 	PmRequirementFreeAll();
@@ -429,6 +443,12 @@ PmMaster* PmGetMasterByIpiMask(const u32 mask)
 {
 	PmMaster* mst = pmMasterHead;
 
+	/* Requests come from one IPI channel, look it up directly */
+	if ((0U != mask) && (0U == (mask & (mask - 1U)))) {
+		mst = pmMastersByIpi[__builtin_ctz(mask)];
+		goto done;
+	}
+
 	while (NULL != mst) {
 		if (0U != (mask & mst->ipiMask)) {
 			break;
@@ -436,9 +456,29 @@ PmMaster* PmGetMasterByIpiMask(const u32 mask)
 		mst = mst->nextMaster;
 	}
 
+done:
 	return mst;
 }
 
+/**
+ * PmMasterGetIndex() - Get index of a master among the supported masters
+ * @master	Master whose index is needed
+ *
+ * @return	Index of the master, PM_MASTER_MAX if the master is not known
+ */
+u32 PmMasterGetIndex(const PmMaster* const master)
+{
+	u32 i;
+
+	for (i = 0U; i < ARRAY_SIZE(pmMastersAll); i++) {
+		if (master == pmMastersAll[i]) {
+			break;
+		}
+	}
+
+	return i;
+}
+
 /**
  * PmMasterGetNextFromIpiMask() - Get next master from ORed masters' IPI mask
  * @mask	Mask from which we need to extract a master
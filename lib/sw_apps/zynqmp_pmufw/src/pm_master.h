@@ -81,6 +81,9 @@ typedef enum {
 /* Master has not sent notification that it has initialized PM */
 #define PM_MASTER_STATE_UNINITIALIZED	5U
 
+/* Number of masters supported by the PFW */
+#define PM_MASTER_MAX	4U
+
 /*********************************************************************
  * Structure definitions
  ********************************************************************/
@@ -181,6 +184,7 @@ extern PmMaster pmMasterRpu1_g;
 /* Get functions */
 PmMaster* PmGetMasterByIpiMask(const u32 mask);
 PmMaster* PmMasterGetNextFromIpiMask(u32* const mask);
+u32 PmMasterGetIndex(const PmMaster* const master);
 
 PmProc* PmGetProcByWfiStatus(const u32 mask);
 PmProc* PmGetProcOfThisMaster(const PmMaster* const master,
@@ -42,6 +42,34 @@ static PmNodeClass* pmNodeClasses[] = {
 	&pmNodeClassPll_g,
 };
 
+/*
+ * Nodes indexed by node ID, so that the lookups done by every PM API call do
+ * not walk the node classes. Filled on the first lookup.
+ */
+static PmNode* pmNodesById[NODE_MAX + 1U];
+static bool pmNodesIndexed;
+
+/**
+ * PmNodeBuildIndex() - Fill the table of nodes indexed by node ID
+ */
+static void PmNodeBuildIndex(void)
+{
+	u32 i, n;
+
+	for (i = ARRAY_SIZE(pmNodeClasses); i > 0U; i--) {
+		for (n = 0U; n < pmNodeClasses[i - 1U]->bucketSize; n++) {
+			PmNode* node = pmNodeClasses[i - 1U]->bucket[n];
+
+			/* Walk backwards, the first class with the ID wins */
+			if (node->nodeId <= NODE_MAX) {
+				pmNodesById[node->nodeId] = node;
+			}
+		}
+	}
+
+	pmNodesIndexed = true;
+}
+
 /**
  * PmGetNodeById() - Find node that matches a given node ID
  * @nodeId      ID of the node to find
@@ -53,6 +81,14 @@ PmNode* PmGetNodeById(const u32 nodeId)
 	u32 i, n;
 	PmNode* node = NULL;
 
+	if (nodeId <= NODE_MAX) {
+		if (false == pmNodesIndexed) {
+			PmNodeBuildIndex();
+		}
+		node = pmNodesById[nodeId];
+		goto done;
+	}
+
 	for (i = 0U; i < ARRAY_SIZE(pmNodeClasses); i++) {
 		for (n = 0U; n < pmNodeClasses[i]->bucketSize; n++) {
 			if (nodeId == pmNodeClasses[i]->bucket[n]->nodeId) {
@@ -173,10 +209,17 @@ void* PmNodeGetDerived(const u8 nodeClass, const u32 nodeId)
 	PmNode* node = NULL;
 	PmNodeClass* class = PmNodeGetClassById(nodeClass);
 
-	if (NULL != class) {
+	if (NULL == class) {
+		goto done;
+	}
+
+	/* Look in the class only if the indexed node belongs to another one */
+	node = PmGetNodeById(nodeId);
+	if ((NULL != node) && (class != node->class)) {
 		node = PmNodeGetFromClass(class, nodeId);
 	}
 
+done:
 	if (NULL != node) {
 		ptr = node->derived;
 	}
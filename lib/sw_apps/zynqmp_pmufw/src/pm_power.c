@@ -65,6 +65,12 @@
 #define A53_DBG_3_EDPRCR_REG			(0xFEF10310U)	/* APU_3 external debug control */
 #define A53_DBG_EDPRCR_REG_MASK			(0x00000009U)	/* COREPURQ and CORENPDRQ bit mask */
 
+/* Total number of entries in the power down sequences of all power nodes */
+#define PM_POWER_ORDER_MAX	80U
+
+/* Convert PMU clock cycles to microseconds */
+#define PM_POWER_CYCLES_TO_US(c)	((c) / (XPFW_CFG_PMU_CLK_FREQ / 1000000U))
+
 /**
  * PmPowerStack() - Used to construct stack for implementing non-recursive
  *		depth-first search in power graph
@@ -193,6 +199,91 @@ done:
 	return node;
 }
 
+/*
+ * Power down sequences of the power nodes. The power graph is static, so the
+ * depth-first order (children before their power parent) of each power node
+ * is computed once and kept as a slice of this array.
+ */
+static PmNode* pmPowerOrder[PM_POWER_ORDER_MAX];
+static u8 pmPowerOrderCnt;
+
+/**
+ * PmPowerOrderBuild() - Precompute the power down sequence of a power node
+ * @power	Power node whose sequence should be built
+ */
+static void PmPowerOrderBuild(PmPower* const power)
+{
+	PmNode* node;
+	u8 start = pmPowerOrderCnt;
+
+	if (0U != power->orderCnt) {
+		goto done;
+	}
+
+	PmPowerDfsBegin(power);
+	node = PmPowerDfsGetNext();
+	while (NULL != node) {
+		if (ARRAY_SIZE(pmPowerOrder) == pmPowerOrderCnt) {
+			/* This should never happen */
+			PmAlert("Power order overflow\r\n");
+			pmPowerOrderCnt = start;
+			goto done;
+		}
+		pmPowerOrder[pmPowerOrderCnt] = node;
+		pmPowerOrderCnt++;
+		node = PmPowerDfsGetNext();
+	}
+	power->orderStart = start;
+	power->orderCnt = pmPowerOrderCnt - start;
+
+done:
+	return;
+}
+
+/**
+ * PmPowerOrderGet() - Get the power down sequence of a power node
+ * @power	Power node
+ * @cnt		Pointer to the location where the number of nodes is stored
+ *
+ * @return	Pointer to the first node of the sequence
+ */
+static PmNode* const* PmPowerOrderGet(PmPower* const power, u32* const cnt)
+{
+	PmPowerOrderBuild(power);
+	*cnt = power->orderCnt;
+
+	return &pmPowerOrder[power->orderStart];
+}
+
+/**
+ * PmPowerGetCycles() - Read the free running PMU cycle counter
+ * @return	Number of PMU clock cycles
+ */
+static inline u32 PmPowerGetCycles(void)
+{
+	/* PIT3 counts down from its preload value */
+	return ~XPfw_Read32(PMU_IOMODULE_PIT3_COUNTER);
+}
+
+/* AIBs isolating the islands/domains while they are powered down */
+static const enum XPfwAib pmRpuAibs[] = {
+	XPFW_AIB_RPU0_TO_LPD,
+	XPFW_AIB_RPU1_TO_LPD,
+	XPFW_AIB_LPD_TO_RPU0,
+	XPFW_AIB_LPD_TO_RPU1,
+};
+
+static const enum XPfwAib pmFpdAibs[] = {
+	XPFW_AIB_LPD_TO_DDR,
+	XPFW_AIB_LPD_TO_FPD,
+};
+
+static const enum XPfwAib pmPldAibs[] = {
+	XPFW_AIB_LPD_TO_AFI_FS2,
+	XPFW_AIB_FPD_TO_AFI_FS0,
+	XPFW_AIB_FPD_TO_AFI_FS1,
+};
+
 /*
  * Note: PLL registers will never be saved/restored as part of CRF_APB module
  * context. PLLs have separate logic, which is part of the PLL management
@@ -341,8 +432,7 @@ static s32 PmPowerDownFpd(void)
 
 	(void)PmResetAssertInt(PM_RESET_FPD, PM_RESET_ACTION_ASSERT);
 
-	XPfw_AibEnable(XPFW_AIB_LPD_TO_DDR);
-	XPfw_AibEnable(XPFW_AIB_LPD_TO_FPD);
+	XPfw_AibEnableList(pmFpdAibs, ARRAY_SIZE(pmFpdAibs));
 
 	status = XpbrPwrDnFpdHandler();
 	if (XST_SUCCESS != status) {
@@ -442,10 +532,7 @@ err:
  */
 static s32 PmPowerDownRpu(void)
 {
-	(void)XPfw_AibEnable(XPFW_AIB_RPU0_TO_LPD);
-	(void)XPfw_AibEnable(XPFW_AIB_RPU1_TO_LPD);
-	(void)XPfw_AibEnable(XPFW_AIB_LPD_TO_RPU0);
-	(void)XPfw_AibEnable(XPFW_AIB_LPD_TO_RPU1);
+	XPfw_AibEnableList(pmRpuAibs, ARRAY_SIZE(pmRpuAibs));
 
 	return XpbrPwrDnRpuHandler();
 }
@@ -473,9 +560,7 @@ static void PmPowerForceDownRpu(PmPower* const power)
  */
 static s32 PmPowerDownPld(void)
 {
-	(void)XPfw_AibEnable(XPFW_AIB_LPD_TO_AFI_FS2);
-	(void)XPfw_AibEnable(XPFW_AIB_FPD_TO_AFI_FS0);
-	(void)XPfw_AibEnable(XPFW_AIB_FPD_TO_AFI_FS1);
+	XPfw_AibEnableList(pmPldAibs, ARRAY_SIZE(pmPldAibs));
 
 	return XpbrPwrDnPldHandler();
 }
@@ -535,13 +620,17 @@ static void PmPowerUpSysOsc(void)
 s32 PmPowerDown(PmPower* const power)
 {
 	s32 status = XST_SUCCESS;
+	u32 start;
 
 	if (PM_PWR_STATE_OFF == power->node.currState) {
 		goto done;
 	}
 
 	if (NULL != power->powerDown) {
+		start = PmPowerGetCycles();
 		status = power->powerDown();
+		power->pwrDnTime = PM_POWER_CYCLES_TO_US(PmPowerGetCycles() -
+							 start);
 	}
 
 	if (XST_SUCCESS != status) {
@@ -553,7 +642,7 @@ s32 PmPowerDown(PmPower* const power)
 	if (NULL != power->node.clocks) {
 		PmClockRelease(&power->node);
 	}
-	PmInfo("%s 1->0\r\n", power->node.name);
+	PmInfo("%s 1->0 (%lu us)\r\n", power->node.name, power->pwrDnTime);
 #ifdef DEBUG_MODE
 	if ((pmPowerIslandRpu_g.power.node.currState == PM_PWR_STATE_OFF) &&
                         (pmPowerDomainFpd_g.power.node.currState == PM_PWR_STATE_OFF)) {
@@ -590,6 +679,7 @@ done:
 static s32 PmPowerUp(PmPower* const power)
 {
 	s32 status = XST_SUCCESS;
+	u32 start;
 
 	/* Enable SysOsc for normal operation if it is in sleep mode. */
 	if ((Xil_In32(AMS_PSSYSMON_CONFIG_REG2) & 0xF0U) == 0x30U) {
@@ -613,13 +703,18 @@ static s32 PmPowerUp(PmPower* const power)
 	}
 
 	if (NULL != power->powerUp) {
+		start = PmPowerGetCycles();
 		status = power->powerUp();
+		power->pwrUpTime = PM_POWER_CYCLES_TO_US(PmPowerGetCycles() -
+							 start);
 	}
 
 	if (XST_SUCCESS != status) {
 		goto done;
 	}
 
+	PmInfo("%s up in %lu us\r\n", power->node.name, power->pwrUpTime);
+
 	if (NULL != power->node.clocks) {
 		status = PmClockRequest(&power->node);
 	}
@@ -1199,7 +1294,9 @@ done:
  */
 static s32 PmPowerGetPowerData(const PmNode* const powerNode, u32* const data)
 {
+	PmNode* const* order;
 	PmNode* node;
+	u32 i, cnt;
 	u32 val = 0U;
 	s32 status = XST_NO_FEATURE;
 
@@ -1209,9 +1306,9 @@ static s32 PmPowerGetPowerData(const PmNode* const powerNode, u32* const data)
 		goto done;
 	}
 
-	PmPowerDfsBegin((PmPower*)powerNode->derived);
-	node = PmPowerDfsGetNext();
-	while (NULL != node) {
+	order = PmPowerOrderGet((PmPower*)powerNode->derived, &cnt);
+	for (i = 0U; i < cnt; i++) {
+		node = order[i];
 		if (NODE_IS_POWER(node)) {
 			status = PmNodeGetPowerInfo(node, &val);
 		} else {
@@ -1225,7 +1322,6 @@ static s32 PmPowerGetPowerData(const PmNode* const powerNode, u32* const data)
 			goto done;
 		}
 		*data += val;
-		node = PmPowerDfsGetNext();
 	}
 
 done:
@@ -1240,13 +1336,15 @@ done:
  */
 static s32 PmPowerForceDown(PmNode* const powerNode)
 {
+	PmNode* const* order;
 	PmNode* node;
 	PmPower* const power = (PmPower*)powerNode->derived;
+	u32 i, cnt;
 	s32 status = XST_FAILURE;
 
-	PmPowerDfsBegin(power);
-	node = PmPowerDfsGetNext();
-	while (NULL != node) {
+	order = PmPowerOrderGet(power, &cnt);
+	for (i = 0U; i < cnt; i++) {
+		node = order[i];
 		if (NODE_IS_POWER(node)) {
 			status = PmPowerDown((PmPower*)node->derived);
 		} else {
@@ -1255,7 +1353,6 @@ static s32 PmPowerForceDown(PmNode* const powerNode)
 		if (XST_SUCCESS != status) {
 			goto done;
 		}
-		node = PmPowerDfsGetNext();
 	}
 	if ((NULL != power->class) && (NULL != power->class->forceDown)) {
 		power->class->forceDown(power);
@@ -1275,6 +1372,9 @@ static s32 PmPowerInit(PmNode* const powerNode)
 {
 	s32 status = XST_SUCCESS;
 
+	/* Precompute the power down sequence while loading the configuration */
+	PmPowerOrderBuild((PmPower*)powerNode->derived);
+
 	if (PM_PWR_STATE_OFF == powerNode->currState) {
 		goto done;
 	}
@@ -1300,12 +1400,14 @@ done:
  */
 static bool PmPowerIsUsable(PmNode* const powerNode)
 {
+	PmNode* const* order;
 	PmNode* node;
+	u32 i, cnt;
 	bool usable = false;
 
-	PmPowerDfsBegin((PmPower*)powerNode->derived);
-	node = PmPowerDfsGetNext();
-	while (NULL != node) {
+	order = PmPowerOrderGet((PmPower*)powerNode->derived, &cnt);
+	for (i = 0U; i < cnt; i++) {
+		node = order[i];
 		if (!NODE_IS_POWER(node)) {
 			if (NULL != node->class->isUsable) {
 				usable = node->class->isUsable(node);
@@ -1314,7 +1416,6 @@ static bool PmPowerIsUsable(PmNode* const powerNode)
 				}
 			}
 		}
-		node = PmPowerDfsGetNext();
 	}
 
 done:
@@ -1334,13 +1435,15 @@ done:
  */
 static u32 PmPowerGetPerms(const PmNode* const powerNode)
 {
+	PmNode* const* order;
 	const PmNode* node;
+	u32 i, cnt;
 	u32 perms = 0U;
 	u32 node_perms;
 
-	PmPowerDfsBegin((PmPower*)powerNode->derived);
-	node = PmPowerDfsGetNext();
-	while (NULL != node) {
+	order = PmPowerOrderGet((PmPower*)powerNode->derived, &cnt);
+	for (i = 0U; i < cnt; i++) {
+		node = order[i];
 		if (!NODE_IS_POWER(node)) {
 			if (NULL == node->class->getPerms) {
 				perms = 0U;
@@ -1353,7 +1456,6 @@ static u32 PmPowerGetPerms(const PmNode* const powerNode)
 			}
 			perms |= node_perms;
 		}
-		node = PmPowerDfsGetNext();
 	}
 
 done:
@@ -71,6 +71,10 @@ typedef struct PmSlaveTcm PmSlaveTcm;
  * @forcePerms  ORed masks of masters which are allowed to force power down this
  *              power node
  * @useCount    How many nodes currently use this power node
+ * @pwrDnTime   Measured duration (in us) of the last transition to OFF state
+ * @pwrUpTime   Measured duration (in us) of the last transition to ON state
+ * @orderStart  Index of the first entry of this node's power down sequence
+ * @orderCnt    Number of nodes in the power down sequence (0 if not built)
  */
 typedef struct PmPower {
 	PmNode node;
@@ -81,8 +85,12 @@ typedef struct PmPower {
 	const u32 pwrDnLatency;
 	const u32 pwrUpLatency;
 	u32 forcePerms;
+	u32 pwrDnTime;
+	u32 pwrUpTime;
 	const u8 childCnt;
 	u8 useCount;
+	u8 orderStart;
+	u8 orderCnt;
 } PmPower;
 
 /**
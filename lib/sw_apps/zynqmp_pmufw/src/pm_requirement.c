@@ -44,6 +44,16 @@ static PmRequirement pmReqData[PM_REQUIREMENT_MAX];
 /* Top of the heap = index of the first free entry in pmReqData array (heap) */
 static u32 pmReqTop;
 
+/*
+ * Requirements indexed by master and slave node ID, built while the
+ * configuration is loaded. Entries hold the index in pmReqData plus one, or
+ * zero if the master has no requirement for the slave.
+ */
+#if (PM_REQUIREMENT_MAX > 255U)
+#error "pmReqIndex entries cannot hold the pmReqData index"
+#endif
+static u8 pmReqIndex[PM_MASTER_MAX][NODE_MAX + 1U];
+
 /**
  * PmRequirementLink() - Link requirement struct into master's and slave's lists
  * @req	Pointer to the requirement structure to be linked in lists
@@ -91,6 +101,8 @@ void PmRequirementFreeAll(void)
 
 	/* Reset top of the heap */
 	pmReqTop = 0U;
+
+	(void)memset(pmReqIndex, 0U, sizeof(pmReqIndex));
 }
 
 /**
@@ -104,6 +116,7 @@ void PmRequirementFreeAll(void)
 PmRequirement* PmRequirementAdd(PmMaster* const master, PmSlave* const slave)
 {
 	PmRequirement* req = PmRequirementMalloc();
+	u32 mstIdx;
 
 	if (NULL == req) {
 		goto done;
@@ -113,6 +126,13 @@ PmRequirement* PmRequirementAdd(PmMaster* const master, PmSlave* const slave)
 	req->slave = slave;
 	PmRequirementLink(req);
 
+	/* The requirement added last is found first in the master's list */
+	mstIdx = PmMasterGetIndex(master);
+	if ((mstIdx < PM_MASTER_MAX) && (slave->node.nodeId <= NODE_MAX)) {
+		pmReqIndex[mstIdx][slave->node.nodeId] =
+			(u8)(req - pmReqData) + 1U;
+	}
+
 done:
 	return req;
 }
@@ -385,6 +405,14 @@ PmRequirement* PmRequirementGet(const PmMaster* const master,
 				const PmSlave* const slave)
 {
 	PmRequirement* req = master->reqs;
+	u32 mstIdx = PmMasterGetIndex(master);
+	u8 entry;
+
+	if ((mstIdx < PM_MASTER_MAX) && (slave->node.nodeId <= NODE_MAX)) {
+		entry = pmReqIndex[mstIdx][slave->node.nodeId];
+		req = (0U != entry) ? &pmReqData[entry - 1U] : NULL;
+		goto done;
+	}
 
 	while (NULL != req) {
 		if (slave == req->slave) {
@@ -393,6 +421,7 @@ PmRequirement* PmRequirementGet(const PmMaster* const master,
 		req = req->nextSlave;
 	}
 
+done:
 	return req;
 }
 
@@ -145,6 +145,58 @@ Done:
 	return;
 }
 
+/**
+ * Enable a list of AIB isolations
+ * @param AibIds is the array of IDs of the AIB instances to be enabled
+ * @param Count is the number of IDs in the array (up to 32)
+ *
+ * All isolation requests are issued first and the acks are then polled
+ * together, so the wait is not accumulated per AIB.
+ */
+void XPfw_AibEnableList(const enum XPfwAib *AibIds, u32 Count)
+{
+	u32 Idx;
+	u32 Pending = 0U;
+	u32 TimeOutCount = AIB_ACK_TIMEOUT;
+
+	for (Idx = 0U; Idx < Count; Idx++) {
+		if (AibIds[Idx] >= XPFW_AIB_ID_MAX) {
+			XPfw_Printf(DEBUG_DETAILED, "Err: invalid AIB#%d\r\n",
+				    AibIds[Idx]);
+			continue;
+		}
+		XPfw_RMW32(AibList[AibIds[Idx]].ReqRegAddr,
+			   AibList[AibIds[Idx]].Mask,
+			   AibList[AibIds[Idx]].Mask);
+		Pending |= (u32)1U << Idx;
+	}
+
+	/* Loop until all the AIB isolation acks are received or we timeout */
+	while (Pending != 0U) {
+		for (Idx = 0U; Idx < Count; Idx++) {
+			if ((Pending & ((u32)1U << Idx)) == 0U) {
+				continue;
+			}
+			if ((XPfw_Read32(AibList[AibIds[Idx]].StsRegAddr) &
+			     AibList[AibIds[Idx]].Mask) != 0U) {
+				Pending &= ~((u32)1U << Idx);
+			}
+		}
+		if ((Pending == 0U) || (TimeOutCount == 0U)) {
+			break;
+		}
+		--TimeOutCount;
+		usleep(10U);
+	}
+
+	for (Idx = 0U; Idx < Count; Idx++) {
+		if ((Pending & ((u32)1U << Idx)) != 0U) {
+			XPfw_Printf(DEBUG_DETAILED, "No AIB#%d ack\r\n",
+				    AibIds[Idx]);
+		}
+	}
+}
+
 /**
  * Disable AIB isolation
  * @param AibId is ID of the AIB instance that needs to be disabled
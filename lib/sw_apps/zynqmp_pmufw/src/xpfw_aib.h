@@ -59,6 +59,7 @@ enum XPfwAib {
 
 void XPfw_AibEnable(enum XPfwAib AibId);
 void XPfw_AibDisable(enum XPfwAib AibId);
+void XPfw_AibEnableList(const enum XPfwAib *AibIds, u32 Count);
 
 #ifdef __cplusplus
 }
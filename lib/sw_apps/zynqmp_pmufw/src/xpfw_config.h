@@ -98,6 +98,8 @@ extern "C" {
  * 	               macro is also defined
  *	- ENABLE_POS : Enables Power Off Suspend feature
  *	- ENABLE_DDR_SR_WR : Enables DDR self refresh over warm restart feature
+ *	- ENABLE_DDR_SR_FAST_RESTORE : Restores trained DDR PHY delays on self
+ *			refresh exit instead of retraining (DDR3/DDR4 only)
  *	- ENABLE_UNUSED_RPU_PWR_DWN : Enables unused RPU power down feature
  *	- DISABLE_CLK_PERMS : Disable clock permission checking (it is not safe
  *			to ever disable clock permission checking). Do this at
@@ -139,6 +141,7 @@ extern "C" {
 #define	DEBUG_MODE_VAL					(0U)
 #define	ENABLE_POS_VAL					(0U)
 #define	ENABLE_DDR_SR_WR_VAL				(0U)
+#define ENABLE_DDR_SR_FAST_RESTORE_VAL			(0U)
 #define DISABLE_CLK_PERMS_VAL				(0U)
 #define ENABLE_UNUSED_RPU_PWR_DWN_VAL			(1U)
 
@@ -293,6 +296,16 @@ extern "C" {
 #endif
 #endif
 
+#ifdef XPAR_PSU_DDRC_0_DEVICE_ID
+#if ENABLE_DDR_SR_FAST_RESTORE_VAL
+#define ENABLE_DDR_SR_FAST_RESTORE
+#endif
+#endif
+
+#if defined(ENABLE_DDR_SR_FAST_RESTORE) && defined(ENABLE_DDR_SR_WR)
+#error "Error: DDR_SR_FAST_RESTORE is not supported with DDR_SR_WR"
+#endif
+
 #if DISABLE_CLK_PERMS_VAL
 #define DISABLE_CLK_PERMS
 #endif
@@ -65,7 +65,7 @@ XStatus XPfw_CoreInit(u32 Options)
 	}
 
 	Status = XPfw_SchedulerInit(&CorePtr->Scheduler,
-		PMU_IOMODULE_PIT1_PRELOAD);
+		PMU_IOMODULE_PIT1_PRELOAD, PMU_IOMODULE_PIT3_PRELOAD);
 
 	if (XST_SUCCESS != Status) {
 		goto Done;
@@ -117,6 +117,7 @@ XStatus XPfw_CoreDispatchEvent(u32 EventId)
 	XStatus Status;
 	u32 Idx;
 	u32 CallCount = 0U;
+	u32 StartCycles;
 	if ((CorePtr != NULL) && (EventId < XPFW_EV_MAX)) {
 
 		for (Idx = 0U; Idx < CorePtr->ModCount; Idx++) {
@@ -125,8 +126,11 @@ XStatus XPfw_CoreDispatchEvent(u32 EventId)
 			 */
 			if (((XPfw_EventGetModMask(EventId) & ((u32) 1U << Idx))
 					== ((u32) 1U << Idx)) && CorePtr->ModList[Idx].EventHandler != NULL) {
+				StartCycles = XPfw_SchedulerGetCycles(&CorePtr->Scheduler);
 				CorePtr->ModList[Idx].EventHandler(&CorePtr->ModList[Idx],
 						EventId);
+				XPfw_SchedulerAccount(&CorePtr->Scheduler, Idx,
+						StartCycles);
 				CallCount++;
 			}
 		}
@@ -147,6 +151,7 @@ XStatus XPfw_CoreDispatchIpi(u32 IpiNum, u32 SrcMask)
 	u32 Idx;
 	u32 MaskIndex;
 	u32 CallCount = 0U;
+	u32 StartCycles;
 	u32 Payload[XPFW_IPI_MAX_MSG_LEN] = {0U};
 
 	if ((CorePtr == NULL) || (IpiNum > 3U)) {
@@ -171,9 +176,12 @@ XStatus XPfw_CoreDispatchIpi(u32 IpiNum, u32 SrcMask)
 				if ( (CorePtr->ModList[Idx].IpiId == (Payload[0] >> 16U)) &&
 					(CorePtr->ModList[Idx].IpiHandler != NULL)) {
 					/* Call the module's IPI handler */
+					StartCycles = XPfw_SchedulerGetCycles(&CorePtr->Scheduler);
 					CorePtr->ModList[Idx].IpiHandler(&CorePtr->ModList[Idx],
 							IpiNum, IpiMaskList[MaskIndex],
 							&Payload[0], XPFW_IPI_MAX_MSG_LEN);
+					XPfw_SchedulerAccount(&CorePtr->Scheduler, Idx,
+							StartCycles);
 					CallCount++;
 				}
 			}
@@ -304,6 +312,9 @@ XStatus XPfw_CoreLoop(void)
 
 void XPfw_CorePrintStats(void)
 {
+	u32 Idx;
+	const XPfw_SchedUsage_t *UsagePtr;
+
 	if(CorePtr != NULL) {
 	XPfw_Printf(DEBUG_DETAILED,
 			"######################################################\r\n");
@@ -313,6 +324,18 @@ void XPfw_CorePrintStats(void)
 			((CorePtr->Scheduler.Enabled == TRUE)?"ENABLED":"DISABLED"));
 	XPfw_Printf(DEBUG_DETAILED,"Scheduler Ticks: %lu\r\n",
 			CorePtr->Scheduler.Tick);
+	XPfw_Printf(DEBUG_DETAILED,"Scheduler Wakeups: %lu\r\n",
+			CorePtr->Scheduler.Wakeups);
+	for (Idx = 0U; Idx < CorePtr->ModCount; Idx++) {
+		UsagePtr = &CorePtr->Scheduler.Usage[Idx];
+		if (UsagePtr->Runs != 0U) {
+			XPfw_Printf(DEBUG_DETAILED,"Mod %lu: %lu runs, %lu us, "
+					"max %lu cycles\r\n", Idx, UsagePtr->Runs,
+					(u32)(UsagePtr->Cycles /
+					(XPFW_CFG_PMU_CLK_FREQ / 1000000U)),
+					UsagePtr->MaxCycles);
+		}
+	}
 	XPfw_Printf(DEBUG_DETAILED,
 			"######################################################\r\n");
 	}
@@ -24,6 +24,13 @@
 
 #include "xpfw_scheduler.h"
 
+/**
+ * The scheduler is tickless: tasks are kept in a list sorted by due tick and
+ * the PIT is programmed in one-shot mode for the task due first, so the PMU
+ * only wakes up when a task has to run. A second PIT runs free as the time
+ * base of the CPU usage accounting.
+ */
+
 /**
  * PMU PIT Clock Frequency and Tick Calculation
  */
@@ -31,6 +38,9 @@
 #define TICK_MILLISECONDS	10U
 #define COUNT_PER_TICK ((PMU_PIT_CLK_FREQ / 1000U)* TICK_MILLISECONDS )
 
+/* Longest sleep the 32-bit PIT counter can hold */
+#define MAX_SLEEP_TICKS	(0xFFFFFFFFU / COUNT_PER_TICK)
+
 /**
  * Microblaze IOModule PIT Register Offsets
  * Used internally in this file
@@ -39,42 +49,107 @@
 #define PIT_COUNTER_OFFSET	4U
 #define PIT_CONTROL_OFFSET	8U
 
-static u32 is_task_active(XPfw_Scheduler_t *SchedPtr, u32 TaskListIndex)
+/* PIT control bits */
+#define PIT_CONTROL_EN		1U
+#define PIT_CONTROL_RELOAD	2U
+
+/* Interrupt enable bit of the MicroBlaze MSR */
+#define MB_MSR_IE		2U
+
+/**
+ * Task list and trigger mask accesses are shared with the PIT handler
+ * and with the modules adding tasks from interrupt handlers
+ */
+static u32 XPfw_SchedulerLock(void)
 {
-	u32 ReturnVal;
-
-	/* Periodic */
-	if ((0U != SchedPtr->TaskList[TaskListIndex].Interval)
-		&& (NULL != SchedPtr->TaskList[TaskListIndex].Callback)
-		&& (0U == (SchedPtr->Tick
-				% SchedPtr->TaskList[TaskListIndex].Interval))) {
-		ReturnVal = TRUE;
-	} else if ((0U == SchedPtr->TaskList[TaskListIndex].Interval)
-			&& (NULL != SchedPtr->TaskList[TaskListIndex].Callback)) {
-		/* Non-Periodic */
-		ReturnVal = TRUE;
-	} else {
-		ReturnVal = FALSE;
+	u32 Msr = (u32)mfmsr();
+
+	microblaze_disable_interrupts();
+
+	return Msr & MB_MSR_IE;
+}
+
+static void XPfw_SchedulerUnlock(u32 Ie)
+{
+	if (0U != Ie) {
+		microblaze_enable_interrupts();
+	}
+}
+
+/* Insert a task in the due list, after the tasks due at the same tick */
+static void XPfw_SchedulerInsert(XPfw_Scheduler_t *SchedPtr, u8 TaskIdx)
+{
+	u8 *LinkPtr = &SchedPtr->Head;
+	u32 Due = SchedPtr->TaskList[TaskIdx].Due;
+
+	while ((XPFW_SCHED_NO_TASK != *LinkPtr) &&
+		((s32)(SchedPtr->TaskList[*LinkPtr].Due - Due) <= 0)) {
+		LinkPtr = &SchedPtr->TaskList[*LinkPtr].Next;
 	}
 
-	return ReturnVal;
+	SchedPtr->TaskList[TaskIdx].Next = *LinkPtr;
+	*LinkPtr = TaskIdx;
 }
 
-static u32 is_task_non_periodic(XPfw_Scheduler_t *SchedPtr, u32 TaskListIndex)
+static void XPfw_SchedulerUnlink(XPfw_Scheduler_t *SchedPtr, u8 TaskIdx)
 {
-	u32 ReturnVal;
+	u8 *LinkPtr = &SchedPtr->Head;
 
-	if ((0U == SchedPtr->TaskList[TaskListIndex].Interval)
-		&& (NULL != SchedPtr->TaskList[TaskListIndex].Callback)) {
-		ReturnVal = TRUE;
-	} else {
-		ReturnVal = FALSE;
+	while (XPFW_SCHED_NO_TASK != *LinkPtr) {
+		if (*LinkPtr == TaskIdx) {
+			*LinkPtr = SchedPtr->TaskList[TaskIdx].Next;
+			break;
+		}
+		LinkPtr = &SchedPtr->TaskList[*LinkPtr].Next;
+	}
+
+	SchedPtr->TaskList[TaskIdx].Next = XPFW_SCHED_NO_TASK;
+}
+
+/* Whole ticks slept since the PIT was programmed */
+static u32 XPfw_SchedulerElapsed(const XPfw_Scheduler_t *SchedPtr)
+{
+	u32 Count;
+	u32 Elapsed = 0U;
+
+	if (0U != SchedPtr->Sleep) {
+		Count = XPfw_Read32(SchedPtr->PitBaseAddr + PIT_COUNTER_OFFSET);
+		Elapsed = SchedPtr->Sleep -
+			((Count + COUNT_PER_TICK - 1U) / COUNT_PER_TICK);
 	}
 
-	return ReturnVal;
+	return Elapsed;
 }
 
-XStatus XPfw_SchedulerInit(XPfw_Scheduler_t *SchedPtr, u32 PitBaseAddr)
+/* Program the PIT to expire when the first task of the due list is due */
+static void XPfw_SchedulerProgram(XPfw_Scheduler_t *SchedPtr)
+{
+	u32 Delta;
+
+	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET, 0U);
+	SchedPtr->Sleep = 0U;
+
+	if ((TRUE == SchedPtr->Enabled) &&
+		(XPFW_SCHED_NO_TASK != SchedPtr->Head)) {
+		Delta = SchedPtr->TaskList[SchedPtr->Head].Due - SchedPtr->Tick;
+		if ((s32)Delta <= 0) {
+			Delta = 1U;
+		} else if (Delta > MAX_SLEEP_TICKS) {
+			Delta = MAX_SLEEP_TICKS;
+		} else {
+			/* Due within the PIT range */
+		}
+
+		SchedPtr->Sleep = Delta;
+		XPfw_Write32(SchedPtr->PitBaseAddr + PIT_PRELOAD_OFFSET,
+				Delta * COUNT_PER_TICK);
+		XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET,
+				PIT_CONTROL_EN);
+	}
+}
+
+XStatus XPfw_SchedulerInit(XPfw_Scheduler_t *SchedPtr, u32 PitBaseAddr,
+		u32 UsagePitBaseAddr)
 {
 	u32 Idx;
 	XStatus Status;
@@ -89,13 +164,32 @@ XStatus XPfw_SchedulerInit(XPfw_Scheduler_t *SchedPtr, u32 PitBaseAddr)
 		SchedPtr->TaskList[Idx].Interval = 0U;
 		SchedPtr->TaskList[Idx].Callback = NULL;
 		SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_DISABLED;
+		SchedPtr->TaskList[Idx].Next = XPFW_SCHED_NO_TASK;
+	}
+
+	for (Idx = 0U; Idx < XPFW_SCHED_MAX_OWNER; Idx++) {
+		SchedPtr->Usage[Idx].Runs = 0U;
+		SchedPtr->Usage[Idx].MaxCycles = 0U;
+		SchedPtr->Usage[Idx].Cycles = 0U;
 	}
 
 	SchedPtr->Enabled = FALSE;
 	SchedPtr->PitBaseAddr = PitBaseAddr;
+	SchedPtr->UsagePitBaseAddr = UsagePitBaseAddr;
 	SchedPtr->Tick = 0U;
+	SchedPtr->Sleep = 0U;
+	SchedPtr->Wakeups = 0U;
+	SchedPtr->Triggered = 0U;
+	SchedPtr->Head = XPFW_SCHED_NO_TASK;
 	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET, 0U);
 
+	/* Free running time base for the CPU usage */
+	XPfw_Write32(SchedPtr->UsagePitBaseAddr + PIT_CONTROL_OFFSET, 0U);
+	XPfw_Write32(SchedPtr->UsagePitBaseAddr + PIT_PRELOAD_OFFSET,
+			0xFFFFFFFFU);
+	XPfw_Write32(SchedPtr->UsagePitBaseAddr + PIT_CONTROL_OFFSET,
+			PIT_CONTROL_RELOAD | PIT_CONTROL_EN);
+
 	/* Successfully completed init */
 	Status = XST_SUCCESS;
 
@@ -106,17 +200,17 @@ done:
 XStatus XPfw_SchedulerStart(XPfw_Scheduler_t *SchedPtr)
 {
 	XStatus Status;
+	u32 Ie;
 
 	if (SchedPtr == NULL) {
 		Status = XST_FAILURE;
 		goto done;
 	}
 
+	Ie = XPfw_SchedulerLock();
 	SchedPtr->Enabled = TRUE;
-
-	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_PRELOAD_OFFSET,
-			COUNT_PER_TICK);
-	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET, 3U);
+	XPfw_SchedulerProgram(SchedPtr);
+	XPfw_SchedulerUnlock(Ie);
 	Status = XST_SUCCESS;
 
 done:
@@ -125,26 +219,53 @@ done:
 
 XStatus XPfw_SchedulerStop(XPfw_Scheduler_t *SchedPtr)
 {
-	SchedPtr->Enabled =FALSE;
+	u32 Ie;
 
-	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_PRELOAD_OFFSET, 0U );
-	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET, 0U );
+	Ie = XPfw_SchedulerLock();
+	SchedPtr->Tick += XPfw_SchedulerElapsed(SchedPtr);
+	SchedPtr->Enabled =FALSE;
+	XPfw_SchedulerProgram(SchedPtr);
+	XPfw_SchedulerUnlock(Ie);
 
 	return XST_SUCCESS;
 }
 
 void XPfw_SchedulerTickHandler(XPfw_Scheduler_t *SchedPtr)
 {
-	u32 Idx;
+	struct XPfw_Task_t *TaskPtr;
+	u8 Idx;
 
-	SchedPtr->Tick++;
-	for (Idx = 0U; Idx < XPFW_SCHED_MAX_TASK; Idx++) {
-		/* Check if it this task can be triggered */
-		if (TRUE == is_task_active(SchedPtr, Idx)) {
-			/* Mark the Task as TRIGGERED */
-			SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_TRIGGERED;
+	/* Ignore an expiry which was overtaken by a new programming */
+	if ((0U == SchedPtr->Sleep) ||
+		(0U != XPfw_Read32(SchedPtr->PitBaseAddr + PIT_COUNTER_OFFSET))) {
+		goto done;
+	}
+
+	SchedPtr->Tick += SchedPtr->Sleep;
+	SchedPtr->Wakeups++;
+
+	/* Trigger the tasks which are due, only the head of the list is checked */
+	while ((XPFW_SCHED_NO_TASK != SchedPtr->Head) &&
+		((s32)(SchedPtr->TaskList[SchedPtr->Head].Due - SchedPtr->Tick) <= 0)) {
+		Idx = SchedPtr->Head;
+		TaskPtr = &SchedPtr->TaskList[Idx];
+		SchedPtr->Head = TaskPtr->Next;
+
+		TaskPtr->Status = XPFW_TASK_STATUS_TRIGGERED;
+		SchedPtr->Triggered |= ((u32)1U << Idx);
+
+		/* Periodic tasks skip the periods missed while stopped */
+		TaskPtr->Due += TaskPtr->Interval;
+		if ((s32)(TaskPtr->Due - SchedPtr->Tick) <= 0) {
+			TaskPtr->Due = SchedPtr->Tick + TaskPtr->Interval;
 		}
+		XPfw_SchedulerInsert(SchedPtr, Idx);
 	}
+
+	XPfw_SchedulerProgram(SchedPtr);
+
+done:
+	return;
 }
 
 XStatus XPfw_SchedulerProcess(XPfw_Scheduler_t *SchedPtr)
@@ -152,20 +273,41 @@ XStatus XPfw_SchedulerProcess(XPfw_Scheduler_t *SchedPtr)
 	u32 Idx;
 	XStatus Status;
 	u32 CallCount = 0U;
+	u32 Pending;
+	u32 OwnerId;
+	u32 StartCycles;
+	u32 Ie;
+	XPfw_Callback_t CallbackFn;
+
+	Ie = XPfw_SchedulerLock();
+	Pending = SchedPtr->Triggered;
+	SchedPtr->Triggered = 0U;
+	XPfw_SchedulerUnlock(Ie);
+
+	for (Idx = 0U; Pending != 0U; Idx++) {
+		if ((Pending & ((u32)1U << Idx)) == 0U) {
+			continue;
+		}
+		Pending &= ~((u32)1U << Idx);
 
-	for (Idx = 0U; Idx < XPFW_SCHED_MAX_TASK; Idx++) {
-		/* Check if the task is triggered and has a valid Callback */
-		if ((XPFW_TASK_STATUS_TRIGGERED == SchedPtr->TaskList[Idx].Status) &&
-			(NULL != SchedPtr->TaskList[Idx].Callback)) {
+		Ie = XPfw_SchedulerLock();
+		CallbackFn = SchedPtr->TaskList[Idx].Callback;
+		OwnerId = SchedPtr->TaskList[Idx].OwnerId;
+		/* Disable the Task */
+		SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_DISABLED;
+		/* Remove the Non-Periodic Task, it may add itself again */
+		if (0U == SchedPtr->TaskList[Idx].Interval) {
+			SchedPtr->TaskList[Idx].Callback = NULL;
+		}
+		XPfw_SchedulerUnlock(Ie);
+
+		/* The task may have been removed after it was triggered */
+		if (NULL != CallbackFn) {
+			StartCycles = XPfw_SchedulerGetCycles(SchedPtr);
 			/* Execute the Task */
-			SchedPtr->TaskList[Idx].Callback();
-			/* Disable the executed Task */
-			SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_DISABLED;
+			CallbackFn();
+			XPfw_SchedulerAccount(SchedPtr, OwnerId, StartCycles);
 			CallCount++;
-	                /* Remove the Non-Periodic Task */
-		        if (TRUE == is_task_non_periodic(SchedPtr, Idx)) {
-			        SchedPtr->TaskList[Idx].Callback = NULL;
-			}
 		}
 	}
 
@@ -182,8 +324,12 @@ XStatus XPfw_SchedulerProcess(XPfw_Scheduler_t *SchedPtr)
 XStatus XPfw_SchedulerAddTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId,u32 MilliSeconds, XPfw_Callback_t CallbackFn)
 {
 	u32 Idx;
+	u32 Elapsed;
+	u32 Ie;
 	XStatus Status;
 
+	Ie = XPfw_SchedulerLock();
+
 	/* Get the Next Free Task Index */
 	for (Idx=0U;Idx < XPFW_SCHED_MAX_TASK;Idx++) {
 		if (NULL == SchedPtr->TaskList[Idx].Callback){
@@ -201,9 +347,31 @@ XStatus XPfw_SchedulerAddTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId,u32 MilliS
 	SchedPtr->TaskList[Idx].Interval = MilliSeconds/TICK_MILLISECONDS;
 	SchedPtr->TaskList[Idx].OwnerId = OwnerId;
 	SchedPtr->TaskList[Idx].Callback = CallbackFn;
+
+	if (0U == SchedPtr->TaskList[Idx].Interval) {
+		/* Non-Periodic, run it from the next XPfw_SchedulerProcess() */
+		SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_TRIGGERED;
+		SchedPtr->Triggered |= ((u32)1U << Idx);
+	} else {
+		Elapsed = XPfw_SchedulerElapsed(SchedPtr);
+		SchedPtr->TaskList[Idx].Due = SchedPtr->Tick + Elapsed +
+				SchedPtr->TaskList[Idx].Interval;
+		XPfw_SchedulerInsert(SchedPtr, (u8)Idx);
+
+		/**
+		 * Program the PIT again when the task is due first, unless the
+		 * PIT already expired and the tick handler is pending
+		 */
+		if ((SchedPtr->Head == (u8)Idx) && (TRUE == SchedPtr->Enabled) &&
+			((0U == SchedPtr->Sleep) || (Elapsed < SchedPtr->Sleep))) {
+			SchedPtr->Tick += Elapsed;
+			XPfw_SchedulerProgram(SchedPtr);
+		}
+	}
 	Status = XST_SUCCESS;
 
 done:
+	XPfw_SchedulerUnlock(Ie);
 	return Status;
 }
 
@@ -211,6 +379,9 @@ XStatus XPfw_SchedulerRemoveTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 Mi
 {
 	u32 Idx;
 	u32 TaskCount = 0U;
+	u32 Ie;
+
+	Ie = XPfw_SchedulerLock();
 
 	/*Find the Task Index */
 	for (Idx = 0U; Idx < XPFW_SCHED_MAX_TASK; Idx++) {
@@ -218,6 +389,13 @@ XStatus XPfw_SchedulerRemoveTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 Mi
 		    (SchedPtr->TaskList[Idx].OwnerId == OwnerId) &&
 		    ((SchedPtr->TaskList[Idx].Interval == (MilliSeconds/TICK_MILLISECONDS)) ||
 				(0U == MilliSeconds))) {
+			/**
+			 * The PIT is left running if the task was due first,
+			 * the next expiry programs it for the new head
+			 */
+			XPfw_SchedulerUnlink(SchedPtr, (u8)Idx);
+			SchedPtr->Triggered &= ~((u32)1U << Idx);
+			SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_DISABLED;
 			SchedPtr->TaskList[Idx].Interval = 0U;
 			SchedPtr->TaskList[Idx].OwnerId = 0U;
 			SchedPtr->TaskList[Idx].Callback = NULL;
@@ -225,8 +403,36 @@ XStatus XPfw_SchedulerRemoveTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 Mi
 		}
 	}
 
+	XPfw_SchedulerUnlock(Ie);
+
 	XPfw_Printf(DEBUG_DETAILED,"%s: Removed %lu tasks\r\n",
 			__func__, TaskCount);
 
 	return ((TaskCount > 0U) ? XST_SUCCESS : XST_FAILURE);
 }
+
+/* PMU clock cycles, wraps around */
+u32 XPfw_SchedulerGetCycles(const XPfw_Scheduler_t *SchedPtr)
+{
+	/* The usage PIT counts down */
+	return ~XPfw_Read32(SchedPtr->UsagePitBaseAddr + PIT_COUNTER_OFFSET);
+}
+
+/* Charge the cycles since StartCycles to a module */
+void XPfw_SchedulerAccount(XPfw_Scheduler_t *SchedPtr, u32 OwnerId,
+		u32 StartCycles)
+{
+	u32 Cycles;
+	u32 Ie;
+
+	if (OwnerId < XPFW_SCHED_MAX_OWNER) {
+		Cycles = XPfw_SchedulerGetCycles(SchedPtr) - StartCycles;
+		Ie = XPfw_SchedulerLock();
+		SchedPtr->Usage[OwnerId].Runs++;
+		SchedPtr->Usage[OwnerId].Cycles += Cycles;
+		if (Cycles > SchedPtr->Usage[OwnerId].MaxCycles) {
+			SchedPtr->Usage[OwnerId].MaxCycles = Cycles;
+		}
+		XPfw_SchedulerUnlock(Ie);
+	}
+}
@@ -32,6 +32,10 @@ extern "C" {
 #include "xpfw_default.h"
 
 #define XPFW_SCHED_MAX_TASK	10U
+#define XPFW_SCHED_MAX_OWNER	32U
+
+/* End of the due list */
+#define XPFW_SCHED_NO_TASK	0xFFU
 
 /* Values for TaskPtr->Status */
 #define XPFW_TASK_STATUS_TRIGGERED	0x5AFEC0C0U
@@ -43,24 +47,43 @@ struct XPfw_Task_t{
 	u32 Interval;
 	u32 OwnerId;
 	u32 Status;
+	u32 Due;	/* Tick the task is due at */
+	u8 Next;	/* Next task in due order */
 	XPfw_Callback_t Callback;
 };
 
+/* CPU usage of a module, in PMU clock cycles */
+typedef struct {
+	u32 Runs;
+	u32 MaxCycles;
+	u64 Cycles;
+} XPfw_SchedUsage_t;
+
 typedef struct {
 	struct XPfw_Task_t TaskList[XPFW_SCHED_MAX_TASK];
+	XPfw_SchedUsage_t Usage[XPFW_SCHED_MAX_OWNER];
 	u32 TaskCount;
 	u32 PitBaseAddr;
-	u32 Tick;
+	u32 UsagePitBaseAddr;
+	u32 Tick;	/* Ticks elapsed up to the last PIT programming */
+	u32 Sleep;	/* Ticks the PIT is programmed for, 0 if stopped */
+	u32 Wakeups;
+	u32 Triggered;	/* Mask of the tasks to run */
+	u8 Head;	/* Task due first */
 	u32 Enabled;
 } XPfw_Scheduler_t ;
 
 void XPfw_SchedulerTickHandler(XPfw_Scheduler_t *SchedPtr);
-XStatus XPfw_SchedulerInit(XPfw_Scheduler_t *SchedPtr, u32 PitBaseAddr);
+XStatus XPfw_SchedulerInit(XPfw_Scheduler_t *SchedPtr, u32 PitBaseAddr,
+		u32 UsagePitBaseAddr);
 XStatus XPfw_SchedulerStart(XPfw_Scheduler_t *SchedPtr);
 XStatus XPfw_SchedulerStop(XPfw_Scheduler_t *SchedPtr);
 XStatus XPfw_SchedulerProcess(XPfw_Scheduler_t *SchedPtr);
 XStatus XPfw_SchedulerAddTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId,u32 MilliSeconds, XPfw_Callback_t CallbackFn);
 XStatus XPfw_SchedulerRemoveTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 MilliSeconds, XPfw_Callback_t CallbackFn);
+u32 XPfw_SchedulerGetCycles(const XPfw_Scheduler_t *SchedPtr);
+void XPfw_SchedulerAccount(XPfw_Scheduler_t *SchedPtr, u32 OwnerId,
+		u32 StartCycles);
 
 #ifdef __cplusplus
 }
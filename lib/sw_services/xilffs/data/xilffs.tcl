@@ -31,6 +31,10 @@
 # 1.00a hk/sg 10/17/13 First release
 # 2.0   hk    12/13/13 Modified to use new TCL API's
 # 4.1   hk    11/21/18 Use additional LFN options
+# 4.2   mn    10/14/19 Export the SD sector cache parameters
+#       mn    10/14/19 Export the fast seek and maximum sector size parameters
+#       mn    10/14/19 Export the reentrancy parameters for FreeRTOS
+#       adk   10/15/19 Export the use_expand parameter
 #
 ##############################################################################
 
@@ -115,6 +119,14 @@ proc xgen_opts_file {libhandle} {
 	set set_fs_rpath [common::get_property CONFIG.set_fs_rpath $libhandle]
 	set word_access [common::get_property CONFIG.word_access $libhandle]
 	set use_chmod [common::get_property CONFIG.use_chmod $libhandle]
+	set sd_cache_sectors [common::get_property CONFIG.sd_cache_sectors $libhandle]
+	set sd_read_ahead [common::get_property CONFIG.sd_read_ahead $libhandle]
+	set use_fastseek [common::get_property CONFIG.use_fastseek $libhandle]
+	set use_expand [common::get_property CONFIG.use_expand $libhandle]
+	set max_sector_size [common::get_property CONFIG.max_sector_size $libhandle]
+	set enable_reentrant [common::get_property CONFIG.enable_reentrant $libhandle]
+	set fs_timeout [common::get_property CONFIG.fs_timeout $libhandle]
+	set os_type [hsi::get_os]
 
 	# do processor specific checks
 	set proc  [hsi::get_sw_processor];
@@ -152,6 +164,18 @@ proc xgen_opts_file {libhandle} {
 		if {$periph == "ps7_sdio" || $periph == "psu_sd" || $periph == "psv_pmc_sd"} {
 			if {$fs_interface == 1} {
 				puts $file_handle "\#define FILE_SYSTEM_INTERFACE_SD"
+				if {$sd_cache_sectors > 0} {
+					if {$sd_read_ahead < 1} {
+						puts "WARNING : Invalid SD read ahead, setting \
+								back to 1\n"
+						set sd_read_ahead 1
+					}
+					if {$sd_read_ahead > $sd_cache_sectors} {
+						set sd_read_ahead $sd_cache_sectors
+					}
+					puts $file_handle "\#define FILE_SYSTEM_SD_CACHE_SECTORS $sd_cache_sectors"
+					puts $file_handle "\#define FILE_SYSTEM_SD_READ_AHEAD $sd_read_ahead"
+				}
 				break
 			}
 		}
@@ -200,6 +224,40 @@ proc xgen_opts_file {libhandle} {
 			set set_fs_rpath 0
 		}
 		puts $file_handle "\#define FILE_SYSTEM_SET_FS_RPATH $set_fs_rpath"
+		if {$use_fastseek == true} {
+			puts $file_handle "\#define FILE_SYSTEM_USE_FASTSEEK"
+		}
+		if {$use_expand == true} {
+			if {$read_only == false} {
+				puts $file_handle "\#define FILE_SYSTEM_USE_EXPAND"
+			} else {
+				puts "WARNING : Cannot Enable EXPAND in \
+						Read Only Mode"
+			}
+		}
+		if {$max_sector_size != 512 && $max_sector_size != 1024 && \
+		    $max_sector_size != 2048 && $max_sector_size != 4096} {
+			puts "WARNING : Invalid maximum sector size, setting \
+					back to 512\n"
+			set max_sector_size 512
+		}
+		if {$max_sector_size != 512} {
+			puts $file_handle "\#define FILE_SYSTEM_MAX_SS $max_sector_size"
+		}
+		if {$enable_reentrant == true} {
+			if {$os_type == "freertos10_xilinx"} {
+				if {$fs_timeout < 1} {
+					puts "WARNING : Invalid FS timeout, setting \
+							back to 1000\n"
+					set fs_timeout 1000
+				}
+				puts $file_handle "\#define FILE_SYSTEM_FS_REENTRANT"
+				puts $file_handle "\#define FILE_SYSTEM_FS_TIMEOUT $fs_timeout"
+			} else {
+				puts "WARNING : Reentrancy is supported only with \
+						freertos10_xilinx"
+			}
+		}
 
 		# MB does not allow word access from RAM
 		if {$proc_type != "microblaze" && $word_access == true} {
@@ -24,8 +24,17 @@
 *		The default block size is 512 bytes.
 *		disk_read and disk_write functions are used to read and
 *		write files using ADMA2 in polled mode.
+*		When "sd_cache_sectors" is non-zero, an LRU cache of that
+*		many sectors sits between FatFs and the SD driver. Small
+*		reads are served from it, misses on sequential reads fetch
+*		"sd_read_ahead" sectors at once, and small writes stay in
+*		the cache until they are evicted or until CTRL_SYNC, which
+*		FatFs issues from f_sync and f_close. Transfers of
+*		"sd_read_ahead" sectors or more go straight to the card.
 *		The file system can be used to read from and write to an
 *		SD card that is already formatted as FATFS.
+*		SD cards always use 512 byte sectors. The RAM disk uses
+*		sectors of "max_sector_size" bytes.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -58,6 +67,11 @@
 *       mn   07/06/18 Fix Cppcheck and Doxygen warnings
 * 4.2   mn   08/16/19 Initialize Status variables with failure values
 *       mn   09/25/19 Check if the SD is powered on or not in disk_status()
+*       mn   10/14/19 Added write back sector cache with read ahead for SD
+*       mn   10/14/19 Report the sector size of the SD card and use the
+*                     maximum sector size for the RAM disk
+*       mn   10/14/19 Keep the base address, CD and WP settings per drive and
+*                     lock the card in the reentrant configuration
 *
 * </pre>
 *
@@ -91,7 +105,7 @@
 static char *dataramfs = NULL;
 
 #define BLOCKSIZE       1U
-#define SECTORSIZE      512U
+#define SECTORSIZE      ((u32)FF_MAX_SS)
 #define SECTORCNT       (RAMFS_SIZE / SECTORSIZE)
 #endif
 
@@ -108,11 +122,498 @@ static DSTATUS Stat[2] = {STA_NOINIT, STA_NOINIT};	/* Disk status */
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
 static XSdPs SdInstance[2];
-static u32 BaseAddress;
-static u32 CardDetect;
-static u32 WriteProtect;
+static u32 BaseAddress[2];
+static u32 CardDetect[2];
+static u32 WriteProtect[2];
 static u32 SlotType[2];
 static u8 HostCntrlrVer[2];
+
+#if defined(FILE_SYSTEM_SD_CACHE_SECTORS) && (FILE_SYSTEM_SD_CACHE_SECTORS > 0)
+#define SD_SECTOR_CACHE
+#define SD_SECTOR_SIZE		XSDPS_BLK_SIZE_512_MASK
+#define SD_CACHE_SECTORS	FILE_SYSTEM_SD_CACHE_SECTORS
+#define SD_READ_AHEAD		FILE_SYSTEM_SD_READ_AHEAD
+
+typedef struct {
+	DWORD Sector;		/* Sector number (LBA) */
+	u32 LastUse;		/* Value of SdCacheClock at the last access */
+	BYTE Drive;		/* Physical drive number */
+	BYTE Valid;		/* Entry holds a sector */
+	BYTE Dirty;		/* Sector must be written back */
+} SdCacheTag;
+
+static SdCacheTag SdCacheTags[SD_CACHE_SECTORS];
+static u32 SdCacheClock;
+static DWORD SdNextSector[2];	/* Sector following the last read */
+#ifdef __ICCARM__
+#pragma data_alignment = 64
+static BYTE SdCacheData[SD_CACHE_SECTORS][SD_SECTOR_SIZE];
+#pragma data_alignment = 64
+static BYTE SdRunBuff[SD_READ_AHEAD][SD_SECTOR_SIZE];
+#else
+static BYTE SdCacheData[SD_CACHE_SECTORS][SD_SECTOR_SIZE]
+	__attribute__ ((aligned(64)));
+static BYTE SdRunBuff[SD_READ_AHEAD][SD_SECTOR_SIZE]
+	__attribute__ ((aligned(64)));
+#endif
+#endif
+
+#if FF_FS_REENTRANT && (FF_MULTI_PARTITION || defined(SD_SECTOR_CACHE))
+/*
+ * FatFs locks each volume. The partitions of a card are different volumes
+ * and the sector cache is shared by the drives, so the accesses to the card
+ * are serialized here as well. Without the cache each drive has its own lock.
+ */
+#define SD_DISK_LOCK
+#ifdef SD_SECTOR_CACHE
+#define SD_LOCK_ID(pdrv)	0U
+#else
+#define SD_LOCK_ID(pdrv)	(pdrv)
+#endif
+#include "task.h"
+static SemaphoreHandle_t SdLock[2];
+#if configSUPPORT_STATIC_ALLOCATION
+static StaticSemaphore_t SdLockBuffer[2];
+#endif
+#endif
+#endif
+
+#ifdef FILE_SYSTEM_INTERFACE_SD
+#ifdef SD_DISK_LOCK
+/*****************************************************************************/
+/**
+*
+* Takes the lock of a drive, creating it on first use.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK, RES_NOTRDY on timeout or RES_ERROR if the lock could
+*		not be created
+*
+******************************************************************************/
+static DRESULT sd_lock(BYTE pdrv)
+{
+	SemaphoreHandle_t *Lock = &SdLock[SD_LOCK_ID(pdrv)];
+
+	if (*Lock == NULL) {
+		/* Keep two tasks from creating the lock at the same time */
+		vTaskSuspendAll();
+		if (*Lock == NULL) {
+#if configSUPPORT_STATIC_ALLOCATION
+			*Lock = xSemaphoreCreateMutexStatic(
+					&SdLockBuffer[SD_LOCK_ID(pdrv)]);
+#else
+			*Lock = xSemaphoreCreateMutex();
+#endif
+		}
+		(void)xTaskResumeAll();
+		if (*Lock == NULL) {
+			return RES_ERROR;
+		}
+	}
+
+	if (ff_req_grant(*Lock) == 0) {
+		return RES_NOTRDY;
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Releases the lock of a drive taken with sd_lock.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_unlock(BYTE pdrv)
+{
+	ff_rel_grant(SdLock[SD_LOCK_ID(pdrv)]);
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors from the SD card.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	XST_SUCCESS or XST_FAILURE
+*
+******************************************************************************/
+static s32 sd_read_sectors(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+	DWORD LocSector = sector;
+
+	/* Convert LBA to byte address if needed */
+	if ((SdInstance[pdrv].HCS) == 0U) {
+		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
+	}
+
+	return XSdPs_ReadPolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors to the SD card.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	XST_SUCCESS or XST_FAILURE
+*
+******************************************************************************/
+static s32 sd_write_sectors(BYTE pdrv, const BYTE *buff, DWORD sector,
+		UINT count)
+{
+	DWORD LocSector = sector;
+
+	/* Convert LBA to byte address if needed */
+	if ((SdInstance[pdrv].HCS) == 0U) {
+		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
+	}
+
+	return XSdPs_WritePolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
+}
+#endif
+
+#ifdef SD_SECTOR_CACHE
+/*****************************************************************************/
+/**
+*
+* Looks a sector up in the sector cache.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number
+*
+* @return	Index of the cache entry or -1 if the sector is not cached.
+*
+******************************************************************************/
+static s32 sd_cache_find(BYTE pdrv, DWORD sector)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < SD_CACHE_SECTORS; Index++) {
+		if ((SdCacheTags[Index].Valid != 0U) &&
+				(SdCacheTags[Index].Sector == sector) &&
+				(SdCacheTags[Index].Drive == pdrv)) {
+			SdCacheTags[Index].LastUse = ++SdCacheClock;
+			return (s32)Index;
+		}
+	}
+
+	return -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* Assigns a cache entry to a sector. A free entry is used if any, otherwise
+* the least recently used one is evicted and written back if it is dirty.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number
+*
+* @return	Index of the cache entry or -1 if the write back failed.
+*
+******************************************************************************/
+static s32 sd_cache_alloc(BYTE pdrv, DWORD sector)
+{
+	u32 Victim = 0U;
+	u32 Index;
+	SdCacheTag *Tag;
+
+	for (Index = 0U; Index < SD_CACHE_SECTORS; Index++) {
+		if (SdCacheTags[Index].Valid == 0U) {
+			Victim = Index;
+			break;
+		}
+		if (SdCacheTags[Index].LastUse < SdCacheTags[Victim].LastUse) {
+			Victim = Index;
+		}
+	}
+
+	Tag = &SdCacheTags[Victim];
+	if ((Tag->Valid != 0U) && (Tag->Dirty != 0U)) {
+		if (sd_write_sectors(Tag->Drive, SdCacheData[Victim],
+				Tag->Sector, 1U) != XST_SUCCESS) {
+			return -1;
+		}
+	}
+
+	Tag->Sector = sector;
+	Tag->Drive = pdrv;
+	Tag->Valid = 1U;
+	Tag->Dirty = 0U;
+	Tag->LastUse = ++SdCacheClock;
+
+	return (s32)Victim;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the dirty sectors of a drive back to the card. Runs of consecutive
+* dirty sectors are gathered and written with a single multi-block write.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT sd_cache_sync(BYTE pdrv)
+{
+	u32 Run[SD_READ_AHEAD];
+	u32 RunLen;
+	u32 Index;
+	u32 First;
+	s32 Status;
+	DWORD Next;
+
+	for (;;) {
+		/* Lowest dirty sector of the drive */
+		First = SD_CACHE_SECTORS;
+		for (Index = 0U; Index < SD_CACHE_SECTORS; Index++) {
+			if ((SdCacheTags[Index].Valid != 0U) &&
+					(SdCacheTags[Index].Dirty != 0U) &&
+					(SdCacheTags[Index].Drive == pdrv) &&
+					((First == SD_CACHE_SECTORS) ||
+					 (SdCacheTags[Index].Sector <
+					  SdCacheTags[First].Sector))) {
+				First = Index;
+			}
+		}
+		if (First == SD_CACHE_SECTORS) {
+			break;
+		}
+
+		/* Extend the run with the dirty sectors that follow it */
+		Run[0] = First;
+		RunLen = 1U;
+		Next = SdCacheTags[First].Sector + 1U;
+		while (RunLen < SD_READ_AHEAD) {
+			for (Index = 0U; Index < SD_CACHE_SECTORS; Index++) {
+				if ((SdCacheTags[Index].Valid != 0U) &&
+						(SdCacheTags[Index].Dirty != 0U) &&
+						(SdCacheTags[Index].Drive == pdrv) &&
+						(SdCacheTags[Index].Sector == Next)) {
+					break;
+				}
+			}
+			if (Index == SD_CACHE_SECTORS) {
+				break;
+			}
+			Run[RunLen] = Index;
+			RunLen++;
+			Next++;
+		}
+
+		if (RunLen == 1U) {
+			Status = sd_write_sectors(pdrv, SdCacheData[First],
+					SdCacheTags[First].Sector, 1U);
+		} else {
+			for (Index = 0U; Index < RunLen; Index++) {
+				(void)memcpy(SdRunBuff[Index], SdCacheData[Run[Index]],
+						SD_SECTOR_SIZE);
+			}
+			Status = sd_write_sectors(pdrv, SdRunBuff[0],
+					SdCacheTags[First].Sector, RunLen);
+		}
+		if (Status != XST_SUCCESS) {
+			return RES_ERROR;
+		}
+
+		for (Index = 0U; Index < RunLen; Index++) {
+			SdCacheTags[Run[Index]].Dirty = 0U;
+		}
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Drops all the cached sectors of a drive, dirty ones included.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_cache_invalidate(BYTE pdrv)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < SD_CACHE_SECTORS; Index++) {
+		if (SdCacheTags[Index].Drive == pdrv) {
+			SdCacheTags[Index].Valid = 0U;
+		}
+	}
+	SdNextSector[pdrv] = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors through the sector cache. Transfers of SD_READ_AHEAD sectors
+* or more are read from the card and patched with the cached sectors, which
+* may be newer. Otherwise each sector comes from the cache, and a miss reads
+* the rest of the request or, when the access continues the previous one,
+* SD_READ_AHEAD sectors into the cache.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT sd_cache_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+	u32 Index;
+	u32 Fetch;
+	s32 Entry;
+	DWORD Cur;
+
+	if (count >= SD_READ_AHEAD) {
+		if (sd_read_sectors(pdrv, buff, sector, count) != XST_SUCCESS) {
+			return RES_ERROR;
+		}
+		for (Index = 0U; Index < SD_CACHE_SECTORS; Index++) {
+			if ((SdCacheTags[Index].Valid != 0U) &&
+					(SdCacheTags[Index].Drive == pdrv) &&
+					(SdCacheTags[Index].Sector >= sector) &&
+					(SdCacheTags[Index].Sector < (sector + count))) {
+				(void)memcpy(buff + ((SdCacheTags[Index].Sector -
+					sector) * SD_SECTOR_SIZE),
+					SdCacheData[Index], SD_SECTOR_SIZE);
+			}
+		}
+		SdNextSector[pdrv] = sector + count;
+		return RES_OK;
+	}
+
+	for (Cur = sector; Cur < (sector + count); Cur++) {
+		Entry = sd_cache_find(pdrv, Cur);
+		if (Entry < 0) {
+			/* Sequential access reads ahead, random access does not */
+			if (sector == SdNextSector[pdrv]) {
+				Fetch = SD_READ_AHEAD;
+			} else {
+				Fetch = (u32)((sector + count) - Cur);
+			}
+			/* Do not read ahead past the end of the card */
+			if ((SdInstance[pdrv].SectorCount > Cur) &&
+					((Cur + Fetch) > SdInstance[pdrv].SectorCount)) {
+				Fetch = (u32)(SdInstance[pdrv].SectorCount - Cur);
+			}
+			if (sd_read_sectors(pdrv, SdRunBuff[0], Cur, Fetch) !=
+					XST_SUCCESS) {
+				return RES_ERROR;
+			}
+			/*
+			 * Cached copies may be newer than the card. Patch them in
+			 * first, as the entries below can evict them.
+			 */
+			for (Index = 0U; Index < SD_CACHE_SECTORS; Index++) {
+				if ((SdCacheTags[Index].Valid != 0U) &&
+						(SdCacheTags[Index].Drive == pdrv) &&
+						(SdCacheTags[Index].Sector > Cur) &&
+						(SdCacheTags[Index].Sector < (Cur + Fetch))) {
+					(void)memcpy(SdRunBuff[SdCacheTags[Index].Sector -
+						Cur], SdCacheData[Index], SD_SECTOR_SIZE);
+				}
+			}
+			for (Index = 0U; Index < Fetch; Index++) {
+				if ((Index != 0U) &&
+						(sd_cache_find(pdrv, Cur + Index) >= 0)) {
+					continue;
+				}
+				Entry = sd_cache_alloc(pdrv, Cur + Index);
+				if (Entry < 0) {
+					return RES_ERROR;
+				}
+				(void)memcpy(SdCacheData[Entry], SdRunBuff[Index],
+						SD_SECTOR_SIZE);
+			}
+			Entry = sd_cache_find(pdrv, Cur);
+		}
+		(void)memcpy(buff + ((Cur - sector) * SD_SECTOR_SIZE),
+				SdCacheData[Entry], SD_SECTOR_SIZE);
+	}
+	SdNextSector[pdrv] = sector + count;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors through the sector cache. Transfers of SD_READ_AHEAD
+* sectors or more are written to the card and update the cached copies.
+* Smaller ones are only written to the cache.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT sd_cache_write(BYTE pdrv, const BYTE *buff, DWORD sector,
+		UINT count)
+{
+	u32 Index;
+	s32 Entry;
+	DWORD Cur;
+
+	if (count >= SD_READ_AHEAD) {
+		if (sd_write_sectors(pdrv, buff, sector, count) != XST_SUCCESS) {
+			return RES_ERROR;
+		}
+		for (Index = 0U; Index < SD_CACHE_SECTORS; Index++) {
+			if ((SdCacheTags[Index].Valid != 0U) &&
+					(SdCacheTags[Index].Drive == pdrv) &&
+					(SdCacheTags[Index].Sector >= sector) &&
+					(SdCacheTags[Index].Sector < (sector + count))) {
+				(void)memcpy(SdCacheData[Index],
+					buff + ((SdCacheTags[Index].Sector -
+					sector) * SD_SECTOR_SIZE), SD_SECTOR_SIZE);
+				SdCacheTags[Index].Dirty = 0U;
+			}
+		}
+		return RES_OK;
+	}
+
+	for (Cur = sector; Cur < (sector + count); Cur++) {
+		Entry = sd_cache_find(pdrv, Cur);
+		if (Entry < 0) {
+			Entry = sd_cache_alloc(pdrv, Cur);
+			if (Entry < 0) {
+				return RES_ERROR;
+			}
+		}
+		(void)memcpy(SdCacheData[Entry],
+				buff + ((Cur - sector) * SD_SECTOR_SIZE),
+				SD_SECTOR_SIZE);
+		SdCacheTags[Entry].Dirty = 1U;
+	}
+
+	return RES_OK;
+}
 #endif
 
 /*-----------------------------------------------------------------------*/
@@ -149,21 +650,21 @@ DSTATUS disk_status (
 		if (SdInstance[pdrv].Config.BaseAddress == (u32)0) {
 #ifdef XPAR_XSDPS_1_DEVICE_ID
 				if(pdrv == 1) {
-						BaseAddress = XPAR_XSDPS_1_BASEADDR;
-						CardDetect = XPAR_XSDPS_1_HAS_CD;
-						WriteProtect = XPAR_XSDPS_1_HAS_WP;
+						BaseAddress[pdrv] = XPAR_XSDPS_1_BASEADDR;
+						CardDetect[pdrv] = XPAR_XSDPS_1_HAS_CD;
+						WriteProtect[pdrv] = XPAR_XSDPS_1_HAS_WP;
 				} else {
 #endif
-						BaseAddress = XPAR_XSDPS_0_BASEADDR;
-						CardDetect = XPAR_XSDPS_0_HAS_CD;
-						WriteProtect = XPAR_XSDPS_0_HAS_WP;
+						BaseAddress[pdrv] = XPAR_XSDPS_0_BASEADDR;
+						CardDetect[pdrv] = XPAR_XSDPS_0_HAS_CD;
+						WriteProtect[pdrv] = XPAR_XSDPS_0_HAS_WP;
 #ifdef XPAR_XSDPS_1_DEVICE_ID
 				}
 #endif
-				HostCntrlrVer[pdrv] = (u8)(XSdPs_ReadReg16(BaseAddress,
+				HostCntrlrVer[pdrv] = (u8)(XSdPs_ReadReg16(BaseAddress[pdrv],
 						XSDPS_HOST_CTRL_VER_OFFSET) & XSDPS_HC_SPEC_VER_MASK);
 				if (HostCntrlrVer[pdrv] == XSDPS_HC_SPEC_V3) {
-					SlotType[pdrv] = XSdPs_ReadReg(BaseAddress,
+					SlotType[pdrv] = XSdPs_ReadReg(BaseAddress[pdrv],
 							XSDPS_CAPS_OFFSET) & XSDPS_CAPS_SLOT_TYPE_MASK;
 				} else {
 					SlotType[pdrv] = 0;
@@ -171,14 +672,14 @@ DSTATUS disk_status (
 		}
 
 		/* If SD is not powered up then mark it as not initialized */
-		if ((XSdPs_ReadReg8((u32)BaseAddress, XSDPS_POWER_CTRL_OFFSET) &
+		if ((XSdPs_ReadReg8((u32)BaseAddress[pdrv], XSDPS_POWER_CTRL_OFFSET) &
 			XSDPS_PC_BUS_PWR_MASK) == 0U) {
 			s |= STA_NOINIT;
 		}
 
-		StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress);
+		StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress[pdrv]);
 		if (SlotType[pdrv] != XSDPS_CAPS_EMB_SLOT) {
-			if (CardDetect) {
+			if (CardDetect[pdrv]) {
 				while ((StatusReg & XSDPS_PSR_CARD_INSRT_MASK) == 0U) {
 					if (DelayCount == 500U) {
 						s = STA_NODISK | STA_NOINIT;
@@ -187,12 +688,12 @@ DSTATUS disk_status (
 						/* Wait for 10 msec */
 						usleep(SD_CD_DELAY);
 						DelayCount++;
-						StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress);
+						StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress[pdrv]);
 					}
 				}
 			}
 			s &= ~STA_NODISK;
-			if (WriteProtect) {
+			if (WriteProtect[pdrv]) {
 					if ((StatusReg & XSDPS_PSR_WPS_PL_MASK) == 0U){
 						s |= STA_PROTECT;
 						goto Label;
@@ -254,7 +755,18 @@ DSTATUS disk_initialize (
 	}
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
-	if (CardDetect) {
+#ifdef SD_DISK_LOCK
+	if (sd_lock(pdrv) != RES_OK) {
+		return s;
+	}
+	/* Another partition of the card may have initialized it meanwhile */
+	if ((Stat[pdrv] & STA_NOINIT) == 0U) {
+		s = Stat[pdrv];
+		goto Unlock;
+	}
+#endif
+
+	if (CardDetect[pdrv]) {
 			/*
 			 * Card detection check
 			 * If the HC detects the No Card State, power will be cleared
@@ -262,7 +774,7 @@ DSTATUS disk_initialize (
 			while(!((XSDPS_PSR_CARD_DPL_MASK |
 					XSDPS_PSR_CARD_STABLE_MASK |
 					XSDPS_PSR_CARD_INSRT_MASK) ==
-					( XSdPs_GetPresentStatusReg((u32)BaseAddress) &
+					( XSdPs_GetPresentStatusReg((u32)BaseAddress[pdrv]) &
 					(XSDPS_PSR_CARD_DPL_MASK |
 					XSDPS_PSR_CARD_STABLE_MASK |
 					XSDPS_PSR_CARD_INSRT_MASK))));
@@ -274,23 +786,28 @@ DSTATUS disk_initialize (
 	SdConfig = XSdPs_LookupConfig((u16)pdrv);
 	if (NULL == SdConfig) {
 		s |= STA_NOINIT;
-		return s;
+		goto Unlock;
 	}
 
 	Status = XSdPs_CfgInitialize(&SdInstance[pdrv], SdConfig,
 					SdConfig->BaseAddress);
 	if (Status != XST_SUCCESS) {
 		s |= STA_NOINIT;
-		return s;
+		goto Unlock;
 	}
 
 	Status = XSdPs_CardInitialize(&SdInstance[pdrv]);
 	if (Status != XST_SUCCESS) {
 		s |= STA_NOINIT;
-		return s;
+		goto Unlock;
 	}
 
 
+#ifdef SD_SECTOR_CACHE
+	/* The card may have been replaced */
+	sd_cache_invalidate(pdrv);
+#endif
+
 	/*
 	 * Disk is initialized.
 	 * Store the same in Stat.
@@ -298,6 +815,11 @@ DSTATUS disk_initialize (
 	s &= (~STA_NOINIT);
 
 	Stat[pdrv] = s;
+
+Unlock:
+#ifdef SD_DISK_LOCK
+	sd_unlock(pdrv);
+#endif
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
@@ -344,8 +866,10 @@ DRESULT disk_read (
 {
 	DSTATUS s;
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	DRESULT res;
+#ifndef SD_SECTOR_CACHE
 	s32 Status = XST_FAILURE;
-	DWORD LocSector = sector;
+#endif
 #endif
 
 	s = disk_status(pdrv);
@@ -358,14 +882,23 @@ DRESULT disk_read (
 	}
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
-	/* Convert LBA to byte address if needed */
-	if ((SdInstance[pdrv].HCS) == 0U) {
-		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
+#ifdef SD_DISK_LOCK
+	res = sd_lock(pdrv);
+	if (res != RES_OK) {
+		return res;
 	}
-
-	Status  = XSdPs_ReadPolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
-	if (Status != XST_SUCCESS) {
-		return RES_ERROR;
+#endif
+#ifdef SD_SECTOR_CACHE
+	res = sd_cache_read(pdrv, buff, sector, count);
+#else
+	Status = sd_read_sectors(pdrv, buff, sector, count);
+	res = (Status == XST_SUCCESS) ? RES_OK : RES_ERROR;
+#endif
+#ifdef SD_DISK_LOCK
+	sd_unlock(pdrv);
+#endif
+	if (res != RES_OK) {
+		return res;
 	}
 #endif
 
@@ -396,7 +929,20 @@ DRESULT disk_ioctl (
 
 	switch (cmd) {
 		case (BYTE)CTRL_SYNC :	/* Make sure that no pending write process */
+#ifdef SD_SECTOR_CACHE
+#ifdef SD_DISK_LOCK
+			res = sd_lock(pdrv);
+			if (res != RES_OK) {
+				break;
+			}
+#endif
+			res = sd_cache_sync(pdrv);
+#ifdef SD_DISK_LOCK
+			sd_unlock(pdrv);
+#endif
+#else
 			res = RES_OK;
+#endif
 			break;
 
 		case (BYTE)GET_SECTOR_COUNT : /* Get number of sectors on the disk (DWORD) */
@@ -409,6 +955,11 @@ DRESULT disk_ioctl (
 			res = RES_OK;
 			break;
 
+		case (BYTE)GET_SECTOR_SIZE : /* Get sector size, needed when FF_MAX_SS > FF_MIN_SS (WORD) */
+			(*((WORD *)((void *)LocBuff))) = ((WORD)XSDPS_BLK_SIZE_512_MASK);
+			res = RES_OK;
+			break;
+
 		default:
 			res = RES_PARERR;
 			break;
@@ -490,8 +1041,10 @@ DRESULT disk_write (
 {
 	DSTATUS s;
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	DRESULT res;
+#ifndef SD_SECTOR_CACHE
 	s32 Status = XST_FAILURE;
-	DWORD LocSector = sector;
+#endif
 #endif
 
 	s = disk_status(pdrv);
@@ -503,16 +1056,24 @@ DRESULT disk_write (
 	}
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
-	/* Convert LBA to byte address if needed */
-	if ((SdInstance[pdrv].HCS) == 0U) {
-		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
+#ifdef SD_DISK_LOCK
+	res = sd_lock(pdrv);
+	if (res != RES_OK) {
+		return res;
 	}
-
-	Status  = XSdPs_WritePolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
-	if (Status != XST_SUCCESS) {
-		return RES_ERROR;
+#endif
+#ifdef SD_SECTOR_CACHE
+	res = sd_cache_write(pdrv, buff, sector, count);
+#else
+	Status = sd_write_sectors(pdrv, buff, sector, count);
+	res = (Status == XST_SUCCESS) ? RES_OK : RES_ERROR;
+#endif
+#ifdef SD_DISK_LOCK
+	sd_unlock(pdrv);
+#endif
+	if (res != RES_OK) {
+		return res;
 	}
-
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
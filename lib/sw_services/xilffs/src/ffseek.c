@@ -0,0 +1,316 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file ffseek.c
+*		Random access helpers on top of FatFs.
+*
+*		Without fast seek, f_lseek follows the cluster chain of the
+*		file through the FAT from the start, or from the current
+*		position when seeking forward, so a seek into a multi GB file
+*		reads thousands of FAT sectors. When "use_fastseek" is set,
+*		f_open_fastseek walks the chain once when the file is opened
+*		and keeps it in a cluster link map table (CLMT) supplied by
+*		the caller. Seeks then look the cluster up in the table and
+*		do not touch the FAT.
+*
+*		A file opened in fast seek mode cannot grow, writes past the
+*		end of the file stop at the last allocated cluster. Data
+*		inside the file can be overwritten.
+*
+*		f_read_at also uses the table to find the contiguous
+*		fragments of a file opened for reading only. The sectors of
+*		a fragment are read with a single disk_read, up to
+*		FF_READ_AT_MAX_SECTORS, where f_read issues one per cluster.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.2   mn   10/14/19 First release
+*       adk  10/15/19 f_read_at reads whole fragments of read only fast
+*                     seek files with one disk_read each
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#include "xparameters.h"
+#if (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM)
+#include "ff.h"
+#include "diskio.h"
+
+/* Largest disk_read issued by f_read_at, the SD driver takes 2 MB */
+#ifndef FF_READ_AT_MAX_SECTORS
+#define FF_READ_AT_MAX_SECTORS	4096U
+#endif
+
+#if FF_USE_FASTSEEK
+/*****************************************************************************/
+/**
+*
+* Open a file and create its cluster link map table.
+*
+* @param	fp: Pointer to the file object to open.
+* @param	path: Path of the file, as for f_open.
+* @param	mode: Access mode and open method flags, as for f_open.
+* @param	tbl: Table of len DWORD items that holds the CLMT. It is used
+*		as long as the file is open and must not be reused before
+*		f_close.
+* @param	len: Number of items in tbl. A file made of n fragments
+*		needs FF_CLMT_ITEMS(n) items.
+*
+* @return
+*		- FR_OK if the file is open in fast seek mode.
+*		- FR_NOT_ENOUGH_CORE if tbl is too small. The file is closed
+*		  and tbl[0] holds the number of items needed, so the call can
+*		  be retried with a larger table.
+*		- Any error code of f_open or f_lseek otherwise. The file is
+*		  closed.
+*
+* @note		An empty file has no cluster and needs FF_CLMT_ITEMS(0) items.
+*
+******************************************************************************/
+FRESULT f_open_fastseek (
+	FIL* fp,
+	const TCHAR* path,
+	BYTE mode,
+	DWORD* tbl,
+	UINT len
+)
+{
+	FRESULT res;
+
+	if ((tbl == NULL) || (len < FF_CLMT_ITEMS(0))) {
+		return FR_INVALID_PARAMETER;
+	}
+
+	res = f_open(fp, path, mode);
+	if (res != FR_OK) {
+		return res;
+	}
+
+	/* f_open clears cltbl, the table is attached after the open */
+	tbl[0] = (DWORD)len;
+	fp->cltbl = tbl;
+	res = f_lseek(fp, CREATE_LINKMAP);
+	if (res != FR_OK) {
+		/* tbl[0] has the required size, keep it for the caller */
+		fp->cltbl = NULL;
+		(void)f_close(fp);
+	}
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Read the whole sectors of a fast seek file straight from the disk, one
+* disk_read per contiguous fragment.
+*
+* @param	fp: Pointer to a file object with a cluster link map table.
+* @param	ofs: Sector aligned offset from the start of the file.
+* @param	buff: Pointer to the buffer receiving the data.
+* @param	nsect: Number of sectors to read, all inside the file.
+*
+* @return	FR_OK, FR_INT_ERR if the table does not cover ofs or
+*		FR_DISK_ERR.
+*
+******************************************************************************/
+static FRESULT read_fragments (
+	FIL* fp,
+	FSIZE_t ofs,
+	BYTE* buff,
+	DWORD nsect
+)
+{
+	FATFS* fs = fp->obj.fs;
+	DWORD* tbl;
+	DWORD ss;
+	DWORD cl;
+	DWORD csect;
+	DWORD ncl;
+	DWORD cc;
+
+#if FF_MAX_SS == FF_MIN_SS
+	ss = (DWORD)FF_MAX_SS;
+#else
+	ss = (DWORD)fs->ssize;
+#endif
+	/* Cluster of the file and sector in the cluster */
+	cl = (DWORD)((ofs / ss) / fs->csize);
+	csect = (DWORD)((ofs / ss) % fs->csize);
+	tbl = fp->cltbl + 1;
+
+	while (nsect > 0U) {
+		/* Skip the fragments before the cluster */
+		ncl = *tbl;
+		while ((ncl != 0U) && (cl >= ncl)) {
+			cl -= ncl;
+			tbl += 2;
+			ncl = *tbl;
+		}
+		if (ncl == 0U) {
+			return FR_INT_ERR;
+		}
+
+		/* Sectors left in the fragment */
+		cc = ((ncl - cl) * fs->csize) - csect;
+		if (cc > nsect) {
+			cc = nsect;
+		}
+		if (cc > FF_READ_AT_MAX_SECTORS) {
+			cc = FF_READ_AT_MAX_SECTORS;
+		}
+		if (disk_read(fs->pdrv, buff, fs->database +
+				((tbl[1] + cl - 2U) * fs->csize) + csect,
+				(UINT)cc) != RES_OK) {
+			return FR_DISK_ERR;
+		}
+
+		buff += cc * ss;
+		nsect -= cc;
+		csect += cc;
+		cl += csect / fs->csize;
+		csect %= fs->csize;
+	}
+
+	return FR_OK;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Read data from a given offset of a file. The file pointer is moved to the
+* offset and then advanced by the number of bytes read.
+*
+* @param	fp: Pointer to an open file object.
+* @param	ofs: Offset from the start of the file.
+* @param	buff: Pointer to the buffer receiving the data.
+* @param	btr: Number of bytes to read.
+* @param	br: Pointer to the number of bytes read. It is less than btr
+*		when the read reaches the end of the file.
+*
+* @return	FR_OK or any error code of f_lseek and f_read.
+*
+* @note		The seek costs no FAT access when the file was opened with
+*		f_open_fastseek. Reads that start and end on sector
+*		boundaries go straight from the disk to buff. For a fast
+*		seek file opened without FA_WRITE, every whole sector does,
+*		in one disk_read per fragment.
+*
+******************************************************************************/
+FRESULT f_read_at (
+	FIL* fp,
+	FSIZE_t ofs,
+	void* buff,
+	UINT btr,
+	UINT* br
+)
+{
+	FRESULT res;
+#if FF_USE_FASTSEEK
+	BYTE* rbuff = (BYTE*)buff;
+	UINT ss;
+	UINT head;
+	UINT rcnt;
+	DWORD nsect;
+#endif
+
+	*br = 0U;
+
+	if (f_tell(fp) != ofs) {
+		res = f_lseek(fp, ofs);
+		if (res != FR_OK) {
+			return res;
+		}
+	}
+
+#if FF_USE_FASTSEEK
+	if ((fp->cltbl != NULL) && ((fp->flag & FA_WRITE) == 0U) &&
+			(ofs < f_size(fp))) {
+#if FF_MAX_SS == FF_MIN_SS
+		ss = (UINT)FF_MAX_SS;
+#else
+		ss = (UINT)fp->obj.fs->ssize;
+#endif
+		if ((FSIZE_t)btr > (f_size(fp) - ofs)) {
+			btr = (UINT)(f_size(fp) - ofs);
+		}
+
+		/* Up to the first sector boundary through the file buffer */
+		head = (ss - (UINT)(ofs % ss)) % ss;
+		if (head > btr) {
+			head = btr;
+		}
+		if (head != 0U) {
+			res = f_read(fp, rbuff, head, &rcnt);
+			*br += rcnt;
+			if ((res != FR_OK) || (rcnt != head)) {
+				return res;
+			}
+			rbuff += head;
+			ofs += head;
+			btr -= head;
+		}
+
+		nsect = (DWORD)(btr / ss);
+		if (nsect > 0U) {
+			res = read_fragments(fp, ofs, rbuff, nsect);
+			if (res != FR_OK) {
+				return res;
+			}
+			rcnt = (UINT)(nsect * ss);
+			*br += rcnt;
+			rbuff += rcnt;
+			ofs += rcnt;
+			btr -= rcnt;
+			res = f_lseek(fp, ofs);
+			if (res != FR_OK) {
+				return res;
+			}
+		}
+
+		/* Rest of the last sector */
+		if (btr != 0U) {
+			res = f_read(fp, rbuff, btr, &rcnt);
+			*br += rcnt;
+			return res;
+		}
+
+		return FR_OK;
+	}
+#endif
+
+	return f_read(fp, buff, btr, br);
+}
+
+#endif /* (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM) */
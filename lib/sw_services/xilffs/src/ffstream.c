@@ -0,0 +1,369 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file ffstream.c
+*		Streaming writes on top of FatFs, for recorders writing long
+*		files at a high rate.
+*
+*		f_write extends a file cluster by cluster, updating the FAT
+*		at each cluster, and issues at most one disk_write per
+*		cluster. f_stream_open instead creates the file with f_expand
+*		as one contiguous extent of the size given, so that the FAT
+*		is written once when the file is created. f_stream_write
+*		then writes the whole sectors of each request straight to
+*		the extent with a single disk_write, up to
+*		FF_STREAM_MAX_SECTORS, and only the unaligned head and tail
+*		go through f_write and the file buffer. The directory entry
+*		is updated by f_stream_sync, called every syncsize bytes or
+*		by the application.
+*
+*		Until f_stream_close, the size of the file is the size of the
+*		extent. f_stream_close truncates the file at the current
+*		position and frees the clusters not used. Writes past the
+*		extent go through f_write, which allocates clusters as usual.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.2   adk  10/15/19 First release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#include "xparameters.h"
+#if (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM)
+#include <string.h>
+#include "ff.h"
+#include "diskio.h"
+
+#if FF_USE_EXPAND && !FF_FS_READONLY
+/* Largest disk_write issued by f_stream_write, the SD driver takes 2 MB */
+#ifndef FF_STREAM_MAX_SECTORS
+#define FF_STREAM_MAX_SECTORS	4096U
+#endif
+
+/* File buffer needs to be written back, as FA_DIRTY in ff.c */
+#define FF_STREAM_FA_DIRTY	0x80U
+/* File has been modified, as FA_MODIFIED in ff.c */
+#define FF_STREAM_FA_MODIFIED	0x40U
+
+/*****************************************************************************/
+/**
+*
+* Write whole sectors of a streaming file straight to its extent.
+*
+* @param	sp: Pointer to the streaming file object.
+* @param	buff: Pointer to the data to be written.
+* @param	nsect: Number of sectors to write, all inside the extent from
+*		the current position, which is sector aligned.
+*
+* @return	FR_OK, FR_TIMEOUT or FR_DISK_ERR.
+*
+******************************************************************************/
+static FRESULT write_extent (
+	FSTREAM* sp,
+	const BYTE* buff,
+	DWORD nsect
+)
+{
+	FIL* fp = &sp->fil;
+	FATFS* fs = fp->obj.fs;
+	FRESULT res = FR_OK;
+	DWORD ss;
+	DWORD sect;
+	DWORD cc;
+
+#if FF_MAX_SS == FF_MIN_SS
+	ss = (DWORD)FF_MAX_SS;
+#else
+	ss = (DWORD)fs->ssize;
+#endif
+
+#if FF_FS_REENTRANT
+	/* The disk is shared with the FatFs functions of other tasks */
+	if (ff_req_grant(fs->sobj) == 0) {
+		return FR_TIMEOUT;
+	}
+#endif
+
+	while (nsect > 0U) {
+		cc = (nsect > FF_STREAM_MAX_SECTORS) ?
+				FF_STREAM_MAX_SECTORS : nsect;
+		sect = sp->sect + (DWORD)(fp->fptr / ss);
+		if (disk_write(fs->pdrv, buff, sect, (UINT)cc) != RES_OK) {
+			res = FR_DISK_ERR;
+			break;
+		}
+
+		/* Keep the sector held by the file buffer up to date */
+#if FF_FS_TINY
+		if ((fs->winsect - sect) < cc) {
+			(void)memcpy(fs->win, buff + ((fs->winsect - sect) * ss),
+					ss);
+			fs->wflag = 0U;
+		}
+#else
+		if ((fp->sect - sect) < cc) {
+			(void)memcpy(fp->buf, buff + ((fp->sect - sect) * ss), ss);
+			fp->flag &= (BYTE)~FF_STREAM_FA_DIRTY;
+		}
+#endif
+
+		buff += cc * ss;
+		nsect -= cc;
+		fp->fptr += (FSIZE_t)cc * ss;
+	}
+
+	if (fp->fptr > 0U) {
+		/* Cluster of the last byte written, as f_write leaves it */
+		fp->clust = fp->obj.sclust + (DWORD)((fp->fptr - 1U) /
+				((FSIZE_t)fs->csize * ss));
+	}
+	if (fp->fptr > fp->obj.objsize) {
+		fp->obj.objsize = fp->fptr;
+	}
+	fp->flag |= (BYTE)FF_STREAM_FA_MODIFIED;
+
+#if FF_FS_REENTRANT
+	ff_rel_grant(fs->sobj);
+#endif
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Create a file for streaming writes, with a contiguous extent of the size
+* given.
+*
+* @param	sp: Pointer to the streaming file object to open.
+* @param	path: Path of the file, as for f_open. An existing file is
+*		replaced.
+* @param	size: Size of the extent in bytes, the expected size of the
+*		recording.
+* @param	syncsize: Number of bytes written between two automatic
+*		f_stream_sync, 0 to sync only on f_stream_sync and
+*		f_stream_close.
+*
+* @return
+*		- FR_OK if the file is open.
+*		- FR_DENIED if the volume has no contiguous free area of the
+*		  size given. The file is removed.
+*		- Any error code of f_open, f_expand or f_sync otherwise.
+*
+* @note		The allocation is recorded in the directory before the
+*		function returns, a recording interrupted by a power loss
+*		leaves a file of the extent size.
+*
+******************************************************************************/
+FRESULT f_stream_open (
+	FSTREAM* sp,
+	const TCHAR* path,
+	FSIZE_t size,
+	FSIZE_t syncsize
+)
+{
+	FIL* fp;
+	FATFS* fs;
+	FRESULT res;
+
+	if ((sp == NULL) || (size == 0U)) {
+		return FR_INVALID_PARAMETER;
+	}
+	fp = &sp->fil;
+
+	res = f_open(fp, path, FA_CREATE_ALWAYS | FA_WRITE);
+	if (res != FR_OK) {
+		return res;
+	}
+
+	res = f_expand(fp, size, 1);
+	if (res == FR_OK) {
+		res = f_sync(fp);
+	}
+	if (res != FR_OK) {
+		(void)f_close(fp);
+		(void)f_unlink(path);
+		return res;
+	}
+
+	fs = fp->obj.fs;
+	sp->sect = fs->database + ((fp->obj.sclust - 2U) * fs->csize);
+	sp->alloc = size;
+	sp->syncsize = syncsize;
+	sp->unsynced = 0U;
+
+	return FR_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Write data at the current position of a streaming file.
+*
+* @param	sp: Pointer to the streaming file object.
+* @param	buff: Pointer to the data to be written.
+* @param	btw: Number of bytes to write.
+* @param	bw: Pointer to the variable receiving the number of bytes
+*		written.
+*
+* @return	FR_OK or any error code of f_write, f_sync or disk_write.
+*
+* @note		Writes of whole sectors at sector aligned positions avoid
+*		the copies through the file buffer, for the best throughput
+*		the buffer should be aligned for the DMA of the SD driver and
+*		btw a multiple of the sector size.
+*
+******************************************************************************/
+FRESULT f_stream_write (
+	FSTREAM* sp,
+	const void* buff,
+	UINT btw,
+	UINT* bw
+)
+{
+	FIL* fp = &sp->fil;
+	const BYTE* wbuff = (const BYTE*)buff;
+	FRESULT res;
+	UINT head;
+	UINT wcnt;
+	DWORD ss;
+	DWORD nsect;
+	DWORD left;
+
+	*bw = 0U;
+	if (fp->obj.fs == NULL) {
+		return FR_INVALID_OBJECT;
+	}
+#if FF_MAX_SS == FF_MIN_SS
+	ss = (DWORD)FF_MAX_SS;
+#else
+	ss = (DWORD)fp->obj.fs->ssize;
+#endif
+
+	/* Up to the next sector boundary through the file buffer */
+	head = (UINT)((ss - (DWORD)(fp->fptr % ss)) % ss);
+	if (head > btw) {
+		head = btw;
+	}
+	if (head != 0U) {
+		res = f_write(fp, wbuff, head, &wcnt);
+		*bw += wcnt;
+		if ((res != FR_OK) || (wcnt != head)) {
+			return res;
+		}
+		wbuff += head;
+		btw -= head;
+	}
+
+	/* Whole sectors inside the extent straight to the disk */
+	nsect = (DWORD)(btw / ss);
+	left = (fp->fptr < sp->alloc) ?
+			(DWORD)((sp->alloc - fp->fptr) / ss) : 0U;
+	if (nsect > left) {
+		nsect = left;
+	}
+	if (nsect > 0U) {
+		res = write_extent(sp, wbuff, nsect);
+		if (res != FR_OK) {
+			return res;
+		}
+		wcnt = (UINT)(nsect * ss);
+		*bw += wcnt;
+		wbuff += wcnt;
+		btw -= wcnt;
+	}
+
+	/* Tail, and anything past the extent */
+	if (btw != 0U) {
+		res = f_write(fp, wbuff, btw, &wcnt);
+		*bw += wcnt;
+		if (res != FR_OK) {
+			return res;
+		}
+	}
+
+	sp->unsynced += *bw;
+	if ((sp->syncsize != 0U) && (sp->unsynced >= sp->syncsize)) {
+		return f_stream_sync(sp);
+	}
+
+	return FR_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Flush the file buffer and the directory entry of a streaming file.
+*
+* @param	sp: Pointer to the streaming file object.
+*
+* @return	FR_OK or any error code of f_sync.
+*
+******************************************************************************/
+FRESULT f_stream_sync (
+	FSTREAM* sp
+)
+{
+	sp->unsynced = 0U;
+
+	return f_sync(&sp->fil);
+}
+
+/*****************************************************************************/
+/**
+*
+* Close a streaming file. The file is truncated at the current position and
+* the clusters of the extent beyond it are freed.
+*
+* @param	sp: Pointer to the streaming file object.
+*
+* @return	FR_OK or any error code of f_truncate or f_close.
+*
+******************************************************************************/
+FRESULT f_stream_close (
+	FSTREAM* sp
+)
+{
+	FRESULT res;
+
+	res = f_truncate(&sp->fil);
+	if (res != FR_OK) {
+		(void)f_close(&sp->fil);
+		return res;
+	}
+
+	return f_close(&sp->fil);
+}
+#endif /* FF_USE_EXPAND && !FF_FS_READONLY */
+#endif /* (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM) */
@@ -204,6 +204,20 @@ typedef struct {
 
 
 
+#if FF_USE_EXPAND && !FF_FS_READONLY
+/* Streaming write file object structure (FSTREAM), see ffstream.c */
+
+typedef struct {
+	FIL		fil;			/* File object */
+	DWORD	sect;			/* First sector of the contiguous extent */
+	FSIZE_t	alloc;			/* Size of the contiguous extent */
+	FSIZE_t	syncsize;		/* Bytes between automatic syncs (0:No automatic sync) */
+	FSIZE_t	unsynced;		/* Bytes written since the last sync */
+} FSTREAM;
+#endif
+
+
+
 /* Directory object structure (DIR) */
 
 typedef struct {
@@ -304,6 +318,16 @@ int f_putc (TCHAR c, FIL* fp);										/* Put a character to the file */
 int f_puts (const TCHAR* str, FIL* cp);								/* Put a string to the file */
 int f_printf (FIL* fp, const TCHAR* str, ...);						/* Put a formatted string to the file */
 TCHAR* f_gets (TCHAR* buff, int len, FIL* fp);						/* Get a string from the file */
+#if FF_USE_FASTSEEK
+FRESULT f_open_fastseek (FIL* fp, const TCHAR* path, BYTE mode, DWORD* tbl, UINT len);	/* Open a file in fast seek mode */
+#endif
+FRESULT f_read_at (FIL* fp, FSIZE_t ofs, void* buff, UINT btr, UINT* br);	/* Read data from a file offset */
+#if FF_USE_EXPAND && !FF_FS_READONLY
+FRESULT f_stream_open (FSTREAM* sp, const TCHAR* path, FSIZE_t size, FSIZE_t syncsize);	/* Create a file with a contiguous extent for streaming writes */
+FRESULT f_stream_write (FSTREAM* sp, const void* buff, UINT btw, UINT* bw);	/* Append data to a streaming file */
+FRESULT f_stream_sync (FSTREAM* sp);								/* Flush the cached information of a streaming file */
+FRESULT f_stream_close (FSTREAM* sp);								/* Truncate the unused extent and close a streaming file */
+#endif
 
 #define f_eof(fp) ((int)((fp)->fptr == (fp)->obj.objsize))
 #define f_error(fp) ((fp)->err)
@@ -367,6 +391,9 @@ int ff_del_syncobj (FF_SYNC_t sobj);	/* Delete a sync object */
 /* Fast seek controls (2nd argument of f_lseek) */
 #define CREATE_LINKMAP	((FSIZE_t)0 - 1)
 
+/* Number of CLMT items needed for a file of nfrag fragments */
+#define FF_CLMT_ITEMS(nfrag)	((UINT)(nfrag) * 2U + 2U)
+
 /* Format options (2nd argument of f_mkfs) */
 #define FM_FAT		0x01
 #define FM_FAT32	0x02
@@ -62,11 +62,19 @@ extern "C" {
 /* This option switches f_mkfs() function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_FASTSEEK	0
+#ifdef FILE_SYSTEM_USE_FASTSEEK
+#define FF_USE_FASTSEEK	1	/* 1:Enable */
+#else
+#define FF_USE_FASTSEEK	0	/* 0:Disable */
+#endif
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_EXPAND	0
+#ifdef FILE_SYSTEM_USE_EXPAND
+#define FF_USE_EXPAND	1	/* 1:Enable */
+#else
+#define FF_USE_EXPAND	0	/* 0:Disable */
+#endif
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
 
@@ -249,7 +257,11 @@ extern "C" {
 
 
 #define FF_MIN_SS		512
+#ifdef FILE_SYSTEM_MAX_SS
+#define FF_MAX_SS		FILE_SYSTEM_MAX_SS
+#else
 #define FF_MAX_SS		512
+#endif
 /* This set of options configures the range of sector size to be supported. (512,
 /  1024, 2048 or 4096) Always set both 512 for most systems, generic memory card and
 /  harddisk. But a larger value may be required for on-board flash memory and some
@@ -324,9 +336,17 @@ extern "C" {
 /      lock control is independent of re-entrancy. */
 
 
-#define FF_FS_REENTRANT	0
+#ifdef FILE_SYSTEM_FS_REENTRANT
+#include "FreeRTOS.h"
+#include "semphr.h"
+#define FF_FS_REENTRANT	1	/* 1:Enable, one FreeRTOS mutex per volume */
+#define FF_FS_TIMEOUT	pdMS_TO_TICKS(FILE_SYSTEM_FS_TIMEOUT)
+#define FF_SYNC_t		SemaphoreHandle_t
+#else
+#define FF_FS_REENTRANT	0	/* 0:Disable */
 #define FF_FS_TIMEOUT	1000
 #define FF_SYNC_t		HANDLE
+#endif
 /* The option FF_FS_REENTRANT switches the re-entrancy (thread safe) of the FatFs
 /  module itself. Note that regardless of this option, file access to different
 /  volume is always re-entrant and volume control functions, f_mount(), f_mkfs()
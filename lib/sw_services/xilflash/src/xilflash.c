@@ -59,6 +59,8 @@
 *		      CR 662317 Description - Xilinx Platform Flash on ML605
 *		      fails to work.
 * 4.4   ms   08/03/17 Added tags and modified comment lines style for doxygen.
+* 4.8   adk  10/15/19 Added XFlash_ReadBurst() used by the family read
+*		      functions to copy the array with aligned word accesses.
 * </pre>
 *
 *
@@ -621,6 +623,66 @@ int XFlashGeometry_ToBlock(XFlashGeometry * InstancePtr,
 	return (XST_SUCCESS);
 }
 
+/*****************************************************************************/
+/**
+*
+* Copies data from the flash array in read mode to a RAM buffer. The bulk of
+* the copy is done with aligned 32-bit reads at incrementing addresses, so
+* that the memory controller turns them into back to back page mode/burst
+* accesses of the flash instead of one access per byte.
+*
+* @param	DestPtr is the destination buffer. It does not need to be
+*		aligned.
+* @param	SrcAddr is the address of the data in the flash array.
+* @param	Bytes is the number of bytes to copy.
+*
+* @return	None.
+*
+* @note		The flash bank(s) must be in read array mode.
+*
+******************************************************************************/
+void XFlash_ReadBurst(void *DestPtr, u32 SrcAddr, u32 Bytes)
+{
+	u8 *Dest8BitPtr = (u8 *)DestPtr;
+	u32 Data;
+
+	/*
+	 * Read the leading bytes up to a word boundary of the flash.
+	 */
+	while ((Bytes != 0) && ((SrcAddr & 3) != 0)) {
+		*Dest8BitPtr++ = READ_FLASH_8(SrcAddr);
+		SrcAddr++;
+		Bytes--;
+	}
+
+	if (((UINTPTR)Dest8BitPtr & 3) == 0) {
+		while (Bytes >= 4) {
+			*(u32 *)Dest8BitPtr = READ_FLASH_32(SrcAddr);
+			Dest8BitPtr += 4;
+			SrcAddr += 4;
+			Bytes -= 4;
+		}
+	} else {
+		/*
+		 * The destination is not aligned, keep the flash accesses
+		 * aligned and split the stores.
+		 */
+		while (Bytes >= 4) {
+			Data = READ_FLASH_32(SrcAddr);
+			memcpy(Dest8BitPtr, &Data, 4);
+			Dest8BitPtr += 4;
+			SrcAddr += 4;
+			Bytes -= 4;
+		}
+	}
+
+	while (Bytes != 0) {
+		*Dest8BitPtr++ = READ_FLASH_8(SrcAddr);
+		SrcAddr++;
+		Bytes--;
+	}
+}
+
 /*****************************************************************************/
 /**
 *
@@ -77,6 +77,10 @@
 * 4.7	akm  07/10/19 Updated XFlashAmd_Write() to use adjusted base address
 *		      in write operation(CR-1029074).
 * 4.7	akm  07/23/19 Initialized Status variable to XST_FAILURE.
+* 4.8	adk  10/15/19 Use write buffer programming on every 16-bit part which
+*		      reports a write buffer in its CFI table, splitting the
+*		      data at write buffer boundaries. Read the array with
+*		      XFlash_ReadBurst().
 * </pre>
 *
 ******************************************************************************/
@@ -195,6 +199,7 @@ static int WriteBufferAmd(XFlash * InstancePtr, void *DestPtr,
 static int WriteBufferSpansion(XFlash * InstancePtr, void *DestPtr,
                          void *SrcPtr, u32 Bytes);
 void AmdDevice_is_Ready(XFlash * InstancePtr);
+extern void XFlash_ReadBurst(void *DestPtr, u32 SrcAddr, u32 Bytes);
 
 /************************** Variable Definitions *****************************/
 
@@ -457,12 +462,7 @@ int XFlashAmd_Initialize(XFlash * InstancePtr)
 ******************************************************************************/
 int XFlashAmd_Read(XFlash *InstancePtr, u32 Offset, u32 Bytes, void *DestPtr)
 {
-	u8 *Dest8BitPtr;
-	u8 *Src8BitPtr;
-	u16 *Dest16BitPtr;
-	u16 *Src16BitPtr;
 	u32  PartMode;
-	u32 Index;
 	u32 Startoffset;
 	u32 EndOffset;
 	XFlashGeometry *GeomPtr;
@@ -519,13 +519,7 @@ int XFlashAmd_Read(XFlash *InstancePtr, u32 Offset, u32 Bytes, void *DestPtr)
 		/*
 		 * Perform copy to the user buffer from the buffer.
 		 */
-		Src8BitPtr = (u8*) (((volatile u8*)InstancePtr->Geometry.
-				     BaseAddress) + Offset);
-		Dest8BitPtr = (u8*) DestPtr;
-
-		for (Index = 0; Index < Bytes; Index++) {
-			Dest8BitPtr[Index] = Src8BitPtr[Index];
-		}
+		XFlash_ReadBurst(DestPtr, GeomPtr->BaseAddress + Offset, Bytes);
 
 	}
 	else if (PartMode == XFL_LAYOUT_PART_MODE_16) {
@@ -537,12 +531,9 @@ int XFlashAmd_Read(XFlash *InstancePtr, u32 Offset, u32 Bytes, void *DestPtr)
 		DevDataPtr->SendCmd(GeomPtr->BaseAddress,XFL_AMD_CMD1_ADDR,
 						XFL_AMD_CMD_STATUS_REG_CLEAR);
 		/* Perform copy to the user buffer from the buffer. */
-		Src16BitPtr = (u16*) (((volatile u16*) InstancePtr->Geometry.
-				       BaseAddress) + Startoffset);
-		Dest16BitPtr = (u16*) DestPtr;
-		for (Index = 0; Index < (Bytes/2); Index++) {
-			Dest16BitPtr[Index] = Src16BitPtr[Index];
-		}
+		XFlash_ReadBurst(DestPtr,
+				GeomPtr->BaseAddress + (Startoffset << 1),
+				Bytes & ~1U);
 	} else {
 		return (XFLASH_PART_NOT_SUPPORTED);
 	}
@@ -1628,7 +1619,11 @@ static int WriteBuffer16(XFlash * InstancePtr, void *DestPtr,
 		return (XFLASH_ALIGNMENT_ERROR);
 	}
 
-	if (InstancePtr->Properties.PartID.ManufacturerID == 0x01)
+	/*
+	 * Parts which report a write buffer in the CFI table are programmed
+	 * one buffer at a time, the others one word at a time.
+	 */
+	if (InstancePtr->Properties.ProgCap.WriteBufferSize != 0)
 		Status = WriteBufferSpansion(InstancePtr,DestPtr,SrcPtr,Bytes);
 	else
 		Status = WriteBufferAmd(InstancePtr,DestPtr,SrcPtr,Bytes);
@@ -1640,9 +1635,9 @@ static int WriteBuffer16(XFlash * InstancePtr, void *DestPtr,
 /*****************************************************************************/
 /**
 *
-* This function is used to program Spansion devices. It does not erase
-* the flash first and will fail if the block(s) are not erased first. The
-* device(s) are programmed in parallel.
+* This function is used to program devices through their write buffer. It
+* does not erase the flash first and will fail if the block(s) are not erased
+* first. The device(s) are programmed in parallel.
 *
 * @param	InstancePtr is the instance to work on.
 * @param	DestPtr is the physical destination address in flash memory
@@ -1655,7 +1650,8 @@ static int WriteBuffer16(XFlash * InstancePtr, void *DestPtr,
 *		- XFLASH_ERROR if a write error occurred. This error is
 *		  usually device specific.
 *
-* @note		None.
+* @note		A write buffer program must not cross a write buffer
+*		boundary, so the first and last buffers may be partial.
 *
 ******************************************************************************/
 static int WriteBufferSpansion(XFlash * InstancePtr, void *DestPtr,
@@ -1668,28 +1664,27 @@ static int WriteBufferSpansion(XFlash * InstancePtr, void *DestPtr,
        int Status = (int)XST_FAILURE;
        XFlashVendorData_Amd *DevDataPtr = GET_PARTDATA(InstancePtr);
        u32 BufferSize = InstancePtr->Properties.ProgCap.WriteBufferSize;
+       u32 Count;
 
 	while (Bytes != 0)
 	{
-		/* Bytes to write should not exceed the buffer size. */
-		if (Bytes > BufferSize)
+		/* Stop at the end of the current write buffer. */
+		Count = BufferSize - ((u32)DestPtr &
+			InstancePtr->Properties.ProgCap.WriteBufferAlignmentMask);
+		if (Count > Bytes)
 		{
-			Status = WriteSingleBuffer(InstancePtr, DestPtr,
-						Tempsrcptr, BufferSize);
-			Bytes = Bytes - BufferSize;
-			DestPtr = DestPtr + BufferSize;
-			Tempsrcptr = Tempsrcptr + BufferSize/2;
-		}
-		else
-		{
-			Status = WriteSingleBuffer(InstancePtr, DestPtr,
-						Tempsrcptr, Bytes);
-			Bytes = 0;
+			Count = Bytes;
 		}
+
+		Status = WriteSingleBuffer(InstancePtr, DestPtr,
+					Tempsrcptr, Count);
 		if (Status != XST_SUCCESS)
 		{
 			return Status;
 		}
+		Bytes = Bytes - Count;
+		DestPtr = DestPtr + Count;
+		Tempsrcptr = Tempsrcptr + Count/2;
 	}
 	return Status;
 }
@@ -92,6 +92,8 @@
 *		      with AXI interface.
 * 4.1	nsk  08/06/15 Fixed CR 835008.
 * 4.7	akm  07/23/19 Initialized Status variable to XST_FAILURE.
+* 4.8	adk  10/15/19 Read the array with XFlash_ReadBurst() and added
+*		      erase suspend/resume through XFlash_DeviceControl().
 * </pre>
 *
 ******************************************************************************/
@@ -131,6 +133,8 @@ typedef struct XFlashVendorData_IntelTag {
 					   allowed) */
 	StatReg SR_WsmReady; /* Status register bitmask for WSM ready */
 	StatReg SR_LastError; /* Status register bitmask for error condition */
+	u32 EraseSuspended;	/* An erase is suspended, the bank is left in
+				   read array mode */
 
 	/*
 	 * The following functions are specific to the width of the data bus and
@@ -206,6 +210,8 @@ static void GetPartID(XFlash *InstancePtr);
 static int XFlashIntel_ResetBank(XFlash *InstancePtr, u32 Offset, u32 Bytes);
 static u16 EnqueueEraseBlocks(XFlash *InstancePtr, u16 *RegionPtr,
 				u16 *BlockPtr, u16 MaxBlocks);
+static int EraseSuspend(XFlash *InstancePtr, u32 Offset);
+static int EraseResume(XFlash *InstancePtr, u32 Offset);
 
 extern int XFlashGeometry_ToBlock(XFlashGeometry *InstancePtr,
 				u32 AbsoluteOffset,
@@ -214,6 +220,7 @@ extern int XFlashGeometry_ToAbsolute(XFlashGeometry *InstancePtr,
 				u16 Region,
 				u16 Block,
 				u32 BlockOffset, u32 *AbsoluteOffsetPtr);
+extern void XFlash_ReadBurst(void *DestPtr, u32 SrcAddr, u32 Bytes);
 
 /************************** Variable Definitions *****************************/
 
@@ -256,6 +263,7 @@ int XFlashIntel_Initialize(XFlash *InstancePtr)
 	 */
 	Layout = InstancePtr->Geometry.MemoryLayout;
 	DevDataPtr = GET_PARTDATA(InstancePtr);
+	DevDataPtr->EraseSuspended = 0;
 
 	/*
 	 * Setup alignment of the write buffer.
@@ -372,6 +380,8 @@ int XFlashIntel_Initialize(XFlash *InstancePtr)
 ******************************************************************************/
 int XFlashIntel_Read(XFlash *InstancePtr, u32 Offset, u32 Bytes, void *DestPtr)
 {
+	XFlashVendorData_Intel *DevDataPtr;
+
 	/*
 	 * Verify inputs are valid.
 	 */
@@ -391,17 +401,21 @@ int XFlashIntel_Read(XFlash *InstancePtr, u32 Offset, u32 Bytes, void *DestPtr)
 	}
 
 	/*
-	 * Reset the bank(s) so that it returns to the read mode.
+	 * Reset the bank(s) so that it returns to the read mode. While an
+	 * erase is suspended the bank is already in read array mode and the
+	 * status register must be left alone.
 	 */
-	if (XFlashIntel_ResetBank(InstancePtr, Offset, Bytes)!= XST_SUCCESS) {
+	DevDataPtr = GET_PARTDATA(InstancePtr);
+	if ((DevDataPtr->EraseSuspended == 0) &&
+	    (XFlashIntel_ResetBank(InstancePtr, Offset, Bytes)!= XST_SUCCESS)) {
 		return (XST_FAILURE);
 	}
 
 	/*
-	 * Perform copy to the user buffer from the buffer.
+	 * Perform copy to the user buffer from the flash array.
 	 */
-	memcpy(DestPtr,	(void *) (InstancePtr->Geometry.BaseAddress + Offset),
-									Bytes);
+	XFlash_ReadBurst(DestPtr, InstancePtr->Geometry.BaseAddress + Offset,
+								Bytes);
 
 	return (XST_SUCCESS);
 }
@@ -1080,11 +1094,95 @@ int XFlashIntel_DeviceControl(XFlash *InstancePtr, u32 Command,
 
 			return (XFLASH_NOT_SUPPORTED);
 
+		case XFL_DEVCTL_ERASE_SUSPEND:
+			return (EraseSuspend(InstancePtr,
+					*((u32 *)Parameters)));
+
+		case XFL_DEVCTL_ERASE_RESUME:
+			return (EraseResume(InstancePtr,
+					*((u32 *)Parameters)));
+
 		default:
 			return (XFLASH_NOT_SUPPORTED);
 	}
 }
 
+/*****************************************************************************/
+/**
+*
+* Suspends the erase in progress on a bank of the Intel flash device and
+* places the bank in read array mode, so that XFlash_Read() can be used until
+* the erase is resumed.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an address inside the bank being erased.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XFLASH_ADDRESS_ERROR if Offset is not within the device.
+*
+* @note		The library erase is blocking, so this is meant to be used
+*		from an interrupt handler or from another thread. The erase
+*		is complete, rather than suspended, if the erase suspended
+*		bit is not set in the status read back.
+*
+******************************************************************************/
+static int EraseSuspend(XFlash *InstancePtr, u32 Offset)
+{
+	XFlashVendorData_Intel *DevDataPtr = GET_PARTDATA(InstancePtr);
+	u32 BaseAddress = InstancePtr->Geometry.BaseAddress;
+
+	if (!XFL_GEOMETRY_IS_ABSOLUTE_VALID(&InstancePtr->Geometry, Offset)) {
+		return (XFLASH_ADDRESS_ERROR);
+	}
+
+	/*
+	 * Suspend, then wait for the WSM to stop.
+	 */
+	DevDataPtr->SendCmd(BaseAddress, Offset, XFL_INTEL_CMD_SUSPEND);
+	DevDataPtr->SendCmd(BaseAddress, Offset,
+				XFL_INTEL_CMD_READ_STATUS_REG);
+	while (DevDataPtr->GetStatus(InstancePtr, Offset) == XFLASH_BUSY) {
+		;
+	}
+
+	DevDataPtr->SendCmd(BaseAddress, Offset, XFL_INTEL_CMD_READ_ARRAY);
+	DevDataPtr->EraseSuspended = 1;
+
+	return (XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* Resumes an erase suspended by EraseSuspend().
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an address inside the bank being erased.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XFLASH_ADDRESS_ERROR if Offset is not within the device.
+*
+* @note		The bank is left in read status register mode, which is what
+*		the interrupted erase polls.
+*
+******************************************************************************/
+static int EraseResume(XFlash *InstancePtr, u32 Offset)
+{
+	XFlashVendorData_Intel *DevDataPtr = GET_PARTDATA(InstancePtr);
+
+	if (!XFL_GEOMETRY_IS_ABSOLUTE_VALID(&InstancePtr->Geometry, Offset)) {
+		return (XFLASH_ADDRESS_ERROR);
+	}
+
+	DevDataPtr->EraseSuspended = 0;
+	DevDataPtr->SendCmd(InstancePtr->Geometry.BaseAddress, Offset,
+				XFL_INTEL_CMD_RESUME);
+
+	return (XST_SUCCESS);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -0,0 +1,366 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+ *
+ *****************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xilfpga_versal.c
+ *
+ * This file contains the versal PL load interface. The PDI loads are
+ * requested from the PLM loader module over IPI.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date        Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 5.2   adk  15/10/19 Initial release
+ * </pre>
+ *
+ * @note
+ *
+ ******************************************************************************/
+/***************************** Include Files *********************************/
+#include "xilfpga.h"
+
+/************************** Constant Definitions *****************************/
+#define XFPGA_PLM_RESP_LEN		(4U)
+#define XFPGA_PLM_ASYNC_MSG_LEN		(4U)
+#define XFPGA_PLM_ASYNC_MSG_ID		((XFPGA_PLM_LOADER_ID << 8U) | \
+					 XFPGA_PLM_LOAD_IMAGE_CMD_ID)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static u32 XFpga_PreConfigVersal(XFpga *InstancePtr);
+static u32 XFpga_WriteToPlVersal(XFpga *InstancePtr);
+static u32 XFpga_PostConfigVersal(XFpga *InstancePtr);
+static u32 XFpga_PlmRequest(XFpga *InstancePtr, u32 *Payload, u32 Len,
+			    u32 *Response);
+static void XFpga_PlmRecvHandler(void *CallBackRef);
+
+/************************** Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+ * This API, when called, initializes the XFPGA interface with default
+ * settings and the IPI channel to the PLM.
+ *
+ * @param InstancePtr Pointer to the XFpga structure.
+ *
+ * @return Returns Status
+ *		- XFPGA_SUCCESS on success
+ *		- Error code on failure
+ *
+ * @note The completion messages of the asynchronous loads are received by
+ *	 the mailbox receive handler of the XPAR_XIPIPSU_0_DEVICE_ID channel,
+ *	 which must not be claimed by another library.
+ *****************************************************************************/
+u32 XFpga_Initialize(XFpga *InstancePtr)
+{
+	u32 Status = XFPGA_FAILURE;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	(void)memset(InstancePtr, 0, sizeof(*InstancePtr));
+	InstancePtr->XFpga_PreConfig = XFpga_PreConfigVersal;
+	InstancePtr->XFpga_WriteToPl = XFpga_WriteToPlVersal;
+	InstancePtr->XFpga_PostConfig = XFpga_PostConfigVersal;
+
+	Status = XMailbox_Initialize(&InstancePtr->PLInfo.Mailbox,
+				     XPAR_XIPIPSU_0_DEVICE_ID);
+	if (Status != (u32)XST_SUCCESS) {
+		Status = XFPGA_VERSAL_UPDATE_ERR(XFPGA_ERROR_IPI_FAIL, Status);
+		goto END;
+	}
+
+	if (XMailbox_SetCallBack(&InstancePtr->PLInfo.Mailbox,
+				 XMAILBOX_RECV_HANDLER,
+				 (void *)XFpga_PlmRecvHandler,
+				 InstancePtr) != XST_SUCCESS) {
+		Status = XFPGA_VERSAL_UPDATE_ERR(XFPGA_ERROR_IPI_FAIL, 0U);
+		goto END;
+	}
+
+	Status = XFPGA_SUCCESS;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/* This function checks that no asynchronous load is pending.
+ *
+ * @param InstancePtr Pointer to the XFpga structure.
+ *
+ * @return	XFPGA_SUCCESS, or XFPGA_ERROR_LOAD_PENDING
+ *
+ *****************************************************************************/
+static u32 XFpga_PreConfigVersal(XFpga *InstancePtr)
+{
+	u32 Status = XFPGA_SUCCESS;
+
+	if (InstancePtr->PLInfo.Handle != 0U) {
+		Status = XFPGA_VERSAL_UPDATE_ERR(XFPGA_ERROR_LOAD_PENDING, 0U);
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/* This function requests the PLM to load the PDI staged in DDR at
+ * WriteInfo.BitstreamAddr, and waits for the load to complete.
+ *
+ * @param InstancePtr Pointer to the XFpga structure.
+ *
+ * @return	XFPGA_SUCCESS, or an error code with the PLM status
+ *
+ *****************************************************************************/
+static u32 XFpga_WriteToPlVersal(XFpga *InstancePtr)
+{
+	u32 Status = XFPGA_FAILURE;
+	u64 PdiAddr = (u64)InstancePtr->WriteInfo.BitstreamAddr;
+	u32 Payload[4U];
+	u32 Response[XFPGA_PLM_RESP_LEN] = {0U};
+
+	Payload[0U] = XFPGA_PLM_HEADER(3U, XFPGA_PLM_LOAD_PDI_CMD_ID);
+	Payload[1U] = XFPGA_PLM_PDI_SRC_DDR;
+	Payload[2U] = (u32)(PdiAddr >> 32U);
+	Payload[3U] = (u32)PdiAddr;
+
+	Status = XFpga_PlmRequest(InstancePtr, Payload, 4U, Response);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/* The PLM starts the PL itself at the end of a PDI load, there is nothing
+ * left to do.
+ *
+ * @param InstancePtr Pointer to the XFpga structure.
+ *
+ * @return	XFPGA_SUCCESS
+ *
+ *****************************************************************************/
+static u32 XFpga_PostConfigVersal(XFpga *InstancePtr)
+{
+	(void)InstancePtr;
+
+	return XFPGA_SUCCESS;
+}
+
+/*****************************************************************************/
+/* This function sends a loader command to the PLM and reads its response.
+ * The send blocks until the PLM has executed the command.
+ *
+ * @param InstancePtr Pointer to the XFpga structure.
+ * @param Payload Command, header included
+ * @param Len Number of words in Payload
+ * @param Response Buffer of XFPGA_PLM_RESP_LEN words for the response
+ *
+ * @return	XFPGA_SUCCESS, or an error code with the PLM status
+ *
+ *****************************************************************************/
+static u32 XFpga_PlmRequest(XFpga *InstancePtr, u32 *Payload, u32 Len,
+			    u32 *Response)
+{
+	u32 Status = XFPGA_FAILURE;
+	XMailbox *MailboxPtr = &InstancePtr->PLInfo.Mailbox;
+
+	Status = XMailbox_SendData(MailboxPtr, XFPGA_PLM_IPI_TARGET, Payload,
+				   Len, XILMBOX_MSG_TYPE_REQ, 1U);
+	if (Status != (u32)XST_SUCCESS) {
+		Status = XFPGA_VERSAL_UPDATE_ERR(XFPGA_ERROR_IPI_FAIL, 0U);
+		goto END;
+	}
+
+	Status = XMailbox_Recv(MailboxPtr, XFPGA_PLM_IPI_TARGET, Response,
+			       XFPGA_PLM_RESP_LEN, XILMBOX_MSG_TYPE_RESP);
+	if (Status != (u32)XST_SUCCESS) {
+		Status = XFPGA_VERSAL_UPDATE_ERR(XFPGA_ERROR_IPI_FAIL, 0U);
+		goto END;
+	}
+
+	InstancePtr->PLInfo.PlmStatus = Response[0U];
+	if (Response[0U] != 0U) {
+		Status = XFPGA_VERSAL_UPDATE_ERR(XFPGA_ERROR_PLM_LOAD_FAIL,
+						 Response[0U]);
+	} else {
+		Status = XFPGA_SUCCESS;
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/* This is the mailbox receive handler. It reads the completion message of
+ * an asynchronous load and calls the load done callback.
+ *
+ * @param CallBackRef Pointer to the XFpga structure.
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XFpga_PlmRecvHandler(void *CallBackRef)
+{
+	XFpga *InstancePtr = (XFpga *)CallBackRef;
+	u32 Msg[XFPGA_PLM_ASYNC_MSG_LEN] = {0U};
+	u32 Status;
+
+	Status = XMailbox_Recv(&InstancePtr->PLInfo.Mailbox,
+			       XFPGA_PLM_IPI_TARGET, Msg,
+			       XFPGA_PLM_ASYNC_MSG_LEN, XILMBOX_MSG_TYPE_REQ);
+	if ((Status != (u32)XST_SUCCESS) ||
+	    (Msg[0U] != XFPGA_PLM_ASYNC_MSG_ID) ||
+	    (Msg[1U] != InstancePtr->PLInfo.Handle)) {
+		goto END;
+	}
+
+	InstancePtr->PLInfo.PlmStatus = Msg[3U];
+	InstancePtr->PLInfo.Handle = 0U;
+	if (InstancePtr->PLInfo.LoadDoneHandler != NULL) {
+		InstancePtr->PLInfo.LoadDoneHandler(
+				InstancePtr->PLInfo.LoadDoneRef, Msg[1U],
+				Msg[3U]);
+	}
+
+END:
+	return;
+}
+
+/*****************************************************************************/
+/**The API requests the PLM to load the PDI staged in DDR and returns as
+ * soon as the PLM has queued the load. The completion is reported by the
+ * Handler callback, from the IPI interrupt, and the progress can be read
+ * with XFpga_PL_LoadStatus(). Only one load can be pending at a time.
+ *
+ *@param InstancePtr Pointer to the XFgpa structure.
+ *
+ *@param PdiAddr DDR address of the staged PDI.
+ *
+ *@param Handler Load done callback, can be NULL when the load is polled.
+ *		It is given the handle and the PLM load status, 0 on success.
+ *
+ *@param CallBackRef Reference passed to Handler.
+ *
+ *@param HandlePtr Updated with the handle of the load.
+ *
+ *@return
+ *	- XFPGA_SUCCESS when the load is queued
+ *	- XFPGA_PRE_CONFIG_ERROR if a load is already pending
+ *	- XFPGA_WRITE_BITSTREAM_ERROR if the PLM refused the load
+ *
+ *****************************************************************************/
+u32 XFpga_PL_BitStream_LoadAsync(XFpga *InstancePtr, UINTPTR PdiAddr,
+				 XFpga_LoadDoneHandler Handler,
+				 void *CallBackRef, u32 *HandlePtr)
+{
+	u32 Status = XFPGA_FAILURE;
+	XMailbox *MailboxPtr;
+	u32 Payload[6U];
+	u32 Response[XFPGA_PLM_RESP_LEN] = {0U};
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(HandlePtr != NULL);
+
+	MailboxPtr = &InstancePtr->PLInfo.Mailbox;
+
+	Status = XFpga_PL_Preconfig(InstancePtr);
+	if (Status != XFPGA_SUCCESS) {
+		goto END;
+	}
+
+	Payload[0U] = XFPGA_PLM_HEADER(5U, XFPGA_PLM_LOAD_IMAGE_CMD_ID);
+	Payload[1U] = XFPGA_PLM_PDI_SRC_DDR;
+	Payload[2U] = (u32)((u64)PdiAddr >> 32U);
+	Payload[3U] = (u32)PdiAddr;
+	Payload[4U] = XFPGA_PLM_ALL_IMAGES;
+	Payload[5U] = XFPGA_PLM_LOAD_FLAG_ASYNC;
+
+	InstancePtr->PLInfo.LoadDoneHandler = Handler;
+	InstancePtr->PLInfo.LoadDoneRef = CallBackRef;
+
+	/*
+	 * Hold the completion message until the handle is known, the PLM can
+	 * finish a small load before the response is read.
+	 */
+	MailboxPtr->XMbox_IPI_IntrCtrl(MailboxPtr, 0U);
+	Status = XFpga_PlmRequest(InstancePtr, Payload, 6U, Response);
+	if (Status == XFPGA_SUCCESS) {
+		InstancePtr->PLInfo.Handle = Response[1U];
+		*HandlePtr = Response[1U];
+	} else {
+		Status = XFPGA_UPDATE_ERR(XFPGA_WRITE_BITSTREAM_ERROR, Status);
+	}
+	MailboxPtr->XMbox_IPI_IntrCtrl(MailboxPtr, 1U);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**The API reads the progress of an asynchronous load from the PLM.
+ *
+ *@param InstancePtr Pointer to the XFgpa structure.
+ *
+ *@param Handle Handle returned by XFpga_PL_BitStream_LoadAsync().
+ *
+ *@param ProgressPtr Updated with the load progress.
+ *
+ *@return
+ *	- XFPGA_SUCCESS on success
+ *	- Error code on failure, e.g. the handle is not the last load.
+ *
+ *@note The PLM runs a load to completion before it serves other requests,
+ *	so a started load reads as queued or done.
+ *
+ *****************************************************************************/
+u32 XFpga_PL_LoadStatus(XFpga *InstancePtr, u32 Handle,
+			XFpga_LoadProgress *ProgressPtr)
+{
+	u32 Status = XFPGA_FAILURE;
+	u32 Payload[2U];
+	u32 Response[XFPGA_PLM_RESP_LEN] = {0U};
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(ProgressPtr != NULL);
+
+	Payload[0U] = XFPGA_PLM_HEADER(1U, XFPGA_PLM_LOAD_STATUS_CMD_ID);
+	Payload[1U] = Handle;
+
+	Status = XFpga_PlmRequest(InstancePtr, Payload, 2U, Response);
+	if (Status == XFPGA_SUCCESS) {
+		ProgressPtr->State = Response[1U];
+		ProgressPtr->ImagesDone = Response[2U] >> 16U;
+		ProgressPtr->NoOfImgs = Response[2U] & 0xFFFFU;
+		ProgressPtr->Status = Response[3U];
+	}
+
+	return Status;
+}
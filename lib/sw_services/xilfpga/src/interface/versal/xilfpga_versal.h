@@ -0,0 +1,180 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+ *
+ *****************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xilfpga_versal.h
+ * @addtogroup xfpga_apis XilFPGA APIs
+ * @{
+ *
+ * On versal the PL is configured by the PLM from the CDOs of a PDI. This
+ * interface requests the PDI loads from the PLM over IPI, by using the
+ * xilmailbox library.
+ *
+ * - Supported Features:
+ *    - Loading of a PDI staged in DDR, blocking.
+ *    - Loading of a PDI staged in DDR, asynchronous with a completion
+ *      callback and a progress query.
+ *
+ * @{
+ * @cond xilfpga_internal
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date        Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 5.2   adk  15/10/19 Initial release
+ * </pre>
+ *
+ * @note
+ *
+ ******************************************************************************/
+
+#ifndef XILFPGA_VERSAL_H
+#define XILFPGA_VERSAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xilmailbox.h"
+
+/************************** Constant Definitions *****************************/
+/* PLM loader module commands */
+#define XFPGA_PLM_LOADER_ID		(7U)
+#define XFPGA_PLM_LOAD_PDI_CMD_ID	(1U)
+#define XFPGA_PLM_LOAD_IMAGE_CMD_ID	(4U)
+#define XFPGA_PLM_LOAD_STATUS_CMD_ID	(5U)
+#define XFPGA_PLM_HEADER(Len, CmdId)	(((u32)(Len) << 16U) | \
+					 (XFPGA_PLM_LOADER_ID << 8U) | (CmdId))
+
+#define XFPGA_PLM_PDI_SRC_DDR		(0xFU)
+#define XFPGA_PLM_ALL_IMAGES		(0xFFFFFFFFU)
+#define XFPGA_PLM_LOAD_FLAG_ASYNC	(0x1U)
+#define XFPGA_PLM_IPI_TARGET		XPAR_XIPIPS_TARGET_PSV_PMC_0_CH0_MASK
+
+/* States reported by XFpga_PL_LoadStatus() */
+#define XFPGA_LOAD_STATE_IDLE		(0x0U)
+#define XFPGA_LOAD_STATE_QUEUED		(0x1U)
+#define XFPGA_LOAD_STATE_RUNNING	(0x2U)
+#define XFPGA_LOAD_STATE_DONE		(0x3U)
+
+/* Versal interface errors */
+#define XFPGA_ERROR_IPI_FAIL		(0x1U)
+#define XFPGA_ERROR_PLM_LOAD_FAIL	(0x2U)
+#define XFPGA_ERROR_LOAD_PENDING	(0x3U)
+
+#define XFPGA_VERSAL_ERR_MASK		(0xFF00U)
+#define XFPGA_ERR_MODULE_MASK		(0xFFFF0000U)
+#define XFPGA_VERSAL_UPDATE_ERR(XfpgaVersalErr, PlmErr)		\
+		((((u32)(PlmErr) << (u32)16U) & XFPGA_ERR_MODULE_MASK) + \
+		(((XfpgaVersalErr) << (u32)8U) & XFPGA_VERSAL_ERR_MASK))
+
+/**************************** Type Definitions *******************************/
+/**
+ * Callback of an asynchronous PDI load, invoked from the IPI interrupt.
+ *
+ * @CallBackRef	Reference given to XFpga_PL_BitStream_LoadAsync()
+ * @Handle	Handle of the completed load
+ * @Status	XFPGA_SUCCESS, or the PLM load status
+ */
+typedef void (*XFpga_LoadDoneHandler)(void *CallBackRef, u32 Handle,
+				      u32 Status);
+
+/**
+ * Progress of an asynchronous PDI load.
+ *
+ * @State	XFPGA_LOAD_STATE_*
+ * @ImagesDone	Number of PDI images the PLM has processed
+ * @NoOfImgs	Number of images in the PDI
+ * @Status	PLM load status once done
+ */
+typedef struct {
+	u32 State;
+	u32 ImagesDone;
+	u32 NoOfImgs;
+	u32 Status;
+} XFpga_LoadProgress;
+
+/**
+ * Structure to store the PL load details.
+ *
+ * @Mailbox		IPI channel to the PLM
+ * @LoadDoneHandler	Callback of the pending asynchronous load
+ * @LoadDoneRef		Reference passed to LoadDoneHandler
+ * @Handle		Handle of the pending asynchronous load, 0 if none
+ * @PlmStatus		Status returned by the PLM for the last request
+ */
+typedef struct {
+	XMailbox Mailbox;
+	XFpga_LoadDoneHandler LoadDoneHandler;
+	void *LoadDoneRef;
+	volatile u32 Handle;
+	u32 PlmStatus;
+} XFpga_Info;
+
+/**
+ * Structure to store the PL Write Image details.
+ *
+ * @BitstreamAddr	PDI base address in DDR.
+ * @AddrPtr_Size	Unused on versal.
+ * @Flags		Unused on versal.
+ */
+typedef struct {
+		UINTPTR BitstreamAddr;
+		UINTPTR	AddrPtr_Size;
+		u32 Flags;
+}XFpga_Write;
+
+/**
+ * Structure to store the PL Image details. Readback is not supported on
+ * versal by this interface.
+ */
+typedef struct {
+		UINTPTR ReadbackAddr;
+		u32 ConfigReg_NumFrames;
+}XFpga_Read;
+
+/**
+ * Structure to store a pre-staged PL Image. Staging is not supported on
+ * versal by this interface, a PDI in DDR is loaded in place.
+ */
+typedef struct {
+		UINTPTR StageAddr;
+		u32 StageSize;
+		u32 BitstreamSize;
+		u32 Flags;
+		u32 IsStaged;
+}XFpga_StagedImage;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* XILFPGA_VERSAL_H */
+/** @} */
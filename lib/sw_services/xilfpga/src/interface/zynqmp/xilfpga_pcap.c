@@ -93,6 +93,9 @@
  *		       to success only on successful completion of the operation
  *                     of the functions.
  * 5.1 Nava  16/07/19  Improve error handling in the bitstream validation path.
+ * 5.2 Nava  14/10/19  Added XFpga_StageBitstreamPcap() to keep the validated
+ *                     configuration data in a staging region, so that it
+ *                     can be loaded many times without the validation.
  * </pre>
  *
  * @note
@@ -185,6 +188,8 @@ static u32 XFpga_ValidateBitstreamImage(XFpga  *InstancePtr);
 static u32 XFpga_PreConfigPcap(XFpga *InstancePtr);
 static u32 XFpga_WriteToPlPcap(XFpga *InstancePtr);
 static u32 XFpga_PostConfigPcap(XFpga *InstancePtr);
+static u32 XFpga_StageBitstreamPcap(XFpga *InstancePtr,
+				    XFpga_StagedImage *StagedImagePtr);
 static u32 XFpga_PcapStatus(void);
 static u32 XFpga_GetConfigRegPcap(const XFpga *InstancePtr);
 static u32 XFpga_GetPLConfigData(const XFpga *InstancePtr);
@@ -194,6 +199,9 @@ static u32 XFpga_SelectEndianess(u8 *Buf, u32 Size, u32 *Pos);
 #ifdef XFPGA_SECURE_MODE
 static u32 XFpga_SecureLoadToPl(XFpga *InstancePtr);
 static u32 XFpga_WriteEncryptToPcap(XFpga *InstancePtr);
+static u32 XFpga_SecureStageImage(XFpga *InstancePtr,
+				  const XFpga_StagedImage *StagedImagePtr,
+				  u32 *SizePtr);
 static u32 XFpga_SecureBitstreamLoad(XFpga *InstancePtr);
 static u32 XFpga_AuthPlChunksDdrOcm(XFpga *InstancePtr, u32 Size);
 static u32 XFpga_AuthPlChunks(UINTPTR BitstreamAddr, u32 Size, UINTPTR AcAddr);
@@ -256,6 +264,7 @@ u32 XFpga_Initialize(XFpga *InstancePtr) {
 	InstancePtr->XFpga_GetInterfaceStatus = XFpga_PcapStatus;
 	InstancePtr->XFpga_GetConfigReg = XFpga_GetConfigRegPcap;
 	InstancePtr->XFpga_GetConfigData = XFpga_GetPLConfigData;
+	InstancePtr->XFpga_StageBitstream = XFpga_StageBitstreamPcap;
 
 	/* Initialize CSU DMA driver */
 	CsuDmaPtr = Xsecure_GetCsuDma();
@@ -564,6 +573,82 @@ static u32 XFpga_PostConfigPcap(XFpga *InstancePtr)
 	return Status;
 }
 
+/*****************************************************************************/
+/** This function copies the configuration data of a validated Bitstream
+ *  into the staging region. Secure Bitstreams are authenticated and
+ *  decrypted into the staging region.
+ *
+ * @param InstancePtr Pointer to the XFpga structure.
+ * @param StagedImagePtr Pointer to the XFpga_StagedImage structure, the
+ *        staging region is given by StageAddr and StageSize.
+ *
+ * @return Returns Status
+ *		- XFPGA_SUCCESS on success
+ *		- Error code on failure
+ *		- XFPGA_ERROR_STAGE_SIZE
+ *
+ *****************************************************************************/
+static u32 XFpga_StageBitstreamPcap(XFpga *InstancePtr,
+				    XFpga_StagedImage *StagedImagePtr)
+{
+	u32 Status = XFPGA_FAILURE;
+	u32 Size = 0U;
+
+	if ((StagedImagePtr->StageAddr & XFPGA_ADDR_WORD_ALIGN_MASK) != 0U) {
+		/* If the Address is not Word aligned return failure */
+		Status = XFPGA_PCAP_UPDATE_ERR((u32)XFPGA_ERROR_UNALIGN_ADDR,
+					       (u32)0U);
+		goto END;
+	}
+
+	if ((InstancePtr->WriteInfo.Flags & XFPGA_SECURE_FLAGS) != 0U)
+#ifdef XFPGA_SECURE_MODE
+	{
+		Status = XFpga_SecureStageImage(InstancePtr, StagedImagePtr,
+						&Size);
+		if (Status != XFPGA_SUCCESS) {
+			goto END;
+		}
+	}
+#else
+	{
+		Status = XFPGA_PCAP_UPDATE_ERR(XFPGA_ERROR_SECURE_MODE_EN, 0U);
+		goto END;
+	}
+#endif
+	else {
+		Size = (u32)InstancePtr->WriteInfo.AddrPtr_Size &
+			~(WORD_LEN - 1U);
+		if ((Size == 0U) || (Size > StagedImagePtr->StageSize)) {
+			Status = XFPGA_PCAP_UPDATE_ERR(
+					(u32)XFPGA_ERROR_STAGE_SIZE, (u32)0U);
+			goto END;
+		}
+
+		if (StagedImagePtr->StageAddr !=
+		    InstancePtr->WriteInfo.BitstreamAddr) {
+			Status = XSecure_MemCopy(
+				(void *)StagedImagePtr->StageAddr,
+				(void *)InstancePtr->WriteInfo.BitstreamAddr,
+				Size/WORD_LEN);
+			if (Status != XFPGA_SUCCESS) {
+				Status = XFPGA_PCAP_UPDATE_ERR(
+					(u32)XFPGA_ERROR_CSU_PCAP_TRANSFER,
+					Status);
+				goto END;
+			}
+		}
+	}
+
+	StagedImagePtr->BitstreamSize = Size;
+	Status = XFPGA_SUCCESS;
+
+END:
+	InstancePtr->PLInfo.State = XFPGA_VALIDATE_INIT;
+
+	return Status;
+}
+
 /*****************************************************************************/
 /** Performs the necessary initialization of PCAP interface
  *
@@ -1244,6 +1329,160 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/* This function authenticates and decrypts the Secure Bitstream into the
+ * staging region. All the authenticated partitions are verified in DDR
+ * before any data is staged.
+ *
+ * @param InstancePtr Pointer to the XFpga structure.
+ * @param StagedImagePtr Pointer to the XFpga_StagedImage structure.
+ * @param SizePtr Pointer to the number of staged bytes.
+ *
+ * @return Returns Status
+ *		- XFPGA_SUCCESS on success
+ *		- Error code on failure
+ *		- XFPGA_ERROR_STAGE_NOT_SUPPORTED for authentication using OCM
+ *
+ *****************************************************************************/
+static u32 XFpga_SecureStageImage(XFpga *InstancePtr,
+				  const XFpga_StagedImage *StagedImagePtr,
+				  u32 *SizePtr)
+{
+	u32 Status = XFPGA_FAILURE;
+	XSecure_ImageInfo *ImageInfo = &InstancePtr->PLInfo.SecureImageInfo;
+	u32 Flags = InstancePtr->WriteInfo.Flags;
+	XSecure_Aes Secure_Aes = {0};
+	UINTPTR BitAddr;
+	UINTPTR AcPtr;
+	u32 PartationLen;
+	u32 ChunkLen;
+	u32 Offset = 0U;
+	u32 Size;
+
+	/*
+	 * Authentication using OCM is used when the external memory is not
+	 * trusted, the plain data can not be staged there.
+	 */
+	if ((Flags & XFPGA_AUTHENTICATION_OCM_EN) != 0U) {
+		Status = XFPGA_PCAP_UPDATE_ERR(
+				(u32)XFPGA_ERROR_STAGE_NOT_SUPPORTED, (u32)0U);
+		goto END;
+	}
+
+#ifndef XSECURE_TRUSTED_ENVIRONMENT
+	if ((Flags & XFPGA_SECURE_FLAGS) == XFPGA_ENCRYPTION_DEVKEY_EN) {
+		Status = XFPGA_PCAP_UPDATE_ERR(
+				(u32)XFPGA_ERROR_STAGE_NOT_SUPPORTED, (u32)0U);
+		goto END;
+	}
+#endif
+
+	BitAddr = InstancePtr->WriteInfo.BitstreamAddr +
+		(ImageInfo->PartitionHdr->DataWordOffset * XSECURE_WORD_LEN);
+	Size = ImageInfo->PartitionHdr->UnEncryptedDataWordLength *
+						XSECURE_WORD_LEN;
+
+	if ((Flags & XFPGA_AUTHENTICATION_DDR_EN) != 0U) {
+		AcPtr = InstancePtr->WriteInfo.BitstreamAddr +
+			(ImageInfo->PartitionHdr->AuthCertificateOffset *
+						XSECURE_WORD_LEN);
+		PartationLen = (u32)(AcPtr - BitAddr);
+
+		while (Offset < PartationLen) {
+			ChunkLen = PartationLen - Offset;
+			if (ChunkLen > PL_PARTATION_SIZE) {
+				ChunkLen = PL_PARTATION_SIZE;
+			}
+
+			/* Copy authentication certificate to internal memory */
+			Status = XSecure_MemCopy((u8 *)AcBuf, (u8 *)AcPtr,
+				XSECURE_AUTH_CERT_MIN_SIZE/(u32)XSECURE_WORD_LEN);
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+
+			Status = XSecure_VerifySpk((u8 *)AcBuf,
+						   ImageInfo->EfuseRsaenable);
+			if (Status != (u32)XST_SUCCESS) {
+				Status = XFPGA_PCAP_UPDATE_ERR(
+					XFPGA_ERROR_DDR_AUTH_VERIFY_SPK,
+					Status);
+				goto END;
+			}
+
+			Status = XSecure_PartitionAuthentication(CsuDmaPtr,
+					(u8 *)(BitAddr + Offset), ChunkLen,
+					(u8 *)(UINTPTR)AcBuf);
+			if (Status != (u32)XST_SUCCESS) {
+				Status = XFPGA_PCAP_UPDATE_ERR(
+					XFPGA_ERROR_DDR_AUTH_PARTITION,
+					Status);
+				goto END;
+			}
+
+			AcPtr += AC_LEN;
+			Offset += ChunkLen;
+		}
+
+		if ((Flags & (XFPGA_ENCRYPTION_USERKEY_EN |
+			      XFPGA_ENCRYPTION_DEVKEY_EN)) == 0U) {
+			Size = PartationLen;
+		}
+	}
+
+	if ((Size == 0U) || (Size > StagedImagePtr->StageSize)) {
+		Status = XFPGA_PCAP_UPDATE_ERR((u32)XFPGA_ERROR_STAGE_SIZE,
+					       (u32)0U);
+		goto END;
+	}
+
+	if ((Flags & (XFPGA_ENCRYPTION_USERKEY_EN |
+		      XFPGA_ENCRYPTION_DEVKEY_EN)) != 0U) {
+		Status = XFpga_AesInit(&Secure_Aes, CsuDmaPtr, ImageInfo->Iv,
+					(char *)InstancePtr->WriteInfo.AddrPtr_Size,
+					Flags);
+		if (Status != XFPGA_SUCCESS) {
+			Status = XFPGA_PCAP_UPDATE_ERR(
+					XFPGA_ERROR_AES_INIT, Status);
+			goto END;
+		}
+
+		Status = (u32)XSecure_AesDecrypt(&Secure_Aes,
+				(u8 *)StagedImagePtr->StageAddr,
+				(u8 *)BitAddr, Size);
+		if (Status != XFPGA_SUCCESS) {
+			/* Do not leave partly decrypted data behind */
+			(void)memset((u8 *)StagedImagePtr->StageAddr, 0U, Size);
+			Status = XFPGA_PCAP_UPDATE_ERR(
+					XFPGA_ERROR_AES_DECRYPT_PL, Status);
+			goto END;
+		}
+	} else {
+		Status = XSecure_MemCopy((void *)StagedImagePtr->StageAddr,
+				(void *)BitAddr, Size/XSECURE_WORD_LEN);
+		if (Status != XST_SUCCESS) {
+			Status = XFPGA_PCAP_UPDATE_ERR(
+				(u32)XFPGA_ERROR_CSU_PCAP_TRANSFER, Status);
+			goto END;
+		}
+	}
+
+	*SizePtr = Size;
+
+END:
+	/* Zeroize the Secure data*/
+	if (((u8 *)InstancePtr->WriteInfo.AddrPtr_Size != NULL) &&
+	    ((Flags & XFPGA_ENCRYPTION_USERKEY_EN) != 0U)) {
+		(void)memset((u8 *)InstancePtr->WriteInfo.AddrPtr_Size, 0U,
+			     KEY_LEN);
+	}
+	(void)memset(&Secure_Aes, 0, sizeof(Secure_Aes));
+	(void)memset(&InstancePtr->PLInfo.SecureImageInfo, 0,
+			sizeof(InstancePtr->PLInfo.SecureImageInfo));
+
+	return Status;
+}
+
 /******************************************************************************/
 /*
  * This API decrypts the chunks of data
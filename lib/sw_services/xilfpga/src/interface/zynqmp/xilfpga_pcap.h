@@ -116,6 +116,8 @@
  *		       address return error.
  * 5.0 sne   27/03/19  Fixed misra-c violations.
  * 5.0 Nava  23/04/19  Optimize the API's logic to avoid code duplication.
+ * 5.2 Nava  14/10/19  Added XFpga_StagedImage to load pre-staged partial
+ *                     bitstreams.
  * </pre>
  *
  * @note
@@ -255,6 +257,8 @@ extern "C" {
 #define XFPGA_ERROR_BITSTREAM_FORMAT		(0x1AU)
 #define XFPGA_ERROR_UNALIGN_ADDR		(0x1BU)
 #define XFPGA_ERROR_AES_INIT			(0x1CU)
+#define XFPGA_ERROR_STAGE_SIZE			(0x1DU)
+#define XFPGA_ERROR_STAGE_NOT_SUPPORTED		(0x1EU)
 
 /* PCAP Error Update Macro */
 #define XFPGA_PCAP_ERR_MASK			(0xFF00U)
@@ -376,6 +380,24 @@ typedef struct {
 		u32 ConfigReg_NumFrames;
 }XFpga_Read;
 
+/**
+ * Structure to store a pre-staged PL Image.
+ *
+ * @StageAddr		Base address of the reserved memory region that holds
+ *			the validated, plain configuration data.
+ * @StageSize		Size of the reserved memory region in bytes.
+ * @BitstreamSize	Size of the staged configuration data in bytes.
+ * @Flags		Flags the Image was staged with.
+ * @IsStaged		XFPGA_IMAGE_STAGED once the Image is staged.
+ */
+typedef struct {
+		UINTPTR StageAddr;
+		u32 StageSize;
+		u32 BitstreamSize;
+		u32 Flags;
+		u32 IsStaged;
+}XFpga_StagedImage;
+
 /************************** Variable Definitions *****************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
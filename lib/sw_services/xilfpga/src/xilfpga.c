@@ -57,6 +57,10 @@
  * 5.1 Nava  27/06/19  Updated documentation for readback API's.
  * 5.1 Nava  16/07/19  Initialize empty status (or) status success to status failure
  *                     to avoid security violations.
+ * 5.2 Nava  14/10/19  Added XFpga_PL_BitStream_Stage() and
+ *                     XFpga_PL_StagedBitStream_Load() API's. The bitstream
+ *                     is validated, authenticated and decrypted once and
+ *                     then loaded many times without the checks.
  *</pre>
  *
  *@note
@@ -145,6 +149,144 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**The API is used to validate the bitstream file once and keep its plain
+ * configuration data in a reserved memory region, so that it can be loaded
+ * into the PL many times with XFpga_PL_StagedBitStream_Load(). It is meant
+ * for partial bitstreams that are swapped at run time.
+ *
+ * Secure bitstreams are authenticated and decrypted into the staging region
+ * by this API. Authentication using OCM is not supported, as the plain data
+ * is kept in the staging region.
+ *
+ *@param InstancePtr Pointer to the XFgpa structure.
+ *
+ *@param BitstreamImageAddr  Linear memory Bitstream image base address
+ *
+ *@param AddrPtr_Size Aes key address which is used for Decryption (or)
+ *			In none Secure Bitstream used it is used to store size
+ *			of Bitstream Image.
+ *
+ *@param Flags Flags are used to specify the type of Bitstream file, as
+ *		for XFpga_PL_BitStream_Load().
+ *
+ *@param StageAddr Word aligned base address of the staging region.
+ *		It can be BitstreamImageAddr for none Secure Bitstreams.
+ *
+ *@param StageSize Size of the staging region in bytes.
+ *
+ *@param StagedImagePtr Pointer to the XFpga_StagedImage structure which is
+ *		updated with the staged image details.
+ *
+ *@return
+ *	- XFPGA_SUCCESS on success
+ *	- Error code on failure.
+ *	- XFPGA_VALIDATE_ERROR.
+ *	- XFPGA_STAGE_ERROR.
+ *
+ *@note The staging region is written by the CSU DMA. It must not be written
+ *	by the processor while the staged image is in use.
+ *
+ *****************************************************************************/
+u32 XFpga_PL_BitStream_Stage(XFpga *InstancePtr,
+			     UINTPTR BitstreamImageAddr,
+			     UINTPTR AddrPtr_Size, u32 Flags,
+			     UINTPTR StageAddr, u32 StageSize,
+			     XFpga_StagedImage *StagedImagePtr)
+{
+	u32 Status = XFPGA_STAGE_ERROR;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(StagedImagePtr != NULL);
+
+	StagedImagePtr->IsStaged = 0U;
+	StagedImagePtr->StageAddr = StageAddr;
+	StagedImagePtr->StageSize = StageSize;
+	StagedImagePtr->BitstreamSize = 0U;
+	StagedImagePtr->Flags = Flags;
+
+	/* Validate Bitstream Image */
+	Status = XFpga_PL_ValidateImage(InstancePtr, BitstreamImageAddr,
+			AddrPtr_Size, Flags);
+	if (Status != XFPGA_SUCCESS) {
+		goto END;
+	}
+
+	if (InstancePtr->XFpga_StageBitstream == NULL) {
+		Status = XFPGA_OPS_NOT_IMPLEMENTED;
+		Xfpga_Printf(XFPGA_DEBUG,
+		"%s Implementation not exists..\r\n", __FUNCTION__);
+	} else {
+		Status = InstancePtr->XFpga_StageBitstream(InstancePtr,
+							   StagedImagePtr);
+		if (Status != XFPGA_SUCCESS) {
+			Status = XFPGA_UPDATE_ERR(XFPGA_STAGE_ERROR, Status);
+		} else {
+			StagedImagePtr->IsStaged = XFPGA_IMAGE_STAGED;
+		}
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**The API is used to load a bitstream staged by XFpga_PL_BitStream_Stage()
+ * into the PL region. The staged data is not validated again, it is written
+ * to the PL as it is.
+ *
+ *@param InstancePtr Pointer to the XFgpa structure.
+ *
+ *@param StagedImagePtr Pointer to the staged image details.
+ *
+ *@return
+ *	- XFPGA_SUCCESS on success
+ *	- Error code on failure.
+ *	- XFPGA_STAGE_ERROR if the image is not staged.
+ *	- XFPGA_PRE_CONFIG_ERROR.
+ *	- XFPGA_WRITE_BITSTREAM_ERROR.
+ *	- XFPGA_POST_CONFIG_ERROR.
+ *
+ *****************************************************************************/
+u32 XFpga_PL_StagedBitStream_Load(XFpga *InstancePtr,
+				  const XFpga_StagedImage *StagedImagePtr)
+{
+	u32 Status = XFPGA_STAGE_ERROR;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(StagedImagePtr != NULL);
+
+	if (StagedImagePtr->IsStaged != XFPGA_IMAGE_STAGED) {
+		goto END;
+	}
+
+	/*
+	 * The staged data is plain configuration data, only the Bitstream
+	 * type is kept from the flags it was staged with.
+	 */
+	InstancePtr->WriteInfo.Flags = StagedImagePtr->Flags & XFPGA_PARTIAL_EN;
+
+	/* Prepare the FPGA to receive configuration Data */
+	Status = XFpga_PL_Preconfig(InstancePtr);
+	if (Status != XFPGA_SUCCESS) {
+		goto END;
+	}
+
+	/* write count bytes of configuration data into the PL */
+	Status = XFpga_PL_Write(InstancePtr, StagedImagePtr->StageAddr,
+				StagedImagePtr->BitstreamSize,
+				InstancePtr->WriteInfo.Flags);
+	if (Status != XFPGA_SUCCESS) {
+		goto END;
+	}
+
+	/* set FPGA to operating state after writing */
+	Status = XFpga_PL_PostConfig(InstancePtr);
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * This function is used to validate the Bitstream Image
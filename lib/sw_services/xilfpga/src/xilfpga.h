@@ -81,6 +81,12 @@
  *                      done by PLM based on the CDO's data exists in the PDI
  *                      images. So there is no need of xilfpga API's for versal
  *                      platform to configure the PL.
+ * 5.2   Nava  14/10/19 Added XFpga_PL_BitStream_Stage() and
+ *                      XFpga_PL_StagedBitStream_Load() to validate a
+ *                      bitstream once and load it many times.
+ * 5.2   adk   15/10/19 Added versal interface, the PDI loads are requested
+ *                      from the PLM, with XFpga_PL_BitStream_LoadAsync()
+ *                      and XFpga_PL_LoadStatus() for asynchronous loads.
  * </pre>
  *
  * @note
@@ -100,8 +106,12 @@ extern "C" {
 #include "xil_printf.h"
 #include "xparameters.h"
 #include "xfpga_config.h"
+#if defined(versal)
+#include "xilfpga_versal.h"
+#else
 #include "xilfpga_pcap.h"
 #include "xsecure.h"
+#endif
 
 /**************************** Type Definitions *******************************/
 /**
@@ -116,6 +126,8 @@ extern "C" {
  * @Xfpga_GetConfigReg:		Returns the value of the specified configuration
  *				register
  * @XFpga_GetConfigData:	Provides the FPGA readback data.
+ * @XFpga_StageBitstream:	Copies the validated Bitstream configuration
+ *				data into a staging region
  * @PLInfo:			Which is used to store the secure image data.
  * @WriteInfo:	XFpga_Write structure which is used to store the PL Write
  *              Image details.
@@ -130,6 +142,8 @@ typedef struct XFpgatag{
 	u32 (*XFpga_GetInterfaceStatus)(void);
 	u32 (*XFpga_GetConfigReg)(const struct XFpgatag *InstancePtr);
 	u32 (*XFpga_GetConfigData)(const struct XFpgatag *InstancePtr);
+	u32 (*XFpga_StageBitstream)(struct XFpgatag *InstancePtr,
+				    XFpga_StagedImage *StagedImagePtr);
 	XFpga_Info	PLInfo;
 	XFpga_Write	WriteInfo;
 	XFpga_Read	ReadInfo;
@@ -144,6 +158,7 @@ typedef struct XFpgatag{
 #define XFPGA_POST_CONFIG_ERROR		(0x5U)
 #define XFPGA_OPS_NOT_IMPLEMENTED	(0x6U)
 #define XFPGA_INPROGRESS			(0x7U)
+#define XFPGA_STAGE_ERROR		(0x8U)
 
 #define XFPGA_FULLBIT_EN			(0x00000000U)
 #define XFPGA_PARTIAL_EN			(0x00000001U)
@@ -164,6 +179,8 @@ typedef struct XFpgatag{
 #define XFPGA_CONFIG_DONE			(0x80000000U)
 #define XFPGA_CONFIG_MASK			(0x07FFFFFFU)
 
+#define XFPGA_IMAGE_STAGED			(0x53544744U) /* "STGD" */
+
 #define XFPGA_SECURE_FLAGS	(				\
 				XFPGA_AUTHENTICATION_DDR_EN	\
 				| XFPGA_AUTHENTICATION_OCM_EN	\
@@ -219,6 +236,20 @@ u32 XFpga_GetPlConfigData(XFpga *InstancePtr, UINTPTR ReadbackAddr,
 u32 XFpga_GetPlConfigReg(XFpga *InstancePtr, UINTPTR ReadbackAddr,
 			 u32 ConfigReg_NumFrames);
 u32 XFpga_InterfaceStatus(XFpga *InstancePtr);
+u32 XFpga_PL_BitStream_Stage(XFpga *InstancePtr,
+			     UINTPTR BitstreamImageAddr,
+			     UINTPTR AddrPtr_Size, u32 Flags,
+			     UINTPTR StageAddr, u32 StageSize,
+			     XFpga_StagedImage *StagedImagePtr);
+u32 XFpga_PL_StagedBitStream_Load(XFpga *InstancePtr,
+				  const XFpga_StagedImage *StagedImagePtr);
+#if defined(versal)
+u32 XFpga_PL_BitStream_LoadAsync(XFpga *InstancePtr, UINTPTR PdiAddr,
+				 XFpga_LoadDoneHandler Handler,
+				 void *CallBackRef, u32 *HandlePtr);
+u32 XFpga_PL_LoadStatus(XFpga *InstancePtr, u32 Handle,
+			XFpga_LoadProgress *ProgressPtr);
+#endif
 
 #ifdef __cplusplus
 }
@@ -536,6 +536,7 @@
  *                    flashes.
  * 5.14 akm  08/01/19 Initialized Status variable to XST_FAILURE.
  * 5.14	akm  09/09/19 Added message regarding deprecation of Xilisf.
+ * 5.15  adk  10/15/19 Added the xilisf_blk block device layer.
  *
  *
  * </pre>
@@ -0,0 +1,159 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+ ******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xilisf_blk.h
+ *
+ * This file contains the definitions of the block device layer, which
+ * exports a range of sectors of an Intel, STM, Winbond or Spansion Serial
+ * Flash as an array of 512 byte logical blocks.
+ *
+ * The blocks are written in a log: every write goes to the next free slot of
+ * the open sector and the previous copy of the block becomes stale. Each
+ * sector starts with a header and a table holding the logical block number
+ * of every slot, so that the block map is rebuilt by XIsf_BlkMount().
+ *
+ * - Small writes are coalesced in RAM and programmed page by page once
+ *   XISF_BLK_WBUF_BLOCKS blocks are pending, the open sector is full or
+ *   XIsf_BlkSync() is called. Rewriting a pending block only updates RAM.
+ * - XIsf_BlkIdle() does one unit of background work per call: erase ahead
+ *   of the writer, garbage collect the sector with the fewest valid blocks,
+ *   or move cold data off the least erased sector when the erase counts
+ *   drift apart by more than XISF_BLK_WEAR_DELTA. Writes only reclaim
+ *   sectors themselves when no erased sector is left.
+ *
+ * The read, write, sync and sector count calls match the disk_read(),
+ * disk_write() and disk_ioctl() needs of a FAT file system diskio layer, so
+ * that xilffs or xilmfs can mount the flash through it.
+ *
+ * The layer requires the library to be in polled mode.
+ *
+ * <pre>
+ *
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who      Date     Changes
+ * ----- -------  -------- -----------------------------------------------
+ * 5.15  adk      10/15/19 First release
+ *
+ * </pre>
+ *
+ ******************************************************************************/
+
+#ifndef XILISF_BLK_H /* prevent circular inclusions */
+#define XILISF_BLK_H /* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xilisf.h"
+
+#if (XPAR_XISF_FLASH_FAMILY != ATMEL)
+
+/************************** Constant Definitions *****************************/
+
+#define XISF_BLK_SIZE		512U	/**< Logical block size */
+#define XISF_BLK_WBUF_BLOCKS	4U	/**< Blocks coalesced before program */
+#define XISF_BLK_ERASED_TARGET	2U	/**< Erased sectors kept ahead */
+#define XISF_BLK_SPARE_SECTORS	2U	/**< Sectors not exported as blocks */
+#define XISF_BLK_WEAR_DELTA	64U	/**< Erase count spread which triggers
+					  *  static wear leveling */
+
+#define XISF_BLK_MAGIC		0x49534642U	/**< "ISFB" sector magic */
+#define XISF_BLK_HDR_SIZE	16U		/**< Sector header size */
+#define XISF_BLK_UNMAPPED	0xFFFFFFFFU	/**< Unmapped block/no sector */
+
+/**
+ * Sector states
+ */
+#define XISF_BLK_SECTOR_ERASED	0U	/**< Erased, header programmed */
+#define XISF_BLK_SECTOR_USED	1U	/**< Holds blocks */
+#define XISF_BLK_SECTOR_DIRTY	2U	/**< Needs an erase */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Run time state of a flash sector. One entry per sector is provided by the
+ * user to XIsf_BlkMount().
+ */
+typedef struct {
+	u32 Seq;		/**< Allocation sequence number */
+	u32 EraseCount;		/**< Number of erase cycles */
+	u16 Valid;		/**< Slots holding the current copy of a block */
+	u16 Used;		/**< Slots allocated */
+	u8 State;		/**< XISF_BLK_SECTOR_* */
+} XIsf_BlkSector;
+
+/**
+ * The block device instance.
+ */
+typedef struct {
+	u8 ReadBuf[XISF_BLK_SIZE + XISF_CMD_SEND_EXTRA_BYTES_4BYTE_MODE]
+		__attribute__ ((aligned(64)));	/**< Flash read buffer */
+	u8 StatusBuf[XISF_STATUS_RDWR_BYTES]
+		__attribute__ ((aligned(64)));	/**< Status register buffer */
+	u8 WriteBuf[XISF_BLK_WBUF_BLOCKS * XISF_BLK_SIZE];
+				/**< Blocks pending program */
+	u32 Tags[XISF_BLK_WBUF_BLOCKS];	/**< Blocks numbers in WriteBuf */
+	XIsf *IsfPtr;		/**< Serial Flash instance */
+	u32 StartAddr;		/**< Flash address of the first sector */
+	u32 SectorSize;		/**< Size of a sector */
+	u32 NumSectors;		/**< Sectors used by the layer */
+	u32 SlotsPerSector;	/**< Block slots in a sector */
+	u32 DataOffset;		/**< Offset of the first slot in a sector */
+	u32 NumBlocks;		/**< Logical blocks exported */
+	u32 *Map;		/**< Block to Sector * Slots + Slot map */
+	XIsf_BlkSector *Sectors;	/**< Sector states */
+	u32 MaxSeq;		/**< Highest sequence number allocated */
+	u32 CurSector;		/**< Sector written to */
+	u32 NumErased;		/**< Sectors in the erased state */
+	u32 WbufSlot;		/**< Slot of the first block in WriteBuf */
+	u32 WbufCount;		/**< Blocks in WriteBuf */
+	u8 IsReady;		/**< Mounted flag */
+} XIsf_Blk;
+
+/************************** Function Prototypes ******************************/
+
+int XIsf_BlkMount(XIsf_Blk *BlkPtr, XIsf *IsfPtr, u32 StartAddr,
+		u32 NumSectors, XIsf_BlkSector *Sectors, u32 *Map,
+		u32 MapEntries);
+int XIsf_BlkRead(XIsf_Blk *BlkPtr, u8 *Buf, u32 Lba, u32 Count);
+int XIsf_BlkWrite(XIsf_Blk *BlkPtr, const u8 *Buf, u32 Lba, u32 Count);
+int XIsf_BlkSync(XIsf_Blk *BlkPtr);
+u32 XIsf_BlkGetCount(XIsf_Blk *BlkPtr);
+int XIsf_BlkIdle(XIsf_Blk *BlkPtr);
+
+#endif /* (XPAR_XISF_FLASH_FAMILY != ATMEL) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
@@ -0,0 +1,1024 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+ ******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xilisf_blk.c
+ *
+ * This file contains the block device layer on top of the Serial Flash
+ * library. Refer xilisf_blk.h for a description of the on flash layout.
+ *
+ * <pre>
+ *
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who      Date     Changes
+ * ----- -------  -------- -----------------------------------------------
+ * 5.15  adk      10/15/19 First release
+ *
+ * </pre>
+ *
+ ******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "include/xilisf_blk.h"
+
+#if (XPAR_XISF_FLASH_FAMILY != ATMEL)
+
+/************************** Constant Definitions *****************************/
+
+#define XISF_BLK_SEQ_OFFSET	8U	/**< Offset of Seq in the header */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Offset of the data in the buffer passed to XIsf_Read(). The command and
+ * address bytes are received in front of the data except on the interfaces
+ * which drop or shift them.
+ */
+#if defined(XPAR_XISF_INTERFACE_PSQSPI) || \
+	defined(XPAR_XISF_INTERFACE_QSPIPSU) || \
+	defined(XPAR_XISF_INTERFACE_OSPIPSV)
+#define XIsf_BlkReadOffset(IsfPtr)	0U
+#else
+#define XIsf_BlkReadOffset(IsfPtr)				\
+	(((IsfPtr)->FourByteAddrMode == TRUE) ?			\
+	 (u32)XISF_CMD_SEND_EXTRA_BYTES_4BYTE_MODE :		\
+	 (u32)XISF_CMD_SEND_EXTRA_BYTES)
+#endif
+
+#define XIsf_BlkSectorAddr(BlkPtr, Sector)			\
+	((BlkPtr)->StartAddr + ((Sector) * (BlkPtr)->SectorSize))
+
+/************************** Function Prototypes ******************************/
+
+static int BlkWaitReady(XIsf_Blk *BlkPtr);
+static int BlkFlashRead(XIsf_Blk *BlkPtr, u32 Address, u32 NumBytes,
+		u8 **DataPtr);
+static int BlkFlashProgram(XIsf_Blk *BlkPtr, u32 Address, u8 *Buf,
+		u32 NumBytes);
+static int BlkEraseSector(XIsf_Blk *BlkPtr, u32 Sector);
+static int BlkFlush(XIsf_Blk *BlkPtr);
+static int BlkOpenSector(XIsf_Blk *BlkPtr, u32 Reserve);
+static int BlkAppend(XIsf_Blk *BlkPtr, u32 Lba, const u8 *Buf, u32 Reserve);
+static u32 BlkFindPending(XIsf_Blk *BlkPtr, u32 Lba);
+static u32 BlkFindVictim(XIsf_Blk *BlkPtr, u32 Cold);
+static u32 BlkFreeSlots(XIsf_Blk *BlkPtr);
+static int BlkCollect(XIsf_Blk *BlkPtr, u32 Victim);
+static int BlkReclaim(XIsf_Blk *BlkPtr);
+
+/************************** Variable Definitions *****************************/
+
+/************************** Function Definitions ******************************/
+
+/*****************************************************************************/
+/**
+ *
+ * This API mounts the block device on a range of Serial Flash sectors and
+ * rebuilds the block map from the sector headers and tables.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	IsfPtr is a pointer to the initialized XIsf instance.
+ * @param	StartAddr is the flash address of the first sector. It must be
+ *		sector aligned.
+ * @param	NumSectors is the number of sectors owned by the block device.
+ *		It must be larger than XISF_BLK_SPARE_SECTORS.
+ * @param	Sectors is an array of NumSectors entries for the sector states.
+ * @param	Map is an array of MapEntries entries for the block map.
+ * @param	MapEntries is the maximum number of blocks to export.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	Sectors which do not hold a valid header are erased on demand,
+ *		so a blank or foreign range mounts as an empty device.
+ *		Partially written sectors are closed and never appended to.
+ *
+ ******************************************************************************/
+int XIsf_BlkMount(XIsf_Blk *BlkPtr, XIsf *IsfPtr, u32 StartAddr,
+		u32 NumSectors, XIsf_BlkSector *Sectors, u32 *Map,
+		u32 MapEntries)
+{
+	int Status;
+	u32 Sector;
+	u32 Slot;
+	u32 Index;
+	u32 Chunk;
+	u32 Lba;
+	u32 Entry;
+	u32 Hdr[XISF_BLK_HDR_SIZE / 4U];
+	u32 MaxErase = 0U;
+	u8 *DataPtr;
+
+	if ((BlkPtr == NULL) || (IsfPtr == NULL) || (Sectors == NULL) ||
+			(Map == NULL) || (IsfPtr->IsReady != TRUE)) {
+		return (int)XST_FAILURE;
+	}
+
+	if ((XIsf_GetTransferMode(IsfPtr) != XISF_POLLING_MODE) ||
+			(NumSectors <= XISF_BLK_SPARE_SECTORS) ||
+			(IsfPtr->BytesPerPage == 0U)) {
+		return (int)XST_FAILURE;
+	}
+
+	memset(BlkPtr, 0, sizeof(XIsf_Blk));
+	BlkPtr->IsfPtr = IsfPtr;
+	BlkPtr->StartAddr = StartAddr;
+	BlkPtr->NumSectors = NumSectors;
+	BlkPtr->Sectors = Sectors;
+	BlkPtr->Map = Map;
+	BlkPtr->CurSector = XISF_BLK_UNMAPPED;
+#if defined(XPAR_XISF_INTERFACE_PSQSPI) || \
+	defined(XPAR_XISF_INTERFACE_QSPIPSU) || \
+	defined(XPAR_XISF_INTERFACE_OSPIPSV)
+	BlkPtr->SectorSize = IsfPtr->SectorSize;
+#else
+	BlkPtr->SectorSize = (u32)IsfPtr->BytesPerPage *
+				IsfPtr->PagesPerBlock;
+#endif
+	if ((BlkPtr->SectorSize < (2U * XISF_BLK_SIZE)) ||
+			((StartAddr % BlkPtr->SectorSize) != 0U)) {
+		return (int)XST_FAILURE;
+	}
+
+	/*
+	 * Fit the largest number of slots behind the header and the tag
+	 * table, the first slot starting on a block boundary.
+	 */
+	Slot = (BlkPtr->SectorSize / XISF_BLK_SIZE) - 1U;
+	for (;;) {
+		BlkPtr->DataOffset = XISF_BLK_HDR_SIZE + (Slot * 4U);
+		BlkPtr->DataOffset = (BlkPtr->DataOffset + XISF_BLK_SIZE - 1U) &
+					~(XISF_BLK_SIZE - 1U);
+		if ((BlkPtr->DataOffset + (Slot * XISF_BLK_SIZE)) <=
+				BlkPtr->SectorSize) {
+			break;
+		}
+		Slot--;
+	}
+	if (Slot > 0xFFFFU) {
+		return (int)XST_FAILURE;
+	}
+	BlkPtr->SlotsPerSector = Slot;
+
+	BlkPtr->NumBlocks = (NumSectors - XISF_BLK_SPARE_SECTORS) * Slot;
+	if (MapEntries < BlkPtr->NumBlocks) {
+		BlkPtr->NumBlocks = MapEntries;
+	}
+	for (Lba = 0U; Lba < BlkPtr->NumBlocks; Lba++) {
+		Map[Lba] = XISF_BLK_UNMAPPED;
+	}
+
+	for (Sector = 0U; Sector < NumSectors; Sector++) {
+		Status = BlkFlashRead(BlkPtr, XIsf_BlkSectorAddr(BlkPtr, Sector),
+				XISF_BLK_HDR_SIZE, &DataPtr);
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+		memcpy(Hdr, DataPtr, XISF_BLK_HDR_SIZE);
+
+		Sectors[Sector].Valid = 0U;
+		Sectors[Sector].Used = 0U;
+		if (Hdr[0] != XISF_BLK_MAGIC) {
+			Sectors[Sector].State = XISF_BLK_SECTOR_DIRTY;
+			Sectors[Sector].Seq = XISF_BLK_UNMAPPED;
+			Sectors[Sector].EraseCount = 0U;
+			continue;
+		}
+
+		Sectors[Sector].EraseCount = Hdr[1];
+		Sectors[Sector].Seq = Hdr[2];
+		if (Hdr[1] > MaxErase) {
+			MaxErase = Hdr[1];
+		}
+		if (Hdr[2] == XISF_BLK_UNMAPPED) {
+			Sectors[Sector].State = XISF_BLK_SECTOR_ERASED;
+			BlkPtr->NumErased++;
+			continue;
+		}
+
+		Sectors[Sector].State = XISF_BLK_SECTOR_USED;
+		Sectors[Sector].Used = (u16)Slot;
+		if (Hdr[2] > BlkPtr->MaxSeq) {
+			BlkPtr->MaxSeq = Hdr[2];
+		}
+
+		/*
+		 * Walk the tag table. The newest copy of a block wins: the
+		 * one from the sector with the higher sequence number, or
+		 * the later slot of the same sector.
+		 */
+		for (Index = 0U; Index < Slot; Index += Chunk) {
+			Chunk = Slot - Index;
+			if (Chunk > (XISF_BLK_SIZE / 4U)) {
+				Chunk = XISF_BLK_SIZE / 4U;
+			}
+			Status = BlkFlashRead(BlkPtr,
+				XIsf_BlkSectorAddr(BlkPtr, Sector) +
+				XISF_BLK_HDR_SIZE + (Index * 4U),
+				Chunk * 4U, &DataPtr);
+			if (Status != (int)XST_SUCCESS) {
+				return (int)XST_FAILURE;
+			}
+
+			for (Entry = 0U; Entry < Chunk; Entry++) {
+				memcpy(&Lba, DataPtr + (Entry * 4U), 4U);
+				if (Lba >= BlkPtr->NumBlocks) {
+					continue;
+				}
+				if (Map[Lba] != XISF_BLK_UNMAPPED) {
+					u32 OldSector = Map[Lba] / Slot;
+
+					if ((OldSector != Sector) &&
+						(Sectors[OldSector].Seq >
+						 Hdr[2])) {
+						continue;
+					}
+					Sectors[OldSector].Valid--;
+				}
+				Map[Lba] = (Sector * Slot) + Index + Entry;
+				Sectors[Sector].Valid++;
+			}
+		}
+	}
+
+	/*
+	 * Sectors caught in the middle of an erase lost their count, assume
+	 * they are as worn as the most worn one.
+	 */
+	for (Sector = 0U; Sector < NumSectors; Sector++) {
+		if ((Sectors[Sector].State == XISF_BLK_SECTOR_DIRTY) &&
+				(Sectors[Sector].EraseCount < MaxErase)) {
+			Sectors[Sector].EraseCount = MaxErase;
+		}
+	}
+
+	BlkPtr->IsReady = TRUE;
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This API reads logical blocks. Blocks which were never written read as
+ * zeros.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Buf is the destination buffer of Count * XISF_BLK_SIZE bytes.
+ * @param	Lba is the first logical block.
+ * @param	Count is the number of blocks.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+int XIsf_BlkRead(XIsf_Blk *BlkPtr, u8 *Buf, u32 Lba, u32 Count)
+{
+	int Status;
+	u32 Index;
+	u32 Phys;
+	u32 Slots;
+	u8 *DataPtr;
+
+	if ((BlkPtr == NULL) || (Buf == NULL) || (BlkPtr->IsReady != TRUE) ||
+			(Lba >= BlkPtr->NumBlocks) ||
+			(Count > (BlkPtr->NumBlocks - Lba))) {
+		return (int)XST_FAILURE;
+	}
+
+	Slots = BlkPtr->SlotsPerSector;
+	for (; Count > 0U; Count--, Lba++, Buf += XISF_BLK_SIZE) {
+		Index = BlkFindPending(BlkPtr, Lba);
+		if (Index < BlkPtr->WbufCount) {
+			memcpy(Buf, &BlkPtr->WriteBuf[Index * XISF_BLK_SIZE],
+					XISF_BLK_SIZE);
+			continue;
+		}
+
+		Phys = BlkPtr->Map[Lba];
+		if (Phys == XISF_BLK_UNMAPPED) {
+			memset(Buf, 0, XISF_BLK_SIZE);
+			continue;
+		}
+
+		Status = BlkFlashRead(BlkPtr,
+				XIsf_BlkSectorAddr(BlkPtr, Phys / Slots) +
+				BlkPtr->DataOffset +
+				((Phys % Slots) * XISF_BLK_SIZE),
+				XISF_BLK_SIZE, &DataPtr);
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+		memcpy(Buf, DataPtr, XISF_BLK_SIZE);
+	}
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This API writes logical blocks. The data is queued in the write buffer and
+ * programmed once enough blocks are pending, see XIsf_BlkSync().
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Buf is the source buffer of Count * XISF_BLK_SIZE bytes.
+ * @param	Lba is the first logical block.
+ * @param	Count is the number of blocks.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	The call erases and garbage collects sectors itself only when
+ *		XIsf_BlkIdle() did not keep an erased sector ahead.
+ *
+ ******************************************************************************/
+int XIsf_BlkWrite(XIsf_Blk *BlkPtr, const u8 *Buf, u32 Lba, u32 Count)
+{
+	int Status;
+
+	if ((BlkPtr == NULL) || (Buf == NULL) || (BlkPtr->IsReady != TRUE) ||
+			(Lba >= BlkPtr->NumBlocks) ||
+			(Count > (BlkPtr->NumBlocks - Lba))) {
+		return (int)XST_FAILURE;
+	}
+
+	for (; Count > 0U; Count--, Lba++, Buf += XISF_BLK_SIZE) {
+		Status = BlkAppend(BlkPtr, Lba, Buf, 1U);
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+	}
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This API programs the blocks pending in the write buffer.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+int XIsf_BlkSync(XIsf_Blk *BlkPtr)
+{
+	if ((BlkPtr == NULL) || (BlkPtr->IsReady != TRUE)) {
+		return (int)XST_FAILURE;
+	}
+
+	return BlkFlush(BlkPtr);
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This API returns the number of logical blocks of the device.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ *
+ * @return	Number of XISF_BLK_SIZE blocks.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+u32 XIsf_BlkGetCount(XIsf_Blk *BlkPtr)
+{
+	if ((BlkPtr == NULL) || (BlkPtr->IsReady != TRUE)) {
+		return 0U;
+	}
+
+	return BlkPtr->NumBlocks;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * This API does one unit of background maintenance, in this order:
+ * - erase a sector holding stale data only,
+ * - garbage collect the sector with the fewest valid blocks while less than
+ *   XISF_BLK_ERASED_TARGET sectors are erased,
+ * - move the blocks of the least erased sector when the erase counts drift
+ *   apart by more than XISF_BLK_WEAR_DELTA.
+ *
+ * It is meant to be called from the idle loop, so that the sector erases
+ * do not stall XIsf_BlkWrite().
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ *
+ * @return
+ *		- XST_SUCCESS if some work was done.
+ *		- XST_NO_DATA if there is nothing to do.
+ *		- XST_FAILURE if a flash operation failed.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+int XIsf_BlkIdle(XIsf_Blk *BlkPtr)
+{
+	u32 Sector;
+	u32 Victim = XISF_BLK_UNMAPPED;
+	u32 MinErase = 0xFFFFFFFFU;
+	u32 MaxErase = 0U;
+	XIsf_BlkSector *SecPtr;
+
+	if ((BlkPtr == NULL) || (BlkPtr->IsReady != TRUE)) {
+		return (int)XST_FAILURE;
+	}
+
+	for (Sector = 0U; Sector < BlkPtr->NumSectors; Sector++) {
+		SecPtr = &BlkPtr->Sectors[Sector];
+		if (SecPtr->State == XISF_BLK_SECTOR_DIRTY) {
+			return BlkEraseSector(BlkPtr, Sector);
+		}
+		if (SecPtr->EraseCount < MinErase) {
+			MinErase = SecPtr->EraseCount;
+		}
+		if (SecPtr->EraseCount > MaxErase) {
+			MaxErase = SecPtr->EraseCount;
+		}
+	}
+
+	if (BlkPtr->NumErased < XISF_BLK_ERASED_TARGET) {
+		Victim = BlkFindVictim(BlkPtr, FALSE);
+		if ((Victim != XISF_BLK_UNMAPPED) &&
+			(BlkPtr->Sectors[Victim].Valid >=
+			 BlkPtr->SlotsPerSector)) {
+			Victim = XISF_BLK_UNMAPPED;
+		}
+	}
+
+	if ((Victim == XISF_BLK_UNMAPPED) &&
+			((MaxErase - MinErase) > XISF_BLK_WEAR_DELTA)) {
+		Victim = BlkFindVictim(BlkPtr, TRUE);
+	}
+
+	if ((Victim == XISF_BLK_UNMAPPED) ||
+		(BlkPtr->Sectors[Victim].Valid > BlkFreeSlots(BlkPtr))) {
+		return (int)XST_NO_DATA;
+	}
+
+	return BlkCollect(BlkPtr, Victim);
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Polls the status register until the flash completes the current program
+ * or erase.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static int BlkWaitReady(XIsf_Blk *BlkPtr)
+{
+	int Status;
+
+	do {
+		Status = XIsf_GetStatus(BlkPtr->IsfPtr, BlkPtr->StatusBuf);
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+	} while ((BlkPtr->StatusBuf[BYTE2] & XISF_SR_IS_READY_MASK) != 0U);
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Reads up to XISF_BLK_SIZE bytes from the flash into the read buffer.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Address is the flash address.
+ * @param	NumBytes is the number of bytes to read.
+ * @param	DataPtr is updated with the location of the data.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static int BlkFlashRead(XIsf_Blk *BlkPtr, u32 Address, u32 NumBytes,
+		u8 **DataPtr)
+{
+	int Status;
+	XIsf_ReadParam ReadParam;
+
+	ReadParam.Address = Address;
+	ReadParam.ReadPtr = BlkPtr->ReadBuf;
+	ReadParam.NumBytes = NumBytes;
+	ReadParam.NumDummyBytes = 0;
+
+	Status = XIsf_Read(BlkPtr->IsfPtr, XISF_READ, (void *)&ReadParam);
+	if (Status != (int)XST_SUCCESS) {
+		return (int)XST_FAILURE;
+	}
+
+	*DataPtr = &BlkPtr->ReadBuf[XIsf_BlkReadOffset(BlkPtr->IsfPtr)];
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Programs a buffer to the flash, one page at most per write command.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Address is the flash address.
+ * @param	Buf is the data to program.
+ * @param	NumBytes is the number of bytes to program.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static int BlkFlashProgram(XIsf_Blk *BlkPtr, u32 Address, u8 *Buf,
+		u32 NumBytes)
+{
+	int Status;
+	u32 PageSize = BlkPtr->IsfPtr->BytesPerPage;
+	u32 Length;
+	XIsf_WriteParam WriteParam;
+
+	while (NumBytes > 0U) {
+		Length = PageSize - (Address % PageSize);
+		if (Length > NumBytes) {
+			Length = NumBytes;
+		}
+
+		Status = XIsf_WriteEnable(BlkPtr->IsfPtr, XISF_WRITE_ENABLE);
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+
+		WriteParam.Address = Address;
+		WriteParam.WritePtr = Buf;
+		WriteParam.NumBytes = Length;
+		Status = XIsf_Write(BlkPtr->IsfPtr, XISF_WRITE,
+				(void *)&WriteParam);
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+
+		Status = BlkWaitReady(BlkPtr);
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+
+		Address += Length;
+		Buf += Length;
+		NumBytes -= Length;
+	}
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Erases a sector and programs its header with the new erase count.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Sector is the sector to erase.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static int BlkEraseSector(XIsf_Blk *BlkPtr, u32 Sector)
+{
+	int Status;
+	u32 Hdr[2];
+	XIsf_BlkSector *SecPtr = &BlkPtr->Sectors[Sector];
+
+	Status = XIsf_WriteEnable(BlkPtr->IsfPtr, XISF_WRITE_ENABLE);
+	if (Status != (int)XST_SUCCESS) {
+		return (int)XST_FAILURE;
+	}
+
+	Status = XIsf_Erase(BlkPtr->IsfPtr, XISF_SECTOR_ERASE,
+			XIsf_BlkSectorAddr(BlkPtr, Sector));
+	if (Status != (int)XST_SUCCESS) {
+		return (int)XST_FAILURE;
+	}
+
+	Status = BlkWaitReady(BlkPtr);
+	if (Status != (int)XST_SUCCESS) {
+		return (int)XST_FAILURE;
+	}
+
+	SecPtr->EraseCount++;
+	Hdr[0] = XISF_BLK_MAGIC;
+	Hdr[1] = SecPtr->EraseCount;
+	Status = BlkFlashProgram(BlkPtr, XIsf_BlkSectorAddr(BlkPtr, Sector),
+			(u8 *)Hdr, sizeof(Hdr));
+	if (Status != (int)XST_SUCCESS) {
+		return (int)XST_FAILURE;
+	}
+
+	SecPtr->State = XISF_BLK_SECTOR_ERASED;
+	SecPtr->Seq = XISF_BLK_UNMAPPED;
+	SecPtr->Valid = 0U;
+	SecPtr->Used = 0U;
+	BlkPtr->NumErased++;
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Programs the pending blocks, then their tags. A block is only found at
+ * mount once its tag is programmed.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static int BlkFlush(XIsf_Blk *BlkPtr)
+{
+	int Status;
+	u32 SectorAddr;
+
+	if (BlkPtr->WbufCount == 0U) {
+		return (int)XST_SUCCESS;
+	}
+
+	SectorAddr = XIsf_BlkSectorAddr(BlkPtr, BlkPtr->CurSector);
+	Status = BlkFlashProgram(BlkPtr, SectorAddr + BlkPtr->DataOffset +
+			(BlkPtr->WbufSlot * XISF_BLK_SIZE),
+			BlkPtr->WriteBuf, BlkPtr->WbufCount * XISF_BLK_SIZE);
+	if (Status != (int)XST_SUCCESS) {
+		return (int)XST_FAILURE;
+	}
+
+	Status = BlkFlashProgram(BlkPtr, SectorAddr + XISF_BLK_HDR_SIZE +
+			(BlkPtr->WbufSlot * 4U), (u8 *)BlkPtr->Tags,
+			BlkPtr->WbufCount * 4U);
+	if (Status != (int)XST_SUCCESS) {
+		return (int)XST_FAILURE;
+	}
+
+	BlkPtr->WbufSlot += BlkPtr->WbufCount;
+	BlkPtr->WbufCount = 0U;
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Makes sure the current sector has a free slot, opening the least erased
+ * sector when needed.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Reserve is the number of erased sectors to leave for the
+ *		garbage collection. Sectors are reclaimed first if needed.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	The write buffer must be empty.
+ *
+ ******************************************************************************/
+static int BlkOpenSector(XIsf_Blk *BlkPtr, u32 Reserve)
+{
+	int Status;
+	u32 Sector;
+	u32 Best;
+	u32 Seq;
+
+	while ((BlkPtr->CurSector == XISF_BLK_UNMAPPED) ||
+		(BlkPtr->Sectors[BlkPtr->CurSector].Used >=
+		 BlkPtr->SlotsPerSector)) {
+		if (BlkPtr->NumErased <= Reserve) {
+			if (Reserve == 0U) {
+				return (int)XST_FAILURE;
+			}
+			BlkPtr->CurSector = XISF_BLK_UNMAPPED;
+			Status = BlkReclaim(BlkPtr);
+			if (Status != (int)XST_SUCCESS) {
+				return (int)XST_FAILURE;
+			}
+			continue;
+		}
+
+		Best = XISF_BLK_UNMAPPED;
+		for (Sector = 0U; Sector < BlkPtr->NumSectors; Sector++) {
+			if ((BlkPtr->Sectors[Sector].State ==
+				XISF_BLK_SECTOR_ERASED) &&
+				((Best == XISF_BLK_UNMAPPED) ||
+				 (BlkPtr->Sectors[Sector].EraseCount <
+				  BlkPtr->Sectors[Best].EraseCount))) {
+				Best = Sector;
+			}
+		}
+
+		Seq = BlkPtr->MaxSeq + 1U;
+		Status = BlkFlashProgram(BlkPtr,
+				XIsf_BlkSectorAddr(BlkPtr, Best) +
+				XISF_BLK_SEQ_OFFSET, (u8 *)&Seq, sizeof(Seq));
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+
+		BlkPtr->MaxSeq = Seq;
+		BlkPtr->Sectors[Best].State = XISF_BLK_SECTOR_USED;
+		BlkPtr->Sectors[Best].Seq = Seq;
+		BlkPtr->NumErased--;
+		BlkPtr->CurSector = Best;
+		BlkPtr->WbufSlot = 0U;
+	}
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Queues one block in the write buffer and updates the block map.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Lba is the logical block.
+ * @param	Buf is the block data.
+ * @param	Reserve is passed to BlkOpenSector().
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	A block already pending is overwritten in place.
+ *
+ ******************************************************************************/
+static int BlkAppend(XIsf_Blk *BlkPtr, u32 Lba, const u8 *Buf, u32 Reserve)
+{
+	int Status;
+	u32 Index;
+	u32 Slot;
+	u32 Old;
+	u32 Slots = BlkPtr->SlotsPerSector;
+
+	Index = BlkFindPending(BlkPtr, Lba);
+	if (Index >= BlkPtr->WbufCount) {
+		if ((BlkPtr->WbufCount == XISF_BLK_WBUF_BLOCKS) ||
+			(BlkPtr->CurSector == XISF_BLK_UNMAPPED) ||
+			(BlkPtr->Sectors[BlkPtr->CurSector].Used >= Slots)) {
+			Status = BlkFlush(BlkPtr);
+			if (Status != (int)XST_SUCCESS) {
+				return (int)XST_FAILURE;
+			}
+			Status = BlkOpenSector(BlkPtr, Reserve);
+			if (Status != (int)XST_SUCCESS) {
+				return (int)XST_FAILURE;
+			}
+			/* Reclaiming may have queued the block again */
+			Index = BlkFindPending(BlkPtr, Lba);
+		}
+	}
+
+	if (Index < BlkPtr->WbufCount) {
+		memcpy(&BlkPtr->WriteBuf[Index * XISF_BLK_SIZE], Buf,
+				XISF_BLK_SIZE);
+		return (int)XST_SUCCESS;
+	}
+
+	Index = BlkPtr->WbufCount;
+	Slot = BlkPtr->WbufSlot + Index;
+	memcpy(&BlkPtr->WriteBuf[Index * XISF_BLK_SIZE], Buf, XISF_BLK_SIZE);
+	BlkPtr->Tags[Index] = Lba;
+	BlkPtr->WbufCount++;
+
+	Old = BlkPtr->Map[Lba];
+	if (Old != XISF_BLK_UNMAPPED) {
+		BlkPtr->Sectors[Old / Slots].Valid--;
+	}
+	BlkPtr->Map[Lba] = (BlkPtr->CurSector * Slots) + Slot;
+	BlkPtr->Sectors[BlkPtr->CurSector].Valid++;
+	BlkPtr->Sectors[BlkPtr->CurSector].Used++;
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Looks a logical block up in the write buffer.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Lba is the logical block.
+ *
+ * @return	Index in the write buffer, WbufCount if not pending.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static u32 BlkFindPending(XIsf_Blk *BlkPtr, u32 Lba)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < BlkPtr->WbufCount; Index++) {
+		if (BlkPtr->Tags[Index] == Lba) {
+			break;
+		}
+	}
+
+	return Index;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Selects the sector to garbage collect, other than the current one.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Cold is TRUE to select the least erased sector, FALSE to select
+ *		the sector with the fewest valid blocks.
+ *
+ * @return	Sector number, XISF_BLK_UNMAPPED if there is none.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static u32 BlkFindVictim(XIsf_Blk *BlkPtr, u32 Cold)
+{
+	u32 Sector;
+	u32 Victim = XISF_BLK_UNMAPPED;
+	XIsf_BlkSector *SecPtr;
+	XIsf_BlkSector *BestPtr = NULL;
+
+	for (Sector = 0U; Sector < BlkPtr->NumSectors; Sector++) {
+		SecPtr = &BlkPtr->Sectors[Sector];
+		if ((SecPtr->State != XISF_BLK_SECTOR_USED) ||
+				(Sector == BlkPtr->CurSector)) {
+			continue;
+		}
+		if ((BestPtr == NULL) ||
+			((Cold == TRUE) ?
+			 (SecPtr->EraseCount < BestPtr->EraseCount) :
+			 (SecPtr->Valid < BestPtr->Valid))) {
+			BestPtr = SecPtr;
+			Victim = Sector;
+		}
+	}
+
+	return Victim;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Returns the number of slots which can be written without reclaiming.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ *
+ * @return	Number of free slots.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static u32 BlkFreeSlots(XIsf_Blk *BlkPtr)
+{
+	u32 Free = BlkPtr->NumErased * BlkPtr->SlotsPerSector;
+
+	if (BlkPtr->CurSector != XISF_BLK_UNMAPPED) {
+		Free += BlkPtr->SlotsPerSector -
+			BlkPtr->Sectors[BlkPtr->CurSector].Used;
+	}
+
+	return Free;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Moves the valid blocks of a sector to the current sector and marks it for
+ * erase.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ * @param	Victim is the sector to collect.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	The copies are programmed before the sector can be erased, so
+ *		an interrupted collection leaves two copies and the newer one
+ *		is used at mount.
+ *
+ ******************************************************************************/
+static int BlkCollect(XIsf_Blk *BlkPtr, u32 Victim)
+{
+	int Status;
+	u32 Lba;
+	u32 Phys;
+	u32 Slots = BlkPtr->SlotsPerSector;
+	u8 *DataPtr;
+
+	for (Lba = 0U; (Lba < BlkPtr->NumBlocks) &&
+			(BlkPtr->Sectors[Victim].Valid > 0U); Lba++) {
+		Phys = BlkPtr->Map[Lba];
+		if ((Phys == XISF_BLK_UNMAPPED) || ((Phys / Slots) != Victim)) {
+			continue;
+		}
+
+		Status = BlkFlashRead(BlkPtr, XIsf_BlkSectorAddr(BlkPtr, Victim) +
+				BlkPtr->DataOffset +
+				((Phys % Slots) * XISF_BLK_SIZE),
+				XISF_BLK_SIZE, &DataPtr);
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+
+		Status = BlkAppend(BlkPtr, Lba, DataPtr, 0U);
+		if (Status != (int)XST_SUCCESS) {
+			return (int)XST_FAILURE;
+		}
+	}
+
+	Status = BlkFlush(BlkPtr);
+	if (Status != (int)XST_SUCCESS) {
+		return (int)XST_FAILURE;
+	}
+
+	BlkPtr->Sectors[Victim].State = XISF_BLK_SECTOR_DIRTY;
+
+	return (int)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Produces an erased sector, collecting the sector with the fewest valid
+ * blocks if no sector is waiting for erase.
+ *
+ * @param	BlkPtr is a pointer to the XIsf_Blk instance.
+ *
+ * @return	XST_SUCCESS if successful, else XST_FAILURE.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static int BlkReclaim(XIsf_Blk *BlkPtr)
+{
+	int Status;
+	u32 Sector;
+	u32 Victim;
+
+	for (Sector = 0U; Sector < BlkPtr->NumSectors; Sector++) {
+		if (BlkPtr->Sectors[Sector].State == XISF_BLK_SECTOR_DIRTY) {
+			return BlkEraseSector(BlkPtr, Sector);
+		}
+	}
+
+	Victim = BlkFindVictim(BlkPtr, FALSE);
+	if ((Victim == XISF_BLK_UNMAPPED) ||
+		(BlkPtr->Sectors[Victim].Valid >= BlkPtr->SlotsPerSector)) {
+		return (int)XST_FAILURE;
+	}
+
+	Status = BlkCollect(BlkPtr, Victim);
+	if (Status != (int)XST_SUCCESS) {
+		return (int)XST_FAILURE;
+	}
+
+	return BlkEraseSector(BlkPtr, Victim);
+}
+
+#endif /* (XPAR_XISF_FLASH_FAMILY != ATMEL) */
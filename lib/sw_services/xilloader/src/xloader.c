@@ -34,6 +34,9 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   07/25/2018 Initial release
+*       adk  10/15/2019 Added PDI header cache and XLoader_LoadPdiImage
+*       adk  10/15/2019 Added boot device stage to the boot timeline
+*       adk  10/15/2019 Partition cache is flushed when a PDI is loaded
 *
 * </pre>
 *
@@ -49,13 +52,33 @@
 /************************** Constant Definitions *****************************/
 
 /**************************** Type Definitions *******************************/
+#ifdef PLM_PDI_HDR_CACHE
+/* Validated headers of a partial PDI loaded from DDR */
+typedef struct {
+	u64 PdiAddr; /**< Address of the PDI in DDR */
+	u32 IsValid; /**< TRUE if the entry holds headers */
+	u32 LastUse; /**< Age stamp, to replace the least recently used */
+	XilPdi_ImgHdrTable ImgHdrTable; /**< Key and cached header table */
+	XilPdi_ImgHdr ImgHdr[XLOADER_PDI_HDR_CACHE_IMGS];
+	XilPdi_PrtnHdr PrtnHdr[XLOADER_PDI_HDR_CACHE_PRTNS];
+} XLoader_PdiHdrCacheEntry;
+#endif
+
 /***************** Macros (Inline Functions) Definitions *********************/
 /************************** Function Prototypes ******************************/
+#ifdef PLM_PDI_HDR_CACHE
+static int XLoader_PdiHdrCacheLookup(XilPdi* PdiPtr);
+static void XLoader_PdiHdrCacheStore(XilPdi* PdiPtr);
+#endif
 
 /************************** Variable Definitions *****************************/
 XilSubsystem SubSystemInfo = {0};
 XilPdi SubsystemPdiIns;
 XilDic Dic;
+#ifdef PLM_PDI_HDR_CACHE
+static XLoader_PdiHdrCacheEntry PdiHdrCache[XLOADER_PDI_HDR_CACHE_ENTRIES];
+static u32 PdiHdrCacheAge;
+#endif
 
 
 /*****************************************************************************/
@@ -162,6 +185,9 @@ int XLoader_PdiInit(XilPdi* PdiPtr, u32 PdiSrc, u64 PdiAddr)
 	u32 RegVal;
 	int Status;
 	XLoader_SecureParms SecureParam = {0U};
+#ifdef PLM_BOOT_TIMELINE
+	u64 DevInitTime;
+#endif
 
 	/**
 	 * Update PDI Ptr with source, addr, meta header
@@ -169,6 +195,14 @@ int XLoader_PdiInit(XilPdi* PdiPtr, u32 PdiSrc, u64 PdiAddr)
 	PdiPtr->PdiSrc = PdiSrc;
 	PdiPtr->PdiAddr = PdiAddr;
 
+#ifdef PLM_PRTN_CACHE
+	/**
+	 * The partition cache is not bound to the partition payload, so the
+	 * copies of a previous PDI are never used for this one
+	 */
+	XLoader_PrtnCacheFlush();
+#endif
+
 	/**
 	 * Mark PDI loading is started.
 	 */
@@ -190,11 +224,18 @@ int XLoader_PdiInit(XilPdi* PdiPtr, u32 PdiSrc, u64 PdiAddr)
 	if ((PdiPtr->SlrType == XLOADER_SSIT_MASTER_SLR) ||
 		(PdiPtr->SlrType == XLOADER_SSIT_MONOLITIC)) {
 		XPlmi_Printf(DEBUG_GENERAL, "Monolithic/Master Device\n\r");
+#ifdef PLM_BOOT_TIMELINE
+		DevInitTime = XPlmi_GetTimerValue();
+#endif
 		Status = DeviceOps[PdiSrc & XLOADER_PDISRC_FLAGS_MASK].Init(PdiSrc);
 		if(Status != XST_SUCCESS)
 		{
 			goto END;
 		}
+#ifdef PLM_BOOT_TIMELINE
+		XPlmi_TlRecord(XPLMI_TL_EVENT_STAGE,
+			XPLMI_TL_STAGE_BOOT_DEVICE, 0U, DevInitTime);
+#endif
 	}
 
 	PdiPtr->DeviceCopy =  DeviceOps[PdiSrc & XLOADER_PDISRC_FLAGS_MASK].Copy;
@@ -259,6 +300,13 @@ int XLoader_PdiInit(XilPdi* PdiPtr, u32 PdiSrc, u64 PdiAddr)
 							Status);
 		goto END;
 	}
+#ifdef PLM_PDI_HDR_CACHE
+	/* Same PDI as a cached one, its headers were already validated */
+	if (XLoader_PdiHdrCacheLookup(PdiPtr) == TRUE) {
+		Status = XST_SUCCESS;
+		goto END;
+	}
+#endif
 	SecureParam.PdiPtr = PdiPtr;
 	/* Is Authentication enabled */
 	if (((PdiPtr->MetaHdr.ImgHdrTable.Attr) &
@@ -331,6 +379,9 @@ int XLoader_PdiInit(XilPdi* PdiPtr, u32 PdiSrc, u64 PdiAddr)
 			Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_PRTNHDR, Status);
 			goto END;
 		}
+#ifdef PLM_PDI_HDR_CACHE
+		XLoader_PdiHdrCacheStore(PdiPtr);
+#endif
 	}
 	else {
 		Status = XLoader_ReadAndVerifySecureHdrs(&SecureParam,
@@ -345,6 +396,136 @@ END:
 	return Status;
 }
 
+#ifdef PLM_PDI_HDR_CACHE
+/*****************************************************************************/
+/**
+ * This function looks up the headers of a partial PDI in DDR in the PDI
+ * header cache. The image header table just read from the PDI must match
+ * the cached one, so a different PDI copied to the same address is not
+ * taken for the cached one.
+ *
+ * @param PdiPtr Pdi instance pointer, with the image header table read
+ *
+ * @return	TRUE if the headers are restored from the cache, else FALSE
+ *
+ *****************************************************************************/
+static int XLoader_PdiHdrCacheLookup(XilPdi* PdiPtr)
+{
+	int Hit = FALSE;
+	u32 Index;
+	XLoader_PdiHdrCacheEntry *Entry;
+	XilPdi_ImgHdrTable *ImgHdrTbl = &PdiPtr->MetaHdr.ImgHdrTable;
+
+	if ((PdiPtr->PdiType != XLOADER_PDI_TYPE_PARTIAL) ||
+		(PdiPtr->PdiSrc != XLOADER_PDI_SRC_DDR)) {
+		goto END;
+	}
+
+	for (Index = 0U; Index < XLOADER_PDI_HDR_CACHE_ENTRIES; ++Index) {
+		Entry = &PdiHdrCache[Index];
+		if ((Entry->IsValid == TRUE) &&
+			(Entry->PdiAddr == PdiPtr->PdiAddr) &&
+			(memcmp(&Entry->ImgHdrTable, ImgHdrTbl,
+				sizeof(XilPdi_ImgHdrTable)) == 0)) {
+			break;
+		}
+	}
+	if (Index == XLOADER_PDI_HDR_CACHE_ENTRIES) {
+		goto END;
+	}
+
+	memcpy(PdiPtr->MetaHdr.ImgHdr, Entry->ImgHdr,
+		ImgHdrTbl->NoOfImgs * sizeof(XilPdi_ImgHdr));
+	memcpy(PdiPtr->MetaHdr.PrtnHdr, Entry->PrtnHdr,
+		ImgHdrTbl->NoOfPrtns * sizeof(XilPdi_PrtnHdr));
+	PdiPtr->MetaHdr.Flag = XILPDI_METAHDR_RD_HDRS_FROM_DEVICE;
+	Entry->LastUse = ++PdiHdrCacheAge;
+	XPlmi_Printf(DEBUG_INFO, "PDI headers found in cache\n\r");
+	Hit = TRUE;
+
+END:
+	return Hit;
+}
+
+/*****************************************************************************/
+/**
+ * This function stores the validated headers of a non secure partial PDI in
+ * DDR in the PDI header cache, replacing the entry of the same address or
+ * the least recently used one. PDIs with more images or partitions than an
+ * entry holds are not cached.
+ *
+ * @param PdiPtr Pdi instance pointer, with the headers validated
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XLoader_PdiHdrCacheStore(XilPdi* PdiPtr)
+{
+	u32 Index;
+	u32 Victim = 0U;
+	XLoader_PdiHdrCacheEntry *Entry;
+	XilPdi_ImgHdrTable *ImgHdrTbl = &PdiPtr->MetaHdr.ImgHdrTable;
+
+	if ((PdiPtr->PdiType != XLOADER_PDI_TYPE_PARTIAL) ||
+		(PdiPtr->PdiSrc != XLOADER_PDI_SRC_DDR) ||
+		(ImgHdrTbl->NoOfImgs > XLOADER_PDI_HDR_CACHE_IMGS) ||
+		(ImgHdrTbl->NoOfPrtns > XLOADER_PDI_HDR_CACHE_PRTNS)) {
+		goto END;
+	}
+
+	for (Index = 0U; Index < XLOADER_PDI_HDR_CACHE_ENTRIES; ++Index) {
+		Entry = &PdiHdrCache[Index];
+		if ((Entry->IsValid != TRUE) ||
+			(Entry->PdiAddr == PdiPtr->PdiAddr)) {
+			Victim = Index;
+			break;
+		}
+		if (Entry->LastUse < PdiHdrCache[Victim].LastUse) {
+			Victim = Index;
+		}
+	}
+
+	Entry = &PdiHdrCache[Victim];
+	Entry->PdiAddr = PdiPtr->PdiAddr;
+	memcpy(&Entry->ImgHdrTable, ImgHdrTbl, sizeof(XilPdi_ImgHdrTable));
+	memcpy(Entry->ImgHdr, PdiPtr->MetaHdr.ImgHdr,
+		ImgHdrTbl->NoOfImgs * sizeof(XilPdi_ImgHdr));
+	memcpy(Entry->PrtnHdr, PdiPtr->MetaHdr.PrtnHdr,
+		ImgHdrTbl->NoOfPrtns * sizeof(XilPdi_PrtnHdr));
+	Entry->LastUse = ++PdiHdrCacheAge;
+	Entry->IsValid = TRUE;
+
+END:
+	return;
+}
+#endif
+
+/*****************************************************************************/
+/**
+ * This function drops the cached headers of the PDI at the given DDR
+ * address. It is to be called when a PDI is rewritten at the same address
+ * with an unchanged image header table.
+ *
+ * @param PdiAddr is the address of the PDI in DDR
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XLoader_PdiHdrCacheInvalidate(u64 PdiAddr)
+{
+#ifdef PLM_PDI_HDR_CACHE
+	u32 Index;
+
+	for (Index = 0U; Index < XLOADER_PDI_HDR_CACHE_ENTRIES; ++Index) {
+		if (PdiHdrCache[Index].PdiAddr == PdiAddr) {
+			PdiHdrCache[Index].IsValid = FALSE;
+		}
+	}
+#else
+	(void)PdiAddr;
+#endif
+}
+
 /*****************************************************************************/
 /**
  * This function is used to load and start the PDI image. It reads meta header,
@@ -389,6 +570,11 @@ int XLoader_LoadAndStartSubSystemPdi(XilPdi *PdiPtr)
 		{
 			goto END;
 		}
+#ifdef PLM_BOOT_TIMELINE
+		XPlmi_TlRecord(XPLMI_TL_EVENT_IMAGE,
+			PdiPtr->MetaHdr.ImgHdr[PdiPtr->ImageNum].ImgID,
+			PdiPtr->ImageNum, ImageLoadTime);
+#endif
 		XPlmi_MeasurePerfTime(ImageLoadTime);
 		XPlmi_Printf(DEBUG_PRINT_PERF,
 			"for Image: %d\n\r", PdiPtr->ImageNum);
@@ -535,6 +721,77 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function loads and starts a single image of a PDI, found by
+ * its image ID in the image headers of the PDI. Only the headers and the
+ * partitions of that image are read.
+ *
+ * @param Pdi instance pointer where PDI details are stored
+ * @param PdiSrc is source of PDI. It can be in Boot Device, DDR
+ * @param PdiAddr is the address at PDI is located in the PDI source
+ *        mentioned
+ * @param ImageId is the ID of the image to load, XLOADER_ALL_IMAGES loads
+ *        the whole PDI as XLoader_LoadPdi
+ *
+ * @return	returns XLOADER_SUCCESS on success
+ *****************************************************************************/
+int XLoader_LoadPdiImage(XilPdi* PdiPtr, u32 PdiSrc, u64 PdiAddr,
+		u32 ImageId)
+{
+	int Status = XST_FAILURE;
+	u32 Index;
+
+	if (ImageId == XLOADER_ALL_IMAGES) {
+		Status = XLoader_LoadPdi(PdiPtr, PdiSrc, PdiAddr);
+		goto RETURN;
+	}
+
+	Status = XLoader_PdiInit(PdiPtr, PdiSrc, PdiAddr);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	/* Partitions of the images are stored one image after the other */
+	for (Index = PdiPtr->ImageNum;
+		Index < PdiPtr->MetaHdr.ImgHdrTable.NoOfImgs; ++Index) {
+		if (PdiPtr->MetaHdr.ImgHdr[Index].ImgID == ImageId) {
+			break;
+		}
+		PdiPtr->PrtnNum += PdiPtr->MetaHdr.ImgHdr[Index].NoOfPrtns;
+	}
+	if (Index == PdiPtr->MetaHdr.ImgHdrTable.NoOfImgs) {
+		Status = XLOADER_ERR_IMG_ID_NOT_FOUND;
+		goto END;
+	}
+	PdiPtr->ImageNum = Index;
+
+	Status = XLoader_LoadImage(PdiPtr, 0xFFFFFFFFU);
+	/** Check for Cfi errors */
+	XLoader_CfiErrorHandler();
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = XLoader_StartImage(PdiPtr);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	/** Mark PDI loading is completed */
+	XPlmi_Out32(PMC_GLOBAL_DONE, XLOADER_PDI_LOAD_COMPLETE);
+
+END:
+	/** Reset the SBI/DMA to clear the buffers */
+	if ((PdiSrc == XLOADER_PDI_SRC_JTAG) ||
+	    (PdiSrc == XLOADER_PDI_SRC_SBI))
+	{
+		XLoader_SbiRecovery();
+	}
+RETURN:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * This function is used to start the subsystems in the PDI.
@@ -34,6 +34,11 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   07/24/2018 Initial release
+*       adk  10/15/2019 Added partition cache macros
+*       adk  10/15/2019 Added XLoader_PrtnCacheFlush
+*       adk  10/15/2019 Added XLoader_IsSbiSrc
+*       adk  10/15/2019 Added XLoader_CfiReadback
+*       adk  10/15/2019 Added XLoader_LoadPdiImage and the PDI header cache
 *
 * </pre>
 *
@@ -63,6 +68,7 @@ extern "C" {
 #include "xcfupmc.h"
 #include "xcframe.h"
 #include "xplmi_proc.h"
+#include "xplmi_timeline.h"
 /************************** Constant Definitions *****************************/
 #define XLOADER_SUCCESS		XST_SUCCESS
 #define XLoader_Printf		XPlmi_Printf
@@ -72,11 +78,20 @@ extern "C" {
 
 #define XLOADER_CHUNK_MEMORY		(XPLMI_PMCRAM_BASEADDR)
 #define XLOADER_CHUNK_MEMORY_1		(XPLMI_PMCRAM_BASEADDR + 0x8100U)
+/** Second buffer for secure blocks that are read ahead, upper half of PRAM */
+#define XLOADER_SECURE_CHUNK_MEMORY_1	(XPLMI_PMCRAM_BASEADDR + 0x10000U)
+/** Bytes a prefetched CDO chunk repeats from the end of the previous one */
+#define XLOADER_CDO_OVERLAP_SIZE	(XPLMI_CDO_OVERLAP_LEN * XIH_PRTN_WORD_LEN)
 #define XLOADER_CHUNK_SIZE			(0x10000U) /** 64K */
 #define XLOADER_CFI_CHUNK_SIZE		(0x40000U) /** 256K */
 #define XLOADER_DMA_LEN_ALIGN           (0x10U)
 #define XLOADER_IMAGE_SEARCH_OFFSET	(0x8000U) /** 32K */
 
+/** DDR holding the copies of the partitions of restartable images */
+#define XLOADER_PRTN_CACHE_BASEADDR	(0x70000000U)
+#define XLOADER_PRTN_CACHE_SIZE		(0x1000000U) /** 16M */
+#define XLOADER_PRTN_CACHE_ENTRIES	(8U)
+
 #define XLOADER_R5_0_TCMA_BASE_ADDR			(0xFFE00000U)
 #define XLOADER_R5_0_TCMB_BASE_ADDR			(0xFFE20000U)
 #define XLOADER_R5_1_TCMA_BASE_ADDR			(0xFFE90000U)
@@ -108,6 +123,16 @@ extern "C" {
 #define XLOADER_MAX_SUBSYSTEMS	10U
 #define XLOADER_RUNNING_CPU_SHIFT	(0x8U)
 #define XLOADER_MAX_DDRCOPYIMGS		(10U)
+/** Image ID to load all the images of a PDI */
+#define XLOADER_ALL_IMAGES		(0xFFFFFFFFU)
+
+/*
+ * PDI header cache, see PLM_PDI_HDR_CACHE. PDIs with more images or
+ * partitions are not cached.
+ */
+#define XLOADER_PDI_HDR_CACHE_ENTRIES	(4U)
+#define XLOADER_PDI_HDR_CACHE_IMGS	(4U)
+#define XLOADER_PDI_HDR_CACHE_PRTNS	(8U)
 
 /*
  * PDI type macros
@@ -272,6 +297,12 @@ typedef struct {
 				    SLAVE_BOOT_SBI_MODE_JTAG_MASK) ? \
 					(TRUE) : (FALSE)
 
+/** PDI sources read through the SBI, which are a stream in PDI order */
+#define XLoader_IsSbiSrc(PdiSrc)	(((PdiSrc) == XLOADER_PDI_SRC_JTAG) || \
+					((PdiSrc) == XLOADER_PDI_SRC_SMAP) || \
+					((PdiSrc) == XLOADER_PDI_SRC_SBI) || \
+					((PdiSrc) == XLOADER_PDI_SRC_PCIE))
+
 /************************** Function Prototypes ******************************/
 extern XilPdi SubsystemPdiIns;
 extern XilDic Dic;
@@ -284,6 +315,9 @@ int XLoader_Init();
 int XLoader_PdiInit(XilPdi* PdiPtr, u32 PdiSrc, u64 PdiAddr);
 int XLoader_LoadAndStartSubSystemPdi(XilPdi *PdiPtr);
 int XLoader_LoadPdi(XilPdi* PdiPtr, u32 PdiSrc, u64 PdiAddr);
+int XLoader_LoadPdiImage(XilPdi* PdiPtr, u32 PdiSrc, u64 PdiAddr,
+		u32 ImageId);
+void XLoader_PdiHdrCacheInvalidate(u64 PdiAddr);
 int XLoader_LoadImage(XilPdi *PdiPtr, u32 ImageId);
 int XLoader_StartImage(XilPdi *PdiPtr);
 int XLoader_RestartImage(u32 ImageId);
@@ -293,11 +327,16 @@ void XLoader_A72Config(u32 CpuId, u32 ExecState, u32 VInitHi);
 void XLoader_ClearIntrSbiDataRdy();
 void XLoader_CfiErrorHandler(void);
 int XLoader_CframeInit();
+int XLoader_CfiReadback(u32 Row, u32 FrameAddr, u32 Len, u64 DestAddr,
+		u64 HashAddr);
 int XLoader_StartDdrcpyImage(u32 ImageId);
 
 /* functions defined in xloader_prtn_load.c */
 int XLoader_LoadImagePrtns(XilPdi* PdiPtr, u32 ImgNum, u32 PrtnNum);
 int XLoader_LoadDdrCpyImgPrtns(XilPdi* PdiPtr, u32 ImgNum, u32 PrtnNum);
+#ifdef PLM_PRTN_CACHE
+void XLoader_PrtnCacheFlush(void);
+#endif
 
 /** Functions defined in xloader_cmds.c */
 void XLoader_CmdsInit(void);
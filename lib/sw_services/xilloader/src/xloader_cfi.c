@@ -34,6 +34,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  bsv   06/17/2019 Initial release
+*       adk   10/15/2019 Added XLoader_CfiReadback to stream PL frames to
+*                        memory and check their SHA3 hash
 *
 * </pre>
 *
@@ -43,12 +45,16 @@
 
 /***************************** Include Files *********************************/
 #include "xloader.h"
+#include "xloader_secure.h"
 #include "xplmi_util.h"
 /************************** Constant Definitions *****************************/
+/** Words read from FDRO by one DMA, the hash of a chunk overlaps the next */
+#define XLOADER_RDBK_CHUNK_WORDS	(XLOADER_CFI_CHUNK_SIZE / 4U)
 
 /**************************** Type Definitions *******************************/
 /***************** Macros (Inline Functions) Definitions *********************/
 /************************** Function Prototypes ******************************/
+static int XLoader_CfiReadbackHash(XSecure_Sha3 *Sha3Ptr, u64 Addr, u32 Len);
 
 /************************** Variable Definitions *****************************/
 XCframe XLoader_CframeIns={0}; /* CFRAME Driver Instance */
@@ -140,3 +146,155 @@ void XLoader_CfiErrorHandler(void)
 				PMC_GLOBAL_PMC_ERR1_STATUS_CFU_MASK,
 				PMC_GLOBAL_PMC_ERR1_STATUS_CFU_MASK);
 }
+
+/*****************************************************************************/
+/**
+ * This function starts the hash of a chunk which was read back
+ *
+ * @param	Sha3Ptr is the SHA3 instance
+ * @param	Addr is the address of the chunk
+ * @param	Len is the length of the chunk in words
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XLoader_CfiReadbackHash(XSecure_Sha3 *Sha3Ptr, u64 Addr, u32 Len)
+{
+	return (int)XSecure_Sha3UpdateStart(Sha3Ptr, (u8 *)(UINTPTR)Addr,
+			Len * XIH_PRTN_WORD_LEN);
+}
+
+/*****************************************************************************/
+/**
+ * This function reads back consecutive configuration frames of a CFRAME row
+ * into memory. The CFRAME read is set up with the register interface and the
+ * FDRO data is moved by PMC DMA1 in chunks of XLOADER_RDBK_CHUNK_WORDS.
+ * When a golden hash is given, PMC DMA0 feeds each chunk to SHA3 while
+ * the next one is read, and the hash of the data is compared with it.
+ *
+ * @param	Row is the CFRAME row, XCFRAME_FRAME_BCAST is not allowed
+ * @param	FrameAddr is the frame address of the first frame
+ * @param	Len is the length to read in words, a multiple of 4
+ * @param	DestAddr is the destination address, 16 byte aligned
+ * @param	HashAddr is the address of the golden SHA3 hash, 0 to skip
+ *		the check. The destination must be below 4GB for the check.
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+int XLoader_CfiReadback(u32 Row, u32 FrameAddr, u32 Len, u64 DestAddr,
+		u64 HashAddr)
+{
+	int Status = XST_FAILURE;
+	XSecure_Sha3 Sha3Instance;
+	XCsuDma *CsuDmaPtr;
+	Xuint128 Value128 = {0U};
+	u32 Hash[XLOADER_SHA3_LEN / 4U];
+	u32 ChunkLen;
+	u32 PrevLen = 0U;
+	u32 Offset = 0U;
+	u32 Index;
+
+	if ((Row >= (u32)XCFRAME_FRAME_BCAST) || (Len == 0U) ||
+		((Len % 4U) != 0U) ||
+		((DestAddr % XLOADER_DMA_LEN_ALIGN) != 0U) ||
+		((HashAddr != 0U) && ((DestAddr + ((u64)Len * 4U)) >
+			(u64)XLOADER_32BIT_MASK))) {
+		Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_RDBK_PARAM, 0);
+		goto END;
+	}
+
+	Status = XLoader_CframeInit();
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	if (HashAddr != 0U) {
+		CsuDmaPtr = XPlmi_GetDmaInstance(CSUDMA_0_DEVICE_ID);
+		if (CsuDmaPtr == NULL) {
+			Status = XST_FAILURE;
+			goto END;
+		}
+		Status = XSecure_Sha3Initialize(&Sha3Instance, CsuDmaPtr);
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+		XSecure_Sha3Start(&Sha3Instance);
+	}
+
+	/* ROWON, RCFG, FAR and frame count of the row */
+	XCframe_WriteCmd(&XLoader_CframeIns, (XCframe_FrameNo)Row,
+			XCFRAME_CMD_REG_ROWON);
+	XCframe_WriteCmd(&XLoader_CframeIns, (XCframe_FrameNo)Row,
+			XCFRAME_CMD_REG_RCFG);
+	Value128.Word0 = FrameAddr;
+	XCframe_WriteReg(&XLoader_CframeIns, XCFRAME_FAR_OFFSET,
+			(XCframe_FrameNo)Row, &Value128);
+	Value128.Word0 = Len / 4U;
+	XCframe_WriteReg(&XLoader_CframeIns, XCFRAME_FRCNT_OFFSET,
+			(XCframe_FrameNo)Row, &Value128);
+
+	XPlmi_SetMaxOutCmds(1U);
+	while (Offset < Len) {
+		ChunkLen = Len - Offset;
+		if (ChunkLen > XLOADER_RDBK_CHUNK_WORDS) {
+			ChunkLen = XLOADER_RDBK_CHUNK_WORDS;
+		}
+
+		Status = XPlmi_DmaXfr(CFU_FDRO_ADDR,
+				DestAddr + ((u64)Offset * 4U), ChunkLen,
+				XPLMI_PMCDMA_1 | XPLMI_SRC_CH_AXI_FIXED |
+				XPLMI_DMA_SRC_NONBLK);
+		if (Status != XST_SUCCESS) {
+			goto END_XFR;
+		}
+
+		/* Hash the previous chunk while this one is read */
+		if (PrevLen != 0U) {
+			Status = XLoader_CfiReadbackHash(&Sha3Instance,
+				DestAddr + ((u64)(Offset - PrevLen) * 4U),
+				PrevLen);
+		}
+		XPlmi_WaitForNonBlkDma();
+		if (Status != XST_SUCCESS) {
+			goto END_XFR;
+		}
+		if (PrevLen != 0U) {
+			Status = (int)XSecure_Sha3UpdateWait(&Sha3Instance);
+			if (Status != XST_SUCCESS) {
+				goto END_XFR;
+			}
+		}
+
+		Offset += ChunkLen;
+		if (HashAddr != 0U) {
+			PrevLen = ChunkLen;
+		}
+	}
+
+	if (HashAddr != 0U) {
+		Status = XLoader_CfiReadbackHash(&Sha3Instance,
+				DestAddr + ((u64)(Offset - PrevLen) * 4U),
+				PrevLen);
+		if (Status != XST_SUCCESS) {
+			goto END_XFR;
+		}
+		Status = (int)XSecure_Sha3Finish(&Sha3Instance, (u8 *)Hash);
+		if (Status != XST_SUCCESS) {
+			goto END_XFR;
+		}
+		for (Index = 0U; Index < (XLOADER_SHA3_LEN / 4U); Index++) {
+			if (Hash[Index] != XPlmi_In64(HashAddr +
+					((u64)Index * 4U))) {
+				Status = XPLMI_UPDATE_STATUS(
+					XLOADER_ERR_RDBK_HASH, 0);
+				break;
+			}
+		}
+	}
+
+END_XFR:
+	XPlmi_SetMaxOutCmds(8U);
+END:
+	return Status;
+}
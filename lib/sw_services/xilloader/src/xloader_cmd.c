@@ -35,6 +35,9 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   03/12/2019 Initial release
 		har  08/28/2019 Fixed MISRA C violations
+*       adk  10/15/2019 Added PL frame readback command
+*       adk  10/15/2019 Added load image by ID command
+*       adk  10/15/2019 Added load handles and get load status command
 * </pre>
 *
 * @note
@@ -45,15 +48,43 @@
 #include "xloader.h"
 #include "xplmi_cmd.h"
 #include "xplmi_modules.h"
+#include "xplmi_task.h"
+#include "xplmi_ipi.h"
 /************************** Constant Definitions *****************************/
+#define XLOADER_LOAD_IMAGE_CMD_ID	(4U)
+/* States of an asynchronous load */
+#define XLOADER_LOAD_STATE_IDLE		(0U)
+#define XLOADER_LOAD_STATE_QUEUED	(1U)
+#define XLOADER_LOAD_STATE_RUNNING	(2U)
+#define XLOADER_LOAD_STATE_DONE		(3U)
+/* Flags of the load image by ID command */
+#define XLOADER_LOAD_FLAG_ASYNC		(0x1U)
+#define XLOADER_LOAD_FLAG_INVALIDATE	(0x2U)
+/* Words of the completion message of an asynchronous load */
+#define XLOADER_ASYNC_MSG_LEN		(4U)
+#define XLOADER_ASYNC_IPI_TIMEOUT	(~0U)
 
 /**************************** Type Definitions *******************************/
+/* Asynchronous load image by ID request */
+typedef struct {
+	XPlmi_TaskNode *Task; /**< Task running the load */
+	u32 State; /**< XLOADER_LOAD_STATE_* */
+	u32 Handle; /**< Handle of the last accepted load, never 0 */
+	int LoadStatus; /**< Status of the load once done */
+	u32 IpiMask; /**< Requester notified on completion */
+	u32 PdiSrc;
+	u64 PdiAddr;
+	u32 ImageId;
+} XLoader_AsyncLoad;
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 
 /************************** Variable Definitions *****************************/
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+static XLoader_AsyncLoad AsyncLoad;
+#endif
 
 /*****************************************************************************/
 
@@ -145,6 +176,245 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function provides PL frame readback command execution
+ *  Command payload parameters are
+ *	* Row - CFRAME row
+ *	* FrameAddr - Frame address of the first frame
+ *	* Len - Length in words, a multiple of 4
+ *	* High Dest Addr
+ *	* Low Dest Addr
+ *	* High Hash Addr - Golden SHA3 hash, 0 to skip the check
+ *	* Low Hash Addr
+ *
+ * @param Pointer to the command structure
+ *
+ * @return Returns the readback status
+ *****************************************************************************/
+static int XLoader_ReadbackFrames(XPlmi_Cmd * Cmd)
+{
+	int Status = XST_FAILURE;
+	u64 DestAddr;
+	u64 HashAddr;
+
+	XPlmi_Printf(DEBUG_DETAILED, "%s \n\r", __func__);
+
+	DestAddr = ((u64 )Cmd->Payload[3] << 32) | (u64 )Cmd->Payload[4];
+	HashAddr = ((u64 )Cmd->Payload[5] << 32) | (u64 )Cmd->Payload[6];
+
+	Status = XLoader_CfiReadback(Cmd->Payload[0], Cmd->Payload[1],
+			Cmd->Payload[2], DestAddr, HashAddr);
+
+	Cmd->Response[0] = Status;
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function loads the image given by ImageId from a subsystem
+ * PDI, or all of its images, and sends the completion message when the
+ * load was asynchronous.
+ *
+ * @param PdiSrc is source of PDI
+ * @param PdiAddr is the address of the PDI in the source
+ * @param ImageId is the image to load, XLOADER_ALL_IMAGES for all
+ *
+ * @return Returns the load status
+ *****************************************************************************/
+static int XLoader_LoadSubsystemImage(u32 PdiSrc, u64 PdiAddr, u32 ImageId)
+{
+	int Status = XST_FAILURE;
+	XilPdi* PdiPtr = &SubsystemPdiIns;
+
+	XPlmi_Printf(DEBUG_INFO, "Subsystem Image 0x%08x Load: Started\n\r",
+			ImageId);
+
+	PdiPtr->PdiType = XLOADER_PDI_TYPE_PARTIAL;
+	Status = XLoader_LoadPdiImage(PdiPtr, PdiSrc, PdiAddr, ImageId);
+	if (Status != XST_SUCCESS)
+	{
+		/* Update the error code */
+		XPlmi_ErrMgr(Status);
+		goto END;
+	}
+
+	XPlmi_Printf(DEBUG_GENERAL, "Subsystem Image Load: Done\n\r");
+END:
+	return Status;
+}
+
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+/*****************************************************************************/
+/**
+ * @brief This function is the task of the asynchronous loads. It loads the
+ * requested image and sends the requester an IPI message with
+ *	* Word 0: Loader module ID << 8 | load image command ID
+ *	* Word 1: Load handle
+ *	* Word 2: ImageId
+ *	* Word 3: Load status
+ *
+ * @param Data is unused
+ *
+ * @return Returns XST_SUCCESS
+ *****************************************************************************/
+static int XLoader_AsyncLoadHandler(void *Data)
+{
+	int Status;
+	u32 Msg[XLOADER_ASYNC_MSG_LEN];
+
+	(void)Data;
+
+	if (AsyncLoad.State != XLOADER_LOAD_STATE_QUEUED) {
+		goto END;
+	}
+
+	AsyncLoad.State = XLOADER_LOAD_STATE_RUNNING;
+	Status = XLoader_LoadSubsystemImage(AsyncLoad.PdiSrc,
+			AsyncLoad.PdiAddr, AsyncLoad.ImageId);
+
+	Msg[0U] = (XPLMI_MODULE_LOADER_ID << 8U) | XLOADER_LOAD_IMAGE_CMD_ID;
+	Msg[1U] = AsyncLoad.Handle;
+	Msg[2U] = AsyncLoad.ImageId;
+	Msg[3U] = (u32)Status;
+	AsyncLoad.LoadStatus = Status;
+	AsyncLoad.State = XLOADER_LOAD_STATE_DONE;
+
+	Status = XPlmi_IpiPollForAck(AsyncLoad.IpiMask,
+			XLOADER_ASYNC_IPI_TIMEOUT);
+	if (Status == XST_SUCCESS) {
+		Status = XPlmi_IpiWrite(AsyncLoad.IpiMask, Msg,
+				XLOADER_ASYNC_MSG_LEN, XIPIPSU_BUF_TYPE_MSG);
+	}
+	if (Status == XST_SUCCESS) {
+		Status = XPlmi_IpiTrigger(AsyncLoad.IpiMask);
+	}
+	if (Status != XST_SUCCESS) {
+		XPlmi_Printf(DEBUG_GENERAL,
+			"Failed to notify the load of image 0x%08x\n\r",
+			Msg[2U]);
+	}
+
+END:
+	return XST_SUCCESS;
+}
+#endif
+
+/*****************************************************************************/
+/**
+ * @brief This function provides load image by ID command execution. Only
+ * the image given by ImageId is loaded and started from the PDI.
+ *  Command payload parameters are
+ *	* PdiSrc - Boot Mode values, DDR, PCIe
+ *	* PdiAddr - 64bit PDI address located in the Source
+ *	* ImageId - Image to load, 0xFFFFFFFF for all the images
+ *	* Flags - Bit 0: return at once and send an IPI message on completion
+ *		  Bit 1: drop the cached headers of the PDI before loading
+ *  An asynchronous load returns its handle in the second response word.
+ *
+ * @param Pointer to the command structure
+ *
+ * @return Returns the load status, or the queuing status if asynchronous
+ *****************************************************************************/
+static int XLoader_LoadImageById(XPlmi_Cmd * Cmd)
+{
+	int Status = XST_FAILURE;
+	u32 PdiSrc;
+	u64 PdiAddr;
+	u32 ImageId;
+	u32 Flags;
+
+	XPlmi_Printf(DEBUG_DETAILED, "%s \n\r", __func__);
+
+	PdiSrc = Cmd->Payload[0];
+	PdiAddr = ((u64 )Cmd->Payload[1] << 32) | (u64 )Cmd->Payload[2];
+	ImageId = Cmd->Payload[3];
+	Flags = Cmd->Payload[4];
+
+	if ((Flags & XLOADER_LOAD_FLAG_INVALIDATE) != 0U) {
+		XLoader_PdiHdrCacheInvalidate(PdiAddr);
+	}
+
+	if ((Flags & XLOADER_LOAD_FLAG_ASYNC) == 0U) {
+		Status = XLoader_LoadSubsystemImage(PdiSrc, PdiAddr, ImageId);
+		goto END;
+	}
+
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+	if ((AsyncLoad.Task == NULL) ||
+		(AsyncLoad.State == XLOADER_LOAD_STATE_QUEUED) ||
+		(AsyncLoad.State == XLOADER_LOAD_STATE_RUNNING) ||
+		(Cmd->IpiMask == 0U)) {
+		Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_ASYNC_LOAD, 0x0U);
+		goto END;
+	}
+	AsyncLoad.IpiMask = Cmd->IpiMask;
+	AsyncLoad.PdiSrc = PdiSrc;
+	AsyncLoad.PdiAddr = PdiAddr;
+	AsyncLoad.ImageId = ImageId;
+	AsyncLoad.LoadStatus = XST_FAILURE;
+	++AsyncLoad.Handle;
+	if (AsyncLoad.Handle == 0U) {
+		AsyncLoad.Handle = 1U;
+	}
+	AsyncLoad.State = XLOADER_LOAD_STATE_QUEUED;
+	XPlmi_TaskTriggerNow(AsyncLoad.Task);
+	Cmd->Response[1] = AsyncLoad.Handle;
+	Status = XST_SUCCESS;
+#else
+	Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_ASYNC_LOAD, 0x0U);
+#endif
+
+END:
+	Cmd->Response[0] = Status;
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function provides get load status command execution. It
+ * reports the progress of the asynchronous load given by its handle.
+ *  Command payload parameters are
+ *	* Handle - Returned by the load image by ID command
+ *  Response words are
+ *	* Word 1: Load state, 0 idle, 1 queued, 2 running, 3 done
+ *	* Word 2: Images processed << 16 | Images in the PDI
+ *	* Word 3: Load status once done
+ *
+ * @param Pointer to the command structure
+ *
+ * @return Returns XST_SUCCESS, or an error if the handle is unknown
+ *
+ * @note The load runs to completion in the PLM task, so a load that was
+ * started reads as queued or done.
+ *****************************************************************************/
+static int XLoader_GetLoadStatus(XPlmi_Cmd * Cmd)
+{
+	int Status = XST_FAILURE;
+
+	XPlmi_Printf(DEBUG_DETAILED, "%s \n\r", __func__);
+
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+	if ((Cmd->Payload[0] == 0U) || (Cmd->Payload[0] != AsyncLoad.Handle)) {
+		Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_ASYNC_LOAD, 0x0U);
+		goto END;
+	}
+
+	Cmd->Response[1] = AsyncLoad.State;
+	Cmd->Response[2] = (SubsystemPdiIns.ImageNum << 16U) |
+		(SubsystemPdiIns.MetaHdr.ImgHdrTable.NoOfImgs & 0xFFFFU);
+	Cmd->Response[3] = (u32)AsyncLoad.LoadStatus;
+	Status = XST_SUCCESS;
+#else
+	Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_ASYNC_LOAD, 0x0U);
+	goto END;
+#endif
+
+END:
+	Cmd->Response[0] = Status;
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * @brief contains the array of PLM loader commands
@@ -154,7 +424,10 @@ static XPlmi_ModuleCmd XLoader_Cmds[] =
 {
 	XPLMI_MODULE_COMMAND(XLoader_Reserved),
 	XPLMI_MODULE_COMMAND(XLoader_LoadSubsystemPdi),
-	XPLMI_MODULE_COMMAND(XLoader_LoadDdrCpyImg)
+	XPLMI_MODULE_COMMAND(XLoader_LoadDdrCpyImg),
+	XPLMI_MODULE_COMMAND(XLoader_ReadbackFrames),
+	XPLMI_MODULE_COMMAND(XLoader_LoadImageById),
+	XPLMI_MODULE_COMMAND(XLoader_GetLoadStatus)
 };
 
 /*****************************************************************************/
@@ -181,4 +454,16 @@ static XPlmi_Module XPlmi_Loader =
 void XLoader_CmdsInit(void)
 {
 	XPlmi_ModuleRegister(&XPlmi_Loader);
+
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+	/* Task for the asynchronous loads, kept between the loads */
+	AsyncLoad.Task = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1,
+			XLoader_AsyncLoadHandler, NULL);
+	if (AsyncLoad.Task != NULL) {
+		AsyncLoad.Task->Flags = XPLMI_TASK_FLAG_PERSISTENT;
+	} else {
+		XPlmi_Printf(DEBUG_GENERAL,
+			"Warning: XLoader_CmdsInit: Failed to create load task\r\n");
+	}
+#endif
 }
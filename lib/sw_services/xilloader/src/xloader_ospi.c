@@ -36,6 +36,8 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  bsv   08/23/2018 Initial release
 * 1.01  bsv   09/10/2019 Added support to set OSPI to DDR mode
+*       adk   10/15/2019 Added non blocking DMA reads and the PLM_OSPI_PERF_TEST
+*                        throughput test
 * </pre>
 *
 * @note
@@ -54,12 +56,20 @@
  * change all the needed parameters in one place.
  */
 
+/* Length read by the throughput test, from the start of the flash */
+#define XLOADER_OSPI_PERF_TEST_LEN	(0x100000U)
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 static int FlashReadID(XOspiPsv *OspiPsvPtr);
+static void XLoader_OspiStatusHandler(void *CallBackRef, u32 StatusEvent);
+static int XLoader_OspiWaitDone(void);
+#ifdef PLM_OSPI_PERF_TEST
+static int XLoader_OspiPerfTest(void);
+#endif
 
 /************************** Variable Definitions *****************************/
 static XOspiPsv OspiPsvInstance;
@@ -68,6 +78,56 @@ u32 StatusCmd;
 u32 OspiFlashMake;
 u32 OspiFlashSize;
 static u8 ReadBuffer[10] __attribute__ ((aligned(32)));
+/* Event reported by the driver for the last non blocking read */
+static u32 OspiStatusEvent = XST_SPI_TRANSFER_DONE;
+
+/*****************************************************************************/
+/**
+ * This function records the completion event of a non blocking read. The
+ * driver calls it from XOspiPsv_IntrHandler, which the loader polls.
+ *
+ * @param	CallBackRef is not used
+ * @param	StatusEvent is the event of the transfer
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XLoader_OspiStatusHandler(void *CallBackRef, u32 StatusEvent)
+{
+	(void) CallBackRef;
+
+	OspiStatusEvent = StatusEvent;
+}
+
+/*****************************************************************************/
+/**
+ * This function waits for the non blocking read in progress, if any. The OSPI
+ * interrupt is not used, XOspiPsv_IntrHandler is polled until the DMA done
+ * status is seen and the transfer is completed.
+ *
+ * @param	None
+ *
+ * @return	XST_SUCCESS if no read failed, error code otherwise
+ *
+ *****************************************************************************/
+static int XLoader_OspiWaitDone(void)
+{
+	int Status = XST_FAILURE;
+
+	while (OspiPsvInstance.IsBusy == TRUE) {
+		(void)XOspiPsv_IntrHandler(&OspiPsvInstance);
+	}
+
+	if (OspiStatusEvent != XST_SPI_TRANSFER_DONE) {
+		OspiStatusEvent = XST_SPI_TRANSFER_DONE;
+		Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_OSPI_READ, XST_FAILURE);
+		goto END;
+	}
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
 /******************************************************************************
 *
 * This function reads serial FLASH ID connected to the SPI interface.
@@ -191,6 +251,10 @@ int XLoader_OspiInit(u32 DeviceFlags)
 		goto END;
 	}
 
+	/* Completion of the non blocking reads is polled */
+	XOspiPsv_SetStatusHandler(OspiPsvInstancePtr, NULL,
+			XLoader_OspiStatusHandler);
+
 	/*
 	 * Enable IDAC controller in OSPI
 	 */
@@ -244,6 +308,10 @@ int XLoader_OspiInit(u32 DeviceFlags)
 
 	XLoader_FlashEnterExit4BAddMode(&OspiPsvInstance, 1U);
 
+#ifdef PLM_OSPI_PERF_TEST
+	Status = XLoader_OspiPerfTest();
+#endif
+
 END:
 	return Status;
 }
@@ -261,6 +329,11 @@ END:
  *
  * @param Length Length of the bytes to be copied
  *
+ * @param Flags XLOADER_DEVICE_COPY_STATE_INITIATE starts the DMA read and
+ * returns, XLOADER_DEVICE_COPY_STATE_WAIT_DONE waits for the read started
+ * before, 0 copies and waits. A read that is still in progress is completed
+ * before a new one is started.
+ *
  * @return
  *		- XLOADER_SUCCESS for successful copy
  *		- errors as mentioned in xloader_error.h
@@ -275,6 +348,13 @@ XStatus XLoader_OspiCopy(u32 SrcAddr, u64 DestAddr, u32 Length, u32 Flags)
 		"Length 0x%0x, Flags 0x%0x\r\n", SrcAddr, (u32)(DestAddr>>32),
 		(u32)(DestAddr), Length, Flags);
 
+	Flags = Flags & XLOADER_DEVICE_COPY_STATE_MASK;
+	Status = XLoader_OspiWaitDone();
+	if ((Status != XST_SUCCESS) ||
+		(Flags == XLOADER_DEVICE_COPY_STATE_WAIT_DONE)) {
+		goto END;
+	}
+
 	/*
 	 * Read cmd
 	 */
@@ -297,7 +377,13 @@ XStatus XLoader_OspiCopy(u32 SrcAddr, u64 DestAddr, u32 Length, u32 Flags)
 		FlashMsg.Dummy = 8U;
 	}
 	
-	Status = XOspiPsv_PollTransfer(&OspiPsvInstance, &FlashMsg);
+	if (Flags == XLOADER_DEVICE_COPY_STATE_INITIATE) {
+		/* Completed by the next copy, XLoader_OspiWaitDone */
+		Status = XOspiPsv_IntrTransfer(&OspiPsvInstance, &FlashMsg);
+	}
+	else {
+		Status = XOspiPsv_PollTransfer(&OspiPsvInstance, &FlashMsg);
+	}
 	if (Status != XST_SUCCESS) {
 		Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_OSPI_READ, Status);
 		goto END;
@@ -319,9 +405,90 @@ END:
 int XLoader_OspiRelease(void)
 {
 	int Status = XST_FAILURE;
+
+	Status = XLoader_OspiWaitDone();
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
 	Status = XLoader_FlashEnterExit4BAddMode(&OspiPsvInstance, 0U);
+
+END:
+	return Status;
+}
+
+#ifdef PLM_OSPI_PERF_TEST
+/*****************************************************************************/
+/**
+ * This function measures the OSPI read throughput. The start of the flash is
+ * read in half PRAM chunks, each read being started as soon as the previous
+ * one is done, as the CDO loading does. The last chunk is then read again
+ * with a blocking read and both copies are compared.
+ *
+ * @param	None
+ *
+ * @return	XST_SUCCESS if the data matches, error code otherwise
+ *
+ *****************************************************************************/
+static int XLoader_OspiPerfTest(void)
+{
+	int Status = XST_FAILURE;
+	u32 ChunkLen = XLOADER_CHUNK_SIZE / 2U;
+	u32 ChunkAddr = XLOADER_CHUNK_MEMORY;
+	u32 OtherAddr;
+	u32 Offset;
+	u64 tStart;
+	u64 tDiff;
+	u32 MBps;
+
+	tStart = XPlmi_GetTimerValue();
+	Status = XLoader_OspiCopy(0U, ChunkAddr, ChunkLen,
+			XLOADER_DEVICE_COPY_STATE_INITIATE);
+	for (Offset = ChunkLen; (Status == XST_SUCCESS) &&
+		(Offset < XLOADER_OSPI_PERF_TEST_LEN); Offset += ChunkLen) {
+		if (ChunkAddr == XLOADER_CHUNK_MEMORY) {
+			ChunkAddr = XLOADER_CHUNK_MEMORY_1;
+		} else {
+			ChunkAddr = XLOADER_CHUNK_MEMORY;
+		}
+		Status = XLoader_OspiCopy(Offset, ChunkAddr, ChunkLen,
+				XLOADER_DEVICE_COPY_STATE_INITIATE);
+	}
+	if (Status == XST_SUCCESS) {
+		Status = XLoader_OspiWaitDone();
+	}
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+	/* Timer counts down */
+	tDiff = tStart - XPlmi_GetTimerValue();
+
+	if (ChunkAddr == XLOADER_CHUNK_MEMORY) {
+		OtherAddr = XLOADER_CHUNK_MEMORY_1;
+	} else {
+		OtherAddr = XLOADER_CHUNK_MEMORY;
+	}
+	Status = XLoader_OspiCopy(XLOADER_OSPI_PERF_TEST_LEN - ChunkLen,
+			OtherAddr, ChunkLen, 0U);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+	if (XPlmi_MemCmp((void *)ChunkAddr, (void *)OtherAddr, ChunkLen) !=
+			XST_SUCCESS) {
+		XLoader_Printf(DEBUG_GENERAL, "OSPI read test data mismatch\n\r");
+		Status = XPLMI_UPDATE_STATUS(XLOADER_ERR_OSPI_READ, XST_FAILURE);
+		goto END;
+	}
+
+	MBps = (u32)(((u64)XLOADER_OSPI_PERF_TEST_LEN * XPlmi_GetPmcIroFreq()) /
+			((tDiff + 1U) * 1000000U));
+	XLoader_Printf(DEBUG_PRINT_ALWAYS, "OSPI %s read: %u MB/s\n\r",
+		(OspiPsvInstance.SdrDdrMode == XOSPIPSV_EDGE_MODE_DDR_PHY) ?
+		"DDR" : "SDR", MBps);
+
+END:
 	return Status;
 }
+#endif
 
 /*****************************************************************************/
 /**
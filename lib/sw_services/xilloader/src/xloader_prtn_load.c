@@ -35,6 +35,14 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/21/2017 Initial release
+*       vns  10/14/2019 Secure CDO blocks of a DDR PDI are read ahead
+*       kc   10/14/2019 DDR CDO chunks overlap so that split commands are
+*                       processed in place
+*       adk  10/15/2019 CDO chunks of an OSPI PDI are read ahead
+*       adk  10/15/2019 Restarted images are copied from the partition
+*                       cache in DDR
+*       adk  10/15/2019 CDO chunks of a SBI PDI are streamed in two buffers
+*       adk  10/15/2019 Added XLoader_PrtnCacheFlush
 *
 * </pre>
 *
@@ -54,6 +62,23 @@
 /************************** Constant Definitions *****************************/
 
 /**************************** Type Definitions *******************************/
+#ifdef PLM_PRTN_CACHE
+/**
+ * Verified copy of a partition in DDR. The hash is of the partition as
+ * it was loaded, it is kept in PMC RAM and checked on every restore.
+ */
+typedef struct {
+	u32 PdiId; /**< PDI the partition belongs to */
+	u32 ImgId; /**< Image the partition belongs to */
+	u32 PrtnNum; /**< Partition number in the PDI */
+	u32 PrtnHdrChecksum; /**< Checksum of the partition header */
+	u64 DestAddr; /**< Address the partition is loaded to */
+	u32 Len; /**< Length of the partition in bytes */
+	u32 CacheAddr; /**< Address of the copy in DDR */
+	u32 Hash[XLOADER_SHA3_LEN/XIH_PRTN_WORD_LEN]; /**< SHA3 of the copy */
+	u32 IsValid; /**< TRUE when the copy can be used */
+} XLoader_PrtnCacheEntry;
+#endif
 
 /***************** Macros (Inline Functions) Definitions *********************/
 #define XLOADER_SUCCESS_NOT_PRTN_OWNER	(0x100U)
@@ -65,8 +90,21 @@ static int XLoader_PrtnValidation(XilPdi* PdiPtr, u32 PrtnNum);
 static int XLoader_CheckHandoffCpu (XilPdi* PdiPtr, u32 DstnCpu);
 static void XLoader_UpdateHandoffParam(XilPdi* PdiPtr, u32 PrtnNum);
 static int XLoader_GetLoadAddr(u32 DstnCpu, u64 *LoadAddrPtr, u32 Len);
+#ifdef PLM_PRTN_CACHE
+static int XLoader_PrtnCacheRestore(XilPdi* PdiPtr, u32 PrtnNum,
+		u64 DestAddr, u32 Len);
+static void XLoader_PrtnCacheSave(XilPdi* PdiPtr, u32 PrtnNum,
+		u64 DestAddr, u32 Len);
+#endif
 
 /************************** Variable Definitions *****************************/
+/** Copies of the DDR copy image partitions that are queued on PMC DMA1 */
+static XPlmi_DmaDesc DdrCpyDesc[XIH_MAX_PRTNS];
+#ifdef PLM_PRTN_CACHE
+static XLoader_PrtnCacheEntry PrtnCache[XLOADER_PRTN_CACHE_ENTRIES];
+/** Next free address of the partition cache */
+static u32 PrtnCacheNext = XLOADER_PRTN_CACHE_BASEADDR;
+#endif
 
 /*****************************************************************************/
 /**
@@ -106,7 +144,26 @@ static int XLoader_DdrCpyPrtnCopy(XilPdi* PdiPtr, u32 PrtnNum)
 	if (Len%XLOADER_DMA_LEN_ALIGN != 0U) {
 		Len = Len + XLOADER_DMA_LEN_ALIGN - (Len%XLOADER_DMA_LEN_ALIGN);
 	}
-		if (SecureParams.SecureEn != TRUE) {
+	if ((SecureParams.SecureEn != TRUE) &&
+	    (PdiPtr->PdiSrc == XLOADER_PDI_SRC_DDR)) {
+		/*
+		 * The copy runs while the next partitions are validated, it is
+		 * waited for at the end of the image
+		 */
+		DdrCpyDesc[PrtnNum].SrcAddr = (u64)SrcAddr;
+		DdrCpyDesc[PrtnNum].DestAddr = DestAddr;
+		DdrCpyDesc[PrtnNum].Len = Len/XIH_PRTN_WORD_LEN;
+		DdrCpyDesc[PrtnNum].Flags = XPLMI_PMCDMA_1;
+		DdrCpyDesc[PrtnNum].Type = XPLMI_DMA_DESC_XFER;
+		DdrCpyDesc[PrtnNum].Callback = NULL;
+		Status = XPlmi_DmaQueueSubmit(&DdrCpyDesc[PrtnNum]);
+		if (XST_SUCCESS != Status)
+		{
+			XPlmi_Printf(DEBUG_GENERAL, "Device Copy Failed \n\r");
+			goto END;
+		}
+	}
+	else if (SecureParams.SecureEn != TRUE) {
 		Status = PdiPtr->MetaHdr.DeviceCopy(SrcAddr, DestAddr, Len, 0x0U);
 		if (XST_SUCCESS != Status)
 		{
@@ -212,6 +269,11 @@ int XLoader_LoadDdrCpyImgPrtns(XilPdi* PdiPtr, u32 ImgNum, u32 PrtnNum)
 		{
 			goto END;
 		}
+#ifdef PLM_BOOT_TIMELINE
+		XPlmi_TlRecord(XPLMI_TL_EVENT_PRTN,
+			PdiPtr->MetaHdr.PrtnHdr[PrtnNum].PrtnId, PrtnNum,
+			PrtnLoadTime);
+#endif
 		XPlmi_MeasurePerfTime(PrtnLoadTime);
 		XPlmi_Printf(DEBUG_PRINT_PERF,
 			" for PrtnNum: %d, Size: %d Bytes\n\r", PrtnNum,
@@ -220,6 +282,8 @@ int XLoader_LoadDdrCpyImgPrtns(XilPdi* PdiPtr, u32 ImgNum, u32 PrtnNum)
 	}
 	Status = XST_SUCCESS;
 END:
+	/* Queued partition copies are done before the image is used */
+	XPlmi_DmaQueueWait();
 	return Status;
 }
 
@@ -271,6 +335,11 @@ int XLoader_LoadImagePrtns(XilPdi* PdiPtr, u32 ImgNum, u32 PrtnNum)
 		{
 			goto END;
 		}
+#ifdef PLM_BOOT_TIMELINE
+		XPlmi_TlRecord(XPLMI_TL_EVENT_PRTN,
+			PdiPtr->MetaHdr.PrtnHdr[PrtnNum].PrtnId, PrtnNum,
+			PrtnLoadTime);
+#endif
 		XPlmi_MeasurePerfTime(PrtnLoadTime);
 		XPlmi_Printf(DEBUG_PRINT_PERF,
 			" for PrtnNum: %d, Size: %d Bytes\n\r", PrtnNum,
@@ -344,12 +413,6 @@ static int XLoader_PrtnCopy(XilPdi* PdiPtr, u32 PrtnNum)
 	XLoader_SecureParms SecureParams = {0U};
 	u32 Mode=0;
 
-	/* Secure init */
-	Status = XLoader_SecureInit(&SecureParams, PdiPtr, PrtnNum);
-	if (Status != XST_SUCCESS) {
-		goto END;
-	}
-
 	/* Assign the partition header to local variable */
 	PrtnHdr = &(PdiPtr->MetaHdr.PrtnHdr[PrtnNum]);
 
@@ -434,6 +497,23 @@ static int XLoader_PrtnCopy(XilPdi* PdiPtr, u32 PrtnNum)
 		}
 	}
 
+#ifdef PLM_PRTN_CACHE
+	/*
+	 * A restarted image is copied from its verified copy in DDR, it is
+	 * loaded from the boot device only if there is no valid copy
+	 */
+	Status = XLoader_PrtnCacheRestore(PdiPtr, PrtnNum, DestAddr, Len);
+	if (XST_SUCCESS == Status) {
+		goto END;
+	}
+#endif
+
+	/* Secure init */
+	Status = XLoader_SecureInit(&SecureParams, PdiPtr, PrtnNum);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
 	if (SecureParams.SecureEn != TRUE) {
 		Status = PdiPtr->MetaHdr.DeviceCopy(SrcAddr, DestAddr, Len, 0x0U);
 		if (XST_SUCCESS != Status)
@@ -449,6 +529,13 @@ static int XLoader_PrtnCopy(XilPdi* PdiPtr, u32 PrtnNum)
 		}
 	}
 
+#ifdef PLM_PRTN_CACHE
+	/* Decrypted partitions are not kept in DDR */
+	if (SecureParams.IsEncrypted != TRUE) {
+		XLoader_PrtnCacheSave(PdiPtr, PrtnNum, DestAddr, Len);
+	}
+#endif
+
 END:
 	return Status;
 }
@@ -588,6 +675,7 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 	u32 LastChunk = FALSE;
 	u32 ChunkAddr = XLOADER_CHUNK_MEMORY;
 	u32 IsNextChunkCopyStarted = FALSE;
+	u32 IsSbiSrc;
 	XLoader_SecureParms SecureParams = {0U};
 
 	XPlmi_Printf(DEBUG_INFO, "Processing CDO partition \n\r");
@@ -629,7 +717,10 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 	 * Process CDO in chunks.
 	 * Chunk size is based on the available PRAM size.
 	 */
-	if ((PdiPtr->PdiSrc == XLOADER_PDI_SRC_DDR) &&
+	IsSbiSrc = XLoader_IsSbiSrc(PdiPtr->PdiSrc);
+	if (((PdiPtr->PdiSrc == XLOADER_PDI_SRC_DDR) ||
+		(PdiPtr->PdiSrc == XLOADER_PDI_SRC_OSPI) ||
+		(IsSbiSrc == TRUE)) &&
 		(SecureParams.SecureEn != TRUE))
 	{
 		ChunkLen = XLOADER_CHUNK_SIZE/2;
@@ -638,6 +729,7 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 	}
 
 	SecureParams.IsCdo = TRUE;
+	SecureParams.UnprocessedLen = Len;
 	while (Len > 0U)
 	{
 		/** Update the len for last chunk */
@@ -652,21 +744,28 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 			{
 				IsNextChunkCopyStarted = FALSE;
 				/** wait for copy to get completed */
-				PdiPtr->DeviceCopy(SrcAddr,
-				  ChunkAddr, ChunkLen,
+				PdiPtr->DeviceCopy(SrcAddr - XLOADER_CDO_OVERLAP_SIZE,
+				  ChunkAddr, ChunkLen + XLOADER_CDO_OVERLAP_SIZE,
 				  XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
+				Cdo.BufPtr = (u32 *)ChunkAddr;
+				Cdo.BufLen = (ChunkLen + XLOADER_CDO_OVERLAP_SIZE)/
+						XIH_PRTN_WORD_LEN;
+				Cdo.OverlapLen = XPLMI_CDO_OVERLAP_LEN;
 			} else {
 				/** Copy the data to PRAM buffer */
 				PdiPtr->DeviceCopy(SrcAddr, ChunkAddr, ChunkLen, 0U);
+				Cdo.BufPtr = (u32 *)ChunkAddr;
+				Cdo.BufLen = ChunkLen/XIH_PRTN_WORD_LEN;
+				Cdo.OverlapLen = 0U;
 			}
 			/** Update variables for next chunk */
-			Cdo.BufPtr = (u32 *)ChunkAddr;
-			Cdo.BufLen = ChunkLen/XIH_PRTN_WORD_LEN;
 			SrcAddr += ChunkLen;
 			Len -= ChunkLen;
-			/** For DDR case, start the copy of the
+			/** For DDR, OSPI and SBI, start the copy of the
 			 * next chunk for increasing performance */
-			if ((PdiPtr->PdiSrc == XLOADER_PDI_SRC_DDR)
+			if (((PdiPtr->PdiSrc == XLOADER_PDI_SRC_DDR) ||
+			     (PdiPtr->PdiSrc == XLOADER_PDI_SRC_OSPI) ||
+			     (IsSbiSrc == TRUE))
 			    && (LastChunk != TRUE))
 			{
 				/** Update the next chunk address to other part */
@@ -684,10 +783,31 @@ static int XLoader_ProcessCdo (XilPdi* PdiPtr, u32 PrtnNum)
 				}
 				IsNextChunkCopyStarted = TRUE;
 
-				/** Initiate the data copy */
-				PdiPtr->DeviceCopy(SrcAddr,
-					   ChunkAddr, ChunkLen,
+				/**
+				 * Initiate the data copy. The chunk starts with
+				 * the end of the current one, so that a command
+				 * split between them is contiguous in PRAM.
+				 * The SBI data can't be read twice, its overlap
+				 * is copied from the current chunk and the SBI
+				 * DMA fills the rest of the buffer while the
+				 * current chunk is processed.
+				 */
+				if (IsSbiSrc == TRUE) {
+					(void)memcpy((void *)ChunkAddr,
+						&Cdo.BufPtr[Cdo.BufLen -
+						XPLMI_CDO_OVERLAP_LEN],
+						XLOADER_CDO_OVERLAP_SIZE);
+					PdiPtr->DeviceCopy(SrcAddr,
+					   ChunkAddr + XLOADER_CDO_OVERLAP_SIZE,
+					   ChunkLen,
 					   XLOADER_DEVICE_COPY_STATE_INITIATE);
+				} else {
+					PdiPtr->DeviceCopy(SrcAddr -
+					   XLOADER_CDO_OVERLAP_SIZE,
+					   ChunkAddr,
+					   ChunkLen + XLOADER_CDO_OVERLAP_SIZE,
+					   XLOADER_DEVICE_COPY_STATE_INITIATE);
+				}
 			}
 		} else {
 			/* Call security function */
@@ -771,6 +891,265 @@ END:
 	return Status;
 }
 
+#ifdef PLM_PRTN_CACHE
+/*****************************************************************************/
+/**
+ * This function calculates the SHA3 hash of a loaded partition
+ *
+ * @param	Addr is the address of the partition
+ *
+ * @param	Len is the length of the partition in bytes
+ *
+ * @param	Hash is the buffer the hash is stored in
+ *
+ * @return	returns XST_SUCCESS on success
+ *
+ *****************************************************************************/
+static int XLoader_PrtnCacheHash(u32 Addr, u32 Len, u32 *Hash)
+{
+	int Status = XST_FAILURE;
+	XSecure_Sha3 Sha3Instance;
+	XCsuDma *CsuDmaPtr;
+
+	CsuDmaPtr = XPlmi_GetDmaInstance(CSUDMA_0_DEVICE_ID);
+	if (CsuDmaPtr == NULL) {
+		goto END;
+	}
+
+	Status = XSecure_Sha3Initialize(&Sha3Instance, CsuDmaPtr);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = (int)XSecure_Sha3Digest(&Sha3Instance, (u8 *)(UINTPTR)Addr,
+			Len, (u8 *)Hash);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function drops all the cached partitions and reclaims the cache
+ * memory. It is called when a new PDI is loaded, as the cache entries only
+ * hold the headers of the partitions and not a hash of the payload read
+ * from the boot device.
+ *
+ * @param	None
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XLoader_PrtnCacheFlush(void)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < XLOADER_PRTN_CACHE_ENTRIES; Index++) {
+		PrtnCache[Index].IsValid = FALSE;
+		PrtnCache[Index].Len = 0U;
+	}
+	PrtnCacheNext = XLOADER_PRTN_CACHE_BASEADDR;
+}
+
+/*****************************************************************************/
+/**
+ * This function looks up the cached copy of a partition. The copy is used
+ * only if it was made from the same partition header of the same PDI and
+ * is loaded to the same address. The cache is flushed whenever a PDI is
+ * loaded, so the copy is always of the PDI the headers were read from.
+ *
+ * @param	PdiPtr is pointer to the XLoader Instance
+ *
+ * @param	PrtnNum is the partition number in the PDI
+ *
+ * @param	DestAddr is the address the partition is loaded to
+ *
+ * @param	Len is the length of the partition in bytes
+ *
+ * @return	pointer to the cache entry, NULL if the partition is not cached
+ *
+ *****************************************************************************/
+static XLoader_PrtnCacheEntry *XLoader_PrtnCacheLookup(XilPdi* PdiPtr,
+		u32 PrtnNum, u64 DestAddr, u32 Len)
+{
+	XLoader_PrtnCacheEntry *Entry = NULL;
+	u32 Index;
+
+	for (Index = 0U; Index < XLOADER_PRTN_CACHE_ENTRIES; Index++) {
+		if ((PrtnCache[Index].IsValid == TRUE) &&
+		    (PrtnCache[Index].PdiId == PdiPtr->PdiId) &&
+		    (PrtnCache[Index].ImgId == PdiPtr->CurImgId) &&
+		    (PrtnCache[Index].PrtnNum == PrtnNum)) {
+			Entry = &PrtnCache[Index];
+			break;
+		}
+	}
+
+	if ((Entry != NULL) &&
+	    ((Entry->PrtnHdrChecksum !=
+	      PdiPtr->MetaHdr.PrtnHdr[PrtnNum].Checksum) ||
+	     (Entry->DestAddr != DestAddr) || (Entry->Len != Len))) {
+		/* The partition changed, its copy is stale */
+		Entry->IsValid = FALSE;
+		Entry = NULL;
+	}
+
+	return Entry;
+}
+
+/*****************************************************************************/
+/**
+ * This function loads a partition from its cached copy in DDR. The loaded
+ * partition is hashed and compared with the hash taken when it was cached,
+ * so that a copy modified in DDR is never used.
+ *
+ * @param	PdiPtr is pointer to the XLoader Instance
+ *
+ * @param	PrtnNum is the partition number in the PDI
+ *
+ * @param	DestAddr is the address the partition is loaded to
+ *
+ * @param	Len is the length of the partition in bytes
+ *
+ * @return	returns XST_SUCCESS if the partition is loaded from the cache
+ *			XST_FAILURE if it must be loaded from the boot device
+ *
+ *****************************************************************************/
+static int XLoader_PrtnCacheRestore(XilPdi* PdiPtr, u32 PrtnNum,
+		u64 DestAddr, u32 Len)
+{
+	int Status = XST_FAILURE;
+	XLoader_PrtnCacheEntry *Entry;
+	u32 Hash[XLOADER_SHA3_LEN/XIH_PRTN_WORD_LEN];
+	u32 Index;
+	u32 Diff = 0U;
+
+	Entry = XLoader_PrtnCacheLookup(PdiPtr, PrtnNum, DestAddr, Len);
+	if (Entry == NULL) {
+		goto END;
+	}
+
+	Status = XPlmi_DmaXfr((u64)Entry->CacheAddr, DestAddr,
+			Len/XIH_PRTN_WORD_LEN, XPLMI_PMCDMA_0);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	/* The hash is taken on the destination, which is no longer in DDR */
+	Status = XLoader_PrtnCacheHash((u32)DestAddr, Len, Hash);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	for (Index = 0U; Index < (XLOADER_SHA3_LEN/XIH_PRTN_WORD_LEN);
+			Index++) {
+		Diff |= Hash[Index] ^ Entry->Hash[Index];
+	}
+	if (Diff != 0U) {
+		XPlmi_Printf(DEBUG_GENERAL, "Cached copy of Prtn 0x%0x is "
+			"corrupted, loading it from the boot device\n\r",
+			PrtnNum);
+		Entry->IsValid = FALSE;
+		Status = XST_FAILURE;
+		goto END;
+	}
+
+	XPlmi_Printf(DEBUG_INFO, "Prtn 0x%0x restored from 0x%08x\n\r",
+			PrtnNum, Entry->CacheAddr);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function keeps a copy of a partition of a full PDI image in DDR,
+ * with the hash of the partition as it was loaded. Partitions loaded above
+ * 4GB and partitions which do not fit in the cache are not cached.
+ *
+ * @param	PdiPtr is pointer to the XLoader Instance
+ *
+ * @param	PrtnNum is the partition number in the PDI
+ *
+ * @param	DestAddr is the address the partition is loaded to
+ *
+ * @param	Len is the length of the partition in bytes
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XLoader_PrtnCacheSave(XilPdi* PdiPtr, u32 PrtnNum,
+		u64 DestAddr, u32 Len)
+{
+	int Status;
+	XLoader_PrtnCacheEntry *Entry = NULL;
+	u32 CacheAddr = 0U;
+	u32 Index;
+
+	if ((PdiPtr->PdiType == XLOADER_PDI_TYPE_PARTIAL) ||
+	    ((DestAddr + Len) > XLOADER_32BIT_MASK)) {
+		goto END;
+	}
+
+	if (XLoader_PrtnCacheLookup(PdiPtr, PrtnNum, DestAddr, Len) != NULL) {
+		goto END;
+	}
+
+	/*
+	 * A stale copy of the same partition is overwritten, other stale
+	 * copies are kept as the cache memory is not reclaimed
+	 */
+	for (Index = 0U; Index < XLOADER_PRTN_CACHE_ENTRIES; Index++) {
+		if ((PrtnCache[Index].PdiId == PdiPtr->PdiId) &&
+		    (PrtnCache[Index].ImgId == PdiPtr->CurImgId) &&
+		    (PrtnCache[Index].PrtnNum == PrtnNum) &&
+		    (PrtnCache[Index].Len == Len)) {
+			Entry = &PrtnCache[Index];
+			CacheAddr = Entry->CacheAddr;
+			break;
+		}
+	}
+	if (Entry == NULL) {
+		for (Index = 0U; Index < XLOADER_PRTN_CACHE_ENTRIES; Index++) {
+			if (PrtnCache[Index].Len == 0U) {
+				Entry = &PrtnCache[Index];
+				break;
+			}
+		}
+		if ((Entry == NULL) || (Len > (XLOADER_PRTN_CACHE_BASEADDR +
+				XLOADER_PRTN_CACHE_SIZE - PrtnCacheNext))) {
+			goto END;
+		}
+		CacheAddr = PrtnCacheNext;
+		PrtnCacheNext += Len;
+	}
+	Entry->IsValid = FALSE;
+	Entry->PdiId = PdiPtr->PdiId;
+	Entry->ImgId = PdiPtr->CurImgId;
+	Entry->PrtnNum = PrtnNum;
+	Entry->Len = Len;
+	Entry->CacheAddr = CacheAddr;
+
+	Status = XLoader_PrtnCacheHash((u32)DestAddr, Len, Entry->Hash);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = XPlmi_DmaXfr(DestAddr, (u64)CacheAddr,
+			Len/XIH_PRTN_WORD_LEN, XPLMI_PMCDMA_0);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	Entry->PrtnHdrChecksum = PdiPtr->MetaHdr.PrtnHdr[PrtnNum].Checksum;
+	Entry->DestAddr = DestAddr;
+	Entry->IsValid = TRUE;
+
+END:
+	return;
+}
+#endif
+
 /*****************************************************************************/
 /**
  * This function updates the load address based on the destination CPU
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   09/21/2017 Initial release
+* 1.01  adk  10/15/2019 Added non blocking copy for streaming CDO chunks
 *
 * </pre>
 *
@@ -166,6 +167,11 @@ int XLoader_SlaveSbiConfig(u64 SlrBaseAddr)
  *
  * @param Length Length of the bytes to be copied
  *
+ * @param Flags XLOADER_DEVICE_COPY_STATE_INITIATE starts the copy and
+ * returns, XLOADER_DEVICE_COPY_STATE_WAIT_DONE waits for the copy started.
+ * The SBI keeps the host waiting until the DMA reads its buffer, so the
+ * copy of a chunk can be started before the previous one is processed.
+ *
  * @return
  *		- XLOADER_SUCCESS for successful copy
  *		- errors as mentioned in xloader_error.h
@@ -175,15 +181,33 @@ XStatus XLoader_SbiCopy(u32 SrcAddress, u64 DestAddress, u32 Length, u32 Flags)
 {
 	int Status = XST_FAILURE;
 	u32 ReadFlags;
+	u32 State;
 
 	/**
 	 * This parameter is required as per the prototype
 	 */
 	(void) (SrcAddress);
 
+	State = Flags & XLOADER_DEVICE_COPY_STATE_MASK;
+	Flags &= ~XLOADER_DEVICE_COPY_STATE_MASK;
+
+	/** Just wait for the Data to be copied */
+	if (State == XLOADER_DEVICE_COPY_STATE_WAIT_DONE)
+	{
+		XPlmi_WaitForNonBlkDma();
+		Status = XST_SUCCESS;
+		goto END;
+	}
+
 	ReadFlags = Flags | XPLMI_PMCDMA_1;
+	/** Update the flags for NON blocking DMA call */
+	if (State == XLOADER_DEVICE_COPY_STATE_INITIATE)
+	{
+		ReadFlags |= XPLMI_DMA_SRC_NONBLK;
+	}
 	Status = XPlmi_SbiDmaXfer(DestAddress, Length/4, ReadFlags);
 
+END:
 	return Status;
 }
 
@@ -35,6 +35,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   09/21/2017 Initial release
+* 1.01  adk  10/15/2019 Boot file is opened in fast seek mode and read with
+*                       f_read_at
 *
 * </pre>
 *
@@ -57,6 +59,8 @@
 #define XLOADER_NUM_DIGITS_IN_FILE_NAME 	4
 #define XLOADER_SD_DRV_NUM_0				0
 #define XLOADER_SD_DRV_NUM_1				1
+/** Fragments of the boot file kept in the fast seek table */
+#define XLOADER_SD_MAX_FRAGMENTS		32U
 
 /**
  * PMC_GLOBAL Base Address
@@ -82,6 +86,10 @@ static u32 XLoader_GetDrvNumSD(u32 DeviceFlags);
 
 static FIL fil;		/* File object */
 static FATFS fatfs;
+#if FF_USE_FASTSEEK
+/* Cluster link map table of the boot file */
+static DWORD SdClmt[FF_CLMT_ITEMS(XLOADER_SD_MAX_FRAGMENTS)];
+#endif
 
 /*****************************************************************************/
 /**
@@ -230,7 +238,20 @@ int XLoader_SdInit(u32 DeviceFlags)
 	XLoader_MakeSdFileName(boot_file, MultiBootOffset, DrvNum);
 
 	if(boot_file[0]!=0) {
+#if FF_USE_FASTSEEK
+		/**
+		 * Map the fragments of the boot file once, the copies then
+		 * read each fragment with one multi block read. A boot file
+		 * with more fragments is read cluster by cluster.
+		 */
+		rc = f_open_fastseek(&fil, boot_file, (BYTE)FA_READ, SdClmt,
+				FF_CLMT_ITEMS(XLOADER_SD_MAX_FRAGMENTS));
+		if (rc == FR_NOT_ENOUGH_CORE) {
+			rc = f_open(&fil, boot_file, (BYTE)FA_READ);
+		}
+#else
 		rc = f_open(&fil, boot_file, (BYTE)FA_READ);
+#endif
 		if (rc!=FR_OK) {
 			XLoader_Printf(DEBUG_INFO,
 					"SD: Unable to open file %s: %d\n", boot_file, rc);
@@ -285,7 +306,9 @@ XStatus XLoader_SdCopy(u32 SrcAddress, u64 DestAddress, u32 Length, u32 Flags)
 		goto END;
 	}
 
-	rc = f_read(&fil, (void*)DestAddress, Length, &br);
+	/* Whole sectors go from the card to DestAddress by ADMA2 */
+	rc = f_read_at(&fil, SrcAddress, (void*)(UINTPTR)DestAddress,
+			Length, &br);
 
 	if (rc != FR_OK) {
 		XLoader_Printf(DEBUG_GENERAL,
@@ -37,6 +37,9 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   vns  04/23/19 First release
 *       har  08/22/19 Fixed MISRA C violations
+*       vns  10/14/19 Read the next block of a DDR PDI while the current block
+*                     is authenticated and decrypted
+*       adk  10/15/19 Read ahead also for a PDI in OSPI flash
 * </pre>
 *
 * @note
@@ -86,6 +89,8 @@ static u32 XLoader_ReadHdrs(XLoader_SecureParms *SecurePtr,
 			XilPdi_MetaHdr *MetaHdr, u64 BufferAddr);
 static u32 XLoader_DecHdrs(XLoader_SecureParms *SecurePtr,
 				XilPdi_MetaHdr *MetaHdr, u64 BufferAddr);
+static void XLoader_StartNextBlkCopy(XLoader_SecureParms *SecurePtr,
+		u32 NextBlkAddr, u32 BlockSize, u32 DataLen, u32 HashLen);
 static u32 XLoader_AuthNDecHdrs(XLoader_SecureParms *SecurePtr,
 				XilPdi_MetaHdr *MetaHdr, u64 BufferAddr);
 
@@ -224,6 +229,7 @@ u32 XLoader_SecureCopy(XLoader_SecureParms *SecurePtr, u64 DestAddr, u32 Size)
 	u32 ClrStatus = XST_FAILURE;
 
 	ChunkLen = XLOADER_CHUNK_SIZE;
+	SecurePtr->UnprocessedLen = Size;
 
 	while (Len > 0U)
 	{
@@ -297,13 +303,21 @@ u32 XLoader_SecurePrtn(XLoader_SecureParms *SecurePtr, u64 DstAddr,
 	u32 Status = (u32)XST_FAILURE;
 	u32 ClrStatus = (u32)XST_FAILURE;
 	u32 TotalSize = BlockSize;
+	u32 DataLen = BlockSize;
+	u32 HashLen = 0U;
 	u32 SrcAddr;
 	u64 OutAddr;
+#ifdef PLM_BOOT_TIMELINE
+	u64 StageTime;
+#endif
 
 	XPlmi_Printf(DEBUG_DETAILED,
 			"Processing Block %d \n\r", SecurePtr->BlockNum);
 	/* 1st block */
 	if (SecurePtr->BlockNum == 0x0) {
+#ifdef PLM_BOOT_TIMELINE
+		SecurePtr->PrtnStartTime = XPlmi_GetTimerValue();
+#endif
 		SrcAddr = SecurePtr->PdiPtr->MetaHdr.FlashOfstAddr +
 		((SecurePtr->PrtnHdr->DataWordOfst) * XIH_PRTN_WORD_LEN);
 		if (SecurePtr->IsEncrypted == TRUE) {
@@ -337,14 +351,44 @@ u32 XLoader_SecurePrtn(XLoader_SecureParms *SecurePtr, u64 DstAddr,
 		 */
 		if (Last != TRUE) {
 			TotalSize = TotalSize + XLOADER_SHA3_LEN;
+			HashLen = XLOADER_SHA3_LEN;
 		}
+		DataLen = TotalSize - HashLen;
 
-		/* Copy to total data to the buffer */
-		SecurePtr->PdiPtr->DeviceCopy(SrcAddr,
-				SecurePtr->ChunkAddr, TotalSize, 0U);
+		/*
+		 * The hash of the next block is kept apart from the data, so that
+		 * the data of a block fits in one half of PRAM
+		 */
+		if (SecurePtr->IsNextBlkCopyStarted == TRUE) {
+			/* Data was read while the previous block was processed */
+			SecurePtr->IsNextBlkCopyStarted = FALSE;
+			SecurePtr->PdiPtr->DeviceCopy(SrcAddr + HashLen,
+				SecurePtr->NextChunkAddr, DataLen,
+				XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
+			SecurePtr->ChunkAddr = SecurePtr->NextChunkAddr;
+		}
+		else {
+			SecurePtr->ChunkAddr = XLOADER_CHUNK_MEMORY;
+			SecurePtr->PdiPtr->DeviceCopy(SrcAddr + HashLen,
+				SecurePtr->ChunkAddr, DataLen, 0U);
+		}
+		if (Last != TRUE) {
+			SecurePtr->PdiPtr->DeviceCopy(SrcAddr,
+				(UINTPTR)SecurePtr->NextBlkHash, HashLen, 0U);
+		}
+
+		/* Read the next block while this one is verified */
+		XLoader_StartNextBlkCopy(SecurePtr, SrcAddr + TotalSize,
+				BlockSize, DataLen, XLOADER_SHA3_LEN);
 
 		/* Verify hash */
+#ifdef PLM_BOOT_TIMELINE
+		StageTime = XPlmi_GetTimerValue();
+#endif
 		Status = XLoader_VerifyHash(SecurePtr, TotalSize, Last);
+#ifdef PLM_BOOT_TIMELINE
+		SecurePtr->HashTime += StageTime - XPlmi_GetTimerValue();
+#endif
 		if (Status != XST_SUCCESS) {
 			goto END;
 		}
@@ -367,11 +411,26 @@ u32 XLoader_SecurePrtn(XLoader_SecureParms *SecurePtr, u64 DstAddr,
 				TotalSize = TotalSize + XLOADER_SECURE_HDR_TOTAL_SIZE;
 			}
 
-			SecurePtr->PdiPtr->DeviceCopy(SrcAddr,
-				SecurePtr->ChunkAddr, TotalSize, 0U);
+			DataLen = TotalSize;
+			if (SecurePtr->IsNextBlkCopyStarted == TRUE) {
+				/* Data was read while the previous block was decrypted */
+				SecurePtr->IsNextBlkCopyStarted = FALSE;
+				SecurePtr->PdiPtr->DeviceCopy(SrcAddr,
+					SecurePtr->NextChunkAddr, TotalSize,
+					XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
+				SecurePtr->ChunkAddr = SecurePtr->NextChunkAddr;
+			}
+			else {
+				SecurePtr->PdiPtr->DeviceCopy(SrcAddr,
+					SecurePtr->ChunkAddr, TotalSize, 0U);
+			}
 			SecurePtr->SecureData = SecurePtr->ChunkAddr;
 			SecurePtr->SecureDataLen = TotalSize;
 			SecurePtr->NextBlkAddr = SrcAddr + TotalSize;
+
+			/* Read the next block while this one is decrypted */
+			XLoader_StartNextBlkCopy(SecurePtr, SrcAddr + TotalSize,
+					BlockSize, DataLen, 0U);
 		}
 
 		if (SecurePtr->IsCdo != TRUE) {
@@ -380,20 +439,55 @@ u32 XLoader_SecurePrtn(XLoader_SecureParms *SecurePtr, u64 DstAddr,
 		else {
 			OutAddr = SecurePtr->SecureData;
 		}
+#ifdef PLM_BOOT_TIMELINE
+		StageTime = XPlmi_GetTimerValue();
+#endif
 		Status = XLoader_AesDecryption(SecurePtr,
 				SecurePtr->SecureData, OutAddr, SecurePtr->SecureDataLen);
+#ifdef PLM_BOOT_TIMELINE
+		SecurePtr->AesTime += StageTime - XPlmi_GetTimerValue();
+#endif
 		if (Status != XST_SUCCESS) {
 			goto END;
 		}
 
 	}
 
+#ifdef PLM_BOOT_TIMELINE
+	/* Time spent in each secure stage over all the blocks */
+	if (Last == TRUE) {
+		if (SecurePtr->HashTime != 0U) {
+			XPlmi_TlRecordDuration(XPLMI_TL_EVENT_SECURE_HASH,
+				SecurePtr->PrtnHdr->PrtnId, SecurePtr->BlockNum + 1U,
+				SecurePtr->PrtnStartTime, SecurePtr->HashTime);
+		}
+		if (SecurePtr->AesTime != 0U) {
+			XPlmi_TlRecordDuration(XPLMI_TL_EVENT_SECURE_AES,
+				SecurePtr->PrtnHdr->PrtnId, SecurePtr->BlockNum + 1U,
+				SecurePtr->PrtnStartTime, SecurePtr->AesTime);
+		}
+	}
+#endif
+
 	SecurePtr->BlockNum++;
+	if (SecurePtr->UnprocessedLen > BlockSize) {
+		SecurePtr->UnprocessedLen -= BlockSize;
+	}
+	else {
+		SecurePtr->UnprocessedLen = 0U;
+	}
 
 END:
 	/* Clears whole intermediate buffers on failure */
 	if (Status != XST_SUCCESS) {
-		ClrStatus = XPlmi_InitNVerifyMem(SecurePtr->ChunkAddr, TotalSize);
+		ClrStatus = XPlmi_InitNVerifyMem(SecurePtr->ChunkAddr, DataLen);
+		if (SecurePtr->IsNextBlkCopyStarted == TRUE) {
+			SecurePtr->IsNextBlkCopyStarted = FALSE;
+			SecurePtr->PdiPtr->DeviceCopy(0U, SecurePtr->NextChunkAddr,
+				0U, XLOADER_DEVICE_COPY_STATE_WAIT_DONE);
+			ClrStatus |= (u32)XPlmi_InitNVerifyMem(SecurePtr->NextChunkAddr,
+				BlockSize);
+		}
 		if (ClrStatus != XST_SUCCESS) {
 				Status = Status | XLOADER_SEC_BUF_CLEAR_ERR;
 		}
@@ -405,6 +499,67 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* @brief
+* This function starts the copy of the data of the next block to the PRAM
+* half that is not used by the current block, when the next block is not the
+* last one. The copy runs on PMC DMA1 while SHA3 and AES use PMC DMA0, it is
+* completed by XLoader_SecurePrtn of the next block. Only a PDI in DDR or in
+* OSPI flash can be read without blocking, for the other boot devices nothing
+* is done.
+*
+* @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
+* @param	NextBlkAddr	Source address of the next block.
+* @param	BlockSize	Size of the data blocks of the partition.
+* @param	DataLen		Length of the current block in PRAM.
+* @param	HashLen		Length of the hash that starts the next block,
+*		0 when the partition is not authenticated.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XLoader_StartNextBlkCopy(XLoader_SecureParms *SecurePtr,
+		u32 NextBlkAddr, u32 BlockSize, u32 DataLen, u32 HashLen)
+{
+	XStatus Status;
+
+	if ((SecurePtr->PdiPtr->PdiSrc != XLOADER_PDI_SRC_DDR) &&
+		(SecurePtr->PdiPtr->PdiSrc != XLOADER_PDI_SRC_OSPI)) {
+		goto END;
+	}
+
+	/* The next block must be followed by another one */
+	if ((SecurePtr->UnprocessedLen <= BlockSize) ||
+		((SecurePtr->UnprocessedLen - BlockSize) <= BlockSize)) {
+		goto END;
+	}
+
+	/* Both blocks must fit in their half of PRAM */
+	if ((BlockSize > XLOADER_CHUNK_SIZE) ||
+		(DataLen > XLOADER_CHUNK_SIZE)) {
+		goto END;
+	}
+
+	if (SecurePtr->ChunkAddr == XLOADER_CHUNK_MEMORY) {
+		SecurePtr->NextChunkAddr = XLOADER_SECURE_CHUNK_MEMORY_1;
+	}
+	else {
+		SecurePtr->NextChunkAddr = XLOADER_CHUNK_MEMORY;
+	}
+
+	/* Hash of the following block is read with the next block */
+	Status = SecurePtr->PdiPtr->DeviceCopy(NextBlkAddr + HashLen,
+			SecurePtr->NextChunkAddr, BlockSize,
+			XLOADER_DEVICE_COPY_STATE_INITIATE);
+	if (Status == XST_SUCCESS) {
+		SecurePtr->IsNextBlkCopyStarted = TRUE;
+	}
+
+END:
+	return;
+}
+
 /*****************************************************************************/
 /**
 * @brief
@@ -705,7 +860,8 @@ RET:
 *
 * @param	SecurePtr	Pointer to the XLoader_SecureParms instance.
 * @param	Size		Size of the data block to be processed
-*		which includes padding lengths and hash.
+*		which includes padding lengths and hash. Except for the last
+*		block, the hash is in NextBlkHash and the rest at ChunkAddr.
 * @param	Last		Notifies if the block to be processed is
 *		last or not.
 *
@@ -719,11 +875,14 @@ static u32 XLoader_VerifyHash(XLoader_SecureParms *SecurePtr,
 	u32 Status = (u32)XST_FAILURE;
 	XSecure_Sha3 Sha3Instance;
 	u8 *Data = (u8 *)SecurePtr->ChunkAddr;
+	u32 DataLen = Size;
 	u8 CalHash[XLOADER_SHA3_LEN] = {0};
 	u8 *ExpHash = (u8 *)SecurePtr->Sha3Hash;
 	XCsuDma *CsuDmaPtr = SecurePtr->CsuDmaInstPtr;
 	XLoader_AuthCertificate *AcPtr=
 		(XLoader_AuthCertificate *)SecurePtr->AcPtr;
+	XSecure_Sha3Buf HashList[3U];
+	u32 HashListCnt = 0U;
 	if (CsuDmaPtr == NULL) {
 		Status = XST_FAILURE;
 		goto END;
@@ -740,16 +899,24 @@ static u32 XLoader_VerifyHash(XLoader_SecureParms *SecurePtr,
 	/* Hash should be calculated on AC + first chunk */
 	if ((SecurePtr->IsAuthenticated == TRUE) &&
 		(SecurePtr->BlockNum == 0x00U)) {
-		Status = XSecure_Sha3Update(&Sha3Instance,
-					(u8 *)AcPtr,
-					XLOADER_AUTH_CERT_MIN_SIZE -
-					XLOADER_PARTITION_SIG_SIZE);
-		if (Status != XST_SUCCESS) {
-			goto END;
-		}
+		HashList[HashListCnt].Data = (u8 *)AcPtr;
+		HashList[HashListCnt].Size = XLOADER_AUTH_CERT_MIN_SIZE -
+					XLOADER_PARTITION_SIG_SIZE;
+		HashListCnt++;
 	}
 
-	Status = XSecure_Sha3Update(&Sha3Instance, Data, Size);
+	/* Hash of the next block precedes the data, it is read to NextBlkHash */
+	if (Last == 0x00U) {
+		HashList[HashListCnt].Data = (u8 *)SecurePtr->NextBlkHash;
+		HashList[HashListCnt].Size = XLOADER_SHA3_LEN;
+		HashListCnt++;
+		DataLen = Size - XLOADER_SHA3_LEN;
+	}
+
+	HashList[HashListCnt].Data = Data;
+	HashList[HashListCnt].Size = DataLen;
+	HashListCnt++;
+	Status = XSecure_Sha3UpdateList(&Sha3Instance, HashList, HashListCnt);
 	if (Status != XST_SUCCESS) {
 		goto END;
 	}
@@ -783,16 +950,12 @@ static u32 XLoader_VerifyHash(XLoader_SecureParms *SecurePtr,
 
 	/* Update the next expected hash  and data location */
 	if (Last == 0x00U) {
-		(void *)XPlmi_MemCpy(ExpHash, Data, XLOADER_SHA3_LEN);
-		/* Here Authentication overhead is removed in the chunk */
-		SecurePtr->SecureData = (UINTPTR)Data + XLOADER_SHA3_LEN;
-		SecurePtr->SecureDataLen = Size - XLOADER_SHA3_LEN;
-	}
-	else {
-		/* this is the last block */
-		SecurePtr->SecureData = (UINTPTR)Data;
-		SecurePtr->SecureDataLen = Size;
+		(void *)XPlmi_MemCpy(ExpHash, SecurePtr->NextBlkHash,
+					XLOADER_SHA3_LEN);
 	}
+	/* Authentication overhead is not in the chunk */
+	SecurePtr->SecureData = (UINTPTR)Data;
+	SecurePtr->SecureDataLen = DataLen;
 
 	Status = XST_SUCCESS;
 
@@ -36,6 +36,7 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   vns  04/23/19 First release
+*       vns  10/14/19 Added fields to read the next block ahead
 * </pre>
 *
 * @note
@@ -226,6 +227,17 @@ typedef struct {
 	u32 BlockNum;
 	u32 Sha3Hash[XLOADER_SHA3_LEN/4];
 	u32 EncNextBlkSize;
+	/* Unencrypted length from the current block to the end */
+	u32 UnprocessedLen;
+	/* Read ahead of the next block */
+	u32 IsNextBlkCopyStarted;
+	u32 NextChunkAddr;
+	u32 NextBlkHash[XLOADER_SHA3_LEN/4];
+#ifdef PLM_BOOT_TIMELINE
+	u64 PrtnStartTime;
+	u64 HashTime;
+	u64 AesTime;
+#endif
 	XLoader_AuthCertificate *AcPtr;
 	XCsuDma *CsuDmaInstPtr;
 }XLoader_SecureParms;
@@ -40,12 +40,16 @@
  * ----- ---- -------- -------------------------------------------------------
  * 1.0   adk  14/02/19    Initial Release
  * 1.1   sd   16/08/19    Initialise status variable
+ *       adk  15/10/19    Added the non blocking hooks for the message queues,
+ *			  the IPI handler passes queued sources to
+ *			  XMailbox_QueueIntrHandler().
  *</pre>
  *
  *@note
  *****************************************************************************/
 /***************************** Include Files *********************************/
 #include "xilmailbox.h"
+#include "xilmailbox_queue.h"
 #include "xscugic.h"
 #include "sleep.h"
 
@@ -57,6 +61,9 @@ static u32 XIpiPs_Send(XMailbox *InstancePtr, u8 Is_Blocking);
 static u32 XIpiPs_SendData(XMailbox *InstancePtr, void *MsgBufferPtr,
 			   u32 MsgLen, u8 BufferType, u8 Is_Blocking);
 static u32 XIpiPs_PollforDone(XMailbox *InstancePtr);
+static u32 XIpiPs_PollDone(XMailbox *InstancePtr, u32 RemoteId);
+static void XIpiPs_Ack(XMailbox *InstancePtr, u32 SourceId);
+static void XIpiPs_IntrCtrl(XMailbox *InstancePtr, u8 Enable);
 static u32 XIpiPs_RecvData(XMailbox *InstancePtr, void *MsgBufferPtr,
 			   u32 MsgLen, u8 BufferType);
 static XStatus XIpiPs_RegisterIrq(XScuGic *IntcInstancePtr,
@@ -88,6 +95,9 @@ u32 XMailbox_Initialize(XMailbox *InstancePtr, u8 DeviceId)
 	InstancePtr->XMbox_IPI_SendData = XIpiPs_SendData;
 	InstancePtr->XMbox_IPI_Send = XIpiPs_Send;
 	InstancePtr->XMbox_IPI_Recv = XIpiPs_RecvData;
+	InstancePtr->XMbox_IPI_PollDone = XIpiPs_PollDone;
+	InstancePtr->XMbox_IPI_Ack = XIpiPs_Ack;
+	InstancePtr->XMbox_IPI_IntrCtrl = XIpiPs_IntrCtrl;
 
 	Status = XIpiPs_Init(InstancePtr, DeviceId);
 	return Status;
@@ -128,6 +138,7 @@ static u32 XIpiPs_Init(XMailbox *InstancePtr, u8 DeviceId)
 	XIpiPsu_ClearInterruptStatus(IpiInstancePtr, XIPIPSU_ALL_MASK);
 
 	/* Register IRQ */
+	DataPtr->IntrId = CfgPtr->IntId;
 	Status = XIpiPs_RegisterIrq(&DataPtr->GicInst, InstancePtr,
 				    CfgPtr->IntId);
 
@@ -226,6 +237,74 @@ static u32 XIpiPs_PollforDone(XMailbox *InstancePtr)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * Check, without waiting, for the acknowledgement of the last IPI triggered
+ * to a remote CPU.
+ *
+ * @param InstancePtr Pointer to the XMailbox instance
+ * @param RemoteId is the Mask of the remote CPU
+ *
+ * @return	XST_SUCCESS if the remote CPU acknowledged the IPI
+ * 		XST_DEVICE_BUSY if the IPI is still pending
+ */
+/****************************************************************************/
+static u32 XIpiPs_PollDone(XMailbox *InstancePtr, u32 RemoteId)
+{
+	XMailbox_Agent *DataPtr = &InstancePtr->Agent;
+	XIpiPsu *IpiInstancePtr = &DataPtr->IpiInst;
+	u32 Status = XST_DEVICE_BUSY;
+
+	if ((XIpiPsu_ReadReg(IpiInstancePtr->Config.BaseAddress,
+			     XIPIPSU_OBS_OFFSET) & RemoteId) == 0U) {
+		Status = XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Acknowledge an IPI which the IPI handler left pending and enable the
+ * source again.
+ *
+ * @param InstancePtr Pointer to the XMailbox instance
+ * @param SourceId is the Mask of the source CPU
+ *
+ * @return	None
+ */
+/****************************************************************************/
+static void XIpiPs_Ack(XMailbox *InstancePtr, u32 SourceId)
+{
+	XMailbox_Agent *DataPtr = &InstancePtr->Agent;
+	XIpiPsu *IpiInstancePtr = &DataPtr->IpiInst;
+
+	XIpiPsu_ClearInterruptStatus(IpiInstancePtr, SourceId);
+	XIpiPsu_InterruptEnable(IpiInstancePtr, SourceId);
+}
+
+/*****************************************************************************/
+/**
+ * Disable or enable the IPI interrupt at the interrupt controller. The
+ * message queues use this to exclude the IPI handler.
+ *
+ * @param InstancePtr Pointer to the XMailbox instance
+ * @param Enable is 0 to disable the interrupt, 1 to enable it
+ *
+ * @return	None
+ */
+/****************************************************************************/
+static void XIpiPs_IntrCtrl(XMailbox *InstancePtr, u8 Enable)
+{
+	XMailbox_Agent *DataPtr = &InstancePtr->Agent;
+
+	if (Enable != 0U) {
+		XScuGic_Enable(&DataPtr->GicInst, DataPtr->IntrId);
+	} else {
+		XScuGic_Disable(&DataPtr->GicInst, DataPtr->IntrId);
+	}
+}
+
 /*****************************************************************************/
 /**
  * This function reads an IPI message
@@ -311,10 +390,25 @@ static void XIpiPs_IntrHandler(void *XMailboxPtr)
 	XMailbox_Agent *DataPtr = &InstancePtr->Agent;
 	XIpiPsu *IpiInstancePtr = &DataPtr->IpiInst;
 	u32 IntrStatus;
+	u32 Handled = 0U;
+	u32 Stalled = 0U;
 
 	IntrStatus = XIpiPsu_GetInterruptStatus(IpiInstancePtr);
-	XIpiPsu_ClearInterruptStatus(IpiInstancePtr, IntrStatus);
-	if (InstancePtr->RecvHandler != NULL) {
+
+	/*
+	 * Queued sources are read before the acknowledgement, a source whose
+	 * receive queue is full stays pending and disabled until
+	 * XMailbox_QueueRecv() makes room.
+	 */
+	if (InstancePtr->QueuePtr != NULL) {
+		Handled = XMailbox_QueueIntrHandler(InstancePtr->QueuePtr,
+						    IntrStatus, &Stalled);
+		XIpiPsu_InterruptDisable(IpiInstancePtr, Stalled);
+	}
+
+	XIpiPsu_ClearInterruptStatus(IpiInstancePtr, IntrStatus & ~Stalled);
+	if (((IntrStatus & ~Handled) != 0U) &&
+	    (InstancePtr->RecvHandler != NULL)) {
 		InstancePtr->RecvHandler(InstancePtr->RecvRefPtr);
 	}
 }
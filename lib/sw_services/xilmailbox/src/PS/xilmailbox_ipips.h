@@ -37,6 +37,7 @@
  * Ver   Who  Date        Changes
  * ----- ---- -------- -------------------------------------------------------
  * 1.0   adk  12/02/19    Initial Release
+ * 1.1   adk  15/10/19    Added IntrId to XMailbox_Agent.
  *</pre>
  *
  *@note
@@ -59,6 +60,7 @@ typedef struct {
 	XScuGic GicInst;
 	u32 SourceId;
 	u32 RemoteId;
+	u32 IntrId;
 } XMailbox_Agent;
 /************************** Constant Definitions *****************************/
 #define BIT(x)                 	(1 << (x))
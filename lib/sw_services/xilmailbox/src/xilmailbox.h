@@ -52,6 +52,9 @@
  *   Message type should be either XILMBOX_MSG_TYPE_REQ (OR) XILMBOX_MSG_TYPE_RESP.
  * - XMailbox_SetCallBack() using this function user can register call backs
  *   for recv and error events.
+ * - XMailbox_QueueInitialize() attaches message queues to a library instance
+ *   for a set of remote agents, see xilmailbox_queue.h. Queued messages are
+ *   sent without waiting for the ACK and completed through callbacks.
  *
  * <pre>
  * MODIFICATION HISTORY:
@@ -61,6 +64,8 @@
  * 1.0   adk  14/02/19    Initial Release
  *       adk  06/03/19    In the mld file updated supported peripheral option
  *			  with A72 and PMC.
+ * 1.1   adk  15/10/19    Added the non blocking transport hooks used by the
+ *			  message queues in xilmailbox_queue.c.
  *</pre>
  *
  *@note
@@ -89,15 +94,23 @@ extern "C" {
 typedef void (*XMailbox_RecvHandler) (void *CallBackRefPtr);
 typedef void (*XMailbox_ErrorHandler) (void *CallBackRefPtr, u32 ErrorMask);
 
+struct XMailbox_QueueTag;
+
 /**
  * @XMbox_IPI_Send:	    Triggers an IPI to a destination CPU
  * @XMbox_IPI_SendData:     Sends an IPI message to a destination CPU
  * @XMbox_IPI_Recv:         Reads an IPI message
+ * @XMbox_IPI_PollDone:     Checks, without waiting, whether a remote CPU
+ *			    acknowledged the last IPI
+ * @XMbox_IPI_Ack:          Acknowledges an IPI left pending by the message
+ *			    queues and re-enables it
+ * @XMbox_IPI_IntrCtrl:     Disables or enables the IPI interrupt
  * @RecvHandler:            Callback for rx IPI event
  * @ErrorHandler:           Callback for error event
  * @ErroRef:                To be passed to the error interrupt callback
  * @RecvRef:                To be passed to the receive interrupt callback.
  * @Agent:                  Used to store IPI Channel information.
+ * @QueuePtr:               Message queues, NULL when not used
  */
 typedef struct XMboxTag {
 	u32 (*XMbox_IPI_Send)(struct XMboxTag *InstancePtr, u8 Is_Blocking);
@@ -105,11 +118,15 @@ typedef struct XMboxTag {
 				  u32 MsgLen, u8 BufferType, u8 Is_Blocking);
 	u32 (*XMbox_IPI_Recv)(struct XMboxTag *InstancePtr, void *BufferPtr,
 			      u32 MsgLen, u8 BufferType);
+	u32 (*XMbox_IPI_PollDone)(struct XMboxTag *InstancePtr, u32 RemoteId);
+	void (*XMbox_IPI_Ack)(struct XMboxTag *InstancePtr, u32 SourceId);
+	void (*XMbox_IPI_IntrCtrl)(struct XMboxTag *InstancePtr, u8 Enable);
 	XMailbox_RecvHandler RecvHandler;
 	XMailbox_ErrorHandler ErrorHandler;
 	void *ErrorRefPtr;
 	void *RecvRefPtr;
 	XMailbox_Agent Agent;
+	struct XMailbox_QueueTag *QueuePtr;
 } XMailbox;
 
 /**
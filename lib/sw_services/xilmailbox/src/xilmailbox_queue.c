@@ -0,0 +1,602 @@
+/******************************************************************************
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+ *
+ ******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xilmailbox_queue.c
+ * @addtogroup xilmailbox_v1_1
+ * @{
+ * @details
+ *
+ * This file contains the definitions of the XilMailbox message queues.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date        Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 1.1   adk  15/10/19    Initial Release
+ *</pre>
+ *
+ *@note
+ *****************************************************************************/
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "xilmailbox_queue.h"
+
+/************************** Function Prototypes ******************************/
+static XMailbox_QueueRemote *XMailbox_QueueFind(XMailbox_Queue *QueuePtr,
+						u32 RemoteId);
+static void XMailbox_QueueLock(XMailbox_Queue *QueuePtr);
+static void XMailbox_QueueUnlock(XMailbox_Queue *QueuePtr);
+static u32 XMailbox_QueuePut(XMailbox_Queue *QueuePtr,
+			     XMailbox_QueueRemote *RemotePtr, u32 Header,
+			     const u32 *MsgPtr, u32 MsgLen,
+			     XMailbox_DoneHandler Handler,
+			     void *CallBackRefPtr, u8 ExpectResp);
+static void XMailbox_QueueKick(XMailbox_Queue *QueuePtr,
+			       XMailbox_QueueRemote *RemotePtr);
+static u32 XMailbox_QueueRxOne(XMailbox_Queue *QueuePtr,
+			       XMailbox_QueueRemote *RemotePtr);
+
+/*****************************************************************************/
+/**
+ * This function attaches message queues for a set of remote agents to an
+ * initialized XMailbox instance. IPIs from these agents are handled by the
+ * queues from then on, IPIs from other agents still go to the receive
+ * handler of the instance.
+ *
+ * @param QueuePtr Pointer to the XMailbox_Queue instance
+ * @param InstancePtr Pointer to the initialized XMailbox instance
+ * @param RemoteIds is the array of the Masks of the remote agents
+ * @param NumRemotes is the number of remote agents, up to
+ *	  XMAILBOX_QUEUE_MAX_REMOTES
+ *
+ * @return
+ *	- XST_SUCCESS if successful
+ *	- XST_INVALID_PARAM if NumRemotes is out of range
+ *
+ ****************************************************************************/
+u32 XMailbox_QueueInitialize(XMailbox_Queue *QueuePtr, XMailbox *InstancePtr,
+			     const u32 *RemoteIds, u32 NumRemotes)
+{
+	u32 Status = XST_FAILURE;
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(RemoteIds != NULL);
+
+	if ((NumRemotes == 0U) || (NumRemotes > XMAILBOX_QUEUE_MAX_REMOTES)) {
+		Status = XST_INVALID_PARAM;
+		goto END;
+	}
+
+	InstancePtr->XMbox_IPI_IntrCtrl(InstancePtr, 0U);
+
+	memset(QueuePtr, 0, sizeof(XMailbox_Queue));
+	QueuePtr->MboxPtr = InstancePtr;
+	QueuePtr->NumRemotes = NumRemotes;
+	for (Index = 0U; Index < NumRemotes; Index++) {
+		QueuePtr->Remote[Index].RemoteId = RemoteIds[Index];
+	}
+	InstancePtr->QueuePtr = QueuePtr;
+
+	InstancePtr->XMbox_IPI_IntrCtrl(InstancePtr, 1U);
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function sets the handler called for every request received from a
+ * queued remote agent. Without a handler the requests are kept in the
+ * receive queues, see XMailbox_QueueRecv().
+ *
+ * @param QueuePtr Pointer to the XMailbox_Queue instance
+ * @param Handler is the request handler, NULL to queue the requests
+ * @param CallBackRefPtr is passed to the handler
+ *
+ * @return	None
+ *
+ ****************************************************************************/
+void XMailbox_QueueSetMsgHandler(XMailbox_Queue *QueuePtr,
+				 XMailbox_MsgHandler Handler,
+				 void *CallBackRefPtr)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(QueuePtr != NULL);
+
+	XMailbox_QueueLock(QueuePtr);
+	QueuePtr->MsgHandler = Handler;
+	QueuePtr->MsgRefPtr = CallBackRefPtr;
+	XMailbox_QueueUnlock(QueuePtr);
+}
+
+/*****************************************************************************/
+/**
+ * This function queues a request to a remote agent and returns without
+ * waiting for it to be sent.
+ *
+ * @param QueuePtr Pointer to the XMailbox_Queue instance
+ * @param RemoteId is the Mask of the remote agent
+ * @param MsgPtr is the pointer to the payload
+ * @param MsgLen is the payload length in words, up to
+ *	  XMAILBOX_QUEUE_MAX_PAYLOAD
+ * @param Handler is called when the request completes, may be NULL
+ * @param CallBackRefPtr is passed to the handler
+ * @param ExpectResp if set the request completes on the response of the
+ *	  remote agent, otherwise on the acknowledgement
+ * @param SeqIdPtr is where the sequence ID of the request is stored, may be
+ *	  NULL
+ *
+ * @return
+ *	- XST_SUCCESS if the request is queued
+ *	- XST_DEVICE_BUSY if the transmit queue of the remote agent is full
+ *	- XST_INVALID_PARAM if the remote agent is not queued
+ *
+ ****************************************************************************/
+u32 XMailbox_QueueSend(XMailbox_Queue *QueuePtr, u32 RemoteId,
+		       const u32 *MsgPtr, u32 MsgLen,
+		       XMailbox_DoneHandler Handler, void *CallBackRefPtr,
+		       u8 ExpectResp, u32 *SeqIdPtr)
+{
+	u32 Status = XST_FAILURE;
+	XMailbox_QueueRemote *RemotePtr;
+	u32 SeqId;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid((MsgPtr != NULL) || (MsgLen == 0U));
+	Xil_AssertNonvoid(MsgLen <= XMAILBOX_QUEUE_MAX_PAYLOAD);
+
+	RemotePtr = XMailbox_QueueFind(QueuePtr, RemoteId);
+	if (RemotePtr == NULL) {
+		Status = XST_INVALID_PARAM;
+		goto END;
+	}
+
+	XMailbox_QueueLock(QueuePtr);
+
+	SeqId = QueuePtr->NextSeqId & XMAILBOX_QUEUE_HDR_SEQ_MASK;
+	Status = XMailbox_QueuePut(QueuePtr, RemotePtr, SeqId, MsgPtr, MsgLen,
+				   Handler, CallBackRefPtr, ExpectResp);
+	if (Status == (u32)XST_SUCCESS) {
+		QueuePtr->NextSeqId++;
+		if (SeqIdPtr != NULL) {
+			*SeqIdPtr = SeqId;
+		}
+	}
+
+	XMailbox_QueueUnlock(QueuePtr);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function queues the response to a request received from a remote
+ * agent.
+ *
+ * @param QueuePtr Pointer to the XMailbox_Queue instance
+ * @param RemoteId is the Mask of the remote agent which sent the request
+ * @param SeqId is the sequence ID of the request
+ * @param MsgPtr is the pointer to the payload
+ * @param MsgLen is the payload length in words, up to
+ *	  XMAILBOX_QUEUE_MAX_PAYLOAD
+ *
+ * @return
+ *	- XST_SUCCESS if the response is queued
+ *	- XST_DEVICE_BUSY if the transmit queue of the remote agent is full
+ *	- XST_INVALID_PARAM if the remote agent is not queued
+ *
+ ****************************************************************************/
+u32 XMailbox_QueueRespond(XMailbox_Queue *QueuePtr, u32 RemoteId, u32 SeqId,
+			  const u32 *MsgPtr, u32 MsgLen)
+{
+	u32 Status = XST_FAILURE;
+	XMailbox_QueueRemote *RemotePtr;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid((MsgPtr != NULL) || (MsgLen == 0U));
+	Xil_AssertNonvoid(MsgLen <= XMAILBOX_QUEUE_MAX_PAYLOAD);
+
+	RemotePtr = XMailbox_QueueFind(QueuePtr, RemoteId);
+	if (RemotePtr == NULL) {
+		Status = XST_INVALID_PARAM;
+		goto END;
+	}
+
+	XMailbox_QueueLock(QueuePtr);
+	Status = XMailbox_QueuePut(QueuePtr, RemotePtr,
+				   (SeqId & XMAILBOX_QUEUE_HDR_SEQ_MASK) |
+				   XMAILBOX_QUEUE_HDR_RESP,
+				   MsgPtr, MsgLen, NULL, NULL, 0U);
+	XMailbox_QueueUnlock(QueuePtr);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function reads the oldest request in the receive queue of a remote
+ * agent.
+ *
+ * @param QueuePtr Pointer to the XMailbox_Queue instance
+ * @param RemoteId is the Mask of the remote agent
+ * @param MsgPtr is the pointer to a buffer of XMAILBOX_QUEUE_MAX_PAYLOAD
+ *	  words for the payload
+ * @param MsgLenPtr is where the payload length in words is stored
+ * @param SeqIdPtr is where the sequence ID of the request is stored, to be
+ *	  passed to XMailbox_QueueRespond()
+ *
+ * @return
+ *	- XST_SUCCESS if a request was read
+ *	- XST_NO_DATA if the receive queue is empty
+ *	- XST_INVALID_PARAM if the remote agent is not queued
+ *
+ ****************************************************************************/
+u32 XMailbox_QueueRecv(XMailbox_Queue *QueuePtr, u32 RemoteId, u32 *MsgPtr,
+		       u32 *MsgLenPtr, u32 *SeqIdPtr)
+{
+	u32 Status = XST_FAILURE;
+	XMailbox_QueueRemote *RemotePtr;
+	XMailbox *MboxPtr;
+	u32 *RxPtr;
+	u32 Len;
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(MsgPtr != NULL);
+	Xil_AssertNonvoid(MsgLenPtr != NULL);
+	Xil_AssertNonvoid(SeqIdPtr != NULL);
+
+	RemotePtr = XMailbox_QueueFind(QueuePtr, RemoteId);
+	if (RemotePtr == NULL) {
+		Status = XST_INVALID_PARAM;
+		goto END;
+	}
+
+	MboxPtr = QueuePtr->MboxPtr;
+	XMailbox_QueueLock(QueuePtr);
+
+	if (RemotePtr->RxCount == 0U) {
+		Status = XST_NO_DATA;
+		goto UNLOCK;
+	}
+
+	RxPtr = RemotePtr->Rx[RemotePtr->RxHead];
+	Len = (RxPtr[0] & XMAILBOX_QUEUE_HDR_LEN_MASK) >>
+		XMAILBOX_QUEUE_HDR_LEN_SHIFT;
+	for (Index = 0U; Index < Len; Index++) {
+		MsgPtr[Index] = RxPtr[Index + 1U];
+	}
+	*MsgLenPtr = Len;
+	*SeqIdPtr = RxPtr[0] & XMAILBOX_QUEUE_HDR_SEQ_MASK;
+
+	RemotePtr->RxHead = (RemotePtr->RxHead + 1U) % XMAILBOX_QUEUE_DEPTH;
+	RemotePtr->RxCount--;
+
+	/* Take the request which waited for room and let the remote go on */
+	if ((RemotePtr->RxStalled != 0U) &&
+	    (XMailbox_QueueRxOne(QueuePtr, RemotePtr) == (u32)XST_SUCCESS)) {
+		RemotePtr->RxStalled = 0U;
+		MboxPtr->XMbox_IPI_Ack(MboxPtr, RemotePtr->RemoteId);
+	}
+	Status = XST_SUCCESS;
+
+UNLOCK:
+	XMailbox_QueueUnlock(QueuePtr);
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function checks the acknowledgements of the messages in the IPI
+ * buffers, completes them and sends the next queued messages. It is to be
+ * called while the application waits for completions.
+ *
+ * @param QueuePtr Pointer to the XMailbox_Queue instance
+ *
+ * @return	None
+ *
+ ****************************************************************************/
+void XMailbox_QueuePoll(XMailbox_Queue *QueuePtr)
+{
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(QueuePtr != NULL);
+
+	XMailbox_QueueLock(QueuePtr);
+	for (Index = 0U; Index < QueuePtr->NumRemotes; Index++) {
+		XMailbox_QueueKick(QueuePtr, &QueuePtr->Remote[Index]);
+	}
+	XMailbox_QueueUnlock(QueuePtr);
+}
+
+/*****************************************************************************/
+/**
+ * This function is called by the IPI handler of the library instance with
+ * the pending IPI sources, before they are acknowledged.
+ *
+ * @param QueuePtr Pointer to the XMailbox_Queue instance
+ * @param IntrStatus is the mask of the pending IPI sources
+ * @param StalledPtr is where the mask of the sources which must stay pending
+ *	  and disabled is stored
+ *
+ * @return	Mask of the sources handled by the queues
+ *
+ ****************************************************************************/
+u32 XMailbox_QueueIntrHandler(XMailbox_Queue *QueuePtr, u32 IntrStatus,
+			      u32 *StalledPtr)
+{
+	XMailbox_QueueRemote *RemotePtr;
+	u32 Handled = 0U;
+	u32 Index;
+
+	QueuePtr->InIntr = 1U;
+	*StalledPtr = 0U;
+
+	for (Index = 0U; Index < QueuePtr->NumRemotes; Index++) {
+		RemotePtr = &QueuePtr->Remote[Index];
+		if ((IntrStatus & RemotePtr->RemoteId) != 0U) {
+			Handled |= RemotePtr->RemoteId;
+			if (XMailbox_QueueRxOne(QueuePtr, RemotePtr) !=
+			    (u32)XST_SUCCESS) {
+				RemotePtr->RxStalled = 1U;
+				*StalledPtr |= RemotePtr->RemoteId;
+			}
+		}
+		XMailbox_QueueKick(QueuePtr, RemotePtr);
+	}
+
+	QueuePtr->InIntr = 0U;
+
+	return Handled;
+}
+
+/*****************************************************************************/
+/**
+ * Return the queues of a remote agent, NULL if it is not queued.
+ *
+ ****************************************************************************/
+static XMailbox_QueueRemote *XMailbox_QueueFind(XMailbox_Queue *QueuePtr,
+						u32 RemoteId)
+{
+	XMailbox_QueueRemote *RemotePtr = NULL;
+	u32 Index;
+
+	for (Index = 0U; Index < QueuePtr->NumRemotes; Index++) {
+		if (QueuePtr->Remote[Index].RemoteId == RemoteId) {
+			RemotePtr = &QueuePtr->Remote[Index];
+			break;
+		}
+	}
+
+	return RemotePtr;
+}
+
+/*****************************************************************************/
+/**
+ * Exclude the IPI handler. The lock nests, so handlers may call the queue
+ * functions, and is a no-op in the IPI handler itself.
+ *
+ ****************************************************************************/
+static void XMailbox_QueueLock(XMailbox_Queue *QueuePtr)
+{
+	if (QueuePtr->InIntr == 0U) {
+		if (QueuePtr->LockDepth == 0U) {
+			QueuePtr->MboxPtr->XMbox_IPI_IntrCtrl(QueuePtr->MboxPtr,
+							      0U);
+		}
+		QueuePtr->LockDepth++;
+	}
+}
+
+static void XMailbox_QueueUnlock(XMailbox_Queue *QueuePtr)
+{
+	if (QueuePtr->InIntr == 0U) {
+		QueuePtr->LockDepth--;
+		if (QueuePtr->LockDepth == 0U) {
+			QueuePtr->MboxPtr->XMbox_IPI_IntrCtrl(QueuePtr->MboxPtr,
+							      1U);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Append a message to the transmit queue of a remote agent and try to send
+ * it. Called with the lock held.
+ *
+ ****************************************************************************/
+static u32 XMailbox_QueuePut(XMailbox_Queue *QueuePtr,
+			     XMailbox_QueueRemote *RemotePtr, u32 Header,
+			     const u32 *MsgPtr, u32 MsgLen,
+			     XMailbox_DoneHandler Handler,
+			     void *CallBackRefPtr, u8 ExpectResp)
+{
+	u32 Status = XST_DEVICE_BUSY;
+	XMailbox_QueueMsg *EntryPtr;
+	u32 Index;
+
+	if (RemotePtr->TxCount < XMAILBOX_QUEUE_DEPTH) {
+		EntryPtr = &RemotePtr->Tx[(RemotePtr->TxHead +
+					   RemotePtr->TxCount) %
+					  XMAILBOX_QUEUE_DEPTH];
+		EntryPtr->Msg[0] = Header |
+			(MsgLen << XMAILBOX_QUEUE_HDR_LEN_SHIFT);
+		for (Index = 0U; Index < MsgLen; Index++) {
+			EntryPtr->Msg[Index + 1U] = MsgPtr[Index];
+		}
+		EntryPtr->Handler = Handler;
+		EntryPtr->CallBackRefPtr = CallBackRefPtr;
+		EntryPtr->ExpectResp = ExpectResp;
+		RemotePtr->TxCount++;
+
+		XMailbox_QueueKick(QueuePtr, RemotePtr);
+		Status = XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Complete the message in the IPI buffer of a remote agent once it is
+ * acknowledged, then write the next queued message. A request which expects
+ * a response is only sent while there is room to wait for it. Called with
+ * the lock held.
+ *
+ ****************************************************************************/
+static void XMailbox_QueueKick(XMailbox_Queue *QueuePtr,
+			       XMailbox_QueueRemote *RemotePtr)
+{
+	XMailbox *MboxPtr = QueuePtr->MboxPtr;
+	XMailbox_QueueMsg Done;
+	XMailbox_QueueMsg *HeadPtr;
+	u32 Status;
+
+	if (MboxPtr->XMbox_IPI_PollDone(MboxPtr, RemotePtr->RemoteId) !=
+	    (u32)XST_SUCCESS) {
+		return;
+	}
+
+	if (RemotePtr->TxBusy != 0U) {
+		Done = RemotePtr->Tx[RemotePtr->TxHead];
+		RemotePtr->TxHead = (RemotePtr->TxHead + 1U) %
+			XMAILBOX_QUEUE_DEPTH;
+		RemotePtr->TxCount--;
+		RemotePtr->TxBusy = 0U;
+
+		if (Done.ExpectResp != 0U) {
+			RemotePtr->Wait[RemotePtr->NumWait] = Done;
+			RemotePtr->NumWait++;
+		} else if (Done.Handler != NULL) {
+			Done.Handler(Done.CallBackRefPtr,
+				     Done.Msg[0] & XMAILBOX_QUEUE_HDR_SEQ_MASK,
+				     XST_SUCCESS, NULL, 0U);
+		}
+	}
+
+	/* The handler may have sent the next message already */
+	if ((RemotePtr->TxBusy != 0U) || (RemotePtr->TxCount == 0U)) {
+		return;
+	}
+
+	HeadPtr = &RemotePtr->Tx[RemotePtr->TxHead];
+	if ((HeadPtr->ExpectResp != 0U) &&
+	    (RemotePtr->NumWait == XMAILBOX_QUEUE_DEPTH)) {
+		return;
+	}
+
+	MboxPtr->Agent.RemoteId = RemotePtr->RemoteId;
+	Status = MboxPtr->XMbox_IPI_SendData(MboxPtr, HeadPtr->Msg,
+				XMAILBOX_MAX_MSG_LEN, XILMBOX_MSG_TYPE_REQ, 0U);
+	if (Status == (u32)XST_SUCCESS) {
+		RemotePtr->TxBusy = 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Read the message in the IPI buffer of a remote agent. A response completes
+ * the request with the same sequence ID, a request goes to the request
+ * handler or to the receive queue.
+ *
+ * @return	XST_SUCCESS if the message was consumed, XST_DEVICE_BUSY if
+ *		the receive queue is full
+ *
+ ****************************************************************************/
+static u32 XMailbox_QueueRxOne(XMailbox_Queue *QueuePtr,
+			       XMailbox_QueueRemote *RemotePtr)
+{
+	XMailbox *MboxPtr = QueuePtr->MboxPtr;
+	u32 Msg[XMAILBOX_MAX_MSG_LEN];
+	XMailbox_QueueMsg Done;
+	u32 Status = XST_SUCCESS;
+	u32 SeqId;
+	u32 Len;
+	u32 Index;
+
+	MboxPtr->Agent.SourceId = RemotePtr->RemoteId;
+	if (MboxPtr->XMbox_IPI_Recv(MboxPtr, Msg, XMAILBOX_MAX_MSG_LEN,
+				    XILMBOX_MSG_TYPE_REQ) != (u32)XST_SUCCESS) {
+		/* Nothing to read, the IPI is acknowledged */
+		goto END;
+	}
+
+	SeqId = Msg[0] & XMAILBOX_QUEUE_HDR_SEQ_MASK;
+	Len = (Msg[0] & XMAILBOX_QUEUE_HDR_LEN_MASK) >>
+		XMAILBOX_QUEUE_HDR_LEN_SHIFT;
+	if (Len > XMAILBOX_QUEUE_MAX_PAYLOAD) {
+		Len = XMAILBOX_QUEUE_MAX_PAYLOAD;
+		Msg[0] = (Msg[0] & ~XMAILBOX_QUEUE_HDR_LEN_MASK) |
+			(Len << XMAILBOX_QUEUE_HDR_LEN_SHIFT);
+	}
+
+	if ((Msg[0] & XMAILBOX_QUEUE_HDR_RESP) != 0U) {
+		/* Responses without a waiting request are dropped */
+		for (Index = 0U; Index < RemotePtr->NumWait; Index++) {
+			if ((RemotePtr->Wait[Index].Msg[0] &
+			     XMAILBOX_QUEUE_HDR_SEQ_MASK) == SeqId) {
+				break;
+			}
+		}
+		if (Index < RemotePtr->NumWait) {
+			Done = RemotePtr->Wait[Index];
+			RemotePtr->NumWait--;
+			RemotePtr->Wait[Index] =
+				RemotePtr->Wait[RemotePtr->NumWait];
+			if (Done.Handler != NULL) {
+				Done.Handler(Done.CallBackRefPtr, SeqId,
+					     XST_SUCCESS, &Msg[1], Len);
+			}
+		}
+	} else if (QueuePtr->MsgHandler != NULL) {
+		QueuePtr->MsgHandler(QueuePtr->MsgRefPtr, RemotePtr->RemoteId,
+				     SeqId, &Msg[1], Len);
+	} else if (RemotePtr->RxCount < XMAILBOX_QUEUE_DEPTH) {
+		Index = (RemotePtr->RxHead + RemotePtr->RxCount) %
+			XMAILBOX_QUEUE_DEPTH;
+		memcpy(RemotePtr->Rx[Index], Msg, sizeof(Msg));
+		RemotePtr->RxCount++;
+	} else {
+		Status = XST_DEVICE_BUSY;
+	}
+
+END:
+	return Status;
+}
@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ *
+ *
+ ******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xilmailbox_queue.h
+ * @addtogroup xilmailbox_v1_1
+ * @{
+ * @details
+ *
+ * Message queues on top of a XilMailbox instance.
+ *
+ * An IPI channel has one message buffer per remote agent, so only one
+ * message can be in the hardware until the remote agent acknowledges it.
+ * The queues keep up to XMAILBOX_QUEUE_DEPTH messages per remote agent and
+ * direction and move them without blocking:
+ *	- XMailbox_QueueSend() queues a request and returns its sequence ID.
+ *	  The next queued message is written to the IPI buffer once the
+ *	  previous one is acknowledged.
+ *	- A request sent with ExpectResp set completes when the remote agent
+ *	  sends a message with the response flag and the same sequence ID,
+ *	  using XMailbox_QueueRespond(). Other requests complete on the
+ *	  acknowledgement. Completion calls the handler given with the request.
+ *	- Messages received from a queued remote agent are read by the IPI
+ *	  handler. Requests go to the handler set with
+ *	  XMailbox_QueueSetMsgHandler(), or to the receive queue read with
+ *	  XMailbox_QueueRecv(). When the receive queue is full the IPI is left
+ *	  unacknowledged, so the remote agent waits for room.
+ *
+ * The IPI hardware has no interrupt for acknowledgements. They are checked
+ * whenever an IPI is received and by XMailbox_QueuePoll(), which the
+ * application calls when it waits for a completion.
+ *
+ * Every message starts with a header word holding the sequence ID, the
+ * payload length and the response flag, so both agents must use the queues.
+ * Handlers run in the context of the IPI handler or of the queue function
+ * which detected the completion, and may queue new messages.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date        Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 1.1   adk  15/10/19    Initial Release
+ *</pre>
+ *
+ *@note
+ *****************************************************************************/
+#ifndef XILMAILBOX_QUEUE_H
+#define XILMAILBOX_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xilmailbox.h"
+
+/************************** Constant Definitions *****************************/
+#define XMAILBOX_QUEUE_DEPTH		8U	/* Messages per remote and
+						 * direction */
+#define XMAILBOX_QUEUE_MAX_REMOTES	4U
+#define XMAILBOX_QUEUE_MAX_PAYLOAD	(XMAILBOX_MAX_MSG_LEN - 1U)
+
+/* Message header word */
+#define XMAILBOX_QUEUE_HDR_SEQ_MASK	(0x0000FFFFU)
+#define XMAILBOX_QUEUE_HDR_LEN_SHIFT	16U
+#define XMAILBOX_QUEUE_HDR_LEN_MASK	(0x00FF0000U)
+#define XMAILBOX_QUEUE_HDR_RESP		(0x01000000U)
+
+/**************************** Type Definitions *******************************/
+/**
+ * Called when a queued request completes. Status is XST_SUCCESS, RespPtr and
+ * RespLen describe the response payload of requests sent with ExpectResp.
+ */
+typedef void (*XMailbox_DoneHandler) (void *CallBackRefPtr, u32 SeqId,
+				      u32 Status, const u32 *RespPtr,
+				      u32 RespLen);
+
+/**
+ * Called for every request received from a queued remote agent.
+ */
+typedef void (*XMailbox_MsgHandler) (void *CallBackRefPtr, u32 SourceId,
+				     u32 SeqId, const u32 *MsgPtr,
+				     u32 MsgLen);
+
+/**
+ * @Msg:            Header word and payload
+ * @Handler:        Completion handler, may be NULL
+ * @CallBackRefPtr: Passed to the completion handler
+ * @ExpectResp:     Completes on the response instead of the acknowledgement
+ */
+typedef struct {
+	u32 Msg[XMAILBOX_MAX_MSG_LEN];
+	XMailbox_DoneHandler Handler;
+	void *CallBackRefPtr;
+	u8 ExpectResp;
+} XMailbox_QueueMsg;
+
+/**
+ * @RemoteId:  Mask of the remote agent
+ * @Tx:        Messages to send, the head is in the IPI buffer when TxBusy
+ * @Wait:      Requests sent, waiting for their response
+ * @Rx:        Received requests, header word and payload
+ * @RxStalled: An IPI from the remote agent waits for room in Rx
+ */
+typedef struct {
+	u32 RemoteId;
+	XMailbox_QueueMsg Tx[XMAILBOX_QUEUE_DEPTH];
+	u32 TxHead;
+	u32 TxCount;
+	u8 TxBusy;
+	XMailbox_QueueMsg Wait[XMAILBOX_QUEUE_DEPTH];
+	u32 NumWait;
+	u32 Rx[XMAILBOX_QUEUE_DEPTH][XMAILBOX_MAX_MSG_LEN];
+	u32 RxHead;
+	u32 RxCount;
+	u8 RxStalled;
+} XMailbox_QueueRemote;
+
+/**
+ * @MboxPtr:    Library instance the queues are attached to
+ * @Remote:     Per remote agent queues
+ * @NumRemotes: Number of entries used in Remote
+ * @NextSeqId:  Sequence ID of the next request
+ * @MsgHandler: Handler for received requests, NULL to queue them
+ * @MsgRefPtr:  Passed to the request handler
+ * @LockDepth:  Nesting of the queue lock
+ * @InIntr:     Set while the IPI handler runs
+ */
+typedef struct XMailbox_QueueTag {
+	XMailbox *MboxPtr;
+	XMailbox_QueueRemote Remote[XMAILBOX_QUEUE_MAX_REMOTES];
+	u32 NumRemotes;
+	u32 NextSeqId;
+	XMailbox_MsgHandler MsgHandler;
+	void *MsgRefPtr;
+	u32 LockDepth;
+	u8 InIntr;
+} XMailbox_Queue;
+
+/************************** Function Prototypes ******************************/
+u32 XMailbox_QueueInitialize(XMailbox_Queue *QueuePtr, XMailbox *InstancePtr,
+			     const u32 *RemoteIds, u32 NumRemotes);
+void XMailbox_QueueSetMsgHandler(XMailbox_Queue *QueuePtr,
+				 XMailbox_MsgHandler Handler,
+				 void *CallBackRefPtr);
+u32 XMailbox_QueueSend(XMailbox_Queue *QueuePtr, u32 RemoteId,
+		       const u32 *MsgPtr, u32 MsgLen,
+		       XMailbox_DoneHandler Handler, void *CallBackRefPtr,
+		       u8 ExpectResp, u32 *SeqIdPtr);
+u32 XMailbox_QueueRespond(XMailbox_Queue *QueuePtr, u32 RemoteId, u32 SeqId,
+			  const u32 *MsgPtr, u32 MsgLen);
+u32 XMailbox_QueueRecv(XMailbox_Queue *QueuePtr, u32 RemoteId, u32 *MsgPtr,
+		       u32 *MsgLenPtr, u32 *SeqIdPtr);
+void XMailbox_QueuePoll(XMailbox_Queue *QueuePtr);
+u32 XMailbox_QueueIntrHandler(XMailbox_Queue *QueuePtr, u32 IntrStatus,
+			      u32 *StalledPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XILMAILBOX_QUEUE_H */
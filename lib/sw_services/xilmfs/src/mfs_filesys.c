@@ -43,6 +43,23 @@ struct mfs_open_file_struct mfs_open_files[MFS_MAX_OPEN_FILES];
 int mfs_num_open_files; /* the number of mfs_open_files */
 int mfs_current_dir; /* index of current directory block */
 
+/**
+ * hashed directory index
+ * each entry caches the location of a directory entry, keyed by the first
+ * block of its directory and its name; entries are checked against the
+ * directory block before use, so stale entries only cause a directory scan
+ */
+struct mfs_dir_index_ent {
+  unsigned int dir;   /* first block of the directory */
+  unsigned int hash;  /* hash of dir and name */
+  unsigned int block; /* dir block that holds the entry */
+  int index;          /* index within block or -1 for an unused entry */
+};
+static struct mfs_dir_index_ent mfs_dir_index[MFS_DIR_INDEX_SIZE];
+
+static int get_first_dir_block(unsigned int dir_block);
+static void dir_index_build(void);
+
 /**
  * initialize the file system;
  * this function must be called before any file system operations
@@ -101,6 +118,9 @@ else { // (init_type == MFSINIT_ROM_IMAGE)
   /* initialize current dir to the top level */
   mfs_current_dir = 0;
 
+  /* index the directory entries of the image */
+  dir_index_build();
+
   /* initialize mfs_open_files */
   for (i = 0; i < MFS_MAX_OPEN_FILES; i++)
     mfs_open_files[i].mode = MFS_MODE_FREE;
@@ -131,6 +151,123 @@ void mfs_init_genimage(int numbytes, char *address, int init_type) {
 }
 
 
+/**
+ * hash a directory entry name together with the first block of its directory
+ * @param dir is the first block of the directory
+ * @param name is the entry name
+ * @return the hash value
+ */
+static unsigned int dir_index_hash(unsigned int dir, const char *name) {
+  unsigned int hash = 2166136261U ^ dir;
+
+  while (*name != '\0') {
+    hash ^= (unsigned char)*name;
+    hash *= 16777619U;
+    name++;
+  }
+  return hash;
+}
+
+/**
+ * check that an index entry still describes a live entry named name in dir
+ * @return 1 if the entry is valid, 0 otherwise
+ */
+static int dir_index_check(const struct mfs_dir_index_ent *ent, unsigned int dir, const char *name) {
+  struct mfs_file_block *fb;
+  int num_local;
+
+  if (ent->index < 0 || ent->block >= (unsigned int)mfs_max_file_blocks)
+    return 0;
+  fb = &mfs_file_system[ent->block];
+  if (fb->block_type != MFS_BLOCK_TYPE_DIR)
+    return 0;
+  /* the first block counts the entries of the whole directory */
+  num_local = fb->u.dir_data.num_entries;
+  if (num_local > MFS_MAX_LOCAL_ENT)
+    num_local = MFS_MAX_LOCAL_ENT;
+  if (ent->index >= num_local ||
+      fb->u.dir_data.dir_ent[ent->index].deleted == 'y' ||
+      strcmp(fb->u.dir_data.dir_ent[ent->index].name, name))
+    return 0;
+  return (get_first_dir_block(ent->block) == (int)dir);
+}
+
+/**
+ * record the location of a directory entry in the index
+ * @param dir is the first block of the directory
+ * @param name is the entry name
+ * @param block is the dir block that holds the entry
+ * @param index is the index of the entry within block
+ */
+static void dir_index_add(unsigned int dir, const char *name, unsigned int block, int index) {
+  unsigned int hash = dir_index_hash(dir, name);
+  struct mfs_dir_index_ent *ent = &mfs_dir_index[hash & (MFS_DIR_INDEX_SIZE - 1)];
+  int i;
+
+  /* reuse an unused entry or the entry of the same name, else evict the first one */
+  for (i = 0; i < MFS_DIR_INDEX_PROBES; i++) {
+    struct mfs_dir_index_ent *probe = &mfs_dir_index[(hash + i) & (MFS_DIR_INDEX_SIZE - 1)];
+    if (probe->index < 0 || (probe->hash == hash && probe->dir == dir)) {
+      ent = probe;
+      break;
+    }
+  }
+  ent->dir = dir;
+  ent->hash = hash;
+  ent->block = block;
+  ent->index = index;
+}
+
+/**
+ * look a name up in the index
+ * @param dir is the first block of the directory
+ * @param name is the entry name
+ * @param dir_block is set to the dir block that holds the entry
+ * @param dir_index is set to the index of the entry within dir_block
+ * @return 1 if found, 0 if the directory must be scanned
+ */
+static int dir_index_find(unsigned int dir, const char *name, int *dir_block, int *dir_index) {
+  unsigned int hash = dir_index_hash(dir, name);
+  int i;
+
+  for (i = 0; i < MFS_DIR_INDEX_PROBES; i++) {
+    struct mfs_dir_index_ent *ent = &mfs_dir_index[(hash + i) & (MFS_DIR_INDEX_SIZE - 1)];
+    if (ent->index >= 0 && ent->hash == hash && ent->dir == dir &&
+        dir_index_check(ent, dir, name)) {
+      *dir_block = ent->block;
+      *dir_index = ent->index;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * clear the index and add all the live entries of all the directories
+ */
+static void dir_index_build(void) {
+  int i;
+  int j;
+  int num_local;
+  int dir;
+
+  for (i = 0; i < MFS_DIR_INDEX_SIZE; i++)
+    mfs_dir_index[i].index = -1;
+
+  for (i = 0; i < mfs_max_file_blocks; i++) {
+    if (mfs_file_system[i].block_type != MFS_BLOCK_TYPE_DIR)
+      continue;
+    dir = get_first_dir_block(i);
+    num_local = mfs_file_system[i].u.dir_data.num_entries;
+    if (num_local > MFS_MAX_LOCAL_ENT)
+      num_local = MFS_MAX_LOCAL_ENT;
+    for (j = 0; j < num_local; j++) {
+      if (mfs_file_system[i].u.dir_data.dir_ent[j].deleted != 'y')
+        dir_index_add(dir, mfs_file_system[i].u.dir_data.dir_ent[j].name, i, j);
+    }
+  }
+}
+
 /**
  * Given a filename, get the directory block and the directory index within
  * that block that correspond to the entry for this filename
@@ -157,6 +294,8 @@ static int get_dir_ent_base(const char *filename,  int *dir_block, int *dir_inde
   int index = 0;
   int basename = 0;
   int looking_for_reuse = 0;
+  int found;
+  unsigned int dir = *dir_block;
 
   while(*filename != '/' && *filename != '\0') {
     tmpfilename[index] = *filename;
@@ -168,14 +307,20 @@ static int get_dir_ent_base(const char *filename,  int *dir_block, int *dir_inde
 	  basename = 1;
 	  looking_for_reuse = 1;
   }
-  while (numentriesleft > 0) {
+  /* the index gives the entry directly; a miss still scans, as the
+     caller needs the free entry for a new file */
+  found = dir_index_find(dir, tmpfilename, dir_block, dir_index);
+  while (found || numentriesleft > 0) {
     if (*dir_index == MFS_MAX_LOCAL_ENT) { /* move to the next dir block */
       *dir_index = 0;
       *dir_block = mfs_file_system[*dir_block].next_block;
     }
-    if (mfs_file_system[*dir_block].u.dir_data.dir_ent[*dir_index].deleted != 'y' &&
-        !strcmp(mfs_file_system[*dir_block].u.dir_data.dir_ent[*dir_index].name,
-                tmpfilename)) { /* found the entry */
+    if (found ||
+        (mfs_file_system[*dir_block].u.dir_data.dir_ent[*dir_index].deleted != 'y' &&
+         !strcmp(mfs_file_system[*dir_block].u.dir_data.dir_ent[*dir_index].name,
+                 tmpfilename))) { /* found the entry */
+      if (!found)
+        dir_index_add(dir, tmpfilename, *dir_block, *dir_index);
       /* *dir_index = index; */
       /* *dir_block = dir; */
       if (basename == 1) /* this is the base file name, ignore final '/' if present */
@@ -507,6 +652,8 @@ static int create_file(const char *filename, int file_type) {
     mfs_file_system[new_dir_block].u.dir_data.dir_ent[new_dir_index].index = new_entry_index;
     set_filename(mfs_file_system[new_dir_block].u.dir_data.dir_ent[new_dir_index].name, get_basename(filename));
     mfs_file_system[new_dir_block].u.dir_data.dir_ent[new_dir_index].deleted = 'n';
+    dir_index_add(first_dir_block, mfs_file_system[new_dir_block].u.dir_data.dir_ent[new_dir_index].name,
+                  new_dir_block, new_dir_index);
     return new_entry_index;
   }
 }
@@ -638,6 +785,9 @@ int mfs_rename_file(char *from_file, char *to_file) {
   if (get_dir_ent(from_file, &from_dir_block, &from_dir_index, &reuse_block, &reuse_index) &&
       !get_dir_ent(to_file, &to_dir_block, &to_dir_index, &reuse_block, &reuse_index)) {
     set_filename(mfs_file_system[from_dir_block].u.dir_data.dir_ent[from_dir_index].name, get_basename(to_file));
+    dir_index_add(get_first_dir_block(from_dir_block),
+                  mfs_file_system[from_dir_block].u.dir_data.dir_ent[from_dir_index].name,
+                  from_dir_block, from_dir_index);
     return 1;
   }
   return 0;
@@ -871,36 +1021,59 @@ int mfs_file_open(const char *filename, int mode) {
 */
 int mfs_file_read(int fd, char *buf, int buflen) {
   int num_read = 0;
-  char *from_ptr = (char *) &(mfs_file_system[mfs_open_files[fd].current_block].u.block_data[mfs_open_files[fd].offset]);
-  int num_left ;
-  num_left =  mfs_file_system[mfs_open_files[fd].current_block].block_size ;
+  const char *from_ptr;
+  int num_chunk;
+
+  /* copy a block at a time */
+  while (buflen > 0) {
+    num_chunk = mfs_file_read_ptr(fd, &from_ptr, buflen);
+    if (num_chunk == 0) /* nothing more to read */
+      break;
+    memcpy(buf, from_ptr, num_chunk);
+    buf += num_chunk;
+    num_read += num_chunk;
+    buflen -= num_chunk;
+  }
+  return num_read;
+}
+
+/**
+ * read characters from a file without copying them
+ * @param fd is a descriptor for the file from which the characters are read
+ * @param buf is set to point to the characters inside the file system memory
+ * @param buflen is the maximum number of characters to be read
+ * fd should be a valid index in mfs_open_files array
+ * Works only if fd points to a file and not a dir
+ * at most the rest of the current file block is returned
+ * @return num bytes available at buf or 0 for error=no bytes read
+*/
+int mfs_file_read_ptr(int fd, const char **buf, int buflen) {
+  int num_left;
+
+  num_left = mfs_file_system[mfs_open_files[fd].current_block].block_size;
   if (num_left > MFS_BLOCK_DATA_SIZE)
     num_left = MFS_BLOCK_DATA_SIZE;
-  num_left -=  mfs_open_files[fd].offset ;
-  while (buflen > 0) {
-    if (num_left == 0) { /* see if there is a next_block */
-      int next_block = mfs_file_system[mfs_open_files[fd].current_block].next_block;
-      if (next_block == 0) { /* nothing more to read */
-	break;
-      }
-      if (mfs_file_system[next_block].block_size == 0) { /* nothing more to read */
-	break;
-      }
-      from_ptr = (char *) &(mfs_file_system[next_block].u.block_data[0]);
-      num_left = mfs_file_system[next_block].block_size;
-      mfs_open_files[fd].current_block = next_block;
-      mfs_open_files[fd].offset = 0;
+  num_left -= mfs_open_files[fd].offset;
+  if (num_left <= 0) { /* see if there is a next_block */
+    int next_block = mfs_file_system[mfs_open_files[fd].current_block].next_block;
+    if (next_block == 0) { /* nothing more to read */
+      return 0;
     }
-
-    *buf = *from_ptr;
-    buf++;
-    from_ptr++;
-    mfs_open_files[fd].offset += 1;
-    num_read++;
-    num_left--;
-    buflen--;
+    if (mfs_file_system[next_block].block_size == 0) { /* nothing more to read */
+      return 0;
+    }
+    num_left = mfs_file_system[next_block].block_size;
+    mfs_open_files[fd].current_block = next_block;
+    mfs_open_files[fd].offset = 0;
   }
-  return num_read;
+  if (buflen < num_left)
+    num_left = buflen;
+  if (num_left <= 0)
+    return 0;
+
+  *buf = (const char *) &(mfs_file_system[mfs_open_files[fd].current_block].u.block_data[mfs_open_files[fd].offset]);
+  mfs_open_files[fd].offset += num_left;
+  return num_left;
 }
 
 /**
@@ -95,6 +95,16 @@ struct mfs_file_block {
 } ;
 
 #define MFS_MAX_OPEN_FILES 10
+/**
+ * number of entries in the hashed directory index, must be a power of 2
+ * the index is built by mfs_init_fs and caches the location of directory
+ * entries so that path lookups do not scan the directories
+ */
+#ifndef MFS_DIR_INDEX_SIZE
+#define MFS_DIR_INDEX_SIZE 256
+#endif
+/* number of index entries probed for a name before falling back to a scan */
+#define MFS_DIR_INDEX_PROBES 4
 #define MFS_MODE_READ 0
 #define MFS_MODE_WRITE 1
 /* MFS_MODE_CREATE creates a new file and opens it with MFS_MODE_WRITE */
@@ -277,6 +287,20 @@ int mfs_file_open(const char *filename, int mode) ;
 */
 int mfs_file_read(int fd, char *buf, int buflen) ;
 
+/**
+ * read characters from a file without copying them
+ * @param fd is a descriptor for the file from which the characters are read
+ * @param buf is set to point to the characters inside the file system memory
+ * @param buflen is the maximum number of characters to be read
+ * fd should be a valid index in mfs_open_files array
+ * The characters returned are contiguous, so fewer than buflen chars are
+ * returned at the end of a file block; call again to get the next block
+ * The file position is advanced past the returned characters
+ * The data must not be modified through buf
+ * @return num bytes available at buf or 0 at end of file
+*/
+int mfs_file_read_ptr(int fd, const char **buf, int buflen);
+
 /**
  * write characters to a file
  * @param fd is a descriptor for the file to which the characters are written
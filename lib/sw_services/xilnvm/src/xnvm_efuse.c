@@ -37,6 +37,9 @@
 * Ver   Who  Date        Changes
 * ----- ---- ---------- -------------------------------------------------------
 * 1.0   kal  08/16/2019 Initial release
+*       adk  10/15/2019 Rows read from the eFUSE array are kept in a verified
+*                       shadow and served from it until the next program
+*                       operation.
 *
 * </pre>
 *
@@ -52,6 +55,10 @@
 
 /*************************** Constant Definitions *****************************/
 
+/* Rows of each page kept in the read shadow */
+#define XNVM_EFUSE_SHADOW_ROWS			(64U)
+#define XNVM_EFUSE_SHADOW_PAGES			(3U)
+
 /***************************** Type Definitions *******************************/
 /* Operation mode - Read, Program(Write) */
 typedef enum {
@@ -65,6 +72,16 @@ typedef enum {
 	XNVM_EFUSE_MARGIN_RD
 } XNvm_EfuseRdMode;
 
+/*
+ * Read shadow of one eFUSE page. Every row is kept along with its complement,
+ * a row whose copies do not match is read from the eFUSE array again.
+ */
+typedef struct {
+	u32 Data[XNVM_EFUSE_SHADOW_ROWS];
+	u32 InvData[XNVM_EFUSE_SHADOW_ROWS];
+	u64 Valid;
+} XNvm_EfuseShadow;
+
 /****************** Macros (Inline Functions) Definitions *********************/
 
 #define XNVM_ONE_MICRO_SECOND			(1U)
@@ -92,12 +109,18 @@ static u32 XNvm_EfusePgmAndVerifyBit(u8 Page, u8 Row, u8 Col);
 static u32 XNvm_EfusePgmTBits(void);
 static u32 XNvm_EfuseCacheLoad(void);
 static u32 XNvm_EfuseCheckForTBits(void);
+static u32 XNvm_EfuseShadowRead(u8 Page, u8 StartRow, u8 RowCount,
+				u32* RowData);
+static void XNvm_EfuseShadowUpdate(u8 Page, u8 StartRow, u8 RowCount,
+				const u32* RowData);
+static void XNvm_EfuseShadowInvalidate(void);
 u32 XNvm_EfusePgmRows(u8 StartRow, u8 RowCount,
 			XNvm_EfuseType EfuseType, const u32* RowData);
 u32 XNvm_EfuseReadRows(XNvm_EfuseRdOpt ReadOption, u8 StartRow, u8 RowCount,
 			XNvm_EfuseType EfuseType, u32* RowData);
 
 /*************************** Variable Definitions *****************************/
+static XNvm_EfuseShadow EfuseShadow[XNVM_EFUSE_SHADOW_PAGES];
 
 /*************************** Function Definitions *****************************/
 
@@ -120,7 +143,9 @@ u32 XNvm_EfuseReadRows(XNvm_EfuseRdOpt ReadOption, u8 StartRow, u8 RowCount,
  *		XNVM_EFUSE_ERROR_RD -	eFUSE Read failed
  *		XST_FAILURE - 	Unexpected error
  *
- * @note	None.
+ * @note	Rows read from the eFUSE array are shadowed in memory, later
+ *		reads of the same rows do not access the eFUSE controller
+ *		until XNvm_EfusePgmRows() is called.
  *
  ******************************************************************************/
 u32 XNvm_EfuseReadRows(XNvm_EfuseRdOpt ReadOption, u8 StartRow, u8 RowCount,
@@ -160,8 +185,18 @@ u32 XNvm_EfuseReadRows(XNvm_EfuseRdOpt ReadOption, u8 StartRow, u8 RowCount,
 		Status = XNvm_EfuseReadCacheRange(StartRow, RowCount, RowData);
 	}
 	else {
+		Status = XNvm_EfuseShadowRead(EfuseType, StartRow, RowCount,
+						RowData);
+		if (XST_SUCCESS == Status) {
+			/* Served from the shadow, controller not accessed */
+			goto RET;
+		}
 		Status = XNvm_EfuseReadRowRange(XNVM_EFUSE_NORMAL_RD,
 				EfuseType, StartRow, RowCount, RowData);
+		if (XST_SUCCESS == Status) {
+			XNvm_EfuseShadowUpdate(EfuseType, StartRow, RowCount,
+						RowData);
+		}
 	}
 END :
 	if (ReadOption != XNVM_EFUSE_RD_FROM_CACHE) {
@@ -170,6 +205,7 @@ END :
 			Status = LockStatus;
 		}
 	}
+RET :
 	return Status;
 }
 
@@ -222,6 +258,8 @@ u32 XNvm_EfusePgmRows(u8 StartRow, u8 RowCount,
 		goto END;
 	}
 
+	XNvm_EfuseShadowInvalidate();
+
 	Status = XNvm_EfuseSetupController(XNVM_EFUSE_MODE_PGM,
 					XNVM_EFUSE_MARGIN_RD);
 	if (Status != XST_SUCCESS) {
@@ -1063,3 +1101,109 @@ static u32 XNvm_EfuseCheckForTBits(void)
 END :
 	return Status;
 }
+
+/******************************************************************************/
+/**
+ * @brief
+ * This function reads rows from the read shadow.
+ *
+ * @param	Page - Page number
+ *		StartRow - Starting Row number (0-based addressing)
+ *		RowCount - Number of Rows to be read
+ *		RowData  - Pointer to memory location where read 32-bit row
+ *			data(s) are to be stored
+ *
+ * @return
+ *		XST_SUCCESS - All the rows are valid in the shadow
+ *		XST_FAILURE - At least one row must be read from eFUSE
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static u32 XNvm_EfuseShadowRead(u8 Page, u8 StartRow, u8 RowCount,
+				u32* RowData)
+{
+	u32 Status = XST_FAILURE;
+	XNvm_EfuseShadow *ShadowPtr = &EfuseShadow[Page];
+	u32 Row;
+	u32 Idx;
+
+	if (((u32)StartRow + RowCount) > XNVM_EFUSE_SHADOW_ROWS) {
+		goto END;
+	}
+
+	for (Idx = 0U; Idx < RowCount; Idx++) {
+		Row = (u32)StartRow + Idx;
+		if (((ShadowPtr->Valid >> Row) & 0x1U) == 0U) {
+			goto END;
+		}
+		if ((ShadowPtr->Data[Row] ^ ShadowPtr->InvData[Row]) !=
+			0xFFFFFFFFU) {
+			ShadowPtr->Valid &= ~((u64)1U << Row);
+			goto END;
+		}
+	}
+
+	for (Idx = 0U; Idx < RowCount; Idx++) {
+		RowData[Idx] = ShadowPtr->Data[(u32)StartRow + Idx];
+	}
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+
+/******************************************************************************/
+/**
+ * @brief
+ * This function stores rows read from the eFUSE array in the read shadow.
+ * Rows beyond XNVM_EFUSE_SHADOW_ROWS are not shadowed.
+ *
+ * @param	Page - Page number
+ *		StartRow - Starting Row number (0-based addressing)
+ *		RowCount - Number of Rows read
+ *		RowData  - Pointer to the 32-bit row data(s) read
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static void XNvm_EfuseShadowUpdate(u8 Page, u8 StartRow, u8 RowCount,
+				const u32* RowData)
+{
+	XNvm_EfuseShadow *ShadowPtr = &EfuseShadow[Page];
+	u32 Row;
+	u32 Idx;
+
+	for (Idx = 0U; Idx < RowCount; Idx++) {
+		Row = (u32)StartRow + Idx;
+		if (Row >= XNVM_EFUSE_SHADOW_ROWS) {
+			break;
+		}
+		ShadowPtr->Data[Row] = RowData[Idx];
+		ShadowPtr->InvData[Row] = ~RowData[Idx];
+		ShadowPtr->Valid |= ((u64)1U << Row);
+	}
+}
+
+/******************************************************************************/
+/**
+ * @brief
+ * This function drops all the rows of the read shadow.
+ *
+ * @param	None.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static void XNvm_EfuseShadowInvalidate(void)
+{
+	u32 Page;
+
+	for (Page = 0U; Page < XNVM_EFUSE_SHADOW_PAGES; Page++) {
+		EfuseShadow[Page].Valid = 0U;
+	}
+}
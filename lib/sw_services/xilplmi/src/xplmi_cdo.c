@@ -35,6 +35,9 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   08/23/2018 Initial release
+*       kc   10/14/2019 Commands split between overlapping chunks are
+*                       processed in place
+*       kc   10/14/2019 Added fast path for write, mask write and mask poll
 *
 * </pre>
 *
@@ -44,9 +47,26 @@
 
 /***************************** Include Files *********************************/
 #include "xplmi_cdo.h"
+#include "xplmi_modules.h"
+#include "xil_io.h"
+#include "xplmi_timeline.h"
 
 /************************** Constant Definitions *****************************/
-#define XPLMI_CMD_LEN_TEMPBUF		(0x8U)
+#define XPLMI_CMD_LEN_TEMPBUF		(XPLMI_CDO_OVERLAP_LEN)
+
+/**
+ * Headers of the generic commands that are executed without going through
+ * XPlmi_CmdExecute. The handlers of these commands only print at DEBUG_INFO
+ * and DEBUG_DETAILED levels, the fast path is not used when they are on.
+ */
+#if ((XPlmiDbgCurrentTypes & (DEBUG_INFO | DEBUG_DETAILED)) == 0U)
+#define XPLMI_CDO_CMD_FAST_PATH
+#endif
+#define XPLMI_GENERIC_CMD_HDR(Len, ApiId)	\
+	(((Len) << 16U) | (XPLMI_MODULE_GENERIC_ID << 8U) | (ApiId))
+#define XPLMI_CMD_MASK_POLL_HDR		XPLMI_GENERIC_CMD_HDR(4U, 1U)
+#define XPLMI_CMD_MASK_WRITE_HDR	XPLMI_GENERIC_CMD_HDR(3U, 2U)
+#define XPLMI_CMD_WRITE_HDR		XPLMI_GENERIC_CMD_HDR(2U, 3U)
 
 /**************************** Type Definitions *******************************/
 
@@ -192,6 +212,7 @@ void XPlmi_InitCdo(XPlmiCdo *CdoPtr)
 	CdoPtr->ProcessedCdoLen = 0U;
 	CdoPtr->ImgId = 0U;
 	CdoPtr->PrtnId = 0U;
+	CdoPtr->OverlapLen = 0U;
 
 	/** Initialize the CDO buffer user params */
 	CdoPtr->CmdEndDetected = FALSE;
@@ -312,6 +333,46 @@ int XPlmi_CdoCmdExecute(XPlmiCdo *CdoPtr, u32 *BufPtr, u32 BufLen, u32 *Size)
 		goto END;
 	}
 
+#ifdef XPLMI_CDO_CMD_FAST_PATH
+	/**
+	 * Register writes and polls make most of the PL and NoC CDOs, execute
+	 * them here when the whole command is in the buffer. A mask poll that
+	 * is not satisfied by the first read goes through its handler, which
+	 * does the timeout.
+	 */
+	switch (BufPtr[0])
+	{
+		case XPLMI_CMD_WRITE_HDR:
+			if (BufLen > 2U) {
+				Xil_Out32(BufPtr[1], BufPtr[2]);
+				*Size = 3U;
+				Status = XST_SUCCESS;
+				goto END;
+			}
+			break;
+		case XPLMI_CMD_MASK_WRITE_HDR:
+			if (BufLen > 3U) {
+				Xil_Out32(BufPtr[1],
+					(Xil_In32(BufPtr[1]) & ~BufPtr[2]) |
+					(BufPtr[2] & BufPtr[3]));
+				*Size = 4U;
+				Status = XST_SUCCESS;
+				goto END;
+			}
+			break;
+		case XPLMI_CMD_MASK_POLL_HDR:
+			if ((BufLen > 4U) &&
+			    ((Xil_In32(BufPtr[1]) & BufPtr[2]) == BufPtr[3])) {
+				*Size = 5U;
+				Status = XST_SUCCESS;
+				goto END;
+			}
+			break;
+		default:
+			break;
+	}
+#endif
+
 	*Size = XPlmi_CmdSize(BufPtr, BufLen);
 	CmdPtr->Len = *Size;
 
@@ -372,6 +433,10 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 	u32 CopiedCmdLen = CdoPtr->CopiedCmdLen;
 	u32 *BufPtr = CdoPtr->BufPtr;
 	u32 BufLen = CdoPtr->BufLen;
+#ifdef PLM_BOOT_TIMELINE
+	u32 CmdId;
+	u32 CmdStartTicks;
+#endif
 
 	/** verify the header for the first chunk of CDO */
 	if (CdoPtr->Cdo1stChunk == TRUE)
@@ -389,6 +454,25 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 		CdoPtr->BufLen -= XPLMI_CDO_HDR_LEN;
 	}
 
+	/**
+	 * Skip the words that repeat the end of the previous chunk, except
+	 * the ones of a command that did not fit in it. That command is then
+	 * contiguous in this buffer and no copy to tempbuf is needed.
+	 */
+	if ((CdoPtr->OverlapLen != 0U) &&
+	    (CdoPtr->OverlapLen <= CdoPtr->BufLen) &&
+	    (CopiedCmdLen <= CdoPtr->OverlapLen))
+	{
+		BufPtr += CdoPtr->OverlapLen - CopiedCmdLen;
+		BufLen -= CdoPtr->OverlapLen - CopiedCmdLen;
+		CdoPtr->BufPtr = BufPtr;
+		CdoPtr->BufLen = BufLen;
+		/** The command words were counted with the previous chunk */
+		CdoPtr->ProcessedCdoLen -= CopiedCmdLen;
+		CdoPtr->CopiedCmdLen = 0U;
+		CopiedCmdLen = 0U;
+	}
+
 	/**
 	 * Check if BufLen is greater than CdoLen
 	 * This is required if more buffer is copied than CDO len.
@@ -429,15 +513,29 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 	/** Execute the commands in the Cdo Buffer */
 	while (BufLen > 0U)
 	{
+#ifdef PLM_BOOT_TIMELINE
+		CmdStartTicks = XPlmi_TlGetTicks();
+#endif
 		/** Check if cmd has to be resumed */
 		if (CdoPtr->CmdState == XPLMI_CMD_STATE_RESUME)
 		{
+#ifdef PLM_BOOT_TIMELINE
+			CmdId = CdoPtr->Cmd.CmdId;
+#endif
 			Status =
 			   XPlmi_CdoCmdResume(CdoPtr, BufPtr, BufLen, &Size);
 		} else {
+#ifdef PLM_BOOT_TIMELINE
+			CmdId = BufPtr[0U];
+#endif
 			Status =
 			   XPlmi_CdoCmdExecute(CdoPtr, BufPtr, BufLen, &Size);
 		}
+#ifdef PLM_BOOT_TIMELINE
+		/** A resumed command is timed once for every chunk */
+		XPlmi_TlCdoCmd(CmdId & (XPLMI_CMD_MODULE_ID_MASK |
+			XPLMI_CMD_API_ID_MASK), CdoPtr->ImgId, CmdStartTicks);
+#endif
 		/**
 		 * if command end is detected, or in case of any error,
 		 * exit the loop
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   08/23/2018 Initial release
+*       kc   10/14/2019 Added chunk overlap to process split commands in place
 *
 * </pre>
 *
@@ -64,6 +65,12 @@ extern "C" {
 
 #define XPLMI_CMD_STATE_RESUME		(1U)
 
+/**
+ * Words a chunk can repeat from the end of the previous chunk. It covers the
+ * longest command that is not executed partially at the end of a chunk.
+ */
+#define XPLMI_CDO_OVERLAP_LEN		(0x8U)
+
 /**************************** Type Definitions *******************************/
 /**
  * The XPlmiCdo is instance data. The user is required to allocate a
@@ -85,6 +92,8 @@ typedef struct {
 				CDO header*/
 	u32 ImgId;		/** Info about which Image this belongs to */
 	u32 PrtnId;		/** Info about which partition this belongs to*/
+	u32 OverlapLen;		/**< Words at the start of the buffer that repeat
+				the end of the previous chunk */
 } XPlmiCdo;
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   08/23/2018 Initial release
+*       kc   10/14/2019 Removed the handler check, done at registration
 *
 * </pre>
 *
@@ -95,13 +96,8 @@ int XPlmi_CmdExecute(XPlmi_Cmd * Cmd)
 		goto END;
 	}
 
-	/** Check if proper handler is registered */
+	/** Handlers are never NULL, see XPlmi_ModuleRegister */
 	ModuleCmd = &Module->CmdAry[ApiId];
-	if (ModuleCmd->Handler == NULL)
-	{
-		Status = XPLMI_UPDATE_STATUS(XPLMI_ERR_CMD_HANDLER_NULL, 0x0);
-		goto END;
-	}
 
 	XPlmi_Printf(DEBUG_DETAILED, "CMD 0x%0x, Len 0x%0x, PayloadLen 0x%0x \n\r",
 		     Cmd->CmdId, Cmd->Len, Cmd->PayloadLen);
@@ -110,7 +106,10 @@ int XPlmi_CmdExecute(XPlmi_Cmd * Cmd)
 	Status = ModuleCmd->Handler(Cmd);
 	if (Status != XST_SUCCESS)
 	{
-		Status = XPLMI_UPDATE_STATUS(XPLMI_ERR_CMD_HANDLER, Status);
+		if (ModuleCmd->Handler != XPlmi_CmdHandlerNull) {
+			Status = XPLMI_UPDATE_STATUS(XPLMI_ERR_CMD_HANDLER,
+						     Status);
+		}
 		goto END;
 	}
 
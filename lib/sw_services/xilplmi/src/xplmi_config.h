@@ -36,6 +36,10 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/21/2017 Initial release
+* 1.01  adk  10/15/2019 Added PLM_OSPI_PERF_TEST option
+*                       Added PLM_SSIT_CONCURRENT option
+*                       Added PLM_PRTN_CACHE option
+*                       Added PLM_PDI_HDR_CACHE option
 *
 * </pre>
 *
@@ -89,6 +93,57 @@ extern "C" {
  */
 #define PLM_PRINT_PERF
 
+/**
+ * Enabling the PLM_BOOT_TIMELINE records the time taken for loading images,
+ * partitions and the secure stages, and the slowest CDO commands, in a
+ * buffer that can be read with the PLM get timeline command.
+ */
+#define PLM_BOOT_TIMELINE
+
+/**
+ * Enabling the PLM_PMON_PROFILE adds the LPD traffic profiling command,
+ * which measures the ports of the LPD performance monitor over a window.
+ * It needs the pmonpsv driver in the PLM BSP.
+ */
+#define PLM_PMON_PROFILE
+
+/**
+ * Enabling the PLM_OSPI_PERF_TEST reads the first 1 MB of the OSPI flash
+ * when OSPI boot device is initialized, checks the data of the non blocking
+ * reads and prints the read throughput.
+ */
+//#define PLM_OSPI_PERF_TEST
+
+/**
+ * Enabling the PLM_SSIT_CONCURRENT makes the DMA XFER commands which write
+ * to a slave SLR run in the background on PMC DMA1, so that the slave SLRs
+ * load their partitions while the master continues with its own. The
+ * transfers are completed by the SSIT sync and wait slaves commands, which
+ * also print the time taken by each slave SLR.
+ */
+#define PLM_SSIT_CONCURRENT
+
+/**
+ * Enabling the PLM_PRTN_CACHE keeps a copy of the elf and data partitions
+ * of the full PDI images in DDR, along with their SHA3 hash in PMC RAM.
+ * When the image is restarted, its partitions are copied from DDR and
+ * checked against the hash instead of being read and authenticated again
+ * from the boot device. Encrypted partitions are not cached. The copies
+ * use the XLOADER_PRTN_CACHE_SIZE bytes of DDR at
+ * XLOADER_PRTN_CACHE_BASEADDR, which must not be used by the applications.
+ */
+//#define PLM_PRTN_CACHE
+
+/**
+ * Enabling the PLM_PDI_HDR_CACHE keeps the validated image header table,
+ * image headers and partition headers of the last partial PDIs loaded from
+ * DDR in PMC RAM. When a PDI is loaded again from the same address, only its
+ * image header table is read and compared with the cached one, and the
+ * headers are not read and validated again. Authenticated and encrypted PDIs
+ * are not cached.
+ */
+//#define PLM_PDI_HDR_CACHE
+
 /**
  * @name PLM code include options
  *
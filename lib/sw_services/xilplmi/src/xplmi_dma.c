@@ -34,6 +34,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   12/21/2018 Initial release
+* 1.01  adk  10/15/2019 Non blocking SBI to DMA transfers are tracked and
+*                       waited for on their channel
 *
 * </pre>
 *
@@ -49,16 +51,46 @@
 #include "xplmi_status.h"
 #include "xplmi_hw.h"
 /************************** Constant Definitions *****************************/
+#define XPLMI_DMA_QUEUES		(2U)
+/** Channels of a non blocking transfer, bit position is XCsuDma_Channel */
+#define XPLMI_NONBLK_CH_SRC		(0x1U)
+#define XPLMI_NONBLK_CH_DST		(0x2U)
 
 /**************************** Type Definitions *******************************/
+/** Transfers queued on one PMC DMA, Head is the one in progress */
+typedef struct {
+	XCsuDma *DmaPtr;
+	XPlmi_DmaDesc *Head;
+	XPlmi_DmaDesc *Tail;
+} XPlmi_DmaQueue;
+
 /***************** Macros (Inline Functions) Definitions *********************/
+#define XPlmi_DmaChDone(DmaPtr, Channel) \
+	((XCsuDma_ReadReg((DmaPtr)->Config.BaseAddress, \
+		(u32)XCSUDMA_I_STS_OFFSET + \
+		((u32)(Channel) * (u32)XCSUDMA_OFFSET_DIFF)) & \
+		XCSUDMA_IXR_DONE_MASK) == XCSUDMA_IXR_DONE_MASK)
+
+#define XPlmi_DmaQueueIndex(Flags) \
+	((((Flags) & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) ? 0U : 1U)
+
 /************************** Function Prototypes ******************************/
+static void XPlmi_DmaStartXfr(XCsuDma *DmaPtr, u64 SrcAddr, u64 DestAddr,
+		u32 Len, u32 Flags);
+static void XPlmi_DmaQueueStart(XPlmi_DmaQueue *Queue);
+static void XPlmi_DmaQueueDrain(u32 Flags);
 
 /************************** Variable Definitions *****************************/
 XCsuDma CsuDma0;		/**<Instance of the Csu_Dma Device */
 XCsuDma CsuDma1;		/**<Instance of the Csu_Dma Device */
 XCsuDma_Configure DmaCtrl = {0x40, 0, 0, 0, 0xFFE, 0x80,
 			0, 0, 0, 0xFFF, 0x8};  /* Default values of CTRL */
+static XPlmi_DmaQueue DmaQueue[XPLMI_DMA_QUEUES] = {
+	{&CsuDma0, NULL, NULL},
+	{&CsuDma1, NULL, NULL},
+};
+/** Channels of the non blocking transfer in progress on PMC DMA1 */
+static u32 NonBlkDma1Pending = 0U;
 
 
 /*****************************************************************************/
@@ -281,6 +313,9 @@ int XPlmi_DmaChXfer(u64 Addr, u32 Len, XCsuDma_Channel Channel, u32 Flags)
 	int Status;
 	XCsuDma *DmaPtr;
 
+	/* Queued transfers complete first */
+	XPlmi_DmaQueueDrain(Flags);
+
 	/* Select DMA pointer */
 	if ((Flags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
 		XPlmi_Printf(DEBUG_INFO, "PMCDMA0\n\r");
@@ -305,6 +340,9 @@ int XPlmi_DmaChXfer(u64 Addr, u32 Len, XCsuDma_Channel Channel, u32 Flags)
 
 	if((Flags & XPLMI_DMA_SRC_NONBLK) != 0U)
 	{
+		if (DmaPtr == &CsuDma1) {
+			NonBlkDma1Pending = (u32)1U << (u32)Channel;
+		}
 		Status = XST_SUCCESS;
 		goto END;
 	}
@@ -329,8 +367,27 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * This function waits for the non blocking transfer on PMC DMA1. Only the
+ * channel used is waited for when the transfer is from or to the SBI.
+ *
+ * @param	None
+ *
+ * @return	None
+ *****************************************************************************/
 void XPlmi_WaitForNonBlkDma(void)
 {
+	if (NonBlkDma1Pending == XPLMI_NONBLK_CH_DST) {
+		XPlmi_WaitForNonBlkDstDma();
+		goto END;
+	} else if (NonBlkDma1Pending == XPLMI_NONBLK_CH_SRC) {
+		XPlmi_WaitForNonBlkSrcDma();
+		goto END;
+	} else {
+		/* For MISRA C compliance */
+	}
+
 	XCsuDma_SetConfig(&CsuDma1, XCSUDMA_SRC_CHANNEL, &DmaCtrl);
 	XCsuDma_WaitForDone(&CsuDma1, XCSUDMA_DST_CHANNEL);
 	XCsuDma_WaitForDone(&CsuDma1, XCSUDMA_SRC_CHANNEL);
@@ -344,7 +401,9 @@ void XPlmi_WaitForNonBlkDma(void)
 	DmaCtrl.AxiBurstType=0U;
 	XCsuDma_SetConfig(&CsuDma1, XCSUDMA_SRC_CHANNEL, &DmaCtrl);
 	XCsuDma_SetConfig(&CsuDma1, XCSUDMA_DST_CHANNEL, &DmaCtrl);
+	NonBlkDma1Pending = 0U;
 
+END:
 	return;
 }
 
@@ -359,6 +418,30 @@ void XPlmi_WaitForNonBlkSrcDma(void)
 
         DmaCtrl.AxiBurstType=0U;
         XCsuDma_SetConfig(&CsuDma1, XCSUDMA_SRC_CHANNEL, &DmaCtrl);
+	NonBlkDma1Pending = 0U;
+
+	return;
+}
+
+/*****************************************************************************/
+/**
+ * This function waits for the non blocking SBI to DMA transfer on PMC DMA1
+ *
+ * @param	None
+ *
+ * @return	None
+ *****************************************************************************/
+void XPlmi_WaitForNonBlkDstDma(void)
+{
+	XCsuDma_WaitForDone(&CsuDma1, XCSUDMA_DST_CHANNEL);
+
+	/* To acknowledge the transfer has completed */
+	XCsuDma_IntrClear(&CsuDma1, XCSUDMA_DST_CHANNEL,
+					XCSUDMA_IXR_DONE_MASK);
+
+	DmaCtrl.AxiBurstType=0U;
+	XCsuDma_SetConfig(&CsuDma1, XCSUDMA_DST_CHANNEL, &DmaCtrl);
+	NonBlkDma1Pending = 0U;
 
 	return;
 }
@@ -436,6 +519,10 @@ int XPlmi_DmaXfr(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags)
 	}
 	else
 	{
+		if (DmaPtr == &CsuDma1) {
+			NonBlkDma1Pending = XPLMI_NONBLK_CH_SRC |
+				XPLMI_NONBLK_CH_DST;
+		}
 		goto END;
 	}
 	if((Flags & XPLMI_DMA_DST_NONBLK) == FALSE)
@@ -490,7 +577,6 @@ int XPlmi_StartDma(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags,
 						XCsuDma** DmaPtrAddr)
 {
 	int Status;
-	u32 EnLast=0U;
 	XCsuDma *DmaPtr;
 
 	XPlmi_Printf(DEBUG_INFO, "DMA Xfer Src 0x%0x%08x, Dest 0x%0x%08x, "
@@ -498,6 +584,9 @@ int XPlmi_StartDma(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags,
 		     (u32)(SrcAddr>>32), (u32)SrcAddr, (u32)(DestAddr>>32),
 		     (u32)DestAddr, Len, Flags);
 
+	/* Queued transfers complete first */
+	XPlmi_DmaQueueDrain(Flags);
+
 	/* Select DMA pointer */
 	if ((Flags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0) {
 		XPlmi_Printf(DEBUG_INFO, "PMCDMA0\n\r");
@@ -509,6 +598,31 @@ int XPlmi_StartDma(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags,
 
 	XPlmi_PrintArray(DEBUG_DETAILED, SrcAddr, Len, "DMA Xfer Data");
 
+	XPlmi_DmaStartXfr(DmaPtr, SrcAddr, DestAddr, Len, Flags);
+	*DmaPtrAddr = DmaPtr;
+	Status = XST_SUCCESS;
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function configures the SSS and the AXI burst type of a DMA and
+ * starts a memory to memory transfer on it.
+ *
+ * @param	DmaPtr is the DMA to use
+ * @param	SrcAddr is the source address
+ * @param	DestAddr is the destination address
+ * @param	Len is the number of words to transfer
+ * @param	Flags are the DMA XFER flags
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XPlmi_DmaStartXfr(XCsuDma *DmaPtr, u64 SrcAddr, u64 DestAddr,
+		u32 Len, u32 Flags)
+{
+	u32 EnLast=0U;
+
 	/* Configure the secure stream switch */
 	XPlmi_SSSCfgDmaDma(Flags);
 
@@ -530,9 +644,6 @@ int XPlmi_StartDma(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags,
 		0xFFFFFFFFU), (u32)(DestAddr>>32U), Len, EnLast);
 	XCsuDma_64BitTransfer(DmaPtr, XCSUDMA_SRC_CHANNEL, (u32)(SrcAddr &
 		0xFFFFFFFFU), (u32)(SrcAddr>>32U), Len, EnLast);
-	*DmaPtrAddr = DmaPtr;
-	Status = XST_SUCCESS;
-	return Status;
 }
 
 /*****************************************************************************/
@@ -598,3 +709,183 @@ void XPlmi_SetMaxOutCmds(u32 Val)
 {
 	DmaCtrl.MaxOutCmds = Val;
 }
+
+/*****************************************************************************/
+/**
+ * This function adds a transfer to the queue of the PMC DMA selected by the
+ * descriptor flags and returns without waiting. Each PMC DMA runs one queued
+ * transfer at a time, in the order of submission, and PMC DMA0 and DMA1 run
+ * in parallel. Completion is reported by the descriptor callback, which is
+ * called from XPlmi_DmaQueuePoll or XPlmi_DmaQueueWait and can trigger a
+ * PLM task.
+ *
+ * Blocking and non blocking transfers of the other XPlmi DMA APIs wait for
+ * the queue of their DMA to be empty before they start, and the queue waits
+ * for a non blocking XPlmi_DmaXfr on PMC DMA1 to be done.
+ *
+ * @param	Desc is the transfer descriptor
+ *
+ * @return	XST_SUCCESS if the transfer is queued, XST_INVALID_PARAM for
+ *		a zero length or an ECC init that is not on PMC DMA0
+ *
+ * @note	PMC DMA0 is also used by SHA3 and AES, its queue must be empty
+ *		when they are started.
+ *
+ *****************************************************************************/
+int XPlmi_DmaQueueSubmit(XPlmi_DmaDesc *Desc)
+{
+	int Status = XST_INVALID_PARAM;
+	u32 Index = XPlmi_DmaQueueIndex(Desc->Flags);
+	XPlmi_DmaQueue *Queue = &DmaQueue[Index];
+
+	if (Desc->Len == 0U) {
+		goto END;
+	}
+
+	/* PZM has a single size register, ECC init is kept on one DMA */
+	if ((Desc->Type == XPLMI_DMA_DESC_ECC_INIT) && (Index != 0U)) {
+		goto END;
+	}
+
+	if ((Index == 1U) && (NonBlkDma1Pending != 0U)) {
+		XPlmi_WaitForNonBlkDma();
+	}
+
+	Desc->Next = NULL;
+	if (Queue->Tail == NULL) {
+		Queue->Head = Desc;
+		Queue->Tail = Desc;
+		XPlmi_DmaQueueStart(Queue);
+	} else {
+		Queue->Tail->Next = Desc;
+		Queue->Tail = Desc;
+	}
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function starts the transfer at the head of a DMA queue.
+ *
+ * @param	Queue is the DMA queue
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XPlmi_DmaQueueStart(XPlmi_DmaQueue *Queue)
+{
+	XPlmi_DmaDesc *Desc = Queue->Head;
+
+	if (Desc->Type == XPLMI_DMA_DESC_ECC_INIT) {
+		XPlmi_SSSCfgDmaPzm(XPLMI_PMCDMA_0);
+		XPlmi_Out32(PMC_GLOBAL_PRAM_ZEROIZE_SIZE, Desc->Len/16U);
+		XCsuDma_64BitTransfer(Queue->DmaPtr, XCSUDMA_DST_CHANNEL,
+			(u32)(Desc->DestAddr & 0xFFFFFFFFU),
+			(u32)(Desc->DestAddr >> 32U), Desc->Len/4U, 0U);
+	} else {
+		XPlmi_DmaStartXfr(Queue->DmaPtr, Desc->SrcAddr,
+			Desc->DestAddr, Desc->Len, Desc->Flags);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * This function completes the queued transfers that are done and starts the
+ * next ones. The callbacks are called after the next transfer is started,
+ * so the DMA does not wait for them.
+ *
+ * @param	None
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XPlmi_DmaQueuePoll(void)
+{
+	XPlmi_DmaQueue *Queue;
+	XPlmi_DmaDesc *Desc;
+	u32 Index;
+
+	for (Index = 0U; Index < XPLMI_DMA_QUEUES; Index++) {
+		Queue = &DmaQueue[Index];
+		while (Queue->Head != NULL) {
+			Desc = Queue->Head;
+			if (XPlmi_DmaChDone(Queue->DmaPtr,
+					XCSUDMA_DST_CHANNEL) == FALSE) {
+				break;
+			}
+			if ((Desc->Type == XPLMI_DMA_DESC_XFER) &&
+			    (XPlmi_DmaChDone(Queue->DmaPtr,
+					XCSUDMA_SRC_CHANNEL) == FALSE)) {
+				break;
+			}
+
+			/* To acknowledge the transfer has completed */
+			XCsuDma_IntrClear(Queue->DmaPtr, XCSUDMA_DST_CHANNEL,
+					XCSUDMA_IXR_DONE_MASK);
+			if (Desc->Type == XPLMI_DMA_DESC_XFER) {
+				XCsuDma_IntrClear(Queue->DmaPtr,
+					XCSUDMA_SRC_CHANNEL,
+					XCSUDMA_IXR_DONE_MASK);
+			}
+
+			/* Revert the setting of PMC_DMA in AXI FIXED mode */
+			if ((Desc->Flags & (XPLMI_SRC_CH_AXI_FIXED |
+					XPLMI_DST_CH_AXI_FIXED)) != 0U) {
+				DmaCtrl.AxiBurstType=0U;
+				XCsuDma_SetConfig(Queue->DmaPtr,
+					XCSUDMA_SRC_CHANNEL, &DmaCtrl);
+				XCsuDma_SetConfig(Queue->DmaPtr,
+					XCSUDMA_DST_CHANNEL, &DmaCtrl);
+			}
+
+			Queue->Head = Desc->Next;
+			if (Queue->Head == NULL) {
+				Queue->Tail = NULL;
+			} else {
+				XPlmi_DmaQueueStart(Queue);
+			}
+
+			if (Desc->Callback != NULL) {
+				Desc->Callback(Desc);
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * This function waits for the queues of both PMC DMAs to be empty.
+ *
+ * @param	None
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XPlmi_DmaQueueWait(void)
+{
+	while ((DmaQueue[0U].Head != NULL) || (DmaQueue[1U].Head != NULL)) {
+		XPlmi_DmaQueuePoll();
+	}
+}
+
+/*****************************************************************************/
+/**
+ * This function waits for the queue of the PMC DMA selected by the flags
+ * to be empty.
+ *
+ * @param	Flags are the DMA XFER flags
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XPlmi_DmaQueueDrain(u32 Flags)
+{
+	XPlmi_DmaQueue *Queue = &DmaQueue[XPlmi_DmaQueueIndex(Flags)];
+
+	while (Queue->Head != NULL) {
+		XPlmi_DmaQueuePoll();
+	}
+}
@@ -34,6 +34,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/21/2017 Initial release
+* 1.01  adk  10/15/2019 Added XPlmi_WaitForNonBlkDstDma
 *
 * </pre>
 *
@@ -106,6 +107,27 @@ extern "C" {
 
 #define XPLMI_DATA_INIT_PZM			(0xDEADBEEFU)
 
+/** DMA queue descriptor types */
+#define XPLMI_DMA_DESC_XFER			(0U) /**< Memory to memory */
+#define XPLMI_DMA_DESC_ECC_INIT			(1U) /**< PZM to memory */
+
+/**
+ * DMA queue descriptor. The descriptor is owned by the queue from
+ * XPlmi_DmaQueueSubmit until its callback is called, it must not be
+ * modified or reused in between.
+ */
+typedef struct XPlmi_DmaDesc XPlmi_DmaDesc;
+struct XPlmi_DmaDesc {
+	u64 SrcAddr;		/**< Source address, unused for ECC init */
+	u64 DestAddr;		/**< Destination address */
+	u32 Len;		/**< Length in words, in bytes for ECC init */
+	u32 Flags;		/**< PMCDMA_0/1 and AXI FIXED flags */
+	u32 Type;		/**< XPLMI_DMA_DESC_XFER or _ECC_INIT */
+	void (*Callback)(XPlmi_DmaDesc *Desc); /**< Completion, can be NULL */
+	void *PrivData;		/**< For the use of the callback */
+	XPlmi_DmaDesc *Next;	/**< Used by the queue */
+};
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
@@ -120,7 +142,11 @@ int XPlmi_StartDma(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags,
 		XCsuDma** DmaPtrAddr);
 void XPlmi_WaitForNonBlkSrcDma(void);
 void XPlmi_WaitForNonBlkDma(void);
+void XPlmi_WaitForNonBlkDstDma(void);
 void XPlmi_SetMaxOutCmds(u32 Val);
+int XPlmi_DmaQueueSubmit(XPlmi_DmaDesc *Desc);
+void XPlmi_DmaQueuePoll(void);
+void XPlmi_DmaQueueWait(void);
 #ifdef __cplusplus
 }
 #endif
@@ -35,6 +35,10 @@
 * Ver   Who  Date        Changes
 * ====  ==== ======== ======================================================-
 * 1.00  kc   02/12/2019 Initial release
+* 1.01  adk  10/15/2019 Error interrupts are handled from one scan of the
+*                       error status registers, with rate limiting, and
+*                       non critical errors are handled from a task
+*       adk  10/15/2019 The PMC sysmon alarms are handled from the interrupt
 *
 * </pre>
 *
@@ -47,6 +51,8 @@
 #include "xplmi.h"
 #include "xpm_node.h"
 #include "xplmi_sysmon.h"
+#include "xplmi_task.h"
+#include "xplmi_scheduler.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -54,9 +60,68 @@
 
 /***************** Macros (Inline Functions) Definitions *********************/
 #define	XPLMI_ERR_REG_MASK(ErrorId)	(0x1U << (NODEINDEX(ErrorId)%32))
+#define XPLMI_ERR_REG_INDEX(ErrorId)	(NODEINDEX(ErrorId) / \
+					 XPLMI_ERR_BITS_PER_REG)
 /************************** Function Prototypes ******************************/
+static int XPlmi_ErrTaskHandler(void *Data);
+static int XPlmi_ErrRateWindow(void);
 
 /************************** Variable Definitions *****************************/
+/* Error status and interrupt registers, in XPLMI_ERR_REG_* order */
+static const u32 ErrStatusRegs[XPLMI_ERR_NUM_REGS] = {
+	PMC_GLOBAL_PMC_ERR1_STATUS,
+	PMC_GLOBAL_PMC_ERR2_STATUS,
+	PSM_GLOBAL_REG_PSM_ERR1_STATUS,
+	PSM_GLOBAL_REG_PSM_ERR2_STATUS,
+};
+
+static const u32 ErrIrqMaskRegs[XPLMI_ERR_NUM_REGS] = {
+	PMC_GLOBAL_PMC_IRQ1_MASK,
+	PMC_GLOBAL_PMC_IRQ2_MASK,
+	PSM_GLOBAL_REG_PSM_IRQ1_MASK,
+	PSM_GLOBAL_REG_PSM_IRQ2_MASK,
+};
+
+static const u32 ErrIrqEnRegs[XPLMI_ERR_NUM_REGS] = {
+	PMC_GLOBAL_PMC_IRQ1_EN,
+	PMC_GLOBAL_PMC_IRQ2_EN,
+	PSM_GLOBAL_REG_PSM_IRQ1_EN,
+	PSM_GLOBAL_REG_PSM_IRQ2_EN,
+};
+
+static const u32 ErrIrqDisRegs[XPLMI_ERR_NUM_REGS] = {
+	PMC_GLOBAL_PMC_IRQ1_DIS,
+	PMC_GLOBAL_PMC_IRQ2_DIS,
+	PSM_GLOBAL_REG_PSM_IRQ1_DIS,
+	PSM_GLOBAL_REG_PSM_IRQ2_DIS,
+};
+
+/*
+ * Errors handled from the interrupt. The others, which include the
+ * correctable SEU and CFRAME errors reported by SEM, are handled from a low
+ * priority task so that they do not delay the command processing.
+ */
+static const u32 ErrCriticalMask[XPLMI_ERR_NUM_REGS] = {
+	/* BOOT, FW, GSW, PMC_PSM, DDRMB, NOCTYPE1, ME, DDRMC, GT, PLSMON CR */
+	0x00551515U,
+	/* MB_FATAL0, MB_FATAL1, PMC_CR, PMCSMON0-9 */
+	0x0001FFACU,
+	/* PS_SW, PSM_B CR, MB_FATAL, PSM_CR, CPM_CR */
+	0x00010035U,
+	/* LPD_SWDT, FPD_SWDT */
+	0x00000003U,
+};
+
+/* Error interrupt state */
+static struct {
+	u32 Pending[XPLMI_ERR_NUM_REGS];	/* Errors left to the task */
+	u32 Throttled[XPLMI_ERR_NUM_REGS];	/* Errors over the rate limit */
+	u32 NumRegs;		/* Registers scanned, PSM ones once LPD is up */
+	u8 WindowUsed;		/* Handlers were called in the rate window */
+	XPlmi_TaskNode *Task;	/* Task handling the non critical errors */
+} ErrIntr = {
+	.NumRegs = XPLMI_ERR_REG_PSM_ERR1,
+};
 
 /*****************************************************************************/
 /**
@@ -345,6 +410,7 @@ int XPlmi_EmDisable(u32 ErrorId)
 	}
 
 	RegMask = XPLMI_ERR_REG_MASK(ErrorId);
+	ErrIntr.Throttled[XPLMI_ERR_REG_INDEX(ErrorId)] &= ~RegMask;
 
 	switch (NODETYPE(ErrorId)) {
 	case XPM_NODETYPE_EVENT_PMC_ERR1:
@@ -662,6 +728,22 @@ void XPlmi_EmInit(void)
 	/* Register Error module commands */
 	XPlmi_ErrModuleInit();
 
+	/* Task for the non critical errors, kept between the interrupts */
+	ErrIntr.Task = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1,
+			XPlmi_ErrTaskHandler, NULL);
+	if (ErrIntr.Task != NULL) {
+		ErrIntr.Task->Flags = XPLMI_TASK_FLAG_PERSISTENT;
+	} else {
+		XPlmi_Printf(DEBUG_GENERAL,
+			"Warning: XPlmi_EmInit: Failed to create error task\r\n");
+	}
+
+	if (XPlmi_SchedulerAddTask(XPlmi_ErrRateWindow,
+			XPLMI_ERR_RATE_WINDOW_MS) != XST_SUCCESS) {
+		XPlmi_Printf(DEBUG_GENERAL,
+			"Warning: XPlmi_EmInit: Failed to add rate window\r\n");
+	}
+
 	/* Disable all the Error Actions */
 	XPlmi_Out32(PMC_GLOBAL_PMC_POR1_DIS, MASK32_ALL_HIGH);
 	XPlmi_Out32(PMC_GLOBAL_PMC_ERR_OUT1_DIS, MASK32_ALL_HIGH);
@@ -720,8 +802,11 @@ int XPlmi_PsEmInit(void)
 	XPlmi_Out32(PSM_GLOBAL_REG_PSM_SRST1_DIS, MASK32_ALL_HIGH);
 
 	/* Clear the error status registers */
-	XPlmi_Out32(PMC_GLOBAL_PMC_ERR1_STATUS, MASK32_ALL_HIGH);
-	XPlmi_Out32(PMC_GLOBAL_PMC_ERR2_STATUS, MASK32_ALL_HIGH);
+	XPlmi_Out32(PSM_GLOBAL_REG_PSM_ERR1_STATUS, MASK32_ALL_HIGH);
+	XPlmi_Out32(PSM_GLOBAL_REG_PSM_ERR2_STATUS, MASK32_ALL_HIGH);
+
+	/* Scan the PSM error registers on the next error interrupts */
+	ErrIntr.NumRegs = XPLMI_ERR_NUM_REGS;
 
 	/* Set the default actions as defined in the Error table */
 	for (Index = XPM_NODEIDX_ERROR_PS_SW_CR;
@@ -750,6 +835,179 @@ int XPlmi_PsEmInit(void)
 	return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function calls the custom handlers of the errors in a mask
+ * of an error register.
+ * @param RegIdx is the error register, XPLMI_ERR_REG_*
+ * @param Mask is the mask of the errors
+ * @return None
+ *****************************************************************************/
+static void XPlmi_ErrDispatch(u32 RegIdx, u32 Mask)
+{
+	u32 Index;
+
+	while (Mask != 0U) {
+		Index = (RegIdx * XPLMI_ERR_BITS_PER_REG) +
+			(u32)__builtin_ctz(Mask);
+		Mask &= (Mask - 1U);
+
+		if ((Index < (u32)XPM_NODEIDX_ERROR_PSMERR2_MAX) &&
+		    (XPLMI_EM_ACTION_CUSTOM == ErrorTable[Index].Action) &&
+		    (NULL != ErrorTable[Index].Handler)) {
+			ErrorTable[Index].Handler((u8)Index);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function is the handler of the error interrupt. Each error
+ * status register is read and cleared once, the critical errors are
+ * handled right away and the others are left to the error task. An error
+ * which interrupts more than XPLMI_ERR_RATE_LIMIT times in a rate window
+ * has its interrupt disabled until the window ends.
+ * @param CallbackRef is the interrupt number, unused
+ * @return None
+ *****************************************************************************/
+void XPlmi_ErrIntrHandler(void *CallbackRef)
+{
+	u32 RegIdx;
+	u32 ErrStatus;
+	u32 Mask;
+	u32 Throttle;
+	u32 Index;
+	u8 Defer = FALSE;
+
+	(void)CallbackRef;
+
+	for (RegIdx = 0U; RegIdx < ErrIntr.NumRegs; RegIdx++) {
+		ErrStatus = XPlmi_In32(ErrStatusRegs[RegIdx]) &
+			~XPlmi_In32(ErrIrqMaskRegs[RegIdx]);
+		if (0U == ErrStatus) {
+			continue;
+		}
+		XPlmi_Out32(ErrStatusRegs[RegIdx], ErrStatus);
+
+		Throttle = 0U;
+		Mask = ErrStatus;
+		while (Mask != 0U) {
+			Index = (RegIdx * XPLMI_ERR_BITS_PER_REG) +
+				(u32)__builtin_ctz(Mask);
+			if (Index < (u32)XPM_NODEIDX_ERROR_PSMERR2_MAX) {
+				ErrorTable[Index].Count++;
+				if (ErrorTable[Index].WindowCount <
+				    XPLMI_ERR_RATE_LIMIT) {
+					ErrorTable[Index].WindowCount++;
+				} else {
+					Throttle |= (Mask & ~(Mask - 1U));
+				}
+			}
+			Mask &= (Mask - 1U);
+		}
+		ErrIntr.WindowUsed = TRUE;
+
+		if (Throttle != 0U) {
+			XPlmi_Out32(ErrIrqDisRegs[RegIdx], Throttle);
+			ErrIntr.Throttled[RegIdx] |= Throttle;
+			ErrStatus &= ~Throttle;
+		}
+
+		XPlmi_ErrDispatch(RegIdx, ErrStatus & ErrCriticalMask[RegIdx]);
+
+		Mask = ErrStatus & ~ErrCriticalMask[RegIdx];
+		if ((Mask != 0U) && (ErrIntr.Task != NULL)) {
+			ErrIntr.Pending[RegIdx] |= Mask;
+			Defer = TRUE;
+		} else {
+			XPlmi_ErrDispatch(RegIdx, Mask);
+		}
+	}
+
+	if (TRUE == Defer) {
+		XPlmi_TaskTriggerNow(ErrIntr.Task);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function is the handler of the error task. It handles the
+ * non critical errors left by the error interrupt, a burst of them is
+ * handled in one run.
+ * @param Data is unused
+ * @return XST_SUCCESS
+ *****************************************************************************/
+static int XPlmi_ErrTaskHandler(void *Data)
+{
+	u32 Pending[XPLMI_ERR_NUM_REGS];
+	u32 RegIdx;
+
+	(void)Data;
+
+	microblaze_disable_interrupts();
+	for (RegIdx = 0U; RegIdx < XPLMI_ERR_NUM_REGS; RegIdx++) {
+		Pending[RegIdx] = ErrIntr.Pending[RegIdx];
+		ErrIntr.Pending[RegIdx] = 0U;
+	}
+	microblaze_enable_interrupts();
+
+	for (RegIdx = 0U; RegIdx < XPLMI_ERR_NUM_REGS; RegIdx++) {
+		XPlmi_ErrDispatch(RegIdx, Pending[RegIdx]);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function ends a rate window. It is called by the scheduler
+ * every XPLMI_ERR_RATE_WINDOW_MS, clears the handler counts and enables
+ * the interrupts of the errors which went over the rate limit again. Errors
+ * which occurred meanwhile are still latched in the status registers and
+ * interrupt once.
+ * @param None
+ * @return XST_SUCCESS
+ *****************************************************************************/
+static int XPlmi_ErrRateWindow(void)
+{
+	u32 RegIdx;
+	u32 Index;
+	u32 Throttled;
+
+	if (FALSE == ErrIntr.WindowUsed) {
+		goto END;
+	}
+
+	microblaze_disable_interrupts();
+	ErrIntr.WindowUsed = FALSE;
+	for (Index = 0U; Index < (u32)XPM_NODEIDX_ERROR_PSMERR2_MAX; Index++) {
+		ErrorTable[Index].WindowCount = 0U;
+	}
+	microblaze_enable_interrupts();
+
+	for (RegIdx = 0U; RegIdx < ErrIntr.NumRegs; RegIdx++) {
+		microblaze_disable_interrupts();
+		Throttled = ErrIntr.Throttled[RegIdx];
+		ErrIntr.Throttled[RegIdx] = 0U;
+		if (Throttled != 0U) {
+			XPlmi_Out32(ErrIrqEnRegs[RegIdx], Throttled);
+		}
+		microblaze_enable_interrupts();
+
+		while (Throttled != 0U) {
+			Index = (RegIdx * XPLMI_ERR_BITS_PER_REG) +
+				(u32)__builtin_ctz(Throttled);
+			Throttled &= (Throttled - 1U);
+			XPlmi_Printf(DEBUG_GENERAL, "Error 0x%x rate limited, "
+				"%u occurrences\n\r", Index,
+				ErrorTable[Index].Count);
+		}
+	}
+
+END:
+	return XST_SUCCESS;
+}
+
 /*****************************************************************************/
 /**
  * This function dumps the registers which can help debugging
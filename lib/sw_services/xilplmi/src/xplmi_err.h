@@ -34,6 +34,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   05/23/2019 Initial release
+* 1.01  adk  10/15/2019 Added batched error interrupt handling with rate
+*                       limiting
 *
 * </pre>
 *
@@ -73,6 +75,21 @@ extern "C" {
 #define XPLMI_INVALID_ERROR_ACTION	(4U)
 #define XPLMI_INVALID_NODEID		(5U)
 
+/* Error registers scanned on an error interrupt */
+#define XPLMI_ERR_REG_PMC_ERR1		(0U)
+#define XPLMI_ERR_REG_PMC_ERR2		(1U)
+#define XPLMI_ERR_REG_PSM_ERR1		(2U)
+#define XPLMI_ERR_REG_PSM_ERR2		(3U)
+#define XPLMI_ERR_NUM_REGS		(4U)
+#define XPLMI_ERR_BITS_PER_REG		(32U)
+
+/*
+ * Handler calls allowed per error in a rate window. An error going over
+ * the limit has its interrupt disabled until the window ends.
+ */
+#define XPLMI_ERR_RATE_LIMIT		(16U)
+#define XPLMI_ERR_RATE_WINDOW_MS	(100U)
+
 /**************************** Type Definitions *******************************/
 /* Pointer to Error Handler Function */
 typedef void (*XPlmi_ErrorHandler_t) (u8 ErrorId);
@@ -81,6 +98,8 @@ typedef void (*XPlmi_ErrorHandler_t) (u8 ErrorId);
 struct XPlmi_Error_t {
 	XPlmi_ErrorHandler_t Handler;
 	u8 Action;
+	u8 WindowCount;	/* Handler calls in the current rate window */
+	u32 Count;	/* Occurrences seen by the error interrupt */
 };
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -89,6 +108,7 @@ void XPlmi_EmInit(void);
 int XPlmi_PsEmInit(void);
 int XPlmi_EmSetAction(u32 ErrorId, u8 ActionId,
 		XPlmi_ErrorHandler_t ErrorHandler);
+void XPlmi_ErrIntrHandler(void *CallbackRef);
 
 /* Functions defined in xplmi_err_cmd.c */
 void XPlmi_ErrModuleInit(void);
@@ -34,6 +34,7 @@
 * Ver   Who  Date        Changes
 * ====  ==== ======== ======================================================-
 * 1.00  kc   02/12/2019 Initial release
+* 1.01  adk  10/15/2019 Added sysmon alarm action commands
 *
 * </pre>
 *
@@ -47,6 +48,7 @@
 #include "xplmi.h"
 #include "xplmi_debug.h"
 #include "xpm_node.h"
+#include "xplmi_sysmon.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -108,6 +110,47 @@ static int XPlmi_CmdEmSetAction(XPlmi_Cmd * Cmd)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function arms the actions of a PMC sysmon alarm, they run
+ * from the error interrupt when the alarm is raised.
+ * command payload paramters are
+ *		* Error ID, PMCSMON0 to PMCSMON9
+ *		* Actions mask
+ *			BIT(0) - Clock throttle
+ *			BIT(1) - PL shutdown
+ *			BIT(2) - Notify subsystems
+ *		* Clock ID of the throttled clock
+ *		* Divider of the throttled clock
+ *		* IPI mask of the notified subsystems
+ * @param Pointer to the command structure
+ *
+ * @return Returns XST_SUCCESS on successful execution
+ *****************************************************************************/
+static int XPlmi_CmdSysMonSetAction(XPlmi_Cmd * Cmd)
+{
+	return XPlmi_SysMonSetAction(Cmd->Payload[0], Cmd->Payload[1],
+			Cmd->Payload[2], Cmd->Payload[3], Cmd->Payload[4]);
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function returns the handling statistics of a PMC sysmon
+ * alarm.
+ * command payload paramters are
+ *		* Error ID, PMCSMON0 to PMCSMON9
+ * Response[1] is the number of alarms handled, Response[2] and
+ * Response[3] are the last and maximum latencies of the actions in us.
+ * @param Pointer to the command structure
+ *
+ * @return Returns XST_SUCCESS on successful execution
+ *****************************************************************************/
+static int XPlmi_CmdSysMonGetStats(XPlmi_Cmd * Cmd)
+{
+	return XPlmi_SysMonGetStats(Cmd->Payload[0], &Cmd->Response[1],
+			&Cmd->Response[2], &Cmd->Response[3]);
+}
+
 /*****************************************************************************/
 /**
  * @brief contains the array of PLM error commands
@@ -117,6 +160,8 @@ static XPlmi_ModuleCmd XPlmi_ErrCmds[] =
 {
 	XPLMI_MODULE_COMMAND(XPlmi_CmdEmReserved),
 	XPLMI_MODULE_COMMAND(XPlmi_CmdEmSetAction),
+	XPLMI_MODULE_COMMAND(XPlmi_CmdSysMonSetAction),
+	XPLMI_MODULE_COMMAND(XPlmi_CmdSysMonGetStats),
 };
 
 /*****************************************************************************/
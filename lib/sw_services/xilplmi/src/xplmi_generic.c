@@ -35,6 +35,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   08/23/2018 Initial release
+* 1.01  adk  10/15/2019 DMA XFER to a slave SLR runs in the background with
+*                       PLM_SSIT_CONCURRENT
 *
 * </pre>
 *
@@ -50,7 +52,12 @@
 #include "xcfupmc.h"
 #include "sleep.h"
 #include "xplmi_ssit.h"
+#include "xplmi_timeline.h"
+#include "xplmi_pmon.h"
 /************************** Constant Definitions *****************************/
+#define XPLMI_WORD_LEN			(4U)
+/** Shorter burst writes are faster with processor writes than with DMA */
+#define XPLMI_BURST_WRITE_DMA_MIN_LEN	(16U)
 
 /**************************** Type Definitions *******************************/
 
@@ -444,6 +451,16 @@ static int XPlmi_DmaXfer(XPlmi_Cmd * Cmd)
 	{
 		Status = XPlmi_NpiRead(SrcAddr,DestAddr,Len);
 	}
+#ifdef PLM_SSIT_CONCURRENT
+	else if ((XPlmi_SsitGetSlave(DestAddr) != XPLMI_SSIT_NO_SLAVE) &&
+		 ((SrcAddr < XPLMI_PMCRAM_BASEADDR) ||
+		  (SrcAddr >= (XPLMI_PMCRAM_BASEADDR + XPLMI_PMCRAM_LEN))))
+	{
+		/** Stream to the slave SLR while the next commands run */
+		Status = XPlmi_SsitStreamXfer(XPlmi_SsitGetSlave(DestAddr),
+				SrcAddr, DestAddr, Len, Flags);
+	}
+#endif
 	else
 	{
 		Status = XPlmi_DmaXfr(SrcAddr, DestAddr, Len, Flags);
@@ -720,6 +737,134 @@ END:
 }
 
 
+/*****************************************************************************/
+/**
+ * @brief This function provides burst write command execution. It writes
+ * the data words of the payload to consecutive 32 bit registers.
+ *  Command payload parameters are
+ *	* Address
+ *	* Value 0 ... Value N-1
+ *
+ *  CDO encoding, N data words at Address, Address + 4, ...
+ *	* Header: ((N + 1) << 16) | (XPLMI_MODULE_GENERIC_ID << 8) | 18
+ *	  When N + 1 is 255 or more, the length field is 255 and the word
+ *	  after the header holds N + 1
+ *	* Address
+ *	* Value 0 ... Value N-1
+ *
+ * Blocks of XPLMI_BURST_WRITE_DMA_MIN_LEN words or more are written with
+ * PMC DMA0, shorter ones with processor writes. The command can span CDO
+ * chunks, it is resumed at the next register.
+ *
+ * @param Pointer to the command structure
+ *
+ * @return Returns the Status of DMA Xfer API
+ *****************************************************************************/
+static int XPlmi_BurstWrite(XPlmi_Cmd * Cmd)
+{
+	int Status = XST_SUCCESS;
+	u32 DestAddr;
+	u32 *Data;
+	u32 Len = Cmd->PayloadLen;
+	u32 Index;
+
+	/** Nothing of the payload is in this chunk yet */
+	if (Len == 0U) {
+		goto END;
+	}
+
+	if (Cmd->ProcessedLen == 0U)
+	{
+		/** store the destination address in resume data */
+		Cmd->ResumeData[0U] = Cmd->Payload[0U];
+		Data = &Cmd->Payload[1U];
+		DestAddr = Cmd->ResumeData[0U];
+		Len -= 1U;
+	} else {
+		Data = &Cmd->Payload[0U];
+		/** decrement the destination offset by the address word */
+		DestAddr = Cmd->ResumeData[0U] +
+			((Cmd->ProcessedLen - 1U) * XPLMI_WORD_LEN);
+	}
+
+	XPlmi_Printf(DEBUG_DETAILED, "%s, Addr: 0x%0x, Len: 0x%0x\n\r",
+		__func__, DestAddr, Len);
+
+	if (Len >= XPLMI_BURST_WRITE_DMA_MIN_LEN) {
+		Status = XPlmi_DmaXfr((u64)(UINTPTR)Data, (u64)DestAddr, Len,
+				XPLMI_PMCDMA_0);
+		if (Status != XST_SUCCESS) {
+			XPlmi_Printf(DEBUG_GENERAL, "BURST WRITE Failed\n\r");
+		}
+	} else {
+		for (Index = 0U; Index < Len; Index++) {
+			Xil_Out32(DestAddr, Data[Index]);
+			DestAddr += XPLMI_WORD_LEN;
+		}
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function provides write list command execution. It writes
+ * a list of address and value pairs, in the order of the list.
+ *  Command payload parameters are
+ *	* Address 0
+ *	* Value 0
+ *	* ...
+ *	* Address N-1
+ *	* Value N-1
+ *
+ *  CDO encoding, N pairs
+ *	* Header: ((2 * N) << 16) | (XPLMI_MODULE_GENERIC_ID << 8) | 19
+ *	  When 2 * N is 255 or more, the length field is 255 and the word
+ *	  after the header holds 2 * N
+ *	* Address 0, Value 0, ..., Address N-1, Value N-1
+ *
+ * The command can span CDO chunks. When a chunk ends between the address
+ * and the value of a pair, the address is kept in the resume data.
+ *
+ * @param Pointer to the command structure
+ *
+ * @return Returns XST_SUCCESS, or XST_INVALID_PARAM for an odd payload length
+ *****************************************************************************/
+static int XPlmi_WriteList(XPlmi_Cmd * Cmd)
+{
+	int Status = XST_INVALID_PARAM;
+	u32 *Pair = Cmd->Payload;
+	u32 Len = Cmd->PayloadLen;
+
+	XPlmi_Printf(DEBUG_DETAILED, "%s, Len: 0x%0x\n\r", __func__, Len);
+
+	if ((Cmd->Len & 1U) != 0U) {
+		goto END;
+	}
+
+	/** Complete the pair split by the end of the previous chunk */
+	if ((Cmd->ProcessedLen & 1U) != 0U) {
+		Xil_Out32(Cmd->ResumeData[0U], Pair[0U]);
+		Pair++;
+		Len--;
+	}
+
+	while (Len >= 2U) {
+		Xil_Out32(Pair[0U], Pair[1U]);
+		Pair += 2U;
+		Len -= 2U;
+	}
+
+	if (Len != 0U) {
+		Cmd->ResumeData[0U] = Pair[0U];
+	}
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * @brief contains the array of PLM generic commands
@@ -744,6 +889,10 @@ static XPlmi_ModuleCmd XPlmi_GenericCmds[] =
 	XPLMI_MODULE_COMMAND(XPlmi_SsitSyncMaster),
 	XPLMI_MODULE_COMMAND(XPlmi_SsitSyncSlaves),
 	XPLMI_MODULE_COMMAND(XPlmi_SsitWaitSlaves),
+	XPLMI_MODULE_COMMAND(XPlmi_GetTimeline),
+	XPLMI_MODULE_COMMAND(XPlmi_BurstWrite),
+	XPLMI_MODULE_COMMAND(XPlmi_WriteList),
+	XPLMI_MODULE_COMMAND(XPlmi_PmonProfile),
 };
 
 /*****************************************************************************/
@@ -36,6 +36,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/21/2017 Initial release
+* 1.01  adk  10/15/2019 Added PSM error status and interrupt mask registers
 *
 * </pre>
 *
@@ -255,6 +256,10 @@ extern "C" {
 #define PSM_GLOBAL_REG_PSM_SRST2_EN    ( ( PSM_GLOBAL_REG_BASEADDR ) + 0X00001094 )
 #define PSM_GLOBAL_REG_PSM_IRQ1_EN    ( ( PSM_GLOBAL_REG_BASEADDR ) + 0X00001064 )
 #define PSM_GLOBAL_REG_PSM_IRQ2_EN    ( ( PSM_GLOBAL_REG_BASEADDR ) + 0X00001074 )
+#define PSM_GLOBAL_REG_PSM_ERR1_STATUS    ( ( PSM_GLOBAL_REG_BASEADDR ) + 0X00001000 )
+#define PSM_GLOBAL_REG_PSM_ERR2_STATUS    ( ( PSM_GLOBAL_REG_BASEADDR ) + 0X00001004 )
+#define PSM_GLOBAL_REG_PSM_IRQ1_MASK    ( ( PSM_GLOBAL_REG_BASEADDR ) + 0X00001060 )
+#define PSM_GLOBAL_REG_PSM_IRQ2_MASK    ( ( PSM_GLOBAL_REG_BASEADDR ) + 0X00001070 )
 
 /**
  * Definitions required for PMC_TAP
@@ -37,6 +37,7 @@
  * Ver   Who  Date        Changes
  * ----- ---- -------- -------------------------------------------------------
  * 1.00  mg   10/09/2018 Initial release
+ *       adk  10/15/2019 XPlmi_IpiShmValidate checks any shared memory buffer
  *
  * </pre>
  *
@@ -48,6 +49,7 @@
 #include "xplmi_proc.h"
 #ifdef XPAR_XIPIPSU_0_DEVICE_ID
 /************************** Constant Definitions *****************************/
+#define XPLMI_IPI_WORD_LEN		(4U)
 
 /**************************** Type Definitions *******************************/
 
@@ -127,8 +129,10 @@ int XPlmi_IpiDispatchHandler(void *Data)
 	int Status = XST_FAILURE;
 	u32 SrcCpuMask;
 	u32 Payload[XPLMI_IPI_MAX_MSG_LEN] = {0U};
+	u32 Response[XPLMI_IPI_SHM_COOKIE_INDEX + 1U];
+	u32 RespLen;
 	u32 MaskIndex;
-	XPlmi_Cmd Cmd;
+	XPlmi_Cmd Cmd = {0U};
 
 	/* For MISRA C */
 	(void )Data;
@@ -144,16 +148,36 @@ int XPlmi_IpiDispatchHandler(void *Data)
 			Cmd.CmdId = Payload[0U];
 			Cmd.IpiMask = IpiMaskList[MaskIndex];
 			Cmd.Len = (Cmd.CmdId >> 16) & 255;
-			if (Cmd.Len > 6U) {
-				Cmd.Len = Payload[1U];
-				Cmd.Payload = (u32 *)Payload[2U];
+			Cmd.ProcessedLen = 0U;
+			Cmd.ResumeHandler = NULL;
+			(void)memset(Cmd.Response, 0, sizeof(Cmd.Response));
+			RespLen = XPLMI_CMD_RESP_SIZE;
+			if (Cmd.Len > XPLMI_IPI_INLINE_MAX_LEN) {
+				/** Payload is in shared memory */
+				Status = XPlmi_IpiShmValidate(
+					((u64)Payload[XPLMI_IPI_SHM_ADDR_HIGH_INDEX] << 32U) |
+					(u64)Payload[XPLMI_IPI_SHM_ADDR_LOW_INDEX],
+					Payload[XPLMI_IPI_SHM_LEN_INDEX]);
+				Cmd.Len = Payload[XPLMI_IPI_SHM_LEN_INDEX];
+				Cmd.Payload = (u32 *)Payload[XPLMI_IPI_SHM_ADDR_LOW_INDEX];
+				Response[XPLMI_IPI_SHM_COOKIE_INDEX] =
+					Payload[XPLMI_IPI_SHM_COOKIE_INDEX];
+				RespLen = XPLMI_IPI_SHM_COOKIE_INDEX + 1U;
 			} else {
+				Status = XST_SUCCESS;
 				Cmd.Payload = &Payload[1U];
 			}
-			Status = XPlmi_CmdExecute(&Cmd);
+			Cmd.PayloadLen = Cmd.Len;
+			if (Status == XST_SUCCESS) {
+				Status = XPlmi_CmdExecute(&Cmd);
+			}
+			if (Cmd.Response[0U] == 0U) {
+				Cmd.Response[0U] = (u32)Status;
+			}
 
 			/* Send response to caller */
-			XPlmi_IpiWrite(Cmd.IpiMask, Cmd.Response, XPLMI_CMD_RESP_SIZE, XIPIPSU_BUF_TYPE_RESP);
+			(void)memcpy(Response, Cmd.Response, sizeof(Cmd.Response));
+			XPlmi_IpiWrite(Cmd.IpiMask, Response, RespLen, XIPIPSU_BUF_TYPE_RESP);
 		}
 	}
 
@@ -169,6 +193,47 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function checks a shared memory buffer given by an IPI caller,
+ * the payload of a shared memory IPI message or the destination of a command
+ * response. The buffer must be word aligned and fully in the low DDR or in
+ * the OCM, both are reachable by the PMC processor without a DMA.
+ *
+ * @param	Addr Address of the buffer
+ * 			Len	Length of the buffer in words
+ *
+ * @return	XST_SUCCESS if the buffer can be used, else
+ *		XPLMI_ERR_IPI_SHM_BUF
+ *
+ *****************************************************************************/
+int XPlmi_IpiShmValidate(u64 Addr, u32 Len)
+{
+	int Status = XPLMI_UPDATE_STATUS(XPLMI_ERR_IPI_SHM_BUF, 0x0);
+	u32 StartAddr = (u32)Addr;
+	u32 EndAddr;
+
+	if ((Len == 0U) || (Len > XPLMI_IPI_SHM_MAX_LEN) ||
+		((Addr >> 32U) != 0U) ||
+		((StartAddr & (XPLMI_IPI_WORD_LEN - 1U)) != 0U)) {
+		goto END;
+	}
+
+	/** Address of the last byte, cannot wrap with the length check */
+	EndAddr = StartAddr + (Len * XPLMI_IPI_WORD_LEN) - 1U;
+	if (EndAddr < StartAddr) {
+		goto END;
+	}
+
+	if ((EndAddr <= XPLMI_IPI_SHM_DDR_HIGH_ADDR) ||
+		(StartAddr >= XPLMI_IPI_SHM_OCM_LOW_ADDR)) {
+		Status = XST_SUCCESS;
+	}
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * @brief This function writes the IPI message or response to destination CPU
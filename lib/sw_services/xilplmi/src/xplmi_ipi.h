@@ -37,6 +37,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  mg   10/09/2018 Initial release
+*       adk  10/15/2019 Added XPlmi_IpiShmValidate
 *
 * </pre>
 *
@@ -67,6 +68,32 @@ extern "C" {
 #define IPI_BASEADDR				0xFF300000
 
 #define IPI_PMC_ISR					( IPI_BASEADDR + 0x20010)
+
+/**
+ * Payload words that fit in the message after the command header. A command
+ * with a longer payload keeps it in DDR or OCM and the message carries a
+ * shared memory descriptor instead:
+ *	* Word 0: Command header, with a length field greater than 6
+ *	* Word 1: Payload length in words
+ *	* Word 2: Low address of the payload
+ *	* Word 3: High address of the payload, must be 0
+ *	* Word 4: Cookie, returned in the response word 4
+ *
+ * The payload is processed in place, it is not copied. The caller flushes it
+ * from its caches before the IPI and must not change it before the response.
+ */
+#define XPLMI_IPI_INLINE_MAX_LEN	(6U)
+#define XPLMI_IPI_SHM_LEN_INDEX		(1U)
+#define XPLMI_IPI_SHM_ADDR_LOW_INDEX	(2U)
+#define XPLMI_IPI_SHM_ADDR_HIGH_INDEX	(3U)
+#define XPLMI_IPI_SHM_COOKIE_INDEX	(4U)
+#define XPLMI_IPI_SHM_MAX_LEN		(0x100000U)
+
+/* Shared memory regions the payload can be in */
+#define XPLMI_IPI_SHM_DDR_LOW_ADDR	(0x0U)
+#define XPLMI_IPI_SHM_DDR_HIGH_ADDR	(0x7FFFFFFFU)
+#define XPLMI_IPI_SHM_OCM_LOW_ADDR	(0xFFFC0000U)
+#define XPLMI_IPI_SHM_OCM_HIGH_ADDR	(0xFFFFFFFFU)
 /* Error codes */
 
 /**************************** Type Definitions *******************************/
@@ -80,6 +107,7 @@ int XPlmi_IpiWrite(u32 DestCpuMask, u32 *MsgPtr, u32 MsgLen, u32 Type);
 int XPlmi_IpiRead(u32 SrcCpuMask, u32 *MsgPtr, u32 MsgLen, u32 Type);
 int XPlmi_IpiTrigger(u32 DestCpuMask);
 int XPlmi_IpiPollForAck(u32 DestCpuMask, u32 TimeOutCount);
+int XPlmi_IpiShmValidate(u64 Addr, u32 Len);
 /************************** Variable Definitions *****************************/
 
 /*****************************************************************************/
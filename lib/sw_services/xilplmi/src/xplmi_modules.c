@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   08/23/2018 Initial release
+*       kc   10/14/2019 Command handlers are validated at registration
 *
 * </pre>
 *
@@ -72,7 +73,36 @@ XPlmi_Module * Modules[XPLMI_MAX_MODULES];
 void XPlmi_ModuleRegister(XPlmi_Module * Module)
 {
 	u32 ModuleId = Module->Id;
+	u32 ApiId;
+
 	Xil_AssertVoid(ModuleId < XPLMI_MAX_MODULES);
 	Xil_AssertVoid(Modules[ModuleId] == NULL);
+	Xil_AssertVoid(Module->CmdCnt <= (XPLMI_CMD_API_ID_MASK + 1U));
+
+	/**
+	 * Commands without handler get one that reports the error, so that
+	 * XPlmi_CmdExecute can call the handler without checking it
+	 */
+	for (ApiId = 0U; ApiId < Module->CmdCnt; ApiId++) {
+		if (Module->CmdAry[ApiId].Handler == NULL) {
+			Module->CmdAry[ApiId].Handler = XPlmi_CmdHandlerNull;
+		}
+	}
 	Modules[ModuleId] = Module;
 }
+
+/*****************************************************************************/
+/**
+ * @brief Handler of the commands a module did not register.
+ *
+ * @param Cmd is pointer to the command structure
+ *
+ * @return XPLMI_ERR_CMD_HANDLER_NULL
+ *
+ *****************************************************************************/
+int XPlmi_CmdHandlerNull(XPlmi_Cmd *Cmd)
+{
+	(void)Cmd;
+
+	return XPLMI_UPDATE_STATUS(XPLMI_ERR_CMD_HANDLER_NULL, 0x0);
+}
@@ -82,6 +82,7 @@ typedef struct {
 
 /************************** Function Prototypes ******************************/
 void XPlmi_ModuleRegister(XPlmi_Module * Module);
+int XPlmi_CmdHandlerNull(XPlmi_Cmd *Cmd);
 
 /************************** Variable Definitions *****************************/
 extern XPlmi_Module * Modules[XPLMI_MAX_MODULES];
@@ -0,0 +1,165 @@
+/******************************************************************************
+* Copyright (C) 2019 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xplmi_pmon.c
+*
+* This file contains the LPD traffic profiling command.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  kc   10/15/2019 Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xplmi_pmon.h"
+#include "xplmi_dma.h"
+#include "xplmi_util.h"
+#include "xplmi_debug.h"
+#include "xstatus.h"
+#if defined(PLM_PMON_PROFILE) && defined(XPAR_XPMONPSV_NUM_INSTANCES)
+#include "xpmonpsv_profile.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+#define XPLMI_PMON_PAYLOAD_LEN		(5U)
+#define XPLMI_PMON_WORD_LEN		(4U)
+#define XPLMI_PMON_DEVICE_ID		XPAR_PSU_CORESIGHT_LPD_ATM_DEVICE_ID
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+/************************** Variable Definitions *****************************/
+#if defined(PLM_PMON_PROFILE) && defined(XPAR_XPMONPSV_NUM_INSTANCES)
+static XpsvPmon PmonInstance;
+static XPmonpsv_Profile Profile;
+static XPmonpsv_ProfReport Reports[XPMONPSV_PROF_MAX_PORTS];
+#endif
+
+/*****************************************************************************/
+/**
+ * @brief This function profiles the LPD ports and copies the reports to a
+ * given address.
+ *  Command payload parameters are
+ *	* Flags, 0 or XPMONPSV_PROF_BUSY
+ *	* Window in microseconds
+ *	* High Dest Addr
+ *	* Low Dest Addr
+ *	* Max Len in bytes
+ *
+ * The response has the status, the number of bytes copied and the number
+ * of ports profiled. The monitor is set up on the first command; later
+ * commands reuse the counters, so the flags of the first command apply.
+ *
+ * @param Pointer to the command structure
+ *
+ * @return Returns the Status, XST_NO_FEATURE when the PLM is built without
+ * PLM_PMON_PROFILE or the design has no LPD performance monitor
+ *****************************************************************************/
+int XPlmi_PmonProfile(XPlmi_Cmd * Cmd)
+{
+	int Status = XST_FAILURE;
+#if defined(PLM_PMON_PROFILE) && defined(XPAR_XPMONPSV_NUM_INSTANCES)
+	XPmonpsv_Config *ConfigPtr;
+	u64 DestAddr;
+	u32 WindowUs;
+	u32 Len;
+
+	if (Cmd->PayloadLen < XPLMI_PMON_PAYLOAD_LEN) {
+		Status = XST_INVALID_PARAM;
+		goto END;
+	}
+
+	WindowUs = Cmd->Payload[1U];
+	if ((WindowUs == 0U) || (WindowUs > XPLMI_PMON_MAX_WINDOW_US)) {
+		Status = XST_INVALID_PARAM;
+		goto END;
+	}
+
+	if (PmonInstance.IsReady != XIL_COMPONENT_IS_READY) {
+		ConfigPtr = XpsvPmon_LookupConfig(XPLMI_PMON_DEVICE_ID);
+		if (ConfigPtr == NULL) {
+			goto END;
+		}
+		Status = XpsvPmon_CfgInitialize(&PmonInstance, ConfigPtr,
+				ConfigPtr->BaseAddress);
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+		(void)XpsvPmon_ProfileInit(&Profile, &PmonInstance);
+		Status = XpsvPmon_ProfileAddAll(&Profile, Cmd->Payload[0U]);
+		if (Status != XST_SUCCESS) {
+			PmonInstance.IsReady = 0U;
+			goto END;
+		}
+	}
+
+	XPlmi_Printf(DEBUG_DETAILED, "%s, Window: %d us\n\r", __func__,
+			WindowUs);
+
+	Status = XpsvPmon_ProfileRun(&Profile, WindowUs, Reports);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	DestAddr = ((u64)Cmd->Payload[2U] << 32U) | (u64)Cmd->Payload[3U];
+	Len = Profile.NumPorts * sizeof(XPmonpsv_ProfReport);
+	if (Cmd->Payload[4U] < Len) {
+		Len = Cmd->Payload[4U];
+	}
+	Len &= ~(XPLMI_PMON_WORD_LEN - 1U);
+
+	if (Len != 0U) {
+		Status = XPlmi_DmaXfr((u64)(UINTPTR)Reports, DestAddr,
+				Len / XPLMI_PMON_WORD_LEN, XPLMI_PMCDMA_0);
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+	}
+	Cmd->Response[1U] = Len;
+	Cmd->Response[2U] = Profile.NumPorts;
+	Status = XST_SUCCESS;
+
+END:
+#else
+	Status = XST_NO_FEATURE;
+#endif
+	Cmd->Response[0U] = (u32)Status;
+	return Status;
+}
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   02/07/2019 Initial release
+* 1.01  adk  10/15/2019 Connected the error interrupt to the error manager
 *
 * </pre>
 *
@@ -46,6 +47,7 @@
 #include "xplmi_proc.h"
 #include "xplmi_hw.h"
 #include "xplmi_scheduler.h"
+#include "xplmi_err.h"
 
 /************************** Constant Definitions *****************************/
 #define XPLMI_MB_MSR_BIP_MASK		(0x8U)
@@ -228,6 +230,20 @@ void XPlmi_PrintPlmTimeStamp()
 	XPlmi_Printf(DEBUG_PRINT_PERF, "] ");
 }
 
+/*****************************************************************************/
+/**
+ * This function returns the PMC IRO frequency, which is the frequency of
+ * the PLM timer.
+ *
+ * @param none
+ *
+ * @return PMC IRO frequency in Hz
+ *****************************************************************************/
+u32 XPlmi_GetPmcIroFreq(void)
+{
+	return (u32)PmcIroFreq;
+}
+
 /*****************************************************************************/
 /**
 * @brief It sets the PMC IRO frequency
@@ -326,7 +342,7 @@ static struct HandlerTable g_TopLevelInterruptTable[] = {
 	{XPlmi_IntrHandler},
 	{XPlmi_GicIntrHandler},
 	{XPlmi_IntrHandler},
-	{XPlmi_IntrHandler},
+	{XPlmi_ErrIntrHandler},
 	{XPlmi_IntrHandler},
 	{XPlmi_IntrHandler},
 	{XPlmi_IntrHandler},
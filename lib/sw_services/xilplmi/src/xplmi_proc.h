@@ -64,6 +64,8 @@ extern "C" {
 #define XPLMI_PIT2			(1U)
 #define XPLMI_PIT3			(2U)
 #define XPLMI_IOMODULE_PMC_PIT3_IRQ			(0x5)
+#define XPLMI_PIT2_COUNTER_ADDR		(XPAR_IOMODULE_0_BASEADDR + \
+		((u32)XPLMI_PIT2 << XTC_TIMER_COUNTER_SHIFT) + XTC_TCR_OFFSET)
 
 
 /**************************** Type Definitions *******************************/
@@ -114,6 +116,7 @@ void XPlmi_PlmIntrDisable(u32 IntrId);
 void XPlmi_RegisterHandler(u32 IntrId, Function_t Handler, void * Data);
 void XPlmi_PrintRomTime();
 void XPlmi_PrintPlmTimeStamp();
+u32 XPlmi_GetPmcIroFreq(void);
 
 /* Handler Table Structure */
 struct HandlerTable {
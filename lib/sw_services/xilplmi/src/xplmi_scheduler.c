@@ -66,6 +66,45 @@ static int XPlmi_IsTask_NonPeriodic(XPlmi_Scheduler_t *SchedPtr, int TaskListInd
 	return ReturnVal;
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function links a task in the wheel slot of its due tick
+ *
+ * @param	Idx Index of the task in the task list
+ *
+ * @return	None
+ *****************************************************************************/
+static void XPlmi_SchedulerWheelAdd(int Idx)
+{
+	u32 Slot = Sched.TaskList[Idx].DueTick & XPLMI_SCHED_WHEEL_MASK;
+
+	Sched.TaskList[Idx].Next = Sched.Wheel[Slot];
+	Sched.Wheel[Slot] = Idx;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function unlinks a task from the wheel slot of its due tick
+ *
+ * @param	Idx Index of the task in the task list
+ *
+ * @return	None
+ *****************************************************************************/
+static void XPlmi_SchedulerWheelRemove(int Idx)
+{
+	u32 Slot = Sched.TaskList[Idx].DueTick & XPLMI_SCHED_WHEEL_MASK;
+	int *Link = &Sched.Wheel[Slot];
+
+	while (*Link != XPLMI_SCHED_NO_TASK) {
+		if (*Link == Idx) {
+			*Link = Sched.TaskList[Idx].Next;
+			break;
+		}
+		Link = &Sched.TaskList[*Link].Next;
+	}
+	Sched.TaskList[Idx].Next = XPLMI_SCHED_NO_TASK;
+}
+
 int XPlmi_SchedulerInit(void)
 {
 	int Idx;
@@ -77,6 +116,11 @@ int XPlmi_SchedulerInit(void)
 		Sched.TaskList[Idx].Interval = 0U;
 		Sched.TaskList[Idx].CustomerFunc = NULL;
 		Sched.TaskList[Idx].Status = XPLMI_TASK_STATUS_DISABLED;
+		Sched.TaskList[Idx].Task = NULL;
+		Sched.TaskList[Idx].Next = XPLMI_SCHED_NO_TASK;
+	}
+	for (Idx = 0U; Idx < XPLMI_SCHED_WHEEL_SLOTS; Idx++) {
+		Sched.Wheel[Idx] = XPLMI_SCHED_NO_TASK;
 	}
 
 	Sched.Enabled = FALSE;
@@ -111,36 +155,62 @@ int XPlmi_SchedulerStop(XPlmi_Scheduler_t *SchedPtr)
 	return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function is called on every scheduler tick. Only the tasks in
+ * the wheel slot of the tick are checked, the ones that are due are triggered
+ * and moved to the slot of their next due tick. A task that is due while its
+ * previous run is still queued is counted as an overrun in its statistics.
+ *
+ * @param	None
+ *
+ * @return	XST_SUCCESS
+ *****************************************************************************/
 int XPlmi_SchedulerHandler(void)
 {
 	int Idx;
-	int Status = XST_FAILURE;
-	XPlmi_TaskNode *Task;
-    /* XPlmi_Printf(DEBUG_GENERAL,"Received :XPlmi_SchedulerHandler\n\r"); */
+	int Next;
+	int Prev = XPLMI_SCHED_NO_TASK;
+	u32 Slot;
+	struct XPlmi_Task_t *SchedTask;
+
 	XPlmi_UtilRMW(PMC_PMC_MB_IO_IRQ_ACK, PMC_PMC_MB_IO_IRQ_ACK, 0x20);
-	for (Idx = 0U; Idx < XPLMI_SCHED_MAX_TASK; Idx++)
-	{
-		/* Check if the task is triggered and has a valid Callback */
-		if (NULL != Sched.TaskList[Idx].CustomerFunc)
-		{
-			/* Execute the Task */
-			Task = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1, Sched.TaskList[Idx].CustomerFunc, 0U);
-			if (Task == NULL)
-			{
-				Status = XPLMI_UPDATE_STATUS(XPLM_ERR_TASK_CREATE, 0x0);
-				goto END;
-			}
-			XPlmi_TaskTriggerNow(Task);
-			}
+	Sched.Tick++;
+	Slot = Sched.Tick & XPLMI_SCHED_WHEEL_MASK;
+
+	for (Idx = Sched.Wheel[Slot]; Idx != XPLMI_SCHED_NO_TASK; Idx = Next) {
+		SchedTask = &Sched.TaskList[Idx];
+		Next = SchedTask->Next;
+		if (SchedTask->DueTick != Sched.Tick) {
+			/* Due in a later turn of the wheel */
+			Prev = Idx;
+			continue;
+		}
+
+		XPlmi_TaskTriggerNow(SchedTask->Task);
+		SchedTask->DueTick += SchedTask->IntervalTicks;
+		if ((SchedTask->DueTick & XPLMI_SCHED_WHEEL_MASK) == Slot) {
+			Prev = Idx;
+			continue;
+		}
+
+		/* Move the task to the slot of its next due tick */
+		if (Prev == XPLMI_SCHED_NO_TASK) {
+			Sched.Wheel[Slot] = Next;
+		} else {
+			Sched.TaskList[Prev].Next = Next;
+		}
+		XPlmi_SchedulerWheelAdd(Idx);
 	}
-END:
-	return Status;
+
+	return XST_SUCCESS;
 }
 
 int XPlmi_SchedulerAddTask(XPlmi_Callback_t CallbackFn, int MilliSeconds)
 {
 	int Idx;
 	int Status = XST_FAILURE;
+	XPlmi_TaskNode *Task;
 
 	/* Get the Next Free Task Index */
 	for (Idx=0U;Idx < XPLMI_SCHED_MAX_TASK;Idx++) {
@@ -154,16 +224,33 @@ int XPlmi_SchedulerAddTask(XPlmi_Callback_t CallbackFn, int MilliSeconds)
 		goto done;
 	}
 
+	/* The task is kept in the task queue lists between the triggers */
+	Task = XPlmi_TaskCreate(XPLM_TASK_PRIORITY_1,
+			(int (*)(void *))CallbackFn, NULL);
+	if (Task == NULL) {
+		Status = XPLMI_UPDATE_STATUS(XPLM_ERR_TASK_CREATE, 0x0);
+		goto done;
+	}
+	Task->Flags = XPLMI_TASK_FLAG_PERSISTENT;
+
 	/* Add Interval as a factor of TICK_MILLISECONDS */
 	Sched.TaskList[Idx].Interval = MilliSeconds;
 	Sched.TaskList[Idx].OwnerId = 0;
 	Sched.TaskList[Idx].CustomerFunc = CallbackFn;
+	Sched.TaskList[Idx].Task = Task;
+	Sched.TaskList[Idx].IntervalTicks = (u32)MilliSeconds /
+			XPLMI_SCHED_TICK_MS;
+	if (Sched.TaskList[Idx].IntervalTicks == 0U) {
+		Sched.TaskList[Idx].IntervalTicks = 1U;
+	}
+	Sched.TaskList[Idx].DueTick = Sched.Tick +
+			Sched.TaskList[Idx].IntervalTicks;
+	XPlmi_SchedulerWheelAdd(Idx);
 	Status = XST_SUCCESS;
 
 done:
 	return Status;
 }
-
 int XPlmi_SchedulerRemoveTask(XPlmi_Scheduler_t *SchedPtr, int OwnerId, int MilliSeconds, XPlmi_Callback_t CallbackFn)
 {
 	int Idx;
@@ -175,6 +262,9 @@ int XPlmi_SchedulerRemoveTask(XPlmi_Scheduler_t *SchedPtr, int OwnerId, int Mill
 		    (SchedPtr->TaskList[Idx].OwnerId == OwnerId) &&
 		    ((SchedPtr->TaskList[Idx].Interval == (MilliSeconds)) ||
 				(0U == MilliSeconds))) {
+			XPlmi_SchedulerWheelRemove(Idx);
+			XPlmi_TaskDelete(SchedPtr->TaskList[Idx].Task);
+			SchedPtr->TaskList[Idx].Task = NULL;
 			SchedPtr->TaskList[Idx].Interval = 0U;
 			SchedPtr->TaskList[Idx].OwnerId = 0U;
 			SchedPtr->TaskList[Idx].CustomerFunc = NULL;
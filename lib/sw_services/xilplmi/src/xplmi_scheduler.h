@@ -32,10 +32,17 @@
 extern "C" {
 #endif
 
+#include "xplmi_task.h"
 
 
 #define XPLMI_SCHED_MAX_TASK	10U
 
+/* Scheduler tick from PIT3 and number of timer wheel slots, a power of 2 */
+#define XPLMI_SCHED_TICK_MS		100U
+#define XPLMI_SCHED_WHEEL_SLOTS	8U
+#define XPLMI_SCHED_WHEEL_MASK	(XPLMI_SCHED_WHEEL_SLOTS - 1U)
+#define XPLMI_SCHED_NO_TASK		(-1)
+
 /* Values for TaskPtr->Status */
 #define XPLMI_TASK_STATUS_TRIGGERED	0x5AFEC0C0U
 #define XPLMI_TASK_STATUS_DISABLED	0x00000000U
@@ -52,14 +59,20 @@ struct XPlmi_Task_t{
 	int OwnerId;
 	int Status;
 	XPlmi_Callback_t CustomerFunc;
+	XPlmi_TaskNode *Task;	/**< Created once, triggered every interval */
+	u32 IntervalTicks;	/**< Interval in scheduler ticks */
+	u32 DueTick;		/**< Tick of the next trigger */
+	int Next;		/**< Next task in the same wheel slot */
 };
 
 typedef struct {
 	struct XPlmi_Task_t TaskList[XPLMI_SCHED_MAX_TASK];
 	int TaskCount;
 	int PitBaseAddr;
-	int Tick;
+	u32 Tick;
 	int Enabled;
+	/** Tasks due at Tick are in the slot (Tick & XPLMI_SCHED_WHEEL_MASK) */
+	int Wheel[XPLMI_SCHED_WHEEL_SLOTS];
 } XPlmi_Scheduler_t ;
 
 int XPlmi_SchedulerInit(void);
@@ -35,6 +35,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  ma   08/13/2019 Initial release
+* 1.01  adk  10/15/2019 Stream the transfers to slave SLRs in the background
+*                       and print the time taken by each slave SLR
 *
 * </pre>
 *
@@ -45,6 +47,8 @@
 /***************************** Include Files *********************************/
 #include "xplmi_ssit.h"
 #include "pmc_global.h"
+#include "xplmi_dma.h"
+#include "xplmi_timeline.h"
 /************************** Constant Definitions *****************************/
 
 /**************************** Type Definitions *******************************/
@@ -52,8 +56,186 @@
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
+static void XPlmi_SsitStreamDone(XPlmi_DmaDesc *Desc);
+static void XPlmi_SsitPrintStats(u32 SlavesMask);
 
 /************************** Variable Definitions *****************************/
+static XPlmi_SsitSlaveStats SlaveStats[SSIT_MAX_SLAVES];
+static XPlmi_DmaDesc StreamDescs[SSIT_MAX_SLAVES][XPLMI_SSIT_STREAM_DESCS];
+
+/*****************************************************************************/
+/**
+ * @brief This function returns the slave SLR whose PMC address window
+ * contains an address.
+ *
+ * @param Addr is the address
+ *
+ * @return Slave SLR index, or XPLMI_SSIT_NO_SLAVE
+ *
+ *****************************************************************************/
+u32 XPlmi_SsitGetSlave(u64 Addr)
+{
+	u32 Slave = XPLMI_SSIT_NO_SLAVE;
+
+	if ((Addr >= XPLMI_SSIT_SLAVE_0_BASEADDR) &&
+	    (Addr < (XPLMI_SSIT_SLAVE_0_BASEADDR +
+		    (SSIT_MAX_SLAVES * XPLMI_SSIT_SLAVE_WINDOW_SIZE)))) {
+		Slave = (u32)((Addr - XPLMI_SSIT_SLAVE_0_BASEADDR) /
+				XPLMI_SSIT_SLAVE_WINDOW_SIZE);
+	}
+
+	return Slave;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function is called by the DMA queue when a transfer to a
+ * slave SLR is done.
+ *
+ * @param Desc is the descriptor of the transfer
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XPlmi_SsitStreamDone(XPlmi_DmaDesc *Desc)
+{
+	XPlmi_SsitSlaveStats *Stats = (XPlmi_SsitSlaveStats *)Desc->PrivData;
+
+	Desc->Len = 0U;
+	Stats->Pending--;
+	if (Stats->Pending == 0U) {
+		Stats->DoneTicks = XPlmi_TlGetTicks();
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function starts a transfer to a slave SLR in the background,
+ * on PMC DMA1, and returns. The slave SLR loads the data while the master
+ * processes its next commands. When all the descriptors of the slave are
+ * in flight, it waits for the oldest one. The source must remain valid
+ * until the transfer is done, it can not be in the PMC RAM.
+ *
+ * @param Slave is the slave SLR index
+ * @param SrcAddr is the source address
+ * @param DestAddr is the destination address, in the window of the slave
+ * @param Len is the number of words to transfer
+ * @param Flags are the DMA XFER flags, the DMA selection is ignored
+ *
+ * @return XST_SUCCESS or error from XPlmi_DmaQueueSubmit
+ *
+ *****************************************************************************/
+int XPlmi_SsitStreamXfer(u32 Slave, u64 SrcAddr, u64 DestAddr, u32 Len,
+		u32 Flags)
+{
+	int Status;
+	XPlmi_SsitSlaveStats *Stats = &SlaveStats[Slave];
+	XPlmi_DmaDesc *Desc = NULL;
+	u32 Index;
+
+	/* Start the transfers queued behind the completed ones */
+	XPlmi_DmaQueuePoll();
+	while (Desc == NULL) {
+		for (Index = 0U; Index < XPLMI_SSIT_STREAM_DESCS; Index++) {
+			if (StreamDescs[Slave][Index].Len == 0U) {
+				Desc = &StreamDescs[Slave][Index];
+				break;
+			}
+		}
+		if (Desc == NULL) {
+			XPlmi_DmaQueuePoll();
+		}
+	}
+
+	if (Stats->Active == FALSE) {
+		Stats->Active = TRUE;
+		Stats->Words = 0U;
+		Stats->Xfers = 0U;
+		Stats->StartTicks = XPlmi_TlGetTicks();
+	}
+
+	Desc->SrcAddr = SrcAddr;
+	Desc->DestAddr = DestAddr;
+	Desc->Len = Len;
+	Desc->Flags = (Flags & ~(XPLMI_PMCDMA_0 | XPLMI_PMCDMA_1)) |
+			XPLMI_PMCDMA_1;
+	Desc->Type = XPLMI_DMA_DESC_XFER;
+	Desc->Callback = XPlmi_SsitStreamDone;
+	Desc->PrivData = Stats;
+	Stats->Pending++;
+	Status = XPlmi_DmaQueueSubmit(Desc);
+	if (Status != XST_SUCCESS) {
+		Desc->Len = 0U;
+		Stats->Pending--;
+		goto END;
+	}
+	Stats->Words += Len;
+	Stats->Xfers++;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function waits for the background transfers to slave SLRs to
+ * be done.
+ *
+ * @param SlavesMask is the mask of the slave SLRs, SSIT_SLAVE_*_MASK
+ *
+ * @return None
+ *
+ *****************************************************************************/
+void XPlmi_SsitStreamWait(u32 SlavesMask)
+{
+	u32 Slave;
+
+	for (Slave = 0U; Slave < SSIT_MAX_SLAVES; Slave++) {
+		if ((SlavesMask & (1U << Slave)) == 0U) {
+			continue;
+		}
+		while (SlaveStats[Slave].Pending != 0U) {
+			XPlmi_DmaQueuePoll();
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function prints, for each slave SLR which received data since
+ * the previous synchronization, the data size, the time taken to transfer it
+ * and the time until the slave reached the synchronization point.
+ *
+ * @param SlavesMask is the mask of the slave SLRs, SSIT_SLAVE_*_MASK
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XPlmi_SsitPrintStats(u32 SlavesMask)
+{
+	XPlmi_SsitSlaveStats *Stats;
+	u32 TicksPerUs = XPlmi_GetPmcIroFreq() / 1000000U;
+	u32 SyncTicks = XPlmi_TlGetTicks();
+	u32 Slave;
+
+	for (Slave = 0U; Slave < SSIT_MAX_SLAVES; Slave++) {
+		Stats = &SlaveStats[Slave];
+		if (((SlavesMask & (1U << Slave)) == 0U) ||
+		    (Stats->Active == FALSE)) {
+			continue;
+		}
+		Stats->Active = FALSE;
+		if (TicksPerUs == 0U) {
+			continue;
+		}
+		/* PLM timer decrements */
+		XPlmi_Printf(DEBUG_PRINT_PERF, "Slave SLR%u: %u KB in %u "
+			"transfers, %u us, synced after %u us\n\r", Slave + 1U,
+			Stats->Words / 256U, Stats->Xfers,
+			(Stats->StartTicks - Stats->DoneTicks) / TicksPerUs,
+			(Stats->StartTicks - SyncTicks) / TicksPerUs);
+	}
+}
 
 /*****************************************************************************/
 /**
@@ -137,6 +319,9 @@ int XPlmi_SsitSyncSlaves(XPlmi_Cmd * Cmd)
 
 	XPlmi_Printf(DEBUG_DETAILED, "%s %p\n\r", __func__, Cmd);
 
+	/* Slaves can only synchronize once they received all their data */
+	XPlmi_SsitStreamWait(SlavesMask);
+
 	/* Wait until all Slaves initiate synchronization point */
 	while (((SlavesReady & SlavesMask) != SlavesMask) &&
 		((ErrorStatus & PMC_GLOBAL_SSIT_ERR_MASK) == 0x0U) && (TimeOut != 0x0U)) {
@@ -197,6 +382,7 @@ int XPlmi_SsitSyncSlaves(XPlmi_Cmd * Cmd)
 	XPlmi_UtilRMW(PMC_GLOBAL_SSIT_ERR, PMC_GLOBAL_SSIT_ERR_IRQ_OUT_0_MASK,
 			0x0U);
 	XPlmi_Printf(DEBUG_DETAILED, "SSIT Sync Slaves successful\n\r");
+	XPlmi_SsitPrintStats(SlavesMask);
 	Status = XST_SUCCESS;
 
 END:
@@ -226,6 +412,9 @@ int XPlmi_SsitWaitSlaves(XPlmi_Cmd * Cmd)
 
 	XPlmi_Printf(DEBUG_DETAILED, "%s %p\n\r", __func__, Cmd);
 
+	/* Slaves can only synchronize once they received all their data */
+	XPlmi_SsitStreamWait(SlavesMask);
+
 	/* Wait until all Slaves initiate synchronization point */
 	while (((SlavesReady & SlavesMask) != SlavesMask) &&
 		((ErrorStatus & PMC_GLOBAL_SSIT_ERR_MASK) == 0x0U) && (TimeOut != 0x0U)) {
@@ -255,6 +444,7 @@ int XPlmi_SsitWaitSlaves(XPlmi_Cmd * Cmd)
 	}
 
 	XPlmi_Printf(DEBUG_DETAILED, "SSIT Wait Master successful\n\r");
+	XPlmi_SsitPrintStats(SlavesMask);
 	Status = XST_SUCCESS;
 END:
 	return Status;
@@ -35,6 +35,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  ma   08/13/2019 Initial release
+* 1.01  adk  10/15/2019 Added concurrent streaming to slave SLRs
 *
 * </pre>
 *
@@ -64,7 +65,25 @@ extern "C" {
 #define SSIT_SLAVE_0_MASK	1U
 #define SSIT_SLAVE_1_MASK	2U
 #define SSIT_SLAVE_2_MASK	4U
+#define SSIT_MAX_SLAVES		3U
+
+/* PMC address windows of the slave SLRs, as seen from the master SLR */
+#define XPLMI_SSIT_SLAVE_0_BASEADDR	(0x108000000ULL)
+#define XPLMI_SSIT_SLAVE_WINDOW_SIZE	(0x4000000ULL)
+
+/* Transfers to one slave SLR which can be in flight */
+#define XPLMI_SSIT_STREAM_DESCS		(4U)
+#define XPLMI_SSIT_NO_SLAVE		(0xFFFFFFFFU)
 /**************************** Type Definitions *******************************/
+/* Statistics of the transfers to a slave SLR, in PLM timer ticks */
+typedef struct {
+	u32 Words;		/* Words transferred */
+	u32 Xfers;		/* Transfers */
+	u32 StartTicks;		/* Start of the first transfer */
+	u32 DoneTicks;		/* Completion of the last transfer */
+	u32 Pending;		/* Transfers in flight */
+	u8 Active;		/* Transfers started since the last sync */
+} XPlmi_SsitSlaveStats;
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -72,6 +91,10 @@ extern "C" {
 int XPlmi_SsitSyncMaster(XPlmi_Cmd * Cmd);
 int XPlmi_SsitSyncSlaves(XPlmi_Cmd * Cmd);
 int XPlmi_SsitWaitSlaves(XPlmi_Cmd * Cmd);
+u32 XPlmi_SsitGetSlave(u64 Addr);
+int XPlmi_SsitStreamXfer(u32 Slave, u64 SrcAddr, u64 DestAddr, u32 Len,
+		u32 Flags);
+void XPlmi_SsitStreamWait(u32 SlavesMask);
 
 #ifdef __cplusplus
 }
@@ -138,6 +138,10 @@ enum {
 	XPLMI_ERR_SSIT_SLAVE_SYNC,	/**< 0x111 - Error when SSIT master
 					 times out waiting for slaves sync
 					 point */
+	XPLMI_ERR_IPI_SHM_BUF,		/**< 0x112 - Error when the shared
+					  memory buffer of an IPI command is
+					  not word aligned or not in DDR or
+					  OCM */
 
 	/** Status codes used in PLM */
 	XPLM_ERR_TASK_CREATE = 0x200,	/**< 0x200 - Error when task create
@@ -253,6 +257,13 @@ enum {
 					  secure validations fail. */
 	XLOADER_ERR_GEN_IDCODE,		/**< 0X326 - Error caused due to
 						mismatch in IDCODEs */
+	XLOADER_ERR_RDBK_PARAM,		/**< 0x327 - Error when frame readback
+					  parameters are invalid */
+	XLOADER_ERR_RDBK_HASH,		/**< 0x328 - Error when the hash of
+					  the frames read back does not match */
+	XLOADER_ERR_ASYNC_LOAD,		/**< 0x329 - Error when an asynchronous
+					  load is requested while another one
+					  is in progress or without IPI */
 };
 
 /**************************** Type Definitions *******************************/
@@ -37,6 +37,8 @@
  * Ver   Who  Date        Changes
  * ----- ---- -------- -------------------------------------------------------
  * 1.00  sn   07/01/2019 Initial release
+ * 1.01  adk  10/15/2019 Added pre-armed actions for the sysmon alarms, run
+ *                       from the error interrupt
  *
  * </pre>
  *
@@ -45,15 +47,35 @@
  ******************************************************************************/
 /***************************** Include Files *********************************/
 #include "xplmi_sysmon.h"
+#include "xplmi_err.h"
+#include "xplmi_ipi.h"
+#include "xplmi_proc.h"
+#include "xpm_node.h"
+#include "xpm_clock.h"
 #include "sleep.h"
 
 /************************** Constant Definitions *****************************/
+/* CFU global control, used to stop the PL */
+#define XPLMI_SYSMON_CFU_FGCR		(0xF12B0018U)
+#define XPLMI_SYSMON_CFU_FGCR_GWE_MASK	(0x00000040U)
+#define XPLMI_SYSMON_CFU_FGCR_GTS_CFG_B_MASK	(0x00000010U)
 
 /**************************** Type Definitions *******************************/
+/* Pre-armed action of a sysmon alarm */
+typedef struct {
+	u32 Actions;			/* XPLMI_SYSMON_ACTION_* */
+	XPm_OutClockNode *Clk;		/* Clock to throttle */
+	u32 Divider;			/* Divider of the throttled clock */
+	u32 IpiMask;			/* Subsystems to notify */
+	u32 Count;			/* Alarms handled */
+	u64 LastLatency;		/* Timer ticks of the last handling */
+	u64 MaxLatency;			/* Timer ticks of the slowest handling */
+} XPlmi_SysMonAction;
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
+static void XPlmi_SysMonAlarmHandler(u8 ErrorIndex);
 
 /************************** Variable Definitions *****************************/
 
@@ -62,6 +84,9 @@
 static XSysMonPsv SysMonInst;
 static XSysMonPsv *SysMonInstPtr = &SysMonInst;
 
+/* Actions of the PMCSMON0 to PMCSMON9 alarms */
+static XPlmi_SysMonAction SysMonActions[XPLMI_SYSMON_NUM_ALARMS];
+
 /*****************************************************************************/
 /**
  * @brief This function initializes the SysMon
@@ -143,3 +168,208 @@ void XPlmi_SysMonOTDetect(void)
 
 	XPlmi_Out32(XSYSMONPSV_BASEADDR + XSYSMONPSV_PCSR_LOCK, 0);
 }
+
+/*****************************************************************************/
+/**
+ * @brief This function returns the action entry of a sysmon alarm error.
+ *
+ * @param	ErrorId is the PMCSMON0 to PMCSMON9 error node ID
+ *
+ * @return	Pointer to the action entry, or NULL if ErrorId is not a
+ *		sysmon alarm
+ *
+ *****************************************************************************/
+static XPlmi_SysMonAction *XPlmi_SysMonGetAction(u32 ErrorId)
+{
+	XPlmi_SysMonAction *ActionPtr = NULL;
+
+	if ((NODETYPE(ErrorId) == XPM_NODETYPE_EVENT_PMC_ERR2) &&
+	    (NODEINDEX(ErrorId) >= XPM_NODEIDX_ERROR_PMCSMON0) &&
+	    (NODEINDEX(ErrorId) <= XPM_NODEIDX_ERROR_PMCSMON9)) {
+		ActionPtr = &SysMonActions[NODEINDEX(ErrorId) -
+					   XPM_NODEIDX_ERROR_PMCSMON0];
+	}
+
+	return ActionPtr;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function is the handler of the sysmon alarm errors. It is
+ * called from the error interrupt and runs the actions armed for the alarm,
+ * with no lookup, and records the time taken.
+ *
+ * @param	ErrorIndex is the error node index, PMCSMON0 to PMCSMON9
+ *
+ * @return	void
+ *
+ *****************************************************************************/
+static void XPlmi_SysMonAlarmHandler(u8 ErrorIndex)
+{
+	XPlmi_SysMonAction *ActionPtr;
+	u64 TStart = XPlmi_GetTimerValue();
+	u64 Latency;
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+	u32 Msg[XPLMI_SYSMON_NOTIFY_LEN];
+#endif
+
+	if ((ErrorIndex < XPM_NODEIDX_ERROR_PMCSMON0) ||
+	    (ErrorIndex > XPM_NODEIDX_ERROR_PMCSMON9)) {
+		return;
+	}
+	ActionPtr = &SysMonActions[ErrorIndex - XPM_NODEIDX_ERROR_PMCSMON0];
+
+	if ((ActionPtr->Actions & XPLMI_SYSMON_ACTION_THROTTLE) != 0U) {
+		(void)XPmClock_SetDivider(ActionPtr->Clk, ActionPtr->Divider);
+	}
+
+	if ((ActionPtr->Actions & XPLMI_SYSMON_ACTION_PL_SHUTDN) != 0U) {
+		/* Freeze the PL flops and tristate the PL outputs */
+		XPlmi_UtilRMW(XPLMI_SYSMON_CFU_FGCR,
+			      XPLMI_SYSMON_CFU_FGCR_GWE_MASK |
+			      XPLMI_SYSMON_CFU_FGCR_GTS_CFG_B_MASK, 0U);
+	}
+
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+	if ((ActionPtr->Actions & XPLMI_SYSMON_ACTION_NOTIFY) != 0U) {
+		Msg[0U] = (XPLMI_SYSMON_NOTIFY_LEN << 16U) |
+			(XPLMI_MODULE_ERROR_ID << 8U) |
+			XPLMI_SYSMON_NOTIFY_API_ID;
+		Msg[1U] = NODEID(XPM_NODECLASS_EVENT,
+				 XPM_NODESUBCL_EVENT_ERROR,
+				 XPM_NODETYPE_EVENT_PMC_ERR2, ErrorIndex);
+		Msg[2U] = XPlmi_In32(XSYSMONPSV_BASEADDR +
+				     XSYSMONPSV_DEVICE_TEMP_MAX);
+		/* The ack is not waited for */
+		if (XPlmi_IpiWrite(ActionPtr->IpiMask, Msg,
+				   XPLMI_SYSMON_NOTIFY_LEN,
+				   XIPIPSU_BUF_TYPE_MSG) == XST_SUCCESS) {
+			(void)XPlmi_IpiTrigger(ActionPtr->IpiMask);
+		}
+	}
+#endif
+
+	/* The PIT counts down */
+	Latency = TStart - XPlmi_GetTimerValue();
+	ActionPtr->Count++;
+	ActionPtr->LastLatency = Latency;
+	if (Latency > ActionPtr->MaxLatency) {
+		ActionPtr->MaxLatency = Latency;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function arms the actions of a sysmon alarm. The actions are
+ * resolved here, so that the error interrupt runs them directly when the
+ * alarm is raised, without going through a task.
+ *
+ * @param	ErrorId is the PMCSMON0 to PMCSMON9 error node ID
+ * @param	Actions is a mask of XPLMI_SYSMON_ACTION_*, 0 to disarm
+ * @param	ClockId is the clock node ID to throttle
+ * @param	Divider is the divider to set on the throttled clock
+ * @param	IpiMask is the IPI mask of the subsystems to notify
+ *
+ * @return	XST_SUCCESS on success, else an error code
+ *
+ * @note	Arming replaces the error action of the alarm, including the
+ *		default SRST of PMCSMON8. Disarming sets it to none.
+ *
+ *****************************************************************************/
+int XPlmi_SysMonSetAction(u32 ErrorId, u32 Actions, u32 ClockId,
+		u32 Divider, u32 IpiMask)
+{
+	int Status = XPLMI_INVALID_ERROR_ID;
+	XPlmi_SysMonAction *ActionPtr = XPlmi_SysMonGetAction(ErrorId);
+	XPm_OutClockNode *Clk = NULL;
+
+	if (ActionPtr == NULL) {
+		goto END;
+	}
+
+	Status = XPLMI_INVALID_ERROR_ACTION;
+	if ((Actions & ~XPLMI_SYSMON_ACTION_MASK) != 0U) {
+		goto END;
+	}
+
+	if ((Actions & XPLMI_SYSMON_ACTION_THROTTLE) != 0U) {
+		if ((0U == Divider) || (!ISOUTCLK(ClockId))) {
+			goto END;
+		}
+		Clk = (XPm_OutClockNode *)XPmClock_GetById(ClockId);
+		if (Clk == NULL) {
+			goto END;
+		}
+	}
+
+	if ((Actions & XPLMI_SYSMON_ACTION_NOTIFY) != 0U) {
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+		if (0U == IpiMask) {
+			goto END;
+		}
+#else
+		goto END;
+#endif
+	}
+
+	/* The entry is read by the error interrupt */
+	microblaze_disable_interrupts();
+	ActionPtr->Actions = Actions;
+	ActionPtr->Clk = Clk;
+	ActionPtr->Divider = Divider;
+	ActionPtr->IpiMask = IpiMask;
+	microblaze_enable_interrupts();
+
+	if (0U == Actions) {
+		Status = XPlmi_EmSetAction(ErrorId, XPLMI_EM_ACTION_NONE, NULL);
+	} else {
+		Status = XPlmi_EmSetAction(ErrorId, XPLMI_EM_ACTION_CUSTOM,
+					   XPlmi_SysMonAlarmHandler);
+	}
+
+END:
+	XPlmi_Printf(DEBUG_DETAILED, "%s: ErrorId: 0x%x Actions: 0x%x "
+		     "Status: 0x%x\n\r", __func__, ErrorId, Actions, Status);
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function returns the handling statistics of a sysmon alarm.
+ * The latency is the time from the alarm handler entry to the end of its
+ * actions.
+ *
+ * @param	ErrorId is the PMCSMON0 to PMCSMON9 error node ID
+ * @param	CountPtr is updated with the number of alarms handled
+ * @param	LastUsPtr is updated with the last latency in us
+ * @param	MaxUsPtr is updated with the maximum latency in us
+ *
+ * @return	XST_SUCCESS on success, else XPLMI_INVALID_ERROR_ID
+ *
+ *****************************************************************************/
+int XPlmi_SysMonGetStats(u32 ErrorId, u32 *CountPtr, u32 *LastUsPtr,
+		u32 *MaxUsPtr)
+{
+	int Status = XPLMI_INVALID_ERROR_ID;
+	XPlmi_SysMonAction *ActionPtr = XPlmi_SysMonGetAction(ErrorId);
+	u32 TicksPerUs = XPlmi_GetPmcIroFreq() / 1000000U;
+	u64 LastLatency;
+	u64 MaxLatency;
+
+	if ((ActionPtr == NULL) || (0U == TicksPerUs)) {
+		goto END;
+	}
+
+	microblaze_disable_interrupts();
+	*CountPtr = ActionPtr->Count;
+	LastLatency = ActionPtr->LastLatency;
+	MaxLatency = ActionPtr->MaxLatency;
+	microblaze_enable_interrupts();
+
+	*LastUsPtr = (u32)(LastLatency / TicksPerUs);
+	*MaxUsPtr = (u32)(MaxLatency / TicksPerUs);
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
@@ -37,6 +37,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  sn   07/01/2019 Initial release
+* 1.01  adk  10/15/2019 Added pre-armed actions for the sysmon alarms
 *
 * </pre>
 *
@@ -58,6 +59,21 @@ extern "C" {
 #include "xsysmonpsv.h"
 
 /************************** Constant Definitions *****************************/
+/* Actions taken from the error interrupt on a sysmon alarm */
+#define XPLMI_SYSMON_ACTION_THROTTLE	(0x1U)	/* Set a clock divider */
+#define XPLMI_SYSMON_ACTION_PL_SHUTDN	(0x2U)	/* Stop and tristate the PL */
+#define XPLMI_SYSMON_ACTION_NOTIFY	(0x4U)	/* IPI message to a subsystem */
+#define XPLMI_SYSMON_ACTION_MASK	(0x7U)
+
+/* PMC sysmon alarms, PMCSMON0 to PMCSMON9 error events */
+#define XPLMI_SYSMON_NUM_ALARMS		(10U)
+
+/*
+ * Alarm notification sent to the subsystems:
+ * Header, alarm error node ID, maximum device temperature (raw)
+ */
+#define XPLMI_SYSMON_NOTIFY_API_ID	(0x10U)
+#define XPLMI_SYSMON_NOTIFY_LEN		(3U)
 
 /**************************** Type Definitions *******************************/
 
@@ -67,6 +83,10 @@ extern "C" {
 /************************** Function Prototypes ******************************/
 int XPlmi_SysMonInit(void);
 void XPlmi_SysMonOTDetect(void);
+int XPlmi_SysMonSetAction(u32 ErrorId, u32 Actions, u32 ClockId,
+		u32 Divider, u32 IpiMask);
+int XPlmi_SysMonGetStats(u32 ErrorId, u32 *CountPtr, u32 *LastUsPtr,
+		u32 *MaxUsPtr);
 
 /************************** Variable Definitions *****************************/
 
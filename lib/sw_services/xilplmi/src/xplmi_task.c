@@ -47,6 +47,7 @@
 /***************************** Include Files *********************************/
 #include "xplmi_task.h"
 #include "xplmi_debug.h"
+#include "xplmi_timeline.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -55,6 +56,8 @@
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
+static void XPlmi_TaskUpdateStats(XPlmi_TaskNode * Task, u32 StartTicks,
+	int (*PrevHandler)(void * PrivData));
 
 /************************** Variable Definitions *****************************/
 static struct metal_list TaskQueue[XPLMI_TASK_PRIORITIES];
@@ -96,6 +99,9 @@ XPlmi_TaskNode * XPlmi_TaskCreate(u32 Priority,
     metal_list_init(&Task->TaskNode);
     Task->Handler = Handler;
     Task->PrivData = PrivData;
+    Task->Flags = 0U;
+    Task->TriggerTicks = 0U;
+    memset(&Task->Stats, 0, sizeof(Task->Stats));
 END:
     return Task;
 }
@@ -131,7 +137,11 @@ void XPlmi_TaskTriggerNow(XPlmi_TaskNode * Task)
 {
     Xil_AssertVoid(Task->Handler != NULL);
     if (metal_list_is_empty(&Task->TaskNode)) {
+        Task->TriggerTicks = XPlmi_TlGetTicks();
         metal_list_add_tail(&TaskQueue[Task->Priority], &Task->TaskNode);
+    } else {
+        /** The previous trigger is not handled yet */
+        Task->Stats.Overruns++;
     }
 }
 
@@ -156,6 +166,76 @@ void XPlmi_TaskInit(void )
 	}
 }
 
+/*****************************************************************************/
+/**
+ * @brief This function updates the statistics of a task after its handler
+ * returns
+ *
+ * @param	Task Pointer to the task node
+ * @param	StartTicks Timer ticks at the start of the handler
+ * @param	PrevHandler Handler of the task that ran before, NULL if none
+ *
+ * @return	None
+ *****************************************************************************/
+static void XPlmi_TaskUpdateStats(XPlmi_TaskNode * Task, u32 StartTicks,
+	int (*PrevHandler)(void * PrivData))
+{
+	XPlmi_TaskStats *Stats = &Task->Stats;
+	/** PLM timer decrements */
+	u32 Latency = Task->TriggerTicks - StartTicks;
+	u32 RunTime = StartTicks - XPlmi_TlGetTicks();
+
+	Stats->RunCount++;
+	Stats->TotalRunTime += RunTime;
+	Stats->TotalLatency += Latency;
+	if (RunTime > Stats->MaxRunTime) {
+		Stats->MaxRunTime = RunTime;
+	}
+	if (Latency > Stats->MaxLatency) {
+		Stats->MaxLatency = Latency;
+		Stats->MaxLatencyBy = PrevHandler;
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function prints the statistics of all the tasks in use, the
+ * times are in us. For the longest latency, the handler of the task that ran
+ * just before is printed, it is the likely cause of the delay.
+ *
+ * @param	None
+ *
+ * @return	None
+ *****************************************************************************/
+void XPlmi_TaskPrintStats(void )
+{
+	u32 TicksPerUs = XPlmi_GetPmcIroFreq() / 1000000U;
+	XPlmi_TaskStats *Stats;
+	u32 Index;
+
+	if (TicksPerUs == 0U) {
+		goto END;
+	}
+
+	XPlmi_Printf(DEBUG_PRINT_PERF, "Task: Runs Overruns AvgRun MaxRun "
+		"AvgLatency MaxLatency MaxLatencyBy\n\r");
+	for (Index = 0U; Index < XPLMI_TASK_MAX; Index++) {
+		Stats = &Tasks[Index].Stats;
+		if ((Tasks[Index].Handler == NULL) || (Stats->RunCount == 0U)) {
+			continue;
+		}
+		XPlmi_Printf(DEBUG_PRINT_PERF, "0x%x: %u %u %u %u %u %u 0x%x\n\r",
+			(UINTPTR)Tasks[Index].Handler, Stats->RunCount, Stats->Overruns,
+			(u32)(Stats->TotalRunTime / Stats->RunCount) / TicksPerUs,
+			Stats->MaxRunTime / TicksPerUs,
+			(u32)(Stats->TotalLatency / Stats->RunCount) / TicksPerUs,
+			Stats->MaxLatency / TicksPerUs, (UINTPTR)Stats->MaxLatencyBy);
+	}
+
+END:
+	return;
+}
+
 /*****************************************************************************/
 /**
  * @brief This function will be checking for tasks in the queue based on the
@@ -172,6 +252,8 @@ void XPlmi_TaskDispatchLoop(void )
 	struct metal_list *Node;
 	XPlmi_TaskNode *Task;
 	u32 Index;
+	u32 StartTicks;
+	int (*PrevHandler)(void * PrivData) = NULL;
 #ifdef PLM_DEBUG_INFO
 	u64 TaskStartTime;
 #endif
@@ -207,15 +289,24 @@ void XPlmi_TaskDispatchLoop(void )
 			TaskStartTime = XPlmi_GetTimerValue();
 #endif
 			Xil_AssertVoid(Task->Handler != NULL);
+			StartTicks = XPlmi_TlGetTicks();
 			Status = Task->Handler(Task->PrivData);
+			XPlmi_TaskUpdateStats(Task, StartTicks, PrevHandler);
+			PrevHandler = Task->Handler;
 #ifdef PLM_DEBUG_INFO
 			XPlmi_MeasurePerfTime(TaskStartTime);
 			XPlmi_Printf(DEBUG_PRINT_PERF, "Task Time \n\r");
 #endif
 			if (Status != XPLMI_TASK_INPROGRESS)
 			{
-				/** delete the task that is handled */
-				XPlmi_TaskDelete(Task);
+				if ((Task->Flags & XPLMI_TASK_FLAG_PERSISTENT) != 0U)
+				{
+					/** keep the task for its next trigger */
+					metal_list_del(&Task->TaskNode);
+				} else {
+					/** delete the task that is handled */
+					XPlmi_TaskDelete(Task);
+				}
 			}
 			if ((Status != XST_SUCCESS) &&
 			    (Status != XPLMI_TASK_INPROGRESS))
@@ -65,15 +65,36 @@ enum PRIORITY {
         XPLM_TASK_PRIORITY_1,
 };
 
+/** Task flags */
+#define XPLMI_TASK_FLAG_PERSISTENT	(0x1U) /**< Not deleted after it runs */
+
 /**************************** Type Definitions *******************************/
 typedef struct XPlmi_TaskNode XPlmi_TaskNode;
 
+/**
+ * Task statistics, in ticks of the PLM timer. The latency is the time from
+ * the trigger of the task to the start of its handler.
+ */
+typedef struct {
+    u32 RunCount;	/**< Number of handler calls */
+    u32 Overruns;	/**< Triggers while the task was already pending */
+    u32 MaxRunTime;	/**< Longest handler call */
+    u32 MaxLatency;	/**< Longest latency */
+    u64 TotalRunTime;	/**< Sum of the handler calls */
+    u64 TotalLatency;	/**< Sum of the latencies */
+    int (*MaxLatencyBy)(void * PrivData); /**< Handler that ran just before
+					    the longest latency */
+} XPlmi_TaskStats;
+
 struct XPlmi_TaskNode {
     u32 Priority;
     u32 Delay;
     struct metal_list TaskNode;
     int (*Handler)(void * PrivData);
     void * PrivData;
+    u32 Flags;
+    u32 TriggerTicks;
+    XPlmi_TaskStats Stats;
 };
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -92,6 +113,7 @@ void XPlmi_TaskDelete(XPlmi_TaskNode * Task);
 void XPlmi_TaskTriggerNow(XPlmi_TaskNode * Task);
 void XPlmi_TaskInit(void );
 void XPlmi_TaskDispatchLoop(void );
+void XPlmi_TaskPrintStats(void );
 /************************** Variable Definitions *****************************/
 
 /*****************************************************************************/
@@ -0,0 +1,256 @@
+/******************************************************************************
+* Copyright (C) 2019 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xplmi_timeline.c
+*
+* This file contains the boot timeline recording and the command to read it.
+* The timeline is kept in PLM data memory, PMC RAM is used by the CDO chunk
+* buffers.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  kc   10/14/2019 Initial release
+*       adk  10/15/2019 Moved XPLMI_TL_TIMER_RESET_VALUE to the header
+*       adk  10/15/2019 Destination of XPlmi_GetTimeline is validated
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xplmi_timeline.h"
+#include "xplmi_dma.h"
+#include "xplmi_hw.h"
+#include "xplmi_util.h"
+#include "xplmi_ipi.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+#define XPLMI_TL_PAYLOAD_LEN		(3U)
+#define XPLMI_TL_WORD_LEN		(4U)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+/************************** Variable Definitions *****************************/
+static XPlmi_Timeline Timeline = {XPLMI_TL_MAGIC, XPLMI_TL_VERSION};
+
+/*****************************************************************************/
+
+#ifdef PLM_BOOT_TIMELINE
+/*****************************************************************************/
+/**
+ * @brief This function saturates a tick count to the 32 bit duration of an
+ * event
+ *
+ * @param Duration in ticks
+ *
+ * @return Duration, or 0xFFFFFFFF if it does not fit in 32 bits
+ *
+ *****************************************************************************/
+static u32 XPlmi_TlDuration(u64 Duration)
+{
+	u32 Ticks = 0xFFFFFFFFU;
+
+	if (Duration < (u64)0xFFFFFFFFU) {
+		Ticks = (u32)Duration;
+	}
+
+	return Ticks;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function adds an event of a known duration to the timeline
+ *
+ * @param Type of the event
+ * @param Id of the image, partition or command
+ * @param Arg is the event specific argument
+ * @param StartTime is the timer value at the start of the event, as read
+ * with XPlmi_GetTimerValue
+ * @param Duration of the event in ticks
+ *
+ * @return none
+ *
+ *****************************************************************************/
+void XPlmi_TlRecordDuration(u32 Type, u32 Id, u32 Arg, u64 StartTime,
+		u64 Duration)
+{
+	XPlmi_TlEvent *Event;
+
+	if (Timeline.NumEvents >= XPLMI_TL_MAX_EVENTS) {
+		Timeline.DroppedEvents++;
+		goto END;
+	}
+
+	Event = &Timeline.Events[Timeline.NumEvents];
+	Event->Type = Type;
+	Event->Id = Id;
+	Event->Arg = Arg;
+	Event->Duration = XPlmi_TlDuration(Duration);
+	Event->Start = XPLMI_TL_TIMER_RESET_VALUE - StartTime;
+	Timeline.NumEvents++;
+
+END:
+	return;
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function adds an event that ends now to the timeline
+ *
+ * @param Type of the event
+ * @param Id of the image, partition or command
+ * @param Arg is the event specific argument
+ * @param StartTime is the timer value at the start of the event, as read
+ * with XPlmi_GetTimerValue
+ *
+ * @return none
+ *
+ *****************************************************************************/
+void XPlmi_TlRecord(u32 Type, u32 Id, u32 Arg, u64 StartTime)
+{
+	XPlmi_TlRecordDuration(Type, Id, Arg, StartTime,
+			StartTime - XPlmi_GetTimerValue());
+}
+
+/*****************************************************************************/
+/**
+ * @brief This function keeps a CDO command that ends now in the list of the
+ * slowest commands, if it took longer than the fastest one of a full list.
+ * The list is sorted with the slowest command first.
+ *
+ * @param CmdId is the command ID, module and API ID
+ * @param Arg is the image ID of the CDO
+ * @param StartTicks is the value of XPlmi_TlGetTicks at the command start
+ *
+ * @return none
+ *
+ *****************************************************************************/
+void XPlmi_TlCdoCmd(u32 CmdId, u32 Arg, u32 StartTicks)
+{
+	u32 Duration = StartTicks - XPlmi_TlGetTicks();
+	u32 Index = Timeline.NumSlowCmds;
+	XPlmi_TlEvent *Event;
+
+	if (Index == XPLMI_TL_MAX_SLOW_CMDS) {
+		if (Duration <= Timeline.SlowCmds[Index - 1U].Duration) {
+			goto END;
+		}
+		/* The fastest command is dropped */
+		Index--;
+	} else {
+		Timeline.NumSlowCmds++;
+	}
+
+	while ((Index > 0U) &&
+	       (Timeline.SlowCmds[Index - 1U].Duration < Duration)) {
+		Timeline.SlowCmds[Index] = Timeline.SlowCmds[Index - 1U];
+		Index--;
+	}
+
+	Event = &Timeline.SlowCmds[Index];
+	Event->Type = XPLMI_TL_EVENT_CDO_CMD;
+	Event->Id = CmdId;
+	Event->Arg = Arg;
+	Event->Duration = Duration;
+	Event->Start = XPLMI_TL_TIMER_RESET_VALUE - XPlmi_GetTimerValue() -
+			Duration;
+
+END:
+	return;
+}
+#endif
+
+/*****************************************************************************/
+/**
+ * @brief This function copies the boot timeline to a given address.
+ *  Command payload parameters are
+ *	* High Dest Addr
+ *	* Low Dest Addr
+ *	* Max Len in bytes
+ *
+ * The destination must be in the low DDR or in the OCM, as the shared
+ * memory IPI payloads. The response has the status followed by the number
+ * of bytes copied. When PLM_BOOT_TIMELINE is not defined, the timeline has
+ * no events.
+ *
+ * @param Pointer to the command structure
+ *
+ * @return Returns the Status
+ *****************************************************************************/
+int XPlmi_GetTimeline(XPlmi_Cmd * Cmd)
+{
+	int Status = XST_FAILURE;
+	u64 DestAddr;
+	u32 Len = sizeof(Timeline);
+
+	if (Cmd->PayloadLen < XPLMI_TL_PAYLOAD_LEN) {
+		Status = XST_INVALID_PARAM;
+		goto END;
+	}
+
+	DestAddr = ((u64)Cmd->Payload[0U] << 32U) | (u64)Cmd->Payload[1U];
+	if (Cmd->Payload[2U] < Len) {
+		Len = Cmd->Payload[2U];
+	}
+	Len &= ~(XPLMI_TL_WORD_LEN - 1U);
+
+	Timeline.TimerFreq = XPlmi_GetPmcIroFreq();
+	Timeline.RomTime = XPLMI_TL_TIMER_RESET_VALUE -
+		((u64)XPlmi_In32(PMC_GLOBAL_GLOBAL_GEN_STORAGE0) |
+		 ((u64)XPlmi_In32(PMC_GLOBAL_GLOBAL_GEN_STORAGE1) << 32U));
+
+	if (Len != 0U) {
+#ifdef XPAR_XIPIPSU_0_DEVICE_ID
+		/* The destination is given by the caller */
+		Status = XPlmi_IpiShmValidate(DestAddr, Len / XPLMI_TL_WORD_LEN);
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+#endif
+		Status = XPlmi_DmaXfr((u64)(UINTPTR)&Timeline, DestAddr,
+				Len / XPLMI_TL_WORD_LEN, XPLMI_PMCDMA_0);
+		if (Status != XST_SUCCESS) {
+			goto END;
+		}
+	}
+	Cmd->Response[1U] = Len;
+	Status = XST_SUCCESS;
+
+END:
+	Cmd->Response[0U] = (u32)Status;
+	return Status;
+}
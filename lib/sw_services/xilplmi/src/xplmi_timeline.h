@@ -0,0 +1,148 @@
+/******************************************************************************
+* Copyright (C) 2019 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xplmi_timeline.h
+*
+* This file contains declarations for the boot timeline. The timeline is a
+* binary record of the time taken by the images, partitions and secure stages
+* loaded by PLM, and of the slowest CDO commands executed. It is read with the
+* XPlmi_GetTimeline generic command, for example from Linux over IPI.
+*
+* All the times are in ticks of the PMC IRO, the frequency is given in the
+* timeline header. Start times are counted from the PLM start.
+*
+* The header and event layouts, the event types and the stage IDs are shared
+* with the zynqmp_fsbl boot timeline, so that boot_timeline.py in versal_plm
+* misc can print and compare the timelines of both loaders.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  kc   10/14/2019 Initial release
+*       adk  10/15/2019 Added the boot stage events
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+#ifndef XPLMI_TIMELINE_H
+#define XPLMI_TIMELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+#include "xil_io.h"
+#include "xplmi_config.h"
+#include "xplmi_proc.h"
+#include "xplmi_cmd.h"
+
+/************************** Constant Definitions *****************************/
+#define XPLMI_TL_MAGIC			(0x4C544C50U) /* "PLTL" */
+#define XPLMI_TL_VERSION		(1U)
+#define XPLMI_TL_MAX_EVENTS		(48U)
+#define XPLMI_TL_MAX_SLOW_CMDS		(16U)
+#define XPLMI_TL_TIMER_RESET_VALUE	((((u64)XPLMI_PIT1_RESET_VALUE) << 32U) | \
+					 (u64)XPLMI_PIT2_RESET_VALUE)
+
+/**
+ * Event types
+ *  - IMAGE: Id is the image ID, Arg the image number
+ *  - PRTN: Id is the partition ID, Arg the partition number
+ *  - SECURE_HASH, SECURE_AES: Id is the partition ID, Arg the number of
+ *    blocks, Duration the sum over all the blocks of the partition
+ *  - CDO_CMD: Id is the command ID (module and API ID), Arg the image ID
+ *  - STAGE: Id is the boot stage ID, Arg is 0
+ */
+#define XPLMI_TL_EVENT_IMAGE		(1U)
+#define XPLMI_TL_EVENT_PRTN		(2U)
+#define XPLMI_TL_EVENT_SECURE_HASH	(3U)
+#define XPLMI_TL_EVENT_SECURE_AES	(4U)
+#define XPLMI_TL_EVENT_CDO_CMD		(5U)
+#define XPLMI_TL_EVENT_STAGE		(6U)
+
+/**
+ * Boot stage IDs
+ *  - INIT: PLM initialization, from the PLM start
+ *  - BOOT_DEVICE: Initialization of the boot device
+ *  - HANDOFF: Boot PDI loaded, from the PLM start
+ */
+#define XPLMI_TL_STAGE_INIT		(1U)
+#define XPLMI_TL_STAGE_BOOT_DEVICE	(2U)
+#define XPLMI_TL_STAGE_HANDOFF		(3U)
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u32 Type;	/**< Event type */
+	u32 Id;		/**< Image, partition or command ID */
+	u32 Arg;	/**< Event specific argument */
+	u32 Duration;	/**< Ticks, saturated to 0xFFFFFFFF */
+	u64 Start;	/**< Ticks since the PLM start */
+} XPlmi_TlEvent;
+
+typedef struct {
+	u32 Magic;		/**< XPLMI_TL_MAGIC */
+	u32 Version;		/**< XPLMI_TL_VERSION */
+	u32 TimerFreq;		/**< Tick frequency in Hz */
+	u32 NumEvents;		/**< Valid entries in Events */
+	u32 DroppedEvents;	/**< Events lost because Events was full */
+	u32 NumSlowCmds;	/**< Valid entries in SlowCmds */
+	u64 RomTime;		/**< Ticks taken by the PMC ROM */
+	XPlmi_TlEvent Events[XPLMI_TL_MAX_EVENTS];	/**< In order of end */
+	XPlmi_TlEvent SlowCmds[XPLMI_TL_MAX_SLOW_CMDS];	/**< Slowest first */
+} XPlmi_Timeline;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+/**
+ * Lower 32 bits of the PLM timer, read directly from the counter register
+ * of PIT2. This is cheap enough to time every CDO command. PIT2 decrements,
+ * so the duration is the start value minus the end value.
+ */
+#define XPlmi_TlGetTicks()	Xil_In32(XPLMI_PIT2_COUNTER_ADDR)
+
+/************************** Function Prototypes ******************************/
+#ifdef PLM_BOOT_TIMELINE
+void XPlmi_TlRecord(u32 Type, u32 Id, u32 Arg, u64 StartTime);
+void XPlmi_TlRecordDuration(u32 Type, u32 Id, u32 Arg, u64 StartTime,
+		u64 Duration);
+void XPlmi_TlCdoCmd(u32 CmdId, u32 Arg, u32 StartTicks);
+#endif
+int XPlmi_GetTimeline(XPlmi_Cmd * Cmd);
+
+/************************** Variable Definitions *****************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XPLMI_TIMELINE_H */
@@ -27,6 +27,7 @@
 #include "pm_api_sys.h"
 #include "pm_callbacks.h"
 #include "pm_client.h"
+#include <xil_cache.h>
 
 /* Payload Packets */
 #define PACK_PAYLOAD(Payload, Arg0, Arg1, Arg2, Arg3, Arg4, Arg5)	\
@@ -42,6 +43,9 @@
 
 #define HEADER(len, ApiId)		((len << 16) | (LIBPM_MODULE_ID << 8) | (ApiId))
 
+/* Header length of a message that carries a shared memory descriptor */
+#define BATCH_DESC_LEN			(7U)
+
 #define PACK_PAYLOAD0(Payload, ApiId) \
 	PACK_PAYLOAD(Payload, HEADER(0, ApiId), 0, 0, 0, 0, 0)
 #define PACK_PAYLOAD1(Payload, ApiId, Arg1) \
@@ -1865,6 +1869,156 @@ done:
 	return Status;
 }
 
+/****************************************************************************/
+/**
+ * @brief  This function prepares a buffer to batch PM operations, so that
+ * they are sent to the PLM with a single IPI by XPm_BatchSend.
+ *
+ * @param  Batch	Batch to prepare
+ * @param  Buf		Buffer of the operations, in DDR or OCM and word
+ *			aligned. It must not be used before XPm_BatchSend
+ *			returns.
+ * @param  BufLen	Length of Buf in words
+ * @param  MaxOps	Maximum number of operations in the batch, up to
+ *			XPM_BATCH_MAX_OPS
+ *
+ * @return XST_SUCCESS if successful else XST_INVALID_PARAM
+ *
+ * @note   The operations are added with XPm_BatchAdd
+ *
+ ****************************************************************************/
+XStatus XPm_BatchInit(XPm_Batch *const Batch, u32 *const Buf,
+		      const u32 BufLen, const u32 MaxOps)
+{
+	XStatus Status = XST_INVALID_PARAM;
+
+	if ((NULL == Batch) || (NULL == Buf) || (0U == MaxOps) ||
+	    (MaxOps > XPM_BATCH_MAX_OPS) ||
+	    (BufLen < (XPM_BATCH_STATUS_INDEX + MaxOps))) {
+		goto done;
+	}
+
+	Batch->Buf = Buf;
+	Batch->BufLen = BufLen;
+	Batch->MaxOps = MaxOps;
+	Batch->NextWord = XPM_BATCH_STATUS_INDEX + MaxOps;
+	Buf[XPM_BATCH_NUM_OPS_INDEX] = 0U;
+	Buf[XPM_BATCH_OPS_OFFSET_INDEX] = Batch->NextWord;
+	Status = XST_SUCCESS;
+
+done:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+ * @brief  This function adds a PM operation to a batch
+ *
+ * @param  Batch	Batch prepared with XPm_BatchInit
+ * @param  ApiId	PM API ID of the operation, for example PM_REQUEST_NODE
+ * @param  Args		Arguments of the operation, as for the single call
+ * @param  NumArgs	Number of arguments
+ *
+ * @return XST_SUCCESS if successful else XST_INVALID_PARAM if the batch
+ * is full
+ *
+ * @note   Only the status of an operation is returned, use operations that
+ * return no value such as PM_REQUEST_NODE, PM_SET_REQUIREMENT,
+ * PM_RESET_ASSERT or PM_CLOCK_ENABLE
+ *
+ ****************************************************************************/
+XStatus XPm_BatchAdd(XPm_Batch *const Batch, const u32 ApiId,
+		     const u32 *const Args, const u32 NumArgs)
+{
+	XStatus Status = XST_INVALID_PARAM;
+	u32 *Buf = Batch->Buf;
+	u32 Idx;
+
+	if ((Buf[XPM_BATCH_NUM_OPS_INDEX] >= Batch->MaxOps) ||
+	    (NumArgs > 0xFFU) ||
+	    ((NumArgs + 1U) > (Batch->BufLen - Batch->NextWord)) ||
+	    ((NumArgs != 0U) && (NULL == Args))) {
+		goto done;
+	}
+
+	XPm_Dbg("%s(%d, %d)\r\n", __func__, ApiId, NumArgs);
+	Buf[Batch->NextWord] = HEADER(NumArgs, ApiId);
+	for (Idx = 0U; Idx < NumArgs; Idx++) {
+		Buf[Batch->NextWord + 1U + Idx] = Args[Idx];
+	}
+	Batch->NextWord += NumArgs + 1U;
+	Buf[XPM_BATCH_NUM_OPS_INDEX]++;
+	Status = XST_SUCCESS;
+
+done:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+ * @brief  This function sends all the operations of a batch to the PLM in a
+ * single IPI. The PLM runs all of them in order, also after a failed one,
+ * and the status of each is read with XPm_BatchGetStatus.
+ *
+ * @param  Batch	Batch with the operations
+ * @param  NumFailed	Number of operations that failed (optional)
+ *
+ * @return XST_SUCCESS if all the operations succeeded else XST_FAILURE or
+ * an error code
+ *
+ * @note   The batch can be sent again, or prepared again with XPm_BatchInit
+ *
+ ****************************************************************************/
+XStatus XPm_BatchSend(XPm_Batch *const Batch, u32 *const NumFailed)
+{
+	XStatus Status;
+	u32 Payload[PAYLOAD_ARG_CNT];
+	u64 Addr = (u64)(UINTPTR)Batch->Buf;
+	u32 Len = Batch->NextWord;
+
+	/* The payload is in memory, the message carries its descriptor */
+	PACK_PAYLOAD(Payload, HEADER(BATCH_DESC_LEN, PM_BATCH), Len,
+		     (u32)Addr, (u32)(Addr >> 32U), 0, 0);
+	Xil_DCacheFlushRange((UINTPTR)Batch->Buf, Len * sizeof(u32));
+
+	/* Send request to the target module */
+	Status = XPm_IpiSend(PrimaryProc, Payload);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+
+	/* Return result from IPI return buffer */
+	Status = Xpm_IpiReadBuff32(PrimaryProc, NumFailed, NULL, NULL);
+	Xil_DCacheInvalidateRange((UINTPTR)Batch->Buf, Len * sizeof(u32));
+
+done:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+ * @brief  This function returns the status of an operation of a sent batch
+ *
+ * @param  Batch	Batch sent with XPm_BatchSend
+ * @param  Index	Index of the operation, in the order of XPm_BatchAdd
+ *
+ * @return Status of the operation, XST_INVALID_PARAM if Index is not an
+ * operation of the batch
+ *
+ * @note   None
+ *
+ ****************************************************************************/
+XStatus XPm_BatchGetStatus(const XPm_Batch *const Batch, const u32 Index)
+{
+	XStatus Status = XST_INVALID_PARAM;
+
+	if (Index < Batch->Buf[XPM_BATCH_NUM_OPS_INDEX]) {
+		Status = (XStatus)Batch->Buf[XPM_BATCH_STATUS_INDEX + Index];
+	}
+
+	return Status;
+}
+
 /* Callback API functions */
 struct pm_init_suspend pm_susp = {
 	.received = false,
@@ -100,6 +100,16 @@ typedef struct XPm_Ntfier {
 	struct XPm_Ntfier* next;
 } XPm_Notifier;
 
+/**
+ * XPm_Batch - PM operations sent to the PLM with a single IPI
+ */
+typedef struct XPm_Btch {
+	u32 *Buf;	/**< Buffer of the operations, see PM_BATCH */
+	u32 BufLen;	/**< Length of Buf in words */
+	u32 MaxOps;	/**< Maximum number of operations */
+	u32 NextWord;	/**< Offset of the next operation in Buf */
+} XPm_Batch;
+
 /* Global data declarations */
 extern struct pm_init_suspend pm_susp;
 extern struct pm_acknowledge pm_ack;
@@ -161,6 +171,12 @@ XStatus XPm_GetOpCharacteristic(const u32 DeviceId,
 int XPm_InitFinalize(void);
 int XPm_RegisterNotifier(XPm_Notifier* const Notifier);
 int XPm_UnregisterNotifier(XPm_Notifier* const Notifier);
+XStatus XPm_BatchInit(XPm_Batch *const Batch, u32 *const Buf,
+		      const u32 BufLen, const u32 MaxOps);
+XStatus XPm_BatchAdd(XPm_Batch *const Batch, const u32 ApiId,
+		     const u32 *const Args, const u32 NumArgs);
+XStatus XPm_BatchSend(XPm_Batch *const Batch, u32 *const NumFailed);
+XStatus XPm_BatchGetStatus(const XPm_Batch *const Batch, const u32 Index);
 void XPm_NotifyCb(const u32 Node, const enum XPmNotifyEvent Event,
 		  const u32 Oppoint);
 
@@ -472,9 +472,24 @@ enum XPmNotifyEvent {
 #define PM_INIT_NODE			62U
 #define PM_FEATURE_CHECK		63U
 #define PM_ISO_CONTROL			64U
+#define PM_BATCH			65U
 
 #define PM_API_MIN      PM_GET_API_VERSION
-#define PM_API_MAX      PM_ISO_CONTROL
+#define PM_API_MAX      PM_BATCH
+
+/**
+ * PM_BATCH buffer, in shared memory:
+ *  - Word 0: number of operations
+ *  - Word 1: offset in words of the first operation
+ *  - Word 2 to 2 + number of operations - 1: status of each operation,
+ *    written by the PLM
+ *  - From the offset: operations, each is a command header with the API ID
+ *    and the number of arguments in bits 16 to 23, followed by the arguments
+ */
+#define XPM_BATCH_NUM_OPS_INDEX		(0U)
+#define XPM_BATCH_OPS_OFFSET_INDEX	(1U)
+#define XPM_BATCH_STATUS_INDEX		(2U)
+#define XPM_BATCH_MAX_OPS		(64U)
 
 #ifdef __cplusplus
 }
@@ -67,6 +67,84 @@ static XPlmi_Module XPlmi_Pm =
 	PM_API_MAX+1,
 };
 
+static int XPm_ProcessCmd(XPlmi_Cmd * Cmd);
+
+/****************************************************************************/
+/**
+ * @brief  This function runs the operations of a PM_BATCH buffer, see
+ * xpm_defs.h for its layout. All the operations are run, also after a failed
+ * one, and the status of each is written to the buffer. The values returned
+ * by the operations, other than the status, are dropped.
+ *
+ * @param  Cmd		PM_BATCH command, the payload is the batch buffer
+ * @param  NumFailed	Number of operations that failed
+ *
+ * @return XST_SUCCESS if all the operations succeeded, XST_FAILURE if one
+ * failed, XST_INVALID_PARAM if the buffer is not valid
+ *
+ * @note   The batch buffer was checked to be in DDR or OCM by the PLM
+ *
+ ****************************************************************************/
+static int XPm_ProcessBatch(XPlmi_Cmd * Cmd, u32 *NumFailed)
+{
+	int Status = XST_INVALID_PARAM;
+	u32 *Buf = Cmd->Payload;
+	u32 NumOps;
+	u32 Offset;
+	u32 OpLen;
+	u32 Idx;
+	XPlmi_Cmd OpCmd;
+
+	*NumFailed = 0U;
+	if (Cmd->Len <= XPM_BATCH_STATUS_INDEX) {
+		goto done;
+	}
+
+	NumOps = Buf[XPM_BATCH_NUM_OPS_INDEX];
+	Offset = Buf[XPM_BATCH_OPS_OFFSET_INDEX];
+	if ((NumOps > XPM_BATCH_MAX_OPS) ||
+	    (Offset < (XPM_BATCH_STATUS_INDEX + NumOps)) ||
+	    (Offset > Cmd->Len)) {
+		goto done;
+	}
+
+	/* Check all the operations before running any */
+	for (Idx = 0U; Idx < NumOps; Idx++) {
+		if (Offset >= Cmd->Len) {
+			goto done;
+		}
+		OpLen = (Buf[Offset] & XPLMI_CMD_LEN_MASK) >> 16U;
+		if (((Buf[Offset] & XPLMI_CMD_API_ID_MASK) == PM_BATCH) ||
+		    (OpLen >= (Cmd->Len - Offset))) {
+			goto done;
+		}
+		Offset += OpLen + 1U;
+	}
+
+	Offset = Buf[XPM_BATCH_OPS_OFFSET_INDEX];
+	for (Idx = 0U; Idx < NumOps; Idx++) {
+		OpLen = (Buf[Offset] & XPLMI_CMD_LEN_MASK) >> 16U;
+		memset(&OpCmd, 0, sizeof(OpCmd));
+		OpCmd.SubsystemId = Cmd->SubsystemId;
+		OpCmd.IpiMask = Cmd->IpiMask;
+		OpCmd.CmdId = (Buf[Offset] & ~XPLMI_CMD_MODULE_ID_MASK) |
+			(XPLMI_MODULE_XILPM_ID << 8U);
+		OpCmd.Len = OpLen;
+		OpCmd.PayloadLen = OpLen;
+		OpCmd.Payload = &Buf[Offset + 1U];
+		Buf[XPM_BATCH_STATUS_INDEX + Idx] = XPm_ProcessCmd(&OpCmd);
+		if (Buf[XPM_BATCH_STATUS_INDEX + Idx] != XST_SUCCESS) {
+			(*NumFailed)++;
+		}
+		Offset += OpLen + 1U;
+	}
+
+	Status = (*NumFailed == 0U) ? XST_SUCCESS : XST_FAILURE;
+
+done:
+	return Status;
+}
+
 static int XPm_ProcessCmd(XPlmi_Cmd * Cmd)
 {
 	u32 ApiResponse[XPLMI_CMD_RESP_SIZE-1] = {0, 0, 0};
@@ -262,6 +340,9 @@ static int XPm_ProcessCmd(XPlmi_Cmd * Cmd)
 						      Pload[1], Pload[2],
 						      Pload[3], Cmd->IpiMask);
 			break;
+		case PM_BATCH:
+			Status = XPm_ProcessBatch(Cmd, &ApiResponse[0]);
+			break;
 		default:
 			PmErr("CMD: INVALID PARAM\n\r");
 			Status = XST_INVALID_PARAM;
@@ -4042,6 +4123,7 @@ int XPm_FeatureCheck(const u32 ApiId, u32 *const Version)
 	case PM_SET_CURRENT_SUBSYSTEM:
 	case PM_INIT_NODE:
 	case PM_FEATURE_CHECK:
+	case PM_BATCH:
 		*Version = XST_API_BASE_VERSION;
 		break;
 	default:
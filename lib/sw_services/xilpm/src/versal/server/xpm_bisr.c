@@ -169,6 +169,20 @@
 #define CFRM_HB_EXP_REPAIR_VAL1_MASK 		0x001FFFFF
 #define CFRM_HB_EXP_REPAIR_VAL1_SHIFT 		0
 
+/*
+ * GTY and DDRMC repairs are on independent NPI endpoints. They are all
+ * triggered while the eFUSE tags are scanned and waited for as a set.
+ */
+#define BISR_MAX_PENDING		16U
+
+typedef struct {
+	u64 BaseAddr;	/* NPI base address of the endpoint */
+	u32 TagType;	/* TAG_ID_TYPE_GTY or TAG_ID_TYPE_DDRMC */
+} XPm_BisrPending;
+
+static XPm_BisrPending BisrPending[BISR_MAX_PENDING];
+static u32 NumBisrPending;
+
 static u32 XPmTagIdWhiteList[TAG_ID_ARRAY_SIZE] = {0};
 static void XPmBisr_InitTagIdList()
 {
@@ -249,24 +263,10 @@ done:
 	return TagDataAddr;
 }
 
-static XStatus XPmBisr_RepairGty(u32 EfuseTagAddr, u32 TagSize, u32 TagOptional, u32 *TagDataAddr)
+static XStatus XPmBisr_GtyDone(u64 BaseAddr)
 {
 	XStatus Status = XST_SUCCESS;
 	u32 RegValue;
-	u64 BaseAddr, BisrDataDestAddr;
-
-	BaseAddr = NPI_FIXED_BASEADDR | (TagOptional<<NPI_EFUSE_ENDPOINT_SHIFT);
-	BisrDataDestAddr = BaseAddr | GTY_NPI_CACHE_DATA_REGISTER_OFFSET;
-
-	/* Copy repair data */
-	*TagDataAddr = XPmBisr_CopyStandard(EfuseTagAddr, TagSize, BisrDataDestAddr);
-
-	/* Unlock PCSR */
-	PmOut32(BaseAddr | GTY_PCSR_LOCK_OFFSET, PCSR_UNLOCK_VAL);
-
-	/* Trigger Bisr */
-	PmOut32(BaseAddr | GTY_PCSR_MASK_OFFSET, GTY_PCSR_BISR_TRIGGER_MASK);
-	PmOut32(BaseAddr | GTY_PCSR_CONTROL_OFFSET, GTY_PCSR_BISR_TRIGGER_MASK);
 
 	/* Wait for Bisr to finish */
 	Status = XPm_PollForMask(BaseAddr | GTY_PCSR_STATUS_OFFSET, GTY_PCSR_STATUS_BISR_DONE_MASK, XPM_POLL_TIMEOUT);
@@ -290,6 +290,101 @@ done:
 	return Status;
 }
 
+static XStatus XPmBisr_DdrMcDone(u64 BaseAddr)
+{
+	XStatus Status = XST_SUCCESS;
+	u32 RegValue;
+
+	/* Wait for Bisr to be done and check status */
+	Status = XPm_PollForMask(BaseAddr | DDRMC_NPI_CACHE_STATUS_REGISTER_OFFSET,
+				 DDRMC_NPI_CACHE_STATUS_BISR_DONE_MASK,
+				 XPM_POLL_TIMEOUT);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+
+	PmIn32(BaseAddr | DDRMC_NPI_CACHE_STATUS_REGISTER_OFFSET, RegValue);
+	if ((RegValue & DDRMC_NPI_CACHE_STATUS_BISR_PASS_MASK) != DDRMC_NPI_CACHE_STATUS_BISR_PASS_MASK) {
+		Status = XST_FAILURE;
+		goto done;
+	}
+
+	/* Disable Bisr Clock */
+	PmRmw32(BaseAddr | DDRMC_NPI_CLK_GATE_REGISTER_OFFSET, DDRMC_NPI_CLK_GATE_BISREN_MASK, ~DDRMC_NPI_CLK_GATE_BISREN_MASK);
+
+	/* Unwrite Trigger Bit */
+	PmOut32(BaseAddr | DDRMC_NPI_PCSR_MASK_REGISTER_OFFSET, DDRMC_NPI_PCSR_BISR_TRIGGER_MASK);
+	PmOut32(BaseAddr | DDRMC_NPI_PCSR_CONTROL_REGISTER_OFFSET, 0);
+
+	/* Lock PCSR */
+	PmOut32(BaseAddr | DDRMC_NPI_PCSR_LOCK_REGISTER_OFFSET, 1);
+
+done:
+	return Status;
+}
+
+/*
+ * Wait for all the triggered GTY and DDRMC repairs. All of them are waited
+ * for, also after a failed one, the first failure is returned.
+ */
+static XStatus XPmBisr_WaitPending(void)
+{
+	XStatus Status = XST_SUCCESS;
+	XStatus RepairStatus;
+	u32 Idx;
+
+	for (Idx = 0; Idx < NumBisrPending; Idx++) {
+		if (TAG_ID_TYPE_GTY == BisrPending[Idx].TagType) {
+			RepairStatus = XPmBisr_GtyDone(BisrPending[Idx].BaseAddr);
+		} else {
+			RepairStatus = XPmBisr_DdrMcDone(BisrPending[Idx].BaseAddr);
+		}
+		if ((XST_SUCCESS != RepairStatus) && (XST_SUCCESS == Status)) {
+			Status = RepairStatus;
+		}
+	}
+	NumBisrPending = 0;
+
+	return Status;
+}
+
+static XStatus XPmBisr_AddPending(u64 BaseAddr, u32 TagType)
+{
+	XStatus Status = XST_SUCCESS;
+
+	if (BISR_MAX_PENDING == NumBisrPending) {
+		Status = XPmBisr_WaitPending();
+	}
+	BisrPending[NumBisrPending].BaseAddr = BaseAddr;
+	BisrPending[NumBisrPending].TagType = TagType;
+	NumBisrPending++;
+
+	return Status;
+}
+
+static XStatus XPmBisr_RepairGty(u32 EfuseTagAddr, u32 TagSize, u32 TagOptional, u32 *TagDataAddr)
+{
+	XStatus Status = XST_SUCCESS;
+	u64 BaseAddr, BisrDataDestAddr;
+
+	BaseAddr = NPI_FIXED_BASEADDR | (TagOptional<<NPI_EFUSE_ENDPOINT_SHIFT);
+	BisrDataDestAddr = BaseAddr | GTY_NPI_CACHE_DATA_REGISTER_OFFSET;
+
+	/* Copy repair data */
+	*TagDataAddr = XPmBisr_CopyStandard(EfuseTagAddr, TagSize, BisrDataDestAddr);
+
+	/* Unlock PCSR */
+	PmOut32(BaseAddr | GTY_PCSR_LOCK_OFFSET, PCSR_UNLOCK_VAL);
+
+	/* Trigger Bisr, it is waited for in XPmBisr_WaitPending */
+	PmOut32(BaseAddr | GTY_PCSR_MASK_OFFSET, GTY_PCSR_BISR_TRIGGER_MASK);
+	PmOut32(BaseAddr | GTY_PCSR_CONTROL_OFFSET, GTY_PCSR_BISR_TRIGGER_MASK);
+
+	Status = XPmBisr_AddPending(BaseAddr, TAG_ID_TYPE_GTY);
+
+	return Status;
+}
+
 static XStatus XPmBisr_RepairLpd(u32 EfuseTagAddr, u32 TagSize, u32 *TagDataAddr)
 {
 	XStatus Status;
@@ -489,7 +584,6 @@ done:
 static XStatus XPmBisr_RepairDdrMc(u32 EfuseTagAddr, u32 TagSize, u32 TagOptional, u32 *TagDataAddr)
 {
 	XStatus Status = XST_SUCCESS;
-	u32 RegValue;
 	u64 BaseAddr, BisrDataDestAddr;
 	XPm_NpDomain *NpDomain = (XPm_NpDomain *)XPmPower_GetById(PM_POWER_NOC);
 
@@ -514,33 +608,11 @@ static XStatus XPmBisr_RepairDdrMc(u32 EfuseTagAddr, u32 TagSize, u32 TagOptiona
 	/* Enable Bisr clock */
 	PmRmw32(BaseAddr | DDRMC_NPI_CLK_GATE_REGISTER_OFFSET, DDRMC_NPI_CLK_GATE_BISREN_MASK, DDRMC_NPI_CLK_GATE_BISREN_MASK);
 
-	/*Trigger Bisr */
+	/*Trigger Bisr, it is waited for in XPmBisr_WaitPending */
 	PmOut32(BaseAddr | DDRMC_NPI_PCSR_MASK_REGISTER_OFFSET, DDRMC_NPI_PCSR_BISR_TRIGGER_MASK);
 	PmOut32(BaseAddr | DDRMC_NPI_PCSR_CONTROL_REGISTER_OFFSET, DDRMC_NPI_PCSR_BISR_TRIGGER_MASK);
 
-	/* Wait for Bisr to be done and check status */
-	Status = XPm_PollForMask(BaseAddr | DDRMC_NPI_CACHE_STATUS_REGISTER_OFFSET,
-				 DDRMC_NPI_CACHE_STATUS_BISR_DONE_MASK,
-				 XPM_POLL_TIMEOUT);
-	if (XST_SUCCESS != Status) {
-		goto done;
-	}
-
-	PmIn32(BaseAddr | DDRMC_NPI_CACHE_STATUS_REGISTER_OFFSET, RegValue);
-	if ((RegValue & DDRMC_NPI_CACHE_STATUS_BISR_PASS_MASK) != DDRMC_NPI_CACHE_STATUS_BISR_PASS_MASK) {
-		Status = XST_FAILURE;
-		goto done;
-	}
-
-	/* Disable Bisr Clock */
-	PmRmw32(BaseAddr | DDRMC_NPI_CLK_GATE_REGISTER_OFFSET, DDRMC_NPI_CLK_GATE_BISREN_MASK, ~DDRMC_NPI_CLK_GATE_BISREN_MASK);
-
-	/* Unwrite Trigger Bit */
-	PmOut32(BaseAddr | DDRMC_NPI_PCSR_MASK_REGISTER_OFFSET, DDRMC_NPI_PCSR_BISR_TRIGGER_MASK);
-	PmOut32(BaseAddr | DDRMC_NPI_PCSR_CONTROL_REGISTER_OFFSET, 0);
-
-	/* Lock PCSR */
-	PmOut32(BaseAddr | DDRMC_NPI_PCSR_LOCK_REGISTER_OFFSET, 1);
+	Status = XPmBisr_AddPending(BaseAddr, TAG_ID_TYPE_DDRMC);
 
 done:
 	return Status;
@@ -861,6 +933,7 @@ XStatus XPmBisr_Repair(u32 TagId)
 	u32 EfuseBisrSize;
 	u32 EfuseBisrOptional;
 	u32 TagType;
+	XStatus RepairStatus;
 	XPm_Device *EfuseCache = XPmDevice_GetById(PM_DEV_EFUSE_CACHE);
 	if (NULL == EfuseCache) {
 		Status = XST_FAILURE;
@@ -968,5 +1041,12 @@ XStatus XPmBisr_Repair(u32 TagId)
 	}
 
 done:
+	/* Wait for the GTY and DDRMC repairs triggered by the scan */
+	if (0U != NumBisrPending) {
+		RepairStatus = XPmBisr_WaitPending();
+		if (XST_SUCCESS == Status) {
+			Status = RepairStatus;
+		}
+	}
 	return Status;
 }
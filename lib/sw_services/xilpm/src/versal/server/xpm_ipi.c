@@ -79,6 +79,25 @@ done:
 XStatus XPm_IpiReadStatus(u32 IpiMask)
 {
 	u32 Response[RESPONSE_ARG_CNT] = {0};
+
+	return XPm_IpiRead(IpiMask, Response);
+}
+
+/****************************************************************************/
+/**
+ * @brief	Reads the whole IPI Response after target module has handled
+ *		interrupt
+ *
+ * @param	IpiMask		IPI interrupt mask of target
+ * @param	Response	Buffer of RESPONSE_ARG_CNT words for the response
+ *
+ * @return	XST_SUCCESS if successful else XST_FAILURE or an error code
+ *
+ * @note	The status returned by the target is in Response[0]
+ *
+ ****************************************************************************/
+XStatus XPm_IpiRead(u32 IpiMask, u32 *Response)
+{
 	XStatus Status;
 
 	/* Wait until current IPI interrupt is handled by target module */
@@ -115,4 +134,12 @@ XStatus XPm_IpiReadStatus(u32 IpiMask)
 
 	return XST_FAILURE;
 }
+
+XStatus XPm_IpiRead(u32 IpiMask, u32 *Response)
+{
+	(void)IpiMask;
+	(void)Response;
+
+	return XST_FAILURE;
+}
 #endif /* XPAR_XIPIPSU_0_DEVICE_ID */
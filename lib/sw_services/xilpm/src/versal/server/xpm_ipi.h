@@ -46,6 +46,7 @@ extern "C" {
 
 XStatus XPm_IpiSend(u32 IpiMask, u32 *Payload);
 XStatus XPm_IpiReadStatus(u32 IpiMask);
+XStatus XPm_IpiRead(u32 IpiMask, u32 *Response);
 
 /*
  * XSDB master IPI-5 mask
@@ -37,6 +37,7 @@
 #include "xpm_gic_proxy.h"
 #include "xpm_regs.h"
 #include "xpm_board.h"
+#include "xplmi_proc.h"
 
 extern u32 ResetReason;
 extern int XLoader_ReloadImage(u32 ImageId);
@@ -775,11 +776,33 @@ done:
 	return;
 }
 
+static void XPmPowerDomain_PrintStepTimes(XPm_PowerDomain *PwrDomain)
+{
+	u32 TicksPerUs = XPlmi_GetPmcIroFreq() / 1000000U;
+	u32 Idx;
+
+	if (0U == TicksPerUs) {
+		goto done;
+	}
+
+	for (Idx = 0U; Idx < XPM_POWER_DOMAIN_NUM_FUNCS; Idx++) {
+		if (0U != PwrDomain->StepTime[Idx]) {
+			PmDbg("Power domain 0x%x, function %d: %d us\r\n",
+			      PwrDomain->Power.Node.Id, Idx,
+			      PwrDomain->StepTime[Idx] / TicksPerUs);
+		}
+	}
+
+done:
+	return;
+}
+
 XStatus XPmPowerDomain_InitDomain(XPm_PowerDomain *PwrDomain, u32 Function,
 				  u32 *Args, u32 NumArgs)
 {
 	XStatus Status = XST_SUCCESS;
 	struct XPm_PowerDomainOps *Ops = PwrDomain->DomainOps;
+	u64 StartTime = XPlmi_GetTimerValue();
 
 	if ((XPM_POWER_STATE_ON == PwrDomain->Power.Node.State) && (Function != FUNC_XPPU_CTRL)) {
 		goto done;
@@ -810,6 +833,7 @@ XStatus XPmPowerDomain_InitDomain(XPm_PowerDomain *PwrDomain, u32 Function,
 		PwrDomain->Power.Node.State = XPM_POWER_STATE_ON;
 		XPmDomainIso_ProcessPending(PwrDomain->Power.Node.Id);
 		XPmPower_UpdateResetFlags(PwrDomain, FUNC_INIT_FINISH);
+		XPmPowerDomain_PrintStepTimes(PwrDomain);
 		break;
 	case FUNC_SCAN_CLEAR:
 		if (XPM_POWER_STATE_INITIALIZING != PwrDomain->Power.Node.State) {
@@ -935,6 +959,12 @@ XStatus XPmPowerDomain_InitDomain(XPm_PowerDomain *PwrDomain, u32 Function,
 		break;
 	}
 
+	/* PMC timer decrements */
+	if (Function < XPM_POWER_DOMAIN_NUM_FUNCS) {
+		PwrDomain->StepTime[Function] =
+			(u32)(StartTime - XPlmi_GetTimerValue());
+	}
+
 done:
 	return Status;
 }
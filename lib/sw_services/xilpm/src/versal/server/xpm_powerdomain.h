@@ -59,12 +59,16 @@ struct XPm_PowerDomainOps {
 	XStatus (*XppuCtrl)(u32 *Args, u32 NumOfArgs);
 };
 
+#define XPM_POWER_DOMAIN_NUM_FUNCS	(FUNC_XPPU_CTRL + 1U)
+
 struct XPm_PowerDomain {
 	XPm_Power Power; /**< Power: Power node base class */
 	XPm_Power *Children; /**< List of children power nodes */
 	struct XPm_PowerDomainOps *DomainOps; /**< house cleaning operations */
 	u32 InitMask; /**< Mask to indicate house cleaning functions present */
 	u32 InitFlag; /**< Flag to indicate house cleaning functions performed */
+	u32 StepTime[XPM_POWER_DOMAIN_NUM_FUNCS]; /**< PMC timer ticks taken by
+						    each init function */
 };
 
 /************************** Function Prototypes ******************************/
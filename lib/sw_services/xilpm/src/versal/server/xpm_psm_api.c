@@ -155,6 +155,127 @@ done:
 	return Status;
 }
 
+/****************************************************************************/
+/**
+ * @brief This Function sends a batched power up/down of processors to PSM
+ *
+ * @param ApiId		PSM_API_BATCH_PWR_UP or PSM_API_BATCH_PWR_DWN
+ * @param DeviceIds	Device IDs of processors
+ * @param Count		Number of processors
+ *
+ * @return XST_SUCCESS if successful else XST_FAILURE or an error code.
+ *
+ * @note none
+ *
+ ****************************************************************************/
+static XStatus XPm_DirectPwrBatch(const u32 ApiId, const u32 *DeviceIds,
+				  const u32 Count)
+{
+	XStatus Status = XST_SUCCESS;
+	u32 Payload[PAYLOAD_ARG_CNT] = {0};
+	u32 Idx;
+
+	if (Count > (PAYLOAD_ARG_CNT - 2U)) {
+		Status = XST_INVALID_PARAM;
+		goto done;
+	}
+
+	Payload[0] = ApiId;
+	Payload[1] = Count;
+	for (Idx = 0U; Idx < Count; Idx++) {
+		Payload[2U + Idx] = DeviceIds[Idx];
+	}
+
+	Status = XPm_IpiSend(PSM_IPI_INT_MASK, Payload);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+
+	Status = XPm_IpiReadStatus(PSM_IPI_INT_MASK);
+
+done:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+ * @brief This Function will power up several processors with one IPI to PSM.
+ *       PSM powers up the islands of the processors in parallel.
+ *
+ * @param DeviceIds	Device IDs of processors
+ * @param Count		Number of processors
+ *
+ * @return XST_SUCCESS if successful else XST_FAILURE or an error code.
+ *
+ * @note none
+ *
+ ****************************************************************************/
+XStatus XPm_DirectPwrUpBatch(const u32 *DeviceIds, const u32 Count)
+{
+	return XPm_DirectPwrBatch(PSM_API_BATCH_PWR_UP, DeviceIds, Count);
+}
+
+/****************************************************************************/
+/**
+ * @brief This Function will power down several processors with one IPI to
+ *       PSM.
+ *
+ * @param DeviceIds	Device IDs of processors
+ * @param Count		Number of processors
+ *
+ * @return XST_SUCCESS if successful else XST_FAILURE or an error code.
+ *
+ * @note none
+ *
+ ****************************************************************************/
+XStatus XPm_DirectPwrDwnBatch(const u32 *DeviceIds, const u32 Count)
+{
+	return XPm_DirectPwrBatch(PSM_API_BATCH_PWR_DWN, DeviceIds, Count);
+}
+
+/****************************************************************************/
+/**
+ * @brief This Function reads the direct power transition counters of a
+ *       processor from PSM.
+ *
+ * @param DeviceId	Device ID of processor
+ * @param Stats		Buffer of PSM_PWR_STATS_CNT words: power up count,
+ *			last and max power up cycles, power down count, last
+ *			and max power down cycles
+ *
+ * @return XST_SUCCESS if successful else XST_FAILURE or an error code.
+ *
+ * @note Cycles are PSM clock cycles
+ *
+ ****************************************************************************/
+XStatus XPm_GetPsmPwrStats(const u32 DeviceId, u32 *Stats)
+{
+	XStatus Status = XST_SUCCESS;
+	u32 Payload[PAYLOAD_ARG_CNT] = {0};
+	u32 Response[RESPONSE_ARG_CNT] = {0};
+	u32 Idx;
+
+	Payload[0] = PSM_API_GET_PWR_STATS;
+	Payload[1] = DeviceId;
+
+	Status = XPm_IpiSend(PSM_IPI_INT_MASK, Payload);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+
+	Status = XPm_IpiRead(PSM_IPI_INT_MASK, Response);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+
+	for (Idx = 0U; Idx < PSM_PWR_STATS_CNT; Idx++) {
+		Stats[Idx] = Response[1U + Idx];
+	}
+
+done:
+	return Status;
+}
+
 /****************************************************************************/
 /**
  * @brief This Function is called by PSM to perform actions to finish suspend
@@ -42,12 +42,21 @@ extern "C" {
 #define PSM_API_DIRECT_PWR_DWN			(1U)
 #define PSM_API_DIRECT_PWR_UP			(2U)
 #define PSM_API_FPD_HOUSECLEAN			(3U)
+#define PSM_API_GET_PWR_STATS			(4U)
+#define PSM_API_BATCH_PWR_DWN			(5U)
+#define PSM_API_BATCH_PWR_UP			(6U)
+
+/* Words returned by PSM_API_GET_PWR_STATS */
+#define PSM_PWR_STATS_CNT			(6U)
 
 void XPm_PsmModuleInit(void);
 XStatus XPm_PwrDwnEvent(const u32 DeviceId);
 XStatus XPm_WakeUpEvent(const u32 DeviceId);
 XStatus XPm_DirectPwrUp(const u32 DeviceId);
 XStatus XPm_DirectPwrDwn(const u32 DeviceId);
+XStatus XPm_DirectPwrUpBatch(const u32 *DeviceIds, const u32 Count);
+XStatus XPm_DirectPwrDwnBatch(const u32 *DeviceIds, const u32 Count);
+XStatus XPm_GetPsmPwrStats(const u32 DeviceId, u32 *Stats);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,387 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+ * @file pm_dvfs.c
+ *
+ * Frequency governor for the APU and RPU clocks, see pm_dvfs.h
+ *
+ * @addtogroup xpm_apis XilPM APIs
+ * @{
+ *****************************************************************************/
+#include <string.h>
+#include "pm_dvfs.h"
+#include "pm_client.h"
+
+#define XPM_DVFS_UP_LOAD	80U	/* Default load to speed up */
+#define XPM_DVFS_DOWN_LOAD	50U	/* Default load to slow down */
+
+/****************************************************************************/
+/**
+ * @brief  Account the idle time up to now in the load window
+ *
+ * @param  gov  Pointer to the governor
+ * @param  now  Current time stamp
+ *
+ * @return None
+ *
+ * @note   None
+ *
+ ****************************************************************************/
+static void XPm_DvfsAccountIdle(XPm_Dvfs *const gov, const u64 now)
+{
+	if (0U != gov->idle) {
+		gov->idleTicks += now - gov->idleStart;
+		gov->idleStart = now;
+	}
+}
+
+/****************************************************************************/
+/**
+ * @brief  Initialize a governor
+ *
+ * The current PLL feedback divider and clock divider are read back and
+ * matched against the operating points. When none matches, the fastest
+ * operating point is applied.
+ *
+ * @param  gov          Pointer to the governor
+ * @param  clock        Processor clock, e.g. PM_CLOCK_ACPU or PM_CLOCK_CPU_R5
+ * @param  pll          Source PLL of the clock, e.g. NODE_APLL or NODE_RPLL
+ * @param  opps         Operating points, sorted by increasing frequency
+ * @param  numOpps      Number of operating points, 1 to XPM_DVFS_MAX_OPPS
+ * @param  timeHandler  Free running time stamp used to measure the load
+ *
+ * @return XST_SUCCESS, XST_INVALID_PARAM or the status of reading or
+ * setting the clock as returned by the PMU-FW
+ *
+ * @note   None
+ *
+ ****************************************************************************/
+XStatus XPm_DvfsInit(XPm_Dvfs *const gov, const enum XPmClock clock,
+		     const enum XPmNodeId pll, const XPm_DvfsOpp *const opps,
+		     const u32 numOpps, const XPm_DvfsTimeHandler timeHandler)
+{
+	XStatus status = XST_INVALID_PARAM;
+	u32 i;
+
+	if ((NULL == gov) || (NULL == opps) || (NULL == timeHandler) ||
+	    (0U == numOpps) || (numOpps > XPM_DVFS_MAX_OPPS)) {
+		goto done;
+	}
+
+	(void)memset(gov, 0, sizeof(*gov));
+	gov->clock = clock;
+	gov->pll = pll;
+	gov->numOpps = numOpps;
+	gov->cap = numOpps - 1U;
+	gov->upLoad = XPM_DVFS_UP_LOAD;
+	gov->downLoad = XPM_DVFS_DOWN_LOAD;
+	gov->timeHandler = timeHandler;
+	for (i = 0U; i < numOpps; i++) {
+		gov->opps[i] = opps[i];
+	}
+
+	status = XPm_ClockGetDivider(clock, &gov->divider);
+	if (XST_SUCCESS != status) {
+		goto done;
+	}
+	status = XPm_PllGetParameter(pll, PM_PLL_PARAM_ID_FBDIV, &gov->fbdiv);
+	if (XST_SUCCESS != status) {
+		goto done;
+	}
+
+	for (i = 0U; i < numOpps; i++) {
+		if ((opps[i].divider == gov->divider) &&
+		    ((0U == opps[i].fbdiv) || (opps[i].fbdiv == gov->fbdiv))) {
+			break;
+		}
+	}
+
+	if (i < numOpps) {
+		gov->cur = i;
+	} else {
+		/* Force the transition from an unknown operating point */
+		gov->cur = numOpps - 1U;
+		gov->divider = 0U;
+		status = XPm_DvfsSetOpp(gov, numOpps - 1U);
+		gov->transitions = 0U;
+		gov->relocks = 0U;
+	}
+
+	gov->windowStart = timeHandler();
+
+done:
+	return status;
+}
+
+/****************************************************************************/
+/**
+ * @brief  Set the load limits of a governor
+ *
+ * @param  gov       Pointer to the governor
+ * @param  upLoad    Load percentage above which the clock is sped up
+ * @param  downLoad  Load percentage below which the clock is slowed down,
+ *  lower than upLoad
+ *
+ * @return None
+ *
+ * @note   The defaults are 80 and 50 percent
+ *
+ ****************************************************************************/
+void XPm_DvfsSetLoadLimits(XPm_Dvfs *const gov, const u32 upLoad,
+			   const u32 downLoad)
+{
+	if ((NULL == gov) || (upLoad > 100U) || (0U == upLoad) ||
+	    (downLoad >= upLoad)) {
+		return;
+	}
+
+	gov->upLoad = upLoad;
+	gov->downLoad = downLoad;
+}
+
+/****************************************************************************/
+/**
+ * @brief  Enable thermal throttling of a governor
+ *
+ * @param  gov          Pointer to the governor
+ * @param  tempHandler  Returns the temperature, NULL to disable throttling
+ * @param  callBackRef  Passed to tempHandler
+ * @param  tripTemp     Temperature above which the clock is throttled
+ * @param  critTemp     Temperature above which the slowest operating point is
+ *  used
+ * @param  hystTemp     Drop below tripTemp needed to release the throttling
+ *
+ * @return None
+ *
+ * @note   Temperatures are in millidegrees Celsius
+ *
+ ****************************************************************************/
+void XPm_DvfsSetThermal(XPm_Dvfs *const gov,
+			const XPm_DvfsTempHandler tempHandler,
+			void *const callBackRef, const s32 tripTemp,
+			const s32 critTemp, const s32 hystTemp)
+{
+	if (NULL == gov) {
+		return;
+	}
+
+	gov->tempHandler = tempHandler;
+	gov->callBackRef = callBackRef;
+	gov->tripTemp = tripTemp;
+	gov->critTemp = critTemp;
+	gov->hystTemp = hystTemp;
+	if (NULL == tempHandler) {
+		gov->cap = gov->numOpps - 1U;
+	}
+}
+
+/****************************************************************************/
+/**
+ * @brief  Idle hook, to be called before the processor waits for interrupt
+ *
+ * @param  gov  Pointer to the governor
+ *
+ * @return None
+ *
+ * @note   None
+ *
+ ****************************************************************************/
+void XPm_DvfsIdleEnter(XPm_Dvfs *const gov)
+{
+	gov->idleStart = gov->timeHandler();
+	gov->idle = 1U;
+}
+
+/****************************************************************************/
+/**
+ * @brief  Idle hook, to be called when the processor leaves the idle loop
+ *
+ * @param  gov  Pointer to the governor
+ *
+ * @return None
+ *
+ * @note   None
+ *
+ ****************************************************************************/
+void XPm_DvfsIdleExit(XPm_Dvfs *const gov)
+{
+	XPm_DvfsAccountIdle(gov, gov->timeHandler());
+	gov->idle = 0U;
+}
+
+/****************************************************************************/
+/**
+ * @brief  Measure the load and temperature and change the operating point
+ *
+ * @param  gov  Pointer to the governor
+ *
+ * @return XST_SUCCESS or the status of the transition as returned by the
+ * PMU-FW
+ *
+ * @note   To be called periodically, e.g. every 10 to 100 ms, from the
+ * context of the idle hooks or with them masked
+ *
+ ****************************************************************************/
+XStatus XPm_DvfsUpdate(XPm_Dvfs *const gov)
+{
+	XStatus status = XST_SUCCESS;
+	u64 now = gov->timeHandler();
+	u64 elapsed;
+	u32 need;
+	u32 target;
+
+	/* Load of the window */
+	XPm_DvfsAccountIdle(gov, now);
+	elapsed = now - gov->windowStart;
+	if (0U != elapsed) {
+		if (gov->idleTicks >= elapsed) {
+			gov->load = 0U;
+		} else {
+			gov->load = (u32)(((elapsed - gov->idleTicks) * 100U) /
+					  elapsed);
+		}
+	}
+	gov->windowStart = now;
+	gov->idleTicks = 0U;
+
+	/* Thermal limit */
+	if (NULL != gov->tempHandler) {
+		gov->temp = gov->tempHandler(gov->callBackRef);
+		if (gov->temp >= gov->critTemp) {
+			gov->cap = 0U;
+			gov->throttles++;
+		} else if (gov->temp >= gov->tripTemp) {
+			if (gov->cap > 0U) {
+				gov->cap--;
+			}
+			gov->throttles++;
+		} else if ((gov->temp < (gov->tripTemp - gov->hystTemp)) &&
+			   (gov->cap < (gov->numOpps - 1U))) {
+			gov->cap++;
+		} else {
+			/* Within the hysteresis, keep the limit */
+		}
+	}
+
+	/* Load policy */
+	if (gov->load >= gov->upLoad) {
+		target = gov->cap;
+	} else if (gov->load < gov->downLoad) {
+		need = (gov->opps[gov->cur].freqKhz / gov->upLoad) * gov->load;
+		for (target = 0U; target < gov->cur; target++) {
+			if (gov->opps[target].freqKhz >= need) {
+				break;
+			}
+		}
+	} else {
+		target = gov->cur;
+	}
+
+	if (target > gov->cap) {
+		target = gov->cap;
+	}
+
+	if (target != gov->cur) {
+		status = XPm_DvfsSetOpp(gov, target);
+	}
+
+	return status;
+}
+
+/****************************************************************************/
+/**
+ * @brief  Change the operating point of a governor
+ *
+ * When the PLL rate changes, the divider is raised before the PLL relocks or
+ * lowered after it, so that the clock never runs faster than the faster of
+ * the current and the new operating point.
+ *
+ * @param  gov    Pointer to the governor
+ * @param  index  Index of the operating point
+ *
+ * @return XST_SUCCESS, XST_INVALID_PARAM or the status of the operation as
+ * returned by the PMU-FW
+ *
+ * @note   The thermal limit is not applied
+ *
+ ****************************************************************************/
+XStatus XPm_DvfsSetOpp(XPm_Dvfs *const gov, const u32 index)
+{
+	XStatus status = XST_INVALID_PARAM;
+	const XPm_DvfsOpp *opp;
+
+	if ((NULL == gov) || (index >= gov->numOpps)) {
+		goto done;
+	}
+
+	opp = &gov->opps[index];
+	status = XST_SUCCESS;
+
+	if ((0U == opp->fbdiv) || (opp->fbdiv == gov->fbdiv)) {
+		if (opp->divider != gov->divider) {
+			status = XPm_ClockSetDivider(gov->clock, opp->divider);
+		}
+		goto update;
+	}
+
+	if (opp->divider > gov->divider) {
+		status = XPm_ClockSetDivider(gov->clock, opp->divider);
+		if (XST_SUCCESS != status) {
+			goto done;
+		}
+		gov->divider = opp->divider;
+	}
+
+	status = XPm_PllSetParameter(gov->pll, PM_PLL_PARAM_ID_FBDIV,
+				     opp->fbdiv);
+	if (XST_SUCCESS != status) {
+		goto done;
+	}
+	/* Setting the mode relocks the PLL with the new feedback divider */
+	status = XPm_PllSetMode(gov->pll, PM_PLL_MODE_INTEGER);
+	if (XST_SUCCESS != status) {
+		goto done;
+	}
+	gov->fbdiv = opp->fbdiv;
+	gov->relocks++;
+
+	if (opp->divider != gov->divider) {
+		status = XPm_ClockSetDivider(gov->clock, opp->divider);
+	}
+
+update:
+	if (XST_SUCCESS == status) {
+		gov->divider = opp->divider;
+		gov->cur = index;
+		gov->transitions++;
+	}
+
+done:
+	return status;
+}
+ /** @} */
@@ -0,0 +1,145 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+ * @file pm_dvfs.h
+ *
+ * Frequency governor for the APU and RPU clocks.
+ *
+ * A governor scales one processor clock through a table of operating points,
+ * each given as the feedback divider of the source PLL and the divider of the
+ * clock. The operating point is chosen by XPm_DvfsUpdate(), called
+ * periodically, from:
+ * - the load of the processor, measured by the idle hooks
+ *   XPm_DvfsIdleEnter() and XPm_DvfsIdleExit() of its idle loop. When the
+ *   load exceeds the up limit the governor goes to the fastest operating
+ *   point allowed; below the down limit it goes to the slowest operating
+ *   point which keeps the load under the up limit.
+ * - the temperature returned by the application, e.g. read from the
+ *   sysmonpsu driver. Above the trip temperature the fastest operating point
+ *   allowed is lowered by one step per update, and raised again once the
+ *   temperature is back under the trip temperature minus the hysteresis.
+ *   Above the critical temperature the slowest operating point is used.
+ *
+ * Operating points sharing the PLL rate of the current one only need a
+ * divider change. When the PLL must relock, the divider is raised before the
+ * relock or lowered after it, so that the clock never exceeds the faster of
+ * the two operating points and only one divider write is issued.
+ *
+ * The PLL runs in integer mode and must not clock other devices whose rate
+ * may not change.
+ *****************************************************************************/
+
+#ifndef PM_DVFS_H_
+#define PM_DVFS_H_
+
+#include <xil_types.h>
+#include <xstatus.h>
+#include "pm_defs.h"
+#include "pm_api_sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define XPM_DVFS_MAX_OPPS	8U	/**< Operating points of a governor */
+
+/**
+ * XPm_DvfsOpp - Operating point, tables are sorted by increasing frequency
+ */
+typedef struct XPm_DvOpp {
+	u32 freqKhz;	/**< Clock frequency, used by the load policy */
+	u32 fbdiv;	/**< PLL feedback divider, 0 to keep the PLL as is */
+	u32 divider;	/**< Clock divider */
+} XPm_DvfsOpp;
+
+/**
+ * Returns a free running time stamp
+ */
+typedef u64 (*XPm_DvfsTimeHandler)(void);
+
+/**
+ * Returns the temperature in millidegrees Celsius
+ */
+typedef s32 (*XPm_DvfsTempHandler)(void *callBackRef);
+
+/**
+ * XPm_Dvfs - Governor of one processor clock
+ */
+typedef struct XPm_Dvfs {
+	enum XPmClock clock;		/**< Processor clock */
+	enum XPmNodeId pll;		/**< Source PLL of the clock */
+	XPm_DvfsOpp opps[XPM_DVFS_MAX_OPPS];	/**< Operating points */
+	u32 numOpps;			/**< Entries in opps */
+	u32 cur;			/**< Current operating point */
+	u32 cap;			/**< Fastest operating point allowed */
+	u32 fbdiv;			/**< Current PLL feedback divider */
+	u32 divider;			/**< Current clock divider */
+	u32 upLoad;			/**< Load percentage to speed up */
+	u32 downLoad;			/**< Load percentage to slow down */
+	u32 load;			/**< Load percentage of last window */
+	XPm_DvfsTimeHandler timeHandler;
+	u64 windowStart;		/**< Start of the load window */
+	u64 idleStart;			/**< Start of the idle period */
+	u64 idleTicks;			/**< Idle time in the window */
+	volatile u32 idle;		/**< The processor is idle */
+	XPm_DvfsTempHandler tempHandler;
+	void *callBackRef;		/**< Passed to tempHandler */
+	s32 tripTemp;			/**< Throttling temperature */
+	s32 critTemp;			/**< Critical temperature */
+	s32 hystTemp;			/**< Hysteresis of tripTemp */
+	s32 temp;			/**< Last temperature read */
+	u32 transitions;		/**< Operating point changes */
+	u32 relocks;			/**< Changes which relocked the PLL */
+	u32 throttles;			/**< Updates above tripTemp */
+} XPm_Dvfs;
+
+XStatus XPm_DvfsInit(XPm_Dvfs *const gov, const enum XPmClock clock,
+		     const enum XPmNodeId pll, const XPm_DvfsOpp *const opps,
+		     const u32 numOpps, const XPm_DvfsTimeHandler timeHandler);
+
+void XPm_DvfsSetLoadLimits(XPm_Dvfs *const gov, const u32 upLoad,
+			   const u32 downLoad);
+
+void XPm_DvfsSetThermal(XPm_Dvfs *const gov,
+			const XPm_DvfsTempHandler tempHandler,
+			void *const callBackRef, const s32 tripTemp,
+			const s32 critTemp, const s32 hystTemp);
+
+void XPm_DvfsIdleEnter(XPm_Dvfs *const gov);
+
+void XPm_DvfsIdleExit(XPm_Dvfs *const gov);
+
+XStatus XPm_DvfsUpdate(XPm_Dvfs *const gov);
+
+XStatus XPm_DvfsSetOpp(XPm_Dvfs *const gov, const u32 index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PM_DVFS_H_ */
@@ -36,6 +36,8 @@
  * Ver   Who   Date        Changes
  * ----- ---  ----------   -----------------------------------------------------
  * 1.0	 ka   01/08/2019   Initial realease of Puf_regeneration example
+ * 1.1	 adk  10/15/2019   Print the regeneration time and regenerate once more
+ *			   with XPuf_Puf_RegenerateOnce
  *
  * @note
  *
@@ -98,6 +100,20 @@ int main()
 
 	Status = XPuf_Puf_Regeneration(&PufData);
 
+	if (Status != XST_SUCCESS) {
+		xPuf_printf(XPUF_DEBUG_INFO,
+			"Puf Regeneration example failed with error : %x\r\n",
+			 Status);
+		goto END;
+	}
+	xPuf_printf(XPUF_DEBUG_INFO, "Puf Regeneration took %d us\r\n",
+		XPuf_GetRegenerationTime());
+
+	/* Same helper data, the key loaded above is reused */
+	Status = XPuf_Puf_RegenerateOnce(&PufData);
+	if ((Status == XST_SUCCESS) && (XPuf_IsKeyLoaded() != TRUE)) {
+		Status = XST_FAILURE;
+	}
 	if (Status != XST_SUCCESS) {
 		xPuf_printf(XPUF_DEBUG_INFO,
 			"Puf Regeneration example failed with error : %x\r\n",
@@ -37,6 +37,11 @@
 * ----- ---- ---------- -------------------------------------------------------
 * 1.0   kal  08/01/2019 Initial release
 *		har	 09/24/2019 Fixed MISRA-C violations
+* 1.1   adk  10/15/2019 Regenerate once per boot: the helper data and PUF ID
+*                       of the last regeneration are kept, so a later
+*                       request with the same helper data reuses the PUF key
+*                       still loaded in the AES engine. The time taken by
+*                       the last regeneration is recorded.
 * </pre>
 *
 * @note
@@ -49,6 +54,7 @@
 #include "xpuf.h"
 #include "xpuf_hw.h"
 #include "xil_util.h"
+#include <string.h>
 
 /************************** Constant Definitions ****************************/
 
@@ -102,9 +108,29 @@ typedef enum {
 	XPUF_REGISTRATION_COMPLETE
 } XPuf_PufRegistrationState;
 
+/*
+ * Last successful regeneration, the PUF key it produced stays in the AES
+ * engine until the PUF is used again or the key is cleared
+ */
+typedef struct {
+	u32 Valid;
+	u32 RegMode;
+	u32 ShutterValue;
+	u32 Chash;
+	u32 Aux;
+	u32 SyndromeAddr;
+	u32 PufID[XPUF_ID_LENGTH];
+} XPuf_RegenState;
+
+/************************** Variable Definitions *****************************/
+
+static XPuf_RegenState PufRegenState;
+static u32 PufRegenTimeUs;
+
 /************************** Function Prototypes ******************************/
 
 static void XPuf_Capture_PufID(XPuf_Data *PufData);
+static u32 XPuf_IsRegenStateMatch(const XPuf_Data *PufData);
 
 /************************** Function Definitions *****************************/
 
@@ -144,6 +170,9 @@ u32 XPuf_Puf_Registration(XPuf_Data *PufData)
 		goto END;
 	}
 
+	/* Registration replaces the PUF key of any earlier regeneration */
+	XPuf_InvalidateKey();
+
 	/* Update PUF_CFG0 register */
 	XPuf_WriteReg(XPUF_PMC_GLOBAL_BASEADDR,
 			XPUF_PMC_GLOBAL_PUF_CFG0_OFFSET,
@@ -242,6 +271,7 @@ u32 XPuf_Puf_Regeneration(XPuf_Data *PufData)
 	u32 PufAux;
 	u32 PufStatus;
 	u32 Debug = XPUF_DEBUG_GENERAL;
+	u32 WaitUs = 0U;
 
 	/* Validate input arguments */
         if (PufData == NULL) {
@@ -275,6 +305,9 @@ u32 XPuf_Puf_Regeneration(XPuf_Data *PufData)
 		goto END;
 	}
 
+	/* The PUF key is replaced from here */
+	XPuf_InvalidateKey();
+
 	/* Update PUF_CFG0 register */
 	XPuf_WriteReg(XPUF_PMC_GLOBAL_BASEADDR,
 			XPUF_PMC_GLOBAL_PUF_CFG0_OFFSET,
@@ -318,7 +351,16 @@ u32 XPuf_Puf_Regeneration(XPuf_Data *PufData)
 			XPUF_PMC_GLOBAL_PUF_CMD_OFFSET,
 			XPUF_CMD_REGENERATION);
 
-	Status  = XPuf_WaitForPufDoneStatus();
+	/*
+	 * Regeneration takes milliseconds, poll tightly for a while and then
+	 * with sleeps in between, timing the wait
+	 */
+	Status = Xil_WaitForEventTimed((XPUF_PMC_GLOBAL_BASEADDR +
+				XPUF_PMC_GLOBAL_PUF_STATUS_OFFSET),
+				XPUF_STATUS_PUF_DONE, XPUF_STATUS_PUF_DONE,
+				XPUF_REGEN_SPIN_COUNT, XPUF_REGEN_TIMEOUT_US,
+				&WaitUs);
+	PufRegenTimeUs = WaitUs;
 
 	if (Status != XST_SUCCESS) {
 		xPuf_printf(Debug,
@@ -333,13 +375,161 @@ u32 XPuf_Puf_Regeneration(XPuf_Data *PufData)
 		((PufStatus & XPUF_STATUS_ID_RDY) == XPUF_STATUS_ID_RDY)) {
 
 		XPuf_Capture_PufID(PufData);
+
+		PufRegenState.RegMode = PufData->RegMode;
+		PufRegenState.ShutterValue = PufData->ShutterValue;
+		PufRegenState.Chash = PufChash;
+		PufRegenState.Aux = PufAux;
+		PufRegenState.SyndromeAddr = PufData->SyndromeAddr;
+		(void)memcpy(PufRegenState.PufID, PufData->PufID,
+				sizeof(PufRegenState.PufID));
+		PufRegenState.Valid = TRUE;
+		Status = XST_SUCCESS;
+	}
+
+END:
+	return Status;
+}
+
+/******************************************************************************/
+/**
+ * @brief
+ * This function regenerates the PUF key once per boot. When the last
+ * regeneration used the same helper data and its key is still loaded in the
+ * AES engine, the PUF ID of that regeneration is returned and the PUF is not
+ * run again. Otherwise it is XPuf_Puf_Regeneration.
+ *
+ * @param   	PufData - Pointer to PufData structure, as for
+ *			XPuf_Puf_Regeneration
+ *
+ * @return  	XST_SUCCESS - PUF key loaded and PUF ID avaiable in
+ *				PUF Data variable
+ *		Errors of XPuf_Puf_Regeneration
+ *
+ * @note	Call XPuf_InvalidateKey after clearing the PUF key of the AES
+ *		engine.
+ *
+ ******************************************************************************/
+u32 XPuf_Puf_RegenerateOnce(XPuf_Data *PufData)
+{
+	u32 Status = XST_FAILURE;
+
+	/* Validate input arguments */
+	if (PufData == NULL) {
+		Status = XPUF_ERROR_INVALID_PARAM;
+		goto END;
+	}
+
+	if ((XPuf_IsKeyLoaded() == TRUE) &&
+		(XPuf_IsRegenStateMatch(PufData) == TRUE)) {
+		(void)memcpy(PufData->PufID, PufRegenState.PufID,
+				sizeof(PufData->PufID));
 		Status = XST_SUCCESS;
+		goto END;
 	}
 
+	Status = XPuf_Puf_Regeneration(PufData);
+
 END:
 	return Status;
 }
 
+/******************************************************************************/
+/**
+ * @brief
+ * This function tells if a PUF key regenerated by this library is loaded,
+ * without touching the PUF.
+ *
+ * @param   	None.
+ *
+ * @return  	TRUE - Key of the last regeneration is ready for use
+ *		FALSE - No regeneration done, or the key is gone
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+u32 XPuf_IsKeyLoaded(void)
+{
+	u32 Status = FALSE;
+	u32 PufStatus;
+
+	if (PufRegenState.Valid == TRUE) {
+		PufStatus = XPuf_ReadReg(XPUF_PMC_GLOBAL_BASEADDR,
+				XPUF_PMC_GLOBAL_PUF_STATUS_OFFSET);
+		if ((PufStatus & XPUF_STATUS_KEY_RDY) == XPUF_STATUS_KEY_RDY) {
+			Status = TRUE;
+		}
+	}
+
+	return Status;
+}
+
+/******************************************************************************/
+/**
+ * @brief
+ * This function forgets the last regeneration, so the next
+ * XPuf_Puf_RegenerateOnce runs the PUF again.
+ *
+ * @param   	None.
+ *
+ * @return  	None.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+void XPuf_InvalidateKey(void)
+{
+	PufRegenState.Valid = FALSE;
+}
+
+/******************************************************************************/
+/**
+ * @brief
+ * This function returns the time the last regeneration waited for the PUF.
+ *
+ * @param   	None.
+ *
+ * @return  	Time in microseconds, 0 if no regeneration was done.
+ *
+ * @note	Without a time base, as on PMC, only the time slept between
+ *		polls is counted and the first XPUF_REGEN_SPIN_COUNT polls are
+ *		left out.
+ *
+ ******************************************************************************/
+u32 XPuf_GetRegenerationTime(void)
+{
+	return PufRegenTimeUs;
+}
+
+/******************************************************************************/
+/**
+ * @brief
+ * This function checks if PufData has the helper data of the last
+ * regeneration.
+ *
+ * @param   	PufData - Pointer to PufData structure
+ *
+ * @return  	TRUE if it matches, FALSE otherwise
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static u32 XPuf_IsRegenStateMatch(const XPuf_Data *PufData)
+{
+	u32 Status = FALSE;
+
+	if ((PufData->ReadOption == XPUF_READ_FROM_RAM) &&
+		(PufData->RegMode == PufRegenState.RegMode) &&
+		(PufData->ShutterValue == PufRegenState.ShutterValue) &&
+		(PufData->Chash == PufRegenState.Chash) &&
+		(PufData->Aux == PufRegenState.Aux) &&
+		(PufData->SyndromeAddr == PufRegenState.SyndromeAddr)) {
+		Status = TRUE;
+	}
+
+	return Status;
+}
+
 /******************************************************************************/
 /**
  * @brief
@@ -39,6 +39,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- ---------- -------------------------------------------------------
 * 1.0   kal  08/01/2019 Initial release
+* 1.1   adk  10/15/2019 Added XPuf_Puf_RegenerateOnce, XPuf_IsKeyLoaded and
+*                       XPuf_GetRegenerationTime
 *
 * </pre>
 *
@@ -94,6 +96,10 @@ extern "C" {
 #define XPUF_SYNDROME_MODE_4K				(0x0U)
 #define XPUF_SYNDROME_MODE_12K				(0x1U)
 
+/* Polls of PUF done before sleeping between polls, and regeneration timeout */
+#define XPUF_REGEN_SPIN_COUNT				(1000U)
+#define XPUF_REGEN_TIMEOUT_US				(100000U)
+
 
 /* XilPuf API's error codes */
 #define XPUF_ERROR_TAG					(0x8200)
@@ -131,6 +137,10 @@ typedef struct {
 
 u32 XPuf_Puf_Registration(XPuf_Data *PufData);
 u32 XPuf_Puf_Regeneration(XPuf_Data *PufData);
+u32 XPuf_Puf_RegenerateOnce(XPuf_Data *PufData);
+u32 XPuf_IsKeyLoaded(void);
+void XPuf_InvalidateKey(void);
+u32 XPuf_GetRegenerationTime(void);
 
 #ifdef __cplusplus
 }
@@ -39,6 +39,8 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   hk   27/01/14 First release
 * 1.4   vns  07/06/17 Added dooxygen tags.
+* 1.6   adk  10/15/19 Added rsa2048_key and the Montgomery based public key
+*                     interfaces of xilrsa_mont.c.
 *
 * </pre>
 *
@@ -131,6 +133,17 @@ typedef struct
 	unsigned long long bytes;
 } sha2_context;
 //! [sha2_context]
+
+/*
+ * Prepared RSA-2048 public key, see rsa2048_key_init()
+ */
+typedef struct
+{
+	RSA_DIGIT mod[RSA_NDIGITS];	/* modulus m */
+	RSA_DIGIT mod_rr[RSA_NDIGITS];	/* R^2 mod m, R = 2^RSA_NBITS */
+	RSA_DIGIT mod_inv;		/* -m^-1 mod 2^32 */
+	unsigned int valid;
+} rsa2048_key;
 /** @}
 @endcond */
 
@@ -172,6 +185,18 @@ void rsa2048_exp(const unsigned char *base, const unsigned char * modular,
 void rsa2048_pubexp(RSA_NUMBER a, RSA_NUMBER x,
 		unsigned long e, RSA_NUMBER m, RSA_NUMBER rrm);
 
+/*
+ * RSA-2048 public key interfaces built on Montgomery multiplication, see
+ * xilrsa_mont.c. rsa2048_pubexp_fast() takes the arguments of
+ * rsa2048_pubexp() and remembers the last keys used; rrm may be NULL.
+ */
+int rsa2048_key_init(rsa2048_key *key, const RSA_DIGIT *m,
+		const RSA_DIGIT *rrm);
+void rsa2048_key_pubexp(const rsa2048_key *key, RSA_NUMBER a,
+		const RSA_DIGIT *x, unsigned long e);
+void rsa2048_pubexp_fast(RSA_NUMBER a, RSA_NUMBER x,
+		unsigned long e, RSA_NUMBER m, RSA_NUMBER rrm);
+
 /*
  * SHA-256 user interfaces
  */
@@ -0,0 +1,342 @@
+/******************************************************************************
+*
+* Copyright (C) 2019 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xilrsa_mont.c
+* @addtogroup xilrsa_apis	XilRSA APIs and Descriptions
+* @{
+* @cond xilrsa_internal
+* This file contains the RSA-2048 public key operation built on Montgomery
+* multiplication. It is plain C using only digit x digit -> double digit
+* products, so it builds for any 32-bit processor.
+*
+* Numbers use the layout of the rest of the library: RSA_NDIGITS digits,
+* least significant digit first. With R = 2^RSA_NBITS, a key is described by
+* its modulus N, R^2 mod N (the modulus extension) and -N^-1 mod 2^32. These
+* are kept in an rsa2048_key, so that verifying several signatures with one
+* key does the per key work only once.
+*
+* Public exponents are small and not secret, so the code is not constant
+* time. It must not be used with a private exponent.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.6   adk  10/15/19 First release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "xilrsa.h"
+
+/************************** Constant Definitions *****************************/
+
+#define RSA_DIGIT_BITS		(sizeof(RSA_DIGIT) * 8U)
+
+/* Exponent with a dedicated path, the one of nearly all public keys */
+#define RSA_PUBEXP_F4		65537UL
+
+/* Keys remembered by rsa2048_pubexp_fast(), FSBL alternates PPK and SPK */
+#define RSA_KEY_CACHE_SIZE	2U
+
+/************************** Variable Definitions *****************************/
+
+static rsa2048_key rsa_key_cache[RSA_KEY_CACHE_SIZE];
+static unsigned int rsa_key_cache_next;
+
+/*****************************************************************************/
+/**
+ * Compares two numbers.
+ *
+ * @return	1 if a >= b, 0 otherwise
+ *
+ ******************************************************************************/
+static int rsa_ge(const RSA_DIGIT *a, const RSA_DIGIT *b)
+{
+	int i;
+
+	for (i = (int)RSA_NDIGITS - 1; i >= 0; i--) {
+		if (a[i] != b[i]) {
+			return (a[i] > b[i]) ? 1 : 0;
+		}
+	}
+
+	return 1;
+}
+
+/*****************************************************************************/
+/**
+ * Computes r = r - m, dropping the borrow.
+ *
+ ******************************************************************************/
+static void rsa_sub(RSA_DIGIT *r, const RSA_DIGIT *m)
+{
+	RSA_DDIGIT t;
+	RSA_DIGIT borrow = 0U;
+	unsigned int i;
+
+	for (i = 0U; i < RSA_NDIGITS; i++) {
+		t = (RSA_DDIGIT)r[i] - m[i] - borrow;
+		r[i] = (RSA_DIGIT)RSA_LSB(t);
+		borrow = (RSA_DIGIT)(RSA_MSB(t) & 1U);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Computes r = 2 * r mod m, for r < m.
+ *
+ ******************************************************************************/
+static void rsa_dbl_mod(RSA_DIGIT *r, const RSA_DIGIT *m)
+{
+	RSA_DIGIT carry = 0U;
+	RSA_DIGIT top;
+	unsigned int i;
+
+	for (i = 0U; i < RSA_NDIGITS; i++) {
+		top = r[i] >> (RSA_DIGIT_BITS - 1U);
+		r[i] = (r[i] << 1U) | carry;
+		carry = top;
+	}
+
+	if ((carry != 0U) || (rsa_ge(r, m) != 0)) {
+		rsa_sub(r, m);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Montgomery multiplication, r = a * b / R mod m, with the coarsely
+ * integrated operand scanning method: each digit of b is multiplied in and
+ * one digit is reduced away, so the intermediate stays RSA_NDIGITS + 2
+ * digits long. Needs a * b < m * R, r may alias a or b.
+ *
+ * @param	r	Result
+ * @param	a	First operand
+ * @param	b	Second operand
+ * @param	key	Key providing m and -m^-1 mod 2^32
+ *
+ ******************************************************************************/
+static void rsa_mont_mul(RSA_DIGIT *r, const RSA_DIGIT *a, const RSA_DIGIT *b,
+		const rsa2048_key *key)
+{
+	RSA_DIGIT t[RSA_NDIGITS + 2U];
+	const RSA_DIGIT *m = key->mod;
+	RSA_DDIGIT c;
+	RSA_DIGIT q, bi;
+	unsigned int i, j;
+
+	(void)memset(t, 0, sizeof(t));
+
+	for (i = 0U; i < RSA_NDIGITS; i++) {
+		/* t += a * b[i] */
+		bi = b[i];
+		c = 0U;
+		for (j = 0U; j < RSA_NDIGITS; j++) {
+			c = (RSA_DDIGIT)a[j] * bi + t[j] + RSA_MSB(c);
+			t[j] = (RSA_DIGIT)RSA_LSB(c);
+		}
+		c = (RSA_DDIGIT)t[RSA_NDIGITS] + RSA_MSB(c);
+		t[RSA_NDIGITS] = (RSA_DIGIT)RSA_LSB(c);
+		t[RSA_NDIGITS + 1U] = (RSA_DIGIT)RSA_MSB(c);
+
+		/* t = (t + q * m) / 2^32, q chosen to clear the low digit */
+		q = t[0] * key->mod_inv;
+		c = (RSA_DDIGIT)q * m[0] + t[0];
+		for (j = 1U; j < RSA_NDIGITS; j++) {
+			c = (RSA_DDIGIT)q * m[j] + t[j] + RSA_MSB(c);
+			t[j - 1U] = (RSA_DIGIT)RSA_LSB(c);
+		}
+		c = (RSA_DDIGIT)t[RSA_NDIGITS] + RSA_MSB(c);
+		t[RSA_NDIGITS - 1U] = (RSA_DIGIT)RSA_LSB(c);
+		t[RSA_NDIGITS] = t[RSA_NDIGITS + 1U] + (RSA_DIGIT)RSA_MSB(c);
+	}
+
+	/* t < 2m here, one subtraction at most */
+	if ((t[RSA_NDIGITS] != 0U) || (rsa_ge(t, m) != 0)) {
+		rsa_sub(t, m);
+	}
+	(void)memcpy(r, t, RSA_NBYTES);
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function prepares a public key for rsa2048_key_pubexp(). It computes
+ * -m^-1 mod 2^32 and takes R^2 mod m from rrm, or computes it when rrm is
+ * NULL.
+ *
+ * @param	key	Key context to fill
+ * @param	m	RSA_NUMBER containing the public key modulus
+ * @param	rrm	RSA_NUMBER containing the public key modulus extension,
+ *		or NULL
+ *
+ * @return	0 on success, -1 if the modulus is even
+ *
+ ******************************************************************************/
+int rsa2048_key_init(rsa2048_key *key, const RSA_DIGIT *m,
+		const RSA_DIGIT *rrm)
+{
+	RSA_DIGIT inv;
+	unsigned int i;
+
+	if ((m[0] & 1U) == 0U) {
+		key->valid = 0U;
+		return -1;
+	}
+
+	(void)memcpy(key->mod, m, RSA_NBYTES);
+
+	/* Newton iteration, each step doubles the correct low bits from 3 */
+	inv = m[0];
+	for (i = 0U; i < 4U; i++) {
+		inv *= 2U - (m[0] * inv);
+	}
+	key->mod_inv = (RSA_DIGIT)0U - inv;
+
+	if (rrm != NULL) {
+		(void)memcpy(key->mod_rr, rrm, RSA_NBYTES);
+	} else {
+		/* 1 doubled 2 * RSA_NBITS times is R^2 mod m */
+		(void)memset(key->mod_rr, 0, RSA_NBYTES);
+		key->mod_rr[0] = 1U;
+		for (i = 0U; i < (2U * RSA_NBITS); i++) {
+			rsa_dbl_mod(key->mod_rr, m);
+		}
+	}
+	key->valid = 1U;
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function computes a = x^e mod m for a key prepared with
+ * rsa2048_key_init(). The exponent 65537 takes 16 squarings and one
+ * multiplication, other exponents use left to right square and multiply.
+ *
+ * @param	key	Prepared key
+ * @param	a	RSA_NUMBER receiving the result, may alias x
+ * @param	x	RSA_NUMBER containing the input data, less than m
+ * @param	e	Public key exponent, non zero
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void rsa2048_key_pubexp(const rsa2048_key *key, RSA_NUMBER a,
+		const RSA_DIGIT *x, unsigned long e)
+{
+	RSA_DIGIT xm[RSA_NDIGITS];
+	RSA_DIGIT am[RSA_NDIGITS];
+	RSA_DIGIT one[RSA_NDIGITS];
+	int bit;
+	int i;
+
+	/* To the Montgomery domain, x * R mod m */
+	rsa_mont_mul(xm, x, key->mod_rr, key);
+
+	if (e == RSA_PUBEXP_F4) {
+		(void)memcpy(am, xm, RSA_NBYTES);
+		for (i = 0; i < 16; i++) {
+			rsa_mont_mul(am, am, am, key);
+		}
+		rsa_mont_mul(am, am, xm, key);
+	} else {
+		bit = (int)(sizeof(e) * 8U) - 1;
+		while ((bit > 0) && (((e >> bit) & 1UL) == 0UL)) {
+			bit--;
+		}
+		(void)memcpy(am, xm, RSA_NBYTES);
+		for (bit--; bit >= 0; bit--) {
+			rsa_mont_mul(am, am, am, key);
+			if (((e >> bit) & 1UL) != 0UL) {
+				rsa_mont_mul(am, am, xm, key);
+			}
+		}
+	}
+
+	/* Back from the Montgomery domain, multiplying by 1 divides by R */
+	(void)memset(one, 0, sizeof(one));
+	one[0] = 1U;
+	rsa_mont_mul(a, am, one, key);
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function is a faster rsa2048_pubexp() with the same arguments. The
+ * last keys used are remembered, so a modulus seen before skips the key
+ * preparation, including the computation of R^2 mod m when rrm is NULL.
+ *
+ * @param	a	RSA_NUMBER containing the decrypted data.
+ * @param	x	RSA_NUMBER containing the input data
+ * @param	e	Unsigned number containing the public key exponent
+ * @param	m	RSA_NUMBER containing the public key modulus
+ * @param	rrm	RSA_NUMBER containing the public key modulus extension,
+ *		or NULL
+ *
+ * @return	None
+ *
+ ******************************************************************************/
+void rsa2048_pubexp_fast(RSA_NUMBER a, RSA_NUMBER x,
+		unsigned long e, RSA_NUMBER m, RSA_NUMBER rrm)
+{
+	rsa2048_key *key = NULL;
+	unsigned int i;
+
+	for (i = 0U; i < RSA_KEY_CACHE_SIZE; i++) {
+		if ((rsa_key_cache[i].valid != 0U) &&
+		    (memcmp(rsa_key_cache[i].mod, m, RSA_NBYTES) == 0) &&
+		    ((rrm == NULL) ||
+		     (memcmp(rsa_key_cache[i].mod_rr, rrm, RSA_NBYTES) == 0))) {
+			key = &rsa_key_cache[i];
+			break;
+		}
+	}
+
+	if (key == NULL) {
+		key = &rsa_key_cache[rsa_key_cache_next];
+		rsa_key_cache_next = (rsa_key_cache_next + 1U) %
+				RSA_KEY_CACHE_SIZE;
+		if (rsa2048_key_init(key, m, rrm) != 0) {
+			(void)memset(a, 0, RSA_NBYTES);
+			return;
+		}
+	}
+
+	rsa2048_key_pubexp(key, a, x, e);
+}
+/** @}
+@endcond */
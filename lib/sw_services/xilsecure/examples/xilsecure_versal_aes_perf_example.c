@@ -0,0 +1,447 @@
+/******************************************************************************
+* Copyright (C) 2019 Xilinx, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMANGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*
+*
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file	xilsecure_versal_aes_perf_example.c
+* @addtogroup xsecure_versal_aes_perf_example XilSecure AES Decryption
+* Throughput Example
+* @{
+*
+* @note
+* This example measures the AES-GCM decryption throughput of Versal when the
+* cipher text is fetched in chunks into a staging buffer, as a loader does from
+* a boot device. The fetch is done with a CPU copy here.
+*
+* The data is first encrypted in one go. It is then decrypted twice:
+*  - stop and go: each chunk is fetched, then decrypted with
+*    XSecure_AesDecryptUpdate
+*  - overlapped: each chunk is decrypted with XSecure_AesDecryptUpdateStart
+*    while the next chunk is fetched into the other half of the staging
+*    buffer, then completed with XSecure_AesDecryptUpdateWait
+*
+* Both runs check the GCM tag and the decrypted data, and print the time taken
+* and the throughput.
+*
+* MODIFICATION HISTORY:
+* <pre>
+* Ver   Who    Date     Changes
+* ----- ------ -------- -------------------------------------------------
+* 4.1   mmd    10/14/19 First Release
+*
+* </pre>
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xsecure_aes.h"
+#include "xil_util.h"
+#include "xtime_l.h"
+/************************** Constant Definitions *****************************/
+
+/* Harcoded KUP key for encryption of data */
+#define	XSECURE_AES_KEY	\
+	"F878B838D8589818E868A828C8488808F070B030D0509010E060A020C0408000"
+
+/* Hardcoded IV for encryption of data */
+#define	XSECURE_IV	"D2450E07EA5DE0426C0FA133"
+
+#define XSECURE_DATA_SIZE	(0x100000U)	/* 1MB */
+#define XSECURE_CHUNK_SIZE	(0x10000U)	/* 64KB */
+#define XSECURE_IV_SIZE		(12)
+#define XSECURE_KEY_SIZE	(32)
+
+#define XSECURE_CSUDMA_DEVICEID	XPAR_XCSUDMA_0_DEVICE_ID
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static s32 SecureAesPerfExample(void);
+static s32 SecureAesDecryptChunks(XSecure_Aes *InstancePtr, u8 Overlap);
+static void SecureAesPrintResult(const char *Name, XTime Start, XTime End);
+static u32 Secure_ConvertStringToHexBE(const char * Str, u8 * Buf, u32 Len);
+
+/************************** Variable Definitions *****************************/
+static u8 Iv[XSECURE_IV_SIZE];
+static u8 Key[XSECURE_KEY_SIZE];
+
+#if defined (__GNUC__)
+static u8 Data[XSECURE_DATA_SIZE]__attribute__ ((aligned (64)));
+static u8 DecData[XSECURE_DATA_SIZE]__attribute__ ((aligned (64)));
+static u8 EncData[XSECURE_DATA_SIZE]__attribute__ ((aligned (64)));
+static u8 Staging[2U * XSECURE_CHUNK_SIZE]__attribute__ ((aligned (64)));
+static u8 GcmTag[XSECURE_SECURE_GCM_TAG_SIZE]__attribute__ ((aligned (64)));
+#elif defined (__ICCARM__)
+#pragma data_alignment = 64
+static u8 Data[XSECURE_DATA_SIZE];
+#pragma data_alignment = 64
+static u8 DecData[XSECURE_DATA_SIZE];
+#pragma data_alignment = 64
+static u8 EncData[XSECURE_DATA_SIZE];
+#pragma data_alignment = 64
+static u8 Staging[2U * XSECURE_CHUNK_SIZE];
+#pragma data_alignment = 64
+static u8 GcmTag[XSECURE_SECURE_GCM_TAG_SIZE];
+#endif
+
+/************************** Function Definitions ******************************/
+int main(void)
+{
+	int Status = XST_FAILURE;
+	u32 Index;
+
+	Xil_DCacheDisable();
+
+	/* Covert strings to buffers */
+	Status = Secure_ConvertStringToHexBE(
+			(const char *) (XSECURE_AES_KEY),
+				Key, XSECURE_KEY_SIZE * 2);
+	if (Status != XST_SUCCESS) {
+		xil_printf(
+			"String Conversion error (KEY):%08x !!!\r\n", Status);
+		goto END;
+	}
+
+	Status = Secure_ConvertStringToHexBE(
+			(const char *) (XSECURE_IV),
+				Iv, XSECURE_IV_SIZE * 2);
+	if (Status != XST_SUCCESS) {
+		xil_printf(
+			"String Conversion error (IV):%08x !!!\r\n", Status);
+		goto END;
+	}
+
+	/* Data to be encrypted */
+	for (Index = 0U; Index < XSECURE_DATA_SIZE; Index++) {
+		Data[Index] = (u8)(Index ^ (Index >> 8U));
+	}
+
+	Status = SecureAesPerfExample();
+	if(Status == XST_SUCCESS) {
+		xil_printf("\r\nSuccessfully ran AES throughput example\r\n");
+	}
+	else {
+		xil_printf("\r\n AES throughput example was failed\r\n");
+	}
+
+END:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* This function encrypts the data with provided AES key and IV, then decrypts
+* it in chunks without and with overlap of the chunk fetch and the decryption,
+* and prints the throughput of both.
+*
+* @param	None
+*
+* @return
+*		- XST_FAILURE if the Aes example was failed.
+*		- XST_SUCCESS if the Aes example was successful
+*
+* @note		None.
+*
+****************************************************************************/
+/** //! [AES throughput example] */
+static s32 SecureAesPerfExample(void)
+{
+	XCsuDma_Config *Config;
+	s32 Status = XST_FAILURE;
+	XCsuDma CsuDmaInstance;
+	XSecure_Aes Secure_Aes;
+	XTime Start;
+	XTime End;
+
+	/* Initialize CSU DMA driver */
+	Config = XCsuDma_LookupConfig(XSECURE_CSUDMA_DEVICEID);
+	if (NULL == Config) {
+		return XST_FAILURE;
+	}
+
+	Status = XCsuDma_CfgInitialize(&CsuDmaInstance, Config,
+					Config->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+
+	/* Initialize the Aes driver so that it's ready to use */
+	XSecure_AesInitialize(&Secure_Aes, &CsuDmaInstance);
+
+	/* Take core out of reset */
+	XSecure_ReleaseReset(Secure_Aes.BaseAddress,
+				XSECURE_AES_SOFT_RST_OFFSET);
+
+	/* Write AES key */
+	Status = XSecure_AesWriteKey(&Secure_Aes, XSECURE_AES_USER_KEY_0,
+				XSECURE_AES_KEY_SIZE_256, (u64)Key);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Failure at key write\n\r");
+		goto END;
+	}
+
+	/* Encryption of Data */
+	Status = XSecure_AesEncryptInit(&Secure_Aes, XSECURE_AES_USER_KEY_0,
+					XSECURE_AES_KEY_SIZE_256, (u64)Iv);
+	if (Status != XST_SUCCESS) {
+		xil_printf(" Aes encrypt init is failed\n\r");
+		goto END;
+	}
+
+	Status = XSecure_AesEncryptData(&Secure_Aes, (u64)Data, (u64)EncData,
+					XSECURE_DATA_SIZE, (u64)GcmTag);
+	if (Status != XST_SUCCESS) {
+		xil_printf(" Aes encrypt data is failed\n\r");
+		goto END;
+	}
+
+	xil_printf("Decrypting %d bytes in chunks of %d bytes\n\r",
+			XSECURE_DATA_SIZE, XSECURE_CHUNK_SIZE);
+
+	XTime_GetTime(&Start);
+	Status = SecureAesDecryptChunks(&Secure_Aes, FALSE);
+	XTime_GetTime(&End);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+	SecureAesPrintResult("Stop and go", Start, End);
+
+	XTime_GetTime(&Start);
+	Status = SecureAesDecryptChunks(&Secure_Aes, TRUE);
+	XTime_GetTime(&End);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+	SecureAesPrintResult("Overlapped ", Start, End);
+
+END:
+	/* Set AES engine into reset */
+	XSecure_SetReset(Secure_Aes.BaseAddress,
+				XSECURE_AES_SOFT_RST_OFFSET);
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* This function decrypts EncData into DecData chunk by chunk. Each chunk is
+* first fetched into the staging buffer, which has two halves.
+*
+* @param	InstancePtr	Pointer to the XSecure_Aes instance.
+* @param	Overlap		TRUE to fetch the next chunk while the current
+*		one is decrypted, FALSE to fetch and decrypt one after the other.
+*
+* @return
+*		- XST_SUCCESS if the GCM tag and the data match
+*		- XST_FAILURE otherwise
+*
+****************************************************************************/
+static s32 SecureAesDecryptChunks(XSecure_Aes *InstancePtr, u8 Overlap)
+{
+	s32 Status = XST_FAILURE;
+	u32 Offset = 0U;
+	u32 Index;
+	u8 *CurBuf = Staging;
+	u8 *NextBuf = Staging + XSECURE_CHUNK_SIZE;
+	u8 *TmpBuf;
+	u8 IsLast;
+
+	(void)memset(DecData, 0, XSECURE_DATA_SIZE);
+
+	Status = XSecure_AesDecryptInit(InstancePtr, XSECURE_AES_USER_KEY_0,
+					XSECURE_AES_KEY_SIZE_256, (u64)Iv);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Error in decrypt init ");
+		goto END;
+	}
+
+	/* Fetch the first chunk */
+	(void)memcpy(CurBuf, EncData, XSECURE_CHUNK_SIZE);
+
+	while (Offset < XSECURE_DATA_SIZE) {
+		IsLast = ((Offset + XSECURE_CHUNK_SIZE) == XSECURE_DATA_SIZE) ?
+				TRUE : FALSE;
+
+		if (Overlap == TRUE) {
+			Status = XSecure_AesDecryptUpdateStart(InstancePtr,
+					(u64)(UINTPTR)CurBuf,
+					(u64)(UINTPTR)&DecData[Offset],
+					XSECURE_CHUNK_SIZE, IsLast);
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+			/* Fetch the next chunk while this one is decrypted */
+			if (IsLast != TRUE) {
+				(void)memcpy(NextBuf,
+					&EncData[Offset + XSECURE_CHUNK_SIZE],
+					XSECURE_CHUNK_SIZE);
+			}
+			Status = XSecure_AesDecryptUpdateWait(InstancePtr);
+		}
+		else {
+			Status = XSecure_AesDecryptUpdate(InstancePtr,
+					(u64)(UINTPTR)CurBuf,
+					(u64)(UINTPTR)&DecData[Offset],
+					XSECURE_CHUNK_SIZE, IsLast);
+			if ((Status == XST_SUCCESS) && (IsLast != TRUE)) {
+				(void)memcpy(NextBuf,
+					&EncData[Offset + XSECURE_CHUNK_SIZE],
+					XSECURE_CHUNK_SIZE);
+			}
+		}
+		if (Status != XST_SUCCESS) {
+			xil_printf("Error in decrypt update ");
+			goto END;
+		}
+
+		TmpBuf = CurBuf;
+		CurBuf = NextBuf;
+		NextBuf = TmpBuf;
+		Offset += XSECURE_CHUNK_SIZE;
+	}
+
+	Status = XSecure_AesDecryptFinal(InstancePtr, (u64)GcmTag);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Decryption failure- GCM tag was not matched\n\r");
+		goto END;
+	}
+
+	/* Comparison of Decrypted Data with original data */
+	for(Index = 0; Index < XSECURE_DATA_SIZE; Index++) {
+		if (Data[Index] != DecData[Index]) {
+			xil_printf("Failure during comparison of the data\n\r");
+			Status = XST_FAILURE;
+			goto END;
+		}
+	}
+
+END:
+	return Status;
+}
+/** //! [AES throughput example] */
+/** @} */
+
+/****************************************************************************/
+/**
+ * Prints the time taken to decrypt XSECURE_DATA_SIZE bytes and the
+ * throughput.
+ *
+ * @param	Name of the run
+ * @param	Start is the time at the start of the run
+ * @param	End is the time at the end of the run
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void SecureAesPrintResult(const char *Name, XTime Start, XTime End)
+{
+	u64 Us = ((End - Start) * 1000000U) / COUNTS_PER_SECOND;
+	u32 KBps = 0U;
+
+	if (Us != 0U) {
+		KBps = (u32)(((u64)XSECURE_DATA_SIZE * 1000000U) / (Us * 1024U));
+	}
+
+	xil_printf("%s: %d us, %d KB/s\n\r", Name, (u32)Us, KBps);
+}
+
+/****************************************************************************/
+/**
+ * Converts the string into the equivalent Hex buffer.
+ *	Ex: "abc123" -> {Buf[2] = 0x23, Buf[1] = 0xc1, Buf[0] = 0xab}
+ *
+ * @param	Str is a Input String. Will support the lower and upper
+ *		case values. Value should be between 0-9, a-f and A-F
+ *
+ * @param	Buf is Output buffer.
+ * @param	Len of the input string. Should have even values
+ *
+ * @return
+ *		- XST_SUCCESS no errors occured.
+ *		- ERROR when input parameters are not valid
+ *		- an error when input buffer has invalid values
+ *
+ * @note	None.
+ *
+ *****************************************************************************/
+static u32 Secure_ConvertStringToHexBE(const char * Str, u8 * Buf, u32 Len)
+{
+	u32 ConvertedLen = 0;
+	u8 LowerNibble, UpperNibble;
+	u32 Status = XST_FAILURE;
+
+	/* Check the parameters */
+	if (Str == NULL){
+		Status = XST_FAILURE;
+		goto END;
+	}
+
+	if (Buf == NULL){
+		Status = XST_FAILURE;
+		goto END;
+	}
+
+	/* Len has to be multiple of 2 */
+	if ((Len == 0) || (Len % 2 == 1)) {
+		Status = XST_FAILURE;
+		goto END;
+	}
+
+	ConvertedLen = 0;
+	while (ConvertedLen < Len) {
+		/* Convert char to nibble */
+		if (Xil_ConvertCharToNibble(Str[ConvertedLen],
+				&UpperNibble) ==XST_SUCCESS) {
+			/* Convert char to nibble */
+			if (Xil_ConvertCharToNibble(
+					Str[ConvertedLen + 1],
+					&LowerNibble) == XST_SUCCESS) {
+				/* Merge upper and lower nibble to Hex */
+				Buf[ConvertedLen / 2] =
+					(UpperNibble << 4) | LowerNibble;
+			} else {
+				/* Error converting Lower nibble */
+				Status = XST_FAILURE;
+				goto END;
+			}
+		} else {
+			/* Error converting Upper nibble */
+			Status = XST_FAILURE;
+			goto END;
+		}
+		ConvertedLen += 2;
+	}
+
+	Status = XST_SUCCESS;
+END:
+
+	return Status;
+}
@@ -58,6 +58,9 @@
 * 4.1   kal  05/20/19 Updated doxygen tags
 *       psl  07/02/19 Fixed Coverity warnings.
 *       mmd  07/05/19 Optimized the code
+*       mmd  10/14/19 Added XSecure_Sha3UpdateList to hash a scatter list
+*                     and XSecure_Sha3UpdateStart/Poll/Wait to overlap an
+*                     update with the preparation of the next data
 *       psl  07/31/19 Fixed MISRA-C violation
 *
 * </pre>
@@ -128,6 +131,7 @@ s32 XSecure_Sha3Initialize(XSecure_Sha3 *InstancePtr, XCsuDma* CsuDmaPtr)
 	InstancePtr->CsuDmaPtr = CsuDmaPtr;
 	InstancePtr->Sha3PadType = XSECURE_CSU_NIST_SHA3;
 	InstancePtr->IsLastUpdate = FALSE;
+	InstancePtr->DmaPending = FALSE;
 
 	XSecure_SssInitialize(&(InstancePtr->SssInstance));
 
@@ -267,6 +271,7 @@ void XSecure_Sha3Start(XSecure_Sha3 *InstancePtr)
 
 	InstancePtr->Sha3Len = 0U;
 	InstancePtr->PartialLen = 0U;
+	InstancePtr->DmaPending = FALSE;
 	(void)memset(InstancePtr->PartialData, 0, XSECURE_SHA3_BLOCK_LEN);
 
 	/* Reset SHA3 engine. */
@@ -305,6 +310,12 @@ u32 XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
 	Xil_AssertNonvoid(Size > (u32)0x00U);
 	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
 
+	/* Complete the update started by XSecure_Sha3UpdateStart, if any */
+	Status = XSecure_Sha3UpdateWait(InstancePtr);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
 	InstancePtr->Sha3Len += Size;
 	DataSize = Size;
 	TransferredBytes = 0U;
@@ -361,6 +372,12 @@ u32 XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash)
 	Xil_AssertNonvoid(Hash != NULL);
 	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
 
+	/* Complete the update started by XSecure_Sha3UpdateStart, if any */
+	Status = XSecure_Sha3UpdateWait(InstancePtr);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
 	PartialLen = InstancePtr->Sha3Len % XSECURE_SHA3_BLOCK_LEN;
 
 	PartialLen = (PartialLen == 0U)?(XSECURE_SHA3_BLOCK_LEN) :
@@ -423,6 +440,199 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * @brief
+ * This function updates the SHA3 engine with a scatter list of buffers, as
+ * if they were one contiguous buffer. Buffers of any size and alignment can
+ * be mixed, the bytes that do not fill a word are combined with the start
+ * of the next buffer.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Sha3 instance.
+ * @param	List		Pointer to the buffers, in the order to hash.
+ * @param	Count		Number of buffers in the list.
+ *
+ * @return	XST_SUCCESS if the update is successful
+ * 		XST_FAILURE if there is a failure in SSS config or DMA
+ *
+ * @note	Buffers of size 0 are skipped. When XSecure_Sha3LastUpdate was
+ *		called, the last buffer of the list is the last update.
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3UpdateList(XSecure_Sha3 *InstancePtr,
+			const XSecure_Sha3Buf *List, const u32 Count)
+{
+	u32 Index;
+	u32 IsLastUpdate;
+	u32 Status = (u32)XST_SUCCESS;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((List != NULL) || (Count == 0U));
+	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
+
+	/* Only the last buffer can end the data */
+	IsLastUpdate = InstancePtr->IsLastUpdate;
+	InstancePtr->IsLastUpdate = FALSE;
+	for (Index = 0U; Index < Count; Index++) {
+		if (List[Index].Size == 0U) {
+			continue;
+		}
+		if (Index == (Count - 1U)) {
+			InstancePtr->IsLastUpdate = IsLastUpdate;
+		}
+		Status = XSecure_Sha3Update(InstancePtr, List[Index].Data,
+				List[Index].Size);
+		if (Status != (u32)XST_SUCCESS) {
+			break;
+		}
+	}
+	InstancePtr->IsLastUpdate = IsLastUpdate;
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function starts an update of the SHA3 engine and returns without
+ * waiting for the CSU DMA, so that the caller can prepare the next data while
+ * the engine runs. The update is completed with XSecure_Sha3UpdatePoll or
+ * XSecure_Sha3UpdateWait, or by the next XSecure_Sha3Update or
+ * XSecure_Sha3Finish.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ * @param	Data 		Pointer to the input data for hashing.
+ * @param	Size 		Size of the input data in bytes.
+ *
+ * @return	XST_SUCCESS if the update is started or done
+ * 		XST_FAILURE if there is a failure in SSS config or DMA
+ *
+ * @note	Only word aligned data, at a word aligned address, following
+ *		word aligned updates, can be started without waiting. Other
+ *		data is hashed with XSecure_Sha3Update before returning.
+ *		The data and the CSU DMA must not be used before the update
+ *		is completed.
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3UpdateStart(XSecure_Sha3 *InstancePtr, const u8 *Data,
+						const u32 Size)
+{
+	u32 Status = (u32)XST_FAILURE;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Size > (u32)0x00U);
+	Xil_AssertNonvoid(InstancePtr->Sha3State == XSECURE_SHA3_ENGINE_STARTED);
+
+	if (((Size % 4U) != 0U) || (InstancePtr->PartialLen != 0U) ||
+		(((UINTPTR)Data & XCSUDMA_ADDR_LSB_MASK) != 0U) ||
+		(Size > XSECURE_CSU_DMA_MAX_TRANSFER)) {
+		Status = XSecure_Sha3Update(InstancePtr, Data, Size);
+		goto END;
+	}
+
+	Status = XSecure_Sha3UpdateWait(InstancePtr);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
+	/* Configure the SSS for SHA3 hashing. */
+	Status = XSecure_SssSha(&(InstancePtr->SssInstance),
+				InstancePtr->CsuDmaPtr->Config.DeviceId);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
+	InstancePtr->Sha3Len += Size;
+	XCsuDma_Transfer(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+			(UINTPTR)Data, Size/4U, (u8)InstancePtr->IsLastUpdate);
+	InstancePtr->DmaPending = TRUE;
+
+END:
+	if (Status != (u32)XST_SUCCESS) {
+		/* Set SHA under reset on failure condition */
+		XSecure_SetReset(InstancePtr->BaseAddress,
+					XSECURE_CSU_SHA3_RESET_OFFSET);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function checks if the update started by XSecure_Sha3UpdateStart is
+ * done, without waiting.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	XST_SUCCESS if no update is in progress
+ * 		XST_DEVICE_BUSY if the update is in progress
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3UpdatePoll(XSecure_Sha3 *InstancePtr)
+{
+	u32 Status = (u32)XST_SUCCESS;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	if (InstancePtr->DmaPending == FALSE) {
+		goto END;
+	}
+
+	if ((XCsuDma_IntrGetStatus(InstancePtr->CsuDmaPtr,
+			XCSUDMA_SRC_CHANNEL) & XCSUDMA_IXR_DONE_MASK) == 0U) {
+		Status = (u32)XST_DEVICE_BUSY;
+		goto END;
+	}
+
+	/* Acknowledge the transfer has completed */
+	XCsuDma_IntrClear(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+				XCSUDMA_IXR_DONE_MASK);
+	InstancePtr->DmaPending = FALSE;
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function waits for the update started by XSecure_Sha3UpdateStart.
+ *
+ * @param	InstancePtr 	Pointer to the XSecure_Sha3 instance.
+ *
+ * @return	XST_SUCCESS if no update is in progress anymore
+ * 		XST_FAILURE if the CSU DMA timed out
+ *
+ ******************************************************************************/
+u32 XSecure_Sha3UpdateWait(XSecure_Sha3 *InstancePtr)
+{
+	u32 Status = (u32)XST_SUCCESS;
+
+	/* Asserts validate the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	if (InstancePtr->DmaPending == FALSE) {
+		goto END;
+	}
+
+	InstancePtr->DmaPending = FALSE;
+	Status = XCsuDma_WaitForDoneTimeout(InstancePtr->CsuDmaPtr,
+						XCSUDMA_SRC_CHANNEL);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
+	/* Acknowledge the transfer has completed */
+	XCsuDma_IntrClear(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+				XCSUDMA_IXR_DONE_MASK);
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * @brief
@@ -65,6 +65,7 @@
                       as void to u32.
 *       psl  03/26/19 Fixed MISRA-C violation
 * 4.1   mmd  07/05/19 Optimized the code
+*       mmd  10/14/19 Added scatter list and non-blocking updates
 *
 * </pre>
 *
@@ -137,7 +138,16 @@ typedef struct {
 	u8 PartialData[XSECURE_SHA3_BLOCK_LEN];
 	XSecure_Sss SssInstance;
 	XSecure_Sha3State Sha3State;
+	u32 DmaPending; /**< Update started by XSecure_Sha3UpdateStart */
 } XSecure_Sha3;
+
+/**
+ * Buffer of a scatter list, see XSecure_Sha3UpdateList
+ */
+typedef struct {
+	const u8 *Data; /**< Pointer to the data */
+	u32 Size; /**< Size of the data in bytes */
+} XSecure_Sha3Buf;
 /**
 @}
 @endcond */
@@ -170,6 +180,12 @@ void XSecure_Sha3Start(XSecure_Sha3 *InstancePtr);
 u32 XSecure_Sha3Update(XSecure_Sha3 *InstancePtr, const u8 *Data,
 						const u32 Size);
 u32 XSecure_Sha3Finish(XSecure_Sha3 *InstancePtr, u8 *Hash);
+u32 XSecure_Sha3UpdateList(XSecure_Sha3 *InstancePtr,
+			const XSecure_Sha3Buf *List, const u32 Count);
+u32 XSecure_Sha3UpdateStart(XSecure_Sha3 *InstancePtr, const u8 *Data,
+						const u32 Size);
+u32 XSecure_Sha3UpdatePoll(XSecure_Sha3 *InstancePtr);
+u32 XSecure_Sha3UpdateWait(XSecure_Sha3 *InstancePtr);
 
 /* Complete SHA digest calculation */
 u32 XSecure_Sha3Digest(XSecure_Sha3 *InstancePtr, const u8 *In,
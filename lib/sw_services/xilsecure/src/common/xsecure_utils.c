@@ -40,6 +40,7 @@
 *       psl     03/26/19 Fixed MISRA-C violation
 *       psl     04/05/19 Fixed IAR warnings.
 * 4.1   psl     07/31/19 Fixed MISRA-C violation
+*       vns     10/14/19 Keep the PMC DMA1 path while configuring the SSS
 * </pre>
 *
 ******************************************************************************/
@@ -269,6 +270,19 @@ static u32 XSecure_SssCfg (XSecure_Sss *InstancePtr, XSecure_SssSrc Resource,
 
 	SssCfg = InputSrcCfg | OutputSrcCfg;
 
+#ifdef XSECURE_VERSAL
+	/*
+	 * PLM may be copying the next block of a partition with PMC DMA1
+	 * while this resource runs on PMC DMA0, retain the DMA1 path
+	 */
+	if ((Resource != XSECURE_SSS_DMA1) && (InputSrc != XSECURE_SSS_DMA1) &&
+		(OutputSrc != XSECURE_SSS_DMA1)) {
+		SssCfg |= XSecure_In32(InstancePtr->Address) &
+			(XSECURE_SSS_CFG_MASK <<
+			(XSECURE_SSS_CFG_LEN_IN_BITS * (u32)XSECURE_SSS_DMA1));
+	}
+#endif
+
 	XSecure_Out32(InstancePtr->Address, SssCfg);
 
 	return XST_SUCCESS;
@@ -73,6 +73,7 @@ extern "C" {
 					/**< To take the core out of reset */
 
 #define XSECURE_SSS_CFG_LEN_IN_BITS	(4U) /**< Length is bits */
+#define XSECURE_SSS_CFG_MASK		(0xFU) /**< Mask of one source */
 
 #ifdef XSECURE_VERSAL
 #define XSECURE_SSS_ADDRESS		(0xF1110500U) /**< SSS base address */
@@ -38,6 +38,7 @@
 * 4.1   vns  08/06/2019 Added AES encryption APIs
 *       har  08/21/2019 Fixed MISRA C violations
 *       vns  08/23/2019 Initialized status variables
+*       mmd  10/14/2019 Added non-blocking decrypt update APIs
 * </pre>
 *
 * @note
@@ -327,6 +328,8 @@ u32 XSecure_AesInitialize(XSecure_Aes *InstancePtr, XCsuDma *CsuDmaPtr)
 	InstancePtr->BaseAddress = XSECURE_AES_BASEADDR;
 	InstancePtr->CsuDmaPtr = CsuDmaPtr;
 	InstancePtr->AesState = XSECURE_AES_INITIALIZED;
+	InstancePtr->DmaPending = FALSE;
+	InstancePtr->DstDmaEnabled = FALSE;
 
 	XSecure_SssInitialize(&(InstancePtr->SssInstance));
 
@@ -646,12 +649,53 @@ u32 XSecure_AesDecryptUpdate(XSecure_Aes *InstancePtr, u64 InDataAddr,
 {
 	u32 Status = (u32)XST_FAILURE;
 
+	Status = XSecure_AesDecryptUpdateStart(InstancePtr, InDataAddr,
+			OutDataAddr, Size, EnLast);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = XSecure_AesDecryptUpdateWait(InstancePtr);
+
+END:
+	return Status;
+
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function starts the decryption of the provided data and returns
+ * without waiting for it. The CSU DMA destination channel is started before
+ * the source channel, so plain text is written out while cipher text is still
+ * being read. The caller can do other work, for example fetch the next block
+ * of cipher text with another DMA, and must then call
+ * XSecure_AesDecryptUpdateWait before any other AES call.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ * @param	InDataAddr	Address of the encrypted data which needs to be
+ *		decrypted.
+ * @param	OutDataAddr	Address of output buffer where the decrypted
+ *		to be updated.
+ * @param	Size		Size of data to be decrypted in bytes.
+ * @param	EnLast		If this is the last update of data to be
+ *		decrypted, this parameter should be set to TRUE otherwise FALSE.
+ *
+ * @return	XST_SUCCESS if the decryption is started.
+ *
+ ******************************************************************************/
+u32 XSecure_AesDecryptUpdateStart(XSecure_Aes *InstancePtr, u64 InDataAddr,
+		u64 OutDataAddr, u32 Size, u8 EnLast)
+{
+	u32 Status = (u32)XST_FAILURE;
+
 	/* Assert validates the input arguments */
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid((Size % XSECURE_WORD_SIZE) == 0x00U);
 	Xil_AssertNonvoid((EnLast == TRUE) || (EnLast == FALSE));
 	Xil_AssertNonvoid(InstancePtr->AesState ==
 			XSECURE_AES_DECRYPT_INITIALIZED);
+	Xil_AssertNonvoid(InstancePtr->DmaPending == FALSE);
 
 	/* Enable CSU DMA Src and Dst channels for byte swapping.*/
 	XSecure_AesCsuDmaConfigureEndiannes(InstancePtr->CsuDmaPtr,
@@ -660,6 +704,10 @@ u32 XSecure_AesDecryptUpdate(XSecure_Aes *InstancePtr, u64 InDataAddr,
 	if ((u32)OutDataAddr != XSECURE_AES_NO_CFG_DST_DMA) {
 		XSecure_AesCsuDmaConfigureEndiannes(InstancePtr->CsuDmaPtr,
 				XCSUDMA_DST_CHANNEL, 1U);
+		InstancePtr->DstDmaEnabled = TRUE;
+	}
+	else {
+		InstancePtr->DstDmaEnabled = FALSE;
 	}
 
 	/* Configure the SSS for AES. */
@@ -672,7 +720,7 @@ u32 XSecure_AesDecryptUpdate(XSecure_Aes *InstancePtr, u64 InDataAddr,
 			XSECURE_SSS_DMA1, XSECURE_SSS_DMA1);
 	}
 	/* Configure destination */
-	if ((u32)OutDataAddr != XSECURE_AES_NO_CFG_DST_DMA) {
+	if (InstancePtr->DstDmaEnabled == TRUE) {
 		XCsuDma_64BitTransfer(InstancePtr->CsuDmaPtr,
 				XCSUDMA_DST_CHANNEL,
 				OutDataAddr, OutDataAddr >> 32,
@@ -684,6 +732,79 @@ u32 XSecure_AesDecryptUpdate(XSecure_Aes *InstancePtr, u64 InDataAddr,
 				InDataAddr, InDataAddr >> 32,
 				Size/XSECURE_WORD_SIZE, EnLast);
 
+	InstancePtr->DmaPending = TRUE;
+	Status = (u32)XST_SUCCESS;
+
+	return Status;
+
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function checks if the decryption started with
+ * XSecure_AesDecryptUpdateStart is done.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ *
+ * @return	- XST_SUCCESS if no decryption is running
+ *		- XST_DEVICE_BUSY if the CSU DMA is still moving the data
+ *
+ * @note	XSecure_AesDecryptUpdateWait must still be called to complete
+ *		the update.
+ *
+ ******************************************************************************/
+u32 XSecure_AesDecryptUpdatePoll(XSecure_Aes *InstancePtr)
+{
+	u32 Status = (u32)XST_SUCCESS;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	if (InstancePtr->DmaPending != TRUE) {
+		goto END;
+	}
+
+	if ((XCsuDma_IntrGetStatus(InstancePtr->CsuDmaPtr,
+		XCSUDMA_SRC_CHANNEL) & XCSUDMA_IXR_DONE_MASK) == 0U) {
+		Status = (u32)XST_DEVICE_BUSY;
+		goto END;
+	}
+
+	if ((InstancePtr->DstDmaEnabled == TRUE) &&
+		((XCsuDma_IntrGetStatus(InstancePtr->CsuDmaPtr,
+		XCSUDMA_DST_CHANNEL) & XCSUDMA_IXR_DONE_MASK) == 0U)) {
+		Status = (u32)XST_DEVICE_BUSY;
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function waits for the decryption started with
+ * XSecure_AesDecryptUpdateStart to complete. It returns at once if no
+ * decryption was started.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Aes instance.
+ *
+ * @return	XST_SUCCESS on successful decryption of the data.
+ *
+ ******************************************************************************/
+u32 XSecure_AesDecryptUpdateWait(XSecure_Aes *InstancePtr)
+{
+	u32 Status = (u32)XST_FAILURE;
+
+	/* Assert validates the input arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	if (InstancePtr->DmaPending != TRUE) {
+		Status = (u32)XST_SUCCESS;
+		goto END;
+	}
+
 	/* Wait for the SRC DMA completion. */
 	XCsuDma_WaitForDone(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL);
 
@@ -691,7 +812,7 @@ u32 XSecure_AesDecryptUpdate(XSecure_Aes *InstancePtr, u64 InDataAddr,
 	XCsuDma_IntrClear(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
 					XCSUDMA_IXR_DONE_MASK);
 
-	if ((u32)OutDataAddr != XSECURE_AES_NO_CFG_DST_DMA) {
+	if (InstancePtr->DstDmaEnabled == TRUE) {
 		/* Wait for the DST DMA completion. */
 		XCsuDma_WaitForDone(InstancePtr->CsuDmaPtr, XCSUDMA_DST_CHANNEL);
 
@@ -705,8 +826,11 @@ u32 XSecure_AesDecryptUpdate(XSecure_Aes *InstancePtr, u64 InDataAddr,
 				XCSUDMA_SRC_CHANNEL, 0U);
 	XSecure_AesCsuDmaConfigureEndiannes(InstancePtr->CsuDmaPtr,
 					XCSUDMA_DST_CHANNEL, 0U);
+
+	InstancePtr->DmaPending = FALSE;
 	Status = (u32)XST_SUCCESS;
 
+END:
 	return Status;
 
 }
@@ -736,6 +860,12 @@ u32 XSecure_AesDecryptFinal(XSecure_Aes *InstancePtr, u64 GcmTagAddr)
 	Xil_AssertNonvoid(InstancePtr->AesState ==
 			XSECURE_AES_DECRYPT_INITIALIZED);
 
+	/* Complete an update that was started without waiting */
+	Status = XSecure_AesDecryptUpdateWait(InstancePtr);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
 	XSecure_WriteReg(InstancePtr->BaseAddress,
 			XSECURE_AES_DATA_SWAP_OFFSET, 0x1U);
 
@@ -36,6 +36,7 @@
 * ----- ---- ---------- -------------------------------------------------------
 * 4.0   vns  04/24/2019 Initial release
 * 4.1   vns  08/06/2019 Added AES encryption APIs
+*       mmd  10/14/2019 Added non-blocking decrypt update APIs
 *
 * </pre>
 *
@@ -163,6 +164,8 @@ typedef struct {
 	XSecure_Sss SssInstance;
 	XSecure_AesState AesState; /**< Current Aes State  */
 	XSecure_AesKeySrc KeySrc;
+	u8 DmaPending; /**< Decrypt update started and not waited for */
+	u8 DstDmaEnabled; /**< Decrypt update writes to a destination */
 } XSecure_Aes;
 
 typedef enum {
@@ -193,6 +196,14 @@ u32 XSecure_AesDecryptInit(XSecure_Aes *InstancePtr, XSecure_AesKeySrc KeySrc,
 
 u32 XSecure_AesDecryptUpdate(XSecure_Aes *InstancePtr, u64 InDataAddr,
 			u64 OutDataAddr, u32 Size, u8 EnLast);
+
+u32 XSecure_AesDecryptUpdateStart(XSecure_Aes *InstancePtr, u64 InDataAddr,
+			u64 OutDataAddr, u32 Size, u8 EnLast);
+
+u32 XSecure_AesDecryptUpdatePoll(XSecure_Aes *InstancePtr);
+
+u32 XSecure_AesDecryptUpdateWait(XSecure_Aes *InstancePtr);
+
 u32 XSecure_AesDecryptFinal(XSecure_Aes *InstancePtr, u64 GcmTagAddr);
 
 u32 XSecure_AesDecryptData(XSecure_Aes *InstancePtr, u64 InDataAddr,
@@ -64,6 +64,7 @@
 *       psl 07/02/19 Fixed Coverity warning.
 *       mmd 07/05/19 Optimized the code
 *       psl 07/31/19 Fixed MISRA-C violation
+*       mmd 10/14/19 Overlapped device copy and decryption of chunks
 *
 * </pre>
 *
@@ -730,7 +731,9 @@ void XSecure_AesSetChunking(XSecure_Aes *InstancePtr, u8 Chunking)
  * @param	InstancePtr	Pointer to the XSecure_Aes instance.
  * @param	ReadBuffer	Buffer where the data will be written
  *		after copying.
- * @param	ChunkSize	Length of the buffer in bytes.
+ * @param	ChunkSize	Length of the buffer in bytes. The buffer is
+ *		used as two halves, so that a chunk is copied while the
+ *		previous one is decrypted.
  * @param	DeviceCopy 	Function pointer to copy data from FLASH
  *		to buffer.
  *		Arguments are:
@@ -886,6 +889,11 @@ u32 XSecure_AesKeySelNLoad(XSecure_Aes *InstancePtr)
  * This is a helper function to decrypt chunked bitstream block and route to
  * PCAP.
  *
+ * The read buffer is used as two halves. While the CSU DMA pushes the chunk
+ * in one half through the AES engine to PCAP, the next chunk is copied from
+ * the device into the other half, so the device copy and the decryption
+ * overlap instead of alternating.
+ *
  * @param	InstancePtr 	Pointer to the XSecure_Aes instance.
  * @param	Src 	Pointer to the encrypted bitstream block start.
  * @param	Len 	Length of bitstream data block in bytes.
@@ -900,35 +908,47 @@ static s32 XSecure_AesChunkDecrypt(XSecure_Aes *InstancePtr, const u8 *Src,
 	/* Assert validates the input arguments */
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(Len != 0U);
-	Xil_AssertNonvoid((InstancePtr->ChunkSize) != 0U);
+	Xil_AssertNonvoid((InstancePtr->ChunkSize) >= 8U);
 
 	s32 Status = XST_FAILURE;
-
-	u32 NumChunks = Len / (InstancePtr->ChunkSize);
-	u32 RemainingBytes = Len % (InstancePtr->ChunkSize);
-	u32 Index;
+	s32 CopyStatus;
+	u32 HalfSize = ((InstancePtr->ChunkSize) / 2U) & ~3U;
+	u32 RemainingBytes = Len;
 	u32 StartAddrByte = (u32)(INTPTR)Src;
+	u32 CurSize;
+	u32 NextSize;
+	u8 *CurBuf = InstancePtr->ReadBuffer;
+	u8 *NextBuf = InstancePtr->ReadBuffer + HalfSize;
+	u8 *TmpBuf;
 
 	/*
 	 * Start the chunking process, copy encrypted chunks into OCM and push
 	 * decrypted data to PCAP
 	 */
+	CurSize = (RemainingBytes < HalfSize) ? RemainingBytes : HalfSize;
+	Status = (s32)InstancePtr->DeviceCopy(StartAddrByte,
+				(UINTPTR)CurBuf, CurSize);
+	if (XST_SUCCESS != Status)
+	{
+		Status = (s32)XSECURE_CSU_AES_DEVICE_COPY_ERROR;
+		goto END;
+	}
 
-	for(Index = 0U; Index < NumChunks; Index++)
+	while (RemainingBytes != 0U)
 	{
-		Status = (s32)InstancePtr->DeviceCopy(StartAddrByte,
-					(UINTPTR)(InstancePtr->ReadBuffer),
-					InstancePtr->ChunkSize);
+		XCsuDma_Transfer(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
+					(UINTPTR)CurBuf, CurSize/4U, 0);
 
-		if (XST_SUCCESS != Status)
-		{
-			Status = (s32)XSECURE_CSU_AES_DEVICE_COPY_ERROR;
-			goto END;
-		}
+		StartAddrByte += CurSize;
+		RemainingBytes -= CurSize;
 
-		XCsuDma_Transfer(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
-					(UINTPTR)(InstancePtr->ReadBuffer),
-					(InstancePtr->ChunkSize)/4U, 0);
+		/* Copy the next chunk while this one is decrypted */
+		NextSize = (RemainingBytes < HalfSize) ? RemainingBytes : HalfSize;
+		CopyStatus = XST_SUCCESS;
+		if (NextSize != 0U) {
+			CopyStatus = (s32)InstancePtr->DeviceCopy(StartAddrByte,
+					(UINTPTR)NextBuf, NextSize);
+		}
 
 		/*
 		 * wait for the SRC_DMA to complete
@@ -945,37 +965,18 @@ static s32 XSecure_AesChunkDecrypt(XSecure_Aes *InstancePtr, const u8 *Src,
 
 		XSecure_PcapWaitForDone();
 
-		StartAddrByte += InstancePtr->ChunkSize;
-	}
-
-	if((RemainingBytes != 0U))
-	{
-		Status = (s32)InstancePtr->DeviceCopy(StartAddrByte,
-				(UINTPTR)(InstancePtr->ReadBuffer), RemainingBytes);
-
-		if (XST_SUCCESS != Status)
+		if (XST_SUCCESS != CopyStatus)
 		{
 			Status = (s32)XSECURE_CSU_AES_DEVICE_COPY_ERROR;
 			goto END;
 		}
 
-		XCsuDma_Transfer(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
-			(UINTPTR)(InstancePtr->ReadBuffer), RemainingBytes/4U, 0);
-
-		/* wait for the SRC_DMA to complete and the pcap to be IDLE */
-		Status = (s32)XCsuDma_WaitForDoneTimeout(InstancePtr->CsuDmaPtr,
-							XCSUDMA_SRC_CHANNEL);
-		if (XST_SUCCESS != Status) {
-			goto END;
-		}
-
-		/* Acknowledge the transfers have completed */
-		XCsuDma_IntrClear(InstancePtr->CsuDmaPtr, XCSUDMA_SRC_CHANNEL,
-							XCSUDMA_IXR_DONE_MASK);
-		XSecure_PcapWaitForDone();
-
-		StartAddrByte += RemainingBytes;
+		TmpBuf = CurBuf;
+		CurBuf = NextBuf;
+		NextBuf = TmpBuf;
+		CurSize = NextSize;
 	}
+
 END:
 	return Status;
 }
@@ -42,6 +42,12 @@
 *       mmd  03/15/19 Refactored the code
 *       psl  03/26/19 Fixed MISRA-C violation
 * 4.1   psl  08/05/19 Fixed MISRA-C violation
+*       mmd  10/14/19 Split XSecure_RsaOperation into XSecure_RsaOperationStart
+*                     and XSecure_RsaOperationWait
+*       adk  10/15/19 Added XSecure_RsaKeyLoad, XSecure_RsaKeyUnload and
+*                     XSecure_RsaIsKeyLoaded. A public key loaded with
+*                     XSecure_RsaKeyLoad stays in the RSA core, following
+*                     operations load only the input and R*R mod M.
 * </pre>
 *
 * @note
@@ -62,12 +68,17 @@
 static void XSecure_RsaPutData(XSecure_Rsa *InstancePtr);
 static void XSecure_RsaGetData(XSecure_Rsa *InstancePtr, u32 *RdData);
 static void XSecure_RsaZeroize(XSecure_Rsa *InstancePtr);
+static void XSecure_RsaZeroizeRam(XSecure_Rsa *InstancePtr, u32 FirstRam);
+static u32 XSecure_RsaSizeCheck(u32 Size);
 static void XSecure_RsaWriteMem(XSecure_Rsa *InstancePtr, u32* WrData,
 							u8 RamOffset);
 static void XSecure_RsaMod32Inverse(XSecure_Rsa *InstancePtr);
 
 /************************** Variable Definitions *****************************/
 
+/* Instance whose key is held in the RSA core, NULL if none */
+static XSecure_Rsa *XSecure_RsaKeyOwner = NULL;
+
 /************************** Function Definitions *****************************/
 
 /*****************************************************************************/
@@ -85,6 +96,11 @@ u32 XSecure_RsaCfgInitialize(XSecure_Rsa *InstancePtr)
 	u32 Status = (u32)XST_FAILURE;
 
 	InstancePtr->BaseAddress = XSECURE_CSU_RSA_BASE;
+
+	/* A new key is coming, the loaded one is no more valid */
+	if (XSecure_RsaKeyOwner == InstancePtr) {
+		XSecure_RsaKeyUnload(InstancePtr);
+	}
 	Status = (u32)XST_SUCCESS;
 
 	return Status;
@@ -108,41 +124,84 @@ u32 XSecure_RsaOperation(XSecure_Rsa *InstancePtr, u8 *Input,
 			u8 *Result, u8 EncDecFlag, u32 Size)
 {
 	u32 Status = (u32)XST_FAILURE;
-	s32 ErrorCode = XST_FAILURE;
+
+	Xil_AssertNonvoid(Result != NULL);
+
+	Status = XSecure_RsaOperationStart(InstancePtr, Input, EncDecFlag,
+					Size);
+	if (Status != (u32)XST_SUCCESS) {
+		goto END;
+	}
+
+	Status = XSecure_RsaOperationWait(InstancePtr, Result);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+* This function loads the key and the input in the RSA core and starts the
+* RSA operation. It returns without waiting for the operation to complete,
+* so the caller can use the other CSU engines, such as SHA3, while RSA is
+* running. The result is read with XSecure_RsaOperationWait.
+*
+* @param	InstancePtr	Pointer to the XSecure_Rsa instance.
+* @param	Input		Pointer to the buffer which contains the input
+*		data to be decrypted.
+* @param	EncDecFlag	XSECURE_RSA_SIGN_ENC or XSECURE_RSA_SIGN_DEC
+* @param	Size		Key size in bytes.
+*
+* @return	XST_SUCCESS if the operation is started.
+*
+* @note		The Input buffer and the key must not be modified until
+*		XSecure_RsaOperationWait returns. On failure the RSA memory is
+*		already cleared and XSecure_RsaOperationWait must not be
+*		called.
+*
+******************************************************************************/
+u32 XSecure_RsaOperationStart(XSecure_Rsa *InstancePtr, u8 *Input,
+			u8 EncDecFlag, u32 Size)
+{
+	s32 ErrorCode = XST_SUCCESS;
 	u32 RsaType = XSECURE_CSU_RSA_CONTROL_4096;
-	u32 TimeOut = 0U;
 
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(Input != NULL);
-	Xil_AssertNonvoid(Result != NULL);
 	Xil_AssertNonvoid((EncDecFlag == XSECURE_RSA_SIGN_ENC) ||
 			(EncDecFlag == XSECURE_RSA_SIGN_DEC));
-	Xil_AssertNonvoid((Size == XSECURE_RSA_512_KEY_SIZE) ||
-			(Size == XSECURE_RSA_576_KEY_SIZE) ||
-			(Size == XSECURE_RSA_704_KEY_SIZE) ||
-			(Size == XSECURE_RSA_768_KEY_SIZE) ||
-			(Size == XSECURE_RSA_992_KEY_SIZE) ||
-			(Size == XSECURE_RSA_1024_KEY_SIZE) ||
-			(Size == XSECURE_RSA_1152_KEY_SIZE) ||
-			(Size == XSECURE_RSA_1408_KEY_SIZE) ||
-			(Size == XSECURE_RSA_1536_KEY_SIZE) ||
-			(Size == XSECURE_RSA_1984_KEY_SIZE) ||
-			(Size == XSECURE_RSA_2048_KEY_SIZE) ||
-			(Size == XSECURE_RSA_3072_KEY_SIZE) ||
-			(Size == XSECURE_RSA_4096_KEY_SIZE));
-
-	InstancePtr->EncDec = EncDecFlag;
-	InstancePtr->SizeInWords = Size/4U;
-	/* Put Modulus, exponent, Mod extension in RSA RAM */
-	XSecure_RsaPutData(InstancePtr);
+	Xil_AssertNonvoid(XSecure_RsaSizeCheck(Size) == (u32)XST_SUCCESS);
+
+	if ((XSecure_RsaKeyOwner == InstancePtr) &&
+		(EncDecFlag == XSECURE_RSA_SIGN_ENC) &&
+		(InstancePtr->SizeInWords == (Size/4U))) {
+		/*
+		 * Modulus, exponent and MINV are still in the RSA core, only
+		 * the Mod extension is loaded again as the result overwrote
+		 * it
+		 */
+		if (InstancePtr->ModExt != NULL) {
+			XSecure_RsaWriteMem(InstancePtr,
+					(u32 *)InstancePtr->ModExt,
+					XSECURE_CSU_RSA_RAM_RES_Y);
+		}
+	}
+	else {
+		XSecure_RsaKeyOwner = NULL;
+		InstancePtr->EncDec = EncDecFlag;
+		InstancePtr->SizeInWords = Size/4U;
+		/* Put Modulus, exponent, Mod extension in RSA RAM */
+		XSecure_RsaPutData(InstancePtr);
+
+		/* Initialize MINV values from Mod. */
+		XSecure_RsaMod32Inverse(InstancePtr);
+	}
 
 	/* Initialize Digest */
 	XSecure_RsaWriteMem(InstancePtr, (u32 *)Input,
 				XSECURE_CSU_RSA_RAM_DIGEST);
 
-	/* Initialize MINV values from Mod. */
-	XSecure_RsaMod32Inverse(InstancePtr);
-
 	switch(InstancePtr->SizeInWords) {
 		case XSECURE_RSA_512_SIZE_WORDS:
 			RsaType = XSECURE_CSU_RSA_CONTROL_512;
@@ -189,6 +248,9 @@ u32 XSecure_RsaOperation(XSecure_Rsa *InstancePtr, u8 *Input,
 	}
 
 	if(ErrorCode == XST_INVALID_PARAM) {
+		/* Zeroize RSA memory space */
+		XSecure_RsaKeyOwner = NULL;
+		XSecure_RsaZeroize(InstancePtr);
 		goto END;
 	}
 
@@ -204,6 +266,34 @@ u32 XSecure_RsaOperation(XSecure_Rsa *InstancePtr, u8 *Input,
 				RsaType + XSECURE_CSU_RSA_CONTROL_EXP);
 	}
 
+END:
+	return (u32)ErrorCode;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+* This function waits for the RSA operation started with
+* XSecure_RsaOperationStart to complete and reads its result.
+*
+* @param	InstancePtr	Pointer to the XSecure_Rsa instance.
+* @param	Result		Pointer to the buffer where resultant decrypted
+*		data to be stored.
+*
+* @return	XST_SUCCESS on success.
+*
+* @note		The RSA memory is cleared in all cases.
+*
+******************************************************************************/
+u32 XSecure_RsaOperationWait(XSecure_Rsa *InstancePtr, u8 *Result)
+{
+	u32 Status = (u32)XST_FAILURE;
+	s32 ErrorCode = XST_FAILURE;
+	u32 TimeOut = 0U;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Result != NULL);
+
 	/* Check and wait for status */
 	do {
 		Status = XSecure_ReadReg(InstancePtr->BaseAddress,
@@ -231,11 +321,132 @@ u32 XSecure_RsaOperation(XSecure_Rsa *InstancePtr, u8 *Input,
 	XSecure_RsaGetData(InstancePtr, (u32 *)Result);
 
 END:
-	/* Zeroize RSA memory space */
-	XSecure_RsaZeroize(InstancePtr);
+	if ((XSecure_RsaKeyOwner == InstancePtr) &&
+		(ErrorCode == XST_SUCCESS)) {
+		/* Keep the loaded key, clear the rest of the RSA memory */
+		XSecure_RsaZeroizeRam(InstancePtr, XSECURE_CSU_RSA_RAM_DIGEST);
+	}
+	else {
+		/* Zeroize RSA memory space */
+		XSecure_RsaKeyOwner = NULL;
+		XSecure_RsaZeroize(InstancePtr);
+	}
 	return (u32)ErrorCode;
 }
 
+/*****************************************************************************/
+/**
+ * @brief
+* This function loads the public key given to XSecure_RsaInitialize in the
+* RSA core and keeps it there, so that several signatures are verified
+* against it without loading the modulus and the exponent each time. Only
+* the following XSecure_RsaOperationStart calls of this instance with
+* XSECURE_RSA_SIGN_ENC and the same key size use the loaded key.
+*
+* @param	InstancePtr	Pointer to the XSecure_Rsa instance.
+* @param	Size		Key size in bytes.
+*
+* @return	XST_SUCCESS on success.
+*
+* @note		The key is released by XSecure_RsaKeyUnload, by
+*		XSecure_RsaInitialize on this instance and by any operation
+*		that does not use it, from this or any other instance. The
+*		Mod extension must stay valid until the key is released.
+*
+******************************************************************************/
+u32 XSecure_RsaKeyLoad(XSecure_Rsa *InstancePtr, u32 Size)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->RsaState == XSECURE_RSA_INITIALIZED);
+	Xil_AssertNonvoid(XSecure_RsaSizeCheck(Size) == (u32)XST_SUCCESS);
+
+	InstancePtr->EncDec = XSECURE_RSA_SIGN_ENC;
+	InstancePtr->SizeInWords = Size/4U;
+
+	/* Modulus and exponent, Mod extension is loaded per operation */
+	XSecure_RsaWriteMem(InstancePtr, (u32 *)InstancePtr->ModExpo,
+					XSECURE_CSU_RSA_RAM_EXPO);
+	XSecure_RsaWriteMem(InstancePtr, (u32 *)InstancePtr->Mod,
+					XSECURE_CSU_RSA_RAM_MOD);
+	XSecure_RsaMod32Inverse(InstancePtr);
+
+	XSecure_RsaKeyOwner = InstancePtr;
+
+	return (u32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+* This function clears the key loaded by XSecure_RsaKeyLoad from the RSA
+* core.
+*
+* @param	InstancePtr	Pointer to the XSecure_Rsa instance.
+*
+* @return	None.
+*
+******************************************************************************/
+void XSecure_RsaKeyUnload(XSecure_Rsa *InstancePtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if (XSecure_RsaKeyOwner == InstancePtr) {
+		XSecure_RsaKeyOwner = NULL;
+		XSecure_RsaZeroize(InstancePtr);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+* This function tells if the key of this instance is loaded in the RSA core.
+*
+* @param	InstancePtr	Pointer to the XSecure_Rsa instance.
+*
+* @return	TRUE if the key is loaded, FALSE otherwise.
+*
+******************************************************************************/
+u32 XSecure_RsaIsKeyLoaded(const XSecure_Rsa *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	return (XSecure_RsaKeyOwner == InstancePtr) ? (u32)TRUE : (u32)FALSE;
+}
+
+/*****************************************************************************/
+/**
+ * @brief
+ * This function checks the key size.
+ *
+ * @param	Size	Key size in bytes.
+ *
+ * @return	XST_SUCCESS if the RSA core supports the size, XST_FAILURE
+ *		otherwise.
+ *
+ ******************************************************************************/
+static u32 XSecure_RsaSizeCheck(u32 Size)
+{
+	u32 Status = (u32)XST_FAILURE;
+
+	if ((Size == XSECURE_RSA_512_KEY_SIZE) ||
+		(Size == XSECURE_RSA_576_KEY_SIZE) ||
+		(Size == XSECURE_RSA_704_KEY_SIZE) ||
+		(Size == XSECURE_RSA_768_KEY_SIZE) ||
+		(Size == XSECURE_RSA_992_KEY_SIZE) ||
+		(Size == XSECURE_RSA_1024_KEY_SIZE) ||
+		(Size == XSECURE_RSA_1152_KEY_SIZE) ||
+		(Size == XSECURE_RSA_1408_KEY_SIZE) ||
+		(Size == XSECURE_RSA_1536_KEY_SIZE) ||
+		(Size == XSECURE_RSA_1984_KEY_SIZE) ||
+		(Size == XSECURE_RSA_2048_KEY_SIZE) ||
+		(Size == XSECURE_RSA_3072_KEY_SIZE) ||
+		(Size == XSECURE_RSA_4096_KEY_SIZE)) {
+		Status = (u32)XST_SUCCESS;
+	}
+
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * @brief
@@ -448,8 +659,24 @@ static void XSecure_RsaWriteMem(XSecure_Rsa *InstancePtr, u32* WrData,
  *****************************************************************************/
 static void XSecure_RsaZeroize(XSecure_Rsa *InstancePtr)
 {
+	XSecure_RsaZeroizeRam(InstancePtr, XSECURE_CSU_RSA_RAM_EXPO);
+}
 
-	u32 RamOffset = 0U;
+/*****************************************************************************/
+/**
+ * @brief
+ * This function clears the RSA memory from the given RAM to the last one.
+ *
+ * @param	InstancePtr	Pointer to the XSecure_Rsa instance.
+ * @param	FirstRam	First RAM to clear, XSECURE_CSU_RSA_RAM_EXPO
+ *		clears all of them.
+ *
+ * @return	None.
+ *
+ *****************************************************************************/
+static void XSecure_RsaZeroizeRam(XSecure_Rsa *InstancePtr, u32 FirstRam)
+{
+	u32 RamOffset = FirstRam;
 	u32 DataOffset;
 
 	XSecure_WriteReg(InstancePtr->BaseAddress,
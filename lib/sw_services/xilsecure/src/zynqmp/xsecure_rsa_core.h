@@ -35,6 +35,10 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 4.0   vns  03/09/19 Initial release
+* 4.1   mmd  10/14/19 Added XSecure_RsaOperationStart and
+*                     XSecure_RsaOperationWait
+*       adk  10/15/19 Added XSecure_RsaKeyLoad, XSecure_RsaKeyUnload and
+*                     XSecure_RsaIsKeyLoaded
 *
 * </pre>
 *
@@ -169,6 +173,16 @@ u32 XSecure_RsaCfgInitialize(XSecure_Rsa *InstancePtr);
 u32 XSecure_RsaOperation(XSecure_Rsa *InstancePtr, u8 *Input,
 		u8 *Result, u8 EncDecFlag, u32 Size);
 
+/* ZynqMP specific RSA core non-blocking operation, started and then waited */
+u32 XSecure_RsaOperationStart(XSecure_Rsa *InstancePtr, u8 *Input,
+		u8 EncDecFlag, u32 Size);
+u32 XSecure_RsaOperationWait(XSecure_Rsa *InstancePtr, u8 *Result);
+
+/* ZynqMP specific RSA public key kept in the core across operations */
+u32 XSecure_RsaKeyLoad(XSecure_Rsa *InstancePtr, u32 Size);
+void XSecure_RsaKeyUnload(XSecure_Rsa *InstancePtr);
+u32 XSecure_RsaIsKeyLoaded(const XSecure_Rsa *InstancePtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -78,6 +78,9 @@
 *       vns   08/29/19 Initialized Status variables
 *       vns   09/17/19 Removed Tbits programming from library as they are to be
 *                      programmed under manufacturing list.
+* 6.8   adk   10/15/19 Rows read from the eFUSE array are kept in a verified
+*                      shadow, reads of shadowed rows skip the controller
+*                      setup until the next program or cache load.
 * </pre>
 *
 *****************************************************************************/
@@ -89,6 +92,10 @@
 
 /************************** Constant Definitions *****************************/
 
+/* Rows of each eFUSE kept in the read shadow */
+#define XSK_ZYNQMP_EFUSEPS_SHADOW_ROWS \
+		(XSK_ZYNQMP_EFUSEPS_PPK1_SHA3_HASH_END_ROW + 1U)
+#define XSK_ZYNQMP_EFUSEPS_SHADOW_NUM		(3U)
 
 /**************************** Type Definitions ******************************/
 
@@ -100,11 +107,23 @@ typedef struct {
 	u8 UserFuse[XSK_ZYNQMP_EFUSEPS_USER_FUSE_ROW_LEN_IN_BITS];
 }XilSKey_UsrFuses;
 
+/*
+ * XilSKey_EfusePsShadow holds the rows of one eFUSE read from the array.
+ * Every row is kept along with its complement, a row whose copies do not
+ * match is read from the eFUSE array again.
+ */
+typedef struct {
+	u32 Data[XSK_ZYNQMP_EFUSEPS_SHADOW_ROWS];
+	u32 InvData[XSK_ZYNQMP_EFUSEPS_SHADOW_ROWS];
+	u64 Valid;
+}XilSKey_EfusePsShadow;
+
 /***************** Macros (Inline Functions) Definitions ********************/
 
 
 /************************** Variable Definitions ****************************/
 static u8 Init_Done;
+static XilSKey_EfusePsShadow EfuseShadow[XSK_ZYNQMP_EFUSEPS_SHADOW_NUM];
 
 /************************** Function Prototypes *****************************/
 
@@ -143,6 +162,11 @@ static u32 XilSKey_ZynqMpEfuseRead(const u32 AddrHigh, const u32 AddrLow);
 static u32 XilSKey_ZynqMpEfuseWrite(const u32 AddrHigh, const u32 AddrLow);
 u32 XilSKey_ZynqMp_EfusePs_ReadPufChash(u32 *Address, u8 ReadOption);
 static u32 XilSkey_ZynqMpUsrFuseRd(u32 Offset, u32 *Buffer, u32 Size, u8 UsrFuseNum);
+static u32 XilSKey_ZynqMp_EfusePs_ShadowRead(u8 Row,
+			XskEfusePs_Type EfuseType, u32 *RowData);
+static u32 XilSKey_ZynqMp_EfusePs_IsShadowed(u8 RowStart, u8 RowEnd,
+			XskEfusePs_Type EfuseType);
+static void XilSKey_ZynqMp_EfusePs_ShadowInvalidate(void);
 
 /************************** Function Definitions *****************************/
 
@@ -963,7 +987,8 @@ END:
 *		XST_SUCCESS - On success
 *		ErrorCode - on Failure
 *
-* @note		None.
+* @note		Outside of programming mode rows are served from the read
+*		shadow when present, and stored in it after a read.
 *
 ******************************************************************************/
 u32 XilSKey_ZynqMp_EfusePs_ReadRow(u8 Row, XskEfusePs_Type EfuseType,
@@ -974,6 +999,8 @@ u32 XilSKey_ZynqMp_EfusePs_ReadRow(u8 Row, XskEfusePs_Type EfuseType,
 	u32 EfusePsType;
 	u32 Status = (u32)XST_FAILURE;
 	u32 TimeOut = 0U;
+	u32 PgmEn;
+	XilSKey_EfusePsShadow *ShadowPtr;
 
 	/* Assert validates the input arguments */
 	Xil_AssertNonvoid(RowData != NULL);
@@ -982,6 +1009,18 @@ u32 XilSKey_ZynqMp_EfusePs_ReadRow(u8 Row, XskEfusePs_Type EfuseType,
 					XSK_ZYNQMP_EFUSEPS_EFUSE_3));
 	Xil_AssertNonvoid(Row <= XSK_ZYNQMP_EFUSEPS_PPK1_SHA3_HASH_END_ROW);
 
+	/* Programming verification always reads the eFUSE array */
+	PgmEn = XilSKey_ReadReg(XSK_ZYNQMP_EFUSEPS_BASEADDR,
+			XSK_ZYNQMP_EFUSEPS_CFG_OFFSET) &
+			XSK_ZYNQMP_EFUSEPS_CFG_PGM_EN_MASK;
+	if (PgmEn == 0U) {
+		Status = XilSKey_ZynqMp_EfusePs_ShadowRead(Row, EfuseType,
+							RowData);
+		if (Status == (u32)XST_SUCCESS) {
+			goto END;
+		}
+	}
+
 	EfusePsType = (u32)EfuseType;
 
 	WriteValue = ((EfusePsType << (u32)XSK_ZYNQMP_EFUSEPS_RD_ADDR_SHIFT) &
@@ -1016,6 +1055,13 @@ u32 XilSKey_ZynqMp_EfusePs_ReadRow(u8 Row, XskEfusePs_Type EfuseType,
 	*RowData =
 		XilSKey_ReadReg(XSK_ZYNQMP_EFUSEPS_BASEADDR,
 				XSK_ZYNQMP_EFUSEPS_RD_DATA_OFFSET);
+	if (PgmEn == 0U) {
+		ShadowPtr = &EfuseShadow[(EfusePsType == 0U) ?
+					0U : (EfusePsType - 1U)];
+		ShadowPtr->Data[Row] = *RowData;
+		ShadowPtr->InvData[Row] = ~(*RowData);
+		ShadowPtr->Valid |= ((u64)1U << Row);
+	}
 	Status = (u32)XST_SUCCESS;
 END:
 	 return Status;
@@ -1096,6 +1142,8 @@ u32 XilSKey_ZynqMp_EfusePs_CacheLoad(void)
 	volatile u32 CacheStatus;
 	u32 Status = (u32)XST_FAILURE;
 
+	XilSKey_ZynqMp_EfusePs_ShadowInvalidate();
+
 	/* Check the unlock status */
 	if (XilSKey_ZynqMp_EfusePs_CtrlrLockStatus() != 0U) {
 		XilSKey_ZynqMp_EfusePs_CtrlrUnLock();
@@ -1156,6 +1204,9 @@ u32 XilSKey_ZynqMp_EfusePs_SetWriteConditions(void)
 	u32 ReadReg;
 	u32 Status = (u32)XST_FAILURE;
 
+	/* Rows read before programming are stale afterwards */
+	XilSKey_ZynqMp_EfusePs_ShadowInvalidate();
+
 	/* Enable Program enable bit */
 	XilSKey_ZynqMp_EfusePS_PrgrmEn();
 
@@ -1838,6 +1889,7 @@ u32 XilSKey_ZynqMp_EfusePs_ReadUserFuse(u32 *UseFusePtr, u8 UserFuse_Num,
 							u8 ReadOption)
 {
 	u32 Status = (u32)XST_FAILURE;
+	u32 Shadowed;
 	XskEfusePs_Type EfuseType = XSK_ZYNQMP_EFUSEPS_EFUSE_0;
 
 	/* Assert validates the input arguments */
@@ -1854,21 +1906,26 @@ u32 XilSKey_ZynqMp_EfusePs_ReadUserFuse(u32 *UseFusePtr, u8 UserFuse_Num,
 		Status = (u32)XST_SUCCESS;
 	}
 	else {
-		/* Unlock the controller */
-		XilSKey_ZynqMp_EfusePs_CtrlrUnLock();
-		/* Check the unlock status */
-		if (XilSKey_ZynqMp_EfusePs_CtrlrLockStatus() != 0U) {
-			Status = (u32)(XSK_EFUSEPS_ERROR_CONTROLLER_LOCK);
-			goto UNLOCK;
-		}
-		Status = XilSKey_ZynqMp_EfusePs_Init();
-		if (Status != (u32)XST_SUCCESS) {
-			goto UNLOCK;
-		}
-		/* Vol and temperature checks */
-		Status = XilSKey_ZynqMp_EfusePs_Temp_Vol_Checks();
-		if (Status != (u32)XST_SUCCESS) {
-			goto UNLOCK;
+		/* Rows in the read shadow do not need the controller */
+		Shadowed = XilSKey_ZynqMp_EfusePs_IsShadowed(XSK_ZYNQMP_EFUSEPS_USR0_FUSE_ROW + UserFuse_Num, XSK_ZYNQMP_EFUSEPS_USR0_FUSE_ROW + UserFuse_Num,
+							EfuseType);
+		if (Shadowed == FALSE) {
+			/* Unlock the controller */
+			XilSKey_ZynqMp_EfusePs_CtrlrUnLock();
+			/* Check the unlock status */
+			if (XilSKey_ZynqMp_EfusePs_CtrlrLockStatus() != 0U) {
+				Status = (u32)(XSK_EFUSEPS_ERROR_CONTROLLER_LOCK);
+				goto UNLOCK;
+			}
+			Status = XilSKey_ZynqMp_EfusePs_Init();
+			if (Status != (u32)XST_SUCCESS) {
+				goto UNLOCK;
+			}
+			/* Vol and temperature checks */
+			Status = XilSKey_ZynqMp_EfusePs_Temp_Vol_Checks();
+			if (Status != (u32)XST_SUCCESS) {
+				goto UNLOCK;
+			}
 		}
 
 		Status = XilSKey_ZynqMp_EfusePs_ReadRow(
@@ -1880,8 +1937,10 @@ u32 XilSKey_ZynqMp_EfusePs_ReadUserFuse(u32 *UseFusePtr, u8 UserFuse_Num,
 
 
 UNLOCK:
-		/* Lock the controller back */
-		XilSKey_ZynqMp_EfusePs_CtrlrLock();
+		if (Shadowed == FALSE) {
+			/* Lock the controller back */
+			XilSKey_ZynqMp_EfusePs_CtrlrLock();
+		}
 	}
 	return Status;
 
@@ -1906,6 +1965,7 @@ UNLOCK:
 u32 XilSKey_ZynqMp_EfusePs_ReadPpk0Hash(u32 *Ppk0Hash, u8 ReadOption)
 {
 	u32 Status = (u32)XST_FAILURE;
+	u32 Shadowed;
 	u32 Row;
 	XskEfusePs_Type EfuseType = XSK_ZYNQMP_EFUSEPS_EFUSE_0;
 	s32 RegNum;
@@ -1929,21 +1989,26 @@ u32 XilSKey_ZynqMp_EfusePs_ReadPpk0Hash(u32 *Ppk0Hash, u8 ReadOption)
 		Status = (u32)XST_SUCCESS;
 	}
 	else {
-		/* Unlock the controller */
-		XilSKey_ZynqMp_EfusePs_CtrlrUnLock();
-		/* Check the unlock status */
-		if (XilSKey_ZynqMp_EfusePs_CtrlrLockStatus() != 0U) {
-			Status = (u32)(XSK_EFUSEPS_ERROR_CONTROLLER_LOCK);
-			goto UNLOCK;
-		}
-		Status = XilSKey_ZynqMp_EfusePs_Init();
-		if (Status != (u32)XST_SUCCESS) {
-			goto UNLOCK;
-		}
-		/* Vol and temperature checks */
-		Status = XilSKey_ZynqMp_EfusePs_Temp_Vol_Checks();
-		if (Status != (u32)XST_SUCCESS) {
-			goto UNLOCK;
+		/* Rows in the read shadow do not need the controller */
+		Shadowed = XilSKey_ZynqMp_EfusePs_IsShadowed(XSK_ZYNQMP_EFUSEPS_PPK0_START_ROW, XSK_ZYNQMP_EFUSEPS_PPK0_SHA3_HASH_END_ROW,
+							EfuseType);
+		if (Shadowed == FALSE) {
+			/* Unlock the controller */
+			XilSKey_ZynqMp_EfusePs_CtrlrUnLock();
+			/* Check the unlock status */
+			if (XilSKey_ZynqMp_EfusePs_CtrlrLockStatus() != 0U) {
+				Status = (u32)(XSK_EFUSEPS_ERROR_CONTROLLER_LOCK);
+				goto UNLOCK;
+			}
+			Status = XilSKey_ZynqMp_EfusePs_Init();
+			if (Status != (u32)XST_SUCCESS) {
+				goto UNLOCK;
+			}
+			/* Vol and temperature checks */
+			Status = XilSKey_ZynqMp_EfusePs_Temp_Vol_Checks();
+			if (Status != (u32)XST_SUCCESS) {
+				goto UNLOCK;
+			}
 		}
 
 		for (Row = XSK_ZYNQMP_EFUSEPS_PPK0_SHA3_HASH_END_ROW;
@@ -1959,8 +2024,10 @@ u32 XilSKey_ZynqMp_EfusePs_ReadPpk0Hash(u32 *Ppk0Hash, u8 ReadOption)
 		}
 
 UNLOCK:
-		/* Lock the controller back */
-		XilSKey_ZynqMp_EfusePs_CtrlrLock();
+		if (Shadowed == FALSE) {
+			/* Lock the controller back */
+			XilSKey_ZynqMp_EfusePs_CtrlrLock();
+		}
 	}
 	return Status;
 
@@ -1985,6 +2052,7 @@ UNLOCK:
 u32 XilSKey_ZynqMp_EfusePs_ReadPpk1Hash(u32 *Ppk1Hash, u8 ReadOption)
 {
 	u32 Status = (u32)XST_FAILURE;
+	u32 Shadowed;
 	u32 Row;
 	XskEfusePs_Type EfuseType = XSK_ZYNQMP_EFUSEPS_EFUSE_0;
 	s32 RegNum;
@@ -2008,21 +2076,26 @@ u32 XilSKey_ZynqMp_EfusePs_ReadPpk1Hash(u32 *Ppk1Hash, u8 ReadOption)
 		Status = (u32)XST_SUCCESS;
 	}
 	else {
-		/* Unlock the controller */
-		XilSKey_ZynqMp_EfusePs_CtrlrUnLock();
-		/* Check the unlock status */
-		if (XilSKey_ZynqMp_EfusePs_CtrlrLockStatus() != 0U) {
-			Status = (u32)(XSK_EFUSEPS_ERROR_CONTROLLER_LOCK);
-			goto UNLOCK;
-		}
-		Status = XilSKey_ZynqMp_EfusePs_Init();
-		if (Status != (u32)XST_SUCCESS) {
-			goto UNLOCK;
-		}
-		/* Vol and temperature checks */
-		Status = XilSKey_ZynqMp_EfusePs_Temp_Vol_Checks();
-		if (Status != (u32)XST_SUCCESS) {
-			goto UNLOCK;
+		/* Rows in the read shadow do not need the controller */
+		Shadowed = XilSKey_ZynqMp_EfusePs_IsShadowed(XSK_ZYNQMP_EFUSEPS_PPK1_START_ROW, XSK_ZYNQMP_EFUSEPS_PPK1_SHA3_HASH_END_ROW,
+							EfuseType);
+		if (Shadowed == FALSE) {
+			/* Unlock the controller */
+			XilSKey_ZynqMp_EfusePs_CtrlrUnLock();
+			/* Check the unlock status */
+			if (XilSKey_ZynqMp_EfusePs_CtrlrLockStatus() != 0U) {
+				Status = (u32)(XSK_EFUSEPS_ERROR_CONTROLLER_LOCK);
+				goto UNLOCK;
+			}
+			Status = XilSKey_ZynqMp_EfusePs_Init();
+			if (Status != (u32)XST_SUCCESS) {
+				goto UNLOCK;
+			}
+			/* Vol and temperature checks */
+			Status = XilSKey_ZynqMp_EfusePs_Temp_Vol_Checks();
+			if (Status != (u32)XST_SUCCESS) {
+				goto UNLOCK;
+			}
 		}
 
 		for (Row = XSK_ZYNQMP_EFUSEPS_PPK1_SHA3_HASH_END_ROW;
@@ -2037,8 +2110,10 @@ u32 XilSKey_ZynqMp_EfusePs_ReadPpk1Hash(u32 *Ppk1Hash, u8 ReadOption)
 		}
 
 UNLOCK:
-		/* Lock the controller back */
-		XilSKey_ZynqMp_EfusePs_CtrlrLock();
+		if (Shadowed == FALSE) {
+			/* Lock the controller back */
+			XilSKey_ZynqMp_EfusePs_CtrlrLock();
+		}
 	}
 	return Status;
 
@@ -2063,6 +2138,7 @@ UNLOCK:
 u32 XilSKey_ZynqMp_EfusePs_ReadSpkId(u32 *SpkId, u8 ReadOption)
 {
 	u32 Status = (u32)XST_FAILURE;
+	u32 Shadowed;
 	XskEfusePs_Type EfuseType = XSK_ZYNQMP_EFUSEPS_EFUSE_0;
 
 	/* Assert validates the input arguments */
@@ -2076,21 +2152,26 @@ u32 XilSKey_ZynqMp_EfusePs_ReadSpkId(u32 *SpkId, u8 ReadOption)
 		Status = (u32)XST_SUCCESS;
 	}
 	else {
-		/* Unlock the controller */
-		XilSKey_ZynqMp_EfusePs_CtrlrUnLock();
-		/* Check the unlock status */
-		if (XilSKey_ZynqMp_EfusePs_CtrlrLockStatus() != 0U) {
-			Status = (u32)(XSK_EFUSEPS_ERROR_CONTROLLER_LOCK);
-			goto UNLOCK;
-		}
-		Status = XilSKey_ZynqMp_EfusePs_Init();
-		if (Status != (u32)XST_SUCCESS) {
-			goto UNLOCK;
-		}
-		/* Vol and temperature checks */
-		Status = XilSKey_ZynqMp_EfusePs_Temp_Vol_Checks();
-		if (Status != (u32)XST_SUCCESS) {
-			goto UNLOCK;
+		/* Rows in the read shadow do not need the controller */
+		Shadowed = XilSKey_ZynqMp_EfusePs_IsShadowed(XSK_ZYNQMP_EFUSEPS_SPK_ID_ROW, XSK_ZYNQMP_EFUSEPS_SPK_ID_ROW,
+							EfuseType);
+		if (Shadowed == FALSE) {
+			/* Unlock the controller */
+			XilSKey_ZynqMp_EfusePs_CtrlrUnLock();
+			/* Check the unlock status */
+			if (XilSKey_ZynqMp_EfusePs_CtrlrLockStatus() != 0U) {
+				Status = (u32)(XSK_EFUSEPS_ERROR_CONTROLLER_LOCK);
+				goto UNLOCK;
+			}
+			Status = XilSKey_ZynqMp_EfusePs_Init();
+			if (Status != (u32)XST_SUCCESS) {
+				goto UNLOCK;
+			}
+			/* Vol and temperature checks */
+			Status = XilSKey_ZynqMp_EfusePs_Temp_Vol_Checks();
+			if (Status != (u32)XST_SUCCESS) {
+				goto UNLOCK;
+			}
 		}
 
 		Status = XilSKey_ZynqMp_EfusePs_ReadRow(
@@ -2100,8 +2181,10 @@ u32 XilSKey_ZynqMp_EfusePs_ReadSpkId(u32 *SpkId, u8 ReadOption)
 		}
 
 UNLOCK:
-		/* Lock the controller back */
-		XilSKey_ZynqMp_EfusePs_CtrlrLock();
+		if (Shadowed == FALSE) {
+			/* Lock the controller back */
+			XilSKey_ZynqMp_EfusePs_CtrlrLock();
+		}
 
 	}
 	return Status;
@@ -3215,3 +3298,96 @@ static u32 XilSKey_ZynqMpEfuseRead(const u32 AddrHigh, const u32 AddrLow)
 END:
 	return Status;
 }
+
+/*****************************************************************************/
+/*
+* This function reads a row from the read shadow.
+*
+* @param	Row specifies the row number to read.
+* @param	EfuseType specifies the eFUSE type.
+* @param	RowData is a pointer to 32 bit variable to hold the row.
+*
+* @return
+*		XST_SUCCESS - Row is valid in the shadow
+*		XST_FAILURE - Row must be read from the eFUSE array
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XilSKey_ZynqMp_EfusePs_ShadowRead(u8 Row,
+			XskEfusePs_Type EfuseType, u32 *RowData)
+{
+	u32 Status = (u32)XST_FAILURE;
+	XilSKey_EfusePsShadow *ShadowPtr;
+
+	if (XilSKey_ZynqMp_EfusePs_IsShadowed(Row, Row, EfuseType) == TRUE) {
+		ShadowPtr = &EfuseShadow[((u32)EfuseType == 0U) ?
+					0U : ((u32)EfuseType - 1U)];
+		*RowData = ShadowPtr->Data[Row];
+		Status = (u32)XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/*
+* This function checks whether a range of rows is valid in the read shadow.
+* Rows whose copy fails the integrity check are dropped from the shadow.
+*
+* @param	RowStart specifies the first row.
+* @param	RowEnd specifies the last row.
+* @param	EfuseType specifies the eFUSE type.
+*
+* @return
+*		TRUE - All the rows are valid in the shadow
+*		FALSE - At least one row must be read from the eFUSE array
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XilSKey_ZynqMp_EfusePs_IsShadowed(u8 RowStart, u8 RowEnd,
+			XskEfusePs_Type EfuseType)
+{
+	u32 Shadowed = TRUE;
+	XilSKey_EfusePsShadow *ShadowPtr;
+	u32 Row;
+
+	ShadowPtr = &EfuseShadow[((u32)EfuseType == 0U) ?
+				0U : ((u32)EfuseType - 1U)];
+
+	for (Row = RowStart; Row <= RowEnd; Row++) {
+		if (((ShadowPtr->Valid >> Row) & 0x1U) == 0U) {
+			Shadowed = FALSE;
+			break;
+		}
+		if ((ShadowPtr->Data[Row] ^ ShadowPtr->InvData[Row]) !=
+						0xFFFFFFFFU) {
+			ShadowPtr->Valid &= ~((u64)1U << Row);
+			Shadowed = FALSE;
+			break;
+		}
+	}
+
+	return Shadowed;
+}
+
+/*****************************************************************************/
+/*
+* This function drops all the rows of the read shadow.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XilSKey_ZynqMp_EfusePs_ShadowInvalidate(void)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < XSK_ZYNQMP_EFUSEPS_SHADOW_NUM; Index++) {
+		EfuseShadow[Index].Valid = 0U;
+	}
+}
@@ -30,6 +30,12 @@
 *
 ******************************************************************************/
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <endian.h>
+#include <sys/mman.h>
+
 #include "mcap_lib.h"
 
 /* Library Specific Definitions */
@@ -43,6 +49,9 @@
 #define MCAP_SYNC_BYTE2 ((MCAP_SYNC_DWORD & 0x0000FF00) >> 8)
 #define MCAP_SYNC_BYTE3 ((MCAP_SYNC_DWORD & 0x000000FF) >> 0)
 
+#define MCAP_IOMEM_FILE	"/proc/iomem"
+#define MCAP_MEM_DEV	"/dev/mem"
+
 #define MCAP_RBT_FILE	".rbt"
 #define MCAP_BIT_FILE	".bit"
 #define MCAP_BIN_FILE	".bin"
@@ -220,11 +229,45 @@ static int Checkforcompletion(struct mcap_dev *mdev)
 	return 0;
 }
 
+/*
+ * Writes the bitstream to the MCAP Data register. When the configuration
+ * space is mapped, every word is a single store to the register instead of
+ * a system call through the PCI library.
+ */
+static void MCapWriteData(struct mcap_dev *mdev, u32 *data, int len,
+			  u8 bswap)
+{
+	volatile u32 *dreg;
+	int count;
+
+	if (!mdev->cfg_map) {
+		if (!bswap) {
+			for (count = 0; count < len; count++)
+				MCapRegWrite(mdev, MCAP_DATA, data[count]);
+		} else {
+			for (count = 0; count < len; count++)
+				MCapRegWrite(mdev, MCAP_DATA,
+					     __bswap_32(data[count]));
+		}
+		return;
+	}
+
+	/* Configuration space is little endian */
+	dreg = (volatile u32 *)(mdev->cfg_map + mdev->reg_base + MCAP_DATA);
+	if (!bswap) {
+		for (count = 0; count < len; count++)
+			*dreg = htole32(data[count]);
+	} else {
+		for (count = 0; count < len; count++)
+			*dreg = htole32(__bswap_32(data[count]));
+	}
+}
+
 static int MCapWritePartialBitStream(struct mcap_dev *mdev, u32 *data,
 					int len, u8 bswap)
 {
 	u32 set, restore;
-	int err, count = 0, i;
+	int err, i;
 
 	if (!data || !len) {
 		pr_err("Invalid Arguments\n");
@@ -254,13 +297,7 @@ static int MCapWritePartialBitStream(struct mcap_dev *mdev, u32 *data,
 	MCapRegWrite(mdev, MCAP_CONTROL, set);
 
 	/* Write Data */
-	if (!bswap) {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, data[count]);
-	} else {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, __bswap_32(data[count]));
-	}
+	MCapWriteData(mdev, data, len, bswap);
 
 	for (i = 0 ; i < EMCAP_EOS_LOOP_COUNT; i++) {
 		MCapRegWrite(mdev, MCAP_DATA, EMCAP_NOOP_VAL);
@@ -287,7 +324,7 @@ static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
 			      int len, u8 bswap)
 {
 	u32 set, restore;
-	int err, count = 0;
+	int err;
 
 	if (!data || !len) {
 		pr_err("Invalid Arguments\n");
@@ -319,13 +356,7 @@ static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
 	}
 
 	/* Write Data */
-	if (!bswap) {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, data[count]);
-	} else {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, __bswap_32(data[count]));
-	}
+	MCapWriteData(mdev, data, len, bswap);
 
 	/* Check for Completion */
 	err = Checkforcompletion(mdev);
@@ -347,9 +378,86 @@ static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
 	return 0;
 }
 
+/*
+ * Maps the configuration space of the MCAP device from the ECAM (MMCONFIG)
+ * region listed in /proc/iomem. Bitstream writes are then done with stores
+ * to the mapping, the PCI library is still used for all the other accesses.
+ */
+int MCapMapConfigSpace(struct mcap_dev *mdev)
+{
+	struct pci_dev *pdev = mdev->pdev;
+	unsigned long long start, end, offset;
+	unsigned int domain, bus_start, bus_end;
+	char *line = NULL;
+	size_t linelen;
+	FILE *fptr;
+	void *map = MAP_FAILED;
+	u32 id;
+	int fd;
+
+	if (mdev->cfg_map)
+		return 0;
+
+	fptr = fopen(MCAP_IOMEM_FILE, "r");
+	if (fptr == NULL)
+		return -EMCAPMAP;
+
+	while (getline(&line, &linelen, fptr) != -1) {
+		if (sscanf(line, " %llx-%llx : PCI %*s %x [bus %x-%x]",
+			   &start, &end, &domain, &bus_start, &bus_end) != 5)
+			continue;
+		if (domain != (unsigned int)pdev->domain ||
+		    pdev->bus < bus_start || pdev->bus > bus_end)
+			continue;
+
+		offset = ((unsigned long long)(pdev->bus - bus_start) << 20) |
+			 (pdev->dev << 15) | (pdev->func << 12);
+		/* Addresses read as 0 without root access */
+		if (!start || start + offset + MCAP_ECAM_FUNC_SIZE - 1 > end)
+			break;
+
+		fd = open(MCAP_MEM_DEV, O_RDWR | O_SYNC);
+		if (fd < 0)
+			break;
+		map = mmap(NULL, MCAP_ECAM_FUNC_SIZE, PROT_READ | PROT_WRITE,
+			   MAP_SHARED, fd, start + offset);
+		close(fd);
+		break;
+	}
+	free(line);
+	fclose(fptr);
+
+	if (map == MAP_FAILED) {
+		pr_dbg("ECAM region of the MCAP device not mapped\n");
+		return -EMCAPMAP;
+	}
+
+	/* Make sure the mapping is the configuration space of the device */
+	id = le32toh(*(volatile u32 *)map);
+	if (id != ((u32)pdev->device_id << 16 | pdev->vendor_id)) {
+		pr_dbg("ECAM mapping does not match the MCAP device\n");
+		munmap(map, MCAP_ECAM_FUNC_SIZE);
+		return -EMCAPMAP;
+	}
+
+	mdev->cfg_map = map;
+	pr_dbg("Configuration space mapped from 0x%llx\n", start + offset);
+
+	return 0;
+}
+
+void MCapUnmapConfigSpace(struct mcap_dev *mdev)
+{
+	if (mdev->cfg_map) {
+		munmap((void *)mdev->cfg_map, MCAP_ECAM_FUNC_SIZE);
+		mdev->cfg_map = NULL;
+	}
+}
+
 void MCapLibFree(struct mcap_dev *mdev)
 {
 	if (mdev) {
+		MCapUnmapConfigSpace(mdev);
 		pci_cleanup(mdev->pacc);
 		free(mdev);
 	}
@@ -369,6 +477,9 @@ struct mcap_dev *MCapLibInit(int device_id)
 	mdev->pacc = pci_alloc();
 
 	mdev->is_multiplebit = 0;
+	mdev->cfg_map = NULL;
+	mdev->report_timing = 0;
+	mdev->pdev = NULL;
 
 	/* Initialize the PCI library */
 	pci_init(mdev->pacc);
@@ -401,6 +512,9 @@ struct mcap_dev *MCapLibInit(int device_id)
 		goto free_resources;
 	}
 
+	/* Fall back to the PCI library if the ECAM region is not mapped */
+	MCapMapConfigSpace(mdev);
+
 	return mdev;
 
 free_resources:
@@ -589,14 +703,37 @@ void MCapDumpRegs(struct mcap_dev *mdev)
 	MCapDumpReadRegs(mdev);
 }
 
+static double MCapElapsed(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) +
+		(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void MCapReportTiming(struct mcap_dev *mdev, u32 wrdatasz,
+			     struct timespec *start, struct timespec *read,
+			     struct timespec *end)
+{
+	double rdtime = MCapElapsed(start, read);
+	double wrtime = MCapElapsed(read, end);
+	double mbytes = (double)wrdatasz * 4 / (1024 * 1024);
+
+	pr_info("Read file:\t\t%.3f s\n", rdtime);
+	pr_info("Write bitstream:\t%.3f s, %u bytes, %.2f MB/s (%s)\n",
+		wrtime, wrdatasz * 4, wrtime > 0 ? mbytes / wrtime : 0,
+		mdev->cfg_map ? "ECAM mapping" : "PCI library");
+}
+
 int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type)
 {
+	struct timespec tstart, tread, tend;
 	FILE *fptr;
 	u32 *data;
 	u32 binsz, wrdatasz;
 	int err = 0;
 	u8 bswap = 0;
 
+	clock_gettime(CLOCK_MONOTONIC, &tstart);
+
 	/* Get the size */
 	fptr = fopen(file_path, "rb");
 	if (fptr == NULL)
@@ -637,6 +774,7 @@ int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type)
 	}
 
 	/* Program FPGA */
+	clock_gettime(CLOCK_MONOTONIC, &tread);
 	if (bitfile_type == EMCAP_PARTIALCONFIG_FILE) {
 		err = MCapWritePartialBitStream(mdev, data, wrdatasz, bswap);
 		if (err)
@@ -648,6 +786,10 @@ int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type)
 			return -EMCAPCFG;
 		pr_info("FPGA Configuration Done!!\n");
 	}
+	clock_gettime(CLOCK_MONOTONIC, &tend);
+
+	if (mdev->report_timing)
+		MCapReportTiming(mdev, wrdatasz, &tstart, &tread, &tend);
 
 free_resources:
 	if (data)
@@ -85,6 +85,7 @@
 #define EMCAPCFG	126
 #define EMCAPBUSWALK	127
 #define EMCAPCFGACC	128
+#define EMCAPMAP	129
 
 #define EMCAP_EOS_RETRY_COUNT 10
 #define EMCAP_EOS_LOOP_COUNT 100
@@ -104,12 +105,21 @@
 #define pr_info printf
 #define pr_err	printf
 
+/* Size of the configuration space of a function in the ECAM region */
+#define MCAP_ECAM_FUNC_SIZE	4096
+
 /* MCAP Device Information */
 struct mcap_dev {
 	struct pci_dev *pdev;
 	struct pci_access *pacc;
 	unsigned int reg_base;
 	u32 is_multiplebit;
+	/*
+	 * Configuration space of the device mapped from the ECAM region,
+	 * NULL when the bitstream is written through the PCI library.
+	 */
+	volatile u8 *cfg_map;
+	u32 report_timing;
 };
 
 #define MCapRegWrite(mdev, offset, value) \
@@ -158,3 +168,5 @@ int MCapShowDevice(struct mcap_dev *mdev, int verbose);
 int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type);
 int MCapReadRegisters(struct mcap_dev *mdev, u32 *data);
 int MCapAccessConfigSpace(struct mcap_dev *mdev, int argc, char **argv);
+int MCapMapConfigSpace(struct mcap_dev *mdev);
+void MCapUnmapConfigSpace(struct mcap_dev *mdev);